@@ -1,9 +1,13 @@
-layout (location = 0) in vec3 vaPos;
-layout (location = 1) in vec2 vaTexUV;
-layout (location = 2) in vec4 vaCol;
-layout (location = 3) in float vaScreenSpace;
-
-layout (location = 5) in float palid; 
+// one instance per billboard, expanded into two triangles - 0 1 2 / 0 2 3
+layout (location = 0) in vec4 vaPos01;
+layout (location = 1) in vec4 vaPos23;
+layout (location = 2) in vec4 vaTexUV01;
+layout (location = 3) in vec4 vaTexUV23;
+layout (location = 4) in vec4 vaCol0;
+layout (location = 5) in vec4 vaCol1;
+layout (location = 6) in vec4 vaCol2;
+layout (location = 7) in vec4 vaCol3;
+layout (location = 8) in vec3 vaDepthScreenSpacePal;
 
 out vec4 colour;
 out vec2 texuv;
@@ -13,11 +17,18 @@ flat out int paletteid;
 uniform mat4 view;
 uniform mat4 projection;
 
+const int corners[6] = int[6](0, 1, 2, 0, 2, 3);
+
 void main() {
-    gl_Position = projection * view * vec4(vaPos, 1.0);
+    int corner = corners[gl_VertexID];
+    vec2 pos[4] = vec2[4](vaPos01.xy, vaPos01.zw, vaPos23.xy, vaPos23.zw);
+    vec2 uv[4] = vec2[4](vaTexUV01.xy, vaTexUV01.zw, vaTexUV23.xy, vaTexUV23.zw);
+    vec4 col[4] = vec4[4](vaCol0, vaCol1, vaCol2, vaCol3);
+
+    gl_Position = projection * view * vec4(pos[corner], vaDepthScreenSpacePal.x, 1.0);
     // float opacity = smoothstep(1.0 , 0.9999, vaPos.z);
-    colour = vec4(vaCol.r, vaCol.g, vaCol.b, 1.0);
-    texuv = vaTexUV;
-    screenspace = vaScreenSpace;
-    paletteid = int(palid);
+    colour = vec4(col[corner].r, col[corner].g, col[corner].b, 1.0);
+    texuv = uv[corner];
+    screenspace = vaDepthScreenSpacePal.y;
+    paletteid = int(vaDepthScreenSpacePal.z);
 }
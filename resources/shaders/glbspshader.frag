@@ -1,6 +1,8 @@
 #ifdef GL_ES
     precision highp float;
     precision highp sampler2DArray;
+    precision highp samplerBuffer;
+    precision highp usamplerBuffer;
 #endif
 
 in vec4 vertexColour;
@@ -10,6 +12,7 @@ in vec3 vsPos;
 in vec3 vsNorm;
 flat in int vsAttrib;
 flat in int vsSector;
+in vec4 viewspace;
 
 out vec4 FragColour;
 
@@ -45,10 +48,19 @@ uniform Sunlight sun;
 uniform vec3 CameraPos;
 uniform int flowtimer;
 uniform int watertiles;
+uniform ivec2 textureArraySize; // size of textureArray0 before the mip bias was applied
 uniform float gamma;
 
-#define num_point_lights 40
-uniform PointLight fspointlights[num_point_lights];
+// clustered point lights, see LightClusterGrid
+#define cluster_tiles_x 16
+#define cluster_tiles_y 8
+#define cluster_slices 16
+
+uniform samplerBuffer clusterLights;
+uniform usamplerBuffer clusterGrid;
+uniform usamplerBuffer clusterIndices;
+uniform vec4 clusterViewport; // viewport origin & size in window coordinates
+uniform vec2 clusterDepth; // near clip & depth slice scale
 
 uniform sampler2DArray textureArray0;
 
@@ -56,6 +68,8 @@ uniform sampler2DArray textureArray0;
 // funcs
 vec3 CalcSunLight(Sunlight light, vec3 normal, vec3 viewDir, vec3 thisfragcol);
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+uvec2 getLightCluster(float depth);
+PointLight getClusterLight(uint entry);
 
 void main() {
 
@@ -82,10 +96,12 @@ void main() {
         texuvmod.x = 1.0;
     }
 
-    deltas.x = texuvmod.x * float(flowtimer & int(textureSize(textureArray0,0).x-1));
-    deltas.y = texuvmod.y * float(flowtimer & int(textureSize(textureArray0,0).y-1));
-    texcoords.x = (deltas.x + texuv.x) / float(textureSize(textureArray0,0).x);
-    texcoords.y = (deltas.y + texuv.y) / float(textureSize(textureArray0,0).y);
+    // texture uvs are in texels of the full-size texture, the array can be smaller if its top mips were dropped
+    ivec2 texsize = textureArraySize;
+    deltas.x = texuvmod.x * float(flowtimer & (texsize.x-1));
+    deltas.y = texuvmod.y * float(flowtimer & (texsize.y-1));
+    texcoords.x = (deltas.x + texuv.x) / float(texsize.x);
+    texcoords.y = (deltas.y + texuv.y) / float(texsize.y);
     fragcol = texture(textureArray0, vec3(texcoords.x,texcoords.y,olayer.y));
 
     vec4 toplayer = texture(textureArray0, vec3(texcoords.x,texcoords.y,0));
@@ -103,22 +119,22 @@ void main() {
     vec3 result = CalcSunLight(sun, fragnorm, fragviewdir, vec3(1)); //fragcol.rgb);
     result = clamp(result, 0.0, 0.85);
 
-    result += CalcPointLight(fspointlights[0], fragnorm, vsPos, fragviewdir);
-
-    // stack stationary
-    for(int i = 1; i < num_point_lights; i++) {
-        if (fspointlights[i].type == 1.0)
-            result += CalcPointLight(fspointlights[i], fragnorm, vsPos, fragviewdir);
+    // stack torchlight & stationary lights under the texture, mobile lights on top of it
+    vec3 modulated = vec3(0);
+    vec3 additive = vec3(0);
+    uvec2 cluster = getLightCluster(-viewspace.z);
+    for (uint i = cluster.x; i < cluster.x + cluster.y; i++) {
+        PointLight light = getClusterLight(i);
+        if (light.type == 1.0) {
+            modulated += CalcPointLight(light, fragnorm, vsPos, fragviewdir);
+        } else {
+            additive += CalcPointLight(light, fragnorm, vsPos, fragviewdir);
+        }
     }
 
+    result += modulated;
     result *= fragcol.rgb;
-
-    // stack mobile
-
-    for(int i = 1; i < num_point_lights; i++) {
-        if (fspointlights[i].type == 2.0)
-            result += CalcPointLight(fspointlights[i], fragnorm, vsPos, fragviewdir);
-    }
+    result += additive;
 
     vec3 clamps = result; // fragcol.rgb *  // clamp(result,0,1) * ; 
 
@@ -203,3 +219,30 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
     specular *= attenuation;
     return (ambient + diffuse + specular);
 }
+
+// finds the light list for this fragment's cluster - (offset, count) into clusterIndices
+uvec2 getLightCluster(float depth) {
+    vec2 tile = (gl_FragCoord.xy - clusterViewport.xy) / clusterViewport.zw * vec2(cluster_tiles_x, cluster_tiles_y);
+    int x = clamp(int(tile.x), 0, cluster_tiles_x - 1);
+    int y = clamp(int(tile.y), 0, cluster_tiles_y - 1);
+    int z = clamp(int(floor(log(max(depth, clusterDepth.x) / clusterDepth.x) * clusterDepth.y)), 0, cluster_slices - 1);
+    return texelFetch(clusterGrid, (z * cluster_tiles_y + y) * cluster_tiles_x + x).xy;
+}
+
+// fetches light from the cluster light list
+PointLight getClusterLight(uint entry) {
+    int index = int(texelFetch(clusterIndices, int(entry)).r) * 3;
+    vec4 posrad = texelFetch(clusterLights, index);
+    vec4 diffuse = texelFetch(clusterLights, index + 1);
+    vec4 specular = texelFetch(clusterLights, index + 2);
+
+    PointLight light;
+    light.type = diffuse.a;
+    light.position = posrad.xyz;
+    light.sector = specular.a;
+    light.radius = posrad.w;
+    light.ambient = diffuse.rgb;
+    light.diffuse = diffuse.rgb;
+    light.specular = specular.rgb;
+    return light;
+}
@@ -12,12 +12,14 @@ out vec3 vsPos;
 out vec3 vsNorm;
 flat out int vsAttrib;
 flat out int vsSector;
+out vec4 viewspace;
 
 uniform mat4 view;
 uniform mat4 projection;
 
 
 void main() {
+    viewspace = view * vec4(vaPos, 1.0);
     gl_Position = projection * view * vec4(vaPos, 1.0);
 
     //unused
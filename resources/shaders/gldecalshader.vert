@@ -1,8 +1,10 @@
+#ifdef GL_ES
+    precision highp samplerBuffer;
+#endif
+
 layout (location = 0) in vec3 vaPos;
 layout (location = 1) in vec2 vaTexUV;
-layout (location = 2) in float vaTexLayer;
-layout (location = 3) in vec3 vaColours;
-layout (location = 4) in float vaAttrib;
+layout (location = 2) in float vaDecal;
 
 out vec4 vertexColour;
 out vec2 texuv;
@@ -16,17 +18,16 @@ uniform mat4 view;
 uniform mat4 projection;
 
 uniform float decalbias;
+uniform samplerBuffer decalColours;
 
 void main() {
 	viewspace = view * vec4(vaPos, 1.0);
 	gl_Position = projection * view * vec4(vaPos, 1.0);
 	gl_Position -= vec4(0, 0, decalbias, 0);
 
-	vertexColour = vec4(vaColours, 1.0);
+	vertexColour = vec4(texelFetch(decalColours, int(vaDecal)).rgb, 1.0);
 
 	texuv = vaTexUV;
-	//olayer = vaTexLayer;
 	//vsPos = vaPos;
 	//vsNorm = vaNormal;
-	//vsAttrib = int(vaAttrib);
 } 
\ No newline at end of file
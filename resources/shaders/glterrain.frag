@@ -1,6 +1,8 @@
 #ifdef GL_ES
     precision highp float;
     precision highp sampler2DArray;
+    precision highp samplerBuffer;
+    precision highp usamplerBuffer;
 #endif
 
 in vec4 vertexColour;
@@ -50,8 +52,16 @@ uniform Sunlight sun;
 uniform vec3 CameraPos;
 uniform float gamma;
 
-#define num_point_lights 20
-uniform PointLight fspointlights[num_point_lights];
+// clustered point lights, see LightClusterGrid
+#define cluster_tiles_x 16
+#define cluster_tiles_y 8
+#define cluster_slices 16
+
+uniform samplerBuffer clusterLights;
+uniform usamplerBuffer clusterGrid;
+uniform usamplerBuffer clusterIndices;
+uniform vec4 clusterViewport; // viewport origin & size in window coordinates
+uniform vec2 clusterDepth; // near clip & depth slice scale
 
 uniform sampler2DArray textureArray0;
 uniform sampler2DArray textureArray1;
@@ -61,6 +71,8 @@ uniform FogParam fog;
 // funcs
 vec3 CalcSunLight(Sunlight light, vec3 normal, vec3 viewDir, vec3 thisfragcol);
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+uvec2 getLightCluster(float depth);
+PointLight getClusterLight(uint entry);
 float getFogRatio(FogParam fogpar, float dist);
 
 void main() {
@@ -84,22 +96,22 @@ void main() {
     vec3 result = CalcSunLight(sun, fragnorm, fragviewdir, vec3(1));
     result = clamp(result, 0.0, 0.85);
 
-    // stack torchlight if any
-    result += CalcPointLight(fspointlights[0], fragnorm, vsPos, fragviewdir);
-
-    // stack stationary lights
-    for(int i = 1; i < num_point_lights; i++) {
-        if (fspointlights[i].type == 1.0)
-            result += CalcPointLight(fspointlights[i], fragnorm, vsPos, fragviewdir);
+    // stack torchlight & stationary lights under the texture, mobile lights on top of it
+    vec3 modulated = vec3(0);
+    vec3 additive = vec3(0);
+    uvec2 cluster = getLightCluster(-viewspace.z);
+    for (uint i = cluster.x; i < cluster.x + cluster.y; i++) {
+        PointLight light = getClusterLight(i);
+        if (light.type == 1.0) {
+            modulated += CalcPointLight(light, fragnorm, vsPos, fragviewdir);
+        } else {
+            additive += CalcPointLight(light, fragnorm, vsPos, fragviewdir);
+        }
     }
 
+    result += modulated;
     result *= fragcol.rgb;
-
-    // stack mobile lights
-    for(int i = 1; i < num_point_lights; i++) {
-        if (fspointlights[i].type == 2.0)
-            result += CalcPointLight(fspointlights[i], fragnorm, vsPos, fragviewdir);
-    }
+    result += additive;
 
     vec3 clamps = result;
     if (fog.fogstart == fog.fogend) {
@@ -181,3 +193,29 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
     specular *= attenuation;
     return (ambient + diffuse + specular);
 }
+
+// finds the light list for this fragment's cluster - (offset, count) into clusterIndices
+uvec2 getLightCluster(float depth) {
+    vec2 tile = (gl_FragCoord.xy - clusterViewport.xy) / clusterViewport.zw * vec2(cluster_tiles_x, cluster_tiles_y);
+    int x = clamp(int(tile.x), 0, cluster_tiles_x - 1);
+    int y = clamp(int(tile.y), 0, cluster_tiles_y - 1);
+    int z = clamp(int(floor(log(max(depth, clusterDepth.x) / clusterDepth.x) * clusterDepth.y)), 0, cluster_slices - 1);
+    return texelFetch(clusterGrid, (z * cluster_tiles_y + y) * cluster_tiles_x + x).xy;
+}
+
+// fetches light from the cluster light list
+PointLight getClusterLight(uint entry) {
+    int index = int(texelFetch(clusterIndices, int(entry)).r) * 3;
+    vec4 posrad = texelFetch(clusterLights, index);
+    vec4 diffuse = texelFetch(clusterLights, index + 1);
+    vec4 specular = texelFetch(clusterLights, index + 2);
+
+    PointLight light;
+    light.type = diffuse.a;
+    light.position = posrad.xyz;
+    light.radius = posrad.w;
+    light.ambient = diffuse.rgb;
+    light.diffuse = diffuse.rgb;
+    light.specular = specular.rgb;
+    return light;
+}
@@ -0,0 +1,34 @@
+#ifdef GL_ES
+    precision highp float;
+#endif
+
+// Bilinear upscale followed by a contrast-adaptive sharpen. Sharpening is backed off in high-contrast areas, so that
+// edges don't ring.
+
+in vec2 texuv;
+
+out vec4 FragColour;
+
+uniform sampler2D scene;
+uniform vec2 texelSize; // Size of a scene texel in texture coordinates.
+uniform vec2 uvMax; // Center of the last rendered texel, the rest of the texture is not up to date.
+uniform float sharpness; // In [0, 1].
+
+vec3 tap(vec2 uv) {
+    return texture(scene, clamp(uv, texelSize * 0.5, uvMax)).rgb;
+}
+
+void main() {
+    vec3 c = tap(texuv);
+    vec3 n = tap(texuv + vec2(0.0, texelSize.y));
+    vec3 s = tap(texuv - vec2(0.0, texelSize.y));
+    vec3 e = tap(texuv + vec2(texelSize.x, 0.0));
+    vec3 w = tap(texuv - vec2(texelSize.x, 0.0));
+
+    vec3 lo = min(c, min(min(n, s), min(e, w)));
+    vec3 hi = max(c, max(max(n, s), max(e, w)));
+    vec3 amount = sqrt(clamp(min(lo, 1.0 - hi) / max(hi, vec3(1.0 / 256.0)), 0.0, 1.0));
+    vec3 weight = -amount * mix(0.125, 0.2, sharpness) * sharpness;
+
+    FragColour = vec4((c + (n + s + e + w) * weight) / (1.0 + 4.0 * weight), 1.0);
+}
@@ -0,0 +1,11 @@
+// Fullscreen triangle that covers the game viewport, generated from the vertex index.
+
+out vec2 texuv;
+
+uniform vec2 uvScale; // Size of the rendered area in the scene texture, as a fraction of the texture size.
+
+void main() {
+    vec2 corner = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+    texuv = corner * uvScale;
+}
@@ -0,0 +1,57 @@
+// Snow flakes are generated entirely on the GPU. Each flake is two triangles, and everything about it is derived from
+// its index & the seed, so the only per-frame input is the time.
+
+out vec4 colour;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+uniform vec4 viewport; // Top-left & bottom-right corners, in pixels.
+uniform uint seed;
+uniform float time; // In seconds.
+uniform float windOffset; // In pixels.
+
+uint hash(uint x) {
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// Random number in [0, 1) for the given flake.
+float flakeRandom(uint flake, uint channel) {
+    return float(hash(hash(flake * 4u + channel) ^ seed) >> 8) / 16777216.0;
+}
+
+void main() {
+    const vec2 corners[6] = vec2[6](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+                                    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
+    uint flake = uint(gl_VertexID / 6);
+    vec2 corner = corners[gl_VertexID % 6];
+
+    // Same mix of flakes as in the original: 70% small, 25% medium & 5% large. Fall speeds & sway match the average
+    // per-frame movement of the original at 60 fps.
+    float kind = flakeRandom(flake, 0u);
+    float size = 1.0;
+    float sway = 3.0;
+    if (kind >= 0.95) {
+        size = 4.0;
+        sway = 10.0;
+    } else if (kind >= 0.7) {
+        size = 2.0;
+        sway = 5.0;
+    }
+    float fallSpeed = (1.5 * size - 0.5) * 60.0;
+
+    vec2 area = max(viewport.zw - viewport.xy - vec2(size), vec2(1.0));
+    float phase = flakeRandom(flake, 3u) * 6.2831853;
+    float x = flakeRandom(flake, 1u) * area.x + windOffset + sway * sin(time * (0.5 + flakeRandom(flake, 2u)) + phase);
+    float y = fract(flakeRandom(flake, 2u) + time * fallSpeed / area.y) * area.y;
+
+    vec2 pos = viewport.xy + floor(vec2(mod(x, area.x), y)) + corner * size;
+    gl_Position = projection * view * vec4(pos, 0.0, 1.0);
+    colour = vec4(1.0);
+}
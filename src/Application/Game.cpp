@@ -1,6 +1,7 @@
 #include "Game.h"
 
 #include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <string>
 #include <utility>
@@ -35,6 +36,7 @@
 #include "Engine/Objects/CharacterEnumFunctions.h"
 #include "Engine/Party.h"
 #include "Engine/SaveLoad.h"
+#include "Engine/SubsystemTimers.h"
 #include "Engine/Random/Random.h"
 #include "Engine/Spells/CastSpellInfo.h"
 #include "Engine/Spells/SpellEnumFunctions.h"
@@ -79,6 +81,7 @@
 
 #include "Library/Platform/Application/PlatformApplication.h"
 #include "Library/Logger/Logger.h"
+#include "Library/Profiler/Profiler.h"
 
 #include "Utility/Format.h"
 #include "Utility/DataPath.h"
@@ -1866,6 +1869,45 @@ void Game::onPressSpace() {
     }
 }
 
+void Game::updateFixedStep() {
+    int rate = _config->gameplay.SimulationRate.value();
+    Duration step;
+    if (rate > 0)
+        step = Duration::fromTicks(std::max<int64_t>(1, std::lround(1.0 * Duration::TICKS_PER_REALTIME_SECOND / rate)));
+    if (pEventTimer->fixedStep() == step)
+        return;
+
+    pEventTimer->setFixedStep(step);
+    _interpolator.reset();
+}
+
+void Game::simulateWorld() {
+    onTimer();
+
+    if (!pEventTimer->isTurnBased()) {
+        _494035_timed_effects__water_walking_damage__etc();
+    } else {
+        // Need to process party death in turn-based mode.
+        maybeWakeSoloSurvivor();
+        updatePartyDeathState();
+    }
+
+    if (dword_6BE364_game_settings_1 & GAME_SETTINGS_SKIP_WORLD_UPDATE) {
+        dword_6BE364_game_settings_1 &= ~GAME_SETTINGS_SKIP_WORLD_UPDATE;
+    } else {
+        {
+            SubsystemTimerScope timer(SUBSYSTEM_AI);
+            OE_PROFILE_ZONE("ai");
+            Actor::UpdateActorAI();
+        }
+        {
+            SubsystemTimerScope timer(SUBSYSTEM_WORLD);
+            OE_PROFILE_ZONE("world");
+            UpdateUserInput_and_MapSpecificStuff();
+        }
+    }
+}
+
 void Game::gameLoop() {
     std::string pLocationName;  // [sp-4h] [bp-68h]@74
     bool bLoading;              // [sp+10h] [bp-54h]@1
@@ -1901,16 +1943,33 @@ void Game::gameLoop() {
 
         bool game_finished = false;
         do {
-            MessageLoopWithWait();
+            OE_PROFILE_FRAME();
+            assets->nextFrame();
+
+            {
+                OE_PROFILE_ZONE("input");
+                MessageLoopWithWait();
+            }
 
             engine->particle_engine->UpdateParticles();
             engine->decal_builder->bloodsplat_container->uNumBloodsplats = 0;
-            if (engine->uNumStationaryLights_in_pStationaryLightsStack != pStationaryLightsStack->uNumLightsActive) {
-                engine->uNumStationaryLights_in_pStationaryLightsStack = pStationaryLightsStack->uNumLightsActive;
+            if (engine->uNumStationaryLights_in_pStationaryLightsStack != pStationaryLightsStack->pLights.size()) {
+                engine->uNumStationaryLights_in_pStationaryLightsStack = pStationaryLightsStack->pLights.size();
             }
 
-            keyboardInputHandler->GenerateInputActions();
-            processQueuedMessages();
+            if (subsystemTimers)
+                subsystemTimers->nextFrame();
+
+            {
+                OE_PROFILE_ZONE("input");
+                keyboardInputHandler->GenerateInputActions();
+            }
+            {
+                SubsystemTimerScope timer(SUBSYSTEM_EVENTS);
+                OE_PROFILE_ZONE("events");
+                processQueuedMessages();
+            }
+            pollPendingSave();
             if (pArcomageGame->bGameInProgress) {
                 ArcomageGame::Loop();
                 render->Present();
@@ -1919,6 +1978,7 @@ void Game::gameLoop() {
 
             pMediaPlayer->HouseMovieLoop();
 
+            updateFixedStep();
             pEventTimer->tick();
             pMiscTimer->tick();
 
@@ -1927,21 +1987,13 @@ void Game::gameLoop() {
             if (pEventTimer->isTurnBased() && !pParty->bTurnBasedModeOn)
                 pEventTimer->setTurnBased(false);
             if (!pEventTimer->isPaused() && uGameState == GAME_STATE_PLAYING) {
-                onTimer();
-
-                if (!pEventTimer->isTurnBased()) {
-                    _494035_timed_effects__water_walking_damage__etc();
-                } else {
-                    // Need to process party death in turn-based mode.
-                    maybeWakeSoloSurvivor();
-                    updatePartyDeathState();
-                }
-
-                if (dword_6BE364_game_settings_1 & GAME_SETTINGS_SKIP_WORLD_UPDATE) {
-                    dword_6BE364_game_settings_1 &= ~GAME_SETTINGS_SKIP_WORLD_UPDATE;
+                if (pEventTimer->hasFixedStep() && !pEventTimer->isTurnBased()) {
+                    while (uGameState == GAME_STATE_PLAYING && pEventTimer->advanceFixedStep()) {
+                        _interpolator.beginStep();
+                        simulateWorld();
+                    }
                 } else {
-                    Actor::UpdateActorAI();
-                    UpdateUserInput_and_MapSpecificStuff();
+                    simulateWorld();
                 }
             }
 
@@ -1952,12 +2004,18 @@ void Game::gameLoop() {
             turnBasedOverlay.update(pMiscTimer->dt(), pTurnEngine->turn_stage);
 
             if (uGameState == GAME_STATE_PLAYING) {
+                SubsystemTimerScope timer(SUBSYSTEM_DRAW);
+                OE_PROFILE_ZONE("draw");
+                if (pEventTimer->hasFixedStep() && !pEventTimer->isPaused() && !pEventTimer->isTurnBased())
+                    _interpolator.beginDraw(pEventTimer->fixedStepAlpha());
                 engine->Draw();
+                _interpolator.endDraw();
                 continue;
             }
 
             if (uGameState == GAME_STATE_CHANGE_LOCATION) {  // смена локации
                 pAudioPlayer->stopSounds();
+                _interpolator.reset();
                 PrepareWorld(0);
                 uGameState = GAME_STATE_PLAYING;
                 continue;
@@ -2069,5 +2127,6 @@ void Game::gameLoop() {
         }
         break;
     }
+    finishPendingSave();
     current_screen_type = SCREEN_VIDEO;
 }
@@ -3,6 +3,8 @@
 #include <memory>
 #include <string>
 
+#include "Engine/SimulationInterpolator.h"
+
 #include "Io/KeyboardInputHandler.h"
 #include "Io/Mouse.h"
 
@@ -25,6 +27,17 @@ class Game {
     bool loop();
     void processQueuedMessages();
     void gameLoop();
+
+    /**
+     * Syncs the fixed simulation step of `pEventTimer` with the `simulation_rate` config option.
+     */
+    void updateFixedStep();
+
+    /**
+     * Runs one world simulation step - timed effects, AI & movement.
+     */
+    void simulateWorld();
+
     void closeTargetedSpellWindow();
     void onEscape();
     void onPressSpace();
@@ -34,6 +47,7 @@ class Game {
     std::shared_ptr<GameConfig> _config;
     DecalBuilder *_decalBuilder = nullptr;
     Menu *_menu = nullptr;
+    SimulationInterpolator _interpolator;
 };
 
 void initDataPath(Platform *platform, const std::string &dataPath);
@@ -61,6 +61,10 @@ class GameConfig : public Config {
 
         Bool ShowFPS = {this, "show_fps", false, "Show debug HUD with FPS and other debug information."};
 
+        Bool ShowProfiler = {this, "show_profiler", false,
+                             "Show frame profiler overlay with per-zone frame breakdowns. Only works in builds with "
+                             "OE_BUILD_PROFILER enabled."};
+
         Bool ShowPickedFace = {this, "show_picked_face", false,
                                "Face pointed with mouse will flash with red for buildings or green for dungeons."};
 
@@ -83,6 +87,18 @@ class GameConfig : public Config {
         ConfigEntry<::LogLevel> LogLevel = {this, "log_level", LOG_ERROR,
                                             "Default log level. One of 'trace', 'debug', 'info', 'warning', 'error' and 'critical'."};
 
+        Bool AsyncLog = {this, "async_log", false,
+                         "Write logs from a background thread. Makes verbose logging cheaper, but the messages that didn't "
+                         "make it out before a hard crash might get lost."};
+
+        Int SpikeThresholdMs = {this, "spike_threshold_ms", 0, &ValidateSpikeThreshold,
+                                "Frame time in milliseconds above which a spike report is written into the 'spikes' folder, "
+                                "with the recent input events, profiler zones of the spike frame and renderer counters. "
+                                "0 to disable."};
+
+        Int SpikeTraceSeconds = {this, "spike_trace_seconds", 10, &ValidateSpikeTraceSeconds,
+                                 "Number of seconds of input events to include into spike reports."};
+
         // TODO(captainurist): move all Trace* options into a separate section.
 
         Int TraceFrameTimeMs = {this, "trace_frame_time_ms", 50, &ValidateFrameTime,
@@ -98,10 +114,21 @@ class GameConfig : public Config {
 
         Bool FullMonsterID = { this, "full_monster_id", false, "Full monster info on popup." };
 
+        Bool VerifyCharacterStatsCache = {this, "verify_character_stats_cache", false,
+                                          "Recompute cached character stats on each use and check them against the cached values."};
+
      private:
         static int ValidateFrameTime(int frameTime) {
             return std::max(frameTime, 1);
         }
+
+        static int ValidateSpikeThreshold(int threshold) {
+            return std::max(threshold, 0);
+        }
+
+        static int ValidateSpikeTraceSeconds(int seconds) {
+            return std::clamp(seconds, 1, 60);
+        }
     };
 
     Debug debug{ this };
@@ -110,6 +137,23 @@ class GameConfig : public Config {
      public:
         explicit Gameplay(GameConfig *config): ConfigSection(config, "gameplay") {}
 
+        Bool ActorLod = {this, "actor_lod", false,
+                         "Move monsters that are far away from the party outdoors at a reduced rate. Changes monster movement "
+                         "slightly, so traces recorded with this option on will only retrace with it on."};
+
+        Int ActorLodDistance = {this, "actor_lod_distance", 8192, &ValidateActorLodDistance,
+                                "Distance from the party after which monsters are moved at a reduced rate if actor_lod is on. "
+                                "Can't be less than 5120, the distance at which monsters can see the party."};
+
+        Int ActorLodInterval = {this, "actor_lod_interval", 8, &ValidateActorLodInterval,
+                                "Far away monsters are moved once in this many game ticks (128 ticks = 1 second), "
+                                "with each move covering all the time since the previous one."};
+
+        Bool ActorSleep = {this, "actor_sleep", false,
+                           "Stop updating the movement of idle monsters that are standing on flat ground outdoors further "
+                           "than actor_lod_distance from the party, until something disturbs them. Doesn't change monster "
+                           "behavior on its own, but changes it slightly when used together with actor_lod."};
+
         Bool AlternativeConditionPriorities = {this, "alternative_condition_priorities", true,
                                                "Use condition priorities from Grayface patches (e.g. Zombie has the lowest priority)."};
 
@@ -159,10 +203,20 @@ class GameConfig : public Config {
         Int NewGameGold = {this, "new_game_gold", 200, "Starting gold."};
         String StartingMap = String(this, "starting_map", "out01.odm", "New Game starting map.");
 
+        Bool ParallelActorTargeting = {this, "parallel_actor_targeting", false,
+                                       "Select targets for monsters in parallel, against the world state at the start of each AI "
+                                       "tick. Monsters might pick slightly different targets than in vanilla, so traces recorded "
+                                       "with this option on will only retrace with it on."};
+
         Int PartyEyeLevel = {this, "party_eye_level", 160, "Party eye level."};
         Int PartyHeight = {this, "party_height", 192, "Party height."};
         Int PartyWalkSpeed = {this, "party_walk_speed", 384, "Party walk speed."};
 
+        Bool PortalNavigation = {this, "portal_navigation", false,
+                                 "Make monsters indoors chase their targets through portals instead of walking straight at "
+                                 "them when they are in another room. Traces recorded with this option on will only "
+                                 "retrace with it on."};
+
         Int RangedAttackDepth = {this, "ranged_attack_depth", 5120, &ValidateRangedAttackDepth,
                                  "Max depth for ranged attacks and ranged spells. "
                                  "It's impossible to target monsters that are further away than this value. "
@@ -180,6 +234,12 @@ class GameConfig : public Config {
                                     "Show unidentified items with a green tint in inventory. "
                                     "If not set, vanilla behavior will be used with green tint applied in shops only."};
 
+        Int SimulationRate = {this, "simulation_rate", 0, &ValidateSimulationRate,
+                              "World simulation rate in steps per second, with party & monster positions interpolated "
+                              "between the steps when drawing. 0 means simulating once per rendered frame, as in "
+                              "vanilla. Game time has a 1/128s resolution, so the actual rate is 128 divided by a "
+                              "whole number, e.g. 60 gives 64 steps per second."};
+
         Bool TreatClubAsMace = {this, "treat_club_as_mace", false,
                                 "Treat clubs as maces. "
                                 "In vanilla clubs are using a separate hidden skill and can be equipped without learning the mace skill."};
@@ -203,6 +263,12 @@ class GameConfig : public Config {
                                        "Disable collisions between the party and monsters on the map. Mainly useful for debugging and tests."};
 
      private:
+        static int ValidateActorLodDistance(int distance) {
+            return std::clamp(distance, 5120, 65536);
+        }
+        static int ValidateActorLodInterval(int interval) {
+            return std::clamp(interval, 1, 64);
+        }
         static int ValidateMaxFlightHeight(int max_flight_height) {
             if (max_flight_height <= 0 || max_flight_height > 16192)
                 return 4000;
@@ -239,6 +305,9 @@ class GameConfig : public Config {
         static int ValidateQuickSaveCount(int num) {
             return std::clamp(num, 0, 4);
         }
+        static int ValidateSimulationRate(int rate) {
+            return rate <= 0 ? 0 : std::clamp(rate, 16, 128);
+        }
     };
 
     class Gamepad : public ConfigSection {
@@ -332,17 +401,47 @@ class GameConfig : public Config {
 
         ConfigEntry<RendererType> Renderer = {this, "renderer", ConfigRenderer, "Renderer to use, 'OpenGL' or 'OpenGLES'."};
 
+        Int AdaptiveQualityFps = {this, "adaptive_quality_fps", 0, &ValidateAdaptiveQualityFps,
+                                  "Target frame rate for adaptive quality. Weather density, particle density and "
+                                  "view distance are gradually lowered when the frame rate stays below the target, "
+                                  "and are restored once it recovers. Use 0 to disable."};
+
+        Int AdaptiveQualityMaxStep = {this, "adaptive_quality_max_step", 4, &ValidateAdaptiveQualityMaxStep,
+                                      "Floor quality for adaptive quality, as the number of quality steps it can go "
+                                      "down by. 0 keeps full quality, 4 keeps full view distance, 6 is the lowest."};
+
         Bool BloodSplats = {this, "bloodsplats", true, "Enable bloodsplats under corpses."};
 
         Float BloodSplatsMultiplier = {this, "bloodsplats_multiplier", 1.0f, "Bloodsplats radius multiplier."};
 
         Bool BloodSplatsFade = {this, "bloodsplats_fade", true, "Enable bloodsplats fading."};
 
+        Bool BuildingLods = {this, "building_lods", true,
+                             "Draw distant outdoor buildings with simplified meshes that are generated on map load."};
+
         Float ClipFarDistance = {this, "clip_far_distance", 16192.0f, "Far clip distance."};
         Float ClipNearDistance = {this, "clip_near_distance", 32.0f, "Near clip distance."};
 
         Bool ColoredLights = {this, "colored_lights", true, "Enable colored lights."};
 
+        Bool CompressTextures = {this, "compress_textures", false,
+                                 "Store world textures with precomputed mips in a compressed GPU format. Uses a lot "
+                                 "less video memory and reduces shimmering on distant surfaces. Compressed textures are "
+                                 "cached on disk. Has no effect if the GPU doesn't support S3TC."};
+
+        Int DynamicResolutionFps = {this, "dynamic_resolution_fps", 0, &ValidateDynamicResolutionFps,
+                                    "Target frame rate for dynamic resolution. The 3D view is rendered at a lower "
+                                    "resolution & upscaled when the frame rate drops below the target, UI is always "
+                                    "rendered at full resolution. Use 0 to disable."};
+
+        Float DynamicResolutionMinScale = {this, "dynamic_resolution_min_scale", 0.5f,
+                                           &ValidateDynamicResolutionMinScale,
+                                           "Lowest render scale of the 3D view that dynamic resolution can go down to."};
+
+        Float DynamicResolutionSharpness = {this, "dynamic_resolution_sharpness", 0.5f,
+                                            &ValidateDynamicResolutionSharpness,
+                                            "Sharpening applied when upscaling the 3D view, in [0, 1]."};
+
         Bool Fog = {this, "fog", true, "Enable fog effect. Used at far clip and in foggy weather."};
 
         Int FogHorizon = {this, "fog_horizon", 39, "Fog height for bottom sky horizon."};
@@ -351,22 +450,65 @@ class GameConfig : public Config {
 
         Int FPSLimit = {this, "fps_limit", 60, "FPS limit. Use 0 for unlimited."};
 
+        Bool FPSLimitToRefreshRate = {this, "fps_limit_refresh_rate", false,
+                                      "Limit FPS to just below the display refresh rate instead of using fps_limit. "
+                                      "Meant for variable refresh rate displays, keeps the frame rate inside the "
+                                      "VRR range without relying on vsync."};
+
         Int Gamma = {this, "gamma", 4, &ValidateGamma, "Gamma level, can be used to adjust brightness."};
 
+        Bool HardwareCursor = {this, "hardware_cursor", true,
+                               "Use the system cursor for the targeting & held item cursors instead of drawing them "
+                               "into the frame, so that they follow the mouse without a frame of delay. Cursors are "
+                               "still drawn into the frame if the system doesn't support color cursors."};
+
+        Bool HardwareVideoDecoding = {this, "hardware_video_decoding", false,
+                                      "Use hardware-accelerated video decoding if it's available. Original game "
+                                      "movies use codecs that don't have hardware decoders, so this only helps for "
+                                      "movies in modern formats."};
+
         Int HouseMovieX1 = {this, "house_movie_x1", 8, "Viewport top-left offset for in-house movies."};
         Int HouseMovieY1 = {this, "house_movie_y1", 8, "Viewport top-left offset for in-house movies."};
 
         Int HouseMovieX2 = {this, "house_movie_x2", 172, "Viewport bottom-right offset for in-house movies."};
         Int HouseMovieY2 = {this, "house_movie_y2", 128, "Viewport bottom-right offset for in-house movies."};
 
+        Bool LuaCache = {this, "lua_cache", true,
+                         "Cache compiled Lua UI templates on disk. Cached bytecode is rebuilt automatically when the "
+                         "templates change."};
+
         Int MaxVisibleSectors = {this, "maxvisiblesectors", 10, &ValidateMaxSectors, "Max number of BSP sectors to display."};
 
+        Int MaxFramesInFlight = {this, "max_frames_in_flight", 0, &ValidateMaxFramesInFlight,
+                                 "Max number of frames the CPU can run ahead of the GPU. Lower values reduce input "
+                                 "latency at the cost of some frame rate, 1 gives the lowest latency. Use 0 to leave "
+                                 "this to the graphics driver. Measured latency is shown with debug.show_fps."};
+
+        Int MaxParticles = {this, "max_particles", 500, &ValidateMaxParticles,
+                            "Max number of particles (spell effects, projectile trails) alive at the same time."};
+
+        Bool OcclusionCulling = {this, "occlusion_culling", true,
+                                 "Skip drawing outdoor buildings that are hidden behind terrain or other buildings. "
+                                 "Visibility is tested on the GPU with a one frame delay."};
+
         Bool SeasonsChange = {this, "seasons_change", true,
                               "Allow changing trees/ground depending on current season (originally was only used in MM6)."};
 
+        Bool ShaderCache = {this, "shader_cache", true,
+                            "Cache compiled shader programs on disk. Speeds up startup, cached programs are rebuilt "
+                            "automatically when shaders or graphics drivers change."};
+
         Bool Snow = {this, "snow", false,
                      "Snow effect from MM6 (where it was activated by events). Currently it shows every third day in winter."};
 
+        Int SnowDensity = {this, "snow_density", 1000, &ValidateSnowDensity,
+                           "Number of snow flakes on screen. Flakes are simulated on the GPU, so this has no CPU cost."};
+
+        Int TextureCacheSize = {this, "texture_cache_size", 512, &ValidateTextureCacheSize,
+                                "Memory budget for loaded textures & sprites, in megabytes, both in RAM and in video "
+                                "memory. Least recently used textures are unloaded once the budget is exceeded, and "
+                                "are reloaded when needed again."};
+
         Bool Tinting = {this, "tinting", false,
                         "Enable vanilla's monster coloring method from hardware mode. "
                         "Where monsters look as if a bucket of paint was thrown at them."};
@@ -377,6 +519,11 @@ class GameConfig : public Config {
         Int TorchlightFlicker = {this, "torchlight_flicker", 0, &ValidateTorchlight,
                                  "Torchlight lighting flicker effect distance. Use 0 to disable flicker."};
 
+        Int VideoMemoryBudget = {this, "video_memory_budget", 0, &ValidateVideoMemoryBudget,
+                                 "Video memory budget for textures & buffers, in megabytes, use 0 to rely on the "
+                                 "driver-reported free video memory only. Once it's exceeded, world textures are "
+                                 "switched to lower resolution mips."};
+
         Bool VSync = {this, "vsync", false, "Enable synchronization of framerate with monitor vertical refresh rate."};
 
         Int ViewPortX1 = {this, "viewport_x1", 8, "Viewport top-left offset."};
@@ -396,9 +543,39 @@ class GameConfig : public Config {
         static int ValidateGamma(int level) {
             return std::clamp(level, 0, 9);
         }
+        static int ValidateAdaptiveQualityFps(int fps) {
+            return std::clamp(fps, 0, 1000);
+        }
+        static int ValidateAdaptiveQualityMaxStep(int step) {
+            return std::clamp(step, 0, 6);
+        }
+        static int ValidateDynamicResolutionFps(int fps) {
+            return std::clamp(fps, 0, 1000);
+        }
+        static float ValidateDynamicResolutionMinScale(float scale) {
+            return std::clamp(scale, 0.25f, 1.0f);
+        }
+        static float ValidateDynamicResolutionSharpness(float sharpness) {
+            return std::clamp(sharpness, 0.0f, 1.0f);
+        }
         static int ValidateMaxSectors(int sectors) {
             return std::clamp(sectors, 1, 150);
         }
+        static int ValidateVideoMemoryBudget(int size) {
+            return std::clamp(size, 0, 65536);
+        }
+        static int ValidateTextureCacheSize(int size) {
+            return std::clamp(size, 64, 8192);
+        }
+        static int ValidateSnowDensity(int flakes) {
+            return std::clamp(flakes, 0, 100000);
+        }
+        static int ValidateMaxFramesInFlight(int frames) {
+            return std::clamp(frames, 0, 3);
+        }
+        static int ValidateMaxParticles(int particles) {
+            return std::clamp(particles, 100, 100000);
+        }
         static int ValidateTorchlight(int distance) {
             if (distance < 0)
                 return 0;
@@ -513,12 +690,33 @@ class GameConfig : public Config {
 
         Bool AlwaysRun = {this, "always_run", true, "Enable always run."};
 
+        Bool ChunkedSaves = {this, "chunked_saves", false,
+                             "Write saves in OpenEnroth chunked format. Map data that didn't change is shared between all "
+                             "the saves in a \"chunks\" subfolder of the saves folder, so saves are written faster and "
+                             "take up a lot less disk space. Vanilla can't load chunked saves, use LodTool assemble to "
+                             "convert them."};
+
+        Bool DecodeCache = {this, "decode_cache", false,
+                            "Cache decompressed game data on disk. Speeds up startup and map loading at the cost of "
+                            "some disk space."};
+
+        Bool TableCache = {this, "table_cache", true,
+                           "Cache parsed text tables on disk. Speeds up startup."};
+
+        Bool FastSaveCompression = {this, "fast_save_compression", false,
+                                    "Use the fastest compression level for map data in saves. Saves are written "
+                                    "faster, but take up more disk space. Saves stay compatible with vanilla."};
+
         Bool FlipOnExit = {this, "flip_on_exit", false, "Flip 180 degrees when leaving a building."};
 
         Bool ShowHits = {this, "show_hits", true, "Show HP status in status bar."};
 
         Int MusicLevel = {this, "music_level", 3, &ValidateLevel, "Music volume level."};
 
+        Int SoundCacheSize = {this, "sound_cache_size", 64, &ValidateSoundCacheSize,
+                              "Memory budget for decoded sounds, in megabytes. Least recently played sounds are "
+                              "unloaded once the budget is exceeded."};
+
         Int SoundLevel = {this, "sound_level", 4, &ValidateLevel, "Sound volume level."};
 
         Int VoiceLevel = {this, "voice_level", 5, &ValidateLevel, "Voice volume level."};
@@ -543,6 +741,9 @@ class GameConfig : public Config {
         static int ValidateTurnSpeed(int speed) {
             return std::clamp(speed, 0, 1024);
         }
+        static int ValidateSoundCacheSize(int size) {
+            return std::clamp(size, 1, 1024);
+        }
     };
 
     Settings settings{ this };
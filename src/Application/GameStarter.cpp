@@ -8,11 +8,15 @@
 #include "Engine/Engine.h"
 #include "Engine/EngineGlobals.h"
 #include "Engine/EngineIocContainer.h"
+#include "Engine/LoadProfiler.h"
+#include "Engine/SubsystemTimers.h"
 #include "Engine/Random/Random.h"
 #include "Engine/Graphics/Renderer/RendererFactory.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
+#include "Engine/Graphics/Renderer/RenderPrepTimers.h"
 #include "Engine/Graphics/Nuklear.h"
 #include "Engine/Graphics/NuklearEventHandler.h"
+#include "Engine/Components/Trace/EngineSpikeRecorder.h"
 #include "Engine/Components/Trace/EngineTracePlayer.h"
 #include "Engine/Components/Trace/EngineTraceRecorder.h"
 #include "Engine/Components/Trace/EngineTraceSimplePlayer.h"
@@ -21,6 +25,7 @@
 #include "Engine/Components/Control/EngineControlComponent.h"
 #include "Engine/Components/Control/EngineController.h"
 #include "Engine/Components/Deterministic/EngineDeterministicComponent.h"
+#include "Engine/Components/FastForward/EngineFastForwardComponent.h"
 #include "Engine/Components/Random/EngineRandomComponent.h"
 
 #include "Library/Environment/Interface/Environment.h"
@@ -28,6 +33,9 @@
 #include "Library/Logger/Logger.h"
 #include "Library/Logger/LogSink.h"
 #include "Library/Logger/BufferLogSink.h"
+#include "Library/Logger/AsyncLogSink.h"
+#include "Library/Profiler/Profiler.h"
+#include "Library/StackTrace/StackTraceOnCrash.h"
 #include "Library/Platform/Interface/Platform.h"
 #include "Library/Platform/Null/NullPlatform.h"
 
@@ -72,7 +80,13 @@ GameStarter::GameStarter(GameStarterOptions options): _options(std::move(options
     } else {
         _logger->setLevel(_config->debug.LogLevel.value());
     }
-    _logger->setSink(_defaultLogSink.get());
+    if (_config->debug.AsyncLog.value()) {
+        _asyncLogSink = std::make_unique<AsyncLogSink>(_defaultLogSink.get());
+        _logger->setSink(_asyncLogSink.get());
+        StackTraceOnCrash::setCrashCallback([sink = _asyncLogSink.get()] { sink->crashFlush(2); }); // 2 is stderr.
+    } else {
+        _logger->setSink(_defaultLogSink.get());
+    }
     _bufferLogSink->flush(_logger.get());
 
     // Create platform.
@@ -100,15 +114,43 @@ GameStarter::GameStarter(GameStarterOptions options): _options(std::move(options
     // and then trace component stores the updated value in a recorded `PaintEvent`.
     _application->installComponent(std::make_unique<GameKeyboardController>()); // This one should go before the window handler.
     _application->installComponent(std::make_unique<GameWindowHandler>());
+    _application->installComponent(std::make_unique<EngineFastForwardComponent>()); // Should go before all other OpenGL context proxies.
     _application->installComponent(std::make_unique<EngineControlComponent>());
     _application->installComponent(std::make_unique<EngineTraceSimpleRecorder>());
     _application->installComponent(std::make_unique<EngineTraceSimplePlayer>());
+    _application->installComponent(std::make_unique<EngineSpikeRecorder>());
     _application->installComponent(std::make_unique<EngineDeterministicComponent>());
     _application->installComponent(std::make_unique<EngineTraceRecorder>());
     _application->installComponent(std::make_unique<EngineTracePlayer>());
     _application->installComponent(std::make_unique<GameTraceHandler>());
     _application->installComponent(std::make_unique<EngineRandomComponent>());
     _application->component<EngineRandomComponent>()->setTracing(_options.tracingRng);
+    _application->component<EngineRandomComponent>()->setTracingTickRange(_options.tracingRngFirstTick,
+                                                                           _options.tracingRngLastTick);
+
+    // Init render prep timers - null renderer checks for these, so this should go before the renderer.
+    if (_options.renderPrep) {
+        _renderPrepTimers = std::make_unique<RenderPrepTimers>();
+        ::renderPrepTimers = _renderPrepTimers.get();
+    }
+
+    // Init subsystem timers.
+    if (_options.subsystemTimers) {
+        _subsystemTimers = std::make_unique<SubsystemTimers>();
+        ::subsystemTimers = _subsystemTimers.get();
+    }
+
+    // Init load profiler.
+    if (!_options.loadProfilePath.empty()) {
+        _loadProfiler = std::make_unique<LoadProfiler>();
+        ::loadProfiler = _loadProfiler.get();
+    }
+
+    // Init frame profiler, it's only there if zones are compiled in.
+    if constexpr (PROFILER_ENABLED) {
+        _profiler = std::make_unique<Profiler>();
+        ::profiler = _profiler.get();
+    }
 
     // Init renderer.
     _renderer = RendererFactory().createRenderer(_options.headless ? RENDERER_NULL : _config->graphics.Renderer.value(), _config);
@@ -135,24 +177,37 @@ GameStarter::GameStarter(GameStarterOptions options): _options(std::move(options
     _engine = std::make_unique<Engine>(_config);
     ::engine = _engine.get();
     _engine->Initialize();
+    _application->component<EngineDeterministicComponent>()->setThreadPool(_engine->_threadPool.get());
 
     // Init game.
     _game = std::make_unique<Game>(_application.get(), _config);
 }
 
 GameStarter::~GameStarter() {
+    _application->component<EngineDeterministicComponent>()->setThreadPool(nullptr); // Thread pool is owned by the engine.
     ::engine = nullptr;
 
     ::nuklear = nullptr;
 
     ::render = nullptr;
 
+    ::renderPrepTimers = nullptr;
+
+    ::subsystemTimers = nullptr;
+
+    ::loadProfiler = nullptr;
+
+    ::profiler = nullptr;
+
     ::application = nullptr;
     ::platform = nullptr;
     ::eventLoop = nullptr;
     ::window = nullptr;
     ::eventHandler = nullptr;
     ::openGLContext = nullptr;
+
+    if (_asyncLogSink)
+        StackTraceOnCrash::setCrashCallback(nullptr);
 }
 
 void GameStarter::resolvePaths(Environment *environment, GameStarterOptions* options, Logger *logger) {
@@ -189,6 +244,14 @@ void GameStarter::resolvePaths(Environment *environment, GameStarterOptions* opt
 void GameStarter::run() {
     _game->run();
 
+    if (_renderPrepTimers)
+        _renderPrepTimers->logSummary();
+
+    if (_loadProfiler) {
+        _loadProfiler->saveChromeTrace(_options.loadProfilePath);
+        logger->info("Level load profile '{}' saved!", _options.loadProfilePath);
+    }
+
     if (_options.useConfig) {
         _config->save(_options.configPath);
         logger->info("Configuration file '{}' saved!", _options.configPath);
@@ -8,6 +8,7 @@
 class Platform;
 class Environment;
 class Logger;
+class AsyncLogSink;
 class BufferLogSink;
 class LogSink;
 class PlatformApplication;
@@ -17,6 +18,10 @@ class Nuklear;
 class Engine;
 class Game;
 class EngineController;
+class RenderPrepTimers;
+class SubsystemTimers;
+class LoadProfiler;
+class Profiler;
 
 class GameStarter {
  public:
@@ -43,10 +48,15 @@ class GameStarter {
     std::unique_ptr<Environment> _environment;
     std::unique_ptr<BufferLogSink> _bufferLogSink;
     std::unique_ptr<LogSink> _defaultLogSink;
+    std::unique_ptr<AsyncLogSink> _asyncLogSink;
     std::unique_ptr<Logger> _logger;
     std::shared_ptr<GameConfig> _config;
     std::unique_ptr<Platform> _platform;
     std::unique_ptr<PlatformApplication> _application;
+    std::unique_ptr<RenderPrepTimers> _renderPrepTimers;
+    std::unique_ptr<SubsystemTimers> _subsystemTimers;
+    std::unique_ptr<LoadProfiler> _loadProfiler;
+    std::unique_ptr<Profiler> _profiler;
     std::unique_ptr<Renderer> _renderer;
     std::unique_ptr<Nuklear> _nuklear;
     std::unique_ptr<Engine> _engine;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <optional>
 
@@ -13,5 +15,10 @@ struct GameStarterOptions {
     std::string dataPath; // Path to game data, empty means use default.
     std::optional<LogLevel> logLevel; // Override log level.
     bool headless = false; // Run in headless mode.
+    bool renderPrep = false; // Time the CPU side of rendering & log a per-phase summary on exit.
+    bool subsystemTimers = false; // Time the game loop subsystems, see `SubsystemTimers`.
+    std::string loadProfilePath; // Save level load timeline here in Chrome trace format, see `LoadProfiler`. Empty means don't.
     bool tracingRng = false; // Use tracing random engine?
+    int64_t tracingRngFirstTick = 0; // First tick to trace random engine calls at, inclusive.
+    int64_t tracingRngLastTick = std::numeric_limits<int64_t>::max(); // Last tick to trace random engine calls at.
 };
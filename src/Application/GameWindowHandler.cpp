@@ -49,7 +49,12 @@ static char PlatformKeyToChar(PlatformKey key, PlatformModifiers mods) {
 }
 
 
-GameWindowHandler::GameWindowHandler() : PlatformEventFilter(EVENTS_ALL) {
+GameWindowHandler::GameWindowHandler() : PlatformEventFilter({
+    EVENT_KEY_PRESS, EVENT_KEY_RELEASE, EVENT_MOUSE_BUTTON_PRESS, EVENT_MOUSE_BUTTON_RELEASE, EVENT_MOUSE_MOVE,
+    EVENT_MOUSE_WHEEL, EVENT_WINDOW_MOVE, EVENT_WINDOW_RESIZE, EVENT_WINDOW_ACTIVATE, EVENT_WINDOW_DEACTIVATE,
+    EVENT_WINDOW_CLOSE_REQUEST, EVENT_GAMEPAD_CONNECTED, EVENT_GAMEPAD_DISCONNECTED, EVENT_GAMEPAD_KEY_PRESS,
+    EVENT_GAMEPAD_KEY_RELEASE, EVENT_GAMEPAD_AXIS
+}) {
     this->mouse = EngineIocContainer::ResolveMouse();
 }
 
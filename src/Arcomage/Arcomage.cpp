@@ -1,4 +1,5 @@
 #include "Arcomage/Arcomage.h"
+#include "Arcomage/ArcomageRules.h"
 
 #include "Engine/EngineGlobals.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
@@ -16,9 +17,6 @@
 #include "Media/Audio/AudioPlayer.h"
 #include "Media/MediaPlayer.h"
 
-
-#include "Utility/IndexedArray.h"
-
 void SetStartConditions();
 void SetStartGameData();
 void FillPlayerDeck();
@@ -28,8 +26,6 @@ int GetEmptyCardSlotIndex(int player_num);
 void IncreaseResourcesInTurn(int player_num);
 void TurnChange();
 bool IsGameOver();
-int CalculateCardPower(ArcomagePlayer *player, ArcomagePlayer *enemy,
-                       ArcomageCard *pCard, int mastery);
 char PlayerTurn(int player_num);
 void DrawGameUI(int animation_stage);
 void DrawSparks();
@@ -50,42 +46,11 @@ bool PlayCard(int player_num, int card_slot_num);
 bool CanCardBePlayed(int player_num, int hand_card_indx);
 void ApplyCardToPlayer(int player_num, unsigned int uCardID);
 int new_explosion_effect(Pointi *startXY, int effect_value);
-int ApplyDamageToBuildings(int player_num, int damage);
 void GameResultsApply();
 
 void am_DrawText(const std::string &str, Pointi *pXY);
 void DrawRect(Recti *pRect, Color uColor, char bSolidFill);
 
-struct ArcomageStartConditions {
-    int16_t max_tower;
-    int16_t max_resources;
-    int16_t tower_height;
-    int16_t wall_height;
-    int16_t quarry_level;
-    int16_t magic_level;
-    int16_t zoo_level;
-    int16_t bricks_amount;
-    int16_t gems_amount;
-    int16_t beasts_amount;
-    int mastery_lvl;
-};
-
-IndexedArray<ArcomageStartConditions, HOUSE_FIRST_ARCOMAGE_TAVERN, HOUSE_LAST_ARCOMAGE_TAVERN> start_conditions = {
-    {HOUSE_TAVERN_HARMONDALE,       {30, 100, 15, 5, 2, 2, 2, 10, 10, 10, 0}},
-    {HOUSE_TAVERN_ERATHIA,          {50, 150, 20, 5, 2, 2, 2, 5, 5, 5, 1}},
-    {HOUSE_TAVERN_TULAREAN_FOREST,  {50, 150, 20, 5, 2, 2, 2, 5, 5, 5, 2}},
-    {HOUSE_TAVERN_DEYJA,            {75, 200, 25, 10, 3, 3, 3, 5, 5, 5, 2}},
-    {HOUSE_TAVERN_BRACADA_DESERT,   {75, 200, 20, 10, 3, 3, 3, 5, 5, 5, 1}},
-    {HOUSE_TAVERN_CELESTE,          {100, 300, 30, 15, 4, 4, 4, 10, 10, 10, 1}},
-    {HOUSE_TAVERN_PIT,              {100, 300, 30, 15, 4, 4, 4, 10, 10, 10, 2}},
-    {HOUSE_TAVERN_EVENMORN_ISLAND,  {150, 400, 20, 10, 5, 5, 5, 25, 25, 25, 0}},
-    {HOUSE_TAVERN_MOUNT_NIGHON,     {200, 500, 20, 10, 1, 1, 1, 15, 15, 15, 2}},
-    {HOUSE_TAVERN_BARROW_DOWNS,     {100, 300, 20, 50, 1, 1, 5, 5, 5, 25, 0}},
-    {HOUSE_TAVERN_TATALIA,          {125, 350, 10, 20, 3, 1, 2, 15, 5, 10, 2}},
-    {HOUSE_TAVERN_AVLEE,            {125, 350, 10, 20, 3, 1, 2, 15, 5, 10, 1}},
-    {HOUSE_TAVERN_STONE_CITY,       {100, 300, 50, 50, 5, 3, 5, 20, 10, 20, 0}}
-};
-
 constexpr auto SIG_MEMALOC = 0x67707274;  // memory allocated;
 constexpr auto SIG_MEMFREE = 0x78787878;  // memory free;
 
@@ -101,13 +66,6 @@ ArcomageDeck deckMaster;
 char Player2Name[] = "Enemy";
 char Player1Name[] = "Player";
 
-struct am_ai_cardpowerstruct {
-    int slot_index;
-    int card_power;
-};
-
-am_ai_cardpowerstruct cards_power[10];
-
 bool Player_Gets_First_Turn = true;  // who starts the game
 bool Player_Cards_Shift = true;  // shifts the cards round at the bottom of the screen so they arent all level
 char use_start_bonus = 1;
@@ -565,312 +523,20 @@ bool ArcomageGame::LoadSprites() {
     return true;
 }
 
-int CalculateCardPower(ArcomagePlayer *player, ArcomagePlayer *enemy,
-                       ArcomageCard *pCard, int mastery) {
-    enum class V_IND {
-        P_TOWER_M10,
-        P_WALL_M10,
-        E_TOWER,
-        E_WALL,
-        E_BUILDINGS,
-        E_QUARRY,
-        E_MAGIC,
-        E_ZOO,
-        E_RES
-    };
-    using enum V_IND;
-
-    // mastery coeffs
-    // base mastery focus on growing walls + tower
-    // second level high priority on resource gen
-    static constexpr IndexedArray<std::array<int, 2>, P_TOWER_M10, E_RES> mastery_coeff = {
-        {P_TOWER_M10,   {{10, 5}}},
-        {P_WALL_M10,    {{2, 1}}},
-        {E_TOWER,       {{1, 10}}},
-        {E_WALL,        {{1, 3}}},
-        {E_BUILDINGS,   {{1, 7}}},
-        {E_QUARRY,      {{1, 5}}},
-        {E_MAGIC,       {{1, 40}}},
-        {E_ZOO,         {{1, 40}}},
-        {E_RES,         {{1, 2}}}
-    };
-
-    int card_power = 0;
-    int element_power = 0;
-
-    if (pCard->to_player_tower == 99 || pCard->to_pl_enm_tower == 99 ||
-        pCard->to_player_tower2 == 99 || pCard->to_pl_enm_tower2 == 99) {
-        element_power = enemy->tower_height - player->tower_height;
-    } else {
-        element_power = pCard->to_player_tower + pCard->to_pl_enm_tower +
-                        pCard->to_player_tower2 + pCard->to_pl_enm_tower2;
-    }
-
-    if (player->tower_height >= 10) {
-        card_power += mastery_coeff[P_TOWER_M10][mastery] * element_power;
-    } else {
-        card_power += 20 * element_power;
-    }
-
-    if (pCard->to_player_wall == 99 || pCard->to_pl_enm_wall == 99 ||
-        pCard->to_player_wall2 == 99 || pCard->to_pl_enm_wall2 == 99) {
-        element_power = enemy->wall_height - player->wall_height;
-    } else {
-        element_power = pCard->to_player_wall + pCard->to_pl_enm_wall +
-                        pCard->to_player_wall2 + pCard->to_pl_enm_wall2;
-    }
-
-    if (player->wall_height >= 10) {
-        card_power += mastery_coeff[P_WALL_M10][mastery] * element_power;  // 1
-    } else {
-        card_power += 5 * element_power;
-    }
-
-    card_power +=
-        7 * (pCard->to_player_buildings + pCard->to_pl_enm_buildings +
-             pCard->to_player_buildings2 + pCard->to_pl_enm_buildings2);
-
-    if (pCard->to_player_quarry_lvl == 99 ||
-        pCard->to_pl_enm_quarry_lvl == 99 ||
-        pCard->to_player_quarry_lvl2 == 99 ||
-        pCard->to_pl_enm_quarry_lvl2 == 99) {
-        element_power = enemy->quarry_level - player->quarry_level;
-    } else {
-        element_power =
-            pCard->to_player_quarry_lvl + pCard->to_pl_enm_quarry_lvl +
-            pCard->to_player_quarry_lvl2 + pCard->to_pl_enm_quarry_lvl;
-    }
-
-    card_power += 40 * element_power;
-
-    if (pCard->to_player_magic_lvl == 99 || pCard->to_pl_enm_magic_lvl == 99 ||
-        pCard->to_player_magic_lvl2 == 99 ||
-        pCard->to_pl_enm_magic_lvl2 == 99) {
-        element_power = enemy->magic_level - player->magic_level;
-    } else {
-        element_power =
-            pCard->to_player_magic_lvl + pCard->to_pl_enm_magic_lvl +
-            pCard->to_player_magic_lvl2 + pCard->to_pl_enm_magic_lvl2;
-    }
-    card_power += 40 * element_power;
-
-    if (pCard->to_player_zoo_lvl == 99 || pCard->to_pl_enm_zoo_lvl == 99 ||
-        pCard->to_player_zoo_lvl2 == 99 || pCard->to_pl_enm_zoo_lvl2 == 99) {
-        element_power = enemy->zoo_level - player->zoo_level;
-    } else {
-        element_power = pCard->to_player_zoo_lvl + pCard->to_pl_enm_zoo_lvl +
-                        pCard->to_player_zoo_lvl2 + pCard->to_pl_enm_zoo_lvl2;
-    }
-    card_power += 40 * element_power;
-
-    if (pCard->to_player_bricks == 99 || pCard->to_pl_enm_bricks == 99 ||
-        pCard->to_player_bricks2 == 99 || pCard->to_pl_enm_bricks2 == 99) {
-        element_power = enemy->resource_bricks - player->resource_bricks;
-    } else {
-        element_power = pCard->to_player_bricks + pCard->to_pl_enm_bricks +
-                        pCard->to_player_bricks2 + pCard->to_pl_enm_bricks2;
-    }
-    card_power += 2 * element_power;
-
-    if (pCard->to_player_gems == 99 || pCard->to_pl_enm_gems == 99 ||
-        pCard->to_player_gems2 == 99 || pCard->to_pl_enm_gems2 == 99) {
-        element_power = enemy->resource_gems - player->resource_gems;
-    } else {
-        element_power = pCard->to_player_gems + pCard->to_pl_enm_gems +
-                        pCard->to_player_gems2 + pCard->to_pl_enm_gems2;
-    }
-    card_power += 2 * element_power;
-
-    if (pCard->to_player_beasts == 99 || pCard->to_pl_enm_beasts == 99 ||
-        pCard->to_player_beasts2 == 99 || pCard->to_pl_enm_beasts2 == 99) {
-        element_power = enemy->resource_beasts - player->resource_beasts;
-    } else {
-        element_power = pCard->to_player_beasts + pCard->to_pl_enm_beasts +
-                        pCard->to_player_beasts2 + pCard->to_pl_enm_beasts2;
-    }
-    card_power += 2 * element_power;
-
-    if (pCard->to_enemy_tower == 99 || pCard->to_enemy_tower2 == 99) {
-        element_power = player->tower_height - enemy->tower_height;
-    } else {
-        element_power = -(pCard->to_enemy_tower + pCard->to_enemy_tower2);
-    }
-    card_power += mastery_coeff[E_TOWER][mastery] * element_power;
-
-    if (pCard->to_enemy_wall == 99 || pCard->to_enemy_wall2 == 99) {
-        element_power = player->wall_height - enemy->wall_height;
-    } else {
-        element_power = -(pCard->to_enemy_wall + pCard->to_enemy_wall2);
-    }
-    card_power += mastery_coeff[E_WALL][mastery] * element_power;
-
-    card_power -= mastery_coeff[E_BUILDINGS][mastery] *
-                  (pCard->to_enemy_buildings + pCard->to_enemy_buildings2);
-
-    if (pCard->to_enemy_quarry_lvl == 99 || pCard->to_enemy_quarry_lvl2 == 99) {
-        element_power = player->quarry_level - enemy->quarry_level;  // 5
-    } else {
-        element_power =
-            -(pCard->to_enemy_quarry_lvl + pCard->to_enemy_quarry_lvl2);  // 5
-    }
-    card_power += mastery_coeff[E_QUARRY][mastery] * element_power;
-
-    if (pCard->to_enemy_magic_lvl == 99 || pCard->to_enemy_magic_lvl2 == 99) {
-        element_power = player->magic_level - enemy->magic_level;  // 40
-    } else {
-        element_power =
-            -(pCard->to_enemy_magic_lvl + pCard->to_enemy_magic_lvl2);
-    }
-    card_power += mastery_coeff[E_MAGIC][mastery] * element_power;
-
-    if (pCard->to_enemy_zoo_lvl == 99 || pCard->to_enemy_zoo_lvl2 == 99) {
-        element_power = player->zoo_level - enemy->zoo_level;  // 40
-    } else {
-        element_power = -(pCard->to_enemy_zoo_lvl + pCard->to_enemy_zoo_lvl2);
-    }
-    card_power += mastery_coeff[E_ZOO][mastery] * element_power;
-
-    if (pCard->to_enemy_bricks == 99 || pCard->to_enemy_bricks2 == 99) {
-        element_power = player->resource_bricks - enemy->resource_bricks;  // 2
-    } else {
-        element_power = -(pCard->to_enemy_bricks + pCard->to_enemy_bricks2);
-    }
-    card_power += mastery_coeff[E_RES][mastery] * element_power;
-
-    if (pCard->to_enemy_gems == 99 || pCard->to_enemy_gems2 == 99) {
-        element_power = player->resource_gems - enemy->resource_gems;  // 2
-    } else {
-        element_power = -(pCard->to_enemy_gems + pCard->to_enemy_gems2);
-    }
-    card_power += mastery_coeff[E_RES][mastery] * element_power;
-
-    if (pCard->to_enemy_beasts == 99 || pCard->to_enemy_beasts2 == 99) {
-        element_power = player->resource_beasts - enemy->resource_beasts;  // 2
-    } else {
-        element_power = -(pCard->to_enemy_beasts + pCard->to_enemy_beasts2);
-    }
-    card_power += mastery_coeff[E_RES][mastery] * element_power;
-
-    if (pCard->field_30 || pCard->field_4D) {
-        card_power *= 10;
-    }
-
-    if (pCard->card_resource_type == 1) {
-        element_power = player->resource_bricks - pCard->needed_bricks;
-    } else if (pCard->card_resource_type == 2) {
-        element_power = player->resource_gems - pCard->needed_gems;
-    } else if (pCard->card_resource_type == 3) {
-        element_power = player->resource_beasts - pCard->needed_beasts;
-    }
-    if (element_power > 3) {
-        element_power = 3;
-    }
-    card_power += 5 * element_power;
-
-    if (enemy->tower_height <= pCard->to_enemy_tower2 + pCard->to_enemy_tower) {
-        card_power += 9999;
-    }
-
-    if (pCard->to_enemy_tower2 + pCard->to_enemy_tower + pCard->to_enemy_wall +
-            pCard->to_enemy_wall2 + pCard->to_enemy_buildings +
-            pCard->to_enemy_buildings2 >=
-        enemy->wall_height + enemy->tower_height) {
-        card_power += 9999;
-    }
-
-    if ((pCard->to_player_tower2 + pCard->to_pl_enm_tower2 +
-         pCard->to_player_tower + pCard->to_pl_enm_tower +
-         player->tower_height) >= max_tower_height) {
-        card_power += 9999;
-    }
-
-    return card_power;
-}
-
 bool OpponentsAITurn(int player_num) {
     assert(player_num != 0);
 
-    int ai_player_cards_count = GetPlayerHandCardCount(player_num);
-    if (ai_player_cards_count == 0) return true;
+    if (GetPlayerHandCardCount(player_num) == 0) return true;
 
     // opponent_mastery = 2; // testing
 
     opponents_turn = 1;
-    if (opponent_mastery == 0) {
-        // select card at random to play
-        int random_card_slot;
-        if (need_to_discard_card == 0) {
-            for (int i = 0; i < 10; ++i) {
-                random_card_slot = grng->randomInSegment(0, ai_player_cards_count - 1);
-                if (CanCardBePlayed(player_num, random_card_slot))
-                    return PlayCard(player_num, random_card_slot);
-            }
-        }
-
-        // if that fails discard card at random
-        random_card_slot = grng->randomInSegment(0, ai_player_cards_count - 1);
-        return DiscardCard(player_num, random_card_slot);
+    ArcomageMove move = chooseArcomageMove(am_Players[player_num], am_Players[(player_num + 1) % 2], opponent_mastery,
+                                           need_to_discard_card, max_tower_height, grng);
+    if (move.slot == -1) return true;
 
-    } else if ((opponent_mastery == 1) || (opponent_mastery == 2)) {
-        // apply some cunning
-        ArcomagePlayer *player = &am_Players[player_num];
-        ArcomagePlayer *enemy = &am_Players[(player_num + 1) % 2];
-
-        // wipe cards power array - set negative for unfilled card slots
-        for (int i = 0; i < 10; ++i) {
-            if (i >= ai_player_cards_count) {
-                cards_power[i].slot_index = -1;
-                cards_power[i].card_power = -9999;
-            } else {
-                cards_power[i].slot_index = i;
-                cards_power[i].card_power = 0;
-            }
-        }
-
-        // calculate how effective each card would be
-        for (int i = 0; i < ai_player_cards_count; ++i) {
-            ArcomageCard *calc_card = &pCards[am_Players[player_num].cards_at_hand[cards_power[i].slot_index]];
-            cards_power[i].card_power =
-                CalculateCardPower(player, enemy, calc_card, opponent_mastery - 1);
-        }
-
-        // bubble sort the card powers in order
-        for (int j = ai_player_cards_count - 1; j >= 0; --j) {
-            for (int m = 0; m < j; ++m) {
-                if (cards_power[m].card_power < cards_power[m + 1].card_power) {
-                    int tempslot = cards_power[m].slot_index;
-                    int temppow = cards_power[m].card_power;
-                    cards_power[m].slot_index = cards_power[m + 1].slot_index;
-                    cards_power[m].card_power = cards_power[m + 1].card_power;
-                    cards_power[m + 1].slot_index = tempslot;
-                    cards_power[m + 1].card_power = temppow;
-                }
-            }
-        }
-
-        // if we have to discard pick the least powerful to chuck
-        int discard_slot = 0;
-        for (int i = ai_player_cards_count - 1; i; --i) {
-            if (i >= 0) {
-                if (pCards[am_Players[player_num].cards_at_hand[cards_power[i].slot_index]].can_be_discarded) {
-                    discard_slot = cards_power[i].slot_index;
-                }
-            }
-        }
-
-        if (!need_to_discard_card) {
-            // try and play most powerful card
-            for (int i = 0; i < ai_player_cards_count - 1; ++i) {
-                if (CanCardBePlayed(player_num, cards_power[i].slot_index) && cards_power[i].card_power) {
-                    return PlayCard(player_num, cards_power[i].slot_index);
-                }
-            }
-        }
-
-        // fall back - have to discard
-        return DiscardCard(player_num, discard_slot);
-    }
-    return true;  // result != 0;
+    if (move.discard) return DiscardCard(player_num, move.slot);
+    return PlayCard(player_num, move.slot);
 }
 
 void ArcomageGame::Loop() {
@@ -999,11 +665,6 @@ void ArcomageGame::Loop() {
 }
 
 void SetStartGameData() {
-    signed int j;                       // edx@7
-    int card_id_counter;                // edx@13
-    signed int i;                       // ecx@13
-    signed int card_dispenser_counter;  // eax@13
-
     SetStartConditions();
 
     current_player_num = !Player_Gets_First_Turn;
@@ -1012,7 +673,7 @@ void SetStartGameData() {
     am_Players[0].pPlayerName = pArcomageGame->pPlayer1Name;
     am_Players[0].IsHisTurn = 1;  // Player_Gets_First_Turn;
 
-    for (i = 0; i < 2; ++i) {
+    for (int i = 0; i < 2; ++i) {
         am_Players[i].tower_height = start_tower_height;
         am_Players[i].wall_height = start_wall_height;
         am_Players[i].quarry_level = start_quarry_level;
@@ -1022,7 +683,7 @@ void SetStartGameData() {
         am_Players[i].resource_gems = start_gems_amount;
         am_Players[i].resource_beasts = start_beasts_amount;
 
-        for (j = 0; j < 10; ++j) {
+        for (int j = 0; j < 10; ++j) {
             am_Players[i].cards_at_hand[j] = -1;
             if (Player_Cards_Shift) {
                 am_Players[i].card_shift[j].x = -1;
@@ -1033,77 +694,13 @@ void SetStartGameData() {
             }
         }
     }
-    deckMaster.name = "Master Deck";
-    for (i = 0, card_dispenser_counter = -2, card_id_counter = 0; i < DECK_SIZE;
-         ++i, ++card_dispenser_counter) {
-        deckMaster.cardsInUse[i] = 0;
-        deckMaster.cards_IDs[i] = card_id_counter;
-        switch (card_dispenser_counter) {
-            case 0:
-            case 2:
-            case 6:
-            case 9:
-            case 13:
-            case 18:
-            case 23:
-            case 33:
-            case 36:
-            case 38:
-            case 44:
-            case 46:
-            case 52:
-            case 57:
-            case 69:
-            case 71:
-            case 75:
-            case 79:
-            case 81:
-            case 84:
-            case 89:
-                break;
-            default:
-                ++card_id_counter;
-        }
-    }
+    initArcomageMasterDeck(&deckMaster);
     FillPlayerDeck();
 }
 
 void FillPlayerDeck() {
-    int m;
-    int rand_deck_pos = 0;
-    char card_taken_flags[DECK_SIZE];
-    int i, j;
-
     ArcomageGame::playSound(20);
-    memset(deckMaster.cardsInUse, 0, DECK_SIZE);
-    memset(card_taken_flags, 0, DECK_SIZE);
-
-    for (i = 0; i < 2; ++i) {
-        for (j = 0; j < 10; ++j) {
-            if (am_Players[i].cards_at_hand[j] > -1) {
-                for (m = 0; m < DECK_SIZE; ++m) {
-                    if (deckMaster.cards_IDs[m] ==
-                            am_Players[i].cards_at_hand[j] &&
-                        deckMaster.cardsInUse[m] == 0) {
-                        // mark which cards are already in players hands
-                        deckMaster.cardsInUse[m] = 1;
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    for (i = 0; i < DECK_SIZE; ++i) {
-        do {
-            rand_deck_pos = grng->random(DECK_SIZE);
-        } while (card_taken_flags[rand_deck_pos] == 1);
-
-        card_taken_flags[rand_deck_pos] = 1;
-        playDeck.cards_IDs[i] = deckMaster.cards_IDs[rand_deck_pos];
-        playDeck.cardsInUse[i] = deckMaster.cardsInUse[rand_deck_pos];
-    }
-
+    shuffleArcomageDeck(&playDeck, &deckMaster, am_Players, grng);
     deck_walk_index = 0;
 }
 
@@ -1116,28 +713,12 @@ void InitalHandsFill() {
 }
 
 void GetNextCardFromDeck(int player_num) {
-    signed int deck_index;      // eax@1
-    int new_card_id;            // edi@1
-    signed int card_slot_indx;  // eax@7
-
-    deck_index = deck_walk_index;
-    for (;;) {
-        if (deck_index >= DECK_SIZE) {
-            FillPlayerDeck();
-            deck_index = deck_walk_index = 0;
-        }
-        if (!playDeck.cardsInUse[deck_index]) {
-            new_card_id = playDeck.cards_IDs[deck_index];
-            ++deck_index;
-            deck_walk_index = deck_index;
-            break;
-        }
-        ++deck_index;
-        deck_walk_index = deck_index;
-    }
+    int prev_deck_walk_index = deck_walk_index;
+    int new_card_id = drawArcomageCard(&playDeck, &deckMaster, &deck_walk_index, am_Players, grng);
+    if (deck_walk_index <= prev_deck_walk_index) ArcomageGame::playSound(20);  // deck was reshuffled
 
     ArcomageGame::playSound(21);
-    card_slot_indx = GetEmptyCardSlotIndex(player_num);
+    int card_slot_indx = GetEmptyCardSlotIndex(player_num);
     if (card_slot_indx != -1) {
         drawn_card_slot_index = card_slot_indx;
         am_Players[player_num].cards_at_hand[card_slot_indx] = new_card_id;
@@ -1149,11 +730,7 @@ void GetNextCardFromDeck(int player_num) {
 }
 
 int GetEmptyCardSlotIndex(int player_num) {
-    // find first empty card slot
-    for (int i = 0; i < 10; ++i) {
-        if (am_Players[player_num].cards_at_hand[i] == -1) return i;
-    }
-    return -1;
+    return arcomageEmptyHandSlot(am_Players[player_num]);
 }
 
 void IncreaseResourcesInTurn(int player_num) {
@@ -1180,18 +757,7 @@ void TurnChange() {
 }
 
 bool IsGameOver() {
-    // check if victory conditions have been met
-    bool result = false;
-    for (int i = 0; i < 2; ++i) {
-        if (am_Players[i].tower_height <= 0) result = true;
-        if (am_Players[i].tower_height >= max_tower_height) result = true;
-        if (am_Players[i].resource_bricks >= max_resources_amount ||
-            am_Players[i].resource_gems >= max_resources_amount ||
-            am_Players[i].resource_beasts >= max_resources_amount)
-            result = true;
-    }
-
-    return result;
+    return isArcomageGameOver(am_Players, max_tower_height, max_resources_amount);
 }
 
 char PlayerTurn(int player_num) {
@@ -1998,12 +1564,7 @@ void ArcomageGame::GetCardRect(unsigned int uCardID, Recti *pCardRect) {
 }
 
 int GetPlayerHandCardCount(int player_num) {
-    int card_count = 0;
-    for (int i = 0; i < 10; ++i) {
-        if (am_Players[player_num].cards_at_hand[i] != -1) ++card_count;
-    }
-
-    return card_count;
+    return arcomageHandCardCount(am_Players[player_num]);
 }
 
 signed int DrawCardsRectangles(int player_num) {
@@ -2122,9 +1683,7 @@ bool PlayCard(int player_num, int card_slot_num) {
         // play sound and take resource cost
         ArcomageCard *pCard = &pCards[am_Players[player_num].cards_at_hand[card_slot_num]];
         ArcomageGame::playSound(23);
-        am_Players[player_num].resource_bricks -= pCard->needed_bricks;
-        am_Players[player_num].resource_beasts -= pCard->needed_beasts;
-        am_Players[player_num].resource_gems -= pCard->needed_gems;
+        payArcomageCardCost(&am_Players[player_num], *pCard);
 
         // set anim card and remove from player
         played_card_id = am_Players[player_num].cards_at_hand[card_slot_num];
@@ -2138,703 +1697,261 @@ bool PlayCard(int player_num, int card_slot_num) {
 }
 
 bool CanCardBePlayed(int player_num, int hand_card_indx) {
-    bool result = true;
-    ArcomagePlayer *pPlayer = &am_Players[player_num];
-    ArcomageCard *test_card = &pCards[pPlayer->cards_at_hand[hand_card_indx]];
-
-    // test card conditions
-    if (test_card->needed_quarry_level > pPlayer->quarry_level) result = false;
-    if (test_card->needed_magic_level > pPlayer->magic_level) result = false;
-    if (test_card->needed_zoo_level > pPlayer->zoo_level) result = false;
-    if (test_card->needed_bricks > pPlayer->resource_bricks) result = false;
-    if (test_card->needed_gems > pPlayer->resource_gems) result = false;
-    if (test_card->needed_beasts > pPlayer->resource_beasts) result = false;
-
-    return result;
+    return canPlayArcomageCard(am_Players[player_num], pCards[am_Players[player_num].cards_at_hand[hand_card_indx]]);
 }
 
 void ApplyCardToPlayer(int player_num, unsigned int uCardID) {
-#define APPLY_TO_PLAYER(PLAYER, ENEMY, FIELD, VAL, RES)   \
-    if (VAL != 0) {                                       \
-        if (VAL == 99) {                                  \
-            if (PLAYER->FIELD < ENEMY->FIELD) {           \
-                PLAYER->FIELD = ENEMY->FIELD;             \
-                RES = ENEMY->FIELD - PLAYER->FIELD;       \
-            }                                             \
-        } else {                                          \
-            PLAYER->FIELD += (signed int)(VAL);           \
-            if (PLAYER->FIELD < 0) PLAYER->FIELD = 0;     \
-            RES = (signed int)(VAL);                      \
-        }                                                 \
-    }
+    ArcomagePlayer *player = &am_Players[player_num];
+    ArcomagePlayer *enemy = &am_Players[(player_num + 1) % 2];
+    const ArcomageCard &card = pCards[uCardID];
 
-#define APPLY_TO_ENEMY(PLAYER, ENEMY, FIELD, VAL, RES) \
-    APPLY_TO_PLAYER(ENEMY, PLAYER, FIELD, VAL, RES)
-
-#define APPLY_TO_BOTH(PLAYER, ENEMY, FIELD, VAL, RES_P, RES_E) \
-    if (VAL != 0) {                                            \
-        if (VAL == 99) {                                       \
-            if (PLAYER->FIELD != ENEMY->FIELD) {               \
-                if (PLAYER->FIELD <= ENEMY->FIELD) {           \
-                    PLAYER->FIELD = ENEMY->FIELD;              \
-                    RES_P = ENEMY->FIELD - PLAYER->FIELD;      \
-                } else {                                       \
-                    ENEMY->FIELD = PLAYER->FIELD;              \
-                    RES_E = PLAYER->FIELD - ENEMY->FIELD;      \
-                }                                              \
-            }                                                  \
-        } else {                                               \
-            PLAYER->FIELD += (signed int)(VAL);                \
-            ENEMY->FIELD += (signed int)(VAL);                 \
-            if (PLAYER->FIELD < 0) {                           \
-                PLAYER->FIELD = 0;                             \
-            }                                                  \
-            if (ENEMY->FIELD < 0) {                            \
-                ENEMY->FIELD = 0;                              \
-            }                                                  \
-            RES_P = (signed int)(VAL);                         \
-            RES_E = (signed int)(VAL);                         \
-        }                                                      \
-    }
+    bool primary = isArcomageCardPrimary(*player, *enemy, card);
+    num_actions_left = arcomageCardActionCount(card, primary);
+    num_cards_to_discard = arcomageCardDrawCount(card, primary);
+    for (int i = 0; i < num_cards_to_discard; i++)
+        GetNextCardFromDeck(player_num);
 
-    ArcomagePlayer *player = &am_Players[player_num];
-    int enemy_num = ((player_num + 1) % 2);
-    ArcomagePlayer *enemy = &am_Players[enemy_num];
-    ArcomageCard *pCard = &pCards[uCardID];
-
-    int buildings_e = 0;
-    int buildings_p = 0;
-    int dmg_e = 0;
-    int dmg_p = 0;
-    int tower_e = 0;
-    int tower_p = 0;
-    int wall_e = 0;
-    int wall_p = 0;
-
-    int beasts_e = 0;
-    int beasts_p = 0;
-    int gems_e = 0;
-    int gems_p = 0;
-    int bricks_e = 0;
-    int bricks_p = 0;
-    int zoo_e = 0;
-    int zoo_p = 0;
-    int magic_e = 0;
-    int magic_p = 0;
-    int quarry_e = 0;
-    int quarry_p = 0;
-
-    switch (pCard->compare_param) {
-        case CHECK_LESSER_QUARRY : // Mother Lode & Copping the Tech
-            if (player->quarry_level < enemy->quarry_level)
-                goto desired_effects;
-            goto secondary_effects;
-        case CHECK_LESSER_MAGIC: // Parity
-            if (player->magic_level < enemy->magic_level) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_LESSER_ZOO:
-            if (player->zoo_level < enemy->zoo_level) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_EQUAL_QUARRY:
-            if (player->quarry_level == enemy->quarry_level) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_EQUAL_MAGIC:
-            if (player->magic_level == enemy->magic_level) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_EQUAL_ZOO:
-            if (player->zoo_level == enemy->zoo_level) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_GREATER_QUARRY:
-            if (player->quarry_level > enemy->quarry_level) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_GREATER_MAGIC: // Unicorn
-            if (player->magic_level > enemy->magic_level) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_GREATER_ZOO:
-            if (player->zoo_level > enemy->zoo_level) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_NO_WALL: // Foundations
-            if (!player->wall_height) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_HAVE_WALL:
-            if (player->wall_height) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_ENEMY_HAS_NO_WALL: // Spizzer
-            if (!enemy->wall_height) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_ENEMY_HAS_WALL: // Corrosion Cloud
-            if (enemy->wall_height) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_LESSER_WALL:
-            if (player->wall_height < enemy->wall_height) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_LESSER_TOWER:
-            if (player->tower_height < enemy->tower_height) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_EQUAL_WALL:
-            if (player->wall_height == enemy->wall_height) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_EQUAL_TOWER:
-            if (player->tower_height == enemy->tower_height) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_GREATER_WALL: // Elven Archers
-            if (player->wall_height > enemy->wall_height) goto desired_effects;
-            goto secondary_effects;
-        case CHECK_GREATER_TOWER:
-            if (player->tower_height > enemy->tower_height) goto desired_effects;
-            goto secondary_effects;
-        default:
-        desired_effects:
-            num_actions_left =
-                pCard->draw_extra_card_count + (pCard->field_30 == 1);
-            num_cards_to_discard = pCard->draw_extra_card_count;
-            for (char i = 0; i < pCard->draw_extra_card_count; i++)
-                GetNextCardFromDeck(player_num);
-
-            need_to_discard_card =
-                GetPlayerHandCardCount(player_num) > minimum_cards_at_hand;
-
-            APPLY_TO_PLAYER(player, enemy, quarry_level,
-                            pCard->to_player_quarry_lvl, quarry_p);
-            APPLY_TO_PLAYER(player, enemy, magic_level,
-                            pCard->to_player_magic_lvl, magic_p);
-            APPLY_TO_PLAYER(player, enemy, zoo_level, pCard->to_player_zoo_lvl,
-                            zoo_p);
-            APPLY_TO_PLAYER(player, enemy, resource_bricks,
-                            pCard->to_player_bricks, bricks_p);
-            APPLY_TO_PLAYER(player, enemy, resource_gems, pCard->to_player_gems,
-                            gems_p);
-            APPLY_TO_PLAYER(player, enemy, resource_beasts,
-                            pCard->to_player_beasts, beasts_p);
-            if (pCard->to_player_buildings) {
-                dmg_p = ApplyDamageToBuildings(
-                    player_num, (signed int)pCard->to_player_buildings);
-                buildings_p = (signed int)pCard->to_player_buildings - dmg_p;
-            }
-            APPLY_TO_PLAYER(player, enemy, wall_height, pCard->to_player_wall,
-                            wall_p);
-            APPLY_TO_PLAYER(player, enemy, tower_height, pCard->to_player_tower,
-                            tower_p);
-
-            APPLY_TO_ENEMY(player, enemy, quarry_level,
-                           pCard->to_enemy_quarry_lvl, quarry_e);
-            APPLY_TO_ENEMY(player, enemy, magic_level,
-                           pCard->to_enemy_magic_lvl, magic_e);
-            APPLY_TO_ENEMY(player, enemy, zoo_level, pCard->to_enemy_zoo_lvl,
-                           zoo_e);
-            APPLY_TO_ENEMY(player, enemy, resource_bricks,
-                           pCard->to_enemy_bricks, bricks_e);
-            APPLY_TO_ENEMY(player, enemy, resource_gems, pCard->to_enemy_gems,
-                           gems_e);
-            APPLY_TO_ENEMY(player, enemy, resource_beasts,
-                           pCard->to_enemy_beasts, beasts_e);
-            if (pCard->to_enemy_buildings) {
-                dmg_e = ApplyDamageToBuildings(
-                    enemy_num, (signed int)pCard->to_enemy_buildings);
-                buildings_e = (signed int)pCard->to_enemy_buildings - dmg_e;
-            }
-            APPLY_TO_ENEMY(player, enemy, wall_height, pCard->to_enemy_wall,
-                           wall_e);
-            APPLY_TO_ENEMY(player, enemy, tower_height, pCard->to_enemy_tower,
-                           tower_e);
-
-            APPLY_TO_BOTH(player, enemy, quarry_level,
-                          pCard->to_pl_enm_quarry_lvl, quarry_p, quarry_e);
-            APPLY_TO_BOTH(player, enemy, magic_level,
-                          pCard->to_pl_enm_magic_lvl, magic_p, magic_e);
-            APPLY_TO_BOTH(player, enemy, zoo_level, pCard->to_pl_enm_zoo_lvl,
-                          zoo_p, zoo_e);
-            APPLY_TO_BOTH(player, enemy, resource_bricks,
-                          pCard->to_pl_enm_bricks, bricks_p, bricks_e);
-            APPLY_TO_BOTH(player, enemy, resource_gems, pCard->to_pl_enm_gems,
-                          gems_p, gems_e);
-            APPLY_TO_BOTH(player, enemy, resource_beasts,
-                          pCard->to_pl_enm_beasts, beasts_p, beasts_e);
-            if (pCard->to_pl_enm_buildings) {
-                dmg_p = ApplyDamageToBuildings(
-                    player_num, (signed int)pCard->to_pl_enm_buildings);
-                dmg_e = ApplyDamageToBuildings(
-                    enemy_num, (signed int)pCard->to_pl_enm_buildings);
-                buildings_p = (signed int)pCard->to_pl_enm_buildings - dmg_p;
-                buildings_e = (signed int)pCard->to_pl_enm_buildings - dmg_e;
-            }
-            APPLY_TO_BOTH(player, enemy, wall_height, pCard->to_pl_enm_wall,
-                          wall_p, wall_e);
-            APPLY_TO_BOTH(player, enemy, tower_height, pCard->to_pl_enm_tower,
-                          tower_p, tower_e);
-            break;
-        case CHECK_ALWAYS_SECONDARY:
-        secondary_effects:
-            num_actions_left = pCard->can_draw_extra_card2 + (pCard->field_4D == 1);
-            num_cards_to_discard = pCard->can_draw_extra_card2;
-            for (char i = 0; i < pCard->can_draw_extra_card2; i++)
-                GetNextCardFromDeck(player_num);
-
-            need_to_discard_card =
-                GetPlayerHandCardCount(player_num) > minimum_cards_at_hand;
-
-            APPLY_TO_PLAYER(player, enemy, quarry_level,
-                            pCard->to_player_quarry_lvl2, quarry_p);
-            APPLY_TO_PLAYER(player, enemy, magic_level,
-                            pCard->to_player_magic_lvl2, magic_p);
-            APPLY_TO_PLAYER(player, enemy, zoo_level, pCard->to_player_zoo_lvl2,
-                            zoo_p);
-            APPLY_TO_PLAYER(player, enemy, resource_bricks,
-                            pCard->to_player_bricks2, bricks_p);
-            APPLY_TO_PLAYER(player, enemy, resource_gems,
-                            pCard->to_player_gems2, gems_p);
-            APPLY_TO_PLAYER(player, enemy, resource_beasts,
-                            pCard->to_player_beasts2, beasts_p);
-            if (pCard->to_player_buildings2) {
-                dmg_p = ApplyDamageToBuildings(
-                    player_num, (signed int)pCard->to_player_buildings2);
-                buildings_p = (signed int)pCard->to_player_buildings2 - dmg_p;
-            }
-            APPLY_TO_PLAYER(player, enemy, wall_height, pCard->to_player_wall2,
-                            wall_p);
-            APPLY_TO_PLAYER(player, enemy, tower_height,
-                            pCard->to_player_tower2, tower_p);
-
-            APPLY_TO_ENEMY(player, enemy, quarry_level,
-                           pCard->to_enemy_quarry_lvl2, quarry_e);
-            APPLY_TO_ENEMY(player, enemy, magic_level,
-                           pCard->to_enemy_magic_lvl2, magic_e);
-            APPLY_TO_ENEMY(player, enemy, zoo_level, pCard->to_enemy_zoo_lvl2,
-                           zoo_e);
-            APPLY_TO_ENEMY(player, enemy, resource_bricks,
-                           pCard->to_enemy_bricks2, bricks_e);
-            APPLY_TO_ENEMY(player, enemy, resource_gems, pCard->to_enemy_gems2,
-                           gems_e);
-            APPLY_TO_ENEMY(player, enemy, resource_beasts,
-                           pCard->to_enemy_beasts2, beasts_e);
-            if (pCard->to_enemy_buildings2) {
-                dmg_e = ApplyDamageToBuildings(
-                    enemy_num, (signed int)pCard->to_enemy_buildings2);
-                buildings_e = (signed int)pCard->to_enemy_buildings2 - dmg_e;
-            }
-            APPLY_TO_ENEMY(player, enemy, wall_height, pCard->to_enemy_wall2,
-                           wall_e);
-            APPLY_TO_ENEMY(player, enemy, tower_height, pCard->to_enemy_tower2,
-                           tower_e);
-
-            APPLY_TO_BOTH(player, enemy, quarry_level,
-                          pCard->to_pl_enm_quarry_lvl2, quarry_p, quarry_e);
-            APPLY_TO_BOTH(player, enemy, magic_level,
-                          pCard->to_pl_enm_magic_lvl2, magic_p, magic_e);
-            APPLY_TO_BOTH(player, enemy, zoo_level, pCard->to_pl_enm_zoo_lvl2,
-                          zoo_p, zoo_e);
-            APPLY_TO_BOTH(player, enemy, resource_bricks,
-                          pCard->to_pl_enm_bricks2, bricks_p, bricks_e);
-            APPLY_TO_BOTH(player, enemy, resource_gems, pCard->to_pl_enm_gems2,
-                          gems_p, gems_e);
-            APPLY_TO_BOTH(player, enemy, resource_beasts,
-                          pCard->to_pl_enm_beasts2, beasts_p, beasts_e);
-
-            if (pCard->to_pl_enm_buildings2) {
-                dmg_p = ApplyDamageToBuildings(
-                    player_num, (signed int)pCard->to_pl_enm_buildings2);
-                dmg_e = ApplyDamageToBuildings(
-                    enemy_num, (signed int)pCard->to_pl_enm_buildings2);
-                buildings_p = (signed int)pCard->to_pl_enm_buildings2 - dmg_p;
-                buildings_e = (signed int)pCard->to_pl_enm_buildings2 - dmg_e;
-            }
-            APPLY_TO_BOTH(player, enemy, wall_height, pCard->to_pl_enm_wall2,
-                          wall_p, wall_e);
-            APPLY_TO_BOTH(player, enemy, tower_height, pCard->to_pl_enm_tower2,
-                          tower_p, tower_e);
-            break;
-    }
-    //  }
+    need_to_discard_card = GetPlayerHandCardCount(player_num) > minimum_cards_at_hand;
 
+    ArcomageCardResult effects = applyArcomageCardEffects(player, enemy, card, primary);
 
     // call sound if required
-    if (quarry_p > 0 || quarry_e > 0) pArcomageGame->playSound(30);
-    if (quarry_p < 0 || quarry_e < 0) pArcomageGame->playSound(31);
-    if (magic_p > 0 || magic_e > 0) pArcomageGame->playSound(33);
-    if (magic_p < 0 || magic_e < 0) pArcomageGame->playSound(34);
-    if (zoo_p > 0 || zoo_e > 0) pArcomageGame->playSound(36);
-    if (zoo_p < 0 || zoo_e < 0) pArcomageGame->playSound(37);
-    if (bricks_p > 0 || bricks_e > 0) pArcomageGame->playSound(39);
-    if (bricks_p < 0 || bricks_e < 0) pArcomageGame->playSound(40);
-    if (gems_p > 0 || gems_e > 0) pArcomageGame->playSound(42);
-    if (gems_p < 0 || gems_e < 0) pArcomageGame->playSound(43);
-    if (beasts_p > 0 || beasts_e > 0) pArcomageGame->playSound(45u);
-    if (beasts_p < 0 || beasts_e < 0) pArcomageGame->playSound(46);
-    if (buildings_p || buildings_e || dmg_p || dmg_e) pArcomageGame->playSound(48);
-    if (wall_p > 0 || wall_e > 0) pArcomageGame->playSound(49);
-    if (wall_p < 0 || wall_e < 0) pArcomageGame->playSound(50);
-    if (tower_p > 0 || tower_e > 0) pArcomageGame->playSound(52);
-    if (tower_p < 0 || tower_e < 0) pArcomageGame->playSound(53);
+    if (effects.player.quarry > 0 || effects.enemy.quarry > 0) pArcomageGame->playSound(30);
+    if (effects.player.quarry < 0 || effects.enemy.quarry < 0) pArcomageGame->playSound(31);
+    if (effects.player.magic > 0 || effects.enemy.magic > 0) pArcomageGame->playSound(33);
+    if (effects.player.magic < 0 || effects.enemy.magic < 0) pArcomageGame->playSound(34);
+    if (effects.player.zoo > 0 || effects.enemy.zoo > 0) pArcomageGame->playSound(36);
+    if (effects.player.zoo < 0 || effects.enemy.zoo < 0) pArcomageGame->playSound(37);
+    if (effects.player.bricks > 0 || effects.enemy.bricks > 0) pArcomageGame->playSound(39);
+    if (effects.player.bricks < 0 || effects.enemy.bricks < 0) pArcomageGame->playSound(40);
+    if (effects.player.gems > 0 || effects.enemy.gems > 0) pArcomageGame->playSound(42);
+    if (effects.player.gems < 0 || effects.enemy.gems < 0) pArcomageGame->playSound(43);
+    if (effects.player.beasts > 0 || effects.enemy.beasts > 0) pArcomageGame->playSound(45u);
+    if (effects.player.beasts < 0 || effects.enemy.beasts < 0) pArcomageGame->playSound(46);
+    if (effects.player.buildings || effects.enemy.buildings || effects.player.damage || effects.enemy.damage)
+        pArcomageGame->playSound(48);
+    if (effects.player.wall > 0 || effects.enemy.wall > 0) pArcomageGame->playSound(49);
+    if (effects.player.wall < 0 || effects.enemy.wall < 0) pArcomageGame->playSound(50);
+    if (effects.player.tower > 0 || effects.enemy.tower > 0) pArcomageGame->playSound(52);
+    if (effects.player.tower < 0 || effects.enemy.tower < 0) pArcomageGame->playSound(53);
 
 
     // call spark effect if required
     Pointi explos_coords;
     if (player_num) {
-        if (quarry_p) {
+        if (effects.player.quarry) {
             explos_coords.x = 573;
             explos_coords.y = 92;
-            new_explosion_effect(&explos_coords, quarry_p);
+            new_explosion_effect(&explos_coords, effects.player.quarry);
         }
-        if (quarry_e) {
+        if (effects.enemy.quarry) {
             explos_coords.x = 26;
             explos_coords.y = 92;
-            new_explosion_effect(&explos_coords, quarry_e);
+            new_explosion_effect(&explos_coords, effects.enemy.quarry);
         }
-        if (magic_p) {
+        if (effects.player.magic) {
             explos_coords.x = 573;
             explos_coords.y = 164;
-            new_explosion_effect(&explos_coords, magic_p);
+            new_explosion_effect(&explos_coords, effects.player.magic);
         }
-        if (magic_e) {
+        if (effects.enemy.magic) {
             explos_coords.x = 26;
             explos_coords.y = 164;
-            new_explosion_effect(&explos_coords, magic_e);
+            new_explosion_effect(&explos_coords, effects.enemy.magic);
         }
-        if (zoo_p) {
+        if (effects.player.zoo) {
             explos_coords.x = 573;
             explos_coords.y = 236;
-            new_explosion_effect(&explos_coords, zoo_p);
+            new_explosion_effect(&explos_coords, effects.player.zoo);
         }
-        if (zoo_e) {
+        if (effects.enemy.zoo) {
             explos_coords.x = 26;
             explos_coords.y = 236;
-            new_explosion_effect(&explos_coords, zoo_e);
+            new_explosion_effect(&explos_coords, effects.enemy.zoo);
         }
-        if (bricks_p) {
+        if (effects.player.bricks) {
             explos_coords.x = 563;
             explos_coords.y = 114;
-            new_explosion_effect(&explos_coords, bricks_p);
+            new_explosion_effect(&explos_coords, effects.player.bricks);
         }
-        if (bricks_e) {
+        if (effects.enemy.bricks) {
             explos_coords.x = 16;
             explos_coords.y = 114;
-            new_explosion_effect(&explos_coords, bricks_e);
+            new_explosion_effect(&explos_coords, effects.enemy.bricks);
         }
-        if (gems_p) {
+        if (effects.player.gems) {
             explos_coords.x = 563;
             explos_coords.y = 186;
-            new_explosion_effect(&explos_coords, gems_p);
+            new_explosion_effect(&explos_coords, effects.player.gems);
         }
-        if (gems_e) {
+        if (effects.enemy.gems) {
             explos_coords.x = 16;
             explos_coords.y = 186;
-            new_explosion_effect(&explos_coords, gems_e);
+            new_explosion_effect(&explos_coords, effects.enemy.gems);
         }
-        if (beasts_p) {
+        if (effects.player.beasts) {
             explos_coords.x = 563;
             explos_coords.y = 258;
-            new_explosion_effect(&explos_coords, beasts_p);
+            new_explosion_effect(&explos_coords, effects.player.beasts);
         }
-        if (beasts_e) {
+        if (effects.enemy.beasts) {
             explos_coords.x = 16;
             explos_coords.y = 258;
-            new_explosion_effect(&explos_coords, beasts_e);
+            new_explosion_effect(&explos_coords, effects.enemy.beasts);
         }
-        if (wall_p) {
+        if (effects.player.wall) {
             explos_coords.x = 442;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, wall_p);
+            new_explosion_effect(&explos_coords, effects.player.wall);
         }
-        if (wall_e) {
+        if (effects.enemy.wall) {
             explos_coords.x = 180;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, wall_e);
+            new_explosion_effect(&explos_coords, effects.enemy.wall);
         }
-        if (tower_p) {
+        if (effects.player.tower) {
             explos_coords.x = 514;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, tower_p);
+            new_explosion_effect(&explos_coords, effects.player.tower);
         }
-        if (tower_e) {
+        if (effects.enemy.tower) {
             explos_coords.x = 122;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, tower_e);
+            new_explosion_effect(&explos_coords, effects.enemy.tower);
         }
-        if (dmg_p) {
+        if (effects.player.damage) {
             explos_coords.x = 442;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, dmg_p);
+            new_explosion_effect(&explos_coords, effects.player.damage);
         }
-        if (buildings_p) {
+        if (effects.player.buildings) {
             explos_coords.x = 514;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, buildings_p);
+            new_explosion_effect(&explos_coords, effects.player.buildings);
         }
-        if (dmg_e) {
+        if (effects.enemy.damage) {
             explos_coords.x = 180;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, dmg_e);
+            new_explosion_effect(&explos_coords, effects.enemy.damage);
         }
-        if (buildings_e) {
+        if (effects.enemy.buildings) {
             explos_coords.x = 122;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, buildings_e);
+            new_explosion_effect(&explos_coords, effects.enemy.buildings);
         }
     } else {
-        if (quarry_p) {
+        if (effects.player.quarry) {
             explos_coords.x = 26;
             explos_coords.y = 92;
-            new_explosion_effect(&explos_coords, quarry_p);
+            new_explosion_effect(&explos_coords, effects.player.quarry);
         }
-        if (quarry_e) {
+        if (effects.enemy.quarry) {
             explos_coords.x = 573;
             explos_coords.y = 92;
-            new_explosion_effect(&explos_coords, quarry_e);
+            new_explosion_effect(&explos_coords, effects.enemy.quarry);
         }
-        if (magic_p) {
+        if (effects.player.magic) {
             explos_coords.x = 26;
             explos_coords.y = 164;
-            new_explosion_effect(&explos_coords, magic_p);
+            new_explosion_effect(&explos_coords, effects.player.magic);
         }
-        if (magic_e) {
+        if (effects.enemy.magic) {
             explos_coords.x = 573;
             explos_coords.y = 164;
-            new_explosion_effect(&explos_coords, magic_e);
+            new_explosion_effect(&explos_coords, effects.enemy.magic);
         }
-        if (zoo_p) {
+        if (effects.player.zoo) {
             explos_coords.x = 26;
             explos_coords.y = 236;
-            new_explosion_effect(&explos_coords, zoo_p);
+            new_explosion_effect(&explos_coords, effects.player.zoo);
         }
-        if (zoo_e) {
+        if (effects.enemy.zoo) {
             explos_coords.x = 573;
             explos_coords.y = 236;
-            new_explosion_effect(&explos_coords, zoo_e);
+            new_explosion_effect(&explos_coords, effects.enemy.zoo);
         }
-        if (bricks_p) {
+        if (effects.player.bricks) {
             explos_coords.x = 16;
             explos_coords.y = 114;
-            new_explosion_effect(&explos_coords, bricks_p);
+            new_explosion_effect(&explos_coords, effects.player.bricks);
         }
-        if (bricks_e) {
+        if (effects.enemy.bricks) {
             explos_coords.x = 563;
             explos_coords.y = 114;
-            new_explosion_effect(&explos_coords, bricks_e);
+            new_explosion_effect(&explos_coords, effects.enemy.bricks);
         }
-        if (gems_p) {
+        if (effects.player.gems) {
             explos_coords.x = 16;
             explos_coords.y = 186;
-            new_explosion_effect(&explos_coords, gems_p);
+            new_explosion_effect(&explos_coords, effects.player.gems);
         }
-        if (gems_e) {
+        if (effects.enemy.gems) {
             explos_coords.x = 563;
             explos_coords.y = 186;
-            new_explosion_effect(&explos_coords, gems_e);
+            new_explosion_effect(&explos_coords, effects.enemy.gems);
         }
-        if (beasts_p) {
+        if (effects.player.beasts) {
             explos_coords.x = 16;
             explos_coords.y = 258;
-            new_explosion_effect(&explos_coords, beasts_p);
+            new_explosion_effect(&explos_coords, effects.player.beasts);
         }
-        if (beasts_e) {
+        if (effects.enemy.beasts) {
             explos_coords.x = 563;
             explos_coords.y = 258;
-            new_explosion_effect(&explos_coords, beasts_e);
+            new_explosion_effect(&explos_coords, effects.enemy.beasts);
         }
-        if (wall_p) {
+        if (effects.player.wall) {
             explos_coords.x = 180;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, wall_p);
+            new_explosion_effect(&explos_coords, effects.player.wall);
         }
-        if (wall_e) {
+        if (effects.enemy.wall) {
             explos_coords.x = 442;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, wall_e);
+            new_explosion_effect(&explos_coords, effects.enemy.wall);
         }
-        if (tower_p) {
+        if (effects.player.tower) {
             explos_coords.x = 122;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, tower_p);
+            new_explosion_effect(&explos_coords, effects.player.tower);
         }
-        if (tower_e) {
+        if (effects.enemy.tower) {
             explos_coords.x = 514;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, tower_e);
+            new_explosion_effect(&explos_coords, effects.enemy.tower);
         }
-        if (dmg_p) {
+        if (effects.player.damage) {
             explos_coords.x = 180;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, dmg_p);
+            new_explosion_effect(&explos_coords, effects.player.damage);
         }
-        if (buildings_p) {
+        if (effects.player.buildings) {
             explos_coords.x = 122;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, buildings_p);
+            new_explosion_effect(&explos_coords, effects.player.buildings);
         }
-        if (dmg_e) {
+        if (effects.enemy.damage) {
             explos_coords.x = 442;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, dmg_e);
+            new_explosion_effect(&explos_coords, effects.enemy.damage);
         }
-        if (buildings_e) {
+        if (effects.enemy.buildings) {
             explos_coords.x = 514;
             explos_coords.y = 296;
-            new_explosion_effect(&explos_coords, buildings_e);
+            new_explosion_effect(&explos_coords, effects.enemy.buildings);
         }
     }
 
-#undef APPLY_TO_BOTH
-#undef APPLY_TO_ENEMY
-#undef APPLY_TO_PLAYER
 }
 
 
 
-int ApplyDamageToBuildings(int player_num, int damage) {
-    int wall = am_Players[player_num].wall_height;
-    int result = 0;
-
-    if (wall >= -damage) {  // wall absorbs all damage
-        result = damage;
-        am_Players[player_num].wall_height += damage;
-    } else {
-        damage += wall;  // reduce damage by size of wall
-        am_Players[player_num].wall_height = 0;
-        result = -wall;
-        am_Players[player_num].tower_height += damage;  // apply remaining to tower
-    }
-
-    if (am_Players[player_num].tower_height < 0)
-        am_Players[player_num].tower_height = 0;
-
-    return result;
-}
-
 void GameResultsApply() {
-    int winner;               // esi@1
-    int victory_type;         // edi@1
-    int pl_resource;          // edx@25
-    int en_resource;          // eax@28
     unsigned int tavern_num;  // eax@54
 
-    winner = -1;
-    victory_type = -1;
-    // nullsub_1();
-    /*strcpy(pText, "The Winner is: ");//"Победил: " Ritor1: архаизм
-    xy.y = 160;
-    xy.x = 320; //- 12 * v2 / 2;
-    am_DrawText(-1, pText, &xy);*/
-
-    //проверка построена ли башня
-    if (am_Players[0].tower_height < max_tower_height &&
-        am_Players[1].tower_height >=
-            max_tower_height) {  //наша башня не построена, а у врага построена
-        winner = 2;  //победил игрок 2(враг)
-        victory_type = 0;
-    } else if (am_Players[0].tower_height >= max_tower_height &&
-               am_Players[1].tower_height <
-                   max_tower_height) {  //наша башня построена, а у врага нет
-        winner = 1;  //победил игрок 1(мы)
-        victory_type = 0;
-    } else if (am_Players[0].tower_height >= max_tower_height &&
-               am_Players[1].tower_height >=
-                   max_tower_height) {  //и у нас, и у врага построена
-        if (am_Players[0].tower_height ==
-            am_Players[1].tower_height) {  //наши башни равны
-            winner = 0;        //никто не победил
-            victory_type = 4;  //ничья
-        } else {               //наши башни не равны
-            winner =
-                (am_Players[0].tower_height <= am_Players[1].tower_height) +
-                1;  //победил тот, у кого выше
-            victory_type = 0;
-        }
-    }
-
-    //проверка разрушена ли башня
-    if (am_Players[0].tower_height <= 0 &&
-        am_Players[1].tower_height > 0) {  //наша башня разрушена, а у врага нет
-        winner = 2;        // победил игрок 2(враг)
-        victory_type = 2;  //победил разрушив башню врага
-    } else if (am_Players[0].tower_height > 0 &&
-               am_Players[1].tower_height <=
-                   0) {  //у врага башня разрушена, а у нас нет
-        winner = 1;        //победил игрок 1(мы)
-        victory_type = 2;  //победил разрушив башню врага
-    } else if (am_Players[0].tower_height <= 0 &&
-               am_Players[1].tower_height <=
-                   0) {  //наша башня разрушена, и у врага разрушена
-        if (am_Players[0].tower_height ==
-            am_Players[1].tower_height) {  //если башни равны
-            if (am_Players[0].wall_height ==
-                am_Players[1].wall_height) {  //если стены равны
-                winner = 0;
-                victory_type = 4;
-            } else {  //если стены не равны
-                winner =
-                    (am_Players[0].wall_height <= am_Players[1].wall_height) +
-                    1;  //победил тот, у кого стена выше
-                victory_type = 1;  //победа когда больше стена при ничье
-            }
-        } else {  //башни не равны
-            winner =
-                (am_Players[0].tower_height <= am_Players[1].tower_height) +
-                1;  // побеждает тот у кого башня больше
-            victory_type = 2;  //победил разрушив башню врага
-        }
-    }
-
-    //проверка набраны ли ресурсы
-    //проверка какого ресурса больше всего у игрока 1(нас)
-    pl_resource =
-        am_Players[0].resource_bricks;  //кирпичей больше чем др. ресурсов
-    if (am_Players[0].resource_gems > am_Players[0].resource_bricks &&
-        am_Players[0].resource_gems >
-            am_Players[0].resource_beasts)  //драг.камней больше всего
-        pl_resource = am_Players[0].resource_gems;
-    else if (am_Players[0].resource_beasts > am_Players[0].resource_gems &&
-             am_Players[0].resource_beasts >
-                 am_Players[0].resource_bricks)  //зверей больше всего
-        pl_resource = am_Players[0].resource_beasts;
-
-    //проверка какого ресурса больше у игрока 2(врага)
-    en_resource =
-        am_Players[1].resource_bricks;  //кирпичей больше чем др. ресурсов
-    if (am_Players[1].resource_gems > am_Players[1].resource_bricks &&
-        am_Players[1].resource_gems >
-            am_Players[1].resource_beasts)  //драг.камней больше всего
-        en_resource = am_Players[1].resource_gems;
-    else if (am_Players[1].resource_beasts > am_Players[1].resource_gems &&
-             am_Players[1].resource_beasts >
-                 am_Players[1].resource_bricks)  //зверей больше всего
-        en_resource = am_Players[1].resource_beasts;
-
-    //сравнение ресурсов игроков
-    if (winner == -1 && victory_type == -1) {  //нет победителя по башням
-        if (pl_resource < max_resources_amount &&
-            en_resource >=
-                max_resources_amount) {  //враг набрал нужное количество
-            winner = 2;  // враг победил
-            victory_type = 3;  //победа собрав нужное количество ресурсов
-        } else if (pl_resource >= max_resources_amount &&
-                   en_resource <
-                       max_resources_amount) {  //мы набрали нужное количество
-            winner = 1;  // мы победили
-            victory_type = 3;  //победа собрав нужное количество ресурсов
-        } else if (pl_resource >= max_resources_amount &&
-                   en_resource >=
-                       max_resources_amount) {  //и у нас и у врага нужное
-                                                //количество ресурсов
-            if (pl_resource == en_resource) {  // ресурсы равны
-                winner = 0;        //ресурсы равны
-                victory_type = 4;  //ничья
-            } else {
-                winner = (pl_resource <= en_resource) +
-                         1;  //ресурсы не равны, побеждает тот у кого больше
-                victory_type = 3;  //победа собрав нужное количество ресурсов
-            }
-        }
-    } else if (winner == 0 && victory_type == 4) {  // при ничье по башням и стене
-        if (pl_resource != en_resource) {  //ресурсы не равны
-            winner =
-                (pl_resource <= en_resource) + 1;  //победил тот у кого больше
-            victory_type =
-                5;  //победа когда при ничье большее количество ресурсов
-        } else {    //ресурсы равны
-            winner = 0;        //нет победителя
-            victory_type = 4;  //ничья
-        }
-    }
+    ArcomageOutcome outcome = arcomageGameOutcome(am_Players, max_tower_height, max_resources_amount);
+    int winner = outcome.winner;
+    int victory_type = outcome.victoryType;
 
     pArcomageGame->Victory_type = victory_type;
     pArcomageGame->uGameWinner = winner;
@@ -2929,29 +2046,28 @@ void ArcomageGame::PrepareArcomage() {
 }
 
 void SetStartConditions() {
-    const ArcomageStartConditions *st_cond;
-    st_cond = &start_conditions[window_SpeakInHouse->houseId()];
+    ArcomageRules rules = arcomageTavernRules(window_SpeakInHouse->houseId());
 
     // set start conditions
-    start_tower_height = st_cond->tower_height;
-    start_wall_height = st_cond->wall_height;
-    start_quarry_level = st_cond->quarry_level - 1;
-    start_magic_level = st_cond->magic_level - 1;
-    start_zoo_level = st_cond->zoo_level - 1;
-    start_bricks_amount = st_cond->bricks_amount;
-    start_gems_amount = st_cond->gems_amount;
-    start_beasts_amount = st_cond->beasts_amount;
+    start_tower_height = rules.startTowerHeight;
+    start_wall_height = rules.startWallHeight;
+    start_quarry_level = rules.startQuarryLevel;
+    start_magic_level = rules.startMagicLevel;
+    start_zoo_level = rules.startZooLevel;
+    start_bricks_amount = rules.startBricks;
+    start_gems_amount = rules.startGems;
+    start_beasts_amount = rules.startBeasts;
     // win conditions
-    max_tower_height = st_cond->max_tower;
-    max_resources_amount = st_cond->max_resources;
+    max_tower_height = rules.maxTowerHeight;
+    max_resources_amount = rules.maxResources;
     // opponent skill level
-    opponent_mastery = st_cond->mastery_lvl;
+    opponent_mastery = rules.aiMastery;
 
     // bonus acts as min level
-    minimum_cards_at_hand = 5;
-    quarry_bonus = 1;
-    magic_bonus = 1;
-    zoo_bonus = 1;
+    minimum_cards_at_hand = rules.minimumCardsAtHand;
+    quarry_bonus = rules.quarryBonus;
+    magic_bonus = rules.magicBonus;
+    zoo_bonus = rules.zooBonus;
 }
 
 void am_DrawText(const std::string &str, Pointi *pXY) {
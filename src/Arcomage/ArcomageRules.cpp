@@ -0,0 +1,799 @@
+#include "ArcomageRules.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "Library/Random/RandomEngine.h"
+
+#include "Utility/IndexedArray.h"
+
+namespace {
+
+struct ArcomageStartConditions {
+    int16_t max_tower;
+    int16_t max_resources;
+    int16_t tower_height;
+    int16_t wall_height;
+    int16_t quarry_level;
+    int16_t magic_level;
+    int16_t zoo_level;
+    int16_t bricks_amount;
+    int16_t gems_amount;
+    int16_t beasts_amount;
+    int mastery_lvl;
+};
+
+IndexedArray<ArcomageStartConditions, HOUSE_FIRST_ARCOMAGE_TAVERN, HOUSE_LAST_ARCOMAGE_TAVERN> start_conditions = {
+    {HOUSE_TAVERN_HARMONDALE,       {30, 100, 15, 5, 2, 2, 2, 10, 10, 10, 0}},
+    {HOUSE_TAVERN_ERATHIA,          {50, 150, 20, 5, 2, 2, 2, 5, 5, 5, 1}},
+    {HOUSE_TAVERN_TULAREAN_FOREST,  {50, 150, 20, 5, 2, 2, 2, 5, 5, 5, 2}},
+    {HOUSE_TAVERN_DEYJA,            {75, 200, 25, 10, 3, 3, 3, 5, 5, 5, 2}},
+    {HOUSE_TAVERN_BRACADA_DESERT,   {75, 200, 20, 10, 3, 3, 3, 5, 5, 5, 1}},
+    {HOUSE_TAVERN_CELESTE,          {100, 300, 30, 15, 4, 4, 4, 10, 10, 10, 1}},
+    {HOUSE_TAVERN_PIT,              {100, 300, 30, 15, 4, 4, 4, 10, 10, 10, 2}},
+    {HOUSE_TAVERN_EVENMORN_ISLAND,  {150, 400, 20, 10, 5, 5, 5, 25, 25, 25, 0}},
+    {HOUSE_TAVERN_MOUNT_NIGHON,     {200, 500, 20, 10, 1, 1, 1, 15, 15, 15, 2}},
+    {HOUSE_TAVERN_BARROW_DOWNS,     {100, 300, 20, 50, 1, 1, 5, 5, 5, 25, 0}},
+    {HOUSE_TAVERN_TATALIA,          {125, 350, 10, 20, 3, 1, 2, 15, 5, 10, 2}},
+    {HOUSE_TAVERN_AVLEE,            {125, 350, 10, 20, 3, 1, 2, 15, 5, 10, 1}},
+    {HOUSE_TAVERN_STONE_CITY,       {100, 300, 50, 50, 5, 3, 5, 20, 10, 20, 0}}
+};
+
+// Values of a single card effect group, e.g. "to player, primary".
+struct CardEffectValues {
+    int quarry;
+    int magic;
+    int zoo;
+    int bricks;
+    int gems;
+    int beasts;
+    int buildings;
+    int wall;
+    int tower;
+};
+
+struct CardEffectGroups {
+    CardEffectValues player;
+    CardEffectValues enemy;
+    CardEffectValues both;
+};
+
+CardEffectGroups cardEffectGroups(const ArcomageCard &card, bool primary) {
+    if (primary) {
+        return {
+            {card.to_player_quarry_lvl, card.to_player_magic_lvl, card.to_player_zoo_lvl, card.to_player_bricks,
+             card.to_player_gems, card.to_player_beasts, card.to_player_buildings, card.to_player_wall,
+             card.to_player_tower},
+            {card.to_enemy_quarry_lvl, card.to_enemy_magic_lvl, card.to_enemy_zoo_lvl, card.to_enemy_bricks,
+             card.to_enemy_gems, card.to_enemy_beasts, card.to_enemy_buildings, card.to_enemy_wall,
+             card.to_enemy_tower},
+            {card.to_pl_enm_quarry_lvl, card.to_pl_enm_magic_lvl, card.to_pl_enm_zoo_lvl, card.to_pl_enm_bricks,
+             card.to_pl_enm_gems, card.to_pl_enm_beasts, card.to_pl_enm_buildings, card.to_pl_enm_wall,
+             card.to_pl_enm_tower}
+        };
+    } else {
+        return {
+            {card.to_player_quarry_lvl2, card.to_player_magic_lvl2, card.to_player_zoo_lvl2, card.to_player_bricks2,
+             card.to_player_gems2, card.to_player_beasts2, card.to_player_buildings2, card.to_player_wall2,
+             card.to_player_tower2},
+            {card.to_enemy_quarry_lvl2, card.to_enemy_magic_lvl2, card.to_enemy_zoo_lvl2, card.to_enemy_bricks2,
+             card.to_enemy_gems2, card.to_enemy_beasts2, card.to_enemy_buildings2, card.to_enemy_wall2,
+             card.to_enemy_tower2},
+            {card.to_pl_enm_quarry_lvl2, card.to_pl_enm_magic_lvl2, card.to_pl_enm_zoo_lvl2, card.to_pl_enm_bricks2,
+             card.to_pl_enm_gems2, card.to_pl_enm_beasts2, card.to_pl_enm_buildings2, card.to_pl_enm_wall2,
+             card.to_pl_enm_tower2}
+        };
+    }
+}
+
+// Value of 99 means "set to the other player's value if it's higher".
+void applyToOne(int *field, int otherField, int value, int *result) {
+    if (value == 0)
+        return;
+
+    if (value == 99) {
+        if (*field < otherField) {
+            *field = otherField;
+            *result = otherField - *field;
+        }
+    } else {
+        *field += value;
+        if (*field < 0)
+            *field = 0;
+        *result = value;
+    }
+}
+
+// Value of 99 means "set the lower of the two values to the higher one".
+void applyToBoth(int *playerField, int *enemyField, int value, int *playerResult, int *enemyResult) {
+    if (value == 0)
+        return;
+
+    if (value == 99) {
+        if (*playerField != *enemyField) {
+            if (*playerField <= *enemyField) {
+                *playerField = *enemyField;
+                *playerResult = *enemyField - *playerField;
+            } else {
+                *enemyField = *playerField;
+                *enemyResult = *playerField - *enemyField;
+            }
+        }
+    } else {
+        *playerField += value;
+        *enemyField += value;
+        if (*playerField < 0)
+            *playerField = 0;
+        if (*enemyField < 0)
+            *enemyField = 0;
+        *playerResult = value;
+        *enemyResult = value;
+    }
+}
+
+void applyToOne(ArcomagePlayer *target, const ArcomagePlayer &other, const CardEffectValues &values,
+                ArcomageCardEffects *effects) {
+    applyToOne(&target->quarry_level, other.quarry_level, values.quarry, &effects->quarry);
+    applyToOne(&target->magic_level, other.magic_level, values.magic, &effects->magic);
+    applyToOne(&target->zoo_level, other.zoo_level, values.zoo, &effects->zoo);
+    applyToOne(&target->resource_bricks, other.resource_bricks, values.bricks, &effects->bricks);
+    applyToOne(&target->resource_gems, other.resource_gems, values.gems, &effects->gems);
+    applyToOne(&target->resource_beasts, other.resource_beasts, values.beasts, &effects->beasts);
+    if (values.buildings) {
+        effects->damage = applyArcomageDamage(target, values.buildings);
+        effects->buildings = values.buildings - effects->damage;
+    }
+    applyToOne(&target->wall_height, other.wall_height, values.wall, &effects->wall);
+    applyToOne(&target->tower_height, other.tower_height, values.tower, &effects->tower);
+}
+
+void applyToBoth(ArcomagePlayer *player, ArcomagePlayer *enemy, const CardEffectValues &values,
+                 ArcomageCardResult *result) {
+    ArcomageCardEffects &p = result->player;
+    ArcomageCardEffects &e = result->enemy;
+    applyToBoth(&player->quarry_level, &enemy->quarry_level, values.quarry, &p.quarry, &e.quarry);
+    applyToBoth(&player->magic_level, &enemy->magic_level, values.magic, &p.magic, &e.magic);
+    applyToBoth(&player->zoo_level, &enemy->zoo_level, values.zoo, &p.zoo, &e.zoo);
+    applyToBoth(&player->resource_bricks, &enemy->resource_bricks, values.bricks, &p.bricks, &e.bricks);
+    applyToBoth(&player->resource_gems, &enemy->resource_gems, values.gems, &p.gems, &e.gems);
+    applyToBoth(&player->resource_beasts, &enemy->resource_beasts, values.beasts, &p.beasts, &e.beasts);
+    if (values.buildings) {
+        p.damage = applyArcomageDamage(player, values.buildings);
+        e.damage = applyArcomageDamage(enemy, values.buildings);
+        p.buildings = values.buildings - p.damage;
+        e.buildings = values.buildings - e.damage;
+    }
+    applyToBoth(&player->wall_height, &enemy->wall_height, values.wall, &p.wall, &e.wall);
+    applyToBoth(&player->tower_height, &enemy->tower_height, values.tower, &p.tower, &e.tower);
+}
+
+int maxResource(const ArcomagePlayer &player) {
+    int result = player.resource_bricks;
+    if (player.resource_gems > player.resource_bricks && player.resource_gems > player.resource_beasts) {
+        result = player.resource_gems;
+    } else if (player.resource_beasts > player.resource_gems && player.resource_beasts > player.resource_bricks) {
+        result = player.resource_beasts;
+    }
+    return result;
+}
+
+bool isHandCardPlayable(const ArcomagePlayer &player, int slot) {
+    int cardId = player.cards_at_hand[slot];
+    return cardId != -1 && canPlayArcomageCard(player, pCards[cardId]);
+}
+
+} // namespace
+
+ArcomageRules arcomageTavernRules(HouseId houseId) {
+    const ArcomageStartConditions &conditions = start_conditions[houseId];
+
+    ArcomageRules result;
+    result.startTowerHeight = conditions.tower_height;
+    result.startWallHeight = conditions.wall_height;
+    result.startQuarryLevel = conditions.quarry_level - 1;
+    result.startMagicLevel = conditions.magic_level - 1;
+    result.startZooLevel = conditions.zoo_level - 1;
+    result.startBricks = conditions.bricks_amount;
+    result.startGems = conditions.gems_amount;
+    result.startBeasts = conditions.beasts_amount;
+    result.maxTowerHeight = conditions.max_tower;
+    result.maxResources = conditions.max_resources;
+    result.aiMastery = conditions.mastery_lvl;
+    return result;
+}
+
+int arcomageHandCardCount(const ArcomagePlayer &player) {
+    return std::ranges::count_if(player.cards_at_hand, [](int cardId) { return cardId != -1; });
+}
+
+int arcomageEmptyHandSlot(const ArcomagePlayer &player) {
+    for (int i = 0; i < 10; ++i)
+        if (player.cards_at_hand[i] == -1)
+            return i;
+    return -1;
+}
+
+bool canPlayArcomageCard(const ArcomagePlayer &player, const ArcomageCard &card) {
+    return card.needed_quarry_level <= player.quarry_level &&
+           card.needed_magic_level <= player.magic_level &&
+           card.needed_zoo_level <= player.zoo_level &&
+           card.needed_bricks <= player.resource_bricks &&
+           card.needed_gems <= player.resource_gems &&
+           card.needed_beasts <= player.resource_beasts;
+}
+
+void payArcomageCardCost(ArcomagePlayer *player, const ArcomageCard &card) {
+    player->resource_bricks -= card.needed_bricks;
+    player->resource_beasts -= card.needed_beasts;
+    player->resource_gems -= card.needed_gems;
+}
+
+void initArcomageMasterDeck(ArcomageDeck *masterDeck) {
+    masterDeck->name = "Master Deck";
+    for (int i = 0, card_dispenser_counter = -2, card_id_counter = 0; i < DECK_SIZE; ++i, ++card_dispenser_counter) {
+        masterDeck->cardsInUse[i] = 0;
+        masterDeck->cards_IDs[i] = card_id_counter;
+        switch (card_dispenser_counter) {
+        case 0:
+        case 2:
+        case 6:
+        case 9:
+        case 13:
+        case 18:
+        case 23:
+        case 33:
+        case 36:
+        case 38:
+        case 44:
+        case 46:
+        case 52:
+        case 57:
+        case 69:
+        case 71:
+        case 75:
+        case 79:
+        case 81:
+        case 84:
+        case 89:
+            break;
+        default:
+            ++card_id_counter;
+        }
+    }
+}
+
+void shuffleArcomageDeck(ArcomageDeck *playDeck, ArcomageDeck *masterDeck, std::span<const ArcomagePlayer, 2> players,
+                         RandomEngine *rng) {
+    char card_taken_flags[DECK_SIZE];
+
+    memset(masterDeck->cardsInUse, 0, DECK_SIZE);
+    memset(card_taken_flags, 0, DECK_SIZE);
+
+    for (const ArcomagePlayer &player : players) {
+        for (int cardId : player.cards_at_hand) {
+            if (cardId > -1) {
+                for (int m = 0; m < DECK_SIZE; ++m) {
+                    if (masterDeck->cards_IDs[m] == cardId && masterDeck->cardsInUse[m] == 0) {
+                        // mark which cards are already in players hands
+                        masterDeck->cardsInUse[m] = 1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < DECK_SIZE; ++i) {
+        int rand_deck_pos;
+        do {
+            rand_deck_pos = rng->random(DECK_SIZE);
+        } while (card_taken_flags[rand_deck_pos] == 1);
+
+        card_taken_flags[rand_deck_pos] = 1;
+        playDeck->cards_IDs[i] = masterDeck->cards_IDs[rand_deck_pos];
+        playDeck->cardsInUse[i] = masterDeck->cardsInUse[rand_deck_pos];
+    }
+}
+
+int drawArcomageCard(ArcomageDeck *playDeck, ArcomageDeck *masterDeck, int *deckWalkIndex,
+                     std::span<const ArcomagePlayer, 2> players, RandomEngine *rng) {
+    for (;;) {
+        if (*deckWalkIndex >= DECK_SIZE) {
+            shuffleArcomageDeck(playDeck, masterDeck, players, rng);
+            *deckWalkIndex = 0;
+        }
+
+        int index = (*deckWalkIndex)++;
+        if (!playDeck->cardsInUse[index])
+            return playDeck->cards_IDs[index];
+    }
+}
+
+bool isArcomageCardPrimary(const ArcomagePlayer &player, const ArcomagePlayer &enemy, const ArcomageCard &card) {
+    switch (card.compare_param) {
+    case CHECK_ALWAYS_SECONDARY:    return false;
+    case CHECK_LESSER_QUARRY:       return player.quarry_level < enemy.quarry_level; // Mother Lode & Copping the Tech
+    case CHECK_LESSER_MAGIC:        return player.magic_level < enemy.magic_level; // Parity
+    case CHECK_LESSER_ZOO:          return player.zoo_level < enemy.zoo_level;
+    case CHECK_EQUAL_QUARRY:        return player.quarry_level == enemy.quarry_level;
+    case CHECK_EQUAL_MAGIC:         return player.magic_level == enemy.magic_level;
+    case CHECK_EQUAL_ZOO:           return player.zoo_level == enemy.zoo_level;
+    case CHECK_GREATER_QUARRY:      return player.quarry_level > enemy.quarry_level;
+    case CHECK_GREATER_MAGIC:       return player.magic_level > enemy.magic_level; // Unicorn
+    case CHECK_GREATER_ZOO:         return player.zoo_level > enemy.zoo_level;
+    case CHECK_NO_WALL:             return !player.wall_height; // Foundations
+    case CHECK_HAVE_WALL:           return player.wall_height;
+    case CHECK_ENEMY_HAS_NO_WALL:   return !enemy.wall_height; // Spizzer
+    case CHECK_ENEMY_HAS_WALL:      return enemy.wall_height; // Corrosion Cloud
+    case CHECK_LESSER_WALL:         return player.wall_height < enemy.wall_height;
+    case CHECK_LESSER_TOWER:        return player.tower_height < enemy.tower_height;
+    case CHECK_EQUAL_WALL:          return player.wall_height == enemy.wall_height;
+    case CHECK_EQUAL_TOWER:         return player.tower_height == enemy.tower_height;
+    case CHECK_GREATER_WALL:        return player.wall_height > enemy.wall_height; // Elven Archers
+    case CHECK_GREATER_TOWER:       return player.tower_height > enemy.tower_height;
+    default:                        return true;
+    }
+}
+
+int arcomageCardDrawCount(const ArcomageCard &card, bool primary) {
+    return primary ? card.draw_extra_card_count : card.can_draw_extra_card2;
+}
+
+int arcomageCardActionCount(const ArcomageCard &card, bool primary) {
+    if (primary) {
+        return card.draw_extra_card_count + (card.field_30 == 1);
+    } else {
+        return card.can_draw_extra_card2 + (card.field_4D == 1);
+    }
+}
+
+ArcomageCardResult applyArcomageCardEffects(ArcomagePlayer *player, ArcomagePlayer *enemy, const ArcomageCard &card,
+                                            bool primary) {
+    CardEffectGroups groups = cardEffectGroups(card, primary);
+
+    ArcomageCardResult result;
+    applyToOne(player, *enemy, groups.player, &result.player);
+    applyToOne(enemy, *player, groups.enemy, &result.enemy);
+    applyToBoth(player, enemy, groups.both, &result);
+    return result;
+}
+
+int applyArcomageDamage(ArcomagePlayer *player, int damage) {
+    int wall = player->wall_height;
+    int result = 0;
+
+    if (wall >= -damage) {  // wall absorbs all damage
+        result = damage;
+        player->wall_height += damage;
+    } else {
+        damage += wall;  // reduce damage by size of wall
+        player->wall_height = 0;
+        result = -wall;
+        player->tower_height += damage;  // apply remaining to tower
+    }
+
+    if (player->tower_height < 0)
+        player->tower_height = 0;
+
+    return result;
+}
+
+int calculateArcomageCardPower(const ArcomagePlayer &player, const ArcomagePlayer &enemy, const ArcomageCard &card,
+                               int mastery, int maxTowerHeight) {
+    enum class V_IND {
+        P_TOWER_M10,
+        P_WALL_M10,
+        E_TOWER,
+        E_WALL,
+        E_BUILDINGS,
+        E_QUARRY,
+        E_MAGIC,
+        E_ZOO,
+        E_RES
+    };
+    using enum V_IND;
+
+    // mastery coeffs
+    // base mastery focus on growing walls + tower
+    // second level high priority on resource gen
+    static constexpr IndexedArray<std::array<int, 2>, P_TOWER_M10, E_RES> mastery_coeff = {
+        {P_TOWER_M10,   {{10, 5}}},
+        {P_WALL_M10,    {{2, 1}}},
+        {E_TOWER,       {{1, 10}}},
+        {E_WALL,        {{1, 3}}},
+        {E_BUILDINGS,   {{1, 7}}},
+        {E_QUARRY,      {{1, 5}}},
+        {E_MAGIC,       {{1, 40}}},
+        {E_ZOO,         {{1, 40}}},
+        {E_RES,         {{1, 2}}}
+    };
+
+    int card_power = 0;
+    int element_power = 0;
+
+    if (card.to_player_tower == 99 || card.to_pl_enm_tower == 99 ||
+        card.to_player_tower2 == 99 || card.to_pl_enm_tower2 == 99) {
+        element_power = enemy.tower_height - player.tower_height;
+    } else {
+        element_power = card.to_player_tower + card.to_pl_enm_tower +
+                        card.to_player_tower2 + card.to_pl_enm_tower2;
+    }
+
+    if (player.tower_height >= 10) {
+        card_power += mastery_coeff[P_TOWER_M10][mastery] * element_power;
+    } else {
+        card_power += 20 * element_power;
+    }
+
+    if (card.to_player_wall == 99 || card.to_pl_enm_wall == 99 ||
+        card.to_player_wall2 == 99 || card.to_pl_enm_wall2 == 99) {
+        element_power = enemy.wall_height - player.wall_height;
+    } else {
+        element_power = card.to_player_wall + card.to_pl_enm_wall +
+                        card.to_player_wall2 + card.to_pl_enm_wall2;
+    }
+
+    if (player.wall_height >= 10) {
+        card_power += mastery_coeff[P_WALL_M10][mastery] * element_power;  // 1
+    } else {
+        card_power += 5 * element_power;
+    }
+
+    card_power +=
+        7 * (card.to_player_buildings + card.to_pl_enm_buildings +
+             card.to_player_buildings2 + card.to_pl_enm_buildings2);
+
+    if (card.to_player_quarry_lvl == 99 ||
+        card.to_pl_enm_quarry_lvl == 99 ||
+        card.to_player_quarry_lvl2 == 99 ||
+        card.to_pl_enm_quarry_lvl2 == 99) {
+        element_power = enemy.quarry_level - player.quarry_level;
+    } else {
+        element_power =
+            card.to_player_quarry_lvl + card.to_pl_enm_quarry_lvl +
+            card.to_player_quarry_lvl2 + card.to_pl_enm_quarry_lvl;
+    }
+
+    card_power += 40 * element_power;
+
+    if (card.to_player_magic_lvl == 99 || card.to_pl_enm_magic_lvl == 99 ||
+        card.to_player_magic_lvl2 == 99 ||
+        card.to_pl_enm_magic_lvl2 == 99) {
+        element_power = enemy.magic_level - player.magic_level;
+    } else {
+        element_power =
+            card.to_player_magic_lvl + card.to_pl_enm_magic_lvl +
+            card.to_player_magic_lvl2 + card.to_pl_enm_magic_lvl2;
+    }
+    card_power += 40 * element_power;
+
+    if (card.to_player_zoo_lvl == 99 || card.to_pl_enm_zoo_lvl == 99 ||
+        card.to_player_zoo_lvl2 == 99 || card.to_pl_enm_zoo_lvl2 == 99) {
+        element_power = enemy.zoo_level - player.zoo_level;
+    } else {
+        element_power = card.to_player_zoo_lvl + card.to_pl_enm_zoo_lvl +
+                        card.to_player_zoo_lvl2 + card.to_pl_enm_zoo_lvl2;
+    }
+    card_power += 40 * element_power;
+
+    if (card.to_player_bricks == 99 || card.to_pl_enm_bricks == 99 ||
+        card.to_player_bricks2 == 99 || card.to_pl_enm_bricks2 == 99) {
+        element_power = enemy.resource_bricks - player.resource_bricks;
+    } else {
+        element_power = card.to_player_bricks + card.to_pl_enm_bricks +
+                        card.to_player_bricks2 + card.to_pl_enm_bricks2;
+    }
+    card_power += 2 * element_power;
+
+    if (card.to_player_gems == 99 || card.to_pl_enm_gems == 99 ||
+        card.to_player_gems2 == 99 || card.to_pl_enm_gems2 == 99) {
+        element_power = enemy.resource_gems - player.resource_gems;
+    } else {
+        element_power = card.to_player_gems + card.to_pl_enm_gems +
+                        card.to_player_gems2 + card.to_pl_enm_gems2;
+    }
+    card_power += 2 * element_power;
+
+    if (card.to_player_beasts == 99 || card.to_pl_enm_beasts == 99 ||
+        card.to_player_beasts2 == 99 || card.to_pl_enm_beasts2 == 99) {
+        element_power = enemy.resource_beasts - player.resource_beasts;
+    } else {
+        element_power = card.to_player_beasts + card.to_pl_enm_beasts +
+                        card.to_player_beasts2 + card.to_pl_enm_beasts2;
+    }
+    card_power += 2 * element_power;
+
+    if (card.to_enemy_tower == 99 || card.to_enemy_tower2 == 99) {
+        element_power = player.tower_height - enemy.tower_height;
+    } else {
+        element_power = -(card.to_enemy_tower + card.to_enemy_tower2);
+    }
+    card_power += mastery_coeff[E_TOWER][mastery] * element_power;
+
+    if (card.to_enemy_wall == 99 || card.to_enemy_wall2 == 99) {
+        element_power = player.wall_height - enemy.wall_height;
+    } else {
+        element_power = -(card.to_enemy_wall + card.to_enemy_wall2);
+    }
+    card_power += mastery_coeff[E_WALL][mastery] * element_power;
+
+    card_power -= mastery_coeff[E_BUILDINGS][mastery] *
+                  (card.to_enemy_buildings + card.to_enemy_buildings2);
+
+    if (card.to_enemy_quarry_lvl == 99 || card.to_enemy_quarry_lvl2 == 99) {
+        element_power = player.quarry_level - enemy.quarry_level;  // 5
+    } else {
+        element_power =
+            -(card.to_enemy_quarry_lvl + card.to_enemy_quarry_lvl2);  // 5
+    }
+    card_power += mastery_coeff[E_QUARRY][mastery] * element_power;
+
+    if (card.to_enemy_magic_lvl == 99 || card.to_enemy_magic_lvl2 == 99) {
+        element_power = player.magic_level - enemy.magic_level;  // 40
+    } else {
+        element_power =
+            -(card.to_enemy_magic_lvl + card.to_enemy_magic_lvl2);
+    }
+    card_power += mastery_coeff[E_MAGIC][mastery] * element_power;
+
+    if (card.to_enemy_zoo_lvl == 99 || card.to_enemy_zoo_lvl2 == 99) {
+        element_power = player.zoo_level - enemy.zoo_level;  // 40
+    } else {
+        element_power = -(card.to_enemy_zoo_lvl + card.to_enemy_zoo_lvl2);
+    }
+    card_power += mastery_coeff[E_ZOO][mastery] * element_power;
+
+    if (card.to_enemy_bricks == 99 || card.to_enemy_bricks2 == 99) {
+        element_power = player.resource_bricks - enemy.resource_bricks;  // 2
+    } else {
+        element_power = -(card.to_enemy_bricks + card.to_enemy_bricks2);
+    }
+    card_power += mastery_coeff[E_RES][mastery] * element_power;
+
+    if (card.to_enemy_gems == 99 || card.to_enemy_gems2 == 99) {
+        element_power = player.resource_gems - enemy.resource_gems;  // 2
+    } else {
+        element_power = -(card.to_enemy_gems + card.to_enemy_gems2);
+    }
+    card_power += mastery_coeff[E_RES][mastery] * element_power;
+
+    if (card.to_enemy_beasts == 99 || card.to_enemy_beasts2 == 99) {
+        element_power = player.resource_beasts - enemy.resource_beasts;  // 2
+    } else {
+        element_power = -(card.to_enemy_beasts + card.to_enemy_beasts2);
+    }
+    card_power += mastery_coeff[E_RES][mastery] * element_power;
+
+    if (card.field_30 || card.field_4D) {
+        card_power *= 10;
+    }
+
+    if (card.card_resource_type == 1) {
+        element_power = player.resource_bricks - card.needed_bricks;
+    } else if (card.card_resource_type == 2) {
+        element_power = player.resource_gems - card.needed_gems;
+    } else if (card.card_resource_type == 3) {
+        element_power = player.resource_beasts - card.needed_beasts;
+    }
+    if (element_power > 3) {
+        element_power = 3;
+    }
+    card_power += 5 * element_power;
+
+    if (enemy.tower_height <= card.to_enemy_tower2 + card.to_enemy_tower) {
+        card_power += 9999;
+    }
+
+    if (card.to_enemy_tower2 + card.to_enemy_tower + card.to_enemy_wall +
+            card.to_enemy_wall2 + card.to_enemy_buildings +
+            card.to_enemy_buildings2 >=
+        enemy.wall_height + enemy.tower_height) {
+        card_power += 9999;
+    }
+
+    if ((card.to_player_tower2 + card.to_pl_enm_tower2 +
+         card.to_player_tower + card.to_pl_enm_tower +
+         player.tower_height) >= maxTowerHeight) {
+        card_power += 9999;
+    }
+
+    return card_power;
+}
+
+ArcomageMove chooseArcomageMove(const ArcomagePlayer &player, const ArcomagePlayer &enemy, int mastery,
+                                bool mustDiscard, int maxTowerHeight, RandomEngine *rng) {
+    int ai_player_cards_count = arcomageHandCardCount(player);
+    if (ai_player_cards_count == 0)
+        return {};
+
+    if (mastery == 0) {
+        // select card at random to play
+        int random_card_slot;
+        if (!mustDiscard) {
+            for (int i = 0; i < 10; ++i) {
+                random_card_slot = rng->randomInSegment(0, ai_player_cards_count - 1);
+                if (isHandCardPlayable(player, random_card_slot))
+                    return {random_card_slot, false};
+            }
+        }
+
+        // if that fails discard card at random
+        random_card_slot = rng->randomInSegment(0, ai_player_cards_count - 1);
+        return {random_card_slot, true};
+    } else if (mastery == 1 || mastery == 2) {
+        // apply some cunning
+        struct CardPower {
+            int slot_index;
+            int card_power;
+        };
+        std::array<CardPower, 10> cards_power;
+
+        // wipe cards power array - set negative for unfilled card slots
+        for (int i = 0; i < 10; ++i) {
+            if (i >= ai_player_cards_count) {
+                cards_power[i].slot_index = -1;
+                cards_power[i].card_power = -9999;
+            } else {
+                cards_power[i].slot_index = i;
+                cards_power[i].card_power = 0;
+            }
+        }
+
+        // calculate how effective each card would be, empty slots go last
+        for (int i = 0; i < ai_player_cards_count; ++i) {
+            int cardId = player.cards_at_hand[cards_power[i].slot_index];
+            if (cardId == -1) {
+                cards_power[i].card_power = -9999;
+            } else {
+                cards_power[i].card_power = calculateArcomageCardPower(player, enemy, pCards[cardId], mastery - 1,
+                                                                       maxTowerHeight);
+            }
+        }
+
+        // sort the card powers in order, stable to match the bubble sort that was used here originally
+        std::stable_sort(cards_power.begin(), cards_power.begin() + ai_player_cards_count,
+                         [](const CardPower &l, const CardPower &r) { return l.card_power > r.card_power; });
+
+        // if we have to discard pick the least powerful to chuck
+        int discard_slot = 0;
+        for (int i = ai_player_cards_count - 1; i > 0; --i) {
+            int cardId = player.cards_at_hand[cards_power[i].slot_index];
+            if (cardId != -1 && pCards[cardId].can_be_discarded)
+                discard_slot = cards_power[i].slot_index;
+        }
+
+        if (!mustDiscard) {
+            // try and play most powerful card
+            for (int i = 0; i < ai_player_cards_count - 1; ++i) {
+                if (isHandCardPlayable(player, cards_power[i].slot_index) && cards_power[i].card_power)
+                    return {cards_power[i].slot_index, false};
+            }
+        }
+
+        // fall back - have to discard
+        return {discard_slot, true};
+    }
+    return {};
+}
+
+bool isArcomageGameOver(std::span<const ArcomagePlayer, 2> players, int maxTowerHeight, int maxResources) {
+    // check if victory conditions have been met
+    for (const ArcomagePlayer &player : players) {
+        if (player.tower_height <= 0 || player.tower_height >= maxTowerHeight)
+            return true;
+        if (player.resource_bricks >= maxResources || player.resource_gems >= maxResources ||
+            player.resource_beasts >= maxResources)
+            return true;
+    }
+    return false;
+}
+
+ArcomageOutcome arcomageGameOutcome(std::span<const ArcomagePlayer, 2> players, int maxTowerHeight,
+                                    int maxResources) {
+    int winner = -1;
+    int victory_type = -1;
+
+    //проверка построена ли башня
+    if (players[0].tower_height < maxTowerHeight &&
+        players[1].tower_height >=
+            maxTowerHeight) {  //наша башня не построена, а у врага построена
+        winner = 2;  //победил игрок 2(враг)
+        victory_type = 0;
+    } else if (players[0].tower_height >= maxTowerHeight &&
+               players[1].tower_height <
+                   maxTowerHeight) {  //наша башня построена, а у врага нет
+        winner = 1;  //победил игрок 1(мы)
+        victory_type = 0;
+    } else if (players[0].tower_height >= maxTowerHeight &&
+               players[1].tower_height >=
+                   maxTowerHeight) {  //и у нас, и у врага построена
+        if (players[0].tower_height ==
+            players[1].tower_height) {  //наши башни равны
+            winner = 0;        //никто не победил
+            victory_type = 4;  //ничья
+        } else {               //наши башни не равны
+            winner =
+                (players[0].tower_height <= players[1].tower_height) +
+                1;  //победил тот, у кого выше
+            victory_type = 0;
+        }
+    }
+
+    //проверка разрушена ли башня
+    if (players[0].tower_height <= 0 &&
+        players[1].tower_height > 0) {  //наша башня разрушена, а у врага нет
+        winner = 2;        // победил игрок 2(враг)
+        victory_type = 2;  //победил разрушив башню врага
+    } else if (players[0].tower_height > 0 &&
+               players[1].tower_height <=
+                   0) {  //у врага башня разрушена, а у нас нет
+        winner = 1;        //победил игрок 1(мы)
+        victory_type = 2;  //победил разрушив башню врага
+    } else if (players[0].tower_height <= 0 &&
+               players[1].tower_height <=
+                   0) {  //наша башня разрушена, и у врага разрушена
+        if (players[0].tower_height ==
+            players[1].tower_height) {  //если башни равны
+            if (players[0].wall_height ==
+                players[1].wall_height) {  //если стены равны
+                winner = 0;
+                victory_type = 4;
+            } else {  //если стены не равны
+                winner =
+                    (players[0].wall_height <= players[1].wall_height) +
+                    1;  //победил тот, у кого стена выше
+                victory_type = 1;  //победа когда больше стена при ничье
+            }
+        } else {  //башни не равны
+            winner =
+                (players[0].tower_height <= players[1].tower_height) +
+                1;  // побеждает тот у кого башня больше
+            victory_type = 2;  //победил разрушив башню врага
+        }
+    }
+
+    //проверка набраны ли ресурсы
+    //проверка какого ресурса больше всего у игроков
+    int pl_resource = maxResource(players[0]);
+    int en_resource = maxResource(players[1]);
+
+    //сравнение ресурсов игроков
+    if (winner == -1 && victory_type == -1) {  //нет победителя по башням
+        if (pl_resource < maxResources &&
+            en_resource >=
+                maxResources) {  //враг набрал нужное количество
+            winner = 2;  // враг победил
+            victory_type = 3;  //победа собрав нужное количество ресурсов
+        } else if (pl_resource >= maxResources &&
+                   en_resource <
+                       maxResources) {  //мы набрали нужное количество
+            winner = 1;  // мы победили
+            victory_type = 3;  //победа собрав нужное количество ресурсов
+        } else if (pl_resource >= maxResources &&
+                   en_resource >=
+                       maxResources) {  //и у нас и у врага нужное
+                                                //количество ресурсов
+            if (pl_resource == en_resource) {  // ресурсы равны
+                winner = 0;        //ресурсы равны
+                victory_type = 4;  //ничья
+            } else {
+                winner = (pl_resource <= en_resource) +
+                         1;  //ресурсы не равны, побеждает тот у кого больше
+                victory_type = 3;  //победа собрав нужное количество ресурсов
+            }
+        }
+    } else if (winner == 0 && victory_type == 4) {  // при ничье по башням и стене
+        if (pl_resource != en_resource) {  //ресурсы не равны
+            winner =
+                (pl_resource <= en_resource) + 1;  //победил тот у кого больше
+            victory_type =
+                5;  //победа когда при ничье большее количество ресурсов
+        } else {    //ресурсы равны
+            winner = 0;        //нет победителя
+            victory_type = 4;  //ничья
+        }
+    }
+
+    return {winner, victory_type};
+}
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "Library/Geometry/Point.h"
+
+#include "GUI/UI/UIHouseEnums.h"
+
+class RandomEngine;
+
+/**
+ * @file
+ *
+ * Arcomage game rules that don't depend on the game UI, the renderer or any global state. These are used both by the
+ * in-game Arcomage, which keeps its state in globals, and by the headless simulator in `ArcomageSimulator.h`, which
+ * keeps it in `ArcomageState`.
+ */
+
+enum class ArcomageCheck {
+    CHECK_ALWAYS_SECONDARY = 0,
+    CHECK_ALWAYS_PRIMARY = 1,
+    CHECK_LESSER_QUARRY = 2,
+    CHECK_LESSER_MAGIC = 3,
+    CHECK_LESSER_ZOO = 4,
+    CHECK_EQUAL_QUARRY = 5,
+    CHECK_EQUAL_MAGIC = 6,
+    CHECK_EQUAL_ZOO = 7,
+    CHECK_GREATER_QUARRY = 8,
+    CHECK_GREATER_MAGIC = 9,
+    CHECK_GREATER_ZOO = 10,
+    CHECK_NO_WALL = 11,
+    CHECK_HAVE_WALL = 12,
+    CHECK_ENEMY_HAS_NO_WALL = 13,
+    CHECK_ENEMY_HAS_WALL = 14,
+    CHECK_LESSER_WALL = 15,
+    CHECK_LESSER_TOWER = 16,
+    CHECK_EQUAL_WALL = 17,
+    CHECK_EQUAL_TOWER = 18,
+    CHECK_GREATER_WALL = 19,
+    CHECK_GREATER_TOWER = 20
+};
+using enum ArcomageCheck;
+
+struct ArcomageCard {
+    char pCardName[32];
+    int32_t slot = 0;
+    int8_t card_resource_type = 0;  // 1- brick, 2-gems, 3-beasts
+    int8_t needed_quarry_level = 0;
+    int8_t needed_magic_level = 0;
+    int8_t needed_zoo_level = 0;
+    int8_t needed_bricks = 0;
+    int8_t needed_gems = 0;
+    int8_t needed_beasts = 0;
+    bool can_be_discarded = true;
+    ArcomageCheck compare_param = CHECK_ALWAYS_PRIMARY;
+    int8_t field_30;  // play again
+    int8_t draw_extra_card_count = 0;
+    int8_t to_player_quarry_lvl = 0;
+    int8_t to_player_magic_lvl = 0;
+    int8_t to_player_zoo_lvl = 0;
+    int8_t to_player_bricks = 0;
+    int8_t to_player_gems = 0;
+    int8_t to_player_beasts = 0;
+    int8_t to_player_buildings = 0;
+    int8_t to_player_wall = 0;
+    int8_t to_player_tower = 0;
+    int8_t to_enemy_quarry_lvl = 0;
+    int8_t to_enemy_magic_lvl = 0;
+    int8_t to_enemy_zoo_lvl = 0;
+    int8_t to_enemy_bricks = 0;
+    int8_t to_enemy_gems = 0;
+    int8_t to_enemy_beasts = 0;
+    int8_t to_enemy_buildings = 0;
+    int8_t to_enemy_wall = 0;
+    int8_t to_enemy_tower = 0;
+    int8_t to_pl_enm_quarry_lvl = 0;
+    int8_t to_pl_enm_magic_lvl = 0;
+    int8_t to_pl_enm_zoo_lvl = 0;
+    int8_t to_pl_enm_bricks = 0;
+    int8_t to_pl_enm_gems = 0;
+    int8_t to_pl_enm_beasts = 0;
+    int8_t to_pl_enm_buildings = 0;
+    int8_t to_pl_enm_wall = 0;
+    int8_t to_pl_enm_tower = 0;
+    int8_t field_4D = 0;  // play again 2
+    int8_t can_draw_extra_card2 = 0;
+    int8_t to_player_quarry_lvl2 = 0;
+    int8_t to_player_magic_lvl2 = 0;
+    int8_t to_player_zoo_lvl2 = 0;
+    int8_t to_player_bricks2 = 0;
+    int8_t to_player_gems2 = 0;
+    int8_t to_player_beasts2 = 0;
+    int8_t to_player_buildings2 = 0;
+    int8_t to_player_wall2 = 0;
+    int8_t to_player_tower2 = 0;
+    int8_t to_enemy_quarry_lvl2 = 0;
+    int8_t to_enemy_magic_lvl2 = 0;
+    int8_t to_enemy_zoo_lvl2 = 0;
+    int8_t to_enemy_bricks2 = 0;
+    int8_t to_enemy_gems2 = 0;
+    int8_t to_enemy_beasts2 = 0;
+    int8_t to_enemy_buildings2 = 0;
+    int8_t to_enemy_wall2 = 0;
+    int8_t to_enemy_tower2 = 0;
+    int8_t to_pl_enm_quarry_lvl2 = 0;
+    int8_t to_pl_enm_magic_lvl2 = 0;
+    int8_t to_pl_enm_zoo_lvl2 = 0;
+    int8_t to_pl_enm_bricks2 = 0;
+    int8_t to_pl_enm_gems2 = 0;
+    int8_t to_pl_enm_beasts2 = 0;
+    int8_t to_pl_enm_buildings2 = 0;
+    int8_t to_pl_enm_wall2 = 0;
+    int8_t to_pl_enm_tower2 = 0;
+    int8_t field_6A = 0;  // unused??
+    int8_t field_6B = 0;  // unused??
+};
+
+struct ArcomagePlayer {
+    std::string pPlayerName;
+    int IsHisTurn = 0;  // doesnt appear to be used correctly - always player 0 turn
+    int tower_height = 0;
+    int wall_height = 0;
+    int quarry_level = 0;
+    int magic_level = 0;
+    int zoo_level = 0;
+    int resource_bricks = 0;
+    int resource_gems = 0;
+    int resource_beasts = 0;
+    int cards_at_hand[10] {};
+    Pointi card_shift[10] {};
+};
+
+#define DECK_SIZE 108
+
+struct ArcomageDeck {
+    std::string name{};
+    char cardsInUse[DECK_SIZE]{};
+    int cards_IDs[DECK_SIZE]{};
+};
+
+extern ArcomageCard pCards[87];
+
+/**
+ * Game parameters, as set up by the tavern where the game is played.
+ */
+struct ArcomageRules {
+    int startTowerHeight = 20;
+    int startWallHeight = 5;
+    int startQuarryLevel = 1; // Start levels don't include the per-turn bonuses, see below.
+    int startMagicLevel = 1;
+    int startZooLevel = 1;
+    int startBricks = 5;
+    int startGems = 5;
+    int startBeasts = 5;
+
+    int maxTowerHeight = 50; // Building a tower this high wins the game.
+    int maxResources = 150; // Collecting this many of any resource wins the game.
+
+    int minimumCardsAtHand = 5;
+    int quarryBonus = 1; // Per-turn bonuses, act as an effective min level.
+    int magicBonus = 1;
+    int zooBonus = 1;
+
+    int aiMastery = 1; // Opponent AI skill level, `0` plays at random, `1` & `2` use `calculateArcomageCardPower`.
+};
+
+/**
+ * @param houseId                       Arcomage tavern.
+ * @return                              Rules for the games played in the provided tavern.
+ */
+[[nodiscard]] ArcomageRules arcomageTavernRules(HouseId houseId);
+
+/**
+ * Stat changes caused by a card, for a single player. Used to play the sounds and show the effects.
+ */
+struct ArcomageCardEffects {
+    int quarry = 0;
+    int magic = 0;
+    int zoo = 0;
+    int bricks = 0;
+    int gems = 0;
+    int beasts = 0;
+    int wall = 0;
+    int tower = 0;
+    int buildings = 0; // Part of the buildings damage that went to the tower.
+    int damage = 0; // Part of the buildings damage that went to the wall.
+};
+
+struct ArcomageCardResult {
+    ArcomageCardEffects player;
+    ArcomageCardEffects enemy;
+};
+
+/**
+ * Move chosen by the AI.
+ */
+struct ArcomageMove {
+    int slot = -1; // Hand slot of the card to play or discard, `-1` means there is nothing to do.
+    bool discard = false;
+};
+
+/**
+ * Result of a finished game, see `arcomageGameOutcome`.
+ */
+struct ArcomageOutcome {
+    int winner = -1; // `0` for a draw, `1` if player 0 won, `2` if player 1 won, `-1` if the game is not over.
+    int victoryType = -1; // `0` tower built, `1` more wall after mutual destruction, `2` enemy tower
+                          // destroyed, `3` resources collected, `4` draw, `5` more resources after a draw.
+};
+
+/**
+ * @param player                        Player.
+ * @return                              Number of cards in the player's hand.
+ */
+[[nodiscard]] int arcomageHandCardCount(const ArcomagePlayer &player);
+
+/**
+ * @param player                        Player.
+ * @return                              First empty slot in the player's hand, or `-1` if the hand is full.
+ */
+[[nodiscard]] int arcomageEmptyHandSlot(const ArcomagePlayer &player);
+
+/**
+ * @param player                        Player.
+ * @param card                          Card to check.
+ * @return                              Whether the player has the levels & resources to play the card.
+ */
+[[nodiscard]] bool canPlayArcomageCard(const ArcomagePlayer &player, const ArcomageCard &card);
+
+/**
+ * Takes the card's resource cost from the player.
+ *
+ * @param[in,out] player                Player.
+ * @param card                          Card being played.
+ */
+void payArcomageCardCost(ArcomagePlayer *player, const ArcomageCard &card);
+
+/**
+ * Fills the master deck with the card ids. Master deck is then shuffled into the play deck with
+ * `shuffleArcomageDeck`.
+ *
+ * @param[out] masterDeck               Deck to fill.
+ */
+void initArcomageMasterDeck(ArcomageDeck *masterDeck);
+
+/**
+ * Shuffles the master deck into the play deck. Cards that are in the players' hands are marked as in use, and are
+ * skipped when drawing.
+ *
+ * @param[out] playDeck                 Play deck.
+ * @param[in,out] masterDeck            Master deck.
+ * @param players                       Players, for the cards in hands.
+ * @param rng                           Random engine to use.
+ */
+void shuffleArcomageDeck(ArcomageDeck *playDeck, ArcomageDeck *masterDeck, std::span<const ArcomagePlayer, 2> players,
+                         RandomEngine *rng);
+
+/**
+ * Draws the next card from the play deck, reshuffling the deck if all the cards were drawn.
+ *
+ * @param[in,out] playDeck              Play deck.
+ * @param[in,out] masterDeck            Master deck.
+ * @param[in,out] deckWalkIndex         Index of the next card in the play deck. Gets reset on reshuffle, so callers
+ *                                      can check whether it went down.
+ * @param players                       Players, for the cards in hands.
+ * @param rng                           Random engine to use for reshuffling.
+ * @return                              Id of the drawn card.
+ */
+[[nodiscard]] int drawArcomageCard(ArcomageDeck *playDeck, ArcomageDeck *masterDeck, int *deckWalkIndex,
+                                   std::span<const ArcomagePlayer, 2> players, RandomEngine *rng);
+
+/**
+ * @param player                        Player that's playing the card.
+ * @param enemy                         Other player.
+ * @param card                          Card being played.
+ * @return                              Whether the card's primary effects apply. If not, secondary effects apply.
+ */
+[[nodiscard]] bool isArcomageCardPrimary(const ArcomagePlayer &player, const ArcomagePlayer &enemy,
+                                         const ArcomageCard &card);
+
+/**
+ * @param card                          Card being played.
+ * @param primary                       Whether primary effects apply, see `isArcomageCardPrimary`.
+ * @return                              Number of extra cards that the player draws.
+ */
+[[nodiscard]] int arcomageCardDrawCount(const ArcomageCard &card, bool primary);
+
+/**
+ * @param card                          Card being played.
+ * @param primary                       Whether primary effects apply, see `isArcomageCardPrimary`.
+ * @return                              Number of extra actions that the card gives.
+ */
+[[nodiscard]] int arcomageCardActionCount(const ArcomageCard &card, bool primary);
+
+/**
+ * Applies the card's effects to the players' levels, resources & buildings. Doesn't draw any cards, see
+ * `arcomageCardDrawCount`.
+ *
+ * @param[in,out] player                Player that's playing the card.
+ * @param[in,out] enemy                 Other player.
+ * @param card                          Card being played.
+ * @param primary                       Whether primary effects apply, see `isArcomageCardPrimary`.
+ * @return                              Stat changes for both players.
+ */
+ArcomageCardResult applyArcomageCardEffects(ArcomagePlayer *player, ArcomagePlayer *enemy, const ArcomageCard &card,
+                                            bool primary);
+
+/**
+ * Applies damage to the player's wall first, and then whatever is left to the tower.
+ *
+ * @param[in,out] player                Player to damage.
+ * @param damage                        Damage, negative values damage, positive values build the wall.
+ * @return                              Part of the damage that went to the wall.
+ */
+int applyArcomageDamage(ArcomagePlayer *player, int damage);
+
+/**
+ * @param player                        Player that's considering the card.
+ * @param enemy                         Other player.
+ * @param card                          Card to evaluate.
+ * @param mastery                       AI calculation mode, `0` or `1`.
+ * @param maxTowerHeight                Tower height that wins the game.
+ * @return                              AI estimate of how good it would be to play the card.
+ */
+[[nodiscard]] int calculateArcomageCardPower(const ArcomagePlayer &player, const ArcomagePlayer &enemy,
+                                             const ArcomageCard &card, int mastery, int maxTowerHeight);
+
+/**
+ * Picks the AI move.
+ *
+ * @param player                        Player that's making the move.
+ * @param enemy                         Other player.
+ * @param mastery                       AI skill level, see `ArcomageRules::aiMastery`.
+ * @param mustDiscard                   Whether the player has to discard a card.
+ * @param maxTowerHeight                Tower height that wins the game.
+ * @param rng                           Random engine to use.
+ * @return                              Chosen move. Note that discard moves might pick a card that can't be
+ *                                      discarded, in which case the move is wasted.
+ */
+[[nodiscard]] ArcomageMove chooseArcomageMove(const ArcomagePlayer &player, const ArcomagePlayer &enemy, int mastery,
+                                              bool mustDiscard, int maxTowerHeight, RandomEngine *rng);
+
+/**
+ * @param players                       Players.
+ * @param maxTowerHeight                Tower height that wins the game.
+ * @param maxResources                  Resource amount that wins the game.
+ * @return                              Whether the game is over.
+ */
+[[nodiscard]] bool isArcomageGameOver(std::span<const ArcomagePlayer, 2> players, int maxTowerHeight, int maxResources);
+
+/**
+ * @param players                       Players.
+ * @param maxTowerHeight                Tower height that wins the game.
+ * @param maxResources                  Resource amount that wins the game.
+ * @return                              Game outcome.
+ */
+[[nodiscard]] ArcomageOutcome arcomageGameOutcome(std::span<const ArcomagePlayer, 2> players, int maxTowerHeight,
+                                                  int maxResources);
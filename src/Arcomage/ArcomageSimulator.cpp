@@ -0,0 +1,196 @@
+#include "ArcomageSimulator.h"
+
+#include <algorithm>
+
+#include "Library/Random/MersenneTwisterRandomEngine.h"
+
+#include "Utility/Thread/ThreadPool.h"
+
+static constexpr size_t GAMES_PER_CHUNK = 1024;
+
+// Safety net for the discard loop, AI might keep picking a card that can't be discarded.
+static constexpr int MAX_DISCARD_ATTEMPTS = 100;
+
+static void drawCard(ArcomageState *state, int playerIndex, RandomEngine *rng) {
+    int cardId = drawArcomageCard(&state->playDeck, &state->masterDeck, &state->deckWalkIndex, state->players, rng);
+    ArcomagePlayer &player = state->players[playerIndex];
+    int slot = arcomageEmptyHandSlot(player);
+    if (slot != -1)
+        player.cards_at_hand[slot] = cardId;
+}
+
+static void topUpHand(ArcomageState *state, const ArcomageRules &rules, RandomEngine *rng) {
+    while (arcomageHandCardCount(state->players[state->currentPlayer]) <= rules.minimumCardsAtHand)
+        drawCard(state, state->currentPlayer, rng);
+}
+
+// Returns whether the move has drawn any cards.
+static bool makeMove(ArcomageState *state, const ArcomageRules &rules, int mastery, RandomEngine *rng) {
+    ArcomagePlayer &player = state->players[state->currentPlayer];
+    ArcomagePlayer &enemy = state->players[(state->currentPlayer + 1) % 2];
+
+    ArcomageMove move = chooseArcomageMove(player, enemy, mastery, state->needToDiscard, rules.maxTowerHeight, rng);
+    if (move.slot == -1 || player.cards_at_hand[move.slot] == -1)
+        return false;
+
+    const ArcomageCard &card = pCards[player.cards_at_hand[move.slot]];
+    if (move.discard) {
+        if (card.can_be_discarded) {
+            player.cards_at_hand[move.slot] = -1;
+            state->needToDiscard = false;
+        }
+        return false;
+    }
+
+    if (!canPlayArcomageCard(player, card))
+        return false;
+    payArcomageCardCost(&player, card);
+    player.cards_at_hand[move.slot] = -1;
+
+    bool primary = isArcomageCardPrimary(player, enemy, card);
+    int drawCount = arcomageCardDrawCount(card, primary);
+    state->actionsLeft = arcomageCardActionCount(card, primary);
+    for (int i = 0; i < drawCount; i++)
+        drawCard(state, state->currentPlayer, rng);
+    state->needToDiscard = arcomageHandCardCount(player) > rules.minimumCardsAtHand;
+
+    applyArcomageCardEffects(&player, &enemy, card, primary);
+    return drawCount > 0;
+}
+
+// Mirrors `PlayerTurn` in `Arcomage.cpp`, returns whether the player gets to draw a card and act again.
+static bool playActions(ArcomageState *state, const ArcomageRules &rules, int mastery, RandomEngine *rng) {
+    state->actionsLeft = 0;
+    topUpHand(state, rules, rng);
+
+    while (true) {
+        // In game, the draw animation started by the move finishes before the play animation does, so there's time
+        // for one top-up draw. The rest of the top-up happens before the next move.
+        bool topUpPending = false;
+        if (makeMove(state, rules, mastery, rng) &&
+            arcomageHandCardCount(state->players[state->currentPlayer]) <= rules.minimumCardsAtHand) {
+            drawCard(state, state->currentPlayer, rng);
+            topUpPending = true;
+        }
+
+        if (state->actionsLeft <= 1)
+            break;
+
+        state->actionsLeft--;
+        if (topUpPending)
+            topUpHand(state, rules, rng);
+    }
+
+    return state->actionsLeft > 0;
+}
+
+ArcomageSimulationStats &ArcomageSimulationStats::operator+=(const ArcomageSimulationStats &other) {
+    gameCount += other.gameCount;
+    for (size_t i = 0; i < wins.size(); i++)
+        wins[i] += other.wins[i];
+    for (size_t i = 0; i < victoryTypes.size(); i++)
+        victoryTypes[i] += other.victoryTypes[i];
+    unfinishedCount += other.unfinishedCount;
+    turnCount += other.turnCount;
+    return *this;
+}
+
+ArcomageState newArcomageGame(const ArcomageRules &rules, int firstPlayer, RandomEngine *rng) {
+    ArcomageState result;
+    for (ArcomagePlayer &player : result.players) {
+        player.tower_height = rules.startTowerHeight;
+        player.wall_height = rules.startWallHeight;
+        player.quarry_level = rules.startQuarryLevel;
+        player.magic_level = rules.startMagicLevel;
+        player.zoo_level = rules.startZooLevel;
+        player.resource_bricks = rules.startBricks;
+        player.resource_gems = rules.startGems;
+        player.resource_beasts = rules.startBeasts;
+        std::ranges::fill(player.cards_at_hand, -1);
+    }
+
+    initArcomageMasterDeck(&result.masterDeck);
+    shuffleArcomageDeck(&result.playDeck, &result.masterDeck, result.players, rng);
+
+    // Only the second player gets the initial hand, the first one fills it up on the first turn.
+    result.currentPlayer = firstPlayer;
+    for (int i = 0; i < rules.minimumCardsAtHand; ++i)
+        drawCard(&result, (firstPlayer + 1) % 2, rng);
+
+    return result;
+}
+
+bool playArcomageTurn(ArcomageState *state, const ArcomageRules &rules, int mastery, RandomEngine *rng) {
+    ArcomagePlayer &player = state->players[state->currentPlayer];
+    player.resource_bricks += rules.quarryBonus + player.quarry_level;
+    player.resource_gems += rules.magicBonus + player.magic_level;
+    player.resource_beasts += rules.zooBonus + player.zoo_level;
+
+    bool turnNotFinished = true;
+    while (turnNotFinished) {
+        drawCard(state, state->currentPlayer, rng);
+        for (int attempt = 0; attempt < MAX_DISCARD_ATTEMPTS; attempt++) {
+            turnNotFinished = playActions(state, rules, mastery, rng);
+            state->needToDiscard = arcomageHandCardCount(player) > rules.minimumCardsAtHand;
+            if (!state->needToDiscard)
+                break;
+        }
+        if (state->needToDiscard)
+            break; // Stuck with a card that can't be discarded, end the turn.
+    }
+
+    state->turnCount++;
+    if (isArcomageGameOver(state->players, rules.maxTowerHeight, rules.maxResources))
+        return true;
+
+    state->currentPlayer = (state->currentPlayer + 1) % 2;
+    return false;
+}
+
+ArcomageSimulationStats simulateArcomageGame(const ArcomageSimulationSettings &settings, RandomEngine *rng) {
+    ArcomageState state = newArcomageGame(settings.rules, settings.firstPlayer, rng);
+
+    bool gameOver = false;
+    while (!gameOver && state.turnCount < settings.maxTurns)
+        gameOver = playArcomageTurn(&state, settings.rules, settings.mastery[state.currentPlayer], rng);
+
+    ArcomageSimulationStats result;
+    result.gameCount = 1;
+    result.turnCount = state.turnCount;
+    if (gameOver) {
+        ArcomageOutcome outcome = arcomageGameOutcome(state.players, settings.rules.maxTowerHeight,
+                                                      settings.rules.maxResources);
+        if (outcome.winner >= 0)
+            result.wins[outcome.winner]++;
+        if (outcome.victoryType >= 0)
+            result.victoryTypes[outcome.victoryType]++;
+    } else {
+        result.unfinishedCount = 1;
+    }
+    return result;
+}
+
+ArcomageSimulationStats simulateArcomageGames(const ArcomageSimulationSettings &settings, ThreadPool *pool) {
+    auto simulateChunk = [&](size_t begin, size_t end) {
+        MersenneTwisterRandomEngine rng;
+        rng.seed(static_cast<int>(static_cast<unsigned>(settings.seed) * 7919u + begin / GAMES_PER_CHUNK + 1));
+
+        ArcomageSimulationStats chunkStats;
+        for (size_t i = begin; i < end; i++)
+            chunkStats += simulateArcomageGame(settings, &rng);
+        return chunkStats;
+    };
+
+    auto combine = [](ArcomageSimulationStats result, const ArcomageSimulationStats &chunkStats) {
+        result += chunkStats;
+        return result;
+    };
+
+    if (pool)
+        return pool->parallelReduce(settings.gameCount, GAMES_PER_CHUNK, ArcomageSimulationStats(), simulateChunk, combine);
+
+    ArcomageSimulationStats result;
+    for (size_t begin = 0; begin < static_cast<size_t>(settings.gameCount); begin += GAMES_PER_CHUNK)
+        result += simulateChunk(begin, std::min(begin + GAMES_PER_CHUNK, static_cast<size_t>(settings.gameCount)));
+    return result;
+}
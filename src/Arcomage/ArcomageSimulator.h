@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "ArcomageRules.h"
+
+class RandomEngine;
+class ThreadPool;
+
+/**
+ * Complete state of an Arcomage game, as seen by the headless simulator. This is a plain copyable struct, so it's
+ * possible to fork a game in the middle, e.g. to evaluate moves by playing them out.
+ */
+struct ArcomageState {
+    std::array<ArcomagePlayer, 2> players;
+    ArcomageDeck playDeck;
+    ArcomageDeck masterDeck;
+    int deckWalkIndex = 0;
+    int currentPlayer = 0;
+    int actionsLeft = 0;
+    bool needToDiscard = false;
+    int turnCount = 0;
+};
+
+struct ArcomageSimulationSettings {
+    ArcomageRules rules;
+    std::array<int, 2> mastery = {{1, 1}}; // AI mastery for both players, see `ArcomageRules::aiMastery`.
+    int firstPlayer = 0;
+    int maxTurns = 1000; // Games that take longer are counted as unfinished.
+    int64_t gameCount = 1;
+    int seed = 0; // Games are seeded from this value in chunks, so results don't depend on the number of threads.
+};
+
+struct ArcomageSimulationStats {
+    int64_t gameCount = 0;
+    std::array<int64_t, 3> wins = {}; // Indexed by `ArcomageOutcome::winner`, so draws go first.
+    std::array<int64_t, 6> victoryTypes = {}; // Indexed by `ArcomageOutcome::victoryType`.
+    int64_t unfinishedCount = 0; // Games that have hit `ArcomageSimulationSettings::maxTurns`.
+    int64_t turnCount = 0; // Total number of turns over all the games.
+
+    ArcomageSimulationStats &operator+=(const ArcomageSimulationStats &other);
+};
+
+/**
+ * Sets up a new game, with the starting stats from the provided rules and with the second player's initial hand
+ * dealt, same as the in-game Arcomage does.
+ *
+ * @param rules                         Game rules.
+ * @param firstPlayer                   Player that makes the first turn.
+ * @param rng                           Random engine to use.
+ * @return                              New game state.
+ */
+[[nodiscard]] ArcomageState newArcomageGame(const ArcomageRules &rules, int firstPlayer, RandomEngine *rng);
+
+/**
+ * Plays one turn of the current player with the AI, and passes the turn to the other player.
+ *
+ * This follows the in-game Arcomage loop, minus the animations. Draws that the in-game loop interleaves with the card
+ * animations happen at the equivalent points here.
+ *
+ * @param[in,out] state                 Game state.
+ * @param rules                         Game rules.
+ * @param mastery                       AI mastery of the current player.
+ * @param rng                           Random engine to use.
+ * @return                              Whether the game is over.
+ */
+bool playArcomageTurn(ArcomageState *state, const ArcomageRules &rules, int mastery, RandomEngine *rng);
+
+/**
+ * Plays an AI-vs-AI game to completion.
+ *
+ * @param settings                      Simulation settings, `gameCount` & `seed` are ignored.
+ * @param rng                           Random engine to use.
+ * @return                              Stats for a single game.
+ */
+[[nodiscard]] ArcomageSimulationStats simulateArcomageGame(const ArcomageSimulationSettings &settings,
+                                                           RandomEngine *rng);
+
+/**
+ * Plays `settings.gameCount` AI-vs-AI games, in parallel.
+ *
+ * @param settings                      Simulation settings.
+ * @param pool                          Thread pool to use, `nullptr` means run everything on the calling thread.
+ * @return                              Combined stats for all the games.
+ */
+[[nodiscard]] ArcomageSimulationStats simulateArcomageGames(const ArcomageSimulationSettings &settings,
+                                                            ThreadPool *pool);
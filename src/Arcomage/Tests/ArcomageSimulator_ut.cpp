@@ -0,0 +1,61 @@
+#include <numeric>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Arcomage/ArcomageSimulator.h"
+
+#include "Library/Random/MersenneTwisterRandomEngine.h"
+
+#include "Utility/Thread/ThreadPool.h"
+
+static void expectSameStats(const ArcomageSimulationStats &l, const ArcomageSimulationStats &r) {
+    EXPECT_EQ(l.gameCount, r.gameCount);
+    EXPECT_EQ(l.wins, r.wins);
+    EXPECT_EQ(l.victoryTypes, r.victoryTypes);
+    EXPECT_EQ(l.unfinishedCount, r.unfinishedCount);
+    EXPECT_EQ(l.turnCount, r.turnCount);
+}
+
+UNIT_TEST(ArcomageSimulator, SingleGame) {
+    ArcomageSimulationSettings settings;
+    MersenneTwisterRandomEngine rng;
+    rng.seed(123);
+
+    ArcomageSimulationStats stats = simulateArcomageGame(settings, &rng);
+    EXPECT_EQ(stats.gameCount, 1);
+    EXPECT_GT(stats.turnCount, 0);
+    EXPECT_LE(stats.turnCount, settings.maxTurns);
+    EXPECT_EQ(std::accumulate(stats.wins.begin(), stats.wins.end(), int64_t(0)) + stats.unfinishedCount, 1);
+}
+
+UNIT_TEST(ArcomageSimulator, Deterministic) {
+    ArcomageSimulationSettings settings;
+    settings.gameCount = 300;
+    settings.seed = 42;
+
+    ArcomageSimulationStats stats0 = simulateArcomageGames(settings, nullptr);
+    ArcomageSimulationStats stats1 = simulateArcomageGames(settings, nullptr);
+    expectSameStats(stats0, stats1);
+
+    EXPECT_EQ(stats0.gameCount, settings.gameCount);
+    int64_t finished = std::accumulate(stats0.wins.begin(), stats0.wins.end(), int64_t(0));
+    EXPECT_EQ(finished + stats0.unfinishedCount, settings.gameCount);
+    EXPECT_EQ(std::accumulate(stats0.victoryTypes.begin(), stats0.victoryTypes.end(), int64_t(0)), finished);
+
+    settings.seed = 43;
+    ArcomageSimulationStats stats2 = simulateArcomageGames(settings, nullptr);
+    EXPECT_NE(stats0.turnCount, stats2.turnCount);
+}
+
+UNIT_TEST(ArcomageSimulator, ThreadCountIndependent) {
+    ArcomageSimulationSettings settings;
+    settings.gameCount = 300;
+    settings.seed = 7;
+    settings.mastery = {{0, 2}};
+
+    ArcomageSimulationStats expected = simulateArcomageGames(settings, nullptr);
+    for (int threadCount : {1, 2, 5}) {
+        ThreadPool pool(threadCount);
+        expectSameStats(simulateArcomageGames(settings, &pool), expected);
+    }
+}
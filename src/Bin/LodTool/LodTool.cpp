@@ -1,11 +1,19 @@
 #include "LodToolOptions.h"
+#include "LodToolBench.h"
 
 #include <cstdio>
+#include <filesystem>
+#include <string>
 
+#include "Library/Lod/LodChunkStore.h"
 #include "Library/Lod/LodReader.h"
+#include "Library/LodFormats/LodBundleReader.h"
+#include "Library/LodFormats/LodBundleWriter.h"
 #include "Library/LodFormats/LodFormats.h"
 #include "Library/Serialization/Serialization.h"
 
+#include "Utility/Streams/FileOutputStream.h"
+#include "Utility/Exception.h"
 #include "Utility/Format.h"
 #include "Utility/String.h"
 #include "Utility/UnicodeCrt.h"
@@ -59,6 +67,53 @@ int runCat(const LodToolOptions &options) {
     return fwrite(data.data(), data.size(), 1, stdout) != 1;
 }
 
+int runPack(const LodToolOptions &options) {
+    LodReader reader(options.lodPath);
+    std::string output = options.pack.output.empty() ? options.lodPath + ".bundle" : options.pack.output;
+
+    LodBundleWriter writer(output, LodBundleReader::fingerprint(reader));
+    size_t imageCount = 0;
+    size_t spriteCount = 0;
+    size_t failedCount = 0;
+    for (const std::string &name : reader.ls()) {
+        try {
+            Blob data = reader.read(name);
+            LodFileFormat format = lod::magic(data, name);
+            if (format == LOD_FILE_IMAGE) {
+                writer.write(name, lod::decodeImage(data));
+                imageCount++;
+            } else if (format == LOD_FILE_SPRITE) {
+                writer.write(name, lod::decodeSprite(data));
+                spriteCount++;
+            }
+        } catch (const std::exception &e) {
+            fmt::println(stderr, "Skipping entry '{}': {}", name, e.what());
+            failedCount++;
+        }
+    }
+    writer.close();
+
+    fmt::println("Bundle: {}", output);
+    fmt::println("Images: {}, sprites: {}, failed: {}", imageCount, spriteCount, failedCount);
+    return 0;
+}
+
+int runAssemble(const LodToolOptions &options) {
+    Blob manifest = Blob::fromFile(options.lodPath);
+    if (!LodChunkStore::isManifest(manifest))
+        throw Exception("'{}' is not a chunked lod manifest", options.lodPath);
+
+    std::string chunks = options.assemble.chunks;
+    if (chunks.empty())
+        chunks = (std::filesystem::path(options.lodPath).parent_path() / "chunks").string();
+
+    Blob lod = LodChunkStore(chunks).assemble(manifest);
+    FileOutputStream output(options.assemble.output);
+    output.write(lod.string_view());
+    output.close();
+    return 0;
+}
+
 int main(int argc, char **argv) {
     try {
         UnicodeCrt _(argc, argv);
@@ -71,6 +126,9 @@ int main(int argc, char **argv) {
         case LodToolOptions::SUBCOMMAND_LS: return runLs(options);
         case LodToolOptions::SUBCOMMAND_DUMP: return runDump(options);
         case LodToolOptions::SUBCOMMAND_CAT: return runCat(options);
+        case LodToolOptions::SUBCOMMAND_BENCH: return runBench(options);
+        case LodToolOptions::SUBCOMMAND_PACK: return runPack(options);
+        case LodToolOptions::SUBCOMMAND_ASSEMBLE: return runAssemble(options);
         }
     } catch (const std::exception &e) {
         fmt::print(stderr, "{}\n", e.what());
@@ -0,0 +1,223 @@
+#include "LodToolBench.h"
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Library/Image/ImageFunctions.h"
+#include "Library/Json/Json.h"
+#include "Library/Lod/LodReader.h"
+#include "Library/LodFormats/LodFormats.h"
+#include "Library/Serialization/Serialization.h"
+
+#include "Utility/Thread/ThreadPool.h"
+#include "Utility/Format.h"
+
+enum class BenchStage {
+    BENCH_READ, // LodReader::read, including paging in the data.
+    BENCH_DECOMPRESS, // lod::decodeCompressed.
+    BENCH_DECODE, // Image & sprite decoding, including palette expansion for images.
+};
+using enum BenchStage;
+
+static constexpr size_t BENCH_STAGE_COUNT = 3;
+
+static const char *benchStageName(BenchStage stage) {
+    switch (stage) {
+    case BENCH_READ: return "read";
+    case BENCH_DECOMPRESS: return "decompress";
+    case BENCH_DECODE: return "decode";
+    default:
+        assert(false);
+        return "";
+    }
+}
+
+struct EntryTiming {
+    LodFileFormat format = LOD_FILE_RAW;
+    size_t size = 0; // Size of the entry inside the LOD.
+    std::array<int64_t, BENCH_STAGE_COUNT> times = {{-1, -1, -1}}; // Nanoseconds, -1 if the stage wasn't run.
+    unsigned checksum = 0; // So that the compiler doesn't optimize the reads away.
+    bool failed = false;
+};
+
+struct StageStats {
+    size_t bytes = 0;
+    int64_t totalTime = 0;
+    std::vector<int64_t> times;
+};
+
+static int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static EntryTiming benchEntry(const LodReader &reader, const std::string &name) {
+    EntryTiming result;
+    try {
+        int64_t start = now();
+        Blob data = reader.read(name);
+        for (size_t i = 0; i < data.size(); i += 4096) // Touch every page so that mmapped data is actually read.
+            result.checksum += static_cast<const unsigned char *>(data.data())[i];
+        result.times[static_cast<size_t>(BENCH_READ)] = now() - start;
+        result.size = data.size();
+        result.format = lod::magic(data, name);
+
+        if (result.format == LOD_FILE_COMPRESSED || result.format == LOD_FILE_PSEUDO_IMAGE) {
+            start = now();
+            Blob uncompressed = lod::decodeCompressed(data);
+            result.times[static_cast<size_t>(BENCH_DECOMPRESS)] = now() - start;
+            result.checksum += uncompressed.size();
+        } else if (result.format == LOD_FILE_IMAGE) {
+            start = now();
+            LodImage image = lod::decodeImage(data);
+            RgbaImage rgba = makeRgbaImage(image.image, image.palette);
+            result.times[static_cast<size_t>(BENCH_DECODE)] = now() - start;
+            result.checksum += rgba.width();
+        } else if (result.format == LOD_FILE_SPRITE) {
+            start = now();
+            LodSprite sprite = lod::decodeSprite(data);
+            result.times[static_cast<size_t>(BENCH_DECODE)] = now() - start;
+            result.checksum += sprite.image.width();
+        }
+    } catch (const std::exception &) {
+        result.failed = true;
+    }
+    return result;
+}
+
+static int64_t percentile(const std::vector<int64_t> &sortedTimes, double p) {
+    return sortedTimes[static_cast<size_t>((sortedTimes.size() - 1) * p)];
+}
+
+static double toMs(int64_t ns) {
+    return ns / 1'000'000.0;
+}
+
+static double toUs(int64_t ns) {
+    return ns / 1'000.0;
+}
+
+static double toMbPerSec(size_t bytes, int64_t ns) {
+    return ns == 0 ? 0.0 : bytes / (1024.0 * 1024.0) / (ns / 1'000'000'000.0);
+}
+
+int runBench(const LodToolOptions &options) {
+    std::unique_ptr<ThreadPool> pool;
+    if (options.bench.threads > 1)
+        pool = std::make_unique<ThreadPool>(options.bench.threads);
+
+    Json json;
+    json["threads"] = options.bench.threads;
+    json["lods"] = Json::array();
+
+    int64_t benchStart = now();
+    for (const std::string &path : options.bench.lodPaths) {
+        int64_t indexStart = now();
+        LodReader reader(path, LOD_ALLOW_DUPLICATES);
+        std::vector<std::string> names = reader.ls();
+        int64_t indexTime = now() - indexStart;
+
+        int64_t entriesStart = now();
+        std::vector<EntryTiming> timings;
+        if (pool) {
+            std::vector<std::future<EntryTiming>> futures;
+            for (const std::string &name : names)
+                futures.push_back(pool->run([&reader, &name] { return benchEntry(reader, name); }));
+            for (std::future<EntryTiming> &future : futures)
+                timings.push_back(future.get());
+        } else {
+            for (const std::string &name : names)
+                timings.push_back(benchEntry(reader, name));
+        }
+        int64_t entriesTime = now() - entriesStart;
+
+        size_t totalBytes = 0;
+        size_t failedCount = 0;
+        std::map<LodFileFormat, std::array<StageStats, BENCH_STAGE_COUNT>> statsByFormat;
+        for (const EntryTiming &timing : timings) {
+            totalBytes += timing.size;
+            if (timing.failed) {
+                failedCount++;
+                continue;
+            }
+
+            std::array<StageStats, BENCH_STAGE_COUNT> &stats = statsByFormat[timing.format];
+            for (size_t i = 0; i < BENCH_STAGE_COUNT; i++) {
+                if (timing.times[i] < 0)
+                    continue;
+                stats[i].bytes += timing.size;
+                stats[i].totalTime += timing.times[i];
+                stats[i].times.push_back(timing.times[i]);
+            }
+        }
+
+        Json lodJson;
+        lodJson["path"] = path;
+        lodJson["entries"] = names.size();
+        lodJson["failed"] = failedCount;
+        lodJson["bytes"] = totalBytes;
+        lodJson["indexMs"] = toMs(indexTime);
+        lodJson["wallMs"] = toMs(entriesTime);
+        lodJson["stages"] = Json::array();
+
+        if (!options.bench.json) {
+            fmt::println("Lod file: {}", path);
+            fmt::println("Index: {:.3f} ms, {} entries", toMs(indexTime), names.size());
+            fmt::println("Entries: {:.3f} ms wall, {:.1f} MB/s, {} failed", toMs(entriesTime), toMbPerSec(totalBytes, entriesTime), failedCount);
+            fmt::println("    {:<24} {:<12} {:>8} {:>10} {:>12} {:>10} {:>10} {:>10}", "Format", "Stage", "Count", "MB", "Total ms", "MB/s", "p50 us", "p99 us");
+        }
+
+        for (auto &[format, stats] : statsByFormat) {
+            for (size_t i = 0; i < BENCH_STAGE_COUNT; i++) {
+                StageStats &stageStats = stats[i];
+                if (stageStats.times.empty())
+                    continue;
+                std::sort(stageStats.times.begin(), stageStats.times.end());
+
+                BenchStage stage = static_cast<BenchStage>(i);
+                double megabytes = stageStats.bytes / (1024.0 * 1024.0);
+                double mbPerSec = toMbPerSec(stageStats.bytes, stageStats.totalTime);
+                double p50 = toUs(percentile(stageStats.times, 0.5));
+                double p99 = toUs(percentile(stageStats.times, 0.99));
+
+                if (options.bench.json) {
+                    Json stageJson;
+                    stageJson["format"] = toString(format);
+                    stageJson["stage"] = benchStageName(stage);
+                    stageJson["count"] = stageStats.times.size();
+                    stageJson["bytes"] = stageStats.bytes;
+                    stageJson["totalMs"] = toMs(stageStats.totalTime);
+                    stageJson["mbPerSec"] = mbPerSec;
+                    stageJson["p50Us"] = p50;
+                    stageJson["p99Us"] = p99;
+                    lodJson["stages"].push_back(std::move(stageJson));
+                } else {
+                    fmt::println("    {:<24} {:<12} {:>8} {:>10.2f} {:>12.3f} {:>10.1f} {:>10.1f} {:>10.1f}",
+                                 toString(format), benchStageName(stage), stageStats.times.size(), megabytes,
+                                 toMs(stageStats.totalTime), mbPerSec, p50, p99);
+                }
+            }
+        }
+
+        if (!options.bench.json)
+            fmt::println("");
+        json["lods"].push_back(std::move(lodJson));
+    }
+    int64_t benchTime = now() - benchStart;
+
+    if (options.bench.json) {
+        json["wallMs"] = toMs(benchTime);
+        fmt::println("{}", json.dump(4));
+    } else {
+        fmt::println("Total: {:.3f} ms", toMs(benchTime));
+    }
+    return 0;
+}
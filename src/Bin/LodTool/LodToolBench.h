@@ -0,0 +1,11 @@
+#pragma once
+
+#include "LodToolOptions.h"
+
+/**
+ * Runs the `bench` subcommand - reads & decodes all entries in the provided lod files and prints timings.
+ *
+ * @param options                       Parsed command line options.
+ * @return                              Process exit code.
+ */
+int runBench(const LodToolOptions &options);
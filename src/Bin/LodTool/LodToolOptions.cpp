@@ -22,6 +22,20 @@ LodToolOptions LodToolOptions::parse(int argc, char **argv) {
     cat->add_option("LOD", result.lodPath, "Path to lod file.")->check(CLI::ExistingFile)->required()->option_text(" ");
     cat->add_option("ENTRY", result.cat.entry, "Name of the entry to print.")->required()->option_text(" ");
 
+    CLI::App *bench = app->add_subcommand("bench", "Measure read & decode throughput for lod files.", result.subcommand, SUBCOMMAND_BENCH)->fallthrough();
+    bench->add_option("--threads", result.bench.threads, "Number of threads to decode on, default is 1.")->check(CLI::PositiveNumber)->option_text("THREADS");
+    bench->add_flag("--json", result.bench.json, "Print results as json.");
+    bench->add_option("LOD", result.bench.lodPaths, "Paths to lod files.")->check(CLI::ExistingFile)->required()->option_text(" ");
+
+    CLI::App *pack = app->add_subcommand("pack", "Create an asset bundle with pre-decoded images & sprites for a lod file.", result.subcommand, SUBCOMMAND_PACK)->fallthrough();
+    pack->add_option("-o,--output", result.pack.output, "Path to the output bundle file, default is LOD.bundle.")->option_text("OUTPUT");
+    pack->add_option("LOD", result.lodPath, "Path to lod file.")->check(CLI::ExistingFile)->required()->option_text(" ");
+
+    CLI::App *assemble = app->add_subcommand("assemble", "Assemble a chunked lod, e.g. an OpenEnroth chunked save, into a regular lod file.", result.subcommand, SUBCOMMAND_ASSEMBLE)->fallthrough();
+    assemble->add_option("-o,--output", result.assemble.output, "Path to the output lod file.")->required()->option_text("OUTPUT");
+    assemble->add_option("--chunks", result.assemble.chunks, "Path to the chunk store folder, default is the chunks folder next to the manifest.")->check(CLI::ExistingDirectory)->option_text("CHUNKS");
+    assemble->add_option("MANIFEST", result.lodPath, "Path to chunked lod manifest.")->check(CLI::ExistingFile)->required()->option_text(" ");
+
     app->parse(argc, argv, result.helpPrinted);
     return result;
 }
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 struct LodToolOptions {
     enum class Subcommand {
         SUBCOMMAND_LS,
         SUBCOMMAND_DUMP,
         SUBCOMMAND_CAT,
+        SUBCOMMAND_BENCH,
+        SUBCOMMAND_PACK,
+        SUBCOMMAND_ASSEMBLE,
     };
     using enum Subcommand;
 
@@ -15,10 +19,28 @@ struct LodToolOptions {
         bool raw = false;
     };
 
+    struct BenchOptions {
+        std::vector<std::string> lodPaths;
+        int threads = 1;
+        bool json = false;
+    };
+
+    struct PackOptions {
+        std::string output; // Empty means "<lod>.bundle".
+    };
+
+    struct AssembleOptions {
+        std::string output;
+        std::string chunks; // Empty means "chunks" folder next to the manifest.
+    };
+
     Subcommand subcommand = SUBCOMMAND_DUMP;
     std::string lodPath;
     bool helpPrinted = false; // True means that help message was already printed.
     CatOptions cat;
+    BenchOptions bench;
+    PackOptions pack;
+    AssembleOptions assemble;
 
     static LodToolOptions parse(int argc, char **argv);
 };
@@ -1,3 +1,4 @@
+#include <array>
 #include <cstdio>
 #include <cassert>
 #include <utility>
@@ -5,8 +6,11 @@
 
 #include "Application/GameStarter.h"
 
+#include "Arcomage/ArcomageSimulator.h"
+
 #include "Engine/Components/Control/EngineControlComponent.h"
 #include "Engine/Components/Control/EngineController.h"
+#include "Engine/Components/FastForward/EngineFastForwardComponent.h"
 #include "Engine/Components/Trace/EngineTraceSimplePlayer.h"
 #include "Engine/Components/Trace/EngineTraceRecorder.h"
 #include "Engine/Components/Trace/EngineTraceStateAccessor.h"
@@ -19,12 +23,14 @@
 #include "Library/Trace/EventTrace.h"
 
 #include "Utility/Streams/FileInputStream.h"
+#include "Utility/Thread/ThreadPool.h"
 #include "Utility/Format.h"
 #include "Utility/UnicodeCrt.h"
 #include "Utility/String.h"
 #include "Utility/Types.h"
 
 #include "OpenEnrothOptions.h"
+#include "ParallelRetrace.h"
 
 static std::string readTextFile(const std::string &path) {
     // Normalize to UNIX line endings. Need this b/c git on Windows checks out CRLF line endings.
@@ -75,10 +81,21 @@ int runRetrace(const OpenEnrothOptions &options) {
 
             std::string savePath = tracePath.substr(0, tracePath.length() - 5) + ".mm7";
 
-            EventTrace oldTrace = EventTrace::loadFromFile(tracePath, application->window());
+            EventTraceFormat format;
+            EventTrace oldTrace;
+            {
+                // Blob::fromFile maps the file, and the recorder rewrites it below. Can't rewrite a mapped file on
+                // Windows, so the blob shouldn't outlive parsing.
+                Blob oldTraceBlob = Blob::fromFile(tracePath);
+                format = options.retrace.format.value_or(EventTrace::detectFormat(oldTraceBlob));
+                oldTrace = EventTrace::fromBlob(oldTraceBlob, application->window());
+            }
             EngineTraceStateAccessor::prepareForPlayback(engine->config.get(), oldTrace.header.config);
 
-            recorder->startRecording(game, savePath, tracePath, TRACE_RECORDING_LOAD_EXISTING_SAVE);
+            EngineTraceRecordingFlags recordingFlags = TRACE_RECORDING_LOAD_EXISTING_SAVE;
+            if (format == EVENT_TRACE_FORMAT_BINARY)
+                recordingFlags |= TRACE_RECORDING_BINARY;
+            recorder->startRecording(game, savePath, tracePath, recordingFlags);
             engine->config->graphics.FPSLimit.setValue(0);
             player->playTrace(game, std::move(oldTrace.events), tracePath, TRACE_PLAYBACK_SKIP_RANDOM_CHECKS | TRACE_PLAYBACK_SKIP_STATE_CHECKS);
             recorder->finishRecording(game);
@@ -92,6 +109,8 @@ int runRetrace(const OpenEnrothOptions &options) {
                 }
             }
         }
+
+        fmt::println(stderr, "{}", RETRACE_FINISHED_MESSAGE);
     });
 
     if (options.retrace.checkCanonical && status == 0)
@@ -100,6 +119,8 @@ int runRetrace(const OpenEnrothOptions &options) {
     return status;
 }
 
+static constexpr int SEEK_PRESENT_INTERVAL = 30;
+
 int runPlay(const OpenEnrothOptions &options) {
     GameStarter starter(options);
 
@@ -110,9 +131,31 @@ int runPlay(const OpenEnrothOptions &options) {
             fmt::println(stderr, "Playing back '{}'...", tracePath);
 
             std::string savePath = tracePath.substr(0, tracePath.length() - 5) + ".mm7";
-            player->playTrace(game, savePath, tracePath, TRACE_PLAYBACK_SKIP_RANDOM_CHECKS | TRACE_PLAYBACK_SKIP_STATE_CHECKS , [&] {
+            EngineTracePlaybackFlags flags = TRACE_PLAYBACK_SKIP_RANDOM_CHECKS | TRACE_PLAYBACK_SKIP_STATE_CHECKS;
+            if (options.play.maxSpeed) {
+                player->playTrace(game, savePath, tracePath, flags | TRACE_PLAYBACK_MAX_SPEED);
+                continue;
+            }
+
+            // Seeking is done by fast-forwarding, which is exact since trace playback is deterministic. Restoring a
+            // snapshot mid-trace isn't an option as RNG state & timers are not a part of the save.
+            EngineFastForwardComponent *fastForward = application->component<EngineFastForwardComponent>();
+            auto applySpeed = [&] {
                 int fps = options.play.speed * 1000 / engine->config->debug.TraceFrameTimeMs.value();
                 engine->config->graphics.FPSLimit.setValue(std::max(1, fps));
+            };
+            player->playTrace(game, savePath, tracePath, flags, [&] {
+                if (options.play.seekMs > 0) {
+                    engine->config->graphics.FPSLimit.setValue(0);
+                    fastForward->start(SEEK_PRESENT_INTERVAL);
+                } else {
+                    applySpeed();
+                }
+            }, [&] {
+                if (fastForward->isActive() && application->platform()->tickCount() >= options.play.seekMs) {
+                    fastForward->finish();
+                    applySpeed();
+                }
             });
         }
     });
@@ -120,6 +163,34 @@ int runPlay(const OpenEnrothOptions &options) {
     return 0;
 }
 
+int runArcomage(const OpenEnrothOptions &options) {
+    ArcomageSimulationSettings settings;
+    settings.mastery = options.arcomage.mastery;
+    settings.maxTurns = options.arcomage.maxTurns;
+    settings.gameCount = options.arcomage.games;
+    settings.seed = options.arcomage.seed;
+
+    ThreadPool pool(options.arcomage.jobs);
+    ArcomageSimulationStats stats = simulateArcomageGames(settings, &pool);
+
+    auto percent = [&](int64_t count) { return 100.0 * count / stats.gameCount; };
+    fmt::println("Games:              {}", stats.gameCount);
+    fmt::println("First player wins:  {} ({:.2f}%)", stats.wins[1], percent(stats.wins[1]));
+    fmt::println("Second player wins: {} ({:.2f}%)", stats.wins[2], percent(stats.wins[2]));
+    fmt::println("Draws:              {} ({:.2f}%)", stats.wins[0], percent(stats.wins[0]));
+    fmt::println("Unfinished:         {} ({:.2f}%)", stats.unfinishedCount, percent(stats.unfinishedCount));
+    fmt::println("Average turns:      {:.2f}", static_cast<double>(stats.turnCount) / stats.gameCount);
+
+    static constexpr std::array<const char *, 6> victoryTypeNames = {{
+        "tower built", "more wall after mutual destruction", "enemy tower destroyed", "resources collected", "draw",
+        "more resources after a draw"
+    }};
+    for (size_t i = 0; i < victoryTypeNames.size(); i++)
+        fmt::println("Victory by {}: {}", victoryTypeNames[i], stats.victoryTypes[i]);
+
+    return 0;
+}
+
 int runOpenEnroth(const OpenEnrothOptions &options) {
     GameStarter(options).run();
     return 0;
@@ -137,7 +208,11 @@ int openEnrothMain(int argc, char **argv) {
         default: assert(false); [[fallthrough]];
         case OpenEnrothOptions::SUBCOMMAND_GAME: return runOpenEnroth(options);
         case OpenEnrothOptions::SUBCOMMAND_PLAY: return runPlay(options);
-        case OpenEnrothOptions::SUBCOMMAND_RETRACE: return runRetrace(options);
+        case OpenEnrothOptions::SUBCOMMAND_RETRACE:
+            if (options.retrace.jobs > 1 && options.retrace.traces.size() > 1)
+                return runParallelRetrace(argv[0], options);
+            return runRetrace(options);
+        case OpenEnrothOptions::SUBCOMMAND_ARCOMAGE: return runArcomage(options);
         }
     } catch (const std::exception &e) {
         fmt::print(stderr, "{}\n", e.what());
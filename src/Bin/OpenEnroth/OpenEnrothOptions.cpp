@@ -37,6 +37,14 @@ OpenEnrothOptions OpenEnrothOptions::parse(int argc, char **argv) {
     play->add_option(
         "--speed", result.play.speed,
         "Playback speed, default is '1.0'.")->option_text("SPEED");
+    play->add_flag(
+        "--max-speed", result.play.maxSpeed,
+        "Play as fast as possible, presenting only some of the frames. Use this to quickly get to the interesting part "
+        "of a long trace.");
+    play->add_option(
+        "--seek", result.play.seekMs,
+        "Play as fast as possible until the trace reaches the provided time, in milliseconds since the start of the "
+        "trace, then continue at the normal speed.")->option_text("MS");
     play->add_option(
         "TRACE", result.play.traces,
         "Path to trace file(s) to play.")->required()->option_text("...");
@@ -47,12 +55,39 @@ OpenEnrothOptions OpenEnrothOptions::parse(int argc, char **argv) {
     app->add_flag(
         "--headless", result.headless,
         "Run in headless mode.");
+    app->add_flag(
+        "--render-prep", result.renderPrep,
+        "Time the CPU side of rendering and print per-phase timings on exit. Combine with '--headless' to benchmark "
+        "render prep without a GPU.");
+    app->add_option(
+        "--load-profile", result.loadProfilePath,
+        "Record timings of level loading and save them on exit as Chrome trace JSON that can be opened "
+        "in Perfetto.")->option_text("PATH");
     retrace->add_flag(
         "--tracing-rng", result.tracingRng,
-        "Use random number generators that print stack trace on each call.");
+        "Use random number generators that record stack trace on each call. Recorded stack traces are printed on "
+        "random state desync and on exit.");
+    retrace->add_option(
+        "--tracing-rng-from", result.tracingRngFirstTick,
+        "First tick to record random number generator calls at, in milliseconds. Use with '--tracing-rng'.")
+        ->option_text("MS");
+    retrace->add_option(
+        "--tracing-rng-to", result.tracingRngLastTick,
+        "Last tick to record random number generator calls at, in milliseconds. Use with '--tracing-rng'.")
+        ->option_text("MS");
     retrace->add_flag(
         "--check-canonical", result.retrace.checkCanonical,
         "Check whether all passed traces are stored in canonical representation and return an error if not.");
+    retrace->add_option(
+        "-j,--jobs", result.retrace.jobs,
+        "Number of headless processes to retrace in, default is '1'.")->check(CLI::PositiveNumber)->option_text("JOBS");
+    CLI::Option *binaryOption = retrace->add_flag_callback(
+        "--binary", [&result] { result.retrace.format = EVENT_TRACE_FORMAT_BINARY; },
+        "Save retraced traces in compact binary format. Binary traces load a lot faster, but can't be diffed.");
+    retrace->add_flag_callback(
+        "--json", [&result] { result.retrace.format = EVENT_TRACE_FORMAT_JSON; },
+        "Save retraced traces in json format. This is the format that should be used for the traces in the repo.")
+        ->excludes(binaryOption);
     retrace->add_flag(
         "--glob", globTraces,
         "Glob passed trace paths.")->group(""); // group("") hides this option. It's here so that we don't have to jump through hoops in cmake.
@@ -61,6 +96,28 @@ OpenEnrothOptions OpenEnrothOptions::parse(int argc, char **argv) {
         "Path to trace file(s) to retrace.")->required()->option_text("...");
     retrace->set_help_flag("-h,--help", "Print help and exit."); // This places --help last in the command list.
 
+    CLI::App *arcomage = app->add_subcommand("arcomage", "Simulate AI-vs-AI Arcomage games, print statistics and exit.",
+                                             result.subcommand, SUBCOMMAND_ARCOMAGE)->fallthrough();
+    arcomage->add_option(
+        "-n,--games", result.arcomage.games,
+        "Number of games to simulate, default is '10000'.")->check(CLI::PositiveNumber)->option_text("GAMES");
+    arcomage->add_option(
+        "--seed", result.arcomage.seed,
+        "Random seed, default is '0'. Results only depend on the seed, not on the number of threads.")->option_text("SEED");
+    arcomage->add_option(
+        "-j,--jobs", result.arcomage.jobs,
+        "Number of threads to simulate in, default is the number of hardware threads.")->option_text("JOBS");
+    arcomage->add_option(
+        "--mastery1", result.arcomage.mastery[0],
+        "AI mastery of the first player, '0' to '2', default is '1'.")->check(CLI::Range(0, 2))->option_text("MASTERY");
+    arcomage->add_option(
+        "--mastery2", result.arcomage.mastery[1],
+        "AI mastery of the second player, '0' to '2', default is '1'.")->check(CLI::Range(0, 2))->option_text("MASTERY");
+    arcomage->add_option(
+        "--max-turns", result.arcomage.maxTurns,
+        "Games that take longer are counted as unfinished, default is '1000'.")->check(CLI::PositiveNumber)->option_text("TURNS");
+    arcomage->set_help_flag("-h,--help", "Print help and exit."); // This places --help last in the command list.
+
     app->parse(argc, argv, result.helpPrinted);
 
     if (result.subcommand == SUBCOMMAND_RETRACE) {
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "Application/GameStarterOptions.h"
 
+#include "Library/Trace/EventTraceEnums.h"
+
 class GameConfig;
 class Platform;
 
@@ -12,24 +17,38 @@ struct OpenEnrothOptions : public GameStarterOptions {
     enum class Subcommand {
         SUBCOMMAND_GAME,
         SUBCOMMAND_PLAY,
-        SUBCOMMAND_RETRACE
+        SUBCOMMAND_RETRACE,
+        SUBCOMMAND_ARCOMAGE
     };
     using enum Subcommand;
 
     struct RetraceOptions {
         std::vector<std::string> traces;
         bool checkCanonical = false;
+        int jobs = 1; // Number of processes to retrace in.
+        std::optional<EventTraceFormat> format; // Format to save retraced traces in, by default it's left unchanged.
     };
 
     struct PlayOptions {
         std::vector<std::string> traces;
         float speed = 1.0f;
+        bool maxSpeed = false; // Play as fast as possible, ignoring `speed`.
+        int64_t seekMs = 0; // Play as fast as possible until this many trace milliseconds have passed.
+    };
+
+    struct ArcomageOptions {
+        int64_t games = 10000;
+        int seed = 0;
+        int jobs = 0; // Number of threads to simulate in, non-positive means use all hardware threads.
+        std::array<int, 2> mastery = {{1, 1}};
+        int maxTurns = 1000;
     };
 
     Subcommand subcommand = SUBCOMMAND_GAME;
     bool helpPrinted = false; // True means that help message was already printed.
     RetraceOptions retrace;
     PlayOptions play;
+    ArcomageOptions arcomage;
 
     /**
      * Parses OpenEnroth command line options.
@@ -0,0 +1,264 @@
+#include "ParallelRetrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Application/GamePathResolver.h"
+
+#include "Library/Cli/CliCommand.h"
+#include "Library/Environment/Interface/Environment.h"
+#include "Library/Serialization/Serialization.h"
+
+#include "Utility/DataPath.h"
+#include "Utility/Format.h"
+#include "Utility/String.h"
+
+#include "OpenEnrothOptions.h"
+
+namespace fs = std::filesystem;
+
+// Retracing several traces per child process amortizes the engine startup time, which is comparable to retrace time
+// for short traces.
+static constexpr size_t MAX_TRACES_PER_PROCESS = 16;
+
+static std::string readLogFile(const fs::path &path) {
+    std::ifstream stream(path, std::ios::binary);
+    std::stringstream result;
+    result << stream.rdbuf();
+    return result.str();
+}
+
+static std::string resolveDataPath(const std::string &dataPath) {
+    if (!dataPath.empty())
+        return dataPath;
+
+    // Same logic as in GameStarter, minus the logging.
+    std::unique_ptr<Environment> environment = Environment::createStandardEnvironment();
+    std::vector<std::string> candidates = resolveMm7Paths(environment.get());
+    std::string missingFile;
+    auto pos = std::ranges::find_if(candidates, [&] (const std::string &candidate) {
+        return fs::exists(candidate) && validateDataPath(candidate, &missingFile);
+    });
+    return pos == candidates.end() ? candidates.back() : *pos;
+}
+
+static void mirrorEntry(const fs::path &source, const fs::path &target) {
+    std::error_code error;
+    if (fs::is_directory(source)) {
+        fs::create_directory_symlink(source, target, error);
+        if (!error)
+            return;
+
+        // Symlinks might be unavailable on Windows, mirror the directory file by file.
+        fs::create_directory(target);
+        for (const fs::directory_entry &entry : fs::directory_iterator(source))
+            mirrorEntry(entry.path(), target / entry.path().filename());
+    } else {
+        fs::create_symlink(source, target, error);
+        if (error) {
+            error.clear();
+            fs::create_hard_link(source, target, error);
+        }
+        if (error)
+            fs::copy_file(source, target);
+    }
+}
+
+static void createDataMirror(const fs::path &dataPath, const fs::path &mirrorPath) {
+    fs::create_directories(mirrorPath);
+    for (const fs::directory_entry &entry : fs::directory_iterator(dataPath)) {
+        std::string name = toLower(entry.path().filename().string());
+        fs::path target = mirrorPath / entry.path().filename();
+        if (name == "saves") {
+            fs::create_directory(target);
+        } else if (name == "data" && entry.is_directory()) {
+            fs::create_directory(target);
+            for (const fs::directory_entry &dataEntry : fs::directory_iterator(entry.path()))
+                if (toLower(dataEntry.path().filename().string()) != "new.lod")
+                    mirrorEntry(dataEntry.path(), target / dataEntry.path().filename());
+        } else {
+            mirrorEntry(entry.path(), target);
+        }
+    }
+}
+
+enum class BatchTraceStatus {
+    BATCH_TRACE_OK,
+    BATCH_TRACE_FAILED,
+    BATCH_TRACE_NOT_CANONICAL,
+    BATCH_TRACE_NOT_STARTED,
+};
+using enum BatchTraceStatus;
+
+static std::string_view displayString(BatchTraceStatus status) {
+    switch (status) {
+    case BATCH_TRACE_OK: return "OK";
+    case BATCH_TRACE_FAILED: return "FAILED";
+    case BATCH_TRACE_NOT_CANONICAL: return "NOT CANONICAL";
+    default: return "NOT STARTED";
+    }
+}
+
+/**
+ * Figures out what happened to each of the traces retraced by a single child process.
+ *
+ * @param log                           Output of the child process.
+ * @param exitCode                      Exit code of the child process.
+ * @param traces                        All traces.
+ * @param batch                         Indices of the traces that were passed to the child process.
+ * @return                              Status for each of the traces in `batch`.
+ */
+static std::vector<BatchTraceStatus> parseBatchLog(std::string_view log, int exitCode,
+                                                   const std::vector<std::string> &traces,
+                                                   const std::vector<size_t> &batch) {
+    std::vector<BatchTraceStatus> result(batch.size(), BATCH_TRACE_OK);
+    if (exitCode == 0)
+        return result;
+
+    // Traces are retraced in order, so everything before the last started trace has finished.
+    size_t startedCount = 0;
+    size_t pos = 0;
+    while (startedCount < batch.size()) {
+        size_t next = log.find(fmt::format("Retracing '{}'...", traces[batch[startedCount]]), pos);
+        if (next == std::string_view::npos)
+            break;
+        pos = next;
+        startedCount++;
+    }
+
+    bool finished = log.find(RETRACE_FINISHED_MESSAGE) != std::string_view::npos;
+    for (size_t i = 0; i < batch.size(); i++) {
+        if (i >= startedCount) {
+            result[i] = BATCH_TRACE_NOT_STARTED;
+        } else {
+            std::string message = fmt::format("Trace '{}' is not in canonical representation.", traces[batch[i]]);
+            if (log.find(message) != std::string_view::npos)
+                result[i] = BATCH_TRACE_NOT_CANONICAL;
+        }
+    }
+
+    // If the child process didn't get to the end, then it died while retracing the last started trace.
+    if (!finished && startedCount > 0)
+        result[startedCount - 1] = BATCH_TRACE_FAILED;
+    if (startedCount == 0)
+        result[0] = BATCH_TRACE_FAILED; // Died on startup, don't requeue the batch forever.
+    return result;
+}
+
+int runParallelRetrace(std::string_view executablePath, const OpenEnrothOptions &options) {
+    using Seconds = std::chrono::duration<double>;
+
+    const std::vector<std::string> &traces = options.retrace.traces;
+    int jobs = std::min<int>(options.retrace.jobs, traces.size());
+
+    fs::path dataPath = fs::absolute(resolveDataPath(options.dataPath));
+    fs::path tmpPath = fs::temp_directory_path() / fmt::format("OpenEnroth_Retrace_{:08x}", std::random_device()());
+    for (int i = 0; i < jobs; i++)
+        createDataMirror(dataPath, tmpPath / fmt::format("data_{}", i));
+
+    std::string baseCommand = quoteCommandLineArgument(executablePath);
+    if (options.logLevel)
+        baseCommand += fmt::format(" --log-level {}", toString(*options.logLevel));
+    baseCommand += " --headless";
+
+    std::string retraceArgs;
+    if (options.tracingRng) {
+        retraceArgs += fmt::format(" --tracing-rng --tracing-rng-from {} --tracing-rng-to {}",
+                                   options.tracingRngFirstTick, options.tracingRngLastTick);
+    }
+    if (options.retrace.checkCanonical)
+        retraceArgs += " --check-canonical";
+    if (options.retrace.format)
+        retraceArgs += *options.retrace.format == EVENT_TRACE_FORMAT_BINARY ? " --binary" : " --json";
+
+    fmt::println(stderr, "Retracing {} traces in {} processes...", traces.size(), jobs);
+
+    std::mutex mutex;
+    std::deque<size_t> pendingTraces;
+    for (size_t i = 0; i < traces.size(); i++)
+        pendingTraces.push_back(i);
+    size_t doneCount = 0;
+    size_t failedCount = 0;
+    size_t nonCanonicalCount = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Takes a batch of traces for the next child process. Batches get smaller towards the end so that the workers
+    // finish at roughly the same time.
+    auto takeBatch = [&] {
+        std::lock_guard lock(mutex);
+        size_t size = std::clamp<size_t>(pendingTraces.size() / (2 * jobs), 1, MAX_TRACES_PER_PROCESS);
+        size = std::min(size, pendingTraces.size());
+        std::vector<size_t> result(pendingTraces.begin(), pendingTraces.begin() + size);
+        pendingTraces.erase(pendingTraces.begin(), pendingTraces.begin() + size);
+        return result;
+    };
+
+    auto worker = [&] (int workerIndex) {
+        fs::path mirrorPath = tmpPath / fmt::format("data_{}", workerIndex);
+        std::string command = fmt::format("{} --data-path {} retrace{}", baseCommand,
+                                          quoteCommandLineArgument(mirrorPath.string()), retraceArgs);
+
+        for (std::vector<size_t> batch = takeBatch(); !batch.empty(); batch = takeBatch()) {
+            std::string batchCommand = command;
+            for (size_t index : batch)
+                batchCommand += " " + quoteCommandLineArgument(traces[index]);
+            fs::path logPath = tmpPath / fmt::format("trace_{}.log", batch[0]);
+
+            auto batchStartTime = std::chrono::steady_clock::now();
+            int exitCode = runCommandLine(batchCommand, logPath.string());
+            auto batchEndTime = std::chrono::steady_clock::now();
+
+            std::string log = readLogFile(logPath);
+            std::vector<BatchTraceStatus> statuses = parseBatchLog(log, exitCode, traces, batch);
+
+            std::lock_guard lock(mutex);
+            double batchTime = Seconds(batchEndTime - batchStartTime).count();
+            for (size_t i = 0; i < batch.size(); i++) {
+                if (statuses[i] == BATCH_TRACE_NOT_STARTED) {
+                    pendingTraces.push_back(batch[i]); // Child process died before getting to this trace.
+                    continue;
+                }
+
+                doneCount++;
+                if (statuses[i] == BATCH_TRACE_FAILED)
+                    failedCount++;
+                if (statuses[i] == BATCH_TRACE_NOT_CANONICAL)
+                    nonCanonicalCount++;
+
+                double elapsed = Seconds(batchEndTime - startTime).count();
+                double eta = elapsed / doneCount * (traces.size() - doneCount);
+                fmt::println(stderr, "[{}/{}] {} '{}' in a batch of {} ({:.1f}s), ETA {:.0f}s", doneCount, traces.size(),
+                             displayString(statuses[i]), traces[batch[i]], batch.size(), batchTime, eta);
+            }
+            if (exitCode != 0)
+                fmt::print(stderr, "{}", log);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < jobs; i++)
+        threads.emplace_back(worker, i);
+    for (std::thread &thread : threads)
+        thread.join();
+
+    std::error_code error;
+    fs::remove_all(tmpPath, error); // Doesn't follow symlinks, so the game data is safe.
+
+    fmt::println(stderr, "Retraced {} traces in {:.1f}s, {} failed, {} not in canonical representation.",
+                 traces.size(), Seconds(std::chrono::steady_clock::now() - startTime).count(), failedCount,
+                 nonCanonicalCount);
+    if (options.retrace.checkCanonical && failedCount == 0 && nonCanonicalCount == 0)
+        fmt::println(stderr, "All traces are in canonical representation.");
+
+    return failedCount == 0 && nonCanonicalCount == 0 ? 0 : 1;
+}
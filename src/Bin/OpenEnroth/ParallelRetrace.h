@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string_view>
+
+struct OpenEnrothOptions;
+
+/**
+ * Printed by `retrace` once it has retraced all of the provided traces.
+ */
+inline constexpr std::string_view RETRACE_FINISHED_MESSAGE = "Retrace finished.";
+
+/**
+ * Retraces `options.retrace.traces` in `options.retrace.jobs` headless child processes. Each child process retraces a
+ * batch of traces so that the engine startup cost is paid once per batch. If a child process fails, the traces from
+ * its batch that it didn't get to are retraced again in other child processes.
+ *
+ * Each worker gets its own mirror of the data folder to pass to its child processes, so that the child processes
+ * don't overwrite each other's `data/new.lod` and saves. Game files in the mirror are links to the original files.
+ *
+ * @param executablePath                Path to the OpenEnroth executable, e.g. `argv[0]`.
+ * @param options                       OpenEnroth options.
+ * @return                              Exit code, zero if all traces were retraced successfully (and are in canonical
+ *                                      representation, if `--check-canonical` was passed).
+ */
+int runParallelRetrace(std::string_view executablePath, const OpenEnrothOptions &options);
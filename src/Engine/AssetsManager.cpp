@@ -1,7 +1,10 @@
 #include "Engine/AssetsManager.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
+#include "Engine/Engine.h"
 #include "Engine/Graphics/ImageLoader.h"
 #include "Engine/Graphics/Image.h"
 #include "Engine/LodTextureCache.h"
@@ -31,24 +34,119 @@ void AssetsManager::releaseAllTextures() {
     ReloadFonts();
 }
 
-bool AssetsManager::releaseImage(const std::string &name) {
-    std::string filename = toLower(name);
+void AssetsManager::nextFrame() {
+    publishPrefetchedImages();
+
+    _frameIndex++;
+    if (_frameIndex % TRIM_INTERVAL == 0)
+        trimCache();
+}
+
+void AssetsManager::prefetchImages(std::span<GraphicsImage *const> images) {
+    ThreadPool *pool = engine->_threadPool.get();
+    if (!pool)
+        return; // Images will be loaded on first access.
+
+    for (GraphicsImage *image : images) {
+        if (!image || image->isLoaded())
+            continue;
+
+        image->prefetch(pool);
+        if (image->isPrefetching() && std::ranges::find(_prefetchedImages, image) == _prefetchedImages.end())
+            _prefetchedImages.push_back(image);
+    }
+}
+
+void AssetsManager::publishPrefetchedImages() {
+    std::erase_if(_prefetchedImages, [](GraphicsImage *image) {
+        if (image->isPrefetching())
+            return false;
+
+        image->upload();
+        return true;
+    });
+}
 
-    auto i = images.find(filename);
+void AssetsManager::trimCache() {
+    size_t budget = static_cast<size_t>(engine->config->graphics.TextureCacheSize.value()) * 1024 * 1024;
+    int64_t lastUseFrame = _frameIndex - MIN_IDLE_FRAMES;
+
+    struct Candidate {
+        int64_t lastUseFrame;
+        size_t size;
+        GraphicsImage *image;
+        bool gpuOnly;
+    };
+    std::vector<Candidate> candidates;
+    size_t total = 0;
+
+    auto collect = [&](const std::unordered_map<std::string, GraphicsImage *, IHash, IEqual> &map, bool gpuOnly) {
+        for (const auto &[_, image] : map) {
+            size_t size = image->memorySize() + image->gpuMemorySize();
+            size_t freeable = gpuOnly ? image->gpuMemorySize() : size;
+            total += size;
+            if (freeable && image->lastUseFrame() <= lastUseFrame)
+                candidates.push_back({image->lastUseFrame(), freeable, image, gpuOnly});
+        }
+    };
+    collect(bitmaps, false);
+    collect(sprites, false);
+    collect(images, true);
+
+    std::vector<LodTextureCache *> textureCaches;
+    for (LodTextureCache *cache : {pBitmaps_LOD, pIcons_LOD})
+        if (cache)
+            textureCaches.push_back(cache);
+    for (LodTextureCache *cache : textureCaches)
+        total += cache->memorySize();
+    if (pSprites_LOD)
+        total += pSprites_LOD->memorySize();
+
+    if (total <= budget)
+        return;
+
+    size_t oldTotal = total;
+
+    // Decoded LOD data is only needed to (re)load the images, so it goes first.
+    for (LodTextureCache *cache : textureCaches)
+        if (total > budget)
+            total -= cache->unloadUnused(lastUseFrame, total - budget);
+    if (pSprites_LOD && total > budget)
+        total -= pSprites_LOD->unloadUnused(lastUseFrame, total - budget);
+
+    std::ranges::sort(candidates, std::less(), &Candidate::lastUseFrame);
+    for (const Candidate &candidate : candidates) {
+        if (total <= budget)
+            break;
+
+        if (candidate.gpuOnly) {
+            candidate.image->releaseRenderId();
+        } else {
+            candidate.image->unload();
+        }
+        total -= candidate.size;
+    }
+
+    logger->trace("Texture cache trimmed from {} KiB to {} KiB, budget is {} KiB",
+                  oldTotal / 1024, total / 1024, budget / 1024);
+}
+
+bool AssetsManager::releaseImage(const std::string &name) {
+    auto i = images.find(name);
     if (i == images.end()) {
         return false;
     }
 
     i->second->releaseRenderId();
-    images.erase(filename);
+    forgetImage(i->second);
+    images.erase(i);
     return true;
 }
 
 GraphicsImage *AssetsManager::getImage_Paletted(const std::string &name) {
-    std::string filename = toLower(name);
-
-    auto i = images.find(filename);
+    auto i = images.find(name);
     if (i == images.end()) {
+        std::string filename = toLower(name);
         auto image = GraphicsImage::Create(std::make_unique<Paletted_Img_Loader>(pIcons_LOD, filename));
         images[filename] = image;
         return image;
@@ -59,10 +157,9 @@ GraphicsImage *AssetsManager::getImage_Paletted(const std::string &name) {
 
 
 GraphicsImage *AssetsManager::getImage_ColorKey(const std::string &name, Color colorkey) {
-    std::string filename = toLower(name);
-
-    auto i = images.find(filename);
+    auto i = images.find(name);
     if (i == images.end()) {
+        std::string filename = toLower(name);
         auto image = GraphicsImage::Create(std::make_unique<ColorKey_LOD_Loader>(pIcons_LOD, filename, colorkey));
         images[filename] = image;
         return image;
@@ -74,10 +171,9 @@ GraphicsImage *AssetsManager::getImage_ColorKey(const std::string &name, Color c
 
 
 GraphicsImage *AssetsManager::getImage_Solid(const std::string &name) {
-    std::string filename = toLower(name);
-
-    auto i = images.find(filename);
+    auto i = images.find(name);
     if (i == images.end()) {
+        std::string filename = toLower(name);
         auto image = GraphicsImage::Create(std::make_unique<Image16bit_LOD_Loader>(pIcons_LOD, filename));
         images[filename] = image;
         return image;
@@ -87,10 +183,9 @@ GraphicsImage *AssetsManager::getImage_Solid(const std::string &name) {
 }
 
 GraphicsImage *AssetsManager::getImage_Alpha(const std::string &name) {
-    std::string filename = toLower(name);
-
-    auto i = images.find(filename);
+    auto i = images.find(name);
     if (i == images.end()) {
+        std::string filename = toLower(name);
         auto image = GraphicsImage::Create(std::make_unique<Alpha_LOD_Loader>(pIcons_LOD, filename));
         images[filename] = image;
         return image;
@@ -100,10 +195,9 @@ GraphicsImage *AssetsManager::getImage_Alpha(const std::string &name) {
 }
 
 GraphicsImage *AssetsManager::getImage_PCXFromIconsLOD(const std::string &name) {
-    std::string filename = toLower(name);
-
-    auto i = images.find(filename);
+    auto i = images.find(name);
     if (i == images.end()) {
+        std::string filename = toLower(name);
         auto image = GraphicsImage::Create(std::make_unique<PCX_LOD_Compressed_Loader>(pIcons_LOD, filename));
         images[filename] = image;
         return image;
@@ -113,10 +207,9 @@ GraphicsImage *AssetsManager::getImage_PCXFromIconsLOD(const std::string &name)
 }
 
 GraphicsImage *AssetsManager::getImage_PCXFromFile(const std::string &name) {
-    std::string filename = toLower(name);
-
-    auto i = images.find(filename);
+    auto i = images.find(name);
     if (i == images.end()) {
+        std::string filename = toLower(name);
         auto image = GraphicsImage::Create(std::make_unique<PCX_File_Loader>(filename));
         images[filename] = image;
         return image;
@@ -126,10 +219,9 @@ GraphicsImage *AssetsManager::getImage_PCXFromFile(const std::string &name) {
 }
 
 GraphicsImage *AssetsManager::getBitmap(const std::string &name) {
-    std::string filename = toLower(name);
-
-    auto i = bitmaps.find(filename);
+    auto i = bitmaps.find(name);
     if (i == bitmaps.end()) {
+        std::string filename = toLower(name);
         auto image = GraphicsImage::Create(std::make_unique<Bitmaps_LOD_Loader>(pBitmaps_LOD, filename));
         bitmaps[filename] = image;
         return image;
@@ -139,23 +231,21 @@ GraphicsImage *AssetsManager::getBitmap(const std::string &name) {
 }
 
 bool AssetsManager::releaseBitmap(const std::string &name) {
-    std::string filename = toLower(name);
-
-    auto i = bitmaps.find(filename);
+    auto i = bitmaps.find(name);
     if (i == bitmaps.end()) {
         return false;
     }
 
     i->second->releaseRenderId();
-    bitmaps.erase(filename);
+    forgetImage(i->second);
+    bitmaps.erase(i);
     return true;
 }
 
 GraphicsImage *AssetsManager::getSprite(const std::string &name) {
-    std::string filename = toLower(name);
-
-    auto i = sprites.find(filename);
+    auto i = sprites.find(name);
     if (i == sprites.end()) {
+        std::string filename = toLower(name);
         auto image = GraphicsImage::Create(std::make_unique<Sprites_LOD_Loader>(pSprites_LOD, filename));
         sprites[filename] = image;
         return image;
@@ -165,15 +255,55 @@ GraphicsImage *AssetsManager::getSprite(const std::string &name) {
 }
 
 bool AssetsManager::releaseSprite(const std::string &name) {
-    std::string filename = toLower(name);
-
-    auto i = sprites.find(filename);
+    auto i = sprites.find(name);
     if (i == sprites.end()) {
         return false;
     }
 
     i->second->releaseRenderId();
-    sprites.erase(filename);
+    forgetImage(i->second);
+    sprites.erase(i);
     return true;
 }
 
+AssetHandle AssetsManager::imageHandle_ColorKey(const std::string &name, Color colorkey) {
+    return intern(fmt::format("colorkey:{:08X}:{}", colorkey.c32(), toLower(name)),
+                  [this, name, colorkey] { return getImage_ColorKey(name, colorkey); });
+}
+
+AssetHandle AssetsManager::imageHandle_Alpha(const std::string &name) {
+    return intern("alpha:" + toLower(name), [this, name] { return getImage_Alpha(name); });
+}
+
+AssetHandle AssetsManager::bitmapHandle(const std::string &name) {
+    return intern("bitmap:" + toLower(name), [this, name] { return getBitmap(name); });
+}
+
+AssetHandle AssetsManager::spriteHandle(const std::string &name) {
+    return intern("sprite:" + toLower(name), [this, name] { return getSprite(name); });
+}
+
+AssetHandle AssetsManager::intern(std::string key, std::function<GraphicsImage *()> load) {
+    auto [pos, inserted] = _slotByKey.emplace(std::move(key), static_cast<uint32_t>(_slots.size()));
+    if (inserted)
+        _slots.push_back({std::move(load), nullptr});
+    return AssetHandle(pos->second);
+}
+
+void AssetsManager::loadSlot(uint32_t index) {
+    Slot &slot = _slots[index];
+    slot.image = slot.load();
+
+    // Several slots can point to the same image. E.g. colorkey & alpha images share the `images` map, so resolving the
+    // same name with both will give us two slots for a single image.
+    _slotsByImage.emplace(slot.image, index);
+}
+
+void AssetsManager::forgetImage(GraphicsImage *image) {
+    auto [begin, end] = _slotsByImage.equal_range(image);
+    for (auto pos = begin; pos != end; ++pos)
+        _slots[pos->second].image = nullptr;
+    _slotsByImage.erase(begin, end);
+
+    std::erase(_prefetchedImages, image);
+}
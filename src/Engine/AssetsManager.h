@@ -3,18 +3,88 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
 
 #include "Library/Color/ColorTable.h"
 #include "GUI/GUIFont.h"
 
+#include "Utility/String.h"
+
 class GraphicsImage;
 
+/**
+ * Interned reference to an image in `AssetsManager`. Resolving a name into a handle involves a hash lookup, but
+ * getting an image out of a handle is just an array access, so code that draws the same images every frame should
+ * resolve the names once and then hold on to the handles.
+ *
+ * Handles are never invalidated. If the image a handle points to is released, it will be reloaded on next access.
+ */
+class AssetHandle {
+ public:
+    AssetHandle() = default;
+
+    [[nodiscard]] explicit operator bool() const {
+        return _index != 0;
+    }
+
+    friend bool operator==(const AssetHandle &l, const AssetHandle &r) = default;
+
+ private:
+    friend class AssetsManager;
+
+    explicit AssetHandle(uint32_t index) : _index(index) {}
+
+ private:
+    uint32_t _index = 0; // Index into `AssetsManager::_slots`, zero is reserved for null handles.
+};
+
 class AssetsManager {
  public:
     AssetsManager() {}
 
     void releaseAllTextures();
 
+    /**
+     * Advances the frame counter that's used for the last use stamps of the loaded images, and publishes the
+     * images that have finished decoding since the last call, see `prefetchImages`. Every `TRIM_INTERVAL` frames also
+     * calls `trimCache`. Should be called once per game loop iteration.
+     */
+    void nextFrame();
+
+    /**
+     * Starts decoding the provided images on the engine's thread pool. Meant to be called when constructing a UI
+     * screen, with all the images that the screen is going to draw, so that the first draw doesn't have to decode them
+     * one by one.
+     *
+     * Images are published (loaded & uploaded to the GPU) from the main thread in `nextFrame`, once their decoding
+     * jobs are done. Use `GraphicsImage::isLoaded` to check whether an image is ready. Drawing an image that's not
+     * ready yet just loads it synchronously, waiting for its decoding job to finish.
+     *
+     * @param images                    Images to prefetch, must have been obtained from this assets manager. Images
+     *                                  that are already loaded are skipped.
+     */
+    void prefetchImages(std::span<GraphicsImage *const> images);
+
+    /**
+     * Unloads the least recently used images, textures & sprites until the total memory they take is within the
+     * `texture_cache_size` budget. Images that were used during the last `MIN_IDLE_FRAMES` frames are never unloaded.
+     *
+     * Bitmaps & sprites are unloaded completely, and are transparently reloaded on next use. Other images can be
+     * modified in place by their users, so only their GL textures are released.
+     */
+    void trimCache();
+
+    /**
+     * @return                          Current frame index, for last use stamps.
+     */
+    [[nodiscard]] int64_t frameIndex() const {
+        return _frameIndex;
+    }
+
     // TODO(captainurist): These are called back from GraphicsImage::Release, which is a questionable design.
     bool releaseImage(const std::string &name);
     bool releaseSprite(const std::string &name);
@@ -31,6 +101,31 @@ class AssetsManager {
     GraphicsImage *getBitmap(const std::string &name);
     GraphicsImage *getSprite(const std::string &name);
 
+    /**
+     * Handle versions of the `get*` methods above. Resolving the same name twice returns the same handle.
+     *
+     * @param name                      Name of the image to resolve.
+     * @return                          Handle that can be passed to `image`.
+     */
+    AssetHandle imageHandle_ColorKey(const std::string &name, Color colorkey = colorTable.TealMask);
+    AssetHandle imageHandle_Alpha(const std::string &name);
+    AssetHandle bitmapHandle(const std::string &name);
+    AssetHandle spriteHandle(const std::string &name);
+
+    /**
+     * @param handle                    Non-null image handle.
+     * @return                          Image for the provided handle, (re)loaded if needed. Same as calling the `get*`
+     *                                  method that the handle was resolved with.
+     */
+    GraphicsImage *image(AssetHandle handle) {
+        assert(handle && handle._index < _slots.size());
+
+        Slot &slot = _slots[handle._index];
+        if (!slot.image)
+            loadSlot(handle._index);
+        return slot.image;
+    }
+
     // TODO(pskelton): Contain better
     // TODO(pskelton): Manager should have a ref to all loose textures created throuh CreateTexture_Blank also
     GraphicsImage *winnerCert{ nullptr };
@@ -47,9 +142,27 @@ class AssetsManager {
     std::unique_ptr<GUIFont> pFontSmallnum;
 
  protected:
-    std::unordered_map<std::string, GraphicsImage *> bitmaps;
-    std::unordered_map<std::string, GraphicsImage *> sprites;
-    std::unordered_map<std::string, GraphicsImage *> images;
+    static constexpr int64_t TRIM_INTERVAL = 60;
+    static constexpr int64_t MIN_IDLE_FRAMES = 2;
+
+    struct Slot {
+        std::function<GraphicsImage *()> load;
+        GraphicsImage *image = nullptr;
+    };
+
+    AssetHandle intern(std::string key, std::function<GraphicsImage *()> load);
+    void loadSlot(uint32_t index);
+    void forgetImage(GraphicsImage *image);
+    void publishPrefetchedImages();
+
+    int64_t _frameIndex = 0;
+    std::vector<Slot> _slots = std::vector<Slot>(1); // Slot 0 is for null handles.
+    std::unordered_map<std::string, uint32_t> _slotByKey;
+    std::unordered_multimap<GraphicsImage *, uint32_t> _slotsByImage;
+    std::vector<GraphicsImage *> _prefetchedImages;
+    std::unordered_map<std::string, GraphicsImage *, IHash, IEqual> bitmaps;
+    std::unordered_map<std::string, GraphicsImage *, IHash, IEqual> sprites;
+    std::unordered_map<std::string, GraphicsImage *, IHash, IEqual> images;
 };
 
 extern AssetsManager *assets;
@@ -1,13 +1,14 @@
 #include "EngineControlComponent.h"
 
+#include <exception>
 #include <utility>
 
 #include "Library/Platform/Interface/PlatformEventHandler.h"
 
 #include "EngineController.h"
 
-static void controlThread(EngineControlState *unsafeState) {
-    EngineControlStateHandle state(SIDE_CONTROL, unsafeState);
+static void controlFiber(EngineControlState *unsafeState) {
+    EngineControlStateHandle state(SIDE_CONTROL, unsafeState, Fiber::current());
     EngineController controller(state);
 
     while (true) {
@@ -17,6 +18,7 @@ static void controlThread(EngineControlState *unsafeState) {
         if (state->terminating)
             return;
 
+        std::exception_ptr exception;
         try {
             // std::queue uses std::deque which doesn't move elements around on reallocation, so we're safe even if
             // another control routine is queued from inside this call.
@@ -24,13 +26,18 @@ static void controlThread(EngineControlState *unsafeState) {
 
             // Let the game consume all posted events before dropping the current control routine. Note that it's
             // important to do this inside a try block as tick() throws.
-            if (!state->postedEvents.empty())
+            if (state->hasPostedEvents())
                 controller.tick();
-            assert(state->postedEvents.empty()); // We assume that the main thread processes all events each tick.
+            assert(!state->hasPostedEvents()); // We assume that the game side processes all events each tick.
         } catch (EngineControlState::TerminationException) {
             return;
         } catch (...) {
-            state->gameRoutine = [exception = std::current_exception()] {
+            exception = std::current_exception();
+        }
+
+        // Yielding from inside a catch block is not OK, see the comment for `Fiber::yield`.
+        if (exception) {
+            state->gameRoutine = [exception] {
                 std::rethrow_exception(exception);
             };
             state.yieldExecution();
@@ -40,18 +47,20 @@ static void controlThread(EngineControlState *unsafeState) {
     }
 }
 
-EngineControlComponent::EngineControlComponent(): _unsafeState(std::make_unique<EngineControlState>()), _state(SIDE_GAME, _unsafeState.get()) {
+EngineControlComponent::EngineControlComponent():
+    _unsafeState(std::make_unique<EngineControlState>()),
+    _controlFiber(std::make_unique<Fiber>([state = _unsafeState.get()] { controlFiber(state); })),
+    _state(SIDE_GAME, _unsafeState.get(), _controlFiber.get()) {
     _emptyHandler = std::make_unique<PlatformEventHandler>();
-    _controlThread = std::thread(&controlThread, _unsafeState.get());
 }
 
 EngineControlComponent::~EngineControlComponent() {
     assert(!application()); // Should be uninstalled.
-    assert(!_controlThread.joinable()); // Thread should be joined at this point.
+    assert(_controlFiber->isFinished()); // Control fiber should be terminated at this point.
 }
 
 void EngineControlComponent::runControlRoutine(ControlRoutine routine) {
-    assert(std::this_thread::get_id() != _controlThread.get_id());
+    assert(Fiber::current() != _controlFiber.get());
 
     _state->controlRoutineQueue.push(std::move(routine));
 }
@@ -61,17 +70,21 @@ bool EngineControlComponent::hasControlRoutine() const {
 }
 
 void EngineControlComponent::processSyntheticEvents(PlatformEventHandler *eventHandler, int count) {
-    while (!_state->postedEvents.empty() && count != 0) {
-        std::unique_ptr<PlatformEvent> event = std::move(_state->postedEvents.front());
-        _state->postedEvents.pop();
+    while (_state->hasPostedEvents() && count != 0) {
+        std::unique_ptr<PlatformEvent> event = std::move(_state->postedEvents[_state->nextPostedEvent++]);
         eventHandler->event(event.get());
         count--; // Negative count will never get to zero, as intended.
     }
+
+    if (!_state->hasPostedEvents()) {
+        _state->postedEvents.clear(); // Keeps the capacity.
+        _state->nextPostedEvent = 0;
+    }
 }
 
 void EngineControlComponent::exec(PlatformEventHandler *eventHandler) {
     if (!hasControlRoutine()) {
-        assert(_state->postedEvents.empty());
+        assert(!_state->hasPostedEvents());
         ProxyEventLoop::exec(eventHandler);
     } else {
         processSyntheticEvents(eventHandler);
@@ -81,7 +94,7 @@ void EngineControlComponent::exec(PlatformEventHandler *eventHandler) {
 
 void EngineControlComponent::processMessages(PlatformEventHandler *eventHandler, int count) {
     if (!hasControlRoutine()) {
-        assert(_state->postedEvents.empty());
+        assert(!_state->hasPostedEvents());
         ProxyEventLoop::processMessages(eventHandler, count);
     } else {
         processSyntheticEvents(eventHandler, count);
@@ -91,7 +104,7 @@ void EngineControlComponent::processMessages(PlatformEventHandler *eventHandler,
 
 void EngineControlComponent::waitForMessages() {
     if (!hasControlRoutine()) {
-        assert(_state->postedEvents.empty());
+        assert(!_state->hasPostedEvents());
         ProxyEventLoop::waitForMessages();
     } else {
         return; // Don't hang up in this function when control routine is running.
@@ -120,5 +133,5 @@ void EngineControlComponent::swapBuffers() {
 void EngineControlComponent::removeNotify() {
     _state->terminating = true;
     _state.yieldExecution();
-    _controlThread.join();
+    assert(_controlFiber->isFinished());
 }
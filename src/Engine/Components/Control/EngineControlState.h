@@ -1,13 +1,10 @@
 #pragma once
 
-#include <mutex>
-#include <condition_variable>
 #include <queue>
 #include <functional>
 #include <memory>
 #include <exception>
-
-#include "Utility/IndexedArray.h"
+#include <vector>
 
 class PlatformEvent;
 class EngineController;
@@ -23,43 +20,40 @@ class EngineControlState {
     using ControlRoutine = std::function<void(EngineController *)>;
     using GameRoutine = std::function<void()>;
 
-    // Main thread -> control thread communication.
+    // Game side -> control side communication.
 
-    /** Queue of control routines to run, these are added from the main thread and are consumed & run in control thread.
-     * Routines are removed from the queue only once they're finished. */
+    /** Queue of control routines to run, these are added from the game side and are consumed & run in the control
+     * fiber. Routines are removed from the queue only once they're finished. */
     std::queue<ControlRoutine> controlRoutineQueue;
 
-    /** Flag denoting that `EngineControlComponent` is being destroyed and it's time to terminate the control thread.
-     * It is set from the main thread. */
+    /** Flag denoting that `EngineControlComponent` is being destroyed and it's time to terminate the control fiber.
+     * It is set from the game side. */
     bool terminating = false;
 
     /** This exception is thrown from `EngineController::tick` to quickly leave the control routine on termination.
      * Intentionally not derived from `std::exception`. */
     struct TerminationException {};
 
-    // Control thread -> main thread communication.
-
-    /** Posted events, these are added from the control thread and are then consumed in the main thread. */
-    std::queue<std::unique_ptr<PlatformEvent>> postedEvents;
+    // Control side -> game side communication.
 
-    /** A way to run some code in the main thread w/o really leaving the control routine.
-     * If this function is valid, yielding execution from the control thread will run it w/o proceeding to the next
-     * frame, and then switch right back into the control thread. It is set in control thread and cleared in the
-     * main thread.
-     *
-     * Exception propagation from the control thread to the main thread is done with a game routine. */
-    GameRoutine gameRoutine;
+    /** Posted events, these are added from the control fiber and are then consumed on the game side, in order. The
+     * vector is cleared once all events are consumed, so it quickly grows to the size of the largest per-frame batch
+     * and posting events stops allocating. */
+    std::vector<std::unique_ptr<PlatformEvent>> postedEvents;
 
-    // Synchronization primitives.
+    /** Index of the first event in `postedEvents` that wasn't consumed yet. */
+    size_t nextPostedEvent = 0;
 
-    /** Which thread is currently active. */
-    EngineControlSide currentSide = SIDE_GAME;
+    [[nodiscard]] bool hasPostedEvents() const {
+        return nextPostedEvent < postedEvents.size();
+    }
 
-    /** This mutex protects everything. Game thread & control thread can run ONLY after locking it, and thus cannot
-     * run in parallel. */
-    std::mutex mutex;
-
-    /** Condvars to wake up control/game threads. */
-    IndexedArray<std::condition_variable, SIDE_GAME, SIDE_CONTROL> wakeEvents;
+    /** A way to run some code on the game side w/o really leaving the control routine.
+     * If this function is valid, yielding execution from the control fiber will run it w/o proceeding to the next
+     * frame, and then switch right back into the control fiber. It is set in the control fiber and cleared on the
+     * game side.
+     *
+     * Exception propagation from the control fiber to the game side is done with a game routine. */
+    GameRoutine gameRoutine;
 };
 
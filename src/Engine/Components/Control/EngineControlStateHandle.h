@@ -1,69 +1,55 @@
 #pragma once
 
 #include <cassert>
-#include <memory>
+
+#include "Library/Fiber/Fiber.h"
 
 #include "EngineControlState.h"
 
+/**
+ * Handle to `EngineControlState` that knows which side it's being accessed from, and thus where to switch on
+ * `yieldExecution`.
+ */
 class EngineControlStateHandle {
  public:
-    EngineControlStateHandle(EngineControlSide side, EngineControlState *state) :
-        _data(std::make_shared<SharedData>(side, state))
-    {}
-
-    ~EngineControlStateHandle() = default;
+    /**
+     * @param side                      Side that will be using this handle.
+     * @param state                     Control state.
+     * @param controlFiber              Fiber that's running the control routines.
+     */
+    EngineControlStateHandle(EngineControlSide side, EngineControlState *state, Fiber *controlFiber) :
+        _side(side), _state(state), _controlFiber(controlFiber) {
+        assert(state && controlFiber);
+    }
 
     EngineControlStateHandle() = delete;
-    EngineControlStateHandle(const EngineControlStateHandle &) = default;
-    EngineControlStateHandle(EngineControlStateHandle &&) = default;
 
     EngineControlState *operator->() const {
-        assert(_data->lock.owns_lock());
+        assert(mySideIsRunning());
 
-        return _data->state;
+        return _state;
     }
 
+    /**
+     * Switches execution to the other side. Returns once the other side has yielded back.
+     */
     void yieldExecution() {
-        _data->yieldExecutionInternal(true);
-    }
-
- private:
-    struct SharedData {
-        SharedData(EngineControlSide side, EngineControlState *state): side(side), state(state), lock(state->mutex) {
-            assert(state);
-        }
+        assert(mySideIsRunning());
 
-        ~SharedData() {
-            yieldExecutionInternal(false);
-        }
-
-        void yieldExecutionInternal(bool wait) {
-            assert(lock.owns_lock());
-
-            state->currentSide = otherSide();
-            state->wakeEvents[otherSide()].notify_all();
-
-            if (wait)
-                state->wakeEvents[mySide()].wait(lock, [&] { return state->currentSide == mySide(); });
-        }
-
-        EngineControlSide mySide() const {
-            return side;
-        }
-
-        EngineControlSide otherSide() const {
-            return side == SIDE_GAME ? SIDE_CONTROL : SIDE_GAME;
+        if (_side == SIDE_GAME) {
+            _controlFiber->resume();
+        } else {
+            Fiber::yield();
         }
+    }
 
-        EngineControlSide side;
-        EngineControlState *state;
-        std::unique_lock<std::mutex> lock;
-    };
+ private:
+    [[nodiscard]] bool mySideIsRunning() const {
+        return (Fiber::current() == _controlFiber) == (_side == SIDE_CONTROL);
+    }
 
  private:
-    // Storing a unique_lock in a shared_ptr is a bit retarded, but this makes this handle class copyable with exactly
-    // the semantics that we want. Another option would be to manage the lock's lifetime externally, but this will just
-    // pile more complexity where it's not really needed.
-    std::shared_ptr<SharedData> _data;
+    EngineControlSide _side;
+    EngineControlState *_state = nullptr;
+    Fiber *_controlFiber = nullptr;
 };
-
@@ -2,8 +2,8 @@
 
 #include <cassert>
 #include <filesystem>
+#include <iterator>
 #include <utility>
-#include <thread>
 
 #include "Arcomage/Arcomage.h"
 
@@ -11,6 +11,7 @@
 #include "GUI/GUIWindow.h"
 #include "GUI/GUIButton.h"
 
+#include "Engine/Engine.h"
 #include "Engine/SaveLoad.h"
 #include "Engine/EngineGlobals.h"
 #include "Engine/mm7_data.h"
@@ -31,14 +32,19 @@ void EngineController::tick(int count) {
         _state.yieldExecution();
 
         // We should check `terminating` after a call to `yieldExecution` because it cannot be set before the call -
-        // the only place it's set is the main thread, and main thread wasn't running before the call.
+        // the only place it's set is the game side, and the game side wasn't running before the call.
         if (_state->terminating)
             throw EngineControlState::TerminationException();
     }
 }
 
 void EngineController::postEvent(std::unique_ptr<PlatformEvent> event) {
-    _state->postedEvents.push(std::move(event));
+    _state->postedEvents.push_back(std::move(event));
+}
+
+void EngineController::postEvents(std::span<std::unique_ptr<PlatformEvent>> events) {
+    std::vector<std::unique_ptr<PlatformEvent>> &postedEvents = _state->postedEvents;
+    postedEvents.insert(postedEvents.end(), std::make_move_iterator(events.begin()), std::make_move_iterator(events.end()));
 }
 
 void EngineController::pressKey(PlatformKey key) {
@@ -186,13 +192,16 @@ void EngineController::skipLoadingScreen() {
 }
 
 void EngineController::saveGame(const std::string &path) {
-    // SaveGame makes a screenshot and needs the opengl context that's bound in game thread, so we cannot call it from
-    // the control thread. One option is to unbind every time we switch to control thread, but this is slow, and not
-    // needed 99% of the time. So we just call back into the game thread.
-    runGameRoutine([] { ::SaveGame(true, false); });
+    // SaveGame makes a screenshot and needs the opengl context that's bound in game thread. Control fiber might be
+    // running on a separate thread (see Fiber), and even when it doesn't, we'd rather not run game code on the fiber
+    // stack. So we just call back into the game side.
+    runGameRoutine([] {
+        ::SaveGame(true, false);
+        finishPendingSave();
+    });
 
     std::string src = makeDataPath("saves", "autosave.mm7");
-    std::filesystem::copy_file(src, path, std::filesystem::copy_options::overwrite_existing); // This might throw.
+    copySaveFile(src, path); // This might throw.
 }
 
 void EngineController::loadGame(const std::string &path) {
@@ -216,6 +225,24 @@ void EngineController::loadGame(const std::string &path) {
     skipLoadingScreen();
 }
 
+Blob EngineController::saveGameToMemory() {
+    Blob result;
+    runGameRoutine([&] { result = ::SaveGameToMemory(); }); // Need the opengl context for the screenshot, see above.
+    return result;
+}
+
+void EngineController::loadGameFromMemory(const Blob &save) {
+    goToMainMenu();
+    if (GetCurrentMenuID() == MENU_MAIN)
+        startNewGame(); // Loading from memory works the same way as quickload, and requires a running game.
+
+    runGameRoutine([&] {
+        ::LoadGameFromMemory(save);
+        uGameState = GAME_STATE_LOADING_GAME;
+    });
+    skipLoadingScreen();
+}
+
 void EngineController::runGameRoutine(GameRoutine routine) {
     _state->gameRoutine = std::move(routine);
     _state.yieldExecution();
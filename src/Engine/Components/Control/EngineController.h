@@ -2,10 +2,13 @@
 
 #include <string>
 #include <memory>
+#include <span>
 
 #include "Library/Platform/Interface/PlatformEnums.h"
 #include "Library/Platform/Interface/PlatformEvents.h"
 
+#include "Utility/Memory/Blob.h"
+
 #include "EngineControlStateHandle.h"
 
 class GUIButton;
@@ -35,6 +38,13 @@ class EngineController {
     void tick(int count = 1);
 
     void postEvent(std::unique_ptr<PlatformEvent> event);
+
+    /**
+     * Posts several events at once. Events are moved out of the provided span.
+     *
+     * @param events                    Events to post, in order.
+     */
+    void postEvents(std::span<std::unique_ptr<PlatformEvent>> events);
     void pressKey(PlatformKey key);
     void releaseKey(PlatformKey key);
     void pressButton(PlatformMouseButton button, int x, int y);
@@ -85,6 +95,25 @@ class EngineController {
      */
     void loadGame(const std::string &path);
 
+    /**
+     * Same as `saveGame`, but saves into memory. Doesn't touch the filesystem.
+     *
+     * @return                          Save file contents, can be passed to `loadGameFromMemory` or written out into
+     *                                  an `.mm7` file.
+     */
+    [[nodiscard]] Blob saveGameToMemory();
+
+    /**
+     * Loads the game from memory. Unlike `loadGame`, this doesn't go through the load game menu and doesn't touch the
+     * filesystem, so it's a lot faster. Note that this also means that the number of frames that it takes & the state
+     * of the random engine after the load are different from what `loadGame` gives you.
+     *
+     * If there is no game running, a new game is started first.
+     *
+     * @param save                      Save file contents, e.g. as returned by `saveGameToMemory`.
+     */
+    void loadGameFromMemory(const Blob &save);
+
     /**
      * Runs the provided routine in game thread and returns once it's finished. This is mainly for running OpenGL code
      * as the corresponding context is bound in the main thread.
@@ -6,6 +6,8 @@
 
 #include "Library/Platform/Application/PlatformApplication.h"
 
+#include "Utility/Thread/ThreadPool.h"
+
 EngineDeterministicComponent::EngineDeterministicComponent() = default;
 EngineDeterministicComponent::~EngineDeterministicComponent() = default;
 
@@ -16,6 +18,8 @@ void EngineDeterministicComponent::restart(int frameTimeMs, RandomEngineType rng
         _oldRandomEngineType = component<EngineRandomComponent>()->type();
 
     _active = true;
+    if (_threadPool)
+        _threadPool->setSerial(true);
     _tickCount = 0;
     _frameTimeMs = frameTimeMs;
     component<EngineRandomComponent>()->setType(rngType);
@@ -27,9 +31,19 @@ void EngineDeterministicComponent::finish() {
         return;
 
     component<EngineRandomComponent>()->setType(_oldRandomEngineType);
+    if (_threadPool)
+        _threadPool->setSerial(false);
     _active = false;
 }
 
+void EngineDeterministicComponent::setThreadPool(ThreadPool *threadPool) {
+    if (_threadPool)
+        _threadPool->setSerial(false);
+    _threadPool = threadPool;
+    if (_threadPool)
+        _threadPool->setSerial(_active);
+}
+
 int64_t EngineDeterministicComponent::tickCount() const {
     if (isActive()) {
         return _tickCount;
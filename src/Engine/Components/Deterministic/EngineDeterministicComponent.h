@@ -9,10 +9,12 @@
 #include "Library/Platform/Application/PlatformApplicationAware.h"
 
 class RandomEngine;
+class ThreadPool;
 
 /**
  * This component can be used to make the engine more deterministic. It replaces the system timer with a fake one that
- * advances by 16ms on each frame, and also resets the global random number generator.
+ * advances by 16ms on each frame, and also resets the global random number generator. If a thread pool is set, it's
+ * switched into serial mode for as long as the component is active, see `ThreadPool::setSerial`.
  *
  * Note that this component is intentionally very dumb. All the methods just do exactly what you would expect right
  * away, so where you're calling them from becomes very important. E.g. calling `restart` from an event
@@ -45,6 +47,12 @@ class EngineDeterministicComponent : private ProxyPlatform, private ProxyOpenGLC
         return _active;
     }
 
+    /**
+     * @param threadPool                Thread pool to switch into serial mode when the component is active, or
+     *                                  `nullptr`. Must outlive the component, or be reset before it's destroyed.
+     */
+    void setThreadPool(ThreadPool *threadPool);
+
  private:
     friend class PlatformIntrospection; // Give access to private bases.
 
@@ -54,6 +62,7 @@ class EngineDeterministicComponent : private ProxyPlatform, private ProxyOpenGLC
 
  private:
     bool _active = false;
+    ThreadPool *_threadPool = nullptr;
     int64_t _tickCount = 0;
     int _frameTimeMs = 0;
     RandomEngineType _oldRandomEngineType = RANDOM_ENGINE_MERSENNE_TWISTER;
@@ -0,0 +1,31 @@
+#include "EngineFastForwardComponent.h"
+
+#include <cassert>
+
+EngineFastForwardComponent::EngineFastForwardComponent() = default;
+EngineFastForwardComponent::~EngineFastForwardComponent() = default;
+
+void EngineFastForwardComponent::start(int presentInterval) {
+    assert(presentInterval >= 1);
+
+    _presentInterval = presentInterval;
+    _frameIndex = 0;
+}
+
+void EngineFastForwardComponent::finish() {
+    _presentInterval = 0;
+}
+
+void EngineFastForwardComponent::swapBuffers() {
+    if (isActive()) {
+        _frameIndex = (_frameIndex + 1) % _presentInterval;
+        if (_frameIndex != 0)
+            return;
+    }
+
+    ProxyOpenGLContext::swapBuffers();
+}
+
+void EngineFastForwardComponent::removeNotify() {
+    finish();
+}
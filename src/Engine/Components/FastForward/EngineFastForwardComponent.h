@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Library/Platform/Proxy/ProxyOpenGLContext.h"
+#include "Library/Platform/Application/PlatformApplicationAware.h"
+
+/**
+ * This component is used to fast-forward through traces. When active, only every `presentInterval`-th frame is
+ * actually presented, `swapBuffers` calls for all the other frames are not forwarded to the OpenGL context, and thus
+ * never block on vsync.
+ *
+ * Game logic doesn't depend on what's presented (this is why headless playback works), so the game behaves exactly
+ * the same as with all frames presented.
+ *
+ * Should be installed before any other `ProxyOpenGLContext` components so that it ends up right on top of the OpenGL
+ * context, and the other components still get a `swapBuffers` call every frame.
+ */
+class EngineFastForwardComponent : private ProxyOpenGLContext, private PlatformApplicationAware {
+ public:
+    EngineFastForwardComponent();
+    virtual ~EngineFastForwardComponent();
+
+    /**
+     * @param presentInterval           Present only every `presentInterval`-th frame, must be positive.
+     */
+    void start(int presentInterval);
+
+    /**
+     * Goes back to presenting every frame. Does nothing if fast-forwarding wasn't started.
+     */
+    void finish();
+
+    [[nodiscard]] bool isActive() const {
+        return _presentInterval > 0;
+    }
+
+ private:
+    friend class PlatformIntrospection; // Give access to private bases.
+
+    virtual void swapBuffers() override;
+    virtual void removeNotify() override;
+
+ private:
+    int _presentInterval = 0;
+    int _frameIndex = 0;
+};
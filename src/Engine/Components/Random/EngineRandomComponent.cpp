@@ -43,6 +43,19 @@ void EngineRandomComponent::setTracing(bool tracing) {
     swizzleGlobals();
 }
 
+void EngineRandomComponent::setTracingTickRange(int64_t firstTick, int64_t lastTick) {
+    _tracingFirstTick = firstTick;
+    _tracingLastTick = lastTick;
+    for (const std::unique_ptr<TracingRandomEngine> &engine : _tracingGrngs)
+        if (engine)
+            engine->setTickRange(firstTick, lastTick);
+}
+
+void EngineRandomComponent::printTracingLog(FILE *stream) {
+    if (_tracing && _tracingGrngs[_type])
+        _tracingGrngs[_type]->printLog(stream);
+}
+
 RandomEngineType EngineRandomComponent::type() const {
     return _type;
 }
@@ -67,11 +80,14 @@ void EngineRandomComponent::installNotify() {
         _vrngs[type] = createRandomEngine(type);
         _grngs[type] = createRandomEngine(type);
         _tracingGrngs[type] = std::make_unique<TracingRandomEngine>(application()->platform(), _grngs[type].get());
+        _tracingGrngs[type]->setTickRange(_tracingFirstTick, _tracingLastTick);
     }
     swizzleGlobals();
 }
 
 void EngineRandomComponent::removeNotify() {
+    printTracingLog(stderr); // Symbolization is deferred, so this is where we're printing whatever is left.
+
     for (RandomEngineType type : _grngs.indices()) {
         _vrngs[type].reset();
         _grngs[type].reset();
@@ -82,5 +98,9 @@ void EngineRandomComponent::removeNotify() {
 
 void EngineRandomComponent::swizzleGlobals() {
     vrng._ptr = _vrngs[_type].get();
-    grng._ptr = (_tracing ? _tracingGrngs : _grngs)[_type].get();
+    if (_tracing) {
+        grng._ptr = _tracingGrngs[_type].get();
+    } else {
+        grng._ptr = _grngs[_type].get();
+    }
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <cstdio>
+#include <limits>
 #include <memory>
 
 #include "Engine/Random/RandomEnums.h"
@@ -9,6 +12,7 @@
 #include "Utility/IndexedArray.h"
 
 class RandomEngine;
+class TracingRandomEngine;
 class Platform;
 
 class EngineRandomComponent : public PlatformApplicationAware {
@@ -19,6 +23,22 @@ class EngineRandomComponent : public PlatformApplicationAware {
     [[nodiscard]] bool isTracing() const;
     void setTracing(bool tracing);
 
+    /**
+     * Limits tracing to the provided tick range, see `TracingRandomEngine::setTickRange`.
+     *
+     * @param firstTick                 First tick to trace, inclusive.
+     * @param lastTick                  Last tick to trace, inclusive.
+     */
+    void setTracingTickRange(int64_t firstTick, int64_t lastTick);
+
+    /**
+     * Prints out & clears the log of the tracing random engine. Does nothing if tracing is off. Note that the log is
+     * also printed to `stderr` when this component is uninstalled.
+     *
+     * @param stream                    Stream to print to.
+     */
+    void printTracingLog(FILE *stream);
+
     [[nodiscard]] RandomEngineType type() const;
     void setType(RandomEngineType type);
 
@@ -39,7 +59,9 @@ class EngineRandomComponent : public PlatformApplicationAware {
  private:
     RandomEnginesArray _grngs;
     RandomEnginesArray _vrngs;
-    RandomEnginesArray _tracingGrngs;
+    IndexedArray<std::unique_ptr<TracingRandomEngine>, RANDOM_ENGINE_FIRST, RANDOM_ENGINE_LAST> _tracingGrngs;
     bool _tracing = false;
+    int64_t _tracingFirstTick = 0;
+    int64_t _tracingLastTick = std::numeric_limits<int64_t>::max();
     RandomEngineType _type = RANDOM_ENGINE_MERSENNE_TWISTER;
 };
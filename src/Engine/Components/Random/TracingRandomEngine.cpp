@@ -1,26 +1,31 @@
 #include "TracingRandomEngine.h"
 
+#include <algorithm>
 #include <cassert>
+#include <utility>
 
 #include "Library/Platform/Interface/Platform.h"
-#include "Library/StackTrace/StackTrace.h"
 
 #include "Utility/Format.h"
 
-TracingRandomEngine::TracingRandomEngine(Platform *platform, RandomEngine *base): _platform(platform), _base(base) {
+TracingRandomEngine::TracingRandomEngine(Platform *platform, RandomEngine *base, size_t capacity) :
+    _platform(platform), _base(base), _capacity(capacity) {
     assert(platform);
     assert(base);
+    assert(capacity > 0);
 }
 
+TracingRandomEngine::~TracingRandomEngine() = default;
+
 float TracingRandomEngine::randomFloat() {
     float result = _base->randomFloat();
-    printTrace("randomFloat", result);
+    record("randomFloat", result);
     return result;
 }
 
 int TracingRandomEngine::random(int hi) {
     int result = _base->random(hi);
-    printTrace("random", result);
+    record("random", result);
     return result;
 }
 
@@ -32,9 +37,45 @@ void TracingRandomEngine::seed(int seed) {
     _base->seed(seed);
 }
 
-template<class T>
-void TracingRandomEngine::printTrace(const char *function, const T &value) const {
-    fmt::println(stderr, "TracingRandomEngine::{} called at {}ms, returning {}, stacktrace:",
-                 function, _platform->tickCount(), value);
-    printStackTrace(stderr);
+void TracingRandomEngine::setTickRange(int64_t firstTick, int64_t lastTick) {
+    assert(firstTick <= lastTick);
+
+    _firstTick = firstTick;
+    _lastTick = lastTick;
+}
+
+void TracingRandomEngine::printLog(FILE *stream) {
+    if (_totalCalls == 0)
+        return;
+
+    size_t count = std::min(_totalCalls, _capacity);
+    if (count < _totalCalls)
+        fmt::println(stream, "TracingRandomEngine: {} earlier calls were dropped.", _totalCalls - count);
+
+    StackTracePrinter printer;
+    for (size_t i = _totalCalls - count; i < _totalCalls; i++) {
+        const Call &call = _calls[i % _capacity];
+        std::visit([&](auto value) {
+            fmt::println(stream, "TracingRandomEngine::{} called at {}ms, returning {}, stacktrace:",
+                         call.function, call.tickCount, value);
+        }, call.value);
+        printer.print(stream, call.stackTrace);
+    }
+
+    _totalCalls = 0;
+}
+
+void TracingRandomEngine::record(const char *function, std::variant<int, float> value) {
+    int64_t tickCount = _platform->tickCount();
+    if (tickCount < _firstTick || tickCount > _lastTick)
+        return;
+
+    if (_calls.empty())
+        _calls.resize(_capacity);
+
+    Call &call = _calls[_totalCalls++ % _capacity];
+    call.function = function;
+    call.tickCount = tickCount;
+    call.value = value;
+    call.stackTrace.capture(STACK_TRACE_DEPTH, 1); // Skip `record`.
 }
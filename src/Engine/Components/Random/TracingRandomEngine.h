@@ -1,25 +1,68 @@
 #pragma once
 
+#include <cstdint>
+#include <cstdio>
+#include <limits>
 #include <memory>
+#include <variant>
+#include <vector>
 
 #include "Library/Random/RandomEngine.h"
+#include "Library/StackTrace/StackTrace.h"
 
 class Platform;
 
+/**
+ * Random engine that records the stack traces of all calls into the wrapped engine.
+ *
+ * Only the raw return addresses of the last `capacity` calls are stored in a ring buffer, and symbolization is
+ * deferred until `printLog` is called, e.g. when a random state desync is detected. This keeps the overhead low enough
+ * to use this engine on long traces.
+ */
 class TracingRandomEngine : public RandomEngine {
  public:
-    explicit TracingRandomEngine(Platform *platform, RandomEngine *base);
+    static constexpr size_t DEFAULT_CAPACITY = 16384;
+    static constexpr int STACK_TRACE_DEPTH = 8;
+
+    TracingRandomEngine(Platform *platform, RandomEngine *base, size_t capacity = DEFAULT_CAPACITY);
+    virtual ~TracingRandomEngine();
 
     virtual float randomFloat() override;
     virtual int random(int hi) override;
     virtual int peek(int hi) const override;
     virtual void seed(int seed) override;
 
+    /**
+     * Limits recording to the calls made in the provided tick range. Use this to bisect determinism breaks.
+     *
+     * @param firstTick                 First tick to record calls at, inclusive.
+     * @param lastTick                  Last tick to record calls at, inclusive.
+     */
+    void setTickRange(int64_t firstTick, int64_t lastTick);
+
+    /**
+     * Symbolizes & prints out the recorded calls, oldest first, and then clears the log.
+     *
+     * @param stream                    Stream to print to.
+     */
+    void printLog(FILE *stream);
+
  private:
-    template<class T>
-    void printTrace(const char *function, const T &value) const;
+    struct Call {
+        const char *function = nullptr;
+        int64_t tickCount = 0;
+        std::variant<int, float> value;
+        RawStackTrace stackTrace;
+    };
+
+    void record(const char *function, std::variant<int, float> value);
 
  private:
     Platform *_platform = nullptr;
     RandomEngine *_base = nullptr;
+    size_t _capacity = 0;
+    std::vector<Call> _calls; // Ring buffer, allocated on first use.
+    size_t _totalCalls = 0; // Number of calls recorded since the last `printLog`.
+    int64_t _firstTick = 0;
+    int64_t _lastTick = std::numeric_limits<int64_t>::max();
 };
@@ -0,0 +1,169 @@
+#include "EngineSpikeRecorder.h"
+
+#include <ctime>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "Engine/Components/Deterministic/EngineDeterministicComponent.h"
+#include "Engine/Graphics/Renderer/Renderer.h"
+#include "Engine/Random/Random.h"
+#include "Engine/Engine.h"
+
+#include "Library/Platform/Application/PlatformApplication.h"
+#include "Library/Profiler/Profiler.h"
+#include "Library/Trace/PaintEvent.h"
+#include "Library/Trace/EventTrace.h"
+#include "Library/Logger/Logger.h"
+
+#include "Utility/Memory/MemoryAccounting.h"
+#include "Utility/Streams/FileOutputStream.h"
+#include "Utility/DataPath.h"
+#include "Utility/Format.h"
+
+// Min time between two reports. Loading screens & such produce spikes in bursts, one report per burst is enough.
+static constexpr std::chrono::seconds REPORT_COOLDOWN(30);
+
+using Milliseconds = std::chrono::duration<float, std::milli>;
+
+static float toMs(EngineSpikeRecorder::Clock::duration duration) {
+    return Milliseconds(duration).count();
+}
+
+EngineSpikeRecorder::EngineSpikeRecorder(): PlatformEventFilter(EVENTS_ALL) {}
+EngineSpikeRecorder::~EngineSpikeRecorder() = default;
+
+void EngineSpikeRecorder::swapBuffers() {
+    ProxyOpenGLContext::swapBuffers();
+
+    Clock::time_point now = Clock::now();
+    Clock::time_point lastSwap = std::exchange(_lastSwap, now);
+
+    int thresholdMs = engine ? engine->config->debug.SpikeThresholdMs.value() : 0;
+    if (thresholdMs <= 0 || component<EngineDeterministicComponent>()->isActive()) {
+        _frames.clear();
+        _events.clear();
+        _reportPending = false;
+        return;
+    }
+
+    if (lastSwap == Clock::time_point())
+        return; // First frame, nothing to measure.
+
+    // Same paint events as in EngineTraceSimpleRecorder, so that the dumped trace has the usual per-frame structure.
+    std::unique_ptr<PaintEvent> paint = std::make_unique<PaintEvent>();
+    paint->type = EVENT_PAINT;
+    paint->tickCount = application()->platform()->tickCount();
+    paint->randomState = grng->peek(1024 * 1024);
+    _events.push_back(std::move(paint));
+
+    Frame &frame = _frames.emplace_back();
+    frame.end = now;
+    frame.duration = now - lastSwap;
+    frame.events = std::move(_events);
+    _events.clear();
+
+    std::chrono::seconds keep(engine->config->debug.SpikeTraceSeconds.value());
+    while (_frames.size() > 1 && now - _frames.front().end > keep)
+        _frames.pop_front();
+
+    // Profiler closes a frame at the start of the next one, so the spike frame breakdown is only available now.
+    if (_reportPending) {
+        _reportPending = false;
+        writeReport();
+    }
+
+    if (frame.duration > std::chrono::milliseconds(thresholdMs) &&
+        (_lastReport == Clock::time_point() || now - _lastReport > REPORT_COOLDOWN)) {
+        _reportPending = true;
+        _lastReport = now;
+    }
+}
+
+bool EngineSpikeRecorder::event(const PlatformEvent *event) {
+    if (EventTrace::isTraceable(event) && engine && engine->config->debug.SpikeThresholdMs.value() > 0)
+        _events.push_back(EventTrace::cloneEvent(event));
+    return false;
+}
+
+void EngineSpikeRecorder::writeReport() {
+    // The spike frame is the one before the last.
+    if (_frames.size() < 2)
+        return;
+    const Frame &spike = _frames[_frames.size() - 2];
+
+    std::string basePath = makeDataPath("spikes", fmt::format("spike_{}", static_cast<int64_t>(std::time(nullptr))));
+
+    try {
+        std::filesystem::create_directories(makeDataPath("spikes"));
+
+        EventTrace trace;
+        for (const Frame &frame : _frames)
+            for (const std::unique_ptr<PlatformEvent> &event : frame.events)
+                trace.events.push_back(EventTrace::cloneEvent(event.get()));
+        EventTrace::saveToFile(basePath + ".json", trace);
+
+        std::string report;
+        auto append = [&]<class... Args>(fmt::format_string<Args...> format, Args &&... args) {
+            fmt::format_to(std::back_inserter(report), format, std::forward<Args>(args)...);
+            report += '\n';
+        };
+
+        append("Spike frame: {:.2f} ms, threshold {} ms", toMs(spike.duration),
+               engine->config->debug.SpikeThresholdMs.value());
+        append("Buffered: {} frames, {} events, {:.2f} s", _frames.size(), trace.events.size(),
+               toMs(_frames.back().end - _frames.front().end + _frames.front().duration) / 1000.0f);
+
+        append("");
+        append("Frame times, ms, oldest first:");
+        for (const Frame &frame : _frames)
+            append("  {:.2f}{}", toMs(frame.duration), &frame == &spike ? " <- spike" : "");
+
+        append("");
+        if (!profiler) {
+            append("Profiler zones are not available, rebuild with OE_BUILD_PROFILER to get them.");
+        } else {
+            const Profiler::Frame &zones = profiler->lastFrame();
+            append("Profiler frame {}: {:.2f} ms", zones.index, toMs(zones.duration));
+            int threadId = -1;
+            for (const Profiler::FrameZone &zone : zones.zones) {
+                if (zone.threadId != threadId) {
+                    threadId = zone.threadId;
+                    append("  {}", threadId == 0 ? std::string("Main thread") : fmt::format("Thread {}", threadId));
+                }
+                append("  {:{}}{}: {:.3f} ms x{}{}", "", 2 * (zone.depth + 1), zone.name, toMs(zone.duration), zone.count,
+                       zone.allocations ? fmt::format(", {} allocations", zone.allocations) : std::string());
+            }
+            append("  Dropped zones: {}", profiler->droppedZoneCount());
+        }
+
+        append("");
+        append("Renderer:");
+        if (render) {
+            auto passTimings = render->GetPassTimings();
+            for (RenderPass pass : passTimings.indices())
+                append("  GPU {}: {:.2f} ms", toString(pass), passTimings[pass]);
+            append("  Latency: {:.2f} ms", render->GetFrameLatency());
+            append("  Skipped GL calls: {}", render->GetAvoidedStateChanges());
+        }
+
+        append("");
+        append("Memory:");
+        for (MemoryTag tag : allMemoryTags()) {
+            MemoryTagStats stats = MemoryAccounting::stats(tag);
+            append("  {}: {} KiB, peak {} KiB, x{}", displayName(tag), stats.size / 1024, stats.peakSize / 1024,
+                   stats.allocationCount);
+        }
+        MemoryTagStats heap = MemoryAccounting::heapStats();
+        append("  Heap total: {} KiB, peak {} KiB, x{}", heap.size / 1024, heap.peakSize / 1024, heap.allocationCount);
+
+        FileOutputStream output(basePath + ".txt");
+        output.write(report);
+        output.close();
+
+        logger->info("Frame spike of {:.2f} ms, report saved to {}.txt", toMs(spike.duration), basePath);
+    } catch (const std::exception &e) {
+        logger->error("Couldn't write spike report: {}", e.what());
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "Library/Platform/Proxy/ProxyOpenGLContext.h"
+#include "Library/Platform/Filters/PlatformEventFilter.h"
+#include "Library/Platform/Application/PlatformApplicationAware.h"
+
+/**
+ * Component that watches frame times, and writes out a spike report once a frame takes longer than
+ * `debug.SpikeThresholdMs`.
+ *
+ * Always keeps a rolling buffer with the traceable events of the last `debug.SpikeTraceSeconds` seconds, split into
+ * frames with paint events, the same way `EngineTraceSimpleRecorder` does it. The report is written a frame after the
+ * spike, so that the profiler has collected the zones of the spike frame by then. Two files are written into the
+ * `spikes` folder:
+ * - `spike_<time>.json` - event trace with the buffered events.
+ * - `spike_<time>.txt` - buffered frame times, profiler breakdown of the spike frame, and renderer & memory counters.
+ *
+ * Note that the trace can't be played back as is. Playback needs a save to start from, and needs the trace to be
+ * recorded in deterministic mode. The trace is there to see what the player was doing when the spike happened.
+ *
+ * Does nothing while `EngineDeterministicComponent` is active.
+ */
+class EngineSpikeRecorder : private ProxyOpenGLContext, private PlatformEventFilter, private PlatformApplicationAware {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    EngineSpikeRecorder();
+    virtual ~EngineSpikeRecorder();
+
+ private:
+    friend class PlatformIntrospection; // Give access to private bases.
+
+    struct Frame {
+        Clock::time_point end;
+        Clock::duration duration = {};
+        std::vector<std::unique_ptr<PlatformEvent>> events; // Events of the frame, followed by a paint event.
+    };
+
+    virtual void swapBuffers() override;
+    virtual bool event(const PlatformEvent *event) override;
+
+    void writeReport();
+
+ private:
+    std::deque<Frame> _frames;
+    std::vector<std::unique_ptr<PlatformEvent>> _events; // Events of the current frame.
+    Clock::time_point _lastSwap;
+    Clock::time_point _lastReport;
+    bool _reportPending = false;
+};
@@ -6,13 +6,15 @@ enum class EngineTracePlaybackFlag {
     TRACE_PLAYBACK_SKIP_RANDOM_CHECKS = 0x1,
     TRACE_PLAYBACK_SKIP_TIME_CHECKS = 0x2,
     TRACE_PLAYBACK_SKIP_STATE_CHECKS = 0x4,
+    TRACE_PLAYBACK_MAX_SPEED = 0x8, // Play back as fast as possible, presenting only a fraction of frames.
 };
 using enum EngineTracePlaybackFlag;
 MM_DECLARE_FLAGS(EngineTracePlaybackFlags, EngineTracePlaybackFlag)
 MM_DECLARE_OPERATORS_FOR_FLAGS(EngineTracePlaybackFlags)
 
 enum class EngineTraceRecordingFlag {
-    TRACE_RECORDING_LOAD_EXISTING_SAVE = 0x1
+    TRACE_RECORDING_LOAD_EXISTING_SAVE = 0x1,
+    TRACE_RECORDING_BINARY = 0x2, // Save the trace in binary format instead of json.
 };
 using enum EngineTraceRecordingFlag;
 MM_DECLARE_FLAGS(EngineTraceRecordingFlags, EngineTraceRecordingFlag)
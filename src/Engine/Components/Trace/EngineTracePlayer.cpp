@@ -9,6 +9,8 @@
 
 #include "Engine/Components/Control/EngineController.h"
 #include "Engine/Components/Deterministic/EngineDeterministicComponent.h"
+#include "Engine/Components/FastForward/EngineFastForwardComponent.h"
+#include "Engine/Components/Random/EngineRandomComponent.h"
 #include "Engine/Random/Random.h"
 #include "Engine/Engine.h"
 
@@ -22,6 +24,10 @@
 #include "EngineTraceStateAccessor.h"
 #include "EngineTraceSimplePlayer.h"
 
+// Present every 30th frame when playing back at max speed. This is about twice a second of game time, so it's still
+// possible to see where the trace is at.
+static constexpr int MAX_SPEED_PRESENT_INTERVAL = 30;
+
 EngineTracePlayer::EngineTracePlayer() {}
 
 EngineTracePlayer::~EngineTracePlayer() {
@@ -44,6 +50,7 @@ void EngineTracePlayer::playTrace(EngineController *game, const std::string &sav
         _flags = 0;
         _trace.reset();
         component<EngineDeterministicComponent>()->finish();
+        component<EngineFastForwardComponent>()->finish();
     });
 
     checkSaveFileSize(_trace->header.saveFileSize);
@@ -65,6 +72,12 @@ void EngineTracePlayer::playTrace(EngineController *game, const std::string &sav
     if (postLoadCallback)
         postLoadCallback();
 
+    if (_flags & TRACE_PLAYBACK_MAX_SPEED) {
+        engine->config->graphics.FPSLimit.setValue(0);
+        engine->config->graphics.FPSLimitToRefreshRate.setValue(false);
+        component<EngineFastForwardComponent>()->start(MAX_SPEED_PRESENT_INTERVAL);
+    }
+
     checkState(_trace->header.startState, true);
     component<EngineTraceSimplePlayer>()->playTrace(game, std::move(_trace->events), _tracePath, _flags, std::move(tickCallback));
     checkState(_trace->header.endState, false);
@@ -84,6 +97,7 @@ void EngineTracePlayer::checkAfterLoadRng(int expectedRandomState) {
 
     int randomState = grng->peek(1024 * 1024);
     if (randomState != expectedRandomState) {
+        component<EngineRandomComponent>()->printTracingLog(stderr); // Does nothing if tracing is off.
         throw Exception("Random state desynchronized after loading a save for trace '{}': expected {}, got {}",
                         _tracePath, expectedRandomState, randomState);
     }
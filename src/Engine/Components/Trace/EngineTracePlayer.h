@@ -15,8 +15,8 @@ class EventTraceGameState;
 /**
  * Component that exposes a trace playback interface.
  *
- * Depends on `EngineDeterministicComponent` and `EngineTraceSimplePlayer`, install them into `PlatformApplication`
- * first.
+ * Depends on `EngineDeterministicComponent`, `EngineFastForwardComponent` and `EngineTraceSimplePlayer`, install them
+ * into `PlatformApplication` first.
  *
  * @see EngineTraceRecorder
  */
@@ -26,7 +26,7 @@ class EngineTracePlayer : private PlatformApplicationAware {
     ~EngineTracePlayer();
 
     /**
-     * Plays a previously recorded trace. Can be called only from a control thread of `EngineControlComponent`.
+     * Plays a previously recorded trace. Can be called only from a control routine of `EngineControlComponent`.
      *
      * @param game                      Engine controller.
      * @param savePath                  Path to save file.
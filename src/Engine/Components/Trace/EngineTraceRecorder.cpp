@@ -32,6 +32,7 @@ void EngineTraceRecorder::startRecording(EngineController *game, const std::stri
 
     _savePath = savePath;
     _tracePath = tracePath;
+    _flags = flags;
     _trace = std::make_unique<EventTrace>();
     _configSnapshot = std::make_unique<ConfigPatch>(ConfigPatch::fromConfig(engine->config.get()));
 
@@ -70,6 +71,7 @@ void EngineTraceRecorder::finishRecording(EngineController *game) {
     MM_AT_SCOPE_EXIT({
         _tracePath.clear();
         _savePath.clear();
+        _flags = 0;
         _trace.reset();
         component<EngineDeterministicComponent>()->finish();
         _configSnapshot->apply(engine->config.get()); // Roll back all config changes.
@@ -79,7 +81,8 @@ void EngineTraceRecorder::finishRecording(EngineController *game) {
     _trace->events = component<EngineTraceSimpleRecorder>()->finishRecording();
     _trace->header.endState = EngineTraceStateAccessor::makeGameState();
 
-    EventTrace::saveToFile(_tracePath, *_trace);
+    EventTraceFormat format = (_flags & TRACE_RECORDING_BINARY) ? EVENT_TRACE_FORMAT_BINARY : EVENT_TRACE_FORMAT_JSON;
+    EventTrace::saveToFile(_tracePath, *_trace, format);
 
     logger->info("Trace saved to {} and {}",
                  absolute(std::filesystem::path(_savePath)).generic_string(),
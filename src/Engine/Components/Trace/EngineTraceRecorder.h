@@ -25,7 +25,7 @@ class ConfigPatch;
  *
  * Some notes on how this works. When starting trace recording:
  * - The game is saved.
- * - Then it is loaded right away. Loading is managed from the control thread.
+ * - Then it is loaded right away. Loading is managed from the control routine.
  * - Then deterministic mode is entered, and actual event recording is started.
  *
  * Why do we need to start trace recording with loading the game? Loading the game updates the states of all actors
@@ -42,7 +42,7 @@ class EngineTraceRecorder : private PlatformApplicationAware {
     /**
      * Starts trace recording.
      *
-     * Note that this method needs to be called from the control thread, see `EngineControlComponent`.
+     * Note that this method needs to be called from a control routine, see `EngineControlComponent`.
      *
      * @param game                      Engine controller.
      * @param savePath                  Path to save file.
@@ -54,7 +54,7 @@ class EngineTraceRecorder : private PlatformApplicationAware {
     /**
      * Finishes trace recording & saves the trace file.
      *
-     * Note that this method needs to be called from the control thread, see `EngineControlComponent`.
+     * Note that this method needs to be called from a control routine, see `EngineControlComponent`.
      *
      * @param game                      Engine controller.
      */
@@ -62,7 +62,7 @@ class EngineTraceRecorder : private PlatformApplicationAware {
 
     /**
      * @return                          Whether recording is in progress. Make sure to call this method only from the
-     *                                  control thread, otherwise you basically can't reason about the current recording
+     *                                  control routine, otherwise you basically can't reason about the current recording
      *                                  state.
      */
     [[nodiscard]] bool isRecording() const {
@@ -75,6 +75,7 @@ class EngineTraceRecorder : private PlatformApplicationAware {
  private:
     std::string _savePath;
     std::string _tracePath;
+    EngineTraceRecordingFlags _flags;
     std::unique_ptr<EventTrace> _trace;
     std::unique_ptr<ConfigPatch> _configSnapshot;
 };
@@ -1,9 +1,11 @@
 #include "EngineTraceSimplePlayer.h"
 
 #include <cassert>
+#include <span>
 #include <utility>
 
 #include "Engine/Components/Control/EngineController.h"
+#include "Engine/Components/Random/EngineRandomComponent.h"
 #include "Engine/Random/Random.h"
 
 #include "Library/Platform/Application/PlatformApplication.h"
@@ -28,20 +30,25 @@ void EngineTraceSimplePlayer::playTrace(EngineController *game, std::vector<std:
     if (tickCallback)
         tickCallback();
 
-    for (std::unique_ptr<PlatformEvent> &event : events) {
-        if (event->type == EVENT_PAINT) {
-            game->tick(1);
+    // Events between two paint events all get handled in the same frame, so we post them as a single batch.
+    size_t batchStart = 0;
+    for (size_t i = 0; i < events.size(); i++) {
+        if (events[i]->type != EVENT_PAINT)
+            continue;
 
-            if (tickCallback)
-                tickCallback();
+        game->postEvents(std::span(events).subspan(batchStart, i - batchStart));
+        batchStart = i + 1;
 
-            const PaintEvent *paintEvent = static_cast<const PaintEvent *>(event.get());
-            checkTime(paintEvent);
-            checkRng(paintEvent);
-        } else {
-            game->postEvent(std::move(event));
-        }
+        game->tick(1);
+
+        if (tickCallback)
+            tickCallback();
+
+        const PaintEvent *paintEvent = static_cast<const PaintEvent *>(events[i].get());
+        checkTime(paintEvent);
+        checkRng(paintEvent);
     }
+    game->postEvents(std::span(events).subspan(batchStart));
 
     if (tickCallback)
         tickCallback();
@@ -65,6 +72,7 @@ void EngineTraceSimplePlayer::checkRng(const PaintEvent *paintEvent) {
     int randomState = grng->peek(1024 * 1024);
     int64_t tickCount = application()->platform()->tickCount();
     if (randomState != paintEvent->randomState) {
+        component<EngineRandomComponent>()->printTracingLog(stderr); // Does nothing if tracing is off.
         throw Exception("Random state desynchronized when playing back trace '{}' at {}ms: expected {}, got {}",
                         _tracePath, tickCount, paintEvent->randomState, randomState);
     }
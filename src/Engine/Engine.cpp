@@ -1,6 +1,12 @@
 #include <cstring>
 #include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <map>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "Engine/Engine.h"
 #include "Engine/EngineGlobals.h"
@@ -8,10 +14,12 @@
 
 #include "Engine/Events/Processor.h"
 #include "Engine/Events/RawEvent.h"
+#include "Engine/Graphics/BspRenderer.h"
 #include "Engine/Graphics/Camera.h"
 #include "Engine/Graphics/DecalBuilder.h"
 #include "Engine/Graphics/DecorationList.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
+#include "Engine/Graphics/Renderer/RenderPrepTimers.h"
 #include "Engine/Graphics/Level/Decoration.h"
 #include "Engine/Graphics/LightmapBuilder.h"
 #include "Engine/Graphics/LightsStack.h"
@@ -27,8 +35,12 @@
 #include "Engine/Graphics/Vis.h"
 #include "Engine/Graphics/Weather.h"
 #include "Engine/Graphics/PortalFunctions.h"
+#include "Engine/Graphics/ProfilerOverlay.h"
 #include "Engine/Graphics/Polygon.h"
 #include "Engine/Graphics/TurnBasedOverlay.h"
+#include "Engine/LoadProfiler.h"
+#include "Engine/LocationPrefetcher.h"
+#include "Engine/LOD.h"
 #include "Engine/LodTextureCache.h"
 #include "Engine/LodSpriteCache.h"
 #include "Engine/Localization.h"
@@ -42,7 +54,9 @@
 #include "Engine/Party.h"
 #include "Engine/Random/Random.h"
 #include "Engine/SaveLoad.h"
+#include "Engine/SimulationInterpolator.h"
 #include "Engine/Snapshots/TableSerialization.h"
+#include "Engine/Snapshots/TextTableCache.h"
 #include "Engine/SpellFxRenderer.h"
 #include "Engine/Spells/CastSpellInfo.h"
 #include "Engine/Spells/Spells.h"
@@ -78,9 +92,15 @@
 #include "Io/Mouse.h"
 
 #include "Library/Logger/Logger.h"
+#include "Library/Profiler/Profiler.h"
 #include "Library/BuildInfo/BuildInfo.h"
 
 #include "Utility/DataPath.h"
+#include "Utility/IndexedBitset.h"
+#include "Utility/Memory/MemoryAccounting.h"
+#include "Utility/Streams/FileOutputStream.h"
+#include "Utility/Thread/TaskGraph.h"
+#include "Utility/Thread/ThreadPool.h"
 
 /*
 
@@ -122,15 +142,21 @@ Engine *engine;
 GameState uGameState;
 
 void Engine::drawWorld() {
+    OE_PROFILE_ZONE("draw world");
+
     engine->SetSaturateFaces(pParty->_497FC5_check_party_perception_against_level());
 
-    pCamera3D->_viewPitch = pParty->_viewPitch;
-    pCamera3D->_viewYaw = pParty->_viewYaw;
-    pCamera3D->vCameraPos.x = pParty->pos.x - pParty->_yawGranularity * cosf(2 * pi_double * pParty->_viewYaw / 2048.0);
-    pCamera3D->vCameraPos.y = pParty->pos.y - pParty->_yawGranularity * sinf(2 * pi_double * pParty->_viewYaw / 2048.0);
-    pCamera3D->vCameraPos.z = pParty->pos.z + pParty->eyeLevel;  // 193, but real 353
+    Vec3f partyPos = simulationInterpolator ? simulationInterpolator->partyPos() : pParty->pos;
+    int partyYaw = simulationInterpolator ? simulationInterpolator->partyYaw() : pParty->_viewYaw;
+    int partyPitch = simulationInterpolator ? simulationInterpolator->partyPitch() : pParty->_viewPitch;
+
+    pCamera3D->_viewPitch = partyPitch;
+    pCamera3D->_viewYaw = partyYaw;
+    pCamera3D->vCameraPos.x = partyPos.x - pParty->_yawGranularity * cosf(2 * pi_double * partyYaw / 2048.0);
+    pCamera3D->vCameraPos.y = partyPos.y - pParty->_yawGranularity * sinf(2 * pi_double * partyYaw / 2048.0);
+    pCamera3D->vCameraPos.z = partyPos.z + pParty->eyeLevel;  // 193, but real 353
 
-    pCamera3D->CalculateRotations(pParty->_viewYaw, pParty->_viewPitch);
+    pCamera3D->CalculateRotations(partyYaw, partyPitch);
     pCamera3D->CreateViewMatrixAndProjectionScale();
     pCamera3D->BuildViewFrustum();
 
@@ -165,21 +191,29 @@ void Engine::drawWorld() {
             render->hd_water_current_frame =
                 std::floor(std::fmod(pMiscTimer->time().toFloatRealtimeSeconds(), 1.0f) * 7.0f);
 
-            if (uCurrentlyLoadedLevelType == LEVEL_INDOOR) {
-                pIndoor->Draw();
-            } else {
-                assert(uCurrentlyLoadedLevelType == LEVEL_OUTDOOR);
-                render->uFogColor = GetLevelFogColor();
-                pOutdoor->Draw();
+            {
+                OE_PROFILE_ZONE("draw level");
+                if (uCurrentlyLoadedLevelType == LEVEL_INDOOR) {
+                    pIndoor->Draw();
+                } else {
+                    assert(uCurrentlyLoadedLevelType == LEVEL_OUTDOOR);
+                    render->uFogColor = GetLevelFogColor();
+                    pOutdoor->Draw();
+                }
             }
 
             decal_builder->DrawBloodsplats();
+
+            if (renderPrepTimers)
+                renderPrepTimers->nextFrame();
         }
         render->DrawBillboards_And_MaybeRenderSpecialEffects_And_EndScene();
     }
 }
 
 void Engine::drawHUD() {
+    OE_PROFILE_ZONE("draw hud");
+
     // 2d from now on
     render->BeginScene2D();
     nuklear->Draw(nuklear->NUKLEAR_STAGE_PRE, WINDOW_GameUI, 1);
@@ -197,7 +231,13 @@ void Engine::drawHUD() {
     mouse->DrawCursor();
     mouse->Activate();
 
+    if (config->debug.ShowProfiler.value())
+        profilerOverlay.draw(nuklear->ctx);
+
     engine->nuklear->Draw(nuklear->NUKLEAR_STAGE_POST, WINDOW_GameUI, 1);
+
+    if (config->debug.ShowProfiler.value())
+        profilerOverlay.flush(nuklear->ctx);
 }
 
 //----- (0044103C) --------------------------------------------------------
@@ -266,7 +306,75 @@ void Engine::DrawGUI() {
 
         pPrimaryWindow->DrawText(assets->pFontArrus.get(), {300, 0}, colorTable.White, fmt::format("DrawCalls: {}", render->drawcalls));
         render->drawcalls = 0;
+        pPrimaryWindow->DrawText(assets->pFontArrus.get(), {300, 16}, colorTable.White,
+                                 fmt::format("Skipped GL calls: {}", render->GetAvoidedStateChanges()));
+
+        int gpu_info_offset = 16;
+        auto passTimings = render->GetPassTimings();
+        for (RenderPass pass : passTimings.indices()) {
+            pPrimaryWindow->DrawText(assets->pFontArrus.get(), {494, gpu_info_offset}, colorTable.White,
+                                     fmt::format("GPU {}: {:.2f} ms", toString(pass), passTimings[pass]));
+            gpu_info_offset += 16;
+        }
+        if (float latency = render->GetFrameLatency()) {
+            pPrimaryWindow->DrawText(assets->pFontArrus.get(), {494, gpu_info_offset}, colorTable.White,
+                                     fmt::format("Latency: {:.2f} ms", latency));
+            gpu_info_offset += 16;
+        }
 
+        // Render list sizes, current / max so far.
+        auto drawListSize = [&](std::string_view name, size_t size, size_t highWaterMark) {
+            pPrimaryWindow->DrawText(assets->pFontArrus.get(), {494, gpu_info_offset}, colorTable.White,
+                                     fmt::format("{}: {}/{}", name, size, highWaterMark));
+            gpu_info_offset += 16;
+        };
+        drawListSize("Billboards", pBillboardRenderList.size(), pBillboardRenderList.highWaterMark());
+        drawListSize("D3D billboards", render->pBillboardRenderListD3D.size(), render->pBillboardRenderListD3D.highWaterMark());
+        if (uCurrentlyLoadedLevelType == LEVEL_INDOOR) {
+            drawListSize("BSP faces", pBspRenderer->faces.size(), pBspRenderer->faces.highWaterMark());
+            drawListSize("BSP nodes", pBspRenderer->nodes.size(), pBspRenderer->nodes.highWaterMark());
+        }
+
+        // Audio counters.
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+        auto drawAudioLine = [&](const std::string &text) {
+            pPrimaryWindow->DrawText(assets->pFontArrus.get(), {494, gpu_info_offset}, colorTable.White, text);
+            gpu_info_offset += 16;
+        };
+        AudioStats audio = pAudioPlayer->stats();
+        drawAudioLine(fmt::format("Voices: {}/{} {}/{} {}/{}", audio.regularSoundCount, audio.regularSoundCapacity,
+                                  audio.loopingSoundCount, audio.loopingSoundCapacity,
+                                  audio.voiceSoundCount, audio.voiceSoundCapacity));
+        int64_t soundPlays = audio.soundCacheHits + audio.soundCacheMisses;
+        drawAudioLine(fmt::format("Sound cache: {:.1f}% {} KiB",
+                                  soundPlays ? 100.0 * audio.soundCacheHits / soundPlays : 0.0,
+                                  audio.soundCacheSize / 1024));
+        drawAudioLine(fmt::format("Sound loads: {} {:.2f} ms avg", audio.soundLoadCount,
+                                  audio.soundLoadCount ? Milliseconds(audio.soundLoadTime).count() / audio.soundLoadCount : 0.0));
+        drawAudioLine(fmt::format("Underruns: {} ({} total)", audio.musicUnderrunCount, audio.totalStreamUnderrunCount));
+        drawAudioLine(fmt::format("Stream updates: {:.1f} ms", Milliseconds(audio.totalStreamUpdateTime).count()));
+
+        // Memory accounting, see `MemoryTag` for the breakdown by subsystem.
+        MemoryTagStats heap = MemoryAccounting::heapStats();
+        MemoryTagStats gpu = MemoryAccounting::stats(MEMORY_TAG_GPU_TEXTURES);
+        pPrimaryWindow->DrawText(assets->pFontArrus.get(), {494, gpu_info_offset}, colorTable.White,
+                                 fmt::format("Heap: {} MiB ({} peak)", heap.size >> 20, heap.peakSize >> 20));
+        gpu_info_offset += 16;
+        pPrimaryWindow->DrawText(assets->pFontArrus.get(), {494, gpu_info_offset}, colorTable.White,
+                                 fmt::format("GPU textures: {} MiB ({} peak)", gpu.size >> 20, gpu.peakSize >> 20));
+        gpu_info_offset += 16;
+        MemoryTagStats gpuBuffers = MemoryAccounting::stats(MEMORY_TAG_GPU_BUFFERS);
+        pPrimaryWindow->DrawText(assets->pFontArrus.get(), {494, gpu_info_offset}, colorTable.White,
+                                 fmt::format("GPU buffers: {} MiB ({} peak)", gpuBuffers.size >> 20,
+                                             gpuBuffers.peakSize >> 20));
+        gpu_info_offset += 16;
+        VideoMemoryInfo videoMemory = render->GetVideoMemoryInfo();
+        if (videoMemory.availableSize >= 0) {
+            pPrimaryWindow->DrawText(assets->pFontArrus.get(), {494, gpu_info_offset}, colorTable.White,
+                                     fmt::format("VRAM free: {} MiB, mip bias {}", videoMemory.availableSize >> 20,
+                                                 videoMemory.textureMipBias));
+            gpu_info_offset += 16;
+        }
 
         int debug_info_offset = 16;
         pPrimaryWindow->DrawText(assets->pFontArrus.get(), {16, debug_info_offset}, colorTable.White,
@@ -312,6 +420,8 @@ void Engine::DrawGUI() {
 
 //----- (0047A815) --------------------------------------------------------
 void Engine::DrawParticles() {
+    RenderPrepTimerScope timer(RENDER_PREP_PARTICLES);
+    OE_PROFILE_ZONE("prep particles");
     particle_engine->Draw();
 }
 
@@ -480,6 +590,8 @@ Engine::Engine(std::shared_ptr<GameConfig> config) {
     this->nuklear = EngineIocContainer::ResolveNuklear();
     this->particle_engine = EngineIocContainer::ResolveParticleEngine();
     this->vis = EngineIocContainer::ResolveVis();
+    this->_threadPool = std::make_unique<ThreadPool>();
+    this->_locationPrefetcher = std::make_unique<LocationPrefetcher>(_threadPool.get());
 
     uNumStationaryLights_in_pStationaryLightsStack = 0;
 
@@ -499,6 +611,11 @@ Engine::~Engine() {
     delete pStru10Instance;
     delete pCamera3D;
     pAudioPlayer.reset();
+
+    // Background tasks might still be decoding LOD entries through the cache, so need to finish these first.
+    _locationPrefetcher.reset();
+    _threadPool.reset();
+    closeLodDecodeCache();
 }
 
 void Engine::LogEngineBuildInfo() {
@@ -597,6 +714,8 @@ void PrepareWorld(unsigned int _0_box_loading_1_fullscreen) {
 
 //----- (00464866) --------------------------------------------------------
 void DoPrepareWorld(bool bLoading, int _1_fullscreen_loading_2_box) {
+    LoadProfilerScope profilerScope("DoPrepareWorld");
+
     // char *v3;         // eax@1
     MapId v5;  // eax@3
 
@@ -643,8 +762,9 @@ void DoPrepareWorld(bool bLoading, int _1_fullscreen_loading_2_box) {
     bDialogueUI_InitializeActor_NPC_ID = 0;
     onMapLoad();
     pGameLoadingUI_ProgressBar->Progress();
-    memset(&render->pBillboardRenderListD3D, 0,
-           sizeof(render->pBillboardRenderListD3D));
+    render->pBillboardRenderListD3D.clear();
+    pBitmaps_LOD->publishPrefetched();
+    pSprites_LOD->publishPrefetched();
     pGameLoadingUI_ProgressBar->Release();
 }
 
@@ -664,18 +784,34 @@ void FinalInitialization() {
     pIcons_LOD->reserveLoadedTextures();
 }
 
-void MM7_LoadLods() {
-    engine->_gameResourceManager = std::make_unique<GameResourceManager>();
-    engine->_gameResourceManager->openGameResources();
+static void logTaskGraph(std::string_view title, const TaskGraph &graph) {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
 
-    pIcons_LOD = new LodTextureCache;
-    pIcons_LOD->open(makeDataPath("data", "icons.lod"));
+    logger->info("{} took {:.2f} ms, critical path:", title, Milliseconds(graph.totalTime()).count());
+    for (const TaskGraph::PathEntry &entry : graph.criticalPath())
+        logger->info("    {:<24}{:>10.2f} ms", entry.name, Milliseconds(entry.duration).count());
+}
 
-    pBitmaps_LOD = new LodTextureCache;
-    pBitmaps_LOD->open(makeDataPath("data", "bitmaps.lod"));
+/**
+ * Adds LOD loading tasks to the startup graph. LODs don't depend on each other, so they are opened in parallel.
+ *
+ * @param graph                         Startup task graph.
+ * @return                              Id of the task that opens the game resources, most of the data tables are
+ *                                      loaded from there.
+ */
+static TaskGraph::TaskId MM7_LoadLods(TaskGraph &graph) {
+    if (engine->config->settings.DecodeCache.value())
+        openLodDecodeCache(makeDataPath("lod_decode_cache.bin"));
 
+    engine->_gameResourceManager = std::make_unique<GameResourceManager>();
+    pIcons_LOD = new LodTextureCache;
+    pBitmaps_LOD = new LodTextureCache;
     pSprites_LOD = new LodSpriteCache;
-    pSprites_LOD->open(makeDataPath("data", "sprites.lod"));
+
+    TaskGraph::TaskId resources = graph.add("game resources", [] { engine->_gameResourceManager->openGameResources(); });
+    graph.add("icons.lod", [] { pIcons_LOD->open(makeDataPath("data", "icons.lod")); });
+    TaskGraph::TaskId bitmaps = graph.add("bitmaps.lod", [] { pBitmaps_LOD->open(makeDataPath("data", "bitmaps.lod")); });
+    graph.add("sprites.lod", [] { pSprites_LOD->open(makeDataPath("data", "sprites.lod")); });
 
     // TODO(captainurist):
     // on error in `open` we had this:
@@ -683,7 +819,8 @@ void MM7_LoadLods() {
     // however, at this point localization isn't initialized yet, so this was a guaranteed crash.
     // Implement proper user-facing error reporting!
 
-    pPaletteManager->load(pBitmaps_LOD);
+    graph.add("palettes", [] { pPaletteManager->load(pBitmaps_LOD); }, {bitmaps});
+    return resources;
 }
 
 //----- (004651F4) --------------------------------------------------------
@@ -706,10 +843,13 @@ void Engine::MM7_Initialize() {
 
     _statusBar = std::make_unique<StatusBar>();
 
-    MM7_LoadLods();
+    // Everything below is loaded in parallel. Localization is the only strtok user here, and audio & video are
+    // initialized on the main thread.
+    TaskGraph graph;
+    TaskGraph::TaskId resources = MM7_LoadLods(graph);
 
     localization = new Localization();
-    localization->Initialize();
+    graph.add("localization", [] { localization->Initialize(); }, {resources});
 
     auto triLoad = [](const std::string &name) {
         TriBlob result;
@@ -718,117 +858,174 @@ void Engine::MM7_Initialize() {
         return result;
     };
 
-    pSpriteFrameTable = new SpriteFrameTable;
-    deserialize(triLoad("dsft.bin"), pSpriteFrameTable);
-
-    pTextureFrameTable = new TextureFrameTable;
-    deserialize(triLoad("dtft.bin"), pTextureFrameTable);
-
-    pTileTable = new TileTable;
-    deserialize(triLoad("dtile.bin"), pTileTable);
-
-    pPlayerFrameTable = new PlayerFrameTable;
-    deserialize(triLoad("dpft.bin"), pPlayerFrameTable);
-
-    pIconsFrameTable = new IconFrameTable;
-    deserialize(triLoad("dift.bin"), pIconsFrameTable);
-
-    pDecorationList = new DecorationList;
-    deserialize(triLoad("ddeclist.bin"), pDecorationList);
-
-    pObjectList = new ObjectList;
-    deserialize(triLoad("dobjlist.bin"), pObjectList);
-
-    pMonsterList = new MonsterList;
-    deserialize(triLoad("dmonlist.bin"), pMonsterList);
-
-    pChestList = new ChestDescList;
-    deserialize(triLoad("dchest.bin"), pChestList);
-
-    pOverlayList = new OverlayList;
-    deserialize(triLoad("doverlay.bin"), pOverlayList);
+    auto addTable = [&](const char *name, auto *table) {
+        graph.add(name, [=] { deserialize(triLoad(name), table); }, {resources});
+    };
 
-    // TODO(captainurist): move to TableSnapshots.h/cpp
-    Blob sounds_mm6 = pIcons_LOD_mm6 ? pIcons_LOD_mm6->LoadCompressedTexture("dsounds.bin") : Blob();
-    Blob sounds_mm8;
-    Blob sounds_mm7 = engine->_gameResourceManager->getEventsFile("dsounds.bin");
+    addTable("dsft.bin", pSpriteFrameTable = new SpriteFrameTable);
+    addTable("dtft.bin", pTextureFrameTable = new TextureFrameTable);
+    addTable("dtile.bin", pTileTable = new TileTable);
+    addTable("dpft.bin", pPlayerFrameTable = new PlayerFrameTable);
+    addTable("dift.bin", pIconsFrameTable = new IconFrameTable);
+    addTable("ddeclist.bin", pDecorationList = new DecorationList);
+    addTable("dobjlist.bin", pObjectList = new ObjectList);
+    addTable("dmonlist.bin", pMonsterList = new MonsterList);
+    addTable("dchest.bin", pChestList = new ChestDescList);
+    addTable("doverlay.bin", pOverlayList = new OverlayList);
 
     pSoundList = new SoundList;
-    pSoundList->FromFile(sounds_mm6, sounds_mm7, sounds_mm8);
+    TaskGraph::TaskId sounds = graph.add("dsounds.bin", [] {
+        // TODO(captainurist): move to TableSnapshots.h/cpp
+        Blob sounds_mm6 = pIcons_LOD_mm6 ? pIcons_LOD_mm6->LoadCompressedTexture("dsounds.bin") : Blob();
+        Blob sounds_mm8;
+        Blob sounds_mm7 = engine->_gameResourceManager->getEventsFile("dsounds.bin");
+        pSoundList->FromFile(sounds_mm6, sounds_mm7, sounds_mm8);
+    }, {resources});
 
     if (!config->debug.NoSound.value())
-        pAudioPlayer->Initialize();
+        graph.addPinned("audio", [] { pAudioPlayer->Initialize(); }, {sounds});
 
     pMediaPlayer = new MPlayer();
-    pMediaPlayer->Initialize();
+    graph.addPinned("video", [] { pMediaPlayer->Initialize(); });
+
+    graph.run(_threadPool.get());
+    logTaskGraph("Engine initialization", graph);
 
     dword_6BE364_game_settings_1 |= GAME_SETTINGS_4000;
 }
 
+static Blob readTextTableCache(const std::string &path) {
+    try {
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec))
+            return Blob::fromFile(path);
+    } catch (const std::exception &e) {
+        logger->warning("Could not read text table cache '{}': {}", path, e.what());
+    }
+    return Blob();
+}
+
+static void writeTextTableCache(const std::string &path, const Blob &cache) {
+    // Write to a temporary file first, so that other instances never see a partially written cache.
+    std::string tmpPath = path + ".tmp";
+    try {
+        FileOutputStream output(tmpPath);
+        output.write(cache.data(), cache.size());
+        output.close();
+        std::filesystem::rename(tmpPath, path);
+    } catch (const std::exception &e) {
+        logger->warning("Could not write text table cache '{}': {}", path, e.what());
+    }
+}
+
 //----- (00465D0B) --------------------------------------------------------
 void Engine::SecondaryInitialization() {
     mouse->Initialize();
 
-    pMapStats = new MapStats();
-    pMapStats->Initialize(engine->_gameResourceManager->getEventsFile("MapStats.txt"));
-
-    pMonsterStats = new MonsterStats();
-    pMonsterStats->Initialize(engine->_gameResourceManager->getEventsFile("monsters.txt"));
-    pMonsterStats->InitializePlacements(engine->_gameResourceManager->getEventsFile("placemon.txt"));
-
-    pSpellStats = new SpellStats();
-    pSpellStats->Initialize(engine->_gameResourceManager->getEventsFile("spells.txt"));
+    // Most of the text table parsers use strtok, which is not reentrant, so they are run on the main thread, together
+    // with the UI code. Files are still loaded in parallel, and the tables that don't use strtok are parsed in parallel.
+    TaskGraph graph;
+
+    std::map<std::string, Blob> files;
+    std::vector<TaskGraph::TaskId> fileTasks;
+    for (const char *name : {"MapStats.txt", "monsters.txt", "placemon.txt", "spells.txt", "hostile.txt", "history.txt",
+                             "2dEvents.txt", "quests.txt", "autonote.txt", "awards.txt", "trans.txt", "merchant.txt",
+                             "scroll.txt"}) {
+        Blob *file = &files[name]; // Map is fully populated before the graph is run, so this pointer stays valid.
+        fileTasks.push_back(graph.add(name, [=] { *file = engine->_gameResourceManager->getEventsFile(name); }));
+    }
 
-    pFactionTable = new FactionTable();
-    pFactionTable->Initialize(engine->_gameResourceManager->getEventsFile("hostile.txt"));
+    // Tables that don't depend on anything but their source files are loaded from the cache if possible.
+    TextTables cachedTables = {
+        pMapStats = new MapStats(),
+        pMonsterStats = new MonsterStats(),
+        pSpellStats = new SpellStats(),
+        pFactionTable = new FactionTable(),
+        pStorylineText = new StorylineText()
+    };
+    TextTableSources cacheSources;
+    std::string cachePath = makeDataPath("text_table_cache.bin");
+    bool useCache = config->settings.TableCache.value();
+    bool cacheLoaded = false;
+    TaskGraph::TaskId cache = graph.add("text table cache", [&] {
+        cacheSources = {Blob::share(files.at("MapStats.txt")), Blob::share(files.at("monsters.txt")),
+                        Blob::share(files.at("placemon.txt")), Blob::share(files.at("spells.txt")),
+                        Blob::share(files.at("hostile.txt")), Blob::share(files.at("history.txt"))};
+        if (useCache)
+            cacheLoaded = loadTextTableCache(readTextTableCache(cachePath), cacheSources, cachedTables);
+    }, fileTasks);
+
+    TaskGraph::TaskId mapStats = graph.add("MapStats.txt parse", [&] {
+        if (!cacheLoaded)
+            pMapStats->Initialize(files.at("MapStats.txt"));
+    }, {cache});
+
+    graph.add("global.evt", [this] {
+        _globalEventMap = EventMap::load(_gameResourceManager->getEventsFile("global.evt"));
+    });
+
+    TaskGraph::TaskId tables = graph.addPinned("text tables", [&] {
+        if (!cacheLoaded) {
+            pMonsterStats->Initialize(files.at("monsters.txt"));
+            pMonsterStats->InitializePlacements(files.at("placemon.txt"));
+            pSpellStats->Initialize(files.at("spells.txt"));
+            pFactionTable->Initialize(files.at("hostile.txt"));
+            pStorylineText->Initialize(files.at("history.txt"));
+        }
 
-    pStorylineText = new StorylineText();
-    pStorylineText->Initialize(engine->_gameResourceManager->getEventsFile("history.txt"));
+        pItemTable = new ItemTable();
+        pItemTable->Initialize(engine->_gameResourceManager.get());
 
-    pItemTable = new ItemTable();
-    pItemTable->Initialize(engine->_gameResourceManager.get());
+        initializeBuildings(files.at("2dEvents.txt"));
+    }, {cache});
 
-    initializeBuildings(engine->_gameResourceManager->getEventsFile("2dEvents.txt"));
+    TaskGraph::TaskId ui = graph.addPinned("ui", [this] {
+        //pPaletteManager->SetMistColor(128, 128, 128);
+        //pPaletteManager->RecalculateAll();
+        pObjectList->InitializeSprites();
+        pOverlayList->InitializeSprites();
 
-    //pPaletteManager->SetMistColor(128, 128, 128);
-    //pPaletteManager->RecalculateAll();
-    pObjectList->InitializeSprites();
-    pOverlayList->InitializeSprites();
+        for (unsigned i = 0; i < 4; ++i) {
+            static const char *pUIAnimNames[4] = {"glow03", "glow05", "torchA", "wizeyeA"};
+            static unsigned short _4E98D0[4][4] = { {479, 0, 329, 0}, {585, 0, 332, 0}, {468, 0, 0, 0}, {606, 0, 0, 0} };
 
-    for (unsigned i = 0; i < 4; ++i) {
-        static const char *pUIAnimNames[4] = {"glow03", "glow05", "torchA", "wizeyeA"};
-        static unsigned short _4E98D0[4][4] = { {479, 0, 329, 0}, {585, 0, 332, 0}, {468, 0, 0, 0}, {606, 0, 0, 0} };
+            // pUIAnims[i]->uIconID = pIconsFrameTable->FindIcon(pUIAnimNames[i]);
+            pUIAnims[i]->icon = pIconsFrameTable->GetIcon(pUIAnimNames[i]);
 
-        // pUIAnims[i]->uIconID = pIconsFrameTable->FindIcon(pUIAnimNames[i]);
-        pUIAnims[i]->icon = pIconsFrameTable->GetIcon(pUIAnimNames[i]);
+            pUIAnims[i]->uAnimLength = 0_ticks;
+            pUIAnims[i]->uAnimTime = 0;
+            pUIAnims[i]->x = _4E98D0[i][0];
+            pUIAnims[i]->y = _4E98D0[i][2];
+        }
 
-        pUIAnims[i]->uAnimLength = 0_ticks;
-        pUIAnims[i]->uAnimTime = 0;
-        pUIAnims[i]->x = _4E98D0[i][0];
-        pUIAnims[i]->y = _4E98D0[i][2];
-    }
+        // TODO(pskelton): dropping this causes std::bad_alloc in headless mode
+        UI_Create();
 
-    // TODO(pskelton): dropping this causes std::bad_alloc in headless mode
-    UI_Create();
+        spell_fx_renedrer->LoadAnimations();
 
-    spell_fx_renedrer->LoadAnimations();
+        for (unsigned i = 0; i < 7; ++i) {
+            std::string container_name = fmt::format("HDWTR{:03}", i);
+            render->hd_water_tile_anim[i] = assets->getBitmap(container_name);
+        }
+    }, {tables, mapStats});
 
-    for (unsigned i = 0; i < 7; ++i) {
-        std::string container_name = fmt::format("HDWTR{:03}", i);
-        render->hd_water_tile_anim[i] = assets->getBitmap(container_name);
-    }
+    graph.addPinned("npc & quest tables", [&] {
+        pNPCStats = new NPCStats();
+        pNPCStats->Initialize(engine->_gameResourceManager.get());
 
-    pNPCStats = new NPCStats();
-    pNPCStats->Initialize(engine->_gameResourceManager.get());
+        initializeQuests(files.at("quests.txt"));
+        initializeAutonotes(files.at("autonote.txt"));
+        initializeAwards(files.at("awards.txt"));
+        initializeTransitions(files.at("trans.txt"));
+        initializeMerchants(files.at("merchant.txt"));
+        initializeMessageScrolls(files.at("scroll.txt"));
+    }, {ui});
 
-    initializeQuests(engine->_gameResourceManager->getEventsFile("quests.txt"));
-    initializeAutonotes(engine->_gameResourceManager->getEventsFile("autonote.txt"));
-    initializeAwards(engine->_gameResourceManager->getEventsFile("awards.txt"));
-    initializeTransitions(engine->_gameResourceManager->getEventsFile("trans.txt"));
-    initializeMerchants(engine->_gameResourceManager->getEventsFile("merchant.txt"));
-    initializeMessageScrolls(engine->_gameResourceManager->getEventsFile("scroll.txt"));
+    graph.run(_threadPool.get());
+    logTaskGraph("Secondary initialization", graph);
 
-    engine->_globalEventMap = EventMap::load(engine->_gameResourceManager->getEventsFile("global.evt"));
+    if (useCache && !cacheLoaded)
+        writeTextTableCache(cachePath, saveTextTableCache(cacheSources, cachedTables));
 
     pBitmaps_LOD->reserveLoadedTextures();
     pSprites_LOD->reserveLoadedSprites();
@@ -903,6 +1100,50 @@ void MM7Initialization() {
                          viewparams->uScreen_BttmR_Y);
 }
 
+void prefetchLevelAssets() {
+    LoadProfilerScope profilerScope("prefetchLevelAssets");
+
+    std::vector<std::string> textureNames;
+    if (uCurrentlyLoadedLevelType == LEVEL_INDOOR) {
+        for (BLVFace &face : pIndoor->pFaces)
+            if (!face.IsTextureFrameTable() && face.resource)
+                textureNames.push_back(*face.GetTexture()->GetName());
+    } else {
+        for (BSPModel &model : pOutdoor->pBModels)
+            for (ODMFace &face : model.pFaces)
+                if (!face.IsTextureFrameTable() && face.resource)
+                    textureNames.push_back(*face.GetTexture()->GetName());
+    }
+
+    // Maps usually have dozens of actors of the same monster type, so we only look at the first actor of each type.
+    std::vector<const Actor *> uniqueActors;
+    IndexedBitset<MONSTER_FIRST, MONSTER_LAST> seenMonsters;
+    for (const Actor &actor : pActors) {
+        if (!seenMonsters[actor.monsterInfo.id]) {
+            seenMonsters.set(actor.monsterInfo.id);
+            uniqueActors.push_back(&actor);
+        }
+    }
+
+    std::vector<std::string> spriteNames;
+    for (const LevelDecoration &decoration : pLevelDecorations)
+        pSpriteFrameTable->collectSpriteNames(pDecorationList->GetDecoration(decoration.uDecorationDescID)->uSpriteID, &spriteNames);
+    for (const Actor *actor : uniqueActors)
+        for (const std::string &spriteName : pMonsterList->monsters[actor->monsterInfo.id].spriteNames)
+            pSpriteFrameTable->collectSpriteNames(pSpriteFrameTable->FastFindSprite(spriteName), &spriteNames);
+
+    std::vector<SoundId> soundIds;
+    for (int decorIdx : decorationsWithSound)
+        soundIds.push_back(pDecorationList->GetDecoration(pLevelDecorations[decorIdx].uDecorationDescID)->uSoundID);
+    for (const Actor *actor : uniqueActors)
+        for (SoundId soundId : actor->soundSampleIds)
+            soundIds.push_back(soundId);
+
+    pBitmaps_LOD->prefetchTextures(textureNames, engine->_threadPool.get());
+    pSprites_LOD->prefetchSprites(spriteNames, engine->_threadPool.get());
+    pAudioPlayer->preloadSounds(soundIds);
+}
+
 // TODO(pskelton): move to outdoor?
 //----- (004610AA) --------------------------------------------------------
 void PrepareToLoadODM(bool bLoading, ODMRenderParams *a2) {
@@ -934,7 +1175,7 @@ void Engine::ResetCursor_Palettes_LODs_Level_Audio_SFT_Windows() {
     }
 
     // Render billboards are used in hit tests, but we're releasing textures, so can't use them anymore.
-    render->uNumBillboardsToDraw = 0;
+    render->pBillboardRenderListD3D.clear();
 
     pBitmaps_LOD->releaseUnreserved();
     pSprites_LOD->releaseUnreserved();
@@ -955,6 +1196,8 @@ void Engine::ResetCursor_Palettes_LODs_Level_Audio_SFT_Windows() {
 
 //----- (00461103) --------------------------------------------------------
 void Engine::_461103_load_level_sub() {
+    LoadProfilerScope profilerScope("Engine::_461103_load_level_sub");
+
     int v4;          // edx@8
     int v6;   // esi@14
     int v8;   // ecx@16
@@ -1119,6 +1362,7 @@ void setTexture(unsigned int uFaceCog, const std::string &pFilename) {
 void setFacesBit(int sCogNumber, FaceAttribute bit, int on) {
     if (sCogNumber) {
         if (uCurrentlyLoadedLevelType == LEVEL_INDOOR) {
+            pBspRenderer->invalidateCache(); // Face attributes affect portal traversal.
             for (unsigned i = 1; i < (unsigned int)pIndoor->pFaceExtras.size(); ++i) {
                 if (pIndoor->pFaceExtras[i].sCogNumber == sCogNumber) {
                     if (on)
@@ -1625,6 +1869,8 @@ void initLevelStrings(const Blob &blob) {
 }
 
 void Level_LoadEvtAndStr(const std::string &pLevelName) {
+    LoadProfilerScope profilerScope("Level_LoadEvtAndStr");
+
     initLevelStrings(engine->_gameResourceManager->getEventsFile(pLevelName + ".str"));
 
     engine->_localEventMap = EventMap::load(engine->_gameResourceManager->getEventsFile(pLevelName + ".evt"));
@@ -8,6 +8,7 @@
 #include "Application/GameConfig.h"
 
 #include "Engine/Events/EventMap.h"
+#include "Engine/Graphics/QualityGovernor.h"
 #include "Engine/MapEnums.h"
 #include "Engine/TeleportPoint.h"
 #include "Engine/mm7_data.h"
@@ -36,6 +37,8 @@ struct ClippingFunctions;
 struct stru10;
 class GUIMessageQueue;
 class GameResourceManager;
+class ThreadPool;
+class LocationPrefetcher;
 class StatusBar;
 struct IndoorLocation;
 struct OutdoorLocation;
@@ -119,6 +122,7 @@ class Engine {
     std::shared_ptr<Io::Mouse> mouse;
     std::shared_ptr<Nuklear> nuklear;
     std::shared_ptr<ParticleEngine> particle_engine;
+    QualityGovernor qualityGovernor; // Fed by the renderer, read by the code that owns the governed settings.
     Vis *vis = nullptr;
     std::shared_ptr<Io::KeyboardInputHandler> keyboardInputHandler;
     std::shared_ptr<Io::KeyboardActionMapping> keyboardActionMapping;
@@ -135,6 +139,8 @@ class Engine {
     std::unique_ptr<OutdoorLocation> _outdoor;
     std::unique_ptr<LightsStack_StationaryLight_> _stationaryLights;
     std::unique_ptr<LightsStack_MobileLight_> _mobileLights;
+    std::unique_ptr<ThreadPool> _threadPool;
+    std::unique_ptr<LocationPrefetcher> _locationPrefetcher; // Uses `_threadPool`, so should be destroyed before it.
 };
 
 extern Engine *engine;
@@ -155,6 +161,12 @@ void MM6_Initialize();
 void MM7Initialization();
 
 void PrepareToLoadODM(bool bLoading, struct ODMRenderParams *a2);
+
+/**
+ * Starts decoding textures of the level geometry and sprites of the level decorations & actors on the engine's
+ * thread pool. Should be called once level data is loaded, but before decorations & actors are initialized.
+ */
+void prefetchLevelAssets();
 void InitializeTurnBasedAnimations(void *);
 unsigned int GetGravityStrength();
 
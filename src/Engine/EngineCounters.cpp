@@ -0,0 +1,3 @@
+#include "EngineCounters.h"
+
+EngineCounters engineCounters;
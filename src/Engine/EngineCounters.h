@@ -0,0 +1,24 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Engine-wide work counters. These count how many times the engine has done something expensive - face tests in
+ * collision code, sector lookups, line-of-sight checks, etc. Unlike wall-clock timings, these are deterministic
+ * when playing back a trace, so game tests can assert on them to catch algorithmic regressions. See
+ * `CommonTapeRecorder::counterPerTick`.
+ *
+ * Counters are never reset, users are expected to look at deltas. Some of the counted functions are also called from
+ * the worker threads (e.g. `Detect_Between_Objects` from `Actor::selectTargets`), so the counters are atomic. Use
+ * relaxed increments, the totals don't depend on the order in which the threads get to them.
+ */
+struct EngineCounters {
+    std::atomic<int64_t> actorsUpdated = 0; // Actors that went through the movement & collision update.
+    std::atomic<int64_t> collisionFaceTests = 0; // Faces tested against a moving body in the collision code.
+    std::atomic<int64_t> sectorLookups = 0; // Calls into `IndoorLocation::GetSector`.
+    std::atomic<int64_t> lineOfSightChecks = 0; // Calls into `Detect_Between_Objects`.
+    std::atomic<int64_t> billboards = 0; // Billboards that went through the billboard render list.
+};
+
+extern EngineCounters engineCounters;
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <functional>
@@ -115,20 +116,11 @@ static bool doForChosenPlayer(CharacterChoosePolicy who, RandomEngine *rng, std:
 }
 
 int EventInterpreter::executeOneEvent(int step, bool isNpc) {
-    EventIR ir;
-    bool stepFound = false;
-
-    for (const EventIR &irTmp : _events) {
-        if (irTmp.step == step) {
-            ir = irTmp;
-            stepFound = true;
-            break;
-        }
-    }
-
-    if (!stepFound) {
+    auto pos = std::ranges::find(*_events, step, &EventIR::step);
+    if (pos == _events->end()) {
         return -1;
     }
+    const EventIR &ir = *pos;
 
     // In NPC mode must process only NPC dialogue related events plus Exit
     if (isNpc) {
@@ -583,7 +575,7 @@ int EventInterpreter::executeOneEvent(int step, bool isNpc) {
 bool EventInterpreter::executeRegular(int startStep) {
     assert(startStep >= 0);
 
-    if (!_eventId || !_events.size()) {
+    if (!_eventId || !isValid()) {
         return false;
     }
 
@@ -605,7 +597,7 @@ bool EventInterpreter::executeNpcDialogue(int startStep) {
         return false;
     }
 
-    if (!_events.size()) {
+    if (!isValid()) {
         // No event commands found for current eventId
         // In this case dialogue elements can be showed
         return true;
@@ -628,12 +620,12 @@ void EventInterpreter::prepare(const EventMap &eventMap, int eventId, Pid object
     _canShowMessages = canShowMessages;
     _objectPid = objectPid;
 
-    _events.clear();
+    _events = nullptr;
     if (eventMap.hasEvent(eventId)) {
-        _events = eventMap.events(eventId);
+        _events = &eventMap.events(eventId);
     }
 }
 
 bool EventInterpreter::isValid() {
-    return _events.size() > 0;
+    return _events && !_events->empty();
 }
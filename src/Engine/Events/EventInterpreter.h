@@ -19,7 +19,7 @@ class EventInterpreter {
 
  private:
      int _eventId = 0;
-     std::vector<EventIR> _events;
+     const std::vector<EventIR> *_events = nullptr; // Points into the event map, which outlives the interpreter.
      Pid _objectPid = Pid();
      bool _canShowMessages = false;
      bool _canShowOption = true;
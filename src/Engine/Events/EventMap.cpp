@@ -1,5 +1,6 @@
 #include "EventMap.h"
 
+#include <algorithm>
 #include <ranges>
 #include <tuple>
 #include <vector>
@@ -38,12 +39,25 @@ EventMap EventMap::load(const Blob &rawData) {
     return result;
 }
 
+static auto triggerKey(const EventTrigger &trigger) {
+    return std::tie(trigger.eventId, trigger.eventStep);
+}
+
 void EventMap::add(int eventId, EventIR ir) {
+    // As retarded as it might look, there are scripts that have THREE EVENT_OnLongTimer instructions.
+    // Thus, we might have several event triggers for the same event id.
+    EventTrigger trigger;
+    trigger.eventId = eventId;
+    trigger.eventStep = ir.step;
+    std::vector<EventTrigger> &triggers = _triggersByType[ir.type];
+    triggers.insert(std::ranges::upper_bound(triggers, triggerKey(trigger), std::less(), &triggerKey), trigger);
+
     _eventsById[eventId].push_back(std::move(ir));
 }
 
 void EventMap::clear() {
     _eventsById.clear();
+    _triggersByType.clear();
 }
 
 const EventIR &EventMap::event(int eventId, int step) const {
@@ -60,25 +74,11 @@ const std::vector<EventIR>& EventMap::events(int eventId) const {
     return *result;
 }
 
-std::vector<EventTrigger> EventMap::enumerateTriggers(EventType triggerType) {
-    std::vector<EventTrigger> result;
-
-    for (const auto &[id, events] : _eventsById) {
-        for (const EventIR &event : events) {
-            // As retarded as it might look, there are scripts that have THREE EVENT_OnLongTimer instructions.
-            // Thus, we might have several event triggers for the same event id.
-            if (event.type == triggerType) {
-                EventTrigger trigger;
-                trigger.eventId = id;
-                trigger.eventStep = event.step;
-                result.push_back(trigger);
-            }
-        }
-    }
+const std::vector<EventTrigger> &EventMap::enumerateTriggers(EventType triggerType) const {
+    static const std::vector<EventTrigger> empty;
 
-    // Need to sort the result so that the order doesn't depend on how the events were laid out in the hash map.
-    std::ranges::sort(result, std::less(), [] (const EventTrigger &value) { return std::tie(value.eventId, value.eventStep); }); // NOLINT
-    return result;
+    const auto *result = valuePtr(_triggersByType, triggerType);
+    return result ? *result : empty;
 }
 
 bool EventMap::hasHint(int eventId) const {
@@ -117,6 +117,9 @@ std::string EventMap::hint(int eventId) const {
 }
 
 void EventMap::dump(int eventId) const {
+    if (!logger->shouldLog(LOG_TRACE))
+        return; // Don't format the events if nobody's going to see them.
+
     const auto *events = valuePtr(_eventsById, eventId);
     if (events) {
         logger->trace("Event: {}", eventId);
@@ -41,9 +41,10 @@ class EventMap {
 
     /**
      * @param triggerType               Event type to look for.
-     * @return                          List of all event positions that have the given event type.
+     * @return                          List of all event positions that have the given event type, sorted by event
+     *                                  id and step.
      */
-    std::vector<EventTrigger> enumerateTriggers(EventType triggerType);
+    const std::vector<EventTrigger> &enumerateTriggers(EventType triggerType) const;
 
     /**
      *
@@ -64,4 +65,5 @@ class EventMap {
 
  private:
     std::unordered_map<int, std::vector<EventIR>> _eventsById;
+    std::unordered_map<EventType, std::vector<EventTrigger>> _triggersByType; // Kept sorted by event id & step.
 };
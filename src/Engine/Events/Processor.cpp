@@ -1,6 +1,9 @@
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "Engine/Engine.h"
+#include "Engine/LoadProfiler.h"
 #include "Engine/Localization.h"
 #include "Engine/mm7_data.h"
 #include "Engine/Graphics/LocationFunctions.h"
@@ -17,6 +20,7 @@
 #include "GUI/UI/UIStatusBar.h"
 
 #include "Library/Logger/Logger.h"
+#include "Library/Profiler/Profiler.h"
 
 struct MapTimer {
     Duration interval;
@@ -39,11 +43,16 @@ static std::vector<int> decorationsWithEvents;
 // Do not needed in practice but can be considered optimization to avoid checking timers too often.
 static Time timerGuard;
 
+// Earliest alarm time over all registered timers, `onTimer` doesn't need to look at the timers until then.
+static Time nextAlarmTime;
+
 int savedEventID;
 int savedEventStep;
 struct LevelDecoration *savedDecoration;
 
 void initDecorationEvents() {
+    LoadProfilerScope profilerScope("initDecorationEvents");
+
     int id = pDecorationList->GetDecorIdByName("Event Trigger");
 
     decorationsWithEvents.clear();
@@ -83,16 +92,16 @@ void checkDecorationEvents() {
 }
 
 static void registerTimerTriggers(EventType triggerType, std::vector<MapTimer> *triggers) {
-    std::vector<EventTrigger> timerTriggers = engine->_localEventMap.enumerateTriggers(triggerType);
+    const std::vector<EventTrigger> &timerTriggers = engine->_localEventMap.enumerateTriggers(triggerType);
 
     // TODO(Nik-RE-dev): using time of last visit will help timers only slightly because each map leaving resets it.
     //                   To support fair timers they need to be saved directly.
     Time levelLastVisit = currentLocationTime().last_visit;
 
     triggers->clear();
-    for (EventTrigger &trigger : timerTriggers) {
+    for (const EventTrigger &trigger : timerTriggers) {
         MapTimer timer;
-        EventIR ir = engine->_localEventMap.event(trigger.eventId, trigger.eventStep);
+        const EventIR &ir = engine->_localEventMap.event(trigger.eventId, trigger.eventStep);
 
         if (ir.data.timer_descr.alt_halfmin_interval) {
             // Alternative interval is defined in terms of half-minutes
@@ -144,6 +153,8 @@ static void registerTimerTriggers(EventType triggerType, std::vector<MapTimer> *
 }
 
 void eventProcessor(int eventId, Pid targetObj, bool canShowMessages, int startStep) {
+    OE_PROFILE_ZONE("event processor");
+
     if (!eventId) {
         engine->_statusBar->nothingHere();
         return;
@@ -196,6 +207,15 @@ std::string getEventHintString(int eventId) {
     return engine->_localEventMap.hint(eventId);
 }
 
+static Time earliestAlarmTime() {
+    Time result = Time::fromTicks(std::numeric_limits<int64_t>::max());
+    for (const MapTimer &timer : onTimerTriggers)
+        result = std::min(result, timer.alarmTime);
+    for (const MapTimer &timer : onLongTimerTriggers)
+        result = std::min(result, timer.alarmTime);
+    return result;
+}
+
 static void registerEventTriggers() {
     onMapLoadTriggers.clear();
     onMapLoadTriggers = engine->_localEventMap.enumerateTriggers(EVENT_OnMapReload);
@@ -204,9 +224,12 @@ static void registerEventTriggers() {
 
     registerTimerTriggers(EVENT_OnLongTimer, &onLongTimerTriggers);
     registerTimerTriggers(EVENT_OnTimer, &onTimerTriggers);
+    nextAlarmTime = earliestAlarmTime();
 }
 
 void onMapLoad() {
+    LoadProfilerScope profilerScope("onMapLoad");
+
     // Register all triggers when map done loading
     registerEventTriggers();
 
@@ -255,6 +278,11 @@ void onTimer() {
 
     timerGuard = pParty->GetPlayingTime();
 
+    // No timer is due yet, checkTimer would be a no-op for all of them.
+    if (pParty->GetPlayingTime() < nextAlarmTime) {
+        return;
+    }
+
     for (MapTimer &timer : onTimerTriggers) {
         checkTimer(timer);
     }
@@ -262,4 +290,6 @@ void onTimer() {
     for (MapTimer &timer : onLongTimerTriggers) {
         checkTimer(timer);
     }
+
+    nextAlarmTime = earliestAlarmTime();
 }
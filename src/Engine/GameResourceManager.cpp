@@ -1,5 +1,7 @@
 #include "Engine/GameResourceManager.h"
 
+#include "Engine/LOD.h"
+
 #include "Library/LodFormats/LodFormats.h"
 
 #include "Utility/DataPath.h"
@@ -9,6 +11,8 @@ GameResourceManager::~GameResourceManager() = default;
 
 void GameResourceManager::openGameResources() {
     _eventsLodReader.open(makeDataPath("data", "events.lod"));
+    if (pDecodeCache)
+        pDecodeCache->attach(_eventsLodReader);
     // TODO(captainurist):
     //  on exception:
     //      Error(localization->GetString(LSTR_PLEASE_REINSTALL), localization->GetString(LSTR_REINSTALL_NECESSARY));
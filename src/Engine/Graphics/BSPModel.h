@@ -7,6 +7,7 @@
 #include "Library/Geometry/Plane.h"
 #include "Library/Geometry/BBox.h"
 
+#include "Bvh.h"
 #include "FaceEnums.h"
 
 class GraphicsImage;
@@ -106,4 +107,5 @@ class BSPModel {
     std::vector<ODMFace> pFaces;
     std::vector<uint16_t> pFacesOrdering;
     std::vector<BSPNode> pNodes;
+    Bvh faceBvh; // Over face bounding boxes, used for picking.
 };
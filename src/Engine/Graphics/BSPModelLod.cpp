@@ -0,0 +1,62 @@
+#include "BSPModelLod.h"
+
+#include <cmath>
+#include <unordered_map>
+
+#include "BSPModel.h"
+
+BSPModelLod buildBSPModelLod(const BSPModel &model, float clusterSize) {
+    BSPModelLod result;
+    result.clusterSize = clusterSize;
+
+    // Assign vertices to clusters, and sum up the cluster positions.
+    std::vector<int> vertexClusters(model.pVertices.size());
+    std::vector<Vec3f> clusterPositions;
+    std::vector<int> clusterSizes;
+    std::unordered_map<int64_t, int> clusterByCell;
+    for (size_t i = 0; i < model.pVertices.size(); i++) {
+        Vec3f pos = model.pVertices[i].toFloat();
+        int64_t cellX = static_cast<int64_t>(std::floor(pos.x / clusterSize)) & 0x1FFFFF;
+        int64_t cellY = static_cast<int64_t>(std::floor(pos.y / clusterSize)) & 0x1FFFFF;
+        int64_t cellZ = static_cast<int64_t>(std::floor(pos.z / clusterSize)) & 0x1FFFFF;
+        int64_t cell = (cellX << 42) | (cellY << 21) | cellZ;
+
+        auto [it, inserted] = clusterByCell.try_emplace(cell, static_cast<int>(clusterPositions.size()));
+        if (inserted) {
+            clusterPositions.push_back(Vec3f());
+            clusterSizes.push_back(0);
+        }
+        int cluster = it->second;
+        clusterPositions[cluster] += pos;
+        clusterSizes[cluster]++;
+        vertexClusters[i] = cluster;
+    }
+    for (size_t i = 0; i < clusterPositions.size(); i++)
+        clusterPositions[i] /= static_cast<float>(clusterSizes[i]);
+
+    // Rebuild face fans, dropping the triangles that have collapsed into a line or a point.
+    for (size_t faceIndex = 0; faceIndex < model.pFaces.size(); faceIndex++) {
+        const ODMFace &face = model.pFaces[faceIndex];
+        auto vertex = [&](int i) {
+            BSPModelLod::Vertex result;
+            result.pos = clusterPositions[vertexClusters[face.pVertexIDs[i]]];
+            result.u = face.pTextureUIDs[i];
+            result.v = face.pTextureVIDs[i];
+            return result;
+        };
+
+        for (int z = 0; z < face.uNumVertices - 2; z++) {
+            int c0 = vertexClusters[face.pVertexIDs[0]];
+            int c1 = vertexClusters[face.pVertexIDs[z + 1]];
+            int c2 = vertexClusters[face.pVertexIDs[z + 2]];
+            if (c0 == c1 || c1 == c2 || c0 == c2)
+                continue;
+
+            BSPModelLod::Triangle &triangle = result.triangles.emplace_back();
+            triangle.face = static_cast<int>(faceIndex);
+            triangle.vertices = {vertex(0), vertex(z + 1), vertex(z + 2)};
+        }
+    }
+
+    return result;
+}
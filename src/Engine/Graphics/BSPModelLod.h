@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Library/Geometry/Vec.h"
+
+class BSPModel;
+
+/**
+ * Simplified mesh of an outdoor model, built with vertex clustering. Used to draw models that are far from the
+ * camera.
+ *
+ * Every triangle remembers the face it was cut from, so face state that changes at runtime (textures, texture
+ * deltas, visibility) is still taken from the model when drawing.
+ */
+struct BSPModelLod {
+    struct Vertex {
+        Vec3f pos;
+        float u = 0; // Texture coordinates without the face's texture deltas.
+        float v = 0;
+    };
+
+    struct Triangle {
+        int face = 0; // Index into `BSPModel::pFaces`.
+        std::array<Vertex, 3> vertices;
+    };
+
+    float clusterSize = 0; // Size of the clustering grid cell, this is the max position error of the mesh.
+    std::vector<Triangle> triangles; // Sorted by face index.
+};
+
+/**
+ * Builds a simplified mesh for the provided model.
+ *
+ * Model vertices are snapped to a grid with `clusterSize` cells, and all vertices in a cell are merged into one at
+ * their average position. Face fans are then rebuilt from the merged vertices, dropping the triangles that have
+ * collapsed. Coplanar neighbours that only differ in small details merge naturally this way, as their shared
+ * vertices end up in the same cells.
+ *
+ * @param model                         Model to simplify.
+ * @param clusterSize                   Size of the clustering grid cell.
+ * @return                              Simplified mesh.
+ */
+[[nodiscard]] BSPModelLod buildBSPModelLod(const BSPModel &model, float clusterSize);
@@ -2,10 +2,9 @@
 
 #include "Engine/Graphics/Indoor.h"
 #include "Engine/Graphics/PortalFunctions.h"
+#include "Engine/Graphics/Viewport.h"
 #include "Engine/Engine.h"
 
-#include "Library/Logger/Logger.h"
-
 BspRenderer *pBspRenderer = new BspRenderer();
 
 //----- (004B0EA8) --------------------------------------------------------
@@ -13,19 +12,14 @@ void BspRenderer::AddFaceToRenderList_d3d(int node_id, int uFaceID) {
     int pTransitionSector;  // ax@11
     // int dotdist;                              // edx@15
 
-    nodes[num_nodes].viewing_portal_id = -1;
-
     if (uFaceID >= pIndoor->pFaces.size()) return;
     BLVFace *pFace = &pIndoor->pFaces[uFaceID];
 
     if (!pFace->isPortal()) {
-        if (num_faces < 1500) {
-            // add face and return
-            faces[num_faces].uFaceID = uFaceID;
-            faces[num_faces++].uNodeID = node_id;
-        } else {
-            logger->info("Too many faces in BLV render");
-        }
+        // add face and return
+        BspFace &face = faces.emplace_back();
+        face.uFaceID = uFaceID;
+        face.uNodeID = node_id;
         return;
     }
 
@@ -43,18 +37,21 @@ void BspRenderer::AddFaceToRenderList_d3d(int node_id, int uFaceID) {
         // draw back sector if we are already doing this sector
         if (nodes[0].uSectorID == pTransitionSector)
             pTransitionSector = pFace->uBackSectorID;
-        nodes[num_nodes].uSectorID = pTransitionSector;
-        nodes[num_nodes].uFaceID = uFaceID;
+
+        BspRenderer_ViewportNode &node = nodes.emplace_back();
+        node.uSectorID = pTransitionSector;
+        node.uFaceID = uFaceID;
+        node.viewing_portal_id = -1;
 
         // set furstum to cam frustum
         for (int loop = 0; loop < 4; loop++) {
-            nodes[num_nodes].ViewportNodeFrustum[loop].normal.x = pCamera3D->FrustumPlanes[loop].x;
-            nodes[num_nodes].ViewportNodeFrustum[loop].normal.y = pCamera3D->FrustumPlanes[loop].y;
-            nodes[num_nodes].ViewportNodeFrustum[loop].normal.z = pCamera3D->FrustumPlanes[loop].z;
-            nodes[num_nodes].ViewportNodeFrustum[loop].dist = -pCamera3D->FrustumPlanes[loop].w;
+            node.ViewportNodeFrustum[loop].normal.x = pCamera3D->FrustumPlanes[loop].x;
+            node.ViewportNodeFrustum[loop].normal.y = pCamera3D->FrustumPlanes[loop].y;
+            node.ViewportNodeFrustum[loop].normal.z = pCamera3D->FrustumPlanes[loop].z;
+            node.ViewportNodeFrustum[loop].dist = -pCamera3D->FrustumPlanes[loop].w;
         }
 
-        AddBspNodeToRenderList(++num_nodes - 1);
+        AddBspNodeToRenderList(nodes.size() - 1);
         return;
     }
     // check if portal is visible on screen
@@ -81,28 +78,28 @@ void BspRenderer::AddFaceToRenderList_d3d(int node_id, int uFaceID) {
         pTransitionSector = pFace->uSectorID;
         if (nodes[node_id].uSectorID == pTransitionSector)
             pTransitionSector = pFace->uBackSectorID;
-        nodes[num_nodes].uSectorID = pTransitionSector;
-        nodes[num_nodes].uFaceID = uFaceID;
 
         // avoid circular loops in portals
-        for (int test = 0; test < num_nodes; test++) {
-            if (nodes[test].uSectorID == nodes[num_nodes].uSectorID &&
-                nodes[test].uFaceID == nodes[num_nodes].uFaceID) {
+        for (const BspRenderer_ViewportNode &test : nodes) {
+            if (test.uSectorID == pTransitionSector && test.uFaceID == uFaceID) {
                 return;
             }
         }
 
         // calculates the portal bounding and frustum
+        BspRenderer_ViewportNode node;
+        node.uSectorID = pTransitionSector;
+        node.uFaceID = uFaceID;
         bool bFrustumbuilt = engine->pStru10Instance->CalcPortalShapePoly(
                 pFace, static_subAddFaceToRenderList_d3d_stru_F79E08,
-                &pNewNumVertices, nodes[num_nodes].ViewportNodeFrustum.data(),
-                nodes[num_nodes].pPortalBounding.data());
+                &pNewNumVertices, node.ViewportNodeFrustum.data(),
+                node.pPortalBounding.data());
 
         if (bFrustumbuilt) {
             // add portal sector to drawing list
-            assert(num_nodes < 150);
-            nodes[num_nodes].viewing_portal_id = uFaceID;
-            AddBspNodeToRenderList(++num_nodes - 1);
+            node.viewing_portal_id = uFaceID;
+            nodes.push_back(node);
+            AddBspNodeToRenderList(nodes.size() - 1);
         }
     }
 }
@@ -115,7 +112,7 @@ void BspRenderer::MakeVisibleSectorList() {
 
     // TODO: this is actually n^2, might make sense to rewrite properly.
 
-    for (unsigned i = 0; i < num_nodes; ++i) {
+    for (unsigned i = 0; i < nodes.size(); ++i) {
         onlist = false;
         for (unsigned j = 0; j < uNumVisibleNotEmptySectors; j++) {
             if (pVisibleSectorIDs_toDrawDecorsActorsEtcFrom[j] == nodes[i].uSectorID) {
@@ -135,26 +132,50 @@ void BspRenderer::MakeVisibleSectorList() {
 }
 
 
+BspRenderCacheKey BspRenderCacheKey::current() {
+    BspRenderCacheKey result;
+    result.uPartySectorID = pBLVRenderParams->uPartySectorID;
+    result.vCameraPos = pCamera3D->vCameraPos;
+    result.FrustumPlanes = pCamera3D->FrustumPlanes;
+    result.ViewPlaneDistPixels = pCamera3D->ViewPlaneDistPixels;
+    result.uScreen_TL_X = pViewport->uScreen_TL_X;
+    result.uScreen_TL_Y = pViewport->uScreen_TL_Y;
+    result.uScreen_BR_X = pViewport->uScreen_BR_X;
+    result.uScreen_BR_Y = pViewport->uScreen_BR_Y;
+    result.maxVisibleSectors = engine->config->graphics.MaxVisibleSectors.value();
+    return result;
+}
+
 //----- (0043F953) --------------------------------------------------------
 void PrepareBspRenderList_BLV() {
-    // reset faces list
-    pBspRenderer->num_faces = 0;
+    // Traversal results depend only on the camera & the level geometry. If neither has changed since the last frame,
+    // e.g. when the party is standing still, the lists from the last frame are still valid. Note that the camera
+    // values have to match exactly, portal frusta are used for culling later on, so reusing them for a slightly
+    // different camera would produce visible artifacts.
+    BspRenderCacheKey key = BspRenderCacheKey::current();
+    if (pBspRenderer->cacheKey == key)
+        return;
+    pBspRenderer->cacheKey = key;
+
+    // reset faces & nodes lists
+    pBspRenderer->faces.clear();
+    pBspRenderer->nodes.clear();
 
     if (pBLVRenderParams->uPartySectorID) {
         // set node 0 to current sector
-        pBspRenderer->nodes[0].uSectorID = pBLVRenderParams->uPartySectorID;
+        BspRenderer_ViewportNode &node = pBspRenderer->nodes.emplace_back();
+        node.uSectorID = pBLVRenderParams->uPartySectorID;
         // set furstum to cam frustum
         for (int loop = 0; loop < 4; loop++) {
-            pBspRenderer->nodes[0].ViewportNodeFrustum[loop].normal.x = pCamera3D->FrustumPlanes[loop].x;
-            pBspRenderer->nodes[0].ViewportNodeFrustum[loop].normal.y = pCamera3D->FrustumPlanes[loop].y;
-            pBspRenderer->nodes[0].ViewportNodeFrustum[loop].normal.z = pCamera3D->FrustumPlanes[loop].z;
-            pBspRenderer->nodes[0].ViewportNodeFrustum[loop].dist = -pCamera3D->FrustumPlanes[loop].w;
+            node.ViewportNodeFrustum[loop].normal.x = pCamera3D->FrustumPlanes[loop].x;
+            node.ViewportNodeFrustum[loop].normal.y = pCamera3D->FrustumPlanes[loop].y;
+            node.ViewportNodeFrustum[loop].normal.z = pCamera3D->FrustumPlanes[loop].z;
+            node.ViewportNodeFrustum[loop].dist = -pCamera3D->FrustumPlanes[loop].w;
         }
 
         // blank viewing node
-        pBspRenderer->nodes[0].uFaceID = -1;
-        pBspRenderer->nodes[0].viewing_portal_id = -1;
-        pBspRenderer->num_nodes = 1;
+        node.uFaceID = -1;
+        node.viewing_portal_id = -1;
         AddBspNodeToRenderList(0);
     }
 
@@ -185,10 +206,11 @@ void AddNodeBSPFaces(int node_id, int uFirstNode) {
     int v8;                   // ebx@10
     int v9;               // di@18
 
-    BspRenderer_ViewportNode *node = &pBspRenderer->nodes[node_id];
+    // Can't hold a reference to the node here as the nodes list might grow in the recursive calls below.
+    int uSectorID = pBspRenderer->nodes[node_id].uSectorID;
 
     while (1) {
-        pSector = &pIndoor->pSectors[node->uSectorID];
+        pSector = &pIndoor->pSectors[uSectorID];
         pNode = &pIndoor->pNodes[uFirstNode];
         pFace = &pIndoor->pFaces[pSector->pFaceIDs[pNode->uBSPFaceIDOffset]];
         // check if we are in front or behind face
@@ -196,7 +218,7 @@ void AddNodeBSPFaces(int node_id, int uFirstNode) {
              pCamera3D->vCameraPos.x * pFace->facePlane.normal.x +
              pCamera3D->vCameraPos.y * pFace->facePlane.normal.y +
              pCamera3D->vCameraPos.z * pFace->facePlane.normal.z;  // plane equation
-        if (pFace->isPortal() && pFace->uSectorID != node->uSectorID) v5 = -v5;
+        if (pFace->isPortal() && pFace->uSectorID != uSectorID) v5 = -v5;
 
         if (v5 <= 0)
             v6 = pNode->uFront;
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <array>
+#include <optional>
 
 #include "Engine/Graphics/Camera.h"
+#include "Engine/Graphics/RenderList.h"
 
 #include "Library/Geometry/Plane.h"
 
@@ -19,18 +21,44 @@ struct BspFace {
     int uNodeID = 0;
 };
 
+/**
+ * Everything that the portal traversal in `PrepareBspRenderList_BLV` depends on, except for the level geometry.
+ */
+struct BspRenderCacheKey {
+    int uPartySectorID = 0;
+    glm::vec3 vCameraPos = {};
+    std::array<glm::vec4, 6> FrustumPlanes = {{}};
+    float ViewPlaneDistPixels = 0;
+    int uScreen_TL_X = 0;
+    int uScreen_TL_Y = 0;
+    int uScreen_BR_X = 0;
+    int uScreen_BR_Y = 0;
+    int maxVisibleSectors = 0;
+
+    [[nodiscard]] static BspRenderCacheKey current();
+
+    bool operator==(const BspRenderCacheKey &other) const = default;
+};
+
 struct BspRenderer {
     void AddFaceToRenderList_d3d(int node_id, int uFaceID);
     void MakeVisibleSectorList();
 
-    unsigned int num_faces = 0;
-    std::array<BspFace, 1500> faces = {{}};
+    /**
+     * Makes the next call to `PrepareBspRenderList_BLV` redo the portal traversal. Should be called whenever the
+     * level geometry changes, e.g. when doors move.
+     */
+    void invalidateCache() {
+        cacheKey.reset();
+    }
 
-    unsigned int num_nodes = 0;
-    std::array<BspRenderer_ViewportNode, 150> nodes = {{}};
+    RenderList<BspFace> faces = RenderList<BspFace>(1500);
+    RenderList<BspRenderer_ViewportNode> nodes = RenderList<BspRenderer_ViewportNode>(150);
 
     unsigned int uNumVisibleNotEmptySectors = 0;
     std::array<int, 150> pVisibleSectorIDs_toDrawDecorsActorsEtcFrom = {{}};
+
+    std::optional<BspRenderCacheKey> cacheKey; // Key for the lists above, empty if they need to be rebuilt.
 };
 
 extern BspRenderer *pBspRenderer;
@@ -0,0 +1,98 @@
+#include "Bvh.h"
+
+#include <algorithm>
+#include <numeric>
+
+static constexpr uint32_t MAX_LEAF_SIZE = 4;
+static constexpr int MAX_DEPTH = 48; // Traversal stack is 64 deep, and we push at most one extra node per level.
+
+static float axisValue(const Vec3f &v, int axis) {
+    return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+}
+
+static bool slabIntersects(float origin, float step, float invStep, float min, float max, float *tmin, float *tmax) {
+    if (step == 0)
+        return origin >= min && origin <= max;
+
+    float t1 = (min - origin) * invStep;
+    float t2 = (max - origin) * invStep;
+    if (t1 > t2)
+        std::swap(t1, t2);
+    *tmin = std::max(*tmin, t1);
+    *tmax = std::min(*tmax, t2);
+    return *tmin <= *tmax;
+}
+
+Bvh::Bvh(std::span<const BBoxf> boxes) {
+    if (boxes.empty())
+        return;
+
+    _indices.resize(boxes.size());
+    std::iota(_indices.begin(), _indices.end(), 0);
+
+    _nodes.reserve(2 * (boxes.size() / MAX_LEAF_SIZE + 1));
+    _nodes.emplace_back();
+    build(boxes, 0, 0, boxes.size(), 0);
+}
+
+void Bvh::segmentHits(const Vec3f &origin, const Vec3f &step, std::vector<int> *result) const {
+    result->clear();
+    forEachSegmentHit(origin, step, [&](int index) { result->push_back(index); });
+    std::sort(result->begin(), result->end());
+}
+
+void Bvh::build(std::span<const BBoxf> boxes, uint32_t nodeIndex, uint32_t first, uint32_t count, int depth) {
+    Vec3f center = boxes[_indices[first]].center();
+    BBoxf bounds = boxes[_indices[first]];
+    BBoxf centers = BBoxf::forPoints(center, center);
+    for (uint32_t i = first + 1; i < first + count; i++) {
+        const BBoxf &box = boxes[_indices[i]];
+        center = box.center();
+        bounds = bounds | box;
+        centers = centers | BBoxf::forPoints(center, center);
+    }
+    _nodes[nodeIndex].bounds = bounds;
+
+    if (count <= MAX_LEAF_SIZE || depth >= MAX_DEPTH) {
+        _nodes[nodeIndex].first = first;
+        _nodes[nodeIndex].count = count;
+        return;
+    }
+
+    // Median split along the longest axis of the box centers. This gives a balanced tree, which is good enough for
+    // level geometry, and keeps the build fast.
+    Vec3f extent = centers.size();
+    int axis = 0;
+    if (extent.y > extent.x)
+        axis = 1;
+    if (extent.z > axisValue(extent, axis))
+        axis = 2;
+
+    uint32_t half = count / 2;
+    std::nth_element(_indices.begin() + first, _indices.begin() + first + half, _indices.begin() + first + count,
+                     [&](int l, int r) { return axisValue(boxes[l].center(), axis) < axisValue(boxes[r].center(), axis); });
+
+    uint32_t childIndex = _nodes.size();
+    _nodes[nodeIndex].first = childIndex;
+    _nodes[nodeIndex].count = 0;
+    _nodes.emplace_back();
+    _nodes.emplace_back();
+
+    build(boxes, childIndex, first, half, depth + 1);
+    build(boxes, childIndex + 1, first + half, count - half, depth + 1);
+}
+
+Bvh::Segment::Segment(const Vec3f &origin, const Vec3f &step) : _origin(origin), _step(step) {
+    _invStep.x = step.x == 0 ? 0 : 1.0f / step.x;
+    _invStep.y = step.y == 0 ? 0 : 1.0f / step.y;
+    _invStep.z = step.z == 0 ? 0 : 1.0f / step.z;
+}
+
+bool Bvh::Segment::intersects(const BBoxf &box) const {
+    float tmin = 0.0f;
+    float tmax = 1.0f;
+    return
+        slabIntersects(_origin.x, _step.x, _invStep.x, box.x1, box.x2, &tmin, &tmax) &&
+        slabIntersects(_origin.y, _step.y, _invStep.y, box.y1, box.y2, &tmin, &tmax) &&
+        slabIntersects(_origin.z, _step.z, _invStep.z, box.z1, box.z2, &tmin, &tmax);
+}
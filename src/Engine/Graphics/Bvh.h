@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Library/Geometry/BBox.h"
+#include "Library/Geometry/Vec.h"
+
+/**
+ * Static bounding volume hierarchy over a set of axis-aligned boxes.
+ *
+ * Built once, e.g. when a level is loaded, and then used to quickly find the boxes that a segment passes through,
+ * which is what ray picking and line of sight checks need. Boxes are referred to by their index in the array that
+ * the hierarchy was built from.
+ */
+class Bvh {
+ public:
+    Bvh() = default;
+
+    /**
+     * @param boxes                     Boxes to build the hierarchy for.
+     */
+    explicit Bvh(std::span<const BBoxf> boxes);
+
+    [[nodiscard]] bool empty() const {
+        return _nodes.empty();
+    }
+
+    /**
+     * Calls the provided callback for each of the boxes that intersect the segment `[origin, origin + step]`. Boxes
+     * are visited in no particular order.
+     *
+     * @param origin                    Segment start.
+     * @param step                      Segment direction & length.
+     * @param callback                  Callback to call, takes box index as its only argument.
+     */
+    template<class Callback>
+    void forEachSegmentHit(const Vec3f &origin, const Vec3f &step, Callback &&callback) const {
+        if (_nodes.empty())
+            return;
+
+        Segment segment(origin, step);
+
+        uint32_t stack[64];
+        int stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0) {
+            const Node &node = _nodes[stack[--stackSize]];
+            if (!segment.intersects(node.bounds))
+                continue;
+
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++)
+                    callback(_indices[i]);
+            } else {
+                stack[stackSize++] = node.first;
+                stack[stackSize++] = node.first + 1;
+            }
+        }
+    }
+
+    /**
+     * Same as `forEachSegmentHit`, but collects the box indices into a vector, sorted in ascending order.
+     *
+     * @param origin                    Segment start.
+     * @param step                      Segment direction & length.
+     * @param[out] result               Vector to store the indices in. Previous contents are discarded.
+     */
+    void segmentHits(const Vec3f &origin, const Vec3f &step, std::vector<int> *result) const;
+
+ private:
+    struct Node {
+        BBoxf bounds;
+        uint32_t first = 0; // First child for inner nodes, first index in `_indices` for leaves.
+        uint32_t count = 0; // Zero for inner nodes, number of boxes for leaves.
+    };
+
+    class Segment {
+     public:
+        Segment(const Vec3f &origin, const Vec3f &step);
+
+        [[nodiscard]] bool intersects(const BBoxf &box) const;
+
+     private:
+        Vec3f _origin;
+        Vec3f _step;
+        Vec3f _invStep;
+    };
+
+    void build(std::span<const BBoxf> boxes, uint32_t nodeIndex, uint32_t first, uint32_t count, int depth);
+
+ private:
+    std::vector<Node> _nodes;
+    std::vector<int> _indices;
+};
@@ -1,5 +1,8 @@
 #include "Engine/Graphics/Camera.h"
 
+#include <algorithm>
+#include <bit>
+
 #include "Engine/Engine.h"
 #include "Engine/OurMath.h"
 
@@ -24,7 +27,7 @@ float Camera3D::GetNearClip() const {
 }
 
 float Camera3D::GetFarClip() const {
-    return engine->config->graphics.ClipFarDistance.value();
+    return engine->config->graphics.ClipFarDistance.value() * engine->qualityGovernor.viewDistanceScale();
 }
 
 // ViewTransformAndClipTest
@@ -309,6 +312,19 @@ void Camera3D::BuildViewFrustum() {
     FrustumPlanes[3].w = glm::dot(glm::vec3(FrustumPlanes[3]), vCameraPos);
 }
 
+bool Camera3D::IsBBoxInFrustum(const BBoxf &box) const {
+    for (int p = 0; p < 4; p++) {
+        // test the box corner furthest along the plane normal, if that one is outside then the whole box is
+        float x = FrustumPlanes[p].x >= 0 ? box.x2 : box.x1;
+        float y = FrustumPlanes[p].y >= 0 ? box.y2 : box.y1;
+        float z = FrustumPlanes[p].z >= 0 ? box.z2 : box.z1;
+
+        if (x * FrustumPlanes[p].x + y * FrustumPlanes[p].y + z * FrustumPlanes[p].z < FrustumPlanes[p].w)
+            return false;
+    }
+    return true;
+}
+
 // TODO(pskelton): does this func need to copy verts or could it be eliminated
 //----- (00437285) --------------------------------------------------------
 bool Camera3D::CullFaceToCameraFrustum(RenderVertexSoft *pInVertices,
@@ -409,19 +425,34 @@ bool Camera3D::ClipFaceToFrustum(RenderVertexSoft *pInVertices,
 
     static RenderVertexSoft sr_vertices_50D9D8[64];
 
-    // result = 0;
-    // VertsAdjusted = 0;
     int MinVertsAllowed = 2 * (DebugLines == 0) + 1;  // 3 normally 1 for debuglines
-    // a6a = 0;
-    // v18 = MinVertsAllowed;
     if (NumFrustumPlanes <= 0) return false;
 
-    // v12 = *pOutNumVertices;
-    // v13 = (char *)&a4->y;
+    // Classify against all planes at once first. Clipping only ever produces points inside the planes that the
+    // polygon was already inside of, so the planes that no vertex is outside of can be skipped.
+    uint32_t planeMask = (1u << NumFrustumPlanes) - 1;
+    if (*pOutNumVertices >= MinVertsAllowed) {
+        FrustumClassification classification =
+            ClippingFunctions::ClassifyVertsToFrustum(pInVertices, *pOutNumVertices, CameraFrustrum, NumFrustumPlanes);
+        if (classification.allOutside) {
+            *pOutNumVertices = 0;
+            return true;
+        }
+        if (!classification.anyOutside) {
+            if (pVertices != pInVertices)
+                std::copy_n(pInVertices, *pOutNumVertices, pVertices);
+            return false;
+        }
+        planeMask = classification.anyOutside;
+    }
+
+    int passCount = std::popcount(planeMask);
+    int pass = 0;
+    for (int i = 0; i < NumFrustumPlanes; ++i) {  // cycle through left,right, top, bottom planes
+        if (!(planeMask & (1u << i)))
+            continue;
 
-    // while ( 1 )
-    for (unsigned i = 0; i < NumFrustumPlanes; ++i) {  // cycle through left,right, top, bottom planes
-        if (i % 2) {
+        if (pass % 2) {
             v14 = pInVertices;
             v15 = sr_vertices_50D9D8;
         }  else {
@@ -429,21 +460,16 @@ bool Camera3D::ClipFaceToFrustum(RenderVertexSoft *pInVertices,
             v14 = sr_vertices_50D9D8;
         }
 
-        if (i == NumFrustumPlanes - 1) v14 = pVertices;
+        if (++pass == passCount) v14 = pVertices;
 
         ClippingFunctions::ClipVertsToFrustumPlane(
             v15, *pOutNumVertices, v14, pOutNumVertices, &CameraFrustrum[i].normal, -CameraFrustrum[i].dist,
             (char*)&VertsAdjusted, _unused);
 
-        // v12 = *pOutNumVertices;
         if (*pOutNumVertices < MinVertsAllowed) {
             *pOutNumVertices = 0;
             return true;
         }
-        // result = a6a;
-        // v13 += 24;
-        // if (++i >= FrustumPlanes)
-        //
     }
     return VertsAdjusted;
 }
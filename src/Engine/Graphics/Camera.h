@@ -6,6 +6,7 @@
 
 #include "Engine/Graphics/RenderEntities.h"
 
+#include "Library/Geometry/BBox.h"
 #include "Library/Geometry/Plane.h"
 
 struct Camera3D {
@@ -24,6 +25,15 @@ struct Camera3D {
         RenderVertexSoft *pVertices,
         signed int NumFrustumPlanes);
 
+    /**
+     * Conservative box visibility test against the side planes of the view frustum, as set up by `BuildViewFrustum`.
+     *
+     * @param box                       Axis-aligned box in world coordinates.
+     * @return                          Whether the box is potentially visible, `false` means it's entirely outside
+     *                                  of the view frustum.
+     */
+    [[nodiscard]] bool IsBBoxInFrustum(const BBoxf &box) const;
+
     float GetPolygonMaxZ(struct RenderVertexSoft *pVertex,
                           unsigned int uStripType);
     float GetPolygonMinZ(struct RenderVertexSoft *pVertices,
@@ -1,7 +1,88 @@
 #include "Engine/Graphics/ClippingFunctions.h"
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#   define OE_CLIPPING_SSE2
+#   include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   define OE_CLIPPING_NEON
+#   include <arm_neon.h>
+#endif
+
 #include "Library/Logger/Logger.h"
 
+FrustumClassification ClippingFunctions::ClassifyVertsToFrustum(const RenderVertexSoft *pVertices,
+                                                                unsigned int uNumVertices, const Planef *pPlanes,
+                                                                unsigned int uNumPlanes) {
+    assert(uNumPlanes <= 32);
+
+    FrustumClassification result;
+    result.allOutside = uNumPlanes == 32 ? ~0u : (1u << uNumPlanes) - 1;
+
+    // Planes are processed in groups of four, one SIMD lane per plane. Note that the dot products are calculated
+    // in the same order as in ClipVertsToFrustumPlane, so that the classification matches it exactly.
+    for (unsigned int first = 0; first < uNumPlanes; first += 4) {
+        alignas(16) float nx[4], ny[4], nz[4], bound[4];
+        for (unsigned int i = 0; i < 4; i++) {
+            if (first + i < uNumPlanes) {
+                const Planef &plane = pPlanes[first + i];
+                nx[i] = plane.normal.x;
+                ny[i] = plane.normal.y;
+                nz[i] = plane.normal.z;
+                bound[i] = -plane.dist;
+            } else {
+                nx[i] = ny[i] = nz[i] = 0.0f;
+                bound[i] = -std::numeric_limits<float>::infinity(); // Padding, everything is inside.
+            }
+        }
+
+#if defined(OE_CLIPPING_SSE2)
+        __m128 vnx = _mm_load_ps(nx), vny = _mm_load_ps(ny), vnz = _mm_load_ps(nz), vbound = _mm_load_ps(bound);
+        for (unsigned int v = 0; v < uNumVertices; v++) {
+            const Vec3f &pos = pVertices[v].vWorldPosition;
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vnx, _mm_set1_ps(pos.x)), _mm_mul_ps(_mm_set1_ps(pos.y), vny)),
+                                    _mm_mul_ps(_mm_set1_ps(pos.z), vnz));
+            uint32_t outside = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpnge_ps(dot, vbound))) << first;
+            result.anyOutside |= outside;
+            result.allOutside &= outside | ~(0xFu << first);
+        }
+#elif defined(OE_CLIPPING_NEON)
+        float32x4_t vnx = vld1q_f32(nx), vny = vld1q_f32(ny), vnz = vld1q_f32(nz), vbound = vld1q_f32(bound);
+        const uint32_t laneBitsData[4] = {1, 2, 4, 8};
+        uint32x4_t laneBits = vld1q_u32(laneBitsData);
+        for (unsigned int v = 0; v < uNumVertices; v++) {
+            const Vec3f &pos = pVertices[v].vWorldPosition;
+            float32x4_t dot = vaddq_f32(vaddq_f32(vmulq_n_f32(vnx, pos.x), vmulq_n_f32(vny, pos.y)),
+                                        vmulq_n_f32(vnz, pos.z));
+            uint32x4_t outsideLanes = vmvnq_u32(vcgeq_f32(dot, vbound)); // NaN counts as outside.
+            uint32_t outside = vaddvq_u32(vandq_u32(outsideLanes, laneBits)) << first;
+            result.anyOutside |= outside;
+            result.allOutside &= outside | ~(0xFu << first);
+        }
+#else
+        for (unsigned int v = 0; v < uNumVertices; v++) {
+            const Vec3f &pos = pVertices[v].vWorldPosition;
+            uint32_t outside = 0;
+            for (unsigned int i = 0; i < 4; i++) {
+                float dot = nx[i] * pos.x + pos.y * ny[i] + pos.z * nz[i];
+                if (!(dot >= bound[i]))
+                    outside |= 1u << i;
+            }
+            outside <<= first;
+            result.anyOutside |= outside;
+            result.allOutside &= outside | ~(0xFu << first);
+        }
+#endif
+    }
+
+    if (uNumVertices == 0)
+        result.allOutside = 0;
+    return result;
+}
+
 //----- (00498377) --------------------------------------------------------
 bool ClippingFunctions::ClipVertsToPortal(RenderVertexSoft *pPortalBounding,  // test skipping this
                                           unsigned int uNumfrust,
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "Engine/Graphics/RenderEntities.h"
 
 #include "Library/Geometry/Plane.h"
@@ -10,7 +12,29 @@ struct VertexBuffer {
     int uNumVertices;
 };
 
+/**
+ * Result of classifying polygon vertices against a set of frustum planes. Bit `i` in the masks corresponds to the
+ * `i`-th plane.
+ */
+struct FrustumClassification {
+    uint32_t anyOutside = 0; // Planes that at least one of the vertices is outside of.
+    uint32_t allOutside = 0; // Planes that all of the vertices are outside of.
+};
+
 struct ClippingFunctions {
+    /**
+     * Classifies polygon vertices against frustum planes, all planes at once. Vertex is inside a plane if
+     * `dot(pos, normal) >= -dist`, same as in `ClipVertsToFrustumPlane`.
+     *
+     * @param pVertices                 Polygon vertices.
+     * @param uNumVertices              Number of vertices.
+     * @param pPlanes                   Frustum planes.
+     * @param uNumPlanes                Number of planes, at most 32.
+     * @return                          Vertex classification.
+     */
+    static FrustumClassification ClassifyVertsToFrustum(const RenderVertexSoft *pVertices, unsigned int uNumVertices,
+                                                        const Planef *pPlanes, unsigned int uNumPlanes);
+
     static bool ClipVertsToFace(RenderVertexSoft *a1, unsigned int uNumVertices, float a3, float a4, float a5,
                                 RenderVertexSoft *pOutVertices, signed int *pOutNumVertices);
 
@@ -1,7 +1,9 @@
 #include "Collisions.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <span>
 #include <utility>
 
 #include "Engine/Events/Processor.h"
@@ -10,12 +12,18 @@
 #include "Engine/Graphics/Outdoor.h"
 #include "Engine/Graphics/Indoor.h"
 #include "Engine/Objects/Actor.h"
+#include "Engine/Objects/ActorSpatialHash.h"
 #include "Engine/Objects/ObjectList.h"
 #include "Engine/Objects/SpriteObject.h"
+#include "Engine/Objects/SpriteObjectSpatialHash.h"
 #include "Engine/TurnEngine/TurnEngine.h"
 #include "Engine/OurMath.h"
 #include "Engine/Party.h"
 #include "Engine/Engine.h"
+#include "Engine/EngineCounters.h"
+#include "Engine/SubsystemTimers.h"
+
+#include "Library/Profiler/Profiler.h"
 
 #include "Utility/Math/Float.h"
 #include "Utility/Math/TrigLut.h"
@@ -267,6 +275,8 @@ static bool CollidePointWithFace(BLVFace *face, const Vec3f &pos, const Vec3f &d
  * @param model_idx                     Model index, or `MODEL_INDOOR`.
 */
 static void CollideBodyWithFace(BLVFace *face, Pid face_pid, bool ignore_ethereal, int model_idx) {
+    engineCounters.collisionFaceTests.fetch_add(1, std::memory_order_relaxed);
+
     auto collide_once = [&](const Vec3f &old_pos, const Vec3f &new_pos, const Vec3f &dir, int radius) {
         float distance_old = face->facePlane.signedDistanceTo(old_pos);
         float distance_new = face->facePlane.signedDistanceTo(new_pos);
@@ -416,16 +426,15 @@ void CollideIndoorWithGeometry(bool ignore_ethereal) {
     }
 
     for (int i = 0; i < totalSectors; i++) {
-        pSector = &pIndoor->pSectors[pSectorsArray[i]];
-
-        int totalFaces = pSector->uNumFloors + pSector->uNumWalls + pSector->uNumCeilings;
-        for (int j = 0; j < totalFaces; j++) {
-            BLVFace *face = &pIndoor->pFaces[pSector->pFloors[j]];
-            if (face->isPortal() || !collision_state.bbox.intersects(face->pBounding))
+        std::span<const int> faceIds = pIndoor->sectorCollisionFaces.faceIds(pSectorsArray[i]);
+        std::span<const BBoxi> faceBounds = pIndoor->sectorCollisionFaces.faceBounds(pSectorsArray[i]);
+        for (size_t j = 0; j < faceIds.size(); j++) {
+            if (!collision_state.bbox.intersects(faceBounds[j]))
                 continue;
 
-            int face_id = pSector->pFloors[j];
-            if (face_id == collision_state.ignored_face_id)
+            int face_id = faceIds[j];
+            BLVFace *face = &pIndoor->pFaces[face_id];
+            if (face->isPortal() || face_id == collision_state.ignored_face_id)
                 continue;
 
             CollideBodyWithFace(face, Pid(OBJECT_Face, face_id), ignore_ethereal, MODEL_INDOOR);
@@ -434,31 +443,31 @@ void CollideIndoorWithGeometry(bool ignore_ethereal) {
 }
 
 void CollideOutdoorWithModels(bool ignore_ethereal) {
-    for (BSPModel &model : pOutdoor->pBModels) {
+    for (ModelFaceGrid::FaceId id : pOutdoor->modelFaceGrid.query(collision_state.bbox)) {
+        BSPModel &model = pOutdoor->pBModels[id.model];
         if (!collision_state.bbox.intersects(model.pBoundingBox))
             continue;
 
-        for (ODMFace &mface : model.pFaces) {
-            if (!collision_state.bbox.intersects(mface.pBoundingBox))
-                continue;
+        ODMFace &mface = model.pFaces[id.face];
+        if (!collision_state.bbox.intersects(mface.pBoundingBox))
+            continue;
 
-            // TODO: we should really either merge two face classes, or template the functions down the chain call here.
-            BLVFace face;
-            face.facePlane = mface.facePlane;
-            face.uAttributes = mface.uAttributes;
-            face.pBounding = mface.pBoundingBox;
-            face.zCalc = mface.zCalc;
-            face.uPolygonType = mface.uPolygonType;
-            face.uNumVertices = mface.uNumVertices;
-            face.resource = mface.resource;
-            face.pVertexIDs = mface.pVertexIDs.data();
-
-            if (face.Ethereal() || face.isPortal()) // TODO: this doesn't respect ignore_ethereal parameter
-                continue;
+        // TODO: we should really either merge two face classes, or template the functions down the chain call here.
+        BLVFace face;
+        face.facePlane = mface.facePlane;
+        face.uAttributes = mface.uAttributes;
+        face.pBounding = mface.pBoundingBox;
+        face.zCalc = mface.zCalc;
+        face.uPolygonType = mface.uPolygonType;
+        face.uNumVertices = mface.uNumVertices;
+        face.resource = mface.resource;
+        face.pVertexIDs = mface.pVertexIDs.data();
+
+        if (face.Ethereal() || face.isPortal()) // TODO: this doesn't respect ignore_ethereal parameter
+            continue;
 
-            Pid pid = Pid::odmFace(model.index, mface.index);
-            CollideBodyWithFace(&face, pid, ignore_ethereal, model.index);
-        }
+        Pid pid = Pid::odmFace(model.index, mface.index);
+        CollideBodyWithFace(&face, pid, ignore_ethereal, model.index);
     }
 }
 
@@ -533,8 +542,22 @@ bool CollideWithActor(int actor_idx, int override_radius) {
     return CollideWithCylinder(actor->pos.toFloat(), radius, actor->height, Pid(OBJECT_Actor, actor_idx), true);
 }
 
+std::vector<int> actorsNearCollisionBox(int maxRadius) {
+    if (maxRadius < 0)
+        maxRadius = actorSpatialHash.maxActorRadius();
+
+    const BBoxf &bbox = collision_state.bbox;
+    float halfSize = std::max(bbox.x2 - bbox.x1, bbox.y2 - bbox.y1) / 2;
+    return actorSpatialHash.query(bbox.center().toInt(), std::ceil(halfSize) + 1 + maxRadius);
+}
+
 void _46ED8A_collide_against_sprite_objects(Pid pid) {
-    for (unsigned i = 0; i < pSpriteObjects.size(); ++i) {
+    // Objects are only checked if their bounding box intersects the collision box, so the hash can't skip anything
+    // that this loop would have collided with.
+    const BBoxf &collisionBox = collision_state.bbox;
+    float halfSize = std::max(collisionBox.x2 - collisionBox.x1, collisionBox.y2 - collisionBox.y1) / 2;
+    int queryRadius = std::ceil(halfSize) + 1 + spriteObjectSpatialHash.maxObjectRadius();
+    for (int i : spriteObjectSpatialHash.query(collisionBox.center().toInt(), queryRadius)) {
         if (pSpriteObjects[i].uObjectDescID == 0)
             continue;
 
@@ -577,6 +600,9 @@ void CollideWithParty(bool jagged_top) {
 }
 
 void ProcessActorCollisionsBLV(Actor &actor, bool isAboveGround, bool isFlying) {
+    SubsystemTimerScope timer(SUBSYSTEM_COLLISIONS);
+    OE_PROFILE_ZONE("collisions");
+
     collision_state.ignored_face_id = -1;
     collision_state.total_move_distance = 0;
     collision_state.check_hi = true;
@@ -712,7 +738,10 @@ void ProcessActorCollisionsBLV(Actor &actor, bool isAboveGround, bool isFlying)
     }
 }
 
-void ProcessActorCollisionsODM(Actor &actor, bool isFlying) {
+void ProcessActorCollisionsODM(Actor &actor, bool isFlying, Duration dt) {
+    SubsystemTimerScope timer(SUBSYSTEM_COLLISIONS);
+    OE_PROFILE_ZONE("collisions");
+
     int actorRadius = !isFlying ? 40 : actor.radius;
 
     collision_state.ignored_face_id = -1;
@@ -727,7 +756,7 @@ void ProcessActorCollisionsODM(Actor &actor, bool isFlying) {
         collision_state.position_hi.z = std::max(collision_state.position_hi.z, collision_state.position_lo.z);
         collision_state.velocity = actor.speed.toFloat();
         collision_state.uSectorID = 0;
-        if (collision_state.PrepareAndCheckIfStationary())
+        if (collision_state.PrepareAndCheckIfStationary(dt))
             break;
 
         CollideOutdoorWithModels(true);
@@ -836,8 +865,14 @@ void ProcessActorCollisionsODM(Actor &actor, bool isFlying) {
 }
 
 void ProcessPartyCollisionsBLV(int sectorId, int min_party_move_delta_sqr, int *faceId, int *faceEvent) {
+    SubsystemTimerScope timer(SUBSYSTEM_COLLISIONS);
+    OE_PROFILE_ZONE("collisions");
+
     constexpr float closestdist = 0.5f; // Closest allowed approach to collision surface - needs adjusting
 
+    // Actors don't move while the party is moving.
+    actorSpatialHash.sync();
+
     collision_state.ignored_face_id = -1;
     collision_state.total_move_distance = 0;
     collision_state.radius_lo = pParty->radius;
@@ -862,7 +897,7 @@ void ProcessPartyCollisionsBLV(int sectorId, int min_party_move_delta_sqr, int *
             // TODO(captainurist): why there is no call to _46ED8A_collide_against_sprite_objects?
             //                     See ProcessPartyCollisionsODM.
             if (!engine->config->gameplay.NoPartyActorCollisions.value()) {
-                for (int k = 0; k < pActors.size(); ++k)
+                for (int k : actorsNearCollisionBox())
                     CollideWithActor(k, 0);
             }
             if (CollideIndoorWithPortals())
@@ -969,8 +1004,15 @@ void ProcessPartyCollisionsBLV(int sectorId, int min_party_move_delta_sqr, int *
 }
 
 void ProcessPartyCollisionsODM(Vec3f *partyNewPos, Vec3f *partyInputSpeed, bool *partyIsOnWater, int *floorFaceId, bool *partyNotOnModel, bool *partyHasHitModel, int *triggerID) {
+    SubsystemTimerScope timer(SUBSYSTEM_COLLISIONS);
+    OE_PROFILE_ZONE("collisions");
+
     constexpr float closestdist = 0.5f;  // Closest allowed approach to collision surface - needs adjusting
 
+    // Neither actors nor sprite objects move while the party is moving.
+    actorSpatialHash.sync();
+    spriteObjectSpatialHash.sync();
+
     // --(Collisions)-------------------------------------------------------------------
     collision_state.ignored_face_id = -1;
     collision_state.total_move_distance = 0;
@@ -996,7 +1038,7 @@ void ProcessPartyCollisionsODM(Vec3f *partyNewPos, Vec3f *partyInputSpeed, bool
         CollideOutdoorWithDecorations(WorldPosToGridCellX(pParty->pos.x), WorldPosToGridCellY(pParty->pos.y));
         _46ED8A_collide_against_sprite_objects(Pid::character(0));
         if (!engine->config->gameplay.NoPartyActorCollisions.value()) {
-            for (size_t actor_id = 0; actor_id < pActors.size(); ++actor_id)
+            for (int actor_id : actorsNearCollisionBox())
                 CollideWithActor(actor_id, 0);
         }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "Engine/Pid.h"
 #include "Engine/Time/Duration.h"
 
@@ -95,6 +97,13 @@ bool CollideIndoorWithPortals();
  */
 bool CollideWithActor(int actor_idx, int override_radius);
 
+/**
+ * @param maxRadius                     Max collision radius that will be passed to `CollideWithActor`, or -1 if actors
+ *                                      will use their own radius.
+ * @return                              Ids of the actors that the body that's being moved in `collision_state` might
+ *                                      collide with, in ascending order. Expects `actorSpatialHash` to be up to date.
+ */
+std::vector<int> actorsNearCollisionBox(int maxRadius = -1);
 
 void _46ED8A_collide_against_sprite_objects(Pid pid);
 
@@ -117,7 +126,14 @@ void CollideWithParty(bool jagged_top);
  */
 void ProcessActorCollisionsBLV(Actor &actor, bool isAboveGround, bool isFlying);
 
-void ProcessActorCollisionsODM(Actor &actor, bool isFlying);
+/**
+ * Outdoor version of `ProcessActorCollisionsBLV`.
+ *
+ * @param actor                     Actor to move.
+ * @param isFlying                  Whether the actor is a flying creature that can fly (e.g. not paralyzed).
+ * @param dt                        Time step to move the actor by, zero means the current frame's `dt`.
+ */
+void ProcessActorCollisionsODM(Actor &actor, bool isFlying, Duration dt = 0_ticks);
 
 void ProcessPartyCollisionsBLV(int sectorId, int min_party_move_delta_sqr, int *faceId, int *faceEvent);
 
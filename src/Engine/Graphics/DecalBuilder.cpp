@@ -62,7 +62,7 @@ void DecalBuilder::Reset(bool bPreserveBloodsplats) {
 
 //----- (0049B540) --------------------------------------------------------
 char DecalBuilder::BuildAndApplyDecals(int light_level, LocationFlags locationFlags, const Planef &FacePlane, int NumFaceVerts,
-                                       RenderVertexSoft *FaceVerts, char ClipFlags, int uSectorID) {
+                                       RenderVertexSoft *FaceVerts, char ClipFlags, int uSectorID, int uFaceID) {
     if (!NumFaceVerts) return 0;
 
     static stru314 static_FacePlane;
@@ -84,7 +84,7 @@ char DecalBuilder::BuildAndApplyDecals(int light_level, LocationFlags locationFl
                 buildsplat->radius,
                 buildsplat->color,
                 buildsplat->faceDist,
-                &static_FacePlane, NumFaceVerts, FaceVerts, ClipFlags))
+                &static_FacePlane, NumFaceVerts, FaceVerts, ClipFlags, uFaceID))
                 logger->warning("Error: Failed to build decal geometry");
         }
     }
@@ -95,7 +95,7 @@ char DecalBuilder::BuildAndApplyDecals(int light_level, LocationFlags locationFl
 bool DecalBuilder::Build_Decal_Geometry(
     int LightLevel, LocationFlags locationFlags, Bloodsplat *blood, float DecalRadius,
     Color uColorMultiplier, float DecalDotDist, stru314 *FacetNormals, signed int numfaceverts,
-    RenderVertexSoft *faceverts, char uClipFlags) {
+    RenderVertexSoft *faceverts, char uClipFlags, int uFaceID) {
 
     if (DecalRadius == 0.0f) return 1;
     Decal *decal = &this->Decals[this->DecalsCount];
@@ -175,6 +175,8 @@ bool DecalBuilder::Build_Decal_Geometry(
         if (!decal->uNumVertices) return 1;
 
         // otherwise keep this decal
+        decal->uid = ++this->uLastDecalUid;
+        decal->uFaceID = uFaceID;
         this->DecalsCount++;
         if (this->DecalsCount == 1024) this->DecalsCount = 0;
         return 1;
@@ -183,6 +185,16 @@ bool DecalBuilder::Build_Decal_Geometry(
     return result;
 }
 
+void DecalBuilder::RemoveFaceDecals(int uFaceID) {
+    for (unsigned i = 0; i < DecalsCount;) {
+        if (Decals[i].uFaceID == uFaceID) {
+            Decals[i] = Decals[--DecalsCount];
+        } else {
+            ++i;
+        }
+    }
+}
+
 //----- (0049BBBD) --------------------------------------------------------
 bool DecalBuilder::ApplyBloodsplatDecals_IndoorFace(int uFaceID) {
     // reset splat count
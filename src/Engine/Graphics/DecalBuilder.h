@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 
 #include "Engine/Graphics/RenderEntities.h"
 #include "Engine/Tables/TileEnums.h"
@@ -69,6 +70,9 @@ struct Decal {
 
     Duration fadetime;
     DecalFlags decal_flags;
+
+    uint64_t uid = 0; // Unique id of the decal geometry, renderers use it to cache the geometry on the GPU side.
+    int uFaceID = -1; // Indoor face the decal was applied to, -1 if outdoors.
 };
 
 // contains all of above
@@ -79,11 +83,19 @@ struct DecalBuilder {
     void AddBloodsplat(const Vec3f &pos, Color color, float radius);
     void Reset(bool bPreserveBloodsplats);
     char BuildAndApplyDecals(int light_level, LocationFlags locationFlags, const Planef &FacePlane, int NumFaceVerts,
-                             RenderVertexSoft *FaceVerts, char ClipFlags, int uSectorID);
+                             RenderVertexSoft *FaceVerts, char ClipFlags, int uSectorID, int uFaceID = -1);
     bool Build_Decal_Geometry(
         int LightLevel, LocationFlags locationFlags, Bloodsplat *blood, float DecalRadius,
         Color uColorMultiplier, float DecalDotDist, struct stru314 *FacetNormals, int numfaceverts,
-        RenderVertexSoft *faceverts, char uClipFlags);
+        RenderVertexSoft *faceverts, char uClipFlags, int uFaceID);
+
+    /**
+     * Removes all decals that were applied to the provided indoor face. Decals are clipped to their faces when they
+     * are created, so this needs to be called when a face moves (e.g. when it's a part of a door).
+     *
+     * @param uFaceID                       Indoor face id.
+     */
+    void RemoveFaceDecals(int uFaceID);
     bool ApplyBloodsplatDecals_IndoorFace(int uFaceID);
     bool ApplyBloodSplat_OutdoorFace(ODMFace *pFace);
 
@@ -108,6 +120,7 @@ struct DecalBuilder {
 
     std::array<Decal, 1024> Decals;  // actual decal geom store
     unsigned int DecalsCount;  // number of decals
+    uint64_t uLastDecalUid = 0;  // last uid handed out to a decal
 
     // for building decal geom
     int uNumSplatsThisFace = 0;  // numeber of bloodsplats that overlap this face
@@ -19,14 +19,21 @@ uint16_t DecorationList::GetDecorIdByName(std::string_view pName) {
     if (pName.empty())
         return 0;
 
-    if (pDecorations.size() > 1) {
-        for (unsigned uID = 1; uID < pDecorations.size(); ++uID) {
-            if (iequals(pName, pDecorations[uID].name))
-                return uID;
-        }
-    }
+    if (_indexedSize != pDecorations.size())
+        buildNameIndex();
+
+    auto pos = _idByName.find(pName);
+    return pos == _idByName.end() ? 0 : pos->second;
+}
+
+void DecorationList::buildNameIndex() {
+    _idByName.clear();
+    _idByName.reserve(pDecorations.size());
 
-    return 0;
+    // Decoration 0 is never returned. For duplicate names the first decoration wins.
+    for (size_t uID = 1; uID < pDecorations.size(); ++uID)
+        _idByName.try_emplace(pDecorations[uID].name, static_cast<uint16_t>(uID));
+    _indexedSize = pDecorations.size();
 }
 
 void RespawnGlobalDecorations() {
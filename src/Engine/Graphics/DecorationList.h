@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "Media/Audio/SoundEnums.h"
 
@@ -10,6 +12,7 @@
 
 #include "Utility/Flags.h"
 #include "Utility/Memory/Blob.h"
+#include "Utility/String.h"
 
 enum class DecorationDescFlag : uint16_t {
     DECORATION_DESC_MOVE_THROUGH = 0x0001,
@@ -59,12 +62,22 @@ class DecorationList {
     void InitializeDecorationSprite(unsigned int uDecID);
     uint16_t GetDecorIdByName(std::string_view pName);
 
+    /**
+     * Rebuilds the name index used by `GetDecorIdByName`. Called after the list is loaded, and also lazily if the
+     * size of `pDecorations` has changed since.
+     */
+    void buildNameIndex();
+
     const DecorationDesc *GetDecoration(unsigned int index) const {
         return &pDecorations[index];
     }
 
  public:
     std::vector<DecorationDesc> pDecorations;
+
+ private:
+    size_t _indexedSize = 0;
+    std::unordered_map<std::string, uint16_t, IHash, IEqual> _idByName;
 };
 
 extern class DecorationList *pDecorationList;
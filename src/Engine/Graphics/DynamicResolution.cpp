@@ -0,0 +1,71 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr float SMOOTHING = 0.1f;
+static constexpr float UPPER_BAND = 1.05f; // Scale down once over 105% of the target frame time.
+static constexpr float LOWER_BAND = 0.85f; // Scale up once under 85%.
+static constexpr float MAX_SCALE_JUMP = 0.25f;
+static constexpr float MIN_SCALABLE_BUDGET = 0.1f; // As a fraction of the target frame time.
+static constexpr int SETTLE_FRAMES = 4; // GPU timings are read back with a delay of a few frames.
+static constexpr int PROBE_FRAMES = 180;
+
+void DynamicResolution::reset() {
+    _scale = 1.0f;
+    _scalableMs = 0.0f;
+    _fixedMs = 0.0f;
+    _settleFrames = SETTLE_FRAMES;
+    _stableFrames = 0;
+}
+
+void DynamicResolution::setTarget(int targetFps, float minScale, bool probeUp) {
+    float targetMs = targetFps > 0 ? 1000.0f / targetFps : 0.0f;
+    if (targetMs == _targetMs && minScale == _minScale && probeUp == _probeUp)
+        return;
+
+    _targetMs = targetMs;
+    _minScale = std::clamp(minScale, SCALE_STEP, 1.0f);
+    _probeUp = probeUp;
+    reset();
+}
+
+float DynamicResolution::update(float scalableMs, float fixedMs) {
+    if (!isEnabled())
+        return _scale;
+
+    if (_settleFrames > 0) {
+        _settleFrames--;
+        _scalableMs = scalableMs;
+        _fixedMs = fixedMs;
+        return _scale;
+    }
+
+    _scalableMs += (scalableMs - _scalableMs) * SMOOTHING;
+    _fixedMs += (fixedMs - _fixedMs) * SMOOTHING;
+
+    float totalMs = _scalableMs + _fixedMs;
+    if (totalMs > _targetMs * UPPER_BAND || (totalMs < _targetMs * LOWER_BAND && _scale < 1.0f)) {
+        _stableFrames = 0;
+
+        float budgetMs = std::max(_targetMs - _fixedMs, _targetMs * MIN_SCALABLE_BUDGET);
+        float scale = _scale * std::sqrt(budgetMs / std::max(_scalableMs, 0.01f));
+        changeScale(std::clamp(scale, _scale - MAX_SCALE_JUMP, _scale + MAX_SCALE_JUMP));
+    } else if (_probeUp && _scale < 1.0f && ++_stableFrames >= PROBE_FRAMES) {
+        _stableFrames = 0;
+        changeScale(_scale + SCALE_STEP);
+    }
+
+    return _scale;
+}
+
+void DynamicResolution::changeScale(float scale) {
+    // Rounding down makes sure that scaling down always takes at least one step, and that scaling up doesn't
+    // overshoot the prediction.
+    scale = std::clamp(std::floor(scale / SCALE_STEP + 0.001f) * SCALE_STEP, _minScale, 1.0f);
+    if (scale == _scale)
+        return;
+
+    _scale = scale;
+    _settleFrames = SETTLE_FRAMES;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * Controller for the render scale of the 3D view, adjusts the scale from frame time feedback to hold a target
+ * frame rate.
+ *
+ * Frame time is split into a part that scales with the number of rendered pixels (3D passes) and a fixed part (UI).
+ * The controller assumes that the scalable part is proportional to the pixel count, i.e. to the square of the scale,
+ * and jumps straight to the scale that's expected to hit the target. Jumps are limited in size, and the scale is
+ * only changed once the smoothed frame time leaves a band around the target, so it doesn't oscillate on noisy
+ * input.
+ *
+ * If the feedback can't go below the target (e.g. it's wall-clock time with vsync on), set `probeUp` to make the
+ * controller periodically try a higher scale while the frame time is on target.
+ */
+class DynamicResolution {
+ public:
+    static constexpr float SCALE_STEP = 1.0f / 16.0f; // Scales are quantized to this step.
+
+    DynamicResolution() = default;
+
+    /**
+     * Resets the controller back to full scale. Settings are preserved.
+     */
+    void reset();
+
+    /**
+     * @param targetFps                 Target frame rate, zero disables scaling.
+     * @param minScale                  Minimal render scale, in `(0, 1]`.
+     * @param probeUp                   Whether the controller should periodically probe for a higher scale, see
+     *                                  class description.
+     */
+    void setTarget(int targetFps, float minScale, bool probeUp);
+
+    /**
+     * Feeds the timings of a frame that was rendered at the current scale into the controller.
+     *
+     * @param scalableMs                Time spent on the work that scales with resolution, in milliseconds.
+     * @param fixedMs                   Time spent on everything else, in milliseconds.
+     * @return                          New render scale.
+     */
+    float update(float scalableMs, float fixedMs);
+
+    [[nodiscard]] float scale() const {
+        return _scale;
+    }
+
+    [[nodiscard]] bool isEnabled() const {
+        return _targetMs > 0.0f;
+    }
+
+ private:
+    void changeScale(float scale);
+
+ private:
+    float _targetMs = 0.0f;
+    float _minScale = 1.0f;
+    bool _probeUp = false;
+    float _scale = 1.0f;
+    float _scalableMs = 0.0f; // Smoothed timings.
+    float _fixedMs = 0.0f;
+    int _settleFrames = 0; // Frames left to skip after a scale change, until the feedback catches up.
+    int _stableFrames = 0; // Frames spent on target in a row.
+};
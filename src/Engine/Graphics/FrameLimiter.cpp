@@ -1,11 +1,24 @@
 #include "FrameLimiter.h"
 
+#include <algorithm>
+#include <cassert>
 #include <chrono>
+#include <cmath>
+#include <thread>
+
+// Sleeps shorter than this are not worth it, we just spin.
+static constexpr int64_t MIN_SLEEP_NS = 500'000;
+
+// Minimal time left for spinning, in case the oversleep estimate is too optimistic.
+static constexpr int64_t MIN_SPIN_NS = 200'000;
+
+// Moving average of oversleep is updated as `avg += (sample - avg) / OVERSLEEP_SMOOTHING`.
+static constexpr int64_t OVERSLEEP_SMOOTHING = 16;
 
 static int64_t nowNs() {
     // We're going through std::chrono here and not through Platform because we need actual clock time, not
     // "simulation time".
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
 FrameLimiter::FrameLimiter() {
@@ -14,15 +27,52 @@ FrameLimiter::FrameLimiter() {
 
 void FrameLimiter::reset() {
     _lastFrameTimeNs = nowNs();
+    _frameCount = 0;
+    _histogram.fill(0);
 }
 
 void FrameLimiter::tick(int targetFps) {
+    assert(targetFps > 0);
+
     int64_t targetDeltaNs = 1'000'000'000 / targetFps;
+    int64_t deadlineNs = _lastFrameTimeNs + targetDeltaNs;
+    int64_t currentTimeNs = nowNs();
+
+    // Sleep through most of the wait. Leave twice the average oversleep for spinning, sleeps overshoot by more than
+    // the average quite often.
+    int64_t sleepNs = deadlineNs - currentTimeNs - std::max(MIN_SPIN_NS, 2 * _oversleepNs);
+    if (sleepNs >= MIN_SLEEP_NS) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(sleepNs));
+
+        int64_t wakeTimeNs = nowNs();
+        int64_t oversleepNs = std::max<int64_t>(0, wakeTimeNs - currentTimeNs - sleepNs);
+        _oversleepNs += (oversleepNs - _oversleepNs) / OVERSLEEP_SMOOTHING;
+        currentTimeNs = wakeTimeNs;
+    }
 
-    int64_t currentTimeNs;
-    do {
+    // Spin out the rest.
+    while (currentTimeNs < deadlineNs)
         currentTimeNs = nowNs();
-    } while (currentTimeNs - _lastFrameTimeNs < targetDeltaNs);
+
+    int64_t frameTimeNs = currentTimeNs - _lastFrameTimeNs;
+    _histogram[std::min<int64_t>(frameTimeNs / HISTOGRAM_BUCKET_NS, HISTOGRAM_BUCKET_COUNT - 1)]++;
+    _frameCount++;
 
     _lastFrameTimeNs = currentTimeNs;
 }
+
+float FrameLimiter::frameTimePercentileMs(float percentile) const {
+    if (_frameCount == 0)
+        return 0.0f;
+
+    int64_t threshold = std::clamp<int64_t>(std::ceil(percentile * _frameCount), 1, _frameCount);
+    int64_t count = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKET_COUNT; i++) {
+        count += _histogram[i];
+        if (count >= threshold)
+            return (i + 1) * HISTOGRAM_BUCKET_NS / 1'000'000.0f;
+    }
+
+    assert(false); // Should never get here, bucket counts sum up to _frameCount.
+    return 0.0f;
+}
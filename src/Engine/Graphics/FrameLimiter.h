@@ -1,15 +1,62 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 
+/**
+ * Frame limiter that paces frames with a hybrid of sleeping & spinning.
+ *
+ * OS sleeps are coarse and tend to overshoot, so the limiter sleeps only until shortly before the deadline, and then
+ * spins out the rest. The time left for spinning is calibrated from a moving average of how much the sleeps
+ * overshoot, so on systems with precise sleeps the limiter spins very little.
+ *
+ * The limiter also collects a histogram of the resulting frame times.
+ */
 class FrameLimiter {
  public:
+    static constexpr int64_t HISTOGRAM_BUCKET_NS = 500'000;
+    static constexpr int HISTOGRAM_BUCKET_COUNT = 100; // Last bucket also collects all the longer frames.
+
+    using Histogram = std::array<int64_t, HISTOGRAM_BUCKET_COUNT>;
+
     FrameLimiter();
 
+    /**
+     * Restarts frame timing & clears the frame time histogram. Oversleep calibration is preserved.
+     */
     void reset();
 
     void tick(int targetFps);
 
+    /**
+     * @return                          Frame time histogram, bucket `i` holds the number of frames that took
+     *                                  `[i * HISTOGRAM_BUCKET_NS, (i + 1) * HISTOGRAM_BUCKET_NS)` nanoseconds.
+     */
+    [[nodiscard]] const Histogram &histogram() const {
+        return _histogram;
+    }
+
+    [[nodiscard]] int64_t frameCount() const {
+        return _frameCount;
+    }
+
+    /**
+     * @param percentile                Percentile to look up, in `[0, 1]`.
+     * @return                          Upper bound of the histogram bucket that the given frame time percentile
+     *                                  falls into, in milliseconds. Zero if no frames were recorded yet.
+     */
+    [[nodiscard]] float frameTimePercentileMs(float percentile) const;
+
+    /**
+     * @return                          Current estimate of how much the OS sleeps overshoot, in nanoseconds.
+     */
+    [[nodiscard]] int64_t oversleepNs() const {
+        return _oversleepNs;
+    }
+
  private:
     int64_t _lastFrameTimeNs = 0;
+    int64_t _oversleepNs = 1'000'000; // Pessimistic initial estimate, converges over the first few frames.
+    int64_t _frameCount = 0;
+    Histogram _histogram = {{}};
 };
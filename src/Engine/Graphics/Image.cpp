@@ -7,6 +7,10 @@
 #include "Engine/Graphics/Renderer/Renderer.h"
 #include "Engine/AssetsManager.h"
 
+#include "Library/Image/ImageFunctions.h"
+
+#include "Utility/Memory/MemoryAccounting.h"
+
 GraphicsImage::GraphicsImage(bool lazy_initialization): _lazyInitialization(lazy_initialization) {}
 
 GraphicsImage::~GraphicsImage() = default;
@@ -31,19 +35,24 @@ GraphicsImage *GraphicsImage::Create(std::unique_ptr<ImageLoader> loader) {
 }
 
 ssize_t GraphicsImage::width() {
-    return rgba().width();
+    return size().w;
 }
 
 ssize_t GraphicsImage::height() {
-    return rgba().height();
+    return size().h;
 }
 
 Sizei GraphicsImage::size() {
-    return rgba().size();
+    LoadImageData();
+    return _rgbaImage ? _rgbaImage.size() : _indexedImage.size();
 }
 
 RgbaImage &GraphicsImage::rgba() {
     LoadImageData();
+    if (isRgbaDeferred()) {
+        MemoryTagScope memoryScope(MEMORY_TAG_ASSETS);
+        _rgbaImage = makeRgbaImage(_indexedImage, _palette);
+    }
     return _rgbaImage;
 }
 
@@ -57,6 +66,11 @@ const GrayscaleImage &GraphicsImage::indexed() {
     return _indexedImage;
 }
 
+bool GraphicsImage::isIndexedOnly() {
+    LoadImageData();
+    return !_rgbaImage && _indexedImage && !(_loader && _loader->isRgbaDeferred());
+}
+
 std::string *GraphicsImage::GetName() {
     assert(_loader);
 
@@ -76,15 +90,50 @@ void GraphicsImage::Release() {
 }
 
 [[nodiscard]] TextureRenderId GraphicsImage::renderId(bool load) {
-    if (load) {
-        LoadImageData();
-        if (!_renderId)
-            _renderId = render->CreateTexture(_rgbaImage);
-    }
+    if (load)
+        upload();
 
     return _renderId;
 }
 
+void GraphicsImage::upload() {
+    LoadImageData();
+    if (!_renderId)
+        createRenderId();
+}
+
+bool GraphicsImage::unload() {
+    if (!_loader || !_initialized)
+        return false;
+
+    releaseRenderId();
+    _rgbaImage = RgbaImage();
+    _indexedImage = GrayscaleImage();
+    _initialized = false;
+    return true;
+}
+
+void GraphicsImage::prefetch(ThreadPool *pool) {
+    if (!_initialized && _loader)
+        _loader->prefetch(pool);
+}
+
+bool GraphicsImage::isPrefetching() const {
+    return !_initialized && _loader && _loader->isPrefetching();
+}
+
+size_t GraphicsImage::memorySize() const {
+    return _rgbaImage.pixels().size_bytes() + _indexedImage.pixels().size_bytes();
+}
+
+size_t GraphicsImage::gpuMemorySize() const {
+    if (!_renderId)
+        return 0;
+    if (isRgbaDeferred())
+        return _indexedImage.pixels().size() * sizeof(Color);
+    return _rgbaImage ? _rgbaImage.pixels().size_bytes() : _indexedImage.pixels().size_bytes();
+}
+
 void GraphicsImage::releaseRenderId() {
     if (!_renderId)
         return;
@@ -94,14 +143,31 @@ void GraphicsImage::releaseRenderId() {
 }
 
 bool GraphicsImage::LoadImageData() {
+    _lastUseFrame = assets->frameIndex();
+
     if (_initialized)
         return true;
 
+    MemoryTagScope memoryScope(MEMORY_TAG_ASSETS);
     _initialized = _loader->Load(&_rgbaImage, &_indexedImage, &_palette);
     // TODO(captainurist): _initialized == false happens, investigate
 
     if (_initialized)
-        _renderId = render->CreateTexture(_rgbaImage);
+        createRenderId();
 
     return _initialized;
 }
+
+bool GraphicsImage::isRgbaDeferred() const {
+    return !_rgbaImage && _indexedImage && _loader && _loader->isRgbaDeferred();
+}
+
+void GraphicsImage::createRenderId() {
+    if (isRgbaDeferred()) {
+        _renderId = render->CreatePalettedTexture(_indexedImage, _palette);
+    } else if (!_rgbaImage && _indexedImage) {
+        _renderId = render->CreateIndexedTexture(_indexedImage);
+    } else {
+        _renderId = render->CreateTexture(_rgbaImage);
+    }
+}
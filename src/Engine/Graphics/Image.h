@@ -12,6 +12,7 @@
 #include "Utility/Types.h"
 
 class ImageLoader;
+class ThreadPool;
 
 class GraphicsImage {
  public:
@@ -31,13 +32,75 @@ class GraphicsImage {
 
     const GrayscaleImage &indexed();
 
+    /**
+     * @return                          Whether this image only has palette indices & no RGBA pixels. Textures of
+     *                                  such images are created with `Renderer::CreateIndexedTexture`, and `rgba`
+     *                                  returns an empty image.
+     */
+    bool isIndexedOnly();
+
     std::string *GetName();
 
     void Release();
 
     [[nodiscard]] TextureRenderId renderId(bool load = true);
+
+    /**
+     * Loads the pixel data if it's not loaded yet & creates the texture. Same as calling `renderId()` and dropping
+     * the result.
+     */
+    void upload();
+
     void releaseRenderId();
 
+    /**
+     * Releases both the pixel data and the GL texture. Only works for images that were created with a loader, and
+     * the data is then transparently reloaded on next access.
+     *
+     * Note that any changes made to the pixels through `rgba()` are lost.
+     *
+     * @return                          Whether the image was unloaded.
+     */
+    bool unload();
+
+    /**
+     * @return                          Whether the pixel data is loaded. Accessing the pixels or the texture of an
+     *                                  image that's not loaded loads it synchronously.
+     */
+    [[nodiscard]] bool isLoaded() const {
+        return _initialized;
+    }
+
+    /**
+     * Starts decoding this image's data in the background, if the loader supports it. Use
+     * `AssetsManager::prefetchImages` instead of calling this method directly.
+     *
+     * @param pool                      Thread pool to run decoding on.
+     */
+    void prefetch(ThreadPool *pool);
+
+    /**
+     * @return                          Whether a background decoding job started by `prefetch` is still running.
+     */
+    [[nodiscard]] bool isPrefetching() const;
+
+    /**
+     * @return                          Frame index of the last access to this image, see `AssetsManager::frameIndex`.
+     */
+    [[nodiscard]] int64_t lastUseFrame() const {
+        return _lastUseFrame;
+    }
+
+    /**
+     * @return                          Size of the pixel data that's currently loaded, in bytes.
+     */
+    [[nodiscard]] size_t memorySize() const;
+
+    /**
+     * @return                          Estimated size of the GL texture, in bytes. Zero if there is no GL texture.
+     */
+    [[nodiscard]] size_t gpuMemorySize() const;
+
  protected:
     ~GraphicsImage(); // Call Release() instead.
 
@@ -50,8 +113,15 @@ class GraphicsImage {
     GrayscaleImage _indexedImage;
     Palette _palette;
     TextureRenderId _renderId;
+    int64_t _lastUseFrame = 0;
 
     bool LoadImageData();
+    void createRenderId();
+
+    /**
+     * @return                          Whether the RGBA pixels weren't computed yet, see `ImageLoader::isRgbaDeferred`.
+     */
+    [[nodiscard]] bool isRgbaDeferred() const;
 };
 
 class ImageHelper {
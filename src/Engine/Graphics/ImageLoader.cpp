@@ -10,7 +10,6 @@
 #include "Engine/LodTextureCache.h"
 #include "Engine/LodSpriteCache.h"
 
-#include "Library/Image/ImageFunctions.h"
 #include "Library/Image/PCX.h"
 #include "Library/Logger/Logger.h"
 
@@ -49,6 +48,14 @@ static Palette MakePaletteColorKey(const Palette &palette, Color key) {
     return result;
 }
 
+void LodTexture_Loader::prefetch(ThreadPool *pool) {
+    lod->prefetchTextures({resource_name}, pool);
+}
+
+bool LodTexture_Loader::isPrefetching() const {
+    return lod->isPrefetching(resource_name);
+}
+
 bool Paletted_Img_Loader::Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage, Palette *palette) {
     Texture_MM7 *tex = lod->loadTexture(resource_name);
     if (tex == nullptr)
@@ -57,7 +64,6 @@ bool Paletted_Img_Loader::Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImag
     // TODO(captainurist): no need to copy here.
     *indexedImage = GrayscaleImage::copy(tex->indexed.width(), tex->indexed.height(), tex->indexed.pixels().data());
     *palette = tex->palette;
-    *rgbaImage = makeRgbaImage(*indexedImage, *palette);
 
     return true;
 }
@@ -76,8 +82,6 @@ bool ColorKey_LOD_Loader::Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImag
         *palette = MakePaletteColorKey(tex->palette, colorkey);
     }
 
-    *rgbaImage = makeRgbaImage(*indexedImage, *palette);
-
     return true;
 }
 
@@ -95,8 +99,6 @@ bool Image16bit_LOD_Loader::Load(RgbaImage *rgbaImage, GrayscaleImage *indexedIm
         *palette = tex->palette;
     }
 
-    *rgbaImage = makeRgbaImage(*indexedImage, *palette);
-
     return true;
 }
 
@@ -108,7 +110,6 @@ bool Alpha_LOD_Loader::Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage,
     // TODO(captainurist): no need to copy here.
     *indexedImage = GrayscaleImage::copy(tex->indexed.width(), tex->indexed.height(), tex->indexed.pixels().data());
     *palette = MakePaletteAlpha(tex->palette);
-    *rgbaImage = makeRgbaImage(*indexedImage, *palette);
 
     return true;
 }
@@ -198,8 +199,7 @@ bool Bitmaps_LOD_Loader::Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage
     *indexedImage = GrayscaleImage::copy(tex->indexed.width(), tex->indexed.height(), tex->indexed.pixels().data()); // NOLINT: this is not std::copy.
 
     if (!transparentTextures.contains(tex->name)) {
-        *palette = tex->palette;
-        *rgbaImage = makeRgbaImage(*indexedImage, *palette);
+        *palette = tex->palette; // RGBA pixels are deferred, see `isRgbaDeferred`.
     } else {
         *palette = MakePaletteAlpha(tex->palette);
 
@@ -222,17 +222,9 @@ bool Bitmaps_LOD_Loader::Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage
 bool Sprites_LOD_Loader::Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage, Palette *palette) {
     Sprite *pSprite = lod->loadSprite(this->resource_name);
 
-    size_t w = pSprite->sprite_header->bitmap.width();
-    size_t h = pSprite->sprite_header->bitmap.height();
-
-    *rgbaImage = RgbaImage::solid(w, h, Color());
-
-    for (size_t y = 0; y < h; y++) {
-        for (size_t x = 0; x < w; x++) {
-            uint8_t index = pSprite->sprite_header->bitmap[y][x];
-            (*rgbaImage)[y][x] = Color(index, 0, 0, index == 0 ? 0 : 255);
-        }
-    }
+    // Palette is applied in shaders, so there's no need for RGBA pixels.
+    const GrayscaleImage &bitmap = pSprite->sprite_header->bitmap;
+    *indexedImage = GrayscaleImage::copy(bitmap.width(), bitmap.height(), bitmap.pixels().data()); // NOLINT: this is not std::copy.
 
     return true;
 }
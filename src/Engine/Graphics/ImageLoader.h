@@ -10,6 +10,7 @@
 class LodSpriteCache;
 class LodTextureCache;
 class LodReader;
+class ThreadPool;
 
 class ImageLoader {
  public:
@@ -19,64 +20,83 @@ class ImageLoader {
 
     virtual bool Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage, Palette *palette) = 0;
 
+    /**
+     * Starts decoding the underlying data on the provided thread pool, so that the following `Load` call is faster.
+     * Default implementation does nothing.
+     *
+     * @param pool                      Thread pool to run decoding on.
+     */
+    virtual void prefetch(ThreadPool *pool) {}
+
+    /**
+     * @return                          Whether the decoding job that was started in `prefetch` is still running.
+     */
+    [[nodiscard]] virtual bool isPrefetching() const { return false; }
+
+    /**
+     * @return                          Whether `Load` might leave the RGBA image empty for paletted images, meaning
+     *                                  that the RGBA pixels are the palette indices with the palette applied. These
+     *                                  are then only computed if someone asks for them, and the texture is created
+     *                                  with `Renderer::CreatePalettedTexture`.
+     */
+    [[nodiscard]] virtual bool isRgbaDeferred() const { return false; }
+
  protected:
     std::string resource_name;
 };
 
-class Paletted_Img_Loader : public ImageLoader {
+/**
+ * Base class for the loaders that get their data from a `LodTextureCache`, prefetching is forwarded to
+ * `LodTextureCache::prefetchTextures`. Derived loaders only produce RGBA pixels if these can't be computed from the
+ * palette, see `isRgbaDeferred`.
+ */
+class LodTexture_Loader : public ImageLoader {
  public:
-    inline Paletted_Img_Loader(LodTextureCache *lod, const std::string &filename) {
+    inline LodTexture_Loader(LodTextureCache *lod, const std::string &filename) {
         this->resource_name = filename;
         this->lod = lod;
     }
 
-    virtual bool Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage, Palette *palette) override;
+    virtual void prefetch(ThreadPool *pool) override;
+    [[nodiscard]] virtual bool isPrefetching() const override;
+    [[nodiscard]] virtual bool isRgbaDeferred() const override { return true; }
 
  protected:
     LodTextureCache *lod;
 };
 
-class ColorKey_LOD_Loader : public ImageLoader {
+class Paletted_Img_Loader : public LodTexture_Loader {
+ public:
+    using LodTexture_Loader::LodTexture_Loader;
+
+    virtual bool Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage, Palette *palette) override;
+};
+
+class ColorKey_LOD_Loader : public LodTexture_Loader {
  public:
     inline ColorKey_LOD_Loader(LodTextureCache *lod,
-                               const std::string &filename, Color colorkey) {
-        this->resource_name = filename;
+                               const std::string &filename, Color colorkey) : LodTexture_Loader(lod, filename) {
         this->colorkey = colorkey;
-        this->lod = lod;
     }
 
     virtual bool Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage, Palette *palette) override;
 
  protected:
     Color colorkey;
-    LodTextureCache *lod;
 };
 
-class Image16bit_LOD_Loader : public ImageLoader {
+class Image16bit_LOD_Loader : public LodTexture_Loader {
  public:
-    inline Image16bit_LOD_Loader(LodTextureCache *lod,
-                                 const std::string &filename) {
-        this->resource_name = filename;
-        this->lod = lod;
-    }
+    using LodTexture_Loader::LodTexture_Loader;
 
     virtual bool Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage, Palette *palette) override;
-
- protected:
-    LodTextureCache *lod;
 };
 
-class Alpha_LOD_Loader : public ImageLoader {
+class Alpha_LOD_Loader : public LodTexture_Loader {
  public:
-    inline Alpha_LOD_Loader(LodTextureCache *lod, const std::string &filename) {
-        this->resource_name = filename;
-        this->lod = lod;
-    }
+    using LodTexture_Loader::LodTexture_Loader;
 
     virtual bool Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage, Palette *palette) override;
-
- protected:
-    LodTextureCache *lod;
 };
 
 class PCX_Loader : public ImageLoader {
@@ -125,17 +145,11 @@ class PCX_LOD_Compressed_Loader : public PCX_Loader {
     std::function<Blob()> blob_func;
 };
 
-class Bitmaps_LOD_Loader : public ImageLoader {
+class Bitmaps_LOD_Loader : public LodTexture_Loader {
  public:
-    inline Bitmaps_LOD_Loader(LodTextureCache *lod, const std::string &filename) {
-        this->resource_name = filename;
-        this->lod = lod;
-    }
+    using LodTexture_Loader::LodTexture_Loader;
 
     virtual bool Load(RgbaImage *rgbaImage, GrayscaleImage *indexedImage, Palette *palette) override;
-
- protected:
-    LodTextureCache *lod;
 };
 
 class Sprites_LOD_Loader : public ImageLoader {
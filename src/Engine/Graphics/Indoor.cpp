@@ -5,6 +5,7 @@
 #include <ranges>
 
 #include "Engine/Engine.h"
+#include "Engine/EngineCounters.h"
 #include "Engine/EngineGlobals.h"
 #include "Engine/AssetsManager.h"
 #include "Engine/Events/Processor.h"
@@ -21,12 +22,16 @@
 #include "Engine/Graphics/Sprites.h"
 #include "Engine/Graphics/PortalFunctions.h"
 #include "Engine/Graphics/Viewport.h"
+#include "Engine/Graphics/Vis.h"
 #include "Engine/Graphics/Image.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
+#include "Engine/Graphics/Renderer/RenderPrepTimers.h"
+#include "Engine/LoadProfiler.h"
 #include "Engine/Random/Random.h"
 #include "Engine/Objects/Actor.h"
 #include "Engine/Objects/ObjectList.h"
 #include "Engine/Objects/SpriteObject.h"
+#include "Engine/Objects/SpriteObjectSpatialHash.h"
 #include "Engine/Tables/ItemTable.h"
 #include "Engine/OurMath.h"
 #include "Engine/Party.h"
@@ -36,7 +41,9 @@
 #include "Engine/TurnEngine/TurnEngine.h"
 #include "Engine/Localization.h"
 #include "Engine/MapInfo.h"
+#include "Engine/LocationPrefetcher.h"
 #include "Engine/LOD.h"
+#include "Engine/SaveLoad.h"
 
 #include "GUI/GUIProgressBar.h"
 #include "GUI/GUIWindow.h"
@@ -45,12 +52,15 @@
 #include "Media/Audio/AudioPlayer.h"
 
 #include "Library/Logger/Logger.h"
+#include "Library/Profiler/Profiler.h"
 #include "Library/LodFormats/LodFormats.h"
 
 #include "Utility/Memory/FreeDeleter.h"
+#include "Utility/Memory/MemoryAccounting.h"
 #include "Utility/Math/TrigLut.h"
 #include "Utility/Math/FixPoint.h"
 #include "Utility/Exception.h"
+#include "Utility/String.h"
 
 IndoorLocation *pIndoor = nullptr;
 BLVRenderParams *pBLVRenderParams = new BLVRenderParams;
@@ -152,24 +162,41 @@ void PrepareDrawLists_BLV() {
     pBLVRenderParams->Reset();
     uNumDecorationsDrawnThisFrame = 0;
     uNumSpritesDrawnThisFrame = 0;
-    uNumBillboardsToDraw = 0;
+    pBillboardRenderList.clear();
 
-    pMobileLightsStack->uNumLightsActive = 0;
-    //pStationaryLightsStack->uNumLightsActive = 0;
+    pMobileLightsStack->pLights.clear();
+    //pStationaryLightsStack->pLights.clear();
     engine->StackPartyTorchLight();
 
-    PrepareBspRenderList_BLV();
+    {
+        RenderPrepTimerScope timer(RENDER_PREP_BSP);
+        OE_PROFILE_ZONE("prep bsp");
+        PrepareBspRenderList_BLV();
+    }
 
-    render->DrawSpriteObjects();
-    pOutdoor->PrepareActorsDrawList();
+    {
+        RenderPrepTimerScope timer(RENDER_PREP_SPRITE_OBJECTS);
+        OE_PROFILE_ZONE("prep sprite objects");
+        render->DrawSpriteObjects();
+    }
 
-     for (unsigned i = 0; i < pBspRenderer->uNumVisibleNotEmptySectors; ++i) {
-         int v7 = pBspRenderer->pVisibleSectorIDs_toDrawDecorsActorsEtcFrom[i];
-         v8 = &pIndoor->pSectors[pBspRenderer->pVisibleSectorIDs_toDrawDecorsActorsEtcFrom[i]];
+    {
+        RenderPrepTimerScope timer(RENDER_PREP_ACTORS);
+        OE_PROFILE_ZONE("prep actors");
+        pOutdoor->PrepareActorsDrawList();
+    }
 
-        for (unsigned j = 0; j < v8->uNumDecorations; ++j)
-            pIndoor->PrepareDecorationsRenderList_BLV(v8->pDecorationIDs[j], v7);
-     }
+    {
+        RenderPrepTimerScope timer(RENDER_PREP_DECORATIONS);
+        OE_PROFILE_ZONE("prep decorations");
+        for (unsigned i = 0; i < pBspRenderer->uNumVisibleNotEmptySectors; ++i) {
+            int v7 = pBspRenderer->pVisibleSectorIDs_toDrawDecorsActorsEtcFrom[i];
+            v8 = &pIndoor->pSectors[pBspRenderer->pVisibleSectorIDs_toDrawDecorsActorsEtcFrom[i]];
+
+            for (unsigned j = 0; j < v8->uNumDecorations; ++j)
+                pIndoor->PrepareDecorationsRenderList_BLV(v8->pDecorationIDs[j], v7);
+        }
+    }
 
     FindBillboardsLightLevels_BLV();
 }
@@ -216,7 +243,11 @@ void IndoorLocation::Draw() {
     PrepareDrawLists_BLV();
     if (pBLVRenderParams->uPartySectorID)
         DrawIndoorFaces(true);
-    render->TransformBillboardsAndSetPalettesODM();
+    {
+        RenderPrepTimerScope timer(RENDER_PREP_BILLBOARDS);
+        OE_PROFILE_ZONE("prep billboards");
+        render->TransformBillboardsAndSetPalettesODM();
+    }
     engine->DrawParticles();
     trail_particle_generator.UpdateParticles();
 }
@@ -269,6 +300,13 @@ void IndoorLocation::Release() {
     this->pSpawnPoints.clear();
     this->pSectors.clear();
     this->pFaces.clear();
+    this->faceBvh = Bvh();
+    this->sectorCollisionFaces = SectorCollisionFaces();
+    this->sectorGrid = SectorGrid();
+    this->sectorVisibility = SectorVisibility();
+    this->sectorNavigation = SectorNavigation();
+    this->activeDoorIds.clear();
+    pBspRenderer->invalidateCache();
     this->pFaceExtras.clear();
     this->pVertices.clear();
     this->pNodes.clear();
@@ -300,8 +338,14 @@ void IndoorLocation::toggleLight(signed int sLightID, unsigned int bToggle) {
     }
 }
 
+// Sector bounding boxes are expanded by this amount in X & Y when looking up the sector for a point.
+static constexpr int GET_SECTOR_SLACK_XY = 5;
+
 //----- (00498E0A) --------------------------------------------------------
 void IndoorLocation::Load(const std::string &filename, int num_days_played, int respawn_interval_days, bool *indoor_was_respawned) {
+    LoadProfilerScope profilerScope("IndoorLocation::Load");
+    MemoryTagScope memoryScope(MEMORY_TAG_LEVEL);
+
     decal_builder->Reset(0);
 
     assert(!bLoaded); // BLV is already loaded!
@@ -315,16 +359,33 @@ void IndoorLocation::Load(const std::string &filename, int num_days_played, int
 
     bLoaded = true;
 
-    IndoorLocation_MM7 location;
-    deserialize(lod::decodeCompressed(pGames_LOD->read(blv_filename)), &location); // read throws if file doesn't exist.
-    reconstruct(location, this);
+    std::unique_ptr<PrefetchedLocation> prefetched = engine->_locationPrefetcher->take(blv_filename);
+    if (!prefetched || !prefetched->indoor) {
+        LoadProfilerScope profilerScope("deserialize location");
+        prefetched = std::make_unique<PrefetchedLocation>();
+        prefetched->fileName = toLower(blv_filename);
+        prefetched->indoor = std::make_unique<IndoorLocation_MM7>();
+        deserialize(lod::decodeCompressed(pGames_LOD->read(blv_filename)), prefetched->indoor.get()); // read throws if file doesn't exist.
+    }
+    const IndoorLocation_MM7 &location = *prefetched->indoor;
+    {
+        LoadProfilerScope profilerScope("reconstruct location");
+        reconstruct(location, this, engine->_threadPool.get());
+    }
 
     std::string dlv_filename = filename;
     dlv_filename.replace(dlv_filename.length() - 4, 4, ".dlv");
 
+    auto loadInitialDelta = [&] {
+        if (!prefetched->initialDelta)
+            prefetched->initialDelta = lod::decodeCompressed(pGames_LOD->read(dlv_filename));
+        return Blob::share(prefetched->initialDelta);
+    };
+
     bool respawnInitial = false; // Perform initial location respawn?
     bool respawnTimed = false; // Perform timed location respawn?
     IndoorDelta_MM7 delta;
+    finishPendingSave(); // Make sure new.lod is fully written.
     if (Blob blob = lod::decodeCompressed(pSave_LOD->read(dlv_filename))) {
         try {
             deserialize(blob, &delta, tags::context(location));
@@ -352,12 +413,12 @@ void IndoorLocation::Load(const std::string &filename, int num_days_played, int
     assert(respawnInitial + respawnTimed <= 1);
 
     if (respawnInitial) {
-        deserialize(lod::decodeCompressed(pGames_LOD->read(dlv_filename)), &delta, tags::context(location));
+        deserialize(loadInitialDelta(), &delta, tags::context(location));
         *indoor_was_respawned = true;
     } else if (respawnTimed) {
         auto header = delta.header;
         auto visibleOutlines = delta.visibleOutlines;
-        deserialize(lod::decodeCompressed(pGames_LOD->read(dlv_filename)), &delta, tags::context(location));
+        deserialize(loadInitialDelta(), &delta, tags::context(location));
         delta.header = header;
         delta.visibleOutlines = visibleOutlines;
         *indoor_was_respawned = true;
@@ -367,14 +428,28 @@ void IndoorLocation::Load(const std::string &filename, int num_days_played, int
 
     reconstruct(delta, this);
 
+    // Keep the parsed location around, the party is likely to come back here soon.
+    engine->_locationPrefetcher->retain(std::move(prefetched));
+
     if (respawnTimed || respawnInitial)
         dlv.lastRespawnDay = num_days_played;
     if (respawnTimed)
         dlv.respawnCount++;
+
+    {
+        LoadProfilerScope profilerScope("build acceleration structures");
+        faceBvh = BuildFaceBvh(pFaces);
+        sectorCollisionFaces = SectorCollisionFaces(pSectors, pFaces);
+        sectorGrid = SectorGrid(pSectors, GET_SECTOR_SLACK_XY);
+        sectorVisibility = SectorVisibility(pSectors, pFaces, LINE_OF_SIGHT_MAX_DISTANCE, LINE_OF_SIGHT_MAX_PORTALS);
+        sectorNavigation = SectorNavigation(pSectors, pFaces);
+    }
 }
 
 //----- (0049AC17) --------------------------------------------------------
 int IndoorLocation::GetSector(int sX, int sY, int sZ) {
+    engineCounters.sectorLookups.fetch_add(1, std::memory_order_relaxed);
+
     if (uCurrentlyLoadedLevelType != LEVEL_INDOOR)
         return 0;
 
@@ -390,13 +465,14 @@ int IndoorLocation::GetSector(int sX, int sY, int sZ) {
     std::optional<int> foundSector;
     bool singleSectorFound = false;
 
-    // loop through sectors
-    for (unsigned i = 1; i < pSectors.size(); ++i) {
+    // loop through sectors that might contain the point
+    for (int i : sectorGrid.candidates(sX, sY)) {
         if (NumFoundFaceStore >= 5) break;
 
         BLVSector *pSector = &pSectors[i];
 
-        if (!pSector->pBounding.intersectsCuboid(Vec3i(sX, sY, sZ), Vec3i(5, 5, 64)))
+        Vec3i slack(GET_SECTOR_SLACK_XY, GET_SECTOR_SLACK_XY, 64);
+        if (!pSector->pBounding.intersectsCuboid(Vec3i(sX, sY, sZ), slack))
             continue;  // outside sector bounding
 
         if (!backupboundingsector) backupboundingsector = i;
@@ -675,15 +751,20 @@ void BLV_UpdateDoors() {
     if (dword_6BE13C_uCurrentlyLoadedLocationID != MAP_INVALID)
         eDoorSoundID = pDoorSoundIDsByLocationID[dword_6BE13C_uCurrentlyLoadedLocationID];
 
-    // loop over all doors
-    for (unsigned i = 0; i < pIndoor->pDoors.size(); ++i) {
+    // Moving doors change the portal geometry, so BSP traversal results from the last frame can't be reused.
+    if (!pIndoor->activeDoorIds.empty())
+        pBspRenderer->invalidateCache();
+
+    // Loop over the moving doors only. Doors that stop moving are dropped from the list after this frame.
+    std::erase_if(pIndoor->activeDoorIds, [&](int i) {
         BLVDoor *door = &pIndoor->pDoors[i];
 
-        // door not moving currently
+        // Door was stopped in a previous frame, nothing to do.
         if (door->uState == DOOR_CLOSED || door->uState == DOOR_OPEN) {
             door->uAttributes &= ~DOOR_SETTING_UP;
-            continue;
+            return true;
         }
+
         bool shouldPlaySound = !(door->uAttributes & (DOOR_SETTING_UP | DOOR_NOSOUND)) && door->uNumVertices != 0;
 
         door->uTimeSinceTriggered += pEventTimer->dt();
@@ -728,6 +809,10 @@ void BLV_UpdateDoors() {
 
         for (int j = 0; j < door->uNumFaces; ++j) {
             BLVFace *face = &pIndoor->pFaces[door->pFaceIDs[j]];
+
+            // Decals were clipped to the face when they were created & can't follow the face as it moves.
+            pIndoor->decal_builder->RemoveFaceDecals(door->pFaceIDs[j]);
+
             const Vec3i &facePoint = pIndoor->pVertices[face->pVertexIDs[0]];
             face->facePlane.dist = -dot(facePoint.toFloat(), face->facePlane.normal);
             face->zCalc.init(face->facePlane);
@@ -774,7 +859,19 @@ void BLV_UpdateDoors() {
                 extras->sTextureDeltaV = -vdot * openDistance + door->pDeltaVs[j];
             }
         }
-    }
+
+        door->uGeometryVersion++;
+        return false;
+    });
+}
+
+void IndoorLocation::activateDoor(int doorIndex) {
+    assert(doorIndex >= 0 && doorIndex < pDoors.size());
+
+    // Kept sorted so that doors are updated in the same order as they were before the active list was introduced.
+    auto pos = std::ranges::lower_bound(activeDoorIds, doorIndex);
+    if (pos == activeDoorIds.end() || *pos != doorIndex)
+        activeDoorIds.insert(pos, doorIndex);
 }
 
 //----- (0046F90C) --------------------------------------------------------
@@ -782,6 +879,9 @@ void UpdateActors_BLV() {
     if (engine->config->debug.NoActors.value())
         return;
 
+    // Sprite objects don't move while actors are moving.
+    spriteObjectSpatialHash.sync();
+
     for (Actor &actor : pActors) {
         if (actor.aiState == Removed || actor.aiState == Disabled || actor.aiState == Summoned || actor.moveSpeed == 0)
             continue;
@@ -792,6 +892,8 @@ void UpdateActors_BLV() {
         if (actor.sectorId == 0 || floorZ <= -30000)
             continue;
 
+        engineCounters.actorsUpdated.fetch_add(1, std::memory_order_relaxed);
+
         bool isFlying = actor.monsterInfo.flying;
         if (!actor.CanAct())
             isFlying = false;
@@ -876,6 +978,8 @@ void UpdateActors_BLV() {
 
 //----- (00460A78) --------------------------------------------------------
 void PrepareToLoadBLV(bool bLoading) {
+    LoadProfilerScope profilerScope("PrepareToLoadBLV");
+
     unsigned int respawn_interval;  // ebx@1
     MapInfo *map_info;              // edi@9
     bool v28;                       // zf@81
@@ -909,7 +1013,7 @@ void PrepareToLoadBLV(bool bLoading) {
     }
     dword_6BE13C_uCurrentlyLoadedLocationID = map_id;
 
-    pStationaryLightsStack->uNumLightsActive = 0;
+    pStationaryLightsStack->pLights.clear();
     pIndoor->Load(pCurrentMapName, pParty->GetPlayingTime().toDays() + 1, respawn_interval, &indoor_was_respawned);
     if (!(dword_6BE364_game_settings_1 & GAME_SETTINGS_LOADING_SAVEGAME_SKIP_RESPAWN)) {
         Actor::InitializeActors();
@@ -948,6 +1052,9 @@ void PrepareToLoadBLV(bool bLoading) {
             pIndoor->pDoors[i].uTimeSinceTriggered = 15360_ticks;
             pIndoor->pDoors[i].uAttributes = DOOR_SETTING_UP;
         }
+
+        // All doors are moving at this point, either snapping into place or still moving from the save.
+        pIndoor->activateDoor(i);
     }
 
     /*for (unsigned i = 0; i < pIndoor->uNumFaces; ++i)
@@ -957,6 +1064,8 @@ void PrepareToLoadBLV(bool bLoading) {
     pPaletteManager->LoadPalette(pBitmaps_LOD->pTextures[pIndoor->pFaces[i].uBitmapID].palette_id1);
     }*/
 
+    prefetchLevelAssets();
+
     pGameLoadingUI_ProgressBar->Progress();
     decorationsWithSound.clear();
 
@@ -1240,42 +1349,41 @@ void IndoorLocation::PrepareDecorationsRenderList_BLV(unsigned int uDecorationID
             if (projected_x + screen_space_half_width >= (signed int)pViewport->uViewportTL_X &&
                 projected_x - screen_space_half_width <= (signed int)pViewport->uViewportBR_X) {
                 if (projected_y >= pViewport->uViewportTL_Y && (projected_y - screen_space_height) <= pViewport->uViewportBR_Y) {
-                    assert(uNumBillboardsToDraw < 500);
-                    ++uNumBillboardsToDraw;
                     ++uNumDecorationsDrawnThisFrame;
 
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].hwsprite =
+                    RenderBillboard &billboard = pBillboardRenderList.emplace_back();
+                    billboard.hwsprite =
                         v11->hw_sprites[v9];
 
                     if (v11->hw_sprites[v9]->texture->height() == 0 || v11->hw_sprites[v9]->texture->width() == 0)
                         assert(false);
 
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].uPaletteIndex = v11->GetPaletteIndex();
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].uIndoorSectorID =
+                    billboard.uPaletteIndex = v11->GetPaletteIndex();
+                    billboard.uIndoorSectorID =
                         uSectorID;
 
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].fov_x =
+                    billboard.fov_x =
                         pCamera3D->ViewPlaneDistPixels;
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].screenspace_projection_factor_x = billb_scale;
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].screenspace_projection_factor_y = billb_scale;
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].field_1E = v30;
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].world_x =
+                    billboard.screenspace_projection_factor_x = billb_scale;
+                    billboard.screenspace_projection_factor_y = billb_scale;
+                    billboard.field_1E = v30;
+                    billboard.world_x =
                         pLevelDecorations[uDecorationID].vPosition.x;
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].world_y =
+                    billboard.world_y =
                         pLevelDecorations[uDecorationID].vPosition.y;
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].world_z =
+                    billboard.world_z =
                         pLevelDecorations[uDecorationID].vPosition.z;
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].screen_space_x =
+                    billboard.screen_space_x =
                         projected_x;
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].screen_space_y =
+                    billboard.screen_space_y =
                         projected_y;
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].screen_space_z =
+                    billboard.screen_space_z =
                         view_x;
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].object_pid =
+                    billboard.object_pid =
                         Pid(OBJECT_Decoration, uDecorationID);
 
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].sTintColor = Color();
-                    pBillboardRenderList[uNumBillboardsToDraw - 1].pSpriteFrame = v11;
+                    billboard.sTintColor = Color();
+                    billboard.pSpriteFrame = v11;
                 }
             }
         }
@@ -1283,7 +1391,7 @@ void IndoorLocation::PrepareDecorationsRenderList_BLV(unsigned int uDecorationID
 }
 
 //----- (00407A1C) --------------------------------------------------------
-bool Check_LineOfSight(const Vec3i &target, const Vec3i &from) {  // target from - true on clear
+bool Check_LineOfSight(const Vec3i &target, const Vec3i &from, const std::vector<int> *outdoorModels) {  // target from - true on clear
     int AngleToTarget = TrigLUT.atan2(from.x - target.x, from.y - target.y);
     bool LOS_Obscurred = 0;
     bool LOS_Obscurred2 = 0;
@@ -1303,12 +1411,12 @@ bool Check_LineOfSight(const Vec3i &target, const Vec3i &from) {  // target from
         // offset 32 to side and check LOS
         Vec3i targetmod = target + Vec3i::fromPolar(32, AngleToTarget + TrigLUT.uIntegerHalfPi, 0);
         Vec3i frommod = from + Vec3i::fromPolar(32, AngleToTarget + TrigLUT.uIntegerHalfPi, 0);
-        LOS_Obscurred2 = Check_LOS_Obscurred_Outdoors_Bmodels(targetmod, frommod);
+        LOS_Obscurred2 = Check_LOS_Obscurred_Outdoors_Bmodels(targetmod, frommod, outdoorModels);
 
         // offset other side and repeat check
         targetmod = target + Vec3i::fromPolar(32, AngleToTarget - TrigLUT.uIntegerHalfPi, 0);
         frommod = from + Vec3i::fromPolar(32, AngleToTarget - TrigLUT.uIntegerHalfPi, 0);
-        LOS_Obscurred = Check_LOS_Obscurred_Outdoors_Bmodels(targetmod, frommod);
+        LOS_Obscurred = Check_LOS_Obscurred_Outdoors_Bmodels(targetmod, frommod, outdoorModels);
     }
 
     bool result{ !LOS_Obscurred2 || !LOS_Obscurred };
@@ -1371,48 +1479,43 @@ bool Check_LOS_Obscurred_Indoors(const Vec3i &target, const Vec3i &from) {  // t
     return false;
 }
 
-bool Check_LOS_Obscurred_Outdoors_Bmodels(const Vec3i &target, const Vec3i &from) {  // true is obscurred
-    Vec3f dir = (from - target).toFloat();
-    dir.normalize();
+static bool Check_LOS_Obscurred_Bmodel(const BSPModel &model, const Vec3i &target, const Vec3i &from,
+                                       const Vec3f &dir, const BBoxi &bbox) {
+    if (CalcDistPointToLine(target.x, target.y, from.x, from.y, model.vPosition.x, model.vPosition.y) > model.sBoundingRadius + 128)
+        return false;
 
-    BBoxi bbox = BBoxi::forPoints(from, target);
+    for (const ODMFace &face : model.pFaces) {
+        float dirDotNormal = dot(dir, face.facePlane.normal);
+        bool FaceIsParallel = fuzzyIsNull(dirDotNormal);
+        if (FaceIsParallel)
+            continue;
 
-    for (BSPModel &model : pOutdoor->pBModels) {
-        if (CalcDistPointToLine(target.x, target.y, from.x, from.y, model.vPosition.x, model.vPosition.y) <= model.sBoundingRadius + 128) {
-            for (ODMFace &face : model.pFaces) {
-                float dirDotNormal = dot(dir, face.facePlane.normal);
-                bool FaceIsParallel = fuzzyIsNull(dirDotNormal);
-                if (FaceIsParallel)
-                    continue;
+        // bounds check
+        if (!bbox.intersects(face.pBoundingBox))
+            continue;
 
-                // bounds check
-                if (!bbox.intersects(face.pBoundingBox))
-                    continue;
+        // point target plane distacne
+        float NegFacePlaceDist = -face.facePlane.signedDistanceTo(target.toFloat());
 
-                // point target plane distacne
-                float NegFacePlaceDist = -face.facePlane.signedDistanceTo(target.toFloat());
+        // are we on same side of plane
+        if (dirDotNormal <= 0) {
+            // angle obtuse - is target underneath plane
+            if (NegFacePlaceDist > 0)
+                continue;  // can never hit
+        } else {
+            // angle acute - is target above plane
+            if (NegFacePlaceDist < 0)
+                continue;  // can never hit
+        }
 
-                // are we on same side of plane
-                if (dirDotNormal <= 0) {
-                    // angle obtuse - is target underneath plane
-                    if (NegFacePlaceDist > 0)
-                        continue;  // can never hit
-                } else {
-                    // angle acute - is target above plane
-                    if (NegFacePlaceDist < 0)
-                        continue;  // can never hit
-                }
-
-                if (std::abs(NegFacePlaceDist) / 16384.0f <= std::abs(dirDotNormal)) {
-                    // calc how far along line interesction is
-                    float IntersectionDist = NegFacePlaceDist /  dirDotNormal;
-                    // less than zero means intersection is behind target point
-                    if (IntersectionDist >= 0) {
-                        Vec3i pos = target + (IntersectionDist * dir).toInt();
-                        if (face.Contains(pos, model.index)) {
-                            return true;
-                        }
-                    }
+        if (std::abs(NegFacePlaceDist) / 16384.0f <= std::abs(dirDotNormal)) {
+            // calc how far along line interesction is
+            float IntersectionDist = NegFacePlaceDist /  dirDotNormal;
+            // less than zero means intersection is behind target point
+            if (IntersectionDist >= 0) {
+                Vec3i pos = target + (IntersectionDist * dir).toInt();
+                if (face.Contains(pos, model.index)) {
+                    return true;
                 }
             }
         }
@@ -1421,6 +1524,37 @@ bool Check_LOS_Obscurred_Outdoors_Bmodels(const Vec3i &target, const Vec3i &from
     return false;
 }
 
+bool Check_LOS_Obscurred_Outdoors_Bmodels(const Vec3i &target, const Vec3i &from,
+                                          const std::vector<int> *models) {  // true is obscurred
+    Vec3f dir = (from - target).toFloat();
+    dir.normalize();
+
+    BBoxi bbox = BBoxi::forPoints(from, target);
+
+    if (models) {
+        for (int modelId : *models)
+            if (Check_LOS_Obscurred_Bmodel(pOutdoor->pBModels[modelId], target, from, dir, bbox))
+                return true;
+    } else {
+        for (const BSPModel &model : pOutdoor->pBModels)
+            if (Check_LOS_Obscurred_Bmodel(model, target, from, dir, bbox))
+                return true;
+    }
+
+    return false;
+}
+
+std::vector<int> outdoorModelsIntersecting(const BBoxi &box) {
+    std::vector<int> result;
+    if (uCurrentlyLoadedLevelType != LEVEL_OUTDOOR)
+        return result;
+
+    for (size_t i = 0; i < pOutdoor->pBModels.size(); i++)
+        if (box.intersects(pOutdoor->pBModels[i].pBoundingBox))
+            result.push_back(i);
+    return result;
+}
+
 //----- (0046A334) --------------------------------------------------------
 // TODO(Nik-RE-dev): does not belong here, it's common function for interaction for both indoor/outdoor
 // TODO(Nik-RE-dev): get rid of external function declaration inside
@@ -1826,6 +1960,7 @@ void switchDoorAnimation(unsigned int uDoorID, DoorAction a2) {
     }
 
     BLVDoor &door = *pos;
+    pIndoor->activateDoor(pos - pIndoor->pDoors.begin()); // No-op if the door is already moving.
 
     if (a2 == DOOR_ACTION_TRIGGER) {
         if (door.uState == DOOR_CLOSING || door.uState == DOOR_OPENING)
@@ -2035,7 +2170,7 @@ void SpawnRandomTreasure(MapInfo *mapInfo, SpawnPoint *a2) {
 
 //----- (0043F515) --------------------------------------------------------
 void FindBillboardsLightLevels_BLV() {
-    for (unsigned i = 0; i < uNumBillboardsToDraw; ++i) {
+    for (unsigned i = 0; i < pBillboardRenderList.size(); ++i) {
         if (pBillboardRenderList[i].field_1E & 2 ||
             uCurrentlyLoadedLevelType == LEVEL_INDOOR &&
                 !pBillboardRenderList[i].uIndoorSectorID)
@@ -10,9 +10,14 @@
 #include "Engine/SpawnPoint.h"
 
 #include "BSPModel.h"
+#include "Bvh.h"
 #include "LocationInfo.h"
 #include "LocationTime.h"
 #include "LocationFunctions.h"
+#include "SectorCollisionFaces.h"
+#include "SectorGrid.h"
+#include "SectorNavigation.h"
+#include "SectorVisibility.h"
 #include "FaceEnums.h"
 
 struct IndoorLocation;
@@ -49,6 +54,7 @@ struct BLVDoor {  // 50h
     uint16_t uNumSectors;
     uint16_t uNumOffsets;
     DoorState uState;
+    uint32_t uGeometryVersion = 0; // Bumped every time the door's vertices are moved. Not saved.
 };
 
 struct BLVMapOutline {  // 0C
@@ -218,6 +224,14 @@ struct IndoorLocation {
      */
     void toggleLight(signed int uLightID, unsigned int bToggle);
 
+    /**
+     * Adds a door to `activeDoorIds`. Must be called whenever a door goes into `DOOR_OPENING` or `DOOR_CLOSING`
+     * state, doors that are not in the list are not updated in `BLV_UpdateDoors`.
+     *
+     * @param doorIndex                 Index of the door in `pDoors`.
+     */
+    void activateDoor(int doorIndex);
+
     static unsigned int GetLocationIndex(const std::string &locationName);
     void DrawIndoorFaces(bool bD3D);
     void PrepareActorRenderList_BLV();
@@ -228,10 +242,16 @@ struct IndoorLocation {
     unsigned int bLoaded = 0;
     std::vector<Vec3i> pVertices;
     std::vector<BLVFace> pFaces;
+    Bvh faceBvh; // Over face bounding boxes, used for picking.
     std::vector<BLVFaceExtra> pFaceExtras;
     std::vector<BLVSector> pSectors;
+    SectorCollisionFaces sectorCollisionFaces; // Built on load, used to speed up collisions.
+    SectorGrid sectorGrid; // Built on load, used to speed up sector lookups.
+    SectorVisibility sectorVisibility; // Built on load, used to speed up line of sight checks.
+    SectorNavigation sectorNavigation; // Built on load, used to steer pursuing actors through portals.
     std::vector<BLVLight> pLights;
     std::vector<BLVDoor> pDoors;
+    std::vector<int> activeDoorIds; // Sorted indices into `pDoors` of the doors that are currently moving.
     std::vector<BSPNode> pNodes;
     std::vector<BLVMapOutline> pMapOutlines;
     std::vector<int16_t> pLFaces;
@@ -338,10 +358,12 @@ int GetApproximateIndoorFloorZ(const Vec3i &pos, int *pSectorID, int *pFaceID =
 /**
  * @param target                         Vec3i of position to check line of sight to
  * @param from                           Vec3i of position to check line of sight from
+ * @param outdoorModels                  Outdoor models to check against, as returned by `outdoorModelsIntersecting`.
+ *                                       Pass `nullptr` to check against all models.
  *
  * @return                              True if line of sight clear to target
  */
-bool Check_LineOfSight(const Vec3i &target, const Vec3i &from);
+bool Check_LineOfSight(const Vec3i &target, const Vec3i &from, const std::vector<int> *outdoorModels = nullptr);
 
 
 /**
@@ -355,9 +377,22 @@ bool Check_LOS_Obscurred_Indoors(const Vec3i &target, const Vec3i &from);
 /**
  * @param target                         Vec3i of position to check line of sight to
  * @param from                           Vec3i of position to check line of sight from
+ * @param models                         Indices of the models to check against. Pass `nullptr` to check against all
+ *                                       models.
  *
  * @return                              True if line of sight obscurred by outdoor models
  */
-bool Check_LOS_Obscurred_Outdoors_Bmodels(const Vec3i &target, const Vec3i &from);
+bool Check_LOS_Obscurred_Outdoors_Bmodels(const Vec3i &target, const Vec3i &from,
+                                          const std::vector<int> *models = nullptr);
+
+/**
+ * Can be used to share the model culling between line of sight checks that all lie within the same box, e.g. checks
+ * from a single point.
+ *
+ * @param box                            Box that all the lines of sight lie within.
+ * @return                              Indices of the outdoor models whose bounding boxes intersect `box`. Returns an
+ *                                      empty vector indoors.
+ */
+std::vector<int> outdoorModelsIntersecting(const BBoxi &box);
 
 extern struct BspRenderer *pBspRenderer;
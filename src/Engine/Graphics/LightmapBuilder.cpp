@@ -113,7 +113,7 @@ int GetLightLevelAtPoint(unsigned int uBaseLightLevel, int uSectorID, float x, f
     unsigned int approx_distance;
 
     // mobile lights
-    for (unsigned i = 0; i < pMobileLightsStack->uNumLightsActive; ++i) {
+    for (unsigned i = 0; i < pMobileLightsStack->pLights.size(); ++i) {
         MobileLight *p = &pMobileLightsStack->pLights[i];
         light_radius = p->uRadius;
 
@@ -158,7 +158,7 @@ int GetLightLevelAtPoint(unsigned int uBaseLightLevel, int uSectorID, float x, f
     }
 
     // stationary lights
-    for (unsigned i = 0; i < pStationaryLightsStack->uNumLightsActive; ++i) {
+    for (unsigned i = 0; i < pStationaryLightsStack->pLights.size(); ++i) {
         StationaryLight *p = &pStationaryLightsStack->pLights[i];
         light_radius = p->uRadius;
 
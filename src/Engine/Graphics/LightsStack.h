@@ -1,10 +1,10 @@
 #pragma once
 
-#include <array>
-
 #include "Library/Color/Color.h"
 #include "Library/Geometry/Vec.h"
 
+#include "Engine/Graphics/RenderList.h"
+
 struct StationaryLight {
     Vec3f vPosition {};
     int16_t uRadius = 0;
@@ -34,30 +34,30 @@ struct LightStack<T>
 
 struct LightsStack_StationaryLight_ {
     //----- (004AD385) --------------------------------------------------------
-    LightsStack_StationaryLight_();
+    LightsStack_StationaryLight_() = default;
 
     //----- (004AD395) --------------------------------------------------------
-    virtual ~LightsStack_StationaryLight_() { uNumLightsActive = 0; }
+    virtual ~LightsStack_StationaryLight_() = default;
 
     //----- (004AD39D) --------------------------------------------------------
-    inline unsigned int GetNumLights() { return uNumLightsActive; }
+    inline unsigned int GetNumLights() { return pLights.size(); }
 
     //----- (004AD3C8) --------------------------------------------------------
-    bool AddLight(const Vec3f &pos, int16_t radius, Color color, char uLightType);
+    void AddLight(const Vec3f &pos, int16_t radius, Color color, char uLightType);
 
-    std::array<StationaryLight, 400> pLights;
-    unsigned int uNumLightsActive;
+    // Rebuilt every frame, preallocated for a typical one.
+    RenderList<StationaryLight> pLights = RenderList<StationaryLight>(400);
 };
 
 struct LightsStack_MobileLight_ {
     //----- (00467D45) --------------------------------------------------------
-    LightsStack_MobileLight_();
+    LightsStack_MobileLight_() = default;
 
     //----- (00467D55) --------------------------------------------------------
-    virtual ~LightsStack_MobileLight_() { this->uNumLightsActive = 0; }
+    virtual ~LightsStack_MobileLight_() = default;
 
-    bool AddLight(const Vec3f &pos, int uSectorID, int uRadius, Color color, char uLightType);
+    void AddLight(const Vec3f &pos, int uSectorID, int uRadius, Color color, char uLightType);
 
-    std::array<MobileLight, 400> pLights;
-    unsigned int uNumLightsActive;
+    // Rebuilt every frame, preallocated for a typical one.
+    RenderList<MobileLight> pLights = RenderList<MobileLight>(400);
 };
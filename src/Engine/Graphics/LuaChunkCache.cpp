@@ -0,0 +1,112 @@
+#include "LuaChunkCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include <lua.hpp>
+
+#include "Library/Logger/Logger.h"
+
+#include "Utility/Memory/Blob.h"
+#include "Utility/Streams/TempFileOutputStream.h"
+#include "Utility/Hash.h"
+
+static constexpr char CACHE_SIGNATURE[8] = {'O', 'E', 'L', 'U', 'A', 'B', 'C', '1'};
+
+struct LuaChunkCacheHeader {
+    char signature[8];
+    uint64_t key;
+    uint64_t size;
+};
+static_assert(sizeof(LuaChunkCacheHeader) == 24);
+
+static uint64_t hashSource(const Blob &source) {
+    // Mix in the version, bytecode format is not stable between LuaJIT releases.
+    return fnv1aHashBytes(source.data(), source.size(), fnv1aHash(LUAJIT_VERSION));
+}
+
+static int writeChunk(lua_State *, const void *data, size_t size, void *userData) {
+    std::string *buffer = static_cast<std::string *>(userData);
+    buffer->append(static_cast<const char *>(data), size);
+    return 0;
+}
+
+void LuaChunkCache::initialize(std::string_view directory) {
+    _directory = directory;
+}
+
+int LuaChunkCache::loadFile(lua_State *L, std::string_view name, const std::string &path) const {
+    if (!isEnabled())
+        return luaL_loadfile(L, path.c_str());
+
+    std::error_code error;
+    if (!std::filesystem::exists(path, error))
+        return luaL_loadfile(L, path.c_str()); // Let Lua report the error.
+
+    Blob source;
+    try {
+        source = Blob::fromFile(path);
+    } catch (const std::exception &) {
+        return luaL_loadfile(L, path.c_str());
+    }
+
+    uint64_t key = hashSource(source);
+    std::string chunkName = "@" + path; // Same chunk name as luaL_loadfile would use.
+    std::string cachePath = this->path(name);
+
+    if (std::filesystem::exists(cachePath, error)) {
+        Blob cached;
+        try {
+            cached = Blob::fromFile(cachePath);
+        } catch (const std::exception &e) {
+            logger->warning("Lua: could not read cached bytecode '{}': {}", cachePath, e.what());
+        }
+
+        LuaChunkCacheHeader header;
+        if (cached.size() >= sizeof(header)) {
+            memcpy(&header, cached.data(), sizeof(header));
+            if (memcmp(header.signature, CACHE_SIGNATURE, sizeof(CACHE_SIGNATURE)) == 0 && header.key == key &&
+                header.size == cached.size() - sizeof(header)) {
+                const char *bytecode = static_cast<const char *>(cached.data()) + sizeof(header);
+                if (luaL_loadbuffer(L, bytecode, header.size, chunkName.c_str()) == 0)
+                    return 0;
+
+                logger->info("Lua: cached bytecode for '{}' was rejected, recompiling: {}", name, lua_tostring(L, -1));
+                lua_pop(L, 1);
+            }
+        }
+    }
+
+    int status = luaL_loadbuffer(L, static_cast<const char *>(source.data()), source.size(), chunkName.c_str());
+    if (status == 0)
+        save(L, name, key);
+    return status;
+}
+
+void LuaChunkCache::save(lua_State *L, std::string_view name, uint64_t key) const {
+    std::string bytecode;
+    if (lua_dump(L, &writeChunk, &bytecode) != 0 || bytecode.empty())
+        return;
+
+    LuaChunkCacheHeader header;
+    memcpy(header.signature, CACHE_SIGNATURE, sizeof(CACHE_SIGNATURE));
+    header.key = key;
+    header.size = bytecode.size();
+
+    std::string path = this->path(name);
+    try {
+        std::filesystem::create_directories(_directory);
+
+        TempFileOutputStream stream(path);
+        stream.write(&header, sizeof(header));
+        stream.write(bytecode.data(), bytecode.size());
+        stream.close();
+    } catch (const std::exception &e) {
+        logger->warning("Lua: could not write bytecode cache '{}': {}", path, e.what());
+    }
+}
+
+std::string LuaChunkCache::path(std::string_view name) const {
+    return (std::filesystem::path(_directory) / (std::string(name) + ".luac")).string();
+}
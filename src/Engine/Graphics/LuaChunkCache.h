@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+struct lua_State;
+
+/**
+ * On-disk cache of compiled Lua chunks, implemented on top of `lua_dump` & `luaL_loadbuffer`.
+ *
+ * Each chunk is stored in a separate file in the cache directory, together with a key that's a hash of the chunk
+ * source and of the LuaJIT version. So cached bytecode is dropped both when the script is edited and when LuaJIT is
+ * updated. If the cached bytecode can't be loaded for any other reason, the chunk is just compiled from source.
+ */
+class LuaChunkCache {
+ public:
+    LuaChunkCache() = default;
+
+    /**
+     * Enables the cache.
+     *
+     * @param directory                 Directory to store the cached bytecode in. Created on first write.
+     */
+    void initialize(std::string_view directory);
+
+    [[nodiscard]] bool isEnabled() const {
+        return !_directory.empty();
+    }
+
+    /**
+     * Drop-in replacement for `luaL_loadfile`. If the cache is disabled, just calls `luaL_loadfile`.
+     *
+     * @param L                         Lua state to load the chunk into.
+     * @param name                      Chunk name, used as a file name in the cache directory.
+     * @param path                      Path to the chunk source.
+     * @return                          Same as `luaL_loadfile` - zero on success, in which case the compiled chunk is
+     *                                  pushed on the stack, or an error code, in which case the error message is
+     *                                  pushed on the stack.
+     */
+    int loadFile(lua_State *L, std::string_view name, const std::string &path) const;
+
+ private:
+    [[nodiscard]] std::string path(std::string_view name) const;
+    void save(lua_State *L, std::string_view name, uint64_t key) const;
+
+ private:
+    std::string _directory; // Empty if disabled.
+};
@@ -0,0 +1,107 @@
+#include "ModelFaceGrid.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "BSPModel.h"
+
+ModelFaceGrid::ModelFaceGrid(std::span<const BSPModel> models, std::function<bool(const ODMFace &)> filter,
+                             int cellShift) : _cellShift(cellShift) {
+    auto included = [&](const ODMFace &face) {
+        return !filter || filter(face);
+    };
+
+    int maxX = INT_MIN;
+    int maxY = INT_MIN;
+    _minX = INT_MAX;
+    _minY = INT_MAX;
+    for (const BSPModel &model : models) {
+        for (const ODMFace &face : model.pFaces) {
+            if (!included(face))
+                continue;
+            _minX = std::min(_minX, face.pBoundingBox.x1);
+            _minY = std::min(_minY, face.pBoundingBox.y1);
+            maxX = std::max(maxX, face.pBoundingBox.x2);
+            maxY = std::max(maxY, face.pBoundingBox.y2);
+        }
+    }
+
+    if (_minX > maxX || _minY > maxY) {
+        _minX = _minY = 0;
+        return; // No faces.
+    }
+
+    _width = ((maxX - _minX) >> _cellShift) + 1;
+    _height = ((maxY - _minY) >> _cellShift) + 1;
+
+    auto forEachCell = [&](const BBoxi &bounds, auto &&callback) {
+        int cellX1 = (bounds.x1 - _minX) >> _cellShift;
+        int cellX2 = (bounds.x2 - _minX) >> _cellShift;
+        int cellY1 = (bounds.y1 - _minY) >> _cellShift;
+        int cellY2 = (bounds.y2 - _minY) >> _cellShift;
+        for (int cellY = cellY1; cellY <= cellY2; cellY++)
+            for (int cellX = cellX1; cellX <= cellX2; cellX++)
+                callback(cellY * _width + cellX);
+    };
+
+    // Counting sort into cells. Faces are added in model & face order, so cell lists come out sorted.
+    std::vector<int> counts(_width * _height + 1, 0);
+    for (const BSPModel &model : models)
+        for (const ODMFace &face : model.pFaces)
+            if (included(face))
+                forEachCell(face.pBoundingBox, [&](int cell) { counts[cell + 1]++; });
+
+    for (size_t i = 1; i < counts.size(); i++)
+        counts[i] += counts[i - 1];
+    _cellStarts = counts;
+
+    _faceIds.resize(_cellStarts.back());
+    for (int i = 0; i < models.size(); i++) {
+        for (int j = 0; j < models[i].pFaces.size(); j++) {
+            const ODMFace &face = models[i].pFaces[j];
+            if (included(face))
+                forEachCell(face.pBoundingBox, [&](int cell) { _faceIds[counts[cell]++] = FaceId(i, j); });
+        }
+    }
+}
+
+std::vector<ModelFaceGrid::FaceId> ModelFaceGrid::query(const BBoxf &bbox) const {
+    std::vector<FaceId> result;
+    if (_width == 0)
+        return result;
+
+    int cellX1 = std::max(0, static_cast<int>(std::floor(bbox.x1)) - _minX) >> _cellShift;
+    int cellX2 = std::min(_width - 1, (static_cast<int>(std::floor(bbox.x2)) - _minX) >> _cellShift);
+    int cellY1 = std::max(0, static_cast<int>(std::floor(bbox.y1)) - _minY) >> _cellShift;
+    int cellY2 = std::min(_height - 1, (static_cast<int>(std::floor(bbox.y2)) - _minY) >> _cellShift);
+    if (cellX1 > cellX2 || cellY1 > cellY2)
+        return result;
+
+    for (int cellY = cellY1; cellY <= cellY2; cellY++) {
+        for (int cellX = cellX1; cellX <= cellX2; cellX++) {
+            int cell = cellY * _width + cellX;
+            result.insert(result.end(), _faceIds.begin() + _cellStarts[cell], _faceIds.begin() + _cellStarts[cell + 1]);
+        }
+    }
+
+    // Faces spanning several cells are listed in each of them.
+    if (cellX1 != cellX2 || cellY1 != cellY2) {
+        std::ranges::sort(result);
+        result.erase(std::ranges::unique(result).begin(), result.end());
+    }
+    return result;
+}
+
+std::span<const ModelFaceGrid::FaceId> ModelFaceGrid::query(int x, int y) const {
+    if (x < _minX || y < _minY)
+        return {};
+
+    int cellX = (x - _minX) >> _cellShift;
+    int cellY = (y - _minY) >> _cellShift;
+    if (cellX >= _width || cellY >= _height)
+        return {};
+
+    int cell = cellY * _width + cellX;
+    return std::span(_faceIds).subspan(_cellStarts[cell], _cellStarts[cell + 1] - _cellStarts[cell]);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <compare>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "Library/Geometry/BBox.h"
+
+class BSPModel;
+struct ODMFace;
+
+/**
+ * Static uniform grid over the XY bounding boxes of the faces of outdoor models.
+ *
+ * Built when an ODM is loaded, and used by the outdoor collision code to only check the faces that are near the
+ * moving object instead of going through every face of every model. Floor & ceiling height queries use filtered grids
+ * with terrain-sized cells, see `OutdoorLocation::floorFaceGrid`.
+ */
+class ModelFaceGrid {
+ public:
+    static constexpr int DEFAULT_CELL_SHIFT = 11;
+
+    struct FaceId {
+        int model = 0;
+        int face = 0;
+
+        friend auto operator<=>(const FaceId &l, const FaceId &r) = default;
+    };
+
+    ModelFaceGrid() = default;
+
+    /**
+     * @param models                    Outdoor models.
+     * @param filter                    Predicate selecting the faces to put into the grid, empty function means all
+     *                                  faces. Must only look at the properties that don't change at runtime.
+     * @param cellShift                 Log2 of the cell size.
+     */
+    explicit ModelFaceGrid(std::span<const BSPModel> models, std::function<bool(const ODMFace &)> filter = {},
+                           int cellShift = DEFAULT_CELL_SHIFT);
+
+    /**
+     * @param bbox                      Query box, e.g. the collision sweep box.
+     * @return                          All faces that are in a cell that overlaps the provided box in XY, sorted by
+     *                                  model & face index - same order as nested loops over models and their faces
+     *                                  would produce. Callers still need to do their own bounding box checks.
+     */
+    [[nodiscard]] std::vector<FaceId> query(const BBoxf &bbox) const;
+
+    /**
+     * @param x                         Query point X.
+     * @param y                         Query point Y.
+     * @return                          All faces in the cell containing the provided point, sorted by model & face
+     *                                  index. Empty if the point is outside the grid. Callers still need to do their
+     *                                  own bounding box checks.
+     */
+    [[nodiscard]] std::span<const FaceId> query(int x, int y) const;
+
+ private:
+    int _cellShift = DEFAULT_CELL_SHIFT;
+    int _minX = 0;
+    int _minY = 0;
+    int _width = 0;
+    int _height = 0;
+    std::vector<int> _cellStarts; // Offsets into _faceIds, one for each cell plus one past the end.
+    std::vector<FaceId> _faceIds;
+};
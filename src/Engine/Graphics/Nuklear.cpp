@@ -13,9 +13,12 @@
 
 #include "Engine/Graphics/Nuklear.h"
 #include "Engine/Graphics/ImageLoader.h"
+#include "Engine/Graphics/LuaChunkCache.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
 #include "Engine/Graphics/Image.h"
 #include "Engine/LodTextureCache.h"
+#include "Engine/Objects/Actor.h"
+#include "Engine/Objects/SpriteObject.h"
 #include "Engine/Party.h"
 
 #include "GUI/GUIWindow.h"
@@ -25,10 +28,13 @@
 #include "Library/Logger/Logger.h"
 
 #include "Utility/DataPath.h"
+#include "Utility/Memory/MemoryAccounting.h"
 
 lua_State *lua = nullptr;
 Nuklear *nuklear = nullptr;
 
+static LuaChunkCache luaChunkCache;
+
 Nuklear::Nuklear() {
 }
 
@@ -57,6 +63,7 @@ struct img {
 
 struct context {
     const char *tmpl;
+    int ui_chunk; // Compiled template chunk, kept across window re-creation. Reset when the lua state is re-created.
     int ui_draw;
     int ui_release;
     std::vector<struct img *> imgs;
@@ -125,9 +132,14 @@ std::unique_ptr<Nuklear> Nuklear::Initialize() {
         return nullptr;
     }
 
+    // Engine is not yet created at this point, so we're using the config from the renderer.
+    if (render->config->graphics.LuaCache.value())
+        luaChunkCache.initialize(makeDataPath("lua_cache"));
+
     for (int w = WINDOW_MainMenu; w != WINDOW_DebugMenu; w++) {
         wins[w].state = WINDOW_NOT_LOADED;
         wins[w].mode = NUKLEAR_MODE_SHARED;
+        wins[w].ui_chunk = -1;
         wins[w].ui_draw = -1;
         wins[w].ui_release = -1;
         wins[w].winType = (WindowType)w;
@@ -999,6 +1011,10 @@ void Nuklear::LuaRelease() {
         return;
 
     lua_close(lua);
+
+    // Registry refs died together with the lua state.
+    for (int w = WINDOW_MainMenu; w != WINDOW_DebugMenu; w++)
+        wins[w].ui_chunk = -1;
 }
 
 bool Nuklear::LuaLoadTemplate(WindowType winType) {
@@ -1010,13 +1026,18 @@ bool Nuklear::LuaLoadTemplate(WindowType winType) {
     }
 
     name = wins[winType].tmpl;
-    int status = luaL_loadfile(lua, makeDataPath("ui", name + ".lua").c_str());
-    if (status) {
-        wins[winType].state = WINDOW_TEMPLATE_ERROR;
-        logger->warning("Nuklear: [{}] couldn't load lua template: {}", wins[winType].tmpl, lua_tostring(lua, -1));
-        lua_pop(lua, 1);
-        return false;
+    if (wins[winType].ui_chunk < 0) {
+        int status = luaChunkCache.loadFile(lua, name, makeDataPath("ui", name + ".lua"));
+        if (status) {
+            wins[winType].state = WINDOW_TEMPLATE_ERROR;
+            logger->warning("Nuklear: [{}] couldn't load lua template: {}", wins[winType].tmpl, lua_tostring(lua, -1));
+            lua_pop(lua, 1);
+            return false;
+        }
+
+        wins[winType].ui_chunk = luaL_ref(lua, LUA_REGISTRYINDEX);
     }
+    lua_rawgeti(lua, LUA_REGISTRYINDEX, wins[winType].ui_chunk);
 
     lua_pushlightuserdata(lua, (void *)&wins[winType]);
     int err = lua_pcall(lua, 1, 0, 0);
@@ -3203,6 +3224,46 @@ static int lua_window_dimensions(lua_State *L) {
     return 4;
 }
 
+static int lua_memory_stats(lua_State *L) {
+    lua_check_ret(lua_check_args(L, lua_gettop(L) == 1 || lua_gettop(L) == 2));
+
+    bool resetPeaks = lua_toboolean(L, 2);
+
+    auto pushStats = [&](const char *name, int64_t size, int64_t peakSize, int64_t count) {
+        lua_pushstring(L, name);
+        lua_newtable(L);
+        lua_pushliteral(L, "size");
+        lua_pushinteger(L, size);
+        lua_rawset(L, -3);
+        lua_pushliteral(L, "peak");
+        lua_pushinteger(L, peakSize);
+        lua_rawset(L, -3);
+        lua_pushliteral(L, "count");
+        lua_pushinteger(L, count);
+        lua_rawset(L, -3);
+        lua_rawset(L, -3);
+    };
+
+    lua_newtable(L);
+    for (MemoryTag tag : allMemoryTags()) {
+        MemoryTagStats stats = MemoryAccounting::stats(tag);
+        pushStats(displayName(tag), stats.size, stats.peakSize, stats.allocationCount);
+    }
+    MemoryTagStats heap = MemoryAccounting::heapStats();
+    pushStats("Heap total", heap.size, heap.peakSize, heap.allocationCount);
+
+    // Containers are not accounted for, report the largest ones directly. Peak is just current capacity.
+    int64_t actorsSize = pActors.capacity() * sizeof(Actor);
+    int64_t spriteObjectsSize = pSpriteObjects.capacity() * sizeof(SpriteObject);
+    pushStats("Actors", actorsSize, actorsSize, pActors.size());
+    pushStats("Sprite objects", spriteObjectsSize, spriteObjectsSize, pSpriteObjects.size());
+
+    if (resetPeaks)
+        MemoryAccounting::resetPeaks();
+
+    return 1;
+}
+
 static int lua_set_game_current_menu(lua_State *L) {
     lua_check_ret(lua_check_args(L, lua_gettop(L) == 2));
 
@@ -3437,7 +3498,7 @@ static int lua_load_raw_from_lod(lua_State *L) {
 }
 
 static bool lua_load_init() {
-    int status = luaL_loadfile(lua, makeDataPath("ui", "init.lua").c_str());
+    int status = luaChunkCache.loadFile(lua, "init", makeDataPath("ui", "init.lua"));
     if (status) {
         logger->warning("Nuklear: couldn't load init template: {}", lua_tostring(lua, -1));
         lua_pop(lua, 1);
@@ -3573,6 +3634,7 @@ bool Nuklear::LuaInit() {
 
     static const luaL_Reg game[] = {
         { "load_raw_from_lod", lua_load_raw_from_lod },
+        { "memory_stats", lua_memory_stats },
         { "party_get", lua_party_get },
         { "party_give", lua_party_give },
         { "party_set", lua_party_set },
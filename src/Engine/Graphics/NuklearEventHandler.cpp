@@ -4,7 +4,10 @@
 
 #include "Nuklear.h"
 
-NuklearEventHandler::NuklearEventHandler() : PlatformEventFilter(EVENTS_ALL) {}
+NuklearEventHandler::NuklearEventHandler() : PlatformEventFilter({
+    EVENT_KEY_PRESS, EVENT_KEY_RELEASE, EVENT_MOUSE_MOVE, EVENT_MOUSE_BUTTON_PRESS, EVENT_MOUSE_BUTTON_RELEASE,
+    EVENT_MOUSE_WHEEL
+}) {}
 
 bool NuklearEventHandler::keyPressEvent(const PlatformKeyEvent *event) {
     PlatformKey key = event->key;
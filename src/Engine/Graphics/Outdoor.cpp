@@ -2,8 +2,11 @@
 
 #include <algorithm>
 #include <memory>
+#include <span>
+#include <vector>
 
 #include "Engine/Engine.h"
+#include "Engine/EngineCounters.h"
 #include "Engine/EngineGlobals.h"
 #include "Engine/AssetsManager.h"
 #include "Engine/Events/Processor.h"
@@ -21,13 +24,17 @@
 #include "Engine/Graphics/Indoor.h"
 #include "Engine/Graphics/Image.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
+#include "Engine/Graphics/Renderer/RenderPrepTimers.h"
 #include "Engine/Graphics/Polygon.h"
+#include "Engine/LoadProfiler.h"
 #include "Engine/Random/Random.h"
 #include "Engine/Objects/Actor.h"
 #include "Engine/Objects/SpriteObject.h"
+#include "Engine/Objects/SpriteObjectSpatialHash.h"
 #include "Engine/Objects/MonsterEnumFunctions.h"
 #include "Engine/OurMath.h"
 #include "Engine/Party.h"
+#include "Engine/SimulationInterpolator.h"
 #include "Engine/Snapshots/CompositeSnapshots.h"
 #include "Engine/SpellFxRenderer.h"
 #include "Engine/Tables/ItemTable.h"
@@ -37,7 +44,9 @@
 #include "Engine/Graphics/Vis.h"
 #include "Engine/Graphics/BspRenderer.h"
 #include "Engine/MapInfo.h"
+#include "Engine/LocationPrefetcher.h"
 #include "Engine/LOD.h"
+#include "Engine/SaveLoad.h"
 
 #include "GUI/GUIProgressBar.h"
 #include "GUI/GUIWindow.h"
@@ -47,12 +56,15 @@
 #include "Media/Audio/AudioPlayer.h"
 
 #include "Library/Logger/Logger.h"
+#include "Library/Profiler/Profiler.h"
 #include "Library/LodFormats/LodFormats.h"
 
 #include "Utility/Memory/FreeDeleter.h"
+#include "Utility/Memory/MemoryAccounting.h"
 #include "Utility/Math/TrigLut.h"
 #include "Utility/Math/FixPoint.h"
 #include "Utility/Exception.h"
+#include "Utility/String.h"
 
 MapStartPoint uLevel_StartingPointType;
 
@@ -88,6 +100,18 @@ static constexpr IndexedArray<FogProbabilityTableEntry, MAP_EMERALD_ISLAND, MAP_
 };
 
 // for future sky textures?
+// Terrain cells are 512x512, see `WorldPosToGridCellX`.
+static constexpr int TERRAIN_CELL_SHIFT = 9;
+
+static bool isFloorFace(const ODMFace &face) {
+    return face.uNumVertices != 0 &&
+           (face.uPolygonType == POLYGON_Floor || face.uPolygonType == POLYGON_InBetweenFloorAndWall);
+}
+
+static bool isCeilingFace(const ODMFace &face) {
+    return face.uPolygonType == POLYGON_Ceiling || face.uPolygonType == POLYGON_InBetweenCeilingAndWall;
+}
+
 static constexpr std::array<int, 9> skyTexturesIds1 = {{3, 3, 3, 3, 3, 3, 3, 3, 3}};
 static constexpr std::array<int, 7> skyTexturesIds2 = {{3, 3, 3, 3, 3, 3, 3}};
 
@@ -132,8 +156,8 @@ void OutdoorLocation::ExecDraw(unsigned int bRedraw) {
     render->DrawOutdoorBuildings();
 
     // TODO(pskelton): consider order of drawing / lighting
-    pMobileLightsStack->uNumLightsActive = 0;
-    pStationaryLightsStack->uNumLightsActive = 0;
+    pMobileLightsStack->pLights.clear();
+    pStationaryLightsStack->pLights.clear();
     engine->StackPartyTorchLight();
 
     // engine->PrepareBloodsplats(); // not used?
@@ -143,15 +167,31 @@ void OutdoorLocation::ExecDraw(unsigned int bRedraw) {
 
     uNumDecorationsDrawnThisFrame = 0;
     uNumSpritesDrawnThisFrame = 0;
-    uNumBillboardsToDraw = 0;
+    pBillboardRenderList.clear();
 
-    PrepareActorsDrawList();
+    {
+        RenderPrepTimerScope timer(RENDER_PREP_ACTORS);
+        OE_PROFILE_ZONE("prep actors");
+        PrepareActorsDrawList();
+    }
 
-    if (!pODMRenderParams->bDoNotRenderDecorations)
+    if (!pODMRenderParams->bDoNotRenderDecorations) {
+        RenderPrepTimerScope timer(RENDER_PREP_DECORATIONS);
+        OE_PROFILE_ZONE("prep decorations");
         render->PrepareDecorationsRenderList_ODM();
+    }
+
+    {
+        RenderPrepTimerScope timer(RENDER_PREP_SPRITE_OBJECTS);
+        OE_PROFILE_ZONE("prep sprite objects");
+        render->DrawSpriteObjects();
+    }
 
-    render->DrawSpriteObjects();
-    render->TransformBillboardsAndSetPalettesODM();
+    {
+        RenderPrepTimerScope timer(RENDER_PREP_BILLBOARDS);
+        OE_PROFILE_ZONE("prep billboards");
+        render->TransformBillboardsAndSetPalettesODM();
+    }
 
     // temp hack to show snow every third day in winter
     switch (pParty->uCurrentMonth) {
@@ -815,6 +855,9 @@ void OutdoorLocation::Release() {
     this->sky_texture_filename = "sky043";
 
     pBModels.clear();
+    modelFaceGrid = ModelFaceGrid();
+    floorFaceGrid = ModelFaceGrid();
+    ceilingFaceGrid = ModelFaceGrid();
     pSpawnPoints.clear();
     pTerrain.Release();
     pFaceIDLIST.clear();
@@ -829,6 +872,9 @@ void OutdoorLocation::Release() {
 }
 
 void OutdoorLocation::Load(const std::string &filename, int days_played, int respawn_interval_days, bool *outdoors_was_respawned) {
+    LoadProfilerScope profilerScope("OutdoorLocation::Load");
+    MemoryTagScope memoryScope(MEMORY_TAG_LEVEL);
+
     //if (engine->IsUnderwater()) {
     //    pPaletteManager->pPalette_tintColor[0] = 0x10;
     //    pPaletteManager->pPalette_tintColor[1] = 0xC2;
@@ -854,18 +900,35 @@ void OutdoorLocation::Load(const std::string &filename, int days_played, int res
     std::string odm_filename = std::string(filename);
     odm_filename.replace(odm_filename.length() - 4, 4, ".odm");
 
-    OutdoorLocation_MM7 location;
-    deserialize(lod::decodeCompressed(pGames_LOD->read(odm_filename)), &location); // read throws.
-    reconstruct(location, this);
+    std::unique_ptr<PrefetchedLocation> prefetched = engine->_locationPrefetcher->take(odm_filename);
+    if (!prefetched || !prefetched->outdoor) {
+        LoadProfilerScope profilerScope("deserialize location");
+        prefetched = std::make_unique<PrefetchedLocation>();
+        prefetched->fileName = toLower(odm_filename);
+        prefetched->outdoor = std::make_unique<OutdoorLocation_MM7>();
+        deserialize(lod::decodeCompressed(pGames_LOD->read(odm_filename)), prefetched->outdoor.get()); // read throws.
+    }
+    const OutdoorLocation_MM7 &location = *prefetched->outdoor;
+    {
+        LoadProfilerScope profilerScope("reconstruct location");
+        reconstruct(location, this);
+    }
 
     // ****************.ddm file*********************//
 
     std::string ddm_filename = filename;
     ddm_filename = ddm_filename.replace(ddm_filename.length() - 4, 4, ".ddm");
 
+    auto loadInitialDelta = [&] {
+        if (!prefetched->initialDelta)
+            prefetched->initialDelta = lod::decodeCompressed(pGames_LOD->read(ddm_filename));
+        return Blob::share(prefetched->initialDelta);
+    };
+
     bool respawnInitial = false; // Perform initial location respawn?
     bool respawnTimed = false; // Perform timed location respawn?
     OutdoorDelta_MM7 delta;
+    finishPendingSave(); // Make sure new.lod is fully written.
     if (Blob blob = lod::decodeCompressed(pSave_LOD->read(ddm_filename))) {
         try {
             deserialize(blob, &delta, tags::context(location));
@@ -897,13 +960,13 @@ void OutdoorLocation::Load(const std::string &filename, int days_played, int res
     assert(respawnInitial + respawnTimed <= 1);
 
     if (respawnInitial) {
-        deserialize(lod::decodeCompressed(pGames_LOD->read(ddm_filename)), &delta, tags::context(location));
+        deserialize(loadInitialDelta(), &delta, tags::context(location));
         *outdoors_was_respawned = true;
     } else if (respawnTimed) {
         auto header = delta.header;
         auto fullyRevealedCells = delta.fullyRevealedCells;
         auto partiallyRevealedCells = delta.partiallyRevealedCells;
-        deserialize(lod::decodeCompressed(pGames_LOD->read(ddm_filename)), &delta, tags::context(location));
+        deserialize(loadInitialDelta(), &delta, tags::context(location));
         delta.header = header;
         delta.fullyRevealedCells = fullyRevealedCells;
         delta.partiallyRevealedCells = partiallyRevealedCells;
@@ -914,11 +977,23 @@ void OutdoorLocation::Load(const std::string &filename, int days_played, int res
 
     reconstruct(delta, this);
 
+    // Keep the parsed location around, the party is likely to come back here soon.
+    engine->_locationPrefetcher->retain(std::move(prefetched));
+
     if (respawnTimed || respawnInitial)
         ddm.lastRespawnDay = days_played;
     if (respawnTimed)
         ddm.respawnCount++;
 
+    {
+        LoadProfilerScope profilerScope("build acceleration structures");
+        for (BSPModel &model : pBModels)
+            model.faceBvh = BuildFaceBvh(model.pFaces);
+        modelFaceGrid = ModelFaceGrid(pBModels);
+        floorFaceGrid = ModelFaceGrid(pBModels, isFloorFace, TERRAIN_CELL_SHIFT);
+        ceilingFaceGrid = ModelFaceGrid(pBModels, isCeilingFace, TERRAIN_CELL_SHIFT);
+    }
+
     pTileTable->InitializeTileset(Tileset_Dirt);
     pTileTable->InitializeTileset(Tileset_Snow);
     pTileTable->InitializeTileset(pTileTypes[0].tileset);
@@ -1285,14 +1360,25 @@ void OutdoorLocation::PrepareActorsDrawList() {
     SpriteFrame *frame;  // eax@24
     int Sprite_Octant;           // [sp+24h] [bp-3Ch]@11
 
+    std::vector<char> inFrustum;
+    if (uCurrentlyLoadedLevelType != LEVEL_INDOOR) {
+        std::vector<Vec3f> centers;
+        std::vector<float> radii;
+        centers.reserve(pActors.size());
+        radii.reserve(pActors.size());
+        for (int i = 0; i < pActors.size(); ++i) {
+            centers.push_back((simulationInterpolator ? simulationInterpolator->actorPos(i) : pActors[i].pos).toFloat());
+            radii.push_back(pActors[i].radius);
+        }
+        inFrustum = CylindersInFrustum(std::move(centers), std::move(radii), engine->_threadPool.get());
+    }
+
     for (int i = 0; i < pActors.size(); ++i) {
         pActors[i].attributes &= ~ACTOR_VISIBLE;
         if (pActors[i].aiState == Removed || pActors[i].aiState == Disabled) {
             continue;
         }
 
-        if (uNumBillboardsToDraw >= 500) return;
-
         // view culling
         if (uCurrentlyLoadedLevelType == LEVEL_INDOOR) {
             bool onlist = false;
@@ -1304,14 +1390,16 @@ void OutdoorLocation::PrepareActorsDrawList() {
             }
             if (!onlist) continue;
         } else {
-            if (!IsCylinderInFrustum(pActors[i].pos.toFloat(), pActors[i].radius)) continue;
+            if (!inFrustum[i]) continue;
         }
 
-        int z = pActors[i].pos.z;
-        int x = pActors[i].pos.x;
-        int y = pActors[i].pos.y;
+        // Draw position, differs from the actor's position if we're drawing in between the simulation steps.
+        Vec3i pos = simulationInterpolator ? simulationInterpolator->actorPos(i) : pActors[i].pos;
+        int z = pos.z;
+        int x = pos.x;
+        int y = pos.y;
 
-        Angle_To_Cam = TrigLUT.atan2(pActors[i].pos.x - pCamera3D->vCameraPos.x, pActors[i].pos.y - pCamera3D->vCameraPos.y);
+        Angle_To_Cam = TrigLUT.atan2(x - pCamera3D->vCameraPos.x, y - pCamera3D->vCameraPos.y);
 
         Sprite_Octant = ((signed int)(TrigLUT.uIntegerPi +
                                       ((signed int)TrigLUT.uIntegerPi >> 3) + pActors[i].yawAngle -
@@ -1339,12 +1427,12 @@ void OutdoorLocation::PrepareActorsDrawList() {
                 z += floorf(pActors[i].height * 0.5f + 0.5f);
             } else {
                 v49 = 1;
-                spell_fx_renderer->_4A7F74(pActors[i].pos.x, pActors[i].pos.y, z);
+                spell_fx_renderer->_4A7F74(x, y, z);
                 v4 = (1.0 - (double)pActors[i].currentActionTime.ticks() /
                             (double)pActors[i].currentActionLength.ticks()) *
                      (double)(2 * pActors[i].height);
                 z -= floorf(v4 + 0.5f);
-                if (z > pActors[i].pos.z) z = pActors[i].pos.z;
+                if (z > pos.z) z = pos.z;
             }
         }
 
@@ -1389,45 +1477,43 @@ void OutdoorLocation::PrepareActorsDrawList() {
                 if (projected_x + screen_space_half_width >= (signed int)pViewport->uViewportTL_X &&
                     projected_x - screen_space_half_width <= (signed int)pViewport->uViewportBR_X) {
                     if (projected_y >= pViewport->uViewportTL_Y && (projected_y - screen_space_height) <= pViewport->uViewportBR_Y) { // test
-                        ++uNumBillboardsToDraw;
                         ++uNumSpritesDrawnThisFrame;
 
                         pActors[i].attributes |= ACTOR_VISIBLE;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].hwsprite = frame->hw_sprites[Sprite_Octant];
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].uIndoorSectorID = pActors[i].sectorId;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].uPaletteIndex = frame->GetPaletteIndex();
+                        RenderBillboard &billboard = pBillboardRenderList.emplace_back();
+                        billboard.hwsprite = frame->hw_sprites[Sprite_Octant];
+                        billboard.uIndoorSectorID = pActors[i].sectorId;
+                        billboard.uPaletteIndex = frame->GetPaletteIndex();
 
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].screenspace_projection_factor_x = proj_scale;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].screenspace_projection_factor_y = proj_scale;
+                        billboard.screenspace_projection_factor_x = proj_scale;
+                        billboard.screenspace_projection_factor_y = proj_scale;
 
                         if (pActors[i].buffs[ACTOR_BUFF_SHRINK].Active() &&
                             pActors[i].buffs[ACTOR_BUFF_SHRINK].power > 0) {
-                            pBillboardRenderList[uNumBillboardsToDraw - 1]
-                                .screenspace_projection_factor_y = 1.0f / pActors[i].buffs[ACTOR_BUFF_SHRINK].power *
-                                                                   pBillboardRenderList[uNumBillboardsToDraw - 1]
-                                .screenspace_projection_factor_y;
+                            billboard.screenspace_projection_factor_y =
+                                1.0f / pActors[i].buffs[ACTOR_BUFF_SHRINK].power * billboard.screenspace_projection_factor_y;
                         } else if (pActors[i].massDistortionTime) {
-                            pBillboardRenderList[uNumBillboardsToDraw - 1].screenspace_projection_factor_y =
+                            billboard.screenspace_projection_factor_y =
                                 spell_fx_renderer->_4A806F_get_mass_distortion_value(&pActors[i]) *
-                                pBillboardRenderList[uNumBillboardsToDraw - 1].screenspace_projection_factor_y;
+                                billboard.screenspace_projection_factor_y;
                         }
 
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].screen_space_x = projected_x;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].screen_space_y = projected_y;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].screen_space_z = view_x;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].world_x = x;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].world_y = y;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].world_z = z;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].dimming_level = 0;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].object_pid = Pid(OBJECT_Actor, i);
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].field_14_actor_id = i;
-
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].field_1E = flags | 0x200;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].pSpriteFrame = frame;
-                        pBillboardRenderList[uNumBillboardsToDraw - 1].sTintColor =
+                        billboard.screen_space_x = projected_x;
+                        billboard.screen_space_y = projected_y;
+                        billboard.screen_space_z = view_x;
+                        billboard.world_x = x;
+                        billboard.world_y = y;
+                        billboard.world_z = z;
+                        billboard.dimming_level = 0;
+                        billboard.object_pid = Pid(OBJECT_Actor, i);
+                        billboard.field_14_actor_id = i;
+
+                        billboard.field_1E = flags | 0x200;
+                        billboard.pSpriteFrame = frame;
+                        billboard.sTintColor =
                             pMonsterList->monsters[pActors[i].monsterInfo.id].tintColor;  // *((int *)&v35[v36] - 36);
                         if (pActors[i].buffs[ACTOR_BUFF_STONED].Active()) {
-                            pBillboardRenderList[uNumBillboardsToDraw - 1].field_1E =
+                            billboard.field_1E =
                                 flags | 0x100;
                         }
                     }
@@ -1446,46 +1532,43 @@ int ODM_GetFloorLevel(const Vec3i &pos, int unused, bool *pIsOnWater,
     current_Face_id[0] = -1;
     odm_floor_level[0] = GetTerrainHeightsAroundParty2(pos.x, pos.y, pIsOnWater, bWaterWalk);
 
-    int surface_count = 1;
+    // Terrain-only cells don't need any further checks.
+    std::span<const ModelFaceGrid::FaceId> faceIds = pOutdoor->floorFaceGrid.query(pos.x, pos.y);
+    if (faceIds.empty()) {
+        *faceId = 0;
+        return odm_floor_level[0];
+    }
 
-    for (BSPModel &model : pOutdoor->pBModels) {
+    int surface_count = 1;
+    int slack = engine->config->gameplay.FloorChecksEps.value();
+    for (ModelFaceGrid::FaceId id : faceIds) {
+        BSPModel &model = pOutdoor->pBModels[id.model];
         if (!model.pBoundingBox.containsXY(pos.x, pos.y))
             continue;
 
-        if (model.pFaces.empty())
+        ODMFace &face = model.pFaces[id.face];
+        if (face.Ethereal())
             continue;
 
-        for (ODMFace &face : model.pFaces) {
-            if (face.Ethereal())
-                continue;
-
-            if (face.uNumVertices == 0)
-                continue;
-
-            if (face.uPolygonType != POLYGON_Floor && face.uPolygonType != POLYGON_InBetweenFloorAndWall)
-                continue;
-
-            if (!face.pBoundingBox.containsXY(pos.x, pos.y))
-                continue;
-
-            int slack = engine->config->gameplay.FloorChecksEps.value();
-            if (!face.Contains(pos, model.index, slack, FACE_XY_PLANE))
-                continue;
+        if (!face.pBoundingBox.containsXY(pos.x, pos.y))
+            continue;
 
-            int floor_level;
-            if (face.uPolygonType == POLYGON_Floor) {
-                floor_level = model.pVertices[face.pVertexIDs[0]].z;
-            } else {
-                floor_level = face.zCalc.calculate(pos.x, pos.y);
-            }
-            odm_floor_level[surface_count] = floor_level;
-            current_BModel_id[surface_count] = model.index;
-            current_Face_id[surface_count] = face.index;
-            surface_count++;
+        if (!face.Contains(pos, model.index, slack, FACE_XY_PLANE))
+            continue;
 
-            if (surface_count >= 20)
-                break;
+        int floor_level;
+        if (face.uPolygonType == POLYGON_Floor) {
+            floor_level = model.pVertices[face.pVertexIDs[0]].z;
+        } else {
+            floor_level = face.zCalc.calculate(pos.x, pos.y);
         }
+        odm_floor_level[surface_count] = floor_level;
+        current_BModel_id[surface_count] = model.index;
+        current_Face_id[surface_count] = face.index;
+        surface_count++;
+
+        if (surface_count >= 20)
+            break;
     }
 
     if (surface_count == 1) {
@@ -2224,40 +2307,36 @@ int GetCeilingHeight(int Party_X, signed int Party_Y, int Party_ZHeight, int *pF
     ceiling_height_level[0] = 10000;  // no ceiling
 
     int ceiling_count = 1;
-
-    for (BSPModel &model : pOutdoor->pBModels) {
+    int slack = engine->config->gameplay.FloorChecksEps.value();
+    for (ModelFaceGrid::FaceId id : pOutdoor->ceilingFaceGrid.query(Party_X, Party_Y)) {
+        BSPModel &model = pOutdoor->pBModels[id.model];
         if (!model.pBoundingBox.containsXY(Party_X, Party_Y))
             continue;
 
-        for (ODMFace &face : model.pFaces) {
-            if (face.Ethereal())
-                continue;
-
-            if (face.uPolygonType != POLYGON_Ceiling && face.uPolygonType != POLYGON_InBetweenCeilingAndWall)
-                continue;
+        ODMFace &face = model.pFaces[id.face];
+        if (face.Ethereal())
+            continue;
 
-            if (!face.pBoundingBox.containsXY(Party_X, Party_Y))
-                continue;
+        if (!face.pBoundingBox.containsXY(Party_X, Party_Y))
+            continue;
 
-            int slack = engine->config->gameplay.FloorChecksEps.value();
-            if (!face.Contains(Vec3i(Party_X, Party_Y, 0), model.index, slack, FACE_XY_PLANE))
-                continue;
+        if (!face.Contains(Vec3i(Party_X, Party_Y, 0), model.index, slack, FACE_XY_PLANE))
+            continue;
 
-            if (ceiling_count >= 20)
-                break;
+        if (ceiling_count >= 20)
+            break;
 
-            int height_level;
-            if (face.uPolygonType == POLYGON_Ceiling)
-                height_level = model.pVertices[face.pVertexIDs[0]].z;
-            else
-                height_level = face.zCalc.calculate(Party_X, Party_Y);
+        int height_level;
+        if (face.uPolygonType == POLYGON_Ceiling)
+            height_level = model.pVertices[face.pVertexIDs[0]].z;
+        else
+            height_level = face.zCalc.calculate(Party_X, Party_Y);
 
-            ceiling_height_level[ceiling_count] = height_level;
-            model_indices[ceiling_count] = model.index;
-            face_indices[ceiling_count] = face.index;
+        ceiling_height_level[ceiling_count] = height_level;
+        model_indices[ceiling_count] = model.index;
+        face_indices[ceiling_count] = face.index;
 
-            ++ceiling_count;
-        }
+        ++ceiling_count;
     }
 
     if (!ceiling_count) {
@@ -2301,15 +2380,105 @@ void sub_487DA9() {
 }
 
 //----- (004706C6) --------------------------------------------------------
+/**
+ * Movement scheduling for the actor_lod config option. Actors that are far away from the party are moved once in
+ * several ticks, and each move then covers all the skipped time.
+ *
+ * @param actor                         Actor to check.
+ * @param[out] dt                       Time step to move the actor by.
+ * @return                              Whether the actor should be moved this tick.
+ */
+static bool scheduleActorMovement(Actor &actor, Duration *dt) {
+    *dt = pEventTimer->dt();
+
+    // Actors that are in full AI state are close to the party & might interact with it, turn-based mode & armageddon
+    // need every actor to move every tick.
+    bool reducedRate = engine->config->gameplay.ActorLod.value() && !(actor.attributes & ACTOR_FULL_AI_STATE) &&
+                       !pParty->bTurnBasedModeOn && !pParty->armageddon_timer;
+    if (reducedRate) {
+        int64_t distance = engine->config->gameplay.ActorLodDistance.value();
+        Vec3f delta = actor.pos.toFloat() - pParty->pos;
+        reducedRate = delta.lengthSqr() > distance * distance;
+    }
+
+    if (!reducedRate) {
+        *dt += actor.lodSkippedTime;
+        actor.lodSkippedTime = 0_ticks;
+        return true;
+    }
+
+    // Actors get moved when the game time crosses an interval boundary. Boundaries are offset by actor id, so that
+    // the far away actors don't all move on the same tick.
+    int64_t interval = engine->config->gameplay.ActorLodInterval.value();
+    int64_t offset = actor.id % interval;
+    int64_t time = pEventTimer->time().ticks() + offset;
+    if ((time - dt->ticks()) / interval == time / interval) {
+        actor.lodSkippedTime += *dt;
+        return false;
+    }
+
+    *dt += actor.lodSkippedTime;
+    actor.lodSkippedTime = 0_ticks;
+    return true;
+}
+
+/**
+ * @param actor                         Actor to check.
+ * @return                              Whether the actor can be put to sleep under the actor_sleep config option,
+ *                                      disregarding its movement state.
+ */
+static bool canActorSleep(const Actor &actor) {
+    // Same conditions as for actor_lod, actors in full AI state might interact with the party.
+    if (!engine->config->gameplay.ActorSleep.value() || (actor.attributes & ACTOR_FULL_AI_STATE) ||
+        pParty->bTurnBasedModeOn || pParty->armageddon_timer)
+        return false;
+
+    int64_t distance = engine->config->gameplay.ActorLodDistance.value();
+    Vec3f delta = actor.pos.toFloat() - pParty->pos;
+    return delta.lengthSqr() > distance * distance;
+}
+
+/**
+ * Wake check for the actor_sleep config option. A sleeping actor is woken up once anything that the movement code
+ * depends on changes, e.g. it is hit and knocked back, its AI state changes, an event moves it, or the party comes
+ * close.
+ *
+ * @param actor                         Actor to check.
+ * @return                              Whether the actor is still asleep and its movement update can be skipped.
+ */
+static bool checkActorSleep(Actor &actor) {
+    if (!actor.asleep)
+        return false;
+
+    if (canActorSleep(actor) && actor.pos == actor.sleepPos && actor.aiState == actor.sleepAiState &&
+        actor.speed == Vec3i() && actor.currentActionAnimation != ANIM_Walking)
+        return true;
+
+    actor.asleep = false;
+    return false;
+}
+
 void UpdateActors_ODM() {
     if (engine->config->debug.NoActors.value())
         return;  // uNumActors = 0;
 
+    // Sprite objects don't move while actors are moving.
+    spriteObjectSpatialHash.sync();
+
     for (unsigned int Actor_ITR = 0; Actor_ITR < pActors.size(); ++Actor_ITR) {
         if (pActors[Actor_ITR].aiState == Removed || pActors[Actor_ITR].aiState == Disabled ||
             pActors[Actor_ITR].aiState == Summoned || !pActors[Actor_ITR].moveSpeed)
                 continue;
 
+        if (checkActorSleep(pActors[Actor_ITR]))
+            continue;
+
+        Duration dt;
+        if (!scheduleActorMovement(pActors[Actor_ITR], &dt))
+            continue;
+
+        engineCounters.actorsUpdated.fetch_add(1, std::memory_order_relaxed);
+
         bool Water_Walk = supertypeForMonsterId(pActors[Actor_ITR].monsterInfo.id) == MONSTER_SUPERTYPE_WATER_ELEMENTAL;
 
         pActors[Actor_ITR].sectorId = 0;
@@ -2326,6 +2495,18 @@ void UpdateActors_ODM() {
 
         bool uIsAboveFloor = (pActors[Actor_ITR].pos.z > (Floor_Level + 1));
 
+        // Idle actor resting on flat land, the code below won't change anything, and won't until something wakes it up.
+        if (canActorSleep(pActors[Actor_ITR]) && pActors[Actor_ITR].speed == Vec3i() &&
+            pActors[Actor_ITR].currentActionAnimation != ANIM_Walking && !Slope_High && !uIsAboveFloor && !uIsOnWater &&
+            pActors[Actor_ITR].pos.z >= Floor_Level &&
+            !(pOutdoor->getTileAttribByPos(pActors[Actor_ITR].pos.x, pActors[Actor_ITR].pos.y) & TILE_DESC_WATER) &&
+            (pActors[Actor_ITR].donebloodsplat || (pActors[Actor_ITR].aiState != Dead && pActors[Actor_ITR].aiState != Dying))) {
+            pActors[Actor_ITR].asleep = true;
+            pActors[Actor_ITR].sleepPos = pActors[Actor_ITR].pos;
+            pActors[Actor_ITR].sleepAiState = pActors[Actor_ITR].aiState;
+            continue;
+        }
+
         // make bloodsplat when the ground is hit
         if (!pActors[Actor_ITR].donebloodsplat) {
             if (pActors[Actor_ITR].aiState == Dead || pActors[Actor_ITR].aiState == Dying) {
@@ -2384,7 +2565,7 @@ void UpdateActors_ODM() {
                 ODM_GetTerrainNormalAt(pActors[Actor_ITR].pos.x, pActors[Actor_ITR].pos.y, &Terrain_Norm);
                 uint16_t Gravity = GetGravityStrength();
 
-                pActors[Actor_ITR].speed.z += -16 * pEventTimer->dt().ticks() * Gravity;
+                pActors[Actor_ITR].speed.z += -16 * dt.ticks() * Gravity;
                 int v73 = std::abs(Terrain_Norm.x * pActors[Actor_ITR].speed.x +
                               Terrain_Norm.z * pActors[Actor_ITR].speed.z +
                               Terrain_Norm.y * pActors[Actor_ITR].speed.y) >> 15;
@@ -2395,7 +2576,7 @@ void UpdateActors_ODM() {
                 // pActors[Actor_ITR].vVelocity.z += fixpoint_mul(v73, Terrain_Norm.z);
             }
         } else {
-            pActors[Actor_ITR].speed.z -= pEventTimer->dt().ticks() * GetGravityStrength();
+            pActors[Actor_ITR].speed.z -= dt.ticks() * GetGravityStrength();
         }
 
         // ARMAGEDDON PANIC
@@ -2416,7 +2597,7 @@ void UpdateActors_ODM() {
         }
 
         // COLLISIONS
-        ProcessActorCollisionsODM(pActors[Actor_ITR], uIsFlying);
+        ProcessActorCollisionsODM(pActors[Actor_ITR], uIsFlying, dt);
 
         // WATER TILE CHECKING
         if (!Water_Walk) {
@@ -2472,6 +2653,8 @@ void UpdateActors_ODM() {
 
 //----- (0047A384) --------------------------------------------------------
 void ODM_LoadAndInitialize(const std::string &pFilename, ODMRenderParams *thisa) {
+    LoadProfilerScope profilerScope("ODM_LoadAndInitialize");
+
     MapInfo *map_info;            // edi@4
     // size_t v7;              // eax@19
 
@@ -2510,6 +2693,7 @@ void ODM_LoadAndInitialize(const std::string &pFilename, ODMRenderParams *thisa)
         }
         RespawnGlobalDecorations();
     }
+    prefetchLevelAssets();
     pOutdoor->PrepareDecorations();
     pOutdoor->ArrangeSpriteObjects();
     pOutdoor->InitalizeActors(map_id);
@@ -2557,68 +2741,6 @@ Color GetLevelFogColor() {
     return Color();
 }
 
-// TODO(pskelton): drop this
-// returns 0xZZ000000
-// basically how much fog should be applied 255-0 (no fog -> max fog)
-int sub_47C3D7_get_fog_specular(int unused, int isSky, float screen_depth) {
-    int v7;
-
-    bool isNight = pWeather->bNight;
-    if (engine->IsUnderwater()) isNight = false;
-
-    if (pParty->armageddon_timer ||
-        !(day_attrib & MAP_WEATHER_FOGGY) && !engine->IsUnderwater())
-        return 0xFF000000;
-    if (isNight) {
-        if (screen_depth < (double)day_fogrange_1) {
-            v7 = 0;
-            if (screen_depth == 0.0) v7 = 216;
-            if (isSky) v7 = 248;
-            return (255 - v7) << 24;
-        } else {
-            if (screen_depth > (double)day_fogrange_2) {
-                v7 = 216;
-                if (screen_depth == 0.0) v7 = 216;
-                if (isSky) v7 = 248;
-                return (255 - v7) << 24;
-            }
-            v7 = (int64_t)((screen_depth - (double)day_fogrange_1) /
-                                  ((double)day_fogrange_2 -
-                                   (double)day_fogrange_1) *
-                                  216.0);
-        }
-    } else {
-        if (screen_depth < (double)day_fogrange_1) {
-            // no fog
-            v7 = 0;
-            if (screen_depth == 0.0) v7 = 216;
-            if (isSky) v7 = 248;
-            return (255 - v7) << 24;
-        } else {
-            if (screen_depth > (double)day_fogrange_2) {
-                // full fog
-                v7 = 216;
-                if (screen_depth == 0.0) v7 = 216;
-                if (isSky) v7 = 248;
-                return (255 - v7) << 24;
-            } else {
-                // linear interpolation
-                v7 =
-                    floorf(((screen_depth - (double)day_fogrange_1) * 216.0 /
-                    ((double)day_fogrange_2 - (double)day_fogrange_1)) +
-                        0.5f);
-            }
-        }
-    }
-    if (v7 > 216) {
-        v7 = 216;
-    } else {
-        if (screen_depth == 0.0) v7 = 216;
-    }
-    if (isSky) v7 = 248;
-    return (255 - v7) << 24;
-}
-
 //----- (0047F44B) --------------------------------------------------------
 unsigned int WorldPosToGridCellX(int sWorldPosX) {
     return (sWorldPosX >> 9) + 64;  // sar is in original exe, resulting -880 / 512 = -1
@@ -16,6 +16,7 @@
 #include "LocationInfo.h"
 #include "LocationTime.h"
 #include "LocationFunctions.h"
+#include "ModelFaceGrid.h"
 
 class DecalBuilder;
 class SpellFxRenderer;
@@ -142,6 +143,9 @@ struct OutdoorLocation {
     OutdoorLocationTerrain pTerrain;
     std::array<uint16_t, 128 * 128> pCmap; // Unused
     std::vector<BSPModel> pBModels;
+    ModelFaceGrid modelFaceGrid; // Built on load, used to speed up collisions with models.
+    ModelFaceGrid floorFaceGrid; // Floor faces of the models on a terrain-sized grid, used by `ODM_GetFloorLevel`.
+    ModelFaceGrid ceilingFaceGrid; // Same for the ceiling faces, used by `GetCeilingHeight`.
     std::vector<Pid> pFaceIDLIST;
     std::array<uint32_t, 128 * 128> pOMAP;
     GraphicsImage *sky_texture = nullptr;        // signed int sSky_TextureID;
@@ -215,7 +219,6 @@ void sub_487DA9();
 void ODM_LoadAndInitialize(const std::string &pLevelFilename,
                            struct ODMRenderParams *thisa);
 Color GetLevelFogColor();
-int sub_47C3D7_get_fog_specular(int unused, int a2, float a3);
 unsigned int WorldPosToGridCellX(int);
 unsigned int WorldPosToGridCellY(int);
 int GridCellToWorldPosX(int);
@@ -1,53 +1,85 @@
 #include "PaletteManager.h"
 
 #include <algorithm>
+#include <optional>
 #include <string>
+#include <string_view>
 
-#include "Engine/Graphics/Texture_MM7.h"
 #include "Engine/LodTextureCache.h"
 
 #include "Library/Color/Color.h"
 #include "Library/Logger/Logger.h"
 
+#include "Utility/String.h"
 #include "Utility/Format.h"
 
 PaletteManager *pPaletteManager = new PaletteManager;
 
 void PaletteManager::load(LodTextureCache *lod) {
+    _lod = lod;
+    _indexById.fill(-1);
+    _paletteIds.clear();
+
     // Palette #0 is grayscale.
+    _indexById[0] = 0;
     _paletteIds.push_back(0);
-    _palettes.push_back(createGrayscalePalette());
 
-    // Load all other palettes.
-    for (int paletteId = 1; paletteId <= 999; paletteId++) {
-        std::string paletteName = fmt::format("pal{:03}", paletteId);
+    // Single pass over the LOD index, palettes are named "palXXX". Ids come out sorted since `ls` is sorted.
+    for (const std::string &name : lod->ls()) {
+        if (name.size() != 6 || !iequals(std::string_view(name).substr(0, 3), "pal") ||
+            !std::all_of(name.begin() + 3, name.end(), [](char c) { return c >= '0' && c <= '9'; }))
+            continue;
 
-        Texture_MM7 *texture = lod->loadTexture(paletteName, false);
-        if (!texture)
+        int paletteId = std::stoi(name.substr(3));
+        if (paletteId == 0 || _indexById[paletteId] != -1)
             continue;
 
+        _indexById[paletteId] = _paletteIds.size();
         _paletteIds.push_back(paletteId);
-        _palettes.push_back(createLoadedPalette(texture->palette));
-
-        texture->Release();
     }
+
+    _palettes.assign(_paletteIds.size(), Palette());
+    _loaded.assign(_paletteIds.size(), false);
+    _palettes[0] = createGrayscalePalette();
+    _loaded[0] = true;
+    _dirtyBegin = 0;
+    _dirtyEnd = 1;
 }
 
 int PaletteManager::paletteIndex(int paletteId) {
-    auto pos = std::lower_bound(_paletteIds.begin(), _paletteIds.end(), paletteId);
-
-    if (pos == _paletteIds.end() || *pos != paletteId) {
+    int index = paletteId >= 0 && paletteId <= MAX_PALETTE_ID ? _indexById[paletteId] : -1;
+    if (index == -1) {
         logger->warning("Palette {} doesn't exist. Returning index to grayscale!", paletteId);
         return 0;
     }
 
-    return pos - _paletteIds.begin();
+    if (!_loaded[index]) {
+        _loaded[index] = true;
+
+        if (std::optional<Palette> palette = _lod->loadPalette(fmt::format("pal{:03}", paletteId))) {
+            _palettes[index] = createLoadedPalette(*palette);
+        } else {
+            logger->warning("Couldn't load palette {}, using grayscale instead!", paletteId);
+            _palettes[index] = _palettes[0];
+        }
+
+        _dirtyBegin = _dirtyBegin == _dirtyEnd ? index : std::min(_dirtyBegin, index);
+        _dirtyEnd = std::max(_dirtyEnd, index + 1);
+    }
+
+    return index;
 }
 
 std::span<Color> PaletteManager::paletteData() {
     return {_palettes[0].colors.data(), _palettes.size() * _palettes[0].colors.size()};
 }
 
+std::pair<int, int> PaletteManager::takeDirtyRange() {
+    std::pair<int, int> result(_dirtyBegin, _dirtyEnd);
+    _dirtyBegin = _dirtyEnd = 0;
+    return result;
+}
+
 Palette PaletteManager::createGrayscalePalette() {
     Palette result;
     for (int i = 0; i < 256; i++)
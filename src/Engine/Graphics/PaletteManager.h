@@ -2,17 +2,29 @@
 
 #include <span>
 #include <array>
+#include <utility>
 #include <vector>
 
 #include "Library/Image/Palette.h"
 
 class LodTextureCache;
 
+/**
+ * Palettes are discovered from the LOD index in `load`, but are only decoded on the first `paletteIndex` call that
+ * asks for them. Unused palettes take no memory beyond their slot in `paletteData`.
+ *
+ * Palette indices are assigned in `load`, in palette id order, and thus don't depend on the order in which palettes
+ * are first used.
+ */
 class PaletteManager {
  public:
+    static constexpr int MAX_PALETTE_ID = 999;
+
     void load(LodTextureCache *lod);
 
     /**
+     * Decodes the palette if it wasn't used before.
+     *
      * @param paletteId                 Palette identifier, a number in [0, 999].
      * @return                          Index for the provided palette identifier. Returned index can then be used
      *                                  for getting palette data from the return value of `paletteData` function.
@@ -20,17 +32,32 @@ class PaletteManager {
     int paletteIndex(int paletteId);
 
     /**
-     * @return                          Span containing contiguous data for all loaded palettes.
+     * @return                          Span containing contiguous data for all palettes. Palettes that weren't
+     *                                  decoded yet are zero-filled.
      */
     std::span<Color> paletteData();
 
+    /**
+     * Returns the range of palette indices that were decoded since the last call, and resets it. Used for
+     * incremental updates of GPU-side palette data.
+     *
+     * @return                          Half-open `[begin, end)` range of palette indices, empty if no new palettes
+     *                                  were decoded.
+     */
+    std::pair<int, int> takeDirtyRange();
+
  private:
     static Palette createGrayscalePalette();
     static Palette createLoadedPalette(const Palette &palette);
 
  private:
+    LodTextureCache *_lod = nullptr;
+    std::array<int, MAX_PALETTE_ID + 1> _indexById = {}; // -1 for palettes not in the LOD.
     std::vector<int> _paletteIds;
     std::vector<Palette> _palettes;
+    std::vector<bool> _loaded;
+    int _dirtyBegin = 0;
+    int _dirtyEnd = 0;
 };
 
 extern PaletteManager *pPaletteManager;
@@ -1,5 +1,9 @@
 #include "Engine/Graphics/ParticleEngine.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "Engine/Engine.h"
 #include "Engine/Graphics/Camera.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
 #include "Engine/Random/Random.h"
@@ -7,6 +11,8 @@
 #include "Engine/OurMath.h"
 #include "Engine/Time/Timer.h"
 
+#include "Library/Profiler/Profiler.h"
+
 #include "Utility/Math/TrigLut.h"
 
 #include "Outdoor.h"
@@ -51,55 +57,51 @@ ParticleEngine::ParticleEngine() {
 }
 
 void ParticleEngine::ResetParticles() {
-    pParticles.fill({});
-    uStartParticle = PARTICLES_ARRAY_SIZE;
-    uEndParticle = 0;
+    _type.clear();
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _shiftX.clear();
+    _shiftY.clear();
+    _shiftZ.clear();
+    _timeToLive.clear();
+    _angle.clear();
+    _rotationSpeed.clear();
+    _size.clear();
+    _color.clear();
+    _lightColor.clear();
+    _texture.clear();
+    _paletteId.clear();
+    _visible.clear();
     uTimeElapsed = 0_ticks;
 }
 
 void ParticleEngine::AddParticle(Particle_sw *particle) {
-    if (!pMiscTimer->isPaused()) {
-        Particle *freeParticle = nullptr;
-
-        for (int i = 0; i < pParticles.size(); i++) {
-            if (pParticles[i].type == ParticleType_Invalid) {
-                if (i < this->uStartParticle) {
-                    this->uStartParticle = i;
-                }
-                if (i > this->uEndParticle) {
-                    this->uEndParticle = i;
-                }
-                freeParticle = &pParticles[i];
-                break;
-            }
-        }
+    if (pMiscTimer->isPaused())
+        return;
 
-        if (freeParticle) {
-            freeParticle->type = particle->type;
-            freeParticle->x = particle->x;
-            freeParticle->y = particle->y;
-            freeParticle->z = particle->z;
-            freeParticle->_x = particle->x;
-            freeParticle->_y = particle->y;
-            freeParticle->_z = particle->z;
-            freeParticle->shift_x = particle->r; // TODO: seems Particle_sw struct fields are mixed up here
-            freeParticle->shift_y = particle->g;
-            freeParticle->shift_z = particle->b;
-            freeParticle->uParticleColor = particle->uDiffuse;
-            freeParticle->uLightColor_bgr = particle->uDiffuse;
-            // v6 = (v4->uType & 4) == 0;
-            freeParticle->timeToLive = particle->timeToLive;
-            freeParticle->texture = particle->texture;
-            freeParticle->paletteID = particle->paletteID;
-            freeParticle->particle_size = particle->particle_size;
-            if (freeParticle->type & ParticleType_Rotating) {
-                freeParticle->rotation_speed = vrng->random(256) - 128;
-                freeParticle->angle = vrng->random(TrigLUT.uIntegerDoublePi);
-            } else {
-                freeParticle->rotation_speed = 0;
-                freeParticle->angle = 0;
-            }
-        }
+    if (size() >= engine->config->graphics.MaxParticles.value() * engine->qualityGovernor.particleScale())
+        return;
+
+    _type.push_back(particle->type);
+    _x.push_back(particle->x);
+    _y.push_back(particle->y);
+    _z.push_back(particle->z);
+    _shiftX.push_back(particle->r); // TODO: seems Particle_sw struct fields are mixed up here
+    _shiftY.push_back(particle->g);
+    _shiftZ.push_back(particle->b);
+    _timeToLive.push_back(particle->timeToLive.ticks());
+    _color.push_back(particle->uDiffuse);
+    _lightColor.push_back(particle->uDiffuse);
+    _texture.push_back(particle->texture);
+    _paletteId.push_back(particle->paletteID);
+    _size.push_back(particle->particle_size);
+    if (particle->type & ParticleType_Rotating) {
+        _rotationSpeed.push_back(vrng->random(256) - 128);
+        _angle.push_back(vrng->random(TrigLUT.uIntegerDoublePi));
+    } else {
+        _rotationSpeed.push_back(0);
+        _angle.push_back(0);
     }
 }
 
@@ -114,8 +116,7 @@ void ParticleEngine::Draw() {
 }
 
 void ParticleEngine::UpdateParticles() {
-    unsigned uCurrentEnd = 0;
-    unsigned uCurrentBegin = PARTICLES_ARRAY_SIZE;
+    OE_PROFILE_ZONE("particles");
 
     // TODO(captainurist): checking pMiscTimer->isPaused(), then using pEventTimer->uTimeElapsed?
     Duration time = !pMiscTimer->isPaused() ? pEventTimer->dt() : 0_ticks;
@@ -124,110 +125,135 @@ void ParticleEngine::UpdateParticles() {
         return;
     }
 
-    for (unsigned int i = uStartParticle; i <= uEndParticle; ++i) {
-        Particle *p = &pParticles[i];
-
-        if (p->type == ParticleType_Invalid) {
-            continue;
-        }
-
-        if (p->timeToLive <= time) {
-            p->timeToLive = 0_ticks;
-            p->type = ParticleType_Invalid;
-            continue;
-        }
+    removeDeadParticles(time);
 
-        p->timeToLive -= time;
+    const int64_t ticks = time.ticks();
+    const size_t count = size();
 
-        // Line particle type appear unused
-        if (p->type & ParticleType_Line) {
-            p->_x = p->x;
-            p->_y = p->y;
-            p->_z = p->z;
-        }
+    for (size_t i = 0; i < count; i++)
+        _timeToLive[i] -= ticks;
 
-        // Dropping particles drop downward with acceleration
-        if (p->type & ParticleType_Dropping) {
-            p->shift_z -= time.ticks() * 5.0;
-        }
+    // Dropping particles drop downward with acceleration
+    for (size_t i = 0; i < count; i++)
+        if (_type[i] & ParticleType_Dropping)
+            _shiftZ[i] -= ticks * 5.0;
 
-        // Ascending particles slowly float upward
-        if (p->type & ParticleType_Ascending) {
-            p->x += (vrng->random(5) - 2) * time.ticks() / 16.0;
-            p->y += (vrng->random(5) - 2) * time.ticks() / 16.0;
-            p->z += (vrng->random(5) + 4) * time.ticks() / 16.0;
+    // Ascending particles slowly float upward. This is the only loop that touches the rng, and it goes through the
+    // particles in order, so the rng sequence doesn't depend on how the other loops are organized.
+    for (size_t i = 0; i < count; i++) {
+        if (_type[i] & ParticleType_Ascending) {
+            _x[i] += (vrng->random(5) - 2) * ticks / 16.0;
+            _y[i] += (vrng->random(5) - 2) * ticks / 16.0;
+            _z[i] += (vrng->random(5) + 4) * ticks / 16.0;
         }
+    }
 
-        // v9 = (signed int)(time * p->rotation_speed) / 16;
-
-        // Particle shift with time
-        double shift = time.ticks() / 128.0f;
-        p->x += shift * p->shift_x;
-        p->y += shift * p->shift_y;
-        p->z += shift * p->shift_z;
-
-        p->angle += time.ticks() * p->rotation_speed / 16;
+    // Particle shift with time
+    double shift = ticks / 128.0f;
+    for (size_t i = 0; i < count; i++) {
+        _x[i] += shift * _shiftX[i];
+        _y[i] += shift * _shiftY[i];
+        _z[i] += shift * _shiftZ[i];
+        _angle[i] += ticks * _rotationSpeed[i] / 16;
+    }
 
-        // With time particles become more transparent
-        int dissipate_value = 2 * p->timeToLive.ticks();
-        if (dissipate_value >= 255) {
-            dissipate_value = 255;
-        }
+    // With time particles become more transparent
+    for (size_t i = 0; i < count; i++) {
+        int dissipate_value = std::min<int64_t>(2 * _timeToLive[i], 255);
         float dissipate_factor = dissipate_value / 255.0f;
-        // v10 = (double)v22 * 0.0039215689;
         // TODO(Nik-RE-dev): check colour format use in particles
-        p->uLightColor_bgr = Color(floorf(p->uParticleColor.r * dissipate_factor + 0.5),
-                                   floorf(p->uParticleColor.g * dissipate_factor + 0.5),
-                                   floorf(p->uParticleColor.b * dissipate_factor + 0.5));
-
-        if (i < uCurrentBegin) {
-           uCurrentBegin = i;
-        }
-        if (i > uCurrentEnd) {
-           uCurrentEnd = i;
-        }
+        _lightColor[i] = Color(floorf(_color[i].r * dissipate_factor + 0.5),
+                               floorf(_color[i].g * dissipate_factor + 0.5),
+                               floorf(_color[i].b * dissipate_factor + 0.5));
     }
-
-    uEndParticle = uCurrentEnd;
-    uStartParticle = uCurrentBegin;
 }
 
-bool ParticleEngine::ViewProject_TrueIfStillVisible_BLV(unsigned int uParticleID) {
-    Particle *pParticle;  // esi@1
-    int y_int_;           // [sp+10h] [bp-40h]@2
-    int x_int;            // [sp+20h] [bp-30h]@2
-    int z_int_;           // [sp+24h] [bp-2Ch]@2
-
-    pParticle = &this->pParticles[uParticleID];
-    if (pParticle->type == ParticleType_Invalid) return 0;
-    // uParticleID = LODWORD(pParticle->x);
-    // v56 = *(float *)&uParticleID + 6.7553994e15;
-    x_int = floorf(pParticle->x + 0.5f);
-    // uParticleID = LODWORD(pParticle->y);
-    // y_int_ = *(float *)&uParticleID + 6.7553994e15;
-    y_int_ = floorf(pParticle->y + 0.5f);
-    // uParticleID = LODWORD(pParticle->z);
-    // z_int_ = *(float *)&uParticleID + 6.7553994e15;
-    z_int_ = floorf(pParticle->z + 0.5f);
-
-    /*fixed x, y, z;*/
-    int xt, yt, zt;
-
-    if (!pCamera3D->ViewClip(x_int, y_int_, z_int_, &xt, &yt, &zt, 0)) return false;
-    pCamera3D->Project(xt, yt, zt, &pParticle->uScreenSpaceX, &pParticle->uScreenSpaceY);
+void ParticleEngine::removeDeadParticles(Duration time) {
+    // Stable compaction, so that the particles stay in the order they were added.
+    const int64_t ticks = time.ticks();
+    size_t j = 0;
+    for (size_t i = 0; i < size(); i++) {
+        if (_timeToLive[i] <= ticks)
+            continue;
 
-    pParticle->fov_x = pCamera3D->ViewPlaneDistPixels;
+        if (i != j) {
+            _type[j] = _type[i];
+            _x[j] = _x[i];
+            _y[j] = _y[i];
+            _z[j] = _z[i];
+            _shiftX[j] = _shiftX[i];
+            _shiftY[j] = _shiftY[i];
+            _shiftZ[j] = _shiftZ[i];
+            _timeToLive[j] = _timeToLive[i];
+            _angle[j] = _angle[i];
+            _rotationSpeed[j] = _rotationSpeed[i];
+            _size[j] = _size[i];
+            _color[j] = _color[i];
+            _lightColor[j] = _lightColor[i];
+            _texture[j] = _texture[i];
+            _paletteId[j] = _paletteId[i];
+        }
+        j++;
+    }
 
-    /*pParticle->screenspace_scale = fixed::FromFloat(pParticle->particle_size) *
-                                   fixed::FromFloat(pParticle->fov_x) / x;*/
+    _type.resize(j);
+    _x.resize(j);
+    _y.resize(j);
+    _z.resize(j);
+    _shiftX.resize(j);
+    _shiftY.resize(j);
+    _shiftZ.resize(j);
+    _timeToLive.resize(j);
+    _angle.resize(j);
+    _rotationSpeed.resize(j);
+    _size.resize(j);
+    _color.resize(j);
+    _lightColor.resize(j);
+    _texture.resize(j);
+    _paletteId.resize(j);
+}
 
-    pParticle->screenspace_scale = /*fixed::FromFloat*/(pParticle->particle_size) *
-        /*fixed::FromFloat*/(pParticle->fov_x) / /*fixed::FromInt*/(xt);
+void ParticleEngine::ViewProjectParticles() {
+    const size_t count = size();
 
-    /*pParticle->zbuffer_depth = x.GetInt();*/
-    pParticle->zbuffer_depth = xt;
+    // World positions are snapped to integers, and so are the view space positions, like in `Camera3D::ViewClip`.
+    _viewVertices.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        _viewVertices[i].vWorldPosition.x = static_cast<int>(floorf(_x[i] + 0.5f));
+        _viewVertices[i].vWorldPosition.y = static_cast<int>(floorf(_y[i] + 0.5f));
+        _viewVertices[i].vWorldPosition.z = static_cast<int>(floorf(_z[i] + 0.5f));
+    }
+    pCamera3D->ViewTransform(_viewVertices.data(), count);
+
+    float nearClip = pCamera3D->GetNearClip();
+    float farClip = pCamera3D->GetFarClip();
+    _visible.clear();
+    for (size_t i = 0; i < count; i++) {
+        RenderVertexSoft &v = _viewVertices[i];
+        v.vWorldViewPosition.x = static_cast<int>(std::round(v.vWorldViewPosition.x + 0.5f));
+        v.vWorldViewPosition.y = static_cast<int>(std::round(v.vWorldViewPosition.y + 0.5f));
+        v.vWorldViewPosition.z = static_cast<int>(std::round(v.vWorldViewPosition.z + 0.5f));
+        if (v.vWorldViewPosition.x >= nearClip && v.vWorldViewPosition.x <= farClip) {
+            _viewVertices[_visible.size()] = v;
+            _visible.push_back(i);
+        }
+    }
 
-    return true;
+    const size_t visibleCount = _visible.size();
+    pCamera3D->Project(_viewVertices.data(), visibleCount, false);
+
+    _screenX.resize(visibleCount);
+    _screenY.resize(visibleCount);
+    _depth.resize(visibleCount);
+    _screenScale.resize(visibleCount);
+    for (size_t k = 0; k < visibleCount; k++) {
+        const RenderVertexSoft &v = _viewVertices[k];
+        int xt = v.vWorldViewPosition.x;
+        _screenX[k] = floorf(v.vWorldViewProjX + 0.5f);
+        _screenY[k] = floorf(v.vWorldViewProjY + 0.5f);
+        _screenScale[k] = _size[_visible[k]] * pCamera3D->ViewPlaneDistPixels / xt;
+        _depth[k] = static_cast<short>(xt);
+    }
 }
 
 void ParticleEngine::DrawParticles_BLV() {
@@ -235,80 +261,52 @@ void ParticleEngine::DrawParticles_BLV() {
 
     v15.sParentBillboardID = -1;
 
-    for (unsigned int i = uStartParticle; i <= uEndParticle; ++i) {
-        Particle *p = &pParticles[i];
+    ViewProjectParticles();
 
-        if (p->type == ParticleType_Invalid) continue;
+    render->BeginBillboardBatch();
+    for (size_t k = 0; k < _visible.size(); ++k) {
+        int i = _visible[k];
+        ParticleFlags type = _type[i];
 
-        if (!ViewProject_TrueIfStillVisible_BLV(i)) continue;
-
-        // TODO(pskelton): reinstate this guard check
+        // TODO(pskelton): reinstate viewport guard check
         // TODO(Nik-RE-dev): all types except for Line appear to behave identically
-        if (true) {
-            /*p->uScreenSpaceX >= pBLVRenderParams->uViewportX &&
-            p->uScreenSpaceX < pBLVRenderParams->uViewportZ &&
-            p->uScreenSpaceY >= pBLVRenderParams->uViewportY &&
-            p->uScreenSpaceY < pBLVRenderParams->uViewportW) { */
-            if (p->type & ParticleType_Diffuse) {
-                // v14 = &pParticles[i];
-                v15.screenspace_projection_factor_x = p->screenspace_scale;
-                v15.screenspace_projection_factor_y = p->screenspace_scale;
-                v15.screen_space_x = p->uScreenSpaceX;
-                v15.screen_space_y = p->uScreenSpaceY;
-                v15.screen_space_z = p->zbuffer_depth;
-                v15.paletteID = p->paletteID;
-                render->MakeParticleBillboardAndPush(
-                    &v15, 0, p->uLightColor_bgr, p->angle);
-            } else if (p->type & ParticleType_Line) {  // type doesnt appear to be used
-                if (pLines.uNumLines < 100) {
-                    pLines.pLineVertices[2 * pLines.uNumLines].pos.x =
-                        p->uScreenSpaceX;
-                    pLines.pLineVertices[2 * pLines.uNumLines].pos.y =
-                        p->uScreenSpaceY;
-                    pLines.pLineVertices[2 * pLines.uNumLines].pos.z =
-                        1.0 - 1.0 / (p->zbuffer_depth * 0.061758894);
-                    pLines.pLineVertices[2 * pLines.uNumLines].rhw = 1.0;
-                    pLines.pLineVertices[2 * pLines.uNumLines].diffuse =
-                        p->uLightColor_bgr;
-                    pLines.pLineVertices[2 * pLines.uNumLines].specular = Color();
-                    pLines.pLineVertices[2 * pLines.uNumLines].texcoord.x = 0.0;
-                    pLines.pLineVertices[2 * pLines.uNumLines].texcoord.y = 0.0;
-
-                    pLines.pLineVertices[2 * pLines.uNumLines + 1].pos.x =
-                        p->uScreenSpaceZ;  // where is this set?
-                    pLines.pLineVertices[2 * pLines.uNumLines + 1].pos.y =
-                        p->uScreenSpaceW;
-                    pLines.pLineVertices[2 * pLines.uNumLines + 1].pos.z =
-                        1.0 - 1.0 / ((short)p->sZValue2 * 0.061758894);
-                    pLines.pLineVertices[2 * pLines.uNumLines + 1].rhw = 1.0;
-                    pLines.pLineVertices[2 * pLines.uNumLines + 1].diffuse =
-                        p->uLightColor_bgr;
-                    pLines.pLineVertices[2 * pLines.uNumLines + 1].specular = Color();
-                    pLines.pLineVertices[2 * pLines.uNumLines + 1].texcoord.x =
-                        0.0;
-                    pLines.pLineVertices[2 * pLines.uNumLines++ + 1]
-                        .texcoord.y = 0.0;
-                }
-            } else if (p->type & ParticleType_Bitmap) {
-                v15.screenspace_projection_factor_x = p->screenspace_scale;
-                v15.screenspace_projection_factor_y = p->screenspace_scale;
-                v15.screen_space_x = p->uScreenSpaceX;
-                v15.screen_space_y = p->uScreenSpaceY;
-                v15.screen_space_z = p->zbuffer_depth;
-                v15.paletteID = p->paletteID;
-                render->MakeParticleBillboardAndPush(
-                    &v15, p->texture, p->uLightColor_bgr, p->angle);
-            } else if (p->type & ParticleType_Sprite) {
-                v15.screenspace_projection_factor_x = p->screenspace_scale;
-                v15.screenspace_projection_factor_y = p->screenspace_scale;
-                v15.screen_space_x = p->uScreenSpaceX;
-                v15.screen_space_y = p->uScreenSpaceY;
-                v15.screen_space_z = p->zbuffer_depth;
-                v15.paletteID = p->paletteID;
-                render->MakeParticleBillboardAndPush(
-                    &v15, p->texture, p->uLightColor_bgr, p->angle);
+        auto pushBillboard = [&](GraphicsImage *texture) {
+            v15.screenspace_projection_factor_x = _screenScale[k];
+            v15.screenspace_projection_factor_y = _screenScale[k];
+            v15.screen_space_x = _screenX[k];
+            v15.screen_space_y = _screenY[k];
+            v15.screen_space_z = _depth[k];
+            v15.paletteID = _paletteId[i];
+            render->MakeParticleBillboardAndPush(&v15, texture, _lightColor[i], _angle[i]);
+        };
+
+        if (type & ParticleType_Diffuse) {
+            pushBillboard(nullptr);
+        } else if (type & ParticleType_Line) {  // type doesnt appear to be used
+            if (pLines.uNumLines < 100) {
+                RenderVertexD3D3 *line = &pLines.pLineVertices[2 * pLines.uNumLines++];
+                line[0].pos.x = _screenX[k];
+                line[0].pos.y = _screenY[k];
+                line[0].pos.z = 1.0 - 1.0 / (_depth[k] * 0.061758894);
+                line[0].rhw = 1.0;
+                line[0].diffuse = _lightColor[i];
+                line[0].specular = Color();
+                line[0].texcoord.x = 0.0;
+                line[0].texcoord.y = 0.0;
+
+                // Line end point was never set in the original code.
+                line[1].pos.x = 0;
+                line[1].pos.y = 0;
+                line[1].pos.z = 1.0 - 1.0 / (0 * 0.061758894);
+                line[1].rhw = 1.0;
+                line[1].diffuse = _lightColor[i];
+                line[1].specular = Color();
+                line[1].texcoord.x = 0.0;
+                line[1].texcoord.y = 0.0;
             }
+        } else if (type & (ParticleType_Bitmap | ParticleType_Sprite)) {
+            pushBillboard(_texture[i]);
         }
     }
+    render->EndBillboardBatch();
 }
-
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <vector>
 
 #include "Engine/Graphics/RenderEntities.h"
 #include "Engine/Time/Duration.h"
@@ -45,46 +47,25 @@ struct Particle_sw {
     int field_38[12]{};
 };
 
-struct Particle {
-    ParticleFlags type = ParticleType_Invalid;
-    float x = 0;
-    float y = 0;
-    float z = 0;
-    float shift_x = 0;
-    float shift_y = 0;
-    float shift_z = 0;
-    Color uParticleColor;
-    Duration timeToLive;
-    GraphicsImage *texture = nullptr;  // unsigned int resource_id;// bitmap IDirect3DTexture
-                       // idx or sprite idx depending on type
-    int paletteID = 0;
-    float particle_size = 0;  // field_28
-    float _x = 0;
-    float _y = 0;
-    float _z = 0;
-    int rotation_speed = 0;
-    int angle = 0;
-    int uScreenSpaceX = 0;
-    int uScreenSpaceY = 0;
-    int uScreenSpaceZ = 0;  // line end x
-    int uScreenSpaceW = 0;  // line end y
-    short zbuffer_depth;
-    int sZValue2 = 0;             // line end z
-    float screenspace_scale = 1.0;  // fixed screenspace_scale {};  // int _screenspace_scale;
-    float fov_x = 0;
-    Color uLightColor_bgr;
-};
-
 struct stru2_LineList {
     unsigned int uNumLines = 0;
     RenderVertexD3D3 pLineVertices[48] {};
     char field_604[60] {};
 };
 
+/**
+ * Particle store & simulation.
+ *
+ * Particles are stored as a structure of arrays, with all live particles packed at the start of the arrays in the
+ * order they were added. This keeps the update & projection loops tight and vectorizable, and keeps the results
+ * deterministic - particles are always processed in the same order, so the visual rng is consumed in the same order
+ * too.
+ *
+ * Max number of live particles is set by the `graphics.max_particles` config entry, new particles are dropped once
+ * the limit is reached.
+ */
 class ParticleEngine {
  public:
-    static const int PARTICLES_ARRAY_SIZE = 500;
-
     /**
      * Particle engine constructor.
      *
@@ -122,22 +103,56 @@ class ParticleEngine {
     void UpdateParticles();
 
     /**
+     * Projects all particles into screen space & fills `_visible` with indices of the particles that are in front of
+     * the camera.
+     *
      * @offset 0x48AE74
      */
-    bool ViewProject_TrueIfStillVisible_BLV(unsigned int uParticleID);
+    void ViewProjectParticles();
 
     /**
      * @offset 0x48BBA6
      */
     void DrawParticles_BLV();
 
-    std::array<Particle, PARTICLES_ARRAY_SIZE> pParticles;
+    /**
+     * @return                          Number of live particles.
+     */
+    [[nodiscard]] size_t size() const {
+        return _type.size();
+    }
+
     stru2_LineList pLines;
-    char field_D160[4800]; // unused
-    float field_E420; // unused
-    int uStartParticle;
-    int uEndParticle;
     Duration uTimeElapsed;
+
+ private:
+    void removeDeadParticles(Duration time);
+
+ private:
+    // Particle data, one element per live particle.
+    std::vector<ParticleFlags> _type;
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _z;
+    std::vector<float> _shiftX;
+    std::vector<float> _shiftY;
+    std::vector<float> _shiftZ;
+    std::vector<int64_t> _timeToLive; // In ticks.
+    std::vector<int> _angle;
+    std::vector<int> _rotationSpeed;
+    std::vector<float> _size;
+    std::vector<Color> _color;
+    std::vector<Color> _lightColor; // Color with the dissipation applied.
+    std::vector<GraphicsImage *> _texture;
+    std::vector<int> _paletteId;
+
+    // Projection results, filled in by `ViewProjectParticles`.
+    std::vector<RenderVertexSoft> _viewVertices;
+    std::vector<int> _visible; // Indices of visible particles.
+    std::vector<int> _screenX;
+    std::vector<int> _screenY;
+    std::vector<int> _depth;
+    std::vector<float> _screenScale;
 };
 
 struct TrailParticle {
@@ -0,0 +1,118 @@
+#include "ProfilerOverlay.h"
+
+#include <nuklear_config.h> // NOLINT: not a C system header.
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Engine/Graphics/Nuklear.h"
+#include "Engine/Graphics/Renderer/Renderer.h"
+
+#include "Library/Profiler/Profiler.h"
+
+#include "Utility/Format.h"
+#include "Utility/Memory/MemoryAccounting.h"
+
+ProfilerOverlay profilerOverlay;
+
+using Milliseconds = std::chrono::duration<float, std::milli>;
+
+static float toMs(Profiler::Duration duration) {
+    return Milliseconds(duration).count();
+}
+
+static void drawFrame(nk_context *ctx, const char *title, const Profiler::Frame &frame) {
+    if (frame.index == -1)
+        return;
+
+    if (nk_tree_push_id(ctx, NK_TREE_TAB, title, NK_MAXIMIZED, static_cast<int>(reinterpret_cast<intptr_t>(title)))) {
+        nk_layout_row_dynamic(ctx, 16, 1);
+        nk_label(ctx, fmt::format("Frame {}: {:.2f} ms", frame.index, toMs(frame.duration)).c_str(), NK_TEXT_LEFT);
+
+        static const float ratios[] = {0.6f, 0.25f, 0.15f};
+        int threadId = -1;
+        for (const Profiler::FrameZone &zone : frame.zones) {
+            if (zone.threadId != threadId) {
+                threadId = zone.threadId;
+                nk_layout_row_dynamic(ctx, 16, 1);
+                nk_label(ctx, threadId == 0 ? "Main thread" : fmt::format("Thread {}", threadId).c_str(), NK_TEXT_LEFT);
+            }
+
+            nk_layout_row(ctx, NK_DYNAMIC, 16, 3, ratios);
+            nk_label(ctx, fmt::format("{:{}}{}", "", 2 * (zone.depth + 1), zone.name).c_str(), NK_TEXT_LEFT);
+            nk_label(ctx, fmt::format("{:.3f} ms", toMs(zone.duration)).c_str(), NK_TEXT_RIGHT);
+            nk_label(ctx, fmt::format("x{}", zone.count).c_str(), NK_TEXT_RIGHT);
+        }
+        nk_tree_pop(ctx);
+    }
+}
+
+static void drawMemory(nk_context *ctx) {
+    if (nk_tree_push(ctx, NK_TREE_TAB, "Memory", NK_MINIMIZED)) {
+        static const float ratios[] = {0.4f, 0.2f, 0.2f, 0.2f};
+        auto drawRow = [&](const char *name, const MemoryTagStats &stats) {
+            nk_layout_row(ctx, NK_DYNAMIC, 16, 4, ratios);
+            nk_label(ctx, name, NK_TEXT_LEFT);
+            nk_label(ctx, fmt::format("{} KiB", stats.size / 1024).c_str(), NK_TEXT_RIGHT);
+            nk_label(ctx, fmt::format("{} KiB", stats.peakSize / 1024).c_str(), NK_TEXT_RIGHT);
+            nk_label(ctx, fmt::format("x{}", stats.allocationCount).c_str(), NK_TEXT_RIGHT);
+        };
+
+        for (MemoryTag tag : allMemoryTags())
+            drawRow(displayName(tag), MemoryAccounting::stats(tag));
+        drawRow("Heap total", MemoryAccounting::heapStats());
+
+        nk_layout_row_dynamic(ctx, 20, 1);
+        if (nk_button_label(ctx, "Reset peaks"))
+            MemoryAccounting::resetPeaks();
+        nk_tree_pop(ctx);
+    }
+}
+
+void ProfilerOverlay::draw(nk_context *ctx) {
+    if (!profiler || !ctx)
+        return;
+
+    nk_flags flags = NK_WINDOW_BORDER | NK_WINDOW_TITLE | NK_WINDOW_MOVABLE | NK_WINDOW_SCALABLE |
+                     NK_WINDOW_MINIMIZABLE;
+    if (nk_begin(ctx, "Profiler", nk_rect(8, 8, 360, 480), flags)) {
+        const std::vector<Profiler::Duration> &history = profiler->frameHistory();
+
+        Profiler::Duration total = {};
+        Profiler::Duration max = {};
+        for (Profiler::Duration duration : history) {
+            total += duration;
+            max = std::max(max, duration);
+        }
+        float avgMs = history.empty() ? 0.0f : toMs(total) / history.size();
+
+        nk_layout_row_dynamic(ctx, 16, 1);
+        std::string summary = fmt::format("Avg {:.2f} ms, max {:.2f} ms over {} frames", avgMs, toMs(max), history.size());
+        nk_label(ctx, summary.c_str(), NK_TEXT_LEFT);
+        if (profiler->droppedZoneCount() > 0)
+            nk_label(ctx, fmt::format("Dropped zones: {}", profiler->droppedZoneCount()).c_str(), NK_TEXT_LEFT);
+
+        nk_layout_row_dynamic(ctx, 60, 1);
+        if (nk_chart_begin(ctx, NK_CHART_COLUMN, history.size(), 0.0f, std::max(toMs(max), 1.0f))) {
+            for (Profiler::Duration duration : history)
+                nk_chart_push(ctx, toMs(duration));
+            nk_chart_end(ctx);
+        }
+
+        drawFrame(ctx, "Last frame", profiler->lastFrame());
+        drawFrame(ctx, "Last spike", profiler->lastSpike());
+        drawMemory(ctx);
+    }
+    nk_end(ctx);
+}
+
+void ProfilerOverlay::flush(nk_context *ctx) {
+    if (!profiler || !ctx || !ctx->begin)
+        return; // Nothing to render, or the lua UI has already rendered everything.
+
+    // If the present & render dimensions differ, nuklear is rendered in `Present`.
+    if (render->GetPresentDimensions() == render->GetRenderDimensions())
+        render->NuklearRender(NK_ANTI_ALIASING_ON, NUKLEAR_MAX_VERTEX_MEMORY, NUKLEAR_MAX_ELEMENT_MEMORY);
+}
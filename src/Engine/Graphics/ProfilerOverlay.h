@@ -0,0 +1,29 @@
+#pragma once
+
+struct nk_context;
+
+/**
+ * Nuklear overlay that shows the frame breakdown collected by the `profiler` - frame time graph, zone timings for the
+ * last frame, and zone timings for the last spike frame.
+ *
+ * Doesn't go through the lua templates, so it works regardless of what the lua UI is doing.
+ */
+class ProfilerOverlay {
+ public:
+    /**
+     * Issues the overlay draw commands into the provided nuklear context. Does nothing if there is no profiler.
+     *
+     * @param ctx                       Nuklear context to draw into.
+     */
+    void draw(nk_context *ctx);
+
+    /**
+     * Renders the overlay if it wasn't already rendered together with the lua UI. Should be called after the
+     * `NUKLEAR_STAGE_POST` draw.
+     *
+     * @param ctx                       Nuklear context that was passed to `draw`.
+     */
+    void flush(nk_context *ctx);
+};
+
+extern ProfilerOverlay profilerOverlay;
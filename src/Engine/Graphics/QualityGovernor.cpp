@@ -0,0 +1,100 @@
+#include "QualityGovernor.h"
+
+#include <algorithm>
+#include <array>
+
+struct QualityStep {
+    float weather;
+    float particles;
+    float viewDistance;
+};
+
+// Quality ladder, each step lowers a single setting. Columns further to the right have higher priority, i.e. they
+// are the last ones to go.
+static constexpr std::array<QualityStep, QualityGovernor::MAX_STEP + 1> QUALITY_STEPS = {{
+    {1.0f,  1.0f,  1.0f},
+    {0.5f,  1.0f,  1.0f},
+    {0.5f,  0.5f,  1.0f},
+    {0.25f, 0.5f,  1.0f},
+    {0.25f, 0.25f, 1.0f},
+    {0.25f, 0.25f, 0.75f},
+    {0.25f, 0.25f, 0.5f},
+}};
+
+static constexpr float SMOOTHING = 0.05f;
+static constexpr float UPPER_BAND = 1.1f; // Step down once over 110% of the target frame time.
+static constexpr float LOWER_BAND = 0.75f; // Step up once under 75%.
+static constexpr int DOWN_FRAMES = 60; // Frames over the band before stepping down.
+static constexpr int UP_FRAMES = 600; // Frames under the band before stepping up.
+static constexpr int SETTLE_FRAMES = 30;
+
+void QualityGovernor::reset() {
+    _step = 0;
+    _frameMs = 0.0f;
+    _settleFrames = SETTLE_FRAMES;
+    _overFrames = 0;
+    _underFrames = 0;
+}
+
+void QualityGovernor::setTarget(int targetFps, int maxStep) {
+    float targetMs = targetFps > 0 ? 1000.0f / targetFps : 0.0f;
+    maxStep = std::clamp(maxStep, 0, MAX_STEP);
+    if (targetMs == _targetMs && maxStep == _maxStep)
+        return;
+
+    _targetMs = targetMs;
+    _maxStep = maxStep;
+    reset();
+}
+
+int QualityGovernor::update(float frameMs) {
+    if (!isEnabled())
+        return _step;
+
+    if (_settleFrames > 0) {
+        _settleFrames--;
+        _frameMs = frameMs;
+        return _step;
+    }
+
+    _frameMs += (frameMs - _frameMs) * SMOOTHING;
+
+    if (_frameMs > _targetMs * UPPER_BAND) {
+        _underFrames = 0;
+        if (++_overFrames >= DOWN_FRAMES)
+            changeStep(_step + 1);
+    } else if (_frameMs < _targetMs * LOWER_BAND) {
+        _overFrames = 0;
+        if (++_underFrames >= UP_FRAMES)
+            changeStep(_step - 1);
+    } else {
+        _overFrames = 0;
+        _underFrames = 0;
+    }
+
+    return _step;
+}
+
+float QualityGovernor::weatherScale() const {
+    return QUALITY_STEPS[_step].weather;
+}
+
+float QualityGovernor::particleScale() const {
+    return QUALITY_STEPS[_step].particles;
+}
+
+float QualityGovernor::viewDistanceScale() const {
+    return QUALITY_STEPS[_step].viewDistance;
+}
+
+void QualityGovernor::changeStep(int step) {
+    _overFrames = 0;
+    _underFrames = 0;
+
+    step = std::clamp(step, 0, _maxStep);
+    if (step == _step)
+        return;
+
+    _step = step;
+    _settleFrames = SETTLE_FRAMES;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * Controller for the visual quality settings that can be lowered at runtime, steps through a fixed quality ladder
+ * based on frame time feedback to hold a target frame rate.
+ *
+ * Each step of the ladder lowers one more setting, in the order of priority - settings that cost the least to
+ * lose visually go first: weather density, particle density, and then view distance. Only settings that don't
+ * affect the game logic are on the ladder.
+ *
+ * The controller steps down once the smoothed frame time has been over the target for a while, and steps back up
+ * only after it's been well under the target for much longer. This is deliberately a lot slower than
+ * `DynamicResolution`, so that resolution scaling gets to handle the short spikes, and the ladder only kicks in
+ * under sustained load.
+ */
+class QualityGovernor {
+ public:
+    static constexpr int MAX_STEP = 6;
+
+    QualityGovernor() = default;
+
+    /**
+     * Resets the controller back to full quality. Settings are preserved.
+     */
+    void reset();
+
+    /**
+     * @param targetFps                 Target frame rate, zero disables the governor.
+     * @param maxStep                   Lowest quality step that the governor can go down to, in `[0, MAX_STEP]`.
+     *                                  Zero keeps full quality.
+     */
+    void setTarget(int targetFps, int maxStep);
+
+    /**
+     * Feeds the time of a frame that was rendered at the current quality step into the controller.
+     *
+     * @param frameMs                   Frame time, in milliseconds.
+     * @return                          New quality step, zero is full quality.
+     */
+    int update(float frameMs);
+
+    [[nodiscard]] int step() const {
+        return _step;
+    }
+
+    [[nodiscard]] bool isEnabled() const {
+        return _targetMs > 0.0f;
+    }
+
+    /**
+     * @return                          Multiplier for the number of weather particles, in `(0, 1]`.
+     */
+    [[nodiscard]] float weatherScale() const;
+
+    /**
+     * @return                          Multiplier for the max number of alive particles, in `(0, 1]`.
+     */
+    [[nodiscard]] float particleScale() const;
+
+    /**
+     * @return                          Multiplier for the far clip distance, in `(0, 1]`.
+     */
+    [[nodiscard]] float viewDistanceScale() const;
+
+ private:
+    void changeStep(int step);
+
+ private:
+    float _targetMs = 0.0f;
+    int _maxStep = 0;
+    int _step = 0;
+    float _frameMs = 0.0f; // Smoothed frame time.
+    int _settleFrames = 0; // Frames left to skip after a step change, until the feedback catches up.
+    int _overFrames = 0; // Frames spent over the target in a row.
+    int _underFrames = 0; // Frames spent under the target in a row.
+};
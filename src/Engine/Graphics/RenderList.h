@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Growable list for the data that's rebuilt every frame - billboards, visible BSP faces, etc.
+ *
+ * Works like an `std::vector` that never shrinks. `clear` is O(1) and keeps both the storage and the elements around,
+ * so once the list has grown to fit the busiest frame, filling it doesn't allocate anymore. New elements are
+ * value-initialized, so stale data from the previous frames never leaks through.
+ *
+ * Also tracks the high-water mark, which is useful for figuring out how big the lists actually get. Note that
+ * references to the elements are invalidated when the list grows, just like with `std::vector`.
+ *
+ * Structural changes (adding / removing elements) bump the revision number, so caches that are built on top of a
+ * render list can check whether they're still up to date.
+ */
+template<class T>
+class RenderList {
+ public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    RenderList() = default;
+
+    /**
+     * @param capacity                  Number of elements to preallocate.
+     */
+    explicit RenderList(size_t capacity) {
+        _storage.resize(capacity);
+    }
+
+    [[nodiscard]] size_t size() const {
+        return _size;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * @return                          Max number of elements that this list has ever held since it was created, or
+     *                                  since the last call to `resetHighWaterMark`.
+     */
+    [[nodiscard]] size_t highWaterMark() const {
+        return _highWaterMark;
+    }
+
+    void resetHighWaterMark() {
+        _highWaterMark = _size;
+    }
+
+    /**
+     * @return                          Revision number of this list, changes every time an element is added or
+     *                                  the list is cleared.
+     */
+    [[nodiscard]] uint64_t revision() const {
+        return _revision;
+    }
+
+    /**
+     * Removes all elements from this list. Doesn't free any memory.
+     */
+    void clear() {
+        _size = 0;
+        _revision++;
+    }
+
+    /**
+     * @return                          Reference to a newly added value-initialized element at the end of the list.
+     */
+    T &emplace_back() {
+        if (_size == _storage.size()) {
+            _storage.emplace_back();
+        } else {
+            _storage[_size] = T();
+        }
+
+        _size++;
+        _revision++;
+        _highWaterMark = std::max(_highWaterMark, _size);
+        return _storage[_size - 1];
+    }
+
+    void push_back(const T &value) {
+        emplace_back() = value;
+    }
+
+    /**
+     * Inserts a new value-initialized element at the given position, shifting all the elements after it.
+     *
+     * @param index                     Position to insert at, must not be greater than `size()`.
+     * @return                          Reference to the newly inserted element.
+     */
+    T &insert(size_t index) {
+        assert(index <= _size);
+
+        emplace_back();
+        std::rotate(begin() + index, end() - 1, end());
+        return _storage[index];
+    }
+
+    [[nodiscard]] T &operator[](size_t index) {
+        assert(index < _size);
+        return _storage[index];
+    }
+
+    [[nodiscard]] const T &operator[](size_t index) const {
+        assert(index < _size);
+        return _storage[index];
+    }
+
+    [[nodiscard]] T &back() {
+        assert(_size > 0);
+        return _storage[_size - 1];
+    }
+
+    [[nodiscard]] const T &back() const {
+        assert(_size > 0);
+        return _storage[_size - 1];
+    }
+
+    [[nodiscard]] iterator begin() {
+        return _storage.data();
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return _storage.data();
+    }
+
+    [[nodiscard]] iterator end() {
+        return _storage.data() + _size;
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return _storage.data() + _size;
+    }
+
+ private:
+    std::vector<T> _storage; // Size of this vector is the capacity of the list.
+    size_t _size = 0;
+    size_t _highWaterMark = 0;
+    uint64_t _revision = 0;
+};
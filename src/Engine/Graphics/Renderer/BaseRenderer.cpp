@@ -1,11 +1,17 @@
 #include "BaseRenderer.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <utility>
+#include <vector>
 
 #include "Engine/Engine.h"
+#include "Engine/EngineCounters.h"
 #include "Engine/SpellFxRenderer.h"
 #include "Engine/Party.h"
+#include "Engine/mm7_data.h"
 #include "Engine/LodTextureCache.h"
 #include "Engine/LodSpriteCache.h"
 
@@ -13,9 +19,12 @@
 #include "Engine/Objects/SpriteObject.h"
 
 #include "Engine/Graphics/Camera.h"
+#include "Engine/Graphics/DecalBuilder.h"
 #include "Engine/Graphics/LightmapBuilder.h"
 #include "Engine/Graphics/LightsStack.h"
 #include "Engine/Graphics/Indoor.h"
+#include "Engine/Graphics/Outdoor.h"
+#include "Engine/Graphics/Polygon.h"
 #include "Engine/Graphics/BspRenderer.h"
 #include "Engine/Graphics/Sprites.h"
 #include "Engine/Graphics/Viewport.h"
@@ -40,6 +49,8 @@
 
 #include "Engine/Graphics/ImageLoader.h"
 
+#include "RenderPrepTimers.h"
+
 static Sizei outputRender = {0, 0};
 static Sizei outputPresent = {0, 0};
 
@@ -50,65 +61,59 @@ bool BaseRenderer::Initialize() {
 }
 
 unsigned int BaseRenderer::Billboard_ProbablyAddToListAndSortByZOrder(float z) {
-    if (uNumBillboardsToDraw >= 999) {
-        return 0;
+    if (_billboardBatchStart != -1) {
+        // Sorted into the list in EndBillboardBatch.
+        pBillboardRenderListD3D.emplace_back().z_order = z;
+        return pBillboardRenderListD3D.size() - 1;
     }
 
-    if (!uNumBillboardsToDraw) {
-        uNumBillboardsToDraw = 1;
-        return 0;
-    }
+    // Keep the list sorted by z, new billboard goes before all the billboards with the same z.
+    auto pos = std::lower_bound(pBillboardRenderListD3D.begin(), pBillboardRenderListD3D.end(), z,
+                                [](const RenderBillboardD3D &billboard, float z) { return billboard.z_order < z; });
+    unsigned int index = pos - pBillboardRenderListD3D.begin();
+    pBillboardRenderListD3D.insert(index);
+    return index;
+}
 
-    unsigned int v7 = 0;
-    for (int left = 0, right = uNumBillboardsToDraw; left < right;) {  // binsearch
-        v7 = left + (right - left) / 2;
-        if (z <= render->pBillboardRenderListD3D[v7].z_order)
-            right = v7;
-        else
-            left = v7 + 1;
-    }
+void BaseRenderer::BeginBillboardBatch() {
+    assert(_billboardBatchStart == -1);
+    _billboardBatchStart = pBillboardRenderListD3D.size();
+}
 
-    if (z > render->pBillboardRenderListD3D[v7].z_order) {
-        if (v7 == render->uNumBillboardsToDraw - 1) {
-            v7 = render->uNumBillboardsToDraw;
-        } else {
-            if (render->uNumBillboardsToDraw > v7) {
-                for (unsigned int i = 0; i < render->uNumBillboardsToDraw - v7; i++) {
-                    render->pBillboardRenderListD3D[render->uNumBillboardsToDraw - i] =
-                        render->pBillboardRenderListD3D[render->uNumBillboardsToDraw - (i + 1)];
-                }
-            }
-            ++v7;
-        }
-        uNumBillboardsToDraw++;
-        return v7;
-    }
+void BaseRenderer::EndBillboardBatch() {
+    assert(_billboardBatchStart != -1);
 
-    if (z <= render->pBillboardRenderListD3D[v7].z_order) {
-        if (render->uNumBillboardsToDraw > v7) {
-            for (unsigned int i = 0; i < render->uNumBillboardsToDraw - v7; i++) {
-                render->pBillboardRenderListD3D[render->uNumBillboardsToDraw - i] =
-                    render->pBillboardRenderListD3D[render->uNumBillboardsToDraw - (i + 1)];
-            }
-        }
-        uNumBillboardsToDraw++;
-        return v7;
-    }
+    RenderBillboardD3D *begin = pBillboardRenderListD3D.begin();
+    RenderBillboardD3D *mid = begin + _billboardBatchStart;
+    RenderBillboardD3D *end = pBillboardRenderListD3D.end();
+    _billboardBatchStart = -1;
+    if (mid == end)
+        return;
 
-    return v7;
+    // Inserting billboards one by one puts each of them before all the billboards with the same z, including the ones
+    // inserted earlier. So we reverse the batch & stable-sort it to get the same order within the batch, and then move
+    // it to the front so that the merge puts it before the old billboards with the same z.
+    auto zLess = [](const RenderBillboardD3D &l, const RenderBillboardD3D &r) { return l.z_order < r.z_order; };
+    std::reverse(mid, end);
+    std::stable_sort(mid, end, zLess);
+    std::rotate(begin, mid, end);
+    std::inplace_merge(begin, begin + (end - mid), end, zLess);
 }
 
 
 // TODO: Move this to sprites ?
 // combined with IndoorLocation::PrepareItemsRenderList_BLV() (0044028F)
 void BaseRenderer::DrawSpriteObjects() {
-    for (unsigned int i = 0; i < pSpriteObjects.size(); ++i) {
-        // exit if we are at max sprites
-        if (::uNumBillboardsToDraw >= 500) {
-            logger->warning("Billboards Full");
-            break;
-        }
+    std::vector<char> inFrustum;
+    if (uCurrentlyLoadedLevelType != LEVEL_INDOOR) {
+        std::vector<Vec3f> centers;
+        centers.reserve(pSpriteObjects.size());
+        for (const SpriteObject &object : pSpriteObjects)
+            centers.push_back(object.vPosition.toFloat());
+        inFrustum = CylindersInFrustum(std::move(centers), std::vector<float>(pSpriteObjects.size(), 512.0f), engine->_threadPool.get());
+    }
 
+    for (unsigned int i = 0; i < pSpriteObjects.size(); ++i) {
         SpriteObject *object = &pSpriteObjects[i];
         if (!object->uObjectDescID) {  // item probably pciked up - this also gets wiped at end of sprite anims/ particle effects
             continue;
@@ -132,7 +137,7 @@ void BaseRenderer::DrawSpriteObjects() {
             }
             if (!onlist) continue;
         } else {
-            if (!IsCylinderInFrustum(object->vPosition.toFloat(), 512.0f)) continue;
+            if (!inFrustum[i]) continue;
         }
 
         // render as sprte 500 - 9081
@@ -150,7 +155,6 @@ void BaseRenderer::DrawSpriteObjects() {
             unsigned int angle = TrigLUT.atan2(x - pCamera3D->vCameraPos.x, y - pCamera3D->vCameraPos.y);
             int octant = ((TrigLUT.uIntegerPi + (TrigLUT.uIntegerPi >> 3) + object->uFacing - angle) >> 8) & 7;
 
-            pBillboardRenderList[::uNumBillboardsToDraw].hwsprite = frame->hw_sprites[octant];
             // error catching
             if (frame->hw_sprites[octant]->texture->height() == 0 || frame->hw_sprites[octant]->texture->width() == 0) {
                 logger->trace("Trying to draw sprite with empty octant texture");
@@ -200,28 +204,28 @@ void BaseRenderer::DrawSpriteObjects() {
                         projected_x - screen_space_half_width <= (signed int)pViewport->uViewportBR_X) {
                         if (projected_y >= pViewport->uViewportTL_Y && (projected_y - screen_space_height) <= pViewport->uViewportBR_Y) {
                             object->uAttributes |= SPRITE_VISIBLE;
-                            pBillboardRenderList[::uNumBillboardsToDraw].uPaletteIndex = frame->GetPaletteIndex();
-                            pBillboardRenderList[::uNumBillboardsToDraw].uIndoorSectorID = object->uSectorID;
-                            pBillboardRenderList[::uNumBillboardsToDraw].pSpriteFrame = frame;
+                            RenderBillboard &billboard = pBillboardRenderList.emplace_back();
+                            billboard.hwsprite = frame->hw_sprites[octant];
+                            billboard.uPaletteIndex = frame->GetPaletteIndex();
+                            billboard.uIndoorSectorID = object->uSectorID;
+                            billboard.pSpriteFrame = frame;
 
-                            pBillboardRenderList[::uNumBillboardsToDraw].screenspace_projection_factor_x = billb_scale;
-                            pBillboardRenderList[::uNumBillboardsToDraw].screenspace_projection_factor_y = billb_scale;
+                            billboard.screenspace_projection_factor_x = billb_scale;
+                            billboard.screenspace_projection_factor_y = billb_scale;
 
-                            pBillboardRenderList[::uNumBillboardsToDraw].field_1E = setflags;
-                            pBillboardRenderList[::uNumBillboardsToDraw].world_x = x;
-                            pBillboardRenderList[::uNumBillboardsToDraw].world_y = y;
-                            pBillboardRenderList[::uNumBillboardsToDraw].world_z = z;
+                            billboard.field_1E = setflags;
+                            billboard.world_x = x;
+                            billboard.world_y = y;
+                            billboard.world_z = z;
 
-                            pBillboardRenderList[::uNumBillboardsToDraw].screen_space_x = projected_x;
-                            pBillboardRenderList[::uNumBillboardsToDraw].screen_space_y = projected_y;
-                            pBillboardRenderList[::uNumBillboardsToDraw].screen_space_z = view_x;
+                            billboard.screen_space_x = projected_x;
+                            billboard.screen_space_y = projected_y;
+                            billboard.screen_space_z = view_x;
 
-                            pBillboardRenderList[::uNumBillboardsToDraw].object_pid = Pid(OBJECT_Item, i);
-                            pBillboardRenderList[::uNumBillboardsToDraw].dimming_level = 0;
-                            pBillboardRenderList[::uNumBillboardsToDraw].sTintColor = Color();
+                            billboard.object_pid = Pid(OBJECT_Item, i);
+                            billboard.dimming_level = 0;
+                            billboard.sTintColor = Color();
 
-                            assert(::uNumBillboardsToDraw < 500);
-                            ++::uNumBillboardsToDraw;
                             ++uNumSpritesDrawnThisFrame;
                         }
                     }
@@ -241,14 +245,16 @@ void BaseRenderer::PrepareDecorationsRenderList_ODM() {
     Particle_sw local_0;    // [sp+Ch] [bp-98h]@7
     int v38;                // [sp+88h] [bp-1Ch]@9
 
-    for (unsigned int i = 0; i < pLevelDecorations.size(); ++i) {
-        if (::uNumBillboardsToDraw >= 500) {
-            logger->warning("Billboards Full");
-            return;
-        }
+    std::vector<Vec3f> centers;
+    centers.reserve(pLevelDecorations.size());
+    for (const LevelDecoration &decoration : pLevelDecorations)
+        centers.push_back(decoration.vPosition.toFloat());
+    std::vector<char> inFrustum = CylindersInFrustum(std::move(centers), std::vector<float>(pLevelDecorations.size(), 512.0f),
+                                                     engine->_threadPool.get());
 
+    for (unsigned int i = 0; i < pLevelDecorations.size(); ++i) {
         // view cull
-        if (!IsCylinderInFrustum(pLevelDecorations[i].vPosition.toFloat(), 512.0f)) continue;
+        if (!inFrustum[i]) continue;
 
         // LevelDecoration *decor = &pLevelDecorations[i];
         if ((!(pLevelDecorations[i].uFlags & LEVEL_DECORATION_OBELISK_CHEST) ||
@@ -337,25 +343,25 @@ void BaseRenderer::PrepareDecorationsRenderList_ODM() {
                             if (projected_x + screen_space_half_width >= (signed int)pViewport->uViewportTL_X &&
                                 projected_x - screen_space_half_width <= (signed int)pViewport->uViewportBR_X) {
                                 if (projected_y >= pViewport->uViewportTL_Y && (projected_y - screen_space_height) <= pViewport->uViewportBR_Y) {
-                                    ::uNumBillboardsToDraw++;
                                     ++uNumDecorationsDrawnThisFrame;
 
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].hwsprite = frame->hw_sprites[(int64_t)v37];
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].world_x = pLevelDecorations[i].vPosition.x;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].world_y = pLevelDecorations[i].vPosition.y;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].world_z = pLevelDecorations[i].vPosition.z;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].screen_space_x = projected_x;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].screen_space_y = projected_y;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].screen_space_z = view_x;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].screenspace_projection_factor_x = _v41;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].screenspace_projection_factor_y = _v41;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].uPaletteIndex = frame->GetPaletteIndex();
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].field_1E = v38 | 0x200;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].uIndoorSectorID = 0;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].object_pid = Pid(OBJECT_Decoration, i);
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].dimming_level = 0;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].pSpriteFrame = frame;
-                                    pBillboardRenderList[::uNumBillboardsToDraw - 1].sTintColor = Color();
+                                    RenderBillboard &billboard = pBillboardRenderList.emplace_back();
+                                    billboard.hwsprite = frame->hw_sprites[(int64_t)v37];
+                                    billboard.world_x = pLevelDecorations[i].vPosition.x;
+                                    billboard.world_y = pLevelDecorations[i].vPosition.y;
+                                    billboard.world_z = pLevelDecorations[i].vPosition.z;
+                                    billboard.screen_space_x = projected_x;
+                                    billboard.screen_space_y = projected_y;
+                                    billboard.screen_space_z = view_x;
+                                    billboard.screenspace_projection_factor_x = _v41;
+                                    billboard.screenspace_projection_factor_y = _v41;
+                                    billboard.uPaletteIndex = frame->GetPaletteIndex();
+                                    billboard.field_1E = v38 | 0x200;
+                                    billboard.uIndoorSectorID = 0;
+                                    billboard.object_pid = Pid(OBJECT_Decoration, i);
+                                    billboard.dimming_level = 0;
+                                    billboard.pSpriteFrame = frame;
+                                    billboard.sTintColor = Color();
                                 }
                             }
                         }
@@ -391,9 +397,11 @@ void BaseRenderer::TransformBillboardsAndSetPalettesODM() {
     billboard.uViewportY = pViewport->uViewportTL_Y;
     billboard.uViewportZ = pViewport->uViewportBR_X - 1;
     billboard.uViewportW = pViewport->uViewportBR_Y;
-    pODMRenderParams->uNumBillboards = ::uNumBillboardsToDraw;
+    pODMRenderParams->uNumBillboards = pBillboardRenderList.size();
+    engineCounters.billboards.fetch_add(pBillboardRenderList.size(), std::memory_order_relaxed);
 
-    for (unsigned int i = 0; i < ::uNumBillboardsToDraw; ++i) {
+    BeginBillboardBatch();
+    for (unsigned int i = 0; i < pBillboardRenderList.size(); ++i) {
         RenderBillboard *p = &pBillboardRenderList[i];
         if (p->hwsprite) {
             billboard.screen_space_x = p->screen_space_x;
@@ -411,6 +419,7 @@ void BaseRenderer::TransformBillboardsAndSetPalettesODM() {
             logger->trace("Billboard with no sprite!");
         }
     }
+    EndBillboardBatch();
 }
 
 Color BlendColors(Color a1, Color a2) {
@@ -608,7 +617,7 @@ void BaseRenderer::SavePCXScreenshot() {
 void BaseRenderer::SavePCXImage32(const std::string &filename, RgbaImageView image) {
     // TODO(pskelton): add "Screenshots" folder?
     FileOutputStream output(makeDataPath(filename));
-    output.write(pcx::encode(image).string_view());
+    output.write(pcx::encode(image, engine->_threadPool.get()).string_view());
     output.close();
 }
 
@@ -617,7 +626,7 @@ void BaseRenderer::SaveScreenshot(const std::string &filename, const unsigned in
 }
 
 Blob BaseRenderer::PackScreenshot(const unsigned int width, const unsigned int height) {
-    return pcx::encode(render->MakeScreenshot32(width, height));
+    return pcx::encode(render->MakeScreenshot32(width, height), engine->_threadPool.get());
 }
 
 GraphicsImage *BaseRenderer::TakeScreenshot(const unsigned int width, const unsigned int height) {
@@ -744,7 +753,7 @@ void BaseRenderer::PresentBlackScreen() {
 std::vector<Actor*> BaseRenderer::getActorsInViewport(int pDepth) {
     std::vector<Actor*> foundActors;
 
-    for (int i = 0; i < render->uNumBillboardsToDraw; i++) {
+    for (int i = 0; i < render->pBillboardRenderListD3D.size(); i++) {
         int renderId = render->pBillboardRenderListD3D[i].sParentBillboardID;
         if(renderId == -1) {
             continue; // E.g. spell particle.
@@ -840,3 +849,215 @@ void BaseRenderer::SaveWinnersCertificate(const std::string &filePath) {
     // reverse input and save to texture for later
     assets->winnerCert = GraphicsImage::Create(std::move(sPixels));
 }
+
+void BaseRenderer::StackTerrainDecals() {
+    // TODO(pskelton): clean up and move to seperate function in decal builder
+    if (!decal_builder->bloodsplat_container->uNumBloodsplats) return;
+    unsigned int NumBloodsplats = decal_builder->bloodsplat_container->uNumBloodsplats;
+
+    RenderPrepTimerScope timer(RENDER_PREP_DECALS);
+
+    auto terrainVertex = [](int x, int y) {
+        return Vec3f((-64.0f + x) * 512, (64.0f - y) * 512, 32 * pOutdoor->pTerrain.pHeightmap[y * 128 + x]);
+    };
+
+    // loop over blood to lay
+    for (unsigned i = 0; i < NumBloodsplats; ++i) {
+        // approx location of bloodsplat
+        int splatx = decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].pos.x;
+        int splaty = decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].pos.y;
+        int testx = WorldPosToGridCellX(splatx);
+        int testy = WorldPosToGridCellY(splaty);
+        // use terrain squares in block surrounding to try and stack faces
+
+        int scope = std::ceil(decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].radius / 512);
+
+        for (int loopy = (testy - scope); loopy <= (testy + scope); ++loopy) {
+            for (int loopx = (testx - scope); loopx <= (testx + scope); ++loopx) {
+                // map is 127 x 127 squares
+                if (loopy < 0) continue;
+                if (loopy > 126) continue;
+                if (loopx < 0) continue;
+                if (loopx > 126) continue;
+
+                // top tri
+                VertexRenderList[0].vWorldPosition = terrainVertex(loopx, loopy);
+                VertexRenderList[1].vWorldPosition = terrainVertex(loopx + 1, loopy + 1);
+                VertexRenderList[2].vWorldPosition = terrainVertex(loopx + 1, loopy);
+
+                // bottom tri
+                VertexRenderList[3].vWorldPosition = terrainVertex(loopx, loopy);
+                VertexRenderList[4].vWorldPosition = terrainVertex(loopx, loopy + 1);
+                VertexRenderList[5].vWorldPosition = terrainVertex(loopx + 1, loopy + 1);
+
+                float WorldMinZ = pOutdoor->GetPolygonMinZ(VertexRenderList, 6);
+                float WorldMaxZ = pOutdoor->GetPolygonMaxZ(VertexRenderList, 6);
+
+                // TODO(pskelton): terrain and boxes should be saved for easier retrieval
+                // test expanded box against bloodsplat
+                BBoxf thissquare{ VertexRenderList[0].vWorldPosition.x,
+                                  VertexRenderList[1].vWorldPosition.x,
+                                  VertexRenderList[1].vWorldPosition.y,
+                                  VertexRenderList[0].vWorldPosition.y,
+                                  WorldMinZ,
+                                  WorldMaxZ };
+
+                // skip this square if no splat over lap
+                if (!thissquare.intersectsCube(decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].pos, decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].radius))
+                    continue;
+
+                // splat hits this square of terrain
+                struct Polygon *pTilePolygon = &array_77EC08[pODMRenderParams->uNumPolygons];
+                pTilePolygon->flags = pOutdoor->getTileAttribByGrid(loopx, loopy);
+
+                unsigned norm_idx = pTerrainNormalIndices[(2 * loopx * 128) + (2 * loopy) + 2];  // 2 is top tri // 3 is bottom
+                unsigned bottnormidx = pTerrainNormalIndices[(2 * loopx * 128) + (2 * loopy) + 3];
+                assert(norm_idx < pTerrainNormals.size());
+                assert(bottnormidx < pTerrainNormals.size());
+                Vec3f *norm = &pTerrainNormals[norm_idx];
+                Vec3f *norm2 = &pTerrainNormals[bottnormidx];
+
+                float Light_tile_dist = 0.0;
+
+                // top tri
+                float _f1 = norm->x * pOutdoor->vSunlight.x + norm->y * pOutdoor->vSunlight.y + norm->z * pOutdoor->vSunlight.z;
+                pTilePolygon->dimming_level = 20.0f - floorf(20.0f * _f1 + 0.5f);
+                pTilePolygon->dimming_level = std::clamp((int)pTilePolygon->dimming_level, 0, 31);
+
+                decal_builder->ApplyBloodSplatToTerrain(pTilePolygon->flags, norm, &Light_tile_dist, VertexRenderList, i);
+                Planef plane;
+                plane.normal = *norm;
+                plane.dist = Light_tile_dist;
+                if (decal_builder->uNumSplatsThisFace > 0)
+                    decal_builder->BuildAndApplyDecals(31 - pTilePolygon->dimming_level, LocationTerrain, plane, 3, VertexRenderList, 0, -1);
+
+                //bottom tri
+                float _f = norm2->x * pOutdoor->vSunlight.x + norm2->y * pOutdoor->vSunlight.y + norm2->z * pOutdoor->vSunlight.z;
+                pTilePolygon->dimming_level = 20.0 - floorf(20.0 * _f + 0.5f);
+                pTilePolygon->dimming_level = std::clamp((int)pTilePolygon->dimming_level, 0, 31);
+
+                decal_builder->ApplyBloodSplatToTerrain(pTilePolygon->flags, norm2, &Light_tile_dist, (VertexRenderList + 3), i);
+                plane.normal = *norm2;
+                plane.dist = Light_tile_dist;
+                if (decal_builder->uNumSplatsThisFace > 0)
+                    decal_builder->BuildAndApplyDecals(31 - pTilePolygon->dimming_level, LocationTerrain, plane, 3, (VertexRenderList + 3), 0, -1);
+            }
+        }
+    }
+}
+
+void BaseRenderer::StackOutdoorBuildingDecals() {
+    // TODO(pskelton): clean up
+    if (!decal_builder->bloodsplat_container->uNumBloodsplats) return;
+
+    RenderPrepTimerScope timer(RENDER_PREP_DECALS);
+
+    for (BSPModel &model : pOutdoor->pBModels) {
+        if (model.pFaces.empty() || isOutdoorModelOccluded(model)) {
+            continue;
+        }
+
+        // check for any splat in this models box - if not continue
+        bool found{ false };
+        for (int splat = 0; splat < decal_builder->bloodsplat_container->uNumBloodsplats; ++splat) {
+            Bloodsplat *thissplat = &decal_builder->bloodsplat_container->pBloodsplats_to_apply[splat];
+            if (model.pBoundingBox.intersectsCube(thissplat->pos, thissplat->radius)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) continue;
+
+        for (ODMFace &face : model.pFaces) {
+            if (face.Invisible()) {
+                continue;
+            }
+
+            struct Polygon *poly = &array_77EC08[pODMRenderParams->uNumPolygons];
+            poly->flags = 0;
+            poly->field_32 = 0;
+
+            poly->pODMFace = &face;
+            poly->uNumVertices = face.uNumVertices;
+            poly->field_59 = 5;
+
+            float _f1 = face.facePlane.normal.x * pOutdoor->vSunlight.x + face.facePlane.normal.y * pOutdoor->vSunlight.y + face.facePlane.normal.z * pOutdoor->vSunlight.z;
+            poly->dimming_level = 20.0 - floorf(20.0 * _f1 + 0.5f);
+            poly->dimming_level = std::clamp((int)poly->dimming_level, 0, 31);
+
+            for (unsigned vertex_id = 1; vertex_id <= face.uNumVertices; vertex_id++) {
+                array_73D150[vertex_id - 1].vWorldPosition.x =
+                    model.pVertices[face.pVertexIDs[vertex_id - 1]].x;
+                array_73D150[vertex_id - 1].vWorldPosition.y =
+                    model.pVertices[face.pVertexIDs[vertex_id - 1]].y;
+                array_73D150[vertex_id - 1].vWorldPosition.z =
+                    model.pVertices[face.pVertexIDs[vertex_id - 1]].z;
+            }
+
+            for (int vertex_id = 0; vertex_id < face.uNumVertices; ++vertex_id) {
+                memcpy(&VertexRenderList[vertex_id], &array_73D150[vertex_id], sizeof(VertexRenderList[vertex_id]));
+                VertexRenderList[vertex_id]._rhw = 1.0 / (array_73D150[vertex_id].vWorldViewPosition.x + 0.0000001);
+            }
+
+            decal_builder->ApplyBloodSplat_OutdoorFace(&face);
+            if (decal_builder->uNumSplatsThisFace > 0) {
+                decal_builder->BuildAndApplyDecals(
+                    31 - poly->dimming_level, LocationBuildings,
+                    face.facePlane,
+                    face.uNumVertices, VertexRenderList, 0, -1);
+            }
+        }
+    }
+}
+
+void BaseRenderer::StackIndoorDecals() {
+    if (!decal_builder->bloodsplat_container->uNumBloodsplats) return;
+
+    RenderPrepTimerScope timer(RENDER_PREP_DECALS);
+
+    // Same ambient level as the one the indoor faces are lit with.
+    int16_t ambientLightLevel = 0;
+    for (const BLVSector &sector : pIndoor->pSectors)
+        ambientLightLevel = std::max(ambientLightLevel, sector.uMinAmbientLightLevel);
+
+    static RenderVertexSoft static_vertices_buff_in[64];  // buff in
+
+    // loop over faces
+    for (int test = 0; test < pIndoor->pFaces.size(); test++) {
+        BLVFace *pface = &pIndoor->pFaces[test];
+
+        if (pface->isPortal()) continue;
+        if (!pface->GetTexture()) continue;
+
+        // check if faces is visible
+        bool onlist = false;
+        for (unsigned i = 0; i < pBspRenderer->uNumVisibleNotEmptySectors; ++i) {
+            int listsector = pBspRenderer->pVisibleSectorIDs_toDrawDecorsActorsEtcFrom[i];
+            if (pface->uSectorID == listsector) {
+                onlist = true;
+                break;
+            }
+        }
+        if (!onlist) continue;
+
+        decal_builder->ApplyBloodsplatDecals_IndoorFace(test);
+        if (!decal_builder->uNumSplatsThisFace) continue;
+
+        // copy to buff in
+        for (unsigned i = 0; i < pface->uNumVertices; ++i) {
+            static_vertices_buff_in[i].vWorldPosition.x =
+                pIndoor->pVertices[pface->pVertexIDs[i]].x;
+            static_vertices_buff_in[i].vWorldPosition.y =
+                pIndoor->pVertices[pface->pVertexIDs[i]].y;
+            static_vertices_buff_in[i].vWorldPosition.z =
+                pIndoor->pVertices[pface->pVertexIDs[i]].z;
+            static_vertices_buff_in[i].u = (signed short)pface->pVertexUIDs[i];
+            static_vertices_buff_in[i].v = (signed short)pface->pVertexVIDs[i];
+        }
+
+        // blood draw
+        decal_builder->BuildAndApplyDecals(ambientLightLevel, LocationIndoors, pface->facePlane,
+            pface->uNumVertices, static_vertices_buff_in,
+            0, pface->uSectorID, test);
+    }
+}
@@ -6,6 +6,8 @@
 
 #include "Renderer.h"
 
+class BSPModel;
+
 class BaseRenderer : public Renderer {
  public:
     inline BaseRenderer(
@@ -41,6 +43,8 @@ class BaseRenderer : public Renderer {
     virtual void DrawTransparentGreenShade(float u, float v, class GraphicsImage *pTexture) override;
     virtual void ClearBlack() override;
     virtual void BillboardSphereSpellFX(struct SpellFX_Billboard *a1, Color diffuse) override;
+    virtual void BeginBillboardBatch() override;
+    virtual void EndBillboardBatch() override;
     virtual void DrawMonsterPortrait(Recti rc, SpriteFrame *Portrait_Sprite, int Y_Offset) override;
     virtual void DrawSpecialEffectsQuad(GraphicsImage *texture, int palette) override;
     virtual void DrawBillboards_And_MaybeRenderSpecialEffects_And_EndScene() override;
@@ -62,4 +66,36 @@ class BaseRenderer : public Renderer {
  protected:
     unsigned int Billboard_ProbablyAddToListAndSortByZOrder(float z);
     void TransformBillboard(const SoftwareBillboard *a2, const RenderBillboard *pBillboard);
+
+    /**
+     * Clips the pending bloodsplats against the terrain cells they overlap & builds decals for them. This is the CPU
+     * part of decal rendering, the results end up in `decal_builder`.
+     */
+    void StackTerrainDecals();
+
+    /**
+     * @param model                     Outdoor model.
+     * @return                          Whether the model is known to be hidden behind terrain or other models, and
+     *                                  thus wasn't drawn this frame. Decals on occluded models are not built.
+     */
+    virtual bool isOutdoorModelOccluded(const BSPModel &model) const {
+        return false;
+    }
+
+    /**
+     * Same as `StackTerrainDecals`, but for the faces of the outdoor buildings. Skips occluded models, see
+     * `isOutdoorModelOccluded`.
+     */
+    void StackOutdoorBuildingDecals();
+
+    /**
+     * Same as `StackTerrainDecals`, but for the indoor faces in the visible sectors.
+     */
+    void StackIndoorDecals();
+
+    /**
+     * Index of the first billboard of the current billboard batch in `pBillboardRenderListD3D`, -1 if there is no
+     * batch in progress. See `BeginBillboardBatch`.
+     */
+    int _billboardBatchStart = -1;
 };
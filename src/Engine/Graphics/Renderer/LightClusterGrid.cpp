@@ -0,0 +1,109 @@
+#include "LightClusterGrid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+static int tileAt(float ndc, int tiles) {
+    return std::clamp(static_cast<int>(std::floor((ndc + 1.0f) * 0.5f * tiles)), 0, tiles - 1);
+}
+
+static std::pair<float, float> projectedExtent(float min, float max, float minDepth, float maxDepth, float scale) {
+    // Projection is monotonic in depth, so the extremes are at either the nearest or the farthest depth.
+    float a = scale * min / minDepth;
+    float b = scale * min / maxDepth;
+    float c = scale * max / minDepth;
+    float d = scale * max / maxDepth;
+    return {std::min({a, b, c, d}), std::max({a, b, c, d})};
+}
+
+void LightClusterGrid::build(std::span<const ClusteredLight> lights, const glm::mat4 &view, const glm::mat4 &projection,
+                             float nearClip, float farClip) {
+    assert(nearClip > 0 && farClip > nearClip);
+
+    _view = view;
+    _scaleX = projection[0][0];
+    _scaleY = projection[1][1];
+    _nearClip = nearClip;
+    _farClip = farClip;
+    _sliceScale = SLICES / std::log(farClip / nearClip);
+
+    // First pass - find the clusters touched by each light, and count the lights in each cluster.
+    _ranges.clear();
+    _lights.clear();
+    _clusters.assign(2 * CLUSTER_COUNT, 0);
+    for (const ClusteredLight &light : lights) {
+        ClusterRange range;
+        if (!computeRange(light, &range))
+            continue;
+
+        _ranges.push_back(range);
+        _lights.emplace_back(light.position.x, light.position.y, light.position.z, light.radius);
+        _lights.emplace_back(light.diffuse.r, light.diffuse.g, light.diffuse.b, static_cast<float>(light.blendMode));
+        _lights.emplace_back(light.specular.r, light.specular.g, light.specular.b, static_cast<float>(light.sectorId));
+
+        forEachCluster(range, [&](int cluster) {
+            uint32_t &count = _clusters[2 * cluster + 1];
+            count = std::min<uint32_t>(count + 1, MAX_LIGHTS_PER_CLUSTER);
+        });
+    }
+
+    // Lay out the index lists.
+    uint32_t offset = 0;
+    for (int i = 0; i < CLUSTER_COUNT; i++) {
+        _clusters[2 * i] = offset;
+        offset += _clusters[2 * i + 1];
+        _clusters[2 * i + 1] = 0;
+    }
+    _indices.resize(offset);
+
+    // Second pass - fill the index lists. Lights are visited in the same order, so the per-cluster cap drops the same
+    // lights as in the first pass.
+    for (size_t i = 0; i < _ranges.size(); i++) {
+        forEachCluster(_ranges[i], [&](int cluster) {
+            uint32_t &count = _clusters[2 * cluster + 1];
+            if (count < MAX_LIGHTS_PER_CLUSTER)
+                _indices[_clusters[2 * cluster] + count++] = i;
+        });
+    }
+}
+
+bool LightClusterGrid::computeRange(const ClusteredLight &light, ClusterRange *range) const {
+    if (light.radius < 1.0f)
+        return false; // Shaders don't light anything with these.
+
+    glm::vec4 center = _view * glm::vec4(light.position.x, light.position.y, light.position.z, 1.0f);
+    float depth = -center.z;
+    float minDepth = depth - light.radius;
+    float maxDepth = depth + light.radius;
+    if (maxDepth <= _nearClip || minDepth >= _farClip)
+        return false;
+
+    auto sliceAt = [&](float depth) {
+        return std::clamp(static_cast<int>(std::floor(std::log(depth / _nearClip) * _sliceScale)), 0, SLICES - 1);
+    };
+    range->z0 = sliceAt(std::max(minDepth, _nearClip));
+    range->z1 = sliceAt(std::min(maxDepth, _farClip));
+
+    if (minDepth <= _nearClip) {
+        // Sphere crosses the near plane, so its projection is unbounded.
+        range->x0 = 0;
+        range->x1 = TILES_X - 1;
+        range->y0 = 0;
+        range->y1 = TILES_Y - 1;
+        return true;
+    }
+
+    // Project the view-space bounding box of the sphere, this is conservative.
+    auto [minX, maxX] = projectedExtent(center.x - light.radius, center.x + light.radius, minDepth, maxDepth, _scaleX);
+    auto [minY, maxY] = projectedExtent(center.y - light.radius, center.y + light.radius, minDepth, maxDepth, _scaleY);
+    if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f)
+        return false;
+
+    range->x0 = tileAt(minX, TILES_X);
+    range->x1 = tileAt(maxX, TILES_X);
+    range->y0 = tileAt(minY, TILES_Y);
+    range->y1 = tileAt(maxY, TILES_Y);
+    return true;
+}
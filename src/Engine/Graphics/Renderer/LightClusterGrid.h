@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Library/Color/Colorf.h"
+#include "Library/Geometry/Vec.h"
+
+/**
+ * How a point light is combined with the texture color in the world shaders.
+ */
+enum class LightBlendMode {
+    LIGHT_BLEND_MODULATED = 1, // Added to the sun light & then multiplied by the texture color, for stationary lights.
+    LIGHT_BLEND_ADDITIVE = 2, // Added on top of the textured color, for mobile lights.
+};
+using enum LightBlendMode;
+
+struct ClusteredLight {
+    Vec3f position;
+    float radius = 0;
+    Colorf diffuse; // Also used as the ambient color.
+    Colorf specular;
+    LightBlendMode blendMode = LIGHT_BLEND_MODULATED;
+    int sectorId = 0; // Indoor sector that the light is in, zero if unknown.
+};
+
+/**
+ * Light grid for clustered forward shading.
+ *
+ * The view frustum is split into `TILES_X * TILES_Y` screen-space tiles and `SLICES` depth slices, with slice depth
+ * growing exponentially from the near to the far plane. Each cluster gets a list of the lights whose bounding spheres
+ * might touch it, so that the world shaders only need to loop over the lights affecting the fragment's cluster
+ * instead of over all the lights in the scene.
+ *
+ * The results are stored in a form that can be uploaded into texture buffers as is:
+ * - `lights` holds `TEXELS_PER_LIGHT` RGBA texels per light: position & radius, diffuse color & blend mode,
+ *   specular color & sector id.
+ * - `clusters` holds an (offset, count) pair into `indices` for each cluster. Clusters are stored x-major, then y,
+ *   then depth slice.
+ * - `indices` holds indices into `lights`.
+ *
+ * Lights are assigned in the order they were provided, and at most `MAX_LIGHTS_PER_CLUSTER` lights end up in a single
+ * cluster, so that the per-fragment cost stays bounded. Callers should put the most important lights first.
+ */
+class LightClusterGrid {
+ public:
+    static constexpr int TILES_X = 16;
+    static constexpr int TILES_Y = 8;
+    static constexpr int SLICES = 16;
+    static constexpr int CLUSTER_COUNT = TILES_X * TILES_Y * SLICES;
+    static constexpr int MAX_LIGHTS_PER_CLUSTER = 32;
+    static constexpr int TEXELS_PER_LIGHT = 3;
+
+    /**
+     * @param lights                    Lights to distribute, in priority order.
+     * @param view                      View matrix.
+     * @param projection                Symmetric perspective projection matrix.
+     * @param nearClip                  Near clip distance that `projection` was built with.
+     * @param farClip                   Far clip distance that `projection` was built with.
+     */
+    void build(std::span<const ClusteredLight> lights, const glm::mat4 &view, const glm::mat4 &projection,
+               float nearClip, float farClip);
+
+    [[nodiscard]] const std::vector<glm::vec4> &lights() const {
+        return _lights;
+    }
+
+    [[nodiscard]] const std::vector<uint32_t> &clusters() const {
+        return _clusters;
+    }
+
+    [[nodiscard]] const std::vector<uint32_t> &indices() const {
+        return _indices;
+    }
+
+    /**
+     * @return                          Near clip distance that the grid was built for.
+     */
+    [[nodiscard]] float nearClip() const {
+        return _nearClip;
+    }
+
+    /**
+     * @return                          Depth slice scale, slice index for view-space depth `d` is
+     *                                  `floor(log(d / nearClip()) * sliceScale())`.
+     */
+    [[nodiscard]] float sliceScale() const {
+        return _sliceScale;
+    }
+
+ private:
+    struct ClusterRange {
+        int x0, x1;
+        int y0, y1;
+        int z0, z1;
+    };
+
+    bool computeRange(const ClusteredLight &light, ClusterRange *range) const;
+
+    template<class Callback>
+    static void forEachCluster(const ClusterRange &range, Callback &&callback) {
+        for (int z = range.z0; z <= range.z1; z++)
+            for (int y = range.y0; y <= range.y1; y++)
+                for (int x = range.x0; x <= range.x1; x++)
+                    callback((z * TILES_Y + y) * TILES_X + x);
+    }
+
+ private:
+    glm::mat4 _view = glm::mat4(1);
+    float _scaleX = 1;
+    float _scaleY = 1;
+    float _nearClip = 1;
+    float _farClip = 1;
+    float _sliceScale = 1;
+
+    std::vector<ClusterRange> _ranges;
+    std::vector<glm::vec4> _lights;
+    std::vector<uint32_t> _clusters;
+    std::vector<uint32_t> _indices;
+};
@@ -6,6 +6,8 @@
 
 #include "Library/Platform/Application/PlatformApplication.h"
 
+#include "RenderPrepTimers.h"
+
 bool NullRenderer::Initialize() {
     application->initializeOpenGLContext(PlatformOpenGLOptions());
     return BaseRenderer::Initialize();
@@ -72,7 +74,7 @@ void NullRenderer::RestoreBackBuffer() {}
 void NullRenderer::BltBackToFontFast(int a2, int a3, Recti *pSrcRect) {}
 void NullRenderer::BeginScene3D() {
     // TODO(captainurist): doesn't belong here.
-    uNumBillboardsToDraw = 0;
+    pBillboardRenderListD3D.clear();
 }
 
 void NullRenderer::DrawTerrainPolygon(struct Polygon *a4, bool transparent, bool clampAtTextureBorders) {}
@@ -85,6 +87,14 @@ TextureRenderId NullRenderer::CreateTexture(RgbaImageView image) {
     return TextureRenderId(1);
 }
 
+TextureRenderId NullRenderer::CreateIndexedTexture(GrayscaleImageView image) {
+    return TextureRenderId(1);
+}
+
+TextureRenderId NullRenderer::CreatePalettedTexture(GrayscaleImageView image, const Palette &palette) {
+    return TextureRenderId(1);
+}
+
 void NullRenderer::DeleteTexture(TextureRenderId id) {}
 void NullRenderer::UpdateTexture(TextureRenderId id, RgbaImageView image) {}
 
@@ -117,11 +127,19 @@ void NullRenderer::FillRectFast(unsigned int uX, unsigned int uY,
                                 unsigned int uWidth, unsigned int uHeight,
                                 Color uColor32) {}
 
-void NullRenderer::DrawOutdoorBuildings() {}
+void NullRenderer::DrawSnow(int flakeCount, uint32_t seed, float time, float windOffset) {}
+
+void NullRenderer::DrawOutdoorBuildings() {
+    if (renderPrepTimers)
+        StackOutdoorBuildingDecals();
+}
 
 void NullRenderer::DrawIndoorSky(unsigned int uNumVertices, int uFaceID) {}
 void NullRenderer::DrawOutdoorSky() {}
-void NullRenderer::DrawOutdoorTerrain() {}
+void NullRenderer::DrawOutdoorTerrain() {
+    if (renderPrepTimers)
+        StackTerrainDecals();
+}
 
 bool NullRenderer::AreRenderSurfacesOk() {
     return true;
@@ -131,6 +149,14 @@ RgbaImage NullRenderer::MakeScreenshot32(const int width, const int height) {
     return RgbaImage::solid(640, 480, Color());
 }
 
+std::future<RgbaImage> NullRenderer::RequestScreenshot32(int width, int height) {
+    std::promise<RgbaImage> result;
+    result.set_value(MakeScreenshot32(width, height));
+    return result.get_future();
+}
+
+void NullRenderer::FinishScreenshots() {}
+
 void NullRenderer::BeginLightmaps() {}
 void NullRenderer::EndLightmaps() {}
 void NullRenderer::BeginLightmaps2() {}
@@ -146,7 +172,10 @@ void NullRenderer::DrawDecal(struct Decal *pDecal, float z_bias) {}
 void NullRenderer::DrawFromSpriteSheet(Recti *pSrcRect, Pointi *pTargetPoint, int a3,
                                        int blend_mode) {}
 
-void NullRenderer::DrawIndoorFaces() {}
+void NullRenderer::DrawIndoorFaces() {
+    if (renderPrepTimers)
+        StackIndoorDecals();
+}
 
 void NullRenderer::ReleaseTerrain() {}
 void NullRenderer::ReleaseBSP() {}
@@ -156,3 +185,19 @@ void NullRenderer::DrawTwodVerts() {}
 void NullRenderer::ReloadShaders() {}
 
 void NullRenderer::DoRenderBillboards_D3D() {}
+
+IndexedArray<float, RENDER_PASS_FIRST, RENDER_PASS_LAST> NullRenderer::GetPassTimings() {
+    return {{}};
+}
+
+float NullRenderer::GetFrameLatency() {
+    return 0.0f;
+}
+
+int NullRenderer::GetAvoidedStateChanges() {
+    return 0;
+}
+
+VideoMemoryInfo NullRenderer::GetVideoMemoryInfo() {
+    return {};
+}
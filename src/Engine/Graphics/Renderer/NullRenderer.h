@@ -4,6 +4,12 @@
 
 #include "BaseRenderer.h"
 
+/**
+ * Renderer that doesn't draw anything, used for headless runs.
+ *
+ * If `renderPrepTimers` are installed, it still runs the CPU side of the passes that `OpenGLRenderer` does inside its
+ * draw calls (decal clipping), so that headless runs can be used to benchmark render prep.
+ */
 class NullRenderer : public BaseRenderer {
  public:
     using BaseRenderer::BaseRenderer;
@@ -50,6 +56,8 @@ class NullRenderer : public BaseRenderer {
                                 GraphicsImage *texture) override;
 
     virtual TextureRenderId CreateTexture(RgbaImageView image) override;
+    virtual TextureRenderId CreateIndexedTexture(GrayscaleImageView image) override;
+    virtual TextureRenderId CreatePalettedTexture(GrayscaleImageView image, const Palette &palette) override;
     virtual void DeleteTexture(TextureRenderId id) override;
     virtual void UpdateTexture(TextureRenderId id, RgbaImageView image) override;
 
@@ -78,6 +86,7 @@ class NullRenderer : public BaseRenderer {
     virtual void EndTextNew() override;
     virtual void DrawTextNew(int x, int y, int w, int h, float u1, float v1, float u2, float v2, int isshadow, Color colour) override;
 
+    virtual void DrawSnow(int flakeCount, uint32_t seed, float time, float windOffset) override;
     virtual void FillRectFast(unsigned int uX, unsigned int uY,
                               unsigned int uWidth, unsigned int uHeight,
                               Color uColor32) override;
@@ -91,6 +100,8 @@ class NullRenderer : public BaseRenderer {
     virtual bool AreRenderSurfacesOk() override;
 
     virtual RgbaImage MakeScreenshot32(const int width, const int height) override;
+    virtual std::future<RgbaImage> RequestScreenshot32(int width, int height) override;
+    virtual void FinishScreenshots() override;
 
     virtual void BeginLightmaps() override;
     virtual void EndLightmaps() override;
@@ -116,4 +127,10 @@ class NullRenderer : public BaseRenderer {
     virtual void ReloadShaders() override;
 
     virtual void DoRenderBillboards_D3D() override;
+
+    virtual IndexedArray<float, RENDER_PASS_FIRST, RENDER_PASS_LAST> GetPassTimings() override;
+    virtual float GetFrameLatency() override;
+    virtual int GetAvoidedStateChanges() override;
+
+    virtual VideoMemoryInfo GetVideoMemoryInfo() override;
 };
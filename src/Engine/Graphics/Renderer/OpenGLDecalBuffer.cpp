@@ -0,0 +1,196 @@
+#include "OpenGLDecalBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+#include "Engine/Graphics/DecalBuilder.h"
+
+#include "Utility/Memory/MemoryAccounting.h"
+
+#include "OpenGLState.h"
+
+// Compacting small buffers is not worth it.
+static constexpr size_t MIN_COMPACTED_GARBAGE = 4096;
+static constexpr size_t MIN_VERTEX_CAPACITY = 4096;
+
+void OpenGLDecalBuffer::release() {
+    openGLState.deleteVertexArrays(1, &_vao);
+    glDeleteBuffers(1, &_vertexBuffer);
+    openGLState.deleteTextures(1, &_colorsTexture);
+    glDeleteBuffers(1, &_colorsBuffer);
+    MemoryAccounting::reallocate(MEMORY_TAG_GPU_BUFFERS, _vertexCapacity * sizeof(Vertex), 0);
+    MemoryAccounting::reallocate(MEMORY_TAG_GPU_BUFFERS, _colorsSize, 0);
+    *this = OpenGLDecalBuffer();
+}
+
+void OpenGLDecalBuffer::beginFrame() {
+    _frame++;
+    _frameUids.clear();
+}
+
+void OpenGLDecalBuffer::add(const Decal &decal, const Colorf &color) {
+    assert(decal.uid != 0);
+    assert(decal.uNumVertices >= 3);
+
+    auto [pos, inserted] = _entries.try_emplace(decal.uid);
+    Entry &entry = pos->second;
+
+    if (inserted) {
+        if (_freeSlots.empty()) {
+            entry.slot = _colors.size();
+            _colors.emplace_back();
+        } else {
+            entry.slot = _freeSlots.back();
+            _freeSlots.pop_back();
+        }
+
+        // Triangulate as a fan - 012, 023, 034...
+        entry.first = _vertices.size();
+        entry.count = 3 * (decal.uNumVertices - 2);
+        for (int i = 0; i < decal.uNumVertices - 2; i++) {
+            for (int j : {0, i + 1, i + 2}) {
+                const RenderVertexSoft &src = decal.pVertices[j];
+                _vertices.push_back({src.vWorldPosition.x, src.vWorldPosition.y, src.vWorldPosition.z,
+                                     src.u, src.v, static_cast<GLfloat>(entry.slot)});
+            }
+        }
+    }
+
+    if (entry.frame == _frame)
+        return; // Already added during this frame.
+
+    entry.frame = _frame;
+    _colors[entry.slot] = color;
+    _frameUids.push_back(decal.uid);
+}
+
+int OpenGLDecalBuffer::draw(GLuint program, int colorsUnit) {
+    evict();
+    if (_garbageVertices >= MIN_COMPACTED_GARBAGE && _garbageVertices > _vertices.size() - _garbageVertices)
+        compact();
+    upload();
+
+    // Decals are added in creation order, which is also the order of their geometry in the buffer, so adjacent ranges
+    // can be merged & we normally end up with just a handful of draw calls.
+    _firsts.clear();
+    _counts.clear();
+    for (uint64_t uid : _frameUids) {
+        const Entry &entry = _entries.at(uid);
+        if (!_firsts.empty() && _firsts.back() + _counts.back() == entry.first) {
+            _counts.back() += entry.count;
+        } else {
+            _firsts.push_back(entry.first);
+            _counts.push_back(entry.count);
+        }
+    }
+
+    glUniform1i(glGetUniformLocation(program, "decalColours"), GLint(colorsUnit));
+    openGLState.activeTexture(GL_TEXTURE0 + colorsUnit);
+    openGLState.bindTexture(GL_TEXTURE_BUFFER, _colorsTexture);
+    openGLState.activeTexture(GL_TEXTURE0);
+
+    openGLState.bindVertexArray(_vao);
+    for (size_t i = 0; i < _firsts.size(); i++)
+        glDrawArrays(GL_TRIANGLES, _firsts[i], _counts[i]);
+    openGLState.bindVertexArray(0);
+
+    openGLState.activeTexture(GL_TEXTURE0 + colorsUnit);
+    openGLState.bindTexture(GL_TEXTURE_BUFFER, 0);
+    openGLState.activeTexture(GL_TEXTURE0);
+
+    return _firsts.size();
+}
+
+void OpenGLDecalBuffer::evict() {
+    for (auto pos = _entries.begin(); pos != _entries.end();) {
+        if (pos->second.frame == _frame) {
+            ++pos;
+            continue;
+        }
+
+        _garbageVertices += pos->second.count;
+        _freeSlots.push_back(pos->second.slot);
+        pos = _entries.erase(pos);
+    }
+}
+
+void OpenGLDecalBuffer::compact() {
+    // Keep the geometry in creation order, see the comment in `draw`.
+    std::vector<Vertex> vertices;
+    vertices.reserve(_vertices.size() - _garbageVertices);
+
+    std::vector<Entry *> entries;
+    entries.reserve(_entries.size());
+    for (auto &[uid, entry] : _entries)
+        entries.push_back(&entry);
+    std::ranges::sort(entries, std::less(), &Entry::first);
+
+    for (Entry *entry : entries) {
+        auto begin = _vertices.begin() + entry->first;
+        entry->first = vertices.size();
+        vertices.insert(vertices.end(), begin, begin + entry->count);
+    }
+
+    _vertices = std::move(vertices);
+    _garbageVertices = 0;
+    _reuploadVertices = true;
+}
+
+void OpenGLDecalBuffer::upload() {
+    if (_vao == 0) {
+        glGenVertexArrays(1, &_vao);
+        glGenBuffers(1, &_vertexBuffer);
+        glGenBuffers(1, &_colorsBuffer);
+        glGenTextures(1, &_colorsTexture);
+
+        openGLState.bindVertexArray(_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+        // position attribute
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, x));
+        glEnableVertexAttribArray(0);
+        // tex uv attribute
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, u));
+        glEnableVertexAttribArray(1);
+        // decal slot attribute
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, slot));
+        glEnableVertexAttribArray(2);
+        openGLState.bindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // Vertices - only the new ones, unless the buffer had to be reallocated or compacted.
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+    if (_vertices.size() > _vertexCapacity) {
+        size_t oldCapacity = std::exchange(_vertexCapacity,
+                                           std::max({MIN_VERTEX_CAPACITY, 2 * _vertexCapacity, _vertices.size()}));
+        MemoryAccounting::reallocate(MEMORY_TAG_GPU_BUFFERS, oldCapacity * sizeof(Vertex),
+                                     _vertexCapacity * sizeof(Vertex));
+        glBufferData(GL_ARRAY_BUFFER, _vertexCapacity * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+        _reuploadVertices = true;
+    }
+    if (_reuploadVertices)
+        _uploadedVertices = 0;
+    if (_uploadedVertices < _vertices.size()) {
+        glBufferSubData(GL_ARRAY_BUFFER, _uploadedVertices * sizeof(Vertex),
+                        (_vertices.size() - _uploadedVertices) * sizeof(Vertex), _vertices.data() + _uploadedVertices);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    _uploadedVertices = _vertices.size();
+    _reuploadVertices = false;
+
+    // Colors - these change every frame, so just orphan the old storage. There's always at least one color since empty
+    // texture buffers are not allowed.
+    if (_colors.empty())
+        _colors.emplace_back();
+    glBindBuffer(GL_TEXTURE_BUFFER, _colorsBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, _colors.size() * sizeof(Colorf), nullptr, GL_STREAM_DRAW);
+    MemoryAccounting::reallocate(MEMORY_TAG_GPU_BUFFERS, std::exchange(_colorsSize, _colors.size() * sizeof(Colorf)),
+                                 _colorsSize);
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, _colors.size() * sizeof(Colorf), _colors.data());
+    openGLState.bindTexture(GL_TEXTURE_BUFFER, _colorsTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, _colorsBuffer);
+    openGLState.bindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+#include "Library/Color/Colorf.h"
+
+struct Decal;
+
+/**
+ * Persistent GPU storage for the decal geometry.
+ *
+ * Decals don't change once they're created, so their triangles are uploaded only once, when the decal is first drawn,
+ * and then stay in the vertex buffer for as long as the decal is drawn every frame. The only per-frame data is the
+ * color of each decal (tint & fade), which is stored in a small texture buffer & indexed by the decal slot stored in
+ * every vertex. This way the per-frame cost scales with the number of new decals, and not with the number of all
+ * decals on the map.
+ *
+ * Usage is `beginFrame`, then `add` for every decal to draw, then `draw`. Decals that weren't added during a frame
+ * are dropped at `draw`. The space they took in the vertex buffer is reclaimed by compacting the buffer once there's
+ * more garbage than live data.
+ *
+ * Shaders are expected to take the position in attribute 0, texture coordinates in attribute 1, and decal slot in
+ * attribute 2, and to read the decal color from `samplerBuffer decalColours`.
+ */
+class OpenGLDecalBuffer {
+ public:
+    OpenGLDecalBuffer() = default;
+
+    /**
+     * Destroys the underlying buffers. Must be called with the OpenGL context still alive.
+     */
+    void release();
+
+    void beginFrame();
+
+    /**
+     * Adds a decal to the current frame, uploading its geometry if it's not yet in the buffer.
+     *
+     * @param decal                     Decal to draw. Decals are identified by their `uid`.
+     * @param color                     Decal color for this frame.
+     */
+    void add(const Decal &decal, const Colorf &color);
+
+    [[nodiscard]] bool empty() const {
+        return _frameUids.empty();
+    }
+
+    /**
+     * Drops the decals that weren't added during this frame, uploads the changes & draws. The program must be in use.
+     *
+     * @param program                   Program to draw with.
+     * @param colorsUnit                Texture unit to bind the decal colors to.
+     * @return                          Number of draw calls issued.
+     */
+    int draw(GLuint program, int colorsUnit);
+
+ private:
+    struct Vertex {
+        GLfloat x;
+        GLfloat y;
+        GLfloat z;
+        GLfloat u;
+        GLfloat v;
+        GLfloat slot;
+    };
+
+    struct Entry {
+        int first = 0;
+        int count = 0;
+        int slot = 0;
+        int64_t frame = 0;
+    };
+
+    void evict();
+    void compact();
+    void upload();
+
+ private:
+    GLuint _vao = 0;
+    GLuint _vertexBuffer = 0;
+    GLuint _colorsBuffer = 0;
+    GLuint _colorsTexture = 0;
+    size_t _vertexCapacity = 0; // Size of the GPU vertex buffer, in vertices.
+    size_t _colorsSize = 0; // Size of the GPU colors buffer, in bytes.
+    size_t _uploadedVertices = 0; // Number of vertices from the start of `_vertices` that are already on the GPU.
+    bool _reuploadVertices = false; // Whether the whole buffer needs to be uploaded, e.g. after compaction.
+
+    int64_t _frame = 0;
+    std::unordered_map<uint64_t, Entry> _entries;
+    std::vector<uint64_t> _frameUids; // Decals added during the current frame.
+    std::vector<Vertex> _vertices; // CPU side copy of the vertex buffer.
+    size_t _garbageVertices = 0; // Number of vertices in `_vertices` that belong to the dropped decals.
+    std::vector<Colorf> _colors; // Decal colors, indexed by slot.
+    std::vector<int> _freeSlots;
+    std::vector<GLint> _firsts;
+    std::vector<GLsizei> _counts;
+};
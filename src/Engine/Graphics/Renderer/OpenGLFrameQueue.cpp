@@ -0,0 +1,62 @@
+#include "OpenGLFrameQueue.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Library/Logger/Logger.h"
+
+static constexpr float LATENCY_SMOOTHING = 0.1f;
+
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void OpenGLFrameQueue::release() {
+    for (Frame &frame : _frames) {
+        if (frame.fence)
+            glDeleteSync(frame.fence);
+        frame = Frame();
+    }
+    _head = 0;
+    _latencyMs = 0.0f;
+}
+
+void OpenGLFrameQueue::nextFrame(int maxFrames, int64_t frameStartNs) {
+    if (maxFrames <= 0) {
+        if (_frames[(_head + MAX_FRAMES - 1) % MAX_FRAMES].fence)
+            release();
+        return;
+    }
+    maxFrames = std::min(maxFrames, MAX_FRAMES);
+
+    Frame &current = _frames[_head];
+    if (current.fence)
+        glDeleteSync(current.fence);
+    current.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    current.startNs = frameStartNs;
+    _head = (_head + 1) % MAX_FRAMES;
+
+    // Wait for the frame that was submitted `maxFrames - 1` frames ago, and for all the ones before it.
+    for (int i = maxFrames; i <= MAX_FRAMES; i++) {
+        Frame &frame = _frames[(_head + MAX_FRAMES - i) % MAX_FRAMES];
+        if (!frame.fence)
+            continue;
+
+        GLenum status = GL_TIMEOUT_EXPIRED;
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        while (status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(frame.fence, flags, 1'000'000'000);
+            flags = 0; // Only need to flush once.
+        }
+        if (status == GL_WAIT_FAILED)
+            logger->warning("OpenGL: waiting on frame fence failed");
+
+        if (i == maxFrames) {
+            float latencyMs = (nowNs() - frame.startNs) / 1'000'000.0f;
+            _latencyMs = _latencyMs == 0.0f ? latencyMs : _latencyMs + (latencyMs - _latencyMs) * LATENCY_SMOOTHING;
+        }
+
+        glDeleteSync(frame.fence);
+        frame = Frame();
+    }
+}
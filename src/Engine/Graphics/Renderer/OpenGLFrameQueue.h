@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+/**
+ * Limits the number of frames the driver is allowed to queue up ahead of the GPU, implemented with fence syncs.
+ *
+ * Drivers usually let the CPU run two or three frames ahead, which is good for throughput, but every queued frame
+ * is a frame of input latency. With a limit of one the CPU waits for the GPU to finish the previous frame before it
+ * starts the next one, so the input for the next frame is sampled as late as possible.
+ *
+ * Also measures the latency from the start of a frame to the GPU finishing it. This is only measured for the frames
+ * the CPU had to wait for, and is an upper bound if the fence was already signaled when the wait started.
+ */
+class OpenGLFrameQueue {
+ public:
+    static constexpr int MAX_FRAMES = 3;
+
+    OpenGLFrameQueue() = default;
+
+    /**
+     * Deletes all fences. Must be called with the OpenGL context still alive.
+     */
+    void release();
+
+    /**
+     * Marks the end of a frame, must be called right after the buffer swap. Blocks until the GPU is working on at
+     * most `maxFrames - 1` frames, so that together with the frame the CPU is about to start there are at most
+     * `maxFrames` frames in flight.
+     *
+     * @param maxFrames                 Max number of frames in flight, in `[1, MAX_FRAMES]`. Zero disables the limit.
+     * @param frameStartNs              Time of the start of the frame that was just submitted, in nanoseconds.
+     */
+    void nextFrame(int maxFrames, int64_t frameStartNs);
+
+    /**
+     * @return                          Smoothed frame latency in milliseconds, or zero if the limit is disabled.
+     */
+    [[nodiscard]] float latencyMs() const {
+        return _latencyMs;
+    }
+
+ private:
+    struct Frame {
+        GLsync fence = nullptr;
+        int64_t startNs = 0;
+    };
+
+    std::array<Frame, MAX_FRAMES> _frames = {};
+    int _head = 0; // Index of the next frame to write.
+    float _latencyMs = 0.0f;
+};
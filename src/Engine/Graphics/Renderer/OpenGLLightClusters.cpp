@@ -0,0 +1,72 @@
+#include "OpenGLLightClusters.h"
+
+#include <cassert>
+#include <utility>
+
+#include "Utility/Memory/MemoryAccounting.h"
+
+#include "OpenGLState.h"
+
+void OpenGLLightClusters::release() {
+    for (Buffer *buffer : {&_lights, &_clusters, &_indices}) {
+        openGLState.deleteTextures(1, &buffer->texture);
+        glDeleteBuffers(1, &buffer->buffer);
+        MemoryAccounting::reallocate(MEMORY_TAG_GPU_BUFFERS, buffer->size, 0);
+        *buffer = Buffer();
+    }
+    _valid = false;
+}
+
+void OpenGLLightClusters::update(std::span<const ClusteredLight> lights, const glm::mat4 &view,
+                                 const glm::mat4 &projection, float nearClip, float farClip) {
+    _grid.build(lights, view, projection, nearClip, farClip);
+
+    upload(&_lights, GL_RGBA32F, _grid.lights().data(), _grid.lights().size() * sizeof(glm::vec4));
+    upload(&_clusters, GL_RG32UI, _grid.clusters().data(), _grid.clusters().size() * sizeof(uint32_t));
+    upload(&_indices, GL_R32UI, _grid.indices().data(), _grid.indices().size() * sizeof(uint32_t));
+    _valid = true;
+}
+
+void OpenGLLightClusters::bind(GLuint program, int firstUnit) {
+    assert(_valid);
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glUniform4f(glGetUniformLocation(program, "clusterViewport"), viewport[0], viewport[1], viewport[2], viewport[3]);
+    glUniform2f(glGetUniformLocation(program, "clusterDepth"), _grid.nearClip(), _grid.sliceScale());
+
+    const char *names[] = {"clusterLights", "clusterGrid", "clusterIndices"};
+    const Buffer *buffers[] = {&_lights, &_clusters, &_indices};
+    for (int i = 0; i < 3; i++) {
+        glUniform1i(glGetUniformLocation(program, names[i]), GLint(firstUnit + i));
+        openGLState.activeTexture(GL_TEXTURE0 + firstUnit + i);
+        openGLState.bindTexture(GL_TEXTURE_BUFFER, buffers[i]->texture);
+    }
+    openGLState.activeTexture(GL_TEXTURE0);
+}
+
+void OpenGLLightClusters::upload(Buffer *buffer, GLenum format, const void *data, size_t size) {
+    if (buffer->buffer == 0) {
+        glGenBuffers(1, &buffer->buffer);
+        glGenTextures(1, &buffer->texture);
+    }
+
+    // Empty texture buffers are not allowed, so there's always at least one element. Shaders never read past the
+    // ranges that are stored in the cluster grid anyway.
+    static constexpr uint32_t dummy[4] = {};
+    if (size == 0) {
+        data = dummy;
+        size = sizeof(dummy);
+    }
+
+    // Orphan the old storage, the GPU might still be reading from it.
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer->buffer);
+    glBufferData(GL_TEXTURE_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+    MemoryAccounting::reallocate(MEMORY_TAG_GPU_BUFFERS, std::exchange(buffer->size, size), size);
+
+    openGLState.bindTexture(GL_TEXTURE_BUFFER, buffer->texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, format, buffer->buffer);
+    openGLState.bindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <span>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+#include "LightClusterGrid.h"
+
+/**
+ * GPU side of `LightClusterGrid`. Owns the texture buffers that the world shaders (terrain, outdoor buildings & BSP)
+ * read their point lights from.
+ *
+ * The grid is meant to be built once per frame. `invalidate` should be called at the start of a frame, then the first
+ * pass that needs the grid calls `update`, and the rest of the passes see that `isValid` is set and just `bind` it.
+ *
+ * Shaders are expected to declare the following uniforms:
+ * - `samplerBuffer clusterLights`, `usamplerBuffer clusterGrid` and `usamplerBuffer clusterIndices` - the data from
+ *   `LightClusterGrid`.
+ * - `vec4 clusterViewport` - viewport origin & size, in window coordinates.
+ * - `vec2 clusterDepth` - near clip distance & depth slice scale.
+ */
+class OpenGLLightClusters {
+ public:
+    OpenGLLightClusters() = default;
+
+    /**
+     * Destroys the underlying buffers. Must be called with the OpenGL context still alive.
+     */
+    void release();
+
+    /**
+     * Marks the grid as out of date, so that the next call to `update` rebuilds it.
+     */
+    void invalidate() {
+        _valid = false;
+    }
+
+    /**
+     * Rebuilds the grid & uploads it to the GPU.
+     *
+     * @param lights                    Lights to distribute, in priority order.
+     * @param view                      View matrix.
+     * @param projection                Perspective projection matrix.
+     * @param nearClip                  Near clip distance that `projection` was built with.
+     * @param farClip                   Far clip distance that `projection` was built with.
+     */
+    void update(std::span<const ClusteredLight> lights, const glm::mat4 &view, const glm::mat4 &projection,
+                float nearClip, float farClip);
+
+    [[nodiscard]] bool isValid() const {
+        return _valid;
+    }
+
+    /**
+     * Binds the grid to the provided program. The program must be in use.
+     *
+     * @param program                   Program to bind to.
+     * @param firstUnit                 First texture unit to use, three consecutive units are taken.
+     */
+    void bind(GLuint program, int firstUnit);
+
+ private:
+    struct Buffer {
+        GLuint buffer = 0;
+        GLuint texture = 0;
+        size_t size = 0; // Size of the buffer storage, in bytes.
+    };
+
+    static void upload(Buffer *buffer, GLenum format, const void *data, size_t size);
+
+ private:
+    LightClusterGrid _grid;
+    bool _valid = false;
+    Buffer _lights;
+    Buffer _clusters;
+    Buffer _indices;
+};
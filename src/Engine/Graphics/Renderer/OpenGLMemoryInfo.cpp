@@ -0,0 +1,53 @@
+#include "OpenGLMemoryInfo.h"
+
+#include <string_view>
+
+// These are not a part of either OpenGL 4.1 or OpenGL ES 3.2, so our glad loader doesn't know about them.
+#ifndef GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX
+#   define GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX 0x9047
+#endif
+#ifndef GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX
+#   define GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX 0x9049
+#endif
+#ifndef GL_TEXTURE_FREE_MEMORY_ATI
+#   define GL_TEXTURE_FREE_MEMORY_ATI 0x87FC
+#endif
+
+static bool hasExtension(std::string_view name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++)
+        if (reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i)) == name)
+            return true;
+    return false;
+}
+
+void OpenGLMemoryInfo::initialize(bool isOpenGLES) {
+    _nvx = !isOpenGLES && hasExtension("GL_NVX_gpu_memory_info");
+    _ati = !isOpenGLES && !_nvx && hasExtension("GL_ATI_meminfo");
+}
+
+int64_t OpenGLMemoryInfo::totalSize() const {
+    if (!_nvx)
+        return -1;
+
+    GLint result = 0; // In KiB.
+    glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &result);
+    return static_cast<int64_t>(result) * 1024;
+}
+
+int64_t OpenGLMemoryInfo::availableSize() const {
+    if (_nvx) {
+        GLint result = 0; // In KiB.
+        glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &result);
+        return static_cast<int64_t>(result) * 1024;
+    }
+
+    if (_ati) {
+        GLint result[4] = {}; // Total free, largest free block, total free auxiliary, largest free auxiliary, in KiB.
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, result);
+        return static_cast<int64_t>(result[0]) * 1024;
+    }
+
+    return -1;
+}
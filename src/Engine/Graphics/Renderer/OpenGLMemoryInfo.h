@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+/**
+ * Video memory queries through the vendor-specific `GL_NVX_gpu_memory_info` & `GL_ATI_meminfo` extensions.
+ *
+ * Neither of these is available on Intel, Apple or any of the OpenGL ES drivers, in which case all the queries
+ * return -1 and the renderer can only go by its own estimates of what it has allocated.
+ */
+class OpenGLMemoryInfo {
+ public:
+    OpenGLMemoryInfo() = default;
+
+    /**
+     * Checks which of the extensions are supported. Must be called with the OpenGL context current.
+     *
+     * @param isOpenGLES                Whether the context is an OpenGL ES one.
+     */
+    void initialize(bool isOpenGLES);
+
+    [[nodiscard]] bool isSupported() const {
+        return _nvx || _ati;
+    }
+
+    /**
+     * @return                          Total dedicated video memory in bytes, or -1 if unknown. Only NVidia drivers
+     *                                  report this.
+     */
+    [[nodiscard]] int64_t totalSize() const;
+
+    /**
+     * @return                          Currently available video memory in bytes, or -1 if unknown. On AMD this is
+     *                                  the free memory in the texture pool.
+     */
+    [[nodiscard]] int64_t availableSize() const;
+
+ private:
+    bool _nvx = false;
+    bool _ati = false;
+};
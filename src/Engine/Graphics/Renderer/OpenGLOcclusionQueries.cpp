@@ -0,0 +1,56 @@
+#include "OpenGLOcclusionQueries.h"
+
+#include <cassert>
+
+void OpenGLOcclusionQueries::initialize(bool isOpenGLES) {
+    // OpenGL ES 3.0 only has the conservative version, which is good enough for culling.
+    _target = isOpenGLES ? GL_ANY_SAMPLES_PASSED_CONSERVATIVE : GL_ANY_SAMPLES_PASSED;
+}
+
+void OpenGLOcclusionQueries::release() {
+    reset(0);
+}
+
+void OpenGLOcclusionQueries::reset(size_t count) {
+    for (const Object &object : _objects)
+        if (object.query)
+            glDeleteQueries(1, &object.query);
+    _objects.clear();
+    _objects.resize(count);
+}
+
+void OpenGLOcclusionQueries::update() {
+    for (Object &object : _objects) {
+        if (!object.pending)
+            continue;
+
+        GLuint available = 0;
+        glGetQueryObjectuiv(object.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            continue;
+
+        GLuint anySamplesPassed = 0;
+        glGetQueryObjectuiv(object.query, GL_QUERY_RESULT, &anySamplesPassed);
+        object.occluded = !anySamplesPassed;
+        object.pending = false;
+    }
+}
+
+void OpenGLOcclusionQueries::markVisible(size_t index) {
+    assert(index < _objects.size());
+    _objects[index].occluded = false;
+}
+
+void OpenGLOcclusionQueries::begin(size_t index) {
+    assert(canBegin(index));
+
+    Object &object = _objects[index];
+    if (!object.query)
+        glGenQueries(1, &object.query);
+    glBeginQuery(_target, object.query);
+    object.pending = true;
+}
+
+void OpenGLOcclusionQueries::end() {
+    glEndQuery(_target);
+}
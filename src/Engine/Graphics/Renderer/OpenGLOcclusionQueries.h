@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+/**
+ * Occlusion queries for a set of objects identified by index, implemented with `GL_ANY_SAMPLES_PASSED` queries.
+ *
+ * Users draw a proxy (e.g. a bounding box) for each object inside a `begin` / `end` pair, and check `isOccluded`
+ * before drawing the object itself in the next frames. Results are only read back once they are available, so this
+ * never stalls the pipeline. Until the result of a query arrives the object keeps its last known state, and objects
+ * with no results yet are considered visible.
+ */
+class OpenGLOcclusionQueries {
+ public:
+    OpenGLOcclusionQueries() = default;
+
+    /**
+     * @param isOpenGLES                Whether the context is an OpenGL ES one.
+     */
+    void initialize(bool isOpenGLES);
+
+    /**
+     * Destroys all query objects. Must be called with the OpenGL context still alive.
+     */
+    void release();
+
+    /**
+     * Destroys all query objects & sets the number of objects. All objects are considered visible after this call.
+     *
+     * @param count                     Number of objects.
+     */
+    void reset(size_t count);
+
+    [[nodiscard]] size_t size() const {
+        return _objects.size();
+    }
+
+    /**
+     * Collects the results that have arrived since the last call.
+     */
+    void update();
+
+    /**
+     * @param index                     Object index.
+     * @return                          Whether the object was fully occluded in the last completed query.
+     */
+    [[nodiscard]] bool isOccluded(size_t index) const {
+        return index < _objects.size() && _objects[index].occluded;
+    }
+
+    /**
+     * Marks an object as visible, without issuing a query. Use this when the proxy can't be tested, e.g. when the
+     * camera is inside of it.
+     *
+     * @param index                     Object index.
+     */
+    void markVisible(size_t index);
+
+    /**
+     * @param index                     Object index.
+     * @return                          Whether a new query for this object can be issued. This is false if the
+     *                                  previous query is still in flight.
+     */
+    [[nodiscard]] bool canBegin(size_t index) const {
+        return index < _objects.size() && !_objects[index].pending;
+    }
+
+    void begin(size_t index);
+    void end();
+
+ private:
+    struct Object {
+        GLuint query = 0;
+        bool pending = false;
+        bool occluded = false;
+    };
+
+    GLenum _target = GL_ANY_SAMPLES_PASSED;
+    std::vector<Object> _objects;
+};
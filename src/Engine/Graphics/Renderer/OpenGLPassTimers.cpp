@@ -0,0 +1,94 @@
+#include "OpenGLPassTimers.h"
+
+#include <cassert>
+
+void OpenGLPassTimers::initialize(bool isOpenGLES) {
+    _supported = !isOpenGLES;
+    _frame = 0;
+    _stack.clear();
+    _timings.fill(0.0f);
+}
+
+void OpenGLPassTimers::release() {
+    if (!_stack.empty())
+        stopQuery();
+    _stack.clear();
+
+    for (Frame &frame : _frames) {
+        for (const Query &query : frame.queries)
+            glDeleteQueries(1, &query.id);
+        frame.queries.clear();
+        frame.used = 0;
+    }
+
+    _supported = false;
+}
+
+void OpenGLPassTimers::begin(RenderPass pass) {
+    if (!_supported)
+        return;
+
+    if (!_stack.empty())
+        stopQuery();
+    _stack.push_back(pass);
+    startQuery(pass);
+}
+
+void OpenGLPassTimers::end(RenderPass pass) {
+    if (!_supported)
+        return;
+
+    assert(!_stack.empty() && _stack.back() == pass);
+    stopQuery();
+    _stack.pop_back();
+    if (!_stack.empty())
+        startQuery(_stack.back());
+}
+
+void OpenGLPassTimers::nextFrame() {
+    if (!_supported)
+        return;
+
+    assert(_stack.empty()); // Passes shouldn't span frames.
+
+    _frame = (_frame + 1) % FRAME_COUNT;
+
+    // This is the oldest frame in flight. If the results are still not there, drop them, we'll reuse the queries.
+    Frame &frame = _frames[_frame];
+    if (frame.used > 0)
+        collect(&frame);
+    frame.used = 0;
+}
+
+void OpenGLPassTimers::startQuery(RenderPass pass) {
+    Frame &frame = _frames[_frame];
+    if (frame.used == frame.queries.size()) {
+        Query &query = frame.queries.emplace_back();
+        glGenQueries(1, &query.id);
+    }
+
+    Query &query = frame.queries[frame.used++];
+    query.pass = pass;
+    glBeginQuery(GL_TIME_ELAPSED, query.id);
+}
+
+void OpenGLPassTimers::stopQuery() {
+    glEndQuery(GL_TIME_ELAPSED);
+}
+
+bool OpenGLPassTimers::collect(Frame *frame) {
+    // Queries complete in order, so it's enough to check the last one.
+    GLuint available = 0;
+    glGetQueryObjectuiv(frame->queries[frame->used - 1].id, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return false;
+
+    Timings timings = {{}};
+    for (size_t i = 0; i < frame->used; i++) {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(frame->queries[i].id, GL_QUERY_RESULT, &elapsed);
+        timings[frame->queries[i].pass] += elapsed / 1'000'000.0f;
+    }
+    _timings = timings;
+    return true;
+}
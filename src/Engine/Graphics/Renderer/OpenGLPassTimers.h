@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+#include "Utility/IndexedArray.h"
+
+#include "RendererEnums.h"
+
+/**
+ * GPU timers for the render passes of `OpenGLRenderer`, implemented with `GL_TIME_ELAPSED` queries.
+ *
+ * Queries issued in a frame are only read back `FRAME_COUNT - 1` frames later, and only if the results are already
+ * available, so reading the timings never stalls the pipeline. Passes can be entered several times per frame, the
+ * times are summed up. Passes can also nest (e.g. text pass flushing the 2D pass), in which case the time spent in
+ * the inner pass is not counted towards the outer one.
+ *
+ * Timer queries are not available on OpenGL ES, there all timings are reported as zero.
+ */
+class OpenGLPassTimers {
+ public:
+    using Timings = IndexedArray<float, RENDER_PASS_FIRST, RENDER_PASS_LAST>;
+
+    OpenGLPassTimers() = default;
+
+    /**
+     * @param isOpenGLES                Whether the context is an OpenGL ES one.
+     */
+    void initialize(bool isOpenGLES);
+
+    /**
+     * Destroys all query objects. Must be called with the OpenGL context still alive.
+     */
+    void release();
+
+    [[nodiscard]] bool isSupported() const {
+        return _supported;
+    }
+
+    void begin(RenderPass pass);
+    void end(RenderPass pass);
+
+    /**
+     * Marks the end of a frame, and collects the results of the oldest frame in flight.
+     */
+    void nextFrame();
+
+    /**
+     * @return                          Per-pass GPU times in milliseconds, for the last frame that had its results
+     *                                  collected.
+     */
+    [[nodiscard]] const Timings &timings() const {
+        return _timings;
+    }
+
+ private:
+    struct Query {
+        GLuint id = 0;
+        RenderPass pass = RENDER_PASS_FIRST;
+    };
+
+    struct Frame {
+        std::vector<Query> queries; // Query objects of this frame, only the first `used` are active.
+        size_t used = 0;
+    };
+
+    void startQuery(RenderPass pass);
+    void stopQuery();
+    bool collect(Frame *frame);
+
+ private:
+    static constexpr size_t FRAME_COUNT = 3;
+
+    bool _supported = false;
+    std::array<Frame, FRAME_COUNT> _frames;
+    size_t _frame = 0;
+    std::vector<RenderPass> _stack; // Currently entered passes.
+    Timings _timings = {{}};
+};
+
+/**
+ * RAII helper for `OpenGLPassTimers::begin` & `OpenGLPassTimers::end`.
+ */
+class OpenGLPassTimerScope {
+ public:
+    OpenGLPassTimerScope(OpenGLPassTimers *timers, RenderPass pass) : _timers(timers), _pass(pass) {
+        _timers->begin(_pass);
+    }
+
+    ~OpenGLPassTimerScope() {
+        _timers->end(_pass);
+    }
+
+    OpenGLPassTimerScope(const OpenGLPassTimerScope &) = delete;
+    OpenGLPassTimerScope &operator=(const OpenGLPassTimerScope &) = delete;
+
+ private:
+    OpenGLPassTimers *_timers;
+    RenderPass _pass;
+};
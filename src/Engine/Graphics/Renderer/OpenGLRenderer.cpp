@@ -1,9 +1,15 @@
 #include "OpenGLRenderer.h"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <map>
+#include <string>
+#include <vector>
 
 #include <glad/gl.h> // NOLINT: not a C system header.
 
@@ -13,6 +19,7 @@
 #include <nuklear_config.h> // NOLINT: not a C system header.
 
 #include "Engine/Engine.h"
+#include "Engine/Components/Deterministic/EngineDeterministicComponent.h"
 #include "Engine/EngineGlobals.h"
 #include "Engine/Graphics/BspRenderer.h"
 #include "Engine/Graphics/Image.h"
@@ -23,6 +30,7 @@
 #include "Engine/Graphics/LightsStack.h"
 #include "Engine/Graphics/Nuklear.h"
 #include "OpenGLShader.h"
+#include "OpenGLState.h"
 #include "Engine/Graphics/Outdoor.h"
 #include "Engine/Graphics/Indoor.h"
 #include "Engine/Graphics/ParticleEngine.h"
@@ -44,11 +52,15 @@
 #include "Library/Platform/Application/PlatformApplication.h"
 #include "Library/Serialization/EnumSerialization.h"
 #include "Library/Image/ImageFunctions.h"
+#include "Library/Image/ImageKernels.h"
 #include "Library/Color/Colorf.h"
 #include "Library/Logger/Logger.h"
+#include "Library/Profiler/Profiler.h"
 #include "Library/Geometry/Size.h"
 
+#include "Utility/DataPath.h"
 #include "Utility/Format.h"
+#include "Utility/Memory/MemoryAccounting.h"
 #include "Utility/Memory/MemSet.h"
 
 #ifndef LOWORD
@@ -57,11 +69,38 @@
 
 static constexpr int DEFAULT_AMBIENT_LIGHT_LEVEL = 0;
 
+// How far below the display refresh rate to keep the frame rate when limiting to it, see `FPSLimitToRefreshRate`.
+static constexpr int VRR_FPS_MARGIN = 3;
+
+// Size of a single frame segment of the stream buffer. Outdoor buildings go through it too, and a single upload must
+// fit into a segment.
+static constexpr size_t STREAM_BUFFER_SEGMENT_SIZE = 8 * 1024 * 1024;
+
+// Size of a single frame segment of the texture staging buffer. Fits a few dozen 128x128 bitmaps, textures that are
+// bigger than this are uploaded straight from client memory.
+static constexpr size_t TEXTURE_STAGING_SEGMENT_SIZE = 4 * 1024 * 1024;
+
+// Video memory pressure is checked every this many frames, see `updateTextureResidency`.
+static constexpr int64_t RESIDENCY_CHECK_INTERVAL = 120;
+
+// Driver-reported available video memory below which we start dropping texture mips. Also at least 10% of the total,
+// if the driver reports the total.
+static constexpr int64_t LOW_VIDEO_MEMORY_SIZE = 64 * 1024 * 1024;
+
+// Max mip bias for the world textures, 2 means 128x128 textures go down to 32x32.
+static constexpr int MAX_TEXTURE_MIP_BIAS = 2;
+
+// First texture unit taken by the light cluster buffers in the world shaders. Terrain uses units 0 & 1 for its
+// texture arrays.
+static constexpr int LIGHT_CLUSTERS_FIRST_TEXTURE_UNIT = 2;
+
+// Texture unit for the per-decal colors in the decal shader.
+static constexpr int DECAL_COLORS_TEXTURE_UNIT = 1;
+
 // globals
 //TODO(pskelton): Combine and contain
 int uNumDecorationsDrawnThisFrame;
-RenderBillboard pBillboardRenderList[500];
-unsigned int uNumBillboardsToDraw;
+RenderList<RenderBillboard> pBillboardRenderList(500);
 int uNumSpritesDrawnThisFrame;
 RenderVertexSoft array_73D150[20];
 RenderVertexSoft VertexRenderList[50];
@@ -74,6 +113,10 @@ static GLuint framebuffer = 0;
 static GLuint framebufferTextures[2] = {0, 0};
 static bool OpenGLES = false;
 
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 struct nk_vertex {
     float position[2]{};
     float uv[2]{};
@@ -222,9 +265,29 @@ OpenGLRenderer::OpenGLRenderer(
 
 OpenGLRenderer::~OpenGLRenderer() { logger->info("RenderGl - Destructor"); }
 
-void OpenGLRenderer::Release() { logger->info("RenderGL - Release"); }
+void OpenGLRenderer::Release() {
+    logger->info("RenderGL - Release");
+    _passTimers.release();
+    _frameQueue.release();
+    _screenReadback.release();
+    _outbuildOcclusion.release();
+    if (_sceneFramebuffer) {
+        glDeleteFramebuffers(1, &_sceneFramebuffer);
+        openGLState.deleteTextures(2, _sceneTextures);
+        _sceneFramebuffer = 0;
+        _sceneTextureSize = Sizei();
+    }
+    _lightClusters.release();
+    _decalBuffer.release();
+    _spriteAtlas.release();
+    _textureArrayUploader.release();
+    _textureStagingBuffer.release();
+    _streamBuffer.release();
+}
 
 RgbaImage OpenGLRenderer::ReadScreenPixels() {
+    resolveSceneTarget();
+
     RgbaImage result = RgbaImage::uninitialized(outputRender.w, outputRender.h);
     if (outputRender != outputPresent) {
         glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
@@ -277,12 +340,9 @@ void OpenGLRenderer::BeginLines2D() {
 
     if (lineVAO == 0) {
         glGenVertexArrays(1, &lineVAO);
-        glGenBuffers(1, &lineVBO);
-
-        glBindVertexArray(lineVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(lineshaderstore), NULL, GL_DYNAMIC_DRAW);
+        openGLState.bindVertexArray(lineVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, _streamBuffer.id());
 
         // position attribute
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(linesverts), (void *)offsetof(linesverts, x));
@@ -297,30 +357,27 @@ void OpenGLRenderer::EndLines2D() {
     if (!linevertscnt) return;
 
     // update buffer
-    glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(lineshaderstore), NULL, GL_DYNAMIC_DRAW);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(linesverts) * linevertscnt, lineshaderstore);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GLint first = _streamBuffer.upload(lineshaderstore, linevertscnt);
 
-    glBindVertexArray(lineVAO);
+    openGLState.bindVertexArray(lineVAO);
     glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
 
-    glUseProgram(lineshader.ID);
+    openGLState.useProgram(lineshader.ID);
 
     //// set projection
     glUniformMatrix4fv(glGetUniformLocation(lineshader.ID, "projection"), 1, GL_FALSE, &projmat[0][0]);
     //// set view
     glUniformMatrix4fv(glGetUniformLocation(lineshader.ID, "view"), 1, GL_FALSE, &viewmat[0][0]);
 
-    glDrawArrays(GL_LINES, 0, (linevertscnt));
+    glDrawArrays(GL_LINES, first, (linevertscnt));
     drawcalls++;
 
-    glUseProgram(0);
+    openGLState.useProgram(0);
     glDisableVertexAttribArray(0);
     glDisableVertexAttribArray(1);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    openGLState.bindVertexArray(0);
 
     linevertscnt = 0;
 }
@@ -376,14 +433,17 @@ void OpenGLRenderer::BeginScene3D() {
         GL_Check_Framebuffer(__FUNCTION__);
     }
 
-    glDepthMask(GL_TRUE);
-    glEnable(GL_DEPTH_TEST);
+    bindSceneTarget();
+
+    openGLState.depthMask(GL_TRUE);
+    openGLState.enable(GL_DEPTH_TEST);
 
     glClearColor(0, 0, 0, 0/*0.9f, 0.5f, 0.1f, 1.0f*/);
     glClearDepthf(1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    render->uNumBillboardsToDraw = 0;  // moved from drawbillboards - cant reset this until mouse picking finished
+    render->pBillboardRenderListD3D.clear();  // moved from drawbillboards - cant reset this until mouse picking finished
+    _lightClusters.invalidate();
 
     SetFogParametersGL();
     gamma = GetGamma();
@@ -473,12 +533,12 @@ void OpenGLRenderer::DrawProjectile(float srcX, float srcY, float srcworldview,
     v29[3].texcoord.x = 0.0;
     v29[3].texcoord.y = 0.0;
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
+    openGLState.enable(GL_BLEND);
+    openGLState.blendFunc(GL_ONE, GL_ONE);
 
     // ErrD3D(pRenderD3D->pDevice->SetRenderState(D3DRENDERSTATE_DITHERENABLE, FALSE));
-    glDepthMask(GL_FALSE);
-    glDisable(GL_CULL_FACE);
+    openGLState.depthMask(GL_FALSE);
+    openGLState.disable(GL_CULL_FACE);
 
     int texid = 0;
 
@@ -526,12 +586,12 @@ void OpenGLRenderer::DrawProjectile(float srcX, float srcY, float srcworldview,
     // TODO(pskelton): do these need batching?
     DrawForcePerVerts();
 
-    glDisable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ZERO);
+    openGLState.disable(GL_BLEND);
+    openGLState.blendFunc(GL_ONE, GL_ZERO);
 
     //ErrD3D(pRenderD3D->pDevice->SetRenderState(D3DRENDERSTATE_DITHERENABLE, TRUE));
-    glDepthMask(GL_TRUE);
-    glEnable(GL_CULL_FACE);
+    openGLState.depthMask(GL_TRUE);
+    openGLState.enable(GL_CULL_FACE);
 }
 
 struct twodverts {
@@ -998,6 +1058,12 @@ bool OpenGLRenderer::AreRenderSurfacesOk() {
 }
 
 RgbaImage OpenGLRenderer::MakeScreenshot32(const int width, const int height) {
+    std::future<RgbaImage> result = RequestScreenshot32(width, height);
+    FinishScreenshots();
+    return result.get();
+}
+
+std::future<RgbaImage> OpenGLRenderer::RequestScreenshot32(int width, int height) {
     // TODO(pskelton): should this call drawworld instead??
 
     pCamera3D->_viewPitch = pParty->_viewPitch;
@@ -1018,22 +1084,29 @@ RgbaImage OpenGLRenderer::MakeScreenshot32(const int width, const int height) {
     }
     DrawBillboards_And_MaybeRenderSpecialEffects_And_EndScene();
 
-    // TODO(captainurist): subImage().scale()
-    RgbaImage sPixels = ReadScreenPixels();
-    float interval_x = static_cast<float>(game_viewport_width) / width;
-    float interval_y = static_cast<float>(game_viewport_height) / height;
+    if (uCurrentlyLoadedLevelType == LEVEL_NULL) {
+        std::promise<RgbaImage> result;
+        result.set_value(RgbaImage::solid(width, height, Color()));
+        return result.get_future();
+    }
 
-    RgbaImage pPixels = RgbaImage::solid(width, height, Color());
+    resolveSceneTarget();
 
-    if (uCurrentlyLoadedLevelType != LEVEL_NULL) {
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                pPixels[y][x] = sPixels[outputRender.h - (y + 1) * interval_y - pViewport->uViewportTL_Y][x * interval_x + pViewport->uViewportTL_X];
-            }
-        }
-    }
+    // Game viewport in GL coordinates, scaled down on the GPU.
+    GLuint screenFramebuffer = outputRender != outputPresent ? framebuffer : 0;
+    Recti srcRect(pViewport->uViewportTL_X, outputRender.h - pViewport->uViewportTL_Y - game_viewport_height,
+                  game_viewport_width, game_viewport_height);
+
+    openGLState.disable(GL_SCISSOR_TEST);
+    std::future<RgbaImage> result = _screenReadback.request(screenFramebuffer, srcRect, Sizei(width, height));
+    openGLState.enable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, screenFramebuffer);
+    return result;
+}
 
-    return pPixels;
+void OpenGLRenderer::FinishScreenshots() {
+    _screenReadback.poll(true);
 }
 
 // TODO(pskelton): drop - not required in gl renderer now
@@ -1045,86 +1118,26 @@ bool OpenGLRenderer::DrawLightmap(struct Lightmap *pLightmap, Vec3f *pColorMult,
     return true;
 }
 
-struct GLdecalverts {
-    GLfloat x;
-    GLfloat y;
-    GLfloat z;
-    GLfloat u;
-    GLfloat v;
-    GLfloat texunit;
-    GLfloat red;
-    GLfloat green;
-    GLfloat blue;
-    GLfloat attribs;
-};
-
-GLdecalverts decalshaderstore[10000] = {};
-int numdecalverts{ 0 };
-
-
 void OpenGLRenderer::BeginDecals() {
-    GraphicsImage *texture = assets->getBitmap("hwsplat04");
-    glBindTexture(GL_TEXTURE_2D, texture->renderId().value());
-
-    glDisable(GL_CULL_FACE);
-    glDepthMask(GL_FALSE);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
-
-    // gen buffers
-
-    if (decalVAO == 0) {
-        glGenVertexArrays(1, &decalVAO);
-        glGenBuffers(1, &decalVBO);
-
-        glBindVertexArray(decalVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, decalVBO);
-
-        glBufferData(GL_ARRAY_BUFFER, sizeof(GLdecalverts) * 10000, decalshaderstore, GL_DYNAMIC_DRAW);
-
-        // position attribute
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GLdecalverts), (void *)offsetof(GLdecalverts, x));
-        glEnableVertexAttribArray(0);
-        // tex uv attribute
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GLdecalverts), (void *)offsetof(GLdecalverts, u));
-        glEnableVertexAttribArray(1);
-        // tex unit attribute
-        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(GLdecalverts), (void *)offsetof(GLdecalverts, texunit));
-        glEnableVertexAttribArray(2);
-        // colours
-        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(GLdecalverts), (void *)offsetof(GLdecalverts, red));
-        glEnableVertexAttribArray(3);
-        // attribs - not used here yet
-        glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(GLdecalverts), (void *)offsetof(GLdecalverts, attribs));
-        glEnableVertexAttribArray(4);
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-    }
-
-    numdecalverts = 0;
+    _decalBuffer.beginFrame();
 }
 
 void OpenGLRenderer::EndDecals() {
-    // draw here
-
-    if (numdecalverts) {
-            glBindBuffer(GL_ARRAY_BUFFER, decalVBO);
-            // orphan buffer
-            glBufferData(GL_ARRAY_BUFFER, sizeof(GLdecalverts) * 10000, NULL, GL_DYNAMIC_DRAW);
-            // update buffer
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(GLdecalverts) * numdecalverts, decalshaderstore);
-    } else {
+    if (_decalBuffer.empty())
         return;
-    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    OpenGLPassTimerScope passTimer(&_passTimers, RENDER_PASS_DECALS);
+
+    openGLState.disable(GL_CULL_FACE);
+    openGLState.depthMask(GL_FALSE);
+    openGLState.enable(GL_BLEND);
+    openGLState.blendFunc(GL_ONE, GL_ONE);
 
     // ?
     _set_3d_projection_matrix();
     _set_3d_modelview_matrix();
 
-    glUseProgram(decalshader.ID);
+    openGLState.useProgram(decalshader.ID);
     // set projection
     glUniformMatrix4fv(glGetUniformLocation(decalshader.ID, "projection"), 1, GL_FALSE, &projmat[0][0]);
     // set view
@@ -1141,39 +1154,22 @@ void OpenGLRenderer::EndDecals() {
 
     // set texture unit location
     glUniform1i(glGetUniformLocation(decalshader.ID, "texture0"), GLint(0));
-    glActiveTexture(GL_TEXTURE0);
+    openGLState.activeTexture(GL_TEXTURE0);
 
     GraphicsImage *texture = assets->getBitmap("hwsplat04");
-    glBindTexture(GL_TEXTURE_2D, texture->renderId().value());
-
-    glBindVertexArray(decalVAO);
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-    glEnableVertexAttribArray(2);
-    glEnableVertexAttribArray(3);
-    glEnableVertexAttribArray(4);
+    openGLState.bindTexture(GL_TEXTURE_2D, texture->renderId().value());
 
-    glDrawArrays(GL_TRIANGLES, 0, numdecalverts);
-    drawcalls++;
+    drawcalls += _decalBuffer.draw(decalshader.ID, DECAL_COLORS_TEXTURE_UNIT);
 
     // unload
-    glUseProgram(0);
-    glDisableVertexAttribArray(0);
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(2);
-    glDisableVertexAttribArray(3);
-    glDisableVertexAttribArray(4);
-    glBindVertexArray(0);
-    //glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    glEnable(GL_CULL_FACE);
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
-}
-
+    openGLState.useProgram(0);
+    openGLState.activeTexture(GL_TEXTURE0);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
 
+    openGLState.enable(GL_CULL_FACE);
+    openGLState.depthMask(GL_TRUE);
+    openGLState.disable(GL_BLEND);
+}
 
 void OpenGLRenderer::DrawDecal(struct Decal *pDecal, float z_bias) {
     if (pDecal->uNumVertices < 3) {
@@ -1184,57 +1180,14 @@ void OpenGLRenderer::DrawDecal(struct Decal *pDecal, float z_bias) {
     float color_mult = pDecal->Fade_by_time();
     if (color_mult == 0.0f) return;
 
-    // temp - bloodsplat persistance
-    // color_mult = 1;
-
-    // load into buffer
+    // Geometry is cached in the decal buffer, only the color is recalculated every frame. Decal vertices don't have
+    // view space positions set, so the tint is the same for all of them.
     Colorf decalColorMult = pDecal->uColorMultiplier.toColorf();
-
-    for (int z = 0; z < (pDecal->uNumVertices - 2); z++) {
-        // 123, 134, 145, 156..
-        GLdecalverts *thisvert = &decalshaderstore[numdecalverts];
-        Colorf uTint = GetActorTintColor(pDecal->DimmingLevel, 0, pDecal->pVertices[0].vWorldViewPosition.x, 0, nullptr).toColorf();
-
-        float uFinalR = uTint.r * color_mult * decalColorMult.r;
-        float uFinalG = uTint.g * color_mult * decalColorMult.g;
-        float uFinalB = uTint.b * color_mult * decalColorMult.b;
-
-        // copy first
-        thisvert->x = pDecal->pVertices[0].vWorldPosition.x;
-        thisvert->y = pDecal->pVertices[0].vWorldPosition.y;
-        thisvert->z = pDecal->pVertices[0].vWorldPosition.z;
-        thisvert->u = pDecal->pVertices[0].u;
-        thisvert->v = pDecal->pVertices[0].v;
-        thisvert->texunit = 0;
-        thisvert->red = uFinalR;
-        thisvert->green = uFinalG;
-        thisvert->blue = uFinalB;
-        thisvert->attribs = 0;
-        thisvert++;
-
-        // copy other two (z+1)(z+2)
-        for (unsigned i = 1; i < 3; ++i) {
-            uTint = GetActorTintColor(pDecal->DimmingLevel, 0, pDecal->pVertices[z + i].vWorldViewPosition.x, 0, nullptr).toColorf();
-            uFinalR = uTint.r * color_mult * decalColorMult.r;
-            uFinalG = uTint.g * color_mult * decalColorMult.g;
-            uFinalB = uTint.b * color_mult * decalColorMult.b;
-
-            thisvert->x = pDecal->pVertices[z + i].vWorldPosition.x;
-            thisvert->y = pDecal->pVertices[z + i].vWorldPosition.y;
-            thisvert->z = pDecal->pVertices[z + i].vWorldPosition.z;
-            thisvert->u = pDecal->pVertices[z + i].u;
-            thisvert->v = pDecal->pVertices[z + i].v;
-            thisvert->texunit = 0;
-            thisvert->red = uFinalR;
-            thisvert->green = uFinalG;
-            thisvert->blue = uFinalB;
-            thisvert->attribs = 0;
-            thisvert++;
-        }
-
-        numdecalverts += 3;
-        assert(numdecalverts <= 9999);
-    }
+    Colorf uTint = GetActorTintColor(pDecal->DimmingLevel, 0, pDecal->pVertices[0].vWorldViewPosition.x, 0,
+                                     nullptr).toColorf();
+    _decalBuffer.add(*pDecal, Colorf(uTint.r * color_mult * decalColorMult.r,
+                                     uTint.g * color_mult * decalColorMult.g,
+                                     uTint.b * color_mult * decalColorMult.b));
 }
 
 void OpenGLRenderer::DrawFromSpriteSheet(Recti *pSrcRect, Pointi *pTargetPoint, int a3, int blend_mode) {
@@ -1354,18 +1307,101 @@ void OpenGLRenderer::Update_Texture(GraphicsImage *texture) {
     UpdateTexture(texture->renderId(), texture->rgba());
 }
 
+// Expects the target texture to be bound to GL_TEXTURE_2D.
+static void uploadTexturePixels(OpenGLStreamBuffer *staging, RgbaImageView image) {
+    size_t size = image.pixels().size() * sizeof(Color);
+    if (!staging->isInitialized() || size > staging->segmentSize()) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.width(), image.height(), GL_RGBA, GL_UNSIGNED_BYTE, image.pixels().data());
+        return;
+    }
+
+    // The copy from the staging buffer is performed by the GPU, ordered with the draws that use the texture, so
+    // there is no need to wait for it here. Buffer segment won't be reused before the copy is done.
+    GLint first = staging->upload(image.pixels().data(), image.pixels().size());
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging->id());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.width(), image.height(), GL_RGBA, GL_UNSIGNED_BYTE,
+                    reinterpret_cast<const void *>(static_cast<std::uintptr_t>(first) * sizeof(Color)));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
 TextureRenderId OpenGLRenderer::CreateTexture(RgbaImageView image) {
     assert(image);
 
     GLuint glId;
     glGenTextures(1, &glId);
-    glBindTexture(GL_TEXTURE_2D, glId);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width(), image.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels().data());
+    openGLState.bindTexture(GL_TEXTURE_2D, glId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width(), image.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    uploadTexturePixels(&_textureStagingBuffer, image);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
+
+    size_t size = image.width() * image.height() * sizeof(Color);
+    _textureSizes[glId] = size;
+    MemoryAccounting::allocate(MEMORY_TAG_GPU_TEXTURES, size);
+
+    return TextureRenderId(glId);
+}
+
+TextureRenderId OpenGLRenderer::CreatePalettedTexture(GrayscaleImageView image, const Palette &palette) {
+    assert(image);
+
+    size_t size = image.pixels().size() * sizeof(Color);
+    if (!_textureStagingBuffer.isInitialized() || size > _textureStagingBuffer.segmentSize())
+        return CreateTexture(makeRgbaImage(image, palette));
+
+    GLuint glId;
+    glGenTextures(1, &glId);
+    openGLState.bindTexture(GL_TEXTURE_2D, glId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width(), image.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    // Palette is expanded right into the staging buffer, see `uploadTexturePixels` for the details on the upload.
+    GLint first = _textureStagingBuffer.upload(size, sizeof(Color), [&](void *dst) {
+        expandPalette(image.pixels(), palette, std::span(static_cast<Color *>(dst), image.pixels().size()));
+    });
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _textureStagingBuffer.id());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.width(), image.height(), GL_RGBA, GL_UNSIGNED_BYTE,
+                    reinterpret_cast<const void *>(static_cast<std::uintptr_t>(first) * sizeof(Color)));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
+
+    _textureSizes[glId] = size;
+    MemoryAccounting::allocate(MEMORY_TAG_GPU_TEXTURES, size);
+
+    return TextureRenderId(glId);
+}
+
+TextureRenderId OpenGLRenderer::CreateIndexedTexture(GrayscaleImageView image) {
+    assert(image);
+
+    GLuint glId;
+    glGenTextures(1, &glId);
+    openGLState.bindTexture(GL_TEXTURE_2D, glId);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, image.width(), image.height(), 0, GL_RED, GL_UNSIGNED_BYTE, image.pixels().data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Index goes into alpha too, so that index zero is transparent. Shaders replace the alpha of all the other
+    // indices when applying the palette.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ZERO);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ZERO);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
+
+    size_t size = image.width() * image.height();
+    _textureSizes[glId] = size;
+    MemoryAccounting::allocate(MEMORY_TAG_GPU_TEXTURES, size);
 
     return TextureRenderId(glId);
 }
@@ -1375,16 +1411,22 @@ void OpenGLRenderer::DeleteTexture(TextureRenderId id) {
         return;
 
     GLuint glId = id.value();
-    glDeleteTextures(1, &glId);
+    openGLState.deleteTextures(1, &glId);
+    _spriteAtlas.remove(glId);
+
+    if (auto pos = _textureSizes.find(glId); pos != _textureSizes.end()) {
+        MemoryAccounting::deallocate(MEMORY_TAG_GPU_TEXTURES, pos->second);
+        _textureSizes.erase(pos);
+    }
 }
 
 void OpenGLRenderer::UpdateTexture(TextureRenderId id, RgbaImageView image) {
     assert(image);
     assert(id);
 
-    glBindTexture(GL_TEXTURE_2D, id.value());
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.width(), image.height(), GL_RGBA, GL_UNSIGNED_BYTE, image.pixels().data());
-    glBindTexture(GL_TEXTURE_2D, 0);
+    openGLState.bindTexture(GL_TEXTURE_2D, id.value());
+    uploadTexturePixels(&_textureStagingBuffer, image);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
 }
 
 // TODO(pskelton): to camera?
@@ -1415,10 +1457,11 @@ void OpenGLRenderer::_set_3d_modelview_matrix() {
 // TODO(pskelton): to camera?
 void OpenGLRenderer::_set_ortho_projection(bool gameviewport) {
     if (!gameviewport) {  // project over entire window
-        glViewport(0, 0, outputRender.w, outputRender.h);
+        openGLState.viewport(0, 0, outputRender.w, outputRender.h);
         projmat = glm::ortho(float(0), float(outputRender.w), float(outputRender.h), float(0), float(-1), float(1));
     } else {  // project to game viewport
-        glViewport(game_viewport_x, outputRender.h-game_viewport_w-1, game_viewport_width, game_viewport_height);
+        Recti viewport = gameViewportRect();
+        openGLState.viewport(viewport.x, viewport.y, viewport.w, viewport.h);
         projmat = glm::ortho(float(game_viewport_x), float(game_viewport_z), float(game_viewport_w), float(game_viewport_y), float(1), float(-1));
     }
 }
@@ -1429,6 +1472,106 @@ void OpenGLRenderer::_set_ortho_modelview() {
     viewmat = glm::mat4x4(1);
 }
 
+static ClusteredLight makeClusteredLight(const Vec3f &pos, float radius, Color color, bool specular,
+                                         LightBlendMode blendMode, int sectorId = 0) {
+    ClusteredLight result;
+    result.position = pos;
+    result.radius = radius;
+    result.diffuse = color.toColorf();
+    result.specular = specular ? result.diffuse : Colorf(0.0f, 0.0f, 0.0f);
+    result.blendMode = blendMode;
+    result.sectorId = sectorId;
+    return result;
+}
+
+// Party torchlight goes first so that it's never dropped from a cluster, then stationary lights, and then mobile
+// lights.
+static void gatherOutdoorLights(std::vector<ClusteredLight> *lights) {
+    // party torchlight - can be radius == 0
+    if (!pMobileLightsStack->pLights.empty()) {
+        const MobileLight &torch = pMobileLightsStack->pLights[0];
+        lights->push_back(makeClusteredLight(torch.vPosition, torch.uRadius, torch.uLightColor, false, LIGHT_BLEND_MODULATED));
+    }
+
+    for (const StationaryLight &light : pStationaryLightsStack->pLights)
+        lights->push_back(makeClusteredLight(light.vPosition, light.uRadius, light.uLightColor, true, LIGHT_BLEND_MODULATED));
+
+    for (size_t i = 1; i < pMobileLightsStack->pLights.size(); ++i) {
+        const MobileLight &light = pMobileLightsStack->pLights[i];
+        lights->push_back(makeClusteredLight(light.vPosition, light.uRadius, light.uLightColor, true, LIGHT_BLEND_ADDITIVE));
+    }
+}
+
+static void gatherIndoorLights(std::vector<ClusteredLight> *lights) {
+    // party torchlight
+    if (!pMobileLightsStack->pLights.empty()) {
+        const MobileLight &torch = pMobileLightsStack->pLights[0];
+        lights->push_back(makeClusteredLight(torch.vPosition, torch.uRadius, torch.uLightColor, false, LIGHT_BLEND_MODULATED));
+    }
+
+    // static lights next (wall torches), only the ones that can be seen through the portals
+    for (const StationaryLight &light : pStationaryLightsStack->pLights) {
+        // is this on the sector list
+        bool onlist = false;
+        for (unsigned i = 0; i < pBspRenderer->uNumVisibleNotEmptySectors; ++i) {
+            if (light.uSectorID == pBspRenderer->pVisibleSectorIDs_toDrawDecorsActorsEtcFrom[i]) {
+                onlist = true;
+                break;
+            }
+        }
+
+        // does light sphere collide with current sector
+        // expanded current sector
+        bool fromexpanded = false;
+        if (pIndoor->pSectors[pBLVRenderParams->uPartySectorID].pBounding.intersectsCube(light.vPosition, light.uRadius)) {
+            onlist = true;
+            fromexpanded = true;
+        }
+
+        if (!onlist)
+            continue;
+
+        // cull through viewing frustum
+        bool visinfrustum = false;
+        if (!fromexpanded) {
+            for (BspRenderer_ViewportNode &node : pBspRenderer->nodes) {
+                if (node.uSectorID == light.uSectorID && IsSphereInFrustum(light.vPosition, light.uRadius, node.ViewportNodeFrustum.data()))
+                    visinfrustum = true;
+            }
+        } else {
+            visinfrustum = IsSphereInFrustum(light.vPosition, light.uRadius);
+        }
+        if (!visinfrustum)
+            continue;
+
+        lights->push_back(makeClusteredLight(light.vPosition, light.uRadius, light.uLightColor, false, LIGHT_BLEND_MODULATED,
+                                             light.uSectorID));
+    }
+
+    // mobile lights
+    for (size_t i = 1; i < pMobileLightsStack->pLights.size(); ++i) {
+        const MobileLight &light = pMobileLightsStack->pLights[i];
+        if (!IsSphereInFrustum(light.vPosition, light.uRadius))
+            continue;
+        lights->push_back(makeClusteredLight(light.vPosition, light.uRadius, light.uLightColor, false, LIGHT_BLEND_ADDITIVE));
+    }
+}
+
+void OpenGLRenderer::bindLightClusters(GLuint program) {
+    // The grid is built by the first world pass of the frame, the rest of the passes reuse it.
+    if (!_lightClusters.isValid()) {
+        _clusteredLights.clear();
+        if (uCurrentlyLoadedLevelType == LEVEL_INDOOR) {
+            gatherIndoorLights(&_clusteredLights);
+        } else {
+            gatherOutdoorLights(&_clusteredLights);
+        }
+        _lightClusters.update(_clusteredLights, viewmat, projmat, pCamera3D->GetNearClip(), pCamera3D->GetFarClip());
+    }
+
+    _lightClusters.bind(program, LIGHT_CLUSTERS_FIRST_TEXTURE_UNIT);
+}
+
 
 // ---------------------- terrain -----------------------
 const int terrain_block_scale = 512;
@@ -1452,16 +1595,45 @@ struct GLshaderverts {
 
 GLshaderverts terrshaderstore[127 * 127 * 6] = {};
 
+// Terrain is split into chunks of TERRAIN_CHUNK_CELLS x TERRAIN_CHUNK_CELLS cells that are culled against the view
+// frustum separately. Vertices of a single chunk are stored contiguously in `terrshaderstore`.
+static constexpr int TERRAIN_CHUNK_CELLS = 16;
+static constexpr int TERRAIN_CHUNKS_PER_SIDE = (127 + TERRAIN_CHUNK_CELLS - 1) / TERRAIN_CHUNK_CELLS;
+
+struct TerrainChunk {
+    BBoxf bbox;
+    GLint first = 0; // First vertex in `terrshaderstore`.
+    GLsizei count = 0; // Number of vertices.
+};
+
+static std::array<TerrainChunk, TERRAIN_CHUNKS_PER_SIDE * TERRAIN_CHUNKS_PER_SIDE> terrainChunks;
+
+/**
+ * @param x                             Cell x.
+ * @param y                             Cell y.
+ * @return                              Index of the first of the six vertices of the cell in `terrshaderstore`.
+ */
+static int terrainCellVertexOffset(int x, int y) {
+    assert(x >= 0 && x < 127 && y >= 0 && y < 127);
+    const TerrainChunk &chunk = terrainChunks[(y / TERRAIN_CHUNK_CELLS) * TERRAIN_CHUNKS_PER_SIDE + x / TERRAIN_CHUNK_CELLS];
+    int chunkWidth = std::min(TERRAIN_CHUNK_CELLS, 127 - x / TERRAIN_CHUNK_CELLS * TERRAIN_CHUNK_CELLS);
+    return chunk.first + 6 * ((y % TERRAIN_CHUNK_CELLS) * chunkWidth + x % TERRAIN_CHUNK_CELLS);
+}
+
 void OpenGLRenderer::DrawOutdoorTerrain() {
+    OE_PROFILE_ZONE("gl terrain");
+
+    OpenGLPassTimerScope passTimer(&_passTimers, RENDER_PASS_TERRAIN);
+
     // shader version
-    // draws entire terrain in one go at the moment
+    // terrain is drawn in chunks, only the chunks in the view frustum are drawn
     // textures must all be square and same size
     // terrain is static and verts only submitted once on VAO creation
 
     // face culling
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
-    glFrontFace(GL_CCW);
+    openGLState.enable(GL_CULL_FACE);
+    openGLState.cullFace(GL_BACK);
+    openGLState.frontFace(GL_CCW);
 
     // camera matrices
     _set_3d_projection_matrix();
@@ -1483,6 +1655,31 @@ void OpenGLRenderer::DrawOutdoorTerrain() {
             }
         }
 
+        // lay out the chunks
+        GLint first = 0;
+        for (int cy = 0; cy < TERRAIN_CHUNKS_PER_SIDE; ++cy) {
+            for (int cx = 0; cx < TERRAIN_CHUNKS_PER_SIDE; ++cx) {
+                int x1 = cx * TERRAIN_CHUNK_CELLS;
+                int y1 = cy * TERRAIN_CHUNK_CELLS;
+                int x2 = std::min(x1 + TERRAIN_CHUNK_CELLS, 127);
+                int y2 = std::min(y1 + TERRAIN_CHUNK_CELLS, 127);
+
+                TerrainChunk &chunk = terrainChunks[cy * TERRAIN_CHUNKS_PER_SIDE + cx];
+                chunk.first = first;
+                chunk.count = 6 * (x2 - x1) * (y2 - y1);
+                first += chunk.count;
+
+                chunk.bbox = BBoxf::forPoints(pTerrainVertices[y1 * 128 + x1].vWorldPosition, pTerrainVertices[y2 * 128 + x2].vWorldPosition);
+                for (int y = y1; y <= y2; ++y) {
+                    for (int x = x1; x <= x2; ++x) {
+                        chunk.bbox.z1 = std::min(chunk.bbox.z1, pTerrainVertices[y * 128 + x].vWorldPosition.z);
+                        chunk.bbox.z2 = std::max(chunk.bbox.z2, pTerrainVertices[y * 128 + x].vWorldPosition.z);
+                    }
+                }
+            }
+        }
+        assert(first == 127 * 127 * 6);
+
         // reserve first 7 layers for water tiles in unit 0
         auto wtrtexture = this->hd_water_tile_anim[0];
         terraintexturesizes[0] = wtrtexture->width();
@@ -1556,83 +1753,85 @@ void OpenGLRenderer::DrawOutdoorTerrain() {
                 Vec3f *norm2 = &pTerrainNormals[bottnormidx];
 
                 // calc each vertex
+                GLshaderverts *cellverts = &terrshaderstore[terrainCellVertexOffset(x, y)];
+
                 // [0] - x,y        n1
-                terrshaderstore[6 * (x + (127 * y))].x = pTerrainVertices[y * 128 + x].vWorldPosition.x;
-                terrshaderstore[6 * (x + (127 * y))].y = pTerrainVertices[y * 128 + x].vWorldPosition.y;
-                terrshaderstore[6 * (x + (127 * y))].z = pTerrainVertices[y * 128 + x].vWorldPosition.z;
-                terrshaderstore[6 * (x + (127 * y))].u = 0;
-                terrshaderstore[6 * (x + (127 * y))].v = 0;
-                terrshaderstore[6 * (x + (127 * y))].texunit = tileunit;
-                terrshaderstore[6 * (x + (127 * y))].texturelayer = tilelayer;
-                terrshaderstore[6 * (x + (127 * y))].normx = norm->x;
-                terrshaderstore[6 * (x + (127 * y))].normy = norm->y;
-                terrshaderstore[6 * (x + (127 * y))].normz = norm->z;
-                terrshaderstore[6 * (x + (127 * y))].attribs = 0;
+                cellverts[0].x = pTerrainVertices[y * 128 + x].vWorldPosition.x;
+                cellverts[0].y = pTerrainVertices[y * 128 + x].vWorldPosition.y;
+                cellverts[0].z = pTerrainVertices[y * 128 + x].vWorldPosition.z;
+                cellverts[0].u = 0;
+                cellverts[0].v = 0;
+                cellverts[0].texunit = tileunit;
+                cellverts[0].texturelayer = tilelayer;
+                cellverts[0].normx = norm->x;
+                cellverts[0].normy = norm->y;
+                cellverts[0].normz = norm->z;
+                cellverts[0].attribs = 0;
 
                 // [1] - x+1,y+1    n1
-                terrshaderstore[6 * (x + (127 * y)) + 1].x = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.x;
-                terrshaderstore[6 * (x + (127 * y)) + 1].y = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.y;
-                terrshaderstore[6 * (x + (127 * y)) + 1].z = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.z;
-                terrshaderstore[6 * (x + (127 * y)) + 1].u = 1;
-                terrshaderstore[6 * (x + (127 * y)) + 1].v = 1;
-                terrshaderstore[6 * (x + (127 * y)) + 1].texunit = tileunit;
-                terrshaderstore[6 * (x + (127 * y)) + 1].texturelayer = tilelayer;
-                terrshaderstore[6 * (x + (127 * y)) + 1].normx = norm->x;
-                terrshaderstore[6 * (x + (127 * y)) + 1].normy = norm->y;
-                terrshaderstore[6 * (x + (127 * y)) + 1].normz = norm->z;
-                terrshaderstore[6 * (x + (127 * y)) + 1].attribs = 0;
+                cellverts[1].x = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.x;
+                cellverts[1].y = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.y;
+                cellverts[1].z = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.z;
+                cellverts[1].u = 1;
+                cellverts[1].v = 1;
+                cellverts[1].texunit = tileunit;
+                cellverts[1].texturelayer = tilelayer;
+                cellverts[1].normx = norm->x;
+                cellverts[1].normy = norm->y;
+                cellverts[1].normz = norm->z;
+                cellverts[1].attribs = 0;
 
                 // [2] - x+1,y      n1
-                terrshaderstore[6 * (x + (127 * y)) + 2].x = pTerrainVertices[y * 128 + x + 1].vWorldPosition.x;
-                terrshaderstore[6 * (x + (127 * y)) + 2].y = pTerrainVertices[y * 128 + x + 1].vWorldPosition.y;
-                terrshaderstore[6 * (x + (127 * y)) + 2].z = pTerrainVertices[y * 128 + x + 1].vWorldPosition.z;
-                terrshaderstore[6 * (x + (127 * y)) + 2].u = 1;
-                terrshaderstore[6 * (x + (127 * y)) + 2].v = 0;
-                terrshaderstore[6 * (x + (127 * y)) + 2].texunit = tileunit;
-                terrshaderstore[6 * (x + (127 * y)) + 2].texturelayer = tilelayer;
-                terrshaderstore[6 * (x + (127 * y)) + 2].normx = norm->x;
-                terrshaderstore[6 * (x + (127 * y)) + 2].normy = norm->y;
-                terrshaderstore[6 * (x + (127 * y)) + 2].normz = norm->z;
-                terrshaderstore[6 * (x + (127 * y)) + 2].attribs = 0;
+                cellverts[2].x = pTerrainVertices[y * 128 + x + 1].vWorldPosition.x;
+                cellverts[2].y = pTerrainVertices[y * 128 + x + 1].vWorldPosition.y;
+                cellverts[2].z = pTerrainVertices[y * 128 + x + 1].vWorldPosition.z;
+                cellverts[2].u = 1;
+                cellverts[2].v = 0;
+                cellverts[2].texunit = tileunit;
+                cellverts[2].texturelayer = tilelayer;
+                cellverts[2].normx = norm->x;
+                cellverts[2].normy = norm->y;
+                cellverts[2].normz = norm->z;
+                cellverts[2].attribs = 0;
 
                 // [3] - x,y        n2
-                terrshaderstore[6 * (x + (127 * y)) + 3].x = pTerrainVertices[y * 128 + x].vWorldPosition.x;
-                terrshaderstore[6 * (x + (127 * y)) + 3].y = pTerrainVertices[y * 128 + x].vWorldPosition.y;
-                terrshaderstore[6 * (x + (127 * y)) + 3].z = pTerrainVertices[y * 128 + x].vWorldPosition.z;
-                terrshaderstore[6 * (x + (127 * y)) + 3].u = 0;
-                terrshaderstore[6 * (x + (127 * y)) + 3].v = 0;
-                terrshaderstore[6 * (x + (127 * y)) + 3].texunit = tileunit;
-                terrshaderstore[6 * (x + (127 * y)) + 3].texturelayer = tilelayer;
-                terrshaderstore[6 * (x + (127 * y)) + 3].normx = norm2->x;
-                terrshaderstore[6 * (x + (127 * y)) + 3].normy = norm2->y;
-                terrshaderstore[6 * (x + (127 * y)) + 3].normz = norm2->z;
-                terrshaderstore[6 * (x + (127 * y)) + 3].attribs = 0;
+                cellverts[3].x = pTerrainVertices[y * 128 + x].vWorldPosition.x;
+                cellverts[3].y = pTerrainVertices[y * 128 + x].vWorldPosition.y;
+                cellverts[3].z = pTerrainVertices[y * 128 + x].vWorldPosition.z;
+                cellverts[3].u = 0;
+                cellverts[3].v = 0;
+                cellverts[3].texunit = tileunit;
+                cellverts[3].texturelayer = tilelayer;
+                cellverts[3].normx = norm2->x;
+                cellverts[3].normy = norm2->y;
+                cellverts[3].normz = norm2->z;
+                cellverts[3].attribs = 0;
 
                 // [4] - x,y+1      n2
-                terrshaderstore[6 * (x + (127 * y)) + 4].x = pTerrainVertices[(y + 1) * 128 + x].vWorldPosition.x;
-                terrshaderstore[6 * (x + (127 * y)) + 4].y = pTerrainVertices[(y + 1) * 128 + x].vWorldPosition.y;
-                terrshaderstore[6 * (x + (127 * y)) + 4].z = pTerrainVertices[(y + 1) * 128 + x].vWorldPosition.z;
-                terrshaderstore[6 * (x + (127 * y)) + 4].u = 0;
-                terrshaderstore[6 * (x + (127 * y)) + 4].v = 1;
-                terrshaderstore[6 * (x + (127 * y)) + 4].texunit = tileunit;
-                terrshaderstore[6 * (x + (127 * y)) + 4].texturelayer = tilelayer;
-                terrshaderstore[6 * (x + (127 * y)) + 4].normx = norm2->x;
-                terrshaderstore[6 * (x + (127 * y)) + 4].normy = norm2->y;
-                terrshaderstore[6 * (x + (127 * y)) + 4].normz = norm2->z;
-                terrshaderstore[6 * (x + (127 * y)) + 4].attribs = 0;
+                cellverts[4].x = pTerrainVertices[(y + 1) * 128 + x].vWorldPosition.x;
+                cellverts[4].y = pTerrainVertices[(y + 1) * 128 + x].vWorldPosition.y;
+                cellverts[4].z = pTerrainVertices[(y + 1) * 128 + x].vWorldPosition.z;
+                cellverts[4].u = 0;
+                cellverts[4].v = 1;
+                cellverts[4].texunit = tileunit;
+                cellverts[4].texturelayer = tilelayer;
+                cellverts[4].normx = norm2->x;
+                cellverts[4].normy = norm2->y;
+                cellverts[4].normz = norm2->z;
+                cellverts[4].attribs = 0;
 
                 // [5] - x+1,y+1    n2
-                terrshaderstore[6 * (x + (127 * y)) + 5].x = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.x;
-                terrshaderstore[6 * (x + (127 * y)) + 5].y = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.y;
-                terrshaderstore[6 * (x + (127 * y)) + 5].z = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.z;
-                terrshaderstore[6 * (x + (127 * y)) + 5].u = 1;
-                terrshaderstore[6 * (x + (127 * y)) + 5].v = 1;
-                terrshaderstore[6 * (x + (127 * y)) + 5].texunit = tileunit;
-                terrshaderstore[6 * (x + (127 * y)) + 5].texturelayer = tilelayer;
-                terrshaderstore[6 * (x + (127 * y)) + 5].normx = norm2->x;
-                terrshaderstore[6 * (x + (127 * y)) + 5].normy = norm2->y;
-                terrshaderstore[6 * (x + (127 * y)) + 5].normz = norm2->z;
-                terrshaderstore[6 * (x + (127 * y)) + 5].attribs = 0;
+                cellverts[5].x = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.x;
+                cellverts[5].y = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.y;
+                cellverts[5].z = pTerrainVertices[(y + 1) * 128 + x + 1].vWorldPosition.z;
+                cellverts[5].u = 1;
+                cellverts[5].v = 1;
+                cellverts[5].texunit = tileunit;
+                cellverts[5].texturelayer = tilelayer;
+                cellverts[5].normx = norm2->x;
+                cellverts[5].normy = norm2->y;
+                cellverts[5].normz = norm2->z;
+                cellverts[5].attribs = 0;
             }
         }
 
@@ -1640,11 +1839,12 @@ void OpenGLRenderer::DrawOutdoorTerrain() {
         glGenVertexArrays(1, &terrainVAO);
         glGenBuffers(1, &terrainVBO);
 
-        glBindVertexArray(terrainVAO);
+        openGLState.bindVertexArray(terrainVAO);
         glBindBuffer(GL_ARRAY_BUFFER, terrainVBO);
 
         // submit vert data
         glBufferData(GL_ARRAY_BUFFER, sizeof(terrshaderstore), terrshaderstore, GL_STATIC_DRAW);
+        MemoryAccounting::allocate(MEMORY_TAG_GPU_BUFFERS, sizeof(terrshaderstore));
         // submit data layout
         // position attribute
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, x));
@@ -1670,11 +1870,14 @@ void OpenGLRenderer::DrawOutdoorTerrain() {
             if (numterraintexloaded[unit] == 0) continue;
 
             glGenTextures(1, &terraintextures[unit]);
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D_ARRAY, terraintextures[unit]);
+            openGLState.activeTexture(GL_TEXTURE0);
+            openGLState.bindTexture(GL_TEXTURE_2D_ARRAY, terraintextures[unit]);
 
             // create blank memory for later texture submission
-            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, terraintexturesizes[unit], terraintexturesizes[unit], numterraintexloaded[unit], 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            size_t size = _textureArrayUploader.allocate(terraintexturesizes[unit], terraintexturesizes[unit],
+                                                         numterraintexloaded[unit], _videoMemoryInfo.textureMipBias);
+            _terrainTexturesSize += size;
+            MemoryAccounting::allocate(MEMORY_TAG_GPU_TEXTURES, size);
 
             // loop through texture map
             std::map<std::string, int>::iterator it = terraintexmap.begin();
@@ -1687,24 +1890,16 @@ void OpenGLRenderer::DrawOutdoorTerrain() {
                     // get texture
                     auto texture = assets->getBitmap(it->first);
                     // send texture data to gpu
-                    glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
-                        0,
-                        0, 0, tlayer,
-                        terraintexturesizes[unit], terraintexturesizes[unit], 1,
-                        GL_RGBA,
-                        GL_UNSIGNED_BYTE,
-                        texture->rgba().pixels().data());
+                    _textureArrayUploader.upload(tlayer, texture->rgba(), _videoMemoryInfo.textureMipBias);
                 }
 
                 it++;
             }
 
             // last texture setups
-            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
             glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
             glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+            _textureArrayUploader.finish();
         }
     }
 
@@ -1721,13 +1916,13 @@ void OpenGLRenderer::DrawOutdoorTerrain() {
     for (int unit = 0; unit < 8; unit++) {
         // skip if textures are empty
         if (numterraintexloaded[unit] > 0) {
-            glActiveTexture(GL_TEXTURE0 + unit);
-            glBindTexture(GL_TEXTURE_2D_ARRAY, terraintextures[unit]);
+            openGLState.activeTexture(GL_TEXTURE0 + unit);
+            openGLState.bindTexture(GL_TEXTURE_2D_ARRAY, terraintextures[unit]);
         }
     }
 
     // load terrain verts
-    glBindVertexArray(terrainVAO);
+    openGLState.bindVertexArray(terrainVAO);
     glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
     glEnableVertexAttribArray(2);
@@ -1735,7 +1930,7 @@ void OpenGLRenderer::DrawOutdoorTerrain() {
     glEnableVertexAttribArray(4);
 
     // use the terrain shader
-    glUseProgram(terrainshader.ID);
+    openGLState.useProgram(terrainshader.ID);
 
     // set projection matrix
     glUniformMatrix4fv(glGetUniformLocation(terrainshader.ID, "projection"), 1, GL_FALSE, &projmat[0][0]);
@@ -1755,10 +1950,7 @@ void OpenGLRenderer::DrawOutdoorTerrain() {
     glUniform1f(glGetUniformLocation(terrainshader.ID, "fog.fogmiddle"), GLfloat(fogmiddle));
     glUniform1f(glGetUniformLocation(terrainshader.ID, "fog.fogend"), GLfloat(fogend));
 
-    GLfloat camera[3] {};
-    camera[0] = (float)(pParty->pos.x - pParty->_yawGranularity * cosf(2 * pi_double * pParty->_viewYaw / 2048.0));
-    camera[1] = (float)(pParty->pos.y - pParty->_yawGranularity * sinf(2 * pi_double * pParty->_viewYaw / 2048.0));
-    camera[2] = (float)(pParty->pos.z + pParty->eyeLevel);
+    GLfloat camera[3] {pCamera3D->vCameraPos.x, pCamera3D->vCameraPos.y, pCamera3D->vCameraPos.z};
     glUniform3fv(glGetUniformLocation(terrainshader.ID, "CameraPos"), 1, &camera[0]);
 
 
@@ -1779,108 +1971,49 @@ void OpenGLRenderer::DrawOutdoorTerrain() {
         glUniform3f(glGetUniformLocation(terrainshader.ID, "sun.specular"), 0, 0, 0);
     }
 
+    // point lights
+    bindLightClusters(terrainshader.ID);
 
-    // TODO(pskelton): this should be a seperate function
-    // rest of lights stacking
-    GLuint num_lights = 0;
-
-    // get party torchlight as priority - can be radius == 0
-    for (int i = 0; i < 1; ++i) {
-        if (pMobileLightsStack->uNumLightsActive < 1) continue;
-
-        MobileLight &test = pMobileLightsStack->pLights[i];
-        std::string slotnum = std::to_string(num_lights);
-
-        float x = pMobileLightsStack->pLights[i].vPosition.x;
-        float y = pMobileLightsStack->pLights[i].vPosition.y;
-        float z = pMobileLightsStack->pLights[i].vPosition.z;
-
-        Colorf color = pMobileLightsStack->pLights[i].uLightColor.toColorf();
-
-        glUniform1f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 2.0f);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].position").c_str()), x, y, z);
-        glUniform1f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].sector").c_str()), 0);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].ambient").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].diffuse").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].specular").c_str()), 0, 0, 0);
-        glUniform1f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].radius").c_str()), test.uRadius);
-        num_lights++;
-    }
-
-    for (int i = 0; i < pStationaryLightsStack->uNumLightsActive; ++i) {
-        // maximum 20 lights sent to shader at the moment
-        // TODO(pskelton): make this configurable - also lights should be sorted by distance so nearest are used first
-        if (num_lights >= 20) break;
-
-        std::string slotnum = std::to_string(num_lights);
-        StationaryLight &test = pStationaryLightsStack->pLights[i];
-
-        float x = test.vPosition.x;
-        float y = test.vPosition.y;
-        float z = test.vPosition.z;
-
-        Colorf color = test.uLightColor.toColorf();
-
-        float lightrad = test.uRadius;
-
-        glUniform1f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 1.0);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].position").c_str()), x, y, z);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].ambient").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].diffuse").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].specular").c_str()), color.r, color.g, color.b);
-        glUniform1f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].radius").c_str()), lightrad);
-
-        num_lights++;
-    }
-
-    // mobile
-    for (int i = 1; i < pMobileLightsStack->uNumLightsActive; ++i) {
-        // maximum 20 lights sent to shader at the moment
-        // TODO(pskelton): make this configurable - also lights should be sorted by distance so nearest are used first
-        if (num_lights >= 20) break;
-
-        std::string slotnum = std::to_string(num_lights);
-        MobileLight &test = pMobileLightsStack->pLights[i];
-
-        float x = pMobileLightsStack->pLights[i].vPosition.x;
-        float y = pMobileLightsStack->pLights[i].vPosition.y;
-        float z = pMobileLightsStack->pLights[i].vPosition.z;
-
-        Colorf color = pMobileLightsStack->pLights[i].uLightColor.toColorf();
-
-        float lightrad = pMobileLightsStack->pLights[i].uRadius;
-
-        glUniform1f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 2.0);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].position").c_str()), x, y, z);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].ambient").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].diffuse").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].specular").c_str()), color.r, color.g, color.b);
-        glUniform1f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].radius").c_str()), lightrad);
+    // gather visible chunks, merging the ones that are adjacent in the vertex buffer
+    std::vector<GLint> firsts;
+    std::vector<GLsizei> counts;
+    for (const TerrainChunk &chunk : terrainChunks) {
+        if (!pCamera3D->IsBBoxInFrustum(chunk.bbox))
+            continue;
 
-        num_lights++;
+        if (!firsts.empty() && firsts.back() + counts.back() == chunk.first) {
+            counts.back() += chunk.count;
+        } else {
+            firsts.push_back(chunk.first);
+            counts.push_back(chunk.count);
+        }
     }
 
-    // blank the rest of the lights
-    for (int blank = num_lights; blank < 20; blank++) {
-        std::string slotnum = std::to_string(blank);
-        glUniform1f(glGetUniformLocation(terrainshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 0.0);
+    // actually draw the visible terrain
+    if (!firsts.empty()) {
+        if (!OpenGLES) {
+            glMultiDrawArrays(GL_TRIANGLES, firsts.data(), counts.data(), firsts.size());
+            drawcalls++;
+        } else {
+            // OpenGL ES doesn't have glMultiDrawArrays
+            for (size_t i = 0; i < firsts.size(); i++) {
+                glDrawArrays(GL_TRIANGLES, firsts[i], counts[i]);
+                drawcalls++;
+            }
+        }
     }
 
-    // actually draw the whole terrain
-    glDrawArrays(GL_TRIANGLES, 0, (127 * 127 * 6));
-    drawcalls++;
-
     // unload
-    glUseProgram(0);
+    openGLState.useProgram(0);
     glDisableVertexAttribArray(0);
     glDisableVertexAttribArray(1);
     glDisableVertexAttribArray(2);
     glDisableVertexAttribArray(3);
     glDisableVertexAttribArray(4);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    openGLState.bindVertexArray(0);
+    openGLState.activeTexture(GL_TEXTURE0);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
 
     //end terrain debug
     if (engine->config->debug.Terrain.value())
@@ -1888,116 +2021,8 @@ void OpenGLRenderer::DrawOutdoorTerrain() {
         if (!OpenGLES)
             glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-    // stack new decals onto terrain faces ////////////////////////////////////////////////
-    // TODO(pskelton): clean up and move to seperate function in decal builder
-    if (!decal_builder->bloodsplat_container->uNumBloodsplats) return;
-    unsigned int NumBloodsplats = decal_builder->bloodsplat_container->uNumBloodsplats;
-
-    // loop over blood to lay
-    for (unsigned i = 0; i < NumBloodsplats; ++i) {
-        // approx location of bloodsplat
-        int splatx = decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].pos.x;
-        int splaty = decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].pos.y;
-        int splatz = decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].pos.z;
-        int testx = WorldPosToGridCellX(splatx);
-        int testy = WorldPosToGridCellY(splaty);
-        // use terrain squares in block surrounding to try and stack faces
-
-        int scope = std::ceil(decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].radius / 512);
-
-        for (int loopy = (testy - scope); loopy <= (testy + scope); ++loopy) {
-            for (int loopx = (testx - scope); loopx <= (testx + scope); ++loopx) {
-                if (loopy < 0) continue;
-                if (loopy > 127) continue;
-                if (loopx < 0) continue;
-                if (loopx > 127) continue;
-
-
-                // top tri
-                // x, y
-                VertexRenderList[0].vWorldPosition.x = terrshaderstore[6 * (loopx + (127 * loopy))].x;
-                VertexRenderList[0].vWorldPosition.y = terrshaderstore[6 * (loopx + (127 * loopy))].y;
-                VertexRenderList[0].vWorldPosition.z = terrshaderstore[6 * (loopx + (127 * loopy))].z;
-                // x + 1, y + 1
-                VertexRenderList[1].vWorldPosition.x = terrshaderstore[6 * (loopx + (127 * loopy)) + 1].x;
-                VertexRenderList[1].vWorldPosition.y = terrshaderstore[6 * (loopx + (127 * loopy)) + 1].y;
-                VertexRenderList[1].vWorldPosition.z = terrshaderstore[6 * (loopx + (127 * loopy)) + 1].z;
-                // x + 1, y
-                VertexRenderList[2].vWorldPosition.x = terrshaderstore[6 * (loopx + (127 * loopy)) + 2].x;
-                VertexRenderList[2].vWorldPosition.y = terrshaderstore[6 * (loopx + (127 * loopy)) + 2].y;
-                VertexRenderList[2].vWorldPosition.z = terrshaderstore[6 * (loopx + (127 * loopy)) + 2].z;
-
-                // bottom tri
-                // x, y
-                VertexRenderList[3].vWorldPosition.x = terrshaderstore[6 * (loopx + (127 * loopy)) + 3].x;
-                VertexRenderList[3].vWorldPosition.y = terrshaderstore[6 * (loopx + (127 * loopy)) + 3].y;
-                VertexRenderList[3].vWorldPosition.z = terrshaderstore[6 * (loopx + (127 * loopy)) + 3].z;
-                // x, y + 1
-                VertexRenderList[4].vWorldPosition.x = terrshaderstore[6 * (loopx + (127 * loopy)) + 4].x;
-                VertexRenderList[4].vWorldPosition.y = terrshaderstore[6 * (loopx + (127 * loopy)) + 4].y;
-                VertexRenderList[4].vWorldPosition.z = terrshaderstore[6 * (loopx + (127 * loopy)) + 4].z;
-                // x + 1, y + 1
-                VertexRenderList[5].vWorldPosition.x = terrshaderstore[6 * (loopx + (127 * loopy)) + 5].x;
-                VertexRenderList[5].vWorldPosition.y = terrshaderstore[6 * (loopx + (127 * loopy)) + 5].y;
-                VertexRenderList[5].vWorldPosition.z = terrshaderstore[6 * (loopx + (127 * loopy)) + 5].z;
-
-                float WorldMinZ = pOutdoor->GetPolygonMinZ(VertexRenderList, 6);
-                float WorldMaxZ = pOutdoor->GetPolygonMaxZ(VertexRenderList, 6);
-
-                // TODO(pskelton): terrain and boxes should be saved for easier retrieval
-                // test expanded box against bloodsplat
-                BBoxf thissquare{ terrshaderstore[6 * (loopx + (127 * loopy))].x ,
-                                  terrshaderstore[6 * (loopx + (127 * loopy)) + 1].x,
-                                  terrshaderstore[6 * (loopx + (127 * loopy)) + 1].y,
-                                  terrshaderstore[6 * (loopx + (127 * loopy))].y,
-                                  WorldMinZ,
-                                  WorldMaxZ };
-
-                // skip this square if no splat over lap
-                if (!thissquare.intersectsCube(decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].pos, decal_builder->bloodsplat_container->pBloodsplats_to_apply[i].radius))
-                    continue;
-
-                // splat hits this square of terrain
-                struct Polygon *pTilePolygon = &array_77EC08[pODMRenderParams->uNumPolygons];
-                pTilePolygon->flags = pOutdoor->getTileAttribByGrid(loopx, loopy);
-
-                unsigned norm_idx = pTerrainNormalIndices[(2 * loopx * 128) + (2 * loopy) + 2];  // 2 is top tri // 3 is bottom
-                unsigned bottnormidx = pTerrainNormalIndices[(2 * loopx * 128) + (2 * loopy) + 3];
-                assert(norm_idx < pTerrainNormals.size());
-                assert(bottnormidx < pTerrainNormals.size());
-                Vec3f *norm = &pTerrainNormals[norm_idx];
-                Vec3f *norm2 = &pTerrainNormals[bottnormidx];
-
-                float Light_tile_dist = 0.0;
-
-                // top tri
-                float _f1 = norm->x * pOutdoor->vSunlight.x + norm->y * pOutdoor->vSunlight.y + norm->z * pOutdoor->vSunlight.z;
-                pTilePolygon->dimming_level = 20.0f - floorf(20.0f * _f1 + 0.5f);
-                pTilePolygon->dimming_level = std::clamp((int)pTilePolygon->dimming_level, 0, 31);
-
-                decal_builder->ApplyBloodSplatToTerrain(pTilePolygon->flags, norm, &Light_tile_dist, VertexRenderList, i);
-                Planef plane;
-                plane.normal = *norm;
-                plane.dist = Light_tile_dist;
-                if (decal_builder->uNumSplatsThisFace > 0)
-                    decal_builder->BuildAndApplyDecals(31 - pTilePolygon->dimming_level, LocationTerrain, plane, 3, VertexRenderList, 0, -1);
-
-                //bottom tri
-                float _f = norm2->x * pOutdoor->vSunlight.x + norm2->y * pOutdoor->vSunlight.y + norm2->z * pOutdoor->vSunlight.z;
-                pTilePolygon->dimming_level = 20.0 - floorf(20.0 * _f + 0.5f);
-                pTilePolygon->dimming_level = std::clamp((int)pTilePolygon->dimming_level, 0, 31);
-
-                decal_builder->ApplyBloodSplatToTerrain(pTilePolygon->flags, norm2, &Light_tile_dist, (VertexRenderList + 3), i);
-                plane.normal = *norm2;
-                plane.dist = Light_tile_dist;
-                if (decal_builder->uNumSplatsThisFace > 0)
-                    decal_builder->BuildAndApplyDecals(31 - pTilePolygon->dimming_level, LocationTerrain, plane, 3, (VertexRenderList + 3), 0, -1);
-            }
-        }
-    }
-
-    // end of new system test
-    return;
+    // stack new decals onto terrain faces
+    StackTerrainDecals();
 
     // end shder version
 }
@@ -2141,7 +2166,7 @@ void OpenGLRenderer::DrawOutdoorSkyPolygon(struct Polygon *pSkyPolygon) {
     static GraphicsImage *effpar03 = assets->getBitmap("effpar03");
     float texidsolid = static_cast<float>(effpar03->renderId().value());
 
-    //glBindTexture(GL_TEXTURE_2D, texture->GetOpenGlTexture());
+    //openGLState.bindTexture(GL_TEXTURE_2D, texture->GetOpenGlTexture());
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
@@ -2275,12 +2300,9 @@ void OpenGLRenderer::DrawForcePerVerts() {
 
     if (forceperVAO == 0) {
         glGenVertexArrays(1, &forceperVAO);
-        glGenBuffers(1, &forceperVBO);
-
-        glBindVertexArray(forceperVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, forceperVBO);
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(forceperstore), forceperstore, GL_DYNAMIC_DRAW);
+        openGLState.bindVertexArray(forceperVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, _streamBuffer.id());
 
         // position attribute
         glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(forcepersverts), (void *)offsetof(forcepersverts, x));
@@ -2297,19 +2319,15 @@ void OpenGLRenderer::DrawForcePerVerts() {
     }
 
     // update buffer
-    glBindBuffer(GL_ARRAY_BUFFER, forceperVBO);
+    GLint first = _streamBuffer.upload(forceperstore, forceperstorecnt);
 
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(forcepersverts) * forceperstorecnt, forceperstore);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    glBindVertexArray(forceperVAO);
+    openGLState.bindVertexArray(forceperVAO);
     glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
     glEnableVertexAttribArray(2);
     glEnableVertexAttribArray(3);
 
-    glUseProgram(forcepershader.ID);
+    openGLState.useProgram(forcepershader.ID);
 
     // set sampler to texure0
     glUniform1i(glGetUniformLocation(forcepershader.ID, "texture0"), GLint(0));
@@ -2356,7 +2374,7 @@ void OpenGLRenderer::DrawForcePerVerts() {
     while (offset < forceperstorecnt) {
         // set texture
         GLfloat thistex = forceperstore[offset].texid;
-        glBindTexture(GL_TEXTURE_2D, thistex);
+        openGLState.bindTexture(GL_TEXTURE_2D, thistex);
 
         int cnt = 0;
         do {
@@ -2367,13 +2385,13 @@ void OpenGLRenderer::DrawForcePerVerts() {
             }
         } while (forceperstore[offset + (cnt * 3)].texid == thistex);
 
-        glDrawArrays(GL_TRIANGLES, offset, (3 * cnt));
+        glDrawArrays(GL_TRIANGLES, first + offset, (3 * cnt));
         drawcalls++;
 
         offset += (3 * cnt);
     }
 
-    glUseProgram(0);
+    openGLState.useProgram(0);
     glDisableVertexAttribArray(0);
     glDisableVertexAttribArray(1);
     glDisableVertexAttribArray(2);
@@ -2381,7 +2399,7 @@ void OpenGLRenderer::DrawForcePerVerts() {
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    glBindVertexArray(0);
+    openGLState.bindVertexArray(0);
 
     forceperstorecnt = 0;
 }
@@ -2413,27 +2431,29 @@ void OpenGLRenderer::SetFogParametersGL() {
     }
 }
 
-struct billbverts {
-    GLfloat x;
-    GLfloat y;
+// A single billboard, drawn as one instance. The vertex shader expands it into two triangles - 0 1 2 / 0 2 3.
+struct billbinstance {
+    GLfloat pos[8]; // Screen space xy of the four corners.
+    GLfloat uv[8]; // Texture coordinates of the four corners.
+    Color color[4]; // Diffuse colour of the four corners.
     GLfloat z;
-    GLfloat u;
-    GLfloat v;
-    Colorf color;
     GLfloat screenspace;
-    GLfloat texid;
-    GLfloat blend;
     GLfloat paletteindex;
+    // Not passed to the shader, used for batching.
+    GLuint texid;
+    RenderBillboardD3D::OpacityType blend;
 };
 
-billbverts billbstore[1000] {};
-int billbstorecnt{ 0 };
+static billbinstance billbstore[1000] {};
+static int billbstorecnt{ 0 };
 
 //----- (004A1C1E) --------------------------------------------------------
 void OpenGLRenderer::DoRenderBillboards_D3D() {
-    glEnable(GL_BLEND);
-    glDepthMask(GL_FALSE);  // in theory billboards all sorted by depth so dont cull by depth test
-    glDisable(GL_CULL_FACE);  // some quads are reversed to reuse sprites opposite hand
+    OE_PROFILE_ZONE("gl billboards");
+
+    openGLState.enable(GL_BLEND);
+    openGLState.depthMask(GL_FALSE);  // in theory billboards all sorted by depth so dont cull by depth test
+    openGLState.disable(GL_CULL_FACE);  // some quads are reversed to reuse sprites opposite hand
 
     _set_ortho_projection(1);
     _set_ortho_modelview();
@@ -2441,204 +2461,124 @@ void OpenGLRenderer::DoRenderBillboards_D3D() {
     if (billbstorecnt)
         logger->trace("Billboard shader store isnt empty!");
 
-    // track loaded tex
-    float gltexid{ 0 };
-    // track blend mode
-    //RenderBillboardD3D::OpacityType blendtrack{ RenderBillboardD3D::NoBlend };
-
     float oneon = 1.0f / (pCamera3D->GetNearClip() * 2.0f);
     float oneof = 1.0f / (pCamera3D->GetFarClip());
 
-    for (int i = uNumBillboardsToDraw - 1; i >= 0; --i) {
-        //if (pBillboardRenderListD3D[i].opacity != RenderBillboardD3D::NoBlend) {
-        //    if (blendtrack != pBillboardRenderListD3D[i].opacity) {
-        //        blendtrack = pBillboardRenderListD3D[i].opacity;
-        //        SetBillboardBlendOptions(blendtrack);
-        //    }
-        //}
+    for (int i = static_cast<int>(pBillboardRenderListD3D.size()) - 1; i >= 0; --i) {
+        auto billboard = &pBillboardRenderListD3D[i];
+        billbinstance &instance = billbstore[billbstorecnt];
 
-        //int palette{ pBillboardRenderListD3D[i].PaletteID};
-        int paletteindex{ pBillboardRenderListD3D[i].PaletteIndex };
+        const OpenGLSpriteAtlas::Slot *slot = nullptr;
+        if (billboard->texture) {
+            instance.texid = billboard->texture->renderId().value();
 
-        if (pBillboardRenderListD3D[i].texture) {
-            auto texture = pBillboardRenderListD3D[i].texture;
-            gltexid = texture->renderId().value();
+            // Paletted sprites are drawn from the atlas, so that consecutive billboards can share a batch.
+            if (billboard->PaletteIndex && billboard->texture->isIndexedOnly()) {
+                slot = &_spriteAtlas.findOrInsert(instance.texid, billboard->texture->indexed());
+                if (slot->texture) {
+                    instance.texid = slot->texture;
+                } else {
+                    slot = nullptr;
+                }
+            }
         } else {
             static GraphicsImage *effpar03 = assets->getBitmap("effpar03");
-            gltexid = static_cast<float>(effpar03->renderId().value());
+            instance.texid = effpar03->renderId().value();
         }
 
-        //if (gltexid != testtexid) {
-        //    gltexid = testtexid;
-        //    glBindTexture(GL_TEXTURE_2D, gltexid);
-        //}
-
-        auto billboard = &pBillboardRenderListD3D[i];
-        auto b = &pBillboardRenderList[i];
-
         float oneoz = 1.0f / billboard->screen_space_z;
-        float thisdepth = (oneoz - oneon) / (oneof - oneon);
-
-        float thisblend = static_cast<float>(billboard->opacity);
-
-        // 0 1 2 / 0 2 3
-
-        billbstore[billbstorecnt].x = billboard->pQuads[0].pos.x;
-        billbstore[billbstorecnt].y = billboard->pQuads[0].pos.y;
-        billbstore[billbstorecnt].z = thisdepth;
-        billbstore[billbstorecnt].u = std::clamp(billboard->pQuads[0].texcoord.x, 0.01f, 0.99f);
-        billbstore[billbstorecnt].v = std::clamp(billboard->pQuads[0].texcoord.y, 0.01f, 0.99f);
-        billbstore[billbstorecnt].color = billboard->pQuads[0].diffuse.toColorf();
-        billbstore[billbstorecnt].screenspace = billboard->screen_space_z;
-        billbstore[billbstorecnt].texid = gltexid;
-        billbstore[billbstorecnt].blend = thisblend;
-        billbstore[billbstorecnt].paletteindex = paletteindex;
-        billbstorecnt++;
-
-        billbstore[billbstorecnt].x = billboard->pQuads[1].pos.x;
-        billbstore[billbstorecnt].y = billboard->pQuads[1].pos.y;
-        billbstore[billbstorecnt].z = thisdepth;
-        billbstore[billbstorecnt].u = std::clamp(billboard->pQuads[1].texcoord.x, 0.01f, 0.99f);
-        billbstore[billbstorecnt].v = std::clamp(billboard->pQuads[1].texcoord.y, 0.01f, 0.99f);
-        billbstore[billbstorecnt].color = billboard->pQuads[1].diffuse.toColorf();
-        billbstore[billbstorecnt].screenspace = billboard->screen_space_z;
-        billbstore[billbstorecnt].texid = gltexid;
-        billbstore[billbstorecnt].blend = thisblend;
-        billbstore[billbstorecnt].paletteindex = paletteindex;
-        billbstorecnt++;
-
-        billbstore[billbstorecnt].x = billboard->pQuads[2].pos.x;
-        billbstore[billbstorecnt].y = billboard->pQuads[2].pos.y;
-        billbstore[billbstorecnt].z = thisdepth;
-        billbstore[billbstorecnt].u = std::clamp(billboard->pQuads[2].texcoord.x, 0.01f, 0.99f);
-        billbstore[billbstorecnt].v = std::clamp(billboard->pQuads[2].texcoord.y, 0.01f, 0.99f);
-        billbstore[billbstorecnt].color = billboard->pQuads[2].diffuse.toColorf();
-        billbstore[billbstorecnt].screenspace = billboard->screen_space_z;
-        billbstore[billbstorecnt].texid = gltexid;
-        billbstore[billbstorecnt].blend = thisblend;
-        billbstore[billbstorecnt].paletteindex = paletteindex;
-        billbstorecnt++;
+        instance.z = (oneoz - oneon) / (oneof - oneon);
+        instance.screenspace = billboard->screen_space_z;
+        instance.paletteindex = billboard->PaletteIndex;
+        instance.blend = billboard->opacity;
+
+        for (int corner = 0; corner < 4; corner++) {
+            instance.pos[2 * corner] = billboard->pQuads[corner].pos.x;
+            instance.pos[2 * corner + 1] = billboard->pQuads[corner].pos.y;
+            instance.uv[2 * corner] = std::clamp(billboard->pQuads[corner].texcoord.x, 0.01f, 0.99f);
+            instance.uv[2 * corner + 1] = std::clamp(billboard->pQuads[corner].texcoord.y, 0.01f, 0.99f);
+            if (slot) {
+                instance.uv[2 * corner] = slot->u0 + instance.uv[2 * corner] * (slot->u1 - slot->u0);
+                instance.uv[2 * corner + 1] = slot->v0 + instance.uv[2 * corner + 1] * (slot->v1 - slot->v0);
+            }
+            instance.color[corner] = billboard->pQuads[corner].diffuse;
+        }
 
-        ////////////////////////////////
-
-        if (billboard->pQuads[3].pos.x != 0.0f && billboard->pQuads[3].pos.y != 0.0f && billboard->pQuads[3].pos.z != 0.0f) {
-            billbstore[billbstorecnt].x = billboard->pQuads[0].pos.x;
-            billbstore[billbstorecnt].y = billboard->pQuads[0].pos.y;
-            billbstore[billbstorecnt].z = thisdepth;
-            billbstore[billbstorecnt].u = std::clamp(billboard->pQuads[0].texcoord.x, 0.01f, 0.99f);
-            billbstore[billbstorecnt].v = std::clamp(billboard->pQuads[0].texcoord.y, 0.01f, 0.99f);
-            billbstore[billbstorecnt].color = billboard->pQuads[0].diffuse.toColorf();
-            billbstore[billbstorecnt].screenspace = billboard->screen_space_z;
-            billbstore[billbstorecnt].texid = gltexid;
-            billbstore[billbstorecnt].blend = thisblend;
-            billbstore[billbstorecnt].paletteindex = paletteindex;
-            billbstorecnt++;
-
-            billbstore[billbstorecnt].x = billboard->pQuads[2].pos.x;
-            billbstore[billbstorecnt].y = billboard->pQuads[2].pos.y;
-            billbstore[billbstorecnt].z = thisdepth;
-            billbstore[billbstorecnt].u = std::clamp(billboard->pQuads[2].texcoord.x, 0.01f, 0.99f);
-            billbstore[billbstorecnt].v = std::clamp(billboard->pQuads[2].texcoord.y, 0.01f, 0.99f);
-            billbstore[billbstorecnt].color = billboard->pQuads[2].diffuse.toColorf();
-            billbstore[billbstorecnt].screenspace = billboard->screen_space_z;
-            billbstore[billbstorecnt].texid = gltexid;
-            billbstore[billbstorecnt].blend = thisblend;
-            billbstore[billbstorecnt].paletteindex = paletteindex;
-            billbstorecnt++;
-
-            billbstore[billbstorecnt].x = billboard->pQuads[3].pos.x;
-            billbstore[billbstorecnt].y = billboard->pQuads[3].pos.y;
-            billbstore[billbstorecnt].z = thisdepth;
-            billbstore[billbstorecnt].u = std::clamp(billboard->pQuads[3].texcoord.x, 0.01f, 0.99f);
-            billbstore[billbstorecnt].v = std::clamp(billboard->pQuads[3].texcoord.y, 0.01f, 0.99f);
-            billbstore[billbstorecnt].color = billboard->pQuads[3].diffuse.toColorf();
-            billbstore[billbstorecnt].screenspace = billboard->screen_space_z;
-            billbstore[billbstorecnt].texid = gltexid;
-            billbstore[billbstorecnt].blend = thisblend;
-            billbstore[billbstorecnt].paletteindex = paletteindex;
-            billbstorecnt++;
+        // triangles only have three corners, collapse the second triangle
+        if (billboard->pQuads[3].pos.x == 0.0f || billboard->pQuads[3].pos.y == 0.0f || billboard->pQuads[3].pos.z == 0.0f) {
+            instance.pos[6] = instance.pos[0];
+            instance.pos[7] = instance.pos[1];
         }
 
-        if (billbstorecnt > 990) {
+        billbstorecnt++;
+        if (billbstorecnt == std::size(billbstore))
             DrawBillboards();
-        }
     }
 
-    // uNumBillboardsToDraw = 0;
+    // pBillboardRenderListD3D.clear();
 
     DrawBillboards();
 
-    //glDisable(GL_BLEND);
-    glDepthMask(GL_TRUE);
+    //openGLState.disable(GL_BLEND);
+    openGLState.depthMask(GL_TRUE);
+}
+
+/**
+ * Points the per-instance billboard attributes of the currently bound VAO at the provided instance.
+ *
+ * @param base                          Index of the first instance in the array buffer.
+ */
+static void setBillboardInstanceAttribs(GLint base) {
+    const char *offset = reinterpret_cast<const char *>(static_cast<uintptr_t>(base) * sizeof(billbinstance));
+
+    // corner positions
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(billbinstance), offset + offsetof(billbinstance, pos));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(billbinstance), offset + offsetof(billbinstance, pos) + 4 * sizeof(GLfloat));
+    // corner tex uvs
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(billbinstance), offset + offsetof(billbinstance, uv));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(billbinstance), offset + offsetof(billbinstance, uv) + 4 * sizeof(GLfloat));
+    // corner colours
+    for (int corner = 0; corner < 4; corner++)
+        glVertexAttribPointer(4 + corner, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(billbinstance), offset + offsetof(billbinstance, color) + corner * sizeof(Color));
+    // depth, screenspace & palette index
+    glVertexAttribPointer(8, 3, GL_FLOAT, GL_FALSE, sizeof(billbinstance), offset + offsetof(billbinstance, z));
 }
 
 // name better
 void OpenGLRenderer::DrawBillboards() {
     if (!billbstorecnt) return;
 
+    OpenGLPassTimerScope passTimer(&_passTimers, RENDER_PASS_BILLBOARDS);
+
     if (billbVAO == 0) {
         glGenVertexArrays(1, &billbVAO);
-        glGenBuffers(1, &billbVBO);
-
-        glBindVertexArray(billbVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, billbVBO);
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(billbstore), billbstore, GL_DYNAMIC_DRAW);
+        openGLState.bindVertexArray(billbVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, _streamBuffer.id());
 
-        // position attribute
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(billbverts), (void *)offsetof(billbverts, x));
-        glEnableVertexAttribArray(0);
-        // tex uv
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(billbverts), (void *)offsetof(billbverts, u));
-        glEnableVertexAttribArray(1);
-        // colour
-        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(billbverts), (void *)offsetof(billbverts, color));
-        glEnableVertexAttribArray(2);
-        // screenspace
-        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(billbverts), (void *)offsetof(billbverts, screenspace));
-        glEnableVertexAttribArray(3);
-        // texid
-        glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(billbverts), (void *)offsetof(billbverts, texid));
-        glEnableVertexAttribArray(4);
-        // palette index
-        glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(billbverts), (void *)offsetof(billbverts, paletteindex));
-        glEnableVertexAttribArray(5);
+        for (int attrib = 0; attrib < 9; attrib++) {
+            glEnableVertexAttribArray(attrib);
+            glVertexAttribDivisor(attrib, 1);
+        }
+        setBillboardInstanceAttribs(0);
     }
 
-    if (palbuf == 0) {
-        // generate palette buffer texture
-        std::span<Color> palettes = pPaletteManager->paletteData();
-        glGenBuffers(1, &palbuf);
-        glBindBuffer(GL_TEXTURE_BUFFER, palbuf);
-        glBufferData(GL_TEXTURE_BUFFER, palettes.size_bytes(), palettes.data(), GL_STATIC_DRAW);
-
-        glGenTextures(1, &paltex);
-        glBindTexture(GL_TEXTURE_BUFFER, paltex);
-        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8UI, palbuf);
-        glBindBuffer(GL_TEXTURE_BUFFER, 0);
-    }
+    updatePaletteBuffer();
 
     // update buffer
-    glBindBuffer(GL_ARRAY_BUFFER, billbVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(billbverts) * billbstorecnt, billbstore);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GLint first = _streamBuffer.upload(billbstore, billbstorecnt);
 
-    glBindVertexArray(billbVAO);
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-    glEnableVertexAttribArray(2);
-    glEnableVertexAttribArray(3);
-    glEnableVertexAttribArray(4);
-    glEnableVertexAttribArray(5);
+    openGLState.bindVertexArray(billbVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, _streamBuffer.id());
 
-    glUseProgram(billbshader.ID);
+    openGLState.useProgram(billbshader.ID);
 
     // set sampler to palette
     glUniform1i(glGetUniformLocation(billbshader.ID, "palbuf"), GLint(1));
-    glActiveTexture(GL_TEXTURE0 + 1);
-    glBindTexture(GL_TEXTURE_BUFFER, paltex);
+    openGLState.activeTexture(GL_TEXTURE0 + 1);
+    openGLState.bindTexture(GL_TEXTURE_BUFFER, paltex);
     glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8UI, palbuf);
-    glActiveTexture(GL_TEXTURE0);
+    openGLState.activeTexture(GL_TEXTURE0);
 
 
     // set sampler to texure0
@@ -2653,61 +2593,64 @@ void OpenGLRenderer::DrawBillboards() {
 
     // set fog uniforms
     glUniform3f(glGetUniformLocation(billbshader.ID, "fog.color"), fog.r, fog.g, fog.b);
-    glUniform1f(glGetUniformLocation(billbshader.ID, "fog.fogstart"), GLfloat(fogstart));
+    GLint fogstartloc = glGetUniformLocation(billbshader.ID, "fog.fogstart");
     glUniform1f(glGetUniformLocation(billbshader.ID, "fog.fogmiddle"), GLfloat(fogmiddle));
     glUniform1f(glGetUniformLocation(billbshader.ID, "fog.fogend"), GLfloat(fogend));
 
+    // billboards are sorted by depth, so draw runs of instances that share texture & blend mode, and only touch the
+    // gl state that actually changes between the runs
+    GLuint boundtex = 0;
+    bool boundadditive = false;
+    bool isfirst = true;
+
     int offset = 0;
     while (offset < billbstorecnt) {
+        const billbinstance &instance = billbstore[offset];
+
         // set texture
-        GLfloat thistex = billbstore[offset].texid;
-        glBindTexture(GL_TEXTURE_2D, billbstore[offset].texid);
-        if (billbstore[offset].paletteindex) {
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        } else {
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        if (isfirst || instance.texid != boundtex) {
+            boundtex = instance.texid;
+            openGLState.bindTexture(GL_TEXTURE_2D, boundtex);
+            if (instance.paletteindex) {
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            } else {
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            }
         }
 
-        GLfloat thisblend = billbstore[offset].blend;
-        if (thisblend == 0.0) {
-            // disable alpha blending and enable fog for opaque items
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            glUniform1f(glGetUniformLocation(billbshader.ID, "fog.fogstart"), GLfloat(fogstart));
-        } else {
-            // enable blending and disable fog for transparent items
-            glBlendFunc(GL_ONE, GL_ONE);
-            glUniform1f(glGetUniformLocation(billbshader.ID, "fog.fogstart"), GLfloat(fogend));
+        bool additive = instance.blend != RenderBillboardD3D::Transparent;
+        if (isfirst || additive != boundadditive) {
+            boundadditive = additive;
+            if (!additive) {
+                // disable alpha blending and enable fog for opaque items
+                openGLState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                glUniform1f(fogstartloc, GLfloat(fogstart));
+            } else {
+                // enable blending and disable fog for transparent items
+                openGLState.blendFunc(GL_ONE, GL_ONE);
+                glUniform1f(fogstartloc, GLfloat(fogend));
+            }
         }
+        isfirst = false;
 
-
-        int cnt = 0;
-        do {
+        int cnt = 1;
+        while (offset + cnt < billbstorecnt && billbstore[offset + cnt].texid == instance.texid && billbstore[offset + cnt].blend == instance.blend)
             cnt++;
-            if (offset + (3 * cnt) > billbstorecnt) {
-                --cnt;
-                break;
-            }
-        } while (billbstore[offset + (cnt * 3)].texid == thistex && billbstore[offset + (cnt * 3)].blend == thisblend);
 
-        glDrawArrays(GL_TRIANGLES, offset, (3 * cnt));
+        setBillboardInstanceAttribs(first + offset);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, cnt);
         drawcalls++;
 
-        offset += (3 * cnt);
+        offset += cnt;
     }
 
-    glUseProgram(0);
-    glDisableVertexAttribArray(0);
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(2);
-    glDisableVertexAttribArray(3);
-    glDisableVertexAttribArray(4);
-    glDisableVertexAttribArray(5);
+    openGLState.useProgram(0);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    glBindVertexArray(0);
+    openGLState.bindVertexArray(0);
     billbstorecnt = 0;
 }
 
@@ -2722,7 +2665,8 @@ void OpenGLRenderer::SetUIClipRect(unsigned int x, unsigned int y, unsigned int
     this->clip_y = y;
     this->clip_z = z;
     this->clip_w = w;
-    glScissor(x, outputRender.h -w, z-x, w-y);  // invert glscissor co-ords 0,0 is BL
+    if (!_sceneTargetBound) // Otherwise will be applied in resolveSceneTarget.
+        openGLState.scissor(x, outputRender.h -w, z-x, w-y);  // invert glscissor co-ords 0,0 is BL
 }
 
 void OpenGLRenderer::ResetUIClipRect() {
@@ -2731,6 +2675,7 @@ void OpenGLRenderer::ResetUIClipRect() {
 
 void OpenGLRenderer::BeginScene2D() {
     // Setup for 2D
+    resolveSceneTarget();
 
     if (outputRender != outputPresent) {
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
@@ -2741,9 +2686,9 @@ void OpenGLRenderer::BeginScene2D() {
         GL_Check_Framebuffer(__FUNCTION__);
     }
 
-    glDepthMask(GL_FALSE);
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_CULL_FACE);
+    openGLState.depthMask(GL_FALSE);
+    openGLState.disable(GL_DEPTH_TEST);
+    openGLState.disable(GL_CULL_FACE);
 
     _set_ortho_projection();
     _set_ortho_modelview();
@@ -2994,18 +2939,17 @@ void OpenGLRenderer::BeginTextNew(GraphicsImage *main, GraphicsImage *shadow) {
 void OpenGLRenderer::EndTextNew() {
     if (!textvertscnt) return;
 
+    OpenGLPassTimerScope passTimer(&_passTimers, RENDER_PASS_TEXT);
+
     if (twodvertscnt) {
         DrawTwodVerts();
     }
 
     if (textVAO == 0) {
         glGenVertexArrays(1, &textVAO);
-        glGenBuffers(1, &textVBO);
-
-        glBindVertexArray(textVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, textVBO);
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(textshaderstore), NULL, GL_DYNAMIC_DRAW);
+        openGLState.bindVertexArray(textVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, _streamBuffer.id());
 
         // position attribute
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(twodverts), (void *)offsetof(twodverts, x));
@@ -3022,25 +2966,19 @@ void OpenGLRenderer::EndTextNew() {
     }
 
     // update buffer
-    glBindBuffer(GL_ARRAY_BUFFER, textVBO);
-    // orphan
-    glBufferData(GL_ARRAY_BUFFER, sizeof(textshaderstore), NULL, GL_DYNAMIC_DRAW);
-    // update buffer
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(twodverts) * textvertscnt, textshaderstore);
+    GLint first = _streamBuffer.upload(textshaderstore, textvertscnt);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    glBindVertexArray(textVAO);
+    openGLState.bindVertexArray(textVAO);
     glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
     glEnableVertexAttribArray(2);
     glEnableVertexAttribArray(3);
 
-    glUseProgram(textshader.ID);
+    openGLState.useProgram(textshader.ID);
 
-    // glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // openGLState.enable(GL_TEXTURE_2D);
+    openGLState.enable(GL_BLEND);
+    openGLState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // set sampler to texure0
     glUniform1i(glGetUniformLocation(textshader.ID, "texture0"), GLint(0));
@@ -3052,15 +2990,15 @@ void OpenGLRenderer::EndTextNew() {
     glUniformMatrix4fv(glGetUniformLocation(textshader.ID, "view"), 1, GL_FALSE, &viewmat[0][0]);
 
     // set textures
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texmain);
-    glActiveTexture(GL_TEXTURE0 + 1);
-    glBindTexture(GL_TEXTURE_2D, texshadow);
+    openGLState.activeTexture(GL_TEXTURE0);
+    openGLState.bindTexture(GL_TEXTURE_2D, texmain);
+    openGLState.activeTexture(GL_TEXTURE0 + 1);
+    openGLState.bindTexture(GL_TEXTURE_2D, texshadow);
 
-    glDrawArrays(GL_TRIANGLES, 0, textvertscnt);
+    glDrawArrays(GL_TRIANGLES, first, textvertscnt);
     drawcalls++;
 
-    glUseProgram(0);
+    openGLState.useProgram(0);
     glDisableVertexAttribArray(0);
     glDisableVertexAttribArray(1);
     glDisableVertexAttribArray(2);
@@ -3068,11 +3006,11 @@ void OpenGLRenderer::EndTextNew() {
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    glBindVertexArray(0);
+    openGLState.bindVertexArray(0);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
+    openGLState.activeTexture(GL_TEXTURE0);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
 
     textvertscnt = 0;
     // texmain = 0;
@@ -3175,6 +3113,10 @@ void OpenGLRenderer::DrawTextNew(int x, int y, int width, int h, float u1, float
 }
 
 void OpenGLRenderer::Present() {
+    OE_PROFILE_ZONE("gl present");
+
+    resolveSceneTarget();
+
     // flush any undrawn items
     DrawTwodVerts();
     EndLines2D();
@@ -3182,9 +3124,9 @@ void OpenGLRenderer::Present() {
 
     if (outputRender != outputPresent) {
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
-        glDisable(GL_SCISSOR_TEST);
+        openGLState.disable(GL_SCISSOR_TEST);
 
-        glViewport(0, 0, outputPresent.w, outputPresent.h);
+        openGLState.viewport(0, 0, outputPresent.w, outputPresent.h);
         glClearColor(0.0, 0.0, 0.0, 1.0);
         glClearDepthf(1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -3213,19 +3155,66 @@ void OpenGLRenderer::Present() {
         if (nuklear && nuklear->ctx)
             NuklearRender(NK_ANTI_ALIASING_ON, NUKLEAR_MAX_VERTEX_MEMORY, NUKLEAR_MAX_ELEMENT_MEMORY);
 
-        glEnable(GL_SCISSOR_TEST);
-        glViewport(0, 0, outputRender.w, outputRender.h);
+        openGLState.enable(GL_SCISSOR_TEST);
+        openGLState.viewport(0, 0, outputRender.w, outputRender.h);
     }
+    _streamBuffer.nextFrame();
+    _textureStagingBuffer.nextFrame();
+    _passTimers.nextFrame();
+    _screenReadback.poll(false);
+    openGLState.nextFrame();
+    if (++_residencyFrame % RESIDENCY_CHECK_INTERVAL == 0)
+        updateTextureResidency();
     openGLContext->swapBuffers();
+    // Input for the next frame is processed right after we return, so the end of the previous present is also the
+    // start of this frame's input.
+    _frameQueue.nextFrame(config->graphics.MaxFramesInFlight.value(), _lastPresentNs);
+    updateDynamicResolution();
+    updateQualityGovernor();
+
+    int fpsLimit = engine->config->graphics.FPSLimit.value();
+    if (engine->config->graphics.FPSLimitToRefreshRate.value()) {
+        // Stay a few frames below the refresh rate so that we never hit the top of the VRR range, where we'd either
+        // get vsync latency or tearing.
+        int refreshRate = window->refreshRate();
+        if (refreshRate > 0)
+            fpsLimit = std::max(1, refreshRate - VRR_FPS_MARGIN);
+    }
+    if (fpsLimit > 0)
+        _frameLimiter.tick(fpsLimit);
+    _lastPresentNs = nowNs();
+}
 
-    if (engine->config->graphics.FPSLimit.value() > 0)
-        _frameLimiter.tick(engine->config->graphics.FPSLimit.value());
+/**
+ * @param pool                          Texture pool to look up the texture in.
+ * @param name                          Texture name.
+ * @return                              Texture array & layer for the provided texture, texture is added to the pool if
+ *                                      it's not there yet.
+ */
+static OpenGLTextureArrayPool::Slot findOrInsertTexture(OpenGLTextureArrayPool *pool, const std::string &name) {
+    if (const OpenGLTextureArrayPool::Slot *slot = pool->find(name))
+        return *slot;
+
+    // water tile - always the first layers of the first array
+    if (name == "wtrtyl")
+        return {};
+
+    GraphicsImage *texture = assets->getBitmap(name);
+    return pool->insert(name, texture->width(), texture->height());
 }
 
-GLshaderverts *outbuildshaderstore[16] = { nullptr };
-int numoutbuildverts[16] = { 0 };
+static const RgbaImage &loadPoolTexture(const std::string &name) {
+    return assets->getBitmap(name)->rgba();
+}
+
+// Per-frame vertex data for outdoor buildings, one vector per texture array in `_outbuildTextures`.
+static std::vector<std::vector<GLshaderverts>> outbuildshaderstore;
 
 void OpenGLRenderer::DrawOutdoorBuildings() {
+    OE_PROFILE_ZONE("gl buildings");
+
+    OpenGLPassTimerScope passTimer(&_passTimers, RENDER_PASS_OUTDOOR_BUILDINGS);
+
     // shader
     // verts are streamed to gpu as required
     // textures can be different sizes
@@ -3233,56 +3222,20 @@ void OpenGLRenderer::DrawOutdoorBuildings() {
     // TODO(pskelton): might have to pass a texture width through for the waterr flow textures to size right
     // and get the correct water speed
 
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
-    glFrontFace(GL_CCW);
+    openGLState.enable(GL_CULL_FACE);
+    openGLState.cullFace(GL_BACK);
+    openGLState.frontFace(GL_CCW);
 
     _set_3d_projection_matrix();
     _set_3d_modelview_matrix();
 
-    if (outbuildVAO[0] == 0) {
-        // count all triangles
-        // make out build shader store
-        int verttotals = 0;
-
-        for (int i = 0; i < 16; i++) {
-            numoutbuildverts[i] = 0;
-
-            //for (BSPModel &model : pOutdoor->pBModels) {
-            //    //int reachable;
-            //    //if (IsBModelVisible(&model, &reachable)) {
-            //    //model.field_40 |= 1;
-            //    if (!model.pFaces.empty()) {
-            //        for (ODMFace &face : model.pFaces) {
-            //            if (!face.Invisible()) {
-            //                numoutbuildverts += 3 * (face.uNumVertices - 2);
-            //            }
-            //        }
-            //    }
-            //}
-
-            free(outbuildshaderstore[i]);
-            outbuildshaderstore[i] = nullptr;
-            outbuildshaderstore[i] = (GLshaderverts *)malloc(sizeof(GLshaderverts) * 20000);
-        }
-
-        // reserve first 7 layers for water tiles in unit 0
-        auto wtrtexture = this->hd_water_tile_anim[0];
-        //terraintexmap.insert(std::make_pair("wtrtyl", terraintexmap.size()));
-        //numterraintexloaded[0]++;
-        outbuildtexturewidths[0] = wtrtexture->width();
-        outbuildtextureheights[0] = wtrtexture->height();
-
+    if (outbuildVAO == 0) {
+        // reserve first 7 layers for water tiles in the first array
         for (int buff = 0; buff < 7; buff++) {
             std::string container_name = fmt::format("HDWTR{:03}", buff);
-            outbuildtexmap.insert(std::make_pair(container_name, outbuildtexmap.size()));
-            numoutbuildtexloaded[0]++;
+            findOrInsertTexture(&_outbuildTextures, container_name);
         }
 
-
-
-
-
         for (BSPModel &model : pOutdoor->pBModels) {
             //int reachable;
             //if (IsBModelVisible(&model, &reachable)) {
@@ -3302,78 +3255,11 @@ void OpenGLRenderer::DrawOutdoorBuildings() {
                             animLength = pTextureFrameTable->textureFrameAnimLength((int64_t)face.resource);
                             texname = tex->GetName();
                         }
-                        // gather up all texture and shaderverts data
-
-                        //auto tile = pOutdoor->getTileDescByGrid(x, y);
 
-                        int texunit = 0;
-                        int texlayer = 0;
-                        int attribflags = 0;
-
-                        if (face.uAttributes & FACE_IsFluid) attribflags |= 2;
-                        if (face.uAttributes & FACE_INDOOR_SKY) attribflags |= 0x400;
-
-                        if (face.uAttributes & FACE_FlowDown)
-                            attribflags |= 0x400;
-                        else if (face.uAttributes & FACE_FlowUp)
-                            attribflags |= 0x800;
-
-                        if (face.uAttributes & FACE_FlowRight)
-                            attribflags |= 0x2000;
-                        else if (face.uAttributes & FACE_FlowLeft)
-                            attribflags |= 0x1000;
-
-                        // loop while running down animlength with frame animtimes
+                        // gather up all textures, loop while running down animlength with frame animtimes
+                        OpenGLTextureArrayPool::Slot slot;
                         do {
-                            // check if tile->name is already in list
-                            auto mapiter = outbuildtexmap.find(*texname);
-                            if (mapiter != outbuildtexmap.end()) {
-                                // if so, extract unit and layer
-                                int unitlayer = mapiter->second;
-                                texlayer = unitlayer & 0xFF;
-                                texunit = (unitlayer & 0xFF00) >> 8;
-                            } else if (*texname == "wtrtyl") {
-                                // water tile
-                                texunit = 0;
-                                texlayer = 0;
-                            } else {
-                                // else need to add it
-                                auto thistexture = assets->getBitmap(*texname);
-                                int width = thistexture->width();
-                                int height = thistexture->height();
-                                // check size to see what unit it needs
-                                int i;
-                                for (i = 0; i < 16; i++) {
-                                    if ((outbuildtexturewidths[i] == width && outbuildtextureheights[i] == height) || outbuildtexturewidths[i] == 0) break;
-                                }
-
-                                if (i == 16) {
-                                    logger->warning("Texture unit full - draw building!");
-                                    texunit = 0;
-                                    texlayer = 0;
-                                } else {
-                                    if (outbuildtexturewidths[i] == 0) {
-                                        outbuildtexturewidths[i] = width;
-                                        outbuildtextureheights[i] = height;
-                                    }
-
-                                    texunit = i;
-                                    texlayer = numoutbuildtexloaded[i];
-
-                                    // encode unit and layer together
-                                    int encode = (texunit << 8) | texlayer;
-
-                                    if (numoutbuildtexloaded[i] < 256) {
-                                        // intsert into tex map
-                                        outbuildtexmap.insert(std::make_pair(*texname, encode));
-                                        numoutbuildtexloaded[i]++;
-                                    } else {
-                                        logger->warning("Texture layer full - draw building!");
-                                        texunit = 0;
-                                        texlayer = 0;
-                                    }
-                                }
-                            }
+                            slot = findOrInsertTexture(&_outbuildTextures, *texname);
 
                             if (face.IsTextureFrameTable()) {
                                 // TODO(pskelton): any instances where animTime is not consistent would need checking
@@ -3383,219 +3269,197 @@ void OpenGLRenderer::DrawOutdoorBuildings() {
                             }
                         } while (animLength > frame);
 
-                        face.texunit = texunit;
-                        face.texlayer = texlayer;
+                        face.texunit = slot.array;
+                        face.texlayer = slot.layer;
                     }
                 }
             }
             //}
         }
 
-        for (int l = 0; l < 16; l++) {
-            glGenVertexArrays(1, &outbuildVAO[l]);
-            glGenBuffers(1, &outbuildVBO[l]);
-
-            glBindVertexArray(outbuildVAO[l]);
-            glBindBuffer(GL_ARRAY_BUFFER, outbuildVBO[l]);
-
-            glBufferData(GL_ARRAY_BUFFER, sizeof(GLshaderverts) * 20000, outbuildshaderstore[l], GL_DYNAMIC_DRAW);
-
-            // position attribute
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, x));
-            glEnableVertexAttribArray(0);
-            // tex uv attribute
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, u));
-            glEnableVertexAttribArray(1);
-            // tex unit attribute
-            // tex array layer attribute
-            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, texunit));
-            glEnableVertexAttribArray(2);
-            // normals
-            glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, normx));
-            glEnableVertexAttribArray(3);
-            // attribs - not used here yet
-            glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, attribs));
-            glEnableVertexAttribArray(4);
+        // simplified meshes for distant models
+        _outbuildLods.clear();
+        if (config->graphics.BuildingLods.value()) {
+            for (const BSPModel &model : pOutdoor->pBModels) {
+                OutdoorModelLods &lods = _outbuildLods.emplace_back();
+                for (size_t i = 0; i < lods.size(); i++) {
+                    float clusterSize = std::max(8.0f, model.sBoundingRadius / OUTDOOR_MODEL_LOD_DETAIL[i]);
+                    lods[i] = buildBSPModelLod(model, clusterSize);
+                }
+            }
         }
 
-        // texture set up
+        glGenVertexArrays(1, &outbuildVAO);
 
-        // loop over all units
-        for (int unit = 0; unit < 16; unit++) {
-            assert(numoutbuildtexloaded[unit] <= 256);
-            // skip if textures are empty
-            if (numoutbuildtexloaded[unit] == 0) continue;
+        openGLState.bindVertexArray(outbuildVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, _streamBuffer.id());
 
-            glGenTextures(1, &outbuildtextures[unit]);
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D_ARRAY, outbuildtextures[unit]);
-
-            // create blank memory for later texture submission
-            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, outbuildtexturewidths[unit], outbuildtextureheights[unit], numoutbuildtexloaded[unit], 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-            std::map<std::string, int>::iterator it = outbuildtexmap.begin();
-            while (it != outbuildtexmap.end()) {
-                // skip if wtrtyl
-                //if ((it->first).substr(0, 6) == "wtrtyl") {
-                //    std::cout << "skipped  " << it->first << std::endl;
-                 //   it++;
-                 //   continue;
-                //}
+        // position attribute
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, x));
+        glEnableVertexAttribArray(0);
+        // tex uv attribute
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, u));
+        glEnableVertexAttribArray(1);
+        // tex array & layer attribute
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, texunit));
+        glEnableVertexAttribArray(2);
+        // normals
+        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, normx));
+        glEnableVertexAttribArray(3);
+        // attribs - not used here yet
+        glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, attribs));
+        glEnableVertexAttribArray(4);
 
-                int comb = it->second;
-                int tlayer = comb & 0xFF;
-                int tunit = (comb & 0xFF00) >> 8;
+        openGLState.bindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
 
-                if (tunit == unit) {
-                    // get texture
-                    auto texture = assets->getBitmap(it->first);
+    // results are from the previous frames, queries for this frame are issued after all the buildings are drawn
+    bool occlusionCulling = config->graphics.OcclusionCulling.value();
+    size_t occlusionSize = occlusionCulling ? pOutdoor->pBModels.size() : 0;
+    if (_outbuildOcclusion.size() != occlusionSize)
+        _outbuildOcclusion.reset(occlusionSize);
+    _outbuildOcclusion.update();
+    _outbuildOcclusionCandidates.clear();
 
-                    glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
-                        0,
-                        0, 0, tlayer,
-                        outbuildtexturewidths[unit], outbuildtextureheights[unit], 1,
-                        GL_RGBA,
-                        GL_UNSIGNED_BYTE,
-                        texture->rgba().pixels().data());
-                }
+        // else update verts - blank store
+        for (std::vector<GLshaderverts> &store : outbuildshaderstore)
+            store.clear();
+
+        // Prepares face for drawing, returns the store to put the face triangles into, or nullptr if the face
+        // shouldn't be drawn.
+        auto prepareFace = [&](const BSPModel &model, ODMFace &face, int *texunit, int *texlayer,
+                               int *attribflags) -> std::vector<GLshaderverts> * {
+            if (face.Invisible())
+                return nullptr;
+
+            array_73D150[0].vWorldPosition = model.pVertices[face.pVertexIDs[0]].toFloat();
+            if (!pCamera3D->is_face_faced_to_cameraODM(&face, &array_73D150[0]))
+                return nullptr;
+
+            if (face.IsTextureFrameTable()) {
+                *texlayer = -1;
+                *texunit = -1;
+            } else {
+                *texlayer = face.texlayer;
+                *texunit = face.texunit;
+            }
 
-                it++;
+            if (*texlayer == -1) { // texture has been reset - see if its in the pool
+                OpenGLTextureArrayPool::Slot slot = findOrInsertTexture(&_outbuildTextures, *face.GetTexture()->GetName());
+                face.texunit = *texunit = slot.array;
+                face.texlayer = *texlayer = slot.layer;
             }
 
-            //iterate through terrain tex map
-            //ignore wtrtyl
-            //laod in
+            *attribflags = 0;
 
-            //auto tile = pOutdoor->getTileDescByGrid(0, 0);
-            //bool border = tile->IsWaterBorderTile();
+            if (face.uAttributes & FACE_IsFluid) *attribflags |= 2;
+            if (face.uAttributes & FACE_INDOOR_SKY) *attribflags |= 0x400;
 
+            if (face.uAttributes & FACE_FlowDown)
+                *attribflags |= 0x400;
+            else if (face.uAttributes & FACE_FlowUp)
+                *attribflags |= 0x800;
 
-            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            if (face.uAttributes & FACE_FlowRight)
+                *attribflags |= 0x2000;
+            else if (face.uAttributes & FACE_FlowLeft)
+                *attribflags |= 0x1000;
 
-            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
-        }
-    }
+            if (face.uAttributes & FACE_OUTLINED || (face.uAttributes & FACE_IsSecret) && engine->is_saturate_faces)
+                *attribflags |= 0x00010000;
 
-        // else update verts - blank store
-        for (int i = 0; i < 16; i++) {
-            numoutbuildverts[i] = 0;
-        }
+            if (*texunit >= outbuildshaderstore.size())
+                outbuildshaderstore.resize(*texunit + 1);
+            return &outbuildshaderstore[*texunit];
+        };
+
+        auto writeVertex = [](GLshaderverts *thisvert, const Vec3f &pos, float u, float v, const ODMFace &face,
+                              int texunit, int texlayer, int attribflags) {
+            thisvert->x = pos.x;
+            thisvert->y = pos.y;
+            thisvert->z = pos.z;
+            thisvert->u = u + face.sTextureDeltaU;
+            thisvert->v = v + face.sTextureDeltaV;
+            thisvert->texunit = texunit;
+            thisvert->texturelayer = texlayer;
+            thisvert->normx = face.facePlane.normal.x;
+            thisvert->normy = face.facePlane.normal.y;
+            thisvert->normz = face.facePlane.normal.z;
+            thisvert->attribs = attribflags;
+        };
+
+        bool useLods = !_outbuildLods.empty();
+        Vec3f cameraPos(pCamera3D->vCameraPos.x, pCamera3D->vCameraPos.y, pCamera3D->vCameraPos.z);
 
         for (BSPModel &model : pOutdoor->pBModels) {
             bool reachable;
             if (IsBModelVisible(&model, 256, &reachable)) {
                 //if (model.index == 35) continue;
                 model.field_40 |= 1;
-                if (!model.pFaces.empty()) {
-                    for (ODMFace &face : model.pFaces) {
-                        if (!face.Invisible()) {
-                            array_73D150[0].vWorldPosition = model.pVertices[face.pVertexIDs[0]].toFloat();
-
-                            if (pCamera3D->is_face_faced_to_cameraODM(&face, &array_73D150[0])) {
-                                int texunit = 0;
-                                int texlayer = 0;
-
-                                if (face.IsTextureFrameTable()) {
-                                    texlayer = -1;
-                                    texunit = -1;
-                                } else {
-                                    texlayer = face.texlayer;
-                                    texunit = face.texunit;
-                                }
-
-                                if (texlayer == -1) { // texture has been reset - see if its in the map
-                                    GraphicsImage *tex = face.GetTexture();
-                                    std::string *texname = tex->GetName();
-                                    auto mapiter = bsptexmap.find(*texname);
-                                    if (mapiter != bsptexmap.end()) {
-                                        // if so, extract unit and layer
-                                        int unitlayer = mapiter->second;
-                                        face.texlayer = texlayer = unitlayer & 0xFF;
-                                        face.texunit = texunit = (unitlayer & 0xFF00) >> 8;
-                                    } else {
-                                        logger->warning("Texture not found in map!");
-                                        // TODO(pskelton): set to water for now - fountains in walls of mist
-                                        texunit = face.texlayer = 0;
-                                        texlayer = face.texunit = 0;
-                                    }
-                                }
-
-                                int attribflags = 0;
-
-                                if (face.uAttributes & FACE_IsFluid) attribflags |= 2;
-                                if (face.uAttributes & FACE_INDOOR_SKY) attribflags |= 0x400;
-
-                                if (face.uAttributes & FACE_FlowDown)
-                                    attribflags |= 0x400;
-                                else if (face.uAttributes & FACE_FlowUp)
-                                    attribflags |= 0x800;
-
-                                if (face.uAttributes & FACE_FlowRight)
-                                    attribflags |= 0x2000;
-                                else if (face.uAttributes & FACE_FlowLeft)
-                                    attribflags |= 0x1000;
-
-                                if (face.uAttributes & FACE_OUTLINED || (face.uAttributes & FACE_IsSecret) && engine->is_saturate_faces)
-                                    attribflags |= 0x00010000;
-
-                                // load up verts here
-                                for (int z = 0; z < (face.uNumVertices - 2); z++) {
-                                    // 123, 134, 145, 156..
-                                    GLshaderverts *thisvert = &outbuildshaderstore[texunit][numoutbuildverts[texunit]];
-
-                                    // copy first
-                                    thisvert->x = model.pVertices[face.pVertexIDs[0]].x;
-                                    thisvert->y = model.pVertices[face.pVertexIDs[0]].y;
-                                    thisvert->z = model.pVertices[face.pVertexIDs[0]].z;
-                                    thisvert->u = face.pTextureUIDs[0] + face.sTextureDeltaU;
-                                    thisvert->v = face.pTextureVIDs[0] + face.sTextureDeltaV;
-                                    thisvert->texunit = texunit;
-                                    thisvert->texturelayer = texlayer;
-                                    thisvert->normx = face.facePlane.normal.x;
-                                    thisvert->normy = face.facePlane.normal.y;
-                                    thisvert->normz = face.facePlane.normal.z;
-                                    thisvert->attribs = attribflags;
-                                    thisvert++;
-
-                                    // copy other two (z+1)(z+2)
-                                    for (unsigned i = 1; i < 3; ++i) {
-                                        thisvert->x = model.pVertices[face.pVertexIDs[z + i]].x;
-                                        thisvert->y = model.pVertices[face.pVertexIDs[z + i]].y;
-                                        thisvert->z = model.pVertices[face.pVertexIDs[z + i]].z;
-                                        thisvert->u = face.pTextureUIDs[z + i] + face.sTextureDeltaU;
-                                        thisvert->v = face.pTextureVIDs[z + i] + face.sTextureDeltaV;
-                                        thisvert->texunit = texunit;
-                                        thisvert->texturelayer = texlayer;
-                                        thisvert->normx = face.facePlane.normal.x;
-                                        thisvert->normy = face.facePlane.normal.y;
-                                        thisvert->normz = face.facePlane.normal.z;
-                                        thisvert->attribs = attribflags;
-                                        thisvert++;
-                                    }
-
-                                    numoutbuildverts[texunit] += 3;
-                                    assert(numoutbuildverts[texunit] <= 9999);
-                                }
-                            }
+                if (occlusionCulling) {
+                    _outbuildOcclusionCandidates.push_back(model.index);
+                    if (_outbuildOcclusion.isOccluded(model.index))
+                        continue;
+                }
+
+                int texunit = 0;
+                int texlayer = 0;
+                int attribflags = 0;
+
+                const BSPModelLod *lod = useLods ? selectOutdoorModelLod(model, cameraPos) : nullptr;
+                if (lod) {
+                    int lastFace = -1;
+                    std::vector<GLshaderverts> *store = nullptr;
+                    for (const BSPModelLod::Triangle &triangle : lod->triangles) {
+                        ODMFace &face = model.pFaces[triangle.face];
+                        if (triangle.face != lastFace) {
+                            lastFace = triangle.face;
+                            store = prepareFace(model, face, &texunit, &texlayer, &attribflags);
+                        }
+                        if (!store)
+                            continue;
+
+                        store->resize(store->size() + 3);
+                        GLshaderverts *thisvert = &(*store)[store->size() - 3];
+                        for (const BSPModelLod::Vertex &vertex : triangle.vertices)
+                            writeVertex(thisvert++, vertex.pos, vertex.u, vertex.v, face, texunit, texlayer, attribflags);
+                    }
+                    continue;
+                }
+
+                for (ODMFace &face : model.pFaces) {
+                    std::vector<GLshaderverts> *store = prepareFace(model, face, &texunit, &texlayer, &attribflags);
+                    if (!store)
+                        continue;
+
+                    // load up verts here
+                    for (int z = 0; z < (face.uNumVertices - 2); z++) {
+                        // 123, 134, 145, 156..
+                        store->resize(store->size() + 3);
+                        GLshaderverts *thisvert = &(*store)[store->size() - 3];
+
+                        // copy first, then the other two (z+1)(z+2)
+                        for (int i : {0, z + 1, z + 2}) {
+                            writeVertex(thisvert++, model.pVertices[face.pVertexIDs[i]].toFloat(),
+                                        face.pTextureUIDs[i], face.pTextureVIDs[i], face, texunit, texlayer, attribflags);
                         }
                     }
                 }
+            } else if (occlusionCulling) {
+                // this model wasn't tested while out of view, so the last result is stale
+                _outbuildOcclusion.markVisible(model.index);
             }
         }
 
-        for (int l = 0; l < 16; l++) {
-            if (numoutbuildverts[l]) {
-                glBindBuffer(GL_ARRAY_BUFFER, outbuildVBO[l]);
-                // orphan buffer
-                glBufferData(GL_ARRAY_BUFFER, sizeof(GLshaderverts) * 20000, NULL, GL_DYNAMIC_DRAW);
-                // update buffer
-                glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(GLshaderverts) * numoutbuildverts[l], outbuildshaderstore[l]);
-            }
-        }
+        // upload any textures that were added this frame
+        _outbuildTextures.commit(loadPoolTexture, &_textureArrayUploader);
 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        // update buffer
+        std::vector<GLint> outbuildfirst(outbuildshaderstore.size());
+        for (size_t l = 0; l < outbuildshaderstore.size(); l++)
+            if (!outbuildshaderstore[l].empty())
+                outbuildfirst[l] = _streamBuffer.upload(outbuildshaderstore[l].data(), outbuildshaderstore[l].size());
 
     // terrain debug
     if (engine->config->debug.Terrain.value())
@@ -3603,7 +3467,7 @@ void OpenGLRenderer::DrawOutdoorBuildings() {
         if (!OpenGLES)
             glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-    glUseProgram(outbuildshader.ID);
+    openGLState.useProgram(outbuildshader.ID);
     // set projection
     glUniformMatrix4fv(glGetUniformLocation(outbuildshader.ID, "projection"), 1, GL_FALSE, &projmat[0][0]);
     // set view
@@ -3624,10 +3488,7 @@ void OpenGLRenderer::DrawOutdoorBuildings() {
     glUniform1f(glGetUniformLocation(outbuildshader.ID, "fog.fogmiddle"), GLfloat(fogmiddle));
     glUniform1f(glGetUniformLocation(outbuildshader.ID, "fog.fogend"), GLfloat(fogend));
 
-    GLfloat camera[3] {};
-    camera[0] = (float)(pParty->pos.x - pParty->_yawGranularity * cosf(2 * pi_double * pParty->_viewYaw / 2048.0f));
-    camera[1] = (float)(pParty->pos.y - pParty->_yawGranularity * sinf(2 * pi_double * pParty->_viewYaw / 2048.0f));
-    camera[2] = (float)(pParty->pos.z + pParty->eyeLevel);
+    GLfloat camera[3] {pCamera3D->vCameraPos.x, pCamera3D->vCameraPos.y, pCamera3D->vCameraPos.z};
     glUniform3fv(glGetUniformLocation(outbuildshader.ID, "CameraPos"), 1, &camera[0]);
 
 
@@ -3647,125 +3508,41 @@ void OpenGLRenderer::DrawOutdoorBuildings() {
         glUniform3f(glGetUniformLocation(terrainshader.ID, "sun.specular"), 0.0f, 0.0f, 0.0f);
     }
 
+    // point lights
+    bindLightClusters(outbuildshader.ID);
 
-    // TODO(pskelton): this should be a seperate function
-    // rest of lights stacking
-    GLuint num_lights = 0;
-
-    // get party torchlight as priority - can be radius == 0
-    for (int i = 0; i < 1; ++i) {
-        if (pMobileLightsStack->uNumLightsActive < 1) continue;
-
-        MobileLight &test = pMobileLightsStack->pLights[i];
-        std::string slotnum = std::to_string(num_lights);
-
-        float x = pMobileLightsStack->pLights[i].vPosition.x;
-        float y = pMobileLightsStack->pLights[i].vPosition.y;
-        float z = pMobileLightsStack->pLights[i].vPosition.z;
-
-        Colorf color = pMobileLightsStack->pLights[i].uLightColor.toColorf();
-
-        glUniform1f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 2.0f);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].position").c_str()), x, y, z);
-        glUniform1f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].sector").c_str()), 0);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].ambient").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].diffuse").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].specular").c_str()), 0, 0, 0);
-        glUniform1f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].radius").c_str()), test.uRadius);
-        num_lights++;
-    }
-
-    for (int i = 0; i < pStationaryLightsStack->uNumLightsActive; ++i) {
-        // maximum 20 lights sent to shader at the moment
-        // TODO(pskelton): make this configurable - also lights should be sorted by distance so nearest are used first
-        if (num_lights >= 20) break;
-
-        std::string slotnum = std::to_string(num_lights);
-        StationaryLight &test = pStationaryLightsStack->pLights[i];
-
-        float x = test.vPosition.x;
-        float y = test.vPosition.y;
-        float z = test.vPosition.z;
-
-        Colorf color = test.uLightColor.toColorf();
-
-        float lightrad = test.uRadius;
-
-        glUniform1f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 1.0);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].position").c_str()), x, y, z);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].ambient").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].diffuse").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].specular").c_str()), color.r, color.g, color.b);
-        glUniform1f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].radius").c_str()), lightrad);
-
-        num_lights++;
-    }
-
-    // mobile
-    for (int i = 1; i < pMobileLightsStack->uNumLightsActive; ++i) {
-        // maximum 20 lights sent to shader at the moment
-        // TODO(pskelton): make this configurable - also lights should be sorted by distance so nearest are used first
-        if (num_lights >= 20) break;
-
-        std::string slotnum = std::to_string(num_lights);
-        MobileLight &test = pMobileLightsStack->pLights[i];
-
-        float x = pMobileLightsStack->pLights[i].vPosition.x;
-        float y = pMobileLightsStack->pLights[i].vPosition.y;
-        float z = pMobileLightsStack->pLights[i].vPosition.z;
-
-        Colorf color = pMobileLightsStack->pLights[i].uLightColor.toColorf();
-
-        float lightrad = pMobileLightsStack->pLights[i].uRadius;
-
-        glUniform1f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 2.0);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].position").c_str()), x, y, z);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].ambient").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].diffuse").c_str()), color.r, color.g, color.b);
-        glUniform3f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].specular").c_str()), color.r, color.g, color.b);
-        glUniform1f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].radius").c_str()), lightrad);
+    openGLState.activeTexture(GL_TEXTURE0);
+    openGLState.bindVertexArray(outbuildVAO);
 
-        num_lights++;
-    }
-
-    // blank the rest of the lights
-    for (int blank = num_lights; blank < 20; blank++) {
-        std::string slotnum = std::to_string(blank);
-        glUniform1f(glGetUniformLocation(outbuildshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 0.0);
-    }
-
-
-    // toggle for water faces or not
-    glUniform1i(glGetUniformLocation(outbuildshader.ID, "watertiles"), GLint(1));
+    for (int unit = 0; unit < outbuildshaderstore.size(); unit++) {
+        // skip if there's nothing to draw
+        if (outbuildshaderstore[unit].empty())
+            continue;
 
-    glActiveTexture(GL_TEXTURE0);
+        // water tiles are only in the first array
+        glUniform1i(glGetUniformLocation(outbuildshader.ID, "watertiles"), GLint(unit == 0));
+        glUniform2i(glGetUniformLocation(outbuildshader.ID, "textureArraySize"),
+                    _outbuildTextures.width(unit), _outbuildTextures.height(unit));
 
-    for (int unit = 0; unit < 16; unit++) {
-        // skip if textures are empty
-        //if (numoutbuildtexloaded[unit] > 0) {
-            if (unit == 1) {
-                glUniform1i(glGetUniformLocation(outbuildshader.ID, "watertiles"), GLint(0));
-            }
-
-            // draw each set of triangles
-            glBindTexture(GL_TEXTURE_2D_ARRAY, outbuildtextures[unit]);
-            glBindVertexArray(outbuildVAO[unit]);
-            glDrawArrays(GL_TRIANGLES, 0, (numoutbuildverts[unit]));
-            drawcalls++;
-        //}
+        // draw each set of triangles
+        openGLState.bindTexture(GL_TEXTURE_2D_ARRAY, _outbuildTextures.texture(unit));
+        glDrawArrays(GL_TRIANGLES, outbuildfirst[unit], outbuildshaderstore[unit].size());
+        drawcalls++;
     }
 
     // unload
-    glUseProgram(0);
+    openGLState.useProgram(0);
     glDisableVertexAttribArray(0);
     glDisableVertexAttribArray(1);
     glDisableVertexAttribArray(2);
     glDisableVertexAttribArray(3);
     glDisableVertexAttribArray(4);
-    glBindVertexArray(0);
+    openGLState.bindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    openGLState.activeTexture(GL_TEXTURE0);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
+
+    drawOutdoorBuildingOcclusionQueries();
 
     //end terrain debug
     if (engine->config->debug.Terrain.value())
@@ -3773,90 +3550,198 @@ void OpenGLRenderer::DrawOutdoorBuildings() {
         if (!OpenGLES)
             glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-    // TODO(pskelton): clean up
     // need to stack decals
-    if (!decal_builder->bloodsplat_container->uNumBloodsplats) return;
+    StackOutdoorBuildingDecals();
+}
+
+const BSPModelLod *OpenGLRenderer::selectOutdoorModelLod(const BSPModel &model, const Vec3f &cameraPos) const {
+    // projected radius of the model's bounding sphere, in pixels
+    float distance = (model.vBoundingCenter.toFloat() - cameraPos).length();
+    float screenRadius = model.sBoundingRadius * pCamera3D->ViewPlaneDistPixels / std::max(distance, 1.0f);
 
-    for (BSPModel &model : pOutdoor->pBModels) {
-        if (model.pFaces.empty()) {
+    const OutdoorModelLods &lods = _outbuildLods[model.index];
+    for (int i = lods.size() - 1; i >= 0; i--)
+        if (screenRadius < OUTDOOR_MODEL_LOD_SCREEN_RADIUS[i])
+            return lods[i].triangles.empty() ? nullptr : &lods[i];
+    return nullptr;
+}
+
+void OpenGLRenderer::drawOutdoorBuildingOcclusionQueries() {
+    if (_outbuildOcclusionCandidates.empty())
+        return;
+
+    // Boxes are inflated a bit so that the faces lying on the box don't get z-fighting with it. Camera inside of the
+    // box can't test it, as the box faces closest to the camera are clipped by the near plane.
+    static constexpr int BOX_MARGIN = 16;
+    float cameraMargin = pCamera3D->GetNearClip() + 2 * BOX_MARGIN;
+    Vec3f cameraPos(pCamera3D->vCameraPos.x, pCamera3D->vCameraPos.y, pCamera3D->vCameraPos.z);
+
+    std::vector<Vec3f> &verts = _outbuildOcclusionVerts;
+    verts.clear();
+    size_t queryCount = 0;
+    for (int index : _outbuildOcclusionCandidates) {
+        const BSPModel &model = pOutdoor->pBModels[index];
+        if (!_outbuildOcclusion.canBegin(index))
+            continue; // Previous query is still in flight.
+
+        if (model.pBoundingBox.intersectsCube(cameraPos, cameraMargin)) {
+            _outbuildOcclusion.markVisible(index);
             continue;
         }
 
-        // check for any splat in this models box - if not continue
-        bool found{ false };
-        for (int splat = 0; splat < decal_builder->bloodsplat_container->uNumBloodsplats; ++splat) {
-            Bloodsplat *thissplat = &decal_builder->bloodsplat_container->pBloodsplats_to_apply[splat];
-            if (model.pBoundingBox.intersectsCube(thissplat->pos, thissplat->radius)) {
-                found = true;
-                break;
-            }
+        float x1 = model.pBoundingBox.x1 - BOX_MARGIN, x2 = model.pBoundingBox.x2 + BOX_MARGIN;
+        float y1 = model.pBoundingBox.y1 - BOX_MARGIN, y2 = model.pBoundingBox.y2 + BOX_MARGIN;
+        float z1 = model.pBoundingBox.z1 - BOX_MARGIN, z2 = model.pBoundingBox.z2 + BOX_MARGIN;
+        Vec3f corners[8] = {
+            {x1, y1, z1}, {x2, y1, z1}, {x2, y2, z1}, {x1, y2, z1},
+            {x1, y1, z2}, {x2, y1, z2}, {x2, y2, z2}, {x1, y2, z2}
+        };
+        static constexpr int faces[6][4] = {
+            {0, 1, 2, 3}, {4, 5, 6, 7}, {0, 1, 5, 4}, {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}
+        };
+        for (const auto &face : faces) {
+            for (int corner : {face[0], face[1], face[2], face[0], face[2], face[3]})
+                verts.push_back(corners[corner]);
         }
-        if (!found) continue;
 
-        for (ODMFace &face : model.pFaces) {
-            if (face.Invisible()) {
-                continue;
-            }
+        _outbuildOcclusionCandidates[queryCount++] = index;
+    }
+    if (queryCount == 0)
+        return;
 
-            struct Polygon *poly = &array_77EC08[pODMRenderParams->uNumPolygons];
-            poly->flags = 0;
-            poly->field_32 = 0;
+    if (outbuildOcclusionVAO == 0) {
+        glGenVertexArrays(1, &outbuildOcclusionVAO);
+        openGLState.bindVertexArray(outbuildOcclusionVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, _streamBuffer.id());
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vec3f), (void *)0);
+        glEnableVertexAttribArray(0);
+        openGLState.bindVertexArray(0);
+    }
 
-            // if (v53 == face.uNumVertices) poly->field_32 |= 1;
-            poly->pODMFace = &face;
-            poly->uNumVertices = face.uNumVertices;
-            poly->field_59 = 5;
+    GLint first = _streamBuffer.upload(verts.data(), verts.size());
 
+    // boxes only touch the query counters, not the framebuffer
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    openGLState.depthMask(GL_FALSE);
+    openGLState.disable(GL_CULL_FACE);
 
-            float _f1 = face.facePlane.normal.x * pOutdoor->vSunlight.x + face.facePlane.normal.y * pOutdoor->vSunlight.y + face.facePlane.normal.z * pOutdoor->vSunlight.z;
-            poly->dimming_level = 20.0 - floorf(20.0 * _f1 + 0.5f);
-            poly->dimming_level = std::clamp((int)poly->dimming_level, 0, 31);
+    openGLState.useProgram(lineshader.ID);
+    glUniformMatrix4fv(glGetUniformLocation(lineshader.ID, "projection"), 1, GL_FALSE, &projmat[0][0]);
+    glUniformMatrix4fv(glGetUniformLocation(lineshader.ID, "view"), 1, GL_FALSE, &viewmat[0][0]);
+    openGLState.bindVertexArray(outbuildOcclusionVAO);
 
-            for (unsigned vertex_id = 1; vertex_id <= face.uNumVertices; vertex_id++) {
-                array_73D150[vertex_id - 1].vWorldPosition.x =
-                    model.pVertices[face.pVertexIDs[vertex_id - 1]].x;
-                array_73D150[vertex_id - 1].vWorldPosition.y =
-                    model.pVertices[face.pVertexIDs[vertex_id - 1]].y;
-                array_73D150[vertex_id - 1].vWorldPosition.z =
-                    model.pVertices[face.pVertexIDs[vertex_id - 1]].z;
-            }
+    for (size_t i = 0; i < queryCount; i++) {
+        _outbuildOcclusion.begin(_outbuildOcclusionCandidates[i]);
+        glDrawArrays(GL_TRIANGLES, first + static_cast<GLint>(36 * i), 36);
+        _outbuildOcclusion.end();
+    }
+    drawcalls += queryCount;
 
-            for (int vertex_id = 0; vertex_id < face.uNumVertices; ++vertex_id) {
-                memcpy(&VertexRenderList[vertex_id], &array_73D150[vertex_id], sizeof(VertexRenderList[vertex_id]));
-                VertexRenderList[vertex_id]._rhw = 1.0 / (array_73D150[vertex_id].vWorldViewPosition.x + 0.0000001);
-            }
+    openGLState.bindVertexArray(0);
+    openGLState.useProgram(0);
+    openGLState.enable(GL_CULL_FACE);
+    openGLState.depthMask(GL_TRUE);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
 
-            decal_builder->ApplyBloodSplat_OutdoorFace(&face);
-            if (decal_builder->uNumSplatsThisFace > 0) {
-                decal_builder->BuildAndApplyDecals(
-                    31 - poly->dimming_level, LocationBuildings,
-                    face.facePlane,
-                    face.uNumVertices, VertexRenderList, 0, -1);
-            }
-        }
-    }
+bool OpenGLRenderer::isOutdoorModelOccluded(const BSPModel &model) const {
+    return _outbuildOcclusion.isOccluded(model.index);
+}
 
-    return;
+// Location of an indoor face in the static BSP vertex buffer, and the state its vertices were last written with.
+struct BSPFaceRange {
+    GLint first = 0;
+    GLsizei count = 0; // Zero for faces that are not in the buffer (portals & degenerate faces).
+    int texunit = -1;
+    int texlayer = -1;
+    int attribs = 0;
+    bool dynamic = false; // Uvs change every frame - sky floors.
+    bool stale = false; // Vertices need to be rewritten on the next draw - faces of doors that have moved.
+    unsigned drawnFrame = 0; // Last frame this face was queued for drawing in.
+};
+
+// Per-level state for indoor faces, indexed by face id.
+static std::vector<BSPFaceRange> bspFaceRanges;
+// Per-frame draw ranges for indoor faces, one vector per texture array in `_bspTextures`.
+static std::vector<std::vector<std::pair<GLint, GLsizei>>> bspDrawRanges;
+static unsigned bspFrame = 0;
+// Last seen `BLVDoor::uGeometryVersion` for each door, indexed by door index.
+static std::vector<uint32_t> bspDoorVersions;
+
+static int bspFaceAttribs(const BLVFace *face) {
+    int attribflags = 0;
 
+    if (face->uAttributes & FACE_IsFluid) attribflags |= 2;
 
+    if (face->uAttributes & FACE_FlowDown)
+        attribflags |= 0x400;
+    else if (face->uAttributes & FACE_FlowUp)
+        attribflags |= 0x800;
 
-    ///////////////// shader end
+    if (face->uAttributes & FACE_FlowRight)
+        attribflags |= 0x2000;
+    else if (face->uAttributes & FACE_FlowLeft)
+        attribflags |= 0x1000;
+
+    if (face->uAttributes & FACE_OUTLINED || (face->uAttributes & FACE_IsSecret) && engine->is_saturate_faces)
+        attribflags |= 0x00010000;
+
+    return attribflags;
 }
 
-GLshaderverts *BSPshaderstore[16] = { nullptr };
-int numBSPverts[16] = { 0 };
+/**
+ * Triangulates an indoor face into a triangle fan.
+ *
+ * @param face                          Face to triangulate.
+ * @param texunit                       Texture array index.
+ * @param texlayer                      Texture array layer.
+ * @param attribflags                   Shader attribute flags.
+ * @param skymodtimex                   U offset for sky faces.
+ * @param skymodtimey                   V offset for sky faces.
+ * @param[out] verts                    Output vertices, must have space for `3 * (face->uNumVertices - 2)` vertices.
+ */
+static void fillBSPFaceVerts(const BLVFace *face, int texunit, int texlayer, int attribflags,
+                             float skymodtimex, float skymodtimey, GLshaderverts *verts) {
+    GLshaderverts *thisvert = verts;
+    for (int z = 0; z < (face->uNumVertices - 2); z++) {
+        // 123, 134, 145, 156..
+        for (int i : {0, z + 1, z + 2}) {
+            thisvert->x = pIndoor->pVertices[face->pVertexIDs[i]].x;
+            thisvert->y = pIndoor->pVertices[face->pVertexIDs[i]].y;
+            thisvert->z = pIndoor->pVertices[face->pVertexIDs[i]].z;
+            thisvert->u = face->pVertexUIDs[i] + pIndoor->pFaceExtras[face->uFaceExtraID].sTextureDeltaU  /*+ face->sTextureDeltaU*/;
+            thisvert->v = face->pVertexVIDs[i] + pIndoor->pFaceExtras[face->uFaceExtraID].sTextureDeltaV  /*+ face->sTextureDeltaV*/;
+            if (face->Indoor_sky()) {
+                thisvert->u = (skymodtimex + thisvert->u) * 0.25f;
+                thisvert->v = (skymodtimey + thisvert->v) * 0.25f;
+            }
+            thisvert->texunit = texunit;
+            thisvert->texturelayer = texlayer;
+            thisvert->normx = face->facePlane.normal.x;
+            thisvert->normy = face->facePlane.normal.y;
+            thisvert->normz = face->facePlane.normal.z;
+            thisvert->attribs = attribflags;
+            thisvert->sector = face->uSectorID;
+            thisvert++;
+        }
+    }
+}
 
 void OpenGLRenderer::DrawIndoorFaces() {
+    OE_PROFILE_ZONE("gl indoor faces");
+
+    OpenGLPassTimerScope passTimer(&_passTimers, RENDER_PASS_INDOOR_FACES);
+
     // void RenderOpenGL::DrawIndoorBSP() {
 
     // TODO(pskelton): might have to pass a texture width through for the waterr flow textures to size right
     // and get the correct water speed
 
 
-        glEnable(GL_CULL_FACE);
+        openGLState.enable(GL_CULL_FACE);
 
-        glCullFace(GL_BACK);
-        glFrontFace(GL_CCW);
+        openGLState.cullFace(GL_BACK);
+        openGLState.frontFace(GL_CCW);
 
         _set_ortho_projection(1);
         _set_ortho_modelview();
@@ -3864,11 +3749,11 @@ void OpenGLRenderer::DrawIndoorFaces() {
         _set_3d_projection_matrix();
         _set_3d_modelview_matrix();
 
-        if (bspVAO[0] == 0) {
+        if (bspVAO == 0) {
             // lights setup
             int cntnosect = 0;
 
-            for (int lightscnt = 0; lightscnt < pStationaryLightsStack->uNumLightsActive; ++lightscnt) {
+            for (int lightscnt = 0; lightscnt < pStationaryLightsStack->pLights.size(); ++lightscnt) {
                 StationaryLight &test = pStationaryLightsStack->pLights[lightscnt];
 
 
@@ -3880,25 +3765,10 @@ void OpenGLRenderer::DrawIndoorFaces() {
             if (cntnosect)
                 logger->warning("{} lights - sector not found", cntnosect);
 
-            for (int i = 0; i < 16; i++) {
-                numBSPverts[i] = 0;
-                free(BSPshaderstore[i]);
-                BSPshaderstore[i] = nullptr;
-                BSPshaderstore[i] = (GLshaderverts*)malloc(sizeof(GLshaderverts) * 20000);
-            }
-
-
-            // reserve first 7 layers for water tiles in unit 0
-            auto wtrtexture = this->hd_water_tile_anim[0];
-            //terraintexmap.insert(std::make_pair("wtrtyl", terraintexmap.size()));
-            //numterraintexloaded[0]++;
-            bsptexturewidths[0] = wtrtexture->width();
-            bsptextureheights[0] = wtrtexture->height();
-
+            // reserve first 7 layers for water tiles in the first array
             for (int buff = 0; buff < 7; buff++) {
                 std::string container_name = fmt::format("HDWTR{:03}", buff);
-                bsptexmap.insert(std::make_pair(container_name, bsptexmap.size()));
-                bsptexloaded[0]++;
+                findOrInsertTexture(&_bspTextures, container_name);
             }
 
 
@@ -3943,56 +3813,9 @@ void OpenGLRenderer::DrawIndoorFaces() {
 
                 // loop while running down animlength with frame animtimes
                 do {
-                    // check if tile->name is already in list
-                    auto mapiter = bsptexmap.find(*texname);
-                    if (mapiter != bsptexmap.end()) {
-                        // if so, extract unit and layer
-                        int unitlayer = mapiter->second;
-                        // TODO(pskelton): make this a pair/struct rather than encoding
-                        texlayer = unitlayer & 0xFF;
-                        texunit = (unitlayer & 0xFF00) >> 8;
-                    } else if (*texname == "wtrtyl") {
-                        // water tile
-                        texunit = 0;
-                        texlayer = 0;
-                    } else {
-                        // else need to add it
-                        auto thistexture = assets->getBitmap(*texname);
-                        int width = thistexture->width();
-                        int height = thistexture->height();
-                        // check size to see what unit it needs
-                        int i;
-                        for (i = 0; i < 16; i++) {
-                            if ((bsptexturewidths[i] == width && bsptextureheights[i] == height) || bsptexturewidths[i] == 0) break;
-                        }
-
-                        if (i == 16) {
-                            logger->warning("Texture unit full - draw Indoor faces!");
-                            texunit = 0;
-                            texlayer = 0;
-                        } else {
-                            if (bsptexturewidths[i] == 0) {
-                                bsptexturewidths[i] = width;
-                                bsptextureheights[i] = height;
-                            }
-
-                            texunit = i;
-                            texlayer = bsptexloaded[i];
-
-                            // encode unit and layer together
-                            int encode = (texunit << 8) | texlayer;
-
-                            if (bsptexloaded[i] < 256) {
-                                // intsert into tex map
-                                bsptexmap.insert(std::make_pair(*texname, encode));
-                                bsptexloaded[i]++;
-                            } else {
-                                logger->warning("Texture layer full - draw indoor faces!");
-                                texunit = 0;
-                                texlayer = 0;
-                            }
-                        }
-                    }
+                    OpenGLTextureArrayPool::Slot slot = findOrInsertTexture(&_bspTextures, *texname);
+                    texunit = slot.array;
+                    texlayer = slot.layer;
 
                     if (face->IsTextureFrameTable()) {
                         // TODO(pskelton): any instances where animTime is not consistent would need checking
@@ -4006,95 +3829,82 @@ void OpenGLRenderer::DrawIndoorFaces() {
                 face->texlayer = texlayer;
             }
 
-            for (int l = 0; l < 16; l++) {
-                glGenVertexArrays(1, &bspVAO[l]);
-                glGenBuffers(1, &bspVBO[l]);
-
-                glBindVertexArray(bspVAO[l]);
-                glBindBuffer(GL_ARRAY_BUFFER, bspVBO[l]);
-
-                glBufferData(GL_ARRAY_BUFFER, sizeof(GLshaderverts) * 20000, NULL, GL_DYNAMIC_DRAW);
-
-                // position attribute
-                glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, x));
-                glEnableVertexAttribArray(0);
-                // tex uv attribute
-                glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, u));
-                glEnableVertexAttribArray(1);
-                // tex unit attribute
-                // tex array layer attribute
-                glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, texunit));
-                glEnableVertexAttribArray(2);
-                // normals
-                glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, normx));
-                glEnableVertexAttribArray(3);
-                // attribs
-                glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, attribs));
-                glEnableVertexAttribArray(4);
-                //sector
-                glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void*)offsetof(GLshaderverts, sector));
-                glEnableVertexAttribArray(5);
-            }
+            // lay out all faces in the static vertex buffer, shader state is filled in when the face is first drawn
+            bspFaceRanges.assign(pIndoor->pFaces.size(), BSPFaceRange());
+            GLint first = 0;
+            for (int faceId = 0; faceId < pIndoor->pFaces.size(); faceId++) {
+                const BLVFace &face = pIndoor->pFaces[faceId];
+                if (face.isPortal() || face.uNumVertices < 3)
+                    continue;
 
-            // texture set up
-
-            // loop over all units
-            for (int unit = 0; unit < 16; unit++) {
-                assert(bsptexloaded[unit] <= 256);
-                // skip if textures are empty
-                if (bsptexloaded[unit] == 0) continue;
-
-                glGenTextures(1, &bsptextures[unit]);
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D_ARRAY, bsptextures[unit]);
-                glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, bsptexturewidths[unit], bsptextureheights[unit], bsptexloaded[unit], 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-
-                std::map<std::string, int>::iterator it = bsptexmap.begin();
-                while (it != bsptexmap.end()) {
-                    int comb = it->second;
-                    int tlayer = comb & 0xFF;
-                    int tunit = (comb & 0xFF00) >> 8;
-
-                    if (tunit == unit) {
-                        // get texture
-                        auto texture = assets->getBitmap(it->first);
-
-                        glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
-                            0,
-                            0, 0, tlayer,
-                            bsptexturewidths[unit], bsptextureheights[unit], 1,
-                            GL_RGBA,
-                            GL_UNSIGNED_BYTE,
-                            texture->rgba().pixels().data());
-
-                        //numterraintexloaded[0]++;
-                    }
+                BSPFaceRange &range = bspFaceRanges[faceId];
+                range.first = first;
+                range.count = 3 * (face.uNumVertices - 2);
+                first += range.count;
+            }
 
-                    it++;
-                }
+            // Door faces start out unfilled & are rewritten when their door moves, see below.
+            bspDoorVersions.clear();
+            for (const BLVDoor &door : pIndoor->pDoors)
+                bspDoorVersions.push_back(door.uGeometryVersion);
+            for (int faceId = 0; faceId < pIndoor->pFaces.size(); faceId++)
+                if (pIndoor->pFaces[faceId].Indoor_sky())
+                    bspFaceRanges[faceId].dynamic = true;
 
+            glGenVertexArrays(1, &bspVAO);
+            glGenBuffers(1, &bspVBO);
 
+            openGLState.bindVertexArray(bspVAO);
+            glBindBuffer(GL_ARRAY_BUFFER, bspVBO);
 
+            glBufferData(GL_ARRAY_BUFFER, sizeof(GLshaderverts) * std::max(first, 1), NULL, GL_DYNAMIC_DRAW);
 
-                glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
-                glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            // position attribute
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, x));
+            glEnableVertexAttribArray(0);
+            // tex uv attribute
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, u));
+            glEnableVertexAttribArray(1);
+            // tex array & layer attribute
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, texunit));
+            glEnableVertexAttribArray(2);
+            // normals
+            glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, normx));
+            glEnableVertexAttribArray(3);
+            // attribs
+            glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void *)offsetof(GLshaderverts, attribs));
+            glEnableVertexAttribArray(4);
+            //sector
+            glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(GLshaderverts), (void*)offsetof(GLshaderverts, sector));
+            glEnableVertexAttribArray(5);
 
-                glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
-            }
+            openGLState.bindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
         }
 
 
-            // update verts - blank store
+            // blank draw ranges, geometry is already on the gpu
+            for (std::vector<std::pair<GLint, GLsizei>> &ranges : bspDrawRanges)
+                ranges.clear();
+            bspFrame++;
+
+            // only faces of the doors that have moved since the last frame need their vertices rewritten. Checking all
+            // doors & not just `activeDoorIds` as a door might have stopped & left the list since the last draw.
+            for (int doorIndex = 0; doorIndex < pIndoor->pDoors.size(); doorIndex++) {
+                const BLVDoor &door = pIndoor->pDoors[doorIndex];
+                if (bspDoorVersions[doorIndex] == door.uGeometryVersion)
+                    continue;
 
-            for (int i = 0; i < 16; i++) {
-                numBSPverts[i] = 0;
+                bspDoorVersions[doorIndex] = door.uGeometryVersion;
+                for (int j = 0; j < door.uNumFaces; ++j)
+                    bspFaceRanges[door.pFaceIDs[j]].stale = true;
             }
 
+            glBindBuffer(GL_ARRAY_BUFFER, bspVBO);
+
             bool drawnsky = false;
 
-            for (unsigned i = 0; i < pBspRenderer->num_faces; ++i) {
+            for (unsigned i = 0; i < pBspRenderer->faces.size(); ++i) {
                 int uFaceID = pBspRenderer->faces[i].uFaceID;
                 if (uFaceID >= pIndoor->pFaces.size())
                     continue;
@@ -4160,25 +3970,9 @@ void OpenGLRenderer::DrawIndoorFaces() {
                         // check face is towards camera
                         if (pCamera3D->is_face_faced_to_cameraBLV(face)) {
                             ++pBLVRenderParams->uNumFacesRenderedThisFrame;
-                            // load up verts here
                             int texlayer = 0;
                             int texunit = 0;
-                            int attribflags = 0;
-
-                            if (face->uAttributes & FACE_IsFluid) attribflags |= 2;
-
-                            if (face->uAttributes & FACE_FlowDown)
-                                attribflags |= 0x400;
-                            else if (face->uAttributes & FACE_FlowUp)
-                                attribflags |= 0x800;
-
-                            if (face->uAttributes & FACE_FlowRight)
-                                attribflags |= 0x2000;
-                            else if (face->uAttributes & FACE_FlowLeft)
-                                attribflags |= 0x1000;
-
-                            if (face->uAttributes & FACE_OUTLINED || (face->uAttributes & FACE_IsSecret) && engine->is_saturate_faces)
-                                attribflags |= 0x00010000;
+                            int attribflags = bspFaceAttribs(face);
 
                             if (face->IsTextureFrameTable()) {
                                 texlayer = -1;
@@ -4188,111 +3982,74 @@ void OpenGLRenderer::DrawIndoorFaces() {
                                 texunit = face->texunit;
                             }
 
-                            if (texlayer == -1) { // texture has been reset - see if its in the map
-                                GraphicsImage *tex = face->GetTexture();
-                                std::string *texname = tex->GetName();
-                                auto mapiter = bsptexmap.find(*texname);
-                                if (mapiter != bsptexmap.end()) {
-                                    // if so, extract unit and layer
-                                    int unitlayer = mapiter->second;
-                                    face->texlayer = texlayer = unitlayer & 0xFF;
-                                    face->texunit = texunit = (unitlayer & 0xFF00) >> 8;
-                                } else {
-                                    logger->warning("Texture not found in map!");
-                                    // TODO(pskelton): set to water for now - fountains in walls of mist
-                                    texlayer = face->texlayer = 0;
-                                    texunit = face->texunit = 0;
-                                }
+                            if (texlayer == -1) { // texture has been reset - see if its in the pool
+                                OpenGLTextureArrayPool::Slot slot = findOrInsertTexture(&_bspTextures, *face->GetTexture()->GetName());
+                                face->texunit = texunit = slot.array;
+                                face->texlayer = texlayer = slot.layer;
                             }
 
-
-                            for (int z = 0; z < (face->uNumVertices - 2); z++) {
-                                // 123, 134, 145, 156..
-                                GLshaderverts *thisvert = &BSPshaderstore[texunit][numBSPverts[texunit]];
-
-                                // copy first
-                                thisvert->x = pIndoor->pVertices[face->pVertexIDs[0]].x;
-                                thisvert->y = pIndoor->pVertices[face->pVertexIDs[0]].y;
-                                thisvert->z = pIndoor->pVertices[face->pVertexIDs[0]].z;
-                                thisvert->u = face->pVertexUIDs[0] + pIndoor->pFaceExtras[face->uFaceExtraID].sTextureDeltaU  /*+ face->sTextureDeltaU*/;
-                                thisvert->v = face->pVertexVIDs[0] + pIndoor->pFaceExtras[face->uFaceExtraID].sTextureDeltaV  /*+ face->sTextureDeltaV*/;
-                                if (face->Indoor_sky()) {
-                                    thisvert->u = (skymodtimex + thisvert->u) * 0.25f;
-                                    thisvert->v = (skymodtimey + thisvert->v) * 0.25f;
-                                }
-                                thisvert->texunit = texunit;
-                                thisvert->texturelayer = texlayer;
-                                thisvert->normx = face->facePlane.normal.x;
-                                thisvert->normy = face->facePlane.normal.y;
-                                thisvert->normz = face->facePlane.normal.z;
-                                thisvert->attribs = attribflags;
-                                thisvert->sector = face->uSectorID;
-                                thisvert++;
-
-                                // copy other two (z+1)(z+2)
-                                for (unsigned i = 1; i < 3; ++i) {
-                                    thisvert->x = pIndoor->pVertices[face->pVertexIDs[z + i]].x;
-                                    thisvert->y = pIndoor->pVertices[face->pVertexIDs[z + i]].y;
-                                    thisvert->z = pIndoor->pVertices[face->pVertexIDs[z + i]].z;
-                                    thisvert->u = face->pVertexUIDs[z + i] + pIndoor->pFaceExtras[face->uFaceExtraID].sTextureDeltaU  /*+ face->sTextureDeltaU*/;
-                                    thisvert->v = face->pVertexVIDs[z + i] + pIndoor->pFaceExtras[face->uFaceExtraID].sTextureDeltaV  /*+ face->sTextureDeltaV*/;
-                                    if (face->Indoor_sky()) {
-                                        thisvert->u = (skymodtimex + thisvert->u) * 0.25f;
-                                        thisvert->v = (skymodtimey + thisvert->v) * 0.25f;
-                                    }
-                                    thisvert->texunit = texunit;
-                                    thisvert->texturelayer = texlayer;
-                                    thisvert->normx = face->facePlane.normal.x;
-                                    thisvert->normy = face->facePlane.normal.y;
-                                    thisvert->normz = face->facePlane.normal.z;
-                                    thisvert->attribs = attribflags;
-                                    thisvert->sector = face->uSectorID;
-                                    thisvert++;
-                                }
-
-                                numBSPverts[texunit] += 3;
-                                assert(numBSPverts[texunit] <= 19999);
+                            // only rewrite the face vertices if anything has changed
+                            BSPFaceRange &range = bspFaceRanges[uFaceID];
+                            if (range.dynamic || range.stale || range.texunit != texunit || range.texlayer != texlayer || range.attribs != attribflags) {
+                                static std::vector<GLshaderverts> faceverts; // Reused across calls, only grows.
+                                if (faceverts.size() < static_cast<size_t>(range.count))
+                                    faceverts.resize(range.count);
+                                fillBSPFaceVerts(face, texunit, texlayer, attribflags, skymodtimex, skymodtimey, faceverts.data());
+                                glBufferSubData(GL_ARRAY_BUFFER, sizeof(GLshaderverts) * range.first, sizeof(GLshaderverts) * range.count, faceverts.data());
+
+                                range.texunit = texunit;
+                                range.texlayer = texlayer;
+                                range.attribs = attribflags;
+                                range.stale = false;
                             }
+
+                            // faces can be seen through several portals, draw them only once
+                            if (range.drawnFrame == bspFrame)
+                                continue;
+                            range.drawnFrame = bspFrame;
+
+                            if (texunit >= bspDrawRanges.size())
+                                bspDrawRanges.resize(texunit + 1);
+                            bspDrawRanges[texunit].emplace_back(range.first, range.count);
                         }
                     }
                 }
             }
 
-            for (int l = 0; l < 16; l++) {
-                if (numBSPverts[l]) {
-                    glBindBuffer(GL_ARRAY_BUFFER, bspVBO[l]);
-                    // orphan buffer
-                    glBufferData(GL_ARRAY_BUFFER, sizeof(GLshaderverts) * 20000, NULL, GL_DYNAMIC_DRAW);
-                    // update buffer
-                    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(GLshaderverts) * numBSPverts[l], BSPshaderstore[l]);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+            // upload any textures that were added this frame
+            _bspTextures.commit(loadPoolTexture, &_textureArrayUploader);
+
+            // merge ranges that are adjacent in the vertex buffer
+            std::vector<std::vector<GLint>> bspfirsts(bspDrawRanges.size());
+            std::vector<std::vector<GLsizei>> bspcounts(bspDrawRanges.size());
+            for (size_t l = 0; l < bspDrawRanges.size(); l++) {
+                std::sort(bspDrawRanges[l].begin(), bspDrawRanges[l].end());
+                for (const auto &[first, count] : bspDrawRanges[l]) {
+                    if (!bspfirsts[l].empty() && bspfirsts[l].back() + bspcounts[l].back() == first) {
+                        bspcounts[l].back() += count;
+                    } else {
+                        bspfirsts[l].push_back(first);
+                        bspcounts[l].push_back(count);
+                    }
                 }
             }
 
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
-
         // terrain debug
         if (engine->config->debug.Terrain.value())
             // TODO: OpenGL ES doesn't provide wireframe functionality so enable it only for classic OpenGL for now
             if (!OpenGLES)
                 glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-        ////
-        for (int unit = 0; unit < 16; unit++) {
-            // skip if textures are empty
-            //if (bsptexloaded[unit] > 0) {
-                glActiveTexture(GL_TEXTURE0 + unit);
-                glBindTexture(GL_TEXTURE_2D_ARRAY, bsptextures[unit]);
-            //}
-        }
-
-        //glBindVertexArray(bspVAO);
+        //openGLState.bindVertexArray(bspVAO);
         //glEnableVertexAttribArray(0);
         //glEnableVertexAttribArray(1);
         //glEnableVertexAttribArray(2);
         //glEnableVertexAttribArray(3);
         //glEnableVertexAttribArray(4);
 
-        glUseProgram(bspshader.ID);
+        openGLState.useProgram(bspshader.ID);
 
         //// set projection
         glUniformMatrix4fv(glGetUniformLocation(bspshader.ID, "projection"), 1, GL_FALSE, &projmat[0][0]);
@@ -4306,14 +4063,9 @@ void OpenGLRenderer::DrawIndoorFaces() {
 
         // set texture unit location
         glUniform1i(glGetUniformLocation(bspshader.ID, "textureArray0"), GLint(0));
-        glUniform1i(glGetUniformLocation(bspshader.ID, "textureArray1"), GLint(1));
-        glUniform1i(glGetUniformLocation(bspshader.ID, "textureArray2"), GLint(2));
 
 
-        GLfloat camera[3] {};
-        camera[0] = (float)(pParty->pos.x - pParty->_yawGranularity * cosf(2 * pi_double * pParty->_viewYaw / 2048.0f));
-        camera[1] = (float)(pParty->pos.y - pParty->_yawGranularity * sinf(2 * pi_double * pParty->_viewYaw / 2048.0f));
-        camera[2] = (float)(pParty->pos.z + pParty->eyeLevel);
+        GLfloat camera[3] {pCamera3D->vCameraPos.x, pCamera3D->vCameraPos.y, pCamera3D->vCameraPos.z};
         glUniform3fv(glGetUniformLocation(bspshader.ID, "CameraPos"), 1, &camera[0]);
 
 
@@ -4343,146 +4095,37 @@ void OpenGLRenderer::DrawIndoorFaces() {
         glUniform3f(glGetUniformLocation(bspshader.ID, "sun.diffuse"), diffuseon * (ambient + 0.3f), diffuseon * (ambient + 0.3f), diffuseon * (ambient + 0.3f));
         glUniform3f(glGetUniformLocation(bspshader.ID, "sun.specular"), diffuseon * 1.0f, diffuseon * 0.8f, 0.0f);
 
-        // point lights - fspointlights
-        // rest of lights stacking
-        GLuint num_lights = 0;   // 1;
-
-        // get party torchlight as priority
-        for (int i = 0; i < 1; ++i) {
-            if (pMobileLightsStack->uNumLightsActive < 1) continue;
-
-            MobileLight &test = pMobileLightsStack->pLights[i];
-            std::string slotnum = std::to_string(num_lights);
-
-            float x = pMobileLightsStack->pLights[i].vPosition.x;
-            float y = pMobileLightsStack->pLights[i].vPosition.y;
-            float z = pMobileLightsStack->pLights[i].vPosition.z;
-
-            Colorf color = pMobileLightsStack->pLights[i].uLightColor.toColorf();
-
-            glUniform1f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 2.0f);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].position").c_str()), x, y, z);
-            glUniform1f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].sector").c_str()), 0);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].ambient").c_str()), color.r, color.g, color.b);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].diffuse").c_str()), color.r, color.g, color.b);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].specular").c_str()), 0, 0, 0);
-            glUniform1f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].radius").c_str()), test.uRadius);
-            num_lights++;
-        }
+        // point lights
+        bindLightClusters(bspshader.ID);
 
-        // stack the static lights next (wall torches)
-        for (int i = 0; i < pStationaryLightsStack->uNumLightsActive; ++i) {
-            if (num_lights >= 40) break;
+        openGLState.activeTexture(GL_TEXTURE0);
+        openGLState.bindVertexArray(bspVAO);
 
-            StationaryLight &test = pStationaryLightsStack->pLights[i];
-
-            // is this on the sector list
-            bool onlist = false;
-            for (unsigned i = 0; i < pBspRenderer->uNumVisibleNotEmptySectors; ++i) {
-                int listsector = pBspRenderer->pVisibleSectorIDs_toDrawDecorsActorsEtcFrom[i];
-                if (test.uSectorID == listsector) {
-                    onlist = true;
-                    break;
-                }
-            }
-
-            // does light sphere collide with current sector
-            // expanded current sector
-            bool fromexpanded{ false };
-            if (pIndoor->pSectors[pBLVRenderParams->uPartySectorID].pBounding.intersectsCube(test.vPosition, test.uRadius)) {
-                onlist = true;
-                fromexpanded = true;
-            }
+        for (int unit = 0; unit < bspfirsts.size(); unit++) {
+            // skip if there's nothing to draw
+            if (bspfirsts[unit].empty())
+                continue;
 
-            if (!onlist) continue;
+            // toggle for water faces or not - water tiles are only in the first array
+            glUniform1i(glGetUniformLocation(bspshader.ID, "watertiles"), GLint(unit == 0));
+            glUniform2i(glGetUniformLocation(bspshader.ID, "textureArraySize"),
+                        _bspTextures.width(unit), _bspTextures.height(unit));
 
-            // cull through viewing frustum
-            bool visinfrustum{ false };
-            if (!fromexpanded) {
-                for (int i = 0; i < pBspRenderer->num_nodes; ++i) {
-                    if (pBspRenderer->nodes[i].uSectorID == test.uSectorID) {
-                        if (IsSphereInFrustum(test.vPosition, test.uRadius, pBspRenderer->nodes[i].ViewportNodeFrustum.data()))
-                            visinfrustum = true;
-                    }
-                }
+            // draw each set of triangles
+            openGLState.bindTexture(GL_TEXTURE_2D_ARRAY, _bspTextures.texture(unit));
+            if (!OpenGLES) {
+                glMultiDrawArrays(GL_TRIANGLES, bspfirsts[unit].data(), bspcounts[unit].data(), bspfirsts[unit].size());
+                drawcalls++;
             } else {
-                if (IsSphereInFrustum(test.vPosition, test.uRadius)) visinfrustum = true;
-            }
-            if (!visinfrustum) continue;
-
-            std::string slotnum = std::to_string(num_lights);
-
-            float x = test.vPosition.x;
-            float y = test.vPosition.y;
-            float z = test.vPosition.z;
-
-            Colorf color = test.uLightColor.toColorf();
-
-            glUniform1f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 1.0f);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].position").c_str()), x, y, z);
-            glUniform1f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].sector").c_str()), test.uSectorID);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].ambient").c_str()), color.r, color.g, color.b);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].diffuse").c_str()), color.r, color.g, color.b);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].specular").c_str()), 0, 0, 0);
-            glUniform1f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].radius").c_str()), test.uRadius);
-            num_lights++;
-        }
-
-        // whatevers left for mobile lights
-        for (int i = 1; i < pMobileLightsStack->uNumLightsActive; ++i) {
-            if (num_lights >= 40) break;
-
-            // TODO(pskelton): nearest lights should be prioritsed
-            MobileLight &test = pMobileLightsStack->pLights[i];
-            if (!IsSphereInFrustum(test.vPosition, test.uRadius)) continue;
-
-            std::string slotnum = std::to_string(num_lights);
-
-            float x = pMobileLightsStack->pLights[i].vPosition.x;
-            float y = pMobileLightsStack->pLights[i].vPosition.y;
-            float z = pMobileLightsStack->pLights[i].vPosition.z;
-
-            Colorf color = pMobileLightsStack->pLights[i].uLightColor.toColorf();
-
-            glUniform1f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 2.0f);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].position").c_str()), x, y, z);
-            glUniform1f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].sector").c_str()), 0);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].ambient").c_str()), color.r, color.g, color.b);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].diffuse").c_str()), color.r, color.g, color.b);
-            glUniform3f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].specular").c_str()), 0, 0, 0);
-            glUniform1f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].radius").c_str()), test.uRadius);
-            num_lights++;
-        }
-
-        // blank any lights not used
-        for (int blank = num_lights; blank < 40; blank++) {
-            std::string slotnum = std::to_string(blank);
-            glUniform1f(glGetUniformLocation(bspshader.ID, ("fspointlights[" + slotnum + "].type").c_str()), 0.0);
-        }
-
-
-
-        // toggle for water faces or not
-        glUniform1i(glGetUniformLocation(bspshader.ID, "watertiles"), GLint(1));
-
-        glActiveTexture(GL_TEXTURE0);
-
-        for (int unit = 0; unit < 16; unit++) {
-            // skip if textures are empty
-            //if (numoutbuildtexloaded[unit] > 0) {
-            if (unit == 1) {
-                glUniform1i(glGetUniformLocation(bspshader.ID, "watertiles"), GLint(0));
+                // OpenGL ES doesn't have glMultiDrawArrays
+                for (size_t i = 0; i < bspfirsts[unit].size(); i++) {
+                    glDrawArrays(GL_TRIANGLES, bspfirsts[unit][i], bspcounts[unit][i]);
+                    drawcalls++;
+                }
             }
-
-            // draw each set of triangles
-            glBindTexture(GL_TEXTURE_2D_ARRAY, bsptextures[unit]);
-            glBindVertexArray(bspVAO[unit]);
-            glDrawArrays(GL_TRIANGLES, 0, (numBSPverts[unit]));
-            drawcalls++;
-            //}
         }
 
-        glUseProgram(0);
+        openGLState.useProgram(0);
 
         glDisableVertexAttribArray(0);
         glDisableVertexAttribArray(1);
@@ -4492,12 +4135,12 @@ void OpenGLRenderer::DrawIndoorFaces() {
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-        glBindVertexArray(0);
+        openGLState.bindVertexArray(0);
 
 
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        openGLState.activeTexture(GL_TEXTURE0);
+        openGLState.bindTexture(GL_TEXTURE_2D, 0);
 
         // indoor sky drawing
         if (forceperstorecnt) {
@@ -4520,57 +4163,8 @@ void OpenGLRenderer::DrawIndoorFaces() {
             if (!OpenGLES)
                 glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-        // stack decals start
-
-        if (!decal_builder->bloodsplat_container->uNumBloodsplats) return;
-        static RenderVertexSoft static_vertices_buff_in[64];  // buff in
-
-        // loop over faces
-        for (int test = 0; test < pIndoor->pFaces.size(); test++) {
-            BLVFace *pface = &pIndoor->pFaces[test];
-
-            if (pface->isPortal()) continue;
-            if (!pface->GetTexture()) continue;
-
-            // check if faces is visible
-            bool onlist = false;
-            for (unsigned i = 0; i < pBspRenderer->uNumVisibleNotEmptySectors; ++i) {
-                int listsector = pBspRenderer->pVisibleSectorIDs_toDrawDecorsActorsEtcFrom[i];
-                if (pface->uSectorID == listsector) {
-                    onlist = true;
-                    break;
-                }
-            }
-            if (!onlist) continue;
-
-
-            decal_builder->ApplyBloodsplatDecals_IndoorFace(test);
-            if (!decal_builder->uNumSplatsThisFace) continue;
-
-            // copy to buff in
-            for (unsigned i = 0; i < pface->uNumVertices; ++i) {
-                static_vertices_buff_in[i].vWorldPosition.x =
-                    pIndoor->pVertices[pface->pVertexIDs[i]].x;
-                static_vertices_buff_in[i].vWorldPosition.y =
-                    pIndoor->pVertices[pface->pVertexIDs[i]].y;
-                static_vertices_buff_in[i].vWorldPosition.z =
-                    pIndoor->pVertices[pface->pVertexIDs[i]].z;
-                static_vertices_buff_in[i].u = (signed short)pface->pVertexUIDs[i];
-                static_vertices_buff_in[i].v = (signed short)pface->pVertexVIDs[i];
-            }
-
-            // blood draw
-            decal_builder->BuildAndApplyDecals(uCurrentAmbientLightLevel, LocationIndoors, pface->facePlane,
-                pface->uNumVertices, static_vertices_buff_in,
-                0, pface->uSectorID);
-        }
-
-
-
-        ///////////////////////////////////////////////////////
-        // stack decals end
-
-        return;
+        // stack decals
+        StackIndoorDecals();
 }
 
 bool OpenGLRenderer::SwitchToWindow() {
@@ -4634,12 +4228,60 @@ bool OpenGLRenderer::Initialize() {
 
         gladSetGLPostCallback(GL_Check_Errors);
 
+        openGLState.invalidate();
+        _streamBuffer.release();
+        _streamBuffer.initialize(openGLContext, OpenGLES, STREAM_BUFFER_SEGMENT_SIZE);
+        _textureStagingBuffer.release();
+        _textureStagingBuffer.initialize(openGLContext, OpenGLES, TEXTURE_STAGING_SEGMENT_SIZE);
+        _textureArrayUploader.initialize(OpenGLES, config->graphics.CompressTextures.value(),
+                                         makeDataPath("texture_compression_cache.bin"));
+        _passTimers.release();
+        _passTimers.initialize(OpenGLES);
+        _outbuildOcclusion.release();
+        _outbuildOcclusion.initialize(OpenGLES);
+        _memoryInfo.initialize(OpenGLES);
+        _videoMemoryInfo = VideoMemoryInfo();
+        if (_memoryInfo.isSupported()) {
+            logger->info("OpenGL: video memory queries are supported, {} MiB available",
+                         _memoryInfo.availableSize() >> 20);
+        }
+
         return Reinitialize(true);
     }
 
     return false;
 }
 
+void OpenGLRenderer::DrawSnow(int flakeCount, uint32_t seed, float time, float windOffset) {
+    if (flakeCount <= 0)
+        return;
+
+    // Snow goes on top of everything that was drawn in 2D before it.
+    DrawTwodVerts();
+
+    OpenGLPassTimerScope passTimer(&_passTimers, RENDER_PASS_WEATHER);
+
+    if (weatherVAO == 0)
+        glGenVertexArrays(1, &weatherVAO);
+
+    openGLState.useProgram(weathershader.ID);
+    glUniformMatrix4fv(glGetUniformLocation(weathershader.ID, "projection"), 1, GL_FALSE, &projmat[0][0]);
+    glUniformMatrix4fv(glGetUniformLocation(weathershader.ID, "view"), 1, GL_FALSE, &viewmat[0][0]);
+    glUniform4f(glGetUniformLocation(weathershader.ID, "viewport"),
+                pViewport->uViewportTL_X, pViewport->uViewportTL_Y, pViewport->uViewportBR_X, pViewport->uViewportBR_Y);
+    glUniform1ui(glGetUniformLocation(weathershader.ID, "seed"), seed);
+    glUniform1f(glGetUniformLocation(weathershader.ID, "time"), time);
+    glUniform1f(glGetUniformLocation(weathershader.ID, "windOffset"), windOffset);
+
+    // Six vertices per flake, two triangles each.
+    openGLState.bindVertexArray(weatherVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6 * flakeCount);
+    drawcalls++;
+
+    openGLState.bindVertexArray(0);
+    openGLState.useProgram(0);
+}
+
 void OpenGLRenderer::FillRectFast(unsigned int uX, unsigned int uY, unsigned int uWidth,
                                   unsigned int uHeight, Color uColor32) {
     Colorf cf = uColor32.toColorf();
@@ -4740,31 +4382,34 @@ void OpenGLRenderer::FillRectFast(unsigned int uX, unsigned int uY, unsigned int
 bool OpenGLRenderer::InitShaders() {
     logger->info("initialising OpenGL shaders...");
 
+    if (config->graphics.ShaderCache.value())
+        _shaderCache.initialize(makeDataPath("shader_cache"));
+
     std::string title = "CRITICAL ERROR: shader compilation failure";
     std::string name = "Terrain";
     std::string message = "shader failed to compile!\nPlease consult the log and consider issuing a bug report!";
-    terrainshader.build(name, "glterrain", OpenGLES);
+    terrainshader.build(name, "glterrain", OpenGLES, &_shaderCache);
     if (terrainshader.ID == 0) {
         platform->showMessageBox(title, fmt::format("{} {}", name, message));
         return false;
     }
 
     name = "Outdoor buildings";
-    outbuildshader.build(name, "gloutbuild", OpenGLES);
+    outbuildshader.build(name, "gloutbuild", OpenGLES, &_shaderCache);
     if (outbuildshader.ID == 0) {
         platform->showMessageBox(title, fmt::format("{} {}", name, message));
         return false;
     }
 
     name = "Indoor BSP";
-    bspshader.build(name, "glbspshader", OpenGLES);
+    bspshader.build(name, "glbspshader", OpenGLES, &_shaderCache);
     if (bspshader.ID == 0) {
         platform->showMessageBox(title, fmt::format("{} {}", name, message));
         return false;
     }
 
     name = "Text";
-    textshader.build(name, "gltextshader", OpenGLES);
+    textshader.build(name, "gltextshader", OpenGLES, &_shaderCache);
     if (textshader.ID == 0) {
         platform->showMessageBox(title, fmt::format("{} {}", name, message));
         return false;
@@ -4772,7 +4417,7 @@ bool OpenGLRenderer::InitShaders() {
     textVAO = 0;
 
     name = "Lines";
-    lineshader.build(name, "gllinesshader", OpenGLES);
+    lineshader.build(name, "gllinesshader", OpenGLES, &_shaderCache);
     if (lineshader.ID == 0) {
         platform->showMessageBox(title, fmt::format("{} {}", name, message));
         return false;
@@ -4780,7 +4425,7 @@ bool OpenGLRenderer::InitShaders() {
     lineVAO = 0;
 
     name = "2D";
-    twodshader.build(name, "gltwodshader", OpenGLES);
+    twodshader.build(name, "gltwodshader", OpenGLES, &_shaderCache);
     if (twodshader.ID == 0) {
         platform->showMessageBox(title, fmt::format("{} {}", name, message));
         return false;
@@ -4788,7 +4433,7 @@ bool OpenGLRenderer::InitShaders() {
     twodVAO = 0;
 
     name = "Billboards";
-    billbshader.build(name, "glbillbshader", OpenGLES);
+    billbshader.build(name, "glbillbshader", OpenGLES, &_shaderCache);
     if (billbshader.ID == 0) {
         platform->showMessageBox(title, fmt::format("{} {}", name, message));
         return false;
@@ -4797,21 +4442,36 @@ bool OpenGLRenderer::InitShaders() {
     palbuf = 0;
 
     name = "Decals";
-    decalshader.build(name, "gldecalshader", OpenGLES);
+    decalshader.build(name, "gldecalshader", OpenGLES, &_shaderCache);
     if (decalshader.ID == 0) {
         platform->showMessageBox(title, fmt::format("{} {}", name, message));
         return false;
     }
-    decalVAO = 0;
 
     name = "Forced perspective";
-    forcepershader.build(name, "glforcepershader", OpenGLES);
+    forcepershader.build(name, "glforcepershader", OpenGLES, &_shaderCache);
     if (forcepershader.ID == 0) {
         platform->showMessageBox(title, fmt::format("{} {}", name, message));
         return false;
     }
     forceperVAO = 0;
 
+    name = "Weather";
+    weathershader.build(name, "glweathershader", OpenGLES, &_shaderCache);
+    if (weathershader.ID == 0) {
+        platform->showMessageBox(title, fmt::format("{} {}", name, message));
+        return false;
+    }
+    weatherVAO = 0;
+
+    name = "Upscale";
+    upscaleshader.build(name, "glupscaleshader", OpenGLES, &_shaderCache);
+    if (upscaleshader.ID == 0) {
+        platform->showMessageBox(title, fmt::format("{} {}", name, message));
+        return false;
+    }
+    upscaleVAO = 0;
+
     logger->info("shaders have been compiled successfully!");
     return true;
 }
@@ -4848,8 +4508,8 @@ bool OpenGLRenderer::Reinitialize(bool firstInit) {
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);       // Black Background
     glClearDepthf(1.0f);
 
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LEQUAL);
+    openGLState.enable(GL_DEPTH_TEST);
+    openGLState.depthFunc(GL_LEQUAL);
 
     if (firstInit) {
         // clear only on first init as it will introduce brief black artifacts on window resize
@@ -4857,30 +4517,30 @@ bool OpenGLRenderer::Reinitialize(bool firstInit) {
     }
 
     glDeleteFramebuffers(1, &framebuffer);
-    glDeleteTextures(2, framebufferTextures);
+    openGLState.deleteTextures(2, framebufferTextures);
 
     glGenFramebuffers(1, &framebuffer);
     glGenTextures(2, framebufferTextures);
 
-    glBindTexture(GL_TEXTURE_2D, framebufferTextures[0]);
+    openGLState.bindTexture(GL_TEXTURE_2D, framebufferTextures[0]);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, outputRender.w, outputRender.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
 
-    glBindTexture(GL_TEXTURE_2D, framebufferTextures[1]);
+    openGLState.bindTexture(GL_TEXTURE_2D, framebufferTextures[1]);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, outputRender.w, outputRender.h, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
 
-    glViewport(0, 0, outputRender.w, outputRender.h);
-    glScissor(0, 0, outputRender.w, outputRender.h);
-    glEnable(GL_SCISSOR_TEST);
+    openGLState.viewport(0, 0, outputRender.w, outputRender.h);
+    openGLState.scissor(0, 0, outputRender.w, outputRender.h);
+    openGLState.enable(GL_SCISSOR_TEST);
 
     // Swap Buffers (Double Buffering)
     openGLContext->swapBuffers();
@@ -4926,11 +4586,239 @@ bool OpenGLRenderer::Reinitialize(bool firstInit) {
     return BaseRenderer::Reinitialize(firstInit);
 }
 
+IndexedArray<float, RENDER_PASS_FIRST, RENDER_PASS_LAST> OpenGLRenderer::GetPassTimings() {
+    return _passTimers.timings();
+}
+
+float OpenGLRenderer::GetFrameLatency() {
+    return _frameQueue.latencyMs();
+}
+
+int OpenGLRenderer::GetAvoidedStateChanges() {
+    return openGLState.avoidedCalls();
+}
+
+VideoMemoryInfo OpenGLRenderer::GetVideoMemoryInfo() {
+    return _videoMemoryInfo;
+}
+
+void OpenGLRenderer::updatePaletteBuffer() {
+    std::span<Color> palettes = pPaletteManager->paletteData();
+
+    if (palbuf == 0) {
+        // Buffer holds slots for all palettes, they are filled in as they get decoded.
+        glGenBuffers(1, &palbuf);
+        glBindBuffer(GL_TEXTURE_BUFFER, palbuf);
+        glBufferData(GL_TEXTURE_BUFFER, palettes.size_bytes(), palettes.data(), GL_DYNAMIC_DRAW);
+        pPaletteManager->takeDirtyRange();
+
+        glGenTextures(1, &paltex);
+        openGLState.bindTexture(GL_TEXTURE_BUFFER, paltex);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8UI, palbuf);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        return;
+    }
+
+    auto [begin, end] = pPaletteManager->takeDirtyRange();
+    if (begin == end)
+        return;
+
+    constexpr size_t paletteSize = sizeof(Palette) / sizeof(Color);
+    std::span<Color> dirty = palettes.subspan(begin * paletteSize, (end - begin) * paletteSize);
+    glBindBuffer(GL_TEXTURE_BUFFER, palbuf);
+    glBufferSubData(GL_TEXTURE_BUFFER, begin * paletteSize * sizeof(Color), dirty.size_bytes(), dirty.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void OpenGLRenderer::updateTextureResidency() {
+    _videoMemoryInfo.totalSize = _memoryInfo.totalSize();
+    _videoMemoryInfo.availableSize = _memoryInfo.availableSize();
+
+    bool lowMemory = false;
+    if (_videoMemoryInfo.availableSize >= 0) {
+        int64_t threshold = LOW_VIDEO_MEMORY_SIZE;
+        if (_videoMemoryInfo.totalSize > 0)
+            threshold = std::max(threshold, _videoMemoryInfo.totalSize / 10);
+        lowMemory = _videoMemoryInfo.availableSize < threshold;
+    }
+
+    int64_t budget = static_cast<int64_t>(config->graphics.VideoMemoryBudget.value()) * 1024 * 1024;
+    int64_t allocated = MemoryAccounting::stats(MEMORY_TAG_GPU_TEXTURES).size +
+                        MemoryAccounting::stats(MEMORY_TAG_GPU_BUFFERS).size;
+    if (budget > 0 && allocated > budget)
+        lowMemory = true;
+
+    if (!lowMemory || _videoMemoryInfo.textureMipBias >= MAX_TEXTURE_MIP_BIAS)
+        return;
+
+    // Outdoor building & indoor arrays are re-created on their next commit, terrain picks up the bias on next load.
+    _videoMemoryInfo.textureMipBias++;
+    _outbuildTextures.setMipBias(_videoMemoryInfo.textureMipBias);
+    _bspTextures.setMipBias(_videoMemoryInfo.textureMipBias);
+    logger->info("OpenGL: running low on video memory ({} MiB available, {} MiB allocated), world texture mip bias "
+                 "is now {}", _videoMemoryInfo.availableSize >> 20, allocated >> 20, _videoMemoryInfo.textureMipBias);
+}
+
+Recti OpenGLRenderer::gameViewportRect() const {
+    if (_sceneTargetBound)
+        return Recti(0, 0, _sceneSize.w, _sceneSize.h);
+    return Recti(game_viewport_x, outputRender.h - game_viewport_w - 1, game_viewport_width, game_viewport_height);
+}
+
+void OpenGLRenderer::bindSceneTarget() {
+    _sceneTargetBound = false; // Scene that was drawn but not resolved, if any, is discarded.
+
+    float scale = _dynamicResolution.scale();
+    if (!_dynamicResolution.isEnabled() || scale >= 1.0f || upscaleshader.ID == 0)
+        return;
+
+    Sizei viewportSize(game_viewport_width, game_viewport_height);
+    if (viewportSize.w <= 0 || viewportSize.h <= 0)
+        return;
+
+    if (_sceneTextureSize != viewportSize) {
+        if (_sceneFramebuffer == 0) {
+            glGenFramebuffers(1, &_sceneFramebuffer);
+            glGenTextures(2, _sceneTextures);
+        }
+
+        // Color texture is sampled with bilinear filtering when upscaling.
+        openGLState.bindTexture(GL_TEXTURE_2D, _sceneTextures[0]);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, viewportSize.w, viewportSize.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+        openGLState.bindTexture(GL_TEXTURE_2D, _sceneTextures[1]);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, viewportSize.w, viewportSize.h, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+        openGLState.bindTexture(GL_TEXTURE_2D, 0);
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _sceneFramebuffer);
+        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _sceneTextures[0], 0);
+        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, _sceneTextures[1], 0);
+        GL_Check_Framebuffer(__FUNCTION__);
+
+        _sceneTextureSize = viewportSize;
+    }
+
+    _sceneSize.w = std::max(1, static_cast<int>(std::round(viewportSize.w * scale)));
+    _sceneSize.h = std::max(1, static_cast<int>(std::round(viewportSize.h * scale)));
+    _sceneTargetBound = true;
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _sceneFramebuffer);
+    openGLState.viewport(0, 0, _sceneSize.w, _sceneSize.h);
+    openGLState.scissor(0, 0, _sceneSize.w, _sceneSize.h);
+}
+
+void OpenGLRenderer::resolveSceneTarget() {
+    if (!_sceneTargetBound)
+        return;
+
+    // Flush whatever was queued in 3D before switching targets.
+    DrawTwodVerts();
+    EndLines2D();
+    EndTextNew();
+
+    _sceneTargetBound = false;
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, outputRender != outputPresent ? framebuffer : 0);
+
+    Recti viewport = gameViewportRect();
+    openGLState.viewport(viewport.x, viewport.y, viewport.w, viewport.h);
+    openGLState.scissor(viewport.x, viewport.y, viewport.w, viewport.h);
+    openGLState.disable(GL_DEPTH_TEST);
+    openGLState.depthMask(GL_FALSE);
+    openGLState.disable(GL_BLEND);
+    openGLState.disable(GL_CULL_FACE);
+
+    if (upscaleVAO == 0)
+        glGenVertexArrays(1, &upscaleVAO);
+
+    float texelW = 1.0f / _sceneTextureSize.w;
+    float texelH = 1.0f / _sceneTextureSize.h;
+    openGLState.useProgram(upscaleshader.ID);
+    glUniform1i(glGetUniformLocation(upscaleshader.ID, "scene"), GLint(0));
+    glUniform2f(glGetUniformLocation(upscaleshader.ID, "uvScale"), _sceneSize.w * texelW, _sceneSize.h * texelH);
+    glUniform2f(glGetUniformLocation(upscaleshader.ID, "uvMax"), (_sceneSize.w - 0.5f) * texelW, (_sceneSize.h - 0.5f) * texelH);
+    glUniform2f(glGetUniformLocation(upscaleshader.ID, "texelSize"), texelW, texelH);
+    glUniform1f(glGetUniformLocation(upscaleshader.ID, "sharpness"), config->graphics.DynamicResolutionSharpness.value());
+    openGLState.activeTexture(GL_TEXTURE0);
+    openGLState.bindTexture(GL_TEXTURE_2D, _sceneTextures[0]);
+
+    openGLState.bindVertexArray(upscaleVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    drawcalls++;
+
+    openGLState.bindVertexArray(0);
+    openGLState.useProgram(0);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
+
+    openGLState.viewport(0, 0, outputRender.w, outputRender.h);
+    openGLState.scissor(clip_x, outputRender.h - clip_w, clip_z - clip_x, clip_w - clip_y);
+}
+
+void OpenGLRenderer::updateDynamicResolution() {
+    bool hasGpuTimings = _passTimers.isSupported();
+    _dynamicResolution.setTarget(config->graphics.DynamicResolutionFps.value(),
+                                 config->graphics.DynamicResolutionMinScale.value(), !hasGpuTimings);
+    if (!_dynamicResolution.isEnabled())
+        return;
+
+    float scalableMs = 0.0f;
+    float fixedMs = 0.0f;
+    if (hasGpuTimings) {
+        const OpenGLPassTimers::Timings &timings = _passTimers.timings();
+        for (RenderPass pass : timings.indices()) {
+            bool isUiPass = pass == RENDER_PASS_TEXT || pass == RENDER_PASS_TWOD || pass == RENDER_PASS_NUKLEAR ||
+                            pass == RENDER_PASS_WEATHER;
+            (isUiPass ? fixedMs : scalableMs) += timings[pass];
+        }
+    } else if (_lastPresentNs != 0) {
+        // No way to split CPU-side frame time, assume it all scales.
+        scalableMs = (nowNs() - _lastPresentNs) / 1'000'000.0f;
+    }
+
+    _dynamicResolution.update(scalableMs, fixedMs);
+}
+
+void OpenGLRenderer::updateQualityGovernor() {
+    QualityGovernor &governor = engine->qualityGovernor;
+
+    // Dropping settings changes what the game looks like, which would break screenshot comparisons in tests, and
+    // particle counts might leak into game state. So no adaptive quality when running deterministically.
+    if (::application->component<EngineDeterministicComponent>()->isActive()) {
+        governor.setTarget(0, 0);
+        governor.reset();
+        return;
+    }
+
+    governor.setTarget(config->graphics.AdaptiveQualityFps.value(), config->graphics.AdaptiveQualityMaxStep.value());
+    if (!governor.isEnabled() || _lastPresentNs == 0)
+        return;
+
+    // We can be bound by either the CPU or the GPU, so take whichever is slower. Note that the time spent in the
+    // frame limiter is not included here.
+    float frameMs = (nowNs() - _lastPresentNs) / 1'000'000.0f;
+    if (_passTimers.isSupported()) {
+        const OpenGLPassTimers::Timings &timings = _passTimers.timings();
+        float gpuMs = 0.0f;
+        for (RenderPass pass : timings.indices())
+            gpuMs += timings[pass];
+        frameMs = std::max(frameMs, gpuMs);
+    }
+
+    governor.update(frameMs);
+}
+
 void OpenGLRenderer::ReloadShaders() {
     logger->info("reloading Shaders...");
-    glUseProgram(0);
+    openGLState.useProgram(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    openGLState.bindVertexArray(0);
 
     std::string name = "Terrain";
     std::string message = "shader failed to reload!\nPlease consult the log and issue a bug report!";
@@ -4949,34 +4837,30 @@ void OpenGLRenderer::ReloadShaders() {
     name = "Text";
     if (!textshader.reload(name, OpenGLES))
         logger->warning("{} {}", name, message);
-    glDeleteVertexArrays(1, &textVAO);
-    glDeleteBuffers(1, &textVBO);
-    textVAO = textVBO = 0;
+    openGLState.deleteVertexArrays(1, &textVAO);
+    textVAO = 0;
     textvertscnt = 0;
 
     name = "Lines";
     if (!lineshader.reload(name, OpenGLES))
         logger->warning("{} {}", name, message);
-    glDeleteVertexArrays(1, &lineVAO);
-    glDeleteBuffers(1, &lineVBO);
-    lineVAO = lineVBO = 0;
+    openGLState.deleteVertexArrays(1, &lineVAO);
+    lineVAO = 0;
     linevertscnt = 0;
 
     name = "2D";
     if (!twodshader.reload(name, OpenGLES))
         logger->warning("{} {}", name, message);
-    glDeleteVertexArrays(1, &twodVAO);
-    glDeleteBuffers(1, &twodVBO);
-    twodVAO = twodVBO = 0;
+    openGLState.deleteVertexArrays(1, &twodVAO);
+    twodVAO = 0;
     twodvertscnt = 0;
 
     name = "Billboards";
     if (!billbshader.reload(name, OpenGLES))
         logger->warning("{} {}", name, message);
-    glDeleteVertexArrays(1, &billbVAO);
-    glDeleteBuffers(1, &billbVBO);
-    billbVAO = billbVBO = 0;
-    glDeleteTextures(1, &paltex);
+    openGLState.deleteVertexArrays(1, &billbVAO);
+    billbVAO = 0;
+    openGLState.deleteTextures(1, &paltex);
     glDeleteBuffers(1, &palbuf);
     paltex = palbuf = 0;
     billbstorecnt = 0;
@@ -4984,19 +4868,26 @@ void OpenGLRenderer::ReloadShaders() {
     name = "Decals";
     if (!decalshader.reload(name, OpenGLES))
         logger->warning("{} {}", name, message);
-    glDeleteVertexArrays(1, &decalVAO);
-    glDeleteBuffers(1, &decalVBO);
-    decalVAO = decalVBO = 0;
-    numdecalverts = 0;
 
     name = "Forced perspective";
     if (!forcepershader.reload(name, OpenGLES))
         logger->warning("{} {}", name, message);
-    glDeleteVertexArrays(1, &forceperVAO);
-    glDeleteBuffers(1, &forceperVBO);
-    forceperVAO = forceperVBO = 0;
+    openGLState.deleteVertexArrays(1, &forceperVAO);
+    forceperVAO = 0;
     forceperstorecnt = 0;
 
+    name = "Weather";
+    if (!weathershader.reload(name, OpenGLES))
+        logger->warning("{} {}", name, message);
+    openGLState.deleteVertexArrays(1, &weatherVAO);
+    weatherVAO = 0;
+
+    name = "Upscale";
+    if (!upscaleshader.reload(name, OpenGLES))
+        logger->warning("{} {}", name, message);
+    openGLState.deleteVertexArrays(1, &upscaleVAO);
+    upscaleVAO = 0;
+
     if (nuklearshader.ID != 0) {
         name = "Nuklear";
         if (!nuklearshader.reload(name, OpenGLES)) {
@@ -5021,75 +4912,51 @@ void OpenGLRenderer::ReleaseTerrain() {
     terraintexmap.clear();
 
     for (int i = 0; i < 8; i++) {
-        glDeleteTextures(1, &terraintextures[i]);
+        openGLState.deleteTextures(1, &terraintextures[i]);
         terraintextures[i] = 0;
         numterraintexloaded[i] = 0;
         terraintexturesizes[i] = 0;
     }
+    if (_terrainTexturesSize)
+        MemoryAccounting::deallocate(MEMORY_TAG_GPU_TEXTURES, std::exchange(_terrainTexturesSize, 0));
 
+    if (terrainVBO)
+        MemoryAccounting::deallocate(MEMORY_TAG_GPU_BUFFERS, sizeof(terrshaderstore));
     glDeleteBuffers(1, &terrainVBO);
-    glDeleteVertexArrays(1, &terrainVAO);
+    openGLState.deleteVertexArrays(1, &terrainVAO);
 
     terrainVBO = 0;
     terrainVAO = 0;
 
-    /*GLuint outbuildVBO, outbuildVAO;
-    GLuint outbuildtextures[8];
-    unsigned numoutbuildtexloaded[8];
-    unsigned outbuildtexturewidths[8];
-    unsigned outbuildtextureheights[8];
-    std::map<std::string, int> outbuildtexmap;*/
-
-    outbuildtexmap.clear();
-
-    for (int i = 0; i < 16; i++) {
-        glDeleteTextures(1, &outbuildtextures[i]);
-        outbuildtextures[i] = 0;
-        numoutbuildtexloaded[i] = 0;
-        outbuildtexturewidths[i] = 0;
-        outbuildtextureheights[i] = 0;
-        glDeleteBuffers(1, &outbuildVBO[i]);
-        glDeleteVertexArrays(1, &outbuildVAO[i]);
-        outbuildVBO[i] = 0;
-        outbuildVAO[i] = 0;
-        if (outbuildshaderstore[i]) {
-            free(outbuildshaderstore[i]);
-            outbuildshaderstore[i] = nullptr;
-        }
-    }
+    _outbuildTextures.release();
+    openGLState.deleteVertexArrays(1, &outbuildVAO);
+    outbuildVAO = 0;
+    _outbuildLods.clear();
+    _outbuildOcclusion.release();
+    openGLState.deleteVertexArrays(1, &outbuildOcclusionVAO);
+    outbuildOcclusionVAO = 0;
+    outbuildshaderstore.clear();
+    _spriteAtlas.release();
 }
 
 void OpenGLRenderer::ReleaseBSP() {
-    /*GLuint bspVBO, bspVAO;
-    GLuint bsptextures[16];
-    unsigned bsptexloaded[16];
-    unsigned bsptexturewidths[16];
-    unsigned bsptextureheights[16];
-    std::map<std::string, int> bsptexmap;*/
-
-    bsptexmap.clear();
-
-    for (int i = 0; i < 16; i++) {
-        glDeleteTextures(1, &bsptextures[i]);
-        bsptextures[i] = 0;
-        bsptexloaded[i] = 0;
-        bsptexturewidths[i] = 0;
-        bsptextureheights[i] = 0;
-        glDeleteBuffers(1, &bspVBO[i]);
-        glDeleteVertexArrays(1, &bspVAO[i]);
-        bspVAO[i] = 0;
-        bspVBO[i] = 0;
-        if (BSPshaderstore[i]) {
-            free(BSPshaderstore[i]);
-            BSPshaderstore[i] = nullptr;
-        }
-    }
+    _bspTextures.release();
+    _spriteAtlas.release();
+    glDeleteBuffers(1, &bspVBO);
+    openGLState.deleteVertexArrays(1, &bspVAO);
+    bspVAO = 0;
+    bspVBO = 0;
+    bspFaceRanges.clear();
+    bspDoorVersions.clear();
+    bspDrawRanges.clear();
 }
 
 
 void OpenGLRenderer::DrawTwodVerts() {
     if (!twodvertscnt) return;
 
+    OpenGLPassTimerScope passTimer(&_passTimers, RENDER_PASS_TWOD);
+
     int savex = this->clip_x;
     int savey = this->clip_y;
     int savez = this->clip_z;
@@ -5098,12 +4965,9 @@ void OpenGLRenderer::DrawTwodVerts() {
 
     if (twodVAO == 0) {
         glGenVertexArrays(1, &twodVAO);
-        glGenBuffers(1, &twodVBO);
-
-        glBindVertexArray(twodVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, twodVBO);
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(twodshaderstore), twodshaderstore, GL_DYNAMIC_DRAW);
+        openGLState.bindVertexArray(twodVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, _streamBuffer.id());
 
         // position attribute
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(twodverts), (void*)offsetof(twodverts, x));
@@ -5122,43 +4986,30 @@ void OpenGLRenderer::DrawTwodVerts() {
         glEnableVertexAttribArray(4);
     }
 
-    if (palbuf == 0) {
-        // generate palette buffer texture
-        std::span<Color> palettes = pPaletteManager->paletteData();
-        glGenBuffers(1, &palbuf);
-        glBindBuffer(GL_TEXTURE_BUFFER, palbuf);
-        glBufferData(GL_TEXTURE_BUFFER, palettes.size_bytes(), palettes.data(), GL_STATIC_DRAW);
-
-        glGenTextures(1, &paltex);
-        glBindTexture(GL_TEXTURE_BUFFER, paltex);
-        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8UI, palbuf);
-        glBindBuffer(GL_TEXTURE_BUFFER, 0);
-    }
+    updatePaletteBuffer();
 
     // update buffer
-    glBindBuffer(GL_ARRAY_BUFFER, twodVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(twodverts) * twodvertscnt, twodshaderstore);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GLint first = _streamBuffer.upload(twodshaderstore, twodvertscnt);
 
-    glBindVertexArray(twodVAO);
+    openGLState.bindVertexArray(twodVAO);
     glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
     glEnableVertexAttribArray(2);
     glEnableVertexAttribArray(3);
     glEnableVertexAttribArray(4);
 
-    glUseProgram(twodshader.ID);
+    openGLState.useProgram(twodshader.ID);
 
     // set sampler to palette
     glUniform1i(glGetUniformLocation(twodshader.ID, "palbuf"), GLint(1));
-    glActiveTexture(GL_TEXTURE0 + 1);
-    glBindTexture(GL_TEXTURE_BUFFER, paltex);
+    openGLState.activeTexture(GL_TEXTURE0 + 1);
+    openGLState.bindTexture(GL_TEXTURE_BUFFER, paltex);
     glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8UI, palbuf);
-    glActiveTexture(GL_TEXTURE0);
+    openGLState.activeTexture(GL_TEXTURE0);
 
-    // glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // openGLState.enable(GL_TEXTURE_2D);
+    openGLState.enable(GL_BLEND);
+    openGLState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     // set sampler to texure0
     glUniform1i(glGetUniformLocation(twodshader.ID, "texture0"), GLint(0));
 
@@ -5171,7 +5022,7 @@ void OpenGLRenderer::DrawTwodVerts() {
     while (offset < twodvertscnt) {
         // set texture
         GLfloat thistex = twodshaderstore[offset].texid;
-        glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(twodshaderstore[offset].texid));
+        openGLState.bindTexture(GL_TEXTURE_2D, static_cast<GLuint>(twodshaderstore[offset].texid));
         if (twodshaderstore[offset].paletteid) {
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -5189,13 +5040,13 @@ void OpenGLRenderer::DrawTwodVerts() {
             }
         } while (twodshaderstore[offset + (cnt * 6)].texid == thistex);
 
-        glDrawArrays(GL_TRIANGLES, offset, (6*cnt));
+        glDrawArrays(GL_TRIANGLES, first + offset, (6*cnt));
         drawcalls++;
 
         offset += (6*cnt);
     }
 
-    glUseProgram(0);
+    openGLState.useProgram(0);
     glDisableVertexAttribArray(0);
     glDisableVertexAttribArray(1);
     glDisableVertexAttribArray(2);
@@ -5204,7 +5055,7 @@ void OpenGLRenderer::DrawTwodVerts() {
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    glBindVertexArray(0);
+    openGLState.bindVertexArray(0);
 
     twodvertscnt = 0;
     render->SetUIClipRect(savex, savey, savez, savew);
@@ -5249,7 +5100,7 @@ bool OpenGLRenderer::NuklearInitialize(struct nk_tex_font *tfont) {
 }
 
 bool OpenGLRenderer::NuklearCreateDevice() {
-    nuklearshader.build("nuklear", "glnuklear", OpenGLES);
+    nuklearshader.build("nuklear", "glnuklear", OpenGLES, &_shaderCache);
     if (nuklearshader.ID == 0) {
         logger->warning("Nuklear shader failed to compile!");
         return false;
@@ -5271,7 +5122,7 @@ bool OpenGLRenderer::NuklearCreateDevice() {
         glGenBuffers(1, &nk->dev.ebo);
         glGenVertexArrays(1, &nk->dev.vao);
 
-        glBindVertexArray(nk->dev.vao);
+        openGLState.bindVertexArray(nk->dev.vao);
         glBindBuffer(GL_ARRAY_BUFFER, nk->dev.vbo);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, nk->dev.ebo);
 
@@ -5284,10 +5135,10 @@ bool OpenGLRenderer::NuklearCreateDevice() {
         glVertexAttribPointer((GLuint)nk->dev.attrib_col, 4, GL_UNSIGNED_BYTE, GL_TRUE, vs, (void*)vc);
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    openGLState.bindVertexArray(0);
 
     return true;
 }
@@ -5300,6 +5151,8 @@ bool OpenGLRenderer::NuklearRender(/*enum nk_anti_aliasing*/ int AA, int max_ver
     if (!nk_ctx->begin)
         return false;
 
+    OpenGLPassTimerScope passTimer(&_passTimers, RENDER_PASS_NUKLEAR);
+
 
     int width, height;
     int display_width, display_height;
@@ -5323,16 +5176,16 @@ bool OpenGLRenderer::NuklearRender(/*enum nk_anti_aliasing*/ int AA, int max_ver
     scale.y = (float)display_height / (float)height;
 
     /* setup global state */
-    glEnable(GL_BLEND);
+    openGLState.enable(GL_BLEND);
     glBlendEquation(GL_FUNC_ADD);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_CULL_FACE);
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_SCISSOR_TEST);
-    glActiveTexture(GL_TEXTURE0);
+    openGLState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    openGLState.disable(GL_CULL_FACE);
+    openGLState.disable(GL_DEPTH_TEST);
+    openGLState.enable(GL_SCISSOR_TEST);
+    openGLState.activeTexture(GL_TEXTURE0);
 
     /* setup program */
-    glUseProgram(nuklearshader.ID);
+    openGLState.useProgram(nuklearshader.ID);
     glUniform1i(nk->dev.uniform_tex, 0);
     glUniformMatrix4fv(nk->dev.uniform_proj, 1, GL_FALSE, &ortho[0][0]);
     {
@@ -5343,7 +5196,7 @@ bool OpenGLRenderer::NuklearRender(/*enum nk_anti_aliasing*/ int AA, int max_ver
         struct nk_buffer vbuf, ebuf;
 
         /* allocate vertex and element buffer */
-        glBindVertexArray(nk->dev.vao);
+        openGLState.bindVertexArray(nk->dev.vao);
         glBindBuffer(GL_ARRAY_BUFFER, nk->dev.vbo);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, nk->dev.ebo);
 
@@ -5390,8 +5243,8 @@ bool OpenGLRenderer::NuklearRender(/*enum nk_anti_aliasing*/ int AA, int max_ver
         /* iterate over and execute each draw command */
         nk_draw_foreach(cmd, nk_ctx, &nk->dev.cmds) {
             if (!cmd->elem_count) continue;
-            glBindTexture(GL_TEXTURE_2D, (GLuint)cmd->texture.id);
-            glScissor((GLint)(cmd->clip_rect.x * scale.x),
+            openGLState.bindTexture(GL_TEXTURE_2D, (GLuint)cmd->texture.id);
+            openGLState.scissor((GLint)(cmd->clip_rect.x * scale.x),
                 (GLint)((height - (GLint)(cmd->clip_rect.y + cmd->clip_rect.h)) * scale.y),
                 (GLint)(cmd->clip_rect.w * scale.x),
                 (GLint)(cmd->clip_rect.h * scale.y));
@@ -5403,12 +5256,12 @@ bool OpenGLRenderer::NuklearRender(/*enum nk_anti_aliasing*/ int AA, int max_ver
         nk_buffer_clear(&nk->dev.cmds);
     }
 
-    glUseProgram(0);
+    openGLState.useProgram(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    glDisable(GL_BLEND);
-    // glDisable(GL_SCISSOR_TEST);
+    openGLState.bindVertexArray(0);
+    openGLState.disable(GL_BLEND);
+    // openGLState.disable(GL_SCISSOR_TEST);
 
     return true;
 }
@@ -5416,10 +5269,10 @@ bool OpenGLRenderer::NuklearRender(/*enum nk_anti_aliasing*/ int AA, int max_ver
 void OpenGLRenderer::NuklearRelease() {
     nk_font_atlas_clear(&nk->dev.atlas);
 
-    glDeleteProgram(nuklearshader.ID);
+    openGLState.deleteProgram(nuklearshader.ID);
     glDeleteBuffers(1, &nk->dev.vbo);
     glDeleteBuffers(1, &nk->dev.ebo);
-    glDeleteVertexArrays(1, &nk->dev.vao);
+    openGLState.deleteVertexArrays(1, &nk->dev.vao);
 
     nk_buffer_free(&nk->dev.cmds);
 
@@ -5456,7 +5309,7 @@ struct nk_tex_font *OpenGLRenderer::NuklearFontLoad(const char *font_path, size_
     image = nk_font_atlas_bake(&nk->dev.atlas, &w, &h, NK_FONT_ATLAS_RGBA32);
 
     glGenTextures(1, &texid);
-    glBindTexture(GL_TEXTURE_2D, texid);
+    openGLState.bindTexture(GL_TEXTURE_2D, texid);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, (GLsizei)w, (GLsizei)h, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
@@ -5469,7 +5322,7 @@ struct nk_tex_font *OpenGLRenderer::NuklearFontLoad(const char *font_path, size_
 
 void OpenGLRenderer::NuklearFontFree(struct nk_tex_font *tfont) {
     if (tfont)
-        glDeleteTextures(1, &tfont->texid);
+        openGLState.deleteTextures(1, &tfont->texid);
 }
 
 struct nk_image OpenGLRenderer::NuklearImageLoad(GraphicsImage *img) {
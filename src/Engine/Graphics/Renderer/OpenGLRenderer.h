@@ -1,19 +1,35 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include <glad/gl.h> // NOLINT: this is not a C system include.
 #include <glm/glm.hpp>
 
+#include "Engine/Graphics/BSPModelLod.h"
+#include "Engine/Graphics/DynamicResolution.h"
 #include "Engine/Graphics/FrameLimiter.h"
 #include "BaseRenderer.h"
 
 #include "Library/Color/Colorf.h"
 
+#include "OpenGLDecalBuffer.h"
+#include "OpenGLFrameQueue.h"
+#include "OpenGLLightClusters.h"
+#include "OpenGLMemoryInfo.h"
+#include "OpenGLOcclusionQueries.h"
+#include "OpenGLPassTimers.h"
+#include "OpenGLScreenReadback.h"
 #include "OpenGLShader.h"
+#include "OpenGLShaderCache.h"
+#include "OpenGLSpriteAtlas.h"
+#include "OpenGLStreamBuffer.h"
+#include "OpenGLTextureArrayPool.h"
+#include "OpenGLTextureArrayUploader.h"
 
 class PlatformOpenGLContext;
 struct nk_state;
@@ -70,6 +86,8 @@ class OpenGLRenderer : public BaseRenderer {
                                 GraphicsImage *texture) override;
 
     virtual TextureRenderId CreateTexture(RgbaImageView image) override;
+    virtual TextureRenderId CreateIndexedTexture(GrayscaleImageView image) override;
+    virtual TextureRenderId CreatePalettedTexture(GrayscaleImageView image, const Palette &palette) override;
     virtual void DeleteTexture(TextureRenderId id) override;
     virtual void UpdateTexture(TextureRenderId id, RgbaImageView image) override;
 
@@ -98,6 +116,7 @@ class OpenGLRenderer : public BaseRenderer {
     virtual void EndTextNew() override;
     virtual void DrawTextNew(int x, int y, int w, int h, float u1, float v1, float u2, float v2, int isshadow, Color colour) override;
 
+    virtual void DrawSnow(int flakeCount, uint32_t seed, float time, float windOffset) override;
     virtual void FillRectFast(unsigned int uX, unsigned int uY,
                               unsigned int uWidth, unsigned int uHeight,
                               Color uColor32) override;
@@ -111,6 +130,8 @@ class OpenGLRenderer : public BaseRenderer {
     virtual bool AreRenderSurfacesOk() override;
 
     virtual RgbaImage MakeScreenshot32(const int width, const int height) override;
+    virtual std::future<RgbaImage> RequestScreenshot32(int width, int height) override;
+    virtual void FinishScreenshots() override;
 
     virtual void BeginLightmaps() override;
     virtual void EndLightmaps() override;
@@ -137,6 +158,11 @@ class OpenGLRenderer : public BaseRenderer {
     virtual bool Reinitialize(bool firstInit) override;
     virtual void ReloadShaders() override;
 
+    virtual IndexedArray<float, RENDER_PASS_FIRST, RENDER_PASS_LAST> GetPassTimings() override;
+    virtual float GetFrameLatency() override;
+    virtual int GetAvoidedStateChanges() override;
+    virtual VideoMemoryInfo GetVideoMemoryInfo() override;
+
  protected:
     virtual void DoRenderBillboards_D3D() override;
     void SetBillboardBlendOptions(RenderBillboardD3D::OpacityType a1);
@@ -158,6 +184,74 @@ class OpenGLRenderer : public BaseRenderer {
     void _set_ortho_projection(bool gameviewport = false);
     void _set_ortho_modelview();
 
+    /**
+     * Binds the clustered point lights to one of the world shaders, building the light grid first if this is the
+     * first world pass of the frame. The program must be in use.
+     *
+     * @param program                   Shader program to bind to.
+     */
+    void bindLightClusters(GLuint program);
+
+    /**
+     * Checks for video memory pressure, and bumps the mip bias of the world textures if we're running low. Pressure
+     * is either reported by the driver, or is when the accounted GPU allocations exceed the `video_memory_budget`.
+     * There is no way back from a bias increase, as re-uploading the texture arrays back & forth would thrash.
+     */
+    void updateTextureResidency();
+
+    /**
+     * Creates the palette buffer texture on first call, and uploads the palettes that were decoded by
+     * `pPaletteManager` since the last call. Leaves `GL_TEXTURE_BUFFER` unbound.
+     */
+    void updatePaletteBuffer();
+
+    /**
+     * @return                          Viewport rectangle for the 3D view in OpenGL window coordinates. When the
+     *                                  scaled scene target is bound this is the part of the target that's drawn into.
+     */
+    [[nodiscard]] Recti gameViewportRect() const;
+
+    /**
+     * Binds the scaled scene target for the 3D passes if dynamic resolution is active & the render scale is below 1.
+     * Otherwise does nothing, and the 3D view is drawn straight into the main target.
+     */
+    void bindSceneTarget();
+
+    /**
+     * Upscales the scene target into the game viewport of the main target & binds the main target back. Does nothing
+     * if the scene target is not bound. Must be called before anything is drawn on top of the 3D view.
+     */
+    void resolveSceneTarget();
+
+    /**
+     * Feeds the timings of the last frame into the dynamic resolution controller. GPU timings are used when they are
+     * available, otherwise falls back to the CPU-side frame time.
+     */
+    void updateDynamicResolution();
+
+    /**
+     * Feeds the time of the last frame into `engine->qualityGovernor`, using whichever of the CPU & GPU frame times
+     * is larger. Keeps the governor off when running deterministically.
+     */
+    void updateQualityGovernor();
+
+    /**
+     * Issues occlusion queries for the bounding boxes of the outdoor models that have passed the frustum check in
+     * `DrawOutdoorBuildings`. Must be called after the terrain & all the buildings were drawn, the results are used
+     * in the next frames.
+     */
+    void drawOutdoorBuildingOcclusionQueries();
+
+    /**
+     * @param model                     Outdoor model to draw.
+     * @param cameraPos                 Camera position.
+     * @return                          Simplified mesh to draw the model with, based on the model's size on screen.
+     *                                  `nullptr` means the full mesh should be drawn.
+     */
+    [[nodiscard]] const BSPModelLod *selectOutdoorModelLod(const BSPModel &model, const Vec3f &cameraPos) const;
+
+    virtual bool isOutdoorModelOccluded(const BSPModel &model) const override;
+
     int clip_x{}, clip_y{};
     int clip_z{}, clip_w{};
 
@@ -179,7 +273,9 @@ class OpenGLRenderer : public BaseRenderer {
     OpenGLShader billbshader;
     OpenGLShader decalshader;
     OpenGLShader forcepershader;
+    OpenGLShader weathershader;
     OpenGLShader nuklearshader;
+    OpenGLShaderCache _shaderCache;
 
     // terrain shader
     GLuint terrainVBO{}, terrainVAO{};
@@ -189,41 +285,96 @@ class OpenGLRenderer : public BaseRenderer {
     unsigned int terraintexturesizes[8]{};
     std::map<std::string, int> terraintexmap;
 
-    // outside building shader
-    GLuint outbuildVBO[16]{}, outbuildVAO[16]{};
-    GLuint outbuildtextures[16]{};
-    unsigned int numoutbuildtexloaded[16]{};
-    unsigned int outbuildtexturewidths[16]{};
-    unsigned int outbuildtextureheights[16]{};
-    std::map<std::string, int> outbuildtexmap;
-
-    // indoors bsp shader
-    GLuint bspVBO[16]{}, bspVAO[16]{};
-    GLuint bsptextures[16]{};
-    unsigned int bsptexloaded[16]{};
-    unsigned int bsptexturewidths[16]{};
-    unsigned int bsptextureheights[16]{};
-    std::map<std::string, int> bsptexmap;
+    // outside building shader, geometry is streamed through _streamBuffer
+    GLuint outbuildVAO{};
+    OpenGLTextureArrayPool _outbuildTextures;
+
+    // Occlusion culling for outdoor buildings. Queries are indexed by model index, proxy boxes are streamed through
+    // _streamBuffer.
+    OpenGLOcclusionQueries _outbuildOcclusion;
+    std::vector<int> _outbuildOcclusionCandidates; // Models that have passed the frustum check this frame.
+    std::vector<Vec3f> _outbuildOcclusionVerts;
+    GLuint outbuildOcclusionVAO{};
+
+    // Simplified meshes for outdoor buildings, indexed by model index. Empty if LODs are disabled. The finer LOD is
+    // used when the model's projected radius drops below the first threshold (in pixels), the coarser one below the
+    // second. Cluster sizes are derived from the same thresholds, model radius divided by the detail factor gives
+    // about 2 pixels of error at the switch distance.
+    static constexpr std::array<float, 2> OUTDOOR_MODEL_LOD_SCREEN_RADIUS = {{160.0f, 48.0f}};
+    static constexpr std::array<float, 2> OUTDOOR_MODEL_LOD_DETAIL = {{80.0f, 24.0f}};
+    using OutdoorModelLods = std::array<BSPModelLod, 2>;
+    std::vector<OutdoorModelLods> _outbuildLods;
+
+    // indoors bsp shader, all faces of the level are in bspVBO
+    GLuint bspVBO{}, bspVAO{};
+    OpenGLTextureArrayPool _bspTextures;
+
+    // Shared vertex buffer for all the passes below that re-upload their geometry every frame.
+    OpenGLStreamBuffer _streamBuffer;
+
+    // Staging pixel buffer for texture uploads.
+    OpenGLStreamBuffer _textureStagingBuffer;
+
+    // Sizes of the textures created with `CreateTexture`, for memory accounting.
+    std::unordered_map<GLuint, size_t> _textureSizes;
+
+    // Decides on the format of the world texture arrays.
+    OpenGLTextureArrayUploader _textureArrayUploader;
+
+    // GPU timers for the render passes.
+    OpenGLPassTimers _passTimers;
+    OpenGLFrameQueue _frameQueue;
+
+    // Screenshots that are being read back, completed in `Present`.
+    OpenGLScreenReadback _screenReadback;
+
+    // Video memory queries, and the adaptive mip bias for the world textures, see `updateTextureResidency`.
+    OpenGLMemoryInfo _memoryInfo;
+    VideoMemoryInfo _videoMemoryInfo;
+    int64_t _residencyFrame = 0;
+    size_t _terrainTexturesSize = 0;
+
+    // Point lights for the terrain, outdoor buildings & BSP shaders, rebuilt every frame.
+    OpenGLLightClusters _lightClusters;
+    std::vector<ClusteredLight> _clusteredLights;
+
+    // Decal geometry, persists between frames.
+    OpenGLDecalBuffer _decalBuffer;
+
+    // Paletted billboard sprites, reset on map change.
+    OpenGLSpriteAtlas _spriteAtlas;
 
     // text shader
-    GLuint textVBO{}, textVAO{};
+    GLuint textVAO{};
     GLuint texmain{}, texshadow{};
 
     // lines shader
-    GLuint lineVBO{}, lineVAO{};
+    GLuint lineVAO{};
 
     // two d shader
-    GLuint twodVBO{}, twodVAO{};
+    GLuint twodVAO{};
 
     // billboards shader
-    GLuint billbVBO{}, billbVAO{};
+    GLuint billbVAO{};
     GLuint palbuf{}, paltex{};
 
-    // decal shader
-    GLuint decalVBO{}, decalVAO{};
-
     // forced perspective shader
-    GLuint forceperVBO{}, forceperVAO{};
+    GLuint forceperVAO{};
+
+    // weather shader, flakes are generated from gl_VertexID so the VAO has no attributes
+    GLuint weatherVAO{};
+
+    // Dynamic resolution for the 3D view. The scene target is allocated at the full game viewport size, and the 3D
+    // passes only use the bottom-left `_sceneSize` part of it, so changing the scale doesn't reallocate anything.
+    DynamicResolution _dynamicResolution;
+    OpenGLShader upscaleshader;
+    GLuint upscaleVAO{}; // Fullscreen triangle is generated from gl_VertexID.
+    GLuint _sceneFramebuffer{};
+    GLuint _sceneTextures[2]{};
+    Sizei _sceneTextureSize;
+    Sizei _sceneSize;
+    bool _sceneTargetBound = false;
+    int64_t _lastPresentNs = 0;
 
     // Fog parameters
     Colorf fog;
@@ -0,0 +1,102 @@
+#include "OpenGLScreenReadback.h"
+
+#include <cstring>
+#include <utility>
+
+#include "Library/Image/ImageFunctions.h"
+#include "Library/Logger/Logger.h"
+
+void OpenGLScreenReadback::release() {
+    poll(true);
+
+    if (_renderbuffer)
+        glDeleteRenderbuffers(1, &_renderbuffer);
+    if (_framebuffer)
+        glDeleteFramebuffers(1, &_framebuffer);
+    _renderbuffer = 0;
+    _framebuffer = 0;
+    _targetSize = Sizei();
+}
+
+std::future<RgbaImage> OpenGLScreenReadback::request(GLuint readFramebuffer, Recti srcRect, Sizei size) {
+    resizeTarget(size);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _framebuffer);
+    glBlitFramebuffer(srcRect.x, srcRect.y, srcRect.x + srcRect.w, srcRect.y + srcRect.h, 0, 0, size.w, size.h,
+                      GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+    Pending &pending = _pending.emplace_back();
+    pending.size = size;
+
+    glGenBuffers(1, &pending.buffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pending.buffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, size.w * size.h * sizeof(Color), nullptr, GL_STREAM_READ);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer);
+    glReadPixels(0, 0, size.w, size.h, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    pending.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush(); // Make sure the fence gets to the GPU, otherwise polling it might never succeed.
+
+    return pending.promise.get_future();
+}
+
+void OpenGLScreenReadback::poll(bool wait) {
+    // Readbacks complete in order, so we can stop at the first one that's not ready.
+    size_t completed = 0;
+    for (; completed < _pending.size(); completed++) {
+        Pending &pending = _pending[completed];
+        GLuint64 timeout = wait ? 1'000'000'000 : 0;
+        GLenum status = glClientWaitSync(pending.fence, 0, timeout);
+        while (wait && status == GL_TIMEOUT_EXPIRED)
+            status = glClientWaitSync(pending.fence, 0, timeout);
+        if (status == GL_TIMEOUT_EXPIRED)
+            break;
+        if (status == GL_WAIT_FAILED)
+            logger->warning("OpenGL: waiting on screen readback fence failed");
+
+        complete(&pending);
+    }
+
+    _pending.erase(_pending.begin(), _pending.begin() + completed);
+}
+
+void OpenGLScreenReadback::resizeTarget(Sizei size) {
+    if (_framebuffer && _targetSize == size)
+        return;
+
+    if (!_framebuffer)
+        glGenFramebuffers(1, &_framebuffer);
+    if (!_renderbuffer)
+        glGenRenderbuffers(1, &_renderbuffer);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, _renderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size.w, size.h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _framebuffer);
+    glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _renderbuffer);
+    _targetSize = size;
+}
+
+void OpenGLScreenReadback::complete(Pending *pending) {
+    RgbaImage image = RgbaImage::uninitialized(pending->size.w, pending->size.h);
+    size_t bytes = image.pixels().size_bytes();
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pending->buffer);
+    if (const void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT)) {
+        std::memcpy(image.pixels().data(), data, bytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        logger->warning("OpenGL: couldn't map screen readback buffer");
+        image = RgbaImage::solid(pending->size.w, pending->size.h, Color());
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glDeleteBuffers(1, &pending->buffer);
+    glDeleteSync(pending->fence);
+
+    // GL rows go bottom to top.
+    pending->promise.set_value(flipVertically(image));
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <future>
+#include <vector>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+#include "Library/Geometry/Rect.h"
+#include "Library/Geometry/Size.h"
+#include "Library/Image/Image.h"
+
+/**
+ * Asynchronous readback of small downscaled copies of the screen, used for save thumbnails & Lloyd's beacon images.
+ *
+ * The requested part of the screen is first blitted into a small offscreen framebuffer, so that the scaling is done
+ * on the GPU and only the final image is read back. Readback goes into a pixel buffer object with a fence behind it,
+ * and the buffer is only mapped once the fence is signaled, normally a frame later. Until then the GPU and the CPU
+ * keep running in parallel.
+ */
+class OpenGLScreenReadback {
+ public:
+    OpenGLScreenReadback() = default;
+
+    /**
+     * Finishes all pending readbacks and deletes all GL objects. Must be called with the OpenGL context still alive.
+     */
+    void release();
+
+    /**
+     * Queues a readback. Changes the framebuffer bindings, restoring them is up to the caller. Scissor test must be
+     * disabled.
+     *
+     * @param readFramebuffer           Framebuffer to read from.
+     * @param srcRect                   Part of the framebuffer to read, in GL coordinates (origin at the bottom left).
+     * @param size                      Size of the resulting image.
+     * @return                          Future for the resulting image, top row first.
+     */
+    [[nodiscard]] std::future<RgbaImage> request(GLuint readFramebuffer, Recti srcRect, Sizei size);
+
+    /**
+     * Completes the readbacks that are ready.
+     *
+     * @param wait                      Whether to block until all pending readbacks are completed.
+     */
+    void poll(bool wait);
+
+    [[nodiscard]] bool empty() const {
+        return _pending.empty();
+    }
+
+ private:
+    struct Pending {
+        GLuint buffer = 0;
+        GLsync fence = nullptr;
+        Sizei size;
+        std::promise<RgbaImage> promise;
+    };
+
+    void resizeTarget(Sizei size);
+    void complete(Pending *pending);
+
+ private:
+    GLuint _framebuffer = 0;
+    GLuint _renderbuffer = 0;
+    Sizei _targetSize;
+    std::vector<Pending> _pending;
+};
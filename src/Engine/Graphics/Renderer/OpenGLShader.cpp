@@ -9,6 +9,9 @@
 #include "Utility/DataPath.h"
 #include "Utility/Exception.h"
 
+#include "OpenGLShaderCache.h"
+#include "OpenGLState.h"
+
 namespace detail_extension {
 MM_DEFINE_ENUM_SERIALIZATION_FUNCTIONS(GLenum, CASE_SENSITIVE, {
     {GL_VERTEX_SHADER, "vert"},
@@ -31,40 +34,63 @@ MM_DEFINE_ENUM_SERIALIZATION_FUNCTIONS(GLenum, CASE_SENSITIVE, {
 })
 } // namespace detail_name
 
-int OpenGLShader::build(const std::string &name, const std::string &filename, bool OpenGLES, bool reload) {
+int OpenGLShader::build(const std::string &name, const std::string &filename, bool OpenGLES, OpenGLShaderCache *cache, bool reload) {
     // 1. retrieve the vertex/fragment source code from filePath
-    GLuint vertex = load(name, filename, GL_VERTEX_SHADER, OpenGLES);
-    if (vertex == 0)
+    std::string vertexSource = readSource(name, filename, GL_VERTEX_SHADER, OpenGLES);
+    if (vertexSource.empty())
         return 0;
 
-    GLuint fragment = load(name, filename, GL_FRAGMENT_SHADER, OpenGLES);
-    if (fragment == 0)
+    std::string fragmentSource = readSource(name, filename, GL_FRAGMENT_SHADER, OpenGLES);
+    if (fragmentSource.empty())
         return 0;
 
-    GLuint geometry = load(name, filename, GL_GEOMETRY_SHADER, OpenGLES, true);
-
-    // shader Program
-    int tempID = glCreateProgram();
-    glAttachShader(tempID, vertex);
-    glAttachShader(tempID, fragment);
-    if (geometry != 0)
-        glAttachShader(tempID, geometry);
-    glLinkProgram(tempID);
-    bool NOerror = checkCompileErrors(tempID, name, "program");
-    if (!NOerror)
-        tempID = 0;
-
-    // delete the shaders as they're linked into our program now and no longer necessery
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
-    if (geometry != 0)
-        glDeleteShader(geometry);
+    std::string geometrySource = readSource(name, filename, GL_GEOMETRY_SHADER, OpenGLES, true);
+
+    // 2. try the program binary cache, the key covers all the stages
+    uint64_t cacheKey = 0;
+    int tempID = 0;
+    if (cache && cache->isEnabled()) {
+        cacheKey = cache->key(vertexSource + '\0' + fragmentSource + '\0' + geometrySource);
+        tempID = cache->load(filename, cacheKey);
+    }
+
+    // 3. compile & link from source if that didn't work out
+    if (!tempID) {
+        GLuint vertex = compile(name, vertexSource, GL_VERTEX_SHADER);
+        GLuint fragment = compile(name, fragmentSource, GL_FRAGMENT_SHADER);
+        GLuint geometry = geometrySource.empty() ? 0 : compile(name, geometrySource, GL_GEOMETRY_SHADER);
+
+        // shader Program
+        tempID = glCreateProgram();
+        glAttachShader(tempID, vertex);
+        glAttachShader(tempID, fragment);
+        if (geometry != 0)
+            glAttachShader(tempID, geometry);
+        if (cache && cache->isEnabled())
+            glProgramParameteri(tempID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(tempID);
+        bool NOerror = checkCompileErrors(tempID, name, "program");
+        if (!NOerror) {
+            openGLState.deleteProgram(tempID);
+            tempID = 0;
+        }
+
+        // delete the shaders as they're linked into our program now and no longer necessery
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+        if (geometry != 0)
+            glDeleteShader(geometry);
+
+        if (tempID && cache)
+            cache->save(filename, cacheKey, tempID);
+    }
 
     if (tempID) {
         // set var members on first load
         if (reload == false) {
             ID = tempID;
             sFilename = filename;
+            _cache = cache;
         }
         return tempID;
     }
@@ -74,10 +100,10 @@ int OpenGLShader::build(const std::string &name, const std::string &filename, bo
 }
 
 bool OpenGLShader::reload(const std::string &name, bool OpenGLES) {
-    int tryreload = build(name, sFilename, OpenGLES, true);
+    int tryreload = build(name, sFilename, OpenGLES, _cache, true);
 
     if (tryreload) {
-        glDeleteProgram(ID);
+        openGLState.deleteProgram(ID);
         ID = tryreload;
         return true;
     }
@@ -87,7 +113,7 @@ bool OpenGLShader::reload(const std::string &name, bool OpenGLES) {
 }
 
 void OpenGLShader::use() {
-    glUseProgram(ID);
+    openGLState.useProgram(ID);
 }
 
 std::string OpenGLShader::shaderTypeToExtension(int type) {
@@ -123,7 +149,7 @@ bool OpenGLShader::checkCompileErrors(int shader, const std::string &name, const
     return true;
 }
 
-int OpenGLShader::load(const std::string &name, const std::string &filename, int type, bool OpenGLES, bool nonFatal) {
+std::string OpenGLShader::readSource(const std::string &name, const std::string &filename, int type, bool OpenGLES, bool nonFatal) {
     std::string directory = "shaders";
     std::string typeName = shaderTypeToName(type);
     std::string path = makeDataPath(directory, filename + "." + shaderTypeToExtension(type));
@@ -137,18 +163,20 @@ int OpenGLShader::load(const std::string &name, const std::string &filename, int
 
         FileInputStream stream(path);
         shaderString += stream.readAll();
-
-        // compile shader
-        const char *shaderChar = shaderString.c_str();
-        GLuint shaderHandler = glCreateShader(type);
-        glShaderSource(shaderHandler, 1, &shaderChar, NULL);
-        glCompileShader(shaderHandler);
-        checkCompileErrors(shaderHandler, name, shaderTypeToName(type));
-
-        return shaderHandler;
+        return shaderString;
     } catch (const Exception &e) {
         if (!nonFatal)
             logger->error("Error occured during reading {} {} shader file at path {}: {}", name, typeName, path, e.what());
-        return 0;
+        return {};
     }
 }
+
+int OpenGLShader::compile(const std::string &name, const std::string &source, int type) {
+    const char *shaderChar = source.c_str();
+    GLuint shaderHandler = glCreateShader(type);
+    glShaderSource(shaderHandler, 1, &shaderChar, NULL);
+    glCompileShader(shaderHandler);
+    checkCompileErrors(shaderHandler, name, shaderTypeToName(type));
+
+    return shaderHandler;
+}
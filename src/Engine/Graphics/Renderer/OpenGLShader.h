@@ -6,6 +6,8 @@
 
 #include <string>
 
+class OpenGLShaderCache;
+
 class OpenGLShader {
  public:
     unsigned int ID{};
@@ -18,7 +20,15 @@ class OpenGLShader {
 
     // TODO(pskelton): consider map for uniform locations
 
-    int build(const std::string &name, const std::string &filename, bool OpenGLES = false, bool reload = false);
+    /**
+     * @param name                      Human-readable shader name, for error messages.
+     * @param filename                  Base file name of the shader sources in the `shaders` data directory.
+     * @param OpenGLES                  Whether to build for OpenGL ES.
+     * @param cache                     Program binary cache to use, can be `nullptr`. Also used on `reload`.
+     * @param reload                    Whether this is a reload, in which case member variables are not touched.
+     * @return                          Linked program, or zero on failure.
+     */
+    int build(const std::string &name, const std::string &filename, bool OpenGLES = false, OpenGLShaderCache *cache = nullptr, bool reload = false);
 
     bool reload(const std::string &name, bool OpenGLES);
 
@@ -32,5 +42,9 @@ class OpenGLShader {
     // utility function for checking shader compilation/linking errors.
     bool checkCompileErrors(int shader, const std::string &name, const std::string &type);
 
-    int load(const std::string &name, const std::string &filename, int type, bool OpenGLES, bool nonFatal = false);
+    // reads the source for the given stage (with the version line prepended), returns an empty string on failure.
+    std::string readSource(const std::string &name, const std::string &filename, int type, bool OpenGLES, bool nonFatal = false);
+    int compile(const std::string &name, const std::string &source, int type);
+
+    OpenGLShaderCache *_cache = nullptr;
 };
@@ -0,0 +1,129 @@
+#include "OpenGLShaderCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Library/Logger/Logger.h"
+
+#include "Utility/Memory/Blob.h"
+#include "Utility/Streams/TempFileOutputStream.h"
+#include "Utility/Hash.h"
+
+#include "OpenGLState.h"
+
+static constexpr char CACHE_SIGNATURE[8] = {'O', 'E', 'S', 'H', 'B', 'I', 'N', '1'};
+
+struct ShaderCacheHeader {
+    char signature[8];
+    uint64_t key;
+    uint32_t format;
+    uint32_t size;
+};
+static_assert(sizeof(ShaderCacheHeader) == 24);
+
+static void hashGlString(uint64_t *hash, GLenum name) {
+    const char *string = reinterpret_cast<const char *>(glGetString(name));
+    if (string)
+        *hash = fnv1aHashBytes(string, strlen(string) + 1, *hash); // Include the terminating zero as a separator.
+}
+
+void OpenGLShaderCache::initialize(std::string_view directory) {
+    _directory.clear();
+
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount <= 0) {
+        logger->info("OpenGL: driver doesn't support program binaries, shader cache is disabled");
+        return;
+    }
+
+    _driverHash = FNV1A_OFFSET_BASIS;
+    hashGlString(&_driverHash, GL_VENDOR);
+    hashGlString(&_driverHash, GL_RENDERER);
+    hashGlString(&_driverHash, GL_VERSION);
+    _directory = directory;
+}
+
+uint64_t OpenGLShaderCache::key(std::string_view sources) const {
+    return fnv1aHash(sources, _driverHash);
+}
+
+GLuint OpenGLShaderCache::load(std::string_view name, uint64_t key) const {
+    if (!isEnabled())
+        return 0;
+
+    std::string path = this->path(name);
+    std::error_code error;
+    if (!std::filesystem::exists(path, error))
+        return 0;
+
+    Blob data;
+    try {
+        data = Blob::fromFile(path);
+    } catch (const std::exception &e) {
+        logger->warning("OpenGL: could not read cached shader binary '{}': {}", path, e.what());
+        return 0;
+    }
+
+    ShaderCacheHeader header;
+    if (data.size() < sizeof(header))
+        return 0;
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.signature, CACHE_SIGNATURE, sizeof(CACHE_SIGNATURE)) != 0 || header.key != key ||
+        header.size != data.size() - sizeof(header))
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, static_cast<const char *>(data.data()) + sizeof(header), header.size);
+
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        logger->info("OpenGL: cached binary for shader '{}' was rejected by the driver, recompiling", name);
+        openGLState.deleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+void OpenGLShaderCache::save(std::string_view name, uint64_t key, GLuint program) const {
+    if (!isEnabled())
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0)
+        return;
+
+    ShaderCacheHeader header;
+    memcpy(header.signature, CACHE_SIGNATURE, sizeof(CACHE_SIGNATURE));
+    header.key = key;
+    header.format = format;
+    header.size = written;
+
+    std::string path = this->path(name);
+    try {
+        std::filesystem::create_directories(_directory);
+
+        TempFileOutputStream stream(path);
+        stream.write(&header, sizeof(header));
+        stream.write(binary.data(), written);
+        stream.close();
+    } catch (const std::exception &e) {
+        logger->warning("OpenGL: could not write shader binary cache '{}': {}", path, e.what());
+    }
+}
+
+std::string OpenGLShaderCache::path(std::string_view name) const {
+    return (std::filesystem::path(_directory) / (std::string(name) + ".bin")).string();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+/**
+ * On-disk cache of linked shader program binaries, implemented on top of `glGetProgramBinary` / `glProgramBinary`.
+ *
+ * Each program is stored in a separate file in the cache directory, together with a key that's a hash of the
+ * program sources and of the driver vendor / renderer / version strings. So cached binaries are dropped both when
+ * the shaders are edited and when the driver is updated. Drivers are also free to reject binaries they don't like,
+ * in which case `load` just fails and the program should be compiled from source.
+ */
+class OpenGLShaderCache {
+ public:
+    OpenGLShaderCache() = default;
+
+    /**
+     * Enables the cache. Does nothing if the driver doesn't support any program binary formats.
+     *
+     * @param directory                 Directory to store the cached binaries in. Created on first write.
+     */
+    void initialize(std::string_view directory);
+
+    [[nodiscard]] bool isEnabled() const {
+        return !_directory.empty();
+    }
+
+    /**
+     * @param sources                   Sources of all shader stages of a program, concatenated.
+     * @return                          Cache key for the provided sources.
+     */
+    [[nodiscard]] uint64_t key(std::string_view sources) const;
+
+    /**
+     * @param name                      Program name, used as a file name in the cache directory.
+     * @param key                       Cache key, as returned by `key`.
+     * @return                          Newly created & linked program, or zero if there is no matching binary in the
+     *                                  cache, or if the driver rejected it.
+     */
+    [[nodiscard]] GLuint load(std::string_view name, uint64_t key) const;
+
+    /**
+     * Stores the binary of a linked program in the cache. The program should be created with
+     * `GL_PROGRAM_BINARY_RETRIEVABLE_HINT` set. Failures are logged and otherwise ignored.
+     *
+     * @param name                      Program name, used as a file name in the cache directory.
+     * @param key                       Cache key, as returned by `key`.
+     * @param program                   Linked program.
+     */
+    void save(std::string_view name, uint64_t key, GLuint program) const;
+
+ private:
+    [[nodiscard]] std::string path(std::string_view name) const;
+
+ private:
+    std::string _directory; // Empty if disabled.
+    uint64_t _driverHash = 0;
+};
@@ -0,0 +1,98 @@
+#include "OpenGLSpriteAtlas.h"
+
+#include <optional>
+#include <vector>
+
+#include "Utility/Memory/MemoryAccounting.h"
+
+#include "OpenGLState.h"
+
+static constexpr size_t PAGE_BYTES = static_cast<size_t>(OpenGLSpriteAtlas::PAGE_SIZE) * OpenGLSpriteAtlas::PAGE_SIZE;
+
+void OpenGLSpriteAtlas::release() {
+    for (Page &page : _pages) {
+        openGLState.deleteTextures(1, &page.texture);
+        MemoryAccounting::deallocate(MEMORY_TAG_GPU_TEXTURES, PAGE_BYTES);
+    }
+    _pages.clear();
+    _slotByTexture.clear();
+}
+
+const OpenGLSpriteAtlas::Slot &OpenGLSpriteAtlas::findOrInsert(GLuint texture, GrayscaleImageView image) {
+    auto [pos, inserted] = _slotByTexture.try_emplace(texture);
+    Slot &slot = pos->second;
+    if (!inserted)
+        return slot;
+
+    // Failures are remembered too, so that we don't retry every frame.
+    if (!image || image.width() > MAX_SPRITE_SIZE || image.height() > MAX_SPRITE_SIZE)
+        return slot;
+
+    Sizei paddedSize(image.width() + 2 * PADDING, image.height() + 2 * PADDING);
+    std::optional<Pointi> position;
+    Page *page = nullptr;
+    for (Page &candidate : _pages) {
+        position = candidate.packer.insert(paddedSize);
+        if (position) {
+            page = &candidate;
+            break;
+        }
+    }
+
+    if (!page) {
+        if (!addPage())
+            return slot;
+        page = &_pages.back();
+        position = page->packer.insert(paddedSize);
+        if (!position)
+            return slot;
+    }
+
+    int x = position->x + PADDING;
+    int y = position->y + PADDING;
+    openGLState.bindTexture(GL_TEXTURE_2D, page->texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, image.width(), image.height(), GL_RED, GL_UNSIGNED_BYTE,
+                    image.pixels().data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
+
+    float scale = 1.0f / PAGE_SIZE;
+    slot.texture = page->texture;
+    slot.u0 = x * scale;
+    slot.v0 = y * scale;
+    slot.u1 = (x + image.width()) * scale;
+    slot.v1 = (y + image.height()) * scale;
+    return slot;
+}
+
+void OpenGLSpriteAtlas::remove(GLuint texture) {
+    _slotByTexture.erase(texture);
+}
+
+bool OpenGLSpriteAtlas::addPage() {
+    if (_pages.size() >= MAX_PAGE_COUNT)
+        return false;
+
+    Page &page = _pages.emplace_back();
+    page.packer.reset(Sizei(PAGE_SIZE, PAGE_SIZE));
+
+    // Pages start out filled with index zero, which is transparent. This also takes care of the padding.
+    std::vector<uint8_t> zeros(PAGE_BYTES, 0);
+    glGenTextures(1, &page.texture);
+    openGLState.bindTexture(GL_TEXTURE_2D, page.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, PAGE_SIZE, PAGE_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, zeros.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ZERO);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ZERO);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
+    openGLState.bindTexture(GL_TEXTURE_2D, 0);
+
+    MemoryAccounting::allocate(MEMORY_TAG_GPU_TEXTURES, PAGE_BYTES);
+    return true;
+}
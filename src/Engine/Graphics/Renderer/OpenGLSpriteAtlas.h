@@ -0,0 +1,77 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+#include "Library/Image/Image.h"
+#include "Library/Image/SkylinePacker.h"
+
+/**
+ * Atlas for paletted sprites, packs sprite indices into a few large single-channel texture pages so that billboards
+ * that use different sprites can be drawn in a single batch.
+ *
+ * Sprites are identified by the GL texture that they were originally uploaded into, and are added to the atlas
+ * lazily, on first use. There is no way to free the space of a single sprite, the whole atlas is reset on map change
+ * instead. Once all the pages are full, new sprites are not added, and should be drawn from their own textures.
+ *
+ * Pages use the same texture swizzle as `Renderer::CreateIndexedTexture` textures, so shaders don't need to know
+ * whether they are sampling the atlas.
+ */
+class OpenGLSpriteAtlas {
+ public:
+    static constexpr int PAGE_SIZE = 2048;
+    static constexpr int MAX_PAGE_COUNT = 4;
+    static constexpr int MAX_SPRITE_SIZE = 512; // Larger sprites are not worth packing.
+    static constexpr int PADDING = 1; // Zero-index border around each sprite, so that edge texels don't bleed.
+
+    struct Slot {
+        GLuint texture = 0; // Atlas page, zero if this sprite is not in the atlas.
+        float u0 = 0.0f;
+        float v0 = 0.0f;
+        float u1 = 0.0f;
+        float v1 = 0.0f;
+    };
+
+    OpenGLSpriteAtlas() = default;
+
+    /**
+     * Destroys all the pages. Must be called with the OpenGL context still alive.
+     */
+    void release();
+
+    /**
+     * Looks up a sprite in the atlas, adding it if it's not there yet.
+     *
+     * @param texture                   GL texture of the sprite.
+     * @param image                     Sprite indices, only used if the sprite needs to be added.
+     * @return                          Atlas slot for the sprite. Slot with zero `texture` means that the sprite
+     *                                  didn't make it into the atlas.
+     */
+    const Slot &findOrInsert(GLuint texture, GrayscaleImageView image);
+
+    /**
+     * Forgets a sprite, should be called when the sprite's own texture is deleted, as GL might reuse the id. Space
+     * taken by the sprite is reclaimed on the next `release`.
+     *
+     * @param texture                   GL texture of the sprite.
+     */
+    void remove(GLuint texture);
+
+    [[nodiscard]] size_t pageCount() const {
+        return _pages.size();
+    }
+
+ private:
+    struct Page {
+        GLuint texture = 0;
+        SkylinePacker packer;
+    };
+
+    bool addPage();
+
+ private:
+    std::vector<Page> _pages;
+    std::unordered_map<GLuint, Slot> _slotByTexture;
+};
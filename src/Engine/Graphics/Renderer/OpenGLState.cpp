@@ -0,0 +1,181 @@
+#include "OpenGLState.h"
+
+#include <algorithm>
+
+OpenGLState openGLState;
+
+void OpenGLState::invalidate() {
+    _program = UNKNOWN;
+    _vertexArray = UNKNOWN;
+    _activeUnit = UNKNOWN;
+    for (auto &unit : _textures)
+        unit.fill(UNKNOWN);
+    _caps.fill(-1);
+    _blendFunc.fill(UNKNOWN);
+    _depthMask = UNKNOWN;
+    _depthFunc = UNKNOWN;
+    _cullFace = UNKNOWN;
+    _frontFace = UNKNOWN;
+    _viewportKnown = false;
+    _scissorKnown = false;
+}
+
+void OpenGLState::useProgram(GLuint program) {
+    if (skip(_program == program))
+        return;
+    _program = program;
+    glUseProgram(program);
+}
+
+void OpenGLState::bindVertexArray(GLuint array) {
+    if (skip(_vertexArray == array))
+        return;
+    _vertexArray = array;
+    glBindVertexArray(array);
+}
+
+void OpenGLState::activeTexture(GLenum unit) {
+    GLenum index = unit - GL_TEXTURE0;
+    if (skip(_activeUnit == index))
+        return;
+    _activeUnit = index;
+    glActiveTexture(unit);
+}
+
+void OpenGLState::bindTexture(GLenum target, GLuint texture) {
+    TextureTarget slot = TextureTarget::COUNT;
+    switch (target) {
+        case GL_TEXTURE_2D: slot = TextureTarget::TEXTURE_2D; break;
+        case GL_TEXTURE_2D_ARRAY: slot = TextureTarget::TEXTURE_2D_ARRAY; break;
+        case GL_TEXTURE_BUFFER: slot = TextureTarget::TEXTURE_BUFFER; break;
+        default: break;
+    }
+
+    if (slot == TextureTarget::COUNT || _activeUnit >= UNIT_COUNT) {
+        glBindTexture(target, texture); // Not tracked.
+        return;
+    }
+
+    GLuint &bound = _textures[_activeUnit][static_cast<int>(slot)];
+    if (skip(bound == texture))
+        return;
+    bound = texture;
+    glBindTexture(target, texture);
+}
+
+void OpenGLState::deleteProgram(GLuint program) {
+    // Program stays in use until another one is bound, but its name is free for reuse.
+    if (_program == program)
+        _program = UNKNOWN;
+    glDeleteProgram(program);
+}
+
+void OpenGLState::deleteVertexArrays(GLsizei n, const GLuint *arrays) {
+    if (std::find(arrays, arrays + n, _vertexArray) != arrays + n)
+        _vertexArray = 0;
+    glDeleteVertexArrays(n, arrays);
+}
+
+void OpenGLState::deleteTextures(GLsizei n, const GLuint *textures) {
+    for (auto &unit : _textures)
+        for (GLuint &bound : unit)
+            if (bound != UNKNOWN && bound != 0 && std::find(textures, textures + n, bound) != textures + n)
+                bound = 0;
+    glDeleteTextures(n, textures);
+}
+
+void OpenGLState::enable(GLenum cap) {
+    setCap(cap, true);
+}
+
+void OpenGLState::disable(GLenum cap) {
+    setCap(cap, false);
+}
+
+void OpenGLState::blendFunc(GLenum sfactor, GLenum dfactor) {
+    if (skip(_blendFunc[0] == sfactor && _blendFunc[1] == dfactor))
+        return;
+    _blendFunc = {sfactor, dfactor};
+    glBlendFunc(sfactor, dfactor);
+}
+
+void OpenGLState::depthMask(GLboolean flag) {
+    if (skip(_depthMask == flag))
+        return;
+    _depthMask = flag;
+    glDepthMask(flag);
+}
+
+void OpenGLState::depthFunc(GLenum func) {
+    if (skip(_depthFunc == func))
+        return;
+    _depthFunc = func;
+    glDepthFunc(func);
+}
+
+void OpenGLState::cullFace(GLenum mode) {
+    if (skip(_cullFace == mode))
+        return;
+    _cullFace = mode;
+    glCullFace(mode);
+}
+
+void OpenGLState::frontFace(GLenum mode) {
+    if (skip(_frontFace == mode))
+        return;
+    _frontFace = mode;
+    glFrontFace(mode);
+}
+
+void OpenGLState::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    std::array<GLint, 4> box = {x, y, width, height};
+    if (skip(_viewportKnown && _viewport == box))
+        return;
+    _viewport = box;
+    _viewportKnown = true;
+    glViewport(x, y, width, height);
+}
+
+void OpenGLState::scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    std::array<GLint, 4> box = {x, y, width, height};
+    if (skip(_scissorKnown && _scissor == box))
+        return;
+    _scissor = box;
+    _scissorKnown = true;
+    glScissor(x, y, width, height);
+}
+
+void OpenGLState::nextFrame() {
+    _lastAvoidedCalls = _avoidedCalls;
+    _avoidedCalls = 0;
+}
+
+void OpenGLState::setCap(GLenum cap, bool enabled) {
+    Cap slot = Cap::COUNT;
+    switch (cap) {
+        case GL_BLEND: slot = Cap::BLEND; break;
+        case GL_DEPTH_TEST: slot = Cap::DEPTH_TEST; break;
+        case GL_CULL_FACE: slot = Cap::CULL_FACE; break;
+        case GL_SCISSOR_TEST: slot = Cap::SCISSOR_TEST; break;
+        default: break;
+    }
+
+    if (slot != Cap::COUNT) {
+        int &state = _caps[static_cast<int>(slot)];
+        if (skip(state == static_cast<int>(enabled)))
+            return;
+        state = enabled;
+    }
+
+    if (enabled) {
+        glEnable(cap);
+    } else {
+        glDisable(cap);
+    }
+}
+
+bool OpenGLState::skip(bool unchanged) {
+    if (unchanged)
+        _avoidedCalls++;
+    return unchanged;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+/**
+ * Shadow copy of the OpenGL state that the renderer changes most often - bound program, vertex array & textures,
+ * blend / depth / cull / scissor state, viewport & scissor box. Calls that wouldn't change anything are dropped
+ * before they reach the driver.
+ *
+ * Methods mirror the GL functions they replace. For this to work, all code that changes the tracked state must go
+ * through this class, otherwise the shadow copy goes stale. If some code had to bypass it, call `invalidate`.
+ *
+ * Deleting objects must also go through this class. GL unbinds deleted objects, and the names are then reused for
+ * the newly created ones, so a stale binding in the shadow copy could make us skip binding a new object.
+ */
+class OpenGLState {
+ public:
+    OpenGLState() {
+        invalidate();
+    }
+
+    /**
+     * Forgets all tracked state, next calls for every piece of state will go to the driver. Must be called after a
+     * new context is created.
+     */
+    void invalidate();
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint array);
+    void activeTexture(GLenum unit);
+    void bindTexture(GLenum target, GLuint texture);
+
+    void deleteProgram(GLuint program);
+    void deleteVertexArrays(GLsizei n, const GLuint *arrays);
+    void deleteTextures(GLsizei n, const GLuint *textures);
+
+    void enable(GLenum cap);
+    void disable(GLenum cap);
+    void blendFunc(GLenum sfactor, GLenum dfactor);
+    void depthMask(GLboolean flag);
+    void depthFunc(GLenum func);
+    void cullFace(GLenum mode);
+    void frontFace(GLenum mode);
+    void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    void scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    /**
+     * Starts a new frame for the call counters.
+     */
+    void nextFrame();
+
+    /**
+     * @return                          Number of calls that were dropped in the last frame.
+     */
+    [[nodiscard]] int avoidedCalls() const {
+        return _lastAvoidedCalls;
+    }
+
+ private:
+    enum class Cap {
+        BLEND,
+        DEPTH_TEST,
+        CULL_FACE,
+        SCISSOR_TEST,
+        COUNT
+    };
+
+    enum class TextureTarget {
+        TEXTURE_2D,
+        TEXTURE_2D_ARRAY,
+        TEXTURE_BUFFER,
+        COUNT
+    };
+
+    static constexpr GLuint UNKNOWN = 0xFFFFFFFF; // Not a valid name or enum value.
+    static constexpr int UNIT_COUNT = 16;
+
+    void setCap(GLenum cap, bool enabled);
+    bool skip(bool unchanged);
+
+ private:
+    GLuint _program = UNKNOWN;
+    GLuint _vertexArray = UNKNOWN;
+    GLenum _activeUnit = UNKNOWN; // As an index, not as a `GL_TEXTUREi` value.
+    std::array<std::array<GLuint, static_cast<int>(TextureTarget::COUNT)>, UNIT_COUNT> _textures = {};
+    std::array<int, static_cast<int>(Cap::COUNT)> _caps = {}; // -1 for unknown.
+    std::array<GLenum, 2> _blendFunc = {};
+    GLuint _depthMask = UNKNOWN;
+    GLenum _depthFunc = UNKNOWN;
+    GLenum _cullFace = UNKNOWN;
+    GLenum _frontFace = UNKNOWN;
+    std::array<GLint, 4> _viewport = {};
+    std::array<GLint, 4> _scissor = {};
+    bool _viewportKnown = false;
+    bool _scissorKnown = false;
+    int _avoidedCalls = 0;
+    int _lastAvoidedCalls = 0;
+};
+
+extern OpenGLState openGLState;
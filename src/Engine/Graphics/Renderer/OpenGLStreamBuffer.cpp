@@ -0,0 +1,190 @@
+#include "OpenGLStreamBuffer.h"
+
+#include <cassert>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "Library/Logger/Logger.h"
+#include "Library/Platform/Interface/PlatformOpenGLContext.h"
+
+#include "Utility/Memory/MemoryAccounting.h"
+
+// Our glad loader is generated for OpenGL 4.1 & OpenGL ES 3.2, and buffer storage is not a part of either,
+// so we're loading it by hand.
+#ifndef GL_MAP_PERSISTENT_BIT
+#   define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#   define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+using BufferStorageProc = void (GLAD_API_PTR *)(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+
+static constexpr GLbitfield PERSISTENT_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+static bool hasExtension(std::string_view name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++)
+        if (reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i)) == name)
+            return true;
+    return false;
+}
+
+static BufferStorageProc loadBufferStorage(PlatformOpenGLContext *context, bool isOpenGLES) {
+    if (isOpenGLES) {
+        if (!hasExtension("GL_EXT_buffer_storage"))
+            return nullptr;
+        return reinterpret_cast<BufferStorageProc>(context->getProcAddress("glBufferStorageEXT"));
+    } else {
+        GLint major = 0, minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        if ((major < 4 || (major == 4 && minor < 4)) && !hasExtension("GL_ARB_buffer_storage"))
+            return nullptr;
+        return reinterpret_cast<BufferStorageProc>(context->getProcAddress("glBufferStorage"));
+    }
+}
+
+static size_t alignUp(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+void OpenGLStreamBuffer::initialize(PlatformOpenGLContext *context, bool isOpenGLES, size_t segmentSize) {
+    assert(!isInitialized());
+
+    _segmentSize = segmentSize;
+    _segment = 0;
+    _offset = 0;
+
+    glGenBuffers(1, &_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+
+    if (BufferStorageProc bufferStorage = loadBufferStorage(context, isOpenGLES)) {
+        bufferStorage(GL_ARRAY_BUFFER, _segmentSize * FRAME_COUNT, nullptr, PERSISTENT_FLAGS);
+        _mapping = static_cast<unsigned char *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, _segmentSize * FRAME_COUNT, PERSISTENT_FLAGS));
+        if (!_mapping) {
+            // Immutable storage can't be re-specified, so we need a new buffer for the fallback path.
+            logger->warning("OpenGL: could not map stream buffer persistently, falling back to buffer orphaning");
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDeleteBuffers(1, &_buffer);
+            glGenBuffers(1, &_buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+        }
+    }
+
+    if (_mapping) {
+        logger->info("OpenGL: using persistently mapped stream buffer, {} x {} KiB", FRAME_COUNT, _segmentSize / 1024);
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, _segmentSize, nullptr, GL_STREAM_DRAW);
+        logger->info("OpenGL: buffer storage is not supported, using orphaned stream buffer, {} KiB", _segmentSize / 1024);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    MemoryAccounting::allocate(MEMORY_TAG_GPU_BUFFERS, storageSize());
+}
+
+void OpenGLStreamBuffer::release() {
+    if (!isInitialized())
+        return;
+
+    MemoryAccounting::deallocate(MEMORY_TAG_GPU_BUFFERS, storageSize());
+
+    for (GLsync &fence : _fences) {
+        if (fence)
+            glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    if (_mapping) {
+        glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        _mapping = nullptr;
+    }
+
+    glDeleteBuffers(1, &_buffer);
+    _buffer = 0;
+    _segmentSize = 0;
+    _segment = 0;
+    _offset = 0;
+}
+
+GLint OpenGLStreamBuffer::upload(const void *data, size_t size, size_t stride) {
+    return upload(size, stride, [&](void *dst) { memcpy(dst, data, size); });
+}
+
+GLint OpenGLStreamBuffer::upload(size_t size, size_t stride, const std::function<void(void *)> &fill) {
+    assert(isInitialized());
+    assert(size <= _segmentSize && stride > 0);
+
+    size_t segmentBase = _segment * _segmentSize;
+    size_t offset = alignUp(segmentBase + _offset, stride);
+    if (offset + size > segmentBase + _segmentSize) {
+        if (_mapping) {
+            nextSegment();
+        } else {
+            // Orphan, the driver will hand us fresh storage while the draws from the old one are still in flight.
+            glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+            glBufferData(GL_ARRAY_BUFFER, _segmentSize, nullptr, GL_STREAM_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            _offset = 0;
+        }
+
+        segmentBase = _segment * _segmentSize;
+        offset = alignUp(segmentBase, stride);
+    }
+
+    if (_mapping) {
+        fill(_mapping + offset);
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+        void *dst = glMapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (dst) {
+            fill(dst);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        } else {
+            std::vector<unsigned char> data(size);
+            fill(data.data());
+            glBufferSubData(GL_ARRAY_BUFFER, offset, size, data.data());
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    _offset = offset + size - segmentBase;
+    return static_cast<GLint>(offset / stride);
+}
+
+void OpenGLStreamBuffer::nextFrame() {
+    if (!isInitialized() || !_mapping || _offset == 0)
+        return;
+
+    nextSegment();
+}
+
+void OpenGLStreamBuffer::nextSegment() {
+    assert(_mapping);
+
+    // Fence off the draws that use the current segment.
+    if (_fences[_segment])
+        glDeleteSync(_fences[_segment]);
+    _fences[_segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // And wait for the GPU to be done with the next one.
+    _segment = (_segment + 1) % FRAME_COUNT;
+    _offset = 0;
+    if (GLsync fence = _fences[_segment]) {
+        GLenum status = GL_TIMEOUT_EXPIRED;
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        while (status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(fence, flags, 1'000'000'000);
+            flags = 0; // Only need to flush once.
+        }
+        if (status == GL_WAIT_FAILED)
+            logger->warning("OpenGL: waiting on stream buffer fence failed");
+
+        glDeleteSync(fence);
+        _fences[_segment] = nullptr;
+    }
+}
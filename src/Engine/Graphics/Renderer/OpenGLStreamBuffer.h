@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+class PlatformOpenGLContext;
+
+/**
+ * Streaming vertex buffer that's shared by all the passes in `OpenGLRenderer` that re-upload their geometry every
+ * frame.
+ *
+ * If `ARB_buffer_storage` (`EXT_buffer_storage` on GLES) is available, this is a persistently mapped buffer that's
+ * split into `FRAME_COUNT` segments, one per frame in flight. Each segment is guarded by a fence, so we only wait
+ * for the GPU if it's lagging more than `FRAME_COUNT - 1` frames behind. Otherwise this falls back to a single buffer
+ * that's written through unsynchronized mappings and is orphaned once it's full.
+ *
+ * Uploads are aligned at vertex stride, so VAOs can point at the start of the buffer, and the draw calls just need
+ * to add the base vertex returned from `upload` to their `first` argument.
+ *
+ * Nothing here is specific to vertex data, so the same class is also used as a staging pixel unpack buffer for
+ * texture uploads, with `stride` being the size of a pixel.
+ */
+class OpenGLStreamBuffer {
+ public:
+    OpenGLStreamBuffer() = default;
+
+    /**
+     * @param context                   OpenGL context to load the extension functions from.
+     * @param isOpenGLES                Whether the context is an OpenGL ES one.
+     * @param segmentSize               Size of a single segment, in bytes. This is the max size of a single upload.
+     */
+    void initialize(PlatformOpenGLContext *context, bool isOpenGLES, size_t segmentSize);
+
+    /**
+     * Destroys the underlying buffer. Must be called with the OpenGL context still alive.
+     */
+    void release();
+
+    [[nodiscard]] bool isInitialized() const {
+        return _buffer != 0;
+    }
+
+    /**
+     * @return                          Underlying OpenGL buffer object.
+     */
+    [[nodiscard]] GLuint id() const {
+        return _buffer;
+    }
+
+    /**
+     * @return                          Size of a single segment, in bytes. This is the max size of a single upload.
+     */
+    [[nodiscard]] size_t segmentSize() const {
+        return _segmentSize;
+    }
+
+    /**
+     * @return                          Whether the persistently mapped path is used.
+     */
+    [[nodiscard]] bool isPersistent() const {
+        return _mapping != nullptr;
+    }
+
+    /**
+     * @return                          Size of the buffer storage, in bytes. In fallback mode the driver might keep
+     *                                  more than this around for the orphaned storage.
+     */
+    [[nodiscard]] size_t storageSize() const {
+        return _mapping ? _segmentSize * FRAME_COUNT : _segmentSize;
+    }
+
+    /**
+     * @param data                      Vertex data to upload.
+     * @param size                      Size of the vertex data, in bytes. Must not exceed the segment size.
+     * @param stride                    Size of a single vertex, in bytes.
+     * @return                          Index of the first uploaded vertex in the buffer.
+     */
+    [[nodiscard]] GLint upload(const void *data, size_t size, size_t stride);
+
+    /**
+     * Same as `upload`, but instead of copying the data from client memory lets the caller write it straight into
+     * the buffer.
+     *
+     * @param size                      Size of the data, in bytes. Must not exceed the segment size.
+     * @param stride                    Size of a single vertex, in bytes.
+     * @param fill                      Function that writes `size` bytes of data into the provided pointer.
+     * @return                          Index of the first uploaded vertex in the buffer.
+     */
+    [[nodiscard]] GLint upload(size_t size, size_t stride, const std::function<void(void *)> &fill);
+
+    template<class T>
+    [[nodiscard]] GLint upload(const T *vertices, size_t count) {
+        return upload(vertices, count * sizeof(T), sizeof(T));
+    }
+
+    /**
+     * Marks the end of a frame. Must be called after all the draw calls that use the data uploaded in this frame
+     * were issued.
+     */
+    void nextFrame();
+
+ private:
+    void nextSegment();
+
+ private:
+    static constexpr size_t FRAME_COUNT = 3;
+
+    GLuint _buffer = 0;
+    size_t _segmentSize = 0;
+    unsigned char *_mapping = nullptr; // Persistent mapping of the whole buffer, nullptr in fallback mode.
+    std::array<GLsync, FRAME_COUNT> _fences = {};
+    size_t _segment = 0; // Current segment, always 0 in fallback mode.
+    size_t _offset = 0; // Write offset inside the current segment.
+};
@@ -0,0 +1,103 @@
+#include "OpenGLTextureArrayPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "Utility/MapAccess.h"
+#include "Utility/Memory/MemoryAccounting.h"
+
+#include "OpenGLState.h"
+#include "OpenGLTextureArrayUploader.h"
+
+const OpenGLTextureArrayPool::Slot *OpenGLTextureArrayPool::find(const std::string &name) const {
+    return valuePtr(_slotByName, name);
+}
+
+OpenGLTextureArrayPool::Slot OpenGLTextureArrayPool::insert(const std::string &name, int width, int height) {
+    assert(!_slotByName.contains(name));
+
+    if (_maxLayers == 0) {
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &_maxLayers);
+        _maxLayers = std::max(_maxLayers, 1);
+    }
+
+    // Going from the back so that we get the last, non-full array of the right size.
+    int index = _arrays.size() - 1;
+    for (; index >= 0; index--)
+        if (_arrays[index].width == width && _arrays[index].height == height)
+            break;
+
+    if (index < 0 || static_cast<int>(_arrays[index].names.size()) >= _maxLayers) {
+        index = _arrays.size();
+        TextureArray &array = _arrays.emplace_back();
+        array.width = width;
+        array.height = height;
+    }
+
+    TextureArray &array = _arrays[index];
+    Slot result = {index, static_cast<int>(array.names.size())};
+    array.names.push_back(name);
+    _slotByName.emplace(name, result);
+    return result;
+}
+
+void OpenGLTextureArrayPool::commit(const Loader &loader, OpenGLTextureArrayUploader *uploader) {
+    for (TextureArray &array : _arrays) {
+        int size = array.names.size();
+        if (array.uploaded == size && array.mipBias >= _mipBias)
+            continue;
+
+        openGLState.activeTexture(GL_TEXTURE0);
+
+        if (size > array.capacity || array.mipBias < _mipBias) {
+            // Need to reallocate. We don't have glCopyImageSubData in GL 4.1, so all layers are re-uploaded.
+            // Capacity grows geometrically so that adding textures one by one doesn't do this on every commit.
+            openGLState.deleteTextures(1, &array.texture);
+            if (array.byteSize)
+                MemoryAccounting::deallocate(MEMORY_TAG_GPU_TEXTURES, std::exchange(array.byteSize, 0));
+            if (size > array.capacity) {
+                array.capacity = array.capacity == 0 ? size :
+                                 std::min(_maxLayers, std::max(size, array.capacity * 3 / 2));
+            }
+            array.uploaded = 0;
+            array.mipBias = std::max(array.mipBias, _mipBias);
+
+            glGenTextures(1, &array.texture);
+            openGLState.bindTexture(GL_TEXTURE_2D_ARRAY, array.texture);
+            array.byteSize = uploader->allocate(array.width, array.height, array.capacity, array.mipBias);
+            MemoryAccounting::allocate(MEMORY_TAG_GPU_TEXTURES, array.byteSize);
+
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        } else {
+            openGLState.bindTexture(GL_TEXTURE_2D_ARRAY, array.texture);
+        }
+
+        for (int layer = array.uploaded; layer < size; layer++) {
+            const RgbaImage &image = loader(array.names[layer]);
+            assert(image.width() == array.width && image.height() == array.height);
+
+            uploader->upload(layer, image, array.mipBias);
+        }
+        array.uploaded = size;
+
+        uploader->finish();
+    }
+
+    openGLState.bindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void OpenGLTextureArrayPool::setMipBias(int mipBias) {
+    _mipBias = mipBias;
+}
+
+void OpenGLTextureArrayPool::release() {
+    for (TextureArray &array : _arrays) {
+        openGLState.deleteTextures(1, &array.texture);
+        if (array.byteSize)
+            MemoryAccounting::deallocate(MEMORY_TAG_GPU_TEXTURES, array.byteSize);
+    }
+    _arrays.clear();
+    _slotByName.clear();
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+#include "Library/Image/Image.h"
+
+class OpenGLTextureArrayUploader;
+
+/**
+ * Pool of `GL_TEXTURE_2D_ARRAY` textures, bucketed by texture size.
+ *
+ * Each texture that's added to the pool gets a slot - an index of the array it was put into, and a layer inside that
+ * array. Size classes are created on demand, and once an array reaches the max number of layers supported by the
+ * driver, another array of the same size is started. So the number of arrays depends only on the number of distinct
+ * texture sizes, and draw calls can be batched per array.
+ *
+ * GL textures are (re-)created lazily in `commit`, so new textures can be added at any time, e.g. when an animated
+ * face switches to a frame that wasn't seen when the level was loaded.
+ */
+class OpenGLTextureArrayPool {
+ public:
+    struct Slot {
+        int array = 0;
+        int layer = 0;
+    };
+
+    using Loader = std::function<const RgbaImage &(const std::string &)>;
+
+    /**
+     * @param name                      Texture name.
+     * @return                          Slot for the texture with the given name, or `nullptr` if it's not in the pool.
+     */
+    [[nodiscard]] const Slot *find(const std::string &name) const;
+
+    /**
+     * Adds a texture to the pool. Texture data is loaded only on the next call to `commit`.
+     *
+     * @param name                      Texture name. Must not be in the pool.
+     * @param width                     Texture width.
+     * @param height                    Texture height.
+     * @return                          Slot for the newly added texture.
+     */
+    Slot insert(const std::string &name, int width, int height);
+
+    /**
+     * Uploads all textures that were added since the last call to GL, growing the arrays as needed.
+     *
+     * @param loader                    Function to get pixel data for a texture by its name.
+     * @param uploader                  Uploader to use, decides on the texture format.
+     */
+    void commit(const Loader &loader, OpenGLTextureArrayUploader *uploader);
+
+    /**
+     * Deletes all GL textures and clears the pool.
+     */
+    void release();
+
+    /**
+     * Sets the mip bias for the texture arrays in this pool, see `OpenGLTextureArrayUploader`. Arrays that were
+     * uploaded with a lower bias are re-created on the next call to `commit`.
+     *
+     * @param mipBias                   Number of top mip levels to drop.
+     */
+    void setMipBias(int mipBias);
+
+    /**
+     * @param array                     Texture array index.
+     * @return                          Width of the textures in the given array. Actual GL texture can be smaller if
+     *                                  it was allocated with a mip bias.
+     */
+    [[nodiscard]] int width(int array) const {
+        return _arrays[array].width;
+    }
+
+    /**
+     * @param array                     Texture array index.
+     * @return                          Height of the textures in the given array, see `width`.
+     */
+    [[nodiscard]] int height(int array) const {
+        return _arrays[array].height;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return _arrays.empty();
+    }
+
+    /**
+     * @return                          Number of texture arrays in this pool.
+     */
+    [[nodiscard]] int arrayCount() const {
+        return _arrays.size();
+    }
+
+    /**
+     * @param array                     Texture array index.
+     * @return                          GL texture for the given array, only valid after a call to `commit`.
+     */
+    [[nodiscard]] GLuint texture(int array) const {
+        return _arrays[array].texture;
+    }
+
+ private:
+    struct TextureArray {
+        int width = 0;
+        int height = 0;
+        std::vector<std::string> names; // Texture names, by layer.
+        GLuint texture = 0;
+        int capacity = 0; // Number of layers allocated in `texture`.
+        int uploaded = 0; // Number of layers that were already uploaded to `texture`.
+        size_t byteSize = 0; // Estimated size of `texture` in bytes, for memory accounting.
+        int mipBias = 0; // Mip bias that `texture` was allocated with.
+    };
+
+ private:
+    std::vector<TextureArray> _arrays;
+    std::unordered_map<std::string, Slot> _slotByName;
+    int _maxLayers = 0;
+    int _mipBias = 0;
+};
@@ -0,0 +1,137 @@
+#include "OpenGLTextureArrayUploader.h"
+
+#include <algorithm>
+#include <cassert>
+#include <string_view>
+
+#include "Library/Image/TextureCompression.h"
+#include "Library/Logger/Logger.h"
+
+// S3TC is not a part of either OpenGL 4.1 or OpenGL ES 3.2, so our glad loader doesn't know about it.
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#   define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+
+static bool hasExtension(std::string_view name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++)
+        if (reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i)) == name)
+            return true;
+    return false;
+}
+
+void OpenGLTextureArrayUploader::initialize(bool isOpenGLES, bool compress, std::string_view cachePath) {
+    release();
+
+    if (!compress)
+        return;
+
+    if (isOpenGLES || !hasExtension("GL_EXT_texture_compression_s3tc")) {
+        logger->info("OpenGL: S3TC is not supported, world textures won't be compressed");
+        return;
+    }
+
+    _compressed = true;
+    logger->info("OpenGL: using BC1-compressed world textures");
+
+    if (!cachePath.empty()) {
+        try {
+            _cache.open(cachePath);
+        } catch (const std::exception &e) {
+            logger->warning("Could not open compressed texture cache '{}', proceeding without it: {}", cachePath, e.what());
+        }
+    }
+}
+
+void OpenGLTextureArrayUploader::release() {
+    _compressed = false;
+    _cache.close();
+}
+
+/**
+ * @param width                         Texture width.
+ * @param height                        Texture height.
+ * @param mipBias                       Requested mip bias.
+ * @return                              Mip bias clamped so that at least one mip level is left.
+ */
+static int clampMipBias(int width, int height, int mipBias) {
+    return std::clamp(mipBias, 0, mipLevelCount(width, height) - 1);
+}
+
+size_t OpenGLTextureArrayUploader::allocate(int width, int height, int layers, int mipBias) {
+    mipBias = clampMipBias(width, height, mipBias);
+    width = std::max(1, width >> mipBias);
+    height = std::max(1, height >> mipBias);
+    int levels = mipLevelCount(width, height);
+
+    if (!_compressed) {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        // `finish` calls glGenerateMipmap, so the driver will allocate the full mip chain.
+        size_t result = 0;
+        for (int level = 0; level < levels; level++) {
+            result += static_cast<size_t>(width) * height * layers * 4;
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+        }
+        return result;
+    }
+
+    size_t result = 0;
+    for (int level = 0; level < levels; level++) {
+        size_t size = bc1CompressedSize(width, height) * layers;
+        glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, width, height, layers, 0,
+                               size, NULL);
+        result += size;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return result;
+}
+
+void OpenGLTextureArrayUploader::upload(int layer, RgbaImageView image, int mipBias) {
+    assert(image);
+
+    mipBias = clampMipBias(image.width(), image.height(), mipBias);
+
+    if (!_compressed) {
+        RgbaImage downsampled;
+        for (int i = 0; i < mipBias; i++)
+            downsampled = downsampleImage(i == 0 ? image : RgbaImageView(downsampled));
+        if (mipBias > 0)
+            image = downsampled;
+
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, image.width(), image.height(), 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                        image.pixels().data());
+        return;
+    }
+
+    // Biased levels are just skipped in the mip chain, so that the cache doesn't need to know about the bias.
+    Blob data = _cache.isOpen() ? _cache.compressBC1MipChain(image) : compressBC1MipChain(image);
+    const char *pos = static_cast<const char *>(data.data());
+    int width = image.width();
+    int height = image.height();
+    for (int level = 0, levels = mipLevelCount(width, height); level < levels; level++) {
+        size_t size = bc1CompressedSize(width, height);
+        if (level >= mipBias) {
+            glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level - mipBias, 0, 0, layer, width, height, 1,
+                                      GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, size, pos);
+        }
+        pos += size;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    assert(pos == static_cast<const char *>(data.data()) + data.size());
+}
+
+void OpenGLTextureArrayUploader::finish() {
+    // Compressed textures come with precomputed mips.
+    if (!_compressed)
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string_view>
+
+#include <glad/gl.h> // NOLINT: this is not a C system include.
+
+#include "Library/Image/Image.h"
+#include "Library/Image/TextureCompressionCache.h"
+
+/**
+ * Helper for filling `GL_TEXTURE_2D_ARRAY` textures with world textures.
+ *
+ * By default textures are stored as `GL_RGBA8`, and sampled without mips. If texture compression is enabled and the
+ * driver supports S3TC, textures are stored as BC1 with a full precomputed mip chain, and sampled with trilinear
+ * filtering. This cuts texture memory 8x (but we're also adding a third on top for the mips), and gets rid of
+ * shimmering on distant surfaces. Compressed mip chains are cached on disk, so compression cost is only paid once
+ * per texture.
+ *
+ * Textures can also be stored with a mip bias, meaning that the top levels of the mip chain are dropped. This is used
+ * to lower the video memory usage when running low on it. Texture arrays are then smaller than the images uploaded
+ * into them, so shaders that work with texel coordinates need to know the original texture size.
+ *
+ * Usage is `allocate`, then `upload` for each layer, then `finish`, all with the texture array bound. Same mip bias
+ * must be passed to `allocate` and `upload`.
+ */
+class OpenGLTextureArrayUploader {
+ public:
+    OpenGLTextureArrayUploader() = default;
+
+    /**
+     * @param isOpenGLES                Whether the context is an OpenGL ES one. Compression is not supported on ES.
+     * @param compress                  Whether texture compression was requested.
+     * @param cachePath                 Path to the compressed texture cache file, empty to not use a cache.
+     */
+    void initialize(bool isOpenGLES, bool compress, std::string_view cachePath);
+
+    void release();
+
+    [[nodiscard]] bool isCompressed() const {
+        return _compressed;
+    }
+
+    /**
+     * Allocates storage for the texture array that's currently bound to `GL_TEXTURE_2D_ARRAY`, and sets up
+     * min & mag filters for it.
+     *
+     * @param width                     Texture width.
+     * @param height                    Texture height.
+     * @param layers                    Number of layers.
+     * @param mipBias                   Number of top mip levels to drop.
+     * @return                          Estimated size of the allocated storage in bytes, including the mips.
+     */
+    size_t allocate(int width, int height, int layers, int mipBias = 0);
+
+    /**
+     * @param layer                     Layer to upload into.
+     * @param image                     Texture data for the layer. Must be of the size passed to `allocate`.
+     * @param mipBias                   Number of top mip levels to drop, must be the same as passed to `allocate`.
+     */
+    void upload(int layer, RgbaImageView image, int mipBias = 0);
+
+    /**
+     * Must be called once all the layers were uploaded. Generates mips if needed.
+     */
+    void finish();
+
+ private:
+    bool _compressed = false;
+    TextureCompressionCache _cache;
+};
@@ -0,0 +1,35 @@
+#include "RenderPrepTimers.h"
+
+#include <algorithm>
+
+#include "Library/Logger/Logger.h"
+#include "Library/Serialization/Serialization.h"
+
+RenderPrepTimers *renderPrepTimers = nullptr;
+
+void RenderPrepTimers::logSummary() const {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    Duration total = {};
+    for (RenderPrepPhase phase : _totals.indices())
+        total += _totals[phase];
+
+    int64_t frames = std::max<int64_t>(_frameCount, 1);
+    logger->info("Render prep timings over {} frames:", _frameCount);
+    for (RenderPrepPhase phase : _totals.indices()) {
+        logger->info("    {:<16}{:>10.2f} ms total, {:>8.4f} ms per frame", toString(phase),
+                     Milliseconds(_totals[phase]).count(), Milliseconds(_totals[phase]).count() / frames);
+    }
+    logger->info("    {:<16}{:>10.2f} ms total, {:>8.4f} ms per frame", "all",
+                 Milliseconds(total).count(), Milliseconds(total).count() / frames);
+}
+
+RenderPrepTimerScope::RenderPrepTimerScope(RenderPrepPhase phase) : _phase(phase) {
+    if (renderPrepTimers)
+        _start = std::chrono::steady_clock::now();
+}
+
+RenderPrepTimerScope::~RenderPrepTimerScope() {
+    if (renderPrepTimers)
+        renderPrepTimers->add(_phase, std::chrono::steady_clock::now() - _start);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "Utility/IndexedArray.h"
+
+#include "RendererEnums.h"
+
+/**
+ * CPU timers for the render prep phases - BSP traversal, billboard transform, decal clipping, etc.
+ *
+ * Unlike `OpenGLPassTimers`, these are not tied to a renderer, the phases are timed wherever they are run. The
+ * timings are only collected if `renderPrepTimers` is set, which is done for the runs started with `--render-prep`.
+ * Combined with `--headless` this gives a way to benchmark the CPU side of rendering without any GPU or driver
+ * noise - when the timers are installed `NullRenderer` also runs the CPU work that it'd normally skip.
+ */
+class RenderPrepTimers {
+ public:
+    using Duration = std::chrono::steady_clock::duration;
+    using Timings = IndexedArray<Duration, RENDER_PREP_FIRST, RENDER_PREP_LAST>;
+
+    RenderPrepTimers() = default;
+
+    void add(RenderPrepPhase phase, Duration duration) {
+        _totals[phase] += duration;
+    }
+
+    /**
+     * Marks the end of a frame in which the 3D world was drawn.
+     */
+    void nextFrame() {
+        _frameCount++;
+    }
+
+    [[nodiscard]] int64_t frameCount() const {
+        return _frameCount;
+    }
+
+    /**
+     * @return                          Total time spent in each of the phases since the timers were created.
+     */
+    [[nodiscard]] const Timings &totals() const {
+        return _totals;
+    }
+
+    /**
+     * Logs total & per-frame times for all phases.
+     */
+    void logSummary() const;
+
+ private:
+    Timings _totals = {{}};
+    int64_t _frameCount = 0;
+};
+
+class RenderPrepTimerScope {
+ public:
+    explicit RenderPrepTimerScope(RenderPrepPhase phase);
+    ~RenderPrepTimerScope();
+
+    RenderPrepTimerScope(const RenderPrepTimerScope &) = delete;
+    RenderPrepTimerScope &operator=(const RenderPrepTimerScope &) = delete;
+
+ private:
+    RenderPrepPhase _phase;
+    std::chrono::steady_clock::time_point _start;
+};
+
+extern RenderPrepTimers *renderPrepTimers;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -7,12 +9,17 @@
 #include "Engine/Graphics/Nuklear.h"
 
 #include "Library/Image/Image.h"
+#include "Library/Image/Palette.h"
 #include "Library/Color/Color.h"
 #include "Library/Color/ColorTable.h"
 #include "Library/Geometry/Rect.h"
 
+#include "Utility/IndexedArray.h"
+
 #include "TextureRenderId.h"
+#include "RendererEnums.h"
 #include "Engine/Graphics/RenderEntities.h"
+#include "Engine/Graphics/RenderList.h"
 
 class Actor;
 class GraphicsImage;
@@ -31,6 +38,12 @@ class File;
 
 bool PauseGameDrawing();
 
+struct VideoMemoryInfo {
+    int64_t totalSize = -1; // Total video memory as reported by the driver, in bytes, -1 if unknown.
+    int64_t availableSize = -1; // Available video memory as reported by the driver, in bytes, -1 if unknown.
+    int textureMipBias = 0; // Number of top mip levels that are currently dropped for the world textures.
+};
+
 // TODO(captainurist): rename Renderer
 class Renderer {
  public:
@@ -91,6 +104,20 @@ class Renderer {
 
     virtual void DrawBillboards_And_MaybeRenderSpecialEffects_And_EndScene() = 0;
     virtual void BillboardSphereSpellFX(struct SpellFX_Billboard *a1, Color diffuse) = 0;
+
+    /**
+     * Starts a billboard batch. Billboards that are added until the matching `EndBillboardBatch` call are appended
+     * to `pBillboardRenderListD3D`, and are then merged into it all at once, instead of each of them being inserted
+     * at its sorted position separately. The resulting order is the same.
+     *
+     * Batches can't be nested, and `pBillboardRenderListD3D` shouldn't be read while a batch is in progress.
+     */
+    virtual void BeginBillboardBatch() = 0;
+
+    /**
+     * Ends a billboard batch started with `BeginBillboardBatch`, sorting the new billboards into the render list.
+     */
+    virtual void EndBillboardBatch() = 0;
     virtual void TransformBillboardsAndSetPalettesODM() = 0;
 
     virtual void DrawProjectile(float srcX, float srcY, float a3, float a4,
@@ -98,6 +125,25 @@ class Renderer {
                                 GraphicsImage *texture) = 0;
 
     virtual TextureRenderId CreateTexture(RgbaImageView image) = 0;
+
+    /**
+     * Creates a single-channel texture for a paletted image. Shaders see the palette index in the red channel, and
+     * index zero is transparent, same as for the textures created from `makeIndexRgbaImage` images.
+     *
+     * @param image                     Palette indices.
+     * @return                          Id of the created texture.
+     */
+    virtual TextureRenderId CreateIndexedTexture(GrayscaleImageView image) = 0;
+
+    /**
+     * Creates an RGBA texture for a paletted image. Same as `CreateTexture(makeRgbaImage(image, palette))`, but the
+     * palette is expanded straight into the upload buffer when possible, without an intermediate RGBA image.
+     *
+     * @param image                     Palette indices.
+     * @param palette                   Palette to apply.
+     * @return                          Id of the created texture.
+     */
+    virtual TextureRenderId CreatePalettedTexture(GrayscaleImageView image, const Palette &palette) = 0;
     virtual void DeleteTexture(TextureRenderId id) = 0;
     virtual void UpdateTexture(TextureRenderId id, RgbaImageView image) = 0;
 
@@ -137,6 +183,17 @@ class Renderer {
                               unsigned int uWidth, unsigned int uHeight,
                               Color uColor32) = 0;
 
+    /**
+     * Draws falling snow over the game viewport. Flakes are fully determined by their index, the seed & the time, so
+     * the renderer doesn't need to keep any per-flake state.
+     *
+     * @param flakeCount                Number of flakes to draw.
+     * @param seed                      Seed for flake positions, sizes & speeds.
+     * @param time                      Time since the snow started, in seconds.
+     * @param windOffset                Horizontal offset of all flakes, in pixels.
+     */
+    virtual void DrawSnow(int flakeCount, uint32_t seed, float time, float windOffset) = 0;
+
     virtual void DrawOutdoorBuildings() = 0;
 
     virtual void DrawIndoorSky(unsigned int uNumVertices, int uFaceID = 0) = 0;
@@ -162,6 +219,23 @@ class Renderer {
     virtual void SavePCXScreenshot() = 0;
     virtual RgbaImage MakeScreenshot32(int width, int height) = 0;
 
+    /**
+     * Same as `MakeScreenshot32`, but doesn't wait for the GPU to finish. The returned future becomes ready in one of
+     * the following `Present` calls, or in `FinishScreenshots`.
+     *
+     * Waiting on the returned future on the game thread without calling `FinishScreenshots` first will deadlock.
+     *
+     * @param width                         Final width of image to create.
+     * @param height                        Final height of image to create.
+     * @return                              Future for the screenshot.
+     */
+    virtual std::future<RgbaImage> RequestScreenshot32(int width, int height) = 0;
+
+    /**
+     * Blocks until all screenshots requested with `RequestScreenshot32` are ready.
+     */
+    virtual void FinishScreenshots() = 0;
+
     virtual std::vector<Actor *> getActorsInViewport(int pDepth) = 0;
 
     virtual void BeginLightmaps() = 0;
@@ -194,14 +268,36 @@ class Renderer {
     virtual void ReloadShaders() = 0;
     virtual void DoRenderBillboards_D3D() = 0;
 
+    /**
+     * @return                          GPU time in milliseconds spent in each of the render passes, as measured a
+     *                                  couple of frames ago. All zeros if the renderer doesn't support GPU timers.
+     */
+    virtual IndexedArray<float, RENDER_PASS_FIRST, RENDER_PASS_LAST> GetPassTimings() = 0;
+
+    /**
+     * @return                          Smoothed time in milliseconds from the start of a frame, when its input is
+     *                                  processed, to the GPU finishing it. Zero if not measured, see
+     *                                  `graphics.MaxFramesInFlight`.
+     */
+    virtual float GetFrameLatency() = 0;
+
+    /**
+     * @return                          Number of redundant state changes that were filtered out in the last frame.
+     */
+    virtual int GetAvoidedStateChanges() = 0;
+
+    /**
+     * @return                          Video memory info, as of the last residency check.
+     */
+    virtual VideoMemoryInfo GetVideoMemoryInfo() = 0;
+
     std::shared_ptr<GameConfig> config = nullptr;
     int *pActiveZBuffer;
     Color uFogColor;
     int hd_water_current_frame;
     GraphicsImage *hd_water_tile_anim[7];
-    RenderBillboardD3D pBillboardRenderListD3D[1000];
-    unsigned int uNumBillboardsToDraw; // TODO(captainurist): this is not properly cleared if BeginScene3D is not called,
-                                       //                     resulting in dangling textures in pBillboardRenderListD3D.
+    RenderList<RenderBillboardD3D> pBillboardRenderListD3D; // TODO(captainurist): this is not properly cleared if BeginScene3D
+                                                             //                     is not called, resulting in dangling textures.
 
     int drawcalls;
 
@@ -214,8 +310,7 @@ class Renderer {
 extern Renderer *render;
 
 extern int uNumDecorationsDrawnThisFrame;
-extern RenderBillboard pBillboardRenderList[500];
-extern unsigned int uNumBillboardsToDraw;
+extern RenderList<RenderBillboard> pBillboardRenderList;
 extern int uNumSpritesDrawnThisFrame;
 
 extern RenderVertexSoft array_507D30[50];
@@ -8,3 +8,25 @@ MM_DEFINE_ENUM_SERIALIZATION_FUNCTIONS(RendererType, CASE_INSENSITIVE, {
     {RENDERER_OPENGL_ES,    "OpenGL_ES"},
     {RENDERER_NULL,         "Null"}
 })
+
+MM_DEFINE_ENUM_SERIALIZATION_FUNCTIONS(RenderPass, CASE_INSENSITIVE, {
+    {RENDER_PASS_TERRAIN,           "terrain"},
+    {RENDER_PASS_OUTDOOR_BUILDINGS, "outdoor_buildings"},
+    {RENDER_PASS_INDOOR_FACES,      "indoor_faces"},
+    {RENDER_PASS_BILLBOARDS,        "billboards"},
+    {RENDER_PASS_DECALS,            "decals"},
+    {RENDER_PASS_WEATHER,           "weather"},
+    {RENDER_PASS_TEXT,              "text"},
+    {RENDER_PASS_TWOD,              "twod"},
+    {RENDER_PASS_NUKLEAR,           "nuklear"}
+})
+
+MM_DEFINE_ENUM_SERIALIZATION_FUNCTIONS(RenderPrepPhase, CASE_INSENSITIVE, {
+    {RENDER_PREP_BSP,               "bsp"},
+    {RENDER_PREP_ACTORS,            "actors"},
+    {RENDER_PREP_DECORATIONS,       "decorations"},
+    {RENDER_PREP_SPRITE_OBJECTS,    "sprite_objects"},
+    {RENDER_PREP_BILLBOARDS,        "billboards"},
+    {RENDER_PREP_DECALS,            "decals"},
+    {RENDER_PREP_PARTICLES,         "particles"}
+})
@@ -9,3 +9,41 @@ enum class RendererType {
 };
 using enum RendererType;
 MM_DECLARE_SERIALIZATION_FUNCTIONS(RendererType)
+
+/**
+ * Render passes that `Renderer` can report GPU timings for.
+ */
+enum class RenderPass {
+    RENDER_PASS_TERRAIN,
+    RENDER_PASS_OUTDOOR_BUILDINGS,
+    RENDER_PASS_INDOOR_FACES,
+    RENDER_PASS_BILLBOARDS,
+    RENDER_PASS_DECALS,
+    RENDER_PASS_WEATHER,
+    RENDER_PASS_TEXT,
+    RENDER_PASS_TWOD,
+    RENDER_PASS_NUKLEAR,
+
+    RENDER_PASS_FIRST = RENDER_PASS_TERRAIN,
+    RENDER_PASS_LAST = RENDER_PASS_NUKLEAR
+};
+using enum RenderPass;
+MM_DECLARE_SERIALIZATION_FUNCTIONS(RenderPass)
+
+/**
+ * CPU-side phases of preparing a 3D frame for rendering, see `RenderPrepTimers`.
+ */
+enum class RenderPrepPhase {
+    RENDER_PREP_BSP,
+    RENDER_PREP_ACTORS,
+    RENDER_PREP_DECORATIONS,
+    RENDER_PREP_SPRITE_OBJECTS,
+    RENDER_PREP_BILLBOARDS,
+    RENDER_PREP_DECALS,
+    RENDER_PREP_PARTICLES,
+
+    RENDER_PREP_FIRST = RENDER_PREP_BSP,
+    RENDER_PREP_LAST = RENDER_PREP_PARTICLES
+};
+using enum RenderPrepPhase;
+MM_DECLARE_SERIALIZATION_FUNCTIONS(RenderPrepPhase)
@@ -0,0 +1,18 @@
+#include "SectorCollisionFaces.h"
+
+#include "Indoor.h"
+
+SectorCollisionFaces::SectorCollisionFaces(std::span<const BLVSector> sectors, std::span<const BLVFace> faces) {
+    _sectorStarts.reserve(sectors.size() + 1);
+    _sectorStarts.push_back(0);
+    for (const BLVSector &sector : sectors) {
+        // Floors, walls & ceilings are stored contiguously, starting at pFloors.
+        int totalFaces = sector.uNumFloors + sector.uNumWalls + sector.uNumCeilings;
+        for (int i = 0; i < totalFaces; i++) {
+            int faceId = sector.pFloors[i];
+            _faceIds.push_back(faceId);
+            _faceBounds.push_back(faces[faceId].pBounding);
+        }
+        _sectorStarts.push_back(_faceIds.size());
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "Library/Geometry/BBox.h"
+
+struct BLVSector;
+struct BLVFace;
+
+/**
+ * Packed per-sector lists of the faces that indoor collision code checks against - floors, walls & ceilings.
+ *
+ * Built when a level is loaded. Face ids and bounding boxes for each sector are stored contiguously, so that the
+ * broadphase in `CollideIndoorWithGeometry` can reject most of the faces without touching `BLVFace` at all.
+ *
+ * Face bounding boxes don't change when doors move, so the cached boxes stay valid for the lifetime of the level.
+ * Face planes & attributes do change, so these are not cached and should be taken from `BLVFace`.
+ */
+class SectorCollisionFaces {
+ public:
+    SectorCollisionFaces() = default;
+
+    /**
+     * @param sectors                   Location sectors.
+     * @param faces                     Location faces.
+     */
+    SectorCollisionFaces(std::span<const BLVSector> sectors, std::span<const BLVFace> faces);
+
+    /**
+     * @param sectorId                  Sector id.
+     * @return                          Ids of the floors, walls & ceilings of the provided sector.
+     */
+    [[nodiscard]] std::span<const int> faceIds(int sectorId) const {
+        return std::span<const int>(_faceIds).subspan(_sectorStarts[sectorId], sectorSize(sectorId));
+    }
+
+    /**
+     * @param sectorId                  Sector id.
+     * @return                          Bounding boxes of the faces returned by `faceIds`, in the same order.
+     */
+    [[nodiscard]] std::span<const BBoxi> faceBounds(int sectorId) const {
+        return std::span<const BBoxi>(_faceBounds).subspan(_sectorStarts[sectorId], sectorSize(sectorId));
+    }
+
+ private:
+    [[nodiscard]] size_t sectorSize(int sectorId) const {
+        return _sectorStarts[sectorId + 1] - _sectorStarts[sectorId];
+    }
+
+ private:
+    std::vector<int> _sectorStarts; // Offsets into the arrays below, one for each sector plus one past the end.
+    std::vector<int> _faceIds;
+    std::vector<BBoxi> _faceBounds;
+};
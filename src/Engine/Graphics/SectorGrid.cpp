@@ -0,0 +1,52 @@
+#include "SectorGrid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+
+#include "Indoor.h"
+
+SectorGrid::SectorGrid(std::span<const BLVSector> sectors, int slack) {
+    assert(slack >= 0);
+
+    if (sectors.size() < 2)
+        return;
+
+    int maxX = INT_MIN;
+    int maxY = INT_MIN;
+    _minX = INT_MAX;
+    _minY = INT_MAX;
+    for (size_t i = 1; i < sectors.size(); i++) {
+        const BBoxi &bounds = sectors[i].pBounding;
+        _minX = std::min(_minX, bounds.x1 - slack);
+        _minY = std::min(_minY, bounds.y1 - slack);
+        maxX = std::max(maxX, bounds.x2 + slack);
+        maxY = std::max(maxY, bounds.y2 + slack);
+    }
+
+    _width = ((maxX - _minX) >> CELL_SHIFT) + 1;
+    _height = ((maxY - _minY) >> CELL_SHIFT) + 1;
+
+    auto forEachCell = [&](const BBoxi &bounds, auto &&callback) {
+        int cellX1 = (bounds.x1 - slack - _minX) >> CELL_SHIFT;
+        int cellX2 = (bounds.x2 + slack - _minX) >> CELL_SHIFT;
+        int cellY1 = (bounds.y1 - slack - _minY) >> CELL_SHIFT;
+        int cellY2 = (bounds.y2 + slack - _minY) >> CELL_SHIFT;
+        for (int cellY = cellY1; cellY <= cellY2; cellY++)
+            for (int cellX = cellX1; cellX <= cellX2; cellX++)
+                callback(cellY * _width + cellX);
+    };
+
+    // Counting sort into cells. Sectors are added in ascending id order, so cell lists come out sorted.
+    std::vector<int> counts(_width * _height + 1, 0);
+    for (size_t i = 1; i < sectors.size(); i++)
+        forEachCell(sectors[i].pBounding, [&](int cell) { counts[cell + 1]++; });
+
+    for (size_t i = 1; i < counts.size(); i++)
+        counts[i] += counts[i - 1];
+    _cellStarts = counts;
+
+    _sectorIds.resize(_cellStarts.back());
+    for (size_t i = 1; i < sectors.size(); i++)
+        forEachCell(sectors[i].pBounding, [&](int cell) { _sectorIds[counts[cell]++] = i; });
+}
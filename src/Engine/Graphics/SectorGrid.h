@@ -0,0 +1,55 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+struct BLVSector;
+
+/**
+ * Static uniform grid over the XY bounding boxes of the sectors of an indoor location.
+ *
+ * Built when a level is loaded, and used by `IndoorLocation::GetSector` to look only at the few sectors that might
+ * contain the point instead of going through all of them. Each cell lists the ids of the sectors that overlap it, in
+ * ascending order, so that the lookup visits the sectors in the same order as a loop over all sectors would.
+ */
+class SectorGrid {
+ public:
+    static constexpr int CELL_SHIFT = 10;
+    static constexpr int CELL_SIZE = 1 << CELL_SHIFT;
+
+    SectorGrid() = default;
+
+    /**
+     * @param sectors                   Location sectors. Sector zero is a dummy one and is not added to the grid.
+     * @param slack                     Sector bounding boxes are expanded by this amount in X & Y before being added
+     *                                  to the grid.
+     */
+    SectorGrid(std::span<const BLVSector> sectors, int slack);
+
+    /**
+     * @param x                         X coordinate.
+     * @param y                         Y coordinate.
+     * @return                          Ids of the sectors whose expanded XY bounding boxes might contain the provided
+     *                                  point, in ascending order. Empty if the point is outside of the grid.
+     */
+    [[nodiscard]] std::span<const int> candidates(int x, int y) const {
+        if (x < _minX || y < _minY)
+            return {};
+
+        int cellX = (x - _minX) >> CELL_SHIFT;
+        int cellY = (y - _minY) >> CELL_SHIFT;
+        if (cellX >= _width || cellY >= _height)
+            return {};
+
+        int cell = cellY * _width + cellX;
+        return std::span<const int>(_sectorIds).subspan(_cellStarts[cell], _cellStarts[cell + 1] - _cellStarts[cell]);
+    }
+
+ private:
+    int _minX = 0;
+    int _minY = 0;
+    int _width = 0;
+    int _height = 0;
+    std::vector<int> _cellStarts; // Offsets into _sectorIds, one for each cell plus one past the end.
+    std::vector<int> _sectorIds;
+};
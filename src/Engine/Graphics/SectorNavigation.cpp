@@ -0,0 +1,107 @@
+#include "SectorNavigation.h"
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "Indoor.h"
+
+// Portals with normals closer than this to the Z axis are treated as holes in floors & ceilings.
+static constexpr float HORIZONTAL_PORTAL_NORMAL_Z = 0.7f;
+
+// Cache is dropped once it grows past this, sector pairs that actors actually query are few.
+static constexpr size_t MAX_CACHE_SIZE = 16384;
+
+static float distance(const Vec3i &l, const Vec3i &r) {
+    float dx = l.x - r.x;
+    float dy = l.y - r.y;
+    float dz = l.z - r.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+SectorNavigation::SectorNavigation(std::span<const BLVSector> sectors, std::span<const BLVFace> faces) {
+    _sectorCount = sectors.size();
+    _edges.resize(_sectorCount);
+    _sectorCenters.resize(_sectorCount);
+
+    std::unordered_map<int, int> portalByFace;
+    for (int from = 0; from < _sectorCount; from++) {
+        const BLVSector &sector = sectors[from];
+        _sectorCenters[from] = sector.pBounding.center();
+
+        for (int i = 0; i < sector.uNumPortals; i++) {
+            int faceId = sector.pPortals[i];
+            const BLVFace &portal = faces[faceId];
+
+            // Same logic as in Detect_Between_Objects.
+            int to = portal.uSectorID == from ? portal.uBackSectorID : portal.uSectorID;
+            if (to == from || to < 0 || to >= _sectorCount)
+                continue;
+
+            auto [pos, inserted] = portalByFace.try_emplace(faceId, _portalCenters.size());
+            if (inserted)
+                _portalCenters.push_back(portal.pBounding.center());
+
+            bool horizontal = std::abs(portal.facePlane.normal.z) > HORIZONTAL_PORTAL_NORMAL_Z;
+            _edges[from].push_back(Edge{to, pos->second, horizontal});
+        }
+    }
+}
+
+std::optional<Vec3i> SectorNavigation::nextWaypoint(int from, int to, bool flying) {
+    if (from == to || from < 0 || to < 0 || from >= _sectorCount || to >= _sectorCount)
+        return std::nullopt;
+
+    uint64_t key = (static_cast<uint64_t>(from) << 33) | (static_cast<uint64_t>(to) << 1) | (flying ? 1 : 0);
+    auto pos = _firstPortalCache.find(key);
+    if (pos == _firstPortalCache.end()) {
+        if (_firstPortalCache.size() >= MAX_CACHE_SIZE)
+            _firstPortalCache.clear();
+        pos = _firstPortalCache.emplace(key, findFirstPortal(from, to, flying)).first;
+    }
+
+    if (pos->second < 0)
+        return std::nullopt;
+    return _portalCenters[pos->second];
+}
+
+int SectorNavigation::findFirstPortal(int from, int to, bool flying) const {
+    // Dijkstra over sectors. Each sector is entered at the center of some portal, path length is the sum of the
+    // distances between consecutive portal centers. The start sector is entered at its center.
+    std::vector<float> costs(_sectorCount, std::numeric_limits<float>::infinity());
+    std::vector<int> entryPortals(_sectorCount, -1);
+    std::vector<int> firstPortals(_sectorCount, -1);
+
+    using QueueItem = std::pair<float, int>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+    costs[from] = 0.0f;
+    queue.emplace(0.0f, from);
+
+    while (!queue.empty()) {
+        auto [cost, sector] = queue.top();
+        queue.pop();
+        if (cost > costs[sector])
+            continue;
+        if (sector == to)
+            return firstPortals[to];
+
+        const Vec3i &entry = entryPortals[sector] < 0 ? _sectorCenters[sector] : _portalCenters[entryPortals[sector]];
+        for (const Edge &edge : _edges[sector]) {
+            if (edge.horizontal && !flying)
+                continue;
+
+            float nextCost = cost + distance(entry, _portalCenters[edge.portal]);
+            if (nextCost >= costs[edge.sector])
+                continue;
+
+            costs[edge.sector] = nextCost;
+            entryPortals[edge.sector] = edge.portal;
+            firstPortals[edge.sector] = sector == from ? edge.portal : firstPortals[sector];
+            queue.emplace(nextCost, edge.sector);
+        }
+    }
+
+    return -1;
+}
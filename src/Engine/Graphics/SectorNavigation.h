@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Library/Geometry/Vec.h"
+
+struct BLVSector;
+struct BLVFace;
+
+/**
+ * Sector-to-sector navigation graph for an indoor location. Sectors are the nodes, portals are the edges, and the
+ * center of each portal is used as a waypoint.
+ *
+ * Paths are found with Dijkstra over portal centers, only the first portal of each path is returned. Actors are
+ * expected to ask again once they cross into the next sector, so the results are cached per (from, to) pair.
+ *
+ * Nearly horizontal portals (holes in floors & ceilings) can only be used by flying actors.
+ */
+class SectorNavigation {
+ public:
+    SectorNavigation() = default;
+
+    /**
+     * @param sectors                   Location sectors.
+     * @param faces                     Location faces, portal ids in `sectors` index into this array.
+     */
+    SectorNavigation(std::span<const BLVSector> sectors, std::span<const BLVFace> faces);
+
+    /**
+     * @param from                      Sector to start from.
+     * @param to                        Target sector.
+     * @param flying                    Whether horizontal portals can be used.
+     * @return                          Center of the first portal to go through to get from `from` to `to`, or
+     *                                  `std::nullopt` if the sectors are the same, out of range, or not connected.
+     */
+    [[nodiscard]] std::optional<Vec3i> nextWaypoint(int from, int to, bool flying);
+
+ private:
+    struct Edge {
+        int sector = 0; // Sector on the other side of the portal.
+        int portal = 0; // Index into `_portalCenters`.
+        bool horizontal = false;
+    };
+
+    /**
+     * @return                          Index of the first portal on the shortest path, or -1 if there is no path.
+     */
+    int findFirstPortal(int from, int to, bool flying) const;
+
+ private:
+    int _sectorCount = 0;
+    std::vector<std::vector<Edge>> _edges; // Per sector.
+    std::vector<Vec3i> _portalCenters;
+    std::vector<Vec3i> _sectorCenters;
+    std::unordered_map<uint64_t, int> _firstPortalCache;
+};
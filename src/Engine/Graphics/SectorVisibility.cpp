@@ -0,0 +1,96 @@
+#include "SectorVisibility.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+#include "Indoor.h"
+
+static int boxGap(const BBoxi &l, const BBoxi &r) {
+    int gapX = std::max({0, r.x1 - l.x2, l.x1 - r.x2});
+    int gapY = std::max({0, r.y1 - l.y2, l.y1 - r.y2});
+    int gapZ = std::max({0, r.z1 - l.z2, l.z1 - r.z2});
+    return std::max({gapX, gapY, gapZ});
+}
+
+static int otherSide(const BLVFace &portal, int sectorId) {
+    // Same logic as in Detect_Between_Objects.
+    return portal.uSectorID == sectorId ? portal.uBackSectorID : portal.uSectorID;
+}
+
+SectorVisibility::SectorVisibility(std::span<const BLVSector> sectors, std::span<const BLVFace> faces,
+                                   int maxDistance, int maxDepth) {
+    assert(maxDistance >= 0 && maxDepth >= 0);
+
+    _sectorCount = sectors.size();
+    _rowWords = (_sectorCount + 63) / 64;
+    _bits.assign(_rowWords * _sectorCount, 0);
+
+    auto mark = [&](int from, int to) {
+        size_t bit = static_cast<size_t>(from) * _rowWords * 64 + to;
+        _bits[bit / 64] |= uint64_t(1) << (bit % 64);
+    };
+
+    // All the portals crossed by a line of sight check intersect the bounding box of the checked segment, and this
+    // box is at most maxDistance wide. Adding a unit of slack so that we don't need to think about rounding.
+    int maxGap = maxDistance + 1;
+
+    std::vector<int> depths(_sectorCount);
+    std::vector<int> queue;
+    for (int from = 0; from < _sectorCount; from++) {
+        mark(from, from);
+
+        const BLVSector &sector = sectors[from];
+        for (int i = 0; i < sector.uNumPortals; i++) {
+            const BLVFace &firstPortal = faces[sector.pPortals[i]];
+            int first = otherSide(firstPortal, from);
+            if (first == from || first < 0 || first >= _sectorCount)
+                continue;
+
+            // BFS from the other side of the first portal, only going through the portals that are close enough to
+            // the first one.
+            std::ranges::fill(depths, -1);
+            queue.clear();
+            depths[first] = 1;
+            queue.push_back(first);
+            for (size_t head = 0; head < queue.size(); head++) {
+                int current = queue[head];
+                mark(from, current);
+                if (depths[current] >= maxDepth)
+                    continue;
+
+                const BLVSector &currentSector = sectors[current];
+                for (int j = 0; j < currentSector.uNumPortals; j++) {
+                    const BLVFace &portal = faces[currentSector.pPortals[j]];
+                    int next = otherSide(portal, current);
+                    if (next == current || next < 0 || next >= _sectorCount || depths[next] != -1)
+                        continue;
+                    if (boxGap(firstPortal.pBounding, portal.pBounding) > maxGap)
+                        continue;
+
+                    depths[next] = depths[current] + 1;
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+}
+
+std::optional<bool> SectorVisibility::cachedLineOfSight(const Vec3i &pos1, int sector1,
+                                                        const Vec3i &pos2, int sector2) const {
+    auto pos = _cache.find(CacheKey(pos1, pos2, sector1, sector2));
+    if (pos == _cache.end())
+        return std::nullopt;
+    return pos->second;
+}
+
+void SectorVisibility::cacheLineOfSight(const Vec3i &pos1, int sector1, const Vec3i &pos2, int sector2, bool visible) {
+    _cache[CacheKey(pos1, pos2, sector1, sector2)] = visible;
+}
+
+size_t SectorVisibility::CacheKeyHash::operator()(const CacheKey &key) const {
+    size_t result = 0;
+    for (int value : {key.pos1.x, key.pos1.y, key.pos1.z, key.pos2.x, key.pos2.y, key.pos2.z, key.sector1, key.sector2})
+        result = result * 0x100000001b3ull ^ std::hash<int>()(value);
+    return result;
+}
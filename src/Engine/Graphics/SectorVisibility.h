@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Library/Geometry/Vec.h"
+
+struct BLVSector;
+struct BLVFace;
+
+/**
+ * Sector-to-sector potentially visible set for an indoor location, plus a cache of exact line of sight results.
+ *
+ * The set is conservative w.r.t. the portal walk in `Detect_Between_Objects`: sector `b` is marked as potentially
+ * visible from sector `a` if `b` can be reached from `a` in at most `maxDepth` portal crossings, with all the crossed
+ * portals lying within `maxDistance` of the first one on each axis. The walk can't do better than that, so if the
+ * set says no then the walk would have said no too, and the result of the check doesn't change.
+ *
+ * Note that the relation is not symmetric.
+ */
+class SectorVisibility {
+ public:
+    SectorVisibility() = default;
+
+    /**
+     * @param sectors                   Location sectors.
+     * @param faces                     Location faces, portal ids in `sectors` index into this array.
+     * @param maxDistance               Max distance between the objects that the line of sight checks are done for.
+     * @param maxDepth                  Max number of portal crossings in a line of sight check.
+     */
+    SectorVisibility(std::span<const BLVSector> sectors, std::span<const BLVFace> faces, int maxDistance, int maxDepth);
+
+    /**
+     * @return                          Whether an object in sector `to` might be visible from sector `from`. Returns
+     *                                  `true` for sector ids that are out of range.
+     */
+    [[nodiscard]] bool potentiallyVisible(int from, int to) const {
+        if (from < 0 || to < 0 || from >= _sectorCount || to >= _sectorCount)
+            return true;
+        size_t bit = static_cast<size_t>(from) * _rowWords * 64 + to;
+        return (_bits[bit / 64] >> (bit % 64)) & 1;
+    }
+
+    /**
+     * Line of sight results are a pure function of the endpoints & their sectors, so they can be safely cached. The
+     * cache should still be cleared regularly (e.g. once per AI tick) to keep it small, as objects keep moving.
+     *
+     * @return                          Cached line of sight result for the given endpoints, if any.
+     */
+    [[nodiscard]] std::optional<bool> cachedLineOfSight(const Vec3i &pos1, int sector1,
+                                                        const Vec3i &pos2, int sector2) const;
+
+    void cacheLineOfSight(const Vec3i &pos1, int sector1, const Vec3i &pos2, int sector2, bool visible);
+
+    void clearCache() {
+        _cache.clear();
+    }
+
+ private:
+    struct CacheKey {
+        Vec3i pos1;
+        Vec3i pos2;
+        int sector1 = 0;
+        int sector2 = 0;
+
+        friend bool operator==(const CacheKey &l, const CacheKey &r) = default;
+    };
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey &key) const;
+    };
+
+ private:
+    int _sectorCount = 0;
+    size_t _rowWords = 0;
+    std::vector<uint64_t> _bits; // Row-major bitmatrix, row `a` holds the sectors potentially visible from `a`.
+    std::unordered_map<CacheKey, bool, CacheKeyHash> _cache;
+};
@@ -29,134 +29,107 @@ void SpriteFrameTable::ResetLoadedFlags() {
         spriteFrame.uFlags &= ~0x80;
 }
 
+/**
+ * @param frame                         Sprite frame.
+ * @param sequenceFlags                 Flags of the first frame in the frame sequence that `frame` belongs to.
+ * @param octant                        View octant, in [0, 7].
+ * @return                              Name of the sprite in sprites LOD for the given octant.
+ */
+static std::string spriteOctantName(const SpriteFrame &frame, int sequenceFlags, int octant) {
+    const std::string &name = frame.texture_name;
+
+    if (sequenceFlags & 0x10) { // single frame per frame sequence
+        return name;
+    } else if (sequenceFlags & 0x10000) {
+        switch (octant) {
+        case 3:
+        case 4:
+        case 5:
+            return name + "4";
+        case 2:
+        case 6:
+            return name + "2";
+        default: // 0, 1, 7.
+            return name + "0";
+        }
+    } else if (sequenceFlags & 0x40) { // part of monster fidgeting seq
+        switch (octant) {
+        case 0:
+            return name + "0";
+        case 4:
+            return name.substr(0, name.size() - 3) + "stA4";
+        case 3:
+        case 5:
+            return name.substr(0, name.size() - 3) + "stA3";
+        case 2:
+        case 6:
+            return name + "2";
+        default: // 1, 7.
+            return name + "1";
+        }
+    } else if (octant != 0 && ((0x0100 << octant) & frame.uFlags)) { // mirrors
+        return fmt::format("{}{}", name, 8 - octant);
+    } else if (name.size() < 7) {
+        return fmt::format("{}{}", name, octant);
+    } else {
+        return name; // some names already passed through with codes attached
+    }
+}
+
 //----- (0044D513) --------------------------------------------------------
 void SpriteFrameTable::InitializeSprite(signed int uSpriteID) {
-    std::string spriteName;
-
-    if (uSpriteID <= pSpriteSFrames.size()) {
-        if (uSpriteID >= 0) {
-            unsigned iter_uSpriteID = uSpriteID;
-            //if (iter_uSpriteID == 603) assert(false);
-
-            int uFlags = pSpriteSFrames[iter_uSpriteID].uFlags;
-
-            if (!(uFlags & 0x0080)) {  // not loaded
-                pSpriteSFrames[iter_uSpriteID].uFlags |= 0x80;  // set loaded
-
-                while (1) {
-                    pSpriteSFrames[iter_uSpriteID].ResetPaletteIndex(pPaletteManager->paletteIndex(pSpriteSFrames[iter_uSpriteID].uPaletteID));
-
-                    if (uFlags & 0x10) {  // single frame per frame sequence
-                        Sprite *sprite = pSprites_LOD->loadSprite(pSpriteSFrames[iter_uSpriteID].texture_name);
-                        if (sprite == nullptr)
-                            logger->warning("Sprite {} not loaded!", pSpriteSFrames[iter_uSpriteID].texture_name);
-                        for (unsigned i = 0; i < 8; ++i)
-                            pSpriteSFrames[iter_uSpriteID].hw_sprites[i] = sprite;
-                    } else if (uFlags & 0x10000) {
-                        for (unsigned i = 0; i < 8; ++i) {
-                            switch (i) {
-                                case 3:
-                                case 4:
-                                case 5:
-                                    spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "4";
-                                    break;
-                                case 2:
-                                case 6:
-                                    spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "2";
-                                    break;
-                                case 0:
-                                case 1:
-                                case 7:
-                                    spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "0";
-                                    break;
-                            }
-                            Sprite *sprite = pSprites_LOD->loadSprite(spriteName);
-                            // pSpriteSFrames[iter_uSpriteID].pHwSpriteIDs[i]=v12;
-                            assert(sprite);
-                            pSpriteSFrames[iter_uSpriteID].hw_sprites[i] = sprite;
-                        }
-
-                    } else if (uFlags & 0x40) {  // part of monster fidgeting seq
-                        for (unsigned i = 0; i < 8; ++i) {
-                            switch (i) {
-                                case 0:
-                                    spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "0";
-                                    break;
-                                case 4:
-                                    spriteName = pSpriteSFrames[iter_uSpriteID].texture_name;
-                                    spriteName.erase(spriteName.size() - 3, 3);
-                                    spriteName = spriteName + "stA4";
-                                    break;
-                                case 3:
-                                case 5:
-                                    spriteName = pSpriteSFrames[iter_uSpriteID].texture_name;
-                                    spriteName.erase(spriteName.size() - 3, 3);
-                                    spriteName = spriteName + "stA3";
-                                    break;
-                                case 2:
-                                case 6:
-                                    spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "2";
-                                    break;
-                                case 1:
-                                case 7:
-                                    spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "1";
-                                    break;
-                            }
-                            Sprite *sprite = pSprites_LOD->loadSprite(spriteName);
-                            // pSpriteSFrames[iter_uSpriteID].pHwSpriteIDs[i]=v12;
-                            assert(sprite);
-                            pSpriteSFrames[iter_uSpriteID].hw_sprites[i] = sprite;
-                        }
-                    } else {
-                        for (unsigned i = 0; i < 8; ++i) {
-                            if (((0x0100 << i) & pSpriteSFrames[iter_uSpriteID].uFlags)) {  // mirrors
-                                switch (i) {
-                                    case 1:
-                                        spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "7";
-                                        break;
-                                    case 2:
-                                        spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "6";
-                                        break;
-                                    case 3:
-                                        spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "5";
-                                        break;
-                                    case 4:
-                                        spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "4";
-                                        break;
-                                    case 5:
-                                        spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "3";
-                                        break;
-                                    case 6:
-                                        spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "2";
-                                        break;
-                                    case 7:
-                                        spriteName = pSpriteSFrames[iter_uSpriteID].texture_name + "1";
-                                        break;
-                                }
-                            } else {
-                                // some names already passed through with codes attached
-                                if (pSpriteSFrames[iter_uSpriteID].texture_name.size() < 7) {
-                                    spriteName = fmt::format("{}{}", pSpriteSFrames[iter_uSpriteID].texture_name, i);
-                                } else {
-                                    spriteName = pSpriteSFrames[iter_uSpriteID].texture_name;
-                                    // assert(false);
-                                }
-                            }
-
-                            Sprite *sprite = pSprites_LOD->loadSprite(spriteName);
-                            // pSpriteSFrames[iter_uSpriteID].pHwSpriteIDs[i]=v12;
-                            assert(sprite);
-                            pSpriteSFrames[iter_uSpriteID].hw_sprites[i] = sprite;
-                        }
-                    }
-
-                    if (!(pSpriteSFrames[iter_uSpriteID].uFlags & 1)) {
-                        return;
-                    }
-                    ++iter_uSpriteID;
-                }
+    if (uSpriteID > pSpriteSFrames.size() || uSpriteID < 0)
+        return;
+
+    int uFlags = pSpriteSFrames[uSpriteID].uFlags;
+    if (uFlags & 0x0080) // already loaded
+        return;
+
+    pSpriteSFrames[uSpriteID].uFlags |= 0x80;  // set loaded
+
+    for (unsigned iter_uSpriteID = uSpriteID; ; ++iter_uSpriteID) {
+        SpriteFrame &frame = pSpriteSFrames[iter_uSpriteID];
+        frame.ResetPaletteIndex(pPaletteManager->paletteIndex(frame.uPaletteID));
+
+        if (uFlags & 0x10) {  // single frame per frame sequence
+            Sprite *sprite = pSprites_LOD->loadSprite(frame.texture_name);
+            if (sprite == nullptr)
+                logger->warning("Sprite {} not loaded!", frame.texture_name);
+            for (unsigned i = 0; i < 8; ++i)
+                frame.hw_sprites[i] = sprite;
+        } else {
+            for (unsigned i = 0; i < 8; ++i) {
+                Sprite *sprite = pSprites_LOD->loadSprite(spriteOctantName(frame, uFlags, i));
+                assert(sprite);
+                frame.hw_sprites[i] = sprite;
             }
         }
+
+        if (!(frame.uFlags & 1))
+            return;
+    }
+}
+
+void SpriteFrameTable::collectSpriteNames(int uSpriteID, std::vector<std::string> *names) const {
+    if (uSpriteID >= pSpriteSFrames.size() || uSpriteID < 0)
+        return;
+
+    int uFlags = pSpriteSFrames[uSpriteID].uFlags;
+    if (uFlags & 0x0080) // already loaded
+        return;
+
+    for (size_t i = uSpriteID; i < pSpriteSFrames.size(); i++) {
+        const SpriteFrame &frame = pSpriteSFrames[i];
+
+        if (uFlags & 0x10) {
+            names->push_back(frame.texture_name);
+        } else {
+            for (int octant = 0; octant < 8; octant++)
+                names->push_back(spriteOctantName(frame, uFlags, octant));
+        }
+
+        if (!(frame.uFlags & 1))
+            return;
     }
 }
 
@@ -180,8 +153,7 @@ SpriteFrame *SpriteFrameTable::GetFrame(int uSpriteID, Duration uTime) {
         return v4;
 
     // uAnimLength / uAnimTime = actual number of frames in sprite
-    for (Duration t = uTime % v4->uAnimLength; t >= v4->uAnimTime; ++v4)
-        t -= v4->uAnimTime;
+    v4 = &pSpriteSFrames[frameAt(uSpriteID, uTime % v4->uAnimLength)];
 
     // TODO(pskelton): investigate and fix properly - dragon breath is missing last two frames??
     // quick fix so it doesnt return empty sprite
@@ -199,10 +171,24 @@ SpriteFrame *SpriteFrameTable::GetFrameReversed(int uSpriteID, Duration time) {
     if (!(sprite->uFlags & 1) || !sprite->uAnimLength)
         return sprite;
 
-    for (Duration t = sprite->uAnimLength - time % sprite->uAnimLength; t >= sprite->uAnimTime; ++sprite)
-        t -= sprite->uAnimTime;
+    return &pSpriteSFrames[frameAt(uSpriteID, sprite->uAnimLength - time % sprite->uAnimLength)];
+}
+
+void SpriteFrameTable::buildFrameIndex() {
+    _frameStarts.resize(pSpriteSFrames.size() + 1);
+    _frameStarts[0] = 0_ticks;
+    for (size_t i = 0; i < pSpriteSFrames.size(); i++)
+        _frameStarts[i + 1] = _frameStarts[i] + pSpriteSFrames[i].uAnimTime;
+}
+
+size_t SpriteFrameTable::frameAt(size_t first, Duration offset) {
+    if (_frameStarts.size() != pSpriteSFrames.size() + 1)
+        buildFrameIndex();
 
-    return sprite;
+    // Frames from `first` to `i - 1` cover everything before _frameStarts[i] - _frameStarts[first], so we're
+    // looking for the first frame that ends after the offset.
+    auto pos = std::upper_bound(_frameStarts.begin() + first + 1, _frameStarts.end(), _frameStarts[first] + offset);
+    return std::min<size_t>(pos - _frameStarts.begin() - 1, pSpriteSFrames.size() - 1);
 }
 
 // new
@@ -54,6 +54,15 @@ struct SpriteFrameTable {
     void ResetLoadedFlags();
     void InitializeSprite(signed int uSpriteID);
 
+    /**
+     * Collects the names of all the sprites that `InitializeSprite` would load for the given sprite id. Does nothing
+     * if the sprite is already loaded.
+     *
+     * @param uSpriteID                 Index in `pSpriteSFrames`.
+     * @param[out] names                Vector to append sprite names to.
+     */
+    void collectSpriteNames(int uSpriteID, std::vector<std::string> *names) const;
+
     /**
      * @param pSpriteName               Name of the sprite to find. Names are case-insensitive.
      * @return                          Index in `pSpriteSFrames` for the sprite, or 0 if sprite wasn't found.
@@ -68,11 +77,31 @@ struct SpriteFrameTable {
      */
     void ResetPaletteIndexes();
 
+    /**
+     * Rebuilds the frame lookup used by `GetFrame` & `GetFrameReversed`. Called after the table is loaded, and also
+     * lazily if the size of `pSpriteSFrames` has changed since.
+     */
+    void buildFrameIndex();
+
     std::vector<SpriteFrame> pSpriteSFrames;
 
     /** Indices into `pSpriteSFrames`, sorted by sprite name. Note that `pSpriteSFrames` itself is not sorted.
      * Contains only indices for 'a' (frontal?) sprites, so smaller in size than `pSpriteSFrames`. */
     std::vector<uint16_t> pSpriteEFrames;
+
+ private:
+    /**
+     * @param first                     Index of the first frame to start the search from.
+     * @param offset                    Time offset from the start of that frame, non-negative.
+     * @return                          Index of the frame that's shown at `offset`. Matches walking the frames one by
+     *                                  one and subtracting their `uAnimTime`, including walking past the end of the
+     *                                  animation if `offset` is larger than the sum of its frame times.
+     */
+    size_t frameAt(size_t first, Duration offset);
+
+ private:
+    /** Prefix sums of `uAnimTime` over the whole table, `_frameStarts[i]` is the sum for all frames before `i`. */
+    std::vector<Duration> _frameStarts;
 };
 
 extern struct SpriteFrameTable *pSpriteFrameTable;
@@ -1,5 +1,7 @@
 #include "TextureFrameTable.h"
 
+#include <algorithm>
+
 #include "Engine/AssetsManager.h"
 
 #include "Utility/String.h"
@@ -13,29 +15,45 @@ GraphicsImage *TextureFrame::GetTexture() {
     return this->tex;
 }
 
-int64_t TextureFrameTable::FindTextureByName(const std::string &Str2) {
-    std::string name = toLower(Str2);
+int64_t TextureFrameTable::FindTextureByName(std::string_view Str2) {
+    if (_frameStarts.size() != textures.size() + 1)
+        buildFrameIndex();
 
-    for (size_t i = 0; i < textures.size(); ++i)
-        if (textures[i].name == name)
-            return i;
-    return -1;
+    auto pos = _indexByName.find(Str2);
+    return pos == _indexByName.end() ? -1 : pos->second;
 }
 
 GraphicsImage *TextureFrameTable::GetFrameTexture(int frameId, Duration offset) {
     Duration animationDuration = textures[frameId].animationDuration;
 
     if ((textures[frameId].flags & TEXTURE_FRAME_TABLE_MORE_FRAMES) && animationDuration) {
-        offset = offset % animationDuration;
-        while (offset >= textures[frameId].frameDuration) {
-            offset -= textures[frameId].frameDuration;
-            ++frameId;
-        }
+        if (_frameStarts.size() != textures.size() + 1)
+            buildFrameIndex();
+
+        // Same as walking the frames and subtracting their durations from the offset, see
+        // `SpriteFrameTable::frameAt`.
+        Duration end = _frameStarts[frameId] + offset % animationDuration;
+        auto pos = std::upper_bound(_frameStarts.begin() + frameId + 1, _frameStarts.end(), end);
+        frameId = std::min<ptrdiff_t>(pos - _frameStarts.begin() - 1, std::ssize(textures) - 1);
     }
 
     return textures[frameId].GetTexture();
 }
 
+void TextureFrameTable::buildFrameIndex() {
+    _frameStarts.resize(textures.size() + 1);
+    _frameStarts[0] = 0_ticks;
+    for (size_t i = 0; i < textures.size(); i++)
+        _frameStarts[i + 1] = _frameStarts[i] + textures[i].frameDuration;
+
+    // Lookups lowercase the name and then compare it as is, so names that are not in lowercase can never be found.
+    _indexByName.clear();
+    _indexByName.reserve(textures.size());
+    for (size_t i = 0; i < textures.size(); ++i)
+        if (textures[i].name == toLower(textures[i].name))
+            _indexByName.try_emplace(textures[i].name, i);
+}
+
 Duration TextureFrameTable::textureFrameAnimLength(int frameID) {
     Duration result = textures[frameID].animationDuration;
     if ((textures[frameID].flags & TEXTURE_FRAME_TABLE_MORE_FRAMES) && result)
@@ -2,11 +2,14 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "Engine/Time/Duration.h"
 
 #include "Utility/Memory/Blob.h"
+#include "Utility/String.h"
 #include "Utility/Flags.h"
 
 class GraphicsImage;
@@ -48,9 +51,20 @@ struct TextureFrameTable {
      */
     Duration textureFrameAnimTime(int frameID);
 
-    int64_t FindTextureByName(const std::string &Str2);
+    int64_t FindTextureByName(std::string_view Str2);
+
+    /**
+     * Rebuilds the lookups used by `GetFrameTexture` & `FindTextureByName`. Called after the table is loaded, and
+     * also lazily if the size of `textures` has changed since.
+     */
+    void buildFrameIndex();
 
     std::vector<TextureFrame> textures;
+
+ private:
+    /** Prefix sums of `frameDuration` over the whole table, `_frameStarts[i]` is the sum for all frames before `i`. */
+    std::vector<Duration> _frameStarts;
+    std::unordered_map<std::string, int64_t, IHash, IEqual> _indexByName;
 };
 
 extern TextureFrameTable *pTextureFrameTable;
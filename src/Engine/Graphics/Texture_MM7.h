@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 #include "Library/Image/Image.h"
@@ -12,4 +13,5 @@ struct Texture_MM7 {
     GrayscaleImage indexed;
     Palette palette;
     bool zeroIsTransparent = false;
+    int64_t lastUseFrame = 0; // Last `loadTexture` call, see `AssetsManager::frameIndex`.
 };
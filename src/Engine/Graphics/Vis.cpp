@@ -1,7 +1,10 @@
 #include "Engine/Graphics/Vis.h"
 
+#include <cassert>
 #include <cstdlib>
 #include <algorithm>
+#include <array>
+#include <span>
 #include <vector>
 #include <utility>
 
@@ -23,6 +26,7 @@
 #include "Library/Logger/Logger.h"
 
 #include "Utility/Math/TrigLut.h"
+#include "Utility/Thread/ThreadPool.h"
 
 static Vis_SelectionList Vis_static_sub_4C1944_stru_F8BDE8;
 
@@ -132,7 +136,7 @@ bool Vis::IsPolygonOccludedByBillboard(RenderVertexSoft *vertices,
     // v5 = 0;
 
     // v6 = render->pBillboardRenderListD3D;
-    for (unsigned i = 0; i < render->uNumBillboardsToDraw; ++i) {
+    for (unsigned i = 0; i < render->pBillboardRenderListD3D.size(); ++i) {
         RenderBillboardD3D *billboard = &render->pBillboardRenderListD3D[i];
         if (IsPointInsideD3DBillboard(billboard, x, y)) {
             if (v13 == -1)
@@ -226,7 +230,7 @@ void Vis::GetPolygonScreenSpaceCenter(RenderVertexSoft *vertices,
 void Vis::PickBillboards_Mouse(float fPickDepth, float fX, float fY,
                                Vis_SelectionList *list,
                                Vis_SelectionFilter *filter) {
-    for (int i = 0; i < render->uNumBillboardsToDraw; ++i) {
+    for (int i : _billboardGrid.billboardsAt(fX, fY)) {
         RenderBillboardD3D *d3d_billboard = &render->pBillboardRenderListD3D[i];
         if (isBillboardPartOfSelection(i, filter) && IsPointInsideD3DBillboard(d3d_billboard, fX, fY)) {
             if (DoesRayIntersectBillboard(fPickDepth, i)) {
@@ -242,6 +246,77 @@ void Vis::PickBillboards_Mouse(float fPickDepth, float fX, float fY,
     }
 }
 
+static constexpr int BILLBOARD_GRID_CELL_SIZE = 32;
+
+std::span<const int> Vis_BillboardGrid::billboardsAt(float x, float y) {
+    if (_list != &render->pBillboardRenderListD3D || _revision != render->pBillboardRenderListD3D.revision())
+        rebuild();
+
+    if (!(x >= _x && y >= _y)) // Also catches NaNs.
+        return _allBillboards;
+
+    int column = static_cast<int>(x - _x) / BILLBOARD_GRID_CELL_SIZE;
+    int row = static_cast<int>(y - _y) / BILLBOARD_GRID_CELL_SIZE;
+    if (column >= _columns || row >= _rows)
+        return _allBillboards;
+
+    int cell = row * _columns + column;
+    return std::span(_cellBillboards).subspan(_cellOffsets[cell], _cellOffsets[cell + 1] - _cellOffsets[cell]);
+}
+
+void Vis_BillboardGrid::rebuild() {
+    const RenderList<RenderBillboardD3D> &billboards = render->pBillboardRenderListD3D;
+    _list = &billboards;
+    _revision = billboards.revision();
+
+    _x = pViewport->uScreen_TL_X;
+    _y = pViewport->uScreen_TL_Y;
+    _columns = std::max(0, pViewport->uScreen_BR_X - _x) / BILLBOARD_GRID_CELL_SIZE + 1;
+    _rows = std::max(0, pViewport->uScreen_BR_Y - _y) / BILLBOARD_GRID_CELL_SIZE + 1;
+
+    // Cell ranges for each of the billboards, bounds check is the same as in IsPointInsideD3DBillboard.
+    struct CellRange {
+        int index;
+        int column1, column2, row1, row2;
+    };
+    std::vector<CellRange> ranges;
+    _allBillboards.clear();
+    for (int i = 0; i < billboards.size(); i++) {
+        const RenderBillboardD3D &billboard = billboards[i];
+        if (billboard.sParentBillboardID == -1)
+            continue; // Not pickable.
+        _allBillboards.push_back(i);
+
+        auto [x1, x2] = std::minmax(billboard.pQuads[0].pos.x, billboard.pQuads[3].pos.x);
+        auto [y1, y2] = std::minmax(billboard.pQuads[0].pos.y, billboard.pQuads[1].pos.y);
+        auto toCell = [](float value, float origin, int count) {
+            // Clamp in float first so that we don't overflow on conversion. NaNs end up at the far end of the grid.
+            float cell = (value - origin) / BILLBOARD_GRID_CELL_SIZE;
+            return cell >= 0 ? static_cast<int>(std::min(cell, count - 1.0f)) : 0;
+        };
+        CellRange range = {i, toCell(x1, _x, _columns), toCell(x2, _x, _columns), toCell(y1, _y, _rows), toCell(y2, _y, _rows)};
+        if (!(x1 <= x2 && y1 <= y2)) // NaNs in coordinates, just put it everywhere.
+            range = {i, 0, _columns - 1, 0, _rows - 1};
+        ranges.push_back(range);
+    }
+
+    // Counting sort into cells, this keeps billboard indices in each cell sorted.
+    _cellOffsets.assign(_columns * _rows + 1, 0);
+    for (const CellRange &range : ranges)
+        for (int row = range.row1; row <= range.row2; row++)
+            for (int column = range.column1; column <= range.column2; column++)
+                _cellOffsets[row * _columns + column + 1]++;
+    for (size_t i = 1; i < _cellOffsets.size(); i++)
+        _cellOffsets[i] += _cellOffsets[i - 1];
+
+    _cellBillboards.resize(_cellOffsets.back());
+    std::vector<int> fill(_cellOffsets.begin(), _cellOffsets.end() - 1);
+    for (const CellRange &range : ranges)
+        for (int row = range.row1; row <= range.row2; row++)
+            for (int column = range.column1; column <= range.column2; column++)
+                _cellBillboards[fill[row * _columns + column]++] = range.index;
+}
+
 //----- (004C1607) --------------------------------------------------------
 bool Vis::IsPointInsideD3DBillboard(RenderBillboardD3D *billboard, float x, float y) {
     /*Not the original implementation.
@@ -268,15 +343,17 @@ bool Vis::IsPointInsideD3DBillboard(RenderBillboardD3D *billboard, float x, floa
         return true;
     }
 
-    RgbaImageView rgba = billboard->texture->rgba();
+    Sizei size = billboard->texture->size();
 
-    int sx = rgba.width() * (x - drX) / drW;
-    int sy = rgba.height() * (y - drY) / drH;
+    int sx = size.w * (x - drX) / drW;
+    int sy = size.h * (y - drY) / drH;
 
-    if (sx < 0 || sx >= rgba.width()) return false;
-    if (sy < 0 || sy >= rgba.height()) return false;
+    if (sx < 0 || sx >= size.w) return false;
+    if (sy < 0 || sy >= size.h) return false;
 
-    return rgba[sy][sx] != Color();
+    if (billboard->texture->isIndexedOnly())
+        return billboard->texture->indexed()[sy][sx] != 0;
+    return billboard->texture->rgba()[sy][sx] != Color();
 }
 
 //----- (004C16B4) --------------------------------------------------------
@@ -285,7 +362,10 @@ void Vis::PickIndoorFaces_Mouse(float fDepth, const Vec3f &rayOrigin, const Vec3
                                 Vis_SelectionFilter *filter) {
     RenderVertexSoft a1;
 
-    for (int faceindex = 0; faceindex < (int)pIndoor->pFaces.size(); ++faceindex) {
+    // Face can only be hit if the intersection point is inside its bounding box, so it's enough to check the faces
+    // whose bounding boxes are crossed by the ray.
+    pIndoor->faceBvh.segmentHits(rayOrigin, rayStep, &_faceCandidates);
+    for (int faceindex : _faceCandidates) {
         BLVFace *face = &pIndoor->pFaces[faceindex];
         if (isFacePartOfSelection(nullptr, face, filter)) {
             if (pCamera3D->is_face_faced_to_cameraBLV(face)) {
@@ -295,15 +375,49 @@ void Vis::PickIndoorFaces_Mouse(float fDepth, const Vec3f &rayOrigin, const Vec3
                 }
             }
         }
+    }
 
-        if (face->uAttributes & FACE_IsPicked)
-            face->uAttributes |= FACE_OUTLINED;
+    updateIndoorFaceOutlines();
+}
+
+void Vis::updateIndoorFaceOutlines() {
+    // Picked faces are only marked when debug outlines are on, so there is no need to walk all the faces otherwise.
+    // Except for the first pick after the outlines were turned off, so that they are cleared.
+    bool showOutlines = engine->config->debug.ShowPickedFace.value();
+    if (!showOutlines && !_faceOutlinesShown)
+        return;
+    _faceOutlinesShown = showOutlines;
+
+    for (BLVFace &face : pIndoor->pFaces) {
+        if (face.uAttributes & FACE_IsPicked)
+            face.uAttributes |= FACE_OUTLINED;
         else
-            face->uAttributes &= ~FACE_OUTLINED;
-        face->uAttributes &= ~FACE_IsPicked;
+            face.uAttributes &= ~FACE_OUTLINED;
+        face.uAttributes &= ~FACE_IsPicked;
     }
 }
 
+template<class Face, class GetBounds>
+static Bvh buildFaceBvh(std::span<const Face> faces, GetBounds getBounds) {
+    // Intersection points are rounded to ints before being checked against face bounding boxes, so we need to
+    // expand the boxes a bit to get the same results.
+    std::vector<BBoxf> boxes;
+    boxes.reserve(faces.size());
+    for (const Face &face : faces) {
+        const BBoxi &bounds = getBounds(face);
+        boxes.push_back(BBoxf{bounds.x1 - 0.5f, bounds.x2 + 0.5f, bounds.y1 - 0.5f, bounds.y2 + 0.5f, bounds.z1 - 0.5f, bounds.z2 + 0.5f});
+    }
+    return Bvh(boxes);
+}
+
+Bvh BuildFaceBvh(std::span<const BLVFace> faces) {
+    return buildFaceBvh(faces, [](const BLVFace &face) -> const BBoxi & { return face.pBounding; });
+}
+
+Bvh BuildFaceBvh(std::span<const ODMFace> faces) {
+    return buildFaceBvh(faces, [](const ODMFace &face) -> const BBoxi & { return face.pBoundingBox; });
+}
+
 bool IsBModelVisible(BSPModel *model, int reachable_depth, bool *reachable) {
     // approx distance - for reachable checks
     float rayx = model->vBoundingCenter.x - pCamera3D->vCameraPos.x;
@@ -342,24 +456,64 @@ bool IsSphereInFrustum(Vec3f center, float radius, Planef *frustum) {
     return true;
 }
 
-bool IsCylinderInFrustum(Vec3f center, float radius) {
+namespace {
+struct CylinderFrustum {
+    std::array<Vec3f, 2> normals;
+    std::array<float, 2> dists;
+};
+} // namespace
+
+static constexpr size_t CYLINDER_CULL_CHUNK_SIZE = 256;
+
+static CylinderFrustum currentCylinderFrustum() {
+    CylinderFrustum result;
+    for (int i = 0; i < 2; i++) {
+        result.normals[i] = Vec3f(pCamera3D->FrustumPlanes[i].x, pCamera3D->FrustumPlanes[i].y, pCamera3D->FrustumPlanes[i].z);
+        result.dists[i] = pCamera3D->FrustumPlanes[i].w;
+    }
+    return result;
+}
+
+static bool isCylinderInFrustum(const CylinderFrustum &frustum, Vec3f center, float radius) {
     // center must be within left / right frustum planes to be visible
     for (int i = 0; i < 2; i++) {
-        Vec3f planenormal{ pCamera3D->FrustumPlanes[i].x, pCamera3D->FrustumPlanes[i].y, pCamera3D->FrustumPlanes[i].z };
-        float planedist{ pCamera3D->FrustumPlanes[i].w };
-        if ((dot(center, planenormal) - planedist) < -radius) {
+        if ((dot(center, frustum.normals[i]) - frustum.dists[i]) < -radius) {
             return false;
         }
     }
     return true;
 }
 
+bool IsCylinderInFrustum(Vec3f center, float radius) {
+    return isCylinderInFrustum(currentCylinderFrustum(), center, radius);
+}
+
+std::vector<char> CylindersInFrustum(std::vector<Vec3f> centers, std::vector<float> radii, ThreadPool *pool) {
+    assert(centers.size() == radii.size());
+
+    CylinderFrustum frustum = currentCylinderFrustum();
+    std::vector<char> result(centers.size());
+    auto cull = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            result[i] = isCylinderInFrustum(frustum, centers[i], radii[i]);
+    };
+
+    if (pool) {
+        pool->parallelFor(centers.size(), CYLINDER_CULL_CHUNK_SIZE, cull);
+    } else {
+        cull(0, centers.size());
+    }
+    return result;
+}
+
 void Vis::PickOutdoorFaces_Mouse(float fDepth, const Vec3f &rayOrigin, const Vec3f &rayStep,
                                  Vis_SelectionList *list,
                                  Vis_SelectionFilter *filter,
                                  bool only_reachable) {
     if (!pOutdoor) return;
 
+    bool showOutlines = engine->config->debug.ShowPickedFace.value();
+
     for (BSPModel &model : pOutdoor->pBModels) {
         bool reachable;
         if (!IsBModelVisible(&model, fDepth, &reachable)) {
@@ -369,7 +523,15 @@ void Vis::PickOutdoorFaces_Mouse(float fDepth, const Vec3f &rayOrigin, const Vec
             continue;
         }
 
-        for (ODMFace &face : model.pFaces) {
+        // See the comments in updateIndoorFaceOutlines.
+        if (showOutlines || _faceOutlinesShown)
+            for (ODMFace &face : model.pFaces)
+                face.uAttributes &= ~FACE_OUTLINED;
+
+        // Same as indoors, only the faces whose bounding boxes are crossed by the ray can be hit.
+        model.faceBvh.segmentHits(rayOrigin, rayStep, &_faceCandidates);
+        for (int faceIndex : _faceCandidates) {
+            ODMFace &face = model.pFaces[faceIndex];
             if (isFacePartOfSelection(&face, nullptr, filter)) {
                 BLVFace blv_face;
                 blv_face.FromODM(&face);
@@ -394,6 +556,8 @@ void Vis::PickOutdoorFaces_Mouse(float fDepth, const Vec3f &rayOrigin, const Vec
             }
         }
     }
+
+    _faceOutlinesShown = showOutlines;
 }
 
 //----- (004C1944) --------------------------------------------------------
@@ -728,7 +892,7 @@ Vis_PIDAndDepth Vis::PickMouse(float fDepth, float fMouseX, float fMouseY,
 //----- (004C06F8) --------------------------------------------------------
 void Vis::PickBillboards_Keyboard(float pick_depth, Vis_SelectionList *list,
                                   Vis_SelectionFilter *filter) {
-    for (int i = 0; i < render->uNumBillboardsToDraw; ++i) {
+    for (int i = 0; i < render->pBillboardRenderListD3D.size(); ++i) {
         RenderBillboardD3D *d3d_billboard = &render->pBillboardRenderListD3D[i];
 
         if (isBillboardPartOfSelection(i, filter)) {
@@ -898,7 +1062,7 @@ bool Vis::DoesRayMissLevelGeom(float test_x, float test_y, float fDepth, float f
 
 //----- (004C0D32) --------------------------------------------------------
 void Vis::PickIndoorFaces_Keyboard(float pick_depth, Vis_SelectionList *list, Vis_SelectionFilter *filter) {
-    for (int i = 0; i < pBspRenderer->num_faces; ++i) {
+    for (int i = 0; i < pBspRenderer->faces.size(); ++i) {
         int pFaceID = pBspRenderer->faces[i].uFaceID;
         BLVFace *pFace = &pIndoor->pFaces[pFaceID];
         if (pCamera3D->is_face_faced_to_cameraBLV(pFace)) {
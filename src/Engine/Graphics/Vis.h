@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Engine/Graphics/Bvh.h"
 #include "Engine/Graphics/RenderEntities.h"
 #include "Engine/Objects/ActorEnums.h"
 #include "Engine/Pid.h"
@@ -9,6 +14,7 @@
 #include "Utility/Flags.h"
 
 class BSPModel;
+class ThreadPool;
 struct ODMFace;
 struct BLVFace;
 struct RenderVertexD3D3;
@@ -78,6 +84,35 @@ struct Vis_SelectionList {
     unsigned int uSize = 0;
 };
 
+/**
+ * Screen-space grid over the billboards in `render->pBillboardRenderListD3D`, used to quickly find the billboards
+ * under the mouse cursor. Rebuilt lazily whenever the billboard list changes.
+ */
+class Vis_BillboardGrid {
+ public:
+    /**
+     * @param x                         Screen x.
+     * @param y                         Screen y.
+     * @return                          Indices of the pickable billboards that might contain the given point, in
+     *                                  ascending order. The caller still needs to check the billboards one by one.
+     */
+    std::span<const int> billboardsAt(float x, float y);
+
+ private:
+    void rebuild();
+
+ private:
+    const void *_list = nullptr;
+    uint64_t _revision = 0;
+    int _x = 0;
+    int _y = 0;
+    int _columns = 0;
+    int _rows = 0;
+    std::vector<int> _cellOffsets; // Cell i has billboards `_cellBillboards[_cellOffsets[i]..._cellOffsets[i + 1]]`.
+    std::vector<int> _cellBillboards;
+    std::vector<int> _allBillboards; // For the points outside the grid.
+};
+
 class Vis {
  public:
     Vis_PIDAndDepth PickKeyboard(float pick_depth, Vis_SelectionFilter *sprite_filter, Vis_SelectionFilter *face_filter);
@@ -107,6 +142,8 @@ class Vis {
                                 Vis_SelectionFilter *filter,
                                 bool only_reachable);
 
+    void updateIndoorFaceOutlines();
+
     bool isBillboardPartOfSelection(int billboardId, Vis_SelectionFilter *filter);
     bool isFacePartOfSelection(ODMFace *odmFace, BLVFace *bvlFace, Vis_SelectionFilter *filter);
 
@@ -148,8 +185,25 @@ class Vis {
 
  private:
     Vis_SelectionList _selectionList;
+    Vis_BillboardGrid _billboardGrid;
+    std::vector<int> _faceCandidates;
+    bool _faceOutlinesShown = false;
 };
 
+/**
+ * @param faces                         Indoor faces.
+ * @return                              Bounding volume hierarchy over the bounding boxes of the provided faces, to be
+ *                                      used for ray picking.
+ */
+Bvh BuildFaceBvh(std::span<const BLVFace> faces);
+
+/**
+ * @param faces                         Faces of a single outdoor model.
+ * @return                              Bounding volume hierarchy over the bounding boxes of the provided faces, to be
+ *                                      used for ray picking.
+ */
+Bvh BuildFaceBvh(std::span<const ODMFace> faces);
+
 
 /**
  * @param model                         Pointer to model to check against.
@@ -176,3 +230,18 @@ bool IsSphereInFrustum(Vec3f center, float radius, Planef *frustum = nullptr);
  * @return                              Whether the cylinder is visible within the L/R camera frustum planes.
  */
 bool IsCylinderInFrustum(Vec3f center, float radius);
+
+/**
+ * Batch version of `IsCylinderInFrustum`.
+ *
+ * Large batches are split into chunks that are tested in parallel on the provided thread pool. The calling thread
+ * takes part in the work, so this function never ends up waiting on unrelated tasks that are queued in the pool.
+ * Results don't depend on the number of threads used.
+ *
+ * @param centers                       Centre points of the cylinders.
+ * @param radii                         Cylinder radii, must be of the same size as `centers`.
+ * @param pool                          Thread pool to use, can be `nullptr`.
+ * @return                              For each of the provided cylinders, whether it's visible within the L/R
+ *                                      camera frustum planes.
+ */
+std::vector<char> CylindersInFrustum(std::vector<Vec3f> centers, std::vector<float> radii, ThreadPool *pool);
@@ -1,8 +1,6 @@
 #pragma once
 
-#include <array>
-
-#include "Library/Geometry/Point.h"
+#include <cstdint>
 
 class Weather {
  public:
@@ -11,9 +9,13 @@ class Weather {
     void Draw();
     bool OnPlayerTurn(int dangle);
 
-    std::array<Pointi, 1000> Screen_Coord;
     bool bNight = false;
     bool bRenderSnow = false;
+
+ private:
+    uint32_t _seed = 0; // Seed for the snow flakes, flakes themselves are simulated by the renderer.
+    int64_t _startTime = 0; // Platform tick count at the start of the snow.
+    float _windOffset = 0; // Horizontal offset of all flakes, in pixels.
 };
 
 extern Weather *pWeather;
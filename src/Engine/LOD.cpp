@@ -1,12 +1,34 @@
 #include "LOD.h"
 
+#include "Library/LodFormats/LodFormats.h"
+#include "Library/Logger/Logger.h"
+
 #include "Utility/DataPath.h"
+#include "Utility/Exception.h"
 
 std::unique_ptr<LodReader> pSave_LOD; // LOD pointing to the savegame file currently being processed
 std::unique_ptr<LodReader> pGames_LOD; // LOD pointing to data/games.lod
+std::unique_ptr<LodDecodeCache> pDecodeCache; // Cache for decompressed LOD entries, optional.
 
 bool Initialize_GamesLOD_NewLOD() {
     pGames_LOD = std::make_unique<LodReader>(makeDataPath("data", "games.lod"));
     pSave_LOD = std::make_unique<LodReader>();
+    if (pDecodeCache)
+        pDecodeCache->attach(*pGames_LOD);
     return true;
 }
+
+void openLodDecodeCache(const std::string &path) {
+    try {
+        pDecodeCache = std::make_unique<LodDecodeCache>(path);
+        lod::setDecodeCache(pDecodeCache.get());
+    } catch (const std::exception &e) {
+        logger->warning("Could not open LOD decode cache '{}', proceeding without it: {}", path, e.what());
+        pDecodeCache.reset();
+    }
+}
+
+void closeLodDecodeCache() {
+    lod::setDecodeCache(nullptr);
+    pDecodeCache.reset();
+}
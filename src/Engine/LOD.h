@@ -1,10 +1,26 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "Library/Lod/LodReader.h"
+#include "Library/LodFormats/LodDecodeCache.h"
 
 bool Initialize_GamesLOD_NewLOD();
 
+/**
+ * Opens the on-disk cache for the decompressed LOD entries and installs it with `lod::setDecodeCache`. LODs that are
+ * opened after this call and are attached to `pDecodeCache` will then be decoded through the cache.
+ *
+ * @param path                          Path to the cache file.
+ */
+void openLodDecodeCache(const std::string &path);
+
+/**
+ * Uninstalls & closes the decoded data cache, writing out the cache file.
+ */
+void closeLodDecodeCache();
+
 extern std::unique_ptr<LodReader> pSave_LOD;
 extern std::unique_ptr<LodReader> pGames_LOD;
+extern std::unique_ptr<LodDecodeCache> pDecodeCache;
@@ -0,0 +1,99 @@
+#include "LoadProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <set>
+
+#include "Library/Json/Json.h"
+
+#include "Utility/Streams/FileOutputStream.h"
+
+LoadProfiler *loadProfiler = nullptr;
+
+static int currentThreadId() {
+    // Small sequential ids read better in the trace viewers than the OS thread ids.
+    static std::atomic<int> nextThreadId = 0;
+    thread_local int threadId = nextThreadId++;
+    return threadId;
+}
+
+LoadProfiler::LoadProfiler() : _startTime(Clock::now()) {
+    currentThreadId(); // Profiler is created on the main thread, make sure it gets the first id.
+}
+
+void LoadProfiler::add(const char *name, Clock::time_point start, Clock::time_point end) {
+    Zone zone;
+    zone.name = name;
+    zone.threadId = currentThreadId();
+    zone.start = start;
+    zone.duration = end - start;
+
+    std::lock_guard lock(_mutex);
+    _zones.push_back(zone);
+}
+
+std::vector<LoadProfiler::Zone> LoadProfiler::zones() const {
+    std::vector<Zone> result;
+    {
+        std::lock_guard lock(_mutex);
+        result = _zones;
+    }
+
+    // Zones are added when they end, so nested zones come before their parents. Viewers don't care, but people do.
+    std::ranges::stable_sort(result, [](const Zone &l, const Zone &r) {
+        return l.start < r.start || (l.start == r.start && l.duration > r.duration);
+    });
+    return result;
+}
+
+void LoadProfiler::saveChromeTrace(std::string_view path) const {
+    using Microseconds = std::chrono::duration<double, std::micro>;
+
+    std::vector<Zone> zones = this->zones();
+
+    Json events = Json::array();
+    std::set<int> threads;
+    for (const Zone &zone : zones) {
+        events.push_back({
+            {"name", zone.name},
+            {"cat", "load"},
+            {"ph", "X"},
+            {"ts", Microseconds(zone.start - _startTime).count()},
+            {"dur", Microseconds(zone.duration).count()},
+            {"pid", 1},
+            {"tid", zone.threadId}
+        });
+        threads.insert(zone.threadId);
+    }
+
+    for (int threadId : threads) {
+        events.push_back({
+            {"name", "thread_name"},
+            {"ph", "M"},
+            {"pid", 1},
+            {"tid", threadId},
+            {"args", {{"name", threadId == 0 ? std::string("main") : "worker " + std::to_string(threadId)}}}
+        });
+    }
+
+    Json trace = {
+        {"traceEvents", std::move(events)},
+        {"displayTimeUnit", "ms"}
+    };
+
+    std::string text = trace.dump();
+    FileOutputStream output(path);
+    output.write(text.data(), text.size());
+    output.close();
+}
+
+LoadProfilerScope::LoadProfilerScope(const char *name) : _name(name) {
+    if (loadProfiler)
+        _start = LoadProfiler::Clock::now();
+}
+
+LoadProfilerScope::~LoadProfilerScope() {
+    if (loadProfiler)
+        loadProfiler->add(_name, _start, LoadProfiler::Clock::now());
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+/**
+ * Timeline profiler for level loading.
+ *
+ * Collects named timing zones - map deserialization, actor init, event init, texture decoding, etc. Zones can be
+ * nested, and can be opened on any thread, including the thread pool workers. The result is saved as a Chrome
+ * `trace_event` JSON that can be opened in Perfetto or in `chrome://tracing`.
+ *
+ * Same as with `SubsystemTimers`, zones are only collected if `loadProfiler` is set, which is done for the runs
+ * started with `--load-profile`.
+ */
+class LoadProfiler {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Zone {
+        const char *name = nullptr;
+        int threadId = 0;
+        Clock::time_point start;
+        Clock::duration duration = {};
+    };
+
+    LoadProfiler();
+
+    /**
+     * Adds a zone. This function is thread-safe.
+     *
+     * @param name                      Zone name, must be a string literal.
+     * @param start                     Zone start time.
+     * @param end                       Zone end time.
+     */
+    void add(const char *name, Clock::time_point start, Clock::time_point end);
+
+    /**
+     * @return                          All zones recorded so far, sorted by start time.
+     */
+    [[nodiscard]] std::vector<Zone> zones() const;
+
+    /**
+     * Saves all zones recorded so far as Chrome trace event JSON.
+     *
+     * @param path                      Path to save to.
+     * @throw Exception                 If the file couldn't be written.
+     */
+    void saveChromeTrace(std::string_view path) const;
+
+ private:
+    Clock::time_point _startTime;
+    mutable std::mutex _mutex;
+    std::vector<Zone> _zones;
+};
+
+class LoadProfilerScope {
+ public:
+    explicit LoadProfilerScope(const char *name);
+    ~LoadProfilerScope();
+
+    LoadProfilerScope(const LoadProfilerScope &) = delete;
+    LoadProfilerScope &operator=(const LoadProfilerScope &) = delete;
+
+ private:
+    const char *_name;
+    LoadProfiler::Clock::time_point _start;
+};
+
+extern LoadProfiler *loadProfiler;
@@ -77,6 +77,10 @@ bool Localization::Initialize() {
     if (!this->localization_strings[LSTR_ENERGY])
         this->localization_strings[LSTR_ENERGY] = "Energy";
 
+    _formatPrograms.clear();
+    for (int i = 0; i < MAX_LOC_STRINGS; ++i)
+        _formatPrograms.emplace_back(localization_strings[i] ? localization_strings[i] : "");
+
     InitializeMm6ItemCategories();
 
     InitializeMonthNames();
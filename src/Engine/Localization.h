@@ -3,6 +3,7 @@
 #include <array>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Engine/Objects/NPCEnums.h"
 #include "Engine/Objects/CharacterEnums.h"
@@ -12,6 +13,7 @@
 #include "Utility/Workaround/ToUnderlying.h"
 #include "Utility/IndexedArray.h"
 #include "Utility/Format.h"
+#include "Utility/PrintfProgram.h"
 
 // TODO(captainurist): #enum
 #define LSTR_AC                               0   // "AC"
@@ -449,10 +451,23 @@ class Localization {
     template<class... Args>
     std::string FormatString(unsigned int index, Args &&... args) const {
         // TODO(captainurist): what if fmt throws?
-        return fmt::sprintf(GetString(index), std::forward<Args>(args)...);
+        return _formatPrograms[index].format(args...);
         // TODO(captainurist): there was also a call to sprintfex_internal after a call to vsprintf.
     }
 
+    /**
+     * Same as `FormatString`, but appends the result to the provided buffer. Doesn't allocate if the buffer is big
+     * enough and the format string only uses simple conversions.
+     *
+     * @param out                       Buffer to append to.
+     * @param index                     Localized string index.
+     * @param args                      Format arguments.
+     */
+    template<class... Args>
+    void FormatStringTo(fmt::memory_buffer *out, unsigned int index, Args &&... args) const {
+        _formatPrograms[index].formatTo(out, args...);
+    }
+
     const char *GetDayName(unsigned int index) const {
         return this->day_names[index];
     }
@@ -656,6 +671,7 @@ class Localization {
  private:
     std::string localization_raw;
     const char **localization_strings = nullptr;
+    std::vector<PrintfProgram> _formatPrograms; // Pre-parsed localization_strings, for FormatString.
     std::string class_desc_raw;
     std::string attribute_desc_raw;
     std::string skill_desc_raw;
@@ -0,0 +1,147 @@
+#include "LocationPrefetcher.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "Engine/LOD.h"
+#include "Engine/LodTextureCache.h"
+#include "Engine/LoadProfiler.h"
+
+#include "Library/LodFormats/LodFormats.h"
+#include "Library/Logger/Logger.h"
+
+#include "Utility/String.h"
+#include "Utility/Thread/ThreadPool.h"
+
+// Max number of recently loaded locations to keep around. Parsed outdoor locations take a couple megabytes each.
+static constexpr size_t MAX_RECENT_LOCATIONS = 3;
+
+template<size_t N>
+static void collectTextureNames(const std::vector<std::array<char, N>> &names, std::vector<std::string> *dst) {
+    for (const std::array<char, N> &name : names)
+        if (size_t size = strnlen(name.data(), N))
+            dst->emplace_back(name.data(), size);
+}
+
+static std::unique_ptr<PrefetchedLocation> loadLocation(const std::string &fileName, ThreadPool *pool) {
+    LoadProfilerScope profilerScope("prefetch location");
+
+    auto result = std::make_unique<PrefetchedLocation>();
+    result->fileName = fileName;
+
+    // Location & its initial delta are inflated in one batch.
+    std::string baseName = fileName.substr(0, fileName.size() - 4);
+    bool indoor = fileName.ends_with(".blv");
+    std::string names[] = {fileName, baseName + (indoor ? ".dlv" : ".ddm")};
+    std::vector<Blob> blobs;
+    for (const std::string &name : names)
+        blobs.push_back(pGames_LOD->read(name));
+    blobs = lod::decodeCompressed(blobs, pool);
+    result->initialDelta = std::move(blobs[1]);
+
+    if (indoor) {
+        result->indoor = std::make_unique<IndoorLocation_MM7>();
+        deserialize(blobs[0], result->indoor.get());
+        collectTextureNames(result->indoor->faceTextures, &result->textureNames);
+    } else {
+        result->outdoor = std::make_unique<OutdoorLocation_MM7>();
+        deserialize(blobs[0], result->outdoor.get());
+        for (const BSPModelExtras_MM7 &extras : result->outdoor->modelExtras)
+            collectTextureNames(extras.faceTextures, &result->textureNames);
+    }
+
+    return result;
+}
+
+template<class T>
+static bool isReady(const std::future<T> &future) {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+LocationPrefetcher::LocationPrefetcher(ThreadPool *pool) : _pool(pool) {
+    assert(pool);
+}
+
+LocationPrefetcher::~LocationPrefetcher() {
+    // Background jobs are reading from the global LODs, so we need to wait for them before the LODs are gone.
+    if (_pending.valid())
+        _pending.wait();
+    for (const auto &future : _abandoned)
+        future.wait();
+}
+
+void LocationPrefetcher::prefetch(const std::string &mapName) {
+    if (mapName.size() <= 4)
+        return; // Not a map file name, e.g. "0" in transitions means "current map".
+
+    std::string fileName = toLower(mapName);
+    if (!fileName.ends_with(".blv"))
+        fileName.replace(fileName.size() - 4, 4, ".odm");
+    if (fileName == _fileName)
+        return;
+    if (std::ranges::any_of(_recent, [&](const auto &location) { return location->fileName == fileName; }))
+        return; // Already loaded recently.
+
+    if (_pending.valid())
+        _abandoned.push_back(std::move(_pending));
+    _ready.reset();
+    _fileName = fileName;
+    _pending = _pool->run([fileName, pool = _pool] { return loadLocation(fileName, pool); });
+}
+
+void LocationPrefetcher::update() {
+    std::erase_if(_abandoned, [](const auto &future) { return isReady(future); });
+
+    if (!_pending.valid() || !isReady(_pending))
+        return;
+
+    try {
+        _ready = _pending.get();
+    } catch (const std::exception &e) {
+        logger->warning("Could not prefetch location '{}': {}", _fileName, e.what());
+        _fileName.clear();
+        return;
+    }
+
+    pBitmaps_LOD->warmTextures(_ready->textureNames, _pool);
+}
+
+std::unique_ptr<PrefetchedLocation> LocationPrefetcher::take(const std::string &fileName) {
+    auto pos = std::ranges::find_if(_recent, [&](const auto &location) { return iequals(location->fileName, fileName); });
+    if (pos != _recent.end()) {
+        std::unique_ptr<PrefetchedLocation> result = std::move(*pos);
+        _recent.erase(pos);
+        return result;
+    }
+
+    if (!iequals(fileName, _fileName)) {
+        // Wrong guess, but we'll keep the prefetched data around - the party might still go there later.
+        return nullptr;
+    }
+
+    if (_pending.valid()) {
+        try {
+            _ready = _pending.get();
+        } catch (const std::exception &e) {
+            logger->warning("Could not prefetch location '{}': {}", _fileName, e.what());
+        }
+    }
+
+    _fileName.clear();
+    return std::move(_ready);
+}
+
+void LocationPrefetcher::retain(std::unique_ptr<PrefetchedLocation> location) {
+    assert(location);
+    assert(location->indoor || location->outdoor);
+
+    location->textureNames.clear(); // Only needed for warming up the textures.
+    std::erase_if(_recent, [&](const auto &recent) { return recent->fileName == location->fileName; });
+    _recent.insert(_recent.begin(), std::move(location));
+    if (_recent.size() > MAX_RECENT_LOCATIONS)
+        _recent.pop_back();
+}
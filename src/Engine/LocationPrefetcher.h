@@ -0,0 +1,85 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Engine/Snapshots/CompositeSnapshots.h"
+
+#include "Utility/Memory/Blob.h"
+
+class ThreadPool;
+
+/**
+ * Location data that was loaded ahead of time by `LocationPrefetcher`.
+ */
+struct PrefetchedLocation {
+    std::string fileName; // Lowercase map file name, e.g. "out02.odm" or "d01.blv".
+    std::unique_ptr<OutdoorLocation_MM7> outdoor; // Set for outdoor locations.
+    std::unique_ptr<IndoorLocation_MM7> indoor; // Set for indoor locations.
+    Blob initialDelta; // Decoded .ddm / .dlv from games.lod, used when the location is respawned.
+    std::vector<std::string> textureNames; // Face textures of the location.
+};
+
+/**
+ * Background loader for the location that the party is likely to enter next, e.g. when the travel or the transition
+ * dialog is shown.
+ *
+ * Prefetching reads & inflates the location from games.lod, parses it into a snapshot, and once that's done, warms up
+ * the location's textures in `pBitmaps_LOD`. The next `OutdoorLocation::Load` / `IndoorLocation::Load` call for the
+ * same map then takes the prefetched data instead of doing the I/O and the parsing on the main thread.
+ *
+ * Deltas from the save LOD are not prefetched. The save LOD is rewritten on autosave, and that is exactly what
+ * happens when the party transitions to another map.
+ *
+ * Locations are handed back with `retain` once they are loaded, and the few most recently loaded ones are kept
+ * around, so that going back & forth between two maps doesn't need to touch games.lod at all.
+ *
+ * All methods should be called from the main thread.
+ */
+class LocationPrefetcher {
+ public:
+    explicit LocationPrefetcher(ThreadPool *pool);
+    ~LocationPrefetcher();
+
+    /**
+     * Starts prefetching the provided location. Does nothing if this location is already being prefetched, and
+     * drops the previous prefetch otherwise.
+     *
+     * @param mapName                   Map file name, e.g. "out02.odm". Extension is used to tell indoor locations
+     *                                  from outdoor ones.
+     */
+    void prefetch(const std::string &mapName);
+
+    /**
+     * Checks whether the background job has finished, and if so, starts warming up the location's textures. Should
+     * be called periodically, e.g. every frame while the transition dialog is shown.
+     */
+    void update();
+
+    /**
+     * Takes the prefetched location if it matches the provided name, waiting for the background job if needed.
+     *
+     * @param fileName                  Location file name, e.g. "out02.odm".
+     * @return                          Prefetched location, or `nullptr` if a different location was prefetched, or
+     *                                  if prefetching has failed.
+     */
+    [[nodiscard]] std::unique_ptr<PrefetchedLocation> take(const std::string &fileName);
+
+    /**
+     * Puts a location that was just loaded into the cache of recently loaded locations, evicting the least recently
+     * loaded one if the cache is full. The next `take` call for the same location will return it.
+     *
+     * @param location                  Location to retain, as returned by `take` or loaded by the caller.
+     */
+    void retain(std::unique_ptr<PrefetchedLocation> location);
+
+ private:
+    ThreadPool *_pool = nullptr;
+    std::string _fileName; // File name of the location being prefetched, empty if none.
+    std::future<std::unique_ptr<PrefetchedLocation>> _pending;
+    std::unique_ptr<PrefetchedLocation> _ready;
+    std::vector<std::future<std::unique_ptr<PrefetchedLocation>>> _abandoned; // Dropped jobs that might still be running.
+    std::vector<std::unique_ptr<PrefetchedLocation>> _recent; // Recently loaded locations, most recent first.
+};
@@ -1,10 +1,18 @@
 #include "LodSpriteCache.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <string>
 #include <vector>
 #include <utility>
 
+#include "Engine/LoadProfiler.h"
+
 #include "Library/LodFormats/LodFormats.h"
+#include "Library/Logger/Logger.h"
 
+#include "Utility/Memory/MemoryAccounting.h"
+#include "Utility/Thread/ThreadPool.h"
 #include "Utility/String.h"
 #include "Utility/MapAccess.h"
 
@@ -22,12 +30,25 @@ void LODSprite::Release() {
 LodSpriteCache::LodSpriteCache() = default;
 
 LodSpriteCache::~LodSpriteCache() {
+    publishPrefetched();
     for (auto &[_, sprite] : _spriteByName)
         sprite.Release();
 }
 
 bool LodSpriteCache::open(const std::string &pFilename) {
     _reader.open(pFilename);
+    _vfs.clear();
+    _vfs.mount(_reader);
+
+    _bundle.close();
+    std::string bundlePath = pFilename + ".bundle";
+    if (std::filesystem::exists(bundlePath)) {
+        try {
+            _bundle.open(bundlePath, LodBundleReader::fingerprint(_reader));
+        } catch (const std::exception &e) {
+            logger->warning("Ignoring asset bundle '{}': {}", bundlePath, e.what());
+        }
+    }
     return true;
 }
 
@@ -36,6 +57,8 @@ void LodSpriteCache::reserveLoadedSprites() {  // final init
 }
 
 void LodSpriteCache::releaseUnreserved() {
+    publishPrefetched(); // Make sure no prefetch jobs are running, results will be released right away.
+
     while (_spritesInOrder.size() > _reservedCount) {
         const std::string &name = _spritesInOrder.back();
         _spriteByName[name].Release();
@@ -45,31 +68,126 @@ void LodSpriteCache::releaseUnreserved() {
 }
 
 Sprite *LodSpriteCache::loadSprite(const std::string &pContainerName) {
+    // Fast path, cache hits don't need a lowercased copy of the name.
+    Sprite *result = valuePtr(_spriteByName, pContainerName);
+    if (result) {
+        LODSprite *header = result->sprite_header;
+        if (!header->bitmap)
+            LoadSpriteFromFile(header, header->name); // Was unloaded in `unloadUnused`.
+        header->lastUseFrame = assets->frameIndex();
+        return result;
+    }
+
     std::string name = toLower(pContainerName);
 
-    Sprite *result = valuePtr(_spriteByName, name);
-    if (result)
+    if (auto pos = _pendingByName.find(name); pos != _pendingByName.end()) {
+        result = publishPrefetched(name, &pos->second);
+        _pendingByName.erase(pos);
         return result;
+    }
 
     std::unique_ptr<LODSprite> header = std::make_unique<LODSprite>();
     if (!LoadSpriteFromFile(header.get(), name))
         return nullptr;
 
+    return publishSprite(name, pContainerName, std::move(header));
+}
+
+size_t LodSpriteCache::memorySize() const {
+    size_t result = 0;
+    for (const auto &[_, sprite] : _spriteByName)
+        result += sprite.sprite_header->bitmap.pixels().size_bytes();
+    return result;
+}
+
+size_t LodSpriteCache::unloadUnused(int64_t lastUseFrame, size_t size) {
+    std::vector<std::pair<int64_t, LODSprite *>> candidates;
+    for (auto &[_, sprite] : _spriteByName)
+        if (sprite.sprite_header->bitmap && sprite.sprite_header->lastUseFrame <= lastUseFrame)
+            candidates.emplace_back(sprite.sprite_header->lastUseFrame, sprite.sprite_header);
+    std::ranges::sort(candidates);
+
+    size_t freed = 0;
+    for (const auto &[_, header] : candidates) {
+        if (freed >= size)
+            break;
+
+        freed += header->bitmap.pixels().size_bytes();
+        header->bitmap.reset();
+    }
+    return freed;
+}
+
+void LodSpriteCache::prefetchSprites(const std::vector<std::string> &names, ThreadPool *pool) {
+    assert(pool);
+
+    for (const std::string &containerName : names) {
+        std::string name = toLower(containerName);
+        if (_spriteByName.contains(name) || _pendingByName.contains(name))
+            continue;
+
+        if (_bundle.isOpen() && _bundle.exists(name))
+            continue; // Already decoded, will be served from the bundle on first access.
+
+        const VfsEntry *entry = _vfs.find(name);
+        if (!entry)
+            continue;
+
+        _pendingByName.emplace(name, pool->run([blob = _vfs.read(*entry)] {
+            LoadProfilerScope profilerScope("decode sprite");
+            MemoryTagScope memoryScope(MEMORY_TAG_SPRITES);
+            return lod::decodeSprite(blob);
+        }));
+    }
+}
+
+void LodSpriteCache::publishPrefetched() {
+    for (auto &[name, future] : _pendingByName)
+        publishPrefetched(name, &future);
+    _pendingByName.clear();
+}
+
+Sprite *LodSpriteCache::publishPrefetched(const std::string &name, std::future<LodSprite> *future) {
+    LodSprite sprite;
+    try {
+        sprite = future->get();
+    } catch (const std::exception &e) {
+        logger->warning("Could not decode sprite '{}': {}", name, e.what());
+        return nullptr;
+    }
+
+    std::unique_ptr<LODSprite> header = std::make_unique<LODSprite>();
+    header->name = name;
+    header->bitmap = std::move(sprite.image);
+    return publishSprite(name, name, std::move(header));
+}
+
+Sprite *LodSpriteCache::publishSprite(const std::string &name, const std::string &containerName, std::unique_ptr<LODSprite> header) {
+    header->lastUseFrame = assets->frameIndex();
+
     Sprite &sprite = _spriteByName[name];
-    sprite.pName = pContainerName;
+    sprite.pName = containerName;
     sprite.uWidth = header->bitmap.width();
     sprite.uHeight = header->bitmap.height();
-    sprite.texture = assets->getSprite(pContainerName); // TODO(captainurist): very weird dependency here.
+    sprite.texture = assets->getSprite(containerName); // TODO(captainurist): very weird dependency here.
     sprite.sprite_header = header.release();
     _spritesInOrder.push_back(name);
     return &sprite;
 }
 
 bool LodSpriteCache::LoadSpriteFromFile(LODSprite *pSprite, const std::string &pContainer) {
-    if (!_reader.exists(pContainer))
-        return false;
+    MemoryTagScope memoryScope(MEMORY_TAG_SPRITES);
 
-    LodSprite sprite = lod::decodeSprite(_reader.read(pContainer));
+    LodSprite sprite;
+    if (_bundle.isOpen() && _bundle.exists(pContainer)) {
+        sprite = _bundle.readSprite(pContainer);
+    } else {
+        const VfsEntry *entry = _vfs.find(pContainer);
+        if (!entry)
+            return false;
+
+        sprite = lod::decodeSprite(_vfs.read(*entry));
+    }
     pSprite->name = pContainer;
     pSprite->bitmap = std::move(sprite.image);
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <future>
 #include <unordered_map>
 #include <vector>
 #include <memory>
@@ -9,14 +11,21 @@
 
 #include "Library/Image/Image.h"
 #include "Library/Lod/LodReader.h"
+#include "Library/LodFormats/LodBundleReader.h"
+#include "Library/LodFormats/LodFormats.h"
+#include "Library/Vfs/VirtualFileSystem.h"
+
+#include "Utility/String.h"
 
 class LodReader;
+class ThreadPool;
 
 struct LODSprite {
     void Release();
 
     std::string name;
-    GrayscaleImage bitmap;
+    GrayscaleImage bitmap; // Can be empty if it was unloaded in `LodSpriteCache::unloadUnused`.
+    int64_t lastUseFrame = 0; // Last `loadSprite` call, see `AssetsManager::frameIndex`.
 };
 
 class LodSpriteCache {
@@ -29,16 +38,53 @@ class LodSpriteCache {
     void reserveLoadedSprites();
     void releaseUnreserved();
 
+    /**
+     * Starts decoding the provided sprites on the worker threads of the provided thread pool. Decoded sprites are
+     * published into the cache from the main thread, either on the next `loadSprite` call that asks for them, or in
+     * `publishPrefetched`.
+     *
+     * @param names                     Names of the sprites to prefetch.
+     * @param pool                      Thread pool to run decoding on.
+     * @see LodTextureCache::prefetchTextures
+     */
+    void prefetchSprites(const std::vector<std::string> &names, ThreadPool *pool);
+
+    /**
+     * Waits for all pending prefetch jobs and publishes their results into the cache.
+     */
+    void publishPrefetched();
+
     Sprite *loadSprite(const std::string &pContainerName);
 
+    /**
+     * @return                          Size of the decoded sprite data in this cache, in bytes.
+     */
+    [[nodiscard]] size_t memorySize() const;
+
+    /**
+     * Unloads the pixel data of the sprites that were not used after the provided frame, least recently used first.
+     * `Sprite` objects themselves are not touched as they are referenced from the sprite frame table, and pixel data
+     * is reloaded on next `loadSprite` call.
+     *
+     * @param lastUseFrame              Only sprites last used at or before this frame are unloaded.
+     * @param size                      Number of bytes to free.
+     * @return                          Number of bytes actually freed.
+     */
+    size_t unloadUnused(int64_t lastUseFrame, size_t size);
+
  private:
     bool LoadSpriteFromFile(LODSprite *pSpriteHeader, const std::string &pContainer);
+    Sprite *publishSprite(const std::string &name, const std::string &containerName, std::unique_ptr<LODSprite> header);
+    Sprite *publishPrefetched(const std::string &name, std::future<LodSprite> *future);
 
  private:
     LodReader _reader;
+    VirtualFileSystem _vfs; // Single probe lookups into `_reader`.
+    LodBundleReader _bundle; // Pre-decoded sprites, if there is an up-to-date bundle next to the LOD.
     int _reservedCount = 0;
-    std::unordered_map<std::string, Sprite> _spriteByName;
+    std::unordered_map<std::string, Sprite, IHash, IEqual> _spriteByName;
     std::vector<std::string> _spritesInOrder;
+    std::unordered_map<std::string, std::future<LodSprite>> _pendingByName;
 };
 
 extern LodSpriteCache *pSprites_LOD;
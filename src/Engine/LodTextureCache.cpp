@@ -1,10 +1,20 @@
 #include "LodTextureCache.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
 #include <utility>
 
+#include "Engine/AssetsManager.h"
+#include "Engine/LoadProfiler.h"
+
 #include "Library/LodFormats/LodFormats.h"
+#include "Library/Logger/Logger.h"
 
+#include "Utility/Memory/MemoryAccounting.h"
 #include "Utility/Streams/BlobInputStream.h"
+#include "Utility/Thread/ThreadPool.h"
 #include "Utility/String.h"
 #include "Utility/MapAccess.h"
 
@@ -19,12 +29,25 @@ LodTextureCache *pBitmaps_LOD_mm8 = nullptr;
 LodTextureCache::LodTextureCache() = default;
 
 LodTextureCache::~LodTextureCache() {
+    publishPrefetched();
     for (auto &[_, texture] : _textureByName)
         texture.Release();
 }
 
 void LodTextureCache::open(const std::string &pFilename) {
     _reader.open(pFilename);
+    _vfs.clear();
+    _vfs.mount(_reader);
+
+    _bundle.close();
+    std::string bundlePath = pFilename + ".bundle";
+    if (std::filesystem::exists(bundlePath)) {
+        try {
+            _bundle.open(bundlePath, LodBundleReader::fingerprint(_reader));
+        } catch (const std::exception &e) {
+            logger->warning("Ignoring asset bundle '{}': {}", bundlePath, e.what());
+        }
+    }
 }
 
 void LodTextureCache::reserveLoadedTextures() {
@@ -32,6 +55,8 @@ void LodTextureCache::reserveLoadedTextures() {
 }
 
 void LodTextureCache::releaseUnreserved() {
+    publishPrefetched(); // Make sure no prefetch jobs are running, results will be released right away.
+
     while (_texturesInOrder.size() > _reservedCount) {
         const std::string &name = _texturesInOrder.back();
         _textureByName[name].Release();
@@ -41,18 +66,35 @@ void LodTextureCache::releaseUnreserved() {
 }
 
 Texture_MM7 *LodTextureCache::loadTexture(const std::string &pContainer, bool useDummyOnError) {
+    // Fast path, cache hits don't need a lowercased copy of the name.
+    Texture_MM7 *result = valuePtr(_textureByName, pContainer);
+    if (result) {
+        result->lastUseFrame = assets->frameIndex();
+        return result;
+    }
+
     std::string name = toLower(pContainer);
 
-    Texture_MM7 *result = valuePtr(_textureByName, name);
-    if (result)
-        return result;
+    if (auto pos = _pendingByName.find(name); pos != _pendingByName.end()) {
+        result = publishPrefetched(name, &pos->second);
+        _pendingByName.erase(pos);
+    } else if (auto pos = _warmByName.find(name); pos != _warmByName.end()) {
+        result = publishPrefetched(name, &pos->second);
+        _warmByName.erase(pos);
+    } else {
+        result = &_textureByName[name];
+        if (LoadTextureFromLOD(result, name)) {
+            _texturesInOrder.push_back(name);
+        } else {
+            _textureByName.erase(name);
+            result = nullptr;
+        }
+    }
 
-    result = &_textureByName[name];
-    if (LoadTextureFromLOD(result, name)) {
-        _texturesInOrder.push_back(name);
+    if (result) {
+        result->lastUseFrame = assets->frameIndex();
         return result;
     }
-    _textureByName.erase(name);
 
     if (useDummyOnError) {
         return loadTexture("pending", false);
@@ -61,15 +103,158 @@ Texture_MM7 *LodTextureCache::loadTexture(const std::string &pContainer, bool us
     }
 }
 
+size_t LodTextureCache::memorySize() const {
+    size_t result = 0;
+    for (const auto &[_, texture] : _textureByName)
+        result += texture.indexed.pixels().size_bytes();
+    return result;
+}
+
+size_t LodTextureCache::unloadUnused(int64_t lastUseFrame, size_t size) {
+    std::vector<std::pair<int64_t, size_t>> candidates; // (last use frame, index into _texturesInOrder).
+    for (size_t i = _reservedCount; i < _texturesInOrder.size(); i++) {
+        const Texture_MM7 &texture = _textureByName[_texturesInOrder[i]];
+        if (texture.lastUseFrame <= lastUseFrame)
+            candidates.emplace_back(texture.lastUseFrame, i);
+    }
+    std::ranges::sort(candidates);
+
+    size_t freed = 0;
+    std::vector<bool> unloaded(_texturesInOrder.size());
+    for (const auto &[_, index] : candidates) {
+        if (freed >= size)
+            break;
+
+        Texture_MM7 &texture = _textureByName[_texturesInOrder[index]];
+        freed += texture.indexed.pixels().size_bytes();
+        texture.Release();
+        _textureByName.erase(_texturesInOrder[index]);
+        unloaded[index] = true;
+    }
+
+    // Keep the load order for the remaining textures, reserved ones are never unloaded so _reservedCount stays valid.
+    size_t kept = _reservedCount;
+    for (size_t i = _reservedCount; i < _texturesInOrder.size(); i++) {
+        if (unloaded[i])
+            continue;
+        if (kept != i)
+            _texturesInOrder[kept] = std::move(_texturesInOrder[i]);
+        kept++;
+    }
+    _texturesInOrder.resize(kept);
+    return freed;
+}
+
+void LodTextureCache::prefetchTextures(const std::vector<std::string> &names, ThreadPool *pool) {
+    assert(pool);
+
+    for (const std::string &containerName : names) {
+        std::string name = toLower(containerName);
+        if (shouldPrefetch(name))
+            _pendingByName.emplace(name, startDecoding(name, pool));
+    }
+}
+
+void LodTextureCache::warmTextures(const std::vector<std::string> &names, ThreadPool *pool) {
+    assert(pool);
+
+    std::unordered_map<std::string, std::future<LodImage>, IHash, IEqual> warmByName;
+    for (const std::string &containerName : names) {
+        std::string name = toLower(containerName);
+        if (warmByName.contains(name))
+            continue;
+
+        if (auto pos = _warmByName.find(name); pos != _warmByName.end()) {
+            warmByName.emplace(name, std::move(pos->second));
+        } else if (shouldPrefetch(name)) {
+            warmByName.emplace(name, startDecoding(name, pool));
+        }
+    }
+    _warmByName = std::move(warmByName); // Stale jobs will just finish in the background.
+}
+
+bool LodTextureCache::shouldPrefetch(const std::string &name) const {
+    if (_textureByName.contains(name) || _pendingByName.contains(name) || _warmByName.contains(name))
+        return false;
+
+    if (_bundle.isOpen() && _bundle.exists(name))
+        return false; // Already decoded, will be served from the bundle on first access.
+
+    return _vfs.find(name) != nullptr; // Missing textures will be reported on first access.
+}
+
+std::future<LodImage> LodTextureCache::startDecoding(const std::string &name, ThreadPool *pool) {
+    // Reading from a LOD is thread-safe, it just creates a subblob.
+    return pool->run([blob = _vfs.read(*_vfs.find(name))] {
+        LoadProfilerScope profilerScope("decode texture");
+        MemoryTagScope memoryScope(MEMORY_TAG_TEXTURES);
+        return lod::decodeImage(blob);
+    });
+}
+
+bool LodTextureCache::isPrefetching(std::string_view name) const {
+    for (const auto *map : {&_pendingByName, &_warmByName})
+        if (auto pos = map->find(name); pos != map->end())
+            return pos->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    return false;
+}
+
+void LodTextureCache::publishPrefetched() {
+    for (auto &[name, future] : _pendingByName)
+        publishPrefetched(name, &future);
+    _pendingByName.clear();
+}
+
+Texture_MM7 *LodTextureCache::publishPrefetched(const std::string &name, std::future<LodImage> *future) {
+    LodImage image;
+    try {
+        image = future->get();
+    } catch (const std::exception &e) {
+        logger->warning("Could not decode texture '{}': {}", name, e.what());
+        return nullptr;
+    }
+
+    Texture_MM7 *result = &_textureByName[name];
+    result->name = name;
+    result->indexed = std::move(image.image);
+    result->palette = image.palette;
+    result->zeroIsTransparent = image.zeroIsTransparent;
+    _texturesInOrder.push_back(name);
+    return result;
+}
+
+std::optional<Palette> LodTextureCache::loadPalette(const std::string &name) {
+    if (_bundle.isOpen() && _bundle.exists(name))
+        return _bundle.readImage(name).palette;
+
+    const VfsEntry *entry = _vfs.find(name);
+    if (!entry)
+        return std::nullopt;
+    return lod::decodeImage(_vfs.read(*entry)).palette;
+}
+
+std::vector<std::string> LodTextureCache::ls() const {
+    return _reader.ls();
+}
+
 Blob LodTextureCache::LoadCompressedTexture(const std::string &pContainer) {
-    return lod::decodeCompressed(_reader.read(pContainer));
+    return lod::decodeCompressed(_vfs.read(pContainer));
 }
 
 bool LodTextureCache::LoadTextureFromLOD(Texture_MM7 *pOutTex, const std::string &pContainer) {
-    if (!_reader.exists(pContainer))
-        return false;
+    LoadProfilerScope profilerScope("load texture");
+    MemoryTagScope memoryScope(MEMORY_TAG_TEXTURES);
 
-    LodImage image = lod::decodeImage(_reader.read(pContainer));
+    LodImage image;
+    if (_bundle.isOpen() && _bundle.exists(pContainer)) {
+        image = _bundle.readImage(pContainer);
+    } else {
+        const VfsEntry *entry = _vfs.find(pContainer);
+        if (!entry)
+            return false;
+
+        image = lod::decodeImage(_vfs.read(*entry));
+    }
 
     pOutTex->name = pContainer;
     pOutTex->indexed = std::move(image.image);
@@ -1,17 +1,26 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <memory>
+#include <future>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
 #include "Engine/Graphics/Texture_MM7.h"
 
 #include "Library/Lod/LodReader.h"
+#include "Library/LodFormats/LodBundleReader.h"
+#include "Library/LodFormats/LodFormats.h"
+#include "Library/Vfs/VirtualFileSystem.h"
+
+#include "Utility/String.h"
 
 #include "Utility/Memory/Blob.h"
 
 class LodReader;
+class ThreadPool;
 
 class LodTextureCache {
  public:
@@ -23,18 +32,88 @@ class LodTextureCache {
     void reserveLoadedTextures();
     void releaseUnreserved();
 
+    /**
+     * Starts decoding the provided textures on the worker threads of the provided thread pool. Textures that are
+     * already loaded or are already being prefetched are skipped.
+     *
+     * Decoded textures are published into the cache either on the next `loadTexture` call that asks for them, or
+     * in `publishPrefetched`. This is always done from the calling (main) thread. Prefetched textures go after the
+     * reserved ones, and thus are released in `releaseUnreserved` together with the other level textures.
+     *
+     * @param names                     Names of the textures to prefetch.
+     * @param pool                      Thread pool to run decoding on.
+     */
+    void prefetchTextures(const std::vector<std::string> &names, ThreadPool *pool);
+
+    /**
+     * Same as `prefetchTextures`, but the decoded textures survive `releaseUnreserved`. Meant for the textures of the
+     * level that the party is about to enter. Textures from the previous `warmTextures` call that were not used yet
+     * and are not in `names` are dropped.
+     *
+     * @param names                     Names of the textures to warm up.
+     * @param pool                      Thread pool to run decoding on.
+     */
+    void warmTextures(const std::vector<std::string> &names, ThreadPool *pool);
+
+    /**
+     * Waits for all pending prefetch jobs and publishes their results into the cache.
+     */
+    void publishPrefetched();
+
+    /**
+     * @param name                      Texture name.
+     * @return                          Whether there is a prefetch job for the provided texture that hasn't finished
+     *                                  yet. Calling `loadTexture` for such a texture will block until it finishes.
+     */
+    [[nodiscard]] bool isPrefetching(std::string_view name) const;
+
     Texture_MM7 *loadTexture(const std::string &pContainer, bool useDummyOnError = true);
 
+    /**
+     * Decodes the palette of the provided texture. Doesn't touch the texture cache, the decoded image is dropped.
+     *
+     * @param name                      Texture name.
+     * @return                          Palette of the texture, or `std::nullopt` if there is no such texture.
+     */
+    [[nodiscard]] std::optional<Palette> loadPalette(const std::string &name);
+
+    /**
+     * @return                          Names of all entries in the underlying LOD, sorted.
+     */
+    [[nodiscard]] std::vector<std::string> ls() const;
+
+    /**
+     * @return                          Size of the decoded texture data in this cache, in bytes.
+     */
+    [[nodiscard]] size_t memorySize() const;
+
+    /**
+     * Unloads unreserved textures that were not used after the provided frame, least recently used first. Unloaded
+     * textures are reloaded on next `loadTexture` call.
+     *
+     * @param lastUseFrame              Only textures last used at or before this frame are unloaded.
+     * @param size                      Number of bytes to free.
+     * @return                          Number of bytes actually freed.
+     */
+    size_t unloadUnused(int64_t lastUseFrame, size_t size);
+
     Blob LoadCompressedTexture(const std::string &pContainer); // TODO(captainurist): doesn't belong here.
 
  private:
     bool LoadTextureFromLOD(struct Texture_MM7 *pOutTex, const std::string &pContainer);
+    Texture_MM7 *publishPrefetched(const std::string &name, std::future<LodImage> *future);
+    [[nodiscard]] bool shouldPrefetch(const std::string &name) const;
+    [[nodiscard]] std::future<LodImage> startDecoding(const std::string &name, ThreadPool *pool);
 
  private:
     LodReader _reader;
+    VirtualFileSystem _vfs; // Single probe lookups into `_reader`.
+    LodBundleReader _bundle; // Pre-decoded textures, if there is an up-to-date bundle next to the LOD.
     int _reservedCount = 0;
-    std::unordered_map<std::string, Texture_MM7> _textureByName;
+    std::unordered_map<std::string, Texture_MM7, IHash, IEqual> _textureByName;
     std::vector<std::string> _texturesInOrder;
+    std::unordered_map<std::string, std::future<LodImage>, IHash, IEqual> _pendingByName;
+    std::unordered_map<std::string, std::future<LodImage>, IHash, IEqual> _warmByName; // Not touched by `releaseUnreserved`.
 };
 
 extern LodTextureCache *pIcons_LOD;
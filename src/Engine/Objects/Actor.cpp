@@ -1,12 +1,16 @@
 #include "Engine/Objects/Actor.h"
 
 #include <algorithm>
+#include <limits>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <optional>
 
 #include "Engine/Engine.h"
+#include "Engine/EngineCounters.h"
 #include "Engine/Graphics/Camera.h"
 #include "Engine/Graphics/DecalBuilder.h"
 #include "Engine/Graphics/Level/Decoration.h"
@@ -15,7 +19,9 @@
 #include "Engine/Graphics/Overlays.h"
 #include "Engine/Graphics/Sprites.h"
 #include "Engine/Graphics/Vis.h"
+#include "Engine/LoadProfiler.h"
 #include "Engine/Localization.h"
+#include "Engine/Objects/ActorSpatialHash.h"
 #include "Engine/Objects/ObjectList.h"
 #include "Engine/Objects/SpriteObject.h"
 #include "Engine/Objects/MonsterEnumFunctions.h"
@@ -43,6 +49,7 @@
 
 #include "Utility/Math/TrigLut.h"
 #include "Utility/Math/FixPoint.h"
+#include "Utility/Thread/ThreadPool.h"
 
 // should be injected into Actor but struct size cant be changed
 static SpellFxRenderer *spell_fx_renderer = EngineIocContainer::ResolveSpellFxRenderer();
@@ -718,7 +725,8 @@ void Actor::AggroSurroundingPeasants(unsigned int uActorID, int a2) {
     Actor *victim = &pActors[uActorID];
     if (a2 == 1) victim->attributes |= ACTOR_AGGRESSOR;
 
-    for (unsigned i = 0; i < pActors.size(); ++i) {
+    actorSpatialHash.sync();
+    for (int i : actorSpatialHash.query(victim->pos, 4096, {Dying, Dead, Removed, Summoned, Disabled})) {
         Actor *actor = &pActors[i];
         if (!actor->CanAct() || i == uActorID) continue;
 
@@ -1872,6 +1880,48 @@ void Actor::playSound(unsigned int uActorID, ActorSound uSoundID) {
     }
 }
 
+/**
+ * Points the provided direction at the next portal on the way to the target if the target is in another sector and
+ * can't be seen. Only does anything indoors with `gameplay.PortalNavigation` on.
+ *
+ * @param actor                         Pursuing actor.
+ * @param target                        Pursued object.
+ * @param[in,out] dir                   Direction from the actor to the target. Only yaw & pitch are changed, distances
+ *                                      are left as is so that range checks still work against the target itself.
+ * @return                              Whether the direction was changed.
+ */
+static bool steerThroughPortals(const Actor &actor, Pid target, AIDirection *dir) {
+    if (uCurrentlyLoadedLevelType != LEVEL_INDOOR || !engine->config->gameplay.PortalNavigation.value())
+        return false;
+
+    int targetSector = -1;
+    if (target.type() == OBJECT_Character) {
+        targetSector = pBLVRenderParams->uPartySectorID;
+    } else if (target.type() == OBJECT_Actor) {
+        targetSector = pActors[target.id()].sectorId;
+    }
+    if (targetSector <= 0 || actor.sectorId <= 0 || targetSector == actor.sectorId)
+        return false;
+
+    std::optional<Vec3i> waypoint = pIndoor->sectorNavigation.nextWaypoint(actor.sectorId, targetSector,
+                                                                          actor.monsterInfo.flying);
+    if (!waypoint)
+        return false;
+
+    Vec3i delta = *waypoint - actor.pos;
+    int distanceXY = integer_sqrt(delta.x * delta.x + delta.y * delta.y);
+    if (distanceXY <= actor.radius)
+        return false; // Right at the portal, the target is likely just around the corner.
+
+    if (Detect_Between_Objects(Pid(OBJECT_Actor, actor.id), target))
+        return false;
+
+    dir->uYawAngle = TrigLUT.atan2(delta.x, delta.y);
+    if (actor.monsterInfo.flying)
+        dir->uPitchAngle = TrigLUT.atan2(distanceXY, delta.z);
+    return true;
+}
+
 //----- (00402AD7) --------------------------------------------------------
 void Actor::AI_Pursue1(unsigned int uActorID, Pid a2, signed int arg0,
                        Duration uActionLength, AIDirection *pDir) {
@@ -1916,8 +1966,14 @@ void Actor::AI_Pursue1(unsigned int uActorID, Pid a2, signed int arg0,
     else
         v18 = 16;
 
-    v7->yawAngle = TrigLUT.atan2(pParty->pos.x + TrigLUT.cos(v18 + TrigLUT.uIntegerPi + v10->uYawAngle) * v10->uDistanceXZ - v7->pos.x,
-                                  pParty->pos.y + TrigLUT.sin(v18 + TrigLUT.uIntegerPi + v10->uYawAngle) * v10->uDistanceXZ - v7->pos.y);
+    AIDirection steered = *v10;
+    if (steerThroughPortals(*v7, a2, &steered)) {
+        v10 = &steered;
+        v7->yawAngle = v10->uYawAngle;
+    } else {
+        v7->yawAngle = TrigLUT.atan2(pParty->pos.x + TrigLUT.cos(v18 + TrigLUT.uIntegerPi + v10->uYawAngle) * v10->uDistanceXZ - v7->pos.x,
+                                      pParty->pos.y + TrigLUT.sin(v18 + TrigLUT.uIntegerPi + v10->uYawAngle) * v10->uDistanceXZ - v7->pos.y);
+    }
     if (uActionLength)
         v7->currentActionLength = uActionLength;
     else
@@ -2017,6 +2073,9 @@ void Actor::AI_Pursue2(unsigned int uActorID, Pid a2,
             v7->currentActionLength = 0_ticks;
         if (v7->currentActionLength > 32_ticks) v7->currentActionLength = 32_ticks;
     }
+    AIDirection steered = *v10;
+    if (steerThroughPortals(*v7, a2, &steered))
+        v10 = &steered;
     v7->yawAngle = (short)v10->uYawAngle;
     v14 = (short)v10->uPitchAngle;
     v7->currentActionTime = 0_ticks;
@@ -2069,6 +2128,9 @@ void Actor::AI_Pursue3(unsigned int uActorID, Pid a2,
             v6->currentActionLength = 0_ticks;
         if (v6->currentActionLength > 128_ticks) v6->currentActionLength = 128_ticks;
     }
+    AIDirection steered = *a4;
+    if (steerThroughPortals(*v6, a2, &steered))
+        a4 = &steered;
     v14 = (short)a4->uYawAngle;
     if (grng->random(2))
         v14 += 256;
@@ -2085,43 +2147,48 @@ void Actor::AI_Pursue3(unsigned int uActorID, Pid a2,
     v6->UpdateAnimation();
 }
 
-//----- (00401221) --------------------------------------------------------
-void Actor::_SelectTarget(unsigned int uActorID, Pid *OutTargetPID,
-                          bool can_target_party) {
-    int v5;                     // ecx@1
+// Actor states that _SelectTarget & findTarget skip.
+static constexpr std::initializer_list<AIState> TARGET_EXCLUDED_STATES = {Dead, Dying, Removed, Summoned, Disabled};
+
+// Number of actors per parallel task in Actor::selectTargets.
+static constexpr size_t SELECT_TARGETS_CHUNK_SIZE = 16;
+
+/**
+ * Target selection part of `Actor::_SelectTarget`. Doesn't modify any state, so it's safe to call in parallel for
+ * different actors, as long as line of sight cache is not used.
+ */
+static Pid findTarget(unsigned int uActorID, bool can_target_party, bool useLineOfSightCache) {
     MonsterHostility v10;             // eax@13
     unsigned v11;                   // ebx@16
     unsigned v12;                   // eax@16
     MonsterHostility v14;             // eax@31
     unsigned v15;                   // edi@43
-    //unsigned v16;                   // ebx@45
-    //unsigned v17;                   // eax@45
     signed int closestId;       // [sp+14h] [bp-1Ch]@1
     unsigned v23;                   // [sp+1Ch] [bp-14h]@16
     unsigned int lowestRadius;  // [sp+24h] [bp-Ch]@1
     unsigned v27;                   // [sp+2Ch] [bp-4h]@16
-    //unsigned v28;                   // [sp+2Ch] [bp-4h]@45
 
     lowestRadius = UINT_MAX;
-    v5 = 0;
+    int v5 = 0;
     // TODO(pskelton): change to PID_INVALID and sort logic in calling funcs
-    *OutTargetPID = Pid();
+    Pid result = Pid();
     closestId = 0;
-    assert(uActorID < pActors.size());
     Actor *thisActor = &pActors[uActorID];
 
-    for (unsigned i = 0; i < pActors.size(); ++i) {
+    // Box check below uses the hostility range for the relation between the actors, which is capped by the range of
+    // thisActor's own hostility unless it's friendly.
+    int queryRadius = _4DF380_hostilityRanges[HOSTILITY_LONG];
+    if (thisActor->monsterInfo.hostilityType != HOSTILITY_FRIENDLY)
+        queryRadius = _4DF380_hostilityRanges[pMonsterStats->infos[thisActor->monsterInfo.id].hostilityType];
+
+    for (int i : actorSpatialHash.query(thisActor->pos, queryRadius, TARGET_EXCLUDED_STATES)) {
         Actor *actor = &pActors[i];
-        if (actor->aiState == Dead || actor->aiState == Dying ||
-            actor->aiState == Removed || actor->aiState == Summoned ||
-            actor->aiState == Disabled || uActorID == i)
+        if (uActorID == i)
             continue;
 
-        if (!thisActor->lastCharacterIdToHit || Pid(OBJECT_Actor, v5) != thisActor->lastCharacterIdToHit) {
-            v10 = thisActor->GetActorsRelation(actor);
-            if (v10 == HOSTILITY_FRIENDLY) continue;
-        } else if (thisActor->IsNotAlive()) {
-            thisActor->lastCharacterIdToHit = Pid();
+        // Dead actors have their lastCharacterIdToHit reset in _SelectTarget before we get here.
+        if (!thisActor->lastCharacterIdToHit || Pid(OBJECT_Actor, v5) != thisActor->lastCharacterIdToHit ||
+            thisActor->IsNotAlive()) {
             v10 = thisActor->GetActorsRelation(actor);
             if (v10 == HOSTILITY_FRIENDLY) continue;
         } else {
@@ -2139,7 +2206,7 @@ void Actor::_SelectTarget(unsigned int uActorID, Pid *OutTargetPID,
         v12 = std::abs(thisActor->pos.z - actor->pos.z);
         if (v23 <= v11 && v27 <= v11 && v12 <= v11 &&
             Detect_Between_Objects(Pid(OBJECT_Actor, i),
-                                            Pid(OBJECT_Actor, uActorID)) &&
+                                   Pid(OBJECT_Actor, uActorID), useLineOfSightCache) &&
             v23 * v23 + v27 * v27 + v12 * v12 < lowestRadius) {
             lowestRadius = v23 * v23 + v27 * v27 + v12 * v12;
             closestId = i;
@@ -2147,7 +2214,7 @@ void Actor::_SelectTarget(unsigned int uActorID, Pid *OutTargetPID,
     }
 
     if (lowestRadius != UINT_MAX) {
-        *OutTargetPID = Pid(OBJECT_Actor, closestId);
+        result = Pid(OBJECT_Actor, closestId);
     }
 
     if (can_target_party && !pParty->Invisible()) {
@@ -2168,12 +2235,62 @@ void Actor::_SelectTarget(unsigned int uActorID, Pid *OutTargetPID,
             unsigned v17 = std::abs(thisActor->pos.z - pParty->pos.z);
             if (v16 <= v15 && v28 <= v15 && v17 <= v15 &&
                 (v16 * v16 + v28 * v28 + v17 * v17 < lowestRadius)) {
-                *OutTargetPID = Pid(OBJECT_Character, 0);
+                result = Pid(OBJECT_Character, 0);
+            }
+        }
+    }
+
+    return result;
+}
+
+// Reset part of Actor::_SelectTarget.
+static void resetLastCharacterIdToHit(unsigned int uActorID) {
+    Actor *thisActor = &pActors[uActorID];
+
+    // The target selection loop used to go over all actors, and the first actor that passed the AI state check reset
+    // lastCharacterIdToHit for the dead actors. Nearby actors are not necessarily the same set, so we do this upfront.
+    if (thisActor->lastCharacterIdToHit && Pid(OBJECT_Actor, 0) == thisActor->lastCharacterIdToHit &&
+        thisActor->IsNotAlive()) {
+        for (unsigned i = 0; i < pActors.size(); ++i) {
+            if (i != uActorID && std::ranges::find(TARGET_EXCLUDED_STATES, pActors[i].aiState) ==
+                                     TARGET_EXCLUDED_STATES.end()) {
+                thisActor->lastCharacterIdToHit = Pid();
+                break;
             }
         }
     }
 }
 
+//----- (00401221) --------------------------------------------------------
+void Actor::_SelectTarget(unsigned int uActorID, Pid *OutTargetPID,
+                          bool can_target_party, bool useLineOfSightCache) {
+    assert(uActorID < pActors.size());
+
+    resetLastCharacterIdToHit(uActorID);
+    *OutTargetPID = findTarget(uActorID, can_target_party, useLineOfSightCache);
+}
+
+std::vector<Pid> Actor::selectTargets(std::span<const unsigned int> actorIds, bool can_target_party) {
+    for (unsigned int actorId : actorIds) {
+        assert(actorId < pActors.size());
+        resetLastCharacterIdToHit(actorId);
+    }
+
+    // Line of sight cache is not thread-safe, so we don't use it here.
+    std::vector<Pid> result(actorIds.size());
+    auto select = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            result[i] = findTarget(actorIds[i], can_target_party, false);
+    };
+
+    if (engine->_threadPool) {
+        engine->_threadPool->parallelFor(actorIds.size(), SELECT_TARGETS_CHUNK_SIZE, select);
+    } else {
+        select(0, actorIds.size());
+    }
+    return result;
+}
+
 //----- (0040104C) --------------------------------------------------------
 MonsterHostility Actor::GetActorsRelation(Actor *otherActPtr) {
     MonsterType thisGroup;  // ebp@19
@@ -2497,6 +2614,7 @@ void Actor::SummonMinion(int summonerId) {
     actor->pos.x = v15;
     actor->pos.y = v17;
     actor->pos.z = this->pos.z;
+    actorSpatialHash.update(actor->id);
 
     actor->tetherDistance = 256;
     actor->sectorId = actorSector;
@@ -2532,6 +2650,10 @@ void Actor::UpdateActorAI() {
     Pid target_pid;   // [sp+ACh] [bp-4h]@83
     unsigned v38;
 
+    // Line of sight results are only reused within a single AI tick.
+    if (uCurrentlyLoadedLevelType == LEVEL_INDOOR)
+        pIndoor->sectorVisibility.clearCache();
+
     // Build AI array
     if (uCurrentlyLoadedLevelType == LEVEL_OUTDOOR)
         Actor::MakeActorAIList_ODM();
@@ -2542,6 +2664,9 @@ void Actor::UpdateActorAI() {
     if (uCurrentlyLoadedLevelType != LEVEL_INDOOR && pParty->armageddon_timer)
         armageddonProgress();
 
+    // Actors only move in between AI ticks, so syncing once here is enough for the target selection below.
+    actorSpatialHash.sync();
+
     // Turn-based mode: return
     if (pParty->bTurnBasedModeOn) {
         pTurnEngine->AITurnBasedAction();
@@ -2612,6 +2737,13 @@ void Actor::UpdateActorAI() {
         pActor->UpdateAnimation();
     }
 
+    // With parallel targeting, targets for all the actors in "full" ai state are selected upfront, against the world
+    // state before any of these actors act. No random numbers are drawn during target selection.
+    std::vector<Pid> selectedTargets;
+    bool parallelTargeting = engine->config->gameplay.ParallelActorTargeting.value();
+    if (parallelTargeting)
+        selectedTargets = Actor::selectTargets(std::span(ai_near_actors_ids).first(ai_arrays_size), true);
+
     // loops over for the actors in "full" ai state
     for (int v78 = 0; v78 < ai_arrays_size; ++v78) {
         unsigned actor_id = ai_near_actors_ids[v78];
@@ -2622,7 +2754,11 @@ void Actor::UpdateActorAI() {
 
         v47 = pActor->monsterInfo.recoveryTime * flt_debugrecmod3;
 
-        Actor::_SelectTarget(actor_id, &ai_near_actors_targets_pid[actor_id], true);
+        if (parallelTargeting) {
+            ai_near_actors_targets_pid[actor_id] = selectedTargets[v78];
+        } else {
+            Actor::_SelectTarget(actor_id, &ai_near_actors_targets_pid[actor_id], true, true);
+        }
 
         if (pActor->monsterInfo.hostilityType != HOSTILITY_FRIENDLY && !ai_near_actors_targets_pid[actor_id])
             pActor->monsterInfo.hostilityType = HOSTILITY_FRIENDLY;
@@ -2969,6 +3105,8 @@ int Actor::searchDeadActors(int *pTotalActors) {
 
 //----- (00408768) --------------------------------------------------------
 void Actor::InitializeActors() {
+    LoadProfilerScope profilerScope("Actor::InitializeActors");
+
     bool bCelestia = false;
     bool bPit = false;
     bool good = false;
@@ -3531,7 +3669,8 @@ bool CheckActors_proximity() {
     distance = 5120;
     if (uCurrentlyLoadedLevelType == LEVEL_INDOOR) distance = 2560;
 
-    for (unsigned i = 0; i < pActors.size(); ++i) {
+    actorSpatialHash.sync();
+    for (int i : actorSpatialHash.query(pParty->pos.toInt(), distance, {Dead, Dying, Removed, Disabled, Summoned})) {
         for_x = std::abs(pActors[i].pos.x - pParty->pos.x);
         for_y = std::abs(pActors[i].pos.y - pParty->pos.y);
         for_z = std::abs(pActors[i].pos.z - pParty->pos.z);
@@ -4018,7 +4157,7 @@ int Actor::MakeActorAIList_BLV() {
 
     // checks nearby actors can detect player and take nearest 30
     for (const auto &[actorId, _] : activeActorsDistances) {
-        if (pActors[actorId].ActorNearby() || Detect_Between_Objects(Pid(OBJECT_Actor, actorId), Pid(OBJECT_Character, 0))) {
+        if (pActors[actorId].ActorNearby() || Detect_Between_Objects(Pid(OBJECT_Actor, actorId), Pid(OBJECT_Character, 0), true)) {
             pActors[actorId].attributes |= ACTOR_NEARBY;
             pickedActorIds.push_back(actorId);
             if (pickedActorIds.size() >= 30) {
@@ -4060,69 +4199,12 @@ int Actor::MakeActorAIList_BLV() {
     return ai_arrays_size;
 }
 
-//----- (004070EF) --------------------------------------------------------
-bool Detect_Between_Objects(Pid uObjID, Pid uObj2ID) {
-    // get object 1 info
-    int obj1_pid = uObjID.id();
-    int obj1_sector;
-    Vec3i pos1;
-
-    switch (uObjID.type()) {
-        case OBJECT_Decoration:
-            pos1 = pLevelDecorations[obj1_pid].vPosition;
-            obj1_sector = pIndoor->GetSector(pos1);
-            break;
-        case OBJECT_Actor:
-            pos1 = pActors[obj1_pid].pos + Vec3i(0, 0, pActors[obj1_pid].height * 0.69999999);
-            obj1_sector = pActors[obj1_pid].sectorId;
-            break;
-        case OBJECT_Item:
-            pos1 = pSpriteObjects[obj1_pid].vPosition;
-            obj1_sector = pSpriteObjects[obj1_pid].uSectorID;
-            break;
-        default:
-            return 0;
-    }
-
-    // get object 2 info
-    int obj2_pid = uObj2ID.id();
-    int obj2_sector;
-    Vec3i pos2;
-
-    switch (uObj2ID.type()) {
-        case OBJECT_Decoration:
-            pos2 = pLevelDecorations[obj2_pid].vPosition;
-            obj2_sector = pIndoor->GetSector(pos2);
-            break;
-        case OBJECT_Character:
-            pos2 = pParty->pos.toInt() + Vec3i(0, 0, pParty->eyeLevel);
-            obj2_sector = pBLVRenderParams->uPartyEyeSectorID;
-            break;
-        case OBJECT_Actor:
-            pos2 = pActors[obj2_pid].pos + Vec3i(0, 0, pActors[obj2_pid].height * 0.69999999);
-            obj2_sector = pActors[obj2_pid].sectorId;
-            break;
-        case OBJECT_Item:
-            pos2 = pSpriteObjects[obj2_pid].vPosition;
-            obj2_sector = pSpriteObjects[obj2_pid].uSectorID;
-            break;
-        default:
-            return 0;
-    }
-
-    // get distance between objects
+// Portal walk part of Detect_Between_Objects, a pure function of its arguments.
+static bool Detect_Through_Portals(const Vec3i &pos1, int obj1_sector, const Vec3i &pos2, int obj2_sector) {
     float dist_x = pos2.x - pos1.x;
     float dist_y = pos2.y - pos1.y;
     float dist_z = pos2.z - pos1.z;
     float dist_3d = sqrt(dist_x * dist_x + dist_y * dist_y + dist_z * dist_z);
-    // range check
-    if (dist_3d > 5120) return 0;
-
-    // if in range always detected outdoors
-    if (uCurrentlyLoadedLevelType == LEVEL_OUTDOOR) return 1;
-
-    // monster in same sector with player/ monster
-    if (obj1_sector == obj2_sector) return 1;
 
     // normalising
     float rayxnorm = dist_x / dist_3d;
@@ -4207,7 +4289,7 @@ bool Detect_Between_Objects(Pid uObjID, Pid uObj2ID) {
 
             // did we hit limit for portals?
             // does the next room have portals?
-            if (sectors_visited < 30 && pIndoor->pSectors[current_sector].uNumPortals > 0) {
+            if (sectors_visited < LINE_OF_SIGHT_MAX_PORTALS && pIndoor->pSectors[current_sector].uNumPortals > 0) {
                 current_portal = -1;
                 continue;
             } else {
@@ -4220,6 +4302,86 @@ bool Detect_Between_Objects(Pid uObjID, Pid uObj2ID) {
     return 1;
 }
 
+//----- (004070EF) --------------------------------------------------------
+bool Detect_Between_Objects(Pid uObjID, Pid uObj2ID, bool useCache) {
+    engineCounters.lineOfSightChecks.fetch_add(1, std::memory_order_relaxed);
+
+    // get object 1 info
+    int obj1_pid = uObjID.id();
+    int obj1_sector;
+    Vec3i pos1;
+
+    switch (uObjID.type()) {
+        case OBJECT_Decoration:
+            pos1 = pLevelDecorations[obj1_pid].vPosition;
+            obj1_sector = pIndoor->GetSector(pos1);
+            break;
+        case OBJECT_Actor:
+            pos1 = pActors[obj1_pid].pos + Vec3i(0, 0, pActors[obj1_pid].height * 0.69999999);
+            obj1_sector = pActors[obj1_pid].sectorId;
+            break;
+        case OBJECT_Item:
+            pos1 = pSpriteObjects[obj1_pid].vPosition;
+            obj1_sector = pSpriteObjects[obj1_pid].uSectorID;
+            break;
+        default:
+            return 0;
+    }
+
+    // get object 2 info
+    int obj2_pid = uObj2ID.id();
+    int obj2_sector;
+    Vec3i pos2;
+
+    switch (uObj2ID.type()) {
+        case OBJECT_Decoration:
+            pos2 = pLevelDecorations[obj2_pid].vPosition;
+            obj2_sector = pIndoor->GetSector(pos2);
+            break;
+        case OBJECT_Character:
+            pos2 = pParty->pos.toInt() + Vec3i(0, 0, pParty->eyeLevel);
+            obj2_sector = pBLVRenderParams->uPartyEyeSectorID;
+            break;
+        case OBJECT_Actor:
+            pos2 = pActors[obj2_pid].pos + Vec3i(0, 0, pActors[obj2_pid].height * 0.69999999);
+            obj2_sector = pActors[obj2_pid].sectorId;
+            break;
+        case OBJECT_Item:
+            pos2 = pSpriteObjects[obj2_pid].vPosition;
+            obj2_sector = pSpriteObjects[obj2_pid].uSectorID;
+            break;
+        default:
+            return 0;
+    }
+
+    // get distance between objects
+    float dist_x = pos2.x - pos1.x;
+    float dist_y = pos2.y - pos1.y;
+    float dist_z = pos2.z - pos1.z;
+    float dist_3d = sqrt(dist_x * dist_x + dist_y * dist_y + dist_z * dist_z);
+    // range check
+    if (dist_3d > LINE_OF_SIGHT_MAX_DISTANCE) return 0;
+
+    // if in range always detected outdoors
+    if (uCurrentlyLoadedLevelType == LEVEL_OUTDOOR) return 1;
+
+    // monster in same sector with player/ monster
+    if (obj1_sector == obj2_sector) return 1;
+
+    // sectors too far apart
+    if (!pIndoor->sectorVisibility.potentiallyVisible(obj1_sector, obj2_sector)) return 0;
+
+    if (!useCache)
+        return Detect_Through_Portals(pos1, obj1_sector, pos2, obj2_sector);
+
+    if (std::optional<bool> cached = pIndoor->sectorVisibility.cachedLineOfSight(pos1, obj1_sector, pos2, obj2_sector))
+        return *cached;
+
+    bool result = Detect_Through_Portals(pos1, obj1_sector, pos2, obj2_sector);
+    pIndoor->sectorVisibility.cacheLineOfSight(pos1, obj1_sector, pos2, obj2_sector, result);
+    return result;
+}
+
 //----- (0044FA4C) --------------------------------------------------------
 void Spawn_Light_Elemental(int spell_power, CharacterSkillMastery caster_skill_mastery, Duration duration) {
     // size_t uActorIndex;            // [sp+10h] [bp-10h]@6
@@ -4440,6 +4602,15 @@ void SpawnEncounter(MapInfo *pMapInfo, SpawnPoint *spawn, int a3, int a4, int a5
 
     // if (v57 == 4) return;
 
+    // Monster lookups below are linear scans by name, and a spawn only has up to four distinct names (plain, A, B & C),
+    // so we resolve each name once.
+    struct SpawnTemplate {
+        MonsterId descId = MONSTER_INVALID;
+        MonsterId statsId = MONSTER_INVALID;
+    };
+    std::unordered_map<std::string, SpawnTemplate> templates;
+    pActors.reserve(std::min<size_t>(pActors.size() + NumToSpawn, 500));
+
     // spawning loop
     for (int i = v53; i < NumToSpawn; ++i) {
         Actor *pMonster = AllocateActor(true);
@@ -4471,13 +4642,20 @@ void SpawnEncounter(MapInfo *pMapInfo, SpawnPoint *spawn, int a3, int a4, int a5
             }
         }
 
-        MonsterId v50 = pMonsterList->GetMonsterIDByName(Str2);
+        auto [templateIt, inserted] = templates.try_emplace(Str2);
+        SpawnTemplate &spawnTemplate = templateIt->second;
+        if (inserted) {
+            spawnTemplate.descId = pMonsterList->GetMonsterIDByName(Str2);
+            spawnTemplate.statsId = pMonsterStats->FindMonsterByTextureName(Str2);
+            // TODO(captainurist): MONSTER_ANGEL_A is monster #1, why do we even need this check?
+            if (spawnTemplate.statsId == MONSTER_INVALID) spawnTemplate.statsId = MONSTER_ANGEL_A;
+        }
+
+        MonsterId v50 = spawnTemplate.descId;
         pTexture = Str2;
 
         v27 = &pMonsterList->monsters[v50];
-        v28 = pMonsterStats->FindMonsterByTextureName(pTexture);
-        // TODO(captainurist): MONSTER_ANGEL_A is monster #1, why do we even need this check?
-        if (v28 == MONSTER_INVALID) v28 = MONSTER_ANGEL_A;
+        v28 = spawnTemplate.statsId;
         Src = &pMonsterStats->infos[v28];
         pMonster->name = Src->name;
         pMonster->currentHP = Src->hp;
@@ -4538,6 +4716,8 @@ void SpawnEncounter(MapInfo *pMapInfo, SpawnPoint *spawn, int a3, int a4, int a5
 void evaluateAoeDamage() {
     SpriteObject *pSpriteObj = nullptr;
 
+    actorSpatialHash.sync();
+
     for (AttackDescription &attack : attackList) {
         ObjectType attackerType = attack.pid.type();
         int attackerId = attack.pid.id();
@@ -4587,13 +4767,29 @@ void evaluateAoeDamage() {
                 }
             }
         } else {  // damage from AOE spells
+            // All the line of sight checks below go from the attack position to the targets within the attack range,
+            // offset sideways by 32 units. So outdoors they can share the model culling, which is done on first use.
+            std::optional<std::vector<int>> losModels;
+            auto lineOfSight = [&](const Vec3i &target) {
+                if (uCurrentlyLoadedLevelType != LEVEL_OUTDOOR)
+                    return Check_LineOfSight(target, attack.pos);
+
+                if (!losModels) {
+                    int extent = attack.attackRange + std::max(32, actorSpatialHash.maxActorRadius()) + 32 + 1;
+                    BBoxi box = {attack.pos.x - extent, attack.pos.x + extent, attack.pos.y - extent, attack.pos.y + extent,
+                                 std::numeric_limits<int>::min() / 2, std::numeric_limits<int>::max() / 2};
+                    losModels = outdoorModelsIntersecting(box);
+                }
+                return Check_LineOfSight(target, attack.pos, &*losModels);
+            };
+
             int distanceSq = (pParty->pos.toInt() + Vec3i(0, 0, pParty->height / 2) - attack.pos).lengthSqr();
             int attackRangeSq = (attack.attackRange + 32) * (attack.attackRange + 32);
 
             // check spell in range of party
             if (distanceSq < attackRangeSq) {  // party damage
                 // check line of sight to party
-                if (Check_LineOfSight(pParty->pos.toInt() + Vec3i(0, 0, pParty->eyeLevel), attack.pos)) {
+                if (lineOfSight(pParty->pos.toInt() + Vec3i(0, 0, pParty->eyeLevel))) {
                     for (int i = 0; i < pParty->pCharacters.size(); i++) {
                         if (pParty->pCharacters[i].conditions.HasNone({CONDITION_DEAD, CONDITION_PETRIFIED, CONDITION_ERADICATED})) {
                             DamageCharacterFromMonster(attack.pid, attack.attackSpecial, &attackVector, i);
@@ -4602,7 +4798,8 @@ void evaluateAoeDamage() {
                 }
             }
 
-            for (int actorID = 0; actorID < pActors.size(); ++actorID) {
+            int queryRadius = attack.attackRange + actorSpatialHash.maxActorRadius();
+            for (int actorID : actorSpatialHash.query(attack.pos, queryRadius, {Dying, Dead, Removed, Summoned, Disabled})) {
                 if (pActors[actorID].CanAct()) {
                     Vec3i distanceVec = pActors[actorID].pos + Vec3i(0, 0, pActors[actorID].height / 2) - attack.pos;
                     int distanceSq = distanceVec.lengthSqr();
@@ -4614,7 +4811,7 @@ void evaluateAoeDamage() {
                     // check range
                     if (distanceSq < attackRangeSq) {
                         // check line of sight
-                        if (Check_LineOfSight(pActors[actorID].pos + Vec3i(0, 0, 50), attack.pos)) {
+                        if (lineOfSight(pActors[actorID].pos + Vec3i(0, 0, 50))) {
                             normalize_to_fixpoint(&attackVector.x, &attackVector.y, &attackVector.z);
                             switch (attackerType) {
                                 case OBJECT_Character:
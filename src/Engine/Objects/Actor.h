@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <vector>
 #include <string>
 
@@ -48,7 +49,7 @@ struct ActorJob {
 
 class GUIWindow;
 
-class Actor {
+class alignas(64) Actor {
  public:
     Actor() {}
     explicit Actor(int id): id(id) {}
@@ -84,8 +85,27 @@ class Actor {
         return attributes & ACTOR_NEARBY;
     }
 
+    /**
+     * @param uActorID                  Id of the actor to select a target for.
+     * @param OutTargetPID              Output, selected target.
+     * @param can_target_party          Whether the party can be selected as a target.
+     * @param useLineOfSightCache       Whether to use the line of sight cache, see `Detect_Between_Objects`. Should
+     *                                  only be `true` when called from `UpdateActorAI`.
+     */
     static void _SelectTarget(unsigned int uActorID, Pid *OutTargetPID,
-                              bool can_target_party);
+                              bool can_target_party, bool useLineOfSightCache = false);
+
+    /**
+     * Batch version of `_SelectTarget`, selects targets for several actors in parallel on the engine thread pool.
+     *
+     * All targets are selected against the same world state, so the results might differ from calling `_SelectTarget`
+     * for each of the actors in turn, with the actors acting in between. Doesn't use the random number generators.
+     *
+     * @param actorIds                  Ids of the actors to select targets for.
+     * @param can_target_party          Whether the party can be selected as a target.
+     * @return                          Selected targets, in the same order as `actorIds`.
+     */
+    static std::vector<Pid> selectTargets(std::span<const unsigned int> actorIds, bool can_target_party);
     static void AI_Pursue3(unsigned int uActorID, Pid a2,
                            Duration uActionLength, struct AIDirection *a4);
     static void AI_Pursue2(unsigned int uActorID, Pid a2,
@@ -199,31 +219,35 @@ class Actor {
     int CalcMagicalDamageToActor(DamageType dmgType, int incomingDmg);
     bool DoesDmgTypeDoDamage(DamageType uType);
 
+    // Hot data, accessed by the per-tick loops over all actors (AI lists, spatial hash, movement, rendering). Kept
+    // together at the start of the object so that such loops touch as few cache lines per actor as possible.
     int id = -1; // Actor index in pActors array.
-    std::string name;
-    int16_t npcId = 0;
     ActorAttributes attributes = 0;
-    int16_t currentHP = 0;
-    MonsterInfo monsterInfo;
-    int16_t word_000084_range_attack = 0;
-    MonsterId word_000086_some_monster_id = MONSTER_INVALID;  // base monster class monsterlist id
+    AIState aiState = Standing;
     uint16_t radius = 32;
     uint16_t height = 128;
     uint16_t moveSpeed = 200;
-    Vec3i pos;
-    Vec3i speed; // TODO(captainurist): velocity is a better name for this, speed = ||velocity||
     uint16_t yawAngle = 0;
     uint16_t pitchAngle = 0;
     int sectorId = 0;
+    Vec3i pos;
+    Vec3i speed; // TODO(captainurist): velocity is a better name for this, speed = ||velocity||
+    ActorAnimation currentActionAnimation = ANIM_Standing;
+    Duration currentActionTime = 0_ticks;
     Duration currentActionLength = 0_ticks;
+    int16_t currentHP = 0;
+
+    // Cold data.
+    std::string name;
+    int16_t npcId = 0;
+    MonsterInfo monsterInfo;
+    int16_t word_000084_range_attack = 0;
+    MonsterId word_000086_some_monster_id = MONSTER_INVALID;  // base monster class monsterlist id
     Vec3i initialPosition;
     Vec3i guardingPosition;
     uint16_t tetherDistance = 256;
-    AIState aiState = Standing;
-    ActorAnimation currentActionAnimation = ANIM_Standing;
     ItemId carriedItemId = ITEM_NULL; // carried items are special items the
                                          // ncp carries (ie lute from bard)
-    Duration currentActionTime = 0_ticks;
     IndexedArray<uint16_t, ANIM_First, ANIM_Last> spriteIds = {{}};
     IndexedArray<SoundId, ACTOR_SOUND_FIRST, ACTOR_SOUND_LAST> soundSampleIds = {{}};
     IndexedArray<SpellBuff, ACTOR_BUFF_FIRST, ACTOR_BUFF_LAST> buffs;
@@ -238,6 +262,11 @@ class Actor {
     Duration massDistortionTime; // Value of pMiscTimer when mass distortion was cast. This was stored in the buffs table
                                  // in vanilla, which made little sense. Buff table stores game time, putting a value of
                                  // a misc timer in there is very questionable.
+    Duration lodSkippedTime; // Time that this actor's movement wasn't updated for because it was far away from the
+                             // party, see the actor_lod config option. Not saved.
+    bool asleep = false; // Whether this actor's movement is not updated, see the actor_sleep config option. Not saved.
+    Vec3i sleepPos; // Position at which the actor was put to sleep.
+    AIState sleepAiState = Standing; // AI state in which the actor was put to sleep.
 };
 
 extern std::vector<Actor> pActors;
@@ -253,7 +282,24 @@ void npcSetItem(int npc, ItemId item, int a3);
  * @offset 0x448A98
  */
 void toggleActorGroupFlag(unsigned int uGroupID, ActorAttribute uFlag, bool bValue);
-bool Detect_Between_Objects(Pid uObjID, Pid uObj2ID);
+
+static constexpr int LINE_OF_SIGHT_MAX_DISTANCE = 5120;
+static constexpr int LINE_OF_SIGHT_MAX_PORTALS = 30;
+
+/**
+ * @offset 0x4070EF
+ *
+ * @param uObjID                        Object that's looking.
+ * @param uObj2ID                       Object that's being looked at.
+ * @return                              Whether `uObj2ID` is within `LINE_OF_SIGHT_MAX_DISTANCE` and can be seen from
+ *                                      `uObjID`. Indoors this walks the portals between the objects' sectors, using
+ *                                      `IndoorLocation::sectorVisibility` to skip the walk when possible.
+ * @param useCache                      Whether to use the line of sight cache. The cache is only cleared at the start
+ *                                      of `Actor::UpdateActorAI`, so this should only be `true` in code that's called
+ *                                      from there, otherwise results from the previous AI tick might be returned. The
+ *                                      cache is also not thread-safe, so in parallel code this should be `false`.
+ */
+bool Detect_Between_Objects(Pid uObjID, Pid uObj2ID, bool useCache = false);
 void Spawn_Light_Elemental(int spell_power, CharacterSkillMastery caster_skill_mastery, Duration duration);
 void SpawnEncounter(struct MapInfo *pMapInfo, SpawnPoint *spawn, int a3, int a4, int a5);
 /**
@@ -0,0 +1,83 @@
+#include "ActorSpatialHash.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Actor.h"
+
+ActorSpatialHash actorSpatialHash;
+
+void ActorSpatialHash::sync() {
+    for (int i = pActors.size(); i < _actorCells.size(); i++)
+        remove(i);
+    _actorCells.resize(pActors.size(), NO_CELL);
+
+    _maxActorRadius = 0;
+    for (int i = 0; i < pActors.size(); i++)
+        update(i);
+}
+
+void ActorSpatialHash::update(int actorId) {
+    assert(actorId >= 0 && actorId < pActors.size());
+
+    if (actorId >= _actorCells.size())
+        _actorCells.resize(actorId + 1, NO_CELL);
+
+    const Actor &actor = pActors[actorId];
+    _maxActorRadius = std::max<int>(_maxActorRadius, actor.radius);
+
+    int64_t key = cellKey(actor.pos.x >> CELL_SHIFT, actor.pos.y >> CELL_SHIFT);
+    if (_actorCells[actorId] == key)
+        return;
+
+    remove(actorId);
+    insert(actorId, key);
+}
+
+std::vector<int> ActorSpatialHash::query(const Vec3i &center, int radius,
+                                         std::initializer_list<AIState> excludedStates) const {
+    assert(radius >= 0);
+
+    std::vector<int> result;
+    int minX = (center.x - radius) >> CELL_SHIFT;
+    int maxX = (center.x + radius) >> CELL_SHIFT;
+    int minY = (center.y - radius) >> CELL_SHIFT;
+    int maxY = (center.y + radius) >> CELL_SHIFT;
+    for (int x = minX; x <= maxX; x++) {
+        for (int y = minY; y <= maxY; y++) {
+            auto pos = _cells.find(cellKey(x, y));
+            if (pos == _cells.end())
+                continue;
+
+            for (int actorId : pos->second)
+                if (std::ranges::find(excludedStates, pActors[actorId].aiState) == excludedStates.end())
+                    result.push_back(actorId);
+        }
+    }
+
+    std::ranges::sort(result);
+    return result;
+}
+
+void ActorSpatialHash::insert(int actorId, int64_t key) {
+    _cells[key].push_back(actorId);
+    _actorCells[actorId] = key;
+}
+
+void ActorSpatialHash::remove(int actorId) {
+    int64_t key = _actorCells[actorId];
+    if (key == NO_CELL)
+        return;
+
+    auto pos = _cells.find(key);
+    assert(pos != _cells.end());
+    std::vector<int> &cell = pos->second;
+    auto actorPos = std::ranges::find(cell, actorId);
+    assert(actorPos != cell.end());
+    *actorPos = cell.back();
+    cell.pop_back();
+    if (cell.empty())
+        _cells.erase(pos);
+
+    _actorCells[actorId] = NO_CELL;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+#include "Library/Geometry/Vec.h"
+
+#include "ActorEnums.h"
+
+/**
+ * Uniform spatial hash over the positions of `pActors`, in the XY plane.
+ *
+ * Used to replace the loops over all actors with loops over the actors near the point of interest. The hash doesn't
+ * track actor positions on its own - `sync` should be called before the queries if actors might have moved or were
+ * added or removed, and `update` can be used to re-bucket a single actor. `sync` only moves the actors whose cell has
+ * changed, and is cheap compared to the queries it replaces.
+ *
+ * Queries return candidates in ascending actor id order, same as the loops over `pActors` that they replace, so
+ * that the game logic stays deterministic.
+ */
+class ActorSpatialHash {
+ public:
+    static constexpr int CELL_SHIFT = 11;
+    static constexpr int CELL_SIZE = 1 << CELL_SHIFT;
+
+    ActorSpatialHash() = default;
+
+    /**
+     * Brings the hash up to date with `pActors`.
+     */
+    void sync();
+
+    /**
+     * Re-buckets a single actor, e.g. after it was spawned or teleported.
+     *
+     * @param actorId                   Id of the actor in `pActors`, might be the id of a new actor.
+     */
+    void update(int actorId);
+
+    /**
+     * @param center                    Query center.
+     * @param radius                    Query radius. Actors are returned if they are in a cell that overlaps the
+     *                                  `[center - radius, center + radius]` XY box, so callers still need to do their
+     *                                  own distance checks.
+     * @param excludedStates            AI states of the actors to skip.
+     * @return                          Ids of the candidate actors, in ascending order.
+     */
+    [[nodiscard]] std::vector<int> query(const Vec3i &center, int radius,
+                                         std::initializer_list<AIState> excludedStates = {}) const;
+
+    /**
+     * @return                          Max radius of the actors in the hash, can be used to expand the query radius
+     *                                  for checks that take actor radius into account.
+     */
+    [[nodiscard]] int maxActorRadius() const {
+        return _maxActorRadius;
+    }
+
+ private:
+    static constexpr int64_t NO_CELL = INT64_MIN;
+
+    static int64_t cellKey(int cellX, int cellY) {
+        return (static_cast<int64_t>(cellX) << 32) | static_cast<uint32_t>(cellY);
+    }
+
+    void insert(int actorId, int64_t key);
+    void remove(int actorId);
+
+ private:
+    std::vector<int64_t> _actorCells; // Cell key for each actor, `NO_CELL` if not in the hash.
+    std::unordered_map<int64_t, std::vector<int>> _cells;
+    int _maxActorRadius = 0;
+};
+
+extern ActorSpatialHash actorSpatialHash;
@@ -1,6 +1,8 @@
 #include "Engine/Objects/Character.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <memory>
 
 #include "Engine/Engine.h"
@@ -20,6 +22,7 @@
 #include "Engine/Objects/SpriteObject.h"
 #include "Engine/Objects/NPC.h"
 #include "Engine/Objects/CharacterEnumFunctions.h"
+#include "Engine/Objects/CharacterStatsCache.h"
 #include "Engine/Objects/MonsterEnumFunctions.h"
 #include "Engine/OurMath.h"
 #include "Engine/Party.h"
@@ -628,24 +631,55 @@ void Character::SetCondition(Condition condition, int blockable) {
     return;
 }
 
+using InventoryOccupancy = std::array<uint16_t, Character::INVENTORY_SLOTS_HEIGHT>;
+static_assert(Character::INVENTORY_SLOTS_WIDTH <= 16);
+
+/**
+ * @param matrix                        Inventory matrix.
+ * @return                              Occupancy bitmap of the provided inventory, a bitmask of taken cells per row.
+ */
+static InventoryOccupancy inventoryOccupancy(const std::array<int, Character::INVENTORY_SLOT_COUNT> &matrix) {
+    InventoryOccupancy result = {};
+    for (unsigned int y = 0; y < Character::INVENTORY_SLOTS_HEIGHT; y++)
+        for (unsigned int x = 0; x < Character::INVENTORY_SLOTS_WIDTH; x++)
+            if (matrix[y * Character::INVENTORY_SLOTS_WIDTH + x] != 0)
+                result[y] |= 1 << x;
+    return result;
+}
+
+static Sizei inventoryItemSize(ItemId itemId) {
+    GraphicsImage *img = assets->getImage_ColorKey(pItemTable->pItems[itemId].iconName);
+    Sizei result(GetSizeInInventorySlots(img->width()), GetSizeInInventorySlots(img->height()));
+    assert(result.h > 0 && result.w > 0 && "Items should have nonzero dimensions");
+    return result;
+}
+
+static bool inventoryItemFits(const InventoryOccupancy &occupancy, unsigned int x, unsigned int y, Sizei size) {
+    if (x + size.w > Character::INVENTORY_SLOTS_WIDTH || y + size.h > Character::INVENTORY_SLOTS_HEIGHT)
+        return false;
+
+    uint16_t mask = ((1 << size.w) - 1) << x;
+    for (unsigned int row = y; row < y + size.h; row++)
+        if (occupancy[row] & mask)
+            return false;
+    return true;
+}
+
 bool Character::canFitItem(unsigned int uSlot, ItemId uItemID) const {
-    auto img = assets->getImage_ColorKey(pItemTable->pItems[uItemID].iconName);
-    unsigned int slotWidth = GetSizeInInventorySlots(img->width());
-    unsigned int slotHeight = GetSizeInInventorySlots(img->height());
-
-    assert(slotHeight > 0 && slotWidth > 0 && "Items should have nonzero dimensions");
-    if ((slotWidth + uSlot % INVENTORY_SLOTS_WIDTH) <= INVENTORY_SLOTS_WIDTH &&
-        (slotHeight + uSlot / INVENTORY_SLOTS_WIDTH) <= INVENTORY_SLOTS_HEIGHT) {
-        for (unsigned int x = 0; x < slotWidth; x++) {
-            for (unsigned int y = 0; y < slotHeight; y++) {
-                if (pInventoryMatrix[y * INVENTORY_SLOTS_WIDTH + x + uSlot] != 0) {
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
-    return false;
+    return inventoryItemFits(inventoryOccupancy(pInventoryMatrix), uSlot % INVENTORY_SLOTS_WIDTH,
+                             uSlot / INVENTORY_SLOTS_WIDTH, inventoryItemSize(uItemID));
+}
+
+int Character::findFreeInventorySlot(ItemId uItemID) const {
+    // Size & occupancy are computed once, so the search is a handful of bit ops per cell.
+    InventoryOccupancy occupancy = inventoryOccupancy(pInventoryMatrix);
+    Sizei size = inventoryItemSize(uItemID);
+
+    for (unsigned int x = 0; x < INVENTORY_SLOTS_WIDTH; x++)
+        for (unsigned int y = 0; y < INVENTORY_SLOTS_HEIGHT; y++)
+            if (inventoryItemFits(occupancy, x, y, size))
+                return y * INVENTORY_SLOTS_WIDTH + x;
+    return -1;
 }
 
 int Character::findFreeInventoryListSlot() const {
@@ -706,15 +740,11 @@ int Character::AddItem(int index, ItemId uItemID) {
     }
 
     if (index == -1) {  // no location specified - search for space
-        for (int xcoord = 0; xcoord < INVENTORY_SLOTS_WIDTH; xcoord++) {
-            for (int ycoord = 0; ycoord < INVENTORY_SLOTS_HEIGHT; ycoord++) {
-                if (canFitItem(ycoord * INVENTORY_SLOTS_WIDTH + xcoord, uItemID)) {  // found space
-                    return CreateItemInInventory(ycoord * INVENTORY_SLOTS_WIDTH + xcoord, uItemID);
-                }
-            }
-        }
+        int slot = findFreeInventorySlot(uItemID);
+        if (slot == -1)
+            return 0;  // no space cant add item
 
-        return 0;  // no space cant add item
+        return CreateItemInInventory(slot, uItemID);
     }
 
     if (!canFitItem(index, uItemID)) {
@@ -730,17 +760,11 @@ int Character::AddItem2(int index, ItemGen *Src) {  // are both required - check
     pItemTable->SetSpecialBonus(Src);
 
     if (index == -1) {  // no loaction specified
-        for (int xcoord = 0; xcoord < INVENTORY_SLOTS_WIDTH; xcoord++) {
-            for (int ycoord = 0; ycoord < INVENTORY_SLOTS_HEIGHT; ycoord++) {
-                if (canFitItem(ycoord * INVENTORY_SLOTS_WIDTH + xcoord,
-                               Src->uItemID)) {  // found space
-                    return CreateItemInInventory2(
-                        ycoord * INVENTORY_SLOTS_WIDTH + xcoord, Src);
-                }
-            }
-        }
+        int slot = findFreeInventorySlot(Src->uItemID);
+        if (slot == -1)
+            return 0;
 
-        return 0;
+        return CreateItemInInventory2(slot, Src);
     }
 
     if (!canFitItem(index, Src->uItemID)) return 0;
@@ -2425,14 +2449,9 @@ int Character::GetItemsBonus(CharacterAttributeType attr, bool getOnlyMainHandDm
     int v26;                    // edi@80
     int v56;                    // eax@365
     CharacterSkillType v58;             // [sp-4h] [bp-20h]@10
-    int v61;                    // [sp+10h] [bp-Ch]@1
-    int v62;                    // [sp+14h] [bp-8h]@1
-    const ItemGen *currEquippedItem;  // [sp+20h] [bp+4h]@101
     bool no_skills;
 
     v5 = 0;
-    v62 = 0;
-    v61 = 0;
 
     no_skills = false;
     switch (attr) {
@@ -2650,36 +2669,56 @@ int Character::GetItemsBonus(CharacterAttributeType attr, bool getOnlyMainHandDm
         case CHARACTER_ATTRIBUTE_SKILL_MEDITATION:
         case CHARACTER_ATTRIBUTE_SKILL_BOW:
         case CHARACTER_ATTRIBUTE_SKILL_SHIELD:
-        case CHARACTER_ATTRIBUTE_SKILL_LEARNING:
-            for (ItemSlot i : allItemSlots()) {
-                if (HasItemEquipped(i)) {
-                    currEquippedItem = GetItem(i);
-                    if (attr == CHARACTER_ATTRIBUTE_AC_BONUS) {
-                        if (isPassiveEquipment(currEquippedItem->GetItemEquipType())) {
-                            v5 += currEquippedItem->GetDamageDice() +
-                                  currEquippedItem->GetDamageMod();
-                        }
-                    }
-                    if (pItemTable->IsMaterialNonCommon(currEquippedItem) &&
-                        !pItemTable->IsMaterialSpecial(currEquippedItem)) {
-                        currEquippedItem->GetItemBonusArtifact(this, attr, &v62);
-                    } else if (currEquippedItem->attributeEnchantment) {
-                        if (*currEquippedItem->attributeEnchantment == attr) {
-                            // if (currEquippedItem->IsRegularEnchanmentForAttribute(attr))
-                            v5 += currEquippedItem->m_enchantmentStrength;
-                        }
-                    } else {
-                        currEquippedItem->GetItemBonusSpecialEnchantment(this, attr, &v5, &v61);
-                    }
-                }
+        case CHARACTER_ATTRIBUTE_SKILL_LEARNING: {
+            if (!CharacterStatsCacheScope::isActive())
+                return equipmentItemsBonus(attr);
+
+            if (_itemsBonusCacheGeneration[attr] != CharacterStatsCacheScope::generation()) {
+                _itemsBonusCache[attr] = equipmentItemsBonus(attr);
+                _itemsBonusCacheGeneration[attr] = CharacterStatsCacheScope::generation();
+            } else if (engine->config->debug.VerifyCharacterStatsCache.value()) {
+                int bonus = equipmentItemsBonus(attr);
+                if (bonus != _itemsBonusCache[attr])
+                    logger->warning("Stale character stats cache for attribute {}: cached {}, actual {}",
+                                    std::to_underlying(attr), _itemsBonusCache[attr], bonus);
             }
-            return v5 + v62 + v61;
-            break;
+            return _itemsBonusCache[attr];
+        }
         default:
             return 0;
     }
 }
 
+int Character::equipmentItemsBonus(CharacterAttributeType attr) const {
+    int result = 0;
+    int artifactBonus = 0;
+    int specialBonus = 0;
+
+    for (ItemSlot i : allItemSlots()) {
+        if (HasItemEquipped(i)) {
+            const ItemGen *currEquippedItem = GetItem(i);
+            if (attr == CHARACTER_ATTRIBUTE_AC_BONUS) {
+                if (isPassiveEquipment(currEquippedItem->GetItemEquipType())) {
+                    result += currEquippedItem->GetDamageDice() +
+                              currEquippedItem->GetDamageMod();
+                }
+            }
+            if (pItemTable->IsMaterialNonCommon(currEquippedItem) &&
+                !pItemTable->IsMaterialSpecial(currEquippedItem)) {
+                currEquippedItem->GetItemBonusArtifact(this, attr, &artifactBonus);
+            } else if (currEquippedItem->attributeEnchantment) {
+                if (*currEquippedItem->attributeEnchantment == attr) {
+                    // if (currEquippedItem->IsRegularEnchanmentForAttribute(attr))
+                    result += currEquippedItem->m_enchantmentStrength;
+                }
+            } else {
+                currEquippedItem->GetItemBonusSpecialEnchantment(this, attr, &result, &specialBonus);
+            }
+        }
+    }
+    return result + artifactBonus + specialBonus;
+}
+
 //----- (0048F73C) --------------------------------------------------------
 int Character::GetMagicalBonus(CharacterAttributeType a2) const {
     int v3 = 0;  // eax@4
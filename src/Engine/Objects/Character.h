@@ -229,6 +229,13 @@ class Character {
      */
     bool canFitItem(unsigned int uSlot, ItemId uItemID) const;
 
+    /**
+     * @param uItemID                   Item to find space for.
+     * @return                          First inventory cell where the provided item fits, or -1 if there's no space.
+     *                                  Cells are checked column by column, top to bottom, same as in vanilla.
+     */
+    int findFreeInventorySlot(ItemId uItemID) const;
+
     /**
      * @offset 0x4925E6
      */
@@ -459,6 +466,16 @@ class Character {
     char uNumDivineInterventionCastsThisDay;
     char uNumArmageddonCasts;
     char uNumFireSpikeCasts;
+
+ private:
+    int equipmentItemsBonus(CharacterAttributeType attr) const;
+
+    template<class T>
+    using AttributeArray = IndexedArray<T, CHARACTER_ATTRIBUTE_MIGHT, CHARACTER_ATTRIBUTE_SKILL_LEARNING>;
+
+    // Equipment part of GetItemsBonus, only used inside a CharacterStatsCacheScope.
+    mutable AttributeArray<int> _itemsBonusCache = {{}};
+    mutable AttributeArray<int64_t> _itemsBonusCacheGeneration = {{}}; // Zero => not cached.
 };
 
 void DamageCharacterFromMonster(Pid uObjID, ActorAbility dmgSource, Vec3i *pPos, signed int a4);
@@ -0,0 +1,13 @@
+#include "CharacterStatsCache.h"
+
+#include <cassert>
+
+CharacterStatsCacheScope::CharacterStatsCacheScope() {
+    if (_depth++ == 0)
+        _generation++;
+}
+
+CharacterStatsCacheScope::~CharacterStatsCacheScope() {
+    assert(_depth > 0);
+    _depth--;
+}
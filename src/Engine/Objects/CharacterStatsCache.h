@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * RAII scope inside which derived character stats are cached.
+ *
+ * `Character::GetItemsBonus` has to go through all the equipped items and their enchantments, and UI code that draws
+ * character stats calls it dozens of times per character per frame. Inside this scope the equipment part of the
+ * bonus is computed once per character & attribute. The cache is dropped when the outermost scope is entered, so the
+ * scope should only wrap code that doesn't change character equipment, skills or conditions, e.g. UI drawing.
+ *
+ * Setting `debug.verify_character_stats_cache` makes cache hits recompute the value and check it against the cached
+ * one.
+ */
+class CharacterStatsCacheScope {
+ public:
+    CharacterStatsCacheScope();
+    ~CharacterStatsCacheScope();
+
+    CharacterStatsCacheScope(const CharacterStatsCacheScope &) = delete;
+    CharacterStatsCacheScope &operator=(const CharacterStatsCacheScope &) = delete;
+
+    /**
+     * @return                          Whether there is a cache scope active at the moment.
+     */
+    [[nodiscard]] static bool isActive() {
+        return _depth > 0;
+    }
+
+    /**
+     * @return                          Generation of the current outermost scope, cached values from other
+     *                                  generations are stale. Zero is never used as a generation.
+     */
+    [[nodiscard]] static int64_t generation() {
+        return _generation;
+    }
+
+ private:
+    static inline int _depth = 0;
+    static inline int64_t _generation = 0;
+};
@@ -15,6 +15,7 @@
 
 #include "GUI/GUIButton.h"
 
+#include "Utility/IndexedArray.h"
 #include "Utility/MapAccess.h"
 
 ItemGen *ptr_50C9A4_ItemToEnchant;
@@ -22,8 +23,11 @@ ItemGen *ptr_50C9A4_ItemToEnchant;
 struct ItemTable *pItemTable;  // 005D29E0
 
 static std::map<int, std::map<CharacterAttributeType, CEnchantment>> regularBonusMap;
-static std::map<ItemEnchantment, std::map<CharacterAttributeType, CEnchantment>> specialBonusMap;
-static std::map<ItemId, std::map<CharacterAttributeType, CEnchantment>> artifactBonusMap;
+// Dense per-attribute bonus tables, default-constructed entries contribute nothing. Bonus queries run for every
+// equipped item on every stat query, so these are plain arrays instead of nested maps.
+using ItemBonusTable = IndexedArray<CEnchantment, CHARACTER_ATTRIBUTE_FIRST, CHARACTER_ATTRIBUTE_LAST>;
+static IndexedArray<ItemBonusTable, ITEM_ENCHANTMENT_FIRST_VALID, ITEM_ENCHANTMENT_LAST_VALID> specialBonusMap;
+static IndexedArray<ItemBonusTable, ITEM_FIRST_ARTIFACT, ITEM_LAST_ARTIFACT> artifactBonusMap;
 
 static std::unordered_map<ItemId, ItemId> itemTextureIdByItemId = {
     { ITEM_RELIC_HARECKS_LEATHER,       ITEM_POTION_STONESKIN },
@@ -304,6 +308,16 @@ static void AddToMap(std::map<Key, std::map<CharacterAttributeType, CEnchantment
     submap[subkey] = CEnchantment(bonusValue, skill);
 }
 
+template<class Table, class ActualKey>
+static void AddToMap(Table &table, ActualKey key, CharacterAttributeType subkey, int bonusValue = 0,
+                     CharacterSkillType skill = CHARACTER_SKILL_INVALID) {
+    CEnchantment &entry = table[key][subkey];
+
+    assert(entry.skillType == CHARACTER_SKILL_INVALID && entry.statBonus == 0);
+
+    entry = CEnchantment(bonusValue, skill);
+}
+
 void ItemGen::PopulateSpecialBonusMap() {
     // of Protection, +10 to all Resistances (description in txt says all 4, need to verify!)
     AddToMap(specialBonusMap, ITEM_ENCHANTMENT_OF_PROTECTION, CHARACTER_ATTRIBUTE_RESIST_AIR, 10);
@@ -667,15 +681,10 @@ void ItemGen::GetItemBonusSpecialEnchantment(const Character *owner,
                                              CharacterAttributeType attrToGet,
                                              int *additiveBonus,
                                              int *halfSkillBonus) const {
-    auto pos = specialBonusMap.find(this->special_enchantment);
-    if (pos == specialBonusMap.end())
+    if (special_enchantment < ITEM_ENCHANTMENT_FIRST_VALID || special_enchantment > ITEM_ENCHANTMENT_LAST_VALID)
         return;
 
-    auto subpos = pos->second.find(attrToGet);
-    if (subpos == pos->second.end())
-        return;
-
-    const CEnchantment &currBonus = subpos->second;
+    const CEnchantment &currBonus = specialBonusMap[special_enchantment][attrToGet];
     if (currBonus.skillType != CHARACTER_SKILL_INVALID) {
         if (currBonus.statBonus == 0) {
             *halfSkillBonus = owner->pActiveSkills[currBonus.skillType].level() / 2;
@@ -692,15 +701,10 @@ void ItemGen::GetItemBonusSpecialEnchantment(const Character *owner,
 void ItemGen::GetItemBonusArtifact(const Character *owner,
                                    CharacterAttributeType attrToGet,
                                    int *bonusSum) const {
-    auto pos = artifactBonusMap.find(this->uItemID);
-    if (pos == artifactBonusMap.end())
-        return;
-
-    auto subpos = pos->second.find(attrToGet);
-    if (subpos == pos->second.end())
+    if (!isArtifact(uItemID))
         return;
 
-    const CEnchantment &currBonus = subpos->second;
+    const CEnchantment &currBonus = artifactBonusMap[uItemID][attrToGet];
     if (currBonus.skillType != CHARACTER_SKILL_INVALID) {
         *bonusSum = owner->pActiveSkills[currBonus.skillType].level() / 2;
     } else {
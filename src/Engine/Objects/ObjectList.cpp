@@ -5,10 +5,19 @@
 struct ObjectList *pObjectList;
 
 unsigned int ObjectList::ObjectIDByItemID(SpriteId uItemID) {
+    if (_indexedSize != pObjects.size())
+        buildIdIndex();
+
+    auto pos = _indexById.find(uItemID);
+    return pos == _indexById.end() ? 0 : pos->second;
+}
+
+void ObjectList::buildIdIndex() {
+    _indexById.clear();
+    _indexById.reserve(pObjects.size());
     for (size_t i = 0; i < pObjects.size(); i++)
-        if (uItemID == pObjects[i].uObjectID)
-            return i;
-    return 0;
+        _indexById.try_emplace(pObjects[i].uObjectID, i);
+    _indexedSize = pObjects.size();
 }
 
 void ObjectList::InitializeSprites() {
@@ -4,6 +4,7 @@
 #include <array>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #include "Engine/Time/Duration.h"
 
@@ -50,8 +51,18 @@ class ObjectList {
     void InitializeSprites();
     unsigned int ObjectIDByItemID(SpriteId uItemID);
 
+    /**
+     * Rebuilds the index used by `ObjectIDByItemID`. Called after the list is loaded, and also lazily if the size of
+     * `pObjects` has changed since.
+     */
+    void buildIdIndex();
+
  public:
     std::vector<ObjectDesc> pObjects;
+
+ private:
+    size_t _indexedSize = 0;
+    std::unordered_map<SpriteId, unsigned int> _indexById;
 };
 
 extern ObjectList *pObjectList;
@@ -1,8 +1,11 @@
 #include "Engine/Objects/SpriteObject.h"
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "Engine/Engine.h"
 #include "Engine/SpellFxRenderer.h"
@@ -17,6 +20,8 @@
 #include "Engine/Random/Random.h"
 
 #include "Engine/Objects/Actor.h"
+#include "Engine/Objects/ActorSpatialHash.h"
+#include "Engine/Objects/SpriteObjectSpatialHash.h"
 #include "Engine/Objects/ObjectList.h"
 #include "Engine/Objects/MonsterEnumFunctions.h"
 #include "Engine/Objects/SpriteEnumFunctions.h"
@@ -42,6 +47,14 @@ static std::shared_ptr<ParticleEngine> particle_engine = EngineIocContainer::Res
 
 std::vector<SpriteObject> pSpriteObjects;
 
+// All slots in `pSpriteObjects` below this index are known to be taken. Kept up to date at the places where sprite
+// objects are freed, so that `SpriteObject::Create` doesn't have to rescan the vector from the start each time.
+static size_t firstFreeSlotHint = 0;
+
+static void markSpriteObjectFree(size_t id) {
+    firstFreeSlotHint = std::min(firstFreeSlotHint, id);
+}
+
 int SpriteObject::Create(int yaw, int pitch, int speed, int which_char) {
     // check for valid sprite object
     if (!uObjectDescID) {
@@ -50,13 +63,12 @@ int SpriteObject::Create(int yaw, int pitch, int speed, int which_char) {
 
     // TODO(pskelton): refactor this so check isnt needed
     // To prevent memory corruption this function should never be called for any item in pSpriteObjects
-    for (SpriteObject &ref : pSpriteObjects) {
-        assert(&ref != this);
-    }
+    assert(std::less<>()(this, pSpriteObjects.data()) ||
+           !std::less<>()(this, pSpriteObjects.data() + pSpriteObjects.size()));
 
-    // find free sprite slot
+    // find free sprite slot, this is the lowest free index as all slots below the hint are taken
     int sprite_slot = -1;
-    for (unsigned int i = 0; i < pSpriteObjects.size(); ++i) {
+    for (size_t i = firstFreeSlotHint; i < pSpriteObjects.size(); ++i) {
         if (!pSpriteObjects[i].uObjectDescID) {
             sprite_slot = i;
             break;
@@ -109,9 +121,23 @@ int SpriteObject::Create(int yaw, int pitch, int speed, int which_char) {
         pSpriteObjects.resize(sprite_slot + 1);
     }
     pSpriteObjects[sprite_slot] = *this;
+    spriteObjectSpatialHash.update(sprite_slot);
+    if (sprite_slot == static_cast<int>(firstFreeSlotHint))
+        firstFreeSlotHint = sprite_slot + 1;
     return sprite_slot;
 }
 
+/**
+ * @return                              Max `toHitRadius` over all monsters, used as the collision radius for actors
+ *                                      by `SpriteObject::updateObjectBLV`.
+ */
+static int maxMonsterToHitRadius() {
+    int result = 0;
+    for (const MonsterDesc &desc : pMonsterList->monsters)
+        result = std::max<int>(result, desc.toHitRadius);
+    return result;
+}
+
 static void createSpriteTrailParticle(Vec3i pos, ObjectDescFlags flags) {
     Particle_sw particle;
     memset(&particle, 0, sizeof(Particle_sw));
@@ -244,14 +270,14 @@ void SpriteObject::updateObjectODM(unsigned int uLayingItemID) {
             int actorId = pSpriteObjects[uLayingItemID].spell_caster_pid.id();
             // TODO: why pActors.size() - 1? Should just check for .size()
             if ((actorId >= 0) && (actorId < (pActors.size() - 1))) {
-                for (int j = 0; j < pActors.size(); ++j) {
+                for (int j : actorsNearCollisionBox()) {
                     if (pActors[actorId].GetActorsRelation(&pActors[j]) != HOSTILITY_FRIENDLY) {
                         CollideWithActor(j, 0);
                     }
                 }
             }
         } else {
-            for (int j = 0; j < pActors.size(); ++j) {
+            for (int j : actorsNearCollisionBox()) {
                 CollideWithActor(j, 0);
             }
         }
@@ -393,7 +419,10 @@ LABEL_25:
                     CollideWithParty(true);
                 }
 
-                for (int actloop = 0; actloop < (signed int)pActors.size(); ++actloop) {
+                // Actor radius is overridden with toHitRadius below.
+                static const int maxToHitRadius = maxMonsterToHitRadius(); // Monster list doesn't change after load.
+                int maxRadius = std::max(actorSpatialHash.maxActorRadius(), maxToHitRadius);
+                for (int actloop : actorsNearCollisionBox(maxRadius)) {
                     // dont collide against self monster type
                     if (pSpriteObject->spell_caster_pid.type() == OBJECT_Actor) {
                         if (pActors[pSpriteObject->spell_caster_pid.id()].monsterInfo.id == pActors[actloop].monsterInfo.id) {
@@ -604,6 +633,7 @@ Color SpriteObject::GetParticleTrailColor() {
 
 void SpriteObject::OnInteraction(unsigned int uLayingItemID) {
     pSpriteObjects[uLayingItemID].uObjectDescID = 0;
+    markSpriteObjectFree(uLayingItemID);
     if (pParty->bTurnBasedModeOn) {
         if (pSpriteObjects[uLayingItemID].uAttributes & SPRITE_HALT_TURN_BASED) {
             pSpriteObjects[uLayingItemID].uAttributes &= ~SPRITE_HALT_TURN_BASED;
@@ -626,6 +656,16 @@ void CompactLayingItemsList() {
     }
 
     pSpriteObjects.resize(new_obj_pos);
+    firstFreeSlotHint = new_obj_pos;
+}
+
+void InvalidateSpriteObjectFreeSlots() {
+    firstFreeSlotHint = 0;
+}
+
+void ReserveSpriteObjects(size_t count) {
+    // Free slots below the end are reused by Create, so this overestimates a bit, which is fine.
+    pSpriteObjects.reserve(pSpriteObjects.size() + count);
 }
 
 void SpriteObject::InitializeSpriteObjects() {
@@ -719,6 +759,8 @@ void SpriteObject::createSplashObject(Vec3i pos) {
 static void updateSpriteOnImpact(SpriteObject *object) {
     object->uType = impactSprite(object->uType);
     object->uObjectDescID = pObjectList->ObjectIDByItemID(object->uType);
+    if (!object->uObjectDescID)
+        markSpriteObjectFree(object - pSpriteObjects.data());
 }
 
 bool processSpellImpact(unsigned int uLayingItemID, Pid pid) {
@@ -1295,6 +1337,10 @@ void applySpellSpriteDamage(unsigned int uLayingItemID, Pid pid) {
 }
 
 void UpdateObjects() {
+    // Actors don't move while we're updating sprite objects, so syncing once is enough for the actor collision checks.
+    if (!pSpriteObjects.empty())
+        actorSpatialHash.sync();
+
     for (unsigned i = 0; i < pSpriteObjects.size(); ++i) {
         if (pSpriteObjects[i].uAttributes & SPRITE_SKIP_A_FRAME) {
             pSpriteObjects[i].uAttributes &= ~SPRITE_SKIP_A_FRAME;
@@ -93,6 +93,20 @@ struct SpriteObject {
 
 void CompactLayingItemsList();
 
+/**
+ * Should be called after `pSpriteObjects` was replaced wholesale, e.g. when loading a location, so that the next
+ * `SpriteObject::Create` call looks for a free slot starting from the beginning of the vector.
+ */
+void InvalidateSpriteObjectFreeSlots();
+
+/**
+ * Makes sure that the next `count` calls to `SpriteObject::Create` won't reallocate `pSpriteObjects`. Should be
+ * called before launching a batch of projectiles.
+ *
+ * @param count                         Number of sprite objects that are about to be created.
+ */
+void ReserveSpriteObjects(size_t count);
+
 extern std::vector<SpriteObject> pSpriteObjects;
 
 /**
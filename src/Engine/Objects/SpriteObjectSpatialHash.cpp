@@ -0,0 +1,81 @@
+#include "SpriteObjectSpatialHash.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "ObjectList.h"
+#include "SpriteObject.h"
+
+SpriteObjectSpatialHash spriteObjectSpatialHash;
+
+void SpriteObjectSpatialHash::sync() {
+    for (int i = pSpriteObjects.size(); i < _objectCells.size(); i++)
+        remove(i);
+    _objectCells.resize(pSpriteObjects.size(), NO_CELL);
+
+    // Object descriptions of a slot can change without the hash knowing, so we use the max over the whole list.
+    _maxObjectRadius = 0;
+    for (const ObjectDesc &desc : pObjectList->pObjects)
+        _maxObjectRadius = std::max<int>(_maxObjectRadius, desc.uRadius);
+
+    for (int i = 0; i < pSpriteObjects.size(); i++)
+        update(i);
+}
+
+void SpriteObjectSpatialHash::update(int objectId) {
+    assert(objectId >= 0 && objectId < pSpriteObjects.size());
+
+    if (objectId >= _objectCells.size())
+        _objectCells.resize(objectId + 1, NO_CELL);
+
+    const SpriteObject &object = pSpriteObjects[objectId];
+    int64_t key = cellKey(object.vPosition.x >> CELL_SHIFT, object.vPosition.y >> CELL_SHIFT);
+    if (_objectCells[objectId] == key)
+        return;
+
+    remove(objectId);
+    insert(objectId, key);
+}
+
+std::vector<int> SpriteObjectSpatialHash::query(const Vec3i &center, int radius) const {
+    assert(radius >= 0);
+
+    std::vector<int> result;
+    int minX = (center.x - radius) >> CELL_SHIFT;
+    int maxX = (center.x + radius) >> CELL_SHIFT;
+    int minY = (center.y - radius) >> CELL_SHIFT;
+    int maxY = (center.y + radius) >> CELL_SHIFT;
+    for (int x = minX; x <= maxX; x++) {
+        for (int y = minY; y <= maxY; y++) {
+            auto pos = _cells.find(cellKey(x, y));
+            if (pos != _cells.end())
+                result.insert(result.end(), pos->second.begin(), pos->second.end());
+        }
+    }
+
+    std::ranges::sort(result);
+    return result;
+}
+
+void SpriteObjectSpatialHash::insert(int objectId, int64_t key) {
+    _cells[key].push_back(objectId);
+    _objectCells[objectId] = key;
+}
+
+void SpriteObjectSpatialHash::remove(int objectId) {
+    int64_t key = _objectCells[objectId];
+    if (key == NO_CELL)
+        return;
+
+    auto pos = _cells.find(key);
+    assert(pos != _cells.end());
+    std::vector<int> &cell = pos->second;
+    auto objectPos = std::ranges::find(cell, objectId);
+    assert(objectPos != cell.end());
+    *objectPos = cell.back();
+    cell.pop_back();
+    if (cell.empty())
+        _cells.erase(pos);
+
+    _objectCells[objectId] = NO_CELL;
+}
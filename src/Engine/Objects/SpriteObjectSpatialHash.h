@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Library/Geometry/Vec.h"
+
+/**
+ * Uniform spatial hash over the positions of `pSpriteObjects`, in the XY plane. Works the same way as
+ * `ActorSpatialHash`.
+ *
+ * Sprite objects only move while they are being updated in `UpdateObjects`, so the hash is synced before the actor &
+ * party movement code that queries it, and `update` is called when new objects are created.
+ *
+ * Empty slots are bucketed too, callers are expected to skip them.
+ */
+class SpriteObjectSpatialHash {
+ public:
+    static constexpr int CELL_SHIFT = 10;
+
+    SpriteObjectSpatialHash() = default;
+
+    /**
+     * Brings the hash up to date with `pSpriteObjects`.
+     */
+    void sync();
+
+    /**
+     * Re-buckets a single sprite object.
+     *
+     * @param objectId                  Id of the sprite object in `pSpriteObjects`, might be the id of a new object.
+     */
+    void update(int objectId);
+
+    /**
+     * @param center                    Query center.
+     * @param radius                    Query radius. Objects are returned if they are in a cell that overlaps the
+     *                                  `[center - radius, center + radius]` XY box.
+     * @return                          Ids of the candidate sprite objects, in ascending order.
+     */
+    [[nodiscard]] std::vector<int> query(const Vec3i &center, int radius) const;
+
+    /**
+     * @return                          Max radius over all the object descriptions in `pObjectList`.
+     */
+    [[nodiscard]] int maxObjectRadius() const {
+        return _maxObjectRadius;
+    }
+
+ private:
+    static constexpr int64_t NO_CELL = INT64_MIN;
+
+    static int64_t cellKey(int cellX, int cellY) {
+        return (static_cast<int64_t>(cellX) << 32) | static_cast<uint32_t>(cellY);
+    }
+
+    void insert(int objectId, int64_t key);
+    void remove(int objectId);
+
+ private:
+    std::vector<int64_t> _objectCells; // Cell key for each object, `NO_CELL` if not in the hash.
+    std::unordered_map<int64_t, std::vector<int>> _cells;
+    int _maxObjectRadius = 0;
+};
+
+extern SpriteObjectSpatialHash spriteObjectSpatialHash;
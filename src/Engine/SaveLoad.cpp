@@ -3,8 +3,16 @@
 #include <cassert>
 #include <filesystem>
 #include <algorithm>
-#include <string>
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "Engine/Engine.h"
 #include "Engine/LOD.h"
@@ -35,8 +43,13 @@
 #include "Library/Compression/Compression.h"
 #include "Library/Logger/Logger.h"
 #include "Library/LodFormats/LodFormats.h"
+#include "Library/Lod/LodChunkStore.h"
+#include "Library/Lod/LodReader.h"
 #include "Library/Lod/LodWriter.h"
 
+#include "Utility/Streams/BlobOutputStream.h"
+#include "Utility/Streams/TempFileOutputStream.h"
+#include "Utility/Thread/ThreadPool.h"
 #include "Utility/DataPath.h"
 
 struct SavegameList *pSavegameList = new SavegameList;
@@ -49,29 +62,310 @@ static LodInfo makeSaveLodInfo() {
     return result;
 }
 
-void LoadGame(unsigned int uSlot) {
-    if (!pSavegameList->pSavegameUsedSlots[uSlot]) {
-        pAudioPlayer->playUISound(SOUND_error);
-        logger->warning("LoadGame: slot {} is empty", uSlot);
+/**
+ * Everything that's needed to write out a savegame. Captured on the game thread, written out on a worker thread.
+ */
+struct SaveGameData {
+    std::shared_future<RgbaImage> screenshot; // Read back from the GPU asynchronously, see `finishPendingSaveInternal`.
+    SaveGame_MM7 saveGame;
+    std::vector<std::pair<std::string, RgbaImage>> beacons;
+    std::string deltaName; // Name of the map delta file, empty if we're not saving the world.
+    std::optional<IndoorDelta_MM7> indoorDelta;
+    std::optional<OutdoorDelta_MM7> outdoorDelta;
+    CompressionLevel deltaCompression = COMPRESSION_DEFAULT;
+    std::vector<std::string> copyPaths; // Where to copy new.lod once it's written.
+    bool chunked = false; // Whether to write chunked saves to `copyPaths`, see the chunked_saves config option.
+    Blob baseLod; // If non-empty, entries are copied from this blob and not from the existing new.lod.
+    std::string cacheName; // If non-empty, new.lod is read back once written, and stored in `quickSaveCache`.
+};
+
+/**
+ * In-memory copy of the last quicksave, so that quickload doesn't have to go through the filesystem.
+ */
+struct QuickSaveCache {
+    std::string name; // Quicksave file name, e.g. "quicksave1.mm7". Empty if there's nothing cached.
+    Blob save;
+    uintmax_t size = 0; // Size of the quicksave file on disk. If it changes, the file was replaced & the cache is stale.
+    std::filesystem::file_time_type modificationTime; // Same for the modification time.
+};
+
+static std::future<Blob> pendingSave; // Returns a copy of new.lod if `pendingSaveCacheName` is non-empty.
+static std::string pendingSaveCacheName;
+static std::function<void(bool)> pendingSaveCallback;
+static QuickSaveCache quickSaveCache;
+
+// Contents of `pSave_LOD` if it was restored with `LoadGameFromMemory`. Empty if `pSave_LOD` is backed by new.lod on
+// disk. New.lod is only brought up to date on the next save.
+static Blob memorySaveLod;
+
+/**
+ * Save file info from a previous `readSaveFileInfos` call, valid as long as the file size & modification time match.
+ */
+struct CachedSaveFileInfo {
+    uintmax_t size = 0;
+    std::filesystem::file_time_type modificationTime;
+    SaveFileInfo info;
+};
+
+static std::unordered_map<std::string, CachedSaveFileInfo> saveFileInfoCache; // Keyed by save file path.
+
+/**
+ * @param path                          Path to a file.
+ * @param[out] size                     File size.
+ * @param[out] modificationTime         File modification time.
+ * @return                              Whether the file exists & could be queried.
+ */
+static bool statSaveFile(const std::string &path, uintmax_t *size, std::filesystem::file_time_type *modificationTime) {
+    std::error_code ec;
+    *size = std::filesystem::file_size(path, ec);
+    if (ec)
+        return false;
+    *modificationTime = std::filesystem::last_write_time(path, ec);
+    return !ec;
+}
+
+// Chunked saves keep their entries in a chunk store in this subfolder of the folder they're in.
+static constexpr std::string_view SAVE_CHUNKS_FOLDER = "chunks";
+
+static LodChunkStore saveChunkStore(const std::string &savePath) {
+    return LodChunkStore((std::filesystem::path(savePath).parent_path() / SAVE_CHUNKS_FOLDER).string());
+}
+
+/**
+ * @param path                          Path to a save file.
+ * @param names                         Entries to read if it's a chunked save, empty span means all.
+ * @return                              Save file contents as a regular LOD.
+ */
+static Blob readSaveFile(const std::string &path, std::span<const std::string> names = {}) {
+    Blob data = Blob::fromFile(path);
+    if (!LodChunkStore::isManifest(data))
+        return data;
+    return saveChunkStore(path).assemble(data, names);
+}
+
+static void writeChunkedSave(const std::string &lodPath, const std::string &path) {
+    LodChunkStore store = saveChunkStore(path);
+    Blob manifest = store.write(LodReader(lodPath, LOD_ALLOW_DUPLICATES));
+
+    TempFileOutputStream output(path);
+    output.write(manifest.string_view());
+    output.close();
+
+    // Drop the chunks that are not used by any of the saves in the folder anymore. Manifests are small, and vanilla
+    // saves are memory-mapped, so this doesn't take long.
+    std::vector<Blob> manifests;
+    for (const auto &entry : std::filesystem::directory_iterator(std::filesystem::path(path).parent_path())) {
+        if (entry.path().extension() != ".mm7")
+            continue;
+        Blob data = Blob::fromFile(entry.path().string());
+        if (LodChunkStore::isManifest(data))
+            manifests.push_back(std::move(data));
+    }
+    store.collectGarbage(manifests);
+}
+
+static void writeSaveGameEntries(const SaveGameData &data, LodWriter *lodWriter) {
+    // Screenshot & beacon images are small, so we encode them in parallel with each other. Note that this might be
+    // running on a pool thread already, this is OK since parallelFor doesn't block on the other queued tasks.
+    std::vector<Blob> images(data.beacons.size() + 1);
+    engine->_threadPool->parallelFor(images.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            images[i] = pcx::encode(i == 0 ? data.screenshot.get() : data.beacons[i - 1].second);
+    });
+
+    lodWriter->write("image.pcx", std::move(images[0]));
+    serialize(data.saveGame, lodWriter);
+    for (size_t i = 0; i < data.beacons.size(); i++)
+        lodWriter->write(data.beacons[i].first, std::move(images[i + 1]));
+
+    if (!data.deltaName.empty()) {
+        Blob uncompressed;
+        if (data.indoorDelta) {
+            serialize(*data.indoorDelta, &uncompressed);
+        } else {
+            serialize(*data.outdoorDelta, &uncompressed);
+        }
+        lodWriter->write(data.deltaName, lod::encodeCompressed(uncompressed, data.deltaCompression));
+    }
+
+    // Apparently vanilla had two bugs canceling each other out:
+    // 1. Broken binary search implementation when looking up LOD entries.
+    // 2. Writing additional duplicate entry at the end of a saves LOD file.
+    // Our code doesn't support duplicate entries, so we just add a dummy entry
+    lodWriter->write("z.bin", Blob::fromString("dummy"));
+}
+
+static void copySaveLodEntries(const LodReader &reader, LodWriter *lodWriter) {
+    for (const std::string &name : reader.ls())
+        lodWriter->write(name, reader.read(name));
+}
+
+static Blob writeSaveGame(const SaveGameData &data) {
+    std::string lodPath = makeDataPath("data", "new.lod");
+
+    LodWriter lodWriter(lodPath, makeSaveLodInfo());
+    if (data.baseLod) {
+        // new.lod on disk is stale, so the entries are taken from the in-memory save instead.
+        copySaveLodEntries(LodReader(Blob::share(data.baseLod), lodPath, LOD_ALLOW_DUPLICATES), &lodWriter);
+    } else {
+        copySaveLodEntries(LodReader(lodPath, LOD_ALLOW_DUPLICATES), &lodWriter);
+    }
+
+    writeSaveGameEntries(data, &lodWriter);
+    lodWriter.close();
+
+    for (const std::string &path : data.copyPaths) {
+        if (data.chunked) {
+            writeChunkedSave(lodPath, path); // This might throw.
+        } else {
+            std::filesystem::copy_file(lodPath, path, std::filesystem::copy_options::overwrite_existing); // This might throw.
+        }
+    }
+
+    // Copying the data and not keeping the mapping around, as the cached file might be overwritten later.
+    if (data.cacheName.empty())
+        return Blob();
+    Blob mapped = Blob::fromFile(lodPath);
+    return Blob::copy(mapped.data(), mapped.size());
+}
+
+static void finishPendingSaveInternal(bool wait) {
+    if (!pendingSave.valid())
+        return;
+    if (!wait && pendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
         return;
+
+    // Screenshot is completed on the game thread, and the worker thread might be waiting for it.
+    if (wait)
+        render->FinishScreenshots();
+
+    bool success = true;
+    Blob cachedSave;
+    try {
+        cachedSave = pendingSave.get();
+    } catch (const std::exception &e) {
+        logger->error("Failed to write savegame: {}", e.what());
+        success = false;
+    }
+    pendingSave = {};
+
+    std::string cacheName = std::exchange(pendingSaveCacheName, {});
+    if (!cacheName.empty()) {
+        quickSaveCache = {}; // Save file might be half-written if we've failed.
+        if (success && statSaveFile(makeDataPath("saves", cacheName), &quickSaveCache.size, &quickSaveCache.modificationTime)) {
+            quickSaveCache.name = std::move(cacheName);
+            quickSaveCache.save = std::move(cachedSave);
+        }
     }
-    pSavegameList->selectedSlot = uSlot;
-    pSavegameList->lastLoadedSave = pSavegameList->pFileList[uSlot];
 
-    // TODO(captainurist): remained from Party::Reset, doesn't really belong here (or in Party::Reset).
-    current_character_screen_window = WINDOW_CharacterWindow_Stats;
+    pSave_LOD->open(makeDataPath("data", "new.lod"), LOD_ALLOW_DUPLICATES);
 
-    std::string filename = makeDataPath("saves", pSavegameList->pFileList[uSlot]);
-    std::string to_file_path = makeDataPath("data", "new.lod");
+    // Callback might start another save, so we need to reset the global first.
+    std::function<void(bool)> callback = std::move(pendingSaveCallback);
+    pendingSaveCallback = {};
+    if (callback)
+        callback(success);
+}
 
-    pSave_LOD->close();
+void finishPendingSave() {
+    finishPendingSaveInternal(true);
+}
 
-    std::error_code ec;
-    if (!std::filesystem::copy_file(filename, to_file_path, std::filesystem::copy_options::overwrite_existing, ec))
-        logger->error("Failed to copy: {}", filename);
+void pollPendingSave() {
+    finishPendingSaveInternal(false);
+}
 
-    pSave_LOD->open(to_file_path, LOD_ALLOW_DUPLICATES);
+/**
+ * Captures everything that's needed to write out a savegame. Must be called on the game thread.
+ *
+ * @param NotSaveWorld                  Whether the state of the current map should not be saved.
+ * @param title                         Save title.
+ * @param[out] data                     Save data to fill.
+ * @return                              Header of the savegame.
+ */
+static SaveGameHeader captureSaveGame(bool NotSaveWorld, const std::string &title, SaveGameData *data) {
+    int pPositionX = pParty->pos.x;
+    int pPositionY = pParty->pos.y;
+    int pPositionZ = pParty->pos.z;
+    int partyViewYaw = pParty->_viewYaw;
+    int partyViewPitch = pParty->_viewPitch;
+    pParty->pos.x = pParty->lastPos.x;
+    pParty->pos.z = pParty->lastPos.z;
+    pParty->pos.y = pParty->lastPos.y;
+
+    pParty->uFallStartZ = pParty->lastPos.z;
+
+    pParty->_viewYaw = pParty->_viewPrevYaw;
+    pParty->_viewPitch = pParty->_viewPrevPitch;
+
+    // saving - please wait
+
+    // if (current_screen_type == SCREEN_SAVEGAME) {
+    //    render->DrawTextureNew(8 / 640.0f, 8 / 480.0f, saveload_ui_loadsave);
+    //    render->DrawTextureNew(18 / 640.0f, 141 / 480.0f, saveload_ui_loadsave);
+    //    int text_pos = pFontSmallnum->AlignText_Center(186, localization->GetString(190));
+    //    pGUIWindow_CurrentMenu->DrawText(pFontSmallnum, text_pos + 25, 219, 0, localization->GetString(190), 0, 0, 0);  // Сохранение
+    //    text_pos = pFontSmallnum->AlignText_Center(186, pSavegameList->pSavegameHeader[pSavegameList->selectedSlot].pName);
+    //    pGUIWindow_CurrentMenu->DrawTextInRect(pFontSmallnum, text_pos + 25, 259, 0, pSavegameList->pSavegameHeader[pSavegameList->selectedSlot].pName, 185, 0);
+    //    text_pos = pFontSmallnum->AlignText_Center(186, localization->GetString(LSTR_PLEASE_WAIT));
+    //    pGUIWindow_CurrentMenu->DrawText(pFontSmallnum, text_pos + 25, 299, 0, localization->GetString(LSTR_PLEASE_WAIT), 0, 0, 0);  // Пожалуйста, подождите
+    //    render->Present();
+    //}
 
+    data->screenshot = render->RequestScreenshot32(150, 112).share();
+
+    SaveGameHeader save_header;
+    save_header.name = title;
+    save_header.locationName = pCurrentMapName;
+    save_header.playingTime = pParty->GetPlayingTime();
+
+    snapshot(save_header, &data->saveGame);
+
+    // TODO(captainurist): incapsulate this too
+    for (size_t i = 0; i < 4; ++i) {  // 4 - players
+        Character *player = &pParty->pCharacters[i];
+        for (size_t j = 0; j < 5; ++j) {  // 5 - images
+            if (j >= player->vBeacons.size()) {
+                continue;
+            }
+            LloydBeacon *beacon = &player->vBeacons[j];
+            GraphicsImage *image = beacon->image;
+            if ((beacon->uBeaconTime.isValid()) && (image != nullptr)) {
+                assert(image->rgba());
+                const RgbaImage &rgba = image->rgba();
+                data->beacons.emplace_back(fmt::format("lloyd{}{}.pcx", i + 1, j + 1), RgbaImage::copy(rgba.width(), rgba.height(), rgba.pixels().data()));
+            }
+        }
+    }
+
+    if (!NotSaveWorld) {  // autosave for change location
+        currentLocationTime().last_visit = pParty->GetPlayingTime();
+        CompactLayingItemsList();
+
+        if (uCurrentlyLoadedLevelType == LEVEL_INDOOR) {
+            snapshot(*pIndoor, &data->indoorDelta.emplace());
+        } else {
+            assert(uCurrentlyLoadedLevelType == LEVEL_OUTDOOR);
+            snapshot(*pOutdoor, &data->outdoorDelta.emplace());
+        }
+
+        data->deltaName = pCurrentMapName;
+        size_t pos = data->deltaName.find_last_of(".");
+        data->deltaName[pos + 1] = 'd';
+        data->deltaCompression = engine->config->settings.FastSaveCompression.value() ? COMPRESSION_FASTEST : COMPRESSION_DEFAULT;
+    }
+
+    pParty->pos.x = pPositionX;
+    pParty->pos.y = pPositionY;
+    pParty->pos.z = pPositionZ;
+    pParty->uFallStartZ = pPositionZ;
+    pParty->_viewYaw = partyViewYaw;
+    pParty->_viewPitch = partyViewPitch;
+
+    return save_header;
+}
+
+static void loadGameFromSaveLod() {
     SaveGameHeader header;
     deserialize(*pSave_LOD, &header, tags::via<SaveGame_MM7>);
 
@@ -151,132 +445,106 @@ void LoadGame(unsigned int uSlot) {
     bFlashHistoryBook = false;
 }
 
-SaveGameHeader SaveGame(bool IsAutoSAve, bool NotSaveWorld, const std::string &title) {
-    assert(IsAutoSAve || !title.empty());
-    assert(pCurrentMapName != "d05.blv" || IsAutoSAve); // No manual saves in Arena.
-
-    s_SavedMapName = pCurrentMapName;
-    if (pCurrentMapName == "d05.blv") { // arena
-        return {};
+void LoadGame(unsigned int uSlot) {
+    if (!pSavegameList->pSavegameUsedSlots[uSlot]) {
+        pAudioPlayer->playUISound(SOUND_error);
+        logger->warning("LoadGame: slot {} is empty", uSlot);
+        return;
     }
+    pSavegameList->selectedSlot = uSlot;
+    pSavegameList->lastLoadedSave = pSavegameList->pFileList[uSlot];
 
-    int pPositionX = pParty->pos.x;
-    int pPositionY = pParty->pos.y;
-    int pPositionZ = pParty->pos.z;
-    int partyViewYaw = pParty->_viewYaw;
-    int partyViewPitch = pParty->_viewPitch;
-    pParty->pos.x = pParty->lastPos.x;
-    pParty->pos.z = pParty->lastPos.z;
-    pParty->pos.y = pParty->lastPos.y;
+    finishPendingSave();
 
-    pParty->uFallStartZ = pParty->lastPos.z;
+    // TODO(captainurist): remained from Party::Reset, doesn't really belong here (or in Party::Reset).
+    current_character_screen_window = WINDOW_CharacterWindow_Stats;
 
-    pParty->_viewYaw = pParty->_viewPrevYaw;
-    pParty->_viewPitch = pParty->_viewPrevPitch;
+    std::string filename = makeDataPath("saves", pSavegameList->pFileList[uSlot]);
+    std::string to_file_path = makeDataPath("data", "new.lod");
 
-    // saving - please wait
+    pSave_LOD->close();
 
-    // if (current_screen_type == SCREEN_SAVEGAME) {
-    //    render->DrawTextureNew(8 / 640.0f, 8 / 480.0f, saveload_ui_loadsave);
-    //    render->DrawTextureNew(18 / 640.0f, 141 / 480.0f, saveload_ui_loadsave);
-    //    int text_pos = pFontSmallnum->AlignText_Center(186, localization->GetString(190));
-    //    pGUIWindow_CurrentMenu->DrawText(pFontSmallnum, text_pos + 25, 219, 0, localization->GetString(190), 0, 0, 0);  // Сохранение
-    //    text_pos = pFontSmallnum->AlignText_Center(186, pSavegameList->pSavegameHeader[pSavegameList->selectedSlot].pName);
-    //    pGUIWindow_CurrentMenu->DrawTextInRect(pFontSmallnum, text_pos + 25, 259, 0, pSavegameList->pSavegameHeader[pSavegameList->selectedSlot].pName, 185, 0);
-    //    text_pos = pFontSmallnum->AlignText_Center(186, localization->GetString(LSTR_PLEASE_WAIT));
-    //    pGUIWindow_CurrentMenu->DrawText(pFontSmallnum, text_pos + 25, 299, 0, localization->GetString(LSTR_PLEASE_WAIT), 0, 0, 0);  // Пожалуйста, подождите
-    //    render->Present();
-    //}
+    try {
+        copySaveFile(filename, to_file_path);
+    } catch (const std::exception &e) {
+        logger->error("Failed to copy: {}: {}", filename, e.what());
+    }
 
-    pSave_LOD->close();
-    LodWriter lodWriter(makeDataPath("data", "new.lod"), makeSaveLodInfo());
+    pSave_LOD->open(to_file_path, LOD_ALLOW_DUPLICATES);
+    memorySaveLod = Blob();
 
-    LodReader lodReader(makeDataPath("data", "new.lod"), LOD_ALLOW_DUPLICATES);
-    for (const std::string &name : lodReader.ls())
-        lodWriter.write(name, lodReader.read(name));
-    lodReader.close();
+    loadGameFromSaveLod();
+}
 
-    lodWriter.write("image.pcx", render->PackScreenshot(150, 112));
+void LoadGameFromMemory(const Blob &save) {
+    finishPendingSave();
 
-    SaveGameHeader save_header;
-    save_header.name = title;
-    save_header.locationName = pCurrentMapName;
-    save_header.playingTime = pParty->GetPlayingTime();
+    // TODO(captainurist): remained from Party::Reset, doesn't really belong here (or in Party::Reset).
+    current_character_screen_window = WINDOW_CharacterWindow_Stats;
 
-    serialize(save_header, &lodWriter, tags::via<SaveGame_MM7>);
+    pSave_LOD->open(Blob::share(save), makeDataPath("data", "new.lod"), LOD_ALLOW_DUPLICATES);
+    memorySaveLod = Blob::share(save);
 
-    // TODO(captainurist): incapsulate this too
-    for (size_t i = 0; i < 4; ++i) {  // 4 - players
-        Character *player = &pParty->pCharacters[i];
-        for (size_t j = 0; j < 5; ++j) {  // 5 - images
-            if (j >= player->vBeacons.size()) {
-                continue;
-            }
-            LloydBeacon *beacon = &player->vBeacons[j];
-            GraphicsImage *image = beacon->image;
-            if ((beacon->uBeaconTime.isValid()) && (image != nullptr)) {
-                assert(image->rgba());
-                std::string str = fmt::format("lloyd{}{}.pcx", i + 1, j + 1);
-                lodWriter.write(str, pcx::encode(image->rgba()));
-            }
-        }
-    }
+    loadGameFromSaveLod();
+}
 
-    Blob uncompressed;
-    if (!NotSaveWorld) {  // autosave for change location
-        currentLocationTime().last_visit = pParty->GetPlayingTime();
-        CompactLayingItemsList();
+SaveGameHeader SaveGame(bool IsAutoSAve, bool NotSaveWorld, const std::string &title, const std::string &copyPath,
+                        std::function<void(bool)> callback, const std::string &cacheName) {
+    assert(IsAutoSAve || !title.empty());
+    assert(pCurrentMapName != "d05.blv" || IsAutoSAve); // No manual saves in Arena.
 
-        if (uCurrentlyLoadedLevelType == LEVEL_INDOOR) {
-            serialize(*pIndoor, &uncompressed, tags::via<IndoorDelta_MM7>);
-        } else {
-            assert(uCurrentlyLoadedLevelType == LEVEL_OUTDOOR);
-            serialize(*pOutdoor, &uncompressed, tags::via<OutdoorDelta_MM7>);
-        }
+    finishPendingSave(); // Saves can't overlap.
 
-        std::string file_name = pCurrentMapName;
-        size_t pos = file_name.find_last_of(".");
-        file_name[pos + 1] = 'd';
-        lodWriter.write(file_name, lod::encodeCompressed(uncompressed));
+    s_SavedMapName = pCurrentMapName;
+    if (pCurrentMapName == "d05.blv") { // arena
+        return {};
     }
 
-    // Apparently vanilla had two bugs canceling each other out:
-    // 1. Broken binary search implementation when looking up LOD entries.
-    // 2. Writing additional duplicate entry at the end of a saves LOD file.
-    // Our code doesn't support duplicate entries, so we just add a dummy entry
-    lodWriter.write("z.bin", Blob::fromString("dummy"));
+    // Game thread only captures the snapshots, encoding & writing is then done on a worker thread.
+    std::shared_ptr<SaveGameData> data = std::make_shared<SaveGameData>();
+    SaveGameHeader saveHeader = captureSaveGame(NotSaveWorld, title, data.get());
+    data->baseLod = std::move(memorySaveLod);
 
-    lodWriter.close();
+    if (IsAutoSAve)
+        data->copyPaths.push_back(makeDataPath("saves", "autosave.mm7"));
+    if (!copyPath.empty())
+        data->copyPaths.push_back(copyPath);
+    data->cacheName = cacheName;
+    data->chunked = engine->config->settings.ChunkedSaves.value();
 
-    if (IsAutoSAve) {
-        std::string src = makeDataPath("data", "new.lod");
-        std::string dst = makeDataPath("saves", "autosave.mm7");
-        std::error_code ec;
-        if (!std::filesystem::copy_file(src, dst, std::filesystem::copy_options::overwrite_existing, ec))
-            logger->warning("Copying of autosave.mm7 failed");
-    }
-    pParty->pos.x = pPositionX;
-    pParty->pos.y = pPositionY;
-    pParty->pos.z = pPositionZ;
-    pParty->uFallStartZ = pPositionZ;
-    pParty->_viewYaw = partyViewYaw;
-    pParty->_viewPitch = partyViewPitch;
+    pSave_LOD->close(); // Reopened in finishPendingSave.
+    pendingSave = engine->_threadPool->run([data] { return writeSaveGame(*data); });
+    pendingSaveCacheName = cacheName;
+    pendingSaveCallback = std::move(callback);
 
-    pSave_LOD->open(makeDataPath("data", "new.lod"), LOD_ALLOW_DUPLICATES);
+    return saveHeader;
+}
 
-    return save_header;
+Blob SaveGameToMemory() {
+    finishPendingSave(); // Make sure pSave_LOD is open & up to date.
+
+    SaveGameData data;
+    captureSaveGame(false, {}, &data);
+    render->FinishScreenshots();
+
+    Blob result;
+    BlobOutputStream stream(&result);
+    LodWriter lodWriter(&stream, makeDataPath("data", "new.lod"), makeSaveLodInfo());
+    copySaveLodEntries(*pSave_LOD, &lodWriter);
+    writeSaveGameEntries(data, &lodWriter);
+    lodWriter.close();
+    stream.close();
+    return result;
 }
 
 void DoSavegame(unsigned int uSlot) {
     assert(pCurrentMapName != "d05.blv"); // Not Arena.
 
-    pSavegameList->pSavegameHeader[uSlot] = SaveGame(0, 0, pSavegameList->pSavegameHeader[uSlot].name);
-
-    std::string src = makeDataPath("data", "new.lod");
     std::string dst = makeDataPath("saves", fmt::format("save{:03}.mm7", uSlot));
-    std::error_code ec;
-    if (!std::filesystem::copy_file(src, dst, std::filesystem::copy_options::overwrite_existing, ec))
-        logger->error("Failed to copy: {}", src);
+    pSavegameList->pSavegameHeader[uSlot] = SaveGame(0, 0, pSavegameList->pSavegameHeader[uSlot].name, dst, [] (bool success) {
+        if (success)
+            engine->_statusBar->setEvent(LSTR_GAME_SAVED);
+    });
 
     pSavegameList->selectedSlot = uSlot;
 
@@ -292,10 +560,87 @@ void DoSavegame(unsigned int uSlot) {
     }
 
     pEventTimer->setPaused(false);
-    engine->_statusBar->setEvent(LSTR_GAME_SAVED);
+}
+
+void copySaveFile(const std::string &src, const std::string &dst) {
+    Blob data = Blob::fromFile(src);
+    if (!LodChunkStore::isManifest(data)) {
+        data = Blob(); // Unmap before copying.
+        std::filesystem::copy_file(src, dst, std::filesystem::copy_options::overwrite_existing);
+        return;
+    }
+
+    Blob lod = saveChunkStore(src).assemble(data);
+    TempFileOutputStream output(dst);
+    output.write(lod.string_view());
+    output.close();
+}
+
+static SaveFileInfo readSaveFileInfo(const std::string &path) {
+    static const std::array<std::string, 2> names = {"header.bin", "image.pcx"};
+    LodReader lod(readSaveFile(path, names), path, LOD_ALLOW_DUPLICATES);
+
+    SaveFileInfo result;
+    deserialize(lod.read("header.bin"), &result.header, tags::via<SaveGameHeader_MM7>);
+    result.hasThumbnail = lod.exists("image.pcx");
+    return result;
+}
+
+std::vector<std::optional<SaveFileInfo>> readSaveFileInfos(const std::vector<std::string> &fileNames) {
+    std::vector<std::optional<SaveFileInfo>> result(fileNames.size());
+    std::vector<std::pair<size_t, std::future<SaveFileInfo>>> pending;
+    std::vector<CachedSaveFileInfo> pendingStats;
+
+    for (size_t i = 0; i < fileNames.size(); i++) {
+        std::string path = makeDataPath("saves", fileNames[i]);
+
+        uintmax_t size = 0;
+        std::filesystem::file_time_type modificationTime;
+        if (!statSaveFile(path, &size, &modificationTime))
+            continue; // Doesn't exist.
+
+        auto pos = saveFileInfoCache.find(path);
+        if (pos != saveFileInfoCache.end() && pos->second.size == size && pos->second.modificationTime == modificationTime) {
+            result[i] = pos->second.info;
+            continue;
+        }
+
+        pending.emplace_back(i, engine->_threadPool->run([path] { return readSaveFileInfo(path); }));
+        pendingStats.push_back(CachedSaveFileInfo{size, modificationTime, {}});
+    }
+
+    for (size_t j = 0; j < pending.size(); j++) {
+        auto &[i, future] = pending[j];
+        result[i] = future.get();
+
+        CachedSaveFileInfo &cached = saveFileInfoCache[makeDataPath("saves", fileNames[i])];
+        cached = std::move(pendingStats[j]);
+        cached.info = *result[i];
+    }
+
+    return result;
+}
+
+GraphicsImage *SavegameList::thumbnail(int slot) {
+    assert(slot >= 0 && slot < MAX_SAVE_SLOTS);
+
+    if (pSavegameThumbnails[slot] || pSavegameThumbnailPaths[slot].empty())
+        return pSavegameThumbnails[slot];
+
+    static const std::array<std::string, 1> names = {"image.pcx"};
+    LodReader lod(readSaveFile(pSavegameThumbnailPaths[slot], names), pSavegameThumbnailPaths[slot], LOD_ALLOW_DUPLICATES);
+    pSavegameThumbnails[slot] = GraphicsImage::Create(std::make_unique<PCX_LOD_Raw_Loader>(&lod, "image.pcx"));
+    if (pSavegameThumbnails[slot]->width() == 0) { // This also loads the image while the lod is still open.
+        pSavegameThumbnails[slot]->Release();
+        pSavegameThumbnails[slot] = nullptr;
+    }
+    pSavegameThumbnailPaths[slot].clear(); // Don't retry.
+    return pSavegameThumbnails[slot];
 }
 
 void SavegameList::Initialize() {
+    finishPendingSave(); // Make sure we're not looking at half-written saves.
+
     pSavegameList->Reset();
 
     std::string saves_dir = makeDataPath("saves");
@@ -326,6 +671,7 @@ void SavegameList::Reset() {
 
     for (int j = 0; j < MAX_SAVE_SLOTS; j++) {
         this->pFileList[j].clear();
+        this->pSavegameThumbnailPaths[j].clear();
     }
 
     numSavegameFiles = 0;
@@ -335,8 +681,11 @@ void SavegameList::Reset() {
 }
 
 void SaveNewGame() {
+    finishPendingSave();
+
     std::string file_path = makeDataPath("data", "new.lod");
     pSave_LOD->close();
+    memorySaveLod = Blob();
     std::filesystem::remove(file_path);
 
     LodWriter lodWriter(file_path, makeSaveLodInfo());
@@ -408,26 +757,25 @@ void QuickSaveGame() {
     }
 
     pSavegameList->pSavegameHeader[uSlot].name = "Quicksave";
-    pSavegameList->pSavegameHeader[uSlot] = SaveGame(0, 0, pSavegameList->pSavegameHeader[uSlot].name);
-
-    std::string src = makeDataPath("data", "new.lod");
     std::string dst = makeDataPath("saves", quickSaveName);
-    std::error_code ec;
-    if (!std::filesystem::copy_file(src, dst, std::filesystem::copy_options::overwrite_existing, ec)) {
-        logger->error("Failed to copy: {}", src);
-        engine->config->gameplay.QuickSavesCount.cycleDecrement();
-        pAudioPlayer->playUISound(SOUND_error);
-    } else {
-        engine->_statusBar->setEvent(LSTR_GAME_SAVED);
-        pAudioPlayer->playUISound(SOUND_StartMainChoice02);
-    }
+    pSavegameList->pSavegameHeader[uSlot] = SaveGame(0, 0, pSavegameList->pSavegameHeader[uSlot].name, dst, [] (bool success) {
+        if (!success) {
+            engine->config->gameplay.QuickSavesCount.cycleDecrement();
+            pAudioPlayer->playUISound(SOUND_error);
+        } else {
+            engine->_statusBar->setEvent(LSTR_GAME_SAVED);
+            pAudioPlayer->playUISound(SOUND_StartMainChoice02);
+        }
+    }, quickSaveName);
 }
 
 void QuickLoadGame() {
-    pSavegameList->Initialize();
+    finishPendingSave(); // Make sure the quicksave cache is up to date.
 
     std::string quickSaveName = GetCurrentQuickSave();
 
+    pSavegameList->Initialize();
+
     int uSlot = -1;
     // find QuickSave slot
     for (int i = 0; i < MAX_SAVE_SLOTS; ++i) {
@@ -439,14 +787,26 @@ void QuickLoadGame() {
         }
     }
 
-    if (uSlot != -1) {
-        LoadGame(uSlot);
-        uGameState = GAME_STATE_LOADING_GAME;
-        pAudioPlayer->playUISound(SOUND_StartMainChoice02);
-    } else {
+    if (uSlot == -1) {
         logger->error("QuickLoadGame:: No quick save could be found!");
         pAudioPlayer->playUISound(SOUND_error);
+        return;
+    }
+
+    // Last quicksave is still in memory & the file wasn't replaced since, no need to go through the filesystem.
+    uintmax_t size = 0;
+    std::filesystem::file_time_type modificationTime;
+    if (quickSaveCache.name == quickSaveName &&
+        statSaveFile(makeDataPath("saves", quickSaveName), &size, &modificationTime) &&
+        quickSaveCache.size == size && quickSaveCache.modificationTime == modificationTime) {
+        pSavegameList->selectedSlot = uSlot;
+        pSavegameList->lastLoadedSave = quickSaveName;
+        LoadGameFromMemory(quickSaveCache.save);
+    } else {
+        LoadGame(uSlot);
     }
+    uGameState = GAME_STATE_LOADING_GAME;
+    pAudioPlayer->playUISound(SOUND_StartMainChoice02);
 }
 
 std::string GetCurrentQuickSave() {
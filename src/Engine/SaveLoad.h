@@ -1,10 +1,15 @@
 #pragma once
 
 #include <array>
+#include <functional>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "Engine/Time/Time.h"
 
+#include "Utility/Memory/Blob.h"
+
 constexpr unsigned int MAX_SAVE_SLOTS = 45;
 
 struct SaveGameHeader {
@@ -13,16 +18,29 @@ struct SaveGameHeader {
     Time playingTime; // Game time of the save.
 };
 
+struct SaveFileInfo {
+    SaveGameHeader header;
+    bool hasThumbnail = false; // Whether the save contains a thumbnail image.
+};
+
 struct SavegameList {
     static void Initialize();
     SavegameList();
 
     void Reset();
 
+    /**
+     * @param slot                      Save slot.
+     * @return                          Thumbnail for the provided slot, or `nullptr` if there is none. Thumbnails are
+     *                                  decoded on first use from the file in `pSavegameThumbnailPaths`.
+     */
+    [[nodiscard]] class GraphicsImage *thumbnail(int slot);
+
     std::array<std::string, MAX_SAVE_SLOTS> pFileList;
     std::array<bool, MAX_SAVE_SLOTS> pSavegameUsedSlots;
     std::array<SaveGameHeader, MAX_SAVE_SLOTS> pSavegameHeader;
     std::array<class GraphicsImage *, MAX_SAVE_SLOTS> pSavegameThumbnails;
+    std::array<std::string, MAX_SAVE_SLOTS> pSavegameThumbnailPaths; // Where to decode thumbnails from, cleared once decoded.
 
     int numSavegameFiles = 0;
     int selectedSlot = 0;
@@ -30,13 +48,91 @@ struct SavegameList {
     std::string lastLoadedSave{};
 };
 
+/**
+ * Reads the headers of the provided save files on the engine's thread pool. Results are cached in memory, keyed by
+ * file size & modification time, so reopening the save or load menu only rereads the saves that have changed.
+ *
+ * @param fileNames                     Save file names in the saves folder, e.g. "save000.mm7".
+ * @return                              Save file infos, `std::nullopt` for files that don't exist.
+ */
+std::vector<std::optional<SaveFileInfo>> readSaveFileInfos(const std::vector<std::string> &fileNames);
+
+/**
+ * Copies a save file. Chunked saves are assembled into regular saves, so this can also be used to get a save that
+ * vanilla can load.
+ *
+ * @param src                           Path to the save file to copy.
+ * @param dst                           Destination path.
+ * @throw Exception                     On errors.
+ */
+void copySaveFile(const std::string &src, const std::string &dst);
+
 void LoadGame(unsigned int uSlot);
-SaveGameHeader SaveGame(bool IsAutoSAve, bool NotSaveWorld, const std::string &title = {});
+
+/**
+ * Same as `LoadGame`, but loads from an in-memory save instead of a save slot. Doesn't touch the filesystem, new.lod
+ * on disk is only brought up to date on the next `SaveGame` call.
+ *
+ * Just like `LoadGame`, this only prepares the game state, setting `uGameState` to `GAME_STATE_LOADING_GAME` is up to
+ * the caller.
+ *
+ * @param save                          Save file contents, e.g. as returned by `SaveGameToMemory`.
+ */
+void LoadGameFromMemory(const Blob &save);
+
+/**
+ * Saves the game into `new.lod`. Only the snapshots are taken on the game thread, the save is then written out on a
+ * worker thread. Use `finishPendingSave` to wait for it to complete.
+ *
+ * @param IsAutoSAve                    Whether to also copy the save into `autosave.mm7`.
+ * @param NotSaveWorld                  Whether the state of the current map should not be saved.
+ * @param title                         Save title.
+ * @param copyPath                      If non-empty, `new.lod` is also copied to this path once written.
+ * @param callback                      Callback to invoke on the game thread once the save is written, `true` is
+ *                                      passed on success.
+ * @param cacheName                     If non-empty, a copy of the written save is kept in memory under this name, and
+ *                                      is then used by `QuickLoadGame` instead of the save file with the same name,
+ *                                      as long as that file doesn't change.
+ * @return                              Header of the savegame.
+ */
+SaveGameHeader SaveGame(bool IsAutoSAve, bool NotSaveWorld, const std::string &title = {},
+                        const std::string &copyPath = {}, std::function<void(bool)> callback = {},
+                        const std::string &cacheName = {});
+
+/**
+ * Same as `SaveGame(false, false)`, but writes the save into memory. Doesn't touch the filesystem and doesn't write
+ * anything into `new.lod`.
+ *
+ * @return                              Save file contents, in the same format as the `.mm7` files in the saves folder.
+ */
+Blob SaveGameToMemory();
+
+/**
+ * Waits for the save that's being written in the background to complete, reopens `pSave_LOD` and invokes the save
+ * completion callback. Does nothing if there is no pending save.
+ */
+void finishPendingSave();
+
+/**
+ * Same as `finishPendingSave`, but returns immediately if the pending save is still being written. Meant to be called
+ * once per frame.
+ */
+void pollPendingSave();
+
 void DoSavegame(unsigned int uSlot);
 bool Initialize_GamesLOD_NewLOD();
 void SaveNewGame();
 
+/**
+ * Quicksaves the game. Like all saves, this only takes the snapshots on the game thread, and the save is written out
+ * in the background. A copy of the quicksave is kept in memory.
+ */
 void QuickSaveGame();
+
+/**
+ * Loads the current quicksave. Loads from the in-memory copy of the last quicksave if it's still current and the
+ * quicksave file wasn't replaced since (same size & modification time), and from the saves folder otherwise.
+ */
 void QuickLoadGame();
 std::string GetCurrentQuickSave();
 
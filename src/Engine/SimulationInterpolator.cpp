@@ -0,0 +1,91 @@
+#include "SimulationInterpolator.h"
+
+#include <cassert>
+#include <cmath>
+
+#include "Engine/Objects/Actor.h"
+#include "Engine/Party.h"
+
+#include "Utility/Math/TrigLut.h"
+
+// Anything moving faster than this in a single step is a teleport, and is snapped instead of interpolated.
+static constexpr float MAX_STEP_DISTANCE = 512.0f;
+
+static float lerp(float a, float b, float alpha) {
+    return a + (b - a) * alpha;
+}
+
+static int lerpAngle(int a, int b, float alpha) {
+    int delta = ((b - a + TrigLUT.uIntegerPi) & TrigLUT.uDoublePiMask) - TrigLUT.uIntegerPi;
+    return a + static_cast<int>(std::round(delta * alpha));
+}
+
+static bool isTeleport(const Vec3f &a, const Vec3f &b) {
+    return (b - a).lengthSqr() > MAX_STEP_DISTANCE * MAX_STEP_DISTANCE;
+}
+
+const SimulationInterpolator *simulationInterpolator = nullptr;
+
+SimulationInterpolator::PartyState SimulationInterpolator::partyState() {
+    return {pParty->pos, pParty->_viewYaw, pParty->_viewPitch};
+}
+
+void SimulationInterpolator::beginStep() {
+    assert(!simulationInterpolator);
+
+    _previousParty = partyState();
+    _previousActors.resize(pActors.size());
+    for (size_t i = 0; i < pActors.size(); i++)
+        _previousActors[i] = pActors[i].pos;
+    _hasPrevious = true;
+}
+
+void SimulationInterpolator::reset() {
+    assert(!simulationInterpolator);
+
+    _hasPrevious = false;
+    _previousActors.clear();
+}
+
+void SimulationInterpolator::beginDraw(float alpha) {
+    assert(!simulationInterpolator);
+
+    if (!_hasPrevious)
+        return;
+
+    PartyState live = partyState();
+    _drawParty = live;
+    if (!isTeleport(_previousParty.pos, live.pos)) {
+        _drawParty.pos.x = lerp(_previousParty.pos.x, live.pos.x, alpha);
+        _drawParty.pos.y = lerp(_previousParty.pos.y, live.pos.y, alpha);
+        _drawParty.pos.z = lerp(_previousParty.pos.z, live.pos.z, alpha);
+    }
+    _drawParty.yaw = lerpAngle(_previousParty.yaw, live.yaw, alpha);
+    _drawParty.pitch = static_cast<int>(std::round(lerp(_previousParty.pitch, live.pitch, alpha)));
+
+    // Actors spawned in the last step have no previous state & are drawn where they are.
+    _drawActors.resize(pActors.size());
+    for (size_t i = 0; i < pActors.size(); i++) {
+        const Vec3i &pos = pActors[i].pos;
+        Vec3i &drawPos = _drawActors[i];
+        drawPos = pos;
+        if (i >= _previousActors.size())
+            continue;
+
+        const Vec3i &prev = _previousActors[i];
+        if (isTeleport(prev.toFloat(), pos.toFloat()))
+            continue;
+        drawPos.x = static_cast<int>(std::round(lerp(prev.x, pos.x, alpha)));
+        drawPos.y = static_cast<int>(std::round(lerp(prev.y, pos.y, alpha)));
+        drawPos.z = static_cast<int>(std::round(lerp(prev.z, pos.z, alpha)));
+    }
+
+    simulationInterpolator = this;
+}
+
+void SimulationInterpolator::endDraw() {
+    // Drawing doesn't add or remove actors.
+    assert(!simulationInterpolator || _drawActors.size() == pActors.size());
+
+    simulationInterpolator = nullptr;
+}
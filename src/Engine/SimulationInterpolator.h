@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include "Library/Geometry/Vec.h"
+
+/**
+ * Interpolates party & actor positions between the last two fixed simulation steps, so that the world moves smoothly
+ * when it's rendered at a higher rate than it's simulated at. See `Timer::setFixedStep`.
+ *
+ * Usage is to call `beginStep` before each simulation step, and to wrap the drawing code in `beginDraw` & `endDraw`.
+ * The world state itself is never touched - draw code that places the camera & the actor sprites asks
+ * `simulationInterpolator` for the positions to draw at, and everything else (picking, visibility flags, sectors)
+ * keeps working with the live positions.
+ */
+class SimulationInterpolator {
+ public:
+    /**
+     * Remembers the current state as the state before the upcoming simulation step.
+     */
+    void beginStep();
+
+    /**
+     * Forgets the remembered state, e.g. after a location change. Nothing is interpolated until the next `beginStep`.
+     */
+    void reset();
+
+    /**
+     * Computes the state interpolated between the last two simulation steps, and publishes this interpolator through
+     * `simulationInterpolator` until `endDraw` is called. Does nothing if there is nothing to interpolate from.
+     *
+     * @param alpha                     Interpolation factor in [0, 1], zero means the state before the last step.
+     */
+    void beginDraw(float alpha);
+
+    /**
+     * Stops publishing the interpolated state.
+     */
+    void endDraw();
+
+    [[nodiscard]] const Vec3f &partyPos() const {
+        return _drawParty.pos;
+    }
+
+    [[nodiscard]] int partyYaw() const {
+        return _drawParty.yaw;
+    }
+
+    [[nodiscard]] int partyPitch() const {
+        return _drawParty.pitch;
+    }
+
+    /**
+     * @param actorId                   Index into `pActors`.
+     * @return                          Position to draw the actor at.
+     */
+    [[nodiscard]] const Vec3i &actorPos(int actorId) const {
+        return _drawActors[actorId];
+    }
+
+ private:
+    struct PartyState {
+        Vec3f pos;
+        int yaw = 0;
+        int pitch = 0;
+    };
+
+    [[nodiscard]] static PartyState partyState();
+
+ private:
+    bool _hasPrevious = false;
+    PartyState _previousParty;
+    PartyState _drawParty;
+    std::vector<Vec3i> _previousActors;
+    std::vector<Vec3i> _drawActors;
+};
+
+/**
+ * Interpolator to take party & actor draw positions from. Only set between `SimulationInterpolator::beginDraw` and
+ * `SimulationInterpolator::endDraw`, draw code should use the live positions if it's null.
+ */
+extern const SimulationInterpolator *simulationInterpolator;
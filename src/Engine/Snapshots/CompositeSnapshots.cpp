@@ -1,7 +1,9 @@
 #include "CompositeSnapshots.h"
 
+#include <array>
 #include <string>
 #include <algorithm>
+#include <functional>
 
 #include "Engine/Graphics/Indoor.h"
 #include "Engine/Graphics/Outdoor.h"
@@ -23,10 +25,38 @@
 #include "Library/Lod/LodWriter.h"
 #include "Library/Lod/LodReader.h"
 
-void reconstruct(const IndoorLocation_MM7 &src, IndoorLocation *dst) {
-    reconstruct(src.vertices, &dst->pVertices);
-    reconstruct(src.faces, &dst->pFaces);
-    reconstruct(src.faceData, &dst->pLFaces);
+#include "Utility/Thread/ThreadPool.h"
+
+void reconstruct(const IndoorLocation_MM7 &src, IndoorLocation *dst, ThreadPool *pool) {
+    // Conversions of the big arrays are independent of each other and don't touch global state, so they can run in
+    // parallel. Everything else either depends on them, or goes through the asset managers, and is done below.
+    std::array<std::function<void()>, 6> conversions = {{
+        [&] { reconstruct(src.vertices, &dst->pVertices); },
+        [&] { reconstruct(src.faces, &dst->pFaces); },
+        [&] { reconstruct(src.faceData, &dst->pLFaces); },
+        [&] { reconstruct(src.faceExtras, &dst->pFaceExtras); },
+        [&] {
+            reconstruct(src.sectors, &dst->pSectors);
+            reconstruct(src.sectorData, &dst->ptr_0002B0_sector_rdata);
+            reconstruct(src.sectorLightData, &dst->ptr_0002B8_sector_lrdata);
+        },
+        [&] {
+            reconstruct(src.lights, &dst->pLights);
+            reconstruct(src.bspNodes, &dst->pNodes);
+            reconstruct(src.spawnPoints, &dst->pSpawnPoints);
+            reconstruct(src.mapOutlines, &dst->pMapOutlines);
+        }
+    }};
+
+    if (pool) {
+        pool->parallelFor(conversions.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+                conversions[i]();
+        });
+    } else {
+        for (const std::function<void()> &conversion : conversions)
+            conversion();
+    }
 
     for (size_t i = 0, j = 0; i < dst->pFaces.size(); ++i) {
         BLVFace *pFace = &dst->pFaces[i];
@@ -60,8 +90,6 @@ void reconstruct(const IndoorLocation_MM7 &src, IndoorLocation *dst) {
         pFace->SetTexture(texName);
     }
 
-    reconstruct(src.faceExtras, &dst->pFaceExtras);
-
     std::string textureName;
     for (unsigned i = 0; i < dst->pFaceExtras.size(); ++i) {
         reconstruct(src.faceExtraTextures[i], &textureName);
@@ -84,9 +112,6 @@ void reconstruct(const IndoorLocation_MM7 &src, IndoorLocation *dst) {
         }
     }
 
-    reconstruct(src.sectors, &dst->pSectors);
-    reconstruct(src.sectorData, &dst->ptr_0002B0_sector_rdata);
-
     for (size_t i = 0, j = 0; i < dst->pSectors.size(); ++i) {
         BLVSector *pSector = &dst->pSectors[i];
 
@@ -120,8 +145,6 @@ void reconstruct(const IndoorLocation_MM7 &src, IndoorLocation *dst) {
         assert(j <= dst->ptr_0002B0_sector_rdata.size());
     }
 
-    reconstruct(src.sectorLightData, &dst->ptr_0002B8_sector_lrdata);
-
     for (unsigned i = 0, j = 0; i < dst->pSectors.size(); ++i) {
         BLVSector *pSector = &dst->pSectors[i];
 
@@ -138,11 +161,6 @@ void reconstruct(const IndoorLocation_MM7 &src, IndoorLocation *dst) {
         reconstruct(src.decorationNames[i], &decorationName);
         pLevelDecorations[i].uDecorationDescID = pDecorationList->GetDecorIdByName(decorationName);
     }
-
-    reconstruct(src.lights, &dst->pLights);
-    reconstruct(src.bspNodes, &dst->pNodes);
-    reconstruct(src.spawnPoints, &dst->pSpawnPoints);
-    reconstruct(src.mapOutlines, &dst->pMapOutlines);
 }
 
 void deserialize(InputStream &src, IndoorLocation_MM7 *dst) {
@@ -222,6 +240,7 @@ void reconstruct(const IndoorDelta_MM7 &src, IndoorLocation *dst) {
         pActors[i].id = i;
 
     reconstruct(src.spriteObjects, &pSpriteObjects);
+    InvalidateSpriteObjectFreeSlots();
 
     for (size_t i = 0; i < pSpriteObjects.size(); ++i) {
         if (pSpriteObjects[i].containing_item.uItemID != ITEM_NULL && !(pSpriteObjects[i].uAttributes & SPRITE_MISSILE)) {
@@ -487,10 +506,13 @@ void reconstruct(const OutdoorDelta_MM7 &src, OutdoorLocation *dst) {
         pLevelDecorations[i].uFlags = LevelDecorationFlags(src.decorationFlags[i]);
 
     reconstruct(src.actors, &pActors);
-    for(size_t i = 0; i < pActors.size(); i++)
+    for(size_t i = 0; i < pActors.size(); i++) {
         pActors[i].id = i;
+        pActors[i].asleep = false;
+    }
 
     reconstruct(src.spriteObjects, &pSpriteObjects);
+    InvalidateSpriteObjectFreeSlots();
     reconstruct(src.chests, &vChests);
     reconstruct(src.eventVariables, &engine->_persistentVariables);
     reconstruct(src.locationTime, &dst->loc_time);
@@ -22,6 +22,7 @@ struct SpriteFrameTable;
 class LodReader;
 class LodWriter;
 class FontData;
+class ThreadPool;
 
 struct IndoorLocation_MM7 {
     BLVHeader_MM7 header;
@@ -43,7 +44,12 @@ struct IndoorLocation_MM7 {
     std::vector<BLVMapOutline_MM7> mapOutlines;
 };
 
-void reconstruct(const IndoorLocation_MM7 &src, IndoorLocation *dst);
+/**
+ * @param src                           Indoor location snapshot.
+ * @param dst                           Indoor location to reconstruct.
+ * @param pool                          Thread pool to convert the large arrays on, can be `nullptr`.
+ */
+void reconstruct(const IndoorLocation_MM7 &src, IndoorLocation *dst, ThreadPool *pool = nullptr);
 void deserialize(InputStream &src, IndoorLocation_MM7 *dst);
 
 
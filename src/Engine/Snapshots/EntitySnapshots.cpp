@@ -176,6 +176,22 @@ void reconstruct(const Vec3s &src, Vec3i *dst) {
     dst->z = src.z;
 }
 
+void reconstruct(const std::vector<Vec3s> &src, std::vector<Vec3i> *dst) {
+    dst->resize(src.size());
+
+    // Converting in fixed-size blocks lets the compiler vectorize the inner loop even at -O2.
+    constexpr size_t BLOCK_SIZE = 16;
+    const int16_t *srcCoords = reinterpret_cast<const int16_t *>(src.data());
+    int *dstCoords = reinterpret_cast<int *>(dst->data());
+    size_t size = src.size() * 3;
+    size_t i = 0;
+    for (; i + BLOCK_SIZE <= size; i += BLOCK_SIZE)
+        for (size_t j = 0; j < BLOCK_SIZE; j++)
+            dstCoords[i + j] = srcCoords[i + j];
+    for (; i < size; i++)
+        dstCoords[i] = srcCoords[i];
+}
+
 void snapshot(const BBoxi &src, BBoxs_MM7 *dst) {
     // TODO(captainurist): do we need to check for overflows here?
     dst->x1 = src.x1;
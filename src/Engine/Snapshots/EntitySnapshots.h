@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "Library/Geometry/Vec.h"
 #include "Library/Geometry/Plane.h"
@@ -75,6 +76,9 @@ void reconstruct(uint16_t src, Pid *dst);
 void snapshot(const Vec3i &src, Vec3s *dst);
 void reconstruct(const Vec3s &src, Vec3i *dst);
 
+// Batched version for the vertex arrays, converts them as flat coordinate arrays so that the loop gets vectorized.
+void reconstruct(const std::vector<Vec3s> &src, std::vector<Vec3i> *dst);
+
 
 #pragma pack(push, 1)
 
@@ -57,6 +57,7 @@ void deserialize(const TriBlob &src, DecorationList *dst) {
         deserialize(src.mm8, &dst->pDecorations, tags::append, tags::via<DecorationDesc_MM7>);
 
     assert(!dst->pDecorations.empty());
+    dst->buildNameIndex();
 }
 
 void deserialize(const TriBlob &src, IconFrameTable *dst) {
@@ -67,6 +68,7 @@ void deserialize(const TriBlob &src, IconFrameTable *dst) {
         dst->pIcons[i].id = i;
 
     assert(!dst->pIcons.empty());
+    dst->buildNameIndex();
 }
 
 void deserialize(const TriBlob &src, MonsterList *dst) {
@@ -96,6 +98,7 @@ void deserialize(const TriBlob &src, ObjectList *dst) {
         deserialize(src.mm8, &dst->pObjects, tags::append, tags::via<ObjectDesc_MM7>);
 
     assert(!dst->pObjects.empty());
+    dst->buildIdIndex();
 }
 
 void deserialize(const TriBlob &src, OverlayList *dst) {
@@ -113,12 +116,15 @@ void deserialize(const TriBlob &src, OverlayList *dst) {
 
 void deserialize(const TriBlob &src, SpriteFrameTable *dst) {
     deserialize(src.mm7, dst, tags::via<SpriteFrameTable_MM7>);
+
+    dst->buildFrameIndex();
 }
 
 void deserialize(const TriBlob &src, TextureFrameTable *dst) {
     deserialize(src.mm7, &dst->textures, tags::append, tags::via<TextureFrame_MM7>);
 
     assert(!dst->textures.empty());
+    dst->buildFrameIndex();
 }
 
 void deserialize(const TriBlob &src, TileTable *dst) {
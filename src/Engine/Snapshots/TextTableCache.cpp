@@ -0,0 +1,239 @@
+#include "TextTableCache.h"
+
+#include <array>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "Engine/Objects/Monsters.h"
+#include "Engine/Spells/Spells.h"
+#include "Engine/Tables/FactionTable.h"
+#include "Engine/Tables/StorylineTextTable.h"
+#include "Engine/MapInfo.h"
+
+#include "Library/Binary/BinarySerialization.h"
+#include "Library/BuildInfo/BuildInfo.h"
+
+#include "Utility/Exception.h"
+#include "Utility/Hash.h"
+#include "Utility/Streams/BlobOutputStream.h"
+#include "Utility/Streams/MemoryInputStream.h"
+
+static constexpr char CACHE_SIGNATURE[8] = {'O', 'E', 'T', 'X', 'T', 'C', 'C', '1'};
+
+// Bump this when the cache format changes. Parser changes are covered by the build id check.
+static constexpr uint32_t CACHE_VERSION = 2;
+
+// Trivially copyable fields are stored as is, so the cache is also invalidated whenever the table layout changes.
+static constexpr uint64_t CACHE_LAYOUT = sizeof(MapInfo) ^ (sizeof(MonsterInfo) << 12) ^ (sizeof(SpellInfo) << 24) ^
+                                         (sizeof(FactionTable) << 32) ^ (sizeof(StorylineRecord) << 48);
+
+struct TextTableCacheHeader {
+    char signature[8] = {};
+    uint32_t version = 0;
+    uint32_t sourceCount = 0;
+    uint64_t layout = 0;
+    uint64_t build = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<TextTableCacheHeader>);
+
+struct TextTableSourceKey {
+    uint64_t size = 0;
+    uint64_t hash = 0;
+
+    friend bool operator==(const TextTableSourceKey &l, const TextTableSourceKey &r) = default;
+};
+
+static TextTableSourceKey makeSourceKey(const Blob &blob) {
+    // Our text files are small enough for hashing not to show up in the profiles.
+    return {blob.size(), fnv1aHashBytes(blob.data(), blob.size())};
+}
+
+static uint64_t makeBuildKey() {
+    // Cache written by a different build is never used, parsers might have changed in between.
+    std::string_view revision = gitRevision();
+    std::string_view time = buildTime();
+    return fnv1aHash(time, fnv1aHash(revision));
+}
+
+static std::array<TextTableSourceKey, 6> makeSourceKeys(const TextTableSources &sources) {
+    return {makeSourceKey(sources.mapStats), makeSourceKey(sources.monsters), makeSourceKey(sources.placements),
+            makeSourceKey(sources.spells), makeSourceKey(sources.factions), makeSourceKey(sources.history)};
+}
+
+namespace {
+class CacheWriter {
+ public:
+    explicit CacheWriter(OutputStream *dst) : _dst(dst) {}
+
+    template<class... Ts>
+    void operator()(const Ts &... values) {
+        (write(values), ...);
+    }
+
+ private:
+    void write(const std::string &value) {
+        serialize(value, _dst);
+    }
+
+    template<class T> requires std::is_trivially_copyable_v<T>
+    void write(const T &value) {
+        _dst->write(&value, sizeof(T));
+    }
+
+ private:
+    OutputStream *_dst = nullptr;
+};
+
+class CacheReader {
+ public:
+    explicit CacheReader(InputStream &src) : _src(src) {}
+
+    template<class... Ts>
+    void operator()(Ts &... values) {
+        (read(&values), ...);
+    }
+
+ private:
+    void read(std::string *value) {
+        deserialize(_src, value);
+    }
+
+    template<class T> requires std::is_trivially_copyable_v<T>
+    void read(T *value) {
+        if (_src.read(value, sizeof(T)) != sizeof(T))
+            throw Exception("Unexpected end of text table cache");
+    }
+
+ private:
+    InputStream &_src;
+};
+} // namespace
+
+// Tables are visited field by field, the same functions are used both for reading and for writing.
+
+template<class Visitor>
+static void visitTable(Visitor &visitor, MapStats &table) {
+    for (MapInfo &info : table.pInfos) {
+        visitor(info.name, info.fileName, info.encounter1MonsterTexture, info.encounter2MonsterTexture,
+                info.encounter3MonsterTexture, info.numResets, info.firstVisitedAt, info.respawnIntervalDays,
+                info.alertDays, info.baseStealingFine, info.perceptionDifficulty, info.field_2C, info.disarmDifficulty,
+                info.trapDamageD20DiceCount, info.mapTreasureLevel, info.encounterChance, info.encounter1Chance,
+                info.encounter2Chance, info.encounter3Chance, info.Dif_M1, info.encounter1MinCount,
+                info.encounter1MaxCount, info.Dif_M2, info.encounter2MinCount, info.encounter2MaxCount, info.Dif_M3,
+                info.encounter3MinCount, info.encounter3MaxCount, info.field_3D, info.field_3E, info.field_3F,
+                info.musicId, info.uEAXEnv, info.field_42, info.field_43);
+    }
+}
+
+template<class Visitor>
+static void visitTable(Visitor &visitor, MonsterStats &table) {
+    for (MonsterInfo &info : table.infos) {
+        visitor(info.name, info.textureName, info.level, info.treasureDropChance, info.treasureLevel,
+                info.treasureType, info.goldDiceRolls, info.goldDiceSides, info.flying, info.movementType, info.aiType,
+                info.hostilityType, info.specialAttackType, info.specialAttackLevel, info.attack1Type,
+                info.attack1DamageDiceRolls, info.attack1DamageDiceSides, info.attack1DamageBonus,
+                info.attack1MissileType, info.attack2Chance, info.attack2Type, info.attack2DamageDiceRolls,
+                info.attack2DamageDiceSides, info.attack2DamageBonus, info.attack2MissileType, info.spell1UseChance,
+                info.spell1Id, info.spell1SkillMastery, info.spell2UseChance, info.spell2Id, info.spell2SkillMastery,
+                info.resFire, info.resAir, info.resWater, info.resEarth, info.resMind, info.resSpirit, info.resBody,
+                info.resLight, info.resDark, info.resPhysical, info.specialAbilityType,
+                info.specialAbilityDamageDiceRolls, info.specialAbilityDamageDiceSides,
+                info.specialAbilityDamageDiceBonus, info.numCharactersAttackedPerSpecialAbility, info.id,
+                info.bloodSplatOnDeath, info.field_3C_some_special_attack, info.field_3E, info.hp, info.ac, info.exp,
+                info.baseSpeed, info.recoveryTime, info.attackPreferences);
+    }
+    for (std::string &name : table.uniqueNames)
+        visitor(name);
+}
+
+template<class Visitor>
+static void visitTable(Visitor &visitor, SpellStats &table) {
+    for (SpellInfo &info : table.pInfos) {
+        visitor(info.name, info.pShortName, info.pDescription, info.pBasicSkillDesc, info.pExpertSkillDesc,
+                info.pMasterSkillDesc, info.pGrandmasterSkillDesc, info.damageType, info.field_20);
+    }
+}
+
+template<class Visitor>
+static void visitTable(Visitor &visitor, FactionTable &table) {
+    visitor(table.relations);
+}
+
+template<class Visitor>
+static void visitTable(Visitor &visitor, StorylineText &table) {
+    for (StorylineRecord &record : table.StoreLine)
+        visitor(record.pText, record.pPageTitle, record.uTime, record.f_9, record.f_A, record.f_B);
+    visitor(table.field_15C);
+}
+
+template<class Visitor>
+static void visitTables(Visitor &visitor, const TextTables &tables) {
+    visitTable(visitor, *tables.mapStats);
+    visitTable(visitor, *tables.monsterStats);
+    visitTable(visitor, *tables.spellStats);
+    visitTable(visitor, *tables.factionTable);
+    visitTable(visitor, *tables.storylineText);
+}
+
+bool loadTextTableCache(const Blob &cache, const TextTableSources &sources, const TextTables &dst) {
+    if (!cache)
+        return false;
+
+    try {
+        MemoryInputStream stream(cache.data(), cache.size());
+
+        TextTableCacheHeader header;
+        std::array<TextTableSourceKey, 6> keys;
+        CacheReader reader(stream);
+        reader(header);
+        if (memcmp(header.signature, CACHE_SIGNATURE, sizeof(CACHE_SIGNATURE)) != 0 || header.version != CACHE_VERSION ||
+            header.sourceCount != keys.size() || header.layout != CACHE_LAYOUT || header.build != makeBuildKey())
+            return false;
+
+        reader(keys);
+        if (keys != makeSourceKeys(sources))
+            return false;
+
+        // Read into temporaries first so that a truncated cache doesn't leave the tables half-initialized.
+        auto mapStats = std::make_unique<MapStats>();
+        auto monsterStats = std::make_unique<MonsterStats>();
+        auto spellStats = std::make_unique<SpellStats>();
+        auto factionTable = std::make_unique<FactionTable>();
+        auto storylineText = std::make_unique<StorylineText>();
+        visitTables(reader, {mapStats.get(), monsterStats.get(), spellStats.get(), factionTable.get(), storylineText.get()});
+
+        *dst.mapStats = std::move(*mapStats);
+        *dst.monsterStats = std::move(*monsterStats);
+        *dst.spellStats = std::move(*spellStats);
+        *dst.factionTable = std::move(*factionTable);
+        *dst.storylineText = std::move(*storylineText);
+        return true;
+    } catch (const std::exception &) {
+        return false;
+    }
+}
+
+Blob saveTextTableCache(const TextTableSources &sources, const TextTables &src) {
+    TextTableCacheHeader header;
+    memcpy(header.signature, CACHE_SIGNATURE, sizeof(CACHE_SIGNATURE));
+    header.version = CACHE_VERSION;
+    header.layout = CACHE_LAYOUT;
+    header.build = makeBuildKey();
+
+    std::array<TextTableSourceKey, 6> keys = makeSourceKeys(sources);
+    header.sourceCount = keys.size();
+
+    Blob result;
+    BlobOutputStream stream(&result);
+    CacheWriter writer(&stream);
+    writer(header, keys);
+    visitTables(writer, src);
+    stream.close();
+    return result;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Utility/Memory/Blob.h"
+
+struct FactionTable;
+struct MapStats;
+struct MonsterStats;
+struct SpellStats;
+struct StorylineText;
+
+/**
+ * Source text files for the tables stored in the text table cache. Cache is keyed by the hashes of these.
+ */
+struct TextTableSources {
+    Blob mapStats; // MapStats.txt
+    Blob monsters; // monsters.txt
+    Blob placements; // placemon.txt
+    Blob spells; // spells.txt
+    Blob factions; // hostile.txt
+    Blob history; // history.txt
+};
+
+/**
+ * Tables stored in the text table cache.
+ */
+struct TextTables {
+    MapStats *mapStats = nullptr;
+    MonsterStats *monsterStats = nullptr;
+    SpellStats *spellStats = nullptr;
+    FactionTable *factionTable = nullptr;
+    StorylineText *storylineText = nullptr;
+};
+
+/**
+ * Loads parsed text tables from a binary cache that was previously written by `saveTextTableCache`.
+ *
+ * Cache is only used if it was written by the same build of OpenEnroth, and from the same source files. Tables are
+ * left untouched if the cache couldn't be used.
+ *
+ * @param cache                         Contents of the cache file. Can be empty, or can contain garbage.
+ * @param sources                       Source text files for the tables.
+ * @param dst                           Tables to load into.
+ * @return                              Whether the tables were loaded.
+ */
+[[nodiscard]] bool loadTextTableCache(const Blob &cache, const TextTableSources &sources, const TextTables &dst);
+
+/**
+ * @param sources                       Source text files that the tables were parsed from.
+ * @param src                           Parsed tables.
+ * @return                              Cache blob that can later be passed to `loadTextTableCache`.
+ */
+[[nodiscard]] Blob saveTextTableCache(const TextTableSources &sources, const TextTables &src);
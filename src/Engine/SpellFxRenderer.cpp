@@ -153,6 +153,7 @@ void SpellFX_Billboard::_47829F_sphere_particle(
     // 128 triangles using 66 diff verts
 
 
+    render->BeginBillboardBatch();
     for (unsigned int i = 0; i < uNumVec3sInArray2; ++i) {  // indicies for triangle in sphere
         // for (unsigned int j = 0; j < 3; ++j) {
         //    field_14[j].x =
@@ -198,6 +199,7 @@ void SpellFX_Billboard::_47829F_sphere_particle(
             if (SpellFXProject()) render->BillboardSphereSpellFX(this, diffuse);
         }
     }
+    render->EndBillboardBatch();
 }
 
 //----- (004A71FE) --------------------------------------------------------
@@ -421,9 +423,9 @@ void SpellFxRenderer::_4A7948_mind_blast_after_effect(SpriteObject *a1) {
 }
 
 //----- (004A7A27) --------------------------------------------------------
-bool SpellFxRenderer::AddMobileLight(SpriteObject *a1, Color uDiffuse,
+void SpellFxRenderer::AddMobileLight(SpriteObject *a1, Color uDiffuse,
                                      int uRadius) {
-    return pMobileLightsStack->AddLight(a1->vPosition.toFloat(), a1->uSectorID,
+    pMobileLightsStack->AddLight(a1->vPosition.toFloat(), a1->uSectorID,
         uRadius, uDiffuse, _4E94D3_light_type);
 }
 
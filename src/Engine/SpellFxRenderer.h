@@ -122,7 +122,7 @@ struct SpellFxRenderer {
     void _4A7688_fireball_collision_particle(struct SpriteObject *a2);
     void _4A77FD_implosion_particle_d3d(struct SpriteObject *a1);
     void _4A7948_mind_blast_after_effect(struct SpriteObject *a1);
-    bool AddMobileLight(struct SpriteObject *a1, Color uDiffuse,
+    void AddMobileLight(struct SpriteObject *a1, Color uDiffuse,
                         int uRadius);
     void
     _4A7A66_miltiple_spell_collision_partifles___like_after_sparks_or_lightning(
@@ -71,6 +71,63 @@ static void initSpellSprite(SpriteObject *spritePtr,
     spritePtr->uSoundID = pCastSpell->overrideSoundId;
 }
 
+/**
+ * Launches a batch of projectiles falling from the sky onto the target, used for meteor shower & starburst.
+ *
+ * @param spritePtr                     Spell sprite to use as a template, `uType` must be set.
+ * @param spellLevel                    Spell level.
+ * @param spellMastery                  Spell mastery.
+ * @param pCastSpell                    Spell that's being cast.
+ * @param target                        Spell target. If it's not an actor, the projectiles are aimed in front of
+ *                                      the party.
+ * @param count                         Number of projectiles to launch.
+ */
+static void launchProjectileShower(SpriteObject *spritePtr,
+                                   int spellLevel,
+                                   CharacterSkillMastery spellMastery,
+                                   CastSpellInfo *pCastSpell,
+                                   Pid target,
+                                   int count) {
+    ObjectType obj_type = target.type();
+    Vec3i dist;
+    if (obj_type == OBJECT_Actor) {  // quick cast can specify target
+        dist = pActors[target.id()].pos;
+    } else {
+        dist = pParty->pos.toInt() + Vec3i(2048 * pCamera3D->_yawRotationCosine, 2048 * pCamera3D->_yawRotationSine, 0);
+    }
+
+    ReserveSpriteObjects(count);
+
+    int j = 0, k = 0;
+    int yaw, pitch;
+    for (; count; count--) {
+        int originHeight = grng->random(1000);
+        // TODO(Nik-RE-dev): condition is always false
+        if (Vec3f(j, k, originHeight - 2500).length() <= 1.0f) {
+            pitch = 0;
+            yaw = 0;
+        } else {
+            pitch = TrigLUT.atan2(std::sqrt(j * j + k * k), originHeight - 2500);
+            yaw = TrigLUT.atan2(j, k);
+        }
+        initSpellSprite(spritePtr, spellLevel, spellMastery, pCastSpell);
+        spritePtr->vPosition = dist + Vec3i(0, 0, originHeight + 2500);
+        spritePtr->spell_target_pid = (obj_type == OBJECT_Actor) ? target : Pid();
+        spritePtr->field_60_distance_related_prolly_lod = stru_50C198._427546(originHeight + 2500);
+        spritePtr->uFacing = yaw;
+        if (pParty->bTurnBasedModeOn) {
+            spritePtr->uAttributes |= SPRITE_HALT_TURN_BASED;
+        }
+        int spell_speed = pObjectList->pObjects[spritePtr->uObjectDescID].uSpeed;
+        if (spritePtr->Create(yaw, pitch, spell_speed, 0) != -1 &&
+                pParty->bTurnBasedModeOn) {
+            ++pTurnEngine->pending_actions;
+        }
+        j = grng->random(1024) - 512;
+        k = grng->random(1024) - 512;
+    }
+}
+
 /**
  * Notify that spell casting failed.
  */
@@ -979,42 +1036,8 @@ void CastSpellInfoHelpers::castSpell() {
                         continue;
                     }
 
-                    ObjectType obj_type = spell_targeted_at.type();
-                    Vec3i dist;
-                    if (obj_type == OBJECT_Actor) {  // quick cast can specify target
-                        dist = pActors[spell_targeted_at.id()].pos;
-                    } else {
-                        dist = pParty->pos.toInt() + Vec3i(2048 * pCamera3D->_yawRotationCosine, 2048 * pCamera3D->_yawRotationSine, 0);
-                    }
-                    int j = 0, k = 0;
-                    int yaw, pitch;
                     int meteor_num = (spell_mastery == CHARACTER_SKILL_MASTERY_GRANDMASTER) ? 20 : 16;
-                    for (; meteor_num; meteor_num--) {
-                        int originHeight = grng->random(1000);
-                        // TODO(Nik-RE-dev): condition is always false
-                        if (Vec3f(j, k, originHeight - 2500).length() <= 1.0f) {
-                            pitch = 0;
-                            yaw = 0;
-                        } else {
-                            pitch = TrigLUT.atan2(std::sqrt(j * j + k * k), originHeight - 2500);
-                            yaw = TrigLUT.atan2(j, k);
-                        }
-                        initSpellSprite(&pSpellSprite, spell_level, spell_mastery, pCastSpell);
-                        pSpellSprite.vPosition = dist + Vec3i(0, 0, originHeight + 2500);
-                        pSpellSprite.spell_target_pid = (obj_type == OBJECT_Actor) ? spell_targeted_at : Pid();
-                        pSpellSprite.field_60_distance_related_prolly_lod = stru_50C198._427546(originHeight + 2500);
-                        pSpellSprite.uFacing = yaw;
-                        if (pParty->bTurnBasedModeOn) {
-                            pSpellSprite.uAttributes |= SPRITE_HALT_TURN_BASED;
-                        }
-                        int spell_speed = pObjectList->pObjects[pSpellSprite.uObjectDescID].uSpeed;
-                        if (pSpellSprite.Create(yaw, pitch, spell_speed, 0) != -1 &&
-                                pParty->bTurnBasedModeOn) {
-                            ++pTurnEngine->pending_actions;
-                        }
-                        j = grng->random(1024) - 512;
-                        k = grng->random(1024) - 512;
-                    }
+                    launchProjectileShower(&pSpellSprite, spell_level, spell_mastery, pCastSpell, spell_targeted_at, meteor_num);
                     break;
                 }
 
@@ -1026,7 +1049,9 @@ void CastSpellInfoHelpers::castSpell() {
                         continue;
                     }
                     initSpellSprite(&pSpellSprite, spell_level, spell_mastery, pCastSpell);
-                    for (Actor *actor : render->getActorsInViewport(4096)) {
+                    std::vector<Actor *> actorsInViewport = render->getActorsInViewport(4096);
+                    ReserveSpriteObjects(actorsInViewport.size());
+                    for (Actor *actor : actorsInViewport) {
                         Vec3i spell_velocity = Vec3i(0, 0, 0);
                         pSpellSprite.vPosition = actor->pos - Vec3i(0, 0, actor->height * -0.8);
                         pSpellSprite.spell_target_pid = Pid(OBJECT_Actor, actor->id);
@@ -1098,6 +1123,7 @@ void CastSpellInfoHelpers::castSpell() {
                     }
                     int spell_spray_angle_start = ONE_THIRD_PI / -2;
                     int spell_spray_angle_end = ONE_THIRD_PI / 2;
+                    ReserveSpriteObjects(sparks_number);
                     while (spell_spray_angle_start <= spell_spray_angle_end) {
                         pSpellSprite.timeSinceCreated = Duration::randomRealtimeMilliseconds(grng, 500);
                         pSpellSprite.uFacing = spell_spray_angle_start + (short)target_direction.uYawAngle;
@@ -1183,41 +1209,7 @@ void CastSpellInfoHelpers::castSpell() {
                         continue;
                     }
 
-                    ObjectType obj_type = spell_targeted_at.type();
-                    Vec3i dist;
-                    if (obj_type == OBJECT_Actor) {  // quick cast can specify target
-                        dist = pActors[spell_targeted_at.id()].pos;
-                    } else {
-                        dist = pParty->pos.toInt() + Vec3i(2048 * pCamera3D->_yawRotationCosine, 2048 * pCamera3D->_yawRotationSine, 0);
-                    }
-                    int j = 0, k = 0;
-                    int yaw, pitch;
-                    for (int star_num = 20; star_num; star_num--) {
-                        int originHeight = grng->random(1000);
-                        // TODO(Nik-RE-dev): condition is always false
-                        if (Vec3f(j, k, originHeight - 2500).length() <= 1.0f) {
-                            pitch = 0;
-                            yaw = 0;
-                        } else {
-                            pitch = TrigLUT.atan2(std::sqrt(j * j + k * k), originHeight - 2500);
-                            yaw = TrigLUT.atan2(j, k);
-                        }
-                        initSpellSprite(&pSpellSprite, spell_level, spell_mastery, pCastSpell);
-                        pSpellSprite.vPosition = dist + Vec3i(0, 0, originHeight + 2500);
-                        pSpellSprite.spell_target_pid = (obj_type == OBJECT_Actor) ? spell_targeted_at : Pid();
-                        pSpellSprite.field_60_distance_related_prolly_lod = stru_50C198._427546(originHeight + 2500);
-                        pSpellSprite.uFacing = yaw;
-                        if (pParty->bTurnBasedModeOn) {
-                            pSpellSprite.uAttributes |= SPRITE_HALT_TURN_BASED;
-                        }
-                        int spell_speed = pObjectList->pObjects[pSpellSprite.uObjectDescID].uSpeed;
-                        if (pSpellSprite.Create(yaw, pitch, spell_speed, 0) != -1 &&
-                                pParty->bTurnBasedModeOn) {
-                            ++pTurnEngine->pending_actions;
-                        }
-                        j = grng->random(1024) - 512;
-                        k = grng->random(1024) - 512;
-                    }
+                    launchProjectileShower(&pSpellSprite, spell_level, spell_mastery, pCastSpell, spell_targeted_at, 20);
                     break;
                 }
 
@@ -1764,7 +1756,9 @@ void CastSpellInfoHelpers::castSpell() {
                     // ++pSpellSprite.uType;
                     pSpellSprite.uType = SPRITE_SPELL_SPIRIT_TURN_UNDEAD_1;
                     initSpellSprite(&pSpellSprite, spell_level, spell_mastery, pCastSpell);
-                    for (Actor *actor : render->getActorsInViewport(4096)) {
+                    std::vector<Actor *> actorsInViewport = render->getActorsInViewport(4096);
+                    ReserveSpriteObjects(actorsInViewport.size());
+                    for (Actor *actor : actorsInViewport) {
                         if (supertypeForMonsterId(actor->monsterInfo.id) == MONSTER_SUPERTYPE_UNDEAD) {
                             pSpellSprite.vPosition = actor->pos - Vec3i(0, 0, actor->height * -0.8);
                             pSpellSprite.spell_target_pid = Pid(OBJECT_Actor, actor->id);
@@ -2116,7 +2110,9 @@ void CastSpellInfoHelpers::castSpell() {
                     // ++pSpellSprite.uType;
                     pSpellSprite.uType = SPRITE_SPELL_MIND_MASS_FEAR_1;
                     initSpellSprite(&pSpellSprite, spell_level, spell_mastery, pCastSpell);
-                    for (Actor *actor : render->getActorsInViewport(4096)) {
+                    std::vector<Actor *> actorsInViewport = render->getActorsInViewport(4096);
+                    ReserveSpriteObjects(actorsInViewport.size());
+                    for (Actor *actor : actorsInViewport) {
                         // Change: do not exit loop when first undead monster is found
                         if (supertypeForMonsterId(actor->monsterInfo.id) != MONSTER_SUPERTYPE_UNDEAD) {
                             pSpellSprite.vPosition = actor->pos - Vec3i(0, 0, actor->height * -0.8);
@@ -2407,7 +2403,9 @@ void CastSpellInfoHelpers::castSpell() {
                     initSpellSprite(&pSpellSprite, spell_level, spell_mastery, pCastSpell);
                     Vec3i spell_velocity = Vec3i(0, 0, 0);
                     // Spell damage processing was removed because Dispel Magic does not do damage
-                    for (Actor *actor : render->getActorsInViewport(4096)) {
+                    std::vector<Actor *> actorsInViewport = render->getActorsInViewport(4096);
+                    ReserveSpriteObjects(actorsInViewport.size());
+                    for (Actor *actor : actorsInViewport) {
                         pSpellSprite.vPosition = actor->pos - Vec3i(0, 0, actor->height * -0.8);
                         pSpellSprite.spell_target_pid = Pid(OBJECT_Actor, actor->id);
                         pSpellSprite.Create(0, 0, 0, 0);
@@ -2498,7 +2496,9 @@ void CastSpellInfoHelpers::castSpell() {
                     pSpellSprite.uType = SPRITE_SPELL_LIGHT_PRISMATIC_LIGHT_1;
                     initSpellSprite(&pSpellSprite, spell_level, spell_mastery, pCastSpell);
                     Vec3i spell_velocity = Vec3i(0, 0, 0);
-                    for (Actor *actor : render->getActorsInViewport(4096)) {
+                    std::vector<Actor *> actorsInViewport = render->getActorsInViewport(4096);
+                    ReserveSpriteObjects(actorsInViewport.size());
+                    for (Actor *actor : actorsInViewport) {
                         pSpellSprite.vPosition = actor->pos - Vec3i(0, 0, actor->height * -0.8);
                         pSpellSprite.spell_target_pid = Pid(OBJECT_Actor, actor->id);
                         Actor::DamageMonsterFromParty(Pid(OBJECT_Item, pSpellSprite.Create(0, 0, 0, 0)), actor->id, &spell_velocity);
@@ -2857,6 +2857,7 @@ void CastSpellInfoHelpers::castSpell() {
                     initSpellSprite(&pSpellSprite, spell_level, spell_mastery, pCastSpell);
                     Vec3i spell_velocity = Vec3i(0, 0, 0);
                     std::vector<Actor*> actorsInViewport = render->getActorsInViewport(pCamera3D->GetMouseInfoDepth());
+                    ReserveSpriteObjects(actorsInViewport.size());
                     for (Actor *actor : actorsInViewport) {
                         pSpellSprite.vPosition = actor->pos - Vec3i(0, 0, actor->height * -0.8);
                         pSpellSprite.spell_target_pid = Pid(OBJECT_Actor, actor->id);
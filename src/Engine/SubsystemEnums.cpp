@@ -0,0 +1,11 @@
+#include "SubsystemEnums.h"
+
+#include "Library/Serialization/EnumSerialization.h"
+
+MM_DEFINE_ENUM_SERIALIZATION_FUNCTIONS(EngineSubsystem, CASE_INSENSITIVE, {
+    {SUBSYSTEM_EVENTS,      "events"},
+    {SUBSYSTEM_AI,          "ai"},
+    {SUBSYSTEM_WORLD,       "world"},
+    {SUBSYSTEM_COLLISIONS,  "collisions"},
+    {SUBSYSTEM_DRAW,        "draw"}
+})
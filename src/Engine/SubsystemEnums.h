@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Library/Serialization/SerializationFwd.h"
+
+/**
+ * Game loop subsystems that `SubsystemTimers` can report CPU timings for.
+ */
+enum class EngineSubsystem {
+    SUBSYSTEM_EVENTS,       // Processing of the queued UI messages & the events they trigger.
+    SUBSYSTEM_AI,           // Actor AI.
+    SUBSYSTEM_WORLD,        // Sprite object, party & actor movement, includes collisions.
+    SUBSYSTEM_COLLISIONS,   // Actor & party collisions. Overlaps with `SUBSYSTEM_WORLD`.
+    SUBSYSTEM_DRAW,         // Drawing the frame, includes render prep.
+
+    SUBSYSTEM_FIRST = SUBSYSTEM_EVENTS,
+    SUBSYSTEM_LAST = SUBSYSTEM_DRAW
+};
+using enum EngineSubsystem;
+MM_DECLARE_SERIALIZATION_FUNCTIONS(EngineSubsystem)
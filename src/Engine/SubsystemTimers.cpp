@@ -0,0 +1,13 @@
+#include "SubsystemTimers.h"
+
+SubsystemTimers *subsystemTimers = nullptr;
+
+SubsystemTimerScope::SubsystemTimerScope(EngineSubsystem subsystem) : _subsystem(subsystem) {
+    if (subsystemTimers)
+        _start = std::chrono::steady_clock::now();
+}
+
+SubsystemTimerScope::~SubsystemTimerScope() {
+    if (subsystemTimers)
+        subsystemTimers->add(_subsystem, std::chrono::steady_clock::now() - _start);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "Utility/IndexedArray.h"
+
+#include "SubsystemEnums.h"
+
+/**
+ * CPU timers for the game loop subsystems - AI, collisions, event processing, etc.
+ *
+ * Same as with `RenderPrepTimers`, the timings are only collected if `subsystemTimers` is set, which is done for the
+ * game test benchmark runs.
+ */
+class SubsystemTimers {
+ public:
+    using Duration = std::chrono::steady_clock::duration;
+    using Timings = IndexedArray<Duration, SUBSYSTEM_FIRST, SUBSYSTEM_LAST>;
+
+    SubsystemTimers() = default;
+
+    void add(EngineSubsystem subsystem, Duration duration) {
+        _totals[subsystem] += duration;
+    }
+
+    /**
+     * Marks the end of a game loop iteration.
+     */
+    void nextFrame() {
+        _frameCount++;
+    }
+
+    [[nodiscard]] int64_t frameCount() const {
+        return _frameCount;
+    }
+
+    /**
+     * @return                          Total time spent in each of the subsystems since the timers were created.
+     */
+    [[nodiscard]] const Timings &totals() const {
+        return _totals;
+    }
+
+ private:
+    Timings _totals = {{}};
+    int64_t _frameCount = 0;
+};
+
+class SubsystemTimerScope {
+ public:
+    explicit SubsystemTimerScope(EngineSubsystem subsystem);
+    ~SubsystemTimerScope();
+
+    SubsystemTimerScope(const SubsystemTimerScope &) = delete;
+    SubsystemTimerScope &operator=(const SubsystemTimerScope &) = delete;
+
+ private:
+    EngineSubsystem _subsystem;
+    std::chrono::steady_clock::time_point _start;
+};
+
+extern SubsystemTimers *subsystemTimers;
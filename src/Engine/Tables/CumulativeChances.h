@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+/**
+ * Precomputed cumulative chances for picking a weighted random value out of a fixed list.
+ *
+ * Item generation code used to walk the item & enchantment tables summing up chances for every roll. This class
+ * stores the inclusive prefix sums instead, so that each pick is a binary search. Lookups return exactly what the
+ * linear walks returned for the same roll, so the random draws and their results stay the same.
+ *
+ * @tparam T                            Type of the values to pick from.
+ */
+template<class T>
+class CumulativeChances {
+ public:
+    /**
+     * @param value                     Value to add.
+     * @param chance                    Chance of the value, values with zero chance are skipped.
+     */
+    void add(T value, int chance) {
+        assert(chance >= 0);
+        if (chance == 0)
+            return;
+
+        _values.push_back(value);
+        _sums.push_back(total() + chance);
+    }
+
+    [[nodiscard]] bool empty() const {
+        return _values.empty();
+    }
+
+    /**
+     * @return                          Sum of the chances of all the values.
+     */
+    [[nodiscard]] int total() const {
+        return _sums.empty() ? 0 : _sums.back();
+    }
+
+    /**
+     * @param roll                      Roll in `[1, total()]`.
+     * @return                          First value for which the running sum of chances is at least `roll`.
+     */
+    [[nodiscard]] T atLeast(int roll) const {
+        assert(roll >= 1 && roll <= total());
+        return _values[std::ranges::lower_bound(_sums, roll) - _sums.begin()];
+    }
+
+    /**
+     * @param roll                      Roll in `[0, total())`.
+     * @return                          First value for which the running sum of chances is greater than `roll`.
+     */
+    [[nodiscard]] T above(int roll) const {
+        assert(roll >= 0 && roll < total());
+        return _values[std::ranges::upper_bound(_sums, roll) - _sums.begin()];
+    }
+
+ private:
+    std::vector<T> _values;
+    std::vector<int> _sums; // Inclusive prefix sums of the chances.
+};
@@ -17,21 +17,31 @@ Icon *IconFrameTable::GetIcon(unsigned int idx) {
     return nullptr;
 }
 
-Icon *IconFrameTable::GetIcon(const char *pIconName) {
-    for (unsigned int i = 0; i < pIcons.size(); i++) {
-        if (iequals(pIconName, this->pIcons[i].GetAnimationName()))
-            return &this->pIcons[i];
-    }
-    return nullptr;
+Icon *IconFrameTable::GetIcon(std::string_view pIconName) {
+    int index = findIndex(pIconName);
+    return index < 0 ? nullptr : &this->pIcons[index];
 }
 
 //----- (00494F3A) --------------------------------------------------------
-unsigned int IconFrameTable::FindIcon(const std::string &pIconName) {
-    for (size_t i = 0; i < pIcons.size(); i++) {
-        if (iequals(pIconName, this->pIcons[i].GetAnimationName()))
-            return i;
-    }
-    return 0;
+unsigned int IconFrameTable::FindIcon(std::string_view pIconName) {
+    int index = findIndex(pIconName);
+    return index < 0 ? 0 : index;
+}
+
+void IconFrameTable::buildNameIndex() {
+    _indexByName.clear();
+    _indexByName.reserve(pIcons.size());
+    for (size_t i = 0; i < pIcons.size(); i++)
+        _indexByName.try_emplace(pIcons[i].GetAnimationName(), i);
+    _indexedSize = pIcons.size();
+}
+
+int IconFrameTable::findIndex(std::string_view name) {
+    if (_indexedSize != pIcons.size())
+        buildNameIndex();
+
+    auto pos = _indexByName.find(name);
+    return pos == _indexByName.end() ? -1 : static_cast<int>(pos->second);
 }
 
 //----- (00494F70) --------------------------------------------------------
@@ -4,11 +4,14 @@
 #include <cstring>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "Engine/Time/Duration.h"
 
 #include "Utility/Memory/Blob.h"
+#include "Utility/String.h"
 
 class GraphicsImage;
 
@@ -46,11 +49,25 @@ class Icon {
 
 struct IconFrameTable {
     Icon *GetIcon(unsigned int idx);
-    Icon *GetIcon(const char *pIconName);
-    unsigned int FindIcon(const std::string &pIconName);
+    Icon *GetIcon(std::string_view pIconName);
+    unsigned int FindIcon(std::string_view pIconName);
     Icon *GetFrame(unsigned int uIconID, Duration frame_time);
 
+    /**
+     * Rebuilds the name index used by `GetIcon` & `FindIcon`. Called after the table is loaded, and also lazily if
+     * the size of `pIcons` has changed since.
+     */
+    void buildNameIndex();
+
     std::vector<Icon> pIcons;
+
+ private:
+    /** Index of the first icon with the given animation name. */
+    [[nodiscard]] int findIndex(std::string_view name);
+
+ private:
+    size_t _indexedSize = 0;
+    std::unordered_map<std::string, unsigned int, IHash, IEqual> _indexByName;
 };
 
 class UIAnimation {
@@ -258,6 +258,8 @@ void ItemTable::Initialize(GameResourceManager *resourceManager) {
     ItemGen::PopulateSpecialBonusMap();
     ItemGen::PopulateArtifactBonusMap();
     ItemGen::PopulateRegularBonusMap();
+
+    initializeRandomChances();
 }
 
 //----- (00456D17) --------------------------------------------------------
@@ -365,148 +367,169 @@ void ItemTable::LoadPotionNotes(const Blob &potionNotes) {
     }
 }
 
+static CumulativeChances<ItemId> buildRandomItemChances(const ItemTable &table, RandomItemType uTreasureType,
+                                                        ItemTreasureLevel treasure_level) {
+    ItemType requested_equip;
+    CharacterSkillType requested_skill = CHARACTER_SKILL_INVALID;
+    switch (uTreasureType) {
+        case RANDOM_ITEM_WEAPON:
+            requested_equip = ITEM_TYPE_SINGLE_HANDED;
+            break;
+        case RANDOM_ITEM_ARMOR:
+            requested_equip = ITEM_TYPE_ARMOUR;
+            break;
+        case RANDOM_ITEM_MICS:
+            requested_skill = CHARACTER_SKILL_MISC;
+            break;
+        case RANDOM_ITEM_SWORD:
+            requested_skill = CHARACTER_SKILL_SWORD;
+            break;
+        case RANDOM_ITEM_DAGGER:
+            requested_skill = CHARACTER_SKILL_DAGGER;
+            break;
+        case RANDOM_ITEM_AXE:
+            requested_skill = CHARACTER_SKILL_AXE;
+            break;
+        case RANDOM_ITEM_SPEAR:
+            requested_skill = CHARACTER_SKILL_SPEAR;
+            break;
+        case RANDOM_ITEM_BOW:
+            requested_skill = CHARACTER_SKILL_BOW;
+            break;
+        case RANDOM_ITEM_MACE:
+            requested_skill = CHARACTER_SKILL_MACE;
+            break;
+        case RANDOM_ITEM_CLUB:
+            requested_skill = CHARACTER_SKILL_CLUB;
+            break;
+        case RANDOM_ITEM_STAFF:
+            requested_skill = CHARACTER_SKILL_STAFF;
+            break;
+        case RANDOM_ITEM_LEATHER_ARMOR:
+            requested_skill = CHARACTER_SKILL_LEATHER;
+            break;
+        case RANDOM_ITEM_CHAIN_ARMOR:
+            requested_skill = CHARACTER_SKILL_CHAIN;
+            break;
+        case RANDOM_ITEM_PLATE_ARMOR:
+            requested_skill = CHARACTER_SKILL_PLATE;
+            break;
+        case RANDOM_ITEM_SHIELD:
+            requested_equip = ITEM_TYPE_SHIELD;
+            break;
+        case RANDOM_ITEM_HELMET:
+            requested_equip = ITEM_TYPE_HELMET;
+            break;
+        case RANDOM_ITEM_BELT:
+            requested_equip = ITEM_TYPE_BELT;
+            break;
+        case RANDOM_ITEM_CLOAK:
+            requested_equip = ITEM_TYPE_CLOAK;
+            break;
+        case RANDOM_ITEM_GAUNTLETS:
+            requested_equip = ITEM_TYPE_GAUNTLETS;
+            break;
+        case RANDOM_ITEM_BOOTS:
+            requested_equip = ITEM_TYPE_BOOTS;
+            break;
+        case RANDOM_ITEM_RING:
+            requested_equip = ITEM_TYPE_RING;
+            break;
+        case RANDOM_ITEM_AMULET:
+            requested_equip = ITEM_TYPE_AMULET;
+            break;
+        case RANDOM_ITEM_WAND:
+            requested_equip = ITEM_TYPE_WAND;
+            break;
+        case RANDOM_ITEM_SPELL_SCROLL:
+            requested_equip = ITEM_TYPE_SPELL_SCROLL;
+            break;
+        case RANDOM_ITEM_POTION:
+            requested_equip = ITEM_TYPE_POTION;
+            break;
+        case RANDOM_ITEM_REAGENT:
+            requested_equip = ITEM_TYPE_REAGENT;
+            break;
+        case RANDOM_ITEM_GEM:
+            requested_equip = ITEM_TYPE_GEM;
+            break;
+        default:
+            assert(false);  // check this condition
+            // TODO(captainurist): explore
+            requested_equip = static_cast<ItemType>(std::to_underlying(uTreasureType) - 1);
+            break;
+    }
+
+    CumulativeChances<ItemId> result;
+    for (ItemId i : allSpawnableItems()) {
+        if (requested_skill == CHARACTER_SKILL_INVALID ? table.pItems[i].uEquipType == requested_equip :
+                                                         table.pItems[i].uSkillType == requested_skill)
+            result.add(i, table.pItems[i].uChanceByTreasureLvl[treasure_level]);
+    }
+    return result;
+}
+
+static bool isSpecialEnchantmentAvailable(const ItemSpecialEnchantmentTable &enchantment,
+                                          ItemTreasureLevel treasure_level) {
+    int tr_lv = (enchantment.iTreasureLevel) & 3;
+
+    // tr_lv  0 = treasure level 3/4
+    // tr_lv  1 = treasure level 3/4/5
+    // tr_lv  2 = treasure level 4/5
+    // tr_lv  3 = treasure level 5/6
+
+    return (treasure_level == ITEM_TREASURE_LEVEL_3) && (tr_lv == 1 || tr_lv == 0) ||
+           (treasure_level == ITEM_TREASURE_LEVEL_4) && (tr_lv == 2 || tr_lv == 1 || tr_lv == 0) ||
+           (treasure_level == ITEM_TREASURE_LEVEL_5) && (tr_lv == 3 || tr_lv == 2 || tr_lv == 1) ||
+           (treasure_level == ITEM_TREASURE_LEVEL_6) && (tr_lv == 3);
+}
+
+void ItemTable::initializeRandomChances() {
+    for (ItemTreasureLevel level : anyItemChances.indices()) {
+        anyItemChances[level] = {};
+        for (ItemId i : pItems.indices())
+            anyItemChances[level].add(i, pItems[i].uChanceByTreasureLvl[level]);
+    }
+
+    for (RandomItemType type : randomItemChances.indices())
+        for (ItemTreasureLevel level : randomItemChances[type].indices())
+            randomItemChances[type][level] = buildRandomItemChances(*this, type, level);
+
+    for (ItemType type : standardEnchantmentChances.indices()) {
+        standardEnchantmentChances[type] = {};
+        for (CharacterAttributeType attr : allEnchantableAttributes())
+            standardEnchantmentChances[type].add(attr, standardEnchantments[attr].chancesByItemType[type]);
+    }
+
+    for (ItemType type : specialEnchantmentChances.indices()) {
+        for (ItemTreasureLevel level : specialEnchantmentChances[type].indices()) {
+            specialEnchantmentChances[type][level] = {};
+            for (ItemEnchantment i : pSpecialEnchantments.indices())
+                if (isSpecialEnchantmentAvailable(pSpecialEnchantments[i], level))
+                    specialEnchantmentChances[type][level].add(i, pSpecialEnchantments[i].to_item_apply[type]);
+        }
+    }
+}
+
 void ItemTable::generateItem(ItemTreasureLevel treasure_level, RandomItemType uTreasureType, ItemGen *outItem) {
     assert(isRandomTreasureLevel(treasure_level));
 
-    int current_chance;           // ebx@43
-    int tmp_chance;               // ecx@47
     ItemId artifactRandomId;       // ebx@57
-    int v18;                      // edx@62
-    //    unsigned int v34; // eax@97
-    int j;              // eax@121
-    std::array<ItemId, 800> spawnableRequestedItems;  // [sp+Ch] [bp-C88h]@33
-    std::array<ItemEnchantment, 800> possibleSpecialIds;
-    int total_chance;   // [sp+C8Ch] [bp-8h]@33
-    int v57;            // [sp+CA0h] [bp+Ch]@62
 
     if (!outItem) outItem = (ItemGen*)malloc(sizeof(ItemGen));
     memset(outItem, 0, sizeof(*outItem));
 
     if (uTreasureType != RANDOM_ITEM_ANY) {  // generate known treasure type
-        ItemType requested_equip;
-        CharacterSkillType requested_skill = CHARACTER_SKILL_INVALID;
-        switch (uTreasureType) {
-            case RANDOM_ITEM_WEAPON:
-                requested_equip = ITEM_TYPE_SINGLE_HANDED;
-                break;
-            case RANDOM_ITEM_ARMOR:
-                requested_equip = ITEM_TYPE_ARMOUR;
-                break;
-            case RANDOM_ITEM_MICS:
-                requested_skill = CHARACTER_SKILL_MISC;
-                break;
-            case RANDOM_ITEM_SWORD:
-                requested_skill = CHARACTER_SKILL_SWORD;
-                break;
-            case RANDOM_ITEM_DAGGER:
-                requested_skill = CHARACTER_SKILL_DAGGER;
-                break;
-            case RANDOM_ITEM_AXE:
-                requested_skill = CHARACTER_SKILL_AXE;
-                break;
-            case RANDOM_ITEM_SPEAR:
-                requested_skill = CHARACTER_SKILL_SPEAR;
-                break;
-            case RANDOM_ITEM_BOW:
-                requested_skill = CHARACTER_SKILL_BOW;
-                break;
-            case RANDOM_ITEM_MACE:
-                requested_skill = CHARACTER_SKILL_MACE;
-                break;
-            case RANDOM_ITEM_CLUB:
-                requested_skill = CHARACTER_SKILL_CLUB;
-                break;
-            case RANDOM_ITEM_STAFF:
-                requested_skill = CHARACTER_SKILL_STAFF;
-                break;
-            case RANDOM_ITEM_LEATHER_ARMOR:
-                requested_skill = CHARACTER_SKILL_LEATHER;
-                break;
-            case RANDOM_ITEM_CHAIN_ARMOR:
-                requested_skill = CHARACTER_SKILL_CHAIN;
-                break;
-            case RANDOM_ITEM_PLATE_ARMOR:
-                requested_skill = CHARACTER_SKILL_PLATE;
-                break;
-            case RANDOM_ITEM_SHIELD:
-                requested_equip = ITEM_TYPE_SHIELD;
-                break;
-            case RANDOM_ITEM_HELMET:
-                requested_equip = ITEM_TYPE_HELMET;
-                break;
-            case RANDOM_ITEM_BELT:
-                requested_equip = ITEM_TYPE_BELT;
-                break;
-            case RANDOM_ITEM_CLOAK:
-                requested_equip = ITEM_TYPE_CLOAK;
-                break;
-            case RANDOM_ITEM_GAUNTLETS:
-                requested_equip = ITEM_TYPE_GAUNTLETS;
-                break;
-            case RANDOM_ITEM_BOOTS:
-                requested_equip = ITEM_TYPE_BOOTS;
-                break;
-            case RANDOM_ITEM_RING:
-                requested_equip = ITEM_TYPE_RING;
-                break;
-            case RANDOM_ITEM_AMULET:
-                requested_equip = ITEM_TYPE_AMULET;
-                break;
-            case RANDOM_ITEM_WAND:
-                requested_equip = ITEM_TYPE_WAND;
-                break;
-            case RANDOM_ITEM_SPELL_SCROLL:
-                requested_equip = ITEM_TYPE_SPELL_SCROLL;
-                break;
-            case RANDOM_ITEM_POTION:
-                requested_equip = ITEM_TYPE_POTION;
-                break;
-            case RANDOM_ITEM_REAGENT:
-                requested_equip = ITEM_TYPE_REAGENT;
-                break;
-            case RANDOM_ITEM_GEM:
-                requested_equip = ITEM_TYPE_GEM;
-                break;
-            default:
-                assert(false);  // check this condition
-                // TODO(captainurist): explore
-                requested_equip = static_cast<ItemType>(std::to_underlying(uTreasureType) - 1);
-                break;
-        }
-        spawnableRequestedItems.fill(ITEM_NULL);
-        total_chance = 0;
-        j = 0;
-        // a2a = 1;
-        if (requested_skill == CHARACTER_SKILL_INVALID) {  // no skill for this item needed
-            for (ItemId i : allSpawnableItems()) {
-                if (pItems[i].uEquipType == requested_equip) {
-                    spawnableRequestedItems[j] = i;
-                    ++j;
-                    total_chance +=
-                            pItems[i].uChanceByTreasureLvl[treasure_level];
-                }
-            }
-        } else {  // have needed skill
-            for (ItemId itemId : allSpawnableItems()) {
-                if (pItems[itemId].uSkillType == requested_skill) {
-                    spawnableRequestedItems[j] = itemId;
-                    ++j;
-                    total_chance +=
-                            pItems[itemId].uChanceByTreasureLvl[treasure_level];
-                }
-            }
+        CumulativeChances<ItemId> fallbackChances;
+        const CumulativeChances<ItemId> *chances = &fallbackChances;
+        if (uTreasureType >= RANDOM_ITEM_FIRST_SPAWNABLE && uTreasureType <= RANDOM_ITEM_LAST_SPAWNABLE) {
+            chances = &randomItemChances[uTreasureType][treasure_level];
+        } else {
+            fallbackChances = buildRandomItemChances(*this, uTreasureType, treasure_level);
         }
 
-        current_chance = 0;
-        if (total_chance) {
-            current_chance = grng->random(total_chance) + 1;
-            tmp_chance = 0;
-            j = 0;
-            while (tmp_chance < current_chance) {
-                outItem->uItemID = spawnableRequestedItems[j];
-                tmp_chance += pItems[spawnableRequestedItems[j]].uChanceByTreasureLvl[treasure_level];
-                ++j;
-            }
+        if (!chances->empty()) {
+            outItem->uItemID = chances->atLeast(grng->random(chances->total()) + 1);
         } else {
             outItem->uItemID = ITEM_CRUDE_LONGSWORD;
         }
@@ -527,13 +550,8 @@ void ItemTable::generateItem(ItemTreasureLevel treasure_level, RandomItemType uT
             }
         }
 
-        v57 = 0;
-        v18 = grng->random(this->chanceByTreasureLevelSums[treasure_level]) + 1;
-        while (v57 < v18) {
-            // TODO(captainurist): what's going on here? Get rid of casts.
-            outItem->uItemID = ItemId(std::to_underlying(outItem->uItemID) + 1);
-            v57 += pItems[outItem->uItemID].uChanceByTreasureLvl[treasure_level];
-        }
+        int roll = grng->random(this->chanceByTreasureLevelSums[treasure_level]) + 1;
+        outItem->uItemID = anyItemChances[treasure_level].atLeast(roll);
     }
     if (outItem->isPotion() && outItem->uItemID != ITEM_POTION_BOTTLE) {  // if it potion set potion spec
         outItem->potionPower = 0;
@@ -575,15 +593,7 @@ void ItemTable::generateItem(ItemTreasureLevel treasure_level, RandomItemType uT
             int bonusChanceRoll = grng->random(100);  // edx@86
             if (bonusChanceRoll < uBonusChanceStandart[treasure_level]) {
                 int enchantmentChanceSumRoll = grng->random(chanceByItemTypeSums[outItem->GetItemEquipType()]) + 1;
-                int currentEnchantmentChancesSum = 0;
-                for (CharacterAttributeType attr : allEnchantableAttributes()) {
-                    if (currentEnchantmentChancesSum >= enchantmentChanceSumRoll)
-                        break;
-
-                    currentEnchantmentChancesSum += standardEnchantments[attr].chancesByItemType[outItem->GetItemEquipType()];
-                    outItem->attributeEnchantment = attr;
-                }
-                assert(outItem->attributeEnchantment);
+                outItem->attributeEnchantment = standardEnchantmentChances[outItem->GetItemEquipType()].atLeast(enchantmentChanceSumRoll);
 
                 outItem->m_enchantmentStrength = bonusRanges[treasure_level].minR +
                                                  grng->random(bonusRanges[treasure_level].maxR - bonusRanges[treasure_level].minR + 1);
@@ -612,37 +622,9 @@ void ItemTable::generateItem(ItemTreasureLevel treasure_level, RandomItemType uT
             return;
     }
 
-    j = 0;
-    int spc_sum = 0;
-    int spc;
-    possibleSpecialIds.fill(ITEM_ENCHANTMENT_NULL);
-    for (ItemEnchantment i : pSpecialEnchantments.indices()) {
-        int tr_lv = (pSpecialEnchantments[i].iTreasureLevel) & 3;
-
-        // tr_lv  0 = treasure level 3/4
-        // tr_lv  1 = treasure level 3/4/5
-        // tr_lv  2 = treasure level 4/5
-        // tr_lv  3 = treasure level 5/6
-
-        if ((treasure_level == ITEM_TREASURE_LEVEL_3) && (tr_lv == 1 || tr_lv == 0) ||
-            (treasure_level == ITEM_TREASURE_LEVEL_4) && (tr_lv == 2 || tr_lv == 1 || tr_lv == 0) ||
-            (treasure_level == ITEM_TREASURE_LEVEL_5) && (tr_lv == 3 || tr_lv == 2 || tr_lv == 1) ||
-            (treasure_level == ITEM_TREASURE_LEVEL_6) && (tr_lv == 3)) {
-            spc = pSpecialEnchantments[i].to_item_apply[outItem->GetItemEquipType()];
-            spc_sum += spc;
-            if (spc) {
-                possibleSpecialIds[j++] = i;
-            }
-        }
-    }
-
-    int target = grng->random(spc_sum);
-    for (int currentSum = 0, k = 0; k < j; k++) {
-        currentSum += pSpecialEnchantments[possibleSpecialIds[k]].to_item_apply[outItem->GetItemEquipType()];
-        if (currentSum > target) {
-            outItem->special_enchantment = possibleSpecialIds[k];
-            return;
-        }
-    }
-    assert(false); // Should never get here.
+    const CumulativeChances<ItemEnchantment> &specialChances = specialEnchantmentChances[outItem->GetItemEquipType()][treasure_level];
+    int target = grng->random(specialChances.total());
+    assert(!specialChances.empty()); // Should never get here with no special enchantments to choose from.
+    if (!specialChances.empty())
+        outItem->special_enchantment = specialChances.above(target);
 }
@@ -4,6 +4,7 @@
 
 #include "Engine/Objects/ItemEnchantment.h"
 #include "Engine/Objects/Items.h"
+#include "Engine/Tables/CumulativeChances.h"
 
 #include "Utility/IndexedArray.h"
 
@@ -28,6 +29,11 @@ struct ItemTable {
     bool IsMaterialSpecial(const ItemGen *pItem);
     bool IsMaterialNonCommon(const ItemGen *pItem);
 
+    /**
+     * Fills in the cumulative chance tables used by `generateItem`. Called from `Initialize`.
+     */
+    void initializeRandomChances();
+
     IndexedArray<ItemDesc, ITEM_FIRST_VALID, ITEM_LAST_VALID> pItems;                   // 4-9604h
     IndexedArray<ItemEnchantmentTable, CHARACTER_ATTRIBUTE_FIRST_ENCHANTABLE, CHARACTER_ATTRIBUTE_LAST_ENCHANTABLE> standardEnchantments;                // 9604h
     IndexedArray<ItemSpecialEnchantmentTable, ITEM_ENCHANTMENT_FIRST_VALID, ITEM_ENCHANTMENT_LAST_VALID> pSpecialEnchantments;  // 97E4h -9FC4h
@@ -51,6 +57,14 @@ struct ItemTable {
     char field_1179D;
     char field_1179E;
     char field_1179F;
+
+    // Precomputed chances for generateItem, see initializeRandomChances.
+    template<class T>
+    using ChancesByTreasureLevel = IndexedArray<CumulativeChances<T>, ITEM_TREASURE_LEVEL_FIRST_RANDOM, ITEM_TREASURE_LEVEL_LAST_RANDOM>;
+    ChancesByTreasureLevel<ItemId> anyItemChances;
+    IndexedArray<ChancesByTreasureLevel<ItemId>, RANDOM_ITEM_FIRST_SPAWNABLE, RANDOM_ITEM_LAST_SPAWNABLE> randomItemChances;
+    IndexedArray<CumulativeChances<CharacterAttributeType>, ITEM_TYPE_FIRST_NORMAL_ENCHANTABLE, ITEM_TYPE_LAST_NORMAL_ENCHANTABLE> standardEnchantmentChances;
+    IndexedArray<ChancesByTreasureLevel<ItemEnchantment>, ITEM_TYPE_FIRST_SPECIAL_ENCHANTABLE, ITEM_TYPE_LAST_SPECIAL_ENCHANTABLE> specialEnchantmentChances;
 };
 
 extern ItemTable *pItemTable;
@@ -1,5 +1,7 @@
 #include "Timer.h"
 
+#include <algorithm>
+
 #include "Engine/EngineGlobals.h"
 
 #include "Io/KeyboardInputHandler.h"
@@ -27,10 +29,44 @@ void Timer::tick() {
     if (_dt > 32_ticks)
         _dt = 32_ticks; // 32 is 250ms
 
+    if (hasFixedStep() && !_paused && !_turnBased) {
+        // Time is advanced in advanceFixedStep. Same cap on how far behind the simulation can fall.
+        _accumulated = std::min(_accumulated + _dt, 32_ticks);
+        _dt = _frameDt = 0_ticks;
+        return;
+    }
+
     if (!_paused && !_turnBased)
         _time += _dt;
 }
 
+void Timer::setFixedStep(Duration step) {
+    _fixedStep = step;
+    _accumulated = _frameDt = 0_ticks;
+}
+
+bool Timer::advanceFixedStep() {
+    if (!hasFixedStep() || _paused || _turnBased)
+        return false; // dt was set in tick.
+
+    if (_accumulated < _fixedStep) {
+        _dt = _frameDt;
+        return false;
+    }
+
+    _accumulated -= _fixedStep;
+    _frameDt += _fixedStep;
+    _dt = _fixedStep;
+    _time += _fixedStep;
+    return true;
+}
+
+float Timer::fixedStepAlpha() const {
+    if (!hasFixedStep())
+        return 0.0f;
+    return std::min(static_cast<float>(_accumulated.ticks()) / _fixedStep.ticks(), 1.0f);
+}
+
 void Timer::setPaused(bool paused) {
     if (_paused == paused)
         return;
@@ -43,8 +43,44 @@ class Timer : private RawTimer {
         return _time;
     }
 
+    /**
+     * Switches the timer into fixed step mode. In this mode `tick` only accumulates the elapsed time, and the game
+     * time is advanced in `advanceFixedStep` calls, one step at a time. Paused & turn-based timers tick as usual.
+     *
+     * @param step                      Step size, zero disables fixed step mode.
+     */
+    void setFixedStep(Duration step);
+
+    Duration fixedStep() const {
+        return _fixedStep;
+    }
+
+    bool hasFixedStep() const {
+        return _fixedStep > 0_ticks;
+    }
+
+    /**
+     * Advances the game time by one fixed step, if enough time has accumulated. While inside a step, `dt` returns
+     * the step size. Once there are no more steps to take, `dt` returns the total time advanced since the last
+     * `tick`, so that the code that runs once per frame still sees the frame's dt.
+     *
+     * @return                          Whether a step was taken.
+     */
+    bool advanceFixedStep();
+
+    /**
+     * @return                          Accumulated time that's not yet simulated, as a fraction of the fixed step,
+     *                                  in [0, 1). Used for interpolating between the last two simulation states.
+     */
+    float fixedStepAlpha() const;
+
  private:
     Duration platformTime();
+
+ private:
+    Duration _fixedStep; // Zero if not in fixed step mode.
+    Duration _accumulated; // Time accumulated since the last fixed step.
+    Duration _frameDt; // Time advanced in fixed steps since the last tick.
 };
 
 // TODO(captainurist): pAnimTimer?
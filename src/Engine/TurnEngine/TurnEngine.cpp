@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <cstdlib>
+#include <tuple>
+#include <unordered_set>
 #include <utility>
 
 #include "Engine/Time/Timer.h"
@@ -10,6 +13,7 @@
 #include "Engine/TurnEngine/TurnEngine.h"
 
 #include "Engine/Objects/Actor.h"
+#include "Engine/Objects/ActorSpatialHash.h"
 #include "Engine/Objects/SpriteObject.h"
 #include "Engine/Objects/MonsterEnumFunctions.h"
 
@@ -25,12 +29,20 @@
 
 struct stru262_TurnBased *pTurnEngine = new stru262_TurnBased;
 
+/**
+ * Turn queue order: less initiative acts first, then characters act before actors, then less id acts first.
+ */
+static bool turnQueueLess(const TurnBased_QueueElem &l, const TurnBased_QueueElem &r) {
+    auto key = [](const TurnBased_QueueElem &elem) {
+        return std::tuple(elem.actor_initiative, elem.uPackedID.type() != OBJECT_Character, elem.uPackedID.id());
+    };
+    return key(l) < key(r);
+}
+
 //----- (00404544) --------------------------------------------------------
 void stru262_TurnBased::SortTurnQueue() {
     int active_actors;
-    TurnBased_QueueElem *current_top;   // eax@16
-    TurnBased_QueueElem *test_element;  // ecx@18
-    int i, j;
+    int i;
     ObjectType p_type;
     unsigned int p_id;
 
@@ -55,26 +67,10 @@ void stru262_TurnBased::SortTurnQueue() {
             }
         }
     }
-    // sort
-    for (i = 0; i + 1 < this->pQueue.size(); ++i) {
-        current_top = &pQueue[i];
-        for (j = i + 1; j < this->pQueue.size(); ++j) {
-            test_element = &pQueue[j];
-            if (test_element->actor_initiative <
-                    current_top
-                        ->actor_initiative ||  // if less initiative -> top
-                ((test_element->actor_initiative ==
-                  current_top->actor_initiative) &&
-                 (((test_element->uPackedID.type() == OBJECT_Character) &&
-                   (current_top->uPackedID.type() ==
-                    OBJECT_Actor)) ||  // player preferable
-                  ((test_element->uPackedID.type() ==
-                    current_top->uPackedID.type()) &&
-                   (test_element->uPackedID.id() < current_top->uPackedID.id()))))) {  // less id preferable
-                std::swap(*current_top, *test_element);
-            }
-        }
-    }
+    // Sort. Queue keys are unique, so this produces the same order as the exchange sort used in vanilla. Usually only
+    // a couple of elements have changed since the last call, so we check whether there's anything to do first.
+    if (!std::ranges::is_sorted(pQueue, turnQueueLess))
+        std::ranges::sort(pQueue, turnQueueLess);
     this->pQueue.resize(active_actors);
     if (pQueue.empty())
         return; // All characters are dead & no monsters around.
@@ -333,13 +329,12 @@ void stru262_TurnBased::StartTurn() {
         }
     }
     // add new arrived actors
+    std::unordered_set<int> queued_actors;
+    for (const TurnBased_QueueElem &element : pQueue)
+        if (element.uPackedID.type() == OBJECT_Actor)
+            queued_actors.insert(element.uPackedID.id());
     for (actor_num = 0; actor_num < ai_arrays_size; ++actor_num) {
-        for (j = 0; j < this->pQueue.size(); ++j) {
-            if ((pQueue[j].uPackedID.type() == OBJECT_Actor) &&
-                ai_near_actors_ids[actor_num] == pQueue[j].uPackedID.id())
-                break;
-        }
-        if (j == this->pQueue.size()) {
+        if (queued_actors.insert(ai_near_actors_ids[actor_num]).second) {
             TurnBased_QueueElem &element = this->pQueue.emplace_back();
             element.uPackedID = Pid(OBJECT_Actor, ai_near_actors_ids[actor_num]);
             element.actor_initiative = 1;
@@ -443,31 +438,20 @@ void stru262_TurnBased::NextTurn() {
 //----- (004063A1) --------------------------------------------------------
 bool stru262_TurnBased::StepTurnQueue() {
     AIState v9;  // dx@12
-    int j;
 
     SortTurnQueue();
     if (pQueue[0].actor_initiative != 0) {
         if (pQueue[0].uPackedID.type() == OBJECT_Character) {
-            do {
-                for (j = 0; j < this->pQueue.size(); ++j)
-                    --pQueue[j].actor_initiative;
-                --turn_initiative;
-                if (turn_initiative == 0) return true;
-            } while (pQueue[0].actor_initiative != 0);
+            // Vanilla was stepping one tick at a time until either the turn is over or the character can act.
+            AdvanceTurnQueue(pQueue[0].actor_initiative, false);
+            if (turn_initiative == 0) return true;
         } else {
             if (pQueue[0].actor_initiative > 0) {
                 v9 = pActors[pQueue[0].uPackedID.id()].aiState;
                 if (!(v9 == Dying || v9 == Dead || v9 == Disabled ||
                       v9 == Removed)) {
-                    do {
-                        for (j = 0; j < this->pQueue.size(); ++j) {
-                            --pQueue[j].actor_initiative;
-                            if (pQueue[j].actor_initiative == 0)
-                                pQueue[j].uActionLength = 0_ticks;
-                        }
-                        --turn_initiative;
-                        if (turn_initiative == 0) return true;
-                    } while (pQueue[0].actor_initiative > 0);
+                    AdvanceTurnQueue(pQueue[0].actor_initiative, true);
+                    if (turn_initiative == 0) return true;
                 }
             }
         }
@@ -475,11 +459,24 @@ bool stru262_TurnBased::StepTurnQueue() {
     return false;
 }
 
+void stru262_TurnBased::AdvanceTurnQueue(int ticks, bool resetActions) {
+    if (ticks <= 0 || (turn_initiative > 0 && turn_initiative < ticks))
+        ticks = turn_initiative; // Can't step past the end of the turn.
+    if (ticks <= 0)
+        return;
+
+    for (TurnBased_QueueElem &element : pQueue) {
+        if (resetActions && element.actor_initiative > 0 && element.actor_initiative <= ticks)
+            element.uActionLength = 0_ticks;
+        element.actor_initiative -= ticks;
+    }
+    turn_initiative -= ticks;
+}
+
 //----- (00406457) --------------------------------------------------------
 void stru262_TurnBased::_406457(int a2) {
     signed int v4;  // ecx@2
     Duration v6;  // eax@2
-    int i;
     if (pQueue[a2].uPackedID.type() == OBJECT_Character) {
         v4 = pQueue[a2].uPackedID.id();
         if (pParty->pTurnBasedCharacterRecoveryTimes[v4]) {
@@ -502,13 +499,8 @@ void stru262_TurnBased::_406457(int a2) {
         pParty->setActiveCharacterIndex(pQueue[0].uPackedID.id() + 1);
     else
         pParty->setActiveCharacterIndex(0);
-    while ((pQueue[0].actor_initiative > 0) && (turn_initiative > 0)) {
-        for (i = 0; i < this->pQueue.size(); ++i) {
-            --pQueue[i].actor_initiative;
-            if (pQueue[i].actor_initiative == 0) pQueue[i].uActionLength = 0_ticks;
-        }
-        --turn_initiative;
-    }
+    if ((pQueue[0].actor_initiative > 0) && (turn_initiative > 0))
+        AdvanceTurnQueue(pQueue[0].actor_initiative, true);
 }
 
 //----- (0040652A) --------------------------------------------------------
@@ -651,6 +643,7 @@ void stru262_TurnBased::AI_Action_(int queue_index) {
               pActors[actor_id].aiState == Summoned ||
               pActors[actor_id].aiState == Disabled ||
               pActors[actor_id].aiState == Removed)) {
+            actorSpatialHash.sync();
             Actor::_SelectTarget(actor_id,
                                  &ai_near_actors_targets_pid[actor_id], true);
             v22 = ai_near_actors_targets_pid[actor_id];
@@ -849,6 +842,7 @@ bool stru262_TurnBased::ActorMove(signed int queue_position) {
         pActors[uActorID].aiState == Disabled ||
         pActors[uActorID].aiState == Summoned)
         return 1;
+    actorSpatialHash.sync();
     Actor::_SelectTarget(uActorID, &ai_near_actors_targets_pid[uActorID], true);
     if (pActors[uActorID].monsterInfo.hostilityType != HOSTILITY_FRIENDLY &&
         !ai_near_actors_targets_pid[uActorID])
@@ -978,6 +972,7 @@ void stru262_TurnBased::ActorAIChooseNewTargets() {
     int uActorID;             // [sp+68h] [bp-10h]@4
     int i;
 
+    actorSpatialHash.sync();
     for (i = 0; i < this->pQueue.size(); ++i) {
         if (pQueue[i].uPackedID.type() == OBJECT_Actor) {
             uActorID = pQueue[i].uPackedID.id();
@@ -38,6 +38,17 @@ struct stru262_TurnBased {
     void StartTurn();
     void NextTurn();
     bool StepTurnQueue();
+
+    /**
+     * Advances the turn queue in time, decreasing the initiative of all queue elements and `turn_initiative`. Stops
+     * at the end of the turn, i.e. when `turn_initiative` reaches zero.
+     *
+     * @param ticks                     Number of ticks to advance by. Non-positive values mean "advance until the end
+     *                                  of the turn".
+     * @param resetActions              Whether to reset the action lengths of the elements that become ready to act
+     *                                  while advancing.
+     */
+    void AdvanceTurnQueue(int ticks, bool resetActions);
     void _406457(int a2);
     void SetAIRecoveryTimes();
     void _4065B0();
@@ -3,6 +3,7 @@
 #include <sstream>
 #include <memory>
 #include <algorithm>
+#include <functional>
 #include <ranges>
 
 #include "Engine/AssetsManager.h"
@@ -18,7 +19,34 @@
 #include "Library/Logger/Logger.h"
 #include "Library/Snapshots/SnapshotSerialization.h"
 
+// Number of distinct strings to keep the wrapping results for, per font.
+static constexpr size_t FITTED_TEXT_CACHE_SIZE = 256;
+
+// Max number of different wrapping parameter sets to keep per string.
+static constexpr size_t FITTED_TEXT_VARIANTS = 8;
+
+// Each font takes a FONT_CELL_SIZE x FONT_CELL_SIZE cell in the shared atlas, 16x16 glyphs of 32x32 pixels each.
+static constexpr int FONT_CELL_SIZE = 512;
+static constexpr int FONT_ATLAS_CELLS_PER_ROW = 4;
+static constexpr int FONT_ATLAS_SIZE = FONT_CELL_SIZE * FONT_ATLAS_CELLS_PER_ROW;
+
+// Glyph atlas shared by all the fonts, so that switching fonts doesn't break the text batch in the renderer.
+struct FontAtlas {
+    GraphicsImage *main = nullptr;
+    GraphicsImage *shadow = nullptr;
+    std::array<bool, FONT_ATLAS_CELLS_PER_ROW * FONT_ATLAS_CELLS_PER_ROW> usedCells = {{}};
+    bool dirty = false; // Pixels were updated but not yet uploaded.
+};
+
+static FontAtlas fontAtlas;
+
 void ReloadFonts() {
+    // Renderer was re-created, atlas textures will be re-uploaded on first use.
+    if (fontAtlas.main) {
+        fontAtlas.main->releaseRenderId();
+        fontAtlas.shadow->releaseRenderId();
+    }
+
     if (assets->pFontBookOnlyShadow)
         assets->pFontBookOnlyShadow->CreateFontTex();
     if (assets->pFontBookLloyds)
@@ -53,7 +81,7 @@ static Color parseColorTag(const char *tag, const Color &defaultColor) {
     }
 }
 
-GUIFont::GUIFont() = default;
+GUIFont::GUIFont() : _fittedTextCache(FITTED_TEXT_CACHE_SIZE) {}
 
 GUIFont::~GUIFont() {
     ReleaseFontTex();
@@ -82,17 +110,51 @@ std::unique_ptr<GUIFont> GUIFont::LoadFont(const std::string &pFontFile, const s
 // TODO(pskelton): Save built atlas so it doesnt get recalcualted on reload?
 void GUIFont::CreateFontTex() {
     this->ReleaseFontTex();
-    // create blank textures
-    this->fonttex = GraphicsImage::Create(512, 512);
-    this->fontshadow = GraphicsImage::Create(512, 512);
-    Color *pPixelsfont = this->fonttex->rgba().pixels().data();
-    Color *pPixelsshadow = this->fontshadow->rgba().pixels().data();
+
+    Color *pPixelsfont = nullptr;
+    Color *pPixelsshadow = nullptr;
+    int pitch = FONT_CELL_SIZE;
+    auto freeCell = std::ranges::find(fontAtlas.usedCells, false);
+    if (freeCell != fontAtlas.usedCells.end()) {
+        if (!fontAtlas.main) {
+            fontAtlas.main = GraphicsImage::Create(FONT_ATLAS_SIZE, FONT_ATLAS_SIZE);
+            fontAtlas.shadow = GraphicsImage::Create(FONT_ATLAS_SIZE, FONT_ATLAS_SIZE);
+        }
+
+        *freeCell = true;
+        _atlasCell = freeCell - fontAtlas.usedCells.begin();
+        _atlasOffset = Pointi((_atlasCell % FONT_ATLAS_CELLS_PER_ROW) * FONT_CELL_SIZE,
+                              (_atlasCell / FONT_ATLAS_CELLS_PER_ROW) * FONT_CELL_SIZE);
+        _atlasSize = FONT_ATLAS_SIZE;
+        this->fonttex = fontAtlas.main;
+        this->fontshadow = fontAtlas.shadow;
+
+        pitch = FONT_ATLAS_SIZE;
+        int cellOffset = _atlasOffset.x + _atlasOffset.y * pitch;
+        pPixelsfont = this->fonttex->rgba().pixels().data() + cellOffset;
+        pPixelsshadow = this->fontshadow->rgba().pixels().data() + cellOffset;
+
+        // Cell might have been used by a font that was released, clear it.
+        for (int y = 0; y < FONT_CELL_SIZE; y++) {
+            std::fill_n(pPixelsfont + y * pitch, FONT_CELL_SIZE, Color());
+            std::fill_n(pPixelsshadow + y * pitch, FONT_CELL_SIZE, Color());
+        }
+    } else {
+        // Atlas is full, fall back to textures of our own.
+        _atlasCell = -1;
+        _atlasOffset = Pointi(0, 0);
+        _atlasSize = FONT_CELL_SIZE;
+        this->fonttex = GraphicsImage::Create(FONT_CELL_SIZE, FONT_CELL_SIZE);
+        this->fontshadow = GraphicsImage::Create(FONT_CELL_SIZE, FONT_CELL_SIZE);
+        pPixelsfont = this->fonttex->rgba().pixels().data();
+        pPixelsshadow = this->fontshadow->rgba().pixels().data();
+    }
 
     // load in char pixels into squares within texture
     for (int l = 0; l < 256; l++) {
         int xsq = l % 16;
         int ysq = l / 16;
-        int offset = 32 * xsq + 32 * ysq * 512;
+        int offset = 32 * xsq + 32 * ysq * pitch;
         uint8_t *pCharPixels = &this->pData.pixels[this->pData.header.font_pixels_offset[l]];
 
         for (unsigned y = 0; y < this->pData.header.uFontHeight; ++y) {
@@ -100,11 +162,11 @@ void GUIFont::CreateFontTex() {
                 if (*pCharPixels) {
                     if (*pCharPixels != 1) {
                         // add to normal
-                        pPixelsfont[offset + x + y * 512] = colorTable.White;
+                        pPixelsfont[offset + x + y * pitch] = colorTable.White;
                     }
                     if (*pCharPixels == 1) {
                         // add to shadow
-                        pPixelsshadow[offset + x + y * 512] = colorTable.White;
+                        pPixelsshadow[offset + x + y * pitch] = colorTable.White;
                     }
                 }
                 ++pCharPixels;
@@ -112,19 +174,59 @@ void GUIFont::CreateFontTex() {
         }
     }
 
-    render->Update_Texture(this->fonttex);
-    render->Update_Texture(this->fontshadow);
+    if (_atlasCell >= 0) {
+        // Atlas is uploaded once all the fonts that are being loaded are in, see beginText.
+        fontAtlas.dirty = true;
+    } else {
+        render->Update_Texture(this->fonttex);
+        render->Update_Texture(this->fontshadow);
+    }
 }
 
 void GUIFont::ReleaseFontTex() {
-    if (this->fonttex) {
-        this->fonttex->releaseRenderId();
-        this->fonttex->Release();
+    if (_atlasCell >= 0) {
+        fontAtlas.usedCells[_atlasCell] = false;
+        _atlasCell = -1;
+
+        if (std::ranges::none_of(fontAtlas.usedCells, std::identity())) {
+            fontAtlas.main->Release();
+            fontAtlas.shadow->Release();
+            fontAtlas.main = nullptr;
+            fontAtlas.shadow = nullptr;
+            fontAtlas.dirty = false;
+        }
+    } else {
+        if (this->fonttex) {
+            this->fonttex->releaseRenderId();
+            this->fonttex->Release();
+        }
+        if (this->fontshadow) {
+            this->fontshadow->releaseRenderId();
+            this->fontshadow->Release();
+        }
     }
-    if (this->fontshadow) {
-        this->fontshadow->releaseRenderId();
-        this->fontshadow->Release();
+
+    this->fonttex = nullptr;
+    this->fontshadow = nullptr;
+}
+
+void GUIFont::beginText() {
+    if (_atlasCell >= 0 && fontAtlas.dirty) {
+        render->Update_Texture(fontAtlas.main);
+        render->Update_Texture(fontAtlas.shadow);
+        fontAtlas.dirty = false;
     }
+
+    beginText();
+}
+
+void GUIFont::glyphTexCoords(unsigned char c, float *u1, float *v1, float *u2, float *v2) const {
+    float x = _atlasOffset.x + (c % 16) * 32.0f;
+    float y = _atlasOffset.y + (c / 16) * 32.0f;
+    *u1 = x / _atlasSize;
+    *u2 = (x + pData.header.pMetrics[c].uWidth) / _atlasSize;
+    *v1 = y / _atlasSize;
+    *v2 = (y + pData.header.uFontHeight) / _atlasSize;
 }
 
 bool GUIFont::IsCharValid(unsigned char c) const {
@@ -141,7 +243,7 @@ Color GUIFont::DrawTextLine(const std::string &text, Color color, Color defaultC
     if (text.empty()) {
         return color;
     }
-    render->BeginTextNew(fonttex, fontshadow);
+    beginText();
 
     Color text_color = color;
     size_t text_length = text.size();
@@ -168,12 +270,8 @@ Color GUIFont::DrawTextLine(const std::string &text, Color color, Color defaultC
                     }
                     uint8_t *pCharPixels = &pData.pixels[pData.header.font_pixels_offset[c]];
 
-                    int xsq = c % 16;
-                    int ysq = c / 16;
-                    float u1 = (xsq * 32.0f) / 512.0f;
-                    float u2 = (xsq * 32.0f + pData.header.pMetrics[c].uWidth) / 512.0f;
-                    float v1 = (ysq * 32.0f) / 512.0f;
-                    float v2 = (ysq * 32.0f + pData.header.uFontHeight) / 512.0f;
+                    float u1, v1, u2, v2;
+                    glyphTexCoords(c, &u1, &v1, &u2, &v2);
 
                     render->DrawTextNew(uX_pos, position.y, pData.header.pMetrics[c].uWidth, pData.header.uFontHeight, u1, v1, u2, v2, 1, colorTable.Black);
                     render->DrawTextNew(uX_pos, position.y, pData.header.pMetrics[c].uWidth, pData.header.uFontHeight, u1, v1, u2, v2, 0, text_color);
@@ -294,8 +392,15 @@ int GUIFont::CalcTextHeight(const std::string &pString, int width, int uXOffset,
         return 0;
     }
 
+    // Dialogue & message boxes measure the same text every frame right before drawing it, so the height is cached
+    // next to the wrapped text.
+    FittedText &fitted = fittedText(pString, width, uXOffset, false);
+    int &cachedHeight = fitted.heights[return_on_carriage];
+    if (cachedHeight >= 0)
+        return cachedHeight;
+
     int uAllHeght = pData.header.uFontHeight - 6;
-    std::string test_string = FitTextInAWindow(pString, width, uXOffset);
+    const std::string &test_string = fitted.result;
     size_t uStringLen = pString.length();
     for (int i = 0; i < uStringLen; ++i) {
         unsigned char c = test_string[i];
@@ -317,6 +422,7 @@ int GUIFont::CalcTextHeight(const std::string &pString, int width, int uXOffset,
         }
     }
 
+    cachedHeight = uAllHeght;
     return uAllHeght;
 }
 
@@ -358,6 +464,33 @@ std::string GUIFont::FitTextInAWindow(const std::string &inString, unsigned int
         return "";
     }
 
+    return fittedText(inString, width, uX, return_on_carriage).result;
+}
+
+GUIFont::FittedText &GUIFont::fittedText(const std::string &inString, unsigned int width, int uX, bool return_on_carriage) {
+    // Same strings get re-wrapped with the same parameters every frame, so we cache the results.
+    std::vector<FittedText> *fittedTexts = _fittedTextCache.find(std::string_view(inString));
+    if (!fittedTexts)
+        fittedTexts = &_fittedTextCache.insert(inString, {});
+
+    for (FittedText &fittedText : *fittedTexts)
+        if (fittedText.width == width && fittedText.uX == uX && fittedText.returnOnCarriage == return_on_carriage)
+            return fittedText;
+
+    if (fittedTexts->size() >= FITTED_TEXT_VARIANTS)
+        fittedTexts->clear(); // Don't let a single string that's drawn in many places eat up all the memory.
+
+    FittedText &fittedText = fittedTexts->emplace_back();
+    fittedText.width = width;
+    fittedText.uX = uX;
+    fittedText.returnOnCarriage = return_on_carriage;
+    fittedText.result = fitTextInAWindowUncached(inString, width, uX, return_on_carriage);
+    return fittedText;
+}
+
+std::string GUIFont::fitTextInAWindowUncached(const std::string &inString, unsigned int width, int uX,
+                                              bool return_on_carriage) {
+
     int lineWidth = uX;
     int newlinePos = -1;
     int lastCopyPos = 0;
@@ -437,7 +570,7 @@ void GUIFont::DrawText(GUIWindow *window, Pointi position, Color color, const st
         return;
     }
 
-    render->BeginTextNew(fonttex, fontshadow);
+    beginText();
 
     size_t v30 = text.length();
     if (!position.x) {
@@ -518,12 +651,8 @@ void GUIFont::DrawText(GUIWindow *window, Pointi position, Color color, const st
                     }
 
                     unsigned char *letter_pixels = &pData.pixels[pData.header.font_pixels_offset[c]];
-                    int xsq = c % 16;
-                    int ysq = c / 16;
-                    float u1 = (xsq * 32.0f) / 512.0f;
-                    float u2 = (xsq * 32.0f + pData.header.pMetrics[c].uWidth) / 512.0f;
-                    float v1 = (ysq * 32.0f) / 512.0f;
-                    float v2 = (ysq * 32.0f + pData.header.uFontHeight) / 512.0f;
+                    float u1, v1, u2, v2;
+                    glyphTexCoords(c, &u1, &v1, &u2, &v2);
 
                     render->DrawTextNew(out_x, out_y, pData.header.pMetrics[c].uWidth, pData.header.uFontHeight, u1, v1, u2, v2, 1, shadowColor);
                     render->DrawTextNew(out_x, out_y, pData.header.pMetrics[c].uWidth, pData.header.uFontHeight, u1, v1, u2, v2, 0, draw_color);
@@ -556,7 +685,7 @@ int GUIFont::DrawTextInRect(GUIWindow *window, Pointi position, Color color, con
         return pLineWidth;
     }
 
-    render->BeginTextNew(fonttex, fontshadow);
+    beginText();
 
     unsigned int text_width = 0;
     if (reverse_text)
@@ -639,12 +768,8 @@ int GUIFont::DrawTextInRect(GUIWindow *window, Pointi position, Color color, con
                     text_pos_x += pData.header.pMetrics[v15].uLeftSpacing;
                 }
                 uint8_t *char_pix_ptr = &pData.pixels[pData.header.font_pixels_offset[v15]];
-                int xsq = v15 % 16;
-                int ysq = v15 / 16;
-                float u1 = (xsq * 32.0f) / 512.0f;
-                float u2 = (xsq * 32.0f + pData.header.pMetrics[v15].uWidth) / 512.0f;
-                float v1 = (ysq * 32.0f) / 512.0f;
-                float v2 = (ysq * 32.0f + pData.header.uFontHeight) / 512.0f;
+                float u1, v1, u2, v2;
+                glyphTexCoords(v15, &u1, &v1, &u2, &v2);
 
                 render->DrawTextNew(text_pos_x, text_pos_y, pData.header.pMetrics[v15].uWidth, pData.header.uFontHeight, u1, v1, u2, v2, 1, colorTable.Black);
                 render->DrawTextNew(text_pos_x, text_pos_y, pData.header.pMetrics[v15].uWidth, pData.header.uFontHeight, u1, v1, u2, v2, 0, draw_color);
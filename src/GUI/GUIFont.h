@@ -3,12 +3,15 @@
 #include <array>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
 
 #include "Library/Color/Color.h"
 #include "Library/Image/Palette.h"
 #include "Library/Geometry/Point.h"
 
+#include "Utility/LruCache.h"
+
 struct GUICharMetric {
     int32_t uLeftSpacing;
     int32_t uWidth;
@@ -93,10 +96,34 @@ class GUIFont {
                                     bool return_on_carriage = false);
     void DrawTextLineToBuff(Color color, Color *uX_buff_pos,
                             const std::string &text, int line_width);
+    std::string fitTextInAWindowUncached(const std::string &inString, unsigned int width, int uX,
+                                         bool return_on_carriage);
+    struct FittedText;
+    FittedText &fittedText(const std::string &inString, unsigned int width, int uX, bool return_on_carriage);
+    void beginText();
+    void glyphTexCoords(unsigned char c, float *u1, float *v1, float *u2, float *v2) const;
 
  private:
+    struct FittedText {
+        unsigned int width = 0;
+        int uX = 0;
+        bool returnOnCarriage = false;
+        std::string result;
+        std::array<int, 2> heights = {{-1, -1}}; // CalcTextHeight results, by return_on_carriage, -1 if not computed.
+    };
+
+    struct FittedTextHash : std::hash<std::string_view> {
+        using is_transparent = void;
+    };
+
     FontData pData;
     Palette palette;
+    // Cached FitTextInAWindow results, by input string.
+    LruCache<std::string, std::vector<FittedText>, FittedTextHash, std::equal_to<>> _fittedTextCache;
+
+    int _atlasCell = -1; // Cell in the shared glyph atlas, -1 if the font has textures of its own.
+    Pointi _atlasOffset;
+    int _atlasSize = 0;
 };
 
 void ReloadFonts();
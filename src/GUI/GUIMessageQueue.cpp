@@ -1,9 +1,7 @@
 #include <GUI/GUIMessageQueue.h>
 
 void GUIFrameMessageQueue::clear() {
-    std::queue<GUIMessage> empty;
-
-    messageQueue.swap(empty);
+    messageQueue.clear();
 }
 
 void GUIFrameMessageQueue::popMessage(UIMessageType *msg, int *param, int *param2) {
@@ -1,11 +1,12 @@
 #pragma once
 
-#include <queue>
 #include <string>
 #include <cassert>
 
 #include "GUI/GUIEnums.h"
 
+#include "Utility/RingQueue.h"
+
 struct GUIMessage {
     UIMessageType type;
     int param;
@@ -20,7 +21,7 @@ struct GUIFrameMessageQueue {
     void popMessage(UIMessageType *msg, int *param, int *param2);
     void addGUIMessage(UIMessageType msg, int param, int param2);
 
-    std::queue<GUIMessage> messageQueue;
+    RingQueue<GUIMessage> messageQueue;
 };
 
 class GUIMessageQueue {
@@ -10,6 +10,7 @@
 #include "Engine/Engine.h"
 #include "Engine/EngineGlobals.h"
 #include "Engine/Objects/CharacterEnumFunctions.h"
+#include "Engine/Objects/CharacterStatsCache.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
 #include "Engine/Graphics/Viewport.h"
 #include "Engine/Graphics/Image.h"
@@ -551,6 +552,11 @@ GUIWindow_CharacterRecord::GUIWindow_CharacterRecord(int uActiveCharacter, Scree
     CharacterUI_LoadPaperdollTextures();
     current_screen_type = screen;
 
+    _statsTabIcon = assets->imageHandle_ColorKey("ib-cd1-d");
+    _skillsTabIcon = assets->imageHandle_ColorKey("ib-cd2-d");
+    _inventoryTabIcon = assets->imageHandle_ColorKey("ib-cd3-d");
+    _awardsTabIcon = assets->imageHandle_ColorKey("ib-cd4-d");
+
     pCharacterScreen_StatsBtn = CreateButton({pViewport->uViewportTL_X + 12, pViewport->uViewportTL_Y + 308},
                                              paperdoll_dbrds[9]->size(), 1, 0,
                                              UIMSG_ClickStatsBtn, 0, Io::InputAction::Stats, localization->GetString(LSTR_STATS),
@@ -637,6 +643,7 @@ void GUIWindow_CharacterRecord::createAwardsScrollBar() {
 }
 
 void GUIWindow_CharacterRecord::Update() {
+    CharacterStatsCacheScope statsCache;
     auto player = &pParty->activeCharacter();
 
     render->ClearZBuffer();
@@ -645,7 +652,7 @@ void GUIWindow_CharacterRecord::Update() {
             CharacterUI_ReleaseButtons();
             releaseAwardsScrollBar();
             CharacterUI_StatsTab_Draw(player);
-            render->DrawTextureNew(pCharacterScreen_StatsBtn->uX / 640.0f, pCharacterScreen_StatsBtn->uY / 480.0f, assets->getImage_ColorKey("ib-cd1-d"));
+            render->DrawTextureNew(pCharacterScreen_StatsBtn->uX / 640.0f, pCharacterScreen_StatsBtn->uY / 480.0f, assets->image(_statsTabIcon));
             break;
         }
         case WINDOW_CharacterWindow_Skills: {
@@ -655,21 +662,21 @@ void GUIWindow_CharacterRecord::Update() {
             }
             releaseAwardsScrollBar();
             CharacterUI_SkillsTab_Draw(player);
-            render->DrawTextureNew(pCharacterScreen_SkillsBtn->uX / 640.0f, pCharacterScreen_SkillsBtn->uY / 480.0f, assets->getImage_ColorKey("ib-cd2-d"));
+            render->DrawTextureNew(pCharacterScreen_SkillsBtn->uX / 640.0f, pCharacterScreen_SkillsBtn->uY / 480.0f, assets->image(_skillsTabIcon));
             break;
         }
         case WINDOW_CharacterWindow_Awards: {
             CharacterUI_ReleaseButtons();
             createAwardsScrollBar();
             CharacterUI_AwardsTab_Draw(player);
-            render->DrawTextureNew(pCharacterScreen_AwardsBtn->uX / 640.0f, pCharacterScreen_AwardsBtn->uY / 480.0f, assets->getImage_ColorKey("ib-cd4-d"));
+            render->DrawTextureNew(pCharacterScreen_AwardsBtn->uX / 640.0f, pCharacterScreen_AwardsBtn->uY / 480.0f, assets->image(_awardsTabIcon));
             break;
         }
         case WINDOW_CharacterWindow_Inventory: {
             CharacterUI_ReleaseButtons();
             releaseAwardsScrollBar();
             CharacterUI_InventoryTab_Draw(player, false);
-            render->DrawTextureNew(pCharacterScreen_InventoryBtn->uX / 640.0f, pCharacterScreen_InventoryBtn->uY / 480.0f, assets->getImage_ColorKey("ib-cd3-d"));
+            render->DrawTextureNew(pCharacterScreen_InventoryBtn->uX / 640.0f, pCharacterScreen_InventoryBtn->uY / 480.0f, assets->image(_inventoryTabIcon));
             break;
         }
         default:
@@ -3,6 +3,8 @@
 #include <vector>
 #include <string>
 
+#include "Engine/AssetsManager.h"
+
 #include "GUI/GUIWindow.h"
 
 class GUIWindow_CharacterRecord : public GUIWindow {
@@ -51,6 +53,10 @@ class GUIWindow_CharacterRecord : public GUIWindow {
     int _scrollableAwardSteps = 0;
     bool _awardLimitReached = false;
     std::vector<int> _achievedAwardsList;
+    AssetHandle _statsTabIcon;
+    AssetHandle _skillsTabIcon;
+    AssetHandle _awardsTabIcon;
+    AssetHandle _inventoryTabIcon;
 };
 
 bool ringscreenactive();
@@ -23,6 +23,7 @@
 #include "Engine/Localization.h"
 #include "Engine/MapInfo.h"
 #include "Engine/Objects/Actor.h"
+#include "Engine/Objects/CharacterStatsCache.h"
 #include "Engine/Objects/Chest.h"
 #include "Engine/Objects/ObjectList.h"
 #include "Engine/Objects/SpriteObject.h"
@@ -803,6 +804,7 @@ void GameUI_DrawFoodAndGold() {
 
 //----- (0041B0C9) --------------------------------------------------------
 void GameUI_DrawLifeManaBars() {
+    CharacterStatsCacheScope statsCache;
     for (int i = 0; i < pParty->pCharacters.size(); ++i) {
         if (pParty->pCharacters[i].health > 0) {
             int v17 = 0;
@@ -400,11 +400,6 @@ void GameUI_DrawItemInfo(struct ItemGen *inspect_item) {
                                       colorTable.TorchRed, localization->GetString(LSTR_BROKEN_ITEM), 3);
         render->ResetUIClipRect();
 
-        if (inspect_item_image) {
-            inspect_item_image->Release();
-            inspect_item_image = nullptr;
-        }
-
         return;
     }
 
@@ -432,11 +427,6 @@ void GameUI_DrawItemInfo(struct ItemGen *inspect_item) {
                 assets->pFontArrus->CalcTextHeight(localization->GetString(LSTR_NOT_IDENTIFIED),
                                            iteminfo_window.uFrameWidth, 0) / 2, colorTable.TorchRed, localization->GetString(LSTR_NOT_IDENTIFIED), 3);
         render->ResetUIClipRect();
-
-        if (inspect_item_image) {
-            inspect_item_image->Release();
-            inspect_item_image = nullptr;
-        }
         return;
     }
 
@@ -2,6 +2,7 @@
 
 #include "Engine/AssetsManager.h"
 #include "Engine/Objects/CharacterEnumFunctions.h"
+#include "Engine/Objects/CharacterStatsCache.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
 #include "Engine/Spells/Spells.h"
 #include "Engine/Localization.h"
@@ -32,6 +33,7 @@ GUIWindow_QuickReference::GUIWindow_QuickReference() : GUIWindow(WINDOW_QuickRef
 }
 
 void GUIWindow_QuickReference::Update() {
+    CharacterStatsCacheScope statsCache;
     // -----------------------------------
     // 004156F0 GUI_UpdateWindows --- part
     // {
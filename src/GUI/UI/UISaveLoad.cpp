@@ -1,18 +1,17 @@
 #include "GUI/UI/UISaveLoad.h"
 
 #include <string>
-#include <filesystem>
 #include <algorithm>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "Engine/Engine.h"
 #include "Engine/EngineGlobals.h"
 #include "Engine/AssetsManager.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
-#include "Engine/Graphics/ImageLoader.h"
 #include "Engine/Graphics/Viewport.h"
 #include "Engine/Graphics/Image.h"
-#include "Engine/Snapshots/EntitySnapshots.h"
 #include "Engine/Localization.h"
 #include "Engine/MapInfo.h"
 #include "Engine/SaveLoad.h"
@@ -26,9 +25,6 @@
 #include "GUI/GUIFont.h"
 #include "GUI/GUIMessageQueue.h"
 
-#include "Library/Lod/LodReader.h"
-#include "Library/Snapshots/SnapshotSerialization.h"
-
 #include "Utility/DataPath.h"
 
 using Io::TextInputType;
@@ -56,21 +52,17 @@ GUIWindow_Save::GUIWindow_Save() : GUIWindow(WINDOW_Save, {0, 0}, render->GetRen
 
     pSavegameList->Initialize();
 
-    LodReader pLODFile;
-    for (unsigned i = 0; i < MAX_SAVE_SLOTS; ++i) {
-        // std::string file_name = pSavegameList->pFileList[i];
-        std::string file_name = fmt::format("save{:03}.mm7", i);
-        if (file_name.empty()) {
-            file_name = "1.mm7";
-        }
+    std::vector<std::string> fileNames;
+    for (unsigned i = 0; i < MAX_SAVE_SLOTS; ++i)
+        fileNames.push_back(fmt::format("save{:03}.mm7", i));
+    std::vector<std::optional<SaveFileInfo>> infos = readSaveFileInfos(fileNames);
 
-        std::string str = makeDataPath("saves", file_name);
-        if (!std::filesystem::exists(str)) {
+    for (unsigned i = 0; i < MAX_SAVE_SLOTS; ++i) {
+        if (!infos[i]) {
             pSavegameList->pSavegameUsedSlots[i] = false;
             pSavegameList->pSavegameHeader[i].name = localization->GetString(LSTR_EMPTY_SAVESLOT);
         } else {
-            pLODFile.open(str, LOD_ALLOW_DUPLICATES);
-            deserialize(pLODFile.read("header.bin"), &pSavegameList->pSavegameHeader[i], tags::via<SaveGameHeader_MM7>);
+            pSavegameList->pSavegameHeader[i] = infos[i]->header;
 
             if (pSavegameList->pSavegameHeader[i].name.empty()) {
                 // blank so add something - suspect quicksaves
@@ -79,13 +71,11 @@ GUIWindow_Save::GUIWindow_Save() : GUIWindow(WINDOW_Save, {0, 0}, render->GetRen
                 pSavegameList->pSavegameHeader[i].name = test;
             }
 
-            pSavegameList->pSavegameThumbnails[i] = GraphicsImage::Create(std::make_unique<PCX_LOD_Raw_Loader>(&pLODFile, "image.pcx"));
-            if (pSavegameList->pSavegameThumbnails[i]->width() == 0) {
-                pSavegameList->pSavegameThumbnails[i]->Release();
-                pSavegameList->pSavegameThumbnails[i] = nullptr;
-            }
-
-            pSavegameList->pSavegameUsedSlots[i] = (pSavegameList->pSavegameThumbnails[i] != nullptr);
+            // Thumbnails are decoded lazily, only for the slots that actually get displayed. Slots with a thumbnail
+            // that fails to decode are marked as unused in UI_DrawSaveLoad.
+            if (infos[i]->hasThumbnail)
+                pSavegameList->pSavegameThumbnailPaths[i] = makeDataPath("saves", fileNames[i]);
+            pSavegameList->pSavegameUsedSlots[i] = infos[i]->hasThumbnail;
         }
     }
 
@@ -155,10 +145,11 @@ GUIWindow_Load::GUIWindow_Load(bool ingame) : GUIWindow(WINDOW_Load, {0, 0}, {0,
 
     pSavegameList->Initialize();
 
-    LodReader pLODFile;
+    std::vector<std::string> fileNames(pSavegameList->pFileList.begin(), pSavegameList->pFileList.begin() + pSavegameList->numSavegameFiles);
+    std::vector<std::optional<SaveFileInfo>> infos = readSaveFileInfos(fileNames);
+
     for (unsigned i = 0; i < pSavegameList->numSavegameFiles; ++i) {
-        std::string str = makeDataPath("saves", pSavegameList->pFileList[i]);
-        if (!std::filesystem::exists(str)) {
+        if (!infos[i]) {
             pSavegameList->pSavegameUsedSlots[i] = false;
             pSavegameList->pSavegameHeader[i].name = localization->GetString(LSTR_EMPTY_SAVESLOT);
             continue;
@@ -172,8 +163,7 @@ GUIWindow_Load::GUIWindow_Load(bool ingame) : GUIWindow(WINDOW_Load, {0, 0}, {0,
             }
         }
 
-        pLODFile.open(str, LOD_ALLOW_DUPLICATES);
-        deserialize(pLODFile.read("header.bin"), &pSavegameList->pSavegameHeader[i], tags::via<SaveGameHeader_MM7>);
+        pSavegameList->pSavegameHeader[i] = infos[i]->header;
 
         if (iequals(pSavegameList->pFileList[i], localization->GetString(LSTR_AUTOSAVE_MM7))) {
             pSavegameList->pSavegameHeader[i].name = localization->GetString(LSTR_AUTOSAVE);
@@ -186,13 +176,9 @@ GUIWindow_Load::GUIWindow_Load(bool ingame) : GUIWindow(WINDOW_Load, {0, 0}, {0,
             pSavegameList->pSavegameHeader[i].name = test;
         }
 
-        pSavegameList->pSavegameThumbnails[i] = GraphicsImage::Create(std::make_unique<PCX_LOD_Raw_Loader>(&pLODFile, "image.pcx"));
-
-        if (pSavegameList->pSavegameThumbnails[i]->width() == 0) {
-            pSavegameList->pSavegameThumbnails[i]->Release();
-            pSavegameList->pSavegameThumbnails[i] = nullptr;
-        }
-
+        // Thumbnails are decoded lazily, only for the slots that actually get displayed.
+        if (infos[i]->hasThumbnail)
+            pSavegameList->pSavegameThumbnailPaths[i] = makeDataPath("saves", fileNames[i]);
         pSavegameList->pSavegameUsedSlots[i] = true;
         //if (pSavegameList->pSavegameThumbnails[i] != nullptr) {
         //    pSavegameUsedSlots[i] = 1;
@@ -239,6 +225,12 @@ void GUIWindow_Load::Update() {
 }
 
 static void UI_DrawSaveLoad(bool save) {
+    // Save slots are only considered used if the thumbnail can be decoded. Thumbnails are decoded lazily, so we might
+    // only find out here.
+    int slot = pSavegameList->selectedSlot;
+    if (save && pSavegameList->pSavegameUsedSlots[slot] && !pSavegameList->thumbnail(slot))
+        pSavegameList->pSavegameUsedSlots[slot] = false;
+
     if (pSavegameList->pSavegameUsedSlots[pSavegameList->selectedSlot]) {
         GUIWindow save_load_window;
         save_load_window.uFrameX = pGUIWindow_CurrentMenu->uFrameX + 240;
@@ -247,9 +239,9 @@ static void UI_DrawSaveLoad(bool save) {
         save_load_window.uFrameZ = save_load_window.uFrameX + 219;
         save_load_window.uFrameHeight = assets->pFontSmallnum->GetHeight();
         save_load_window.uFrameW = assets->pFontSmallnum->GetHeight() + save_load_window.uFrameY - 1;
-        if (pSavegameList->pSavegameThumbnails[pSavegameList->selectedSlot]) {
+        if (GraphicsImage *thumbnail = pSavegameList->thumbnail(pSavegameList->selectedSlot)) {
             render->DrawTextureNew((pGUIWindow_CurrentMenu->uFrameX + 276) / 640.0f, (pGUIWindow_CurrentMenu->uFrameY + 171) / 480.0f,
-                                   pSavegameList->pSavegameThumbnails[pSavegameList->selectedSlot]);
+                                   thumbnail);
         }
         // Draw map name
         save_load_window.DrawTitleText(assets->pFontSmallnum.get(), 0, 0, colorTable.White,
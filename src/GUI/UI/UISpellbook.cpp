@@ -238,6 +238,9 @@ void GUIWindow_Spellbook::loadSpellbook() {
             SBPageCSpellsTextureList[index + 1] = assets->getImage_Solid(pContainer);
         }
     }
+
+    assets->prefetchImages(SBPageSSpellsTextureList);
+    assets->prefetchImages(SBPageCSpellsTextureList);
 }
 
 void GUIWindow_Spellbook::drawCurrentSchoolBackground() {
@@ -264,6 +267,12 @@ void GUIWindow_Spellbook::initializeTextures() {
         ui_spellbook_school_tabs[page][0] = assets->getImage_Alpha(fmt::format("tab{}a", std::to_underlying(page) + 1));
         ui_spellbook_school_tabs[page][1] = assets->getImage_Alpha(fmt::format("tab{}b", std::to_underlying(page) + 1));
     }
+
+    assets->prefetchImages(std::array{ui_spellbook_btn_close, ui_spellbook_btn_close_click,
+                                      ui_spellbook_btn_quckspell, ui_spellbook_btn_quckspell_click});
+    assets->prefetchImages(ui_spellbook_school_backgrounds);
+    for (MagicSchool page : allMagicSchools())
+        assets->prefetchImages(ui_spellbook_school_tabs[page]);
 }
 
 void GUIWindow_Spellbook::onCloseSpellBook() {
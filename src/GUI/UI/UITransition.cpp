@@ -7,6 +7,7 @@
 #include "Engine/Graphics/Indoor.h"
 #include "Engine/Graphics/Renderer/Renderer.h"
 #include "Engine/Graphics/Image.h"
+#include "Engine/LocationPrefetcher.h"
 #include "Engine/Localization.h"
 #include "Engine/MapInfo.h"
 #include "Engine/Party.h"
@@ -95,6 +96,8 @@ GUIWindow_Transition::GUIWindow_Transition(HouseId transitionHouse, unsigned exi
         if (locationName[0] == '0') {
             v15 = pCurrentMapName;
         }
+        PrefetchLevelMusic(v15);
+        engine->_locationPrefetcher->prefetch(v15);
         if (pMapStats->GetMapInfo(v15) != MAP_INVALID) {
             transition_button_label = localization->FormatString(LSTR_FMT_ENTER_S, pMapStats->pInfos[pMapStats->GetMapInfo(v15)].name);
             if (uCurrentlyLoadedLevelType == LEVEL_INDOOR && pParty->hasActiveCharacter() && pParty->GetRedOrYellowAlert())
@@ -111,6 +114,8 @@ GUIWindow_Transition::GUIWindow_Transition(HouseId transitionHouse, unsigned exi
                 uCurrentHouse_Animation = IndoorLocation::GetLocationIndex(locationName);
         }
     } else if (!IndoorLocation::GetLocationIndex(locationName)) { // transfer to outdoors - no special message
+        PrefetchLevelMusic(locationName);
+        engine->_locationPrefetcher->prefetch(locationName);
         if (pMapStats->GetMapInfo(pCurrentMapName) != MAP_INVALID) {
             transition_button_label = localization->FormatString(LSTR_FMT_LEAVE_S, pMapStats->pInfos[pMapStats->GetMapInfo(pCurrentMapName)].name);
             if (transitionHouse != HOUSE_INVALID && pAnimatedRooms[buildingTable[transitionHouse].uAnimationID].uRoomSoundId)
@@ -147,6 +152,12 @@ GUIWindow_Travel::GUIWindow_Travel() : GUIWindow(WINDOW_ChangeLocation, {0, 0},
     game_ui_dialogue_background = assets->getImage_Solid(dialogueBackgroundResourceByAlignment[pParty->alignment]);
 
     transition_ui_icon = assets->getImage_Solid("outside");
+
+    std::string destinationMapName;
+    if (pOutdoor->GetTravelDestination(pParty->pos.x, pParty->pos.y, &destinationMapName)) {
+        PrefetchLevelMusic(destinationMapName);
+        engine->_locationPrefetcher->prefetch(destinationMapName);
+    }
     if (pMapStats->GetMapInfo(pCurrentMapName) != MAP_INVALID) {
         transition_button_label = localization->FormatString( LSTR_FMT_LEAVE_S, pMapStats->pInfos[pMapStats->GetMapInfo(pCurrentMapName)].name);
     } else {
@@ -165,6 +176,8 @@ GUIWindow_Travel::GUIWindow_Travel() : GUIWindow(WINDOW_ChangeLocation, {0, 0},
 }
 
 void GUIWindow_Travel::Update() {
+    engine->_locationPrefetcher->update();
+
     std::string pDestinationMapName;
 
     pOutdoor->GetTravelDestination(pParty->pos.x, pParty->pos.y, &pDestinationMapName);
@@ -197,6 +210,8 @@ void GUIWindow_Travel::Update() {
 }
 
 void GUIWindow_Transition::Update() {
+    engine->_locationPrefetcher->update();
+
     render->DrawTextureNew(477 / 640.0f, 0, game_ui_dialogue_background);
     render->DrawTextureNew((pNPCPortraits_x[0][0] - 4) / 640.0f, (pNPCPortraits_y[0][0] - 4) / 480.0f, game_ui_evtnpc);
     render->DrawTextureNew(pNPCPortraits_x[0][0] / 640.0f, pNPCPortraits_y[0][0] / 480.0f, transition_ui_icon);
@@ -1,5 +1,7 @@
 #include "Mouse.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <list>
 
@@ -22,6 +24,8 @@
 #include "GUI/UI/UIBranchlessDialogue.h"
 #include "GUI/UI/UISpell.h"
 
+#include "Library/Platform/Interface/Platform.h"
+
 #include "Media/Audio/AudioPlayer.h"
 
 std::shared_ptr<Io::Mouse> mouse = nullptr;
@@ -153,12 +157,24 @@ void Io::Mouse::DrawCursor() {
 
     // for party held item
     if (pParty->pPickedItem.uItemID != ITEM_NULL) {
+        // Broken & unidentified items are tinted when drawn, these always go through the renderer.
+        const ItemGen &item = pParty->pPickedItem;
+        if (item.IsIdentified() && !item.IsBroken()) {
+            GraphicsImage *texture = assets->getImage_Alpha(item.GetIconName());
+            if (texture && showHardwareCursor(texture, false))
+                return;
+        }
+
+        hideHardwareCursor();
         DrawPickedItem();
     } else {
         ClearPickedItem();
 
         // for other cursor img ie target mouse
-        if (this->cursor_img) {
+        if (this->cursor_img && showHardwareCursor(this->cursor_img, true)) {
+            return;
+        } else if (this->cursor_img) {
+            hideHardwareCursor();
             platform->setCursorShown(false);
             // draw image - needs centering
             pos.x -= (this->cursor_img->width()) / 2;
@@ -166,6 +182,7 @@ void Io::Mouse::DrawCursor() {
 
             render->DrawTextureNew(pos.x / 640., pos.y / 480., this->cursor_img);
         } else {
+            hideHardwareCursor();
             platform->setCursorShown(true);
         }
     }
@@ -219,6 +236,53 @@ void Io::Mouse::DrawCursor() {
     */
 }
 
+bool Io::Mouse::showHardwareCursor(GraphicsImage *image, bool centered) {
+    if (!engine->config->graphics.HardwareCursor.value()) {
+        hideHardwareCursor();
+        return false;
+    }
+
+    // UI is drawn at render dimensions & then scaled to fit the window, the cursor should be scaled the same way.
+    Sizei renderDims = render->GetRenderDimensions();
+    Sizei presentDims = render->GetPresentDimensions();
+    float scale = std::min(static_cast<float>(presentDims.w) / renderDims.w, static_cast<float>(presentDims.h) / renderDims.h);
+    Sizei size(std::max(1, static_cast<int>(std::round(image->width() * scale))),
+               std::max(1, static_cast<int>(std::round(image->height() * scale))));
+
+    if (image != _hardwareCursorImage || size != _hardwareCursorSize) {
+        hideHardwareCursor();
+
+        const RgbaImage &src = image->rgba();
+        RgbaImage scaled = RgbaImage::uninitialized(size.w, size.h);
+        for (int y = 0; y < size.h; y++)
+            for (int x = 0; x < size.w; x++)
+                scaled[y][x] = src[y * src.height() / size.h][x * src.width() / size.w];
+
+        // Failures are remembered too, so that we don't retry on every frame.
+        _hardwareCursor = platform->createCursor(scaled, centered ? Pointi(size.w / 2, size.h / 2) : Pointi(0, 0));
+        _hardwareCursorImage = image;
+        _hardwareCursorSize = size;
+    }
+
+    if (!_hardwareCursor)
+        return false;
+
+    if (!_hardwareCursorSet) {
+        platform->setCursor(_hardwareCursor.get());
+        _hardwareCursorSet = true;
+    }
+    platform->setCursorShown(true);
+    return true;
+}
+
+void Io::Mouse::hideHardwareCursor() {
+    if (!_hardwareCursorSet)
+        return;
+
+    platform->setCursor(nullptr);
+    _hardwareCursorSet = false;
+}
+
 void Io::Mouse::Activate() { bActive = true; }
 
 void Io::Mouse::ClearPickedItem() { pPickedItem = nullptr; }
@@ -7,6 +7,8 @@
 #include "Engine/Pid.h"
 
 #include "Library/Geometry/Point.h"
+#include "Library/Geometry/Size.h"
+#include "Library/Platform/Interface/PlatformCursor.h"
 
 class GraphicsImage;
 
@@ -46,6 +48,26 @@ class Mouse {
 
     void UI_OnMouseLeftClick();
 
+ private:
+    /**
+     * Switches to a system cursor made from the provided image. The system cursor is not tied to the frame rate, so
+     * it's preferred over drawing the cursor into the frame.
+     *
+     * @param image                     Cursor image, in UI coordinates. Will be scaled to match the UI scale.
+     * @param centered                  Whether the click point is in the center of the image, otherwise it's in the
+     *                                  top-left corner.
+     * @return                          Whether the system cursor is now in use. If not, the caller should draw the
+     *                                  cursor into the frame.
+     */
+    bool showHardwareCursor(GraphicsImage *image, bool centered);
+
+    /**
+     * Switches back to the default system cursor if a custom one was set by `showHardwareCursor`.
+     */
+    void hideHardwareCursor();
+
+ public:
+
     Pid uPointingObjectID;
     unsigned int bActive = 0;
     int field_8 = 0;
@@ -95,6 +117,12 @@ class Mouse {
     int field_104 = 0;
     unsigned int uMouseX = 0;
     unsigned int uMouseY = 0;
+
+ private:
+    std::unique_ptr<PlatformCursor> _hardwareCursor;
+    GraphicsImage *_hardwareCursorImage = nullptr; // Image & size that `_hardwareCursor` was created for.
+    Sizei _hardwareCursorSize;
+    bool _hardwareCursorSet = false;
 };
 }  // namespace Io
 
@@ -5,3 +5,7 @@
 [[noreturn]] void throwBinarySerializationNoMoreDataError(size_t bytesRead, size_t bytesExpected, std::string_view typeName) {
     throw Exception("Could not read '{}' from binary stream: expected {} bytes, got only {}", typeName, bytesExpected, bytesRead);
 }
+
+[[noreturn]] void throwBinarySerializationNoViewError(std::string_view typeName) {
+    throw Exception("Could not read '{}' from binary stream in place: stream doesn't support zero-copy reads", typeName);
+}
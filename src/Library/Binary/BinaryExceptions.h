@@ -3,3 +3,4 @@
 #include <string_view>
 
 [[noreturn]] void throwBinarySerializationNoMoreDataError(size_t bytesRead, size_t bytesExpected, std::string_view typeName);
+[[noreturn]] void throwBinarySerializationNoViewError(std::string_view typeName);
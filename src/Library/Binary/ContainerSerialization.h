@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <optional>
 #include <span>
 #include <array>
 
@@ -63,6 +64,24 @@ void serialize(const Span &src, OutputStream *dst) {
 }
 
 
+//
+// Read-only std::span support - deserializes in place, pointing into the memory that the stream is reading from.
+// Requires a stream that supports `InputStream::readView`, and a type without alignment requirements, so that the
+// data can be accessed in place.
+//
+
+template<class T> requires is_memcopy_serializable_v<T> && (alignof(T) == 1)
+void deserialize(InputStream &src, std::span<const T> *dst, PresizedTag tag) {
+    size_t bytesExpected = tag.size * sizeof(T);
+    std::optional<std::span<const std::byte>> view = src.readView(bytesExpected);
+    if (!view)
+        throwBinarySerializationNoViewError(typeid(T).name());
+    if (view->size() != bytesExpected)
+        throwBinarySerializationNoMoreDataError(view->size() % sizeof(T), sizeof(T), typeid(T).name());
+    *dst = std::span<const T>(reinterpret_cast<const T *>(view->data()), tag.size);
+}
+
+
 //
 // std::array support - doesn't write size to the stream.
 //
@@ -1,18 +1,27 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <typeinfo>
 #include <type_traits>
 
 #include "Utility/Streams/OutputStream.h"
 #include "Utility/Streams/InputStream.h"
 
+#include "BinaryConcepts.h"
 #include "BinaryExceptions.h"
 
+// Memcopy serialization writes out the in-memory representation as is, and all the binary formats that we're working
+// with are little-endian.
+static_assert(std::endian::native == std::endian::little, "Memcopy serialization requires a little-endian platform.");
+
 /**
  * Type trait that's used by the binary serialization framework to check if a type can be binary-serialized with a
  * simple `memcpy` call.
  *
- * By default, only arithmetic (floating point or integral) types are memcopy-serializable.
+ * By default, only arithmetic (floating point or integral) types are memcopy-serializable. Arrays of
+ * memcopy-serializable types are detected automatically, so that e.g. a `std::vector<std::array<char, 10>>` is
+ * serialized with a single `memcpy` call and not element by element.
  *
  * Instead of specializing this trait directly for your class, use `MM_DECLARE_MEMCOPY_SERIALIZABLE`.
  *
@@ -26,22 +35,27 @@ struct is_memcopy_serializable : std::is_arithmetic<T> {};
 template<class T>
 constexpr bool is_memcopy_serializable_v = is_memcopy_serializable<T>::value;
 
+template<class T, size_t N>
+struct is_memcopy_serializable<std::array<T, N>> : std::bool_constant<is_memcopy_serializable_v<T> &&
+                                                                      sizeof(std::array<T, N>) == N * sizeof(T)> {};
+
 /**
  * Invoke this macro for a type to use it with binary serialization functions via simple memory copy.
  *
  * @param T                             Type to declare as memcopy-serializable.
  */
 #define MM_DECLARE_MEMCOPY_SERIALIZABLE(T)                                                                              \
+static_assert(std::is_trivially_copyable_v<T>, "Memcopy-serializable types must be trivially copyable.");               \
 template<>                                                                                                              \
 struct is_memcopy_serializable<T> : std::true_type {};
 
 
-template<class T> requires is_memcopy_serializable_v<T>
+template<RegularBinarizable T> requires is_memcopy_serializable_v<T>
 void serialize(const T &src, OutputStream *dst) {
     dst->write(&src, sizeof(T));
 }
 
-template<class T> requires is_memcopy_serializable_v<T>
+template<RegularBinarizable T> requires is_memcopy_serializable_v<T>
 void deserialize(InputStream &src, T *dst) {
     size_t bytes = src.read(dst, sizeof(T));
     if (bytes != sizeof(T))
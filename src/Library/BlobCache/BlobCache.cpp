@@ -0,0 +1,168 @@
+#include "BlobCache.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <utility>
+
+#include "Utility/Streams/TempFileOutputStream.h"
+
+static constexpr size_t SIGNATURE_SIZE = 8;
+
+struct BlobCacheRecordHeader {
+    uint32_t keySize = 0;
+    uint32_t valueSize = 0;
+};
+
+BlobCache::BlobCache() = default;
+
+BlobCache::~BlobCache() {
+    close();
+}
+
+void BlobCache::open(std::string_view path, std::string_view signature, size_t maxSize) {
+    assert(signature.size() <= SIGNATURE_SIZE);
+
+    close();
+
+    std::lock_guard lock(_mutex);
+
+    _signature = signature;
+    _signature.resize(SIGNATURE_SIZE, '\0');
+    _maxSize = maxSize;
+
+    std::error_code ec;
+    uintmax_t fileSize = std::filesystem::file_size(std::filesystem::path(path), ec);
+    if (!ec && fileSize > 0)
+        _mapping = Blob::fromFile(path);
+
+    // Parse what we have. If anything's off, we just start from scratch, the file will be replaced on close.
+    const char *data = static_cast<const char *>(_mapping.data());
+    size_t size = _mapping.size();
+    _valid = size >= SIGNATURE_SIZE && memcmp(data, _signature.data(), SIGNATURE_SIZE) == 0;
+    size_t offset = SIGNATURE_SIZE;
+    while (_valid && offset < size) {
+        BlobCacheRecordHeader header;
+        if (offset + sizeof(header) > size) {
+            _valid = false;
+            break;
+        }
+        memcpy(&header, data + offset, sizeof(header));
+        offset += sizeof(header);
+
+        if (header.keySize + static_cast<size_t>(header.valueSize) > size - offset) {
+            _valid = false;
+            break;
+        }
+
+        std::string key(data + offset, header.keySize);
+        offset += header.keySize;
+        _recordByKey[std::move(key)].value = _mapping.subBlob(offset, header.valueSize);
+        offset += header.valueSize;
+    }
+
+    if (_valid) {
+        _size = size;
+    } else {
+        _recordByKey.clear();
+        _mapping = Blob();
+        _size = SIGNATURE_SIZE;
+    }
+
+    _path = path;
+}
+
+void BlobCache::close() {
+    std::lock_guard lock(_mutex);
+
+    if (_path.empty())
+        return;
+
+    // Nothing to write if nothing was added & the file is fine as it is.
+    bool overflow = _size > _maxSize;
+    if (!_failed && (_output || !_valid || overflow)) {
+        try {
+            if (!_output)
+                openOutput();
+
+            // When over the limit, only the records used in this session are kept.
+            for (const auto &[key, record] : _recordByKey)
+                if (!record.added && (!overflow || record.used))
+                    writeRecord(key, record.value);
+
+            // Need to unmap the old file before replacing it, otherwise this won't work on Windows.
+            _recordByKey.clear();
+            _mapping = Blob();
+            _output->close();
+        } catch (const std::exception &) {
+            // E.g. another process has the file open on Windows. We'll just try again next time.
+            if (_output)
+                _output->discard();
+        }
+    }
+
+    _output.reset();
+    _recordByKey.clear();
+    _mapping = Blob();
+    _path.clear();
+    _signature.clear();
+    _maxSize = 0;
+    _size = 0;
+    _valid = false;
+    _failed = false;
+}
+
+std::optional<Blob> BlobCache::find(const std::string &key) {
+    std::lock_guard lock(_mutex);
+    assert(!_path.empty());
+
+    auto pos = _recordByKey.find(key);
+    if (pos == _recordByKey.end() || pos->second.added)
+        return std::nullopt;
+
+    pos->second.used = true;
+    return Blob::share(pos->second.value);
+}
+
+void BlobCache::insert(const std::string &key, const Blob &value) {
+    std::lock_guard lock(_mutex);
+    assert(!_path.empty());
+
+    auto [pos, inserted] = _recordByKey.try_emplace(key);
+    if (!inserted)
+        return;
+    pos->second.used = true;
+    pos->second.added = true;
+
+    if (_failed)
+        return;
+
+    try {
+        if (!_output)
+            openOutput();
+        writeRecord(key, value);
+        _size += sizeof(BlobCacheRecordHeader) + key.size() + value.size();
+    } catch (const std::exception &) {
+        // Out of disk space or similar. Stop writing & leave the cache file as it is.
+        if (_output)
+            _output->discard();
+        _output.reset();
+        _failed = true;
+    }
+}
+
+void BlobCache::openOutput() {
+    _output = std::make_unique<TempFileOutputStream>(_path);
+    _output->write(_signature.data(), SIGNATURE_SIZE);
+}
+
+void BlobCache::writeRecord(std::string_view key, const Blob &value) {
+    BlobCacheRecordHeader header;
+    header.keySize = key.size();
+    header.valueSize = value.size();
+    _output->write(&header, sizeof(header));
+    _output->write(key.data(), key.size());
+    _output->write(value.data(), value.size());
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Utility/Memory/Blob.h"
+
+class TempFileOutputStream;
+
+/**
+ * Persistent on-disk key-value store, a building block for the caches of derived data.
+ *
+ * Cache file is memory-mapped on open, and the cached values are returned as subblobs of the mapping, so a lookup
+ * doesn't copy anything.
+ *
+ * Cache file is never modified in place - other processes might have it mapped, and truncating a mapped file makes
+ * them crash on the next access. Instead, the values added during a session are written into a private temporary
+ * file, which on `close` also gets all the surviving old records, and is then moved over the cache file. If several
+ * processes are using the same cache file, the last one to close wins and the values added by the others are lost,
+ * which is fine for a cache.
+ *
+ * If the cache file grows beyond the size limit, only the records that were used during the current session survive
+ * the rewrite on `close`.
+ *
+ * This class is thread-safe.
+ */
+class BlobCache {
+ public:
+    BlobCache();
+    ~BlobCache();
+
+    /**
+     * @param path                      Path to the cache file. It's OK if the file doesn't exist or is not a valid
+     *                                  cache file, it will be replaced on `close`.
+     * @param signature                 Signature of the cache file format, 8 characters at most. Files with a
+     *                                  different signature are treated as invalid.
+     * @param maxSize                   Size limit for the cache file, in bytes.
+     * @throw Exception                 If the cache file exists, but couldn't be read.
+     */
+    void open(std::string_view path, std::string_view signature, size_t maxSize);
+
+    /**
+     * Closes this cache, writing out the new cache file if needed. Errors are ignored, losing the added values is
+     * not a problem for a cache.
+     */
+    void close();
+
+    [[nodiscard]] bool isOpen() const {
+        return !_path.empty();
+    }
+
+    /**
+     * Note that the values added during the current session are not kept in memory, and are not returned by this
+     * function until the cache is reopened.
+     *
+     * @param key                       Key to look up.
+     * @return                          Cached value, or `std::nullopt` if there is no value for `key`.
+     */
+    [[nodiscard]] std::optional<Blob> find(const std::string &key);
+
+    /**
+     * Adds a value to the cache. Does nothing if there already is a value for `key`. Write errors are ignored, and
+     * disable all further writes until the cache is reopened.
+     *
+     * @param key                       Key to store the value under.
+     * @param value                     Value to store.
+     */
+    void insert(const std::string &key, const Blob &value);
+
+ private:
+    struct Record {
+        Blob value; // Subblob of `_mapping`, empty for the records added during the current session.
+        bool used = false;
+        bool added = false;
+    };
+
+    void openOutput();
+    void writeRecord(std::string_view key, const Blob &value);
+
+ private:
+    std::mutex _mutex;
+    std::string _path;
+    std::string _signature;
+    size_t _maxSize = 0;
+    size_t _size = 0; // Total size of the old & added records, with the signature.
+    bool _valid = false; // Whether the cache file was valid when opened.
+    bool _failed = false; // Whether there was a write error.
+    Blob _mapping;
+    std::unordered_map<std::string, Record> _recordByKey;
+    std::unique_ptr<TempFileOutputStream> _output; // New cache file, created on first write.
+};
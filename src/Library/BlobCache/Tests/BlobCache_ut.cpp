@@ -0,0 +1,107 @@
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/BlobCache/BlobCache.h"
+
+#include "Utility/Streams/FileOutputStream.h"
+
+static const char *CACHE_PATH = "tmp_blob_cache.bin";
+
+UNIT_TEST(BlobCache, RoundTrip) {
+    BlobCache cache;
+    cache.open(CACHE_PATH, "TEST", 1024 * 1024);
+    EXPECT_FALSE(cache.find("a"));
+    cache.insert("a", Blob::fromString("123"));
+    cache.insert("b", Blob::fromString(""));
+    cache.insert("a", Blob::fromString("456")); // Ignored.
+    EXPECT_FALSE(cache.find("a")); // Added values are not kept in memory.
+    cache.close();
+
+    cache.open(CACHE_PATH, "TEST", 1024 * 1024);
+    std::optional<Blob> a = cache.find("a");
+    std::optional<Blob> b = cache.find("b");
+    ASSERT_TRUE(a && b);
+    EXPECT_EQ(a->string_view(), "123");
+    EXPECT_EQ(b->size(), 0);
+    cache.insert("c", Blob::fromString("789"));
+    cache.close();
+
+    cache.open(CACHE_PATH, "TEST", 1024 * 1024);
+    EXPECT_TRUE(cache.find("a"));
+    EXPECT_TRUE(cache.find("b"));
+    EXPECT_TRUE(cache.find("c"));
+    cache.close();
+
+    // Different signature - cache is discarded.
+    cache.open(CACHE_PATH, "TEST2", 1024 * 1024);
+    EXPECT_FALSE(cache.find("a"));
+    cache.close();
+
+    remove(CACHE_PATH);
+}
+
+UNIT_TEST(BlobCache, MappedFileIsNotModified) {
+    BlobCache cache;
+    cache.open(CACHE_PATH, "TEST", 1024 * 1024);
+    cache.insert("a", Blob::fromString("123"));
+    cache.close();
+
+    // Another process might have the cache mapped & reading from it, the data it sees shouldn't change.
+    Blob mapping = Blob::fromFile(CACHE_PATH);
+    std::string contents(mapping.string_view());
+
+    cache.open(CACHE_PATH, "TEST", 1024 * 1024);
+    cache.insert("b", Blob::fromString("456"));
+    cache.close();
+
+    EXPECT_EQ(mapping.string_view(), contents);
+    mapping = Blob();
+
+    remove(CACHE_PATH);
+}
+
+UNIT_TEST(BlobCache, InvalidFile) {
+    FileOutputStream output(CACHE_PATH);
+    output.write("TEST\0\0\0\0\xff\xff", 10); // Truncated record.
+    output.close();
+
+    BlobCache cache;
+    cache.open(CACHE_PATH, "TEST", 1024 * 1024);
+    cache.insert("a", Blob::fromString("123"));
+    cache.close();
+
+    cache.open(CACHE_PATH, "TEST", 1024 * 1024);
+    EXPECT_TRUE(cache.find("a"));
+    cache.close();
+
+    remove(CACHE_PATH);
+}
+
+UNIT_TEST(BlobCache, SizeLimit) {
+    std::string value(1000, 'x');
+
+    BlobCache cache;
+    cache.open(CACHE_PATH, "TEST", 2500);
+    cache.insert("a", Blob::view(value));
+    cache.insert("b", Blob::view(value));
+    cache.insert("c", Blob::view(value));
+    cache.close();
+
+    // Over the limit, so only the values used in the next session should survive.
+    cache.open(CACHE_PATH, "TEST", 2500);
+    EXPECT_TRUE(cache.find("b"));
+    cache.close();
+    EXPECT_LT(std::filesystem::file_size(CACHE_PATH), 2500);
+
+    cache.open(CACHE_PATH, "TEST", 2500);
+    EXPECT_FALSE(cache.find("a"));
+    EXPECT_TRUE(cache.find("b"));
+    EXPECT_FALSE(cache.find("c"));
+    cache.close();
+
+    remove(CACHE_PATH);
+}
@@ -0,0 +1,29 @@
+#include "CliCommand.h"
+
+#include <cstdlib>
+
+#include "Utility/Format.h"
+
+std::string quoteCommandLineArgument(std::string_view arg) {
+    std::string result = "\"";
+    for (char c : arg) {
+#ifdef _WINDOWS
+        if (c == '"')
+            result += '\\';
+#else
+        if (c == '"' || c == '\\' || c == '$' || c == '`')
+            result += '\\';
+#endif
+        result += c;
+    }
+    result += '"';
+    return result;
+}
+
+int runCommandLine(std::string_view commandLine, std::string_view outputPath) {
+    std::string command = fmt::format("{} > {} 2>&1", commandLine, quoteCommandLineArgument(outputPath));
+#ifdef _WINDOWS
+    command = "\"" + command + "\""; // cmd.exe strips the outer quotes.
+#endif
+    return std::system(command.c_str());
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/**
+ * @param arg                           Argument to quote.
+ * @return                              Argument quoted so that it can be used in a command line passed to
+ *                                      `runCommandLine` as is.
+ */
+std::string quoteCommandLineArgument(std::string_view arg);
+
+/**
+ * Runs a command line through the system shell and waits for it to finish. Can be called concurrently from several
+ * threads to run several processes in parallel.
+ *
+ * @param commandLine                   Command line to run, arguments should be quoted with
+ *                                      `quoteCommandLineArgument`.
+ * @param outputPath                    Path to the file to redirect both stdout and stderr of the process into.
+ * @return                              Exit code of the process, zero means success.
+ */
+int runCommandLine(std::string_view commandLine, std::string_view outputPath);
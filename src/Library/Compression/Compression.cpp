@@ -2,44 +2,90 @@
 
 #include <zlib.h>
 
+#include <cassert>
 #include <cstring>
 #include <algorithm>
+#include <exception>
 #include <memory>
 
 #include "Utility/Memory/FreeDeleter.h"
+#include "Utility/Thread/ThreadPool.h"
 
-namespace zlib {
+// Number of blobs per parallel task in batch zlib::uncompress. There might be hundreds of small blobs, so we don't
+// want a task per blob.
+static constexpr size_t UNCOMPRESS_CHUNK_SIZE = 4;
 
-Blob compress(const Blob &source) {
-    uLongf destLen = source.size();
-    std::unique_ptr<void, FreeDeleter> dest;
-    int res = Z_BUF_ERROR;
-    while (res == Z_BUF_ERROR) {
-        if (dest) {
-            dest.reset();
-            destLen *= 2;
-        }
-        dest.reset(malloc(destLen));
-        res = ::compress(static_cast<Bytef *>(dest.get()), &destLen, static_cast<const Bytef *>(source.data()), source.size());
+static int zlibLevel(CompressionLevel level) {
+    switch (level) {
+    case COMPRESSION_FASTEST: return Z_BEST_SPEED;
+    case COMPRESSION_DEFAULT: return Z_DEFAULT_COMPRESSION;
+    case COMPRESSION_SMALLEST: return Z_BEST_COMPRESSION;
+    default:
+        assert(false);
+        return Z_DEFAULT_COMPRESSION;
     }
+}
+
+namespace zlib {
+
+Blob compress(const Blob &source, CompressionLevel level) {
+    uLongf destLen = compressBound(source.size());
+    std::unique_ptr<void, FreeDeleter> dest(malloc(destLen));
+    int res = ::compress2(static_cast<Bytef *>(dest.get()), &destLen, static_cast<const Bytef *>(source.data()), source.size(), zlibLevel(level));
 
     return res == Z_OK ? Blob::copy(dest.get(), destLen) : Blob();
 }
 
 Blob uncompress(const Blob &source, size_t sizeHint) {
-    uLongf destLen = sizeHint > source.size() ? sizeHint : source.size() * 4;
+    uLongf capacity = std::max<uLongf>(sizeHint > source.size() ? sizeHint : source.size() * 4, 1);
+    uLongf destLen = capacity;
     std::unique_ptr<void, FreeDeleter> dest;
     int res = Z_BUF_ERROR;
     while (res == Z_BUF_ERROR) {
         if (dest) {
             dest.reset();
-            destLen *= 2;
+            capacity *= 2;
+            destLen = capacity;
         }
-        dest.reset(malloc(destLen));
+        dest.reset(malloc(capacity));
         res = ::uncompress(static_cast<Bytef *>(dest.get()), &destLen, static_cast<const Bytef *>(source.data()), source.size());
     }
 
-    return res == Z_OK ? Blob::copy(dest.get(), destLen) : Blob();
+    if (res != Z_OK)
+        return Blob();
+
+    // Size hints are usually exact, so in most cases we can just hand the buffer over without copying.
+    if (destLen == capacity)
+        return Blob::fromMalloc(std::move(dest), destLen);
+    return Blob::copy(dest.get(), destLen);
+}
+
+std::vector<Blob> uncompress(std::span<const Blob> sources, std::span<const size_t> sizeHints, ThreadPool *pool) {
+    assert(sizeHints.empty() || sizeHints.size() == sources.size());
+
+    std::vector<Blob> result(sources.size());
+    if (!pool) {
+        for (size_t i = 0; i < sources.size(); i++)
+            result[i] = uncompress(sources[i], sizeHints.empty() ? 0 : sizeHints[i]);
+        return result;
+    }
+
+    // This might be called from a pool task, so we're using parallelFor that doesn't block on the other queued tasks.
+    // Chunk functions must not throw, so exceptions are collected per chunk & rethrown once all chunks are done.
+    std::vector<std::exception_ptr> exceptions((sources.size() + UNCOMPRESS_CHUNK_SIZE - 1) / UNCOMPRESS_CHUNK_SIZE);
+    pool->parallelFor(sources.size(), UNCOMPRESS_CHUNK_SIZE, [&](size_t begin, size_t end) {
+        try {
+            for (size_t i = begin; i < end; i++)
+                result[i] = uncompress(sources[i], sizeHints.empty() ? 0 : sizeHints[i]);
+        } catch (...) {
+            exceptions[begin / UNCOMPRESS_CHUNK_SIZE] = std::current_exception();
+        }
+    });
+
+    for (const std::exception_ptr &exception : exceptions)
+        if (exception)
+            std::rethrow_exception(exception);
+    return result;
 }
 
 };  // namespace zlib
@@ -1,8 +1,42 @@
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include "Utility/Memory/Blob.h"
 
+class ThreadPool;
+
+enum class CompressionLevel {
+    COMPRESSION_FASTEST, // Fastest compression, worst compression ratio.
+    COMPRESSION_DEFAULT, // Default compromise between speed & compression ratio.
+    COMPRESSION_SMALLEST, // Slowest compression, best compression ratio.
+};
+using enum CompressionLevel;
+
 namespace zlib {
-Blob compress(const Blob &source);
+/**
+ * @param source                        Data to compress.
+ * @param level                         Compression level. Note that the output is a regular zlib stream
+ *                                      regardless of the level, and can be uncompressed with `uncompress`.
+ * @return                              Compressed data, or an empty `Blob` on error.
+ */
+Blob compress(const Blob &source, CompressionLevel level = COMPRESSION_DEFAULT);
 Blob uncompress(const Blob &source, size_t sizeHint = 0);
+
+/**
+ * Batch version of `uncompress` that decompresses all the provided blobs in parallel on the provided thread pool.
+ * The calling thread takes part in the work, so it's OK to call this function from a task that's running on `pool`.
+ *
+ * @param sources                       Compressed blobs.
+ * @param sizeHints                     Uncompressed size hints, must be either empty or of the same size
+ *                                      as `sources`.
+ * @param pool                          Thread pool to use. If `nullptr` is passed, then decompression is performed
+ *                                      on the calling thread.
+ * @return                              Uncompressed blobs, in the same order as `sources`. Blobs that couldn't be
+ *                                      uncompressed are returned empty, just like in the single-blob version.
+ * @throws std::exception               If decompression of some of the blobs threw. The exception is rethrown only
+ *                                      after all the other blobs were processed.
+ */
+std::vector<Blob> uncompress(std::span<const Blob> sources, std::span<const size_t> sizeHints, ThreadPool *pool);
 };  // namespace zlib
@@ -0,0 +1,73 @@
+#include <future>
+#include <string>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Compression/Compression.h"
+
+#include "Utility/Thread/ThreadPool.h"
+
+UNIT_TEST(Compression, RoundTrip) {
+    std::string data = std::string(10000, 'a') + "lolkek" + std::string(10000, 'b');
+
+    Blob compressed = zlib::compress(Blob::view(data));
+    EXPECT_LT(compressed.size(), data.size());
+    EXPECT_EQ(zlib::uncompress(compressed).string_view(), data);
+    EXPECT_EQ(zlib::uncompress(compressed, data.size()).string_view(), data);
+    EXPECT_EQ(zlib::uncompress(compressed, 1).string_view(), data); // Wrong hint should still work.
+}
+
+UNIT_TEST(Compression, Levels) {
+    std::string data;
+    for (int i = 0; i < 10000; i++)
+        data += std::to_string(i * i);
+
+    for (CompressionLevel level : {COMPRESSION_FASTEST, COMPRESSION_DEFAULT, COMPRESSION_SMALLEST}) {
+        Blob compressed = zlib::compress(Blob::view(data), level);
+        EXPECT_LT(compressed.size(), data.size());
+        EXPECT_EQ(zlib::uncompress(compressed, data.size()).string_view(), data);
+    }
+}
+
+UNIT_TEST(Compression, Batch) {
+    std::vector<std::string> data;
+    std::vector<Blob> compressed;
+    std::vector<size_t> sizeHints;
+    for (int i = 0; i < 100; i++) {
+        data.push_back(std::string(i * 100, 'a' + i % 26));
+        compressed.push_back(zlib::compress(Blob::view(data.back())));
+        sizeHints.push_back(data.back().size());
+    }
+
+    ThreadPool pool(4);
+    std::vector<Blob> result = zlib::uncompress(compressed, sizeHints, &pool);
+    ASSERT_EQ(result.size(), data.size());
+    for (size_t i = 0; i < data.size(); i++)
+        EXPECT_EQ(result[i].string_view(), data[i]);
+
+    result = zlib::uncompress(compressed, {}, nullptr);
+    ASSERT_EQ(result.size(), data.size());
+    for (size_t i = 0; i < data.size(); i++)
+        EXPECT_EQ(result[i].string_view(), data[i]);
+}
+
+UNIT_TEST(Compression, BatchFromPoolTasks) {
+    std::string data = std::string(10000, 'a') + "lolkek";
+    std::vector<Blob> compressed;
+    for (int i = 0; i < 20; i++)
+        compressed.push_back(zlib::compress(Blob::view(data)));
+
+    // All workers are busy calling the batch version, this shouldn't deadlock.
+    ThreadPool pool(2);
+    std::vector<std::future<std::vector<Blob>>> futures;
+    for (int i = 0; i < 4; i++)
+        futures.push_back(pool.run([&] { return zlib::uncompress(compressed, {}, &pool); }));
+
+    for (std::future<std::vector<Blob>> &future : futures) {
+        std::vector<Blob> result = future.get();
+        ASSERT_EQ(result.size(), compressed.size());
+        for (const Blob &blob : result)
+            EXPECT_EQ(blob.string_view(), data);
+    }
+}
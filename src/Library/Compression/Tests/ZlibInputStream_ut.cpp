@@ -0,0 +1,52 @@
+#include <string>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Compression/Compression.h"
+#include "Library/Compression/ZlibInputStream.h"
+
+#include "Utility/Exception.h"
+
+UNIT_TEST(ZlibInputStream, ReadAll) {
+    std::string data;
+    for (int i = 0; i < 100000; i++)
+        data += std::to_string(i * 7);
+
+    ZlibInputStream stream(zlib::compress(Blob::view(data)));
+    EXPECT_EQ(stream.readAll(), data);
+}
+
+UNIT_TEST(ZlibInputStream, ReadInChunks) {
+    std::string data = std::string(10000, 'a') + "lolkek" + std::string(10000, 'b');
+
+    ZlibInputStream stream(zlib::compress(Blob::view(data)));
+    std::string result;
+    char buffer[777];
+    while (true) {
+        size_t bytes = stream.read(buffer, sizeof(buffer));
+        result.append(buffer, bytes);
+        if (bytes < sizeof(buffer))
+            break;
+    }
+    EXPECT_EQ(result, data);
+    EXPECT_EQ(stream.read(buffer, sizeof(buffer)), 0);
+}
+
+UNIT_TEST(ZlibInputStream, Skip) {
+    std::string data = std::string(10000, 'a') + "lolkek" + std::string(10000, 'b');
+
+    ZlibInputStream stream(zlib::compress(Blob::view(data)));
+    EXPECT_EQ(stream.skip(10000), 10000);
+    char buffer[6];
+    stream.readOrFail(buffer, sizeof(buffer));
+    EXPECT_EQ(std::string_view(buffer, sizeof(buffer)), "lolkek");
+    EXPECT_EQ(stream.skip(20000), 10000);
+}
+
+UNIT_TEST(ZlibInputStream, Corrupted) {
+    std::string data = "this is not a zlib stream at all";
+
+    ZlibInputStream stream(Blob::view(data));
+    char buffer[16];
+    EXPECT_THROW((void) stream.read(buffer, sizeof(buffer)), Exception);
+}
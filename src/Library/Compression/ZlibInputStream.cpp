@@ -0,0 +1,91 @@
+#include "ZlibInputStream.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+
+#include "Utility/Exception.h"
+
+ZlibInputStream::ZlibInputStream() = default;
+
+ZlibInputStream::ZlibInputStream(Blob &&compressed) {
+    open(std::move(compressed));
+}
+
+ZlibInputStream::ZlibInputStream(const Blob &compressed) : ZlibInputStream(Blob::share(compressed)) {}
+
+ZlibInputStream::~ZlibInputStream() {
+    close();
+}
+
+void ZlibInputStream::open(Blob &&compressed) {
+    close();
+
+    std::unique_ptr<z_stream_s> zstream = std::make_unique<z_stream_s>();
+    zstream->zalloc = Z_NULL;
+    zstream->zfree = Z_NULL;
+    zstream->opaque = Z_NULL;
+    zstream->next_in = static_cast<Bytef *>(const_cast<void *>(compressed.data()));
+    zstream->avail_in = 0; // Set up in `read`, blob might not fit into `uInt`.
+    if (inflateInit(zstream.get()) != Z_OK)
+        throw Exception("Failed to initialize zlib inflate stream");
+
+    _compressed = std::move(compressed);
+    _zstream = std::move(zstream);
+    _eof = false;
+}
+
+size_t ZlibInputStream::read(void *data, size_t size) {
+    assert(isOpen());
+
+    const Bytef *begin = static_cast<const Bytef *>(_compressed.data());
+    const Bytef *end = begin + _compressed.size();
+
+    Bytef *out = static_cast<Bytef *>(data);
+    size_t result = 0;
+    while (result < size && !_eof) {
+        const Bytef *in = _zstream->next_in;
+        _zstream->avail_in = std::min<size_t>(end - in, std::numeric_limits<uInt>::max());
+        _zstream->next_out = out + result;
+        _zstream->avail_out = std::min<size_t>(size - result, std::numeric_limits<uInt>::max());
+        uInt availOut = _zstream->avail_out;
+
+        int res = inflate(_zstream.get(), Z_NO_FLUSH);
+        result += availOut - _zstream->avail_out;
+
+        if (res == Z_STREAM_END) {
+            _eof = true;
+        } else if (res == Z_BUF_ERROR && _zstream->avail_in == 0) {
+            _eof = true; // Truncated input, treat as end of stream.
+        } else if (res != Z_OK && res != Z_BUF_ERROR) {
+            throw Exception("Failed to inflate a zlib stream: {}", _zstream->msg ? _zstream->msg : "unknown error");
+        }
+    }
+
+    return result;
+}
+
+size_t ZlibInputStream::skip(size_t size) {
+    char buffer[4096];
+    size_t result = 0;
+    while (result < size) {
+        size_t chunk = std::min(size - result, sizeof(buffer));
+        size_t bytes = read(buffer, chunk);
+        result += bytes;
+        if (bytes < chunk)
+            break;
+    }
+    return result;
+}
+
+void ZlibInputStream::close() {
+    // Double-closing is OK.
+    if (_zstream)
+        inflateEnd(_zstream.get());
+    _zstream.reset();
+    _compressed = Blob();
+    _eof = false;
+}
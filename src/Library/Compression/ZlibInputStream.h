@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+
+#include "Utility/Memory/Blob.h"
+#include "Utility/Streams/InputStream.h"
+
+struct z_stream_s;
+
+/**
+ * Input stream that inflates zlib-compressed data on the fly.
+ *
+ * Compared to `zlib::uncompress`, this doesn't need a buffer for the whole uncompressed data, and the consumer can
+ * start processing the data before it's fully uncompressed.
+ */
+class ZlibInputStream : public InputStream {
+ public:
+    ZlibInputStream();
+    explicit ZlibInputStream(Blob &&compressed);
+    explicit ZlibInputStream(const Blob &compressed); // Shares the blob and stores the shared copy in this object.
+    virtual ~ZlibInputStream();
+
+    /**
+     * @param compressed                Zlib-compressed data to read from.
+     */
+    void open(Blob &&compressed);
+
+    [[nodiscard]] bool isOpen() const {
+        return !!_zstream;
+    }
+
+    /**
+     * @throws Exception                If the compressed data is corrupted.
+     */
+    [[nodiscard]] virtual size_t read(void *data, size_t size) override;
+
+    /**
+     * @throws Exception                If the compressed data is corrupted.
+     */
+    [[nodiscard]] virtual size_t skip(size_t size) override;
+    virtual void close() override;
+
+ private:
+    Blob _compressed;
+    std::unique_ptr<z_stream_s> _zstream;
+    bool _eof = false;
+};
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <utility>
+#include <vector>
 
 #include "ConfigSection.h"
 #include "AnyHandler.h"
@@ -33,6 +34,15 @@ void AnyConfigEntry::setValue(std::any value) {
         return;
 
     _value = std::move(value);
+    changed();
+}
+
+void AnyConfigEntry::reset() {
+    if (_handler->equals(_defaultValue, _value))
+        return;
+
+    _value = _defaultValue;
+    changed();
 }
 
 std::string AnyConfigEntry::defaultString() const {
@@ -46,3 +56,19 @@ std::string AnyConfigEntry::string() const {
 void AnyConfigEntry::setString(const std::string &value) {
     setValue(_handler->deserialize(value));
 }
+
+void AnyConfigEntry::addListener(const void *owner, Listener listener) {
+    assert(listener);
+
+    _listeners.emplace_back(owner, std::move(listener));
+}
+
+void AnyConfigEntry::removeListeners(const void *owner) {
+    std::erase_if(_listeners, [owner](const auto &pair) { return pair.first == owner; });
+}
+
+void AnyConfigEntry::changed() {
+    syncValue();
+    for (const auto &[owner, listener] : _listeners)
+        listener();
+}
@@ -3,6 +3,7 @@
 #include <string>
 #include <functional>
 #include <any>
+#include <utility>
 #include <vector>
 
 #include "ConfigFwd.h"
@@ -10,6 +11,7 @@
 class AnyConfigEntry {
  public:
     using Validator = std::function<std::any(std::any)>;
+    using Listener = std::function<void()>;
 
     AnyConfigEntry(ConfigSection *section, const std::string &name, const std::string &description, AnyHandler *handler,
                    std::any defaultValue, Validator validator);
@@ -29,9 +31,7 @@ class AnyConfigEntry {
 
     void setValue(std::any value);
 
-    void reset() {
-        _value = _defaultValue;
-    }
+    void reset();
 
     std::string defaultString() const;
 
@@ -51,11 +51,34 @@ class AnyConfigEntry {
         return _description;
     }
 
+    /**
+     * Adds a listener that's invoked every time this config entry's value is changed. Can be used by subsystems to
+     * cache state that's derived from config values.
+     *
+     * @param owner                     Owner of the listener, can be used to remove the listener later.
+     * @param listener                  Callback to invoke after the value has changed.
+     */
+    void addListener(const void *owner, Listener listener);
+
+    /**
+     * @param owner                     Owner of the listeners to remove, as passed to `addListener`.
+     */
+    void removeListeners(const void *owner);
+
  protected:
     Validator validator() const {
         return _validator;
     }
 
+    /**
+     * Called after the value has changed, before the listeners are notified. Derived classes can use this to update
+     * their own copies of the value.
+     */
+    virtual void syncValue() {}
+
+ private:
+    void changed();
+
  private:
     ConfigSection *_section = nullptr;
     std::string _name;
@@ -64,4 +87,5 @@ class AnyConfigEntry {
     std::any _defaultValue;
     std::any _value;
     Validator _validator = nullptr;
+    std::vector<std::pair<const void *, Listener>> _listeners;
 };
@@ -19,17 +19,21 @@ class ConfigEntry : public AnyConfigEntry {
 
     template<class TypedValidator>
     ConfigEntry(ConfigSection *section, const std::string &name, T defaultValue, TypedValidator validator, const std::string &description) :
-        AnyConfigEntry(section, name, description, AnyHandler::forType<T>(), defaultValue, wrapValidator(std::move(validator))) {}
+        AnyConfigEntry(section, name, description, AnyHandler::forType<T>(), defaultValue, wrapValidator(std::move(validator))),
+        _value(std::move(defaultValue)) {}
 
     ConfigEntry(ConfigSection *section, const std::string &name, T defaultValue, const std::string &description) :
-        AnyConfigEntry(section, name, description, AnyHandler::forType<T>(), defaultValue, nullptr) {}
+        AnyConfigEntry(section, name, description, AnyHandler::forType<T>(), defaultValue, nullptr),
+        _value(std::move(defaultValue)) {}
 
     const T &defaultValue() const {
         return std::any_cast<const T &>(AnyConfigEntry::defaultValue());
     }
 
     const T &value() const {
-        return std::any_cast<const T &>(AnyConfigEntry::value());
+        // Config values are read in a lot of places every frame, so we're returning a typed copy here and not
+        // going through std::any_cast.
+        return _value;
     }
 
     void setValue(T value) {
@@ -66,6 +70,11 @@ class ConfigEntry : public AnyConfigEntry {
             setValue(INT_MAX);
     }
 
+ protected:
+    virtual void syncValue() override {
+        _value = std::any_cast<const T &>(AnyConfigEntry::value());
+    }
+
  private:
     template<class TypedValidator>
     static Validator wrapValidator(TypedValidator validator) {
@@ -73,4 +82,7 @@ class ConfigEntry : public AnyConfigEntry {
             return std::any(std::in_place_type<T>, validator(std::any_cast<T &&>(std::move(value))));
         };
     }
+
+ private:
+    T _value;
 };
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <string>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Config/Config.h"
+
+class TestConfig : public Config {
+ public:
+    class Section : public ConfigSection {
+     public:
+        explicit Section(TestConfig *config) : ConfigSection(config, "test") {}
+
+        ConfigEntry<int> count = {this, "count", 10, [](int value) { return std::clamp(value, 0, 100); }, ""};
+        ConfigEntry<std::string> name = {this, "name", "default", ""};
+    };
+
+    Section test{this};
+};
+
+UNIT_TEST(Config, TypedValue) {
+    TestConfig config;
+    EXPECT_EQ(config.test.count.value(), 10);
+    EXPECT_EQ(config.test.name.value(), "default");
+
+    config.test.count.setValue(1000);
+    EXPECT_EQ(config.test.count.value(), 100); // Validator should've been applied.
+
+    config.test.name.setString("other");
+    EXPECT_EQ(config.test.name.value(), "other");
+
+    config.reset();
+    EXPECT_EQ(config.test.count.value(), 10);
+    EXPECT_EQ(config.test.name.value(), "default");
+}
+
+UNIT_TEST(Config, Listeners) {
+    TestConfig config;
+
+    int calls = 0;
+    int lastValue = 0;
+    config.test.count.addListener(&calls, [&] {
+        calls++;
+        lastValue = config.test.count.value();
+    });
+
+    config.test.count.setValue(20);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(lastValue, 20);
+
+    config.test.count.setValue(20); // Not a change.
+    EXPECT_EQ(calls, 1);
+
+    config.test.count.increment();
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(lastValue, 21);
+
+    config.test.count.reset();
+    EXPECT_EQ(calls, 3);
+    EXPECT_EQ(lastValue, 10);
+
+    config.test.count.removeListeners(&calls);
+    config.test.count.setValue(30);
+    EXPECT_EQ(calls, 3);
+}
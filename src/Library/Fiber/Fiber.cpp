@@ -0,0 +1,197 @@
+#if defined(__APPLE__)
+// ucontext routines are deprecated on macOS and are only declared in XSI mode. They still work just fine.
+#   define _XOPEN_SOURCE 600
+#endif
+
+#include "Fiber.h"
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+#if defined(_WINDOWS)
+#   include <Windows.h>
+#elif defined(__ANDROID__)
+#   include <condition_variable>
+#   include <mutex>
+#   include <thread>
+#else
+#   include <ucontext.h>
+#endif
+
+#include "Utility/Exception.h"
+
+static thread_local Fiber *globalCurrentFiber = nullptr;
+
+#if defined(_WINDOWS)
+
+class FiberImpl {
+ public:
+    FiberImpl(Fiber *owner, size_t stackSize) : _owner(owner) {
+        _fiber = CreateFiberEx(0, stackSize, FIBER_FLAG_FLOAT_SWITCH, &FiberImpl::entry, this);
+        if (!_fiber)
+            throw Exception("Could not create a fiber, error code {}", GetLastError());
+    }
+
+    ~FiberImpl() {
+        DeleteFiber(_fiber);
+    }
+
+    void switchIn() {
+        // Only fibers can switch to other fibers. The calling thread is left converted, there's no harm in that.
+        if (!IsThreadAFiber() && !ConvertThreadToFiberEx(nullptr, FIBER_FLAG_FLOAT_SWITCH))
+            throw Exception("Could not convert thread to a fiber, error code {}", GetLastError());
+
+        _caller = GetCurrentFiber();
+        SwitchToFiber(_fiber);
+    }
+
+    void switchOut() {
+        SwitchToFiber(_caller);
+    }
+
+ private:
+    static void WINAPI entry(void *param) {
+        FiberImpl *self = static_cast<FiberImpl *>(param);
+        self->_owner->run();
+        SwitchToFiber(self->_caller); // Returning from a fiber function terminates the thread, so we never do that.
+    }
+
+ private:
+    Fiber *_owner = nullptr;
+    void *_fiber = nullptr;
+    void *_caller = nullptr;
+};
+
+#elif defined(__ANDROID__)
+
+// Bionic doesn't have ucontext routines, so we have to fall back to threads. Note that stack size is ignored here.
+class FiberImpl {
+ public:
+    FiberImpl(Fiber *owner, size_t /*stackSize*/) : _owner(owner) {}
+
+    ~FiberImpl() {
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    void switchIn() {
+        std::unique_lock lock(_mutex);
+        if (!_thread.joinable())
+            _thread = std::thread(&FiberImpl::threadMain, this);
+
+        _insideFiber = true;
+        _wakeEvent.notify_all();
+        _wakeEvent.wait(lock, [&] { return !_insideFiber; });
+    }
+
+    void switchOut() {
+        std::unique_lock lock(_mutex);
+        _insideFiber = false;
+        _wakeEvent.notify_all();
+        _wakeEvent.wait(lock, [&] { return _insideFiber; });
+    }
+
+ private:
+    void threadMain() {
+        {
+            std::unique_lock lock(_mutex);
+            _wakeEvent.wait(lock, [&] { return _insideFiber; });
+        }
+
+        globalCurrentFiber = _owner;
+        _owner->run();
+
+        std::unique_lock lock(_mutex);
+        _insideFiber = false;
+        _wakeEvent.notify_all();
+    }
+
+ private:
+    Fiber *_owner = nullptr;
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _wakeEvent;
+    bool _insideFiber = false;
+};
+
+#else
+
+class FiberImpl {
+ public:
+    FiberImpl(Fiber *owner, size_t stackSize) : _owner(owner), _stack(new char[stackSize]) {
+        // Stack memory is intentionally left uninitialized, so that the OS can commit it lazily.
+        if (getcontext(&_context) != 0)
+            throw Exception("Could not create a fiber, getcontext failed");
+        _context.uc_stack.ss_sp = _stack.get();
+        _context.uc_stack.ss_size = stackSize;
+        _context.uc_link = &_caller; // Switch back into the last resume() call once the fiber function returns.
+
+        // makecontext can only pass int arguments, so we have to split the pointer.
+        uint64_t self = reinterpret_cast<uintptr_t>(this);
+        makecontext(&_context, reinterpret_cast<void(*)()>(&FiberImpl::entry), 2,
+                    static_cast<uint32_t>(self >> 32), static_cast<uint32_t>(self));
+    }
+
+    void switchIn() {
+        swapcontext(&_caller, &_context);
+    }
+
+    void switchOut() {
+        swapcontext(&_context, &_caller);
+    }
+
+ private:
+    static void entry(uint32_t hi, uint32_t lo) {
+        FiberImpl *self = reinterpret_cast<FiberImpl *>(static_cast<uintptr_t>((static_cast<uint64_t>(hi) << 32) | lo));
+        self->_owner->run();
+    }
+
+ private:
+    Fiber *_owner = nullptr;
+    std::unique_ptr<char[]> _stack;
+    ucontext_t _context = {};
+    ucontext_t _caller = {};
+};
+
+#endif
+
+Fiber::Fiber(std::function<void()> body, size_t stackSize) :
+    _body(std::move(body)),
+    _impl(std::make_unique<FiberImpl>(this, stackSize)) {
+    assert(_body);
+}
+
+Fiber::~Fiber() = default;
+
+void Fiber::resume() {
+    assert(!_finished);
+    assert(globalCurrentFiber != this);
+
+    Fiber *caller = std::exchange(globalCurrentFiber, this);
+    _impl->switchIn();
+    globalCurrentFiber = caller;
+
+    if (_exception)
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+}
+
+void Fiber::yield() {
+    assert(globalCurrentFiber); // Must be called from inside a fiber.
+
+    globalCurrentFiber->_impl->switchOut();
+}
+
+Fiber *Fiber::current() {
+    return globalCurrentFiber;
+}
+
+void Fiber::run() {
+    // Exceptions can't cross fiber boundaries, so we catch everything here and rethrow from resume().
+    try {
+        _body();
+    } catch (...) {
+        _exception = std::current_exception();
+    }
+    _finished = true;
+}
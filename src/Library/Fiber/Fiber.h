@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+
+class FiberImpl;
+
+/**
+ * Stackful coroutine. Fiber body runs on its own stack, and can suspend itself from any depth of nested calls by
+ * calling `Fiber::yield`, which switches right back into the `resume` call.
+ *
+ * Switching between fibers is cooperative and happens on the thread that's calling `resume`, so no synchronization is
+ * needed for the data that's shared between the fiber and the code that resumes it.
+ *
+ * Uses native fibers on Windows and `ucontext` on other platforms. On platforms without `ucontext` (Android) falls
+ * back to running the fiber body on a separate thread, handing execution back & forth with a condition variable.
+ */
+class Fiber {
+ public:
+    static constexpr size_t DEFAULT_STACK_SIZE = 8 * 1024 * 1024;
+
+    /**
+     * Creates a suspended fiber. Fiber body will start running on the first `resume` call.
+     *
+     * @param body                      Fiber body.
+     * @param stackSize                 Stack size for the fiber, in bytes.
+     */
+    explicit Fiber(std::function<void()> body, size_t stackSize = DEFAULT_STACK_SIZE);
+
+    /**
+     * Fiber must be either finished, or not started at this point.
+     */
+    ~Fiber();
+
+    Fiber(const Fiber &) = delete;
+    Fiber &operator=(const Fiber &) = delete;
+
+    /**
+     * Switches into this fiber, and runs it until it either yields or finishes. Must not be called from inside the
+     * fiber itself.
+     *
+     * @throw                           Whatever the fiber body has thrown, if it has finished with an exception.
+     */
+    void resume();
+
+    /**
+     * @return                          Whether the fiber body has returned.
+     */
+    [[nodiscard]] bool isFinished() const {
+        return _finished;
+    }
+
+    /**
+     * Suspends the currently running fiber, switching back into the `resume` call that has started it. Must be called
+     * from inside a fiber.
+     *
+     * Don't call this function from inside a `catch` block. C++ runtime tracks the exceptions that are being handled
+     * per thread, and switching out of a fiber in the middle of a handler messes this up.
+     */
+    static void yield();
+
+    /**
+     * @return                          Currently running fiber, or `nullptr` if called from outside of a fiber.
+     */
+    [[nodiscard]] static Fiber *current();
+
+ private:
+    friend class FiberImpl;
+
+    void run();
+
+ private:
+    std::function<void()> _body;
+    std::unique_ptr<FiberImpl> _impl;
+    std::exception_ptr _exception;
+    bool _finished = false;
+};
@@ -0,0 +1,78 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Fiber/Fiber.h"
+
+UNIT_TEST(Fiber, ResumeYield) {
+    std::vector<int> log;
+
+    Fiber fiber([&] {
+        EXPECT_NE(Fiber::current(), nullptr);
+        log.push_back(1);
+        Fiber::yield();
+        log.push_back(3);
+        Fiber::yield();
+        log.push_back(5);
+    });
+    EXPECT_EQ(Fiber::current(), nullptr);
+    EXPECT_FALSE(fiber.isFinished());
+
+    fiber.resume();
+    log.push_back(2);
+    fiber.resume();
+    log.push_back(4);
+    EXPECT_FALSE(fiber.isFinished());
+    fiber.resume();
+    EXPECT_TRUE(fiber.isFinished());
+    EXPECT_EQ(Fiber::current(), nullptr);
+
+    EXPECT_EQ(log, (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+static int recurseAndYield(int depth) {
+    if (depth == 0) {
+        Fiber::yield();
+        return 0;
+    }
+
+    volatile char buffer[256] = {}; // Use up some stack.
+    return recurseAndYield(depth - 1) + 1 + buffer[0];
+}
+
+UNIT_TEST(Fiber, NestedYield) {
+    int result = -1;
+    Fiber fiber([&] { result = recurseAndYield(1000); });
+
+    fiber.resume();
+    EXPECT_EQ(result, -1);
+    fiber.resume();
+    EXPECT_EQ(result, 1000);
+    EXPECT_TRUE(fiber.isFinished());
+}
+
+UNIT_TEST(Fiber, Exception) {
+    Fiber fiber([] {
+        Fiber::yield();
+        throw std::runtime_error("42");
+    });
+
+    fiber.resume();
+    try {
+        fiber.resume();
+        FAIL();
+    } catch (const std::runtime_error &e) {
+        EXPECT_EQ(std::string(e.what()), "42");
+    }
+    EXPECT_TRUE(fiber.isFinished());
+}
+
+UNIT_TEST(Fiber, NotStarted) {
+    bool started = false;
+    {
+        Fiber fiber([&] { started = true; });
+    }
+    EXPECT_FALSE(started);
+}
@@ -18,6 +18,10 @@ struct Rect {
         return x <= point.x && point.x < x + w && y <= point.y && point.y < y + h;
     }
 
+    bool intersects(const Rect &other) const {
+        return x < other.x + other.w && other.x < x + w && y < other.y + other.h && other.y < y + h;
+    }
+
     Point<T> topLeft() const {
         return {x, y};
     }
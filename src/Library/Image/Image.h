@@ -10,7 +10,7 @@
 #include "Library/Color/Color.h"
 #include "Library/Geometry/Size.h"
 
-#include "Utility/Memory/FreeDeleter.h"
+#include "Utility/Memory/MemoryAccounting.h"
 #include "Utility/Types.h"
 
 class Blob;
@@ -84,10 +84,13 @@ class ImageBase {
 /**
  * `Image` is a class holding a 2d image, with pixels of type `T`.
  *
+ * Pixel memory is reported to `MemoryAccounting` under the memory tag that's current on the thread that has created
+ * the image.
+ *
  * @see ImageView
  */
 template<class T>
-class Image : public detail::ImageBase<T, std::unique_ptr<T, FreeDeleter>> {
+class Image : public detail::ImageBase<T, std::unique_ptr<T, AccountedFreeDeleter>> {
  public:
     Image() = default;
     Image(const Image &) = delete; // Non-copyable.
@@ -115,10 +118,15 @@ class Image : public detail::ImageBase<T, std::unique_ptr<T, FreeDeleter>> {
         if (width == 0 || height == 0)
             return Image();
 
+        size_t size = width * height * sizeof(T);
+        MemoryTag tag = MemoryAccounting::currentTag();
+        MemoryAccounting::allocate(tag, size);
+
         Image result;
         result._width = width;
         result._height = height;
-        result._pixels.reset(static_cast<T *>(malloc(width * height * sizeof(T))));
+        result._pixels = std::unique_ptr<T, AccountedFreeDeleter>(static_cast<T *>(malloc(size)),
+                                                                  AccountedFreeDeleter(tag, size));
         return result;
     }
 
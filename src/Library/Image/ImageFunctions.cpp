@@ -2,6 +2,8 @@
 
 #include <cassert>
 
+#include "ImageKernels.h"
+
 RgbaImage makeRgbaImage(GrayscaleImageView indexedImage, const Palette &palette) {
     if (!indexedImage)
         return RgbaImage();
@@ -11,9 +13,17 @@ RgbaImage makeRgbaImage(GrayscaleImageView indexedImage, const Palette &palette)
     auto dstPixels = result.pixels();
     assert(srcPixels.size() == dstPixels.size());
 
-    for (size_t i = 0, size = srcPixels.size(); i < size; i++)
-        dstPixels[i] = palette.colors[srcPixels[i]];
+    expandPalette(srcPixels, palette, dstPixels);
+
+    return result;
+}
+
+RgbaImage makeIndexRgbaImage(GrayscaleImageView indexedImage) {
+    if (!indexedImage)
+        return RgbaImage();
 
+    RgbaImage result = RgbaImage::uninitialized(indexedImage.width(), indexedImage.height());
+    expandIndices(indexedImage.pixels(), result.pixels());
     return result;
 }
 
@@ -5,4 +5,11 @@
 
 RgbaImage makeRgbaImage(GrayscaleImageView indexedImage, const Palette &palette);
 
+/**
+ * @param indexedImage                  Indexed image.
+ * @return                              Image with palette indices stored in the red channel, and alpha set to zero
+ *                                      for index zero. This is what the palette shaders take as input.
+ */
+RgbaImage makeIndexRgbaImage(GrayscaleImageView indexedImage);
+
 RgbaImage flipVertically(RgbaImageView image);
@@ -0,0 +1,165 @@
+#include "ImageKernels.h"
+
+#include <cassert>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#   define OE_IMAGE_KERNELS_X86 1
+#   include <immintrin.h>
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   define OE_IMAGE_KERNELS_NEON 1
+#   include <arm_neon.h>
+#endif
+
+#if defined(OE_IMAGE_KERNELS_X86) && !defined(_MSC_VER)
+#   define OE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#   define OE_TARGET_AVX2 // MSVC lets us use AVX2 intrinsics without any annotations.
+#endif
+
+static_assert(sizeof(Color) == 4);
+static_assert(std::endian::native == std::endian::little); // Kernels below rely on r being the lowest byte.
+
+void detail::expandPaletteScalar(std::span<const uint8_t> src, const Palette &palette, std::span<Color> dst) {
+    assert(src.size() == dst.size());
+
+    for (size_t i = 0, size = src.size(); i < size; i++)
+        dst[i] = palette.colors[src[i]];
+}
+
+void detail::expandIndicesScalar(std::span<const uint8_t> src, std::span<Color> dst) {
+    assert(src.size() == dst.size());
+
+    for (size_t i = 0, size = src.size(); i < size; i++)
+        dst[i] = Color(src[i], 0, 0, src[i] == 0 ? 0 : 255);
+}
+
+#ifdef OE_IMAGE_KERNELS_X86
+static bool checkAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    __cpuid(info, 1);
+    bool osxsave = info[2] & (1 << 27);
+    bool avx = info[2] & (1 << 28);
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false; // OS doesn't save YMM registers.
+
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool detail::hasExpandPaletteAvx2() {
+    static const bool result = checkAvx2();
+    return result;
+}
+
+OE_TARGET_AVX2 void detail::expandPaletteAvx2(std::span<const uint8_t> src, const Palette &palette,
+                                               std::span<Color> dst) {
+    assert(src.size() == dst.size());
+    assert(hasExpandPaletteAvx2());
+
+    const int *table = reinterpret_cast<const int *>(palette.colors.data());
+    size_t i = 0;
+    for (size_t size = src.size(); i + 8 <= size; i += 8) {
+        __m128i indices8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src.data() + i));
+        __m256i indices32 = _mm256_cvtepu8_epi32(indices8);
+        __m256i colors = _mm256_i32gather_epi32(table, indices32, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst.data() + i), colors);
+    }
+
+    expandPaletteScalar(src.subspan(i), palette, dst.subspan(i));
+}
+#else
+bool detail::hasExpandPaletteAvx2() {
+    return false;
+}
+
+void detail::expandPaletteAvx2(std::span<const uint8_t>, const Palette &, std::span<Color>) {
+    assert(false);
+}
+#endif
+
+#ifdef OE_IMAGE_KERNELS_X86
+bool detail::hasExpandIndicesSimd() {
+    return true;
+}
+
+void detail::expandIndicesSimd(std::span<const uint8_t> src, std::span<Color> dst) {
+    assert(src.size() == dst.size());
+
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (size_t size = src.size(); i + 16 <= size; i += 16) {
+        __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src.data() + i));
+        __m128i alpha = _mm_andnot_si128(_mm_cmpeq_epi8(indices, zero), _mm_set1_epi8(-1)); // 0xFF for non-zero.
+
+        // Build (index, 0, 0, alpha) byte quads. Low 16-bit halves are (index, 0), high halves are (0, alpha).
+        __m128i lo = _mm_unpacklo_epi8(indices, zero);
+        __m128i hi = _mm_unpackhi_epi8(indices, zero);
+        __m128i alphaLo = _mm_unpacklo_epi8(zero, alpha);
+        __m128i alphaHi = _mm_unpackhi_epi8(zero, alpha);
+
+        __m128i *out = reinterpret_cast<__m128i *>(dst.data() + i);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(lo, alphaLo));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, alphaLo));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, alphaHi));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, alphaHi));
+    }
+
+    expandIndicesScalar(src.subspan(i), dst.subspan(i));
+}
+#elif defined(OE_IMAGE_KERNELS_NEON)
+bool detail::hasExpandIndicesSimd() {
+    return true;
+}
+
+void detail::expandIndicesSimd(std::span<const uint8_t> src, std::span<Color> dst) {
+    assert(src.size() == dst.size());
+
+    size_t i = 0;
+    for (size_t size = src.size(); i + 16 <= size; i += 16) {
+        uint8x16x4_t quads;
+        quads.val[0] = vld1q_u8(src.data() + i);
+        quads.val[1] = vdupq_n_u8(0);
+        quads.val[2] = vdupq_n_u8(0);
+        quads.val[3] = vtstq_u8(quads.val[0], quads.val[0]); // 0xFF for non-zero.
+        vst4q_u8(reinterpret_cast<uint8_t *>(dst.data() + i), quads);
+    }
+
+    expandIndicesScalar(src.subspan(i), dst.subspan(i));
+}
+#else
+bool detail::hasExpandIndicesSimd() {
+    return false;
+}
+
+void detail::expandIndicesSimd(std::span<const uint8_t>, std::span<Color>) {
+    assert(false);
+}
+#endif
+
+void expandPalette(std::span<const uint8_t> src, const Palette &palette, std::span<Color> dst) {
+    if (detail::hasExpandPaletteAvx2()) {
+        detail::expandPaletteAvx2(src, palette, dst);
+    } else {
+        detail::expandPaletteScalar(src, palette, dst);
+    }
+}
+
+void expandIndices(std::span<const uint8_t> src, std::span<Color> dst) {
+    if (detail::hasExpandIndicesSimd()) {
+        detail::expandIndicesSimd(src, dst);
+    } else {
+        detail::expandIndicesScalar(src, dst);
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "Library/Color/Color.h"
+
+#include "Palette.h"
+
+/**
+ * @file
+ *
+ * Pixel conversion kernels used by the functions in `ImageFunctions.h`.
+ *
+ * Each function here dispatches to the best implementation that's supported by the CPU that we're running on. The
+ * implementations themselves are exposed in `detail` so that they can be tested against each other.
+ */
+
+/**
+ * Looks up the provided palette indices in a palette.
+ *
+ * @param src                           Palette indices.
+ * @param palette                       Palette to use.
+ * @param[out] dst                      Output colors, must be the same size as `src`.
+ */
+void expandPalette(std::span<const uint8_t> src, const Palette &palette, std::span<Color> dst);
+
+/**
+ * Stores the provided palette indices in the red channel. Alpha is set to zero for index zero, and to 255 for all
+ * other indices. This is the format that the palette shaders expect.
+ *
+ * @param src                           Palette indices.
+ * @param[out] dst                      Output colors, must be the same size as `src`.
+ */
+void expandIndices(std::span<const uint8_t> src, std::span<Color> dst);
+
+namespace detail {
+void expandPaletteScalar(std::span<const uint8_t> src, const Palette &palette, std::span<Color> dst);
+void expandIndicesScalar(std::span<const uint8_t> src, std::span<Color> dst);
+
+/**
+ * @return                              Whether the AVX2 palette expansion kernel is supported by this CPU.
+ */
+bool hasExpandPaletteAvx2();
+void expandPaletteAvx2(std::span<const uint8_t> src, const Palette &palette, std::span<Color> dst);
+
+/**
+ * @return                              Whether there is a SIMD index expansion kernel for this platform. SSE2 and NEON
+ *                                      are baseline on the platforms that we support, so no runtime checks are needed.
+ */
+bool hasExpandIndicesSimd();
+void expandIndicesSimd(std::span<const uint8_t> src, std::span<Color> dst);
+} // namespace detail
@@ -1,11 +1,14 @@
 #include "PCX.h"
 
 #include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 #include "Utility/Exception.h"
+#include "Utility/Thread/ThreadPool.h"
 
 enum {
     PCX_VERSION_2_5 = 0,
@@ -52,17 +55,6 @@ static inline int bs_get_bytes_left(bstreamer *bs) {
     return bs->buffer_end - bs->buffer;
 }
 
-static inline unsigned int bs_get_byte(bstreamer *bs) {
-    unsigned int byte;
-    if (bs_get_bytes_left(bs) > 0) {
-        byte = bs->buffer[0];
-        bs->buffer++;
-        return byte;
-    }
-
-    return 0;
-}
-
 static inline unsigned int bs_get_buffer(bstreamer *bs, uint8_t *dst, unsigned int size) {
     int size_min = std::min((unsigned int)(bs->buffer_end - bs->buffer), size);
     memcpy(dst, bs->buffer, size_min);
@@ -72,22 +64,37 @@ static inline unsigned int bs_get_buffer(bstreamer *bs, uint8_t *dst, unsigned i
 
 static int pcx_rle_decode(bstreamer *bs, uint8_t *dst, unsigned int bytes_per_scanline, int compressed) {
     unsigned int i = 0;
-    unsigned char run, value;
 
     if (bs_get_bytes_left(bs) < 1)
         return -1;
 
     if (compressed) {
-        while (i < bytes_per_scanline && bs_get_bytes_left(bs) > 0) {
-            run = 1;
-            value = bs_get_byte(bs);
-            if (value >= 0xc0 && bs_get_bytes_left(bs) > 0) {
+        const uint8_t *input = bs->buffer;
+        const uint8_t *end = bs->buffer_end;
+        while (i < bytes_per_scanline && input < end) {
+            // Copy literal spans in one go, they are the majority of the data in 24-bit images.
+            const uint8_t *literalEnd = input;
+            size_t literalLimit = std::min<size_t>(bytes_per_scanline - i, end - input);
+            while (literalEnd < input + literalLimit && *literalEnd < 0xc0)
+                literalEnd++;
+            if (literalEnd != input) {
+                memcpy(dst + i, input, literalEnd - input);
+                i += literalEnd - input;
+                input = literalEnd;
+                continue;
+            }
+
+            unsigned int run = 1;
+            uint8_t value = *input++;
+            if (input < end) {
                 run = value & 0x3f;
-                value = bs_get_byte(bs);
+                value = *input++;
             }
-            while (i < bytes_per_scanline && run--)
-                dst[i++] = value;
+            run = std::min(run, bytes_per_scanline - i);
+            memset(dst + i, value, run);
+            i += run;
         }
+        bs->buffer = input;
     } else {
         bs_get_buffer(bs, dst, bytes_per_scanline);
     }
@@ -133,9 +140,12 @@ RgbaImage pcx::decode(const Blob &data) {
         if (ret < 0)
             throw Exception("PCX image data is corrupted");
 
-        auto line = result[y];
+        const uint8_t *lineR = scanline.get();
+        const uint8_t *lineG = lineR + header->bytes_per_row;
+        const uint8_t *lineB = lineG + header->bytes_per_row;
+        Color *line = result[y].data();
         for (unsigned int x = 0; x < width; x++)
-            line[x] = Color(scanline[x], scanline[x + header->bytes_per_row], scanline[x + (header->bytes_per_row << 1)]);
+            line[x] = Color(lineR[x], lineG[x], lineB[x]);
     }
 
     return result;
@@ -166,19 +176,45 @@ void *writePcxHeader(void *pcx_data, int width, int height) {
     return static_cast<uint8_t *>(pcx_data) + sizeof(PCXHeader);
 }
 
-void *encodeOneLine(void *pcx_data, void *line, size_t line_size) {
-    uint8_t *input = (uint8_t *)line;
-    uint8_t *end = input + line_size;
-    uint8_t *output = (uint8_t *)pcx_data;
+// Rows are encoded in bands of this size when encoding in parallel.
+static constexpr size_t PARALLEL_BAND_HEIGHT = 32;
+
+// Images smaller than this are encoded on the calling thread. This covers save thumbnails & Lloyd beacon images,
+// for which the dispatch overhead is larger than the encoding itself.
+static constexpr size_t PARALLEL_MIN_PIXELS = 256 * 256;
+
+/**
+ * @return                              Length of the run of `value` bytes at `input`, capped at `limit`.
+ */
+static size_t runLength(const uint8_t *input, const uint8_t *end, uint8_t value, size_t limit) {
+    end = std::min(end, input + limit);
+    const uint8_t *pos = input;
+
+    // Compare eight bytes at a time, the first mismatching byte is the lowest non-zero byte of the xor.
+    if constexpr (std::endian::native == std::endian::little) {
+        uint64_t pattern = value * 0x0101010101010101ull;
+        while (end - pos >= 8) {
+            uint64_t word;
+            memcpy(&word, pos, 8);
+            uint64_t diff = word ^ pattern;
+            if (diff)
+                return pos - input + std::countr_zero(diff) / 8;
+            pos += 8;
+        }
+    }
+
+    while (pos < end && *pos == value)
+        pos++;
+    return pos - input;
+}
+
+static uint8_t *encodeOneLine(uint8_t *output, const uint8_t *input, size_t size) {
+    const uint8_t *end = input + size;
 
     while (input < end) {
         uint8_t value = *input++;
-
-        int count = 1;
-        while (count < 63 && input < end && *input == value) {
-            input++;
-            count++;
-        }
+        size_t count = 1 + runLength(input, end, value, 62);
+        input += count - 1;
 
         if (count > 1 || (value & 0xC0) != 0)
             *output++ = 0xC0 + count;
@@ -188,7 +224,38 @@ void *encodeOneLine(void *pcx_data, void *line, size_t line_size) {
     return output;
 }
 
-Blob pcx::encode(RgbaImageView image) {
+static uint8_t *encodeRows(uint8_t *output, RgbaImageView image, size_t pitch, size_t rowBegin, size_t rowEnd) {
+    size_t width = image.width();
+
+    std::unique_ptr<uint8_t[]> lineRGB(new uint8_t[3 * pitch]);
+    uint8_t *lineR = lineRGB.get();
+    uint8_t *lineG = lineR + pitch;
+    uint8_t *lineB = lineG + pitch;
+
+    // Padding bytes are not part of the image, but they still get encoded.
+    if (pitch != width) {
+        lineR[width] = 0;
+        lineG[width] = 0;
+        lineB[width] = 0;
+    }
+
+    for (size_t y = rowBegin; y < rowEnd; y++) {
+        const Color *input = image[y].data();
+        for (size_t x = 0; x < width; x++) {
+            lineR[x] = input[x].r;
+            lineG[x] = input[x].g;
+            lineB[x] = input[x].b;
+        }
+
+        output = encodeOneLine(output, lineR, pitch);
+        output = encodeOneLine(output, lineG, pitch);
+        output = encodeOneLine(output, lineB, pitch);
+    }
+
+    return output;
+}
+
+Blob pcx::encode(RgbaImageView image, ThreadPool *pool) {
     assert(image);
 
     size_t width = image.width();
@@ -201,28 +268,33 @@ Blob pcx::encode(RgbaImageView image) {
 
     // pcx file can be larger than uncompressed
     // pcx header and no compression @24bit worst case doubles in size
-    size_t worstCase = sizeof(PCXHeader) + 3 * pitch * height * 2;
+    size_t worstCaseRow = 3 * pitch * 2;
+    size_t worstCase = sizeof(PCXHeader) + worstCaseRow * height;
     std::unique_ptr<uint8_t[], FreeDeleter> pcx_data(static_cast<uint8_t *>(malloc(worstCase)));
 
     uint8_t *output = (uint8_t *) writePcxHeader(pcx_data.get(), width, height);
 
-    std::unique_ptr<uint8_t[]> lineRGB(new uint8_t[3 * pitch]);
-    uint8_t *lineR = lineRGB.get();
-    uint8_t *lineG = lineRGB.get() + pitch;
-    uint8_t *lineB = lineRGB.get() + 2 * pitch;
-    const Color *input = image.pixels().data();
-
-    for (int y = 0; y < height; y++) {
-        for (unsigned int x = 0; x < width; x++) {
-            Color pixel = *input++;
-            lineR[x] = pixel.r;
-            lineG[x] = pixel.g;
-            lineB[x] = pixel.b;
-        }
-        uint8_t *line = lineRGB.get();
-        for (int p = 0; p < 3; p++) {
-            output = (uint8_t *) encodeOneLine(output, line, pitch);
-            line += pitch;
+    if (!pool || width * height < PARALLEL_MIN_PIXELS) {
+        output = encodeRows(output, image, pitch, 0, height);
+    } else {
+        // Each band is encoded in place into its worst case slot, and then the bands are compacted. Scanlines are
+        // encoded independently, so the result is the same as with sequential encoding.
+        size_t bandCount = (height + PARALLEL_BAND_HEIGHT - 1) / PARALLEL_BAND_HEIGHT;
+        std::vector<uint8_t *> bandEnds(bandCount);
+        uint8_t *base = output;
+        pool->parallelFor(bandCount, 1, [&](size_t begin, size_t end) {
+            for (size_t band = begin; band < end; band++) {
+                size_t rowBegin = band * PARALLEL_BAND_HEIGHT;
+                size_t rowEnd = std::min(height, rowBegin + PARALLEL_BAND_HEIGHT);
+                bandEnds[band] = encodeRows(base + rowBegin * worstCaseRow, image, pitch, rowBegin, rowEnd);
+            }
+        });
+
+        for (size_t band = 0; band < bandCount; band++) {
+            uint8_t *bandBegin = base + band * PARALLEL_BAND_HEIGHT * worstCaseRow;
+            size_t bandSize = bandEnds[band] - bandBegin;
+            memmove(output, bandBegin, bandSize);
+            output += bandSize;
         }
     }
 
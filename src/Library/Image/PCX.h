@@ -6,6 +6,8 @@
 #include "Library/Image/Image.h"
 #include "Utility/Memory/Blob.h"
 
+class ThreadPool;
+
 namespace pcx {
 /**
  * Decodes a PCX image from a `Blob`.
@@ -16,5 +18,14 @@ namespace pcx {
  */
 RgbaImage decode(const Blob &data);
 
-Blob encode(RgbaImageView image);
+/**
+ * Encodes an image as a 24-bit RLE-compressed PCX.
+ *
+ * @param image                         Image to encode.
+ * @param pool                          Thread pool to encode large images on, if any. Small images like save
+ *                                      thumbnails are always encoded on the calling thread. The result doesn't depend
+ *                                      on whether a pool was used.
+ * @return                              Encoded PCX image.
+ */
+Blob encode(RgbaImageView image, ThreadPool *pool = nullptr);
 }  // namespace pcx
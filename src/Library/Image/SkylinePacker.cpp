@@ -0,0 +1,92 @@
+#include "SkylinePacker.h"
+
+#include <algorithm>
+#include <limits>
+
+SkylinePacker::SkylinePacker(Sizei size) {
+    reset(size);
+}
+
+void SkylinePacker::reset(Sizei size) {
+    _size = size;
+    _skyline.clear();
+    _skyline.push_back({0, 0, size.w});
+    _usedArea = 0;
+}
+
+std::optional<int> SkylinePacker::fit(size_t index, Sizei size) const {
+    int x = _skyline[index].x;
+    if (x + size.w > _size.w)
+        return std::nullopt;
+
+    int y = 0;
+    int widthLeft = size.w;
+    for (size_t i = index; widthLeft > 0; i++) {
+        y = std::max(y, _skyline[i].y);
+        if (y + size.h > _size.h)
+            return std::nullopt;
+        widthLeft -= _skyline[i].w;
+    }
+    return y;
+}
+
+std::optional<Pointi> SkylinePacker::insert(Sizei size) {
+    if (size.w <= 0 || size.h <= 0 || _skyline.empty())
+        return std::nullopt;
+
+    size_t bestIndex = _skyline.size();
+    int bestBottom = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+    int bestY = 0;
+    for (size_t i = 0; i < _skyline.size(); i++) {
+        std::optional<int> y = fit(i, size);
+        if (!y)
+            continue;
+
+        // Lowest bottom edge first, then the narrowest segment to waste less space under the rectangle.
+        int bottom = *y + size.h;
+        if (bottom < bestBottom || (bottom == bestBottom && _skyline[i].w < bestWidth)) {
+            bestIndex = i;
+            bestBottom = bottom;
+            bestWidth = _skyline[i].w;
+            bestY = *y;
+        }
+    }
+
+    if (bestIndex == _skyline.size())
+        return std::nullopt;
+
+    Pointi result(_skyline[bestIndex].x, bestY);
+    _skyline.insert(_skyline.begin() + bestIndex, Segment{result.x, bestBottom, size.w});
+
+    // Cut the segments that are now covered by the new one.
+    int right = result.x + size.w;
+    for (size_t i = bestIndex + 1; i < _skyline.size();) {
+        Segment &segment = _skyline[i];
+        if (segment.x >= right)
+            break;
+
+        int segmentRight = segment.x + segment.w;
+        if (segmentRight <= right) {
+            _skyline.erase(_skyline.begin() + i);
+            continue;
+        }
+
+        segment.w = segmentRight - right;
+        segment.x = right;
+        break;
+    }
+
+    // Merge the neighbours at the same height.
+    for (size_t i = 0; i + 1 < _skyline.size();) {
+        if (_skyline[i].y == _skyline[i + 1].y) {
+            _skyline[i].w += _skyline[i + 1].w;
+            _skyline.erase(_skyline.begin() + i + 1);
+        } else {
+            i++;
+        }
+    }
+
+    _usedArea += static_cast<int64_t>(size.w) * size.h;
+    return result;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Library/Geometry/Point.h"
+#include "Library/Geometry/Size.h"
+
+/**
+ * Rectangle packer for texture atlases, implements the skyline bottom-left heuristic.
+ *
+ * The packer tracks the upper contour ("skyline") of the rectangles that were placed so far, and puts each new
+ * rectangle at the position along the skyline that keeps the contour lowest. This is not as tight as maxrects, but
+ * is a lot cheaper, and works well for runtime packing where rectangles arrive one by one.
+ *
+ * Y axis points down, so "lowest" here means closest to the top edge of the atlas.
+ */
+class SkylinePacker {
+ public:
+    SkylinePacker() = default;
+    explicit SkylinePacker(Sizei size);
+
+    /**
+     * Clears the packer.
+     *
+     * @param size                      New atlas size.
+     */
+    void reset(Sizei size);
+
+    /**
+     * @param size                      Size of the rectangle to place.
+     * @return                          Top-left corner of the placed rectangle, or `std::nullopt` if there is no
+     *                                  space left for it.
+     */
+    [[nodiscard]] std::optional<Pointi> insert(Sizei size);
+
+    [[nodiscard]] Sizei size() const {
+        return _size;
+    }
+
+    /**
+     * @return                          Total area of all the placed rectangles.
+     */
+    [[nodiscard]] int64_t usedArea() const {
+        return _usedArea;
+    }
+
+ private:
+    struct Segment {
+        int x;
+        int y; // Height of the skyline over this segment.
+        int w;
+    };
+
+    /**
+     * @return                          Y coordinate at which a rectangle of the given width can be placed at the start
+     *                                  of the given segment, or `std::nullopt` if it doesn't fit there.
+     */
+    std::optional<int> fit(size_t index, Sizei size) const;
+
+ private:
+    Sizei _size;
+    std::vector<Segment> _skyline;
+    int64_t _usedArea = 0;
+};
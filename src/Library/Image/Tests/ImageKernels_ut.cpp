@@ -0,0 +1,64 @@
+#include <random>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Image/ImageKernels.h"
+
+static std::vector<uint8_t> makeIndices(size_t size) {
+    std::mt19937 rng(size);
+    std::vector<uint8_t> result(size);
+    for (uint8_t &index : result)
+        index = rng() % 4 == 0 ? 0 : rng() % 256; // Make sure we have a fair share of zeros.
+    return result;
+}
+
+static Palette makePalette() {
+    Palette result;
+    for (int i = 0; i < 256; i++)
+        result.colors[i] = Color(i, 255 - i, i * 7, i * 13);
+    return result;
+}
+
+UNIT_TEST(ImageKernels, ExpandPalette) {
+    Palette palette = makePalette();
+
+    // Odd sizes to exercise the scalar tails.
+    for (size_t size : {0, 1, 7, 8, 9, 63, 1000}) {
+        std::vector<uint8_t> src = makeIndices(size);
+        std::vector<Color> expected(size);
+        detail::expandPaletteScalar(src, palette, expected);
+        for (size_t i = 0; i < size; i++)
+            EXPECT_EQ(expected[i], palette.colors[src[i]]);
+
+        std::vector<Color> actual(size);
+        expandPalette(src, palette, actual);
+        EXPECT_EQ(actual, expected);
+
+        if (detail::hasExpandPaletteAvx2()) {
+            std::vector<Color> avx2(size);
+            detail::expandPaletteAvx2(src, palette, avx2);
+            EXPECT_EQ(avx2, expected);
+        }
+    }
+}
+
+UNIT_TEST(ImageKernels, ExpandIndices) {
+    for (size_t size : {0, 1, 15, 16, 17, 255, 1000}) {
+        std::vector<uint8_t> src = makeIndices(size);
+        std::vector<Color> expected(size);
+        detail::expandIndicesScalar(src, expected);
+        for (size_t i = 0; i < size; i++)
+            EXPECT_EQ(expected[i], Color(src[i], 0, 0, src[i] == 0 ? 0 : 255));
+
+        std::vector<Color> actual(size);
+        expandIndices(src, actual);
+        EXPECT_EQ(actual, expected);
+
+        if (detail::hasExpandIndicesSimd()) {
+            std::vector<Color> simd(size);
+            detail::expandIndicesSimd(src, simd);
+            EXPECT_EQ(simd, expected);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include <random>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Image/PCX.h"
+
+#include "Utility/Thread/ThreadPool.h"
+
+static RgbaImage makeImage(size_t width, size_t height) {
+    // Mix of long runs, short runs & noise, with plenty of bytes that need the 0xC0 prefix.
+    std::mt19937 rng(width * height);
+    RgbaImage result = RgbaImage::uninitialized(width, height);
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            uint8_t v = (y % 3 == 0) ? 0xC7 : (x / 5 % 2 == 0) ? rng() % 256 : x / 100;
+            result[y][x] = Color(v, y % 2 ? v : 0xFF, rng() % 2 ? 0x10 : 0xD0);
+        }
+    }
+    return result;
+}
+
+// Straightforward RLE encoder to compare against.
+static std::vector<uint8_t> encodeReference(RgbaImageView image) {
+    size_t pitch = (image.width() + 1) & ~static_cast<size_t>(1);
+    std::vector<uint8_t> result;
+    for (size_t y = 0; y < image.height(); y++) {
+        for (int plane = 0; plane < 3; plane++) {
+            std::vector<uint8_t> line(pitch, 0);
+            for (size_t x = 0; x < image.width(); x++) {
+                Color c = image[y][x];
+                line[x] = plane == 0 ? c.r : plane == 1 ? c.g : c.b;
+            }
+
+            for (size_t i = 0; i < pitch;) {
+                size_t count = 1;
+                while (count < 63 && i + count < pitch && line[i + count] == line[i])
+                    count++;
+                if (count > 1 || (line[i] & 0xC0) != 0)
+                    result.push_back(0xC0 + count);
+                result.push_back(line[i]);
+                i += count;
+            }
+        }
+    }
+    return result;
+}
+
+UNIT_TEST(PCX, RoundTrip) {
+    for (auto [width, height] : {std::pair(1, 1), std::pair(150, 112), std::pair(93, 68), std::pair(640, 480)}) {
+        RgbaImage image = makeImage(width, height);
+        RgbaImage decoded = pcx::decode(pcx::encode(image));
+        EXPECT_EQ(decoded.width(), width);
+        EXPECT_EQ(decoded.height(), height);
+        EXPECT_TRUE(std::ranges::equal(decoded.pixels(), image.pixels()));
+    }
+}
+
+UNIT_TEST(PCX, EncodeMatchesReference) {
+    ThreadPool pool(4);
+
+    for (auto [width, height] : {std::pair(1, 1), std::pair(93, 68), std::pair(641, 479), std::pair(1024, 768)}) {
+        RgbaImage image = makeImage(width, height);
+        std::vector<uint8_t> reference = encodeReference(image);
+
+        for (ThreadPool *p : {static_cast<ThreadPool *>(nullptr), &pool}) {
+            Blob encoded = pcx::encode(image, p);
+            ASSERT_EQ(encoded.size(), 128 + reference.size());
+            EXPECT_EQ(encoded.string_view().substr(128),
+                      std::string_view(reinterpret_cast<const char *>(reference.data()), reference.size()));
+        }
+    }
+}
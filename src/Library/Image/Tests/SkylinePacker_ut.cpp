@@ -0,0 +1,64 @@
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Geometry/Rect.h"
+#include "Library/Image/SkylinePacker.h"
+
+UNIT_TEST(SkylinePacker, FillsRows) {
+    SkylinePacker packer(Sizei(64, 64));
+
+    // Four 32x32 squares fill the atlas exactly.
+    std::vector<Recti> rects;
+    for (int i = 0; i < 4; i++) {
+        std::optional<Pointi> pos = packer.insert(Sizei(32, 32));
+        ASSERT_TRUE(pos.has_value());
+        rects.emplace_back(*pos, Sizei(32, 32));
+    }
+    EXPECT_EQ(rects, std::vector<Recti>({Recti(0, 0, 32, 32), Recti(32, 0, 32, 32), Recti(0, 32, 32, 32),
+                                         Recti(32, 32, 32, 32)}));
+    EXPECT_EQ(packer.usedArea(), 64 * 64);
+    EXPECT_FALSE(packer.insert(Sizei(1, 1)).has_value());
+
+    packer.reset(Sizei(64, 64));
+    EXPECT_EQ(packer.usedArea(), 0);
+    std::optional<Pointi> pos = packer.insert(Sizei(64, 64));
+    ASSERT_TRUE(pos.has_value());
+    EXPECT_EQ(Recti(*pos, Sizei(64, 64)), Recti(0, 0, 64, 64));
+}
+
+UNIT_TEST(SkylinePacker, RejectsOversized) {
+    SkylinePacker packer(Sizei(64, 32));
+    EXPECT_FALSE(packer.insert(Sizei(65, 1)).has_value());
+    EXPECT_FALSE(packer.insert(Sizei(1, 33)).has_value());
+    EXPECT_FALSE(packer.insert(Sizei(0, 10)).has_value());
+    EXPECT_TRUE(packer.insert(Sizei(64, 32)).has_value());
+}
+
+UNIT_TEST(SkylinePacker, NoOverlaps) {
+    std::mt19937 rng(42);
+    Sizei atlasSize(512, 512);
+    SkylinePacker packer(atlasSize);
+
+    std::vector<Recti> rects;
+    for (int i = 0; i < 2000; i++) {
+        Sizei size(1 + rng() % 48, 1 + rng() % 48);
+        std::optional<Pointi> pos = packer.insert(size);
+        if (!pos)
+            continue;
+
+        Recti rect(pos->x, pos->y, size.w, size.h);
+        EXPECT_GE(rect.x, 0);
+        EXPECT_GE(rect.y, 0);
+        EXPECT_LE(rect.x + rect.w, atlasSize.w);
+        EXPECT_LE(rect.y + rect.h, atlasSize.h);
+        for (const Recti &other : rects)
+            EXPECT_FALSE(rect.intersects(other));
+        rects.push_back(rect);
+    }
+
+    // Skyline should do a decent job on random rectangles.
+    EXPECT_GT(packer.usedArea(), atlasSize.w * atlasSize.h * 7 / 10);
+}
@@ -0,0 +1,210 @@
+#include "TextureCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+RgbaImage downsampleImage(RgbaImageView image) {
+    assert(image);
+
+    ssize_t width = std::max<ssize_t>(1, image.width() / 2);
+    ssize_t height = std::max<ssize_t>(1, image.height() / 2);
+    RgbaImage result = RgbaImage::uninitialized(width, height);
+
+    for (ssize_t y = 0; y < height; y++) {
+        for (ssize_t x = 0; x < width; x++) {
+            int r = 0, g = 0, b = 0, a = 0;
+            for (ssize_t dy = 0; dy < 2; dy++) {
+                for (ssize_t dx = 0; dx < 2; dx++) {
+                    Color c = image[std::min(2 * y + dy, image.height() - 1)][std::min(2 * x + dx, image.width() - 1)];
+                    r += c.r * c.a;
+                    g += c.g * c.a;
+                    b += c.b * c.a;
+                    a += c.a;
+                }
+            }
+
+            if (a == 0) {
+                result[y][x] = Color(0, 0, 0, 0);
+            } else {
+                result[y][x] = Color((r + a / 2) / a, (g + a / 2) / a, (b + a / 2) / a, (a + 2) / 4);
+            }
+        }
+    }
+
+    return result;
+}
+
+size_t bc1CompressedSize(ssize_t width, ssize_t height) {
+    return ((width + 3) / 4) * ((height + 3) / 4) * 8;
+}
+
+static uint16_t packColor565(int r, int g, int b) {
+    return static_cast<uint16_t>(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+static std::array<int, 3> unpackColor565(uint16_t color) {
+    int r = (color >> 11) & 31;
+    int g = (color >> 5) & 63;
+    int b = color & 31;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+static void compressBC1Block(const std::array<Color, 16> &block, unsigned char *dst) {
+    // Pick the endpoints from the bounding box of the opaque pixels, inset a bit as that reduces the error for the
+    // interpolated colors.
+    std::array<int, 3> min = {255, 255, 255};
+    std::array<int, 3> max = {0, 0, 0};
+    bool hasTransparent = false;
+    bool hasOpaque = false;
+    for (const Color &c : block) {
+        if (c.a < 128) {
+            hasTransparent = true;
+            continue;
+        }
+        hasOpaque = true;
+        min = {std::min<int>(min[0], c.r), std::min<int>(min[1], c.g), std::min<int>(min[2], c.b)};
+        max = {std::max<int>(max[0], c.r), std::max<int>(max[1], c.g), std::max<int>(max[2], c.b)};
+    }
+
+    uint16_t c0 = 0, c1 = 0;
+    if (hasOpaque) {
+        for (int i = 0; i < 3; i++) {
+            int inset = (max[i] - min[i]) / 16;
+            min[i] += inset;
+            max[i] -= inset;
+        }
+
+        // Bounding box diagonal is a good approximation of the principal axis only if the channels are positively
+        // correlated. Flip the channels that are anti-correlated with the one that has the largest range.
+        int main = 0;
+        for (int i = 1; i < 3; i++)
+            if (max[i] - min[i] > max[main] - min[main])
+                main = i;
+        std::array<int, 3> center = {(min[0] + max[0]) / 2, (min[1] + max[1]) / 2, (min[2] + max[2]) / 2};
+        std::array<int, 3> covariance = {0, 0, 0};
+        for (const Color &c : block) {
+            if (c.a < 128)
+                continue;
+            std::array<int, 3> d = {c.r - center[0], c.g - center[1], c.b - center[2]};
+            for (int i = 0; i < 3; i++)
+                covariance[i] += d[i] * d[main];
+        }
+        for (int i = 0; i < 3; i++)
+            if (covariance[i] < 0)
+                std::swap(min[i], max[i]);
+
+        c0 = packColor565(max[0], max[1], max[2]);
+        c1 = packColor565(min[0], min[1], min[2]);
+    }
+
+    // Four-color mode needs c0 > c1, three-color mode with transparency needs c0 <= c1.
+    if (hasTransparent ? c0 > c1 : c0 < c1)
+        std::swap(c0, c1);
+    bool fourColors = c0 > c1;
+
+    std::array<std::array<int, 3>, 4> palette;
+    palette[0] = unpackColor565(c0);
+    palette[1] = unpackColor565(c1);
+    for (int i = 0; i < 3; i++) {
+        if (fourColors) {
+            palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+            palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+        } else {
+            palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+            palette[3][i] = 0;
+        }
+    }
+
+    uint32_t indices = 0;
+    for (int p = 0; p < 16; p++) {
+        const Color &c = block[p];
+        uint32_t index = 3; // Transparent in three-color mode.
+        if (c.a >= 128) {
+            int bestError = INT32_MAX;
+            for (uint32_t i = 0; i < (fourColors ? 4u : 3u); i++) {
+                int dr = c.r - palette[i][0];
+                int dg = c.g - palette[i][1];
+                int db = c.b - palette[i][2];
+                int error = dr * dr + dg * dg + db * db;
+                if (error < bestError) {
+                    bestError = error;
+                    index = i;
+                }
+            }
+        }
+        indices |= index << (2 * p);
+    }
+
+    // BC1 is little-endian.
+    dst[0] = c0 & 0xFF;
+    dst[1] = c0 >> 8;
+    dst[2] = c1 & 0xFF;
+    dst[3] = c1 >> 8;
+    for (int i = 0; i < 4; i++)
+        dst[4 + i] = (indices >> (8 * i)) & 0xFF;
+}
+
+static void compressBC1Into(RgbaImageView image, unsigned char *dst) {
+    std::array<Color, 16> block;
+    for (ssize_t by = 0; by < image.height(); by += 4) {
+        for (ssize_t bx = 0; bx < image.width(); bx += 4) {
+            for (ssize_t y = 0; y < 4; y++)
+                for (ssize_t x = 0; x < 4; x++)
+                    block[y * 4 + x] = image[std::min(by + y, image.height() - 1)][std::min(bx + x, image.width() - 1)];
+
+            compressBC1Block(block, dst);
+            dst += 8;
+        }
+    }
+}
+
+Blob compressBC1(RgbaImageView image) {
+    assert(image);
+
+    std::string result(bc1CompressedSize(image.width(), image.height()), '\0');
+    compressBC1Into(image, reinterpret_cast<unsigned char *>(result.data()));
+    return Blob::fromString(std::move(result));
+}
+
+int mipLevelCount(ssize_t width, ssize_t height) {
+    int result = 1;
+    while (width > 1 || height > 1) {
+        width = std::max<ssize_t>(1, width / 2);
+        height = std::max<ssize_t>(1, height / 2);
+        result++;
+    }
+    return result;
+}
+
+Blob compressBC1MipChain(RgbaImageView image) {
+    assert(image);
+
+    size_t size = bc1CompressedSize(image.width(), image.height());
+    for (ssize_t w = image.width(), h = image.height(); w > 1 || h > 1;) {
+        w = std::max<ssize_t>(1, w / 2);
+        h = std::max<ssize_t>(1, h / 2);
+        size += bc1CompressedSize(w, h);
+    }
+
+    std::string result(size, '\0');
+    unsigned char *dst = reinterpret_cast<unsigned char *>(result.data());
+    compressBC1Into(image, dst);
+    dst += bc1CompressedSize(image.width(), image.height());
+
+    RgbaImage level;
+    RgbaImageView prev = image;
+    while (prev.width() > 1 || prev.height() > 1) {
+        level = downsampleImage(prev);
+        compressBC1Into(level, dst);
+        dst += bc1CompressedSize(level.width(), level.height());
+        prev = level;
+    }
+    assert(dst == reinterpret_cast<unsigned char *>(result.data()) + result.size());
+
+    return Blob::fromString(std::move(result));
+}
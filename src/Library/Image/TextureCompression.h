@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Utility/Memory/Blob.h"
+
+#include "Image.h"
+
+/**
+ * @param image                         Image to downsample.
+ * @return                              Image of half the size (rounded down, but at least 1x1), with each pixel being
+ *                                      an average of a 2x2 block of source pixels. Colors are weighted by alpha, so
+ *                                      that transparent pixels don't bleed into their neighbours.
+ */
+RgbaImage downsampleImage(RgbaImageView image);
+
+/**
+ * @param width                         Image width.
+ * @param height                        Image height.
+ * @return                              Size of a BC1-compressed image of the given size, in bytes.
+ */
+[[nodiscard]] size_t bc1CompressedSize(ssize_t width, ssize_t height);
+
+/**
+ * Compresses an image into BC1 (aka DXT1) format.
+ *
+ * Pixels with alpha below 128 are encoded as transparent using the 3-color BC1 mode, so this works both for opaque
+ * and for color-keyed images. Images that are not a multiple of 4 in size are padded by repeating the edge pixels.
+ *
+ * @param image                         Image to compress.
+ * @return                              BC1 data, `bc1CompressedSize(image.width(), image.height())` bytes.
+ */
+Blob compressBC1(RgbaImageView image);
+
+/**
+ * @param width                         Image width.
+ * @param height                        Image height.
+ * @return                              Number of levels in a full mip chain for an image of the given size.
+ */
+[[nodiscard]] int mipLevelCount(ssize_t width, ssize_t height);
+
+/**
+ * Generates a full mip chain for the provided image and compresses all the levels into BC1.
+ *
+ * @param image                         Level 0 image.
+ * @return                              BC1 data for all levels, starting with level 0, concatenated.
+ */
+Blob compressBC1MipChain(RgbaImageView image);
@@ -0,0 +1,45 @@
+#include "TextureCompressionCache.h"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "Utility/Format.h"
+#include "Utility/Hash.h"
+
+#include "TextureCompression.h"
+
+static constexpr std::string_view CACHE_SIGNATURE = "OETEXCC2";
+static constexpr size_t MAX_CACHE_SIZE = 256 * 1024 * 1024; // Cache file is compacted once it grows beyond this.
+
+TextureCompressionCache::TextureCompressionCache() = default;
+
+TextureCompressionCache::TextureCompressionCache(std::string_view path) {
+    open(path);
+}
+
+TextureCompressionCache::~TextureCompressionCache() = default;
+
+void TextureCompressionCache::open(std::string_view path) {
+    _cache.open(path, CACHE_SIGNATURE, MAX_CACHE_SIZE);
+}
+
+void TextureCompressionCache::close() {
+    _cache.close();
+}
+
+Blob TextureCompressionCache::compressBC1MipChain(RgbaImageView image) {
+    assert(isOpen());
+
+    std::array<uint64_t, 2> hash = murmur3Hash128(image.pixels().data(), image.pixels().size_bytes());
+    std::string key = fmt::format("bc1|{}x{}|{:016x}{:016x}", image.width(), image.height(), hash[0], hash[1]);
+    if (std::optional<Blob> cached = _cache.find(key))
+        return std::move(*cached);
+
+    Blob result = ::compressBC1MipChain(image);
+    _cache.insert(key, result);
+    return result;
+}
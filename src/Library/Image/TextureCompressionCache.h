@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string_view>
+
+#include "Library/BlobCache/BlobCache.h"
+
+#include "Utility/Memory/Blob.h"
+
+#include "Image.h"
+
+/**
+ * Persistent on-disk cache for the results of `compressBC1MipChain`, see `BlobCache` for how the cache file is
+ * managed.
+ *
+ * Cache entries are keyed by image size and a 128-bit hash of the image pixels, so there's nothing to invalidate -
+ * changed textures just get new entries, and the stale ones are dropped once the cache file grows too big.
+ */
+class TextureCompressionCache {
+ public:
+    TextureCompressionCache();
+    explicit TextureCompressionCache(std::string_view path);
+    ~TextureCompressionCache();
+
+    /**
+     * @param path                      Path to the cache file, see `BlobCache::open`.
+     * @throw Exception                 If the cache file exists, but couldn't be read.
+     */
+    void open(std::string_view path);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const {
+        return _cache.isOpen();
+    }
+
+    /**
+     * Cached version of `compressBC1MipChain`.
+     *
+     * @param image                     Level 0 image.
+     * @return                          BC1 data for all mip levels.
+     */
+    [[nodiscard]] Blob compressBC1MipChain(RgbaImageView image);
+
+ private:
+    BlobCache _cache;
+};
@@ -0,0 +1,225 @@
+#include "JsonStreaming.h"
+
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Utility/Streams/OutputStream.h"
+
+#include "Json.h"
+
+namespace {
+
+/**
+ * SAX handler that builds DOMs only for the top-level members, or for the elements of the streamed top-level
+ * arrays.
+ */
+class StreamingSaxHandler {
+ public:
+    StreamingSaxHandler(const std::function<bool(std::string_view)> &isStreamed,
+                        const std::function<void(std::string_view, Json &&)> &callback) :
+        _isStreamed(isStreamed), _callback(callback) {}
+
+    bool null() {
+        return addValue(Json(nullptr));
+    }
+
+    bool boolean(bool value) {
+        return addValue(Json(value));
+    }
+
+    bool number_integer(Json::number_integer_t value) {
+        return addValue(Json(value));
+    }
+
+    bool number_unsigned(Json::number_unsigned_t value) {
+        return addValue(Json(value));
+    }
+
+    bool number_float(Json::number_float_t value, const Json::string_t &) {
+        return addValue(Json(value));
+    }
+
+    bool string(Json::string_t &value) {
+        return addValue(Json(std::move(value)));
+    }
+
+    bool binary(Json::binary_t &value) {
+        return addValue(Json::binary(std::move(value)));
+    }
+
+    bool start_object(size_t) {
+        if (_depth++ == 0)
+            return true; // Top-level object.
+
+        return addContainer(Json::object());
+    }
+
+    bool key(Json::string_t &value) {
+        if (_depth == 1) {
+            _topLevelKey = std::move(value);
+        } else {
+            _key = std::move(value);
+        }
+        return true;
+    }
+
+    bool end_object() {
+        _depth--;
+        return _depth == 0 ? true : endContainer();
+    }
+
+    bool start_array(size_t) {
+        if (_depth++ == 0)
+            throw Json::type_error::create(302, "Top-level json value must be an object", nullptr);
+
+        if (_depth == 2 && _isStreamed(_topLevelKey)) {
+            _streaming = true;
+            return true;
+        }
+
+        return addContainer(Json::array());
+    }
+
+    bool end_array() {
+        _depth--;
+        if (_stack.empty()) {
+            assert(_streaming && _depth == 1);
+            _streaming = false;
+            return true;
+        }
+        return endContainer();
+    }
+
+    bool parse_error(size_t, const std::string &, const nlohmann::detail::exception &error) {
+        // Rethrow with the same type as `Json::parse` would throw.
+        if (const Json::parse_error *parseError = dynamic_cast<const Json::parse_error *>(&error))
+            throw *parseError;
+        if (const Json::out_of_range *outOfRange = dynamic_cast<const Json::out_of_range *>(&error))
+            throw *outOfRange;
+        throw error;
+    }
+
+ private:
+    bool addValue(Json &&value) {
+        if (_depth == 0)
+            throw Json::type_error::create(302, "Top-level json value must be an object", nullptr);
+
+        if (_stack.empty()) {
+            _callback(_topLevelKey, std::move(value));
+        } else {
+            insert(std::move(value));
+        }
+        return true;
+    }
+
+    bool addContainer(Json &&value) {
+        if (_stack.empty()) {
+            _value = std::move(value);
+            _stack.push_back(&_value);
+        } else {
+            _stack.push_back(insert(std::move(value)));
+        }
+        return true;
+    }
+
+    bool endContainer() {
+        _stack.pop_back();
+        if (_stack.empty())
+            _callback(_topLevelKey, std::move(_value));
+        return true;
+    }
+
+    Json *insert(Json &&value) {
+        Json *parent = _stack.back();
+        if (parent->is_array()) {
+            parent->push_back(std::move(value));
+            return &parent->back();
+        } else {
+            Json &result = (*parent)[_key];
+            result = std::move(value);
+            return &result;
+        }
+    }
+
+ private:
+    const std::function<bool(std::string_view)> &_isStreamed;
+    const std::function<void(std::string_view, Json &&)> &_callback;
+    int _depth = 0; // Nesting depth in the document, the top-level object is at depth 1.
+    bool _streaming = false; // Whether we're inside a streamed top-level array.
+    std::string _topLevelKey;
+    std::string _key; // Last key inside the value that's being built.
+    Json _value; // Value that's being built.
+    std::vector<Json *> _stack; // Containers that are being built, `_value` is at the bottom.
+};
+
+} // namespace
+
+void parseJsonObjectStreaming(std::string_view json, const std::function<bool(std::string_view)> &isStreamed,
+                              const std::function<void(std::string_view, Json &&)> &callback) {
+    StreamingSaxHandler handler(isStreamed, callback);
+    Json::sax_parse(json, &handler);
+}
+
+JsonObjectStreamWriter::JsonObjectStreamWriter(OutputStream *dst) : _dst(dst) {
+    assert(dst);
+
+    _dst->write("{");
+}
+
+void JsonObjectStreamWriter::writeMember(std::string_view key, const Json &value) {
+    assert(!_inArray);
+
+    writeKey(key);
+    writeIndented(value, "\n    ");
+}
+
+void JsonObjectStreamWriter::beginArray(std::string_view key) {
+    assert(!_inArray);
+
+    writeKey(key);
+    _dst->write("[");
+    _inArray = true;
+    _elementCount = 0;
+}
+
+void JsonObjectStreamWriter::writeElement(const Json &value) {
+    assert(_inArray);
+
+    _dst->write(_elementCount++ == 0 ? "\n        " : ",\n        ");
+    writeIndented(value, "\n        ");
+}
+
+void JsonObjectStreamWriter::endArray() {
+    assert(_inArray);
+
+    _dst->write(_elementCount == 0 ? "]" : "\n    ]");
+    _inArray = false;
+}
+
+void JsonObjectStreamWriter::close() {
+    assert(!_inArray);
+
+    _dst->write(_memberCount == 0 ? "}" : "\n}");
+}
+
+void JsonObjectStreamWriter::writeKey(std::string_view key) {
+    _dst->write(_memberCount++ == 0 ? "\n    " : ",\n    ");
+    _dst->write(Json(key).dump());
+    _dst->write(": ");
+}
+
+void JsonObjectStreamWriter::writeIndented(const Json &value, std::string_view indent) {
+    // Json strings can't contain literal newlines, so every newline in the output is a line break that needs
+    // to be indented.
+    _buffer.clear();
+    for (char c : value.dump(4)) {
+        if (c == '\n') {
+            _buffer += indent;
+        } else {
+            _buffer += c;
+        }
+    }
+    _dst->write(_buffer);
+}
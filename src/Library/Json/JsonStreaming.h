@@ -0,0 +1,71 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "JsonFwd.h"
+
+class OutputStream;
+
+/**
+ * Parses a json object without building the DOM for the whole document.
+ *
+ * Values of the top-level members are passed to `callback` one by one. Top-level arrays for which `isStreamed`
+ * returns `true` are not passed as a whole, instead `callback` is invoked for each of their elements. This way peak
+ * memory usage is bounded by the size of the largest element, and not by the size of the whole document.
+ *
+ * @param json                          Json to parse.
+ * @param isStreamed                    Predicate that takes a top-level key, and returns whether the elements of the
+ *                                      array stored under this key should be passed to `callback` one by one.
+ * @param callback                      Callback that takes a top-level key and the value stored under it, or one of
+ *                                      the array elements for the streamed arrays.
+ * @throws Json::exception              If the provided string is not a valid json, or if it's not an object.
+ */
+void parseJsonObjectStreaming(std::string_view json, const std::function<bool(std::string_view)> &isStreamed,
+                              const std::function<void(std::string_view, Json &&)> &callback);
+
+/**
+ * Writer for a json object that writes out its members one by one, without building the DOM for the whole document.
+ * Arrays can also be written element by element.
+ *
+ * Output is formatted the same way as `Json::dump(4)` formats it, so if the members are written in alphabetical
+ * order, the result is identical to what `dump` would produce.
+ *
+ * Example usage:
+ * \code
+ * JsonObjectStreamWriter writer(&stream);
+ * writer.writeMember("header", header);
+ * writer.beginArray("items");
+ * for (const Json &item : items)
+ *     writer.writeElement(item);
+ * writer.endArray();
+ * writer.close();
+ * \endcode
+ */
+class JsonObjectStreamWriter {
+ public:
+    explicit JsonObjectStreamWriter(OutputStream *dst);
+
+    void writeMember(std::string_view key, const Json &value);
+
+    void beginArray(std::string_view key);
+    void writeElement(const Json &value);
+    void endArray();
+
+    /**
+     * Writes out the closing brace. Doesn't close the underlying stream.
+     */
+    void close();
+
+ private:
+    void writeKey(std::string_view key);
+    void writeIndented(const Json &value, std::string_view indent);
+
+ private:
+    OutputStream *_dst = nullptr;
+    size_t _memberCount = 0;
+    size_t _elementCount = 0;
+    bool _inArray = false;
+    std::string _buffer;
+};
@@ -0,0 +1,71 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Json/Json.h"
+#include "Library/Json/JsonStreaming.h"
+
+#include "Utility/Streams/StringOutputStream.h"
+
+UNIT_TEST(JsonStreaming, WriterMatchesDump) {
+    Json expected = Json::parse(R"({"a": 1, "b": {"c": [1, 2, {"d": "\n"}], "e": {}}, "f": [], "g": [{"h": null}, 2]})");
+
+    std::string result;
+    StringOutputStream stream(&result);
+    JsonObjectStreamWriter writer(&stream);
+    writer.writeMember("a", expected["a"]);
+    writer.writeMember("b", expected["b"]);
+    writer.beginArray("f");
+    writer.endArray();
+    writer.beginArray("g");
+    for (const Json &element : expected["g"])
+        writer.writeElement(element);
+    writer.endArray();
+    writer.close();
+    stream.close();
+
+    EXPECT_EQ(result, expected.dump(4));
+}
+
+UNIT_TEST(JsonStreaming, WriterEmpty) {
+    std::string result;
+    StringOutputStream stream(&result);
+    JsonObjectStreamWriter writer(&stream);
+    writer.close();
+    stream.close();
+
+    EXPECT_EQ(result, Json::object().dump(4));
+}
+
+UNIT_TEST(JsonStreaming, Parse) {
+    std::string json = R"({"a": 1, "b": {"c": [1, 2]}, "s": [{"x": 1}, 2, [3]], "t": [4, 5]})";
+
+    std::vector<std::pair<std::string, Json>> values;
+    parseJsonObjectStreaming(json, [](std::string_view key) { return key == "s"; }, [&](std::string_view key, Json &&value) {
+        values.emplace_back(std::string(key), std::move(value));
+    });
+
+    std::vector<std::pair<std::string, Json>> expected = {
+        {"a", Json(1)},
+        {"b", Json::parse(R"({"c": [1, 2]})")},
+        {"s", Json::parse(R"({"x": 1})")},
+        {"s", Json(2)},
+        {"s", Json::parse("[3]")},
+        {"t", Json::parse("[4, 5]")}
+    };
+    EXPECT_EQ(values, expected);
+}
+
+UNIT_TEST(JsonStreaming, ParseErrors) {
+    auto parse = [](std::string_view json) {
+        parseJsonObjectStreaming(json, [](std::string_view) { return true; }, [](std::string_view, Json &&) {});
+    };
+
+    EXPECT_THROW(parse(R"({"a": [1, 2)"), Json::parse_error);
+    EXPECT_THROW(parse("{\"a\": }"), Json::parse_error);
+    EXPECT_THROW(parse("[1, 2]"), Json::type_error);
+    EXPECT_THROW(parse("5"), Json::type_error);
+    EXPECT_NO_THROW(parse("{}"));
+}
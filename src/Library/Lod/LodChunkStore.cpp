@@ -0,0 +1,148 @@
+#include "LodChunkStore.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Library/Serialization/Serialization.h"
+
+#include "Utility/Streams/BlobOutputStream.h"
+#include "Utility/Streams/StringOutputStream.h"
+#include "Utility/Streams/TempFileOutputStream.h"
+#include "Utility/Exception.h"
+#include "Utility/Hash.h"
+#include "Utility/String.h"
+
+#include "LodInfo.h"
+#include "LodReader.h"
+#include "LodWriter.h"
+
+static constexpr std::string_view MANIFEST_SIGNATURE = "OpenEnroth chunked lod 1\n";
+
+struct ManifestEntry {
+    std::string name;
+    std::string chunk; // Chunk file name in the store directory.
+};
+
+struct Manifest {
+    LodInfo info;
+    std::vector<ManifestEntry> entries;
+};
+
+static uint64_t hashChunk(const Blob &data) {
+    // Collisions are handled by comparing the chunk contents, so we don't need anything stronger.
+    return fnv1aHashBytes(data.data(), data.size());
+}
+
+static Manifest parseManifest(const Blob &data) {
+    if (!LodChunkStore::isManifest(data))
+        throw Exception("Not a chunked lod manifest");
+
+    std::vector<std::string_view> lines = splitString(data.string_view().substr(MANIFEST_SIGNATURE.size()), '\n');
+    if (!lines.empty() && lines.back().empty())
+        lines.pop_back(); // Trailing newline.
+    if (lines.empty())
+        throw Exception("Chunked lod manifest is missing the lod info");
+
+    Manifest result;
+    std::vector<std::string_view> fields = splitString(lines[0], '\t');
+    if (fields.size() != 3)
+        throw Exception("Invalid lod info line in chunked lod manifest");
+    result.info.version = fromString<LodVersion>(fields[0]);
+    result.info.rootName = fields[1];
+    result.info.description = fields[2];
+
+    for (size_t i = 1; i < lines.size(); i++) {
+        splitString(lines[i], '\t', &fields);
+        if (fields.size() != 2 || fields[0].empty() || fields[1].empty())
+            throw Exception("Invalid entry line {} in chunked lod manifest", i + 2);
+        result.entries.push_back(ManifestEntry{std::string(fields[0]), std::string(fields[1])});
+    }
+
+    return result;
+}
+
+LodChunkStore::LodChunkStore(std::string_view path) : _path(path) {}
+
+Blob LodChunkStore::write(const LodReader &lod) const {
+    std::filesystem::create_directories(_path); // This might throw.
+
+    std::string manifest;
+    StringOutputStream stream(&manifest);
+    stream.write(MANIFEST_SIGNATURE);
+    stream.write(fmt::format("{}\t{}\t{}\n", toString(lod.info().version), lod.info().rootName, lod.info().description));
+
+    for (const std::string &name : lod.ls()) {
+        Blob data = lod.read(name);
+        std::string baseName = fmt::format("{:016x}-{:x}", hashChunk(data), data.size());
+
+        // On a hash collision the chunk gets a numeric suffix.
+        for (int suffix = 0;; suffix++) {
+            std::string chunk = suffix == 0 ? baseName : fmt::format("{}-{}", baseName, suffix);
+            std::string path = (std::filesystem::path(_path) / chunk).string();
+
+            if (std::filesystem::exists(path)) {
+                Blob existing = Blob::fromFile(path);
+                if (existing.string_view() != data.string_view())
+                    continue;
+            } else {
+                TempFileOutputStream output(path);
+                output.write(data.string_view());
+                output.close();
+            }
+
+            stream.write(fmt::format("{}\t{}\n", name, chunk));
+            break;
+        }
+    }
+
+    stream.close();
+    return Blob::fromString(std::move(manifest));
+}
+
+Blob LodChunkStore::assemble(const Blob &manifest, std::span<const std::string> names) const {
+    Manifest parsed = parseManifest(manifest);
+
+    Blob result;
+    BlobOutputStream stream(&result);
+    LodWriter writer(&stream, _path, parsed.info);
+    for (const ManifestEntry &entry : parsed.entries) {
+        if (!names.empty() && std::ranges::none_of(names, [&](const std::string &name) { return iequals(name, entry.name); }))
+            continue;
+
+        std::string path = (std::filesystem::path(_path) / entry.chunk).string();
+        if (!std::filesystem::exists(path))
+            throw Exception("Chunk '{}' for lod entry '{}' is missing from '{}'", entry.chunk, entry.name, _path);
+        writer.write(entry.name, Blob::fromFile(path));
+    }
+    writer.close();
+    stream.close();
+    return result;
+}
+
+size_t LodChunkStore::collectGarbage(std::span<const Blob> manifests) const {
+    std::unordered_set<std::string> used;
+    for (const Blob &manifest : manifests)
+        for (const ManifestEntry &entry : parseManifest(manifest).entries)
+            used.insert(entry.chunk);
+
+    std::error_code ec;
+    if (!std::filesystem::exists(_path, ec))
+        return 0;
+
+    size_t result = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(_path)) {
+        if (!entry.is_regular_file() || used.contains(entry.path().filename().string()))
+            continue;
+        if (std::filesystem::remove(entry.path(), ec))
+            result++;
+    }
+    return result;
+}
+
+bool LodChunkStore::isManifest(const Blob &data) {
+    return data.string_view().starts_with(MANIFEST_SIGNATURE);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Utility/Memory/Blob.h"
+
+class LodReader;
+
+/**
+ * Content-addressed store for LOD entries, backs OpenEnroth chunked saves.
+ *
+ * A chunked LOD is a small text manifest that lists the entries of the LOD in order, with each entry referencing a
+ * chunk file in the store directory. Chunk file names are derived from the entry contents, so identical entries are
+ * shared between all the manifests that use the same store, and writing a LOD only writes out the chunks that the
+ * store doesn't have yet.
+ *
+ * Manifest layout is a signature line, a line with the LOD info, and then one line per entry:
+ * ```
+ * OpenEnroth chunked lod 1
+ * <version>\t<root name>\t<description>
+ * <entry name>\t<chunk name>
+ * ...
+ * ```
+ *
+ * A chunked LOD can always be assembled back into a regular LOD with `assemble`, with the same LOD info and the same
+ * entries as the original one.
+ */
+class LodChunkStore {
+ public:
+    /**
+     * @param path                      Path to the store directory. Created on first write if it doesn't exist.
+     */
+    explicit LodChunkStore(std::string_view path);
+
+    /**
+     * @return                          Path to the store directory.
+     */
+    [[nodiscard]] const std::string &path() const {
+        return _path;
+    }
+
+    /**
+     * Writes out the chunks for all entries of the provided LOD that are not yet in the store.
+     *
+     * @param lod                       LOD to store.
+     * @return                          Manifest for the provided LOD.
+     * @throw Exception                 On write errors.
+     */
+    [[nodiscard]] Blob write(const LodReader &lod) const;
+
+    /**
+     * @param manifest                  Manifest, as returned by `write`.
+     * @param names                     Names of the entries to include. Empty span means all entries.
+     * @return                          Regular LOD assembled from the chunks listed in the manifest.
+     * @throw Exception                 If the manifest is invalid, or if some of the chunks are missing.
+     */
+    [[nodiscard]] Blob assemble(const Blob &manifest, std::span<const std::string> names = {}) const;
+
+    /**
+     * Deletes all chunks that are not referenced by the provided manifests.
+     *
+     * @param manifests                 All manifests that use this store.
+     * @return                          Number of deleted chunks.
+     * @throw Exception                 If one of the manifests is invalid.
+     */
+    size_t collectGarbage(std::span<const Blob> manifests) const;
+
+    /**
+     * @param data                      File contents to check.
+     * @return                          Whether the provided data looks like a chunked LOD manifest.
+     */
+    [[nodiscard]] static bool isManifest(const Blob &data);
+
+ private:
+    std::string _path;
+};
@@ -99,7 +99,7 @@ void LodReader::open(Blob blob, std::string_view path, LodOpenFlags openFlags) {
     rootEntry.dataSize = blob.size() - rootEntry.dataOffset;
 
     BlobInputStream dirStream(blob.subBlob(rootEntry.dataOffset, rootEntry.dataSize));
-    std::unordered_map<std::string, LodRegion> files;
+    std::unordered_map<std::string, LodRegion, IHash, IEqual> files;
     for (const LodEntry &entry : parseFileEntries(dirStream, rootEntry, version, path)) {
         std::string name = toLower(entry.name);
         if (files.contains(name)) {
@@ -136,17 +136,22 @@ void LodReader::close() {
 bool LodReader::exists(const std::string &filename) const {
     assert(isOpen());
 
-    return _files.contains(toLower(filename));
+    return _files.contains(filename);
 }
 
 Blob LodReader::read(const std::string &filename) const {
+    LodRegion region = this->region(filename);
+    return _lod.subBlob(region.offset, region.size);
+}
+
+LodReader::LodRegion LodReader::region(const std::string &filename) const {
     assert(isOpen());
 
-    const auto pos = _files.find(toLower(filename));
+    const auto pos = _files.find(filename);
     if (pos == _files.cend())
         throw Exception("Entry '{}' doesn't exist in LOD file '{}'", filename, _path);
 
-    return _lod.subBlob(pos->second.offset, pos->second.size);
+    return pos->second;
 }
 
 std::vector<std::string> LodReader::ls() const {
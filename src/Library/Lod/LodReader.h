@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "Utility/Memory/Blob.h"
+#include "Utility/String.h"
 
 #include "LodEnums.h"
 #include "LodInfo.h"
@@ -20,6 +21,11 @@ class InputStream;
  */
 class LodReader final {
  public:
+    struct LodRegion {
+        size_t offset = 0;
+        size_t size = 0;
+    };
+
     LodReader();
     LodReader(std::string_view path, LodOpenFlags openFlags = 0);
     LodReader(Blob blob, std::string_view path, LodOpenFlags openFlags = 0);
@@ -50,6 +56,20 @@ class LodReader final {
         return !!_lod;
     }
 
+    /**
+     * @return                          Path to the LOD file, as was passed to `open`.
+     */
+    [[nodiscard]] const std::string &path() const {
+        return _path;
+    }
+
+    /**
+     * @return                          Raw LOD data. Blobs returned from `read` are subblobs of it.
+     */
+    [[nodiscard]] const Blob &data() const {
+        return _lod;
+    }
+
     /**
      * @param filename                  Name of the LOD file entry.
      * @return                          Whether the file exists inside the LOD. The check is case-insensitive.
@@ -63,6 +83,13 @@ class LodReader final {
      */
     [[nodiscard]] Blob read(const std::string &filename) const;
 
+    /**
+     * @param filename                  Name of the LOD file entry.
+     * @return                          Location of the file's data inside the LOD, as stored in the LOD index.
+     * @throws Exception                If file doesn't exist inside the LOD.
+     */
+    [[nodiscard]] LodRegion region(const std::string &filename) const;
+
     /**
      * @return                          List of all files in a LOD.
      */
@@ -74,15 +101,9 @@ class LodReader final {
      */
     [[nodiscard]] const LodInfo &info() const;
 
- private:
-    struct LodRegion {
-        size_t offset = 0;
-        size_t size = 0;
-    };
-
  private:
     Blob _lod;
     std::string _path;
     LodInfo _info;
-    std::unordered_map<std::string, LodRegion> _files;
+    std::unordered_map<std::string, LodRegion, IHash, IEqual> _files; // Keys are lowercased, see `ls`.
 };
@@ -0,0 +1,94 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Lod/LodChunkStore.h"
+#include "Library/Lod/LodReader.h"
+#include "Library/Lod/LodWriter.h"
+
+#include "Utility/Streams/BlobOutputStream.h"
+
+static Blob makeLod(const LodInfo &info, const std::vector<std::pair<std::string, std::string>> &entries) {
+    Blob result;
+    BlobOutputStream stream(&result);
+    LodWriter writer(&stream, "some.lod", info);
+    for (const auto &[name, data] : entries)
+        writer.write(name, Blob::fromString(data));
+    writer.close();
+    stream.close();
+    return result;
+}
+
+static size_t countFiles(const std::string &path) {
+    return std::distance(std::filesystem::directory_iterator(path), std::filesystem::directory_iterator());
+}
+
+UNIT_TEST(LodChunkStore, RoundTrip) {
+    std::string storePath = "tmp_chunks_roundtrip";
+
+    auto cleanup = [&] {
+        std::error_code ec;
+        std::filesystem::remove_all(storePath, ec);
+    };
+    cleanup(); // Just in case.
+
+    LodInfo info;
+    info.version = LOD_VERSION_MM7;
+    info.description = "Test LOD";
+    info.rootName = "chapter";
+
+    LodChunkStore store(storePath);
+    Blob manifest = store.write(LodReader(makeLod(info, {{"a", "123"}, {"b", ""}, {"c", std::string(1000, 'c')}}), "some.lod"));
+    EXPECT_TRUE(LodChunkStore::isManifest(manifest));
+    EXPECT_FALSE(LodChunkStore::isManifest(makeLod(info, {})));
+
+    LodReader reader(store.assemble(manifest), "assembled.lod");
+    EXPECT_EQ(reader.info().version, info.version);
+    EXPECT_EQ(reader.info().description, info.description);
+    EXPECT_EQ(reader.info().rootName, info.rootName);
+    EXPECT_EQ(reader.ls(), (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(reader.read("a").string_view(), "123");
+    EXPECT_EQ(reader.read("b").string_view(), "");
+    EXPECT_EQ(reader.read("c").string_view(), std::string(1000, 'c'));
+
+    std::vector<std::string> names = {"C"};
+    LodReader partialReader(store.assemble(manifest, names), "assembled.lod");
+    EXPECT_EQ(partialReader.ls(), (std::vector<std::string>{"c"}));
+
+    cleanup();
+}
+
+UNIT_TEST(LodChunkStore, Deduplication) {
+    std::string storePath = "tmp_chunks_dedup";
+
+    auto cleanup = [&] {
+        std::error_code ec;
+        std::filesystem::remove_all(storePath, ec);
+    };
+    cleanup(); // Just in case.
+
+    LodInfo info;
+    info.version = LOD_VERSION_MM7;
+
+    LodChunkStore store(storePath);
+    std::vector<Blob> manifests;
+    manifests.push_back(store.write(LodReader(makeLod(info, {{"a", "1"}, {"b", "2"}}), "1.lod")));
+    EXPECT_EQ(countFiles(storePath), 2);
+
+    // Unchanged entries are shared, identical entries under different names are shared too.
+    manifests.push_back(store.write(LodReader(makeLod(info, {{"a", "1"}, {"b", "3"}, {"c", "1"}}), "2.lod")));
+    EXPECT_EQ(countFiles(storePath), 3);
+
+    // Dropping the first manifest only frees the chunk for its "b".
+    EXPECT_EQ(store.collectGarbage(std::span(manifests).subspan(1)), 1);
+    EXPECT_EQ(countFiles(storePath), 2);
+
+    LodReader reader(store.assemble(manifests[1]), "2.lod");
+    EXPECT_EQ(reader.read("a").string_view(), "1");
+    EXPECT_EQ(reader.read("b").string_view(), "3");
+    EXPECT_EQ(reader.read("c").string_view(), "1");
+
+    cleanup();
+}
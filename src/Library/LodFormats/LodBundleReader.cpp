@@ -0,0 +1,117 @@
+#include "LodBundleReader.h"
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "Library/Lod/LodReader.h"
+#include "Library/Snapshots/CommonSnapshots.h"
+
+#include "Utility/Exception.h"
+#include "Utility/Hash.h"
+#include "Utility/String.h"
+
+LodBundleReader::LodBundleReader() = default;
+
+LodBundleReader::LodBundleReader(std::string_view path, uint64_t fingerprint) {
+    open(path, fingerprint);
+}
+
+LodBundleReader::~LodBundleReader() = default;
+
+void LodBundleReader::open(std::string_view path, uint64_t fingerprint) {
+    Blob data = Blob::fromFile(path);
+
+    if (data.size() < sizeof(LodBundleHeader_OE))
+        throw Exception("File '{}' is not a valid asset bundle: file is too small", path);
+
+    LodBundleHeader_OE header;
+    memcpy(&header, data.data(), sizeof(header));
+
+    if (std::string_view(header.signature.data(), header.signature.size()) != LOD_BUNDLE_SIGNATURE)
+        throw Exception("File '{}' is not a valid asset bundle: invalid signature", path);
+    if (header.fingerprint != fingerprint)
+        throw Exception("Asset bundle '{}' is out of date: fingerprint mismatch", path);
+    if (header.indexOffset > data.size() || (data.size() - header.indexOffset) / sizeof(LodBundleEntry_OE) < header.entryCount)
+        throw Exception("File '{}' is not a valid asset bundle: index is out of bounds", path);
+
+    std::unordered_map<std::string, LodBundleEntry_OE> index;
+    const LodBundleEntry_OE *entries = reinterpret_cast<const LodBundleEntry_OE *>(static_cast<const char *>(data.data()) + header.indexOffset);
+    for (size_t i = 0; i < header.entryCount; i++) {
+        LodBundleEntry_OE entry;
+        memcpy(&entry, &entries[i], sizeof(entry));
+
+        size_t pixelsSize = static_cast<size_t>(entry.width) * entry.height;
+        bool valid =
+            (entry.type == static_cast<uint32_t>(LOD_FILE_IMAGE) || entry.type == static_cast<uint32_t>(LOD_FILE_SPRITE)) &&
+            entry.pixelsOffset <= header.indexOffset && header.indexOffset - entry.pixelsOffset >= pixelsSize;
+        if (entry.type == static_cast<uint32_t>(LOD_FILE_IMAGE))
+            valid = valid && entry.paletteOffset <= header.indexOffset && header.indexOffset - entry.paletteOffset >= sizeof(Palette);
+        if (!valid)
+            throw Exception("File '{}' is not a valid asset bundle: entry #{} is invalid", path, i);
+
+        std::string name;
+        reconstruct(entry.name, &name);
+        index.emplace(toLower(name), entry);
+    }
+
+    // All good, this is a valid bundle.
+    _path = path;
+    _data = std::move(data);
+    _index = std::move(index);
+}
+
+void LodBundleReader::close() {
+    _path.clear();
+    _data = Blob();
+    _index.clear();
+}
+
+bool LodBundleReader::exists(const std::string &name) const {
+    assert(isOpen());
+
+    return _index.contains(toLower(name));
+}
+
+LodImage LodBundleReader::readImage(const std::string &name) const {
+    const LodBundleEntry_OE &entry = this->entry(name, LOD_FILE_IMAGE);
+    const char *data = static_cast<const char *>(_data.data());
+
+    LodImage result;
+    result.image = GrayscaleImage::copy(entry.width, entry.height, reinterpret_cast<const uint8_t *>(data + entry.pixelsOffset));
+    memcpy(&result.palette, data + entry.paletteOffset, sizeof(Palette));
+    result.zeroIsTransparent = entry.flags != 0;
+    return result;
+}
+
+LodSprite LodBundleReader::readSprite(const std::string &name) const {
+    const LodBundleEntry_OE &entry = this->entry(name, LOD_FILE_SPRITE);
+    const char *data = static_cast<const char *>(_data.data());
+
+    LodSprite result;
+    result.image = GrayscaleImage::copy(entry.width, entry.height, reinterpret_cast<const uint8_t *>(data + entry.pixelsOffset));
+    result.paletteId = entry.flags;
+    return result;
+}
+
+uint64_t LodBundleReader::fingerprint(const LodReader &lod) {
+    // Only the index is hashed, going through the entry contents would mean reading the whole LOD on every startup.
+    uint64_t result = FNV1A_OFFSET_BASIS;
+    for (const std::string &name : lod.ls()) {
+        LodReader::LodRegion region = lod.region(name);
+        uint64_t location[2] = {region.offset, region.size};
+        result = fnv1aHashBytes(name.data(), name.size() + 1, result); // Include the terminating zero as a separator.
+        result = fnv1aHashBytes(location, sizeof(location), result);
+    }
+    return result;
+}
+
+const LodBundleEntry_OE &LodBundleReader::entry(const std::string &name, LodFileFormat type) const {
+    assert(isOpen());
+
+    auto pos = _index.find(toLower(name));
+    if (pos == _index.end() || pos->second.type != static_cast<uint32_t>(type))
+        throw Exception("Entry '{}' doesn't exist in asset bundle '{}'", name, _path);
+    return pos->second;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Utility/Memory/Blob.h"
+
+#include "LodFormats.h"
+#include "LodFormatSnapshots.h"
+
+class LodReader;
+
+/**
+ * Reader for OpenEnroth asset bundles, see `LodBundleWriter` for the format description.
+ *
+ * Bundle file is memory-mapped, so opening a bundle is cheap, and reading an entry boils down to a single copy of
+ * the pixel data.
+ */
+class LodBundleReader {
+ public:
+    LodBundleReader();
+    LodBundleReader(std::string_view path, uint64_t fingerprint);
+    ~LodBundleReader();
+
+    /**
+     * @param path                      Path to the bundle file.
+     * @param fingerprint               Expected fingerprint of the source LOD.
+     * @throw Exception                 If the file is not a valid bundle, or if the fingerprint doesn't match.
+     */
+    void open(std::string_view path, uint64_t fingerprint);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const {
+        return static_cast<bool>(_data);
+    }
+
+    /**
+     * @param name                      Name of the entry to check. The check is case-insensitive.
+     * @return                          Whether the bundle contains a pre-decoded image or sprite with the given name.
+     */
+    [[nodiscard]] bool exists(const std::string &name) const;
+
+    /**
+     * @param name                      Name of the image to read.
+     * @return                          Decoded image.
+     * @throw Exception                 If there is no image with the given name in this bundle.
+     */
+    [[nodiscard]] LodImage readImage(const std::string &name) const;
+
+    /**
+     * @param name                      Name of the sprite to read.
+     * @return                          Decoded sprite.
+     * @throw Exception                 If there is no sprite with the given name in this bundle.
+     */
+    [[nodiscard]] LodSprite readSprite(const std::string &name) const;
+
+    /**
+     * Computes a fingerprint of the provided LOD that's then stored in the bundle. Hashes entry names, offsets and
+     * sizes from the LOD index, so this doesn't touch the entry data. An edit that keeps the layout of every entry
+     * intact goes unnoticed, but LOD editors rewrite the whole index, and any change in an entry's size shifts
+     * the offsets of all entries after it.
+     *
+     * @param lod                       LOD to compute fingerprint for.
+     * @return                          Fingerprint of the provided LOD.
+     */
+    [[nodiscard]] static uint64_t fingerprint(const LodReader &lod);
+
+ private:
+    const LodBundleEntry_OE &entry(const std::string &name, LodFileFormat type) const;
+
+ private:
+    std::string _path;
+    Blob _data;
+    std::unordered_map<std::string, LodBundleEntry_OE> _index;
+};
@@ -0,0 +1,129 @@
+#include "LodBundleWriter.h"
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Library/Snapshots/CommonSnapshots.h"
+
+#include "Utility/Streams/TempFileOutputStream.h"
+#include "Utility/Memory/MemSet.h"
+#include "Utility/String.h"
+
+#include "LodFormatSnapshots.h"
+
+static_assert(sizeof(Palette) == 1024);
+
+static size_t alignUp(size_t offset) {
+    return (offset + LOD_BUNDLE_ALIGNMENT - 1) / LOD_BUNDLE_ALIGNMENT * LOD_BUNDLE_ALIGNMENT;
+}
+
+static void writePadding(OutputStream *stream, size_t *offset) {
+    size_t aligned = alignUp(*offset);
+    if (aligned != *offset)
+        stream->write(std::string(aligned - *offset, '\0'));
+    *offset = aligned;
+}
+
+LodBundleWriter::LodBundleWriter() = default;
+
+LodBundleWriter::LodBundleWriter(std::string_view path, uint64_t fingerprint) {
+    open(path, fingerprint);
+}
+
+LodBundleWriter::~LodBundleWriter() {
+    close();
+}
+
+void LodBundleWriter::open(std::string_view path, uint64_t fingerprint) {
+    std::unique_ptr<OutputStream> stream = std::make_unique<TempFileOutputStream>(path); // If this throws, no field is overwritten.
+
+    close();
+
+    _stream = std::move(stream);
+    _fingerprint = fingerprint;
+}
+
+void LodBundleWriter::close() {
+    if (!isOpen())
+        return; // Double-closing is OK.
+
+    LodBundleHeader_OE header;
+    memzero(&header);
+    memcpy(header.signature.data(), LOD_BUNDLE_SIGNATURE.data(), LOD_BUNDLE_SIGNATURE.size());
+    header.fingerprint = _fingerprint;
+    header.entryCount = _entries.size();
+
+    // Lay out the data first.
+    size_t offset = sizeof(LodBundleHeader_OE);
+    std::vector<LodBundleEntry_OE> index;
+    for (const auto &[name, entry] : _entries) {
+        LodBundleEntry_OE &indexEntry = index.emplace_back();
+        memzero(&indexEntry);
+        snapshot(name, &indexEntry.name);
+        indexEntry.type = static_cast<uint32_t>(entry.type);
+        indexEntry.width = entry.width;
+        indexEntry.height = entry.height;
+        indexEntry.flags = entry.flags;
+
+        offset = alignUp(offset);
+        indexEntry.pixelsOffset = offset;
+        offset += entry.pixels.size();
+
+        if (entry.palette) {
+            offset = alignUp(offset);
+            indexEntry.paletteOffset = offset;
+            offset += entry.palette.size();
+        }
+    }
+    header.indexOffset = alignUp(offset);
+
+    // Then write it out.
+    _stream->write(&header, sizeof(header));
+    offset = sizeof(LodBundleHeader_OE);
+    for (const auto &[_, entry] : _entries) {
+        writePadding(_stream.get(), &offset);
+        _stream->write(entry.pixels.string_view());
+        offset += entry.pixels.size();
+
+        if (entry.palette) {
+            writePadding(_stream.get(), &offset);
+            _stream->write(entry.palette.string_view());
+            offset += entry.palette.size();
+        }
+    }
+    writePadding(_stream.get(), &offset);
+    assert(offset == header.indexOffset);
+    _stream->write(index.data(), index.size() * sizeof(LodBundleEntry_OE));
+
+    _entries.clear();
+    _stream->close();
+    _stream.reset();
+    _fingerprint = 0;
+}
+
+void LodBundleWriter::write(const std::string &name, const LodImage &image) {
+    assert(isOpen());
+
+    Entry &entry = _entries[toLower(name)];
+    entry.type = LOD_FILE_IMAGE;
+    entry.width = image.image.width();
+    entry.height = image.image.height();
+    entry.flags = image.zeroIsTransparent ? 1 : 0;
+    entry.pixels = Blob::copy(image.image.pixels().data(), image.image.pixels().size());
+    entry.palette = Blob::copy(&image.palette, sizeof(Palette));
+}
+
+void LodBundleWriter::write(const std::string &name, const LodSprite &sprite) {
+    assert(isOpen());
+
+    Entry &entry = _entries[toLower(name)];
+    entry.type = LOD_FILE_SPRITE;
+    entry.width = sprite.image.width();
+    entry.height = sprite.image.height();
+    entry.flags = sprite.paletteId;
+    entry.pixels = Blob::copy(sprite.image.pixels().data(), sprite.image.pixels().size());
+    entry.palette = Blob();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "Utility/Memory/Blob.h"
+#include "Utility/Streams/OutputStream.h"
+
+#include "LodFormats.h"
+
+/**
+ * Writer for OpenEnroth asset bundles.
+ *
+ * An asset bundle is a companion file for a stock LOD that contains pre-decoded images and sprites, so that
+ * they can be served straight from a memory mapping without decompression & decoding. Stock LOD stays the source of
+ * truth - bundle stores a fingerprint of the LOD it was created from, and is ignored if the fingerprint doesn't match.
+ *
+ * Bundle layout is a `LodBundleHeader_OE`, followed by aligned pixel & palette data, followed by an index of
+ * `LodBundleEntry_OE` structs.
+ *
+ * @see LodBundleReader
+ */
+class LodBundleWriter {
+ public:
+    LodBundleWriter();
+    LodBundleWriter(std::string_view path, uint64_t fingerprint);
+    ~LodBundleWriter();
+
+    /**
+     * @param path                      Path to the bundle file to write. The file is written out on `close`.
+     * @param fingerprint               Fingerprint of the source LOD, as returned by `LodBundleReader::fingerprint`.
+     * @throw Exception                 If the file couldn't be opened.
+     */
+    void open(std::string_view path, uint64_t fingerprint);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const {
+        return _stream != nullptr;
+    }
+
+    void write(const std::string &name, const LodImage &image);
+    void write(const std::string &name, const LodSprite &sprite);
+
+ private:
+    struct Entry {
+        LodFileFormat type = LOD_FILE_IMAGE;
+        size_t width = 0;
+        size_t height = 0;
+        uint32_t flags = 0;
+        Blob pixels;
+        Blob palette; // Empty for sprites.
+    };
+
+ private:
+    std::unique_ptr<OutputStream> _stream;
+    uint64_t _fingerprint = 0;
+    std::map<std::string, Entry> _entries;
+};
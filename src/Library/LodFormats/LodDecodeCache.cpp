@@ -0,0 +1,64 @@
+#include "LodDecodeCache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+
+#include "Library/Lod/LodReader.h"
+
+#include "Utility/Format.h"
+
+static constexpr std::string_view CACHE_SIGNATURE = "OELODCC2";
+static constexpr size_t MAX_CACHE_SIZE = 512 * 1024 * 1024; // Cache file is compacted once it grows beyond this.
+
+LodDecodeCache::LodDecodeCache() = default;
+
+LodDecodeCache::LodDecodeCache(std::string_view path) {
+    open(path);
+}
+
+LodDecodeCache::~LodDecodeCache() = default;
+
+void LodDecodeCache::open(std::string_view path) {
+    close();
+    _cache.open(path, CACHE_SIGNATURE, MAX_CACHE_SIZE);
+}
+
+void LodDecodeCache::close() {
+    _cache.close();
+
+    std::lock_guard lock(_mutex);
+    _lods.clear();
+}
+
+void LodDecodeCache::attach(const LodReader &lod) {
+    assert(lod.isOpen());
+
+    std::error_code ec;
+    int64_t mtime = std::filesystem::last_write_time(std::filesystem::path(lod.path()), ec).time_since_epoch().count();
+
+    std::lock_guard lock(_mutex);
+    std::erase_if(_lods, [&](const AttachedLod &attached) { return attached.path == lod.path(); });
+    _lods.push_back({lod.path(), ec ? 0 : mtime, Blob::share(lod.data())});
+}
+
+std::string LodDecodeCache::key(const Blob &blob) {
+    std::lock_guard lock(_mutex);
+    for (const AttachedLod &lod : _lods) {
+        uintptr_t begin = reinterpret_cast<uintptr_t>(lod.data.data());
+        uintptr_t pos = reinterpret_cast<uintptr_t>(blob.data());
+        if (pos >= begin && pos - begin + blob.size() <= lod.data.size())
+            return fmt::format("{}|{}|{}|{}", lod.path, lod.mtime, pos - begin, blob.size());
+    }
+    return {};
+}
+
+std::optional<Blob> LodDecodeCache::find(const std::string &key) {
+    return _cache.find(key);
+}
+
+void LodDecodeCache::insert(const std::string &key, const Blob &data) {
+    _cache.insert(key, data);
+}
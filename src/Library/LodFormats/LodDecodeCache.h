@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Library/BlobCache/BlobCache.h"
+
+#include "Utility/Memory/Blob.h"
+
+class LodReader;
+
+/**
+ * Persistent on-disk cache for the results of `lod::decodeCompressed`.
+ *
+ * LODs are attached to the cache with `attach`, and once the cache is installed with `lod::setDecodeCache`,
+ * `lod::decodeCompressed` calls for the blobs returned from `LodReader::read` go through the cache, so the callers
+ * don't need to know about it. Cache entries are keyed by LOD path, LOD modification time and entry location inside
+ * the LOD, so modifying a LOD file automatically invalidates all the cache entries for it.
+ *
+ * Only the entries that actually need inflating are cached, there is no point in caching stored ones.
+ *
+ * This class is thread-safe. Note that the lookups and the insertions are separate calls, so that the actual inflating
+ * can happen outside of any locks.
+ */
+class LodDecodeCache {
+ public:
+    LodDecodeCache();
+    explicit LodDecodeCache(std::string_view path);
+    ~LodDecodeCache();
+
+    /**
+     * @param path                      Path to the cache file, see `BlobCache::open`.
+     * @throw Exception                 If the cache file exists, but couldn't be read.
+     */
+    void open(std::string_view path);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const {
+        return _cache.isOpen();
+    }
+
+    /**
+     * Starts caching the decoded entries of the provided LOD. The LOD data is retained until the cache is closed or
+     * another LOD with the same path is attached, so that the memory range it occupies can't be reused by some other
+     * data while the cache is still looking at it.
+     *
+     * Only attach LODs that don't change much. E.g. there's no point in caching the save LOD.
+     *
+     * @param lod                       LOD to attach, must be opened from a file.
+     */
+    void attach(const LodReader &lod);
+
+    /**
+     * @param blob                      Compressed LOD entry, as returned from `LodReader::read`.
+     * @return                          Cache key for the entry, or an empty string if `blob` doesn't come from one of
+     *                                  the attached LODs.
+     */
+    [[nodiscard]] std::string key(const Blob &blob);
+
+    /**
+     * @param key                       Cache key, as returned from `key`.
+     * @return                          Decoded entry, or `std::nullopt` if it's not in the cache.
+     */
+    [[nodiscard]] std::optional<Blob> find(const std::string &key);
+
+    /**
+     * @param key                       Cache key, as returned from `key`.
+     * @param data                      Decoded entry.
+     */
+    void insert(const std::string &key, const Blob &data);
+
+ private:
+    struct AttachedLod {
+        std::string path;
+        int64_t mtime = 0;
+        Blob data;
+    };
+
+ private:
+    BlobCache _cache;
+    std::mutex _mutex; // Protects `_lods`.
+    std::vector<AttachedLod> _lods;
+};
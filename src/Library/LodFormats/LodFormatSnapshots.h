@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <array>
+#include <string_view>
 
 #include "Library/Binary/MemCopySerialization.h"
 
@@ -69,4 +70,33 @@ struct LodSpriteLine_MM6 {
 static_assert(sizeof(LodSpriteLine_MM6) == 8);
 MM_DECLARE_MEMCOPY_SERIALIZABLE(LodSpriteLine_MM6)
 
+/**
+ * Header of an OpenEnroth asset bundle, see `LodBundleWriter`. All offsets in a bundle are from the start of the file,
+ * and all data chunks are aligned at `LOD_BUNDLE_ALIGNMENT`.
+ */
+struct LodBundleHeader_OE {
+    std::array<char, 8> signature; // Always `LOD_BUNDLE_SIGNATURE`, not zero-terminated.
+    uint64_t fingerprint; // Fingerprint of the source LOD, see `LodBundleReader::fingerprint`.
+    uint32_t entryCount; // Number of `LodBundleEntry_OE` structs in the index.
+    uint32_t unk_0; // Always 0.
+    uint64_t indexOffset; // Offset of the index.
+};
+static_assert(sizeof(LodBundleHeader_OE) == 32);
+MM_DECLARE_MEMCOPY_SERIALIZABLE(LodBundleHeader_OE)
+
+struct LodBundleEntry_OE {
+    std::array<char, 32> name; // Lowercase entry name.
+    uint32_t type; // `LodFileFormat`, either `LOD_FILE_IMAGE` or `LOD_FILE_SPRITE`.
+    uint32_t width;
+    uint32_t height;
+    uint32_t flags; // For images - 1 if zero palette entry is transparent. For sprites - palette id.
+    uint64_t pixelsOffset; // Offset of the 8-bit indexed pixel data, width * height bytes.
+    uint64_t paletteOffset; // Offset of the palette, 256 RGBA colors. Only for images, 0 for sprites.
+};
+static_assert(sizeof(LodBundleEntry_OE) == 64);
+MM_DECLARE_MEMCOPY_SERIALIZABLE(LodBundleEntry_OE)
+
 #pragma pack(pop)
+
+static constexpr size_t LOD_BUNDLE_ALIGNMENT = 16;
+static constexpr std::string_view LOD_BUNDLE_SIGNATURE = "OELODBN1";
@@ -2,8 +2,11 @@
 
 #include <optional>
 #include <span>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "LodDecodeCache.h"
 #include "LodFormatSnapshots.h"
 
 #include "Library/Binary/ContainerSerialization.h"
@@ -14,9 +17,12 @@
 #include "Utility/Streams/MemoryInputStream.h"
 #include "Utility/Streams/BlobInputStream.h"
 #include "Utility/Memory/Blob.h"
+#include "Utility/Memory/MemoryAccounting.h"
 #include "Utility/String.h"
 #include "Utility/Exception.h"
 
+static LodDecodeCache *globalDecodeCache = nullptr;
+
 static void deserialize(InputStream &src, Palette *dst) {
     std::array<std::uint8_t, 0x300> rawPalette;
     src.readOrFail(rawPalette.data(), rawPalette.size());
@@ -104,27 +110,36 @@ LodFileFormat lod::magic(const Blob &blob, const std::string &fileName) {
     return LOD_FILE_RAW;
 }
 
-Blob lod::decodeCompressed(const Blob &blob) {
-    LodFileFormat format = magic(blob, {});
-    if (format == LOD_FILE_RAW)
-        return Blob::share(blob); // Not compressed.
+/**
+ * Parses the header of a compressed LOD entry.
+ *
+ * @param blob                          `Blob` from a LOD file.
+ * @param[out] payload                  Payload of the entry, compressed if `decompressedSize` is non-zero.
+ * @param[out] decompressedSize         Decompressed size of the payload, zero if the payload is not compressed.
+ * @throw Exception                     If the provided `Blob` is of unsupported type.
+ */
+static void parseCompressed(const Blob &blob, Blob *payload, size_t *decompressedSize) {
+    LodFileFormat format = lod::magic(blob, {});
+    if (format == LOD_FILE_RAW) {
+        *payload = Blob::share(blob); // Not compressed.
+        *decompressedSize = 0;
+        return;
+    }
 
     if (format == LOD_FILE_COMPRESSED) {
         BlobInputStream stream(blob);
         LodCompressionHeader_MM6 header;
         deserialize(stream, &header);
 
-        Blob result;
         if (header.dataSize == blob.size()) {
             // Workaround for a bug in the original LOD writer, where header.dataSize was equal to LOD record size,
             // instead of the size of the data that followed.
-            result = stream.tail();
+            *payload = stream.tail();
         } else {
-            result = stream.readBlobOrFail(header.dataSize);
+            *payload = stream.readBlobOrFail(header.dataSize);
         }
-        if (header.decompressedSize)
-            result = zlib::uncompress(result, header.decompressedSize);
-        return result;
+        *decompressedSize = header.decompressedSize;
+        return;
     }
 
     if (format == LodFileFormat::LOD_FILE_PSEUDO_IMAGE) {
@@ -132,17 +147,82 @@ Blob lod::decodeCompressed(const Blob &blob) {
         LodImageHeader_MM6 header;
         deserialize(stream, &header);
 
-        Blob result = stream.readBlobOrFail(header.dataSize);
-        if (header.decompressedSize)
-            result = zlib::uncompress(result, header.decompressedSize);
-        return result;
+        *payload = stream.readBlobOrFail(header.dataSize);
+        *decompressedSize = header.decompressedSize;
+        return;
     }
 
     throw Exception("Cannot uncompress LOD entry of type '{}', operation is not supported", toString(format));
 }
 
-Blob lod::encodeCompressed(const Blob &blob) {
-    Blob compressed = zlib::compress(blob);
+Blob lod::decodeCompressed(const Blob &blob) {
+    MemoryTagScope memoryScope(MEMORY_TAG_LOD);
+
+    Blob result;
+    size_t decompressedSize = 0;
+    parseCompressed(blob, &result, &decompressedSize);
+    if (!decompressedSize)
+        return result;
+
+    // Cache is only locked for the lookup & the insertion, inflating happens outside the lock.
+    std::string key = globalDecodeCache ? globalDecodeCache->key(blob) : std::string();
+    if (!key.empty())
+        if (std::optional<Blob> cached = globalDecodeCache->find(key))
+            return std::move(*cached);
+
+    result = zlib::uncompress(result, decompressedSize);
+    if (!key.empty())
+        globalDecodeCache->insert(key, result);
+    return result;
+}
+
+std::vector<Blob> lod::decodeCompressed(std::span<const Blob> blobs, ThreadPool *pool) {
+    MemoryTagScope memoryScope(MEMORY_TAG_LOD);
+
+    std::vector<Blob> result(blobs.size());
+    std::vector<Blob> payloads;
+    std::vector<size_t> sizeHints;
+    std::vector<size_t> indices;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < blobs.size(); i++) {
+        Blob payload;
+        size_t decompressedSize = 0;
+        parseCompressed(blobs[i], &payload, &decompressedSize);
+
+        if (decompressedSize == 0) {
+            result[i] = std::move(payload);
+            continue;
+        }
+
+        std::string key = globalDecodeCache ? globalDecodeCache->key(blobs[i]) : std::string();
+        if (!key.empty()) {
+            if (std::optional<Blob> cached = globalDecodeCache->find(key)) {
+                result[i] = std::move(*cached);
+                continue;
+            }
+        }
+
+        payloads.push_back(std::move(payload));
+        sizeHints.push_back(decompressedSize);
+        indices.push_back(i);
+        keys.push_back(std::move(key));
+    }
+
+    std::vector<Blob> uncompressed = zlib::uncompress(payloads, sizeHints, pool);
+    for (size_t i = 0; i < indices.size(); i++) {
+        if (!keys[i].empty())
+            globalDecodeCache->insert(keys[i], uncompressed[i]);
+        result[indices[i]] = std::move(uncompressed[i]);
+    }
+    return result;
+}
+
+void lod::setDecodeCache(LodDecodeCache *cache) {
+    globalDecodeCache = cache;
+}
+
+Blob lod::encodeCompressed(const Blob &blob, CompressionLevel level) {
+    Blob compressed = zlib::compress(blob, level);
 
     LodCompressionHeader_MM6 header;
     header.version = 91969;
@@ -212,8 +292,8 @@ LodSprite lod::decodeSprite(const Blob &blob) {
     LodSpriteHeader_MM6 header;
     deserialize(stream, &header);
 
-    std::vector<LodSpriteLine_MM6> lines;
-    deserialize(stream, &lines, tags::presized(header.height));
+    std::span<const LodSpriteLine_MM6> lines;
+    deserialize(stream, &lines, tags::presized(header.height)); // Zero-copy, points into the blob.
 
     Blob pixels = stream.readBlobOrFail(header.dataSize);
     if (header.decompressedSize)
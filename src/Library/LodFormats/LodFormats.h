@@ -1,13 +1,18 @@
 #pragma once
 
+#include <span>
 #include <string>
+#include <vector>
 
+#include "Library/Compression/Compression.h"
 #include "Library/Image/Image.h"
 #include "Library/Image/Palette.h"
 
 #include "LodFormatEnums.h"
 
 class Blob;
+class LodDecodeCache;
+class ThreadPool;
 
 struct LodSprite {
     GrayscaleImage image;
@@ -31,19 +36,46 @@ LodFileFormat magic(const Blob &blob, const std::string &fileName);
  *
  * In case of `LOD_FILE_RAW`, it just does nothing and returns the blob as is.
  *
+ * If a decode cache was installed with `setDecodeCache`, entries of the LODs attached to it are served from it.
+ *
  * @param blob                          `Blob` from a LOD file.
  * @return                              Uncompressed `Blob`.
  * @throw Exception                     If the provided `Blob` is of unsupported type.
  */
 Blob decodeCompressed(const Blob &blob);
 
+/**
+ * Batch version of `decodeCompressed` that inflates the provided blobs in parallel.
+ *
+ * Headers are parsed on the calling thread, so this function throws on invalid input before any work is dispatched
+ * to the thread pool.
+ *
+ * @param blobs                         `Blob`s from a LOD file.
+ * @param pool                          Thread pool to use, can be `nullptr`.
+ * @return                              Uncompressed `Blob`s, in the same order as `blobs`.
+ * @throw Exception                     If any of the provided `Blob`s is of unsupported type.
+ * @see zlib::uncompress
+ */
+std::vector<Blob> decodeCompressed(std::span<const Blob> blobs, ThreadPool *pool);
+
+/**
+ * Installs the cache that `decodeCompressed` goes through. Not thread-safe, should be called before any decoding
+ * starts, and the cache should outlive all `decodeCompressed` calls.
+ *
+ * @param cache                         Cache to use, or `nullptr` to disable caching.
+ */
+void setDecodeCache(LodDecodeCache *cache);
+
 /**
  * This function compresses the provided `Blob` into the `LOD_FILE_COMPRESSED` format.
  *
+ * The output is always readable by vanilla, regardless of the compression level used.
+ *
  * @param blob                          `Blob` to compress.
+ * @param level                         Compression level to use.
  * @return                              Compressed `Blob` in `LOD_FILE_COMPRESSED` format.
  */
-Blob encodeCompressed(const Blob &blob);
+Blob encodeCompressed(const Blob &blob, CompressionLevel level = COMPRESSION_DEFAULT);
 
 /**
  * This function processes `LOD_FILE_PALETTE` and `LOD_FILE_IMAGE` formats. In case of the latter, the pixel data
@@ -0,0 +1,57 @@
+#include <filesystem>
+#include <string>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Lod/LodReader.h"
+#include "Library/Lod/LodWriter.h"
+#include "Library/LodFormats/LodBundleReader.h"
+#include "Library/LodFormats/LodBundleWriter.h"
+
+#include "Utility/Streams/BlobOutputStream.h"
+#include "Utility/Exception.h"
+
+static LodReader makeLod(const std::string &file1, const std::string &file2) {
+    LodInfo info;
+    info.version = LOD_VERSION_MM7;
+    info.rootName = "data";
+
+    Blob lod;
+    BlobOutputStream stream(&lod);
+    LodWriter writer(&stream, "some.lod", info);
+    writer.write("1", Blob::view(file1));
+    writer.write("2", Blob::view(file2));
+    writer.close();
+    stream.close();
+
+    return LodReader(std::move(lod), "some.lod");
+}
+
+UNIT_TEST(LodBundleReader, FingerprintSeesLayout) {
+    LodReader lod1 = makeLod("1234", std::string(1000, 'a'));
+    LodReader lod2 = makeLod("12345", std::string(1000, 'a')); // Shifts the second entry.
+    LodReader lod3 = makeLod("1234", std::string(1001, 'a'));
+    LodReader lod4 = makeLod("4321", std::string(1000, 'b')); // Same layout, different bytes.
+
+    EXPECT_NE(LodBundleReader::fingerprint(lod1), LodBundleReader::fingerprint(lod2));
+    EXPECT_NE(LodBundleReader::fingerprint(lod1), LodBundleReader::fingerprint(lod3));
+    EXPECT_EQ(LodBundleReader::fingerprint(lod1), LodBundleReader::fingerprint(lod4)); // Contents are not hashed.
+}
+
+UNIT_TEST(LodBundleReader, StaleBundleRejected) {
+    std::string path = "tmp_test.bundle";
+
+    LodReader lod1 = makeLod("1234", "abcd");
+    LodReader lod2 = makeLod("1234", "abcde");
+
+    LodImage image;
+    image.image = GrayscaleImage::solid(2, 2, 1);
+    LodBundleWriter writer(path, LodBundleReader::fingerprint(lod1));
+    writer.write("image", image);
+    writer.close();
+
+    EXPECT_NO_THROW((void) LodBundleReader(path, LodBundleReader::fingerprint(lod1)));
+    EXPECT_THROW((void) LodBundleReader(path, LodBundleReader::fingerprint(lod2)), Exception);
+
+    std::filesystem::remove(path);
+}
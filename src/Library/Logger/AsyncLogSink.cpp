@@ -0,0 +1,155 @@
+#include "AsyncLogSink.h"
+
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <string>
+
+#ifdef _WINDOWS
+#   include <io.h>
+#else
+#   include <unistd.h>
+#endif
+
+#include "Utility/Format.h"
+
+#include "LogCategory.h"
+
+static LogCategory asyncLogCategory("async_log");
+
+// Records are preallocated to hold messages of this size without reallocating.
+static constexpr size_t RECORD_MESSAGE_RESERVE = 256;
+
+// Max time `flush` waits for the background thread to finish draining.
+static constexpr std::chrono::milliseconds FLUSH_TIMEOUT(1000);
+
+AsyncLogSink::AsyncLogSink(LogSink *target, AsyncLogPolicy policy, size_t capacity) : _target(target), _policy(policy) {
+    assert(target);
+    assert(capacity > 0);
+
+    capacity = std::bit_ceil(capacity);
+    _mask = capacity - 1;
+    _records = std::make_unique<Record[]>(capacity);
+    for (size_t i = 0; i < capacity; i++) {
+        _records[i].sequence.store(i, std::memory_order_relaxed);
+        _records[i].message.reserve(RECORD_MESSAGE_RESERVE);
+    }
+
+    _thread = std::thread(&AsyncLogSink::run, this);
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    _stopping.store(true, std::memory_order_release);
+    _writeCount.fetch_add(1, std::memory_order_release);
+    _writeCount.notify_one();
+    _thread.join();
+}
+
+void AsyncLogSink::write(const LogCategory &category, LogLevel level, std::string_view message) {
+    // This is Vyukov's bounded queue. Record's sequence number is equal to the write position it's waiting for
+    // when it's free, and to write position + 1 when it holds a message.
+    size_t pos = _writePos.load(std::memory_order_relaxed);
+    Record *record = nullptr;
+    while (true) {
+        record = &_records[pos & _mask];
+        size_t sequence = record->sequence.load(std::memory_order_acquire);
+        ptrdiff_t diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (_writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            // Queue is full.
+            if (_policy == ASYNC_LOG_DROP) {
+                _droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+            pos = _writePos.load(std::memory_order_relaxed);
+        } else {
+            pos = _writePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->category = &category;
+    record->level = level;
+    record->message.assign(message);
+    record->sequence.store(pos + 1, std::memory_order_release);
+
+    _writeCount.fetch_add(1, std::memory_order_release);
+    _writeCount.notify_one();
+}
+
+void AsyncLogSink::flush() {
+    auto lock = std::unique_lock(_drainMutex, std::defer_lock);
+    if (!lock.try_lock_for(FLUSH_TIMEOUT))
+        return;
+    drain();
+}
+
+/**
+ * Async-signal-safe way to write to a file descriptor.
+ */
+static void writeToFd(int fd, std::string_view data) {
+    while (!data.empty()) {
+#ifdef _WINDOWS
+        int written = _write(fd, data.data(), static_cast<unsigned int>(data.size()));
+#else
+        ssize_t written = ::write(fd, data.data(), data.size());
+#endif
+        if (written <= 0)
+            return; // Nothing we can do here.
+        data.remove_prefix(written);
+    }
+}
+
+void AsyncLogSink::crashFlush(int fd) {
+    // Bounded by queue capacity in case other threads keep logging.
+    size_t readPos = _readPos.load(std::memory_order_acquire);
+    for (size_t pos = readPos; pos <= readPos + _mask; pos++) {
+        const Record &record = _records[pos & _mask];
+        if (record.sequence.load(std::memory_order_acquire) != pos + 1)
+            break;
+
+        writeToFd(fd, record.category->name());
+        writeToFd(fd, ": ");
+        writeToFd(fd, record.message);
+        writeToFd(fd, "\n");
+    }
+}
+
+void AsyncLogSink::run() {
+    while (true) {
+        uint64_t writeCount = _writeCount.load(std::memory_order_acquire);
+
+        {
+            auto lock = std::lock_guard(_drainMutex);
+            drain();
+        }
+
+        if (_stopping.load(std::memory_order_acquire))
+            break;
+
+        _writeCount.wait(writeCount, std::memory_order_acquire);
+    }
+
+    // Producers might have managed to squeeze in something right before the destructor was called.
+    auto lock = std::lock_guard(_drainMutex);
+    drain();
+}
+
+void AsyncLogSink::drain() {
+    size_t readPos = _readPos.load(std::memory_order_relaxed);
+    while (true) {
+        Record &record = _records[readPos & _mask];
+        if (record.sequence.load(std::memory_order_acquire) != readPos + 1)
+            break;
+
+        _target->write(*record.category, record.level, record.message);
+        record.sequence.store(readPos + _mask + 1, std::memory_order_release);
+        readPos++;
+        _readPos.store(readPos, std::memory_order_release);
+    }
+
+    if (size_t droppedCount = _droppedCount.exchange(0, std::memory_order_relaxed))
+        _target->write(asyncLogCategory, LOG_WARNING, fmt::format("Log queue overflow, dropped {} messages.", droppedCount));
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "LogSink.h"
+
+/**
+ * Log sink wrapper that writes to the target sink from a background thread.
+ *
+ * Logging threads copy the messages into the preallocated records of a bounded lock-free MPSC ring buffer, so
+ * logging doesn't block on the target sink's IO. What happens when the buffer is full is controlled by the
+ * `AsyncLogPolicy` passed to the constructor.
+ *
+ * Messages that were logged before the crash are lost unless they are written out, so it makes sense to call
+ * `crashFlush` from a crash handler, see `StackTraceOnCrash::setCrashCallback`.
+ */
+class AsyncLogSink : public LogSink {
+ public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    /**
+     * @param target                    Sink to write to. Must be thread-safe if it's also used directly, and must
+     *                                  outlive this object.
+     * @param policy                    What to do when the queue is full.
+     * @param capacity                  Queue capacity, in messages. Will be rounded up to the next power of two.
+     */
+    explicit AsyncLogSink(LogSink *target, AsyncLogPolicy policy = ASYNC_LOG_DROP, size_t capacity = DEFAULT_CAPACITY);
+    virtual ~AsyncLogSink();
+
+    virtual void write(const LogCategory &category, LogLevel level, std::string_view message) override;
+
+    /**
+     * Writes out all the queued messages from the calling thread.
+     *
+     * Gives up if the background thread doesn't release the target sink in a reasonable time. Takes locks and calls
+     * into the target sink, so it's not safe to call from a signal handler, use `crashFlush` there.
+     */
+    void flush();
+
+    /**
+     * Writes the queued messages directly into the provided file descriptor with `write(2)`, bypassing the target
+     * sink. Doesn't take locks and doesn't allocate, so it's safe to call from a signal handler.
+     *
+     * The queue is left as is, so if the background thread is draining the queue at the same time, some messages
+     * might end up written out twice.
+     *
+     * @param fd                        File descriptor to write to, e.g. 2 for `stderr`.
+     */
+    void crashFlush(int fd);
+
+    /**
+     * @return                          Number of messages that were dropped because the queue was full. Reset
+     *                                  each time the drop is reported to the target sink.
+     */
+    [[nodiscard]] size_t droppedCount() const {
+        return _droppedCount.load(std::memory_order_relaxed);
+    }
+
+ private:
+    struct Record {
+        std::atomic<size_t> sequence = 0;
+        const LogCategory *category = nullptr;
+        LogLevel level = LOG_TRACE;
+        std::string message;
+    };
+
+    void run();
+    void drain();
+
+ private:
+    LogSink *_target = nullptr;
+    AsyncLogPolicy _policy = ASYNC_LOG_DROP;
+    size_t _mask = 0;
+    std::unique_ptr<Record[]> _records;
+    alignas(64) std::atomic<size_t> _writePos = 0;
+    alignas(64) std::atomic<size_t> _readPos = 0; // Only written under `_drainMutex`, atomic for `crashFlush`.
+    std::atomic<size_t> _droppedCount = 0;
+    std::atomic<uint64_t> _writeCount = 0; // Background thread waits on this one.
+    std::atomic<bool> _stopping = false;
+    std::timed_mutex _drainMutex;
+    std::thread _thread;
+};
@@ -15,3 +15,12 @@ enum class LogLevel {
 };
 using enum LogLevel;
 MM_DECLARE_SERIALIZATION_FUNCTIONS(LogLevel)
+
+/**
+ * What `AsyncLogSink` should do when its queue is full.
+ */
+enum class AsyncLogPolicy {
+    ASYNC_LOG_DROP, // Drop the message. Number of dropped messages is reported once there is space in the queue.
+    ASYNC_LOG_BLOCK // Block the logging thread until there is space in the queue.
+};
+using enum AsyncLogPolicy;
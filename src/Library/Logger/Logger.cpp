@@ -1,6 +1,11 @@
 #include "Logger.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <string_view>
+
+#include "Utility/ScopeGuard.h"
 
 #include "LogSink.h"
 #include "LogSource.h"
@@ -23,7 +28,24 @@ Logger::~Logger() {
 }
 
 void Logger::logV(const LogCategory &category, LogLevel level, fmt::string_view fmt, fmt::format_args args) {
-    _sink->write(category, level, fmt::vformat(fmt, args));
+    // Format into a thread-local buffer so that we don't allocate on each call. If a formatter or the sink logs
+    // something while the buffer is in use, the nested call gets a buffer of its own.
+    thread_local fmt::memory_buffer threadBuffer;
+    thread_local bool threadBufferInUse = false;
+
+    if (threadBufferInUse) {
+        fmt::memory_buffer buffer;
+        fmt::vformat_to(std::back_inserter(buffer), fmt, args);
+        _sink->write(category, level, std::string_view(buffer.data(), buffer.size()));
+        return;
+    }
+
+    threadBufferInUse = true;
+    MM_AT_SCOPE_EXIT(threadBufferInUse = false);
+
+    threadBuffer.clear();
+    fmt::vformat_to(std::back_inserter(threadBuffer), fmt, args);
+    _sink->write(category, level, std::string_view(threadBuffer.data(), threadBuffer.size()));
 }
 
 LogLevel Logger::level() const {
@@ -38,7 +60,7 @@ void Logger::setLevel(LogLevel level) {
 
     for (const LogCategory *category : LogCategory::instances())
         if (category->_source && !category->_level)
-            category->_source->setLevel(level);
+            category->_source->setLevel(std::max(level, MIN_LOG_LEVEL));
 }
 
 std::optional<LogLevel> Logger::level(const LogCategory &category) const {
@@ -52,7 +74,7 @@ void Logger::setLevel(LogCategory &category, std::optional<LogLevel> level) {
     category._level = level;
 
     if (category._source) {
-        LogLevel effectiveLevel = level ? *level : *_defaultCategory._level;
+        LogLevel effectiveLevel = std::max(level ? *level : *_defaultCategory._level, MIN_LOG_LEVEL);
         category._source->setLevel(effectiveLevel);
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string_view>
+#include <type_traits>
 #include <utility>
 
 #include "Utility/Format.h"
@@ -10,6 +11,50 @@
 
 class LogSink;
 
+#ifndef OE_MIN_LOG_LEVEL
+#   define OE_MIN_LOG_LEVEL 0
+#endif
+
+/**
+ * Min log level that's compiled in, set with the `OE_MIN_LOG_LEVEL` cmake option. Logging calls below this level are
+ * compiled out, and `Logger::shouldLog` always returns `false` for them.
+ *
+ * Note that the arguments of the compiled out calls are still evaluated. Use `logLazy` for the expensive ones.
+ */
+inline constexpr LogLevel MIN_LOG_LEVEL = static_cast<LogLevel>(OE_MIN_LOG_LEVEL);
+
+/**
+ * Lazily evaluated log argument, see `logLazy`.
+ */
+template<class Callable>
+struct LogLazy {
+    Callable callable;
+};
+
+/**
+ * Wraps the provided callable so that it's invoked only if the message is actually logged. Invocation result is then
+ * formatted in place of the wrapper, e.g.:
+ * ```
+ * logger->trace("Actor state: {}", logLazy([&] { return toString(actor); }));
+ * ```
+ *
+ * @param callable                      Callable to wrap.
+ * @return                              Wrapped callable that can be passed as an argument to `Logger` methods.
+ */
+template<class Callable>
+LogLazy<Callable> logLazy(Callable callable) {
+    return {std::move(callable)};
+}
+
+template<class Callable>
+struct fmt::formatter<LogLazy<Callable>> : fmt::formatter<std::decay_t<std::invoke_result_t<const Callable &>>> {
+    using base_type = fmt::formatter<std::decay_t<std::invoke_result_t<const Callable &>>>;
+
+    auto format(const LogLazy<Callable> &value, format_context &ctx) const {
+        return base_type::format(value.callable(), ctx);
+    }
+};
+
 /**
  * Main logging class.
  *
@@ -30,6 +75,8 @@ class LogSink;
  * 4. Different logging targets are implemented with the `LogSink` interface. `LogSink` also makes it possible to
  *    implement complex logging logic, i.e. writing all logs starting with `LOG_DEBUG` into a file, but printing only
  *    errors to the console. It's up to the user to properly implement the log level handling in this case.
+ * 5. Logging calls below `MIN_LOG_LEVEL` are compiled out. This is why `trace` & other level-specific methods are
+ *    preferred to `log` with a runtime level - for those the check is done with `if constexpr`.
  */
 class Logger {
  public:
@@ -39,7 +86,7 @@ class Logger {
     // LogCategory API.
 
     bool shouldLog(const LogCategory &category, LogLevel level) const {
-        return level >= (category._level ? *category._level : *_defaultCategory._level);
+        return level >= MIN_LOG_LEVEL && level >= (category._level ? *category._level : *_defaultCategory._level);
     }
 
     template<class... Args>
@@ -50,38 +97,44 @@ class Logger {
 
     template<class... Args>
     void trace(const LogCategory &category, fmt::format_string<Args...> fmt, Args &&... args) {
-        log(category, LOG_TRACE, fmt, std::forward<Args>(args)...);
+        if constexpr (LOG_TRACE >= MIN_LOG_LEVEL)
+            log(category, LOG_TRACE, fmt, std::forward<Args>(args)...);
     }
 
     template<class... Args>
     void debug(const LogCategory &category, fmt::format_string<Args...> fmt, Args &&... args) {
-        log(category, LOG_DEBUG, fmt, std::forward<Args>(args)...);
+        if constexpr (LOG_DEBUG >= MIN_LOG_LEVEL)
+            log(category, LOG_DEBUG, fmt, std::forward<Args>(args)...);
     }
 
     template<class... Args>
     void info(const LogCategory &category, fmt::format_string<Args...> fmt, Args &&... args) {
-        log(category, LOG_INFO, fmt, std::forward<Args>(args)...);
+        if constexpr (LOG_INFO >= MIN_LOG_LEVEL)
+            log(category, LOG_INFO, fmt, std::forward<Args>(args)...);
     }
 
     template<class... Args>
     void warning(const LogCategory &category, fmt::format_string<Args...> fmt, Args &&... args) {
-        log(category, LOG_WARNING, fmt, std::forward<Args>(args)...);
+        if constexpr (LOG_WARNING >= MIN_LOG_LEVEL)
+            log(category, LOG_WARNING, fmt, std::forward<Args>(args)...);
     }
 
     template<class... Args>
     void error(const LogCategory &category, fmt::format_string<Args...> fmt, Args &&... args) {
-        log(category, LOG_ERROR, fmt, std::forward<Args>(args)...);
+        if constexpr (LOG_ERROR >= MIN_LOG_LEVEL)
+            log(category, LOG_ERROR, fmt, std::forward<Args>(args)...);
     }
 
     template<class... Args>
     void critical(const LogCategory &category, fmt::format_string<Args...> fmt, Args &&... args) {
-        log(category, LOG_CRITICAL, fmt, std::forward<Args>(args)...);
+        if constexpr (LOG_CRITICAL >= MIN_LOG_LEVEL)
+            log(category, LOG_CRITICAL, fmt, std::forward<Args>(args)...);
     }
 
     // Default category API.
 
     bool shouldLog(LogLevel level) const {
-        return level >= *_defaultCategory._level;
+        return level >= MIN_LOG_LEVEL && level >= *_defaultCategory._level;
     }
 
     template<class... Args>
@@ -0,0 +1,126 @@
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Logger/AsyncLogSink.h"
+
+#include "Utility/Format.h"
+
+static LogCategory testLogCategory("async_log_test");
+
+class TestLogSink : public LogSink {
+ public:
+    virtual void write(const LogCategory &category, LogLevel level, std::string_view message) override {
+        while (_paused.load())
+            std::this_thread::yield();
+
+        auto guard = std::lock_guard(_mutex);
+        _messages.emplace_back(message);
+    }
+
+    void setPaused(bool paused) {
+        _paused.store(paused);
+    }
+
+    std::vector<std::string> messages() {
+        auto guard = std::lock_guard(_mutex);
+        return _messages;
+    }
+
+ private:
+    std::atomic<bool> _paused = false;
+    std::mutex _mutex;
+    std::vector<std::string> _messages;
+};
+
+UNIT_TEST(AsyncLogSink, BlockKeepsAllMessages) {
+    constexpr int threadCount = 4;
+    constexpr int messageCount = 1000;
+
+    TestLogSink target;
+    {
+        AsyncLogSink sink(&target, ASYNC_LOG_BLOCK, 16);
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; i++) {
+            threads.emplace_back([&, i] {
+                for (int j = 0; j < messageCount; j++)
+                    sink.write(testLogCategory, LOG_INFO, fmt::format("{} {}", i, j));
+            });
+        }
+        for (std::thread &thread : threads)
+            thread.join();
+    }
+
+    // Messages from each thread should arrive in order.
+    std::vector<std::string> messages = target.messages();
+    EXPECT_EQ(messages.size(), threadCount * messageCount);
+    std::vector<int> nextIndices(threadCount, 0);
+    for (const std::string &message : messages) {
+        int thread = std::stoi(message.substr(0, message.find(' ')));
+        int index = std::stoi(message.substr(message.find(' ') + 1));
+        EXPECT_EQ(index, nextIndices[thread]);
+        nextIndices[thread]++;
+    }
+}
+
+UNIT_TEST(AsyncLogSink, DropReportsDroppedMessages) {
+    TestLogSink target;
+    AsyncLogSink sink(&target, ASYNC_LOG_DROP, 8);
+
+    target.setPaused(true);
+    for (int i = 0; i < 100; i++)
+        sink.write(testLogCategory, LOG_INFO, fmt::format("{}", i));
+    EXPECT_GT(sink.droppedCount(), 0);
+    target.setPaused(false);
+    sink.flush();
+
+    std::vector<std::string> messages = target.messages();
+    ASSERT_FALSE(messages.empty());
+    EXPECT_LE(messages.size(), 10); // At most 8 queued messages + 1 warning.
+    EXPECT_TRUE(messages.back().starts_with("Log queue overflow"));
+    EXPECT_EQ(sink.droppedCount(), 0);
+}
+
+UNIT_TEST(AsyncLogSink, FlushWritesEverything) {
+    TestLogSink target;
+    AsyncLogSink sink(&target, ASYNC_LOG_BLOCK);
+
+    for (int i = 0; i < 100; i++)
+        sink.write(testLogCategory, LOG_INFO, fmt::format("{}", i));
+    sink.flush();
+
+    EXPECT_EQ(target.messages().size(), 100);
+}
+
+UNIT_TEST(AsyncLogSink, CrashFlushWritesQueuedMessages) {
+    const char *tmpfile = "tmp_crash_flush.txt";
+
+    TestLogSink target;
+    AsyncLogSink sink(&target, ASYNC_LOG_DROP, 16);
+
+    // Background thread gets stuck in the target sink, so both messages are still queued.
+    target.setPaused(true);
+    sink.write(testLogCategory, LOG_INFO, "1");
+    sink.write(testLogCategory, LOG_INFO, "2");
+
+    FILE *file = fopen(tmpfile, "wb");
+    ASSERT_NE(file, nullptr);
+    sink.crashFlush(fileno(file));
+    fclose(file);
+    target.setPaused(false);
+
+    std::ifstream input(tmpfile, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+    EXPECT_EQ(contents, "async_log_test: 1\nasync_log_test: 2\n");
+
+    remove(tmpfile);
+}
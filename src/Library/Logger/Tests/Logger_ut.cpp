@@ -0,0 +1,62 @@
+#include <string>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Logger/Logger.h"
+#include "Library/Logger/LogSink.h"
+
+class TestLogSink : public LogSink {
+ public:
+    virtual void write(const LogCategory &category, LogLevel level, std::string_view message) override {
+        messages.emplace_back(message);
+    }
+
+    std::vector<std::string> messages;
+};
+
+UNIT_TEST(Logger, LazyArguments) {
+    TestLogSink sink;
+    Logger logger(LOG_WARNING, &sink);
+
+    int calls = 0;
+    auto lazy = logLazy([&] {
+        calls++;
+        return calls;
+    });
+
+    logger.info("{}", lazy);
+    EXPECT_EQ(calls, 0);
+    EXPECT_TRUE(sink.messages.empty());
+
+    logger.error("{:>3}", lazy);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(sink.messages, std::vector<std::string>({"  1"}));
+}
+
+UNIT_TEST(Logger, MinLogLevel) {
+    TestLogSink sink;
+    Logger logger(LOG_TRACE, &sink);
+
+    logger.trace("trace");
+    logger.critical("critical");
+    EXPECT_EQ(logger.shouldLog(LOG_TRACE), MIN_LOG_LEVEL == LOG_TRACE);
+    EXPECT_EQ(sink.messages.size(), MIN_LOG_LEVEL == LOG_TRACE ? 2 : 1);
+    EXPECT_EQ(sink.messages.back(), "critical");
+}
+
+UNIT_TEST(Logger, NestedLogCalls) {
+    TestLogSink sink;
+    Logger logger(LOG_INFO, &sink);
+
+    // Logging from inside a formatter shouldn't corrupt the message that's being formatted.
+    auto nested = logLazy([&] {
+        logger.info("nested {}", std::string(1000, 'b'));
+        return 42;
+    });
+    logger.info("{} {}", std::string(1000, 'a'), nested);
+
+    ASSERT_EQ(sink.messages.size(), 2);
+    EXPECT_EQ(sink.messages[0], "nested " + std::string(1000, 'b'));
+    EXPECT_EQ(sink.messages[1], std::string(1000, 'a') + " 42");
+}
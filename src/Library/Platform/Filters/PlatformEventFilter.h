@@ -11,12 +11,17 @@ using enum PlatformEventWildcard;
 
 class PlatformEventFilter {
  public:
+    /**
+     * @param eventTypes                Event types that this filter is interested in. `FilteringEventHandler` will
+     *                                  only pass events of these types to this filter, so it's best to keep this list
+     *                                  as short as possible.
+     */
     explicit PlatformEventFilter(std::initializer_list<PlatformEventType> eventTypes);
     explicit PlatformEventFilter(PlatformEventWildcard eventTypes);
 
     virtual bool event(const PlatformEvent *event);
 
-    const std::vector<PlatformEventType> eventTypes() const {
+    [[nodiscard]] const std::vector<PlatformEventType> &eventTypes() const {
         return _eventTypes;
     }
 
@@ -4,7 +4,9 @@
 #include <vector>
 #include <string>
 
+#include "Library/Geometry/Point.h"
 #include "Library/Geometry/Rect.h"
+#include "Library/Image/Image.h"
 
 #include "Utility/Flags.h"
 
@@ -15,6 +17,7 @@ class PlatformWindow;
 class PlatformEventLoop;
 class PlatformEventHandler;
 class PlatformGamepad;
+class PlatformCursor;
 class Logger;
 
 /**
@@ -30,6 +33,7 @@ class Logger;
  * - `PlatformWindow`, an API handle for a GUI window.
  * - `PlatformEventLoop`, an API handle for running an event loop.
  * - `PlatformOpenGLContext`, an API handle for accessing OpenGL API for a window.
+ * - `PlatformCursor`, an API handle for a system cursor.
  *
  * Then there are the following extension points:
  * - `PlatformEventHandler`, which should be subclassed in user code to handle platform events. An instance is passed
@@ -118,6 +122,24 @@ class Platform {
      */
     virtual bool isCursorShown() const = 0;
 
+    /**
+     * Creates a color cursor that can then be set with `setCursor`.
+     *
+     * @param image                     Cursor image. Transparent pixels are not drawn.
+     * @param hotspot                   Position of the cursor's click point inside the image.
+     * @return                          Newly created cursor, or `nullptr` on error or if color cursors are not
+     *                                  supported.
+     */
+    virtual std::unique_ptr<PlatformCursor> createCursor(RgbaImageView image, Pointi hotspot) = 0;
+
+    /**
+     * Changes the system cursor shape for all windows created by this platform. Doesn't change cursor visibility,
+     * see `setCursorShown`.
+     *
+     * @param cursor                    Cursor to use, or `nullptr` to switch back to the default system cursor.
+     */
+    virtual void setCursor(PlatformCursor *cursor) = 0;
+
     /**
      * @return                          Geometries of all monitors on current system, or an empty vector in case of an
      *                                  error.
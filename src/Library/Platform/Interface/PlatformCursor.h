@@ -0,0 +1,12 @@
+#pragma once
+
+/**
+ * API handle for a system cursor created with `Platform::createCursor`.
+ *
+ * Doesn't expose any methods, the only thing that can be done with a cursor is passing it to `Platform::setCursor`.
+ * Destroying the current cursor switches back to the default system cursor.
+ */
+class PlatformCursor {
+ public:
+    virtual ~PlatformCursor() = default;
+};
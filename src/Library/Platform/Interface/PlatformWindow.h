@@ -55,6 +55,12 @@ class PlatformWindow {
 
     virtual Marginsi frameMargins() const = 0;
 
+    /**
+     * @return                          Refresh rate of the display that the window is on, in Hz, or zero if it's not
+     *                                  known.
+     */
+    virtual int refreshRate() const = 0;
+
     /**
      * @return                          System handle of a window, e.g. `HWND` on windows or `NSWindow *` on mac.
      */
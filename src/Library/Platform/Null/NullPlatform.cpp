@@ -2,6 +2,8 @@
 
 #include <utility>
 
+#include "Library/Platform/Interface/PlatformCursor.h"
+
 #include "NullPlatformSharedState.h"
 #include "NullWindow.h"
 #include "NullEventLoop.h"
@@ -32,6 +34,12 @@ bool NullPlatform::isCursorShown() const {
     return _cursorShown;
 }
 
+std::unique_ptr<PlatformCursor> NullPlatform::createCursor(RgbaImageView image, Pointi hotspot) {
+    return nullptr; // No color cursors in null platform, users are expected to fall back to drawing the cursor.
+}
+
+void NullPlatform::setCursor(PlatformCursor *cursor) {}
+
 std::vector<Recti> NullPlatform::displayGeometries() const {
     return _state->options.displayGeometries;
 }
@@ -20,6 +20,8 @@ class NullPlatform : public Platform {
     virtual std::vector<PlatformGamepad *> gamepads() override;
     virtual void setCursorShown(bool cursorShown) override;
     virtual bool isCursorShown() const override;
+    virtual std::unique_ptr<PlatformCursor> createCursor(RgbaImageView image, Pointi hotspot) override;
+    virtual void setCursor(PlatformCursor *cursor) override;
     virtual std::vector<Recti> displayGeometries() const override;
     virtual void showMessageBox(const std::string &title, const std::string &message) const override;
     virtual int64_t tickCount() const override;
@@ -12,4 +12,5 @@ struct NullPlatformOptions {
     Sizei defaultWindowSize = Sizei(100, 100);
     Marginsi defaultFrameMargins = Marginsi(5, 5, 5, 5);
     std::vector<Recti> displayGeometries = {{0, 0, 1920, 1080}};
+    int displayRefreshRate = 60;
 };
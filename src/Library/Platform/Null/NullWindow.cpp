@@ -87,6 +87,10 @@ Marginsi NullWindow::frameMargins() const {
     }
 }
 
+int NullWindow::refreshRate() const {
+    return _state->options.displayRefreshRate;
+}
+
 uintptr_t NullWindow::systemHandle() const {
     return _systemHandle;
 }
@@ -2,6 +2,7 @@
 
 #include "Library/Platform/Interface/PlatformWindow.h"
 #include "Library/Platform/Interface/PlatformEventLoop.h"
+#include "Library/Platform/Interface/PlatformCursor.h"
 
 ProxyPlatform::ProxyPlatform(Platform *base): ProxyBase<Platform>(base) {}
 
@@ -25,6 +26,14 @@ bool ProxyPlatform::isCursorShown() const {
     return nonNullBase()->isCursorShown();
 }
 
+std::unique_ptr<PlatformCursor> ProxyPlatform::createCursor(RgbaImageView image, Pointi hotspot) {
+    return nonNullBase()->createCursor(image, hotspot);
+}
+
+void ProxyPlatform::setCursor(PlatformCursor *cursor) {
+    nonNullBase()->setCursor(cursor);
+}
+
 std::vector<Recti> ProxyPlatform::displayGeometries() const {
     return nonNullBase()->displayGeometries();
 }
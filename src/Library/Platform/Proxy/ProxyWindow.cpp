@@ -72,6 +72,10 @@ Marginsi ProxyWindow::frameMargins() const {
     return nonNullBase()->frameMargins();
 }
 
+int ProxyWindow::refreshRate() const {
+    return nonNullBase()->refreshRate();
+}
+
 uintptr_t ProxyWindow::systemHandle() const {
     return nonNullBase()->systemHandle();
 }
@@ -0,0 +1,11 @@
+#include "SdlCursor.h"
+
+#include <cassert>
+
+SdlCursor::SdlCursor(SDL_Cursor *cursor): _cursor(cursor) {
+    assert(cursor);
+}
+
+SdlCursor::~SdlCursor() {
+    SDL_FreeCursor(_cursor);
+}
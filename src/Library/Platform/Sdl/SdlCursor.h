@@ -0,0 +1,18 @@
+#pragma once
+
+#include <SDL.h>
+
+#include "Library/Platform/Interface/PlatformCursor.h"
+
+class SdlCursor : public PlatformCursor {
+ public:
+    explicit SdlCursor(SDL_Cursor *cursor);
+    virtual ~SdlCursor();
+
+    SDL_Cursor *sdlHandle() const {
+        return _cursor;
+    }
+
+ private:
+    SDL_Cursor *_cursor = nullptr;
+};
@@ -10,6 +10,7 @@
 #include "Library/Logger/Logger.h"
 
 #include "SdlPlatformSharedState.h"
+#include "SdlCursor.h"
 #include "SdlEventLoop.h"
 #include "SdlWindow.h"
 #include "SdlGamepad.h"
@@ -104,6 +105,36 @@ bool SdlPlatform::isCursorShown() const {
     }
 }
 
+std::unique_ptr<PlatformCursor> SdlPlatform::createCursor(RgbaImageView image, Pointi hotspot) {
+    if (!_initialized || !image)
+        return nullptr;
+
+    // SDL doesn't write into the pixels of a surface created this way, so the const_cast is safe.
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<Color *>(image.pixels().data()),
+                                                              image.width(), image.height(), 32,
+                                                              image.width() * sizeof(Color), SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        _state->logSdlError("SDL_CreateRGBSurfaceWithFormatFrom");
+        return nullptr;
+    }
+
+    SDL_Cursor *cursor = SDL_CreateColorCursor(surface, hotspot.x, hotspot.y);
+    SDL_FreeSurface(surface); // SDL makes a copy, so it's OK to free the surface right away.
+    if (!cursor) {
+        _state->logSdlError("SDL_CreateColorCursor");
+        return nullptr;
+    }
+
+    return std::make_unique<SdlCursor>(cursor);
+}
+
+void SdlPlatform::setCursor(PlatformCursor *cursor) {
+    if (!_initialized)
+        return;
+
+    SDL_SetCursor(cursor ? static_cast<SdlCursor *>(cursor)->sdlHandle() : SDL_GetDefaultCursor());
+}
+
 std::vector<Recti> SdlPlatform::displayGeometries() const {
     if (!_initialized)
         return {};
@@ -22,6 +22,8 @@ class SdlPlatform: public Platform {
 
     virtual void setCursorShown(bool cursorShown) override;
     virtual bool isCursorShown() const override;
+    virtual std::unique_ptr<PlatformCursor> createCursor(RgbaImageView image, Pointi hotspot) override;
+    virtual void setCursor(PlatformCursor *cursor) override;
 
     virtual std::vector<Recti> displayGeometries() const override;
 
@@ -160,6 +160,21 @@ Marginsi SdlWindow::frameMargins() const {
     return result;
 }
 
+int SdlWindow::refreshRate() const {
+    int displayIndex = SDL_GetWindowDisplayIndex(_window);
+    if (displayIndex < 0) {
+        _state->logSdlError("SDL_GetWindowDisplayIndex");
+        return 0;
+    }
+
+    SDL_DisplayMode mode;
+    if (SDL_GetCurrentDisplayMode(displayIndex, &mode) != 0) {
+        _state->logSdlError("SDL_GetCurrentDisplayMode");
+        return 0;
+    }
+    return mode.refresh_rate; // SDL also uses zero for unknown.
+}
+
 uintptr_t SdlWindow::systemHandle() const {
     SDL_SysWMinfo info;
     SDL_VERSION(&info.version);
@@ -40,6 +40,7 @@ class SdlWindow : public PlatformWindow {
     virtual bool grabsMouse() const override;
 
     virtual Marginsi frameMargins() const override;
+    virtual int refreshRate() const override;
 
     virtual uintptr_t systemHandle() const override;
 
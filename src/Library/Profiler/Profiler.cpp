@@ -0,0 +1,139 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <tuple>
+#include <utility>
+
+Profiler *profiler = nullptr;
+
+static std::atomic<uint64_t> nextProfilerGeneration = 1;
+
+static thread_local int profilerDepth = 0;
+
+static std::atomic<Profiler::AllocationCounter> globalAllocationCounter = nullptr;
+
+static int64_t currentAllocationCount() {
+    Profiler::AllocationCounter counter = globalAllocationCounter.load(std::memory_order_relaxed);
+    return counter ? counter() : 0;
+}
+
+Profiler::Profiler() : _generation(nextProfilerGeneration++) {
+    threadBuffer(); // Make sure the creating thread gets thread id 0.
+}
+
+Profiler::~Profiler() = default;
+
+Profiler::ThreadBuffer *Profiler::threadBuffer() {
+    // Generation check makes sure we don't reuse a buffer of a profiler that was destroyed, even if a new profiler
+    // was allocated at the same address.
+    static thread_local uint64_t bufferGeneration = 0;
+    static thread_local ThreadBuffer *buffer = nullptr;
+    if (bufferGeneration == _generation)
+        return buffer;
+
+    auto guard = std::lock_guard(_buffersMutex);
+    std::unique_ptr<ThreadBuffer> &result = _buffers.emplace_back(std::make_unique<ThreadBuffer>());
+    result->threadId = _buffers.size() - 1;
+    result->ring.resize(RING_BUFFER_SIZE);
+
+    bufferGeneration = _generation;
+    buffer = result.get();
+    return buffer;
+}
+
+void Profiler::setAllocationCounter(AllocationCounter counter) {
+    globalAllocationCounter.store(counter, std::memory_order_relaxed);
+}
+
+void Profiler::add(const char *name, int depth, Clock::time_point start, Clock::time_point end, int64_t allocations) {
+    ThreadBuffer *buffer = threadBuffer();
+
+    auto guard = std::lock_guard(buffer->mutex);
+    if (buffer->writeIndex - buffer->readIndex == RING_BUFFER_SIZE) {
+        buffer->readIndex++;
+        buffer->droppedZoneCount++;
+    }
+    buffer->ring[buffer->writeIndex % RING_BUFFER_SIZE] = Zone{name, depth, start, end, allocations};
+    buffer->writeIndex++;
+}
+
+void Profiler::nextFrame() {
+    Clock::time_point now = Clock::now();
+    bool firstFrame = _frameStart == Clock::time_point();
+
+    // Collect the zones. Zones are aggregated by (thread, depth, name), and then sorted by first entry time.
+    std::map<std::tuple<int, int, const char *>, size_t> indexByKey;
+    std::vector<std::pair<Clock::time_point, FrameZone>> zones;
+    {
+        auto guard = std::lock_guard(_buffersMutex);
+        for (const std::unique_ptr<ThreadBuffer> &buffer : _buffers) {
+            auto bufferGuard = std::lock_guard(buffer->mutex);
+            for (uint64_t i = buffer->readIndex; i < buffer->writeIndex; i++) {
+                const Zone &zone = buffer->ring[i % RING_BUFFER_SIZE];
+
+                auto key = std::tuple(buffer->threadId, zone.depth, zone.name);
+                auto [pos, inserted] = indexByKey.emplace(key, zones.size());
+                if (inserted)
+                    zones.emplace_back(zone.start, FrameZone{zone.name, buffer->threadId, zone.depth});
+
+                auto &[firstStart, frameZone] = zones[pos->second];
+                firstStart = std::min(firstStart, zone.start);
+                frameZone.count++;
+                frameZone.duration += zone.end - zone.start;
+                frameZone.allocations += zone.allocations;
+            }
+            buffer->readIndex = buffer->writeIndex;
+            _droppedZoneCount += std::exchange(buffer->droppedZoneCount, 0);
+        }
+    }
+
+    Clock::time_point frameStart = std::exchange(_frameStart, now);
+    if (firstFrame)
+        return; // Zones recorded before the first frame don't belong to any frame.
+
+    std::ranges::sort(zones, [](const auto &l, const auto &r) {
+        return std::tie(l.second.threadId, l.first, l.second.depth) <
+               std::tie(r.second.threadId, r.first, r.second.depth);
+    });
+
+    Frame frame;
+    frame.index = _frameIndex++;
+    frame.duration = now - frameStart;
+    frame.zones.reserve(zones.size());
+    for (auto &[_, zone] : zones)
+        frame.zones.push_back(zone);
+
+    // Spike detection needs some history to compare against.
+    if (_history.size() >= HISTORY_SIZE / 4) {
+        Duration total = {};
+        for (Duration duration : _history)
+            total += duration;
+        if (frame.duration > SPIKE_FACTOR * total / _history.size())
+            _lastSpike = frame;
+    }
+
+    if (_history.size() == HISTORY_SIZE)
+        _history.erase(_history.begin());
+    _history.push_back(frame.duration);
+
+    _lastFrame = std::move(frame);
+}
+
+ProfilerScope::ProfilerScope(const char *name) : _name(name) {
+    if (profiler) {
+        _depth = profilerDepth++;
+        _start = Profiler::Clock::now();
+        _allocations = currentAllocationCount();
+    }
+}
+
+ProfilerScope::~ProfilerScope() {
+    if (_depth == -1)
+        return;
+
+    profilerDepth--;
+    if (profiler)
+        profiler->add(_name, _depth, _start, Profiler::Clock::now(), currentAllocationCount() - _allocations);
+}
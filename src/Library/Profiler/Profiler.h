@@ -0,0 +1,184 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef OE_USE_TRACY
+#   include <tracy/Tracy.hpp>
+#endif
+
+#ifndef OE_PROFILER_ENABLED
+#   define OE_PROFILER_ENABLED 0
+#endif
+
+/**
+ * Whether the profiler zones are compiled in, set with the `OE_BUILD_PROFILER` cmake option. When this is `false`,
+ * `OE_PROFILE_ZONE` & `OE_PROFILE_FRAME` expand to nothing, and nobody creates the `profiler` instance.
+ */
+inline constexpr bool PROFILER_ENABLED = OE_PROFILER_ENABLED;
+
+/**
+ * Frame profiler with named zones.
+ *
+ * Zones are recorded into per-thread ring buffers, and are collected into per-frame breakdowns on each call to
+ * `nextFrame`, which should be called from the main thread once per game loop iteration. Zones that were recorded
+ * on other threads are attributed to the frame during which they ended.
+ *
+ * Don't use this class directly, use the `OE_PROFILE_ZONE` & `OE_PROFILE_FRAME` macros.
+ */
+class Profiler {
+ public:
+    using Clock = std::chrono::steady_clock;
+    using Duration = Clock::duration;
+
+    static constexpr size_t RING_BUFFER_SIZE = 16384; // Per thread, older zones are overwritten if not collected.
+    static constexpr size_t HISTORY_SIZE = 240; // Number of frame times to keep.
+    static constexpr double SPIKE_FACTOR = 2.0; // Frames this many times longer than average are spikes.
+
+    struct FrameZone {
+        const char *name = nullptr;
+        int threadId = 0; // Sequential thread id, the thread that has created the profiler is 0.
+        int depth = 0;
+        int count = 0; // Number of times the zone was entered during the frame.
+        Duration duration = {}; // Total time spent in the zone during the frame.
+        int64_t allocations = 0; // Allocations made inside the zone, nested zones included. See `setAllocationCounter`.
+    };
+
+    /**
+     * Function that returns the number of heap allocations made on the calling thread so far.
+     */
+    using AllocationCounter = int64_t (*)();
+
+    struct Frame {
+        int64_t index = -1; // -1 means no frame was recorded yet.
+        Duration duration = {};
+        std::vector<FrameZone> zones; // Sorted by thread, then by first entry time.
+    };
+
+    Profiler();
+    ~Profiler();
+
+    /**
+     * Records a zone on the calling thread. Thread-safe.
+     *
+     * @param name                      Zone name, must be a string literal or otherwise outlive the profiler.
+     * @param depth                     Nesting depth of the zone on the calling thread.
+     * @param start                     Zone start time.
+     * @param end                       Zone end time.
+     * @param allocations               Number of allocations made inside the zone.
+     */
+    void add(const char *name, int depth, Clock::time_point start, Clock::time_point end, int64_t allocations = 0);
+
+    /**
+     * Installs an allocation counter, after which zones also record the number of allocations made inside them.
+     * The engine has no allocation hook of its own, so by default allocations are not counted. Game tests install
+     * `threadAllocationCount` here. Thread-safe.
+     *
+     * @param counter                   Allocation counter, `nullptr` to stop counting.
+     */
+    static void setAllocationCounter(AllocationCounter counter);
+
+    /**
+     * Closes the current frame, and collects all the zones recorded so far into its breakdown. Should be called from
+     * the main thread.
+     */
+    void nextFrame();
+
+    /**
+     * @return                          Breakdown of the last completed frame.
+     */
+    [[nodiscard]] const Frame &lastFrame() const {
+        return _lastFrame;
+    }
+
+    /**
+     * @return                          Breakdown of the last spike frame, i.e. the last frame that took
+     *                                  `SPIKE_FACTOR` times longer than the average over the frame history.
+     */
+    [[nodiscard]] const Frame &lastSpike() const {
+        return _lastSpike;
+    }
+
+    /**
+     * @return                          Durations of the last `HISTORY_SIZE` frames, oldest first.
+     */
+    [[nodiscard]] const std::vector<Duration> &frameHistory() const {
+        return _history;
+    }
+
+    /**
+     * @return                          Number of zones that were overwritten in the ring buffers before they could be
+     *                                  collected.
+     */
+    [[nodiscard]] int64_t droppedZoneCount() const {
+        return _droppedZoneCount;
+    }
+
+ private:
+    struct Zone {
+        const char *name;
+        int depth;
+        Clock::time_point start;
+        Clock::time_point end;
+        int64_t allocations;
+    };
+
+    struct ThreadBuffer {
+        std::mutex mutex;
+        int threadId = 0;
+        std::vector<Zone> ring;
+        uint64_t writeIndex = 0;
+        uint64_t readIndex = 0;
+        int64_t droppedZoneCount = 0;
+    };
+
+    ThreadBuffer *threadBuffer();
+
+ private:
+    uint64_t _generation = 0;
+    std::mutex _buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+    Clock::time_point _frameStart;
+    int64_t _frameIndex = 0;
+    Frame _lastFrame;
+    Frame _lastSpike;
+    std::vector<Duration> _history;
+    int64_t _droppedZoneCount = 0;
+};
+
+/**
+ * Records a zone into the `profiler` for the lifetime of the scope. Does nothing if there is no profiler.
+ */
+class ProfilerScope {
+ public:
+    explicit ProfilerScope(const char *name);
+    ~ProfilerScope();
+
+    ProfilerScope(const ProfilerScope &) = delete;
+    ProfilerScope &operator=(const ProfilerScope &) = delete;
+
+ private:
+    const char *_name;
+    int _depth = -1;
+    Profiler::Clock::time_point _start;
+    int64_t _allocations = 0;
+};
+
+extern Profiler *profiler;
+
+#define OE_PROFILER_CONCAT_I(a, b) a ## b
+#define OE_PROFILER_CONCAT(a, b) OE_PROFILER_CONCAT_I(a, b)
+
+#if OE_PROFILER_ENABLED && defined(OE_USE_TRACY)
+#   define OE_PROFILE_ZONE(name) ProfilerScope OE_PROFILER_CONCAT(profilerScope, __LINE__)(name); ZoneScopedN(name)
+#   define OE_PROFILE_FRAME() do { if (profiler) profiler->nextFrame(); FrameMark; } while (0)
+#elif OE_PROFILER_ENABLED
+#   define OE_PROFILE_ZONE(name) ProfilerScope OE_PROFILER_CONCAT(profilerScope, __LINE__)(name)
+#   define OE_PROFILE_FRAME() do { if (profiler) profiler->nextFrame(); } while (0)
+#else
+#   define OE_PROFILE_ZONE(name) do {} while (0)
+#   define OE_PROFILE_FRAME() do {} while (0)
+#endif
@@ -0,0 +1,120 @@
+#include <string_view>
+#include <thread>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Profiler/Profiler.h"
+
+class ProfilerInstall {
+ public:
+    explicit ProfilerInstall(Profiler *instance) {
+        ::profiler = instance;
+    }
+
+    ~ProfilerInstall() {
+        ::profiler = nullptr;
+    }
+};
+
+UNIT_TEST(Profiler, FrameBreakdown) {
+    Profiler instance;
+    ProfilerInstall install(&instance);
+
+    instance.nextFrame();
+    EXPECT_EQ(instance.lastFrame().index, -1);
+
+    {
+        ProfilerScope outer("outer");
+        for (int i = 0; i < 3; i++)
+            ProfilerScope inner("inner");
+    }
+    instance.nextFrame();
+
+    const Profiler::Frame &frame = instance.lastFrame();
+    EXPECT_EQ(frame.index, 0);
+    ASSERT_EQ(frame.zones.size(), 2);
+    EXPECT_EQ(std::string_view(frame.zones[0].name), "outer");
+    EXPECT_EQ(frame.zones[0].depth, 0);
+    EXPECT_EQ(frame.zones[0].count, 1);
+    EXPECT_EQ(std::string_view(frame.zones[1].name), "inner");
+    EXPECT_EQ(frame.zones[1].depth, 1);
+    EXPECT_EQ(frame.zones[1].count, 3);
+    EXPECT_LE(frame.zones[1].duration, frame.zones[0].duration);
+    EXPECT_LE(frame.zones[0].duration, frame.duration);
+
+    instance.nextFrame();
+    EXPECT_EQ(instance.lastFrame().index, 1);
+    EXPECT_TRUE(instance.lastFrame().zones.empty());
+    EXPECT_EQ(instance.frameHistory().size(), 2);
+}
+
+UNIT_TEST(Profiler, ThreadIds) {
+    Profiler instance;
+    ProfilerInstall install(&instance);
+
+    instance.nextFrame();
+    {
+        ProfilerScope main("main");
+    }
+    std::thread([] { ProfilerScope worker("worker"); }).join();
+    instance.nextFrame();
+
+    const Profiler::Frame &frame = instance.lastFrame();
+    ASSERT_EQ(frame.zones.size(), 2);
+    EXPECT_EQ(std::string_view(frame.zones[0].name), "main");
+    EXPECT_EQ(frame.zones[0].threadId, 0);
+    EXPECT_EQ(std::string_view(frame.zones[1].name), "worker");
+    EXPECT_EQ(frame.zones[1].threadId, 1);
+}
+
+UNIT_TEST(Profiler, RingBufferOverflow) {
+    Profiler instance;
+    ProfilerInstall install(&instance);
+
+    instance.nextFrame();
+    for (size_t i = 0; i < Profiler::RING_BUFFER_SIZE + 10; i++)
+        ProfilerScope zone("zone");
+    instance.nextFrame();
+
+    ASSERT_EQ(instance.lastFrame().zones.size(), 1);
+    EXPECT_EQ(instance.lastFrame().zones[0].count, Profiler::RING_BUFFER_SIZE);
+    EXPECT_EQ(instance.droppedZoneCount(), 10);
+}
+
+static int64_t testAllocationCount = 0;
+
+UNIT_TEST(Profiler, Allocations) {
+    Profiler instance;
+    ProfilerInstall install(&instance);
+    Profiler::setAllocationCounter([] { return testAllocationCount; });
+
+    instance.nextFrame();
+    {
+        ProfilerScope outer("outer");
+        testAllocationCount += 2;
+        for (int i = 0; i < 3; i++) {
+            ProfilerScope inner("inner");
+            testAllocationCount++;
+        }
+    }
+    instance.nextFrame();
+    Profiler::setAllocationCounter(nullptr);
+
+    const Profiler::Frame &frame = instance.lastFrame();
+    ASSERT_EQ(frame.zones.size(), 2);
+    EXPECT_EQ(frame.zones[0].allocations, 5); // Nested zones are included.
+    EXPECT_EQ(frame.zones[1].allocations, 3);
+
+    instance.nextFrame();
+    {
+        ProfilerScope zone("zone");
+        testAllocationCount++;
+    }
+    instance.nextFrame();
+    ASSERT_EQ(instance.lastFrame().zones.size(), 1);
+    EXPECT_EQ(instance.lastFrame().zones[0].allocations, 0); // No counter, nothing is counted.
+}
+
+UNIT_TEST(Profiler, NoProfiler) {
+    ProfilerScope zone("zone"); // Should do nothing & not crash.
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 #include <random>
+#include <span>
 
 #include "RandomEngine.h"
 
@@ -14,17 +16,31 @@ class MersenneTwisterRandomEngine: public RandomEngine {
     virtual int random(int hi) override {
         assert(hi > 0);
 
-        return static_cast<int>((static_cast<uint64_t>(_base()) * static_cast<uint64_t>(hi)) >> 32);
+        return scale(_base(), hi);
     }
 
     virtual int peek(int hi) const override {
         assert(hi > 0);
 
         std::mt19937 copy = _base;
-        return static_cast<int>((static_cast<uint64_t>(copy()) * static_cast<uint64_t>(hi)) >> 32);
+        return scale(copy(), hi);
+    }
+
+    virtual void randomFill(int hi, std::span<int> dst) override {
+        assert(hi > 0);
+
+        for (int &value : dst)
+            value = scale(_base(), hi);
+    }
+
+    virtual void randomFloatFill(std::span<float> dst) override {
+        std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+        for (float &value : dst)
+            value = distribution(_base);
     }
 
     virtual void seed(int seed) override {
+        _seed = seed;
         if (seed == 0) {
             _base = std::mt19937();
         } else {
@@ -32,6 +48,33 @@ class MersenneTwisterRandomEngine: public RandomEngine {
         }
     }
 
+    /**
+     * Creates an independent random engine, e.g. for a worker thread. Sub-streams are derived from the seed only, so
+     * the result doesn't depend on how many numbers were already taken out of this engine, and creating a sub-stream
+     * doesn't advance this engine.
+     *
+     * @param index                     Sub-stream index. Different indices give unrelated sequences.
+     * @return                          New random engine.
+     */
+    [[nodiscard]] MersenneTwisterRandomEngine substream(int index) const {
+        // SplitMix64 finalizer over (seed, index), so that adjacent seeds & indices don't give correlated streams.
+        uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(_seed)) << 32) | static_cast<uint32_t>(index);
+        key += 0x9E3779B97F4A7C15ull;
+        key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+        key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+        key ^= key >> 31;
+
+        MersenneTwisterRandomEngine result;
+        result.seed(static_cast<int>(static_cast<uint32_t>(key ^ (key >> 32))));
+        return result;
+    }
+
+ private:
+    static int scale(uint32_t value, int hi) {
+        return static_cast<int>((static_cast<uint64_t>(value) * static_cast<uint64_t>(hi)) >> 32);
+    }
+
  private:
     std::mt19937 _base;
+    int _seed = 0;
 };
@@ -2,6 +2,16 @@
 
 #include <cassert>
 
+void RandomEngine::randomFill(int hi, std::span<int> dst) {
+    for (int &value : dst)
+        value = random(hi);
+}
+
+void RandomEngine::randomFloatFill(std::span<float> dst) {
+    for (float &value : dst)
+        value = randomFloat();
+}
+
 int RandomEngine::randomInSegment(int min, int max) {
     assert(max >= min);
 
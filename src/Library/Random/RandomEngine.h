@@ -5,6 +5,7 @@
 #include <cassert>
 #include <memory>
 #include <initializer_list>
+#include <span>
 
 /**
  * Random number generator interface.
@@ -34,6 +35,22 @@ class RandomEngine {
      */
     virtual int peek(int hi) const = 0;
 
+    /**
+     * Batch version of `random`. Produces exactly the same values as calling `random(hi)` `dst.size()` times in a
+     * row, but goes through a single virtual call, so implementations can generate the values in a tight loop.
+     *
+     * @param hi                        Upper bound for the results. Must be greater than zero.
+     * @param dst                       Span to fill with random numbers in range `[0, hi)`.
+     */
+    virtual void randomFill(int hi, std::span<int> dst);
+
+    /**
+     * Batch version of `randomFloat`, same guarantees as for `randomFill` apply.
+     *
+     * @param dst                       Span to fill with random floating point numbers in range `[0, 1)`.
+     */
+    virtual void randomFloatFill(std::span<float> dst);
+
     /**
      * Reinitializes this random engine with the provided seed value. Passing `0` should be equivalent to calling
      * an in-place destructor and then reconstructing the object.
@@ -0,0 +1,60 @@
+#include <memory>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Random/MersenneTwisterRandomEngine.h"
+#include "Library/Random/SequentialRandomEngine.h"
+
+UNIT_TEST(RandomEngine, FillMatchesSingleCalls) {
+    std::vector<std::unique_ptr<RandomEngine>> engines;
+    engines.push_back(std::make_unique<MersenneTwisterRandomEngine>());
+    engines.push_back(std::make_unique<SequentialRandomEngine>());
+
+    for (const std::unique_ptr<RandomEngine> &engine : engines) {
+        engine->seed(1234);
+        std::vector<int> expected;
+        for (int i = 0; i < 1000; i++)
+            expected.push_back(engine->random(100));
+        std::vector<float> expectedFloats;
+        for (int i = 0; i < 1000; i++)
+            expectedFloats.push_back(engine->randomFloat());
+
+        engine->seed(1234);
+        std::vector<int> actual(1000);
+        engine->randomFill(100, actual);
+        std::vector<float> actualFloats(1000);
+        engine->randomFloatFill(actualFloats);
+
+        EXPECT_EQ(actual, expected);
+        EXPECT_EQ(actualFloats, expectedFloats);
+    }
+}
+
+UNIT_TEST(RandomEngine, Substreams) {
+    MersenneTwisterRandomEngine engine;
+    engine.seed(42);
+
+    MersenneTwisterRandomEngine a0 = engine.substream(0);
+    MersenneTwisterRandomEngine b0 = engine.substream(1);
+
+    // Taking numbers out of the parent engine doesn't change the sub-streams.
+    std::vector<int> tmp(100);
+    engine.randomFill(1000, tmp);
+    MersenneTwisterRandomEngine a1 = engine.substream(0);
+
+    std::vector<int> a0s(100), a1s(100), b0s(100);
+    a0.randomFill(1 << 30, a0s);
+    a1.randomFill(1 << 30, a1s);
+    b0.randomFill(1 << 30, b0s);
+    EXPECT_EQ(a0s, a1s);
+    EXPECT_NE(a0s, b0s);
+
+    // Different seeds give different sub-streams.
+    MersenneTwisterRandomEngine other;
+    other.seed(43);
+    MersenneTwisterRandomEngine c0 = other.substream(0);
+    std::vector<int> c0s(100);
+    c0.randomFill(1 << 30, c0s);
+    EXPECT_NE(a0s, c0s);
+}
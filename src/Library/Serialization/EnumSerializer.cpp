@@ -2,36 +2,76 @@
 
 #include <cassert>
 #include <algorithm>
+#include <numeric>
+#include <unordered_set>
+#include <vector>
 
+#include "Utility/Hash.h"
 #include "Utility/String.h"
 
+// Values are considered dense if the dense index is at most this many times larger than the number of values.
+static constexpr size_t MAX_DENSE_INDEX_RATIO = 4;
+
+// Seed search is capped, if we can't find a seed for some bucket then we just retry with more buckets.
+static constexpr uint32_t MAX_SEED = 1u << 16;
+
+static uint64_t mixHash(uint64_t hash, uint64_t seed) {
+    // Murmur3 finalizer, decorrelates the seeded hashes that are derived from the same name hash.
+    hash ^= seed * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+uint64_t detail::EnumSerializationTable::hashName(std::string_view name) const {
+    if (_caseSensitivity == CASE_INSENSITIVE)
+        return ihash(name);
+
+    return fnv1aHash(name); // Same as ihash but w/o case folding.
+}
+
+const std::string *detail::EnumSerializationTable::findName(uint64_t value) const {
+    int32_t index = -1;
+    if (!_denseIndex.empty()) {
+        if (value >= _denseBase && value - _denseBase < _denseIndex.size())
+            index = _denseIndex[value - _denseBase];
+    } else {
+        auto pos = _sparseIndex.find(value);
+        if (pos != _sparseIndex.end())
+            index = pos->second;
+    }
+    return index < 0 ? nullptr : &_sortedEnumStrings[index].second;
+}
+
 bool detail::EnumSerializationTable::trySerialize(uint64_t src, std::string *dst) const {
-    auto pos = _stringByEnum.find(src);
-    if (pos == _stringByEnum.end())
+    const std::string *name = findName(src);
+    if (!name)
         return false;
-    *dst = std::string(pos->second);
+    *dst = *name;
     return true;
 }
 
 bool detail::EnumSerializationTable::tryDeserialize(std::string_view src, uint64_t *dst) const {
-    auto DoTryDeserialize = [this] (std::string_view src, uint64_t *dst) {
-        auto pos = _enumByString.find(src);
-        if (pos == _enumByString.end())
-            return false;
-        *dst = pos->second;
-        return true;
-    };
+    if (_entries.empty())
+        return false;
 
-    if (_caseSensitivity == CASE_INSENSITIVE) {
-        return DoTryDeserialize(toLower(src), dst);
-    } else {
-        return DoTryDeserialize(src, dst);
-    }
+    uint64_t hash = hashName(src);
+    uint32_t seed = _seeds[mixHash(hash, 0) % _seeds.size()];
+    const Entry &entry = _entries[mixHash(hash, seed) % _entries.size()];
+
+    bool equal = _caseSensitivity == CASE_INSENSITIVE ? iequals(entry.name, src) : entry.name == src;
+    if (!equal)
+        return false;
+    *dst = entry.value;
+    return true;
 }
 
 bool detail::EnumSerializationTable::isUsableWithFlags() const {
-    auto pos = _enumByString.find("0");
-    if (pos != _enumByString.end() && pos->second != 0)
+    uint64_t zero;
+    if (tryDeserialize("0", &zero) && zero != 0)
         return false;
 
     for (const auto &[_, string] : _sortedEnumStrings)
@@ -43,9 +83,8 @@ bool detail::EnumSerializationTable::isUsableWithFlags() const {
 
 bool detail::EnumSerializationTable::trySerializeFlags(uint64_t src, std::string *dst) const {
     // First check if it's a single value.
-    auto pos = _stringByEnum.find(src);
-    if (pos != _stringByEnum.end()) {
-        *dst = pos->second;
+    if (const std::string *name = findName(src)) {
+        *dst = *name;
         return true;
     }
 
@@ -102,22 +141,117 @@ bool detail::EnumSerializationTable::tryDeserializeFlags(std::string_view src, u
 }
 
 void detail::EnumSerializationTable::insert(uint64_t value, std::string_view name) {
-    if (!_stringByEnum.contains(value)) {
-        _sortedEnumStrings.emplace_back(value, std::string(name));
-        _stringByEnum.emplace(_sortedEnumStrings.back());
-    }
+    _entries.push_back(Entry{value, std::string(name)});
+}
+
+void detail::EnumSerializationTable::polish() {
+    buildValueIndex();
+    buildPerfectHash();
+}
+
+void detail::EnumSerializationTable::buildValueIndex() {
+    // The first name provided for a value is the one it serializes to.
+    for (const Entry &entry : _entries)
+        _sortedEnumStrings.emplace_back(entry.value, entry.name);
+    std::stable_sort(_sortedEnumStrings.begin(), _sortedEnumStrings.end(), [] (const auto &l, const auto &r) {
+        return l.first < r.first;
+    });
+    auto duplicates = std::ranges::unique(_sortedEnumStrings, [] (const auto &l, const auto &r) {
+        return l.first == r.first;
+    });
+    _sortedEnumStrings.erase(duplicates.begin(), duplicates.end());
 
-    std::string storedName;
-    if (_caseSensitivity == CASE_INSENSITIVE) {
-        storedName = toLower(name);
+    if (_sortedEnumStrings.empty())
+        return;
+
+    uint64_t minValue = _sortedEnumStrings.front().first;
+    uint64_t maxValue = _sortedEnumStrings.back().first;
+    if (maxValue - minValue < MAX_DENSE_INDEX_RATIO * _sortedEnumStrings.size() + 16) {
+        _denseBase = minValue;
+        _denseIndex.assign(maxValue - minValue + 1, -1);
+        for (size_t i = 0; i < _sortedEnumStrings.size(); i++)
+            _denseIndex[_sortedEnumStrings[i].first - minValue] = i;
     } else {
-        storedName = name;
+        for (size_t i = 0; i < _sortedEnumStrings.size(); i++)
+            _sparseIndex.emplace(_sortedEnumStrings[i].first, i);
     }
-
-    assert(!_enumByString.contains(storedName));
-    _enumByString.emplace(storedName, value);
 }
 
-void detail::EnumSerializationTable::polish() {
-    std::sort(_sortedEnumStrings.begin(), _sortedEnumStrings.end());
+void detail::EnumSerializationTable::buildPerfectHash() {
+    // Hash & displace. Names are split into buckets by the first level hash, then for each bucket, starting from the
+    // largest ones, we look for a seed that maps all of the bucket's names into free slots.
+    // Names must be unique. Duplicates would also make the seed search below loop forever, so in release builds we
+    // just drop them. Note that a 64-bit hash collision between two different names is not something we need to worry
+    // about.
+    std::vector<uint64_t> hashes;
+    std::unordered_set<uint64_t> uniqueHashes;
+    std::erase_if(_entries, [&] (const Entry &entry) {
+        uint64_t hash = hashName(entry.name);
+        bool unique = uniqueHashes.insert(hash).second;
+        assert(unique);
+        if (unique)
+            hashes.push_back(hash);
+        return !unique;
+    });
+
+    size_t size = _entries.size();
+    if (size == 0)
+        return;
+
+    for (size_t bucketCount = std::max<size_t>(1, size / 4);; bucketCount = bucketCount * 2) {
+        std::vector<std::vector<size_t>> buckets(bucketCount);
+        for (size_t i = 0; i < size; i++)
+            buckets[mixHash(hashes[i], 0) % bucketCount].push_back(i);
+
+        std::vector<size_t> order(bucketCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&] (size_t l, size_t r) {
+            return buckets[l].size() > buckets[r].size();
+        });
+
+        std::vector<uint32_t> seeds(bucketCount, 0);
+        std::vector<int> slots(size, -1);
+        std::vector<size_t> bucketSlots;
+        bool success = true;
+        for (size_t bucket : order) {
+            if (buckets[bucket].empty())
+                break;
+
+            uint32_t seed = 1;
+            for (; seed < MAX_SEED; seed++) {
+                bucketSlots.clear();
+                bool fits = true;
+                for (size_t entry : buckets[bucket]) {
+                    size_t slot = mixHash(hashes[entry], seed) % size;
+                    if (slots[slot] != -1 || std::ranges::find(bucketSlots, slot) != bucketSlots.end()) {
+                        fits = false;
+                        break;
+                    }
+                    bucketSlots.push_back(slot);
+                }
+                if (fits)
+                    break;
+            }
+
+            if (seed == MAX_SEED) {
+                success = false;
+                break;
+            }
+
+            seeds[bucket] = seed;
+            for (size_t i = 0; i < bucketSlots.size(); i++)
+                slots[bucketSlots[i]] = buckets[bucket][i];
+        }
+
+        if (!success)
+            continue;
+
+        std::vector<Entry> entries;
+        entries.reserve(size);
+        for (int slot : slots)
+            entries.push_back(std::move(_entries[slot]));
+        _entries = std::move(entries);
+        _seeds = std::move(seeds);
+        return;
+    }
 }
@@ -5,7 +5,6 @@
 #include <string>
 #include <string_view>
 #include <vector>
-#include <functional>
 #include <utility>
 #include <type_traits>
 
@@ -18,6 +17,16 @@ enum class CaseSensitivity {
 using enum CaseSensitivity;
 
 namespace detail {
+/**
+ * Lookup table for enum serialization.
+ *
+ * String to enum lookups go through a minimal perfect hash that's built at static init time, with case folding
+ * built into the hash function for case-insensitive tables. This means that deserialization is a single hash
+ * computation, two array lookups and a single string comparison, and never allocates.
+ *
+ * Enum to string lookups go through a dense array indexed by enum value, unless the values are too sparse for that
+ * (e.g. for flags), in which case a hash map is used.
+ */
 class EnumSerializationTable {
  public:
     template<class T>
@@ -37,16 +46,35 @@ class EnumSerializationTable {
  private:
     void insert(uint64_t value, std::string_view name);
     void polish();
+    void buildPerfectHash();
+    void buildValueIndex();
 
-    struct HeterogeneousStringHash : std::hash<std::string_view> {
-        using is_transparent = void;
+    [[nodiscard]] uint64_t hashName(std::string_view name) const;
+    [[nodiscard]] const std::string *findName(uint64_t value) const;
+
+    struct Entry {
+        uint64_t value;
+        std::string name;
     };
 
  private:
     CaseSensitivity _caseSensitivity;
-    std::unordered_map<uint64_t, std::string> _stringByEnum;
-    std::unordered_map<std::string, uint64_t, HeterogeneousStringHash, std::equal_to<>> _enumByString;
+
+    /** All name-value pairs. Once the table is built, entries are stored in perfect hash slot order. */
+    std::vector<Entry> _entries;
+
+    /** Per-bucket seeds for the second level of the perfect hash. */
+    std::vector<uint32_t> _seeds;
+
+    /** Unique enum values, each with the first name that was provided for it, sorted by value. */
     std::vector<std::pair<uint64_t, std::string>> _sortedEnumStrings;
+
+    /** Dense value index, `_denseIndex[value - _denseBase]` is an index into `_sortedEnumStrings`, or -1. */
+    std::vector<int32_t> _denseIndex;
+    uint64_t _denseBase = 0;
+
+    /** Sparse value index, used instead of `_denseIndex` if enum values are too sparse. */
+    std::unordered_map<uint64_t, int32_t> _sparseIndex;
 };
 
 template<class T>
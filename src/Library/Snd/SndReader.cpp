@@ -4,6 +4,7 @@
 #include <utility>
 
 #include "Library/Compression/Compression.h"
+#include "Library/Compression/ZlibInputStream.h"
 #include "Library/Snapshots/SnapshotSerialization.h"
 
 #include "Utility/Streams/BlobInputStream.h"
@@ -61,12 +62,7 @@ bool SndReader::exists(const std::string &filename) const {
 }
 
 Blob SndReader::read(const std::string &filename) const {
-    assert(isOpen());
-
-    const auto pos = _files.find(toLower(filename));
-    if (pos == _files.cend())
-        throw Exception("Entry '{}' doesn't exist in SND file '{}'", filename, _path);
-    const SndEntry &entry = pos->second;
+    const SndEntry &entry = this->entry(filename);
 
     Blob result = _snd.subBlob(entry.offset, entry.size);
     if (entry.decompressedSize && entry.decompressedSize != entry.size)
@@ -74,6 +70,24 @@ Blob SndReader::read(const std::string &filename) const {
     return result;
 }
 
+std::unique_ptr<InputStream> SndReader::readStream(const std::string &filename) const {
+    const SndEntry &entry = this->entry(filename);
+
+    Blob data = _snd.subBlob(entry.offset, entry.size);
+    if (entry.decompressedSize && entry.decompressedSize != entry.size)
+        return std::make_unique<ZlibInputStream>(std::move(data));
+    return std::make_unique<BlobInputStream>(std::move(data));
+}
+
+const SndEntry &SndReader::entry(const std::string &filename) const {
+    assert(isOpen());
+
+    const auto pos = _files.find(toLower(filename));
+    if (pos == _files.cend())
+        throw Exception("Entry '{}' doesn't exist in SND file '{}'", filename, _path);
+    return pos->second;
+}
+
 std::vector<std::string> SndReader::ls() const {
     assert(isOpen());
 
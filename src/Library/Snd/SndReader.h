@@ -1,11 +1,13 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include "Utility/Memory/Blob.h"
+#include "Utility/Streams/InputStream.h"
 
 #include "SndSnapshots.h"
 
@@ -38,6 +40,13 @@ class SndReader {
         return !!_snd;
     }
 
+    /**
+     * @return                          Path to the file, as was passed to `open`.
+     */
+    [[nodiscard]] const std::string &path() const {
+        return _path;
+    }
+
     /**
      * @param filename                  Name of the SND file entry.
      * @return                          Whether the file exists inside the SND. The check is case-insensitive.
@@ -51,11 +60,26 @@ class SndReader {
      */
     [[nodiscard]] Blob read(const std::string &filename) const;
 
+    /**
+     * Streaming version of `read`.
+     *
+     * Uncompressed entries are read straight from the memory-mapped SND file, and compressed ones are inflated on
+     * the fly as the stream is read, so no buffer for the whole decompressed entry is ever allocated.
+     *
+     * @param filename                  Name of the SND file entry.
+     * @return                          Input stream for the contents of the file inside the SND.
+     * @throws Exception                If file doesn't exist inside the SND.
+     */
+    [[nodiscard]] std::unique_ptr<InputStream> readStream(const std::string &filename) const;
+
     /**
      * @return                          List of all files in the SND.
      */
     [[nodiscard]] std::vector<std::string> ls() const;
 
+ private:
+    [[nodiscard]] const SndEntry &entry(const std::string &filename) const;
+
  private:
     Blob _snd;
     std::string _path;
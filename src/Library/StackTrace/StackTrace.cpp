@@ -1,5 +1,8 @@
 #include "StackTrace.h"
 
+#include <string>
+#include <unordered_map>
+
 #ifndef __ANDROID__
 #   include <backward.hpp>
 #endif
@@ -12,6 +15,16 @@ void printStackTrace(FILE *stream) {
     fmt::println(stream, "Stack traces not supported on Android...");
 }
 
+struct RawStackTrace::Impl {};
+
+void RawStackTrace::capture(int, int) {}
+
+struct StackTracePrinter::Impl {};
+
+void StackTracePrinter::print(FILE *stream, const RawStackTrace &) {
+    printStackTrace(stream);
+}
+
 #else
 
 void printStackTrace(FILE *stream) {
@@ -26,4 +39,39 @@ void printStackTrace(FILE *stream) {
     }
 }
 
+struct RawStackTrace::Impl {
+    backward::StackTrace trace;
+};
+
+void RawStackTrace::capture(int depth, int skip) {
+    _impl->trace.load_here(depth + skip + 1);
+    _impl->trace.skip_n_firsts(skip + 1); // +1 for `capture` itself.
+}
+
+struct StackTracePrinter::Impl {
+    backward::TraceResolver resolver;
+    std::unordered_map<void *, std::string> functionByAddress;
+};
+
+void StackTracePrinter::print(FILE *stream, const RawStackTrace &trace) {
+    backward::StackTrace &stackTrace = trace._impl->trace;
+    _impl->resolver.load_stacktrace(stackTrace);
+
+    for (size_t i = 0; i < stackTrace.size(); i++) {
+        backward::Trace frame = stackTrace[i];
+        auto pos = _impl->functionByAddress.find(frame.addr);
+        if (pos == _impl->functionByAddress.end())
+            pos = _impl->functionByAddress.emplace(frame.addr, _impl->resolver.resolve(frame).object_function).first;
+        fmt::println(stream, "#{: <2} {}", i, pos->second);
+    }
+}
+
 #endif
+
+RawStackTrace::RawStackTrace() : _impl(std::make_unique<Impl>()) {}
+RawStackTrace::RawStackTrace(RawStackTrace &&other) = default;
+RawStackTrace::~RawStackTrace() = default;
+RawStackTrace &RawStackTrace::operator=(RawStackTrace &&other) = default;
+
+StackTracePrinter::StackTracePrinter() : _impl(std::make_unique<Impl>()) {}
+StackTracePrinter::~StackTracePrinter() = default;
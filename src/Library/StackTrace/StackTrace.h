@@ -1,5 +1,53 @@
 #pragma once
 
 #include <cstdio>
+#include <memory>
 
 void printStackTrace(FILE *stream);
+
+/**
+ * Stack trace that stores only the return addresses, and is thus cheap to capture. Symbolization is done only when
+ * the trace is printed, see `StackTracePrinter`.
+ *
+ * Re-capturing into the same `RawStackTrace` doesn't allocate, so these can be reused for repeated captures.
+ */
+class RawStackTrace {
+ public:
+    RawStackTrace();
+    RawStackTrace(RawStackTrace &&other);
+    ~RawStackTrace();
+    RawStackTrace &operator=(RawStackTrace &&other);
+
+    /**
+     * Captures a stack trace at the call site.
+     *
+     * @param depth                     Max number of frames to capture.
+     * @param skip                      Number of innermost frames to skip, not counting `capture` itself.
+     */
+    void capture(int depth, int skip = 0);
+
+ private:
+    friend class StackTracePrinter;
+    struct Impl;
+
+ private:
+    std::unique_ptr<Impl> _impl;
+};
+
+/**
+ * Symbolizes & prints raw stack traces. Resolved symbols are cached, so use a single printer when printing a lot of
+ * stack traces.
+ */
+class StackTracePrinter {
+ public:
+    StackTracePrinter();
+    ~StackTracePrinter();
+
+    void print(FILE *stream, const RawStackTrace &trace);
+
+ private:
+    struct Impl;
+
+ private:
+    std::unique_ptr<Impl> _impl;
+};
@@ -1,17 +1,91 @@
 #include "StackTraceOnCrash.h"
 
+#include <atomic>
+#include <utility>
+
 #ifndef __ANDROID__
 #   include <backward.hpp>
 #endif
 
-#ifdef __ANDROID__
+#ifdef _WINDOWS
+#   include <Windows.h>
+#elif !defined(__ANDROID__)
+#   include <signal.h>
+#   include <array>
+#endif
+
+static std::function<void()> globalCrashCallback;
+static std::atomic<bool> globalCrashCallbackInvoked = false;
+
+static void invokeCrashCallback() {
+    // Make sure we don't recurse if the callback crashes too. Can't just reset the callback here as destroying
+    // an std::function might deallocate, and this is not async-signal-safe.
+    if (globalCrashCallbackInvoked.exchange(true))
+        return;
+    if (globalCrashCallback)
+        globalCrashCallback();
+}
+
+void StackTraceOnCrash::setCrashCallback(std::function<void()> callback) {
+    globalCrashCallback = std::move(callback);
+    globalCrashCallbackInvoked = false;
+}
+
+#if defined(__ANDROID__)
 
 StackTraceOnCrash::StackTraceOnCrash() = default;
 
+#elif defined(_WINDOWS)
+
+static LPTOP_LEVEL_EXCEPTION_FILTER globalBackwardExceptionFilter = nullptr;
+
+static LONG WINAPI crashExceptionFilter(EXCEPTION_POINTERS *info) {
+    invokeCrashCallback();
+    return globalBackwardExceptionFilter ? globalBackwardExceptionFilter(info) : EXCEPTION_CONTINUE_SEARCH;
+}
+
+StackTraceOnCrash::StackTraceOnCrash() {
+    _private = std::make_shared<backward::SignalHandling>();
+
+    // Backward installs its own exception filter, we chain ours in front of it.
+    globalBackwardExceptionFilter = SetUnhandledExceptionFilter(&crashExceptionFilter);
+}
+
 #else
 
+// Preallocated & indexed by signal number, lookups in the signal handler must not allocate.
+static std::array<struct sigaction, NSIG> globalBackwardActions = {};
+
+static void crashSignalHandler(int signal, siginfo_t *info, void *context) {
+    invokeCrashCallback();
+
+    if (signal <= 0 || signal >= NSIG)
+        return;
+
+    const struct sigaction &action = globalBackwardActions[signal];
+    if (action.sa_flags & SA_SIGINFO) {
+        action.sa_sigaction(signal, info, context);
+    } else if (action.sa_handler != SIG_DFL && action.sa_handler != SIG_IGN) {
+        action.sa_handler(signal);
+    }
+}
+
 StackTraceOnCrash::StackTraceOnCrash() {
     _private = std::make_shared<backward::SignalHandling>();
+
+    // Backward installs its own signal handlers, we chain ours in front of them.
+    for (int signal : backward::SignalHandling::make_default_signals()) {
+        if (signal <= 0 || signal >= NSIG)
+            continue;
+
+        struct sigaction action = {};
+        sigaction(signal, nullptr, &action);
+        globalBackwardActions[signal] = action;
+
+        action.sa_sigaction = &crashSignalHandler;
+        action.sa_flags |= SA_SIGINFO;
+        sigaction(signal, &action, nullptr);
+    }
 }
 
 #endif
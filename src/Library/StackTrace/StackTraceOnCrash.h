@@ -1,11 +1,23 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 class StackTraceOnCrash {
  public:
     StackTraceOnCrash();
 
+    /**
+     * Sets the callback that will be invoked on crash, right before the stack trace is printed. Can be used to flush
+     * the buffered logs.
+     *
+     * Note that the callback gets called from a signal handler, so it must be async-signal-safe - no locks, no
+     * allocations, no stdio. It's invoked at most once, and only if a `StackTraceOnCrash` instance is alive.
+     *
+     * @param callback                  Crash callback, pass an empty function to reset. NOT thread-safe.
+     */
+    static void setCrashCallback(std::function<void()> callback);
+
  private:
     std::shared_ptr<void> _private;
 };
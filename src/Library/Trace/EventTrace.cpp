@@ -1,16 +1,22 @@
 #include "EventTrace.h"
 
+#include <cassert>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "Library/Serialization/EnumSerialization.h"
 #include "Library/Json/Json.h"
+#include "Library/Json/JsonStreaming.h"
 
 #include "Io/Key.h" // TODO(captainurist): doesn't belong here
 
-#include "Utility/Streams/FileInputStream.h"
 #include "Utility/Streams/FileOutputStream.h"
+#include "Utility/Streams/StringOutputStream.h"
+#include "Utility/Workaround/ToUnderlying.h"
+#include "Utility/Exception.h"
 
 #include "PaintEvent.h"
 
@@ -205,28 +211,285 @@ MM_DEFINE_JSON_STRUCT_SERIALIZATION_FUNCTIONS(EventTraceHeader, (
     (afterLoadRandomState, "afterLoadRandomState")
 ))
 
-MM_DEFINE_JSON_STRUCT_SERIALIZATION_FUNCTIONS(EventTrace, (
-    (header, "header"),
-    (events, "trace")
-))
+// Json traces are written & parsed in a streaming fashion, one event at a time, so that we don't have to build a DOM
+// for the whole trace. This is equivalent to serializing the following struct:
+// MM_DEFINE_JSON_STRUCT_SERIALIZATION_FUNCTIONS(EventTrace, (
+//     (header, "header"),
+//     (events, "trace")
+// ))
+static constexpr std::string_view JSON_TRACE_HEADER_KEY = "header";
+static constexpr std::string_view JSON_TRACE_EVENTS_KEY = "trace";
+
+// Binary traces start with this magic, followed by a varint format version. JSON traces start with '{'.
+static constexpr std::string_view BINARY_TRACE_MAGIC("OETRACE\0", 8);
+static constexpr uint64_t BINARY_TRACE_VERSION = 1;
+
+/**
+ * Writer for the binary trace format. Everything is stored as varints, signed values are zigzag-encoded first, and
+ * paint event tick counts are stored as deltas from the previous paint event. This way most of the events end up
+ * taking only a couple of bytes.
+ */
+class BinaryTraceWriter {
+ public:
+    explicit BinaryTraceWriter(std::string *target) : _target(target) {}
+
+    void writeUnsigned(uint64_t value) {
+        while (value >= 0x80) {
+            _target->push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        _target->push_back(static_cast<char>(value));
+    }
 
-void EventTrace::saveToFile(std::string_view path, const EventTrace &trace) {
-    FileOutputStream output(path);
+    void writeSigned(int64_t value) {
+        writeUnsigned((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void writeString(std::string_view value) {
+        writeUnsigned(value.size());
+        _target->append(value);
+    }
+
+    void writeEvent(const PlatformEvent *event) {
+        writeUnsigned(std::to_underlying(event->type));
+        dispatchByEventType(event->type, [&]<class T>(T *) {
+            writePayload(*static_cast<const T *>(event));
+        });
+    }
+
+ private:
+    void writePayload(const PlatformKeyEvent &event) {
+        writeSigned(std::to_underlying(event.key));
+        writeUnsigned(static_cast<uint32_t>(event.mods));
+        writeUnsigned(event.isAutoRepeat);
+    }
+
+    void writePayload(const PlatformMouseEvent &event) {
+        writeSigned(std::to_underlying(event.button));
+        writeUnsigned(static_cast<PlatformMouseButtons::underlying_type>(event.buttons));
+        writeSigned(event.pos.x);
+        writeSigned(event.pos.y);
+        writeUnsigned(event.isDoubleClick);
+    }
+
+    void writePayload(const PlatformWheelEvent &event) {
+        writeSigned(event.angleDelta.x);
+        writeSigned(event.angleDelta.y);
+    }
+
+    void writePayload(const PlatformMoveEvent &event) {
+        writeSigned(event.pos.x);
+        writeSigned(event.pos.y);
+    }
+
+    void writePayload(const PlatformResizeEvent &event) {
+        writeSigned(event.size.w);
+        writeSigned(event.size.h);
+    }
+
+    void writePayload(const PlatformWindowEvent &) {}
+
+    void writePayload(const PaintEvent &event) {
+        writeSigned(event.tickCount - _lastTickCount);
+        writeSigned(event.randomState);
+        _lastTickCount = event.tickCount;
+    }
+
+ private:
+    std::string *_target = nullptr;
+    int64_t _lastTickCount = 0;
+};
+
+class BinaryTraceReader {
+ public:
+    explicit BinaryTraceReader(std::string_view data) : _data(data) {}
+
+    uint64_t readUnsigned() {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (_pos == _data.size())
+                throw Exception("Unexpected end of binary trace data");
+
+            uint8_t byte = _data[_pos++];
+            result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return result;
+        }
+        throw Exception("Invalid varint in binary trace data at offset {}", _pos);
+    }
+
+    int64_t readSigned() {
+        uint64_t value = readUnsigned();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    std::string_view readString() {
+        uint64_t size = readUnsigned();
+        if (size > _data.size() - _pos)
+            throw Exception("Unexpected end of binary trace data");
+        std::string_view result = _data.substr(_pos, size);
+        _pos += size;
+        return result;
+    }
+
+    std::unique_ptr<PlatformEvent> readEvent() {
+        PlatformEventType type = static_cast<PlatformEventType>(readUnsigned());
+
+        std::unique_ptr<PlatformEvent> result;
+        dispatchByEventType(type, [&]<class T>(T *) {
+            std::unique_ptr<T> event = std::make_unique<T>();
+            event->type = type;
+            readPayload(event.get());
+            result = std::move(event);
+        });
+        if (!result)
+            throw Exception("Invalid event type {} in binary trace data", std::to_underlying(type));
+        return result;
+    }
+
+ private:
+    void readPayload(PlatformKeyEvent *event) {
+        event->key = static_cast<PlatformKey>(readSigned());
+        event->mods = PlatformModifiers(static_cast<uint32_t>(readUnsigned()));
+        event->isAutoRepeat = readUnsigned();
+    }
+
+    void readPayload(PlatformMouseEvent *event) {
+        event->button = static_cast<PlatformMouseButton>(readSigned());
+        event->buttons = PlatformMouseButtons(static_cast<PlatformMouseButtons::underlying_type>(readUnsigned()));
+        event->pos.x = readSigned();
+        event->pos.y = readSigned();
+        event->isDoubleClick = readUnsigned();
+    }
+
+    void readPayload(PlatformWheelEvent *event) {
+        event->angleDelta.x = readSigned();
+        event->angleDelta.y = readSigned();
+    }
+
+    void readPayload(PlatformMoveEvent *event) {
+        event->pos.x = readSigned();
+        event->pos.y = readSigned();
+    }
+
+    void readPayload(PlatformResizeEvent *event) {
+        event->size.w = readSigned();
+        event->size.h = readSigned();
+    }
 
+    void readPayload(PlatformWindowEvent *) {}
+
+    void readPayload(PaintEvent *event) {
+        event->tickCount = _lastTickCount + readSigned();
+        event->randomState = readSigned();
+        _lastTickCount = event->tickCount;
+    }
+
+ private:
+    std::string_view _data;
+    size_t _pos = 0;
+    int64_t _lastTickCount = 0;
+};
+
+static std::string saveBinaryTrace(const EventTrace &trace) {
+    // Header is small, so we just store it as json. This way we don't need to maintain a separate encoding for configs.
+    Json header;
+    to_json(header, trace.header);
+
+    std::string result(BINARY_TRACE_MAGIC);
+    BinaryTraceWriter writer(&result);
+    writer.writeUnsigned(BINARY_TRACE_VERSION);
+    writer.writeString(header.dump());
+    writer.writeUnsigned(trace.events.size());
+    for (const std::unique_ptr<PlatformEvent> &event : trace.events)
+        writer.writeEvent(event.get());
+    return result;
+}
+
+static EventTrace loadBinaryTrace(std::string_view data) {
+    assert(data.starts_with(BINARY_TRACE_MAGIC));
+
+    BinaryTraceReader reader(data.substr(BINARY_TRACE_MAGIC.size()));
+    uint64_t version = reader.readUnsigned();
+    if (version != BINARY_TRACE_VERSION)
+        throw Exception("Unsupported binary trace version {}, expected {}", version, BINARY_TRACE_VERSION);
+
+    EventTrace result;
+    from_json(Json::parse(reader.readString()), result.header);
+
+    uint64_t eventCount = reader.readUnsigned();
+    for (uint64_t i = 0; i < eventCount; i++)
+        result.events.push_back(reader.readEvent());
+    return result;
+}
+
+static void saveJsonTrace(const EventTrace &trace, OutputStream *dst) {
     // TODO(captainurist): well, nlohmann json is retarded in that it chokes if we throw exceptions inside
     // to_json calls for individual elements. Fix upstream?
     // Note: there is an example in tests to reproduce.
-    Json json;
-    to_json(json, trace);
-    output.write(json.dump(/*indent=*/4));
+    JsonObjectStreamWriter writer(dst);
+
+    Json header;
+    to_json(header, trace.header);
+    writer.writeMember(JSON_TRACE_HEADER_KEY, header);
+
+    writer.beginArray(JSON_TRACE_EVENTS_KEY);
+    for (const std::unique_ptr<PlatformEvent> &event : trace.events) {
+        Json json;
+        to_json(json, event);
+        writer.writeElement(json);
+    }
+    writer.endArray();
+
+    writer.close();
+}
+
+static EventTrace loadJsonTrace(std::string_view data) {
+    EventTrace result;
+    parseJsonObjectStreaming(data, [](std::string_view key) {
+        return key == JSON_TRACE_EVENTS_KEY;
+    }, [&](std::string_view key, Json &&value) {
+        if (key == JSON_TRACE_HEADER_KEY) {
+            from_json(value, result.header);
+        } else if (key == JSON_TRACE_EVENTS_KEY) {
+            from_json(value, result.events.emplace_back());
+        }
+    });
+    return result;
+}
+
+void EventTrace::saveToFile(std::string_view path, const EventTrace &trace, EventTraceFormat format) {
+    FileOutputStream output(path);
+    if (format == EVENT_TRACE_FORMAT_BINARY) {
+        output.write(saveBinaryTrace(trace));
+    } else {
+        saveJsonTrace(trace, &output);
+    }
+    output.close();
 }
 
 EventTrace EventTrace::loadFromFile(std::string_view path, PlatformWindow *window) {
-    FileInputStream input(path);
-    Json json = Json::parse(input.handle());
+    return fromBlob(Blob::fromFile(path), window);
+}
 
+Blob EventTrace::toBlob(const EventTrace &trace, EventTraceFormat format) {
+    if (format == EVENT_TRACE_FORMAT_BINARY)
+        return Blob::fromString(saveBinaryTrace(trace));
+
+    std::string result;
+    StringOutputStream output(&result);
+    saveJsonTrace(trace, &output);
+    output.close();
+    return Blob::fromString(std::move(result));
+}
+
+EventTrace EventTrace::fromBlob(const Blob &blob, PlatformWindow *window) {
     EventTrace result;
-    from_json(json, result);
+    if (detectFormat(blob) == EVENT_TRACE_FORMAT_BINARY) {
+        result = loadBinaryTrace(blob.string_view());
+    } else {
+        result = loadJsonTrace(blob.string_view());
+    }
 
     for (std::unique_ptr<PlatformEvent> &event : result.events) {
         dispatchByEventType(event->type, [&]<class T>(T *) {
@@ -239,6 +502,10 @@ EventTrace EventTrace::loadFromFile(std::string_view path, PlatformWindow *windo
     return result;
 }
 
+EventTraceFormat EventTrace::detectFormat(const Blob &blob) {
+    return blob.string_view().starts_with(BINARY_TRACE_MAGIC) ? EVENT_TRACE_FORMAT_BINARY : EVENT_TRACE_FORMAT_JSON;
+}
+
 bool EventTrace::isTraceable(const PlatformEvent *event) {
     bool result = false;
     dispatchByEventType(event->type, [&](auto) { result = true; }); // Callback not invoked => not supported.
@@ -9,6 +9,10 @@
 #include "Library/Config/ConfigPatch.h"
 #include "Library/Geometry/Vec.h"
 
+#include "Utility/Memory/Blob.h"
+
+#include "EventTraceEnums.h"
+
 // TODO(captainurist): this should go to Core/, not Library/,
 
 struct EventTraceCharacterState {
@@ -42,9 +46,29 @@ struct EventTraceHeader {
 };
 
 struct EventTrace {
-    static void saveToFile(std::string_view path, const EventTrace &trace);
+    static void saveToFile(std::string_view path, const EventTrace &trace,
+                           EventTraceFormat format = EVENT_TRACE_FORMAT_JSON);
+
+    /**
+     * Loads a trace. Trace format is detected automatically.
+     *
+     * @param path                      Path to the trace file.
+     * @param window                    Window to set for all the window events in the trace.
+     * @return                          Loaded trace.
+     * @throws Exception                If the file doesn't exist or is not a valid trace.
+     */
     static EventTrace loadFromFile(std::string_view path, PlatformWindow *window);
 
+    static Blob toBlob(const EventTrace &trace, EventTraceFormat format = EVENT_TRACE_FORMAT_JSON);
+    static EventTrace fromBlob(const Blob &blob, PlatformWindow *window);
+
+    /**
+     * @param blob                      Trace file contents.
+     * @return                          Format of the provided trace. Note that the trace might still fail to load if
+     *                                  it's malformed.
+     */
+    static EventTraceFormat detectFormat(const Blob &blob);
+
     static bool isTraceable(const PlatformEvent *event);
     static std::unique_ptr<PlatformEvent> cloneEvent(const PlatformEvent *event);
 
@@ -0,0 +1,7 @@
+#pragma once
+
+enum class EventTraceFormat {
+    EVENT_TRACE_FORMAT_JSON, // Human-readable & diffable, this is what we keep in the repo.
+    EVENT_TRACE_FORMAT_BINARY, // Compact & fast to load, for CI & local test runs.
+};
+using enum EventTraceFormat;
@@ -0,0 +1,103 @@
+#include <memory>
+#include <utility>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Trace/EventTrace.h"
+#include "Library/Trace/PaintEvent.h"
+#include "Library/Json/Json.h"
+
+static EventTrace makeTestTrace() {
+    EventTrace result;
+    result.header.saveFileSize = 12345;
+    result.header.afterLoadRandomState = -100500;
+    result.header.startState.locationName = "out01.odm";
+    result.header.startState.partyPosition = Vec3i(-1, 2, -300000);
+    result.header.startState.characters.push_back({10, 20});
+
+    std::unique_ptr<PaintEvent> paint0 = std::make_unique<PaintEvent>();
+    paint0->type = EVENT_PAINT;
+    paint0->tickCount = 1000000;
+    paint0->randomState = 42;
+    result.events.push_back(std::move(paint0));
+
+    std::unique_ptr<PlatformKeyEvent> key = std::make_unique<PlatformKeyEvent>();
+    key->type = EVENT_KEY_PRESS;
+    key->key = PlatformKey::KEY_ESCAPE;
+    key->mods = MOD_SHIFT | MOD_CTRL;
+    key->isAutoRepeat = true;
+    result.events.push_back(std::move(key));
+
+    std::unique_ptr<PlatformMouseEvent> mouse = std::make_unique<PlatformMouseEvent>();
+    mouse->type = EVENT_MOUSE_BUTTON_PRESS;
+    mouse->button = BUTTON_LEFT;
+    mouse->buttons = BUTTON_LEFT | BUTTON_RIGHT;
+    mouse->pos = Pointi(-5, 479);
+    mouse->isDoubleClick = true;
+    result.events.push_back(std::move(mouse));
+
+    std::unique_ptr<PlatformWheelEvent> wheel = std::make_unique<PlatformWheelEvent>();
+    wheel->type = EVENT_MOUSE_WHEEL;
+    wheel->angleDelta = Pointi(0, -120);
+    result.events.push_back(std::move(wheel));
+
+    std::unique_ptr<PlatformResizeEvent> resize = std::make_unique<PlatformResizeEvent>();
+    resize->type = EVENT_WINDOW_RESIZE;
+    resize->size = Sizei(640, 480);
+    result.events.push_back(std::move(resize));
+
+    std::unique_ptr<PlatformWindowEvent> activate = std::make_unique<PlatformWindowEvent>();
+    activate->type = EVENT_WINDOW_ACTIVATE;
+    result.events.push_back(std::move(activate));
+
+    std::unique_ptr<PaintEvent> paint1 = std::make_unique<PaintEvent>();
+    paint1->type = EVENT_PAINT;
+    paint1->tickCount = 999984; // Going backwards should also work.
+    paint1->randomState = -1;
+    result.events.push_back(std::move(paint1));
+
+    return result;
+}
+
+UNIT_TEST(EventTrace, BinaryRoundTrip) {
+    EventTrace trace = makeTestTrace();
+    Blob json = EventTrace::toBlob(trace, EVENT_TRACE_FORMAT_JSON);
+    Blob binary = EventTrace::toBlob(trace, EVENT_TRACE_FORMAT_BINARY);
+    EXPECT_EQ(EventTrace::detectFormat(json), EVENT_TRACE_FORMAT_JSON);
+    EXPECT_EQ(EventTrace::detectFormat(binary), EVENT_TRACE_FORMAT_BINARY);
+    EXPECT_LT(binary.size(), json.size());
+
+    // Converting binary -> json should give us exactly what we've started with.
+    EventTrace fromBinary = EventTrace::fromBlob(binary, nullptr);
+    EXPECT_EQ(fromBinary.events.size(), trace.events.size());
+    EXPECT_EQ(EventTrace::toBlob(fromBinary, EVENT_TRACE_FORMAT_JSON).string_view(), json.string_view());
+
+    // And json -> binary should also be lossless.
+    EventTrace fromJson = EventTrace::fromBlob(json, nullptr);
+    EXPECT_EQ(EventTrace::toBlob(fromJson, EVENT_TRACE_FORMAT_BINARY).string_view(), binary.string_view());
+}
+
+UNIT_TEST(EventTrace, BinaryTruncated) {
+    Blob binary = EventTrace::toBlob(makeTestTrace(), EVENT_TRACE_FORMAT_BINARY);
+    Blob truncated = binary.subBlob(0, binary.size() - 1);
+    EXPECT_THROW((void) EventTrace::fromBlob(truncated, nullptr), std::exception);
+}
+
+UNIT_TEST(EventTrace, JsonMatchesDom) {
+    // Streaming json writer should produce exactly what dumping a DOM of the whole trace would produce, so that the
+    // traces in the repo don't change.
+    EventTrace trace = makeTestTrace();
+    Blob json = EventTrace::toBlob(trace, EVENT_TRACE_FORMAT_JSON);
+    EXPECT_EQ(Json::parse(json.string_view()).dump(4), json.string_view());
+
+    EventTrace fromJson = EventTrace::fromBlob(json, nullptr);
+    EXPECT_EQ(fromJson.header.saveFileSize, trace.header.saveFileSize);
+    EXPECT_EQ(fromJson.header.startState.locationName, trace.header.startState.locationName);
+    EXPECT_EQ(fromJson.events.size(), trace.events.size());
+    EXPECT_EQ(EventTrace::toBlob(fromJson, EVENT_TRACE_FORMAT_JSON).string_view(), json.string_view());
+}
+
+UNIT_TEST(EventTrace, JsonInvalid) {
+    EXPECT_THROW((void) EventTrace::fromBlob(Blob::fromString("{\"trace\": [{\"type\": \"paint\""), nullptr), Json::exception);
+    EXPECT_THROW((void) EventTrace::fromBlob(Blob::fromString("[]"), nullptr), Json::exception);
+}
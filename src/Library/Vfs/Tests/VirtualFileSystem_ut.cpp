@@ -0,0 +1,88 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Library/Lod/LodReader.h"
+#include "Library/Lod/LodWriter.h"
+#include "Library/Vfs/VirtualFileSystem.h"
+
+#include "Utility/Streams/BlobOutputStream.h"
+
+static LodReader makeLod(std::string_view path, const std::vector<std::pair<std::string, std::string>> &files) {
+    LodInfo info;
+    info.version = LOD_VERSION_MM7;
+    info.rootName = "data";
+
+    Blob lod;
+    BlobOutputStream stream(&lod);
+    LodWriter writer(&stream, path, info);
+    for (const auto &[name, data] : files)
+        writer.write(name, Blob::fromString(data));
+    writer.close();
+    stream.close();
+
+    return LodReader(std::move(lod), path);
+}
+
+UNIT_TEST(VirtualFileSystem, Priority) {
+    LodReader lod1 = makeLod("1.lod", {{"a", "a1"}, {"b", "b1"}});
+    LodReader lod2 = makeLod("2.lod", {{"b", "b2"}, {"c", "c2"}});
+
+    VirtualFileSystem vfs;
+    vfs.mount(lod1);
+    vfs.mount(lod2);
+
+    EXPECT_EQ(vfs.archiveCount(), 2);
+    EXPECT_EQ(vfs.ls(), (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(vfs.read("a").string_view(), "a1");
+    EXPECT_EQ(vfs.read("b").string_view(), "b2"); // Last mounted archive wins.
+    EXPECT_EQ(vfs.find("b")->archive, 1);
+    EXPECT_EQ(vfs.read("c").string_view(), "c2");
+    EXPECT_EQ(vfs.find("c")->archive, 1);
+    EXPECT_EQ(vfs.archivePath(vfs.find("c")->archive), "2.lod");
+}
+
+UNIT_TEST(VirtualFileSystem, OverrideOrder) {
+    // Same entry in all three LODs, plus entries that are only overridden by some of them.
+    LodReader lod1 = makeLod("1.lod", {{"a", "a1"}, {"b", "b1"}, {"z", "z1"}});
+    LodReader lod2 = makeLod("2.lod", {{"a", "a2"}, {"b", "b2"}});
+    LodReader lod3 = makeLod("3.lod", {{"A", "a3"}, {"c", "c3"}});
+
+    VirtualFileSystem vfs;
+    vfs.mount(lod1);
+    vfs.mount(lod2);
+    vfs.mount(lod3);
+
+    EXPECT_EQ(vfs.ls(), (std::vector<std::string>{"a", "b", "c", "z"}));
+    EXPECT_EQ(vfs.read("a").string_view(), "a3");
+    EXPECT_EQ(vfs.archivePath(vfs.find("a")->archive), "3.lod");
+    EXPECT_EQ(vfs.read("b").string_view(), "b2");
+    EXPECT_EQ(vfs.read("c").string_view(), "c3");
+    EXPECT_EQ(vfs.read("z").string_view(), "z1");
+    EXPECT_EQ(vfs.find("z")->archive, 0);
+}
+
+UNIT_TEST(VirtualFileSystem, CaseInsensitive) {
+    LodReader lod = makeLod("1.lod", {{"SomeFile", "data"}});
+
+    VirtualFileSystem vfs;
+    vfs.mount(lod);
+
+    EXPECT_TRUE(vfs.exists("somefile"));
+    EXPECT_TRUE(vfs.exists("SOMEFILE"));
+    EXPECT_FALSE(vfs.exists("somefil"));
+    EXPECT_FALSE(vfs.exists("somefile1"));
+    EXPECT_EQ(vfs.read("SoMeFiLe").string_view(), "data");
+    EXPECT_THROW((void) vfs.read("otherfile"), std::exception);
+}
+
+UNIT_TEST(VirtualFileSystem, OutlivesReaders) {
+    VirtualFileSystem vfs;
+    {
+        LodReader lod = makeLod("1.lod", {{"a", "data"}});
+        vfs.mount(lod);
+    }
+    EXPECT_EQ(vfs.read("a").string_view(), "data");
+}
@@ -0,0 +1,123 @@
+#include "VirtualFileSystem.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <utility>
+
+#include "Library/Lod/LodReader.h"
+#include "Library/Vid/VidReader.h"
+#include "Library/Snd/SndReader.h"
+
+#include "Utility/Exception.h"
+#include "Utility/String.h"
+
+namespace {
+struct VfsEntryLess {
+    bool operator()(const VfsEntry &l, std::string_view r) const {
+        return iless(l.name, r);
+    }
+    bool operator()(std::string_view l, const VfsEntry &r) const {
+        return iless(l, r.name);
+    }
+};
+} // namespace
+
+VirtualFileSystem::VirtualFileSystem() = default;
+VirtualFileSystem::~VirtualFileSystem() = default;
+
+void VirtualFileSystem::mount(const LodReader &lod) {
+    assert(lod.isOpen());
+
+    int archive = _archives.size();
+    _archives.push_back({lod.path(), {}});
+
+    std::vector<VfsEntry> entries;
+    for (std::string &name : lod.ls()) {
+        Blob data = lod.read(name);
+        entries.push_back({std::move(name), archive, std::move(data)});
+    }
+    merge(std::move(entries));
+}
+
+void VirtualFileSystem::mount(const VidReader &vid) {
+    assert(vid.isOpen());
+
+    int archive = _archives.size();
+    _archives.push_back({vid.path(), {}});
+
+    std::vector<VfsEntry> entries;
+    for (std::string &name : vid.ls()) {
+        Blob data = vid.read(name);
+        entries.push_back({std::move(name), archive, std::move(data)});
+    }
+    merge(std::move(entries));
+}
+
+void VirtualFileSystem::mount(const SndReader *snd) {
+    assert(snd && snd->isOpen());
+
+    int archive = _archives.size();
+    _archives.push_back({snd->path(), [snd] (const std::string &name) { return snd->read(name); }});
+
+    std::vector<VfsEntry> entries;
+    for (std::string &name : snd->ls())
+        entries.push_back({std::move(name), archive, Blob()});
+    merge(std::move(entries));
+}
+
+void VirtualFileSystem::clear() {
+    _archives.clear();
+    _entries.clear();
+}
+
+const VfsEntry *VirtualFileSystem::find(std::string_view name) const {
+    auto pos = std::lower_bound(_entries.begin(), _entries.end(), name, VfsEntryLess());
+    if (pos == _entries.end() || !iequals(pos->name, name))
+        return nullptr;
+    return &*pos;
+}
+
+Blob VirtualFileSystem::read(std::string_view name) const {
+    const VfsEntry *entry = find(name);
+    if (!entry)
+        throw Exception("Entry '{}' doesn't exist in any of the mounted archives", name);
+    return read(*entry);
+}
+
+Blob VirtualFileSystem::read(const VfsEntry &entry) const {
+    const Archive &archive = _archives[entry.archive];
+    if (archive.lazyRead)
+        return archive.lazyRead(entry.name);
+    return Blob::share(entry.data);
+}
+
+std::vector<std::string> VirtualFileSystem::ls() const {
+    std::vector<std::string> result;
+    result.reserve(_entries.size());
+    for (const VfsEntry &entry : _entries)
+        result.push_back(entry.name);
+    return result;
+}
+
+void VirtualFileSystem::merge(std::vector<VfsEntry> entries) {
+    for (VfsEntry &entry : entries)
+        entry.name = toLower(entry.name); // Readers already return lowercased names, but we don't want to rely on that.
+
+    std::sort(entries.begin(), entries.end(), [] (const VfsEntry &l, const VfsEntry &r) { return l.name < r.name; });
+
+    // Merge, entries from the archive that's being mounted override the ones that are already in the index.
+    std::vector<VfsEntry> result;
+    result.reserve(_entries.size() + entries.size());
+    auto l = _entries.begin(), r = entries.begin();
+    while (l != _entries.end() || r != entries.end()) {
+        if (l == _entries.end() || (r != entries.end() && r->name <= l->name)) {
+            if (l != _entries.end() && l->name == r->name)
+                ++l; // Overridden by the new archive.
+            result.push_back(std::move(*r++));
+        } else {
+            result.push_back(std::move(*l++));
+        }
+    }
+    _entries = std::move(result);
+}
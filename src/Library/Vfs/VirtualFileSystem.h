@@ -0,0 +1,102 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Utility/Memory/Blob.h"
+
+class LodReader;
+class VidReader;
+class SndReader;
+
+/**
+ * Entry in the merged index of a `VirtualFileSystem`.
+ */
+struct VfsEntry {
+    std::string name; // Lowercased entry name.
+    int archive = -1; // Index of the archive this entry comes from, in mount order.
+    Blob data; // Entry data as a subblob of the archive, or an empty blob if the archive doesn't support direct access.
+};
+
+/**
+ * Layered read-only file system over several game archives.
+ *
+ * Archives are mounted one after another, and archives that were mounted later override the ones mounted before
+ * them, so a LOD set is mounted base archive first & patches / mods on top. Once an archive is mounted, its entries
+ * are merged into a single sorted index, so that a lookup is always a single binary search over pre-lowercased names
+ * that doesn't allocate, no matter how many archives are mounted.
+ *
+ * LOD & VID files are mounted directly - index stores subblobs of the archive memory, so reading doesn't touch the
+ * original reader at all. SND files use compression at the container level, so the index just points back to
+ * the original `SndReader`, which then must outlive this object.
+ */
+class VirtualFileSystem {
+ public:
+    VirtualFileSystem();
+    ~VirtualFileSystem();
+
+    void mount(const LodReader &lod);
+    void mount(const VidReader &vid);
+    void mount(const SndReader *snd);
+
+    /**
+     * Unmounts all archives.
+     */
+    void clear();
+
+    /**
+     * @param name                      Name of the entry to look up. The lookup is case-insensitive.
+     * @return                          Entry for the provided name, or `nullptr` if it wasn't found in any of
+     *                                  the mounted archives. If several archives have this entry, the one from
+     *                                  the archive that was mounted last is returned.
+     */
+    [[nodiscard]] const VfsEntry *find(std::string_view name) const;
+
+    [[nodiscard]] bool exists(std::string_view name) const {
+        return find(name) != nullptr;
+    }
+
+    /**
+     * @param name                      Name of the entry to read.
+     * @return                          Entry contents.
+     * @throws Exception                If there is no such entry.
+     */
+    [[nodiscard]] Blob read(std::string_view name) const;
+
+    /**
+     * @param entry                     Entry to read, as returned from `find`.
+     * @return                          Entry contents.
+     */
+    [[nodiscard]] Blob read(const VfsEntry &entry) const;
+
+    /**
+     * @param archive                   Archive index.
+     * @return                          Path of the archive file, as was passed to the corresponding reader.
+     */
+    [[nodiscard]] const std::string &archivePath(int archive) const {
+        return _archives[archive].path;
+    }
+
+    [[nodiscard]] int archiveCount() const {
+        return _archives.size();
+    }
+
+    /**
+     * @return                          Sorted list of all entries in the mounted archives.
+     */
+    [[nodiscard]] std::vector<std::string> ls() const;
+
+ private:
+    struct Archive {
+        std::string path;
+        std::function<Blob(const std::string &)> lazyRead;
+    };
+
+    void merge(std::vector<VfsEntry> entries);
+
+ private:
+    std::vector<Archive> _archives;
+    std::vector<VfsEntry> _entries; // Sorted by name.
+};
@@ -32,6 +32,13 @@ class VidReader {
         return !!_vid;
     }
 
+    /**
+     * @return                          Path to the file, as was passed to `open`.
+     */
+    [[nodiscard]] const std::string &path() const {
+        return _path;
+    }
+
     /**
      * @param filename                  Name of the VID file entry.
      * @return                          Whether the file exists inside the VID. The check is case-insensitive.
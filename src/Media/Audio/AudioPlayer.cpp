@@ -1,11 +1,14 @@
 #include "AudioPlayer.h"
 
 #include <algorithm>
+#include <cassert>
 #include <map>
+#include <optional>
 #include <string>
 #include <filesystem>
 #include <utility>
 #include <thread>
+#include <vector>
 
 #include "Engine/Graphics/Indoor.h"
 #include "Engine/Graphics/Level/Decoration.h"
@@ -19,11 +22,15 @@
 #include "GUI/GUIWindow.h"
 
 #include "Media/AudioBufferDataSource.h"
+#include "Media/AudioStreamDataSource.h"
 
 #include "Library/Compression/Compression.h"
 #include "Library/Logger/Logger.h"
+#include "Library/Profiler/Profiler.h"
 
 #include "Utility/DataPath.h"
+#include "Utility/Memory/MemoryAccounting.h"
+#include "Utility/Thread/ThreadPool.h"
 
 #include "SoundList.h"
 #include "OpenALTrack16.h"
@@ -45,6 +52,10 @@ extern OpenALSoundProvider *provider;
 
 AudioPlayer::~AudioPlayer() = default;
 
+static std::string musicTrackPath(MusicId eTrack) {
+    return makeDataPath("music", fmt::format("{}.mp3", std::to_underlying(eTrack)));
+}
+
 void AudioPlayer::MusicPlayTrack(MusicId eTrack) {
     if (currentMusicTrack == eTrack) {
         return;
@@ -56,14 +67,21 @@ void AudioPlayer::MusicPlayTrack(MusicId eTrack) {
         }
         currentMusicTrack = MUSIC_INVALID;
 
-        std::string file_path = fmt::format("{}.mp3", std::to_underlying(eTrack));
-        file_path = makeDataPath("music", file_path);
-        if (!std::filesystem::exists(file_path)) {
-            logger->warning("AudioPlayer: {} not found", file_path);
-            return;
+        PAudioDataSource source;
+        if (_prefetchedMusicTrack == eTrack) {
+            source = std::move(_prefetchedMusic);
+        } else {
+            std::string file_path = musicTrackPath(eTrack);
+            if (!std::filesystem::exists(file_path)) {
+                logger->warning("AudioPlayer: {} not found", file_path);
+                return;
+            }
+            source = CreateMusicDataSource(file_path);
         }
+        _prefetchedMusic = nullptr;
+        _prefetchedMusicTrack = MUSIC_INVALID;
 
-        pCurrentMusicTrack = CreateAudioTrack(file_path);
+        pCurrentMusicTrack = CreateAudioTrack(source);
         if (pCurrentMusicTrack) {
             currentMusicTrack = eTrack;
 
@@ -76,6 +94,21 @@ void AudioPlayer::MusicPlayTrack(MusicId eTrack) {
     }
 }
 
+void AudioPlayer::MusicPrefetchTrack(MusicId eTrack) {
+    if (engine->config->debug.NoSound.value() || !bPlayerReady)
+        return;
+    if (eTrack == MUSIC_INVALID || eTrack == currentMusicTrack || eTrack == _prefetchedMusicTrack)
+        return;
+
+    std::string file_path = musicTrackPath(eTrack);
+    if (!std::filesystem::exists(file_path))
+        return;
+
+    _prefetchedMusic = CreateMusicDataSource(file_path);
+    _prefetchedMusic->Open(); // Starts decoding in the background.
+    _prefetchedMusicTrack = eTrack;
+}
+
 void AudioPlayer::MusicStart() {}
 
 void AudioPlayer::MusicStop() {
@@ -328,43 +361,176 @@ void AudioPlayer::playSound(SoundId eSoundID, SoundPlaybackMode mode, Pid pid) {
 }
 
 bool AudioPlayer::loadSoundDataSource(SoundInfo* si) {
-    if (!si->dataSource) {
-        Blob buffer;
+    if (si->dataSource) {
+        touchCachedSound(si->uSoundID);
+        _soundCacheHits++;
+        return true;
+    }
+    _soundCacheMisses++;
 
-        if (si->sName == "") {  // enable this for bonus sound effects
-            //logger->Info("AudioPlayer: trying to load bonus sound {}", eSoundID);
-            //buffer = LoadSound(int(eSoundID));
-        } else {
-            buffer = LoadSound(si->sName);
-        }
+    if (si->sName.empty()) {  // enable this for bonus sound effects
+        //logger->Info("AudioPlayer: trying to load bonus sound {}", eSoundID);
+        //buffer = LoadSound(int(eSoundID));
+        logger->warning("AudioPlayer: failed to load sound {} ({})", std::to_underlying(si->uSoundID), si->sName);
+        return false;
+    }
 
-        if (!buffer) {
-            logger->warning("AudioPlayer: failed to load sound {} ({})", std::to_underlying(si->uSoundID), si->sName);
-            return false;
-        }
+    if (!_sndReader.exists(si->sName)) {
+        logger->warning("AudioPlayer: {} can't load sound header!", si->sName);
+        return false;
+    }
+
+    // Streaming from the SND, compressed sounds are inflated as they are decoded.
+    MemoryTagScope memoryScope(MEMORY_TAG_AUDIO);
+    auto loadStart = std::chrono::steady_clock::now();
+    bool loaded = createSoundDataSource(si, CreateAudioStreamDataSource(_sndReader.readStream(si->sName)));
+    _soundLoadTime += std::chrono::steady_clock::now() - loadStart;
+    _soundLoadCount++;
+    if (!loaded)
+        return false;
+
+    trimSoundCache();
+    return true;
+}
+
+void AudioPlayer::preloadSounds(std::span<const SoundId> soundIds) {
+    if (!bPlayerReady)
+        return;
+
+    std::vector<SoundInfo *> infos;
+    for (SoundId soundId : soundIds) {
+        if (soundId == SOUND_Invalid)
+            continue;
+
+        SoundInfo *si = pSoundList->soundInfo(soundId);
+        if (!si || si->dataSource || si->sName.empty() || !_sndReader.exists(si->sName))
+            continue;
+        if (std::ranges::find(infos, si) == infos.end())
+            infos.push_back(si);
+    }
 
-        si->dataSource = CreateAudioBufferDataSource(std::move(buffer));
-        if (!si->dataSource) {
-            logger->warning("AudioPlayer: failed to create sound data source {} ({})", std::to_underlying(si->uSoundID), si->sName);
-            return false;
+    // SND reads & zlib inflate are thread-safe, decoding & uploading to OpenAL is then done on this thread.
+    MemoryTagScope memoryScope(MEMORY_TAG_AUDIO);
+    auto loadStart = std::chrono::steady_clock::now();
+    std::vector<Blob> buffers(infos.size());
+    engine->_threadPool->parallelFor(infos.size(), 1, [&](size_t begin, size_t end) {
+        MemoryTagScope workerMemoryScope(MEMORY_TAG_AUDIO);
+        for (size_t i = begin; i < end; i++)
+            buffers[i] = _sndReader.read(infos[i]->sName);
+    });
+
+    for (size_t i = 0; i < infos.size(); i++) {
+        if (!buffers[i]) {
+            logger->warning("AudioPlayer: failed to load sound {} ({})", std::to_underlying(infos[i]->uSoundID), infos[i]->sName);
+            continue;
         }
+        createSoundDataSource(infos[i], CreateAudioBufferDataSource(std::move(buffers[i])));
+    }
+    _soundLoadTime += std::chrono::steady_clock::now() - loadStart;
+    _soundLoadCount += infos.size();
+
+    trimSoundCache();
+    logger->trace("AudioPlayer: preloaded {} sounds, {} KiB in sound cache", infos.size(), _cachedSoundsSize / 1024);
+}
+
+bool AudioPlayer::createSoundDataSource(SoundInfo *si, PAudioDataSource baseDataSource) {
+    assert(!si->dataSource);
 
-        si->dataSource = PlatformDataSourceInitialize(si->dataSource);
+    if (!baseDataSource) {
+        logger->warning("AudioPlayer: failed to create sound data source {} ({})", std::to_underlying(si->uSoundID), si->sName);
+        return false;
     }
+
+    // Decode right away so that we know how much memory the sound takes.
+    auto dataSource = std::static_pointer_cast<OpenALAudioDataSource>(PlatformDataSourceInitialize(baseDataSource));
+    if (!dataSource->Open()) {
+        logger->warning("AudioPlayer: failed to decode sound {} ({})", std::to_underlying(si->uSoundID), si->sName);
+        return false;
+    }
+    si->dataSource = dataSource;
+
+    _soundLru.push_front(si->uSoundID);
+    _cachedSounds[si->uSoundID] = CachedSound{dataSource->bufferSize(), _soundLru.begin()};
+    _cachedSoundsSize += dataSource->bufferSize();
     return true;
 }
 
+void AudioPlayer::touchCachedSound(SoundId soundId) {
+    auto pos = _cachedSounds.find(soundId);
+    if (pos != _cachedSounds.end())
+        _soundLru.splice(_soundLru.begin(), _soundLru, pos->second.lruPos);
+}
+
+void AudioPlayer::trimSoundCache() {
+    size_t budget = static_cast<size_t>(engine->config->settings.SoundCacheSize.value()) * 1024 * 1024;
+
+    // Walk from the least recently played sound, skipping the ones that are still referenced by playing samples.
+    // Most recently played sound is never evicted, so that the caller can use it even if it's over the budget.
+    auto pos = _soundLru.end();
+    while (_cachedSoundsSize > budget && pos != _soundLru.begin() && std::prev(pos) != _soundLru.begin()) {
+        --pos;
+
+        SoundInfo *si = pSoundList->soundInfo(*pos);
+        assert(si && si->dataSource);
+        if (si->dataSource.use_count() > 1)
+            continue;
+
+        si->dataSource = nullptr;
+        auto cachedPos = _cachedSounds.find(*pos);
+        _cachedSoundsSize -= cachedPos->second.size;
+        _cachedSounds.erase(cachedPos);
+        pos = _soundLru.erase(pos);
+    }
+}
+
+/**
+ * @param pid                           Object that's playing a sound.
+ * @return                              Current position of the object, or `std::nullopt` if the object doesn't move
+ *                                      or doesn't exist anymore.
+ */
+static std::optional<Vec3f> movingSoundSourcePosition(Pid pid) {
+    switch (pid.type()) {
+        case OBJECT_Actor:
+            if (pid.id() < pActors.size())
+                return pActors[pid.id()].pos.toFloat();
+            return std::nullopt;
+        case OBJECT_Item:
+            if (pid.id() < pSpriteObjects.size())
+                return pSpriteObjects[pid.id()].vPosition.toFloat();
+            return std::nullopt;
+        default:
+            return std::nullopt;
+    }
+}
+
 void AudioPlayer::UpdateSounds() {
+    OE_PROFILE_ZONE("audio");
+
     float pitch = M_PI * pParty->_viewPitch / 1024.f;
     float yaw = M_PI * pParty->_viewYaw / 1024.f;
 
+    // Apply all the listener & source changes at once.
+    provider->BeginBatchUpdates();
+
     provider->SetOrientation(yaw, pitch);
     provider->SetListenerPosition(pParty->pos.x, pParty->pos.y, pParty->pos.z);
 
+    _voiceSoundPool.setListenerPosition(pParty->pos);
+    _regularSoundPool.setListenerPosition(pParty->pos);
+    _loopingSoundPool.setListenerPosition(pParty->pos);
+
     _voiceSoundPool.update();
     _regularSoundPool.update();
     _loopingSoundPool.update();
 
+    // Sounds follow the objects that are playing them. Samples only call into OpenAL if position has changed.
+    _regularSoundPool.forEachPositionalPid([](Pid pid, IAudioSample &sample) {
+        if (std::optional<Vec3f> position = movingSoundSourcePosition(pid))
+            sample.SetPosition(position->x, position->y, position->z, MAX_SOUND_DIST);
+    });
+
+    provider->EndBatchUpdates();
+
     if (current_screen_type != SCREEN_GAME) {
         stopWalkingSounds();
     }
@@ -373,6 +539,25 @@ void AudioPlayer::UpdateSounds() {
     }
 }
 
+AudioStats AudioPlayer::stats() const {
+    AudioStats result;
+    result.voiceSoundCount = _voiceSoundPool.activeVoiceCount();
+    result.voiceSoundCapacity = _voiceSoundPool.capacity();
+    result.regularSoundCount = _regularSoundPool.activeVoiceCount();
+    result.regularSoundCapacity = _regularSoundPool.capacity();
+    result.loopingSoundCount = _loopingSoundPool.activeVoiceCount();
+    result.loopingSoundCapacity = _loopingSoundPool.capacity();
+    result.soundLoadCount = _soundLoadCount;
+    result.soundLoadTime = _soundLoadTime;
+    result.soundCacheHits = _soundCacheHits;
+    result.soundCacheMisses = _soundCacheMisses;
+    result.soundCacheSize = _cachedSoundsSize;
+    result.musicUnderrunCount = pCurrentMusicTrack ? pCurrentMusicTrack->GetUnderrunCount() : 0;
+    result.totalStreamUnderrunCount = totalStreamUnderrunCount();
+    result.totalStreamUpdateTime = OpenALUpdateThread::totalUpdateTime();
+    return result;
+}
+
 void AudioPlayer::pauseAllSounds() {
     _voiceSoundPool.pause();
     _regularSoundPool.pause();
@@ -387,6 +572,11 @@ void AudioPlayer::pauseLooping() {
 }
 
 void AudioPlayer::soundDrain() {
+    // Nobody's going to hear the sounds anyway, so there's no point in waiting. Trace playback mutes everything, and
+    // this makes headless retraces & game tests not block on wall clock here.
+    if (engine->config->debug.NoSound.value() || (uMasterVolume == 0 && uVoiceVolume == 0))
+        return;
+
     while (_voiceSoundPool.hasPlaying()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
         _voiceSoundPool.update();
@@ -447,6 +637,13 @@ void PlayLevelMusic() {
     }
 }
 
+void PrefetchLevelMusic(const std::string &mapName) {
+    MapId map_id = pMapStats->GetMapInfo(mapName);
+    if (map_id != MAP_INVALID) {
+        pAudioPlayer->MusicPrefetchTrack(pMapStats->pInfos[map_id].musicId);
+    }
+}
+
 Blob AudioPlayer::LoadSound(const std::string &pSoundName) {
     if (!_sndReader.exists(pSoundName)) {
         logger->warning("AudioPlayer: {} can't load sound header!", pSoundName);
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <memory>
 #include <list>
+#include <span>
+#include <unordered_map>
 
 #include "Engine/Pid.h"
 #include "Engine/Spells/SpellEnums.h"
@@ -21,6 +25,30 @@
 #include "AudioSamplePool.h"
 #include "SoundInfo.h"
 
+/**
+ * Audio subsystem counters, see `AudioPlayer::stats`.
+ */
+struct AudioStats {
+    using Duration = std::chrono::steady_clock::duration;
+
+    int voiceSoundCount = 0;
+    int voiceSoundCapacity = 0;
+    int regularSoundCount = 0;
+    int regularSoundCapacity = 0;
+    int loopingSoundCount = 0;
+    int loopingSoundCapacity = 0;
+
+    int64_t soundLoadCount = 0; // Number of sounds loaded & decoded, including preloads.
+    Duration soundLoadTime = {}; // Total time spent loading & decoding sounds.
+    int64_t soundCacheHits = 0; // Sounds played from the decoded sound cache.
+    int64_t soundCacheMisses = 0; // Sounds that had to be loaded on play.
+    size_t soundCacheSize = 0; // Decoded PCM data in the sound cache, in bytes.
+
+    int musicUnderrunCount = 0; // Underruns of the current music track.
+    int64_t totalStreamUnderrunCount = 0; // Underruns of all streamed tracks since the program start.
+    Duration totalStreamUpdateTime = {}; // Time spent refilling streamed tracks since the program start.
+};
+
 class AudioPlayer {
  public:
     AudioPlayer() = default;
@@ -36,18 +64,35 @@ class AudioPlayer {
     void SetMusicVolume(int level);
 
     void MusicPlayTrack(MusicId eTrack);
+
+    /**
+     * Starts opening & decoding the provided music track in the background, so that a subsequent `MusicPlayTrack`
+     * call for the same track doesn't need to wait for the disk. Only one track is prefetched at a time.
+     *
+     * @param eTrack                    Track to prefetch.
+     */
+    void MusicPrefetchTrack(MusicId eTrack);
     void MusicStart();
     void MusicStop();
     void MusicPause();
     void MusicResume();
 
     void UpdateSounds();
+
+    /**
+     * @return                          Current values of the audio subsystem counters.
+     */
+    [[nodiscard]] AudioStats stats() const;
     void pauseAllSounds();
     void pauseLooping();
     void resumeSounds();
     void stopSounds();
     void stopVoiceSounds();
     void stopWalkingSounds();
+
+    /**
+     * Waits until all voice & regular sounds finish playing. Returns right away if sound is disabled or muted.
+     */
     void soundDrain();
     bool isWalkingSoundPlays();
 
@@ -74,6 +119,17 @@ class AudioPlayer {
      */
     bool loadSoundDataSource(SoundInfo* si);
 
+    /**
+     * Loads & decodes the provided sounds so that playing them later doesn't hit the disk. SND reads & decompression
+     * are done in parallel on the engine thread pool.
+     *
+     * Preloaded sounds go through the same cache as the sounds loaded on demand, and are thus subject to the
+     * `settings.sound_cache_size` budget.
+     *
+     * @param soundIds                  Ids of the sounds to preload. Duplicates and invalid ids are OK.
+     */
+    void preloadSounds(std::span<const SoundId> soundIds);
+
     /**
      * Play sound of spell casting or spell sprite impact.
      *
@@ -145,20 +201,51 @@ class AudioPlayer {
     }
 
  protected:
+    bool createSoundDataSource(SoundInfo *si, PAudioDataSource baseDataSource);
+    void touchCachedSound(SoundId soundId);
+    void trimSoundCache();
+
+ protected:
+    struct CachedSound {
+        size_t size = 0;
+        std::list<SoundId>::iterator lruPos;
+    };
+
     bool bPlayerReady = false;
     MusicId currentMusicTrack = MUSIC_INVALID;
     float uMasterVolume = 0;
     float uMusicVolume = 0;
     float uVoiceVolume = 0;
     PAudioTrack pCurrentMusicTrack;
-
-    AudioSamplePool _voiceSoundPool = AudioSamplePool(false);
-    AudioSamplePool _regularSoundPool = AudioSamplePool(false);
-    AudioSamplePool _loopingSoundPool = AudioSamplePool(true);
+    PAudioDataSource _prefetchedMusic;
+    MusicId _prefetchedMusicTrack = MUSIC_INVALID;
+
+    // Pool capacities add up to less than the 256 sources that OpenAL Soft provides by default, leaving room for the
+    // walking sample & music.
+    AudioSamplePool _voiceSoundPool = AudioSamplePool(false, 16);
+    AudioSamplePool _regularSoundPool = AudioSamplePool(false, 160);
+    AudioSamplePool _loopingSoundPool = AudioSamplePool(true, 64);
     PAudioSample _currentWalkingSample;
     SndReader _sndReader;
+
+    // Sounds that have a data source loaded, most recently played first.
+    std::list<SoundId> _soundLru;
+    std::unordered_map<SoundId, CachedSound> _cachedSounds;
+    size_t _cachedSoundsSize = 0; // Total size of decoded PCM data in `_cachedSounds`, in bytes.
+
+    int64_t _soundLoadCount = 0;
+    AudioStats::Duration _soundLoadTime = {};
+    int64_t _soundCacheHits = 0;
+    int64_t _soundCacheMisses = 0;
 };
 
 extern std::unique_ptr<AudioPlayer> pAudioPlayer;
 
 void PlayLevelMusic();
+
+/**
+ * Prefetches the music for the provided map, see `AudioPlayer::MusicPrefetchTrack`.
+ *
+ * @param mapName                       Name of the map that the party is about to travel to.
+ */
+void PrefetchLevelMusic(const std::string &mapName);
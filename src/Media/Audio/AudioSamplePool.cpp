@@ -1,110 +1,181 @@
 #include "AudioSamplePool.h"
 
+#include <cassert>
+#include <limits>
+#include <utility>
+
+#include "OpenALSoundProvider.h"
+
+AudioSamplePool::AudioSamplePool(bool looping, int capacity) : _looping(looping) {
+    assert(capacity > 0);
+
+    _voices.resize(capacity);
+    _freeVoices.reserve(capacity);
+    for (int i = capacity - 1; i >= 0; i--)
+        _freeVoices.push_back(i);
+    _voiceBySoundId.reserve(capacity);
+    _voiceByPid.reserve(capacity);
+}
+
 bool AudioSamplePool::playNew(PAudioSample sample, PAudioDataSource source, bool positional) {
-    update();
-    if (!sample->Open(source)) {
-        return false;
-    }
-    sample->Play(_looping, positional);
-    _samplePool.push_back(AudioSamplePoolEntry(sample, SOUND_Invalid, Pid()));
-    return true;
+    return play(std::move(sample), std::move(source), SOUND_Invalid, Pid(), positional);
 }
 
 bool AudioSamplePool::playUniqueSoundId(PAudioSample sample, PAudioDataSource source, SoundId id, bool positional) {
-    update();
-    for (AudioSamplePoolEntry &entry : _samplePool) {
-        if (entry.id == id) {
+    auto pos = _voiceBySoundId.find(id);
+    if (pos != _voiceBySoundId.end()) {
+        if (!_voices[pos->second].samplePtr->IsStopped())
             return true;
-        }
-    }
-    if (!sample->Open(source)) {
-        return false;
+        freeVoice(pos->second);
     }
-    sample->Play(_looping, positional);
-    _samplePool.push_back(AudioSamplePoolEntry(sample, id, Pid()));
-    return true;
+
+    return play(std::move(sample), std::move(source), id, Pid(), positional);
 }
 
 bool AudioSamplePool::playUniquePid(PAudioSample sample, PAudioDataSource source, Pid pid, bool positional) {
-    update();
-    for (AudioSamplePoolEntry &entry : _samplePool) {
-        if (entry.pid == pid) {
+    auto pos = _voiceByPid.find(pid.packed());
+    if (pos != _voiceByPid.end()) {
+        if (!_voices[pos->second].samplePtr->IsStopped())
             return true;
-        }
+        freeVoice(pos->second);
     }
-    if (!sample->Open(source)) {
-        return false;
-    }
-    sample->Play(_looping, positional);
-    _samplePool.push_back(AudioSamplePoolEntry(sample, SOUND_Invalid, pid));
-    return true;
+
+    return play(std::move(sample), std::move(source), SOUND_Invalid, pid, positional);
 }
 
 void AudioSamplePool::pause() {
     update();
-    for (AudioSamplePoolEntry &entry : _samplePool) {
-        entry.samplePtr->Pause();
-    }
+    for (AudioSamplePoolEntry &entry : _voices)
+        if (entry.samplePtr)
+            entry.samplePtr->Pause();
 }
 
 void AudioSamplePool::resume() {
     update();
-    for (AudioSamplePoolEntry &entry : _samplePool) {
-        entry.samplePtr->Resume();
-    }
+    for (AudioSamplePoolEntry &entry : _voices)
+        if (entry.samplePtr)
+            entry.samplePtr->Resume();
 }
 
 void AudioSamplePool::stop() {
-    for (AudioSamplePoolEntry &entry : _samplePool) {
-        entry.samplePtr->Stop();
+    for (int i = 0; i < _voices.size(); i++) {
+        if (_voices[i].samplePtr) {
+            _voices[i].samplePtr->Stop();
+            freeVoice(i);
+        }
     }
-    _samplePool.clear();
 }
 
 void AudioSamplePool::stopSoundId(SoundId soundId) {
     assert(soundId != SOUND_Invalid);
 
-    auto it = _samplePool.begin();
-    while (it != _samplePool.end()) {
-        if ((*it).id == soundId) {
-            (*it).samplePtr->Stop();
-            it = _samplePool.erase(it);
-        } else {
-            it++;
-        }
-    }
+    auto pos = _voiceBySoundId.find(soundId);
+    if (pos == _voiceBySoundId.end())
+        return;
+
+    _voices[pos->second].samplePtr->Stop();
+    freeVoice(pos->second);
 }
 
 void AudioSamplePool::stopPid(Pid pid) {
     assert(pid != Pid());
 
-    auto it = _samplePool.begin();
-    while (it != _samplePool.end()) {
-        if ((*it).pid == pid) {
-            (*it).samplePtr->Stop();
-            it = _samplePool.erase(it);
-        } else {
-            it++;
-        }
-    }
+    auto pos = _voiceByPid.find(pid.packed());
+    if (pos == _voiceByPid.end())
+        return;
+
+    _voices[pos->second].samplePtr->Stop();
+    freeVoice(pos->second);
 }
 
 void AudioSamplePool::update() {
-    auto it = _samplePool.begin();
-    std::erase_if(_samplePool, [](const AudioSamplePoolEntry& entry) { return entry.samplePtr->IsStopped(); });
+    for (int i = 0; i < _voices.size(); i++)
+        if (_voices[i].samplePtr && _voices[i].samplePtr->IsStopped())
+            freeVoice(i);
 }
 
 void AudioSamplePool::setVolume(float value) {
-    for (AudioSamplePoolEntry &entry : _samplePool) {
-        entry.samplePtr->SetVolume(value);
-    }
+    for (AudioSamplePoolEntry &entry : _voices)
+        if (entry.samplePtr)
+            entry.samplePtr->SetVolume(value);
 }
 
 bool AudioSamplePool::hasPlaying() {
-    for (AudioSamplePoolEntry &entry : _samplePool) {
-        if (!entry.samplePtr->IsStopped()) {
+    for (AudioSamplePoolEntry &entry : _voices)
+        if (entry.samplePtr && !entry.samplePtr->IsStopped())
             return true;
+    return false;
+}
+
+bool AudioSamplePool::play(PAudioSample sample, PAudioDataSource source, SoundId id, Pid pid, bool positional) {
+    if (positional && !_looping && _hasListenerPosition &&
+        (sample->GetPosition() - _listenerPosition).lengthSqr() > INAUDIBLE_SOUND_DIST * INAUDIBLE_SOUND_DIST)
+        return true; // Dropped, won't be heard anyway.
+
+    int index = allocateVoice(*sample, positional);
+    if (index == -1)
+        return true; // Dropped, all playing samples are more important.
+
+    if (!sample->Open(source)) {
+        _freeVoices.push_back(index);
+        return false;
+    }
+    sample->Play(_looping, positional);
+
+    AudioSamplePoolEntry &entry = _voices[index];
+    entry.samplePtr = std::move(sample);
+    entry.id = id;
+    entry.pid = pid;
+    entry.positional = positional;
+    if (id != SOUND_Invalid)
+        _voiceBySoundId[id] = index;
+    if (pid)
+        _voiceByPid[pid.packed()] = index;
+    return true;
+}
+
+int AudioSamplePool::allocateVoice(const IAudioSample &sample, bool positional) {
+    if (_freeVoices.empty())
+        update();
+
+    if (_freeVoices.empty()) {
+        int victim = -1;
+        float victimScore = stealScore(sample, positional);
+        for (int i = 0; i < _voices.size(); i++) {
+            float score = stealScore(*_voices[i].samplePtr, _voices[i].positional);
+            if (score > victimScore) {
+                victim = i;
+                victimScore = score;
+            }
         }
+
+        if (victim == -1)
+            return -1;
+
+        _voices[victim].samplePtr->Stop();
+        freeVoice(victim);
     }
-    return false;
+
+    int result = _freeVoices.back();
+    _freeVoices.pop_back();
+    return result;
+}
+
+void AudioSamplePool::freeVoice(int index) {
+    AudioSamplePoolEntry &entry = _voices[index];
+    assert(entry.samplePtr);
+
+    if (entry.id != SOUND_Invalid)
+        _voiceBySoundId.erase(entry.id);
+    if (entry.pid)
+        _voiceByPid.erase(entry.pid.packed());
+    entry = AudioSamplePoolEntry();
+    _freeVoices.push_back(index);
+}
+
+float AudioSamplePool::stealScore(const IAudioSample &sample, bool positional) const {
+    // Non-positional samples are never stolen by positional ones, among positional samples the farthest one goes.
+    if (!positional)
+        return -1.0f;
+    return (sample.GetPosition() - _listenerPosition).lengthSqr();
 }
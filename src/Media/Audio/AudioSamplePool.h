@@ -1,24 +1,41 @@
 #pragma once
 
-#include <list>
+#include <unordered_map>
+#include <vector>
 
 #include "Engine/Pid.h"
 
+#include "Library/Geometry/Vec.h"
+
 #include "Media/AudioSample.h"
 
 #include "SoundEnums.h"
 
 struct AudioSamplePoolEntry {
-    AudioSamplePoolEntry(PAudioSample samplePtr, SoundId id, Pid pid) : samplePtr(samplePtr), id(id), pid(pid) {}
-
     PAudioSample samplePtr;
-    SoundId id;
+    SoundId id = SOUND_Invalid;
     Pid pid;
+    bool positional = false;
 };
 
+/**
+ * Fixed-capacity pool of playing samples.
+ *
+ * Every playing sample holds an OpenAL source, and there's only a limited number of those. Pool capacities are chosen
+ * so that together they stay under the OpenAL source limit. When the pool is full, a new sample steals the voice of
+ * the least important playing sample - positional samples are less important than non-positional ones, and far away
+ * positional samples are less important than the ones that are close to the listener. If all playing samples are
+ * more important than the new one, then the new sample is just dropped.
+ *
+ * Samples started with `playUniqueSoundId` and `playUniquePid` are indexed, so that lookups by `SoundId`
+ * and `Pid` don't need to walk the pool.
+ *
+ * Non-looping positional samples that are too far away from the listener to be heard are dropped right away,
+ * without claiming a voice. Looping samples are always played as the listener might come closer.
+ */
 class AudioSamplePool {
  public:
-    explicit AudioSamplePool(bool looping):_looping(looping) {}
+    AudioSamplePool(bool looping, int capacity);
 
     bool playNew(PAudioSample sample, PAudioDataSource source, bool positional = false);
     bool playUniqueSoundId(PAudioSample sample, PAudioDataSource source, SoundId id, bool positional = false);
@@ -31,7 +48,52 @@ class AudioSamplePool {
     void update();
     void setVolume(float value);
     bool hasPlaying();
+
+    /**
+     * @return                          Number of voices that are currently taken, including the ones that have
+     *                                  stopped, but weren't freed by `update` yet.
+     */
+    [[nodiscard]] int activeVoiceCount() const {
+        return _voices.size() - _freeVoices.size();
+    }
+
+    [[nodiscard]] int capacity() const {
+        return _voices.size();
+    }
+
+    /**
+     * @param position                  Listener position, used to pick the voice to steal when the pool is full.
+     */
+    void setListenerPosition(const Vec3f &position) {
+        _listenerPosition = position;
+        _hasListenerPosition = true;
+    }
+
+    /**
+     * Calls the provided function for all playing positional samples that are tied to a `Pid`, so that their
+     * positions can be updated.
+     *
+     * @param function                  Function to call, takes a `Pid` and an `IAudioSample &`.
+     */
+    template<class Function>
+    void forEachPositionalPid(Function &&function) {
+        for (const AudioSamplePoolEntry &entry : _voices)
+            if (entry.samplePtr && entry.positional && entry.pid)
+                function(entry.pid, *entry.samplePtr);
+    }
+
+ private:
+    bool play(PAudioSample sample, PAudioDataSource source, SoundId id, Pid pid, bool positional);
+    int allocateVoice(const IAudioSample &sample, bool positional);
+    void freeVoice(int index);
+    [[nodiscard]] float stealScore(const IAudioSample &sample, bool positional) const;
+
  private:
-    std::list<AudioSamplePoolEntry> _samplePool;
+    std::vector<AudioSamplePoolEntry> _voices; // Fixed size, slots with null `samplePtr` are free.
+    std::vector<int> _freeVoices;
+    std::unordered_map<SoundId, int> _voiceBySoundId;
+    std::unordered_map<uint16_t, int> _voiceByPid; // Keyed by packed `Pid`.
+    Vec3f _listenerPosition;
+    bool _hasListenerPosition = false;
     bool _looping;
 };
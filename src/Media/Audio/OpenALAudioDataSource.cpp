@@ -70,6 +70,7 @@ bool OpenALAudioDataSource::Open() {
         }
 
         _buffers.push_back(al_buffer);
+        _bufferSize += buffer->size();
     }
 
     _baseDataSource->Close();
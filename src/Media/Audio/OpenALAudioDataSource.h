@@ -25,9 +25,18 @@ class OpenALAudioDataSource : public IAudioDataSource {
 
     bool linkSource(ALuint al_source);
 
+    /**
+     * @return                          Total size of the decoded PCM data uploaded to OpenAL buffers, in bytes. Zero
+     *                                  if this data source wasn't opened yet.
+     */
+    [[nodiscard]] size_t bufferSize() const {
+        return _bufferSize;
+    }
+
  protected:
     PAudioDataSource _baseDataSource;
     std::vector<ALuint> _buffers;
+    size_t _bufferSize = 0;
 };
 
 PAudioDataSource PlatformDataSourceInitialize(PAudioDataSource baseDataSource);
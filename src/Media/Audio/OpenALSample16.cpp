@@ -8,8 +8,6 @@
 AudioSample16::~AudioSample16() { Close(); }
 
 void AudioSample16::Close() {
-    pDataSource = nullptr;
-
     if (alIsSource(al_source) != 0) {
         alSourceStop(al_source);
         checkOpenALError();
@@ -20,6 +18,9 @@ void AudioSample16::Close() {
     }
 
     al_source = -1;
+
+    // Release the data source only after the buffers were detached, we might be holding the last reference.
+    pDataSource = nullptr;
 }
 
 void AudioSample16::defaultSource() {
@@ -58,6 +59,10 @@ bool AudioSample16::Open(PAudioDataSource data_source) {
 }
 
 bool AudioSample16::SetPosition(float x, float y, float z, float max_dist) {
+    // Position is either already submitted, or will be submitted in Play, no need to call into OpenAL.
+    if (_position == Vec3f(x, y, z) && _maxDistance == max_dist)
+        return true;
+
     _position = Vec3f(x, y, z);
     _maxDistance = max_dist;
 
@@ -22,6 +22,9 @@ class AudioSample16 : public IAudioSample {
     virtual bool Resume() override;
     virtual bool SetVolume(float volume) override;
     virtual bool SetPosition(float x, float y, float z, float max_dist) override;
+    virtual Vec3f GetPosition() const override {
+        return _position;
+    }
 
  protected:
     void Close();
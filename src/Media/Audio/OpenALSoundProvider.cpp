@@ -71,6 +71,13 @@ bool OpenALSoundProvider::Initialize() {
     ALfloat listenerOri[] = {0.f, 1.f, 0.f, 0.f, 0.f, -1.f};
     alListenerfv(AL_ORIENTATION, listenerOri);
 
+    if (alIsExtensionPresent("AL_SOFT_deferred_updates")) {
+        deferUpdates = reinterpret_cast<DeferredUpdatesFunction>(alGetProcAddress("alDeferUpdatesSOFT"));
+        processUpdates = reinterpret_cast<DeferredUpdatesFunction>(alGetProcAddress("alProcessUpdatesSOFT"));
+        if (!deferUpdates || !processUpdates)
+            deferUpdates = processUpdates = nullptr;
+    }
+
     return true;
 }
 
@@ -87,6 +94,22 @@ void OpenALSoundProvider::SetOrientation(float yaw, float pitch) {
     alListenerfv(AL_ORIENTATION, listenerOri);
 }
 
+void OpenALSoundProvider::BeginBatchUpdates() {
+    if (deferUpdates) {
+        deferUpdates();
+    } else if (context) {
+        alcSuspendContext(context);
+    }
+}
+
+void OpenALSoundProvider::EndBatchUpdates() {
+    if (processUpdates) {
+        processUpdates();
+    } else if (context) {
+        alcProcessContext(context);
+    }
+}
+
 void OpenALSoundProvider::Release() {
     alcMakeContextCurrent(nullptr);
     if (context) {
@@ -10,6 +10,10 @@ constexpr float MAX_SOUND_DIST = 60000.0f;
 constexpr float REFERENCE_DIST = 300.0f;
 constexpr float ROLLOFF_FACTOR = 1.5f;
 
+// Distance at which positional sounds are attenuated below 1/256 of their gain, and are not worth playing. Derived
+// from the inverse distance clamped model that OpenAL uses by default.
+constexpr float INAUDIBLE_SOUND_DIST = REFERENCE_DIST + (REFERENCE_DIST * 256.0f - REFERENCE_DIST) / ROLLOFF_FACTOR;
+
 class OpenALSoundProvider {
  public:
     struct TrackBuffer {
@@ -43,11 +47,24 @@ class OpenALSoundProvider {
     void SetListenerPosition(float x, float y, float z);
     void SetOrientation(float yaw, float pitch);
 
+    /**
+     * Starts a batch of source & listener updates. Until `EndBatchUpdates` is called, OpenAL doesn't apply the
+     * changes to the mixer, so that they are all applied at once instead of one property at a time.
+     *
+     * Uses `AL_SOFT_deferred_updates` if it's available, and falls back to context suspend / process otherwise.
+     */
+    void BeginBatchUpdates();
+    void EndBatchUpdates();
+
  protected:
     void DeleteBuffers(StreamingTrackBuffer *track, int type);
 
+    using DeferredUpdatesFunction = void (AL_APIENTRY *)();
+
     ALCdevice *device;
     ALCcontext *context;
+    DeferredUpdatesFunction deferUpdates = nullptr;
+    DeferredUpdatesFunction processUpdates = nullptr;
 };
 
 // TODO(pskelton): contain?
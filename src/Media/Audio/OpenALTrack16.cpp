@@ -1,13 +1,20 @@
 #include "OpenALTrack16.h"
 
+#include <atomic>
 #include <memory>
 
 #include "Media/AudioFileDataSource.h"
+#include "Media/PrefetchingAudioDataSource.h"
 
 #include "Library/Logger/Logger.h"
 
 #include "OpenALSoundProvider.h"
 
+// Streamed tracks keep a one second reserve queued in OpenAL, so this leaves some slack for slow storage.
+static constexpr float MUSIC_DECODE_AHEAD_SECONDS = 4.0f;
+
+static std::atomic<int64_t> totalUnderrunCount = 0;
+
 OpenALTrack16::OpenALTrack16() {
     al_format = AL_FORMAT_STEREO16;
     al_source = -1;
@@ -36,10 +43,10 @@ bool OpenALTrack16::Open(PAudioDataSource data_source) {
     setSourceDefaults(al_source);
     alSourcei(al_source, AL_SOURCE_RELATIVE, AL_TRUE);
 
-    al_sample_rate = pDataSource->GetSampleRate();
-
+    // Sample rate is queried on the first refill, data source might still be opening in the background.
+    al_sample_rate = 0;
     uiReservedData = 0;
-    uiReservedDataMinimum = 1000 * (al_sample_rate / 1000) * 4;
+    uiReservedDataMinimum = 0;
 
     return true;
 }
@@ -51,23 +58,35 @@ bool OpenALTrack16::Play() {
         return false;
     }
 
-    ALint status;
-    alGetSourcei(al_source, AL_SOURCE_STATE, &status);
-    if (status == AL_PLAYING) {
-        return true;
-    }
-
-    if (!Update()) {
-        Close();
-        return false;
-    }
-
-    alSourcePlay(al_source);
-    if (checkOpenALError()) {
-        return false;
-    }
+    // Initial fill & playback start happen on the update thread, so that we don't block on decoding here.
+    bUpdateFailed = false;
+    bStalled = false;
+    updater->add(this, [this] {
+        if (bUpdateFailed)
+            return OpenALUpdateThread::Clock::duration::max();
+
+        if (!Update()) {
+            logger->warning("OpenAL: Failed to refill streamed track");
+            bUpdateFailed = true;
+            return OpenALUpdateThread::Clock::duration::max();
+        }
 
-    updater.Start(10, [this]() { Update(); });
+        // This also restarts the source if it ran dry. Source that's stopped on its own is an underrun, initial &
+        // paused sources are just starting / resuming.
+        ALint status;
+        alGetSourcei(al_source, AL_SOURCE_STATE, &status);
+        if (status == AL_STOPPED && !bStalled) {
+            underrunCount.fetch_add(1, std::memory_order_relaxed);
+            totalUnderrunCount.fetch_add(1, std::memory_order_relaxed);
+            bStalled = true;
+        }
+        if (status != AL_PLAYING && uiReservedData > 0) {
+            alSourcePlay(al_source);
+            checkOpenALError();
+            bStalled = false;
+        }
+        return RefillInterval();
+    });
 
     return true;
 }
@@ -87,13 +106,14 @@ bool OpenALTrack16::Pause() {
         return false;
     }
 
+    // Stop refills first, otherwise the update thread might restart the source.
+    updater->remove(this);
+
     alSourcePause(al_source);
     if (checkOpenALError()) {
         return false;
     }
 
-    updater.Stop();
-
     return true;
 }
 
@@ -126,7 +146,7 @@ float OpenALTrack16::GetVolume() {
 }
 
 void OpenALTrack16::Close() {
-    updater.Stop();
+    updater->remove(this);
     if (pDataSource) {
         pDataSource->Close();
     }
@@ -175,9 +195,20 @@ void OpenALTrack16::DrainBuffers() {
 }
 
 bool OpenALTrack16::Update() {
+    // Don't block the update thread if the data source is still decoding, we'll get back to it shortly.
+    if (!pDataSource->HasNextBuffer())
+        return true;
+
+    if (al_sample_rate == 0) {
+        al_sample_rate = pDataSource->GetSampleRate();
+        uiReservedDataMinimum = 1000 * (al_sample_rate / 1000) * 4;
+        if (al_sample_rate == 0)
+            return false;
+    }
+
     DrainBuffers();
 
-    while (uiReservedData < uiReservedDataMinimum) {
+    while (uiReservedData < uiReservedDataMinimum && pDataSource->HasNextBuffer()) {
         std::shared_ptr<Blob> buffer = pDataSource->GetNextBuffer();
 
         if (!buffer) {
@@ -212,13 +243,34 @@ bool OpenALTrack16::Update() {
     return true;
 }
 
-PAudioTrack CreateAudioTrack(const std::string &file_path) {
+OpenALUpdateThread::Clock::duration OpenALTrack16::RefillInterval() const {
+    // Refill once about half of the reserve is played out. Data is queued as 16-bit stereo.
+    size_t bytesPerSecond = 4 * al_sample_rate;
+    if (bytesPerSecond == 0 || uiReservedData <= uiReservedDataMinimum / 2)
+        return OpenALUpdateThread::Clock::duration::zero();
+
+    double seconds = static_cast<double>(uiReservedData - uiReservedDataMinimum / 2) / bytesPerSecond;
+    return std::chrono::duration_cast<OpenALUpdateThread::Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+int64_t totalStreamUnderrunCount() {
+    return totalUnderrunCount.load(std::memory_order_relaxed);
+}
+
+PAudioTrack CreateAudioTrack(PAudioDataSource source) {
     PAudioTrack track = std::make_shared<OpenALTrack16>();
 
-    PAudioDataSource source = CreateAudioFileDataSource(file_path);
     if (!track->Open(source)) {
         track = nullptr;
     }
 
     return track;
 }
+
+PAudioTrack CreateAudioTrack(const std::string &file_path) {
+    return CreateAudioTrack(CreateMusicDataSource(file_path));
+}
+
+PAudioDataSource CreateMusicDataSource(const std::string &file_path) {
+    return CreatePrefetchingAudioDataSource(CreateAudioFileDataSource(file_path), MUSIC_DECODE_AHEAD_SECONDS);
+}
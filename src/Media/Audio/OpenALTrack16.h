@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
 
 #include <al.h> // NOLINT: not a C system header.
@@ -22,19 +25,40 @@ class OpenALTrack16 : public IAudioTrack {
     virtual bool Resume() override;
     virtual bool SetVolume(float volume) override;
     virtual float GetVolume() override;
+    virtual int GetUnderrunCount() const override {
+        return underrunCount.load(std::memory_order_relaxed);
+    }
 
  protected:
     void Close();
     void DrainBuffers();
     bool Update();
+    OpenALUpdateThread::Clock::duration RefillInterval() const;
 
     PAudioDataSource pDataSource;
-    OpenALUpdateThread updater;
+    std::shared_ptr<OpenALUpdateThread> updater = OpenALUpdateThread::shared();
     ALenum al_format;
     ALuint al_source;
     ALsizei al_sample_rate;
     size_t uiReservedData;
     size_t uiReservedDataMinimum;
+    bool bUpdateFailed = false; // Accessed from the update thread only while the track is playing.
+    bool bStalled = false; // Same as above. Set when an underrun was counted, until the source is restarted.
+    std::atomic<int> underrunCount = 0;
 };
 
+/**
+ * @return                              Total number of underruns across all streamed tracks since the program start.
+ */
+int64_t totalStreamUnderrunCount();
+
+PAudioTrack CreateAudioTrack(PAudioDataSource source);
 PAudioTrack CreateAudioTrack(const std::string &file_path);
+
+/**
+ * @param file_path                     Path to the music file.
+ * @return                              Data source that decodes the music file ahead on a worker thread & loops it.
+ *                                      Is opened asynchronously, so it can be created ahead of time to prefetch
+ *                                      a track.
+ */
+PAudioDataSource CreateMusicDataSource(const std::string &file_path);
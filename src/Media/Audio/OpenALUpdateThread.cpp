@@ -0,0 +1,93 @@
+#include "OpenALUpdateThread.h"
+
+#include <algorithm>
+#include <atomic>
+
+// Bounds for the time between refills. Lower bound protects from spinning when a source can't fill its queue, upper
+// bound makes sure we notice sources that stopped on their own reasonably fast.
+static constexpr auto MIN_REFILL_INTERVAL = std::chrono::milliseconds(5);
+static constexpr auto MAX_REFILL_INTERVAL = std::chrono::milliseconds(250);
+
+static std::atomic<OpenALUpdateThread::Clock::rep> totalUpdateTicks = 0;
+
+std::shared_ptr<OpenALUpdateThread> OpenALUpdateThread::shared() {
+    static std::mutex mutex;
+    static std::weak_ptr<OpenALUpdateThread> instance;
+
+    std::lock_guard lock(mutex);
+    std::shared_ptr<OpenALUpdateThread> result = instance.lock();
+    if (!result) {
+        result = std::make_shared<OpenALUpdateThread>();
+        instance = result;
+    }
+    return result;
+}
+
+OpenALUpdateThread::OpenALUpdateThread() {
+    _thread = std::thread([this] { threadMain(); });
+}
+
+OpenALUpdateThread::~OpenALUpdateThread() {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+}
+
+void OpenALUpdateThread::add(const void *owner, UpdateFunction func) {
+    {
+        std::lock_guard lock(_mutex);
+        auto pos = std::ranges::find(_clients, owner, &Client::owner);
+        if (pos == _clients.end())
+            pos = _clients.insert(_clients.end(), Client{.owner = owner});
+        pos->func = std::move(func);
+        pos->deadline = Clock::now();
+    }
+    _condition.notify_one();
+}
+
+void OpenALUpdateThread::remove(const void *owner) {
+    // Refill functions are called under the lock, so once we have it, nothing is running.
+    std::lock_guard lock(_mutex);
+    std::erase_if(_clients, [owner](const Client &client) { return client.owner == owner; });
+}
+
+void OpenALUpdateThread::wake(const void *owner) {
+    {
+        std::lock_guard lock(_mutex);
+        auto pos = std::ranges::find(_clients, owner, &Client::owner);
+        if (pos == _clients.end())
+            return;
+        pos->deadline = Clock::now();
+    }
+    _condition.notify_one();
+}
+
+OpenALUpdateThread::Clock::duration OpenALUpdateThread::totalUpdateTime() {
+    return Clock::duration(totalUpdateTicks.load(std::memory_order_relaxed));
+}
+
+void OpenALUpdateThread::threadMain() {
+    std::unique_lock lock(_mutex);
+    while (!_stopping) {
+        Clock::time_point now = Clock::now();
+        Clock::time_point nextDeadline = Clock::time_point::max();
+        for (Client &client : _clients) {
+            if (client.deadline <= now) {
+                Clock::duration interval = std::clamp<Clock::duration>(client.func(), MIN_REFILL_INTERVAL,
+                                                                       MAX_REFILL_INTERVAL);
+                client.deadline = now + interval;
+            }
+            nextDeadline = std::min(nextDeadline, client.deadline);
+        }
+        totalUpdateTicks.fetch_add((Clock::now() - now).count(), std::memory_order_relaxed);
+
+        if (nextDeadline == Clock::time_point::max()) {
+            _condition.wait(lock);
+        } else {
+            _condition.wait_until(lock, nextDeadline);
+        }
+    }
+}
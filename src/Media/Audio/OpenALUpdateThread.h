@@ -1,45 +1,83 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
+/**
+ * Refill thread for streamed OpenAL sources.
+ *
+ * Instead of polling at a fixed rate, each registered source reports how long its queued audio is going to last, and
+ * the thread sleeps until the earliest of the resulting deadlines. Sources can also request an immediate refill
+ * with `wake`, e.g. when playback is resumed or new stream data becomes available. All sources that are due are
+ * refilled in a single pass.
+ */
 class OpenALUpdateThread {
  public:
-    OpenALUpdateThread() : bRunning(false) {}
-
-    virtual ~OpenALUpdateThread() {
-        if (bRunning.load(std::memory_order_acquire)) {
-            Stop();
-        }
-    }
-
-    void Start(int interval, std::function<void(void)> func) {
-        if (bRunning.load(std::memory_order_acquire)) {
-            Stop();
-        }
-        bRunning.store(true, std::memory_order_release);
-        theThread = std::thread([this, interval, func]() {
-            while (bRunning.load(std::memory_order_acquire)) {
-                func();
-                std::this_thread::sleep_for(
-                    std::chrono::milliseconds(interval));
-            }
-        });
-    }
-
-    void Stop() {
-        bRunning.store(false, std::memory_order_release);
-        if (theThread.joinable()) {
-            theThread.join();
-        }
-    }
-
-    bool IsRunning() const noexcept {
-        return (bRunning.load(std::memory_order_acquire) &&
-                theThread.joinable());
-    }
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Refill function. Returns the time until the next refill is needed. Is called on the update thread, and must not
+     * call back into `OpenALUpdateThread`.
+     */
+    using UpdateFunction = std::function<Clock::duration()>;
+
+    /**
+     * @return                          Update thread shared between all streamed sources. The thread is stopped
+     *                                  once the last reference to it is released.
+     */
+    static std::shared_ptr<OpenALUpdateThread> shared();
+
+    OpenALUpdateThread();
+    ~OpenALUpdateThread();
+
+    /**
+     * Registers a source & schedules an immediate refill for it. If the source is already registered, its update
+     * function is replaced.
+     *
+     * @param owner                     Key to identify the source by.
+     * @param func                      Refill function.
+     */
+    void add(const void *owner, UpdateFunction func);
+
+    /**
+     * Unregisters a source. After this function returns, the source's refill function is not running and won't be
+     * called again.
+     *
+     * @param owner                     Key that was passed to `add`. Unknown keys are ignored.
+     */
+    void remove(const void *owner);
+
+    /**
+     * Schedules an immediate refill for the given source.
+     *
+     * @param owner                     Key that was passed to `add`. Unknown keys are ignored.
+     */
+    void wake(const void *owner);
+
+    /**
+     * @return                          Total time spent in refill functions across all update threads since the
+     *                                  program start.
+     */
+    [[nodiscard]] static Clock::duration totalUpdateTime();
+
+ private:
+    struct Client {
+        const void *owner = nullptr;
+        UpdateFunction func;
+        Clock::time_point deadline;
+    };
+
+    void threadMain();
 
  private:
-    std::atomic<bool> bRunning;
-    std::thread theThread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<Client> _clients;
+    bool _stopping = false;
+    std::thread _thread;
 };
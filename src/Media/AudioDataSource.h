@@ -16,5 +16,11 @@ class IAudioDataSource {
     virtual size_t GetChannelCount() = 0;
     virtual std::shared_ptr<Blob> GetNextBuffer() = 0;
     virtual float GetDuration() = 0;
+
+    /**
+     * @return                          Whether a call to `GetNextBuffer` would return right away. Data sources that
+     *                                  decode in the background return false while they are waiting on the decoder.
+     */
+    virtual bool HasNextBuffer() { return true; }
 };
 typedef std::shared_ptr<IAudioDataSource> PAudioDataSource;
@@ -2,6 +2,8 @@
 
 #include <memory>
 
+#include "Library/Geometry/Vec.h"
+
 #include "AudioDataSource.h"
 
 class IAudioSample {
@@ -19,5 +21,6 @@ class IAudioSample {
     virtual bool Resume() = 0;
     virtual bool SetVolume(float volume) = 0;
     virtual bool SetPosition(float x, float y, float z, float max_dist) = 0;
+    virtual Vec3f GetPosition() const = 0;
 };
 typedef std::shared_ptr<IAudioSample> PAudioSample;
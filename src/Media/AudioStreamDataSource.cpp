@@ -0,0 +1,91 @@
+#include "AudioStreamDataSource.h"
+
+#include <utility>
+
+extern "C" {
+#include <libavformat/avformat.h> // NOLINT: not a C system header.
+}
+
+#include "Library/Logger/Logger.h"
+
+#include "Utility/Exception.h"
+
+static constexpr int AVIO_BUFFER_SIZE = 4096;
+
+AudioStreamDataSource::AudioStreamDataSource(std::unique_ptr<InputStream> stream) : stream(std::move(stream)) {}
+
+AudioStreamDataSource::~AudioStreamDataSource() {
+    Close();
+}
+
+bool AudioStreamDataSource::Open() {
+    if (bOpened) {
+        return true;
+    }
+
+    if (!stream) {
+        return false; // Stream is consumed on first open, can't reopen.
+    }
+
+    pFormatContext = avformat_alloc_context();
+    if (pFormatContext == nullptr) {
+        return false;
+    }
+
+    uint8_t *avio_ctx_buffer = static_cast<uint8_t *>(av_malloc(AVIO_BUFFER_SIZE));
+    if (avio_ctx_buffer == nullptr) {
+        Close();
+        return false;
+    }
+
+    // No seek callback, ffmpeg will treat the input as non-seekable.
+    avio_ctx = avio_alloc_context(avio_ctx_buffer, AVIO_BUFFER_SIZE, 0, this, &read_packet, nullptr, nullptr);
+    if (!avio_ctx) {
+        av_free(avio_ctx_buffer);
+        Close();
+        return false;
+    }
+
+    pFormatContext->pb = avio_ctx;
+
+    if (avformat_open_input(&pFormatContext, nullptr, nullptr, nullptr) < 0) {
+        logger->warning("ffmpeg: Unable to open input stream");
+        Close();
+        return false;
+    }
+
+    av_dump_format(pFormatContext, 0, nullptr, 0);
+
+    return AudioBaseDataSource::Open();
+}
+
+void AudioStreamDataSource::Close() {
+    AudioBaseDataSource::Close();
+
+    if (avio_ctx) {
+        // FFmpeg might have reallocated the buffer, so we're freeing the one that's in the context.
+        av_freep(&avio_ctx->buffer);
+        avio_context_free(&avio_ctx);
+    }
+    stream.reset();
+}
+
+int AudioStreamDataSource::read_packet(void *opaque, uint8_t *buf, int buf_size) {
+    return static_cast<AudioStreamDataSource *>(opaque)->ReadPacket(buf, buf_size);
+}
+
+int AudioStreamDataSource::ReadPacket(uint8_t *buf, int buf_size) {
+    size_t size = 0;
+    try {
+        size = stream->read(buf, buf_size);
+    } catch (const Exception &e) {
+        logger->warning("Failed to read audio stream: {}", e.what());
+        return AVERROR(EIO);
+    }
+
+    return size == 0 ? AVERROR_EOF : static_cast<int>(size);
+}
+
+PAudioDataSource CreateAudioStreamDataSource(std::unique_ptr<InputStream> stream) {
+    return std::make_shared<AudioStreamDataSource>(std::move(stream));
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "Utility/Streams/InputStream.h"
+
+#include "AudioBaseDataSource.h"
+
+struct AVIOContext;
+
+/**
+ * Audio data source that reads the encoded audio from an `InputStream`, e.g. from a `ZlibInputStream`.
+ *
+ * The stream is read sequentially as ffmpeg gets to the data, and is never seeked, so the encoded audio doesn't need
+ * to be fully in memory.
+ */
+class AudioStreamDataSource : public AudioBaseDataSource {
+ public:
+    explicit AudioStreamDataSource(std::unique_ptr<InputStream> stream);
+    virtual ~AudioStreamDataSource();
+
+    virtual bool Open() override;
+    virtual void Close() override;
+
+ protected:
+    static int read_packet(void *opaque, uint8_t *buf, int buf_size);
+    int ReadPacket(uint8_t *buf, int buf_size);
+
+ protected:
+    std::unique_ptr<InputStream> stream;
+    AVIOContext *avio_ctx = nullptr;
+};
+
+PAudioDataSource CreateAudioStreamDataSource(std::unique_ptr<InputStream> stream);
@@ -18,6 +18,11 @@ class IAudioTrack {
     virtual bool Resume() = 0;
     virtual bool SetVolume(float volume) = 0;
     virtual float GetVolume() = 0;
+
+    /**
+     * @return                          Number of times the track ran out of queued audio while playing.
+     */
+    virtual int GetUnderrunCount() const = 0;
 };
 typedef std::shared_ptr<IAudioTrack> PAudioTrack;
 
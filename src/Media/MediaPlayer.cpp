@@ -4,6 +4,7 @@ extern "C" {
     #include <libavcodec/avcodec.h>
     #include <libavformat/avformat.h>
     #include <libavutil/avutil.h>
+    #include <libavutil/hwcontext.h>
     #include <libavutil/imgutils.h>
     #include <libavutil/mem.h>
     #include <libavutil/opt.h>
@@ -14,9 +15,11 @@ extern "C" {
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <vector>
 #include <thread>
@@ -73,7 +76,7 @@ class AVStreamWrapper {
         dec = nullptr;
         if (dec_ctx != nullptr) {
             // Close the codec
-            avcodec_close(dec_ctx);
+            avcodec_free_context(&dec_ctx);
             logger->trace("ffmpeg: close decoder context file");
             dec_ctx = nullptr;
         }
@@ -81,6 +84,11 @@ class AVStreamWrapper {
 
     virtual bool open(AVFormatContext *format_ctx) = 0;
 
+    /**
+     * Called right before the decoder is opened, can be used to set up additional decoder options.
+     */
+    virtual void configure() {}
+
     virtual bool open(AVFormatContext *format_ctx, AVMediaType type_) {
         stream_idx = av_find_best_stream(format_ctx, type_, -1, -1, &dec, 0);
         if (stream_idx < 0) {
@@ -100,6 +108,7 @@ class AVStreamWrapper {
             close();
             return false;
         }
+        configure();
         if (avcodec_open2(dec_ctx, dec, nullptr) < 0) {
             close();
             return false;
@@ -189,6 +198,28 @@ class AVAudioStream : public AVStreamWrapper {
 
 class AVVideoStream : public AVStreamWrapper {
  public:
+    virtual ~AVVideoStream() {
+        close();
+    }
+
+    virtual void close() override {
+        if (converter) {
+            sws_freeContext(converter);
+            converter = nullptr;
+        }
+        hw_pix_fmt = AV_PIX_FMT_NONE;
+        AVStreamWrapper::close();
+    }
+
+    virtual void configure() override {
+        // Let ffmpeg pick the number of decoding threads.
+        dec_ctx->thread_count = 0;
+        dec_ctx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+        if (engine->config->graphics.HardwareVideoDecoding.value())
+            configureHardwareDecoding();
+    }
+
     virtual bool open(AVFormatContext *format_ctx) override {
         if (!AVStreamWrapper::open(format_ctx, AVMEDIA_TYPE_VIDEO)) {
             return false;
@@ -200,16 +231,13 @@ class AVVideoStream : public AVStreamWrapper {
         frame_len = av_q2d(stream->time_base) * 1000.;
         frames_per_second = 1. / av_q2d(stream->time_base);
 
-        converter = sws_getContext(
-            dec_ctx->width, dec_ctx->height, dec_ctx->pix_fmt, width, height,
-            AV_PIX_FMT_BGR32, SWS_BICUBIC, nullptr, nullptr, nullptr);
-
         return true;
     }
 
     std::shared_ptr<Blob> decode_frame(AVPacket *avpacket) {
         std::shared_ptr<Blob> result;
         AVFrame *frame = av_frame_alloc();
+        AVFrame *sw_frame = nullptr;
 
         if (!queue.empty()) {
             result = queue.front();
@@ -225,17 +253,40 @@ class AVVideoStream : public AVStreamWrapper {
                 }
                 if (res < 0) {
                     av_frame_free(&frame);
+                    av_frame_free(&sw_frame);
                     return result;
                 }
+
+                // Hardware decoded frames live in video memory, we need to download them first.
+                AVFrame *src_frame = frame;
+                if (hw_pix_fmt != AV_PIX_FMT_NONE && frame->format == hw_pix_fmt) {
+                    if (!sw_frame)
+                        sw_frame = av_frame_alloc();
+                    if (av_hwframe_transfer_data(sw_frame, frame, 0) < 0) {
+                        logger->warning("ffmpeg: failed to transfer hardware decoded frame");
+                        continue;
+                    }
+                    src_frame = sw_frame;
+                }
+
+                // Source pixel format is only known for sure once we have a frame, e.g. for hardware decoding.
+                converter = sws_getCachedContext(converter, src_frame->width, src_frame->height,
+                                                 static_cast<AVPixelFormat>(src_frame->format), width, height,
+                                                 AV_PIX_FMT_BGR32, SWS_BICUBIC, nullptr, nullptr, nullptr);
+                if (!converter) {
+                    logger->warning("ffmpeg: failed to create video frame converter");
+                    continue;
+                }
+
                 int linesizes[4] = { 0, 0, 0, 0 };
                 if (av_image_fill_linesizes(linesizes, AV_PIX_FMT_RGB32, width) < 0) {
                     assert(false);
                 }
-                size_t tmp_size = frame->height * linesizes[0] * 2;
+                size_t tmp_size = height * linesizes[0];
                 std::unique_ptr<void, FreeDeleter> tmp_buf(malloc(tmp_size));
                 uint8_t *data[4] = { static_cast<uint8_t *>(tmp_buf.get()), nullptr, nullptr, nullptr };
 
-                if (sws_scale(converter, frame->data, frame->linesize, 0, frame->height, data, linesizes) < 0) {
+                if (sws_scale(converter, src_frame->data, src_frame->linesize, 0, src_frame->height, data, linesizes) < 0) {
                     assert(false);
                 }
 
@@ -250,6 +301,7 @@ class AVVideoStream : public AVStreamWrapper {
         }
 
         av_frame_free(&frame);
+        av_frame_free(&sw_frame);
 
         last_frame = result;
 
@@ -260,8 +312,42 @@ class AVVideoStream : public AVStreamWrapper {
     double frames_per_second = 0;
     double frame_len = 0;
     SwsContext *converter = nullptr;
+    AVPixelFormat hw_pix_fmt = AV_PIX_FMT_NONE;
     int width = 0;
     int height = 0;
+
+ private:
+    void configureHardwareDecoding() {
+        for (int i = 0;; i++) {
+            const AVCodecHWConfig *config = avcodec_get_hw_config(dec, i);
+            if (!config)
+                break;
+            if (!(config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX))
+                continue;
+
+            AVBufferRef *device_ctx = nullptr;
+            if (av_hwdevice_ctx_create(&device_ctx, config->device_type, nullptr, nullptr, 0) < 0)
+                continue;
+
+            dec_ctx->hw_device_ctx = device_ctx; // Decoder context takes ownership.
+            dec_ctx->opaque = this;
+            dec_ctx->get_format = &AVVideoStream::getFormat;
+            hw_pix_fmt = config->pix_fmt;
+            logger->info("ffmpeg: using {} hardware decoding for {}", av_hwdevice_get_type_name(config->device_type), dec->name);
+            return;
+        }
+    }
+
+    static AVPixelFormat getFormat(AVCodecContext *ctx, const AVPixelFormat *formats) {
+        AVVideoStream *self = static_cast<AVVideoStream *>(ctx->opaque);
+        for (const AVPixelFormat *format = formats; *format != AV_PIX_FMT_NONE; format++)
+            if (*format == self->hw_pix_fmt)
+                return *format;
+
+        // Hardware format not offered, e.g. because of an unsupported profile. Fall back to software decoding.
+        self->hw_pix_fmt = AV_PIX_FMT_NONE;
+        return avcodec_default_get_format(ctx, formats);
+    }
 };
 
 static Recti calculateVideoRectangle(const PMovie &pMovie_Track) {
@@ -328,13 +414,11 @@ class Movie : public IMovie {
             format_ctx = nullptr;
         }
         if (avioContext) {
-            av_free(avioContext);
-            avioContext = nullptr;
-        }
-        if (ioBuffer) {
-            // av_free(ioBuffer);
-            ioBuffer = nullptr;
+            // FFmpeg might have reallocated the buffer, so we're freeing the one that's in the context.
+            av_freep(&avioContext->buffer);
+            avio_context_free(&avioContext);
         }
+        ioBuffer = nullptr;
     }
 
     bool Load(const char *filename) {  // Загрузка
@@ -373,16 +457,24 @@ class Movie : public IMovie {
         return true;
     }
 
+    /**
+     * Opens a movie that's stored in memory. FFmpeg reads the data through a custom AVIO context straight from the
+     * provided blob, so if it's a region of a memory-mapped VID file, no copies are made and pages are read in lazily
+     * as the demuxer gets to them.
+     *
+     * @param blob                      Movie data. A shared copy is stored in this object.
+     * @return                          Whether the movie was successfully opened.
+     */
     bool LoadFromLOD(const Blob &blob) {
         _blob = Blob::share(blob);
         _stream.reset(_blob.data(), _blob.size());
 
         if (!ioBuffer) {
-            ioBuffer = (unsigned char *)av_malloc(AV_INPUT_BUFFER_MIN_SIZE);  // can get av_free()ed by libav
+            ioBuffer = static_cast<unsigned char *>(av_malloc(IO_BUFFER_SIZE));
         }
 
         if (!avioContext) {
-            avioContext = avio_alloc_context(ioBuffer, 0x4000, 0, this, s_read, NULL, s_seek);
+            avioContext = avio_alloc_context(ioBuffer, IO_BUFFER_SIZE, 0, this, s_read, NULL, s_seek);
         }
         if (!format_ctx) {
             format_ctx = avformat_alloc_context();
@@ -409,18 +501,10 @@ class Movie : public IMovie {
         last_resampled_frame_num++;
         if (last_resampled_frame_num == video.stream->duration) {
             if (looping) {
-                video.reset();
-                audio.reset();
-                int err = av_seek_frame(format_ctx, -1, 0,
-                                        AVSEEK_FLAG_BACKWARD | AVSEEK_FLAG_ANY);
-                char err_buf[2048];
-                av_strerror(err, err_buf, 2048);
-                if (err < 0) {
+                if (!Rewind()) {
                     Close();
                     return nullptr;
                 }
-                last_resampled_frame_num = 0;
-                playback_time = 0;
                 desired_frame_number = 0;
             } else {
                 playing = false;
@@ -431,9 +515,14 @@ class Movie : public IMovie {
         AVPacket *avpacket = av_packet_alloc();
 
         // keep reading packets until we hit the end or find a video packet
-        do {
+        for (;;) {
             if (av_read_frame(format_ctx, avpacket) < 0) {
-                // probably movie is finished
+                // Probably movie is finished. Stream duration can be off, so we also loop from here.
+                if (looping && last_resampled_frame_num > 0 && Rewind()) {
+                    desired_frame_number = 0;
+                    continue; // Avpacket is empty at this point, so we just go read the next one.
+                }
+
                 playing = false;
                 av_packet_free(&avpacket);
                 return nullptr;
@@ -449,14 +538,15 @@ class Movie : public IMovie {
                                        buffer->data());
                 }
             } else if (avpacket->stream_index == video.stream_idx) {
-              // Decode video frame
-              // video packet - decode & maybe show
-              video.decode_frame(avpacket);
+                // Decode video frame
+                // video packet - decode & maybe show
+                video.decode_frame(avpacket);
+                if (avpacket->pts > desired_frame_number)
+                    break;
             } else {
                 assert(false);  // unknown stream
             }
-        } while (avpacket->stream_index != video.stream_idx ||
-                 avpacket->pts <= desired_frame_number);
+        }
 
         av_packet_free(&avpacket);
 
@@ -585,6 +675,25 @@ class Movie : public IMovie {
     virtual bool IsPlaying() const override { return playing; }
 
  protected:
+    static constexpr int IO_BUFFER_SIZE = 0x4000;
+
+    /**
+     * Seeks back to the start of the movie, reusing the opened demuxer & decoders.
+     *
+     * @return                          Whether the seek was successful.
+     */
+    bool Rewind() {
+        video.reset();
+        audio.reset();
+        if (av_seek_frame(format_ctx, -1, 0, AVSEEK_FLAG_BACKWARD | AVSEEK_FLAG_ANY) < 0) {
+            logger->warning("ffmpeg: Unable to rewind the movie");
+            return false;
+        }
+        last_resampled_frame_num = 0;
+        playback_time = 0;
+        return true;
+    }
+
     static int s_read(void *opaque, uint8_t *buf, int buf_size) {
         return static_cast<Movie *>(opaque)->read(buf, buf_size);
     }
@@ -594,30 +703,37 @@ class Movie : public IMovie {
     }
 
     int read(uint8_t *buf, int buf_size) {
-        return _stream.read(buf, buf_size);
+        int result = _stream.read(buf, buf_size);
+        return result == 0 ? AVERROR_EOF : result;
     }
 
     int64_t seek(int64_t offset, int whence) {
+        whence &= ~AVSEEK_FORCE; // We're in memory, seeks are always cheap.
+
         if (whence == AVSEEK_SIZE) {
             return _blob.size();
         }
 
+        int64_t position = 0;
         switch (whence) {
             case SEEK_SET:
-                _stream.seek(offset);
+                position = offset;
                 break;
             case SEEK_CUR:
-                _stream.seek(_stream.position() + offset);
+                position = _stream.position() + offset;
                 break;
             case SEEK_END:
-                _stream.seek(_blob.size() - offset);
+                position = _blob.size() + offset;
                 break;
             default:
-                assert(false);
-                break;
+                return AVERROR(EINVAL);
         }
 
-        return _stream.position();
+        if (position < 0 || position > static_cast<int64_t>(_blob.size()))
+            return AVERROR(EINVAL);
+
+        _stream.seek(position);
+        return position;
     }
 
  protected:
@@ -642,6 +758,189 @@ class Movie : public IMovie {
     MemoryInputStream _stream;
 };
 
+/**
+ * Movie that decodes on a separate thread, used for house movies.
+ *
+ * House movies are drawn as a part of the house UI, and decoding them synchronously in `GetFrame` was causing frame
+ * drops on expensive keyframes. Here the decoder thread keeps a small queue of ready frames along with their
+ * presentation timestamps, and `GetFrame` just picks the latest frame that's due, reusing the current one if no new
+ * frame is due yet. Audio is decoded on the same thread, but is handed over to OpenAL from the calling thread.
+ */
+class HouseMovie : public Movie {
+ public:
+    virtual ~HouseMovie() {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_all();
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    /**
+     * Starts the decoder thread and waits for the first frame, so that it can be shown right away once the movie
+     * starts playing.
+     *
+     * @return                          Whether the first frame was decoded successfully.
+     */
+    bool Preroll() {
+        startDecoding();
+
+        std::unique_lock lock(_mutex);
+        _condition.wait(lock, [&] { return !_frames.empty() || _decodingFinished; });
+        return !_frames.empty();
+    }
+
+    virtual bool Play(bool loop = false) override {
+        {
+            std::lock_guard lock(_mutex);
+            _looping = loop;
+        }
+        startDecoding();
+
+        // Continue from the last presented frame if we were stopped.
+        _playStartTime = std::chrono::steady_clock::now() -
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double, std::milli>(_currentFrameTimeMs));
+        playing = true;
+        return false;
+    }
+
+    virtual std::shared_ptr<Blob> GetFrame() override {
+        if (!playing) {
+            return nullptr;
+        }
+
+        double playbackTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                                          _playStartTime).count();
+
+        std::deque<std::shared_ptr<Blob>> audioBuffers;
+        bool notify = false;
+        bool finished = false;
+        {
+            std::lock_guard lock(_mutex);
+            audioBuffers.swap(_audioBuffers);
+
+            // Skip over all the frames that are due, presenting the latest one.
+            while (!_frames.empty() && _frames.front().timeMs <= playbackTimeMs) {
+                _currentFrame = std::move(_frames.front().data);
+                _currentFrameTimeMs = _frames.front().timeMs;
+                _frames.pop_front();
+                notify = true;
+            }
+
+            finished = _decodingFinished && _frames.empty();
+        }
+        if (notify)
+            _condition.notify_all();
+
+        for (const std::shared_ptr<Blob> &buffer : audioBuffers)
+            provider->Stream16(audio_data_in_device, buffer->size() / 2, buffer->data());
+
+        if (finished) {
+            playing = false;
+            return nullptr;
+        }
+
+        return _currentFrame;
+    }
+
+ private:
+    struct Frame {
+        std::shared_ptr<Blob> data;
+        double timeMs = 0;
+    };
+
+    static constexpr size_t MAX_QUEUED_FRAMES = 4;
+
+    void startDecoding() {
+        if (!_thread.joinable())
+            _thread = std::thread(&HouseMovie::decodeThreadMain, this);
+    }
+
+    void decodeThreadMain() {
+        AVPacket *avpacket = av_packet_alloc();
+        int64_t frameIndex = 0;
+        int64_t framesInLoop = 0;
+
+        while (true) {
+            {
+                std::unique_lock lock(_mutex);
+                _condition.wait(lock, [&] { return _stopping || _frames.size() < MAX_QUEUED_FRAMES; });
+                if (_stopping)
+                    break;
+            }
+
+            if (av_read_frame(format_ctx, avpacket) < 0) {
+                // End of the movie. Stream duration can be off, so we're not relying on it.
+                bool looping;
+                {
+                    std::lock_guard lock(_mutex);
+                    looping = _looping;
+                }
+                if (looping && framesInLoop > 0 && Rewind()) {
+                    framesInLoop = 0;
+                    continue;
+                }
+                break;
+            }
+
+            if (avpacket->stream_index == audio.stream_idx) {
+                std::shared_ptr<Blob> buffer = audio.decode_frame(avpacket);
+                if (buffer) {
+                    std::lock_guard lock(_mutex);
+                    _audioBuffers.push_back(std::move(buffer));
+                }
+            } else if (avpacket->stream_index == video.stream_idx) {
+                std::shared_ptr<Blob> buffer = video.decode_frame(avpacket);
+                if (buffer) {
+                    std::lock_guard lock(_mutex);
+                    _frames.push_back({std::move(buffer), frameIndex * video.frame_len});
+                    frameIndex++;
+                    framesInLoop++;
+                    _condition.notify_all();
+                }
+            }
+            av_packet_unref(avpacket);
+        }
+
+        av_packet_free(&avpacket);
+
+        {
+            std::lock_guard lock(_mutex);
+            _decodingFinished = true;
+        }
+        _condition.notify_all();
+    }
+
+ private:
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<Frame> _frames; // Guarded by _mutex.
+    std::deque<std::shared_ptr<Blob>> _audioBuffers; // Guarded by _mutex.
+    bool _looping = false; // Guarded by _mutex.
+    bool _stopping = false; // Guarded by _mutex.
+    bool _decodingFinished = false; // Guarded by _mutex.
+
+    std::shared_ptr<Blob> _currentFrame;
+    double _currentFrameTimeMs = 0;
+    std::chrono::steady_clock::time_point _playStartTime;
+};
+
+/**
+ * @param blob                          House movie data.
+ * @return                              Opened house movie with the first frame already decoded, or `nullptr` if the
+ *                                      movie couldn't be opened.
+ */
+static std::shared_ptr<HouseMovie> openHouseMovie(const Blob &blob) {
+    std::shared_ptr<HouseMovie> result = std::make_shared<HouseMovie>();
+    if (!result->LoadFromLOD(blob) || !result->Preroll())
+        return nullptr;
+    return result;
+}
+
 void MPlayer::Initialize() {
     might_list.open(makeDataPath("anims", "might7.vid"));
     magic_list.open(makeDataPath("anims", "magic7.vid"));
@@ -660,10 +959,9 @@ void MPlayer::OpenHouseMovie(const std::string &pMovieName, bool bLoop) {
         return;
     }
 
-    std::shared_ptr<Movie> pMovie = std::make_shared<Movie>();
-    pMovie->LoadFromLOD(blob);
-    pMovie_Track = std::dynamic_pointer_cast<IMovie>(pMovie);
+    pMovie_Track = openHouseMovie(blob);
     sInHouseMovie = pMovieName;
+    bLoopInHouseMovie = bLoop;
 }
 
 void MPlayer::HouseMovieLoop() {
@@ -672,12 +970,13 @@ void MPlayer::HouseMovieLoop() {
     }
 
     if (!pMovie_Track->IsPlaying()) {
-        pMovie_Track->Play(false);
+        pMovie_Track->Play(bLoopInHouseMovie); // Looping movies rewind in place, without re-opening.
     }
 
     render->BeginScene2D();
 
     static GraphicsImage *tex;
+    static std::shared_ptr<Blob> uploadedFrame; // Holding a reference so that a new frame can't reuse the address.
     if (!tex) {
         tex = GraphicsImage::Create(pMovie_Track->GetWidth(), pMovie_Track->GetHeight());
     }
@@ -691,24 +990,25 @@ void MPlayer::HouseMovieLoop() {
         rect.w = wsize.w - render->config->graphics.HouseMovieX2.value();
         rect.h = wsize.h - render->config->graphics.HouseMovieY2.value();
 
-        // update pixels from buffer
-        tex->rgba() = RgbaImage::copy(tex->width(), tex->height(), static_cast<const Color *>(buffer->data()));
-
-        // update texture
-        render->Update_Texture(tex);
+        // GetFrame returns the same frame until it's time to show the next one, and we're called every game frame.
+        if (buffer != uploadedFrame) {
+            tex->rgba() = RgbaImage::copy(tex->width(), tex->height(), static_cast<const Color *>(buffer->data()));
+            render->Update_Texture(tex);
+            uploadedFrame = buffer;
+        }
         render->DrawImage(tex, rect);
 
     } else {
+        // Movie has finished, or failed to rewind. Re-open it from scratch.
         pMovie_Track = nullptr;
         Blob blob = LoadMovie(sInHouseMovie);
-        if (blob) {
-            std::shared_ptr<Movie> pMovie = std::make_shared<Movie>();
-            pMovie->LoadFromLOD(blob);
-            pMovie_Track = std::dynamic_pointer_cast<IMovie>(pMovie);
-            pMovie_Track->Play();
+        if (blob)
+            pMovie_Track = openHouseMovie(blob);
+        if (pMovie_Track) {
+            pMovie_Track->Play(bLoopInHouseMovie);
+            // callback to prevent skipped frame draw
+            HouseMovieLoop();
         }
-        // callback to prevent skipped frame draw
-        HouseMovieLoop();
     }
 }
 
@@ -741,6 +1041,7 @@ void MPlayer::PlayFullscreenMovie(const std::string &pFilename) {
 
     // create texture
     GraphicsImage *tex = GraphicsImage::Create(pMovie_Track->GetWidth(), pMovie_Track->GetHeight());
+    std::shared_ptr<Blob> uploadedFrame;
 
     if (pMovie->GetFormat() == "bink") {
         logger->trace("bink file");
@@ -759,11 +1060,12 @@ void MPlayer::PlayFullscreenMovie(const std::string &pFilename) {
                 break;
             }
 
-            // update pixels from buffer
-            tex->rgba() = RgbaImage::copy(tex->width(), tex->height(), static_cast<const Color *>(buffer->data()));
-
-            // update texture
-            render->Update_Texture(tex);
+            // This loop runs a lot faster than the movie frame rate, only upload new frames.
+            if (buffer != uploadedFrame) {
+                tex->rgba() = RgbaImage::copy(tex->width(), tex->height(), static_cast<const Color *>(buffer->data()));
+                render->Update_Texture(tex);
+                uploadedFrame = buffer;
+            }
             render->DrawImage(tex, calculateVideoRectangle(pMovie_Track));
 
             render->Present();
@@ -39,7 +39,13 @@ class MPlayer {
     VidReader might_list;
     VidReader magic_list;
     std::string sInHouseMovie;
+    bool bLoopInHouseMovie = true;
 
+    /**
+     * @param video_name                Name of the movie, without extension.
+     * @return                          Movie data as a region of the memory-mapped VID file, or an empty blob if
+     *                                  the movie wasn't found. No data is actually read until the movie is played.
+     */
     Blob LoadMovie(const std::string &video_name);
 };
 
@@ -0,0 +1,136 @@
+#include "PrefetchingAudioDataSource.h"
+
+#include <utility>
+
+#include "Library/Logger/Logger.h"
+
+PrefetchingAudioDataSource::PrefetchingAudioDataSource(PAudioDataSource baseDataSource, float aheadSeconds)
+    : _baseDataSource(std::move(baseDataSource)), _aheadSeconds(aheadSeconds) {}
+
+PrefetchingAudioDataSource::~PrefetchingAudioDataSource() {
+    Close();
+}
+
+bool PrefetchingAudioDataSource::Open() {
+    if (_worker.joinable())
+        return true;
+
+    _stopping = false;
+    _finished = false;
+    _opened = false;
+    _worker = std::thread([this] { workerMain(); });
+    return true;
+}
+
+void PrefetchingAudioDataSource::Close() {
+    if (!_worker.joinable())
+        return;
+
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+    _worker.join();
+
+    _buffers.clear();
+    _bufferedSize = 0;
+}
+
+size_t PrefetchingAudioDataSource::GetSampleRate() {
+    waitOpened();
+    return _sampleRate;
+}
+
+size_t PrefetchingAudioDataSource::GetChannelCount() {
+    waitOpened();
+    return _channelCount;
+}
+
+float PrefetchingAudioDataSource::GetDuration() {
+    waitOpened();
+    return _duration;
+}
+
+std::shared_ptr<Blob> PrefetchingAudioDataSource::GetNextBuffer() {
+    std::unique_lock lock(_mutex);
+    _condition.wait(lock, [this] { return !_buffers.empty() || _finished; });
+    if (_buffers.empty())
+        return nullptr;
+
+    std::shared_ptr<Blob> result = std::move(_buffers.front());
+    _buffers.pop_front();
+    _bufferedSize -= result->size();
+    lock.unlock();
+
+    _condition.notify_all();
+    return result;
+}
+
+bool PrefetchingAudioDataSource::HasNextBuffer() {
+    std::lock_guard lock(_mutex);
+    return !_buffers.empty() || _finished;
+}
+
+void PrefetchingAudioDataSource::waitOpened() {
+    std::unique_lock lock(_mutex);
+    _condition.wait(lock, [this] { return _opened || _finished; });
+}
+
+void PrefetchingAudioDataSource::workerMain() {
+    // Base data source is only accessed from this thread while the worker is running.
+    bool opened = _baseDataSource->Open();
+    {
+        std::lock_guard lock(_mutex);
+        if (opened) {
+            _sampleRate = _baseDataSource->GetSampleRate();
+            _channelCount = _baseDataSource->GetChannelCount();
+            _duration = _baseDataSource->GetDuration();
+            _capacity = _aheadSeconds * _sampleRate * _channelCount * 2;
+        }
+        _opened = opened;
+        _finished = !opened;
+    }
+    _condition.notify_all();
+    if (!opened)
+        return;
+
+    while (true) {
+        {
+            std::unique_lock lock(_mutex);
+            _condition.wait(lock, [this] { return _stopping || _bufferedSize < _capacity; });
+            if (_stopping)
+                break;
+        }
+
+        std::shared_ptr<Blob> buffer = _baseDataSource->GetNextBuffer();
+        if (!buffer) {
+            // End of stream, loop around.
+            _baseDataSource->Close();
+            if (_baseDataSource->Open())
+                buffer = _baseDataSource->GetNextBuffer();
+            if (!buffer) {
+                logger->warning("PrefetchingAudioDataSource: failed to restart the underlying data source");
+                break;
+            }
+        }
+
+        {
+            std::lock_guard lock(_mutex);
+            _bufferedSize += buffer->size();
+            _buffers.push_back(std::move(buffer));
+        }
+        _condition.notify_all();
+    }
+
+    _baseDataSource->Close();
+    {
+        std::lock_guard lock(_mutex);
+        _finished = true;
+    }
+    _condition.notify_all();
+}
+
+PAudioDataSource CreatePrefetchingAudioDataSource(PAudioDataSource baseDataSource, float aheadSeconds) {
+    return std::make_shared<PrefetchingAudioDataSource>(std::move(baseDataSource), aheadSeconds);
+}
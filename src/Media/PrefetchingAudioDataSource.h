@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "AudioDataSource.h"
+
+/**
+ * Data source that decodes ahead on a worker thread into a bounded queue of PCM buffers.
+ *
+ * `Open` only starts the worker and returns right away, opening & decoding of the underlying data source then happens
+ * on the worker thread. This makes it possible to open a data source ahead of time, e.g. for the music of the map that
+ * the party is about to travel to, and then play it without blocking on disk reads or decoding.
+ *
+ * The underlying data source is looped - once it runs out, it's reopened & decoding continues from the start.
+ *
+ * Note that the getters block until the underlying data source is opened, and `GetNextBuffer` blocks until there's
+ * decoded data available. Use `HasNextBuffer` to check whether these calls would block.
+ */
+class PrefetchingAudioDataSource : public IAudioDataSource {
+ public:
+    /**
+     * @param baseDataSource            Data source to decode ahead.
+     * @param aheadSeconds              How many seconds of audio to keep decoded ahead.
+     */
+    PrefetchingAudioDataSource(PAudioDataSource baseDataSource, float aheadSeconds);
+    virtual ~PrefetchingAudioDataSource() override;
+
+    virtual bool Open() override;
+    virtual void Close() override;
+
+    virtual size_t GetSampleRate() override;
+    virtual size_t GetChannelCount() override;
+    virtual std::shared_ptr<Blob> GetNextBuffer() override;
+    virtual float GetDuration() override;
+    virtual bool HasNextBuffer() override;
+
+ private:
+    void waitOpened();
+    void workerMain();
+
+ private:
+    PAudioDataSource _baseDataSource;
+    float _aheadSeconds = 0.0f;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::shared_ptr<Blob>> _buffers;
+    size_t _bufferedSize = 0; // Total size of `_buffers`, in bytes.
+    size_t _capacity = 0; // Max value for `_bufferedSize`, known once the base data source is opened.
+    size_t _sampleRate = 0;
+    size_t _channelCount = 0;
+    float _duration = 0.0f;
+    bool _opened = false; // Base data source was opened, stream parameters above are valid.
+    bool _finished = false; // Worker is done, either because of an error or because it was stopped.
+    bool _stopping = false;
+    std::thread _worker;
+};
+
+PAudioDataSource CreatePrefetchingAudioDataSource(PAudioDataSource baseDataSource, float aheadSeconds);
@@ -36,7 +36,9 @@ static const std::vector<std::vector<std::string_view>> globalValidateList = {
     {"shaders", "gltextshader.frag"},
     {"shaders", "gltextshader.vert"},
     {"shaders", "gltwodshader.frag"},
-    {"shaders", "gltwodshader.vert"}
+    {"shaders", "gltwodshader.vert"},
+    {"shaders", "glweathershader.frag"},
+    {"shaders", "glweathershader.vert"}
 };
 
 void setDataPath(const std::filesystem::path &dataPath) {
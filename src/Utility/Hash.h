@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Initial value for `fnv1aHash`.
+ */
+inline constexpr uint64_t FNV1A_OFFSET_BASIS = 14695981039346656037ull;
+
+/**
+ * Mixes a single byte into a 64-bit FNV-1a hash.
+ *
+ * @param hash                          Hash to continue from.
+ * @param byte                          Byte to mix in.
+ * @return                              Updated hash.
+ */
+[[nodiscard]] constexpr uint64_t fnv1aHashByte(uint64_t hash, unsigned char byte) {
+    return (hash ^ byte) * 1099511628211ull;
+}
+
+/**
+ * 64-bit FNV-1a hash. Fast enough for cache keys & de-duplication, but is not cryptographic and has no collision
+ * guarantees - callers that can't tolerate collisions should compare the hashed data too.
+ *
+ * Hashing several buffers in sequence by passing the previous result as `hash` gives the same result as hashing their
+ * concatenation.
+ *
+ * @param data                          Data to hash.
+ * @param size                          Size of the data, in bytes.
+ * @param hash                          Hash to continue from.
+ * @return                              Updated hash.
+ */
+[[nodiscard]] inline uint64_t fnv1aHashBytes(const void *data, size_t size, uint64_t hash = FNV1A_OFFSET_BASIS) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; i++)
+        hash = fnv1aHashByte(hash, bytes[i]);
+    return hash;
+}
+
+/**
+ * Same as `fnv1aHashBytes`, but for strings. Named differently so that a string literal followed by a hash can't
+ * silently convert into a `(const void *, size_t)` pair.
+ *
+ * @param s                             String to hash.
+ * @param hash                          Hash to continue from.
+ * @return                              Updated hash.
+ */
+[[nodiscard]] inline uint64_t fnv1aHash(std::string_view s, uint64_t hash = FNV1A_OFFSET_BASIS) {
+    return fnv1aHashBytes(s.data(), s.size(), hash);
+}
+
+/**
+ * 128-bit MurmurHash3, x64 variant. Slower than `fnv1aHashBytes`, but collisions are practically impossible, so this
+ * one should be used where a collision would silently return wrong data, e.g. for the keys of persistent caches.
+ *
+ * @param data                          Data to hash.
+ * @param size                          Size of the data, in bytes.
+ * @param seed                          Hash seed.
+ * @return                              Hash, as a pair of 64-bit values in the order of the reference implementation.
+ */
+[[nodiscard]] std::array<uint64_t, 2> murmur3Hash128(const void *data, size_t size, uint32_t seed = 0);
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cassert>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Fixed capacity cache that evicts the least recently used entry when full.
+ *
+ * Lookups support heterogeneous keys if `Hash` and `KeyEqual` are transparent, e.g. `std::string_view` lookups into
+ * a cache keyed by `std::string`.
+ *
+ * @tparam Key                          Key type.
+ * @tparam Value                        Value type.
+ * @tparam Hash                         Hash for the keys.
+ * @tparam KeyEqual                     Equality comparison for the keys.
+ */
+template<class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class LruCache {
+ public:
+    explicit LruCache(size_t capacity) : _capacity(capacity) {
+        assert(capacity > 0);
+    }
+
+    /**
+     * @param key                       Key to look up.
+     * @return                          Pointer to the cached value, or `nullptr` if there is none. Found entry
+     *                                  becomes the most recently used one. Returned pointer stays valid until the
+     *                                  entry is evicted.
+     */
+    template<class K>
+    [[nodiscard]] Value *find(const K &key) {
+        auto pos = _index.find(key);
+        if (pos == _index.end())
+            return nullptr;
+
+        _entries.splice(_entries.begin(), _entries, pos->second);
+        return &pos->second->second;
+    }
+
+    /**
+     * Inserts a new entry, evicting the least recently used one if the cache is full. Key must not be in the cache.
+     *
+     * @param key                       Key to insert.
+     * @param value                     Value to insert.
+     * @return                          Reference to the inserted value.
+     */
+    Value &insert(Key key, Value value) {
+        assert(!_index.contains(key));
+
+        if (_entries.size() == _capacity) {
+            _index.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+
+        _entries.emplace_front(std::move(key), std::move(value));
+        _index.emplace(_entries.front().first, _entries.begin());
+        return _entries.front().second;
+    }
+
+    void clear() {
+        _index.clear();
+        _entries.clear();
+    }
+
+    [[nodiscard]] size_t size() const {
+        return _entries.size();
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return _capacity;
+    }
+
+ private:
+    using Entry = std::pair<Key, Value>;
+
+    size_t _capacity = 0;
+    std::list<Entry> _entries; // Most recently used first.
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash, KeyEqual> _index;
+};
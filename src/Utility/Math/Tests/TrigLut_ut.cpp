@@ -0,0 +1,48 @@
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Utility/Math/TrigLut.h"
+
+UNIT_TEST(TrigLut, BatchSinCos) {
+    // Odd size so that the scalar tail is also tested.
+    std::vector<int> angles;
+    for (int angle = -3 * TrigLUT.uIntegerDoublePi; angle <= 3 * TrigLUT.uIntegerDoublePi + 2; angle++)
+        angles.push_back(angle);
+    angles.push_back(1000000007);
+    angles.push_back(-1000000007);
+
+    std::vector<float> sins(angles.size());
+    std::vector<float> coses(angles.size());
+    TrigLUT.sinCos(angles, sins, coses);
+
+    for (size_t i = 0; i < angles.size(); i++) {
+        EXPECT_EQ(sins[i], TrigLUT.sin(angles[i])) << angles[i];
+        EXPECT_EQ(coses[i], TrigLUT.cos(angles[i])) << angles[i];
+    }
+}
+
+UNIT_TEST(TrigLut, BatchAtan2) {
+    std::vector<int> xs, ys;
+    for (int x = -64; x <= 64; x++) {
+        for (int y = -64; y <= 64; y++) {
+            xs.push_back(x * 37);
+            ys.push_back(y * 41);
+        }
+    }
+
+    std::vector<int> angles(xs.size());
+    TrigLUT.atan2(xs, ys, angles);
+
+    for (size_t i = 0; i < xs.size(); i++)
+        EXPECT_EQ(angles[i], TrigLUT.atan2(xs[i], ys[i]));
+}
+
+UNIT_TEST(TrigLut, Precise) {
+    for (int angle = 0; angle < TrigLUT.uIntegerDoublePi; angle++) {
+        EXPECT_NEAR(TrigTableLookup::preciseCos(angle), TrigLUT.cos(angle), 1.0e-5f);
+        EXPECT_NEAR(TrigTableLookup::preciseSin(angle), TrigLUT.sin(angle), 1.0e-5f);
+    }
+
+    EXPECT_NEAR(TrigTableLookup::preciseSin(0.5f), 0.0015340f, 1.0e-6f);
+}
@@ -1,9 +1,106 @@
 #include "TrigLut.h"
 
+#include <cassert>
 #include <cmath>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#   define OE_TRIG_KERNELS_SSE2
+#   include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   define OE_TRIG_KERNELS_NEON
+#   include <arm_neon.h>
+#endif
+
 TrigTableLookup TrigLUT;
 
+// The SIMD kernels only vectorize the table index & sign computation, the values still come from the table. Negation
+// is a sign bit flip, so the results are bit-exact with the scalar code.
+
+#ifdef OE_TRIG_KERNELS_SSE2
+static size_t sinCosSimd(const float *table, std::span<const int> angles, std::span<float> sins,
+                         std::span<float> coses) {
+    const __m128i doublePiMask = _mm_set1_epi32(TrigTableLookup::uDoublePiMask);
+    const __m128i integerPi = _mm_set1_epi32(TrigTableLookup::uIntegerPi);
+    const __m128i integerDoublePi = _mm_set1_epi32(TrigTableLookup::uIntegerDoublePi);
+    const __m128i halfPiMinusOne = _mm_set1_epi32(TrigTableLookup::uIntegerHalfPi - 1);
+    const __m128i halfPi = _mm_set1_epi32(TrigTableLookup::uIntegerHalfPi);
+    const __m128i signBit = _mm_set1_epi32(static_cast<int>(0x80000000u));
+
+    // Computes table indices & sign masks, same as `TrigTableLookup::cos`.
+    auto reduce = [&](__m128i angle, __m128i *index, __m128i *sign) {
+        angle = _mm_and_si128(angle, doublePiMask);
+        __m128i mirror = _mm_cmpgt_epi32(angle, integerPi);
+        angle = _mm_or_si128(_mm_and_si128(mirror, _mm_sub_epi32(integerDoublePi, angle)),
+                             _mm_andnot_si128(mirror, angle));
+        __m128i negative = _mm_cmpgt_epi32(angle, halfPiMinusOne);
+        *index = _mm_or_si128(_mm_and_si128(negative, _mm_sub_epi32(integerPi, angle)),
+                              _mm_andnot_si128(negative, angle));
+        *sign = _mm_and_si128(negative, signBit);
+    };
+
+    // There is no gather in SSE2, so the lookups go through memory.
+    auto lookup = [&](__m128i index, __m128i sign) {
+        alignas(16) int indices[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(indices), index);
+        __m128 values = _mm_setr_ps(table[indices[0]], table[indices[1]], table[indices[2]], table[indices[3]]);
+        return _mm_xor_ps(values, _mm_castsi128_ps(sign));
+    };
+
+    size_t i = 0;
+    for (size_t size = angles.size(); i + 4 <= size; i += 4) {
+        __m128i angle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(angles.data() + i));
+
+        __m128i index, sign;
+        reduce(angle, &index, &sign);
+        _mm_storeu_ps(coses.data() + i, lookup(index, sign));
+        reduce(_mm_sub_epi32(angle, halfPi), &index, &sign);
+        _mm_storeu_ps(sins.data() + i, lookup(index, sign));
+    }
+    return i;
+}
+#elif defined(OE_TRIG_KERNELS_NEON)
+static size_t sinCosSimd(const float *table, std::span<const int> angles, std::span<float> sins,
+                         std::span<float> coses) {
+    const int32x4_t doublePiMask = vdupq_n_s32(TrigTableLookup::uDoublePiMask);
+    const int32x4_t integerPi = vdupq_n_s32(TrigTableLookup::uIntegerPi);
+    const int32x4_t integerDoublePi = vdupq_n_s32(TrigTableLookup::uIntegerDoublePi);
+    const int32x4_t halfPi = vdupq_n_s32(TrigTableLookup::uIntegerHalfPi);
+    const uint32x4_t signBit = vdupq_n_u32(0x80000000u);
+
+    // Computes table indices & sign masks, same as `TrigTableLookup::cos`.
+    auto reduce = [&](int32x4_t angle, int32x4_t *index, uint32x4_t *sign) {
+        angle = vandq_s32(angle, doublePiMask);
+        angle = vbslq_s32(vcgtq_s32(angle, integerPi), vsubq_s32(integerDoublePi, angle), angle);
+        uint32x4_t negative = vcgeq_s32(angle, halfPi);
+        *index = vbslq_s32(negative, vsubq_s32(integerPi, angle), angle);
+        *sign = vandq_u32(negative, signBit);
+    };
+
+    auto lookup = [&](int32x4_t index, uint32x4_t sign) {
+        float values[4] = {table[vgetq_lane_s32(index, 0)], table[vgetq_lane_s32(index, 1)],
+                           table[vgetq_lane_s32(index, 2)], table[vgetq_lane_s32(index, 3)]};
+        return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vld1q_f32(values)), sign));
+    };
+
+    size_t i = 0;
+    for (size_t size = angles.size(); i + 4 <= size; i += 4) {
+        int32x4_t angle = vld1q_s32(angles.data() + i);
+
+        int32x4_t index;
+        uint32x4_t sign;
+        reduce(angle, &index, &sign);
+        vst1q_f32(coses.data() + i, lookup(index, sign));
+        reduce(vsubq_s32(angle, halfPi), &index, &sign);
+        vst1q_f32(sins.data() + i, lookup(index, sign));
+    }
+    return i;
+}
+#else
+static size_t sinCosSimd(const float *, std::span<const int>, std::span<float>, std::span<float>) {
+    return 0;
+}
+#endif
+
 TrigTableLookup::TrigTableLookup() {
     for (int i = 0; i <= this->uIntegerHalfPi; i++)
         _cosTable[i] = std::cos(i * M_PI / uIntegerPi);
@@ -30,3 +127,29 @@ int TrigTableLookup::atan2(int x, int y) const {
     // Note that std::round call is important here, otherwise atan2(x, y) + atan2(y, x) != uIntegerHalfPi.
     return static_cast<int>(std::round(angle / M_PI * 1024)) & uDoublePiMask;
 }
+
+void TrigTableLookup::sinCos(std::span<const int> angles, std::span<float> sins, std::span<float> coses) const {
+    assert(angles.size() == sins.size() && angles.size() == coses.size());
+
+    for (size_t i = sinCosSimd(_cosTable.data(), angles, sins, coses); i < angles.size(); i++) {
+        sins[i] = sin(angles[i]);
+        coses[i] = cos(angles[i]);
+    }
+}
+
+void TrigTableLookup::atan2(std::span<const int> xs, std::span<const int> ys, std::span<int> angles) const {
+    assert(xs.size() == ys.size() && xs.size() == angles.size());
+
+    // Not vectorized. A SIMD atan2 approximation would round differently near the bucket boundaries, and we need the
+    // results to match the scalar version exactly.
+    for (size_t i = 0; i < xs.size(); i++)
+        angles[i] = atan2(xs[i], ys[i]);
+}
+
+float TrigTableLookup::preciseCos(float angle) {
+    return std::cos(angle * static_cast<float>(M_PI / uIntegerPi));
+}
+
+float TrigTableLookup::preciseSin(float angle) {
+    return std::sin(angle * static_cast<float>(M_PI / uIntegerPi));
+}
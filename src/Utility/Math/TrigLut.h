@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <span>
 
 /**
  * Lookup table for trigonometric functions.
@@ -43,6 +44,40 @@ class TrigTableLookup {
      */
     int atan2(int x, int y) const;
 
+    /**
+     * Batch version of `sin` & `cos`. Results are bit-exact with the scalar versions, so this can be used in the game
+     * logic.
+     *
+     * @param angles                    Angles in 1/2048ths of a full circle.
+     * @param[out] sins                 Sines of the provided angles, must be the same size as `angles`.
+     * @param[out] coses                Cosines of the provided angles, must be the same size as `angles`.
+     */
+    void sinCos(std::span<const int> angles, std::span<float> sins, std::span<float> coses) const;
+
+    /**
+     * Batch version of `atan2`, results are bit-exact with the scalar version.
+     *
+     * @param xs                        X coordinates.
+     * @param ys                        Y coordinates, must be the same size as `xs`.
+     * @param[out] angles               Angles in 1/2048ths of a full circle, must be the same size as `xs`.
+     */
+    void atan2(std::span<const int> xs, std::span<const int> ys, std::span<int> angles) const;
+
+    /**
+     * Full precision cosine that doesn't go through the table. Results are not the same as what `cos` returns, so
+     * this should only be used for rendering, e.g. for the camera & sky.
+     *
+     * @param angle                     Angle in 1/2048ths of a full circle, fractional angles are OK.
+     * @return                          Cosine of the provided angle.
+     */
+    static float preciseCos(float angle);
+
+    /**
+     * @param angle                     Angle in 1/2048ths of a full circle, fractional angles are OK.
+     * @return                          Sine of the provided angle, see `preciseCos`.
+     */
+    static float preciseSin(float angle);
+
  private:
     std::array<float, uIntegerHalfPi + 1> _cosTable;
 };
@@ -1,5 +1,7 @@
 #include "Blob.h"
 
+#include <cstring>
+#include <new>
 #include <string>
 
 #include <mio/mmap.hpp>
@@ -8,15 +10,117 @@
 #include "Utility/Exception.h"
 
 #include "FreeDeleter.h"
+#include "MemoryAccounting.h"
+#include "SmallBlockPool.h"
+
+namespace {
+
+// Strings this small are copied into pooled memory instead of being moved into the blob state.
+constexpr size_t MAX_COPIED_STRING_SIZE = 1024;
+
+void *allocateStateMemory(size_t size) {
+    if (size <= SmallBlockPool::MAX_BLOCK_SIZE)
+        return SmallBlockPool::instance()->allocate(size);
+    return ::operator new(size);
+}
+
+void deallocateStateMemory(void *memory, size_t size) {
+    if (size <= SmallBlockPool::MAX_BLOCK_SIZE) {
+        SmallBlockPool::instance()->deallocate(memory, size);
+    } else {
+        ::operator delete(memory);
+    }
+}
+
+/**
+ * Blob state that holds an object of type `T` that owns the blob's memory.
+ */
+template<class T>
+class ObjectBlobState final : public detail::BlobState {
+ public:
+    template<class... Args>
+    static ObjectBlobState *create(Args &&... args) {
+        return new(allocateStateMemory(sizeof(ObjectBlobState))) ObjectBlobState(std::forward<Args>(args)...);
+    }
+
+    T &object() {
+        return _object;
+    }
+
+    /**
+     * Reports the memory owned by the stored object to `MemoryAccounting`, it will be reported as deallocated when
+     * this state is destroyed. Should be called at most once.
+     */
+    void account(MemoryTag tag, size_t size) {
+        _tag = tag;
+        _accountedSize = size;
+        MemoryAccounting::allocate(tag, size);
+    }
+
+ protected:
+    virtual void destroy() override {
+        if (_accountedSize)
+            MemoryAccounting::deallocate(_tag, _accountedSize);
+        this->~ObjectBlobState();
+        deallocateStateMemory(this, sizeof(ObjectBlobState));
+    }
+
+ private:
+    template<class... Args>
+    explicit ObjectBlobState(Args &&... args) : _object(std::forward<Args>(args)...) {}
+
+ private:
+    T _object;
+    MemoryTag _tag = MEMORY_TAG_UNTAGGED;
+    size_t _accountedSize = 0;
+};
+
+// Size of the `InlineBlobState` header. Data goes right after it, so it's also a multiple of the max alignment.
+constexpr size_t HEADER_SIZE = 32;
+
+/**
+ * Blob state that's immediately followed by the blob's data in memory.
+ */
+class InlineBlobState final : public detail::BlobState {
+ public:
+    static InlineBlobState *create(size_t size) {
+        MemoryTag tag = MemoryAccounting::currentTag();
+        MemoryAccounting::allocate(tag, size);
+        return new(allocateStateMemory(HEADER_SIZE + size)) InlineBlobState(size, tag);
+    }
+
+    void *data() {
+        return reinterpret_cast<char *>(this) + HEADER_SIZE;
+    }
+
+ protected:
+    virtual void destroy() override {
+        size_t size = _size;
+        MemoryAccounting::deallocate(_tag, size);
+        this->~InlineBlobState();
+        deallocateStateMemory(this, HEADER_SIZE + size);
+    }
+
+ private:
+    InlineBlobState(size_t size, MemoryTag tag) : _size(size), _tag(tag) {}
+
+ private:
+    size_t _size = 0;
+    MemoryTag _tag = MEMORY_TAG_UNTAGGED;
+};
+
+static_assert(sizeof(InlineBlobState) <= HEADER_SIZE);
+static_assert(HEADER_SIZE % alignof(std::max_align_t) == 0);
+
+} // namespace
 
 Blob Blob::subBlob(size_t offset, size_t size) const {
     if (offset >= _size || size == 0)
         return Blob();
 
-    Blob result;
+    Blob result = share(*this);
     result._data = static_cast<const char *>(_data) + offset;
     result._size = std::min(size, _size - offset);
-    result._state = _state;
     return result;
 }
 
@@ -24,10 +128,13 @@ Blob Blob::fromMalloc(const void *data, size_t size) {
     if (!data)
         return Blob();
 
+    auto *state = ObjectBlobState<std::unique_ptr<void, FreeDeleter>>::create(const_cast<void *>(data));
+    state->account(MemoryAccounting::currentTag(), size);
+
     Blob result;
     result._data = data;
     result._size = size;
-    result._state = std::shared_ptr<void>(const_cast<void *>(data), FreeDeleter());
+    result._state = state;
     return result;
 }
 
@@ -37,14 +144,17 @@ Blob Blob::fromMalloc(std::unique_ptr<void, FreeDeleter> data, size_t size) {
 
 Blob Blob::fromFile(std::string_view path) {
     // On Windows mio::mmap_source expects UTF8-encoded paths. If the file doesn't exist, std::system_error is thrown.
-    std::shared_ptr<mio::mmap_source> mmap = std::make_shared<mio::mmap_source>(std::string(path));
-    if (mmap->size() == 0)
+    mio::mmap_source mmap{std::string(path)};
+    if (mmap.size() == 0)
         return Blob();
 
+    auto *state = ObjectBlobState<mio::mmap_source>::create(std::move(mmap));
+    state->account(MEMORY_TAG_MAPPED_FILES, state->object().size());
+
     Blob result;
-    result._data = mmap->data();
-    result._size = mmap->size();
-    result._state = std::move(mmap);
+    result._data = state->object().data();
+    result._size = state->object().size();
+    result._state = state;
     return result;
 }
 
@@ -52,12 +162,17 @@ Blob Blob::fromString(std::string string) {
     if (string.empty())
         return Blob();
 
-    std::shared_ptr<std::string> state = std::make_shared<std::string>(std::move(string));
+    // Copying small strings is cheaper than allocating a separate state object.
+    if (string.size() <= MAX_COPIED_STRING_SIZE)
+        return copy(string.data(), string.size());
+
+    auto *state = ObjectBlobState<std::string>::create(std::move(string));
+    state->account(MemoryAccounting::currentTag(), state->object().capacity());
 
     Blob result;
-    result._data = state->data();
-    result._size = state->size();
-    result._state = std::move(state);
+    result._data = state->object().data();
+    result._size = state->object().size();
+    result._state = state;
     return result;
 }
 
@@ -65,9 +180,10 @@ Blob Blob::copy(const void *data, size_t size) { // NOLINT: this is not std::cop
     if (size == 0)
         return Blob();
 
-    std::unique_ptr<void, FreeDeleter> memory(malloc(size)); // We don't handle allocation failures.
-    memcpy(memory.get(), data, size);
-    return fromMalloc(std::move(memory), size);
+    void *memory = nullptr;
+    Blob result = allocate(size, &memory);
+    memcpy(memory, data, size);
+    return result;
 }
 
 Blob Blob::view(const void *data, size_t size) {
@@ -86,22 +202,24 @@ Blob Blob::read(FILE *file, size_t size) {
     if (size == 0)
         return Blob();
 
-    std::unique_ptr<void, FreeDeleter> memory(malloc(size));
+    void *memory = nullptr;
+    Blob result = allocate(size, &memory);
 
-    size_t read = fread(memory.get(), size, 1, file);
+    size_t read = fread(memory, size, 1, file);
     if (read != 1)
         throw Exception("Failed to read {} bytes from file", size);
 
-    return fromMalloc(std::move(memory), size);
+    return result;
 }
 
 Blob Blob::read(FileInputStream &file, size_t size) {
     if (size == 0)
         return Blob();
 
-    std::unique_ptr<void, FreeDeleter> memory(malloc(size));
-    file.readOrFail(memory.get(), size);
-    return fromMalloc(std::move(memory), size);
+    void *memory = nullptr;
+    Blob result = allocate(size, &memory);
+    file.readOrFail(memory, size);
+    return result;
 }
 
 Blob Blob::concat(const Blob &l, const Blob &r) {
@@ -115,12 +233,13 @@ Blob Blob::concat(const Blob &l, const Blob &r) {
         return Blob::share(l);
     }
 
-    std::unique_ptr<void, FreeDeleter> memory(malloc(lsize + rsize));
+    void *memory = nullptr;
+    Blob result = allocate(lsize + rsize, &memory);
 
-    memcpy(memory.get(), l.data(), lsize);
-    memcpy(static_cast<char *>(memory.get()) + lsize, r.data(), rsize);
+    memcpy(memory, l.data(), lsize);
+    memcpy(static_cast<char *>(memory) + lsize, r.data(), rsize);
 
-    return fromMalloc(std::move(memory), lsize + rsize);
+    return result;
 }
 
 Blob Blob::share(const Blob &other) {
@@ -128,5 +247,20 @@ Blob Blob::share(const Blob &other) {
     result._data = other._data;
     result._size = other._size;
     result._state = other._state;
+    if (result._state)
+        result._state->ref();
+    return result;
+}
+
+Blob Blob::allocate(size_t size, void **data) {
+    assert(size > 0);
+
+    InlineBlobState *state = InlineBlobState::create(size); // We don't handle allocation failures.
+
+    Blob result;
+    result._data = state->data();
+    result._size = size;
+    result._state = state;
+    *data = state->data();
     return result;
 }
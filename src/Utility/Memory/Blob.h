@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <utility>
@@ -12,11 +13,46 @@
 
 class FileInputStream;
 
+namespace detail {
+/**
+ * Intrusively refcounted blob state. Implementations are private to `Blob.cpp`.
+ */
+class BlobState {
+ public:
+    void ref() {
+        _refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void unref() {
+        if (_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            destroy();
+    }
+
+ protected:
+    BlobState() = default;
+    virtual ~BlobState() = default;
+
+    /**
+     * Destroys this state object & frees the memory it occupies.
+     */
+    virtual void destroy() = 0;
+
+ private:
+    std::atomic<size_t> _refCount = 1;
+};
+} // namespace detail
+
 /**
  * `Blob` is an abstraction that couples a contiguous memory region with the knowledge of how to deallocate it.
  *
  * Deallocation is type-erased (like it's done in `std::shared_ptr`), so you don't have to pass in deleter as
  * a template parameter.
+ *
+ * Blob state is intrusively refcounted. Blobs that own a copy of their data (e.g. the ones created with `copy` or
+ * `read`) store it in the same allocation as the state, and small allocations are served from `SmallBlockPool`.
+ *
+ * Owned memory is reported to `MemoryAccounting` under the memory tag that's current on the thread that has created
+ * the blob.
  */
 class Blob final {
  public:
@@ -28,7 +64,10 @@ class Blob final {
         swap(*this, other);
     }
 
-    ~Blob() = default;
+    ~Blob() {
+        if (_state)
+            _state->unref();
+    }
 
     Blob &operator=(const Blob &) = delete; // Blobs are non-copyable.
 
@@ -155,8 +194,16 @@ class Blob final {
         return {static_cast<const char *>(_data), _size};
     }
 
+ private:
+    /**
+     * @param size                      Size of the memory region to allocate, must be non-zero.
+     * @param[out] data                 Pointer to the allocated memory region.
+     * @return                          Blob that owns a newly allocated uninitialized memory region.
+     */
+    [[nodiscard]] static Blob allocate(size_t size, void **data);
+
  private:
     const void *_data = nullptr;
     size_t _size = 0;
-    std::shared_ptr<void> _state;
+    detail::BlobState *_state = nullptr;
 };
@@ -0,0 +1,105 @@
+#include "MemoryAccounting.h"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <utility>
+
+#include "Utility/Workaround/ToUnderlying.h"
+
+namespace {
+
+struct AtomicStats {
+    std::atomic<int64_t> size = 0;
+    std::atomic<int64_t> peakSize = 0;
+    std::atomic<int64_t> allocationCount = 0;
+
+    void add(int64_t delta, int64_t countDelta) {
+        int64_t newSize = size.fetch_add(delta, std::memory_order_relaxed) + delta;
+        allocationCount.fetch_add(countDelta, std::memory_order_relaxed);
+
+        int64_t peak = peakSize.load(std::memory_order_relaxed);
+        while (newSize > peak && !peakSize.compare_exchange_weak(peak, newSize, std::memory_order_relaxed)) {}
+    }
+
+    MemoryTagStats load() const {
+        return {size.load(std::memory_order_relaxed), peakSize.load(std::memory_order_relaxed),
+                allocationCount.load(std::memory_order_relaxed)};
+    }
+
+    void resetPeak() {
+        peakSize.store(size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+};
+
+constexpr size_t TAG_COUNT = std::to_underlying(MEMORY_TAG_LAST) + 1;
+
+std::array<AtomicStats, TAG_COUNT> tagStats;
+AtomicStats heapTotalStats;
+
+thread_local MemoryTag currentThreadTag = MEMORY_TAG_UNTAGGED;
+
+bool isHeapTag(MemoryTag tag) {
+    return tag <= MEMORY_TAG_LAST_HEAP;
+}
+
+} // namespace
+
+const char *displayName(MemoryTag tag) {
+    switch (tag) {
+    case MEMORY_TAG_UNTAGGED:       return "Untagged";
+    case MEMORY_TAG_LOD:            return "LOD";
+    case MEMORY_TAG_TEXTURES:       return "Textures";
+    case MEMORY_TAG_SPRITES:        return "Sprites";
+    case MEMORY_TAG_ASSETS:         return "Assets";
+    case MEMORY_TAG_LEVEL:          return "Level";
+    case MEMORY_TAG_AUDIO:          return "Audio";
+    case MEMORY_TAG_GPU_TEXTURES:   return "GPU textures";
+    case MEMORY_TAG_GPU_BUFFERS:    return "GPU buffers";
+    case MEMORY_TAG_MAPPED_FILES:   return "Mapped files";
+    default:
+        assert(false);
+        return "";
+    }
+}
+
+void MemoryAccounting::allocate(MemoryTag tag, size_t size) {
+    tagStats[std::to_underlying(tag)].add(size, 1);
+    if (isHeapTag(tag))
+        heapTotalStats.add(size, 1);
+}
+
+void MemoryAccounting::deallocate(MemoryTag tag, size_t size) {
+    tagStats[std::to_underlying(tag)].add(-static_cast<int64_t>(size), -1);
+    if (isHeapTag(tag))
+        heapTotalStats.add(-static_cast<int64_t>(size), -1);
+}
+
+void MemoryAccounting::reallocate(MemoryTag tag, size_t oldSize, size_t newSize) {
+    if (oldSize)
+        deallocate(tag, oldSize);
+    if (newSize)
+        allocate(tag, newSize);
+}
+
+MemoryTagStats MemoryAccounting::stats(MemoryTag tag) {
+    return tagStats[std::to_underlying(tag)].load();
+}
+
+MemoryTagStats MemoryAccounting::heapStats() {
+    return heapTotalStats.load();
+}
+
+void MemoryAccounting::resetPeaks() {
+    for (AtomicStats &stats : tagStats)
+        stats.resetPeak();
+    heapTotalStats.resetPeak();
+}
+
+MemoryTag MemoryAccounting::currentTag() {
+    return currentThreadTag;
+}
+
+MemoryTag MemoryAccounting::exchangeCurrentTag(MemoryTag tag) {
+    return std::exchange(currentThreadTag, tag);
+}
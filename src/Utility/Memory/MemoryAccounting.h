@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "Utility/Segment.h"
+
+/**
+ * Subsystem tags for memory accounting.
+ *
+ * Allocations made through `Blob` and `Image` are attributed to the tag that's current on the allocating thread, see
+ * `MemoryTagScope`. Some tags are not scope-based and are always used for the corresponding kind of allocations.
+ */
+enum class MemoryTag : uint8_t {
+    MEMORY_TAG_UNTAGGED,        // Allocations made outside of any `MemoryTagScope`.
+    MEMORY_TAG_LOD,             // LOD file reads & LOD entry data.
+    MEMORY_TAG_TEXTURES,        // `LodTextureCache` entries.
+    MEMORY_TAG_SPRITES,         // `LodSpriteCache` entries.
+    MEMORY_TAG_ASSETS,          // `AssetsManager` images & fonts.
+    MEMORY_TAG_LEVEL,           // Level data that's loaded in `Indoor` / `Outdoor`.
+    MEMORY_TAG_AUDIO,           // Sound & music buffers.
+    MEMORY_TAG_GPU_TEXTURES,    // GL textures, sizes are estimated from texture formats. Not in process memory.
+    MEMORY_TAG_GPU_BUFFERS,     // GL buffers. Not in process memory.
+    MEMORY_TAG_MAPPED_FILES,    // Memory-mapped files. Address space, not necessarily resident.
+
+    MEMORY_TAG_FIRST = MEMORY_TAG_UNTAGGED,
+    MEMORY_TAG_LAST = MEMORY_TAG_MAPPED_FILES,
+    MEMORY_TAG_LAST_HEAP = MEMORY_TAG_AUDIO // Last tag that's accounting for heap memory.
+};
+using enum MemoryTag;
+
+inline Segment<MemoryTag> allMemoryTags() {
+    return {MEMORY_TAG_FIRST, MEMORY_TAG_LAST};
+}
+
+/**
+ * @param tag                           Memory tag.
+ * @return                              Human-readable tag name.
+ */
+[[nodiscard]] const char *displayName(MemoryTag tag);
+
+struct MemoryTagStats {
+    int64_t size = 0; // Currently allocated bytes.
+    int64_t peakSize = 0; // Max of `size` since startup or since the last `resetPeaks` call.
+    int64_t allocationCount = 0; // Number of live allocations.
+};
+
+/**
+ * Thread-safe process-wide memory accounting by subsystem tag.
+ *
+ * This is not an allocator, and it doesn't see all the allocations - only the ones that are reported at the
+ * subsystem boundaries, like `Blob`, `Image` and GL texture creation. Container memory is not accounted for.
+ */
+class MemoryAccounting {
+ public:
+    static void allocate(MemoryTag tag, size_t size);
+    static void deallocate(MemoryTag tag, size_t size);
+
+    /**
+     * Reports a resize of an allocation. Zero size means there is no allocation, so this can also be used for
+     * allocating & freeing.
+     *
+     * @param tag                       Memory tag.
+     * @param oldSize                   Old allocation size.
+     * @param newSize                   New allocation size.
+     */
+    static void reallocate(MemoryTag tag, size_t oldSize, size_t newSize);
+
+    /**
+     * @param tag                       Memory tag.
+     * @return                          Accounting stats for the provided tag.
+     */
+    [[nodiscard]] static MemoryTagStats stats(MemoryTag tag);
+
+    /**
+     * @return                          Accounting stats for all the heap memory tags combined, i.e. everything except
+     *                                  GPU textures & buffers and mapped files. Peak is the peak of the total, not
+     *                                  the sum of the peaks.
+     */
+    [[nodiscard]] static MemoryTagStats heapStats();
+
+    /**
+     * Resets the peaks to the current sizes.
+     */
+    static void resetPeaks();
+
+    /**
+     * @return                          Memory tag that's current on the calling thread.
+     */
+    [[nodiscard]] static MemoryTag currentTag();
+
+ private:
+    friend class MemoryTagScope;
+    static MemoryTag exchangeCurrentTag(MemoryTag tag);
+};
+
+/**
+ * Sets the current memory tag on the calling thread for the lifetime of the scope.
+ *
+ * Note that thread pool tasks don't inherit the tag from the thread that has posted them, so tasks that allocate
+ * should set up their own scope.
+ */
+class MemoryTagScope {
+ public:
+    explicit MemoryTagScope(MemoryTag tag) : _prevTag(MemoryAccounting::exchangeCurrentTag(tag)) {}
+
+    ~MemoryTagScope() {
+        MemoryAccounting::exchangeCurrentTag(_prevTag);
+    }
+
+    MemoryTagScope(const MemoryTagScope &) = delete;
+    MemoryTagScope &operator=(const MemoryTagScope &) = delete;
+
+ private:
+    MemoryTag _prevTag;
+};
+
+/**
+ * Same as `FreeDeleter`, but also reports the deallocation to `MemoryAccounting`.
+ */
+class AccountedFreeDeleter {
+ public:
+    AccountedFreeDeleter() = default;
+    AccountedFreeDeleter(MemoryTag tag, size_t size) : _tag(tag), _size(size) {}
+
+    template<class T>
+    void operator()(const T *p) const {
+        if (_size)
+            MemoryAccounting::deallocate(_tag, _size);
+        std::free(const_cast<T *>(p));
+    }
+
+ private:
+    MemoryTag _tag = MEMORY_TAG_UNTAGGED;
+    size_t _size = 0;
+};
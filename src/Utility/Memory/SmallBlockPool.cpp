@@ -0,0 +1,53 @@
+#include "SmallBlockPool.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdlib>
+
+static_assert(SmallBlockPool::MIN_BLOCK_SIZE % alignof(std::max_align_t) == 0);
+static_assert(SmallBlockPool::MAX_BLOCK_SIZE == SmallBlockPool::MIN_BLOCK_SIZE << 7);
+
+SmallBlockPool *SmallBlockPool::instance() {
+    static SmallBlockPool *pool = new SmallBlockPool(); // Leaked intentionally.
+    return pool;
+}
+
+void *SmallBlockPool::allocate(size_t size) {
+    assert(size > 0 && size <= MAX_BLOCK_SIZE);
+
+    size_t index = sizeClassIndex(size);
+    size_t blockSize = MIN_BLOCK_SIZE << index;
+    SizeClass &sizeClass = _sizeClasses[index];
+
+    auto guard = std::lock_guard(sizeClass.mutex);
+    if (FreeBlock *block = sizeClass.freeList) {
+        sizeClass.freeList = block->next;
+        return block;
+    }
+
+    if (sizeClass.chunkPos == sizeClass.chunkEnd) {
+        sizeClass.chunkPos = static_cast<char *>(malloc(CHUNK_SIZE)); // We don't handle allocation failures.
+        sizeClass.chunkEnd = sizeClass.chunkPos + CHUNK_SIZE;
+    }
+
+    void *result = sizeClass.chunkPos;
+    sizeClass.chunkPos += blockSize;
+    return result;
+}
+
+void SmallBlockPool::deallocate(void *block, size_t size) {
+    assert(block);
+    assert(size > 0 && size <= MAX_BLOCK_SIZE);
+
+    SizeClass &sizeClass = _sizeClasses[sizeClassIndex(size)];
+
+    auto guard = std::lock_guard(sizeClass.mutex);
+    FreeBlock *freeBlock = static_cast<FreeBlock *>(block);
+    freeBlock->next = sizeClass.freeList;
+    sizeClass.freeList = freeBlock;
+}
+
+size_t SmallBlockPool::sizeClassIndex(size_t size) {
+    return std::bit_width(std::max(size, MIN_BLOCK_SIZE) - 1) - std::bit_width(MIN_BLOCK_SIZE - 1);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+
+/**
+ * Thread-safe size-classed pool for small memory blocks.
+ *
+ * Blocks are carved out of large chunks that are allocated on demand, and are put on a per-size-class free list
+ * when deallocated. Chunks are never returned to the system, so the memory held by the pool is bounded by the peak
+ * small block usage.
+ *
+ * Used by `Blob` for the small payloads & the blob state objects, so that loading a map doesn't hit `malloc` for
+ * each of the thousands of small blobs it creates.
+ */
+class SmallBlockPool {
+ public:
+    static constexpr size_t MIN_BLOCK_SIZE = 32;
+    static constexpr size_t MAX_BLOCK_SIZE = 4096;
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @return                          Global pool instance. Never destroyed, so it's safe to use it from the
+     *                                  destructors of global objects.
+     */
+    [[nodiscard]] static SmallBlockPool *instance();
+
+    /**
+     * @param size                      Block size, must be in `[1, MAX_BLOCK_SIZE]`.
+     * @return                          Newly allocated block, aligned at `alignof(std::max_align_t)`.
+     */
+    [[nodiscard]] void *allocate(size_t size);
+
+    /**
+     * @param block                     Block to deallocate, as returned from `allocate`.
+     * @param size                      Size that was passed to `allocate`.
+     */
+    void deallocate(void *block, size_t size);
+
+ private:
+    static constexpr size_t SIZE_CLASS_COUNT = 8; // 32, 64, ..., 4096.
+
+    SmallBlockPool() = default;
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct SizeClass {
+        std::mutex mutex;
+        FreeBlock *freeList = nullptr;
+        char *chunkPos = nullptr;
+        char *chunkEnd = nullptr;
+    };
+
+    static size_t sizeClassIndex(size_t size);
+
+ private:
+    std::array<SizeClass, SIZE_CLASS_COUNT> _sizeClasses;
+};
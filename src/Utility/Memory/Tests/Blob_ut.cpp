@@ -53,3 +53,43 @@ UNIT_TEST(Blob, SharedFromFile) {
 
     cleanup();
 }
+
+UNIT_TEST(Blob, CopyShareAndSubBlob) {
+    for (size_t size : {1, 100, 5000, 100000}) {
+        std::string data(size, 'a');
+        for (size_t i = 0; i < size; i++)
+            data[i] = static_cast<char>('a' + i % 26);
+
+        Blob blob = Blob::copy(data.data(), data.size());
+        EXPECT_EQ(blob.string_view(), data);
+        EXPECT_NE(blob.data(), data.data());
+
+        Blob shared = Blob::share(blob);
+        Blob subBlob = blob.subBlob(size / 2);
+        EXPECT_EQ(shared.data(), blob.data());
+        EXPECT_EQ(subBlob.data(), static_cast<const char *>(blob.data()) + size / 2);
+
+        blob = Blob(); // Release original blob.
+        EXPECT_EQ(shared.string_view(), data);
+        EXPECT_EQ(subBlob.string_view(), std::string_view(data).substr(size / 2));
+    }
+}
+
+UNIT_TEST(Blob, FromString) {
+    for (size_t size : {10, 10000}) {
+        std::string data(size, 'x');
+        Blob blob = Blob::fromString(data);
+        EXPECT_EQ(blob.string_view(), data);
+
+        Blob subBlob = blob.subBlob(1, 5);
+        blob = Blob();
+        EXPECT_EQ(subBlob.string_view(), "xxxxx");
+    }
+}
+
+UNIT_TEST(Blob, Concat) {
+    Blob l = Blob::fromString("abc");
+    Blob r = Blob::fromString("def");
+    EXPECT_EQ(Blob::concat(l, r).string_view(), "abcdef");
+    EXPECT_EQ(Blob::concat(l, Blob()).data(), l.data());
+}
@@ -0,0 +1,69 @@
+#include <string>
+#include <thread>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Utility/Memory/Blob.h"
+#include "Utility/Memory/MemoryAccounting.h"
+
+UNIT_TEST(MemoryAccounting, AllocateDeallocate) {
+    MemoryTagStats before = MemoryAccounting::stats(MEMORY_TAG_AUDIO);
+
+    MemoryAccounting::allocate(MEMORY_TAG_AUDIO, 100);
+    MemoryAccounting::allocate(MEMORY_TAG_AUDIO, 50);
+    MemoryTagStats stats = MemoryAccounting::stats(MEMORY_TAG_AUDIO);
+    EXPECT_EQ(stats.size - before.size, 150);
+    EXPECT_EQ(stats.allocationCount - before.allocationCount, 2);
+    EXPECT_GE(stats.peakSize, stats.size);
+
+    MemoryAccounting::deallocate(MEMORY_TAG_AUDIO, 100);
+    MemoryAccounting::deallocate(MEMORY_TAG_AUDIO, 50);
+    MemoryTagStats after = MemoryAccounting::stats(MEMORY_TAG_AUDIO);
+    EXPECT_EQ(after.size, before.size);
+    EXPECT_EQ(after.allocationCount, before.allocationCount);
+    EXPECT_GE(after.peakSize, before.size + 150);
+
+    MemoryAccounting::resetPeaks();
+    EXPECT_EQ(MemoryAccounting::stats(MEMORY_TAG_AUDIO).peakSize, after.size);
+}
+
+UNIT_TEST(MemoryAccounting, HeapTotalSkipsGpu) {
+    MemoryTagStats before = MemoryAccounting::heapStats();
+    MemoryAccounting::allocate(MEMORY_TAG_GPU_TEXTURES, 1000);
+    EXPECT_EQ(MemoryAccounting::heapStats().size, before.size);
+    MemoryAccounting::deallocate(MEMORY_TAG_GPU_TEXTURES, 1000);
+}
+
+UNIT_TEST(MemoryAccounting, TagScope) {
+    EXPECT_EQ(MemoryAccounting::currentTag(), MEMORY_TAG_UNTAGGED);
+    {
+        MemoryTagScope outer(MEMORY_TAG_LEVEL);
+        EXPECT_EQ(MemoryAccounting::currentTag(), MEMORY_TAG_LEVEL);
+        {
+            MemoryTagScope inner(MEMORY_TAG_SPRITES);
+            EXPECT_EQ(MemoryAccounting::currentTag(), MEMORY_TAG_SPRITES);
+
+            std::thread([] { EXPECT_EQ(MemoryAccounting::currentTag(), MEMORY_TAG_UNTAGGED); }).join();
+        }
+        EXPECT_EQ(MemoryAccounting::currentTag(), MEMORY_TAG_LEVEL);
+    }
+    EXPECT_EQ(MemoryAccounting::currentTag(), MEMORY_TAG_UNTAGGED);
+}
+
+UNIT_TEST(MemoryAccounting, Blobs) {
+    MemoryTagStats before = MemoryAccounting::stats(MEMORY_TAG_TEXTURES);
+    {
+        MemoryTagScope scope(MEMORY_TAG_TEXTURES);
+        Blob small = Blob::copy("12345", 5);
+        Blob large = Blob::fromString(std::string(10000, 'a'));
+        Blob view = Blob::view("123", 3);
+        Blob shared = Blob::share(small);
+
+        MemoryTagStats stats = MemoryAccounting::stats(MEMORY_TAG_TEXTURES);
+        EXPECT_EQ(stats.allocationCount - before.allocationCount, 2);
+        EXPECT_GE(stats.size - before.size, 10005);
+    }
+    MemoryTagStats after = MemoryAccounting::stats(MEMORY_TAG_TEXTURES);
+    EXPECT_EQ(after.size, before.size);
+    EXPECT_EQ(after.allocationCount, before.allocationCount);
+}
@@ -0,0 +1,40 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Utility/Memory/SmallBlockPool.h"
+
+UNIT_TEST(SmallBlockPool, AllocateDeallocate) {
+    SmallBlockPool *pool = SmallBlockPool::instance();
+
+    std::vector<std::pair<void *, size_t>> blocks;
+    for (size_t size = 1; size <= SmallBlockPool::MAX_BLOCK_SIZE; size = size * 3 / 2 + 1) {
+        for (int i = 0; i < 100; i++) {
+            void *block = pool->allocate(size);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t), 0);
+            memset(block, i, size);
+            blocks.emplace_back(block, size);
+        }
+    }
+
+    for (size_t i = 0; i < blocks.size(); i++) {
+        auto [block, size] = blocks[i];
+        const unsigned char *bytes = static_cast<const unsigned char *>(block);
+        EXPECT_EQ(bytes[0], i % 100);
+        EXPECT_EQ(bytes[size - 1], i % 100);
+    }
+
+    for (auto [block, size] : blocks)
+        pool->deallocate(block, size);
+}
+
+UNIT_TEST(SmallBlockPool, Reuse) {
+    SmallBlockPool *pool = SmallBlockPool::instance();
+
+    void *block = pool->allocate(100);
+    pool->deallocate(block, 100);
+    EXPECT_EQ(pool->allocate(120), block); // Same size class.
+    pool->deallocate(block, 120);
+}
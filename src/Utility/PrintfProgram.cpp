@@ -0,0 +1,67 @@
+#include "PrintfProgram.h"
+
+#include <cstring>
+
+static bool isFlag(char c) {
+    return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0';
+}
+
+static bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static bool isLengthModifier(char c) {
+    return c == 'h' || c == 'l' || c == 'j' || c == 'z' || c == 't' || c == 'L';
+}
+
+static bool isConversion(char c) {
+    return c != '\0' && std::strchr("diouxXcspeEfFgGaA", c) != nullptr;
+}
+
+PrintfProgram::PrintfProgram(std::string_view format) : _format(format) {
+    size_t literalStart = 0;
+    size_t pos = 0;
+    while (pos < format.size()) {
+        if (format[pos] != '%') {
+            pos++;
+            continue;
+        }
+
+        if (pos + 1 < format.size() && format[pos + 1] == '%') {
+            // "%%" outputs a single '%', which is the second char of the pair.
+            _segments.push_back({format.substr(literalStart, pos - literalStart + 1), {}});
+            pos += 2;
+            literalStart = pos;
+            continue;
+        }
+
+        size_t specStart = pos++;
+        while (pos < format.size() && isFlag(format[pos]))
+            pos++;
+        while (pos < format.size() && isDigit(format[pos]))
+            pos++;
+        if (pos < format.size() && format[pos] == '.') {
+            pos++;
+            while (pos < format.size() && isDigit(format[pos]))
+                pos++;
+        }
+        while (pos < format.size() && isLengthModifier(format[pos]))
+            pos++;
+
+        if (pos == format.size() || !isConversion(format[pos])) {
+            // Positional arguments, '*' width or precision, or just a broken format string. Leave it all to fmt.
+            _fallback = true;
+            _segments.clear();
+            return;
+        }
+
+        pos++;
+        _segments.push_back({format.substr(literalStart, specStart - literalStart),
+                             format.substr(specStart, pos - specStart)});
+        _slotCount++;
+        literalStart = pos;
+    }
+
+    if (literalStart < format.size())
+        _segments.push_back({format.substr(literalStart), {}});
+}
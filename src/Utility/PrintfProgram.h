@@ -0,0 +1,96 @@
+#pragma once
+
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "Utility/Format.h"
+
+/**
+ * Printf-style format string, pre-parsed into literal spans and argument slots.
+ *
+ * Formatting through `PrintfProgram` produces exactly the same output as `fmt::sprintf` with the same format string
+ * and arguments, but doesn't reparse the format string on each call. `%s`, `%d`/`%i` and `%u` with matching argument
+ * types are formatted directly into the output buffer, everything else goes through `fmt::sprintf` one conversion at
+ * a time. Format strings that use positional arguments or `*` width / precision, or that don't parse, are always
+ * passed to `fmt::sprintf` as a whole, so that the errors are also the same.
+ */
+class PrintfProgram {
+ public:
+    PrintfProgram() = default;
+    explicit PrintfProgram(std::string_view format);
+
+    template<class... Args>
+    void formatTo(fmt::memory_buffer *out, const Args &... args) const {
+        if (_fallback || _slotCount > static_cast<int>(sizeof...(Args))) {
+            std::string result = fmt::sprintf(_format, args...);
+            out->append(result.data(), result.data() + result.size());
+            return;
+        }
+
+        int slot = 0;
+        for (const Segment &segment : _segments) {
+            out->append(segment.literal.data(), segment.literal.data() + segment.literal.size());
+            if (segment.spec.empty())
+                continue;
+
+            [[maybe_unused]] int i = 0;
+            ((i++ == slot ? formatArg(out, segment.spec, args) : void()), ...);
+            slot++;
+        }
+    }
+
+    template<class... Args>
+    [[nodiscard]] std::string format(const Args &... args) const {
+        fmt::memory_buffer buffer;
+        formatTo(&buffer, args...);
+        return fmt::to_string(buffer);
+    }
+
+ private:
+    struct Segment {
+        std::string_view literal; // Literal text to output.
+        std::string_view spec; // Conversion spec to format the next argument with, empty if none.
+    };
+
+    template<class T>
+    static void formatArg(fmt::memory_buffer *out, std::string_view spec, const T &arg) {
+        using Arg = std::decay_t<T>;
+        constexpr bool isChar = std::is_same_v<Arg, char> || std::is_same_v<Arg, signed char> ||
+                                std::is_same_v<Arg, unsigned char>;
+        constexpr bool isInteger = std::is_integral_v<Arg> && !std::is_same_v<Arg, bool> && !isChar;
+
+        if constexpr (std::is_same_v<Arg, std::string> || std::is_same_v<Arg, std::string_view>) {
+            if (spec == "%s") {
+                out->append(arg.data(), arg.data() + arg.size());
+                return;
+            }
+        } else if constexpr (std::is_same_v<Arg, const char *> || std::is_same_v<Arg, char *>) {
+            if (spec == "%s" && arg) {
+                out->append(arg, arg + std::char_traits<char>::length(arg));
+                return;
+            }
+        } else if constexpr (isInteger && std::is_signed_v<Arg>) {
+            if (spec == "%d" || spec == "%i") {
+                fmt::format_to(std::back_inserter(*out), "{}", arg);
+                return;
+            }
+        } else if constexpr (isInteger && std::is_unsigned_v<Arg>) {
+            if (spec == "%u") {
+                fmt::format_to(std::back_inserter(*out), "{}", arg);
+                return;
+            }
+        }
+
+        std::string result = fmt::sprintf(spec, arg);
+        out->append(result.data(), result.data() + result.size());
+    }
+
+ private:
+    std::string_view _format;
+    std::vector<Segment> _segments;
+    int _slotCount = 0;
+    bool _fallback = false;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * FIFO queue backed by a ring buffer that grows when full, a drop-in for `std::queue` in hot paths.
+ *
+ * Unlike `std::queue` over a `std::deque`, this one doesn't allocate or free anything in steady state - storage is
+ * only reallocated when the queue outgrows its capacity, and is never shrunk. `clear` and `swap` keep the storage
+ * too.
+ *
+ * @tparam T                            Element type, must be default-constructible.
+ */
+template<class T>
+class RingQueue {
+ public:
+    /**
+     * @param capacity                  Initial capacity, must be a power of two.
+     */
+    explicit RingQueue(size_t capacity = 16) : _storage(capacity) {
+        assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    }
+
+    [[nodiscard]] bool empty() const {
+        return _size == 0;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return _size;
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return _storage.size();
+    }
+
+    [[nodiscard]] T &front() {
+        assert(!empty());
+        return _storage[_head];
+    }
+
+    [[nodiscard]] const T &front() const {
+        assert(!empty());
+        return _storage[_head];
+    }
+
+    void push(T value) {
+        if (_size == _storage.size())
+            grow();
+
+        _storage[(_head + _size) & (_storage.size() - 1)] = std::move(value);
+        _size++;
+    }
+
+    void pop() {
+        assert(!empty());
+        _storage[_head] = T();
+        _head = (_head + 1) & (_storage.size() - 1);
+        _size--;
+    }
+
+    void clear() {
+        while (!empty())
+            pop();
+        _head = 0;
+    }
+
+    void swap(RingQueue &other) {
+        _storage.swap(other._storage);
+        std::swap(_head, other._head);
+        std::swap(_size, other._size);
+    }
+
+ private:
+    void grow() {
+        std::vector<T> storage(_storage.size() * 2);
+        for (size_t i = 0; i < _size; i++)
+            storage[i] = std::move(_storage[(_head + i) & (_storage.size() - 1)]);
+        _storage.swap(storage);
+        _head = 0;
+    }
+
+ private:
+    std::vector<T> _storage;
+    size_t _head = 0;
+    size_t _size = 0;
+};
@@ -25,6 +25,15 @@ size_t BlobInputStream::read(void *data, size_t size) {
     return result;
 }
 
+std::optional<std::span<const std::byte>> BlobInputStream::readView(size_t size) {
+    assert(_pos);
+
+    size_t result = std::min(size, remaining());
+    std::span<const std::byte> view(reinterpret_cast<const std::byte *>(_pos), result);
+    _pos += result;
+    return view;
+}
+
 size_t BlobInputStream::skip(size_t size) {
     assert(_pos);
 
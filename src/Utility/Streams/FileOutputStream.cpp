@@ -1,10 +1,23 @@
 #include "FileOutputStream.h"
 
 #include <cassert>
+#include <cstring>
+#include <new>
+#include <utility>
 
 #include "Utility/Exception.h"
 #include "Utility/UnicodeCrt.h"
 
+#ifndef _WINDOWS
+#   include <sys/uio.h>
+#   include <unistd.h>
+#   include <cerrno>
+#endif
+
+void FileOutputStream::AlignedDeleter::operator()(char *buffer) const {
+    ::operator delete[](buffer, std::align_val_t(BUFFER_ALIGNMENT));
+}
+
 FileOutputStream::FileOutputStream(std::string_view path) {
     open(path);
 }
@@ -22,18 +35,32 @@ void FileOutputStream::open(std::string_view path) {
     _file = fopen(_path.c_str(), "wb");
     if (!_file)
         Exception::throwFromErrno(_path);
+
+    // We're doing our own buffering, and on POSIX we're also writing directly into the file descriptor.
+    setvbuf(_file, nullptr, _IONBF, 0);
 }
 
 void FileOutputStream::write(const void *data, size_t size) {
     assert(isOpen()); // Writing into a closed stream is UB.
 
-    if (fwrite(data, size, 1, _file) != 1)
-        Exception::throwFromErrno(_path);
+    if (size == 0)
+        return; // `data` might be null, and passing null to memcpy is UB even for zero sizes.
+
+    if (size >= BUFFER_SIZE - _bufferSize) {
+        flushBuffer(data, size);
+        return;
+    }
+
+    if (!_buffer)
+        _buffer.reset(static_cast<char *>(::operator new[](BUFFER_SIZE, std::align_val_t(BUFFER_ALIGNMENT))));
+    memcpy(_buffer.get() + _bufferSize, data, size);
+    _bufferSize += size;
 }
 
 void FileOutputStream::flush() {
     assert(isOpen()); // Flushing a closed stream is UB.
 
+    flushBuffer();
     if (fflush(_file) != 0)
         Exception::throwFromErrno(_path);
 }
@@ -46,9 +73,56 @@ void FileOutputStream::closeInternal(bool canThrow) {
     if (!isOpen())
         return;
 
+    try {
+        flushBuffer();
+    } catch (...) {
+        fclose(_file);
+        _file = nullptr;
+        _bufferSize = 0;
+        if (canThrow)
+            throw;
+        return; // TODO(captainurist): !canThrow => log OR attach
+    }
+
     int status = fclose(_file);
     _file = nullptr;
     if (status != 0 && canThrow)
         Exception::throwFromErrno(_path);
     // TODO(captainurist): !canThrow => log OR attach
 }
+
+void FileOutputStream::flushBuffer(const void *extraData, size_t extraSize) {
+    size_t bufferSize = std::exchange(_bufferSize, 0);
+    if (bufferSize == 0 && extraSize == 0)
+        return;
+
+#ifdef _WINDOWS
+    // No writev on Windows, but the FILE is unbuffered, so these go straight to WriteFile.
+    if (bufferSize > 0 && fwrite(_buffer.get(), bufferSize, 1, _file) != 1)
+        Exception::throwFromErrno(_path);
+    if (extraSize > 0 && fwrite(extraData, extraSize, 1, _file) != 1)
+        Exception::throwFromErrno(_path);
+#else
+    int fd = fileno(_file);
+    iovec chunks[2] = {{_buffer.get(), bufferSize}, {const_cast<void *>(extraData), extraSize}};
+    iovec *chunk = bufferSize > 0 ? chunks : chunks + 1;
+    iovec *end = extraSize > 0 ? chunks + 2 : chunks + 1;
+    while (chunk != end) {
+        ssize_t written = writev(fd, chunk, end - chunk);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            Exception::throwFromErrno(_path);
+        }
+
+        // Partial write, advance through the chunks.
+        size_t remaining = written;
+        while (chunk != end && remaining >= chunk->iov_len)
+            remaining -= (chunk++)->iov_len;
+        if (chunk != end) {
+            chunk->iov_base = static_cast<char *>(chunk->iov_base) + remaining;
+            chunk->iov_len -= remaining;
+        }
+    }
+#endif
+}
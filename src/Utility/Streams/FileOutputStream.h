@@ -1,13 +1,24 @@
 #pragma once
 
 #include <cstdio>
+#include <memory>
 #include <string>
 #include <string_view>
 
 #include "OutputStream.h"
 
+/**
+ * Output stream that writes into a file.
+ *
+ * The stream does its own buffering with a large aligned buffer instead of relying on the `FILE` one. Small writes
+ * are coalesced in the buffer, and writes that don't fit are sent down together with the buffered data as a single
+ * vectored write, without copying them into the buffer first.
+ */
 class FileOutputStream : public OutputStream {
  public:
+    static constexpr size_t BUFFER_SIZE = 256 * 1024;
+    static constexpr size_t BUFFER_ALIGNMENT = 4096;
+
     FileOutputStream() = default;
     explicit FileOutputStream(std::string_view path);
     virtual ~FileOutputStream();
@@ -23,14 +34,17 @@ class FileOutputStream : public OutputStream {
     virtual void flush() override;
     virtual void close() override;
 
-    [[nodiscard]] FILE *handle() {
-        return _file;
-    }
-
  private:
+    struct AlignedDeleter {
+        void operator()(char *buffer) const;
+    };
+
     void closeInternal(bool canThrow);
+    void flushBuffer(const void *extraData = nullptr, size_t extraSize = 0);
 
  private:
     std::string _path;
     FILE *_file = nullptr;
+    std::unique_ptr<char[], AlignedDeleter> _buffer; // Allocated on first write.
+    size_t _bufferSize = 0; // Number of bytes in `_buffer`.
 };
@@ -11,6 +11,17 @@ void InputStream::readOrFail(void *data, size_t size) {
         throw Exception("Failed to read the requested number of bytes from a stream, requested {}, got {}", size, bytes);
 }
 
+std::optional<std::span<const std::byte>> InputStream::readView(size_t size) {
+    return std::nullopt;
+}
+
+std::optional<std::span<const std::byte>> InputStream::readViewOrFail(size_t size) {
+    std::optional<std::span<const std::byte>> result = readView(size);
+    if (result && result->size() != size)
+        throw Exception("Failed to read the requested number of bytes from a stream, requested {}, got {}", size, result->size());
+    return result;
+}
+
 std::string InputStream::readAll(size_t maxSize) {
     size_t chunkSize = 1024;
     size_t maxChunkSize = 16 * 1024 * 1024;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <optional>
+#include <span>
 #include <string>
 
 /**
@@ -33,6 +35,28 @@ class InputStream {
      */
     void readOrFail(void *data, size_t size);
 
+    /**
+     * Zero-copy version of `read`, supported only by the streams that read from memory.
+     *
+     * @param size                      Number of bytes to read.
+     * @return                          View into the memory that the stream is reading from, holding the read data.
+     *                                  A view that's shorter than `size` signals end of stream. The view stays
+     *                                  valid for as long as the underlying memory does. If zero-copy reads are not
+     *                                  supported, returns `std::nullopt` and doesn't change stream position.
+     * @throws Exception                On error.
+     */
+    [[nodiscard]] virtual std::optional<std::span<const std::byte>> readView(size_t size);
+
+    /**
+     * Same as `readView`, but fails with an exception if there is not enough data in the stream.
+     *
+     * @param size                      Number of bytes to read.
+     * @return                          View into the memory that the stream is reading from, holding the read data,
+     *                                  or `std::nullopt` if zero-copy reads are not supported.
+     * @throws Exception                On error.
+     */
+    [[nodiscard]] std::optional<std::span<const std::byte>> readViewOrFail(size_t size);
+
     /**
      * Reads everything that's in this stream, up to `maxSize` bytes.
      *
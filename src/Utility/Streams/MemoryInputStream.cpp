@@ -30,6 +30,15 @@ size_t MemoryInputStream::read(void *data, size_t size) {
     return result;
 }
 
+std::optional<std::span<const std::byte>> MemoryInputStream::readView(size_t size) {
+    assert(_pos);
+
+    size_t result = std::min(size, static_cast<size_t>(_end - _pos));
+    std::span<const std::byte> view(reinterpret_cast<const std::byte *>(_pos), result);
+    _pos += result;
+    return view;
+}
+
 size_t MemoryInputStream::skip(size_t size) {
     assert(_pos);
 
@@ -12,6 +12,7 @@ class MemoryInputStream: public InputStream {
 
     virtual size_t read(void *data, size_t size) override;
     virtual size_t skip(size_t size) override;
+    [[nodiscard]] virtual std::optional<std::span<const std::byte>> readView(size_t size) override;
     virtual void close() override;
 
     void seek(size_t pos);
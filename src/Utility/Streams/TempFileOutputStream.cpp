@@ -1,7 +1,8 @@
 #include "TempFileOutputStream.h"
 
-#include <random>
+#include <exception>
 #include <filesystem>
+#include <random>
 
 TempFileOutputStream::TempFileOutputStream(std::string_view path) {
     open(path);
@@ -25,10 +26,27 @@ void TempFileOutputStream::close() {
     closeInternal();
 }
 
+void TempFileOutputStream::discard() {
+    if (isOpen()) {
+        try {
+            base_type::close();
+        } catch (const std::exception &) {
+            // The file is deleted anyway.
+        }
+    }
+
+    if (!_tmpPath.empty()) {
+        std::error_code ec;
+        std::filesystem::remove(_tmpPath, ec);
+        _tmpPath.clear();
+    }
+}
+
 void TempFileOutputStream::closeInternal() {
     if (!isOpen())
         return;
 
     base_type::close();
     std::filesystem::rename(_tmpPath, _targetPath);
+    _tmpPath.clear();
 }
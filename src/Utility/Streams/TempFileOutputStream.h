@@ -17,6 +17,12 @@ class TempFileOutputStream : public FileOutputStream {
 
     virtual void close() override;
 
+    /**
+     * Closes this stream & deletes the temporary file, leaving the target file untouched. Can also be used to clean up
+     * after a failed `close`.
+     */
+    void discard();
+
  private:
     void closeInternal();
 
@@ -51,3 +51,42 @@ UNIT_TEST(FileInputStream, Skip) {
 
     remove(tmpfile);
 }
+
+UNIT_TEST(FileOutputStream, BufferedWrites) {
+    const char *tmpfile = "tmp_test.txt";
+
+    // Mix of small writes that get buffered and large writes that go through the vectored path.
+    std::string expected;
+    FileOutputStream out(tmpfile);
+    for (int i = 0; i < 10; i++) {
+        std::string small(i * 100 + 1, static_cast<char>('a' + i));
+        std::string large(FileOutputStream::BUFFER_SIZE + i * 1000, static_cast<char>('A' + i));
+        out.write(small.data(), small.size());
+        out.write(large.data(), large.size());
+        expected += small;
+        expected += large;
+    }
+    out.close();
+
+    FileInputStream in(tmpfile);
+    EXPECT_EQ(in.readAll(), expected);
+    in.close();
+
+    remove(tmpfile);
+}
+
+UNIT_TEST(FileOutputStream, EmptyWrites) {
+    const char *tmpfile = "tmp_test.txt";
+
+    FileOutputStream out(tmpfile);
+    out.write(nullptr, 0);
+    out.write("12", 2);
+    out.write(nullptr, 0);
+    out.close();
+
+    FileInputStream in(tmpfile);
+    EXPECT_EQ(in.readAll(), "12");
+    in.close();
+
+    remove(tmpfile);
+}
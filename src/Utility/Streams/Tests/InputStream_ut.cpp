@@ -1,6 +1,7 @@
 #include "Testing/Unit/UnitTest.h"
 
 #include "Utility/Streams/MemoryInputStream.h"
+#include "Utility/Exception.h"
 
 UNIT_TEST(InputStream, ReadAll) {
     std::string largeString(10000, 'a');
@@ -9,3 +10,20 @@ UNIT_TEST(InputStream, ReadAll) {
     std::string resultingString = input.readAll();
     EXPECT_EQ(largeString, resultingString); // There was a bug in readAll resulting in failures on large files.
 }
+
+UNIT_TEST(InputStream, ReadView) {
+    std::string data = "0123456789";
+    MemoryInputStream input(data.data(), data.size());
+
+    std::optional<std::span<const std::byte>> view = input.readView(4);
+    EXPECT_TRUE(view);
+    EXPECT_EQ(view->size(), 4);
+    EXPECT_EQ(static_cast<const void *>(view->data()), static_cast<const void *>(data.data()));
+
+    view = input.readView(10);
+    EXPECT_TRUE(view);
+    EXPECT_EQ(view->size(), 6); // Short view at the end of the stream.
+    EXPECT_EQ(static_cast<const void *>(view->data()), static_cast<const void *>(data.data() + 4));
+
+    EXPECT_THROW((void) input.readViewOrFail(1), Exception);
+}
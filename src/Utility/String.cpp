@@ -1,18 +1,52 @@
 #include "String.h"
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <algorithm>
 
 #include "Format.h"
+#include "Hash.h"
 
 static inline unsigned char asciiToLower(unsigned char c) {
     return ((((c) >= 'A') && ((c) <= 'Z')) ? ((c) - 'A' + 'a') : (c));
 }
 
+static inline uint64_t loadWord(const char *p) {
+    uint64_t result;
+    memcpy(&result, p, sizeof(result));
+    return result;
+}
+
+static inline void storeWord(char *p, uint64_t word) {
+    memcpy(p, &word, sizeof(word));
+}
+
+static inline uint64_t asciiToLowerWord(uint64_t word) {
+    // Lowercases all 8 chars in a word at once. Chars with the high bit set are left untouched, same as in
+    // `asciiToLower`. None of the per-byte additions below can carry into the next byte.
+    constexpr uint64_t ones = 0x0101010101010101ull;
+    uint64_t heptets = word & (0x7F * ones);
+    uint64_t geA = heptets + (0x80 - 'A') * ones; // High bit set for chars >= 'A'.
+    uint64_t gtZ = heptets + (0x7F - 'Z') * ones; // High bit set for chars > 'Z'.
+    uint64_t upper = ~word & (geA ^ gtZ) & (0x80 * ones);
+    return word | (upper >> 2); // 0x80 >> 2 == 0x20, the difference between 'A' and 'a'.
+}
+
 static int asciiCaseInsensitiveCompare(const char *l, const char *r, size_t size) {
     // There is no C api for ascii-only strnicmp, so we have to roll out our own.
     // The difference from the original strnicmp is that we don't check for null terminators.
+
+    // Skip the matching prefix a word at a time, the mismatching word is then handled by the char loop below.
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), l += sizeof(uint64_t), r += sizeof(uint64_t)) {
+        uint64_t lw = loadWord(l);
+        uint64_t rw = loadWord(r);
+        if (lw != rw && asciiToLowerWord(lw) != asciiToLowerWord(rw))
+            break;
+    }
+
     const unsigned char *ul = reinterpret_cast<const unsigned char *>(l);
     const unsigned char *ur = reinterpret_cast<const unsigned char *>(r);
 
@@ -44,7 +78,14 @@ std::vector<char *> tokenize(char *input, const char separator) {
 
 std::string toLower(std::string_view text) {
     std::string result(text);
-    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+
+    char *pos = result.data();
+    char *end = pos + result.size();
+    for (; end - pos >= static_cast<ptrdiff_t>(sizeof(uint64_t)); pos += sizeof(uint64_t))
+        storeWord(pos, asciiToLowerWord(loadWord(pos)));
+    for (; pos != end; pos++)
+        *pos = static_cast<char>(asciiToLower(static_cast<unsigned char>(*pos)));
+
     return result;
 }
 
@@ -77,6 +118,14 @@ bool iless(std::string_view a, std::string_view b) {
     return a.size() < b.size();
 }
 
+size_t ihash(std::string_view s) {
+    // FNV-1a over lowercased chars.
+    uint64_t result = FNV1A_OFFSET_BASIS;
+    for (char c : s)
+        result = fnv1aHashByte(result, asciiToLower(static_cast<unsigned char>(c)));
+    return static_cast<size_t>(result);
+}
+
 bool iequalsAscii(std::u8string_view a, std::u8string_view b) {
     return iequals(toCharStringView(a), toCharStringView(b));
 }
@@ -44,12 +44,38 @@ bool iless(std::string_view a, std::string_view b);
 bool iequalsAscii(std::u8string_view a, std::u8string_view b);
 bool ilessAscii(std::u8string_view a, std::u8string_view b);
 
+/**
+ * @param s                             String to hash.
+ * @return                              Ascii case-insensitive hash of the provided string, consistent with `iequals`.
+ */
+size_t ihash(std::string_view s);
+
 struct ILess {
     bool operator()(std::string_view a, std::string_view b) const {
         return iless(a, b);
     }
 };
 
+/**
+ * Case-insensitive hash & equality, for unordered containers keyed by names. Both are transparent, so
+ * `std::string_view` lookups into a container keyed by `std::string` don't allocate.
+ */
+struct IHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view s) const {
+        return ihash(s);
+    }
+};
+
+struct IEqual {
+    using is_transparent = void;
+
+    bool operator()(std::string_view a, std::string_view b) const {
+        return iequals(a, b);
+    }
+};
+
 /**
  * @param s                             String to transform.
  * @param placeholder                   Character to replace all non-printable chars with.
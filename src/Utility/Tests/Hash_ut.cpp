@@ -0,0 +1,34 @@
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Utility/Hash.h"
+#include "Utility/String.h"
+
+UNIT_TEST(Hash, Fnv1aKnownValues) {
+    // Reference values from the FNV spec.
+    EXPECT_EQ(fnv1aHash(""), 0xcbf29ce484222325ull);
+    EXPECT_EQ(fnv1aHash("a"), 0xaf63dc4c8601ec8cull);
+    EXPECT_EQ(fnv1aHash("foobar"), 0x85944171f73967e8ull);
+}
+
+UNIT_TEST(Hash, Fnv1aChaining) {
+    EXPECT_EQ(fnv1aHash("bar", fnv1aHash("foo")), fnv1aHash("foobar"));
+    EXPECT_EQ(fnv1aHash("", fnv1aHash("foobar")), fnv1aHash("foobar"));
+}
+
+UNIT_TEST(Hash, IhashIsFnv1aOfLowercased) {
+    EXPECT_EQ(ihash("FooBar"), static_cast<size_t>(fnv1aHash("foobar")));
+    EXPECT_EQ(ihash("FOOBAR"), ihash("foobar"));
+}
+
+UNIT_TEST(Hash, Murmur3KnownValues) {
+    // Reference values from the original MurmurHash3_x64_128 implementation.
+    auto hash = [](std::string_view s) { return murmur3Hash128(s.data(), s.size()); };
+    EXPECT_EQ(hash(""), (std::array<uint64_t, 2>{0, 0}));
+    EXPECT_EQ(hash("hello"), (std::array<uint64_t, 2>{0xcbd8a7b341bd9b02ull, 0x5b1e906a48ae1d19ull}));
+    EXPECT_EQ(hash("The quick brown fox jumps over the lazy dog"),
+              (std::array<uint64_t, 2>{0xe34bbc7bbc071b6cull, 0x7a433ca9c49a9347ull}));
+}
@@ -0,0 +1,39 @@
+#include <string>
+#include <string_view>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Utility/LruCache.h"
+
+UNIT_TEST(LruCache, Eviction) {
+    LruCache<int, std::string> cache(2);
+    cache.insert(1, "one");
+    cache.insert(2, "two");
+    EXPECT_EQ(cache.size(), 2);
+
+    // Touch 1 so that 2 becomes the least recently used.
+    ASSERT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(*cache.find(1), "one");
+
+    cache.insert(3, "three");
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(cache.find(2), nullptr);
+    EXPECT_NE(cache.find(3), nullptr);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.find(1), nullptr);
+}
+
+UNIT_TEST(LruCache, HeterogeneousLookup) {
+    struct Hash : std::hash<std::string_view> {
+        using is_transparent = void;
+    };
+
+    LruCache<std::string, int, Hash, std::equal_to<>> cache(4);
+    cache.insert("abc", 1);
+    ASSERT_NE(cache.find(std::string_view("abc")), nullptr);
+    EXPECT_EQ(*cache.find(std::string_view("abc")), 1);
+    EXPECT_EQ(cache.find(std::string_view("abd")), nullptr);
+}
@@ -0,0 +1,54 @@
+#include <string>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Utility/PrintfProgram.h"
+
+template<class... Args>
+static void checkSameAsSprintf(const char *format, const Args &... args) {
+    EXPECT_EQ(PrintfProgram(format).format(args...), fmt::sprintf(format, args...)) << format;
+}
+
+UNIT_TEST(PrintfProgram, Literals) {
+    checkSameAsSprintf("");
+    checkSameAsSprintf("Nothing to format");
+    checkSameAsSprintf("100%%");
+    checkSameAsSprintf("%%%%");
+    checkSameAsSprintf("%% in the middle %%.");
+}
+
+UNIT_TEST(PrintfProgram, FastPaths) {
+    checkSameAsSprintf("%s stole %s!", std::string("Zoltan"), "a ring");
+    checkSameAsSprintf("Recovery time: %d", -15);
+    checkSameAsSprintf("%i%i", 1, 2);
+    checkSameAsSprintf("%u gold", 100u);
+    checkSameAsSprintf("%s: %lu out of %lu", "Quests", 3, 10);
+}
+
+UNIT_TEST(PrintfProgram, MismatchedTypes) {
+    checkSameAsSprintf("%u", -1);
+    checkSameAsSprintf("%d", 4294967295u);
+    checkSameAsSprintf("%s", 42);
+    checkSameAsSprintf("%d", 'a');
+    checkSameAsSprintf("%s", static_cast<const char *>(nullptr));
+}
+
+UNIT_TEST(PrintfProgram, ComplexSpecs) {
+    checkSameAsSprintf("%02d:%02d %s", 7, 5, "am");
+    checkSameAsSprintf("%-8s|", "left");
+    checkSameAsSprintf("%.2f%%", 12.345);
+    checkSameAsSprintf("%5.1f", 3.14159);
+    checkSameAsSprintf("%x %X %o", 255, 255, 8);
+    checkSameAsSprintf("%c", 'z');
+}
+
+UNIT_TEST(PrintfProgram, Fallback) {
+    checkSameAsSprintf("%*d", 5, 42);
+    checkSameAsSprintf("%2$s %1$s", "world", "hello");
+    checkSameAsSprintf("Extra args are ignored", 1, 2);
+}
+
+UNIT_TEST(PrintfProgram, Errors) {
+    EXPECT_ANY_THROW((void) PrintfProgram("%d %d").format(1));
+    EXPECT_ANY_THROW((void) PrintfProgram("Trailing %").format(1));
+}
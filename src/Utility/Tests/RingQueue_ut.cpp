@@ -0,0 +1,70 @@
+#include <string>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Utility/RingQueue.h"
+
+UNIT_TEST(RingQueue, Fifo) {
+    RingQueue<int> queue(4);
+    EXPECT_TRUE(queue.empty());
+
+    // Push & pop enough to wrap around a few times.
+    int next = 0;
+    for (int i = 0; i < 20; i++) {
+        queue.push(i * 2);
+        queue.push(i * 2 + 1);
+        EXPECT_EQ(queue.front(), next);
+        queue.pop();
+        next++;
+    }
+    EXPECT_EQ(queue.size(), 20);
+    EXPECT_EQ(queue.capacity(), 32);
+
+    while (!queue.empty()) {
+        EXPECT_EQ(queue.front(), next);
+        queue.pop();
+        next++;
+    }
+    EXPECT_EQ(next, 40);
+}
+
+UNIT_TEST(RingQueue, GrowWrapped) {
+    RingQueue<std::string> queue(4);
+    queue.push("a");
+    queue.push("b");
+    queue.push("c");
+    queue.pop();
+    queue.pop();
+    queue.push("d");
+    queue.push("e");
+    queue.push("f");
+    queue.push("g"); // Grows while the contents are wrapped around the end of the buffer.
+    EXPECT_EQ(queue.capacity(), 8);
+
+    for (const char *expected : {"c", "d", "e", "f", "g"}) {
+        ASSERT_FALSE(queue.empty());
+        EXPECT_EQ(queue.front(), expected);
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+UNIT_TEST(RingQueue, ClearAndSwap) {
+    RingQueue<int> a(4);
+    RingQueue<int> b(4);
+    for (int i = 0; i < 10; i++)
+        a.push(i);
+
+    a.swap(b);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(b.size(), 10);
+    EXPECT_EQ(b.front(), 0);
+
+    size_t capacity = b.capacity();
+    b.clear();
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(b.capacity(), capacity);
+
+    b.push(42);
+    EXPECT_EQ(b.front(), 42);
+}
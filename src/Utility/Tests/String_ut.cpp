@@ -1,3 +1,6 @@
+#include <string>
+#include <unordered_map>
+
 #include "Testing/Unit/UnitTest.h"
 
 #include "Utility/String.h"
@@ -24,6 +27,44 @@ UNIT_TEST(String, iless) {
     EXPECT_TRUE(iless("@", "`"));
 }
 
+UNIT_TEST(String, LongStrings) {
+    // Strings longer than a word go through the word-at-a-time code path.
+    EXPECT_TRUE(iequals("Spell96_Sprite_Frame", "SPELL96_sprite_FRAME"));
+    EXPECT_FALSE(iequals("Spell96_Sprite_Frame", "Spell96_Sprite_Frama"));
+    EXPECT_FALSE(iequals("@@@@@@@@[[[[", "````````{{{{"));
+    EXPECT_TRUE(iless("Dec01_frame_a", "DEC01_FRAME_B"));
+    EXPECT_FALSE(iless("Dec01_frame_b", "DEC01_FRAME_A"));
+    EXPECT_TRUE(iless("Dec01_frame", "DEC01_FRAME_A"));
+    EXPECT_EQ(toLower("Mixed_CASE_String_\xC0\xDA"), "mixed_case_string_\xC0\xDA");
+
+    // Check every char against every char, at every position within a word.
+    for (int a = 0; a < 256; a++) {
+        for (int b = 0; b < 256; b++) {
+            char ca = static_cast<char>(a), cb = static_cast<char>(b);
+            char la = (a >= 'A' && a <= 'Z') ? static_cast<char>(a + 32) : ca;
+            char lb = (b >= 'A' && b <= 'Z') ? static_cast<char>(b + 32) : cb;
+            for (size_t pos : {0, 7}) {
+                std::string sa(8, 'x'), sb(8, 'x');
+                sa[pos] = ca;
+                sb[pos] = cb;
+                EXPECT_EQ(iequals(sa, sb), la == lb);
+                EXPECT_EQ(iless(sa, sb), static_cast<unsigned char>(la) < static_cast<unsigned char>(lb));
+            }
+        }
+    }
+}
+
+UNIT_TEST(String, ihash) {
+    EXPECT_EQ(ihash("Tree60"), ihash("tREE60"));
+    EXPECT_EQ(ihash(""), ihash(""));
+    EXPECT_NE(ihash("@"), ihash("`"));
+
+    std::unordered_map<std::string, int, IHash, IEqual> map;
+    map.emplace("Spell96", 1);
+    EXPECT_EQ(map.find(std::string_view("SPELL96"))->second, 1);
+    EXPECT_EQ(map.find(std::string_view("spell9")), map.end());
+}
+
 UNIT_TEST(String, Printable) {
     EXPECT_EQ(toPrintable("123\xFF", '.'), "123.");
 }
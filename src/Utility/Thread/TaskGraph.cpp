@@ -0,0 +1,151 @@
+#include "TaskGraph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "ThreadPool.h"
+
+TaskGraph::TaskId TaskGraph::add(std::string_view name, std::function<void()> fn,
+                                 const std::vector<TaskId> &dependencies) {
+    return addInternal(name, std::move(fn), dependencies, false);
+}
+
+TaskGraph::TaskId TaskGraph::addPinned(std::string_view name, std::function<void()> fn,
+                                       const std::vector<TaskId> &dependencies) {
+    return addInternal(name, std::move(fn), dependencies, true);
+}
+
+TaskGraph::TaskId TaskGraph::addInternal(std::string_view name, std::function<void()> fn,
+                                         const std::vector<TaskId> &dependencies, bool pinned) {
+    TaskId result = _tasks.size();
+
+    Task &task = _tasks.emplace_back();
+    task.name = name;
+    task.fn = std::move(fn);
+    task.pinned = pinned;
+    for (TaskId dependency : dependencies) {
+        assert(dependency >= 0 && dependency < result); // Tasks must be added in topological order.
+        task.dependencies.push_back(dependency);
+        _tasks[dependency].dependents.push_back(result);
+    }
+
+    return result;
+}
+
+void TaskGraph::execute(TaskId id) {
+    Clock::time_point start = Clock::now();
+    _tasks[id].fn();
+    _tasks[id].duration = Clock::now() - start;
+}
+
+void TaskGraph::run(ThreadPool *pool) {
+    Clock::time_point start = Clock::now();
+    _exception = nullptr;
+
+    if (!pool || pool->isSerial()) {
+        for (TaskId id = 0; id < _tasks.size(); id++)
+            execute(id);
+        _totalTime = Clock::now() - start;
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<TaskId> pinnedQueue;
+    int inFlight = 0; // Tasks that were scheduled, but haven't finished yet.
+
+    std::function<void(TaskId)> schedule;
+    auto finish = [&](TaskId id, std::exception_ptr exception) {
+        std::lock_guard lock(mutex);
+        if (exception && !_exception)
+            _exception = exception;
+        if (!_exception)
+            for (TaskId dependent : _tasks[id].dependents)
+                if (--_tasks[dependent].pendingDependencies == 0)
+                    schedule(dependent);
+        inFlight--;
+        condition.notify_all();
+    };
+    auto executeAndFinish = [&](TaskId id) {
+        std::exception_ptr exception;
+        try {
+            execute(id);
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        finish(id, exception);
+    };
+
+    // Called under the lock.
+    schedule = [&](TaskId id) {
+        inFlight++;
+        if (_tasks[id].pinned) {
+            pinnedQueue.push_back(id);
+        } else {
+            pool->post([&, id] { executeAndFinish(id); });
+        }
+    };
+
+    {
+        std::lock_guard lock(mutex);
+        for (Task &task : _tasks)
+            task.pendingDependencies = task.dependencies.size();
+        for (TaskId id = 0; id < _tasks.size(); id++)
+            if (_tasks[id].pendingDependencies == 0)
+                schedule(id);
+    }
+
+    std::unique_lock lock(mutex);
+    while (inFlight > 0) {
+        if (pinnedQueue.empty()) {
+            condition.wait(lock);
+            continue;
+        }
+
+        TaskId id = pinnedQueue.front();
+        pinnedQueue.pop_front();
+        if (_exception) {
+            inFlight--; // Don't start new tasks after a failure.
+            continue;
+        }
+
+        lock.unlock();
+        executeAndFinish(id);
+        lock.lock();
+    }
+    lock.unlock();
+
+    _totalTime = Clock::now() - start;
+    if (_exception)
+        std::rethrow_exception(_exception);
+}
+
+std::vector<TaskGraph::PathEntry> TaskGraph::criticalPath() const {
+    if (_tasks.empty())
+        return {};
+
+    // Tasks are in topological order, so a single forward pass is enough.
+    std::vector<Clock::duration> pathDuration(_tasks.size());
+    std::vector<TaskId> pathPrev(_tasks.size(), -1);
+    TaskId last = 0;
+    for (TaskId id = 0; id < _tasks.size(); id++) {
+        for (TaskId dependency : _tasks[id].dependencies) {
+            if (pathPrev[id] == -1 || pathDuration[dependency] > pathDuration[pathPrev[id]]) {
+                pathPrev[id] = dependency;
+            }
+        }
+        pathDuration[id] = _tasks[id].duration + (pathPrev[id] == -1 ? Clock::duration() : pathDuration[pathPrev[id]]);
+        if (pathDuration[id] > pathDuration[last])
+            last = id;
+    }
+
+    std::vector<PathEntry> result;
+    for (TaskId id = last; id != -1; id = pathPrev[id])
+        result.push_back({_tasks[id].name, _tasks[id].duration});
+    std::reverse(result.begin(), result.end());
+    return result;
+}
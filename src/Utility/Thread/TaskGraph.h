@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * Small task graph with explicit dependencies, meant for one-shot jobs like engine startup.
+ *
+ * Tasks are added in topological order - a task can only depend on the tasks that were added before it. Tasks that
+ * are not thread-safe can be pinned to the thread that calls `run`. Pinned tasks are executed one at a time, in the
+ * order their dependencies get satisfied, so they are also serialized with respect to each other.
+ *
+ * After the graph has run, per-task timings are available, and `criticalPath` can be used to find out which chain of
+ * tasks determined the total run time.
+ *
+ * Example usage:
+ * \code
+ * TaskGraph graph;
+ * TaskGraph::TaskId load = graph.add("load", [&] { data = load(); });
+ * graph.add("parse", [&] { parse(data); }, {load});
+ * graph.run(pool);
+ * \endcode
+ */
+class TaskGraph {
+ public:
+    using TaskId = int;
+    using Clock = std::chrono::steady_clock;
+
+    struct PathEntry {
+        std::string name;
+        Clock::duration duration = {};
+    };
+
+    TaskGraph() = default;
+
+    /**
+     * @param name                      Task name, for logging.
+     * @param fn                        Task function, called on one of the thread pool workers.
+     * @param dependencies              Tasks that must be finished before this task can start.
+     * @return                          Id of the added task.
+     */
+    TaskId add(std::string_view name, std::function<void()> fn, const std::vector<TaskId> &dependencies = {});
+
+    /**
+     * Same as `add`, but the task is called on the thread that calls `run`.
+     */
+    TaskId addPinned(std::string_view name, std::function<void()> fn, const std::vector<TaskId> &dependencies = {});
+
+    /**
+     * Runs all tasks & waits for them to finish. If a task throws, no new tasks are started, and the exception is
+     * rethrown once the tasks that are already running are done.
+     *
+     * @param pool                      Thread pool to use. If `nullptr` is passed, or if the pool is in serial mode,
+     *                                  then all tasks are run on the calling thread, in the order in which they were
+     *                                  added.
+     */
+    void run(ThreadPool *pool);
+
+    /**
+     * @return                          Wall time of the last `run`.
+     */
+    [[nodiscard]] Clock::duration totalTime() const {
+        return _totalTime;
+    }
+
+    /**
+     * @return                          Chain of dependent tasks with the longest total duration in the last `run`,
+     *                                  in execution order.
+     */
+    [[nodiscard]] std::vector<PathEntry> criticalPath() const;
+
+ private:
+    struct Task {
+        std::string name;
+        std::function<void()> fn;
+        std::vector<TaskId> dependencies;
+        std::vector<TaskId> dependents;
+        bool pinned = false;
+        int pendingDependencies = 0;
+        Clock::duration duration = {};
+    };
+
+    TaskId addInternal(std::string_view name, std::function<void()> fn, const std::vector<TaskId> &dependencies,
+                       bool pinned);
+    void execute(TaskId id);
+
+ private:
+    std::vector<Task> _tasks;
+    std::exception_ptr _exception; // First exception thrown by a task, guarded by the mutex in `run`.
+    Clock::duration _totalTime = {};
+};
@@ -0,0 +1,75 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Utility/Thread/TaskGraph.h"
+#include "Utility/Thread/ThreadPool.h"
+
+UNIT_TEST(TaskGraph, Dependencies) {
+    ThreadPool pool(4);
+    for (ThreadPool *p : {&pool, static_cast<ThreadPool *>(nullptr)}) {
+        std::vector<std::atomic<int>> done(6);
+        auto check = [&](std::initializer_list<int> deps) {
+            for (int dep : deps)
+                EXPECT_EQ(done[dep].load(), 1);
+        };
+
+        TaskGraph graph;
+        TaskGraph::TaskId a = graph.add("a", [&] { done[0]++; });
+        TaskGraph::TaskId b = graph.add("b", [&] { done[1]++; });
+        TaskGraph::TaskId c = graph.add("c", [&] { check({0, 1}); done[2]++; }, {a, b});
+        TaskGraph::TaskId d = graph.addPinned("d", [&] { check({0}); done[3]++; }, {a});
+        TaskGraph::TaskId e = graph.addPinned("e", [&] { check({2, 3}); done[4]++; }, {c, d});
+        graph.add("f", [&] { check({4}); done[5]++; }, {e});
+        graph.run(p);
+
+        for (const std::atomic<int> &value : done)
+            EXPECT_EQ(value.load(), 1);
+    }
+}
+
+UNIT_TEST(TaskGraph, PinnedRunOnCallingThread) {
+    ThreadPool pool(4);
+    std::thread::id mainThread = std::this_thread::get_id();
+
+    TaskGraph graph;
+    for (int i = 0; i < 20; i++) {
+        TaskGraph::TaskId worker = graph.add("worker", [] {});
+        graph.addPinned("pinned", [&] { EXPECT_EQ(std::this_thread::get_id(), mainThread); }, {worker});
+    }
+    graph.run(&pool);
+}
+
+UNIT_TEST(TaskGraph, Exceptions) {
+    ThreadPool pool(2);
+    std::atomic<bool> dependentRan = false;
+
+    TaskGraph graph;
+    TaskGraph::TaskId failing = graph.add("failing", [] { throw std::runtime_error("42"); });
+    graph.add("dependent", [&] { dependentRan = true; }, {failing});
+    EXPECT_THROW(graph.run(&pool), std::runtime_error);
+    EXPECT_FALSE(dependentRan);
+}
+
+UNIT_TEST(TaskGraph, CriticalPath) {
+    using namespace std::chrono_literals;
+
+    ThreadPool pool(4);
+    TaskGraph graph;
+    TaskGraph::TaskId fast = graph.add("fast", [] {});
+    TaskGraph::TaskId slow = graph.add("slow", [] { std::this_thread::sleep_for(20ms); });
+    graph.add("join", [] {}, {fast, slow});
+    graph.add("unrelated", [] {});
+    graph.run(&pool);
+
+    std::vector<TaskGraph::PathEntry> path = graph.criticalPath();
+    ASSERT_EQ(path.size(), 2);
+    EXPECT_EQ(path[0].name, "slow");
+    EXPECT_EQ(path[1].name, "join");
+    EXPECT_GE(path[0].duration, 20ms);
+    EXPECT_GE(graph.totalTime(), 20ms);
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Testing/Unit/UnitTest.h"
+
+#include "Utility/Thread/ThreadPool.h"
+
+UNIT_TEST(ThreadPool, Results) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.threadCount(), 4);
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; i++)
+        futures.push_back(pool.run([i] { return i * i; }));
+
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(futures[i].get(), i * i);
+}
+
+UNIT_TEST(ThreadPool, Exceptions) {
+    ThreadPool pool(2);
+    std::future<void> future = pool.run([] { throw std::runtime_error("42"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+UNIT_TEST(ThreadPool, DestructorWaits) {
+    std::atomic<int> counter = 0;
+    {
+        ThreadPool pool(3);
+        for (int i = 0; i < 50; i++)
+            (void) pool.run([&] { counter++; });
+    }
+    EXPECT_EQ(counter, 50);
+}
+
+UNIT_TEST(ThreadPool, ParallelFor) {
+    ThreadPool pool(4);
+
+    for (size_t count : {0, 1, 99, 100, 1001}) {
+        std::vector<int> hits(count, 0);
+        pool.parallelFor(count, 100, [&](size_t begin, size_t end) {
+            EXPECT_LE(end - begin, 100);
+            for (size_t i = begin; i < end; i++)
+                hits[i]++;
+        });
+
+        for (size_t i = 0; i < count; i++)
+            EXPECT_EQ(hits[i], 1);
+    }
+}
+
+UNIT_TEST(ThreadPool, ParallelReduce) {
+    // Float sums depend on the order of summation, so this checks that partial results are combined in chunk order.
+    auto sum = [](ThreadPool &pool, size_t count) {
+        return pool.parallelReduce(count, 7, 0.0f, [](size_t begin, size_t end) {
+            float result = 0.0f;
+            for (size_t i = begin; i < end; i++)
+                result += 1.0f / (i + 1);
+            return result;
+        }, [](float l, float r) { return l + r; });
+    };
+
+    ThreadPool pool1(1);
+    ThreadPool pool8(8);
+    for (size_t count : {0, 1, 7, 1000, 12345}) {
+        float expected = 0.0f;
+        for (size_t begin = 0; begin < count; begin += 7) {
+            float partial = 0.0f;
+            for (size_t i = begin; i < std::min<size_t>(begin + 7, count); i++)
+                partial += 1.0f / (i + 1);
+            expected += partial;
+        }
+
+        EXPECT_EQ(sum(pool1, count), expected);
+        EXPECT_EQ(sum(pool8, count), expected);
+    }
+}
+
+UNIT_TEST(ThreadPool, Serial) {
+    ThreadPool pool(4);
+    pool.setSerial(true);
+    EXPECT_TRUE(pool.isSerial());
+
+    std::vector<size_t> order;
+    std::thread::id caller = std::this_thread::get_id();
+    pool.parallelFor(1000, 10, [&](size_t begin, size_t end) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        order.push_back(begin);
+    });
+
+    ASSERT_EQ(order.size(), 100);
+    for (size_t i = 0; i < order.size(); i++)
+        EXPECT_EQ(order[i], i * 10);
+}
@@ -0,0 +1,106 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    _threads.reserve(threadCount);
+    for (int i = 0; i < threadCount; i++)
+        _threads.emplace_back([this] { workerMain(); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+
+    for (std::thread &thread : _threads)
+        thread.join();
+}
+
+void ThreadPool::post(std::function<void()> task) {
+    {
+        std::unique_lock lock(_mutex);
+        assert(!_stopping);
+        _tasks.push_back(std::move(task));
+    }
+    _condition.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t count, size_t chunkSize, std::function<void(size_t, size_t)> fn) {
+    assert(chunkSize > 0);
+
+    size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    if (chunkCount <= 1 || _serial) {
+        for (size_t begin = 0; begin < count; begin += chunkSize)
+            fn(begin, std::min(begin + chunkSize, count));
+        return;
+    }
+
+    // Job is shared with the helper tasks, some of which might only start after we're done. These won't find any
+    // chunks to process & won't call fn.
+    struct Job {
+        std::function<void(size_t, size_t)> fn;
+        size_t count = 0;
+        size_t chunkSize = 0;
+        size_t chunkCount = 0;
+        std::atomic<size_t> nextChunk = 0;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        size_t doneChunks = 0;
+    };
+
+    auto job = std::make_shared<Job>();
+    job->fn = std::move(fn);
+    job->count = count;
+    job->chunkSize = chunkSize;
+    job->chunkCount = chunkCount;
+
+    auto runChunks = [](Job *job) {
+        size_t processed = 0;
+        for (size_t chunk = job->nextChunk++; chunk < job->chunkCount; chunk = job->nextChunk++) {
+            size_t begin = chunk * job->chunkSize;
+            job->fn(begin, std::min(begin + job->chunkSize, job->count));
+            processed++;
+        }
+
+        if (processed == 0)
+            return;
+
+        std::lock_guard lock(job->mutex);
+        job->doneChunks += processed;
+        if (job->doneChunks == job->chunkCount)
+            job->condition.notify_all();
+    };
+
+    size_t helperCount = std::min<size_t>(threadCount(), chunkCount - 1);
+    for (size_t i = 0; i < helperCount; i++)
+        post([job, runChunks] { runChunks(job.get()); });
+
+    runChunks(job.get());
+
+    std::unique_lock lock(job->mutex);
+    job->condition.wait(lock, [&] { return job->doneChunks == job->chunkCount; });
+}
+
+void ThreadPool::workerMain() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(_mutex);
+            _condition.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+            if (_tasks.empty())
+                return; // Stopping & no more tasks.
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+    }
+}
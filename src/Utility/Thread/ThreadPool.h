@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Simple fixed-size thread pool.
+ *
+ * Tasks are executed in FIFO order, results are delivered through `std::future`s. Destructor waits for all the
+ * queued tasks to finish.
+ *
+ * Example usage:
+ * \code
+ * ThreadPool pool;
+ * std::future<int> result = pool.run([] { return 42; });
+ * assert(result.get() == 42);
+ * \endcode
+ */
+class ThreadPool {
+ public:
+    /**
+     * @param threadCount               Number of worker threads. Non-positive values mean "use the number of hardware
+     *                                  threads".
+     */
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @param fn                        Function to run on one of the worker threads.
+     * @return                          Future for the result of `fn`. Exceptions thrown by `fn` are propagated
+     *                                  through the returned future.
+     */
+    template<class Fn>
+    [[nodiscard]] std::future<std::invoke_result_t<std::decay_t<Fn>>> run(Fn &&fn) {
+        using result_type = std::invoke_result_t<std::decay_t<Fn>>;
+
+        auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<Fn>(fn));
+        std::future<result_type> result = task->get_future();
+        post([task = std::move(task)] { (*task)(); });
+        return result;
+    }
+
+    /**
+     * Fire-and-forget version of `run`.
+     *
+     * @param task                      Function to run on one of the worker threads. Must not throw.
+     */
+    void post(std::function<void()> task);
+
+    /**
+     * Splits `[0, count)` into chunks and calls `fn` for each of them, in parallel.
+     *
+     * The calling thread takes part in the work, so this function never ends up waiting on unrelated tasks that are
+     * queued in the pool. Chunk boundaries don't depend on the number of threads used.
+     *
+     * @param count                     Number of items to process.
+     * @param chunkSize                 Max number of items in a chunk. Must be greater than zero.
+     * @param fn                        Function to call, takes the `[begin, end)` item range as its arguments. Must not
+     *                                  throw.
+     */
+    void parallelFor(size_t count, size_t chunkSize, std::function<void(size_t, size_t)> fn);
+
+    /**
+     * Same as `parallelFor`, but `fn` returns a partial result for its chunk, and the partial results are then
+     * combined on the calling thread, in chunk order. Since chunk boundaries don't depend on the number of threads,
+     * the result is the same for any number of threads, even if `reduce` is not associative (e.g. for float sums).
+     *
+     * @param count                     Number of items to process.
+     * @param chunkSize                 Max number of items in a chunk. Must be greater than zero.
+     * @param init                      Initial value for the result.
+     * @param fn                        Function to call, takes the `[begin, end)` item range as its arguments and
+     *                                  returns a `T`. Must not throw.
+     * @param reduce                    Function that combines the result so far with the next partial result.
+     * @return                          `reduce(...reduce(reduce(init, partial0), partial1)..., partialN)`.
+     */
+    template<class T, class Fn, class Reduce>
+    [[nodiscard]] T parallelReduce(size_t count, size_t chunkSize, T init, Fn &&fn, Reduce &&reduce) {
+        assert(chunkSize > 0);
+
+        std::vector<T> partials((count + chunkSize - 1) / chunkSize);
+        parallelFor(count, chunkSize, [&](size_t begin, size_t end) {
+            partials[begin / chunkSize] = fn(begin, end);
+        });
+
+        T result = std::move(init);
+        for (T &partial : partials)
+            result = reduce(std::move(result), std::move(partial));
+        return result;
+    }
+
+    /**
+     * Switches the pool into serial mode, or back. In serial mode `parallelFor` and `parallelReduce` process all
+     * chunks on the calling thread, in order, and `TaskGraph::run` runs the tasks in the order they were added. This
+     * is used when the engine is running deterministically, so that traces don't depend on the thread scheduling
+     * even if some chunk function has order-dependent side effects.
+     *
+     * Tasks queued with `run` and `post` still go to the worker threads. Code that's using these must make sure that
+     * the results don't leak into the game state in an order-dependent way.
+     *
+     * @param serial                    Whether to enable serial mode.
+     */
+    void setSerial(bool serial) {
+        _serial = serial;
+    }
+
+    [[nodiscard]] bool isSerial() const {
+        return _serial;
+    }
+
+    /**
+     * @return                          Number of worker threads in this pool.
+     */
+    [[nodiscard]] int threadCount() const {
+        return _threads.size();
+    }
+
+ private:
+    void workerMain();
+
+ private:
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::function<void()>> _tasks;
+    bool _stopping = false;
+    std::vector<std::thread> _threads;
+    std::atomic<bool> _serial = false; // Set on the game thread, but read in parallelFor, which can run on workers.
+};
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+
+#include "Application/GameStarter.h"
+
+#include "Engine/Components/Control/EngineController.h"
+
+#include "Library/StackTrace/StackTraceOnCrash.h"
+
+#include "Utility/Format.h"
+#include "Utility/UnicodeCrt.h"
+
+#include "BenchmarkOptions.h"
+
+void printGoogleBenchmarkHelp(char *app) {
+    int argc = 2;
+    char help[] = "--help";
+    char *argv[] = { app, help, nullptr };
+    benchmark::Initialize(&argc, argv); // Prints help & exits.
+}
+
+int platformMain(int argc, char **argv) {
+    try {
+        StackTraceOnCrash st;
+        UnicodeCrt _(argc, argv);
+        BenchmarkOptions opts = BenchmarkOptions::parse(argc, argv);
+        if (opts.helpPrinted) {
+            fmt::print(stdout, "\n");
+            printGoogleBenchmarkHelp(argv[0]);
+            return 1;
+        }
+
+        benchmark::Initialize(&argc, argv);
+
+        // Benchmarks are run from the control routine so that they have full access to the loaded game data. Engine
+        // doesn't tick while the control routine is running, so the timings are not affected by the game loop.
+        GameStarter starter(opts);
+        starter.runInstrumented([&] (EngineController *game) {
+            if (opts.savePath.empty()) {
+                game->startNewGame();
+            } else {
+                game->loadGame(opts.savePath);
+            }
+            benchmark::RunSpecifiedBenchmarks();
+        });
+
+        benchmark::Shutdown();
+        return 0;
+    } catch (const std::exception &e) {
+        fmt::print(stderr, "{}\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,31 @@
+#include "BenchmarkOptions.h"
+
+#include <memory>
+
+#include "Library/Cli/CliApp.h"
+
+BenchmarkOptions BenchmarkOptions::parse(int argc, char **argv) {
+    BenchmarkOptions result;
+    result.useConfig = false; // Benchmarks don't need an external config.
+
+    std::unique_ptr<CliApp> app = std::make_unique<CliApp>();
+
+    app->add_option(
+        "--data-path", result.dataPath,
+        "Path to game data dir.")->check(CLI::ExistingDirectory)->option_text("PATH");
+    app->add_option(
+        "--save", result.savePath,
+        "Save to load before running the benchmarks. Benchmarks for the indoor code are skipped unless the party is "
+        "indoors in the provided save.")->check(CLI::ExistingFile)->option_text("PATH");
+    app->add_flag(
+        "--headless", result.headless,
+        "Run in headless mode.");
+    app->add_option(
+        "--log-level", result.logLevel,
+        "Log level, one of 'trace', 'debug', 'info', 'warning', 'error', 'critical'.")->option_text("LOG_LEVEL");
+    app->set_help_flag("-h,--help", "Print help and exit.");
+    app->allow_extras(); // Google Benchmark options are parsed separately.
+
+    app->parse(argc, argv, result.helpPrinted);
+    return result;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+#include "Application/GameStarterOptions.h"
+
+struct BenchmarkOptions : GameStarterOptions {
+    std::string savePath; // Save to load before running the benchmarks, empty means start a new game.
+    bool helpPrinted = false;
+
+    static BenchmarkOptions parse(int argc, char **argv);
+};
@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "Engine/Graphics/Level/Decoration.h"
+#include "Engine/Graphics/Indoor.h"
+#include "Engine/Graphics/LocationFunctions.h"
+#include "Engine/Objects/Actor.h"
+#include "Engine/Snapshots/CompositeSnapshots.h"
+#include "Engine/AssetsManager.h"
+#include "Engine/Engine.h"
+#include "Engine/LOD.h"
+#include "Engine/Party.h"
+#include "Engine/Pid.h"
+#include "Engine/SaveLoad.h"
+#include "Engine/mm7_data.h"
+
+#include "GUI/GUIFont.h"
+
+#include "Library/Binary/BlobSerialization.h"
+#include "Library/Lod/LodWriter.h"
+#include "Library/LodFormats/LodFormats.h"
+
+#include "Utility/Streams/BlobOutputStream.h"
+#include "Utility/Thread/ThreadPool.h"
+
+// Engine benchmarks run on the game state that was set up in `BenchmarkMain`, and don't modify it.
+
+static bool checkIndoor(benchmark::State &state) {
+    if (uCurrentlyLoadedLevelType == LEVEL_INDOOR)
+        return true;
+    state.SkipWithError("Party is not indoors, use '--save' to provide a save with an indoor location.");
+    return false;
+}
+
+static void BM_IndoorGetSector(benchmark::State &state) {
+    if (!checkIndoor(state))
+        return;
+
+    std::vector<Vec3i> points = {pParty->pos.toInt()};
+    for (const Actor &actor : pActors)
+        points.push_back(actor.pos);
+    for (const LevelDecoration &decoration : pLevelDecorations)
+        points.push_back(decoration.vPosition);
+
+    size_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pIndoor->GetSector(points[index]));
+        index = (index + 1) % points.size();
+    }
+}
+BENCHMARK(BM_IndoorGetSector);
+
+static void BM_DetectBetweenObjects(benchmark::State &state) {
+    if (!checkIndoor(state))
+        return;
+    if (pActors.size() < 2) {
+        state.SkipWithError("Not enough actors in the current location.");
+        return;
+    }
+
+    bool useCache = state.range(0);
+    int first = 0;
+    int second = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Detect_Between_Objects(Pid(OBJECT_Actor, first), Pid(OBJECT_Actor, second), useCache));
+        if (++second == pActors.size()) {
+            first = (first + 1) % (pActors.size() - 1);
+            second = first + 1;
+        }
+    }
+}
+BENCHMARK(BM_DetectBetweenObjects)->ArgName("useCache")->Arg(0)->Arg(1);
+
+static void BM_SerializeIndoorDelta(benchmark::State &state) {
+    if (!checkIndoor(state))
+        return;
+
+    IndoorDelta_MM7 delta;
+    snapshot(*pIndoor, &delta);
+    for (auto _ : state) {
+        Blob blob;
+        serialize(delta, &blob);
+        benchmark::DoNotOptimize(blob.data());
+    }
+}
+BENCHMARK(BM_SerializeIndoorDelta);
+
+static void BM_ReconstructIndoorLocation(benchmark::State &state) {
+    if (!checkIndoor(state))
+        return;
+
+    // Reconstruction also re-creates `pLevelDecorations`, but from the same level data, so the game state that the
+    // other benchmarks use doesn't change.
+    IndoorLocation_MM7 location;
+    deserialize(lod::decodeCompressed(pGames_LOD->read(pIndoor->filename)), &location);
+
+    ThreadPool *pool = state.range(0) ? engine->_threadPool.get() : nullptr;
+    for (auto _ : state) {
+        IndoorLocation indoor;
+        reconstruct(location, &indoor, pool);
+        benchmark::DoNotOptimize(indoor.pFaces.data());
+    }
+}
+BENCHMARK(BM_ReconstructIndoorLocation)->ArgName("threaded")->Arg(0)->Arg(1);
+
+static void BM_SerializeSaveGame(benchmark::State &state) {
+    SaveGameHeader header;
+    header.name = "Benchmark";
+    header.locationName = pCurrentMapName;
+    header.playingTime = pParty->GetPlayingTime();
+
+    LodInfo info;
+    info.version = LOD_VERSION_MM7;
+    info.rootName = "chapter";
+
+    for (auto _ : state) {
+        SaveGame_MM7 save;
+        snapshot(header, &save);
+
+        Blob blob;
+        BlobOutputStream stream(&blob);
+        LodWriter writer(&stream, "new.lod", info);
+        serialize(save, &writer);
+        writer.close();
+        benchmark::DoNotOptimize(blob.data());
+    }
+}
+BENCHMARK(BM_SerializeSaveGame);
+
+static void BM_GUIFontGetLineWidth(benchmark::State &state) {
+    std::string text = "You have found a \f00000Scroll of Fire Bolt\f00000! It is worth 100 gold.";
+    for (auto _ : state)
+        benchmark::DoNotOptimize(assets->pFontArrus->GetLineWidth(text));
+}
+BENCHMARK(BM_GUIFontGetLineWidth);
@@ -0,0 +1,207 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Engine/Snapshots/CompositeSnapshots.h"
+
+#include "Library/Binary/BlobSerialization.h"
+#include "Library/Compression/Compression.h"
+#include "Library/Image/ImageKernels.h"
+#include "Library/Image/PCX.h"
+#include "Library/Lod/LodReader.h"
+#include "Library/LodFormats/LodFormats.h"
+
+#include "Utility/Streams/BlobOutputStream.h"
+#include "Utility/Math/TrigLut.h"
+#include "Utility/Thread/ThreadPool.h"
+#include "Utility/DataPath.h"
+
+// Library benchmarks only need the game data, and don't depend on the game state. They are still run from
+// `BenchmarkMain`'s control routine, so the data path is already set up.
+
+static constexpr const char *BENCHMARK_LOCATION = "d01.blv"; // Emerald Island temple, smallish indoor location.
+static constexpr const char *BENCHMARK_OUTDOOR_LOCATION = "out01.odm"; // Emerald Island.
+
+static std::string gamesLodPath() {
+    return makeDataPath("data", "games.lod");
+}
+
+static const LodReader *gamesLod(benchmark::State &state) {
+    static LodReader lod;
+    if (!lod.isOpen() && std::filesystem::exists(gamesLodPath()))
+        lod.open(gamesLodPath());
+    if (!lod.isOpen()) {
+        state.SkipWithError("games.lod not found.");
+        return nullptr;
+    }
+    return &lod;
+}
+
+static Blob locationBlob(benchmark::State &state, const char *name = BENCHMARK_LOCATION) {
+    if (const LodReader *lod = gamesLod(state))
+        return lod::decodeCompressed(lod->read(name));
+    return Blob();
+}
+
+static void BM_LodReaderOpen(benchmark::State &state) {
+    if (!gamesLod(state))
+        return;
+
+    for (auto _ : state) {
+        LodReader lod(gamesLodPath());
+        benchmark::DoNotOptimize(lod.isOpen());
+    }
+}
+BENCHMARK(BM_LodReaderOpen);
+
+static void BM_LodReaderRead(benchmark::State &state) {
+    const LodReader *lod = gamesLod(state);
+    if (!lod)
+        return;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(lod->read(BENCHMARK_LOCATION));
+}
+BENCHMARK(BM_LodReaderRead);
+
+static void BM_BlobSubBlob(benchmark::State &state) {
+    Blob blob = locationBlob(state);
+    if (!blob)
+        return;
+
+    size_t offset = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(blob.subBlob(offset, 64));
+        offset = (offset + 4096) % (blob.size() - 64);
+    }
+}
+BENCHMARK(BM_BlobSubBlob);
+
+static void BM_ZlibUncompress(benchmark::State &state) {
+    Blob blob = locationBlob(state);
+    if (!blob)
+        return;
+
+    Blob compressed = zlib::compress(blob);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(zlib::uncompress(compressed, blob.size()));
+    state.SetBytesProcessed(state.iterations() * blob.size());
+}
+BENCHMARK(BM_ZlibUncompress);
+
+static void BM_DeserializeIndoorLocation(benchmark::State &state) {
+    Blob blob = locationBlob(state);
+    if (!blob)
+        return;
+
+    for (auto _ : state) {
+        IndoorLocation_MM7 location;
+        deserialize(blob, &location);
+        benchmark::DoNotOptimize(location.faces.data());
+    }
+    state.SetBytesProcessed(state.iterations() * blob.size());
+}
+BENCHMARK(BM_DeserializeIndoorLocation);
+
+static void BM_DeserializeOutdoorLocation(benchmark::State &state) {
+    Blob blob = locationBlob(state, BENCHMARK_OUTDOOR_LOCATION);
+    if (!blob)
+        return;
+
+    for (auto _ : state) {
+        OutdoorLocation_MM7 location;
+        deserialize(blob, &location);
+        benchmark::DoNotOptimize(location.models.data());
+    }
+    state.SetBytesProcessed(state.iterations() * blob.size());
+}
+BENCHMARK(BM_DeserializeOutdoorLocation);
+
+static void BM_SerializeTextureNames(benchmark::State &state) {
+    // Same shape as the face texture name tables in the location files. Arg 0 serializes names one by one, which is
+    // what the serialization code used to do before arrays were detected as memcopy-serializable.
+    std::vector<std::array<char, 10>> names(10000);
+    for (size_t i = 0; i < names.size(); i++)
+        fmt::format_to_n(names[i].data(), names[i].size(), "tex{}", i);
+
+    bool bulk = state.range(0);
+    for (auto _ : state) {
+        Blob blob;
+        if (bulk) {
+            serialize(names, &blob);
+        } else {
+            BlobOutputStream stream(&blob);
+            serialize(static_cast<uint32_t>(names.size()), &stream);
+            for (const std::array<char, 10> &name : names)
+                serialize(std::span(name), &stream);
+            stream.close();
+        }
+        benchmark::DoNotOptimize(blob.data());
+    }
+    state.SetBytesProcessed(state.iterations() * names.size() * sizeof(names[0]));
+}
+BENCHMARK(BM_SerializeTextureNames)->ArgName("bulk")->Arg(0)->Arg(1);
+
+static void BM_ExpandPalette(benchmark::State &state) {
+    Palette palette;
+    for (int i = 0; i < 256; i++)
+        palette.colors[i] = Color(i, i, i);
+
+    std::vector<uint8_t> indices(256 * 256);
+    for (size_t i = 0; i < indices.size(); i++)
+        indices[i] = i * 31;
+    std::vector<Color> colors(indices.size());
+
+    bool simd = state.range(0);
+    for (auto _ : state) {
+        if (simd) {
+            expandPalette(indices, palette, colors);
+        } else {
+            detail::expandPaletteScalar(indices, palette, colors);
+        }
+        benchmark::DoNotOptimize(colors.data());
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+BENCHMARK(BM_ExpandPalette)->ArgName("simd")->Arg(0)->Arg(1);
+
+static void BM_EncodePcx(benchmark::State &state) {
+    // Screenshot-sized image with a mix of flat areas & noise.
+    RgbaImage image = RgbaImage::uninitialized(640, 480);
+    for (size_t y = 0; y < image.height(); y++)
+        for (size_t x = 0; x < image.width(); x++)
+            image[y][x] = y < 240 ? Color(x / 64, y / 64, 128) : Color(x * 7, y * 13, x ^ y);
+
+    ThreadPool pool;
+    bool parallel = state.range(0);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(pcx::encode(image, parallel ? &pool : nullptr));
+    state.SetItemsProcessed(state.iterations() * image.width() * image.height());
+}
+BENCHMARK(BM_EncodePcx)->ArgName("parallel")->Arg(0)->Arg(1);
+
+static void BM_TrigLutSinCos(benchmark::State &state) {
+    int angle = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TrigLUT.sin(angle) + TrigLUT.cos(angle));
+        angle = (angle + 7) & TrigTableLookup::uDoublePiMask;
+    }
+}
+BENCHMARK(BM_TrigLutSinCos);
+
+static void BM_TrigLutAtan2(benchmark::State &state) {
+    int x = -1000;
+    int y = 1000;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TrigLUT.atan2(x, y));
+        x = x >= 1000 ? -1000 : x + 13;
+        y = y <= -1000 ? 1000 : y - 17;
+    }
+}
+BENCHMARK(BM_TrigLutAtan2);
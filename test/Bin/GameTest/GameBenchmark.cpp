@@ -0,0 +1,177 @@
+#include "GameBenchmark.h"
+
+#include <gtest/gtest.h>
+
+#ifdef _WINDOWS
+#   include <windows.h>
+#   include <psapi.h>
+#else
+#   include <sys/resource.h>
+#endif
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+
+#include "Engine/Graphics/Renderer/RenderPrepTimers.h"
+#include "Engine/SubsystemTimers.h"
+
+#include "Library/Json/Json.h"
+
+#include "Testing/Game/TestController.h"
+
+#include "Utility/Format.h"
+
+#include "GameTestOptions.h"
+
+struct GameBenchmarkResult {
+    int64_t frames = 0;
+    double wallTimeMs = 0;
+    double framesPerSecond = 0;
+    std::map<std::string, double> subsystemMs;
+    std::map<std::string, double> renderPrepMs;
+    int64_t peakMemoryBytes = 0;
+};
+
+MM_DEFINE_JSON_STRUCT_SERIALIZATION_FUNCTIONS(GameBenchmarkResult, (
+    (frames, "frames"),
+    (wallTimeMs, "wallTimeMs"),
+    (framesPerSecond, "framesPerSecond"),
+    (subsystemMs, "subsystemMs"),
+    (renderPrepMs, "renderPrepMs"),
+    (peakMemoryBytes, "peakMemoryBytes")
+))
+
+using GameBenchmarkResults = std::map<std::string, GameBenchmarkResult>;
+
+static GameBenchmarkResults benchmarkResults;
+
+static constexpr std::string_view BENCHMARK_SUITE = "Benchmarks";
+
+using Duration = std::chrono::steady_clock::duration;
+
+static double toMs(Duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/**
+ * @return                              Peak resident set size of the current process, in bytes.
+ */
+static int64_t peakMemoryBytes() {
+#ifdef _WINDOWS
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#   ifdef __APPLE__
+    return usage.ru_maxrss; // Bytes on macOS.
+#   else
+    return usage.ru_maxrss * int64_t(1024); // Kilobytes everywhere else.
+#   endif
+#endif
+}
+
+void runBenchmark(TestController &test, const std::string &saveName, const std::string &traceName) {
+    const testing::TestInfo *testInfo = testing::UnitTest::GetInstance()->current_test_info();
+    assert(testInfo && testInfo->test_suite_name() == BENCHMARK_SUITE);
+
+    // Timers are always installed in benchmark mode, and benchmarks are only run in benchmark mode.
+    assert(subsystemTimers && renderPrepTimers);
+
+    SubsystemTimers::Timings subsystemTotals = subsystemTimers->totals();
+    RenderPrepTimers::Timings renderPrepTotals = renderPrepTimers->totals();
+    int64_t frameCount = subsystemTimers->frameCount();
+    auto startTime = std::chrono::steady_clock::now();
+
+    test.playTraceFromTestData(saveName, traceName);
+
+    auto endTime = std::chrono::steady_clock::now();
+
+    GameBenchmarkResult result;
+    result.frames = subsystemTimers->frameCount() - frameCount;
+    result.wallTimeMs = toMs(endTime - startTime);
+    result.framesPerSecond = result.wallTimeMs > 0 ? result.frames * 1000.0 / result.wallTimeMs : 0.0;
+    for (EngineSubsystem subsystem : subsystemTotals.indices()) {
+        Duration duration = subsystemTimers->totals()[subsystem] - subsystemTotals[subsystem];
+        result.subsystemMs[toString(subsystem)] = toMs(duration);
+    }
+    for (RenderPrepPhase phase : renderPrepTotals.indices()) {
+        Duration duration = renderPrepTimers->totals()[phase] - renderPrepTotals[phase];
+        result.renderPrepMs[toString(phase)] = toMs(duration);
+    }
+    // This is process-wide, so it's the peak over this & all previous benchmarks.
+    result.peakMemoryBytes = peakMemoryBytes();
+
+    std::string name = fmt::format("{}.{}", testInfo->test_suite_name(), testInfo->name());
+    fmt::println("Benchmark '{}': {} frames in {:.1f} ms, {:.1f} fps", name, result.frames, result.wallTimeMs,
+                 result.framesPerSecond);
+    benchmarkResults[name] = std::move(result);
+}
+
+void applyBenchmarkFilter(const GameTestOptions &opts) {
+    std::string &filter = testing::GTEST_FLAG(filter);
+    std::string benchmarkPattern = fmt::format("{}.*", BENCHMARK_SUITE);
+
+    if (!opts.benchmarkPath.empty()) {
+        if (filter == "*")
+            filter = benchmarkPattern;
+    } else {
+        filter += filter.find('-') == std::string::npos ? "-" : ":";
+        filter += benchmarkPattern;
+    }
+}
+
+int finishBenchmarks(const GameTestOptions &opts) {
+    if (opts.benchmarkPath.empty())
+        return 0;
+
+    int exitCode = 0;
+
+    Json json = benchmarkResults;
+    std::ofstream output(std::filesystem::path(opts.benchmarkPath), std::ios::binary);
+    output << json.dump(4) << "\n";
+    output.close();
+    if (!output) {
+        fmt::println(stderr, "Could not write benchmark results to '{}'", opts.benchmarkPath);
+        exitCode = 1;
+    }
+
+    if (opts.benchmarkBaselinePath.empty())
+        return exitCode;
+
+    GameBenchmarkResults baseline;
+    try {
+        std::ifstream input(std::filesystem::path(opts.benchmarkBaselinePath), std::ios::binary);
+        Json::parse(input).get_to(baseline);
+    } catch (const std::exception &e) {
+        fmt::println(stderr, "Could not read benchmark baseline from '{}': {}", opts.benchmarkBaselinePath, e.what());
+        return 1;
+    }
+
+    for (const auto &[name, result] : benchmarkResults) {
+        auto pos = baseline.find(name);
+        if (pos == baseline.end()) {
+            fmt::println("Benchmark '{}': no baseline", name);
+            continue;
+        }
+
+        // Comparing fps and not the wall time - if the trace was retraced, the frame count might have changed.
+        double baselineFps = pos->second.framesPerSecond;
+        double ratio = baselineFps > 0 ? result.framesPerSecond / baselineFps : 1.0;
+        bool regressed = ratio < 1.0 - opts.benchmarkThreshold;
+        fmt::println("Benchmark '{}': {:.1f} fps vs {:.1f} fps baseline ({:+.1f}%){}", name, result.framesPerSecond,
+                     baselineFps, (ratio - 1.0) * 100.0, regressed ? ", REGRESSION" : "");
+        if (regressed)
+            exitCode = 1;
+    }
+
+    return exitCode;
+}
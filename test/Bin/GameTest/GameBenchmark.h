@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+class TestController;
+struct GameTestOptions;
+
+/**
+ * Plays back a trace & records the resulting performance numbers for the currently running benchmark. Should be
+ * called from within a `Benchmarks.*` game test, the results are keyed by the full test name.
+ *
+ * @param test                          Test controller.
+ * @param saveName                      Save file name in the test data folder.
+ * @param traceName                     Trace file name in the test data folder.
+ */
+void runBenchmark(TestController &test, const std::string &saveName, const std::string &traceName);
+
+/**
+ * Adjusts the Google Test filter so that `Benchmarks.*` tests are run only in benchmark mode, and only benchmarks are
+ * run in benchmark mode (unless an explicit filter was passed). Should be called after `testing::InitGoogleTest`.
+ *
+ * @param opts                          Game test options.
+ */
+void applyBenchmarkFilter(const GameTestOptions &opts);
+
+/**
+ * Writes the benchmark results into `opts.benchmarkPath`, and compares them against the baseline in
+ * `opts.benchmarkBaselinePath`, if any. Does nothing if not in benchmark mode.
+ *
+ * @param opts                          Game test options.
+ * @return                              Exit code - non-zero if the report couldn't be written, or if any of the
+ *                                      benchmarks is slower than the baseline by more than the threshold.
+ */
+int finishBenchmarks(const GameTestOptions &opts);
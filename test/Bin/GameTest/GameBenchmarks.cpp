@@ -0,0 +1,31 @@
+#include "Testing/Game/GameTest.h"
+
+#include "GameBenchmark.h"
+
+// Benchmarks are only run with `--benchmark`, see `applyBenchmarkFilter`. Traces are picked so that each benchmark
+// stresses a different part of the engine.
+
+GAME_TEST(Benchmarks, IndoorBattle) {
+    // Battle with ~60 monsters in a dungeon - actor AI & indoor collisions.
+    runBenchmark(test, "issue_735a.mm7", "issue_735a.json");
+}
+
+GAME_TEST(Benchmarks, OutdoorBattle) {
+    // Battle with over 30 monsters in the open - actor AI & outdoor collisions.
+    runBenchmark(test, "issue_735b.mm7", "issue_735b.json");
+}
+
+GAME_TEST(Benchmarks, WallHugging) {
+    // Hugging the walls of the dragon cave on Emerald Isle & shooting fireballs - party collisions & sprite objects.
+    runBenchmark(test, "issue_735c.mm7", "issue_735c.json");
+}
+
+GAME_TEST(Benchmarks, TurnBasedBattle) {
+    // Turn-based battle with ~60 monsters in a dungeon, casting poison cloud - turn-based mode & spell effects.
+    runBenchmark(test, "issue_735d.mm7", "issue_735d.json");
+}
+
+GAME_TEST(Benchmarks, Armageddon) {
+    // Casting armageddon on a crowd of actors - particles & decals.
+    runBenchmark(test, "issue_518.mm7", "issue_518.json");
+}
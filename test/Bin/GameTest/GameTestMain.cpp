@@ -15,7 +15,9 @@
 #include "Utility/Format.h"
 #include "Utility/UnicodeCrt.h"
 
+#include "GameBenchmark.h"
 #include "GameTestOptions.h"
+#include "GameTestSharding.h"
 
 void printGoogleTestHelp(char *app) {
     int argc = 2;
@@ -35,7 +37,12 @@ int platformMain(int argc, char **argv) {
             return 1;
         }
 
+        if (opts.jobs > 1 && !opts.listRequested)
+            return runTestShards(argc, argv, opts);
+
         testing::InitGoogleTest(&argc, argv);
+        applyBenchmarkFilter(opts);
+        applyTestShard(opts);
         if (opts.listRequested)
             return RUN_ALL_TESTS();
 
@@ -47,7 +54,9 @@ int platformMain(int argc, char **argv) {
             GameTest::init(game, &test);
             exitCode = RUN_ALL_TESTS();
         });
-        return exitCode;
+
+        int benchmarkExitCode = finishBenchmarks(opts);
+        return exitCode != 0 ? exitCode : benchmarkExitCode;
     } catch (const std::exception &e) {
         // TODO(captainurist): we need a separate test that testing framework terminates correctly if the engine throws.
         fmt::print(stderr, "{}\n", e.what());
@@ -25,18 +25,54 @@ GameTestOptions GameTestOptions::parse(int argc, char **argv) {
     app->add_flag(
         "--headless", result.headless,
         "Run in headless mode.")->group(otherOptions);
+    app->add_flag(
+        "--render-prep", result.renderPrep,
+        "Time the CPU side of rendering and print per-phase timings on exit. Combine with '--headless' to benchmark "
+        "render prep without a GPU.")->group(otherOptions);
     app->add_option(
         "--speed", result.speed,
         "Playback speed, default is infinite, use '1.0' for realtime playback.")->option_text("SPEED");
     app->add_flag(
         "--tracing-rng", result.tracingRng,
-        "Use random number generators that print stack trace on each call.")->group(otherOptions);
+        "Use random number generators that record stack trace on each call. Recorded stack traces are printed on "
+        "random state desync and on exit.")->group(otherOptions);
+    app->add_option(
+        "--tracing-rng-from", result.tracingRngFirstTick,
+        "First tick to record random number generator calls at, in milliseconds. Use with '--tracing-rng'.")
+        ->option_text("MS")->group(otherOptions);
+    app->add_option(
+        "--tracing-rng-to", result.tracingRngLastTick,
+        "Last tick to record random number generator calls at, in milliseconds. Use with '--tracing-rng'.")
+        ->option_text("MS")->group(otherOptions);
     app->add_option(
         "--log-level", result.logLevel,
         "Log level, one of 'trace', 'debug', 'info', 'warning', 'error', 'critical'.")->option_text("LOG_LEVEL");
     app->add_flag_callback(
         "-v,--verbose", [&] { result.logLevel = LOG_TRACE; },
         "Set log level to 'trace'.");
+    app->add_option(
+        "-j,--jobs", result.jobs,
+        "Run the tests in this many worker processes in parallel.")->check(CLI::PositiveNumber)->option_text("JOBS")->group(otherOptions);
+    app->add_option(
+        "--shard-index", result.shardIndex,
+        "Index of the test shard to run, in '[0, SHARD_COUNT)'.")->check(CLI::NonNegativeNumber)->option_text("INDEX")->group(otherOptions);
+    app->add_option(
+        "--shard-count", result.shardCount,
+        "Total number of test shards.")->check(CLI::PositiveNumber)->option_text("SHARD_COUNT")->group(otherOptions);
+    app->add_option(
+        "--shard-durations", result.shardDurationsPath,
+        "Test report from a previous run to balance the shards by test durations, e.g. one written with "
+        "'--gtest_output=xml:PATH'.")->check(CLI::ExistingFile)->option_text("PATH")->group(otherOptions);
+    app->add_option(
+        "--benchmark", result.benchmarkPath,
+        "Run the benchmarks instead of the tests, and write the results as JSON to the provided file.")->option_text("PATH")->group(otherOptions);
+    app->add_option(
+        "--benchmark-baseline", result.benchmarkBaselinePath,
+        "Compare benchmark results against the ones in the provided file, and fail if any of the benchmarks got "
+        "slower than allowed by '--benchmark-threshold'.")->check(CLI::ExistingFile)->option_text("PATH")->group(otherOptions);
+    app->add_option(
+        "--benchmark-threshold", result.benchmarkThreshold,
+        "Max allowed fps regression relative to the baseline, default is '0.1'.")->check(CLI::Range(0.0f, 1.0f))->option_text("FRACTION")->group(otherOptions);
     app->set_help_flag("-h,--help", "Print help and exit.")->group(otherOptions);
     app->add_flag(
         "--gtest_list_tests", result.listRequested,
@@ -49,5 +85,19 @@ GameTestOptions GameTestOptions::parse(int argc, char **argv) {
         throw CLI::RequiredError(testPathOption->get_name());
     result.testPath = testPath.value_or("");
 
+    if (result.shardIndex >= result.shardCount)
+        throw CLI::ValidationError("--shard-index", "Shard index must be less than shard count.");
+    if (result.jobs > 1 && result.shardCount > 1)
+        throw CLI::ValidationError("--jobs", "Can't be combined with '--shard-count'.");
+    if (result.jobs > 1 && !result.benchmarkPath.empty())
+        throw CLI::ValidationError("--jobs", "Can't be combined with '--benchmark', parallel runs would skew the timings.");
+    if (!result.benchmarkBaselinePath.empty() && result.benchmarkPath.empty())
+        throw CLI::RequiredError("--benchmark");
+
+    if (!result.benchmarkPath.empty()) {
+        result.renderPrep = true;
+        result.subsystemTimers = true;
+    }
+
     return result;
 }
@@ -11,6 +11,13 @@ struct GameTestOptions : GameStarterOptions {
     float speed = FLT_MAX; // Test playback speed.
     bool helpPrinted = false;
     bool listRequested = false;
+    int jobs = 1; // Number of worker processes to split the tests between.
+    int shardIndex = 0;
+    int shardCount = 1;
+    std::string shardDurationsPath; // Test report to take test durations from when splitting the tests into shards.
+    std::string benchmarkPath; // Path to write benchmark results to, non-empty means benchmark mode.
+    std::string benchmarkBaselinePath; // Benchmark results to compare against.
+    float benchmarkThreshold = 0.1f; // Max allowed fps regression relative to baseline.
 
     static GameTestOptions parse(int argc, char **argv);
 };
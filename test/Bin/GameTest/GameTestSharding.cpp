@@ -0,0 +1,269 @@
+#include "GameTestSharding.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "Library/Cli/CliCommand.h"
+
+#include "Utility/Format.h"
+
+#include "GameTestOptions.h"
+
+static std::string readFile(const std::filesystem::path &path) {
+    std::ifstream stream(path, std::ios::binary);
+    std::stringstream result;
+    result << stream.rdbuf();
+    return result.str();
+}
+
+static std::string xmlAttribute(std::string_view tag, std::string_view name) {
+    std::string key = fmt::format(" {}=\"", name);
+    size_t pos = tag.find(key);
+    if (pos == std::string_view::npos)
+        return {};
+
+    pos += key.size();
+    size_t end = tag.find('"', pos);
+    if (end == std::string_view::npos)
+        return {};
+
+    return std::string(tag.substr(pos, end - pos));
+}
+
+static bool matchesPattern(std::string_view name, std::string_view pattern) {
+    if (pattern.empty())
+        return name.empty();
+
+    if (pattern[0] == '*')
+        return matchesPattern(name, pattern.substr(1)) || (!name.empty() && matchesPattern(name.substr(1), pattern));
+
+    if (name.empty())
+        return false;
+
+    return (pattern[0] == '?' || pattern[0] == name[0]) && matchesPattern(name.substr(1), pattern.substr(1));
+}
+
+static bool matchesAnyPattern(std::string_view name, std::string_view patterns) {
+    while (!patterns.empty()) {
+        size_t end = patterns.find(':');
+        if (matchesPattern(name, patterns.substr(0, end)))
+            return true;
+        if (end == std::string_view::npos)
+            break;
+        patterns = patterns.substr(end + 1);
+    }
+    return false;
+}
+
+TestDurations loadTestDurations(std::string_view path) {
+    TestDurations result;
+
+    std::string report = readFile(std::filesystem::path(path));
+    if (report.empty()) {
+        fmt::print(stderr, "Could not read test durations from '{}', tests will be split evenly\n", path);
+        return result;
+    }
+
+    size_t pos = 0;
+    while ((pos = report.find("<testcase ", pos)) != std::string::npos) {
+        size_t end = report.find('>', pos);
+        if (end == std::string::npos)
+            break;
+
+        std::string_view tag(report.data() + pos, end - pos);
+        std::string name = xmlAttribute(tag, "name");
+        std::string suite = xmlAttribute(tag, "classname");
+        std::string time = xmlAttribute(tag, "time");
+        if (!name.empty() && !suite.empty() && !time.empty())
+            result[fmt::format("{}.{}", suite, name)] = std::strtod(time.c_str(), nullptr);
+
+        pos = end;
+    }
+
+    return result;
+}
+
+std::vector<std::string> selectShardTests(std::vector<std::string> tests, const TestDurations &durations,
+                                          int shardIndex, int shardCount) {
+    assert(shardCount > 0 && shardIndex >= 0 && shardIndex < shardCount);
+
+    double knownTotal = 0.0;
+    int knownCount = 0;
+    for (const std::string &test : tests) {
+        auto pos = durations.find(test);
+        if (pos != durations.end()) {
+            knownTotal += pos->second;
+            knownCount++;
+        }
+    }
+    double fallback = knownCount > 0 ? knownTotal / knownCount : 1.0;
+
+    auto duration = [&](const std::string &test) {
+        auto pos = durations.find(test);
+        return pos == durations.end() ? fallback : pos->second;
+    };
+
+    // Sort by name first so that the split doesn't depend on the test registration order.
+    std::ranges::sort(tests);
+    std::ranges::stable_sort(tests, std::greater<double>(), duration);
+
+    std::vector<double> loads(shardCount, 0.0);
+    std::vector<std::string> result;
+    for (const std::string &test : tests) {
+        ptrdiff_t shard = std::ranges::min_element(loads) - loads.begin();
+        loads[shard] += duration(test);
+        if (shard == shardIndex)
+            result.push_back(test);
+    }
+    return result;
+}
+
+bool matchesTestFilter(std::string_view name, std::string_view filter) {
+    size_t dash = filter.find('-');
+    std::string_view positive = filter.substr(0, dash);
+    std::string_view negative = dash == std::string_view::npos ? std::string_view() : filter.substr(dash + 1);
+    if (positive.empty())
+        positive = "*";
+
+    return matchesAnyPattern(name, positive) && !matchesAnyPattern(name, negative);
+}
+
+void applyTestShard(const GameTestOptions &opts) {
+    if (opts.shardCount <= 1)
+        return;
+
+    std::string filter = testing::GTEST_FLAG(filter);
+    std::vector<std::string> tests;
+    testing::UnitTest *unitTest = testing::UnitTest::GetInstance();
+    for (int i = 0; i < unitTest->total_test_suite_count(); i++) {
+        const testing::TestSuite *suite = unitTest->GetTestSuite(i);
+        for (int j = 0; j < suite->total_test_count(); j++) {
+            std::string name = fmt::format("{}.{}", suite->name(), suite->GetTestInfo(j)->name());
+            if (matchesTestFilter(name, filter))
+                tests.push_back(std::move(name));
+        }
+    }
+
+    TestDurations durations;
+    if (!opts.shardDurationsPath.empty())
+        durations = loadTestDurations(opts.shardDurationsPath);
+
+    std::vector<std::string> shardTests =
+        selectShardTests(std::move(tests), durations, opts.shardIndex, opts.shardCount);
+
+    // Empty filter means "run everything", so we need a filter that matches nothing for an empty shard.
+    testing::GTEST_FLAG(filter) = shardTests.empty() ? "-*" : fmt::format("{}", fmt::join(shardTests, ":"));
+}
+
+int runTestShards(int argc, char **argv, const GameTestOptions &opts) {
+    namespace fs = std::filesystem;
+
+    // Forward everything except for the options that we're handling here.
+    std::string outputPath;
+    std::string baseCommand = quoteCommandLineArgument(argv[0]);
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--jobs" || arg == "-j") {
+            i++;
+            continue;
+        }
+        if (arg.starts_with("--jobs=") || arg.starts_with("-j"))
+            continue;
+        if (arg.starts_with("--gtest_output=")) {
+            std::string_view output = arg.substr(std::string_view("--gtest_output=").size());
+            if (output == "xml") {
+                outputPath = "test_detail.xml";
+            } else if (output.starts_with("xml:")) {
+                outputPath = output.substr(4);
+            } else {
+                fmt::print(stderr, "Only xml output is supported for sharded runs, ignoring '{}'\n", arg);
+            }
+            continue;
+        }
+        baseCommand += " " + quoteCommandLineArgument(arg);
+    }
+
+    std::error_code error;
+    fs::path shardDir =
+        fs::temp_directory_path(error) / fmt::format("OpenEnroth_GameTest_{:08x}", std::random_device()());
+    fs::create_directories(shardDir, error);
+
+    fmt::print("Running game tests in {} processes, shard logs are in '{}'\n", opts.jobs, shardDir.string());
+    std::fflush(stdout);
+
+    std::vector<int> exitCodes(opts.jobs, 0);
+    std::vector<std::thread> threads;
+    for (int shard = 0; shard < opts.jobs; shard++) {
+        fs::path xmlPath = shardDir / fmt::format("shard_{}.xml", shard);
+        fs::path logPath = shardDir / fmt::format("shard_{}.log", shard);
+        std::string outputArg = quoteCommandLineArgument(fmt::format("--gtest_output=xml:{}", xmlPath.string()));
+        std::string command = fmt::format("{} --shard-index {} --shard-count {} {}",
+                                          baseCommand, shard, opts.jobs, outputArg);
+        threads.emplace_back([&exitCodes, shard, command = std::move(command), logPath = logPath.string()] {
+            exitCodes[shard] = runCommandLine(command, logPath);
+        });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+
+    bool success = true;
+    for (int shard = 0; shard < opts.jobs; shard++) {
+        if (exitCodes[shard] == 0) {
+            fmt::print("Shard {}/{} passed\n", shard + 1, opts.jobs);
+            continue;
+        }
+
+        success = false;
+        fmt::print("Shard {}/{} FAILED (exit code {}), log follows:\n", shard + 1, opts.jobs, exitCodes[shard]);
+        fmt::print("{}\n", readFile(shardDir / fmt::format("shard_{}.log", shard)));
+    }
+
+    if (!outputPath.empty()) {
+        int tests = 0, failures = 0, disabled = 0, errors = 0;
+        double time = 0.0;
+        std::string body;
+        for (int shard = 0; shard < opts.jobs; shard++) {
+            std::string report = readFile(shardDir / fmt::format("shard_{}.xml", shard));
+            size_t start = report.find("<testsuites");
+            size_t tagEnd = report.find('>', start);
+            size_t end = report.rfind("</testsuites>");
+            if (start == std::string::npos || tagEnd == std::string::npos || end == std::string::npos || end < tagEnd) {
+                fmt::print(stderr, "Report for shard {}/{} is missing or broken\n", shard + 1, opts.jobs);
+                success = false;
+                continue;
+            }
+
+            std::string_view tag(report.data() + start, tagEnd - start);
+            tests += std::atoi(xmlAttribute(tag, "tests").c_str());
+            failures += std::atoi(xmlAttribute(tag, "failures").c_str());
+            disabled += std::atoi(xmlAttribute(tag, "disabled").c_str());
+            errors += std::atoi(xmlAttribute(tag, "errors").c_str());
+            time = std::max(time, std::strtod(xmlAttribute(tag, "time").c_str(), nullptr)); // Shards run in parallel.
+            body += report.substr(tagEnd + 1, end - tagEnd - 1);
+        }
+
+        std::ofstream output(fs::path(outputPath), std::ios::binary);
+        output << fmt::format("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                              "<testsuites tests=\"{}\" failures=\"{}\" disabled=\"{}\" errors=\"{}\" "
+                              "time=\"{:.3f}\" name=\"AllTests\">",
+                              tests, failures, disabled, errors, time);
+        output << body << "</testsuites>\n";
+        if (!output) {
+            fmt::print(stderr, "Could not write test report to '{}'\n", outputPath);
+            success = false;
+        }
+    }
+
+    if (success)
+        fs::remove_all(shardDir, error);
+    return success ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct GameTestOptions;
+
+/**
+ * Test durations in seconds, by full test name (`Suite.Test`).
+ */
+using TestDurations = std::unordered_map<std::string, double>;
+
+/**
+ * @param path                          Path to a Google Test XML report, e.g. one written by a previous sharded run.
+ * @return                              Durations of all the test cases in the report. Empty if the report couldn't
+ *                                      be read.
+ */
+TestDurations loadTestDurations(std::string_view path);
+
+/**
+ * Splits the tests between the shards so that the shards take roughly the same time - tests are handed out longest
+ * first, each to the shard that has the least work so far. Tests with unknown durations are assumed to take as long
+ * as an average known test. The split is deterministic, so all the shards end up with the same result.
+ *
+ * @param tests                         Full names of the tests to split.
+ * @param durations                     Known test durations.
+ * @param shardIndex                    Index of the shard to return the tests for.
+ * @param shardCount                    Total number of shards.
+ * @return                              Full names of the tests for the given shard.
+ */
+std::vector<std::string> selectShardTests(std::vector<std::string> tests, const TestDurations &durations,
+                                          int shardIndex, int shardCount);
+
+/**
+ * @param name                          Full test name.
+ * @param filter                        Google Test filter, e.g. `Issues.*:Items.*-Issues.Issue123`.
+ * @return                              Whether the test matches the filter, same as Google Test would match it.
+ */
+bool matchesTestFilter(std::string_view name, std::string_view filter);
+
+/**
+ * Restricts the tests that will be run to the ones from the shard specified in the options. Should be called after
+ * `testing::InitGoogleTest`. Does nothing if no sharding was requested.
+ *
+ * @param opts                          Game test options.
+ */
+void applyTestShard(const GameTestOptions &opts);
+
+/**
+ * Runs the game tests in `opts.jobs` child processes, each running its own shard, and merges the XML reports of
+ * the child processes into the report requested with `--gtest_output`, if any.
+ *
+ * @param argc                          Command line argc, as passed to `main`.
+ * @param argv                          Command line argv, as passed to `main`.
+ * @param opts                          Game test options.
+ * @return                              Exit code - zero if all shards have succeeded.
+ */
+int runTestShards(int argc, char **argv, const GameTestOptions &opts);
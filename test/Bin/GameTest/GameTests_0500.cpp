@@ -562,6 +562,25 @@ GAME_TEST(Issues, Issue735a) {
     test.playTraceFromTestData("issue_735a.mm7", "issue_735a.json");
 }
 
+GAME_TEST(Issues, Issue735aCounters) {
+    // Work budgets for the Issue735a dungeon battle. Each actor selects a target at most once per tick and checks line
+    // of sight at most once per other actor plus the party, so there are at most n * (n + 1) line of sight checks per
+    // tick. Anything above that means that something is checking the same pair of actors more than once.
+    auto actorCountTape = tapes.custom([] { return static_cast<int64_t>(pActors.size()); });
+    auto actorsUpdatedTape = tapes.counterPerTick(&EngineCounters::actorsUpdated);
+    auto lineOfSightTape = tapes.counterPerTick(&EngineCounters::lineOfSightChecks);
+    auto collisionTape = tapes.counterPerTick(&EngineCounters::collisionFaceTests);
+    test.playTraceFromTestData("issue_735a.mm7", "issue_735a.json");
+
+    int64_t actorCount = actorCountTape.max();
+    EXPECT_GT(actorCount, 50);
+    EXPECT_GT(actorsUpdatedTape.max(), 0);
+    EXPECT_LE(actorsUpdatedTape.max(), actorCount); // Each actor is updated at most once per tick.
+    EXPECT_GT(lineOfSightTape.max(), 0);
+    EXPECT_LE(lineOfSightTape.max(), actorCount * (actorCount + 1));
+    EXPECT_GT(collisionTape.max(), 0);
+}
+
 GAME_TEST(Issues, Issue735b) {
     // Trace-only test: battle with over 30 monsters in the open.
     test.playTraceFromTestData("issue_735b.mm7", "issue_735b.json");
@@ -1,5 +1,10 @@
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <system_error>
 #include <unordered_set>
 
+#include "Testing/Game/AllocationCounter.h"
 #include "Testing/Game/GameTest.h"
 
 #include "GUI/GUIWindow.h"
@@ -15,9 +20,13 @@
 #include "Engine/Engine.h"
 #include "Engine/PriceCalculator.h"
 #include "Engine/Graphics/ParticleEngine.h"
+#include "Engine/mm7_data.h"
 
 #include "Media/Audio/AudioPlayer.h"
 
+#include "Utility/DataPath.h"
+#include "Utility/ScopeGuard.h"
+
 static bool characterHasJar(int charIndex, int jarIndex) {
     for (const ItemGen &item : pParty->pCharacters[charIndex].pInventoryItemList)
         if (item.uItemID == ITEM_QUEST_LICH_JAR_FULL && item.uHolderPlayer == jarIndex)
@@ -41,6 +50,20 @@ GAME_TEST(Prs, Pr1005) {
     EXPECT_EQ(zTape.frontBack(), tape(154, 193)); // Paving is at z=192, party z should be this value +1.
 }
 
+GAME_TEST(Prs, Pr1005Allocations) {
+    // Steady-state allocations on the game thread, party walking around outdoors with nothing else going on. The
+    // quietest tick is what the game allocates every frame no matter what. Test code is not counted, so this is
+    // all engine. The budget is just above the steady state, so that any new per-frame allocation trips it. The goal
+    // is to get it down to zero.
+    static constexpr int64_t ALLOCATIONS_PER_TICK_BUDGET = 200;
+    auto allocationsTape = tapes.allocationsPerTick();
+    std::optional<AllocationSampler> sampler;
+    test.playTraceFromTestData("pr_1005.mm7", "pr_1005.json", [&] { sampler.emplace(997, 64); });
+    EXPECT_LE(allocationsTape.min(), ALLOCATIONS_PER_TICK_BUDGET);
+    if (HasFailure() && sampler)
+        sampler->print(stderr); // Show where the allocations are coming from.
+}
+
 GAME_TEST(Issues, Issue1020) {
     // Test finishing the scavenger hunt quest. The game should not crash when there is no dialogue options.
     test.playTraceFromTestData("issue_1020.mm7", "issue_1020.json"); // Should not assert
@@ -559,8 +582,7 @@ GAME_TEST(Prs, Pr1440) {
 
 GAME_TEST(Issues, Issue1447A) {
     // Fire bolt doesn't emit particles in turn based mode
-    auto particlesTape = tapes.custom([] { return std::ranges::count_if(engine->particle_engine.get()->pParticles,
-                                        [](const Particle &par) { return par.type != ParticleType_Invalid; }); });
+    auto particlesTape = tapes.custom([] { return engine->particle_engine->size(); });
     auto turnBasedTape = tapes.custom([] { return pParty->bTurnBasedModeOn; });
     test.playTraceFromTestData("issue_1447A.mm7", "issue_1447A.json");
     EXPECT_EQ(turnBasedTape.back(), true);
@@ -569,8 +591,7 @@ GAME_TEST(Issues, Issue1447A) {
 
 GAME_TEST(Issues, Issue1447B) {
     // Fireball doesn't emit particles in turn based mode
-    auto particlesTape = tapes.custom([] { return std::ranges::count_if(engine->particle_engine.get()->pParticles,
-                                        [](const Particle& par) { return par.type != ParticleType_Invalid; }); });
+    auto particlesTape = tapes.custom([] { return engine->particle_engine->size(); });
     auto turnBasedTape = tapes.custom([] { return pParty->bTurnBasedModeOn; });
     test.playTraceFromTestData("issue_1447B.mm7", "issue_1447B.json");
     EXPECT_EQ(turnBasedTape.back(), true);
@@ -579,8 +600,7 @@ GAME_TEST(Issues, Issue1447B) {
 
 GAME_TEST(Issues, Issue1447C) {
     // Acid blast doesn't emit particles in turn based mode
-    auto particlesTape = tapes.custom([] { return std::ranges::count_if(engine->particle_engine.get()->pParticles,
-                                        [](const Particle& par) { return par.type != ParticleType_Invalid; }); });
+    auto particlesTape = tapes.custom([] { return engine->particle_engine->size(); });
     auto turnBasedTape = tapes.custom([] { return pParty->bTurnBasedModeOn; });
     test.playTraceFromTestData("issue_1447C.mm7", "issue_1447C.json");
     EXPECT_EQ(turnBasedTape.back(), true);
@@ -685,3 +705,44 @@ GAME_TEST(Issues, Issue1482) {
     EXPECT_GT(timeTape.delta(), Duration::fromMinutes(5));
     EXPECT_LT(timeTape.delta(), Duration::fromMinutes(10));
 }
+
+// Other
+
+GAME_TEST(Saves, MemorySaves) {
+    // Saving into memory & loading from memory should restore the game state. Loading from memory leaves a stale
+    // new.lod on disk, so the next save to disk has to be rebuilt from the in-memory save, check that it's loadable.
+    std::string savePath = makeDataPath("saves", "!!!memory_test.mm7");
+    MM_AT_SCOPE_EXIT({
+        std::error_code ec;
+        std::filesystem::remove(savePath, ec); // Using std::error_code here, so can't throw.
+    });
+
+    test.loadGameFromTestData("issue_1478.mm7");
+    game.tick();
+    std::string mapName = pCurrentMapName;
+    Vec3i pos = pParty->pos.toInt();
+    int gold = pParty->GetGold();
+    ASSERT_GT(gold, 100);
+
+    Blob save = game.saveGameToMemory();
+    EXPECT_TRUE(save);
+
+    pParty->pos += Vec3f(100, 100, 0);
+    pParty->TakeGold(100);
+    game.tick();
+    EXPECT_EQ(pParty->GetGold(), gold - 100);
+
+    game.loadGameFromMemory(save);
+    EXPECT_EQ(pCurrentMapName, mapName);
+    EXPECT_EQ(pParty->pos.toInt(), pos);
+    EXPECT_EQ(pParty->GetGold(), gold);
+
+    game.saveGame(savePath);
+    pParty->TakeGold(100);
+    game.tick();
+
+    game.loadGame(savePath);
+    EXPECT_EQ(pCurrentMapName, mapName);
+    EXPECT_EQ(pParty->pos.toInt(), pos);
+    EXPECT_EQ(pParty->GetGold(), gold);
+}
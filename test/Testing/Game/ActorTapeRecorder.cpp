@@ -38,12 +38,10 @@ TestTape<int> ActorTapeRecorder::countByBuff(ActorBuff buff) {
 }
 
 TestMultiTape<int> ActorTapeRecorder::indicesByState(AIState state) {
-    return _controller->recordTape([state] {
-        AccessibleVector<int> result;
+    return _controller->recordMultiTape<int>([state] (AccessibleVector<int> *result) {
         for (size_t i = 0; i < actors().size(); i++)
             if (actors()[i].aiState == state)
-                result.push_back(i);
-        return result;
+                result->push_back(i);
     });
 }
 
@@ -22,12 +22,11 @@ class ActorTapeRecorder {
 
     template<class Callback, class T = std::decay_t<std::invoke_result_t<Callback, const Actor &>>>
     TestMultiTape<T> custom(std::initializer_list<int> actorIndices, Callback callback) {
-        return _controller->recordTape([actorIndices = std::vector(actorIndices), callback = std::move(callback)] {
-            AccessibleVector<T> result;
+        auto fill = [actorIndices = std::vector(actorIndices), callback = std::move(callback)] (AccessibleVector<T> *result) {
             for (int actorIndex : actorIndices)
-                result.push_back(callback(actors()[actorIndex]));
-            return result;
-        });
+                result->push_back(callback(actors()[actorIndex]));
+        };
+        return _controller->recordMultiTape<T>(std::move(fill));
     }
 
     TestTape<int> totalHp();
@@ -0,0 +1,77 @@
+#include "AllocationCounter.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+#include "Library/Fiber/Fiber.h"
+
+#include "Utility/Format.h"
+
+// Max number of frames in a sampled stack trace.
+static constexpr int SAMPLE_DEPTH = 24;
+
+static thread_local int64_t globalThreadAllocationCount = 0;
+static thread_local AllocationSampler *globalThreadSampler = nullptr;
+static thread_local bool globalInsideSampler = false; // Stack trace capture might allocate, and we don't want to recurse.
+
+int64_t threadAllocationCount() {
+    return globalThreadAllocationCount;
+}
+
+AllocationSampler::AllocationSampler(int interval, int maxSamples) : _interval(interval), _countdown(interval) {
+    assert(interval > 0 && maxSamples > 0);
+    assert(!globalThreadSampler); // Samplers don't nest.
+
+    // Capturing once makes the traces allocate their storage upfront, re-capturing then doesn't allocate.
+    _samples.resize(maxSamples);
+    for (RawStackTrace &trace : _samples)
+        trace.capture(SAMPLE_DEPTH);
+
+    globalThreadSampler = this;
+}
+
+AllocationSampler::~AllocationSampler() {
+    assert(globalThreadSampler == this);
+    globalThreadSampler = nullptr;
+}
+
+void AllocationSampler::sample() {
+    if (--_countdown > 0 || _sampleCount == _samples.size())
+        return;
+    _countdown = _interval;
+
+    globalInsideSampler = true;
+    _samples[_sampleCount++].capture(SAMPLE_DEPTH, 2); // Skip `sample` & `operator new`.
+    globalInsideSampler = false;
+}
+
+void AllocationSampler::print(FILE *stream) const {
+    StackTracePrinter printer;
+    for (size_t i = 0; i < _sampleCount; i++) {
+        fmt::println(stream, "Allocation sample #{}:", i);
+        printer.print(stream, _samples[i]);
+    }
+}
+
+void *operator new(size_t size) {
+    // Control routines run in a fiber on the game thread, this is test code & not the game.
+    if (!Fiber::current()) {
+        globalThreadAllocationCount++;
+        if (globalThreadSampler && !globalInsideSampler)
+            globalThreadSampler->sample();
+    }
+
+    // Zero-size allocations must return unique pointers, and malloc(0) is allowed to return nullptr.
+    if (void *result = std::malloc(size ? size : 1))
+        return result;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
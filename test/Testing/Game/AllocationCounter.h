@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "Library/StackTrace/StackTrace.h"
+
+/**
+ * Counts heap allocations made through the global `operator new` on the calling thread.
+ *
+ * The counting is done by replacing the global `operator new` & `operator delete`, which happens for any binary that
+ * links in `testing_game` and calls this function. Aligned and `nothrow` overloads aren't replaced. Their default
+ * implementations either forward to the non-aligned `operator new`, and are counted, or call into the allocator
+ * directly, and aren't. Allocations made with `malloc` are not counted either.
+ *
+ * Allocations made from inside a `Fiber` are not counted. This is where the control routines run, so the test body,
+ * the tape callbacks and the trace player's checks don't end up attributed to the game.
+ *
+ * @return                              Number of allocations made on the calling thread since it has started.
+ */
+[[nodiscard]] int64_t threadAllocationCount();
+
+/**
+ * Captures stack traces of the allocations counted by `threadAllocationCount`. Only the allocations made on the
+ * thread that has created the sampler are sampled, and only during the sampler's lifetime. Stack traces are
+ * captured into preallocated storage, so sampling itself doesn't count as allocating.
+ *
+ * Use this to find out where the allocations flagged by an allocation budget test come from.
+ */
+class AllocationSampler {
+ public:
+    /**
+     * @param interval                  Capture every `interval`-th allocation.
+     * @param maxSamples                Max number of stack traces to capture, the rest are dropped.
+     */
+    AllocationSampler(int interval, int maxSamples);
+    ~AllocationSampler();
+
+    AllocationSampler(const AllocationSampler &) = delete;
+    AllocationSampler &operator=(const AllocationSampler &) = delete;
+
+    [[nodiscard]] size_t sampleCount() const {
+        return _sampleCount;
+    }
+
+    /**
+     * Symbolizes & prints all the captured stack traces.
+     *
+     * @param stream                    Stream to print into.
+     */
+    void print(FILE *stream) const;
+
+    /**
+     * Called from the replaced `operator new` for each allocation on the sampled thread.
+     */
+    void sample();
+
+ private:
+    int _interval = 1;
+    int _countdown = 1;
+    size_t _sampleCount = 0;
+    std::vector<RawStackTrace> _samples;
+};
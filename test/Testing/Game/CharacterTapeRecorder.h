@@ -14,11 +14,9 @@ class CharacterTapeRecorder {
 
     template<class Callback, class T = std::decay_t<std::invoke_result_t<Callback, const Character &>>>
     TestMultiTape<T> custom(Callback callback) {
-        return _controller->recordTape([callback = std::move(callback)] {
-            AccessibleVector<T> result;
+        return _controller->recordMultiTape<T>([callback = std::move(callback)] (AccessibleVector<T> *result) {
             for (const Character &character : characters())
-                result.push_back(callback(character));
-            return result;
+                result->push_back(callback(character));
         });
     }
 
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <ranges>
+#include <utility>
 
 #include "Engine/Objects/Character.h"
 #include "Engine/Objects/Actor.h"
@@ -129,14 +130,32 @@ TestTape<HouseId> CommonTapeRecorder::house() {
 }
 
 TestMultiTape<SpriteId> CommonTapeRecorder::sprites() {
-    return custom([] {
-        AccessibleVector<SpriteId> result;
+    return _controller->recordMultiTape<SpriteId>([] (AccessibleVector<SpriteId> *result) {
         for (const SpriteObject &sprite : pSpriteObjects)
-            result.push_back(sprite.uType);
-        return result;
+            result->push_back(sprite.uType);
     });
 }
 
 TestTape<int> CommonTapeRecorder::activeCharacterIndex() {
     return custom([] { return pParty->hasActiveCharacter() ? pParty->activeCharacterIndex() : 0; });
 }
+
+TestTape<int64_t> CommonTapeRecorder::counterPerTick(std::atomic<int64_t> EngineCounters::*counter) {
+    return custom([counter, last = (engineCounters.*counter).load()] () mutable {
+        int64_t value = (engineCounters.*counter).load();
+        return value - std::exchange(last, value);
+    });
+}
+
+TestTape<int64_t> CommonTapeRecorder::counterTotal(std::atomic<int64_t> EngineCounters::*counter) {
+    return custom([counter, start = (engineCounters.*counter).load()] {
+        return (engineCounters.*counter).load() - start;
+    });
+}
+
+TestTape<int64_t> CommonTapeRecorder::allocationsPerTick() {
+    return custom([controller = _controller, last = _controller->gameAllocationCount()] () mutable {
+        int64_t value = controller->gameAllocationCount();
+        return value - std::exchange(last, value);
+    });
+}
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <utility>
 #include <string>
 #include <type_traits>
 
+#include "Engine/EngineCounters.h"
 #include "Engine/Objects/ItemEnums.h"
 #include "Engine/Objects/ActorEnums.h"
 #include "Engine/Objects/SpriteEnums.h"
@@ -83,6 +85,25 @@ class CommonTapeRecorder {
 
     TestTape<int> activeCharacterIndex(); // Remember that 0 means none!
 
+    /**
+     * @param counter                   Engine counter to record, e.g. `&EngineCounters::collisionFaceTests`.
+     * @return                          Tape of per-tick counter increments. Use `max()` to check the per-tick budget.
+     */
+    TestTape<int64_t> counterPerTick(std::atomic<int64_t> EngineCounters::*counter);
+
+    /**
+     * @param counter                   Engine counter to record.
+     * @return                          Tape of counter increments since the tape was created. Use `back()` to check
+     *                                  the budget for the whole trace.
+     */
+    TestTape<int64_t> counterTotal(std::atomic<int64_t> EngineCounters::*counter);
+
+    /**
+     * @return                          Tape of the number of heap allocations made by the game on the game thread
+     *                                  during each tick. See `threadAllocationCount` for what's counted.
+     */
+    TestTape<int64_t> allocationsPerTick();
+
  private:
     TestController *_controller = nullptr;
 };
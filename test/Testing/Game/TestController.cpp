@@ -15,12 +15,16 @@
 #include "Media/Audio/AudioPlayer.h"
 
 #include "Library/Platform/Application/PlatformApplication.h"
+#include "Library/Profiler/Profiler.h"
+
+#include "AllocationCounter.h"
 
 TestController::TestController(EngineController *controller, const std::string &testDataPath, float playbackSpeed):
     _controller(controller),
     _testDataPath(testDataPath),
-    _playbackSpeed(playbackSpeed)
-{}
+    _playbackSpeed(playbackSpeed) {
+    Profiler::setAllocationCounter(&threadAllocationCount); // Zones in the profiler reports get allocation counts.
+}
 
 std::string TestController::fullPathInTestData(const std::string &fileName) {
     return (_testDataPath / fileName).string();
@@ -36,6 +40,8 @@ void TestController::playTraceFromTestData(const std::string &saveName, const st
 
 void TestController::playTraceFromTestData(const std::string &saveName, const std::string &traceName,
                                            EngineTracePlaybackFlags flags, std::function<void()> postLoadCallback) {
+    _loadStartAllocationCount = threadAllocationCount();
+
     // TODO(captainurist): we need to overhaul our usage of path::string, path::u8string, path::generic_string,
     // pick one, and spell it out explicitly in HACKING
     ::application->component<EngineTracePlayer>()->playTrace(
@@ -47,6 +53,9 @@ void TestController::playTraceFromTestData(const std::string &saveName, const st
             if (postLoadCallback)
                 postLoadCallback();
 
+            // Don't count the allocations made while loading.
+            _loadAllocationCount += threadAllocationCount() - _loadStartAllocationCount;
+
             // FPS are unlimited by default, and speed over x1000 isn't really distinguishable from unlimited FPS.
             if (_playbackSpeed < 1000.0f) {
                 int fps = _playbackSpeed * 1000 / engine->config->debug.TraceFrameTimeMs.value();
@@ -77,13 +86,17 @@ void TestController::prepareForNextTestInternal() {
     int frameTimeMs = engine->config->debug.TraceFrameTimeMs.value();
     RandomEngineType rngType = engine->config->debug.TraceRandomEngine.value();
 
-    _tapeCallbacks.clear();
+    _tapeStates.clear();
     ::application->component<GameKeyboardController>()->reset();
     ::application->component<EngineDeterministicComponent>()->restart(frameTimeMs, rngType);
     _controller->goToMainMenu();
 }
 
 void TestController::runTapeCallbacks() {
-    for (const auto &callback : _tapeCallbacks)
-        callback();
+    for (const auto &state : _tapeStates)
+        state->tick();
+}
+
+int64_t TestController::gameAllocationCount() const {
+    return threadAllocationCount() - _loadAllocationCount;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <functional>
@@ -38,16 +39,36 @@ class TestController {
     // Accessed by tape recorders.
     template<class Callback, class T = std::invoke_result_t<Callback>>
     TestTape<T> recordTape(Callback callback) {
-        auto state = std::make_shared<detail::TestTapeState<T>>(std::move(callback));
-        _tapeCallbacks.push_back([state] { state->tick(); });
+        auto state = std::make_shared<detail::TestTapeCallbackState<T, Callback>>(std::move(callback));
+        _tapeStates.push_back(state);
         return TestTape<T>(std::move(state));
     }
 
+    /**
+     * Same as `recordTape`, but for tapes of vectors. The callback is passed an empty vector to fill in, which is
+     * reused between the ticks.
+     */
+    template<class T, class Callback>
+    TestMultiTape<T> recordMultiTape(Callback callback) {
+        auto state = std::make_shared<detail::TestTapeFillState<AccessibleVector<T>, Callback>>(std::move(callback));
+        _tapeStates.push_back(state);
+        return TestMultiTape<T>(std::move(state));
+    }
+
     void runTapeCallbacks();
 
+    /**
+     * @return                          Number of allocations made by the game on the game thread, excluding the
+     *                                  allocations made while loading traces. Test code runs in the control fiber
+     *                                  and is not counted, see `threadAllocationCount`.
+     */
+    [[nodiscard]] int64_t gameAllocationCount() const;
+
  private:
     EngineController *_controller;
     std::filesystem::path _testDataPath;
     float _playbackSpeed;
-    std::vector<std::function<void()>> _tapeCallbacks;
+    std::vector<std::shared_ptr<detail::TestTapeStateBase>> _tapeStates;
+    int64_t _loadStartAllocationCount = 0; // Thread allocation count right before the last trace started loading.
+    int64_t _loadAllocationCount = 0; // Total number of allocations made while loading traces.
 };
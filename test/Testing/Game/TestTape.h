@@ -13,26 +13,73 @@
 namespace testing {} // Forward-declare gtest namespace.
 
 namespace detail {
+class TestTapeStateBase {
+ public:
+    virtual ~TestTapeStateBase() = default;
+
+    /**
+     * Samples the tape value for the current tick.
+     */
+    virtual void tick() = 0;
+};
+
+/**
+ * Tape state that stores only the values that differ from the previous ones, so that a value that stays the same for
+ * thousands of ticks takes up a single element.
+ */
 template<class T>
-class TestTapeState {
+class TestTapeState : public TestTapeStateBase {
  public:
-    explicit TestTapeState(std::function<T()> callback) : _callback(std::move(callback)) {
-        assert(_callback);
+    const std::vector<T> &values() const {
+        return _values;
+    }
+
+ protected:
+    [[nodiscard]] bool changed(const T &value) const {
+        return _values.empty() || _values.back() != value;
     }
 
-    void tick() {
+ protected:
+    std::vector<T> _values;
+};
+
+/**
+ * Tape state for callbacks that return the tape value.
+ */
+template<class T, class Callback>
+class TestTapeCallbackState : public TestTapeState<T> {
+ public:
+    explicit TestTapeCallbackState(Callback callback) : _callback(std::move(callback)) {}
+
+    virtual void tick() override {
         T value = _callback();
-        if (_values.empty() || _values.back() != value)
-            _values.push_back(std::move(value));
+        if (this->changed(value))
+            this->_values.push_back(std::move(value));
     }
 
-    const std::vector<T> &values() const {
-        return _values;
+ private:
+    Callback _callback;
+};
+
+/**
+ * Tape state for callbacks that fill in a vector of values. The vector is reused between the ticks and is only copied
+ * when the values change, so that multi-tapes don't allocate every tick.
+ */
+template<class T, class Callback>
+class TestTapeFillState : public TestTapeState<T> {
+ public:
+    explicit TestTapeFillState(Callback callback) : _callback(std::move(callback)) {}
+
+    virtual void tick() override {
+        _scratch.clear();
+        _callback(&_scratch);
+        if (this->changed(_scratch))
+            this->_values.push_back(_scratch);
     }
 
  private:
-    std::function<T()> _callback;
-    std::vector<T> _values;
+    Callback _callback;
+    T _scratch;
 };
 
 template<class T>